@@ -48,7 +48,8 @@
 #include <limits>
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Blas1.hpp>
-#include <KokkosSparse_spmv.hpp>
+#include <KokkosSparse_linear_operator.hpp>
+#include <KokkosBlas1_fused.hpp>
 #include <impl/Kokkos_Timer.hpp>
 
 #include <WrapMPI.hpp>
@@ -103,7 +104,7 @@ struct CGSolve< ImportType , SparseMatrixType , VectorType ,
 
     /* p  = x       */  Kokkos::deep_copy( p , x );
     /* import p     */  import( pAll );
-    /* Ap = A * p   */  KokkosSparse::spmv( "N" , 1.0 , A , pAll , 0.0 , Ap);
+    /* Ap = A * p   */  KokkosSparse::Experimental::operator_apply( A , pAll , Ap );
     /* b - Ap => r  */  KokkosBlas::update( 1.0 , b , -1.0 , Ap , 0.0 , r);
     /* p  = r       */  Kokkos::deep_copy( p , r );
 
@@ -121,11 +122,12 @@ struct CGSolve< ImportType , SparseMatrixType , VectorType ,
 
       timer.reset();
       /* import p    */  import( pAll );
-      /* Ap = A * p  */  KokkosSparse::spmv( "N", 1.0, A , pAll, 0.0, Ap);
+      /* Ap = A * p, dot( p , Ap ) */
+      const double pAp_local = KokkosSparse::Experimental::operator_apply_dot( A , pAll , Ap , p );
       execution_space::fence();
       matvec_time += timer.seconds();
 
-      const double pAp_dot = Kokkos::Example::all_reduce( KokkosBlas::dot( p , Ap ) , import.comm );
+      const double pAp_dot = Kokkos::Example::all_reduce( pAp_local , import.comm );
       const double alpha   = old_rdot / pAp_dot ;
 
       /* x +=  alpha * p ;  */ KokkosBlas::axpby( alpha, p  , 1.0 , x );
@@ -146,6 +148,182 @@ struct CGSolve< ImportType , SparseMatrixType , VectorType ,
   }
 };
 
+//----------------------------------------------------------------------------
+/* Pipelined CG (P. Ghysels and W. Vanroose, "Hiding global synchronization
+ * latency in the preconditioned Conjugate Gradient algorithm", 2014),
+ * without preconditioner.  The two inner products of an iteration are
+ * reduced by a single non-blocking all_reduce that is overlapped with the
+ * matrix-vector product n = A * w.  The price is three more vectors, one
+ * more matrix-vector product at convergence and a recurrence for the
+ * residual that can lose accuracy at tight tolerances.
+ */
+
+/* All vector updates of a pipelined CG iteration and the inner products
+ * of the next one in a single sweep:
+ *
+ *   z = n + beta * z ;  s = w + beta * s ;  p = r + beta * p ;
+ *   x += alpha * p ;    r -= alpha * s ;    w -= alpha * z ;
+ *   dots = { dot( r , r ) , dot( w , r ) }
+ */
+template< class VectorType >
+struct PipelinedCGUpdate {
+  typedef typename VectorType::execution_space   execution_space ;
+  typedef typename VectorType::non_const_value_type scalar_type ;
+  typedef scalar_type value_type[] ;
+
+  const unsigned value_count ;
+
+  VectorType x , r , w , p , s , z ;
+  typename VectorType::const_type n ;
+  scalar_type alpha , beta ;
+
+  PipelinedCGUpdate( const VectorType & arg_x ,
+                     const VectorType & arg_r ,
+                     const VectorType & arg_w ,
+                     const VectorType & arg_p ,
+                     const VectorType & arg_s ,
+                     const VectorType & arg_z ,
+                     const VectorType & arg_n ,
+                     const scalar_type arg_alpha ,
+                     const scalar_type arg_beta )
+    : value_count(2)
+    , x( arg_x ), r( arg_r ), w( arg_w ), p( arg_p ), s( arg_s ), z( arg_z ), n( arg_n )
+    , alpha( arg_alpha ), beta( arg_beta )
+    {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()( const unsigned i , value_type dots ) const
+  {
+    const scalar_type z_i = n(i) + beta * z(i);
+    const scalar_type s_i = w(i) + beta * s(i);
+    const scalar_type p_i = r(i) + beta * p(i);
+    const scalar_type r_i = r(i) - alpha * s_i ;
+    const scalar_type w_i = w(i) - alpha * z_i ;
+
+    z(i) = z_i ; s(i) = s_i ; p(i) = p_i ;
+    x(i) += alpha * p_i ;
+    r(i) = r_i ; w(i) = w_i ;
+
+    dots[0] += r_i * r_i ;
+    dots[1] += w_i * r_i ;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init( value_type dots ) const { dots[0] = 0 ; dots[1] = 0 ; }
+
+  KOKKOS_INLINE_FUNCTION
+  void join( volatile value_type dots , const volatile value_type src ) const
+    { dots[0] += src[0] ; dots[1] += src[1] ; }
+};
+
+template< class ImportType , class SparseMatrixType , class VectorType , class TagType = void >
+struct PipelinedCGSolve ;
+
+template< class ImportType , class SparseMatrixType , class VectorType >
+struct PipelinedCGSolve< ImportType , SparseMatrixType , VectorType ,
+  typename Kokkos::Impl::enable_if<(
+    Kokkos::Impl::is_view< VectorType >::value &&
+    VectorType::rank == 1
+  )>::type >
+{
+  typedef typename VectorType::value_type scalar_type ;
+  typedef typename VectorType::execution_space execution_space;
+
+  size_t iteration ;
+  double iter_time ;
+  double matvec_time ;
+  double norm_res ;
+
+  PipelinedCGSolve( const ImportType       & import ,
+                    const SparseMatrixType & A ,
+                    const VectorType       & b ,
+                    const VectorType       & x ,
+                    const size_t             maximum_iteration = 200 ,
+                    const double             tolerance = std::numeric_limits<double>::epsilon() )
+    : iteration(0)
+    , iter_time(0)
+    , matvec_time(0)
+    , norm_res(0)
+  {
+    const size_t count_owned = import.count_owned ;
+    const size_t count_total = import.count_owned + import.count_receive;
+
+    // Need input vectors to matvec to be owned + received
+    VectorType rAll( "pcg::r" , count_total );
+    VectorType wAll( "pcg::w" , count_total );
+
+    VectorType r = Kokkos::subview( rAll , std::pair<size_t,size_t>(0,count_owned) );
+    VectorType w = Kokkos::subview( wAll , std::pair<size_t,size_t>(0,count_owned) );
+    VectorType p( "pcg::p" , count_owned );
+    VectorType s( "pcg::s" , count_owned );
+    VectorType z( "pcg::z" , count_owned );
+    VectorType n( "pcg::n" , count_owned );
+
+    /* r = b - A * x ; w = A * r ; */
+
+    /* r  = x       */  Kokkos::deep_copy( r , x );
+    /* import r     */  import( rAll );
+    /* n  = A * r   */  KokkosSparse::Experimental::operator_apply( A , rAll , n );
+    /* b - n => r   */  KokkosBlas::update( 1.0 , b , -1.0 , n , 0.0 , r );
+    /* import r     */  import( rAll );
+    /* w  = A * r   */  KokkosSparse::Experimental::operator_apply( A , rAll , w );
+
+    Kokkos::Example::AsyncAllReduce<2> dots ;
+    {
+      const Kokkos::pair<scalar_type,scalar_type> rr_wr = KokkosBlas::Experimental::dot2( r , r , w , r );
+      dots.local[0] = rr_wr.first ;
+      dots.local[1] = rr_wr.second ;
+    }
+    dots.start( import.comm );
+
+    double gamma_old = 0 ;
+    double alpha_old = 0 ;
+
+    iteration = 0 ;
+
+    Kokkos::Impl::Timer wall_clock ;
+    Kokkos::Impl::Timer timer;
+
+    while ( true ) {
+
+      /* n = A * w, overlapped with the reduction of dot( r , r ) and dot( w , r ) */
+
+      timer.reset();
+      /* import w    */  import( wAll );
+      /* n = A * w   */  KokkosSparse::Experimental::operator_apply( A , wAll , n );
+      execution_space::fence();
+      matvec_time += timer.seconds();
+
+      dots.wait();
+      const double gamma = dots.global[0] ;
+      const double delta = dots.global[1] ;
+
+      norm_res = std::sqrt( gamma );
+      if ( ! ( tolerance < norm_res && iteration < maximum_iteration ) ) break ;
+
+      const double beta  = iteration ? gamma / gamma_old : 0.0 ;
+      const double alpha = iteration ? gamma / ( delta - beta * gamma / alpha_old ) : gamma / delta ;
+
+      {
+        typedef PipelinedCGUpdate< VectorType > functor_type ;
+        Kokkos::parallel_reduce( "Kokkos::Example::PipelinedCGUpdate" ,
+                                 Kokkos::RangePolicy< execution_space >( 0 , count_owned ) ,
+                                 functor_type( x , r , w , p , s , z , n , alpha , beta ) ,
+                                 dots.local );
+      }
+      dots.start( import.comm );
+
+      gamma_old = gamma ;
+      alpha_old = alpha ;
+
+      ++iteration ;
+    }
+
+    execution_space::fence();
+    iter_time = wall_clock.seconds();
+  }
+};
+
 } // namespace Example
 } // namespace Kokkos
 
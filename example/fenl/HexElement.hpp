@@ -44,6 +44,8 @@
 #ifndef KOKKOS_HEXELEMENT_HPP
 #define KOKKOS_HEXELEMENT_HPP
 
+#include <Kokkos_Macros.hpp>
+
 namespace Kokkos {
 namespace Example {
 
@@ -260,6 +262,187 @@ public:
   }
 };
 
+//----------------------------------------------------------------------------
+/** \brief  Sum-factorized evaluation of a Hex element field and of the
+ *          transpose, integrating against the bases.
+ *
+ *  Values and reference gradients at the tensor product integration points
+ *  are computed with one-dimensional contractions, one direction at a time,
+ *  in O( NodeCount * n ) operations instead of the O( NodeCount^2 ) of the
+ *  HexElement_Data tables, where n is the 1D function count.  This is the
+ *  kernel of matrix-free element operators whose assembled matrices would
+ *  cost O( NodeCount^2 ) memory traffic per element.
+ *
+ *  Integration points are numbered lexicographically, px + n * ( py + n * pz ),
+ *  and the tables are held by value so that the class is copied into the
+ *  functors running on Device.
+ */
+template< unsigned NodeCount , class Device >
+class HexElement_TensorEval {
+public:
+
+  typedef HexElement_TensorData< NodeCount > tensor_data_type ;
+
+  static const unsigned spatial_dimension   = 3 ;
+  static const unsigned element_node_count  = NodeCount ;
+  static const unsigned integration_count   = NodeCount ;
+  static const unsigned count_1d            = tensor_data_type::function_count_1d ;
+
+  float values_1d[ count_1d ][ count_1d ];
+  float derivs_1d[ count_1d ][ count_1d ];
+  float weights[ integration_count ];
+
+  // Lexicographic tensor index of each element node
+  unsigned char node_map[ element_node_count ];
+
+  HexElement_TensorEval()
+  {
+    tensor_data_type tensor_data ;
+
+    for ( unsigned p = 0 ; p < count_1d ; ++p ) {
+    for ( unsigned f = 0 ; f < count_1d ; ++f ) {
+      values_1d[p][f] = tensor_data.values_1d[p][f];
+      derivs_1d[p][f] = tensor_data.derivs_1d[p][f];
+    }}
+
+    for ( unsigned pz = 0 ; pz < count_1d ; ++pz ) {
+    for ( unsigned py = 0 ; py < count_1d ; ++py ) {
+    for ( unsigned px = 0 ; px < count_1d ; ++px ) {
+      weights[ px + count_1d * ( py + count_1d * pz ) ] =
+        tensor_data.weights_1d[px] * tensor_data.weights_1d[py] * tensor_data.weights_1d[pz] ;
+    }}}
+
+    for ( unsigned i = 0 ; i < element_node_count ; ++i ) {
+      node_map[i] = tensor_data.eval_map[i][0] +
+                    count_1d * ( tensor_data.eval_map[i][1] +
+                                 count_1d * tensor_data.eval_map[i][2] );
+    }
+  }
+
+  /** \brief  Value and reference gradient at the integration points of
+   *          the field with nodal values u[ element_node_count ].
+   */
+  KOKKOS_INLINE_FUNCTION
+  void gradient( const double u[] ,
+                 double value[] ,
+                 double grad[][ integration_count ] ) const
+  {
+    const unsigned n = count_1d ;
+
+    double U[ integration_count ] ;
+    double A[ integration_count ] , Ax[ integration_count ] ;
+    double B[ integration_count ] , Bx[ integration_count ] , By[ integration_count ] ;
+
+    for ( unsigned i = 0 ; i < element_node_count ; ++i ) { U[ node_map[i] ] = u[i] ; }
+
+    // Contract x: [fz][fy][px]
+    for ( unsigned fz = 0 ; fz < n ; ++fz ) {
+    for ( unsigned fy = 0 ; fy < n ; ++fy ) {
+    for ( unsigned px = 0 ; px < n ; ++px ) {
+      double a = 0 , ax = 0 ;
+      for ( unsigned fx = 0 ; fx < n ; ++fx ) {
+        const double uf = U[ fx + n * ( fy + n * fz ) ];
+        a  += values_1d[px][fx] * uf ;
+        ax += derivs_1d[px][fx] * uf ;
+      }
+      A[  px + n * ( fy + n * fz ) ] = a ;
+      Ax[ px + n * ( fy + n * fz ) ] = ax ;
+    }}}
+
+    // Contract y: [fz][py][px]
+    for ( unsigned fz = 0 ; fz < n ; ++fz ) {
+    for ( unsigned py = 0 ; py < n ; ++py ) {
+    for ( unsigned px = 0 ; px < n ; ++px ) {
+      double b = 0 , bx = 0 , by = 0 ;
+      for ( unsigned fy = 0 ; fy < n ; ++fy ) {
+        const double a  = A[  px + n * ( fy + n * fz ) ];
+        const double ax = Ax[ px + n * ( fy + n * fz ) ];
+        b  += values_1d[py][fy] * a ;
+        bx += values_1d[py][fy] * ax ;
+        by += derivs_1d[py][fy] * a ;
+      }
+      B[  px + n * ( py + n * fz ) ] = b ;
+      Bx[ px + n * ( py + n * fz ) ] = bx ;
+      By[ px + n * ( py + n * fz ) ] = by ;
+    }}}
+
+    // Contract z: [pz][py][px]
+    for ( unsigned pz = 0 ; pz < n ; ++pz ) {
+    for ( unsigned py = 0 ; py < n ; ++py ) {
+    for ( unsigned px = 0 ; px < n ; ++px ) {
+      double v = 0 , gx = 0 , gy = 0 , gz = 0 ;
+      for ( unsigned fz = 0 ; fz < n ; ++fz ) {
+        const unsigned k = px + n * ( py + n * fz );
+        v  += values_1d[pz][fz] * B[k] ;
+        gx += values_1d[pz][fz] * Bx[k] ;
+        gy += values_1d[pz][fz] * By[k] ;
+        gz += derivs_1d[pz][fz] * B[k] ;
+      }
+      const unsigned q = px + n * ( py + n * pz );
+      value[q]   = v ;
+      grad[0][q] = gx ;
+      grad[1][q] = gy ;
+      grad[2][q] = gz ;
+    }}}
+  }
+
+  /** \brief  r_i = sum_q value[q] * phi_i(q) + grad[:][q] . grad_ref phi_i(q) ,
+   *          the transpose of gradient() for quadrature-weighted data.
+   */
+  KOKKOS_INLINE_FUNCTION
+  void integrate( const double value[] ,
+                  const double grad[][ integration_count ] ,
+                  double r[] ) const
+  {
+    const unsigned n = count_1d ;
+
+    double A[ integration_count ] , Ax[ integration_count ] ;
+    double B[ integration_count ] , Bx[ integration_count ] , By[ integration_count ] ;
+
+    // Contract z: [fz][py][px]
+    for ( unsigned fz = 0 ; fz < n ; ++fz ) {
+    for ( unsigned py = 0 ; py < n ; ++py ) {
+    for ( unsigned px = 0 ; px < n ; ++px ) {
+      double b = 0 , bx = 0 , by = 0 ;
+      for ( unsigned pz = 0 ; pz < n ; ++pz ) {
+        const unsigned q = px + n * ( py + n * pz );
+        b  += values_1d[pz][fz] * value[q] + derivs_1d[pz][fz] * grad[2][q] ;
+        bx += values_1d[pz][fz] * grad[0][q] ;
+        by += values_1d[pz][fz] * grad[1][q] ;
+      }
+      B[  px + n * ( py + n * fz ) ] = b ;
+      Bx[ px + n * ( py + n * fz ) ] = bx ;
+      By[ px + n * ( py + n * fz ) ] = by ;
+    }}}
+
+    // Contract y: [fz][fy][px]
+    for ( unsigned fz = 0 ; fz < n ; ++fz ) {
+    for ( unsigned fy = 0 ; fy < n ; ++fy ) {
+    for ( unsigned px = 0 ; px < n ; ++px ) {
+      double a = 0 , ax = 0 ;
+      for ( unsigned py = 0 ; py < n ; ++py ) {
+        const unsigned k = px + n * ( py + n * fz );
+        a  += values_1d[py][fy] * B[k] + derivs_1d[py][fy] * By[k] ;
+        ax += values_1d[py][fy] * Bx[k] ;
+      }
+      A[  px + n * ( fy + n * fz ) ] = a ;
+      Ax[ px + n * ( fy + n * fz ) ] = ax ;
+    }}}
+
+    // Contract x: [fz][fy][fx]
+    for ( unsigned i = 0 ; i < element_node_count ; ++i ) {
+      const unsigned f  = node_map[i] ;
+      const unsigned fx = f % n ;
+      const unsigned k  = f - fx ;
+      double ri = 0 ;
+      for ( unsigned px = 0 ; px < n ; ++px ) {
+        ri += values_1d[px][fx] * A[ k + px ] + derivs_1d[px][fx] * Ax[ k + px ] ;
+      }
+      r[i] = ri ;
+    }
+  }
+};
+
 //----------------------------------------------------------------------------
 
 } /* namespace Example */
@@ -70,6 +70,36 @@ double all_reduce_max( double value , MPI_Comm comm )
   return value ;
 }
 
+/* Non-blocking sum of N doubles: 'start' posts the reduction of
+ * 'local' into 'global' and 'wait' completes it.  Work done between
+ * the two calls, e.g. a matrix-vector product, hides the latency of
+ * the reduction.  Without MPI-3 the reduction is done by 'start'.
+ */
+template< int N >
+struct AsyncAllReduce {
+  double local[N] ;
+  double global[N] ;
+#if MPI_VERSION >= 3
+  MPI_Request request ;
+#endif
+
+  void start( MPI_Comm comm )
+  {
+#if MPI_VERSION >= 3
+    MPI_Iallreduce( local , global , N , MPI_DOUBLE , MPI_SUM , comm , & request );
+#else
+    MPI_Allreduce( local , global , N , MPI_DOUBLE , MPI_SUM , comm );
+#endif
+  }
+
+  void wait()
+  {
+#if MPI_VERSION >= 3
+    MPI_Wait( & request , MPI_STATUS_IGNORE );
+#endif
+  }
+};
+
 } // namespace Example
 } // namespace Kokkos
 
@@ -95,6 +125,15 @@ double all_reduce( double value , MPI_Comm ) { return value ; }
 inline
 double all_reduce_max( double value , MPI_Comm ) { return value ; }
 
+template< int N >
+struct AsyncAllReduce {
+  double local[N] ;
+  double global[N] ;
+
+  void start( MPI_Comm ) { for ( int i = 0 ; i < N ; ++i ) global[i] = local[i] ; }
+  void wait() {}
+};
+
 } // namespace Example
 } // namespace Kokkos
 
@@ -55,6 +55,7 @@ Perf fenl< Kokkos::Threads , Kokkos::Example::BoxElemPart::ElemLinear >(
   const int use_print ,
   const int use_trials ,
   const int use_atomic ,
+  const int use_pipelined ,
   const int global_elems[] );
 
 
@@ -64,6 +65,7 @@ Perf fenl< Kokkos::Threads , Kokkos::Example::BoxElemPart::ElemQuadratic >(
   const int use_print ,
   const int use_trials ,
   const int use_atomic ,
+  const int use_pipelined ,
   const int global_elems[] );
 
 #endif
@@ -77,6 +79,7 @@ Perf fenl< Kokkos::OpenMP , Kokkos::Example::BoxElemPart::ElemLinear >(
   const int use_print ,
   const int use_trials ,
   const int use_atomic ,
+  const int use_pipelined ,
   const int global_elems[] );
 
 
@@ -86,6 +89,7 @@ Perf fenl< Kokkos::OpenMP , Kokkos::Example::BoxElemPart::ElemQuadratic >(
   const int use_print ,
   const int use_trials ,
   const int use_atomic ,
+  const int use_pipelined ,
   const int global_elems[] );
 
 #endif
@@ -98,6 +102,7 @@ Perf fenl< Kokkos::Cuda , Kokkos::Example::BoxElemPart::ElemLinear >(
   const int use_print ,
   const int use_trials ,
   const int use_atomic ,
+  const int use_pipelined ,
   const int global_elems[] );
 
 
@@ -107,6 +112,7 @@ Perf fenl< Kokkos::Cuda , Kokkos::Example::BoxElemPart::ElemQuadratic >(
   const int use_print ,
   const int use_trials ,
   const int use_atomic ,
+  const int use_pipelined ,
   const int global_elems[] );
 
 #endif
@@ -57,11 +57,11 @@ struct Perf {
   size_t global_node_count ;
   size_t newton_iter_count ;
   size_t cg_iter_count ;
-  double map_ratio ;
-  double fill_node_set ;
-  double scan_node_count ;
+  double graph_ratio ;
+  double fill_node_elem ;
+  double fill_candidates ;
+  double sort_candidates ;
   double fill_graph_entries ;
-  double sort_graph_entries ;
   double fill_element_graph ;
   double create_sparse_matrix ;
   double fill_time ;
@@ -79,6 +79,7 @@ Perf fenl(
   const int use_print ,
   const int use_trials ,
   const int use_atomic ,
+  const int use_pipelined ,
   const int global_elems[] );
 
 } /* namespace FENL */
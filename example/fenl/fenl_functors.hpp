@@ -54,610 +54,15 @@
 #include <limits>
 
 #include <Kokkos_Pair.hpp>
-#include <Kokkos_UnorderedMap.hpp>
 
 #include <impl/Kokkos_Timer.hpp>
 
 #include <BoxElemFixture.hpp>
 #include <HexElement.hpp>
 
-//----------------------------------------------------------------------------
-//----------------------------------------------------------------------------
-
-namespace Kokkos {
-namespace Example {
-namespace FENL {
-
-template< class ElemNodeIdView , class CrsGraphType , unsigned ElemNode >
-class NodeNodeGraph {
-public:
-
-  typedef typename ElemNodeIdView::execution_space execution_space ;
-  typedef pair<unsigned,unsigned> key_type ;
-
-  typedef Kokkos::UnorderedMap< key_type, void , execution_space > SetType ;
-  typedef typename CrsGraphType::row_map_type::non_const_type  RowMapType ;
-  typedef Kokkos::View< unsigned ,  execution_space >              UnsignedValue ;
-
-  // Static dimensions of 0 generate compiler warnings or errors.
-  typedef Kokkos::View< unsigned*[ElemNode][ElemNode] , execution_space >
-    ElemGraphType ;
-
-private:
-
-  enum PhaseType { FILL_NODE_SET ,
-                   SCAN_NODE_COUNT ,
-                   FILL_GRAPH_ENTRIES ,
-                   SORT_GRAPH_ENTRIES ,
-                   FILL_ELEMENT_GRAPH };
-
-  const unsigned        node_count ;
-  const ElemNodeIdView  elem_node_id ;
-  UnsignedValue         row_total ;
-  RowMapType            row_count ;
-  RowMapType            row_map ;
-  SetType               node_node_set ;
-  PhaseType             phase ;
-
-public:
-
-  CrsGraphType          graph ;
-  ElemGraphType         elem_graph ;
-
-  struct Times
-  {
-    double ratio;
-    double fill_node_set;
-    double scan_node_count;
-    double fill_graph_entries;
-    double sort_graph_entries;
-    double fill_element_graph;
-  };
-
-  NodeNodeGraph( const ElemNodeIdView & arg_elem_node_id ,
-                 const unsigned         arg_node_count,
-                 Times & results
-               )
-    : node_count(arg_node_count)
-    , elem_node_id( arg_elem_node_id )
-    , row_total( "row_total" )
-    , row_count(Kokkos::ViewAllocateWithoutInitializing("row_count") , node_count ) // will deep_copy to 0 inside loop
-    , row_map( "graph_row_map" , node_count + 1 )
-    , node_node_set()
-    , phase( FILL_NODE_SET )
-    , graph()
-    , elem_graph()
-   {
-      //--------------------------------
-      // Guess at span required for the map:
-
-      Kokkos::Impl::Timer wall_clock ;
-
-      wall_clock.reset();
-      phase = FILL_NODE_SET ;
-
-      // upper bound on the span
-      size_t set_span = (28ull * node_count) / 2;
-
-      {
-        // Zero the row count to restart the fill
-        Kokkos::deep_copy( row_count , 0u );
-
-        node_node_set = SetType( set_span );
-
-        // May be larger that requested:
-        set_span = node_node_set.span();
-
-        Kokkos::parallel_for( elem_node_id.extent(0) , *this );
-      }
-
-      execution_space::fence();
-      results.ratio = (double)node_node_set.size() / (double)node_node_set.span();
-      results.fill_node_set = wall_clock.seconds();
-      //--------------------------------
-
-      wall_clock.reset();
-      phase = SCAN_NODE_COUNT ;
-
-      // Exclusive scan of row_count into row_map
-      // including the final total in the 'node_count + 1' position.
-      // Zero the 'row_count' values.
-      Kokkos::parallel_scan( node_count , *this );
-
-      // Zero the row count for the fill:
-      Kokkos::deep_copy( row_count , 0u );
-
-      unsigned graph_entry_count = 0 ;
-
-      Kokkos::deep_copy( graph_entry_count , row_total );
-
-      // Assign graph's row_map and allocate graph's entries
-      graph.row_map = row_map ;
-      graph.entries = typename CrsGraphType::entries_type( "graph_entries" , graph_entry_count );
-
-      //--------------------------------
-      // Fill graph's entries from the (node,node) set.
-
-      execution_space::fence();
-      results.scan_node_count = wall_clock.seconds();
-
-      wall_clock.reset();
-      phase = FILL_GRAPH_ENTRIES ;
-      Kokkos::parallel_for( node_node_set.span() , *this );
-
-      execution_space::fence();
-      results.fill_graph_entries = wall_clock.seconds();
-
-      //--------------------------------
-      // Done with the temporary sets and arrays
-      wall_clock.reset();
-      phase = SORT_GRAPH_ENTRIES ;
-
-      row_total = UnsignedValue();
-      row_count = RowMapType();
-      row_map   = RowMapType();
-      node_node_set.clear();
-
-      //--------------------------------
-
-      Kokkos::parallel_for( node_count , *this );
-
-      execution_space::fence();
-      results.sort_graph_entries = wall_clock.seconds();
-
-      //--------------------------------
-      // Element-to-graph mapping:
-      wall_clock.reset();
-      phase = FILL_ELEMENT_GRAPH ;
-      elem_graph = ElemGraphType("elem_graph", elem_node_id.extent(0) );
-      Kokkos::parallel_for( elem_node_id.extent(0) , *this );
-
-      execution_space::fence();
-      results.fill_element_graph = wall_clock.seconds();
-    }
-
-  //------------------------------------
-  // parallel_for: create map and count row length
-
-  KOKKOS_INLINE_FUNCTION
-  void fill_set( const unsigned ielem ) const
-  {
-    // Loop over element's (row_local_node,col_local_node) pairs:
-    for ( unsigned row_local_node = 0 ; row_local_node < elem_node_id.extent(1) ; ++row_local_node ) {
-
-      const unsigned row_node = elem_node_id( ielem , row_local_node );
-
-      for ( unsigned col_local_node = row_local_node ; col_local_node < elem_node_id.extent(1) ; ++col_local_node ) {
-
-        const unsigned col_node = elem_node_id( ielem , col_local_node );
-
-        // If either node is locally owned then insert the pair into the unordered map:
-
-        if ( row_node < row_count.extent(0) || col_node < row_count.extent(0) ) {
-
-          const key_type key = (row_node < col_node) ? make_pair( row_node, col_node ) : make_pair( col_node, row_node ) ;
-
-          const typename SetType::insert_result result = node_node_set.insert( key );
-
-          // A successfull insert: the first time this pair was added
-          if ( result.success() ) {
-
-            // If row node is owned then increment count
-            if ( row_node < row_count.extent(0) ) { atomic_fetch_add( & row_count( row_node ) , 1 ); }
-
-            // If column node is owned and not equal to row node then increment count
-            if ( col_node < row_count.extent(0) && col_node != row_node ) { atomic_fetch_add( & row_count( col_node ) , 1 ); }
-          }
-        }
-      }
-    }
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void fill_graph_entries( const unsigned iset ) const
-  {
-    if ( node_node_set.valid_at(iset) ) {
-      // Add each entry to the graph entries.
-
-      const key_type key = node_node_set.key_at(iset) ;
-      const unsigned row_node = key.first ;
-      const unsigned col_node = key.second ;
-
-      if ( row_node < row_count.extent(0) ) {
-        const unsigned offset = graph.row_map( row_node ) + atomic_fetch_add( & row_count( row_node ) , 1 );
-        graph.entries( offset ) = col_node ;
-      }
-
-      if ( col_node < row_count.extent(0) && col_node != row_node ) {
-        const unsigned offset = graph.row_map( col_node ) + atomic_fetch_add( & row_count( col_node ) , 1 );
-        graph.entries( offset ) = row_node ;
-      }
-    }
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void sort_graph_entries( const unsigned irow ) const
-  {
-    const unsigned row_beg = graph.row_map( irow );
-    const unsigned row_end = graph.row_map( irow + 1 );
-    for ( unsigned i = row_beg + 1 ; i < row_end ; ++i ) {
-      const unsigned col = graph.entries(i);
-      unsigned j = i ;
-      for ( ; row_beg < j && col < graph.entries(j-1) ; --j ) {
-        graph.entries(j) = graph.entries(j-1);
-      }
-      graph.entries(j) = col ;
-    }
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void fill_elem_graph_map( const unsigned ielem ) const
-  {
-    for ( unsigned row_local_node = 0 ; row_local_node < elem_node_id.extent(1) ; ++row_local_node ) {
-
-      const unsigned row_node = elem_node_id( ielem , row_local_node );
-
-      for ( unsigned col_local_node = 0 ; col_local_node < elem_node_id.extent(1) ; ++col_local_node ) {
-
-        const unsigned col_node = elem_node_id( ielem , col_local_node );
-
-        unsigned entry = ~0u ;
-
-        if ( row_node + 1 < graph.row_map.extent(0) ) {
-
-          const unsigned entry_end = graph.row_map( row_node + 1 );
-
-          entry = graph.row_map( row_node );
-
-          for ( ; entry < entry_end && graph.entries(entry) != col_node ; ++entry );
-
-          if ( entry == entry_end ) entry = ~0u ;
-        }
-
-        elem_graph( ielem , row_local_node , col_local_node ) = entry ;
-      }
-    }
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void operator()( const unsigned iwork ) const
-  {
-    if ( phase == FILL_NODE_SET ) {
-      fill_set( iwork );
-    }
-    else if ( phase == FILL_GRAPH_ENTRIES ) {
-      fill_graph_entries( iwork );
-    }
-    else if ( phase == SORT_GRAPH_ENTRIES ) {
-      sort_graph_entries( iwork );
-    }
-    else if ( phase == FILL_ELEMENT_GRAPH ) {
-      fill_elem_graph_map( iwork );
-    }
-  }
-
-  //------------------------------------
-  // parallel_scan: row offsets
-
-  typedef unsigned value_type ;
-
-  KOKKOS_INLINE_FUNCTION
-  void operator()( const unsigned irow , unsigned & update , const bool final ) const
-  {
-    // exclusive scan
-    if ( final ) { row_map( irow ) = update ; }
-
-    update += row_count( irow );
-
-    if ( final ) {
-      if ( irow + 1 == row_count.extent(0) ) {
-        row_map( irow + 1 ) = update ;
-        row_total()         = update ;
-      }
-    }
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void init( unsigned & update ) const { update = 0 ; }
-
-  KOKKOS_INLINE_FUNCTION
-  void join( volatile unsigned & update , const volatile unsigned & input ) const { update += input ; }
-
-  //------------------------------------
-};
-
-} /* namespace FENL */
-} /* namespace Example */
-} /* namespace Kokkos  */
+#include <KokkosSparse_assembly.hpp>
 
 //----------------------------------------------------------------------------
-
-namespace Kokkos {
-namespace Example {
-namespace FENL {
-
-template< class ElemCompType >
-class NodeElemGatherFill {
-public:
-
-  typedef typename ElemCompType::execution_space         execution_space ;
-  typedef typename ElemCompType::vector_type         vector_type ;
-  typedef typename ElemCompType::sparse_matrix_type  sparse_matrix_type ;
-  typedef typename ElemCompType::elem_node_type      elem_node_type ;
-  typedef typename ElemCompType::elem_vectors_type   elem_vectors_type ;
-  typedef typename ElemCompType::elem_matrices_type  elem_matrices_type ;
-  typedef typename ElemCompType::elem_graph_type     elem_graph_type ;
-
-  static const unsigned ElemNodeCount = ElemCompType::ElemNodeCount ;
-
-  //------------------------------------
-
-private:
-
-  typedef Kokkos::StaticCrsGraph< unsigned[2] , execution_space >  CrsGraphType ;
-  typedef typename CrsGraphType::row_map_type::non_const_type  RowMapType ;
-  typedef Kokkos::View< unsigned ,  execution_space >              UnsignedValue ;
-
-  enum PhaseType { FILL_NODE_COUNT ,
-                   SCAN_NODE_COUNT ,
-                   FILL_GRAPH_ENTRIES ,
-                   SORT_GRAPH_ENTRIES ,
-                   GATHER_FILL };
-
-  const elem_node_type  elem_node_id ;
-  const elem_graph_type elem_graph ;
-  UnsignedValue         row_total ;
-  RowMapType            row_count ;
-  RowMapType            row_map ;
-  CrsGraphType          graph ;
-  vector_type           residual ;
-  sparse_matrix_type    jacobian ;
-  elem_vectors_type     elem_residual ;
-  elem_matrices_type    elem_jacobian ;
-  PhaseType             phase ;
-
-public:
-
-  NodeElemGatherFill()
-    : elem_node_id()
-    , elem_graph()
-    , row_total()
-    , row_count()
-    , row_map()
-    , graph()
-    , residual()
-    , jacobian()
-    , elem_residual()
-    , elem_jacobian()
-    , phase( FILL_NODE_COUNT )
-    {}
-
-  NodeElemGatherFill( const NodeElemGatherFill & rhs )
-    : elem_node_id(  rhs.elem_node_id )
-    , elem_graph(    rhs.elem_graph )
-    , row_total(     rhs.row_total )
-    , row_count(     rhs.row_count )
-    , row_map(       rhs.row_map )
-    , graph(         rhs.graph )
-    , residual(      rhs.residual )
-    , jacobian(      rhs.jacobian )
-    , elem_residual( rhs.elem_residual )
-    , elem_jacobian( rhs.elem_jacobian )
-    , phase(         rhs.phase )
-    {}
-
-  NodeElemGatherFill( const elem_node_type     & arg_elem_node_id ,
-                      const elem_graph_type    & arg_elem_graph ,
-                      const vector_type        & arg_residual ,
-                      const sparse_matrix_type & arg_jacobian ,
-                      const elem_vectors_type  & arg_elem_residual ,
-                      const elem_matrices_type & arg_elem_jacobian )
-    : elem_node_id( arg_elem_node_id )
-    , elem_graph( arg_elem_graph )
-    , row_total( "row_total" )
-    , row_count( "row_count" , arg_residual.extent(0) )
-    , row_map( "graph_row_map" , arg_residual.extent(0) + 1 )
-    , graph()
-    , residual( arg_residual )
-    , jacobian( arg_jacobian )
-    , elem_residual( arg_elem_residual )
-    , elem_jacobian( arg_elem_jacobian )
-    , phase( FILL_NODE_COUNT )
-    {
-      //--------------------------------
-      // Count node->element relations
-
-      phase = FILL_NODE_COUNT ;
-
-      Kokkos::parallel_for( elem_node_id.extent(0) , *this );
-
-      //--------------------------------
-
-      phase = SCAN_NODE_COUNT ;
-
-      // Exclusive scan of row_count into row_map
-      // including the final total in the 'node_count + 1' position.
-      // Zero the 'row_count' values.
-      Kokkos::parallel_scan( residual.extent(0) , *this );
-
-      // Zero the row count for the fill:
-      Kokkos::deep_copy( row_count , typename RowMapType::value_type(0) );
-
-      unsigned graph_entry_count = 0 ;
-
-      Kokkos::deep_copy( graph_entry_count , row_total );
-
-      // Assign graph's row_map and allocate graph's entries
-      graph.row_map = row_map ;
-
-      typedef typename CrsGraphType::entries_type graph_entries_type ;
-
-      graph.entries = graph_entries_type( "graph_entries" , graph_entry_count );
-
-      //--------------------------------
-      // Fill graph's entries from the (node,node) set.
-
-      phase = FILL_GRAPH_ENTRIES ;
-
-      Kokkos::deep_copy( row_count , 0u );
-      Kokkos::parallel_for( elem_node_id.extent(0) , *this );
-
-      execution_space::fence();
-
-      //--------------------------------
-      // Done with the temporary sets and arrays
-
-      row_total = UnsignedValue();
-      row_count = RowMapType();
-      row_map   = RowMapType();
-
-      //--------------------------------
-
-      phase = SORT_GRAPH_ENTRIES ;
-      Kokkos::parallel_for( residual.extent(0) , *this );
-
-      execution_space::fence();
-
-      phase = GATHER_FILL ;
-    }
-
-  void apply() const
-  {
-    Kokkos::parallel_for( residual.extent(0) , *this );
-  }
-
-  //------------------------------------
-  //------------------------------------
-  // parallel_for: Count node->element pairs
-
-  KOKKOS_INLINE_FUNCTION
-  void fill_node_count( const unsigned ielem ) const
-  {
-    for ( unsigned row_local_node = 0 ; row_local_node < elem_node_id.extent(1) ; ++row_local_node ) {
-
-      const unsigned row_node = elem_node_id( ielem , row_local_node );
-
-      if ( row_node < row_count.extent(0) ) {
-        atomic_fetch_add( & row_count( row_node ) , 1 );
-      }
-    }
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void fill_graph_entries( const unsigned ielem ) const
-  {
-    for ( unsigned row_local_node = 0 ; row_local_node < elem_node_id.extent(1) ; ++row_local_node ) {
-
-      const unsigned row_node = elem_node_id( ielem , row_local_node );
-
-      if ( row_node < row_count.extent(0) ) {
-
-        const unsigned offset = graph.row_map( row_node ) + atomic_fetch_add( & row_count( row_node ) , 1 );
-
-        graph.entries( offset , 0 ) = ielem ;
-        graph.entries( offset , 1 ) = row_local_node ;
-      }
-    }
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void sort_graph_entries( const unsigned irow ) const
-  {
-    const unsigned row_beg = graph.row_map( irow );
-    const unsigned row_end = graph.row_map( irow + 1 );
-    for ( unsigned i = row_beg + 1 ; i < row_end ; ++i ) {
-      const unsigned elem  = graph.entries(i,0);
-      const unsigned local = graph.entries(i,1);
-      unsigned j = i ;
-      for ( ; row_beg < j && elem < graph.entries(j-1,0) ; --j ) {
-        graph.entries(j,0) = graph.entries(j-1,0);
-        graph.entries(j,1) = graph.entries(j-1,1);
-      }
-      graph.entries(j,0) = elem ;
-      graph.entries(j,1) = local ;
-    }
-  }
-
-  //------------------------------------
-
-  KOKKOS_INLINE_FUNCTION
-  void gather_fill( const unsigned irow ) const
-  {
-    const unsigned node_elem_begin = graph.row_map(irow);
-    const unsigned node_elem_end   = graph.row_map(irow+1);
-
-    //  for each element that a node belongs to
-
-    for ( unsigned i = node_elem_begin ; i < node_elem_end ; i++ ) {
-
-      const unsigned elem_id   = graph.entries( i, 0);
-      const unsigned row_index = graph.entries( i, 1);
-
-      residual(irow) += elem_residual(elem_id, row_index);
-
-      //  for each node in a particular related element
-      //  gather the contents of the element stiffness
-      //  matrix that belong in irow
-
-      for ( unsigned j = 0 ; j < ElemNodeCount ; ++j ) {
-        const unsigned A_index = elem_graph( elem_id , row_index , j );
-
-        jacobian.values( A_index ) += elem_jacobian( elem_id, row_index, j );
-      }
-    }
-  }
-
-  //------------------------------------
-
-  KOKKOS_INLINE_FUNCTION
-  void operator()( const unsigned iwork ) const
-  {
-    if ( phase == FILL_NODE_COUNT ) {
-      fill_node_count( iwork );
-    }
-    else if ( phase == FILL_GRAPH_ENTRIES ) {
-      fill_graph_entries( iwork );
-    }
-    else if ( phase == SORT_GRAPH_ENTRIES ) {
-      sort_graph_entries( iwork );
-    }
-    else if ( phase == GATHER_FILL ) {
-      gather_fill( iwork );
-    }
-  }
-
-  //------------------------------------
-  // parallel_scan: row offsets
-
-  typedef unsigned value_type ;
-
-  KOKKOS_INLINE_FUNCTION
-  void operator()( const unsigned irow , unsigned & update , const bool final ) const
-  {
-    // exclusive scan
-    if ( final ) { row_map( irow ) = update ; }
-
-    update += row_count( irow );
-
-    if ( final ) {
-      if ( irow + 1 == row_count.extent(0) ) {
-        row_map( irow + 1 ) = update ;
-        row_total()         = update ;
-      }
-    }
-  }
-
-  KOKKOS_INLINE_FUNCTION
-  void init( unsigned & update ) const { update = 0 ; }
-
-  KOKKOS_INLINE_FUNCTION
-  void join( volatile unsigned & update , const volatile unsigned & input ) const { update += input ; }
-};
-
-} /* namespace FENL */
-} /* namespace Example */
-} /* namespace Kokkos  */
-
 //----------------------------------------------------------------------------
 
 namespace Kokkos {
@@ -699,7 +104,8 @@ public:
   typedef Kokkos::View< scalar_type*[FunctionCount] ,                execution_space > elem_vectors_type ;
   typedef Kokkos::View< scalar_type* ,                               execution_space > vector_type ;
 
-  typedef typename NodeNodeGraph< elem_node_type , sparse_graph_type , ElemNodeCount >::ElemGraphType elem_graph_type ;
+  typedef KokkosSparse::Experimental::AssemblyGraph< sparse_graph_type , elem_node_type > assembly_graph_type ;
+  typedef typename assembly_graph_type::elem_graph_type elem_graph_type ;
 
   //------------------------------------
 
@@ -732,7 +138,8 @@ public:
     {}
 
   // If the element->sparse_matrix graph is provided then perform atomic updates
-  // Otherwise fill per-element contributions for subequent gather-add into a residual and jacobian.
+  // Otherwise fill per-element contributions for subequent atomic-free
+  // gather-add into a residual and jacobian by assembly_graph_type::gather.
   ElementComputation( const mesh_type          & arg_mesh ,
 	              const scalar_type          arg_coeff_K ,
                       const vector_type        & arg_solution ,
@@ -999,7 +406,7 @@ if ( 1 == ielem ) {
 
           for( unsigned j = 0 ; j < FunctionCount ; j++ ) {
             const unsigned entry = elem_graph( ielem , i , j );
-            if ( entry != ~0u ) {
+            if ( entry != assembly_graph_type::invalid_offset() ) {
               atomic_fetch_add( & jacobian.values( entry ) , elem_mat[i][j] );
             }
           }
@@ -1131,6 +538,318 @@ public:
   }
 };
 
+//----------------------------------------------------------------------------
+/** \brief  Matrix-free Jacobian of the nonlinear element computation with
+ *          the Dirichlet conditions of DirichletComputation, as a linear
+ *          operator for KokkosSparse_linear_operator.hpp.
+ *
+ *  apply( x , y ) evaluates y = J x element by element with the
+ *  sum-factorized HexElement_TensorEval, so the Jacobian is never formed:
+ *  per element it reads the nodal coordinates, solution and x instead of
+ *  the ElemNodeCount^2 matrix entries.  Boundary rows are the identity
+ *  and boundary columns are zero, as DirichletComputation leaves the
+ *  assembled Jacobian.  x has the owned and received nodes, y the owned.
+ */
+template< class FixtureType , class SparseMatrixType >
+class JacobianOperator ;
+
+template< class DeviceType , BoxElemPart::ElemOrder Order , class CoordinateMap ,
+          typename ScalarType , typename OrdinalType , class MemoryTraits , typename SizeType >
+class JacobianOperator<
+  Kokkos::Example::BoxElemFixture< DeviceType , Order , CoordinateMap > ,
+  KokkosSparse::CrsMatrix< ScalarType , OrdinalType , DeviceType , MemoryTraits , SizeType > >
+{
+public:
+
+  typedef Kokkos::Example::BoxElemFixture< DeviceType, Order, CoordinateMap >  mesh_type ;
+  typedef Kokkos::Example::HexElement_Data< mesh_type::ElemNode >              element_data_type ;
+  typedef Kokkos::Example::HexElement_TensorEval< mesh_type::ElemNode , DeviceType > tensor_eval_type ;
+  typedef typename mesh_type::node_coord_type                                  node_coord_type ;
+  typedef typename mesh_type::elem_node_type                                   elem_node_type ;
+  typedef typename node_coord_type::value_type                                 scalar_coord_type ;
+
+  typedef DeviceType   execution_space ;
+  typedef ScalarType   scalar_type ;
+  typedef ScalarType   non_const_value_type ;
+  typedef OrdinalType  non_const_ordinal_type ;
+  typedef SizeType     non_const_size_type ;
+
+  static const unsigned SpatialDim       = element_data_type::spatial_dimension ;
+  static const unsigned ElemNodeCount    = element_data_type::element_node_count ;
+  static const unsigned IntegrationCount = element_data_type::integration_count ;
+
+  typedef Kokkos::View< scalar_type* , execution_space > vector_type ;
+
+  //------------------------------------
+  // Computational data:
+
+  const tensor_eval_type    tensor_eval ;
+  const element_data_type   elem_data ;
+  const elem_node_type      elem_node_ids ;
+  const node_coord_type     node_coords ;
+  const vector_type         solution ;
+  const scalar_type         coeff_K ;
+  const scalar_coord_type   bc_lower_limit ;
+  const scalar_coord_type   bc_upper_limit ;
+  const unsigned            bc_plane ;
+  const unsigned            node_count ;
+
+  JacobianOperator( const JacobianOperator & rhs )
+    : tensor_eval()
+    , elem_data()
+    , elem_node_ids(  rhs.elem_node_ids )
+    , node_coords(    rhs.node_coords )
+    , solution(       rhs.solution )
+    , coeff_K(        rhs.coeff_K )
+    , bc_lower_limit( rhs.bc_lower_limit )
+    , bc_upper_limit( rhs.bc_upper_limit )
+    , bc_plane(       rhs.bc_plane )
+    , node_count(     rhs.node_count )
+    {}
+
+  JacobianOperator( const mesh_type   & arg_mesh ,
+                    const scalar_type   arg_coeff_K ,
+                    const vector_type & arg_solution ,
+                    const unsigned      arg_bc_plane )
+    : tensor_eval()
+    , elem_data()
+    , elem_node_ids(  arg_mesh.elem_node() )
+    , node_coords(    arg_mesh.node_coord() )
+    , solution(       arg_solution )
+    , coeff_K(        arg_coeff_K )
+    , bc_lower_limit( std::numeric_limits<scalar_coord_type>::epsilon() )
+    , bc_upper_limit( scalar_coord_type(1) - std::numeric_limits<scalar_coord_type>::epsilon() )
+    , bc_plane(       arg_bc_plane )
+    , node_count(     arg_mesh.node_count_owned() )
+    {}
+
+  OrdinalType numRows() const { return node_count ; }
+  OrdinalType numCols() const { return solution.extent(0); }
+
+  //------------------------------------
+
+  template< class XVector , class YVector >
+  struct ApplyFunctor {
+    const JacobianOperator op ;
+    const XVector x ;
+    const YVector y ;
+
+    ApplyFunctor( const JacobianOperator & arg_op , const XVector & arg_x , const YVector & arg_y )
+      : op( arg_op ), x( arg_x ), y( arg_y ) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()( const unsigned ielem ) const { op.apply_element( ielem , x , y ); }
+  };
+
+  template< class DVector >
+  struct DiagonalFunctor {
+    const JacobianOperator op ;
+    const DVector d ;
+
+    DiagonalFunctor( const JacobianOperator & arg_op , const DVector & arg_d )
+      : op( arg_op ), d( arg_d ) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()( const unsigned ielem ) const { op.diagonal_element( ielem , d ); }
+  };
+
+  // Boundary rows of y are the rows of x.
+  template< class XVector , class YVector >
+  struct BoundaryFunctor {
+    const JacobianOperator op ;
+    const XVector x ;
+    const YVector y ;
+
+    BoundaryFunctor( const JacobianOperator & arg_op , const XVector & arg_x , const YVector & arg_y )
+      : op( arg_op ), x( arg_x ), y( arg_y ) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()( const unsigned inode ) const
+    { if ( op.is_boundary( inode ) ) { y( inode ) = x( inode ); } }
+  };
+
+  /** \brief  y = J x */
+  template< class XVector , class YVector >
+  void apply( const XVector & x , const YVector & y ) const
+  {
+    Kokkos::deep_copy( y , scalar_type(0) );
+    parallel_for( elem_node_ids.extent(0) , ApplyFunctor< XVector , YVector >( *this , x , y ) );
+    parallel_for( node_count , BoundaryFunctor< XVector , YVector >( *this , x , y ) );
+  }
+
+  /** \brief  d = diag( J ), with the ElemNodeCount^2 evaluations of the
+   *          HexElement_Data tables per element.
+   */
+  template< class DVector >
+  void diagonal( const DVector & d ) const
+  {
+    vector_type one( "one" , solution.extent(0) );
+    Kokkos::deep_copy( one , scalar_type(1) );
+    Kokkos::deep_copy( d , scalar_type(0) );
+    parallel_for( elem_node_ids.extent(0) , DiagonalFunctor< DVector >( *this , d ) );
+    parallel_for( node_count , BoundaryFunctor< vector_type , DVector >( *this , one , d ) );
+  }
+
+  //------------------------------------
+
+  KOKKOS_INLINE_FUNCTION
+  bool is_boundary( const unsigned inode ) const
+  {
+    const scalar_coord_type c = node_coords( inode , bc_plane );
+    return c <= bc_lower_limit || bc_upper_limit <= c ;
+  }
+
+  // invJ = J^{-1} for J[ a * 3 + b ] = d x_b / d xi_a , returns det(J).
+  KOKKOS_INLINE_FUNCTION
+  static double inverse_jacobian( const double J[] , double invJ[] )
+  {
+    invJ[0] = J[4] * J[8] - J[5] * J[7] ;
+    invJ[1] = J[2] * J[7] - J[1] * J[8] ;
+    invJ[2] = J[1] * J[5] - J[2] * J[4] ;
+    invJ[3] = J[5] * J[6] - J[3] * J[8] ;
+    invJ[4] = J[0] * J[8] - J[2] * J[6] ;
+    invJ[5] = J[2] * J[3] - J[0] * J[5] ;
+    invJ[6] = J[3] * J[7] - J[4] * J[6] ;
+    invJ[7] = J[1] * J[6] - J[0] * J[7] ;
+    invJ[8] = J[0] * J[4] - J[1] * J[3] ;
+
+    const double detJ = J[0] * invJ[0] + J[3] * invJ[1] + J[6] * invJ[2] ;
+    const double detJinv = 1.0 / detJ ;
+
+    for ( unsigned i = 0 ; i < 9 ; ++i ) { invJ[i] *= detJinv ; }
+
+    return detJ ;
+  }
+
+  template< class XVector , class YVector >
+  KOKKOS_INLINE_FUNCTION
+  void apply_element( const unsigned ielem , const XVector & x , const YVector & y ) const
+  {
+    double coords[ SpatialDim ][ ElemNodeCount ] ;
+    double val[ ElemNodeCount ] ;
+    double u[ ElemNodeCount ] ;
+    unsigned node_index[ ElemNodeCount ];
+
+    for ( unsigned i = 0 ; i < ElemNodeCount ; ++i ) {
+      const unsigned ni = elem_node_ids( ielem , i );
+
+      node_index[i] = ni ;
+
+      coords[0][i] = node_coords( ni , 0 );
+      coords[1][i] = node_coords( ni , 1 );
+      coords[2][i] = node_coords( ni , 2 );
+
+      val[i] = solution( ni );
+      u[i]   = is_boundary( ni ) ? 0 : x( ni );
+    }
+
+    double scratch[ IntegrationCount ] ;
+    double coords_grad[ SpatialDim ][ SpatialDim ][ IntegrationCount ] ;
+    double val_at_pt[ IntegrationCount ] ;
+    double u_at_pt[ IntegrationCount ] ;
+    double u_grad[ SpatialDim ][ IntegrationCount ] ;
+
+    for ( unsigned b = 0 ; b < SpatialDim ; ++b ) {
+      tensor_eval.gradient( coords[b] , scratch , coords_grad[b] );
+    }
+    tensor_eval.gradient( val , val_at_pt , u_grad );
+    tensor_eval.gradient( u , u_at_pt , u_grad );
+
+    // $$ (J u)_i = \int_{\Omega} k \nabla \phi_i \cdot \nabla u + 2 \phi_i T u d \Omega $$
+
+    for ( unsigned q = 0 ; q < IntegrationCount ; ++q ) {
+      double J[9] , invJ[9] ;
+      for ( unsigned a = 0 ; a < SpatialDim ; ++a ) {
+      for ( unsigned b = 0 ; b < SpatialDim ; ++b ) {
+        J[ a * 3 + b ] = coords_grad[b][a][q] ;
+      }}
+
+      const double detJ_weight = inverse_jacobian( J , invJ ) * tensor_eval.weights[q] ;
+      const double k_detJ_weight = coeff_K * detJ_weight ;
+
+      double flux[ SpatialDim ] ;
+      for ( unsigned b = 0 ; b < SpatialDim ; ++b ) {
+        flux[b] = k_detJ_weight * ( invJ[ b * 3 + 0 ] * u_grad[0][q] +
+                                    invJ[ b * 3 + 1 ] * u_grad[1][q] +
+                                    invJ[ b * 3 + 2 ] * u_grad[2][q] );
+      }
+      for ( unsigned a = 0 ; a < SpatialDim ; ++a ) {
+        u_grad[a][q] = invJ[ 0 * 3 + a ] * flux[0] +
+                       invJ[ 1 * 3 + a ] * flux[1] +
+                       invJ[ 2 * 3 + a ] * flux[2] ;
+      }
+      u_at_pt[q] *= 2.0 * val_at_pt[q] * detJ_weight ;
+    }
+
+    double elem_vec[ ElemNodeCount ] ;
+
+    tensor_eval.integrate( u_at_pt , u_grad , elem_vec );
+
+    for ( unsigned i = 0 ; i < ElemNodeCount ; ++i ) {
+      const unsigned row = node_index[i] ;
+      if ( row < node_count && ! is_boundary( row ) ) {
+        atomic_fetch_add( & y( row ) , elem_vec[i] );
+      }
+    }
+  }
+
+  template< class DVector >
+  KOKKOS_INLINE_FUNCTION
+  void diagonal_element( const unsigned ielem , const DVector & d ) const
+  {
+    double coords[ SpatialDim ][ ElemNodeCount ] ;
+    double val[ ElemNodeCount ] ;
+    double elem_vec[ ElemNodeCount ] ;
+
+    for ( unsigned i = 0 ; i < ElemNodeCount ; ++i ) {
+      const unsigned ni = elem_node_ids( ielem , i );
+
+      coords[0][i] = node_coords( ni , 0 );
+      coords[1][i] = node_coords( ni , 1 );
+      coords[2][i] = node_coords( ni , 2 );
+
+      val[i] = solution( ni );
+      elem_vec[i] = 0 ;
+    }
+
+    for ( unsigned ip = 0 ; ip < IntegrationCount ; ++ip ) {
+      double J[9] = { 0, 0, 0,  0, 0, 0,  0, 0, 0 } , invJ[9] ;
+      double value_at_pt = 0 ;
+
+      for ( unsigned i = 0 ; i < ElemNodeCount ; ++i ) {
+        value_at_pt += val[i] * elem_data.values[ip][i] ;
+        for ( unsigned a = 0 ; a < SpatialDim ; ++a ) {
+        for ( unsigned b = 0 ; b < SpatialDim ; ++b ) {
+          J[ a * 3 + b ] += elem_data.gradients[ip][a][i] * coords[b][i] ;
+        }}
+      }
+
+      const double detJ_weight = inverse_jacobian( J , invJ ) * elem_data.weights[ip] ;
+      const double k_detJ_weight = coeff_K * detJ_weight ;
+      const double mat_val = 2.0 * value_at_pt * detJ_weight ;
+
+      for ( unsigned i = 0 ; i < ElemNodeCount ; ++i ) {
+        double dpsi2 = 0 ;
+        for ( unsigned b = 0 ; b < SpatialDim ; ++b ) {
+          const double dpsi = invJ[ b * 3 + 0 ] * elem_data.gradients[ip][0][i] +
+                              invJ[ b * 3 + 1 ] * elem_data.gradients[ip][1][i] +
+                              invJ[ b * 3 + 2 ] * elem_data.gradients[ip][2][i] ;
+          dpsi2 += dpsi * dpsi ;
+        }
+        elem_vec[i] += k_detJ_weight * dpsi2 +
+                       mat_val * elem_data.values[ip][i] * elem_data.values[ip][i] ;
+      }
+    }
+
+    for ( unsigned i = 0 ; i < ElemNodeCount ; ++i ) {
+      const unsigned row = elem_node_ids( ielem , i );
+      if ( row < node_count && ! is_boundary( row ) ) {
+        atomic_fetch_add( & d( row ) , elem_vec[i] );
+      }
+    }
+  }
+}; /* JacobianOperator */
+
 } /* namespace FENL */
 } /* namespace Example */
 } /* namespace Kokkos  */
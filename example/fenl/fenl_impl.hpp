@@ -48,7 +48,6 @@
 
 // Kokkos libraries' headers:
 
-#include <Kokkos_UnorderedMap.hpp>
 #include <Kokkos_StaticCrsGraph.hpp>
 #include <KokkosSparse_spmv.hpp>
 #include <Kokkos_Blas1.hpp>
@@ -156,6 +155,7 @@ Perf fenl(
   const int use_print ,
   const int use_trials ,
   const int use_atomic ,
+  const int use_pipelined ,
   const int use_elems[] )
 {
   typedef Kokkos::Example::BoxElemFixture< Device , ElemOrder > FixtureType ;
@@ -166,8 +166,8 @@ Perf fenl(
   typedef typename SparseMatrixType::StaticCrsGraphType
     SparseGraphType ;
 
-  typedef Kokkos::Example::FENL::NodeNodeGraph< typename FixtureType::elem_node_type , SparseGraphType , FixtureType::ElemNode >
-     NodeNodeGraphType ;
+  typedef KokkosSparse::Experimental::AssemblyGraph< SparseGraphType , typename FixtureType::elem_node_type >
+     AssemblyGraphType ;
 
   typedef Kokkos::Example::FENL::ElementComputation< FixtureType , SparseMatrixType >
     ElementComputationType ;
@@ -175,9 +175,6 @@ Perf fenl(
   typedef Kokkos::Example::FENL::DirichletComputation< FixtureType , SparseMatrixType >
     DirichletComputationType ;
 
-  typedef NodeElemGatherFill< ElementComputationType >
-    NodeElemGatherFillType ;
-
   typedef typename ElementComputationType::vector_type VectorType ;
 
   typedef Kokkos::Example::VectorImport<
@@ -326,21 +323,21 @@ Perf fenl(
     perf.global_node_count = fixture.node_count_global();
 
     //----------------------------------
-    // Create the sparse matrix graph and element-to-graph map
-    // from the element->to->node identifier array.
+    // Create the sparse matrix graph, element-to-graph map and
+    // node-to-element map from the element->to->node identifier array.
     // The graph only has rows for the owned nodes.
 
-    typename NodeNodeGraphType::Times graph_times;
+    typename AssemblyGraphType::Times graph_times;
 
-    const NodeNodeGraphType
-      mesh_to_graph( fixture.elem_node() , fixture.node_count_owned(), graph_times );
+    const AssemblyGraphType
+      mesh_to_graph( fixture.elem_node() , fixture.node_count_owned(), & graph_times );
 
-    perf.map_ratio          = maximum(comm, graph_times.ratio);
-    perf.fill_node_set      = maximum(comm, graph_times.fill_node_set);
-    perf.scan_node_count    = maximum(comm, graph_times.scan_node_count);
-    perf.fill_graph_entries = maximum(comm, graph_times.fill_graph_entries);
-    perf.sort_graph_entries = maximum(comm, graph_times.sort_graph_entries);
-    perf.fill_element_graph = maximum(comm, graph_times.fill_element_graph);
+    perf.graph_ratio        = maximum(comm, graph_times.ratio);
+    perf.fill_node_elem     = maximum(comm, graph_times.node_elem);
+    perf.fill_candidates    = maximum(comm, graph_times.candidates);
+    perf.sort_candidates    = maximum(comm, graph_times.sort);
+    perf.fill_graph_entries = maximum(comm, graph_times.graph);
+    perf.fill_element_graph = maximum(comm, graph_times.elem_graph);
 
     wall_clock.reset();
     // Create the sparse matrix from the graph:
@@ -401,15 +398,6 @@ Perf fenl(
                                            mesh_to_graph.elem_graph , jacobian , nodal_residual )
                  : ElementComputationType( fixture , manufactured_solution.K , nodal_solution ) );
 
-    const NodeElemGatherFillType gatherfill(
-      use_atomic ? NodeElemGatherFillType()
-                 : NodeElemGatherFillType( fixture.elem_node() ,
-                                           mesh_to_graph.elem_graph ,
-                                           nodal_residual ,
-                                           jacobian ,
-                                           elemcomp.elem_residuals ,
-                                           elemcomp.elem_jacobians ) );
-
     // Create boundary condition functor
     const DirichletComputationType dirichlet(
       fixture , nodal_solution , jacobian , nodal_residual ,
@@ -441,7 +429,8 @@ Perf fenl(
       elemcomp.apply();
 
       if ( ! use_atomic ) {
-        gatherfill.apply();
+        mesh_to_graph.gather( elemcomp.elem_residuals , elemcomp.elem_jacobians ,
+                              nodal_residual , jacobian.values );
       }
 
       Device::fence();
@@ -474,17 +463,35 @@ Perf fenl(
       //--------------------------------
       // Solve for nonlinear update
 
-      CGSolve< ImportType , SparseMatrixType , VectorType >
-        cgsolve( comm_nodal_import , jacobian, nodal_residual, nodal_delta ,
-                 cg_iteration_limit , cg_iteration_tolerance );
+      size_t cg_iteration = 0 ;
+      double cg_residual = 0 ;
+
+      if ( use_pipelined ) {
+        PipelinedCGSolve< ImportType , SparseMatrixType , VectorType >
+          cgsolve( comm_nodal_import , jacobian, nodal_residual, nodal_delta ,
+                   cg_iteration_limit , cg_iteration_tolerance );
+
+        cg_iteration = cgsolve.iteration ;
+        cg_residual  = cgsolve.norm_res ;
+        perf.matvec_time += cgsolve.matvec_time ;
+        perf.cg_time     += cgsolve.iter_time ;
+      }
+      else {
+        CGSolve< ImportType , SparseMatrixType , VectorType >
+          cgsolve( comm_nodal_import , jacobian, nodal_residual, nodal_delta ,
+                   cg_iteration_limit , cg_iteration_tolerance );
+
+        cg_iteration = cgsolve.iteration ;
+        cg_residual  = cgsolve.norm_res ;
+        perf.matvec_time += cgsolve.matvec_time ;
+        perf.cg_time     += cgsolve.iter_time ;
+      }
 
       // Update solution vector
 
       KokkosBlas::axpby( -1.0 , nodal_delta , 1.0 , nodal_solution );
 
-      perf.cg_iter_count += cgsolve.iteration ;
-      perf.matvec_time   += cgsolve.matvec_time ;
-      perf.cg_time       += cgsolve.iter_time ;
+      perf.cg_iter_count += cg_iteration ;
 
       //--------------------------------
 
@@ -498,8 +505,8 @@ Perf fenl(
           std::cout << "Newton iteration[" << perf.newton_iter_count << "]"
                     << " residual[" << perf.newton_residual << "]"
                     << " update[" << delta_norm << "]"
-                    << " cg_iteration[" << cgsolve.iteration << "]"
-                    << " cg_residual[" << cgsolve.norm_res << "]"
+                    << " cg_iteration[" << cg_iteration << "]"
+                    << " cg_residual[" << cg_residual << "]"
                     << std::endl ;
         }
 
@@ -572,10 +579,10 @@ Perf fenl(
       perf_stats = perf ;
     }
     else {
-      perf_stats.fill_node_set = std::min( perf_stats.fill_node_set , perf.fill_node_set );
-      perf_stats.scan_node_count = std::min( perf_stats.scan_node_count , perf.scan_node_count );
+      perf_stats.fill_node_elem = std::min( perf_stats.fill_node_elem , perf.fill_node_elem );
+      perf_stats.fill_candidates = std::min( perf_stats.fill_candidates , perf.fill_candidates );
+      perf_stats.sort_candidates = std::min( perf_stats.sort_candidates , perf.sort_candidates );
       perf_stats.fill_graph_entries = std::min( perf_stats.fill_graph_entries , perf.fill_graph_entries );
-      perf_stats.sort_graph_entries = std::min( perf_stats.sort_graph_entries , perf.sort_graph_entries );
       perf_stats.fill_element_graph = std::min( perf_stats.fill_element_graph , perf.fill_element_graph );
       perf_stats.create_sparse_matrix = std::min( perf_stats.create_sparse_matrix , perf.create_sparse_matrix );
       perf_stats.fill_time = std::min( perf_stats.fill_time , perf.fill_time );
@@ -77,6 +77,7 @@ enum { CMD_USE_THREADS = 0
      , CMD_USE_FIXTURE_END
      , CMD_USE_FIXTURE_QUADRATIC
      , CMD_USE_ATOMIC
+     , CMD_USE_PIPELINED
      , CMD_USE_TRIALS
      , CMD_VTUNE
      , CMD_PRINT
@@ -118,6 +119,9 @@ void print_cmdline( std::ostream & s , const int cmd[] )
   if ( cmd[ CMD_USE_ATOMIC ] ) {
     s << " ATOMIC" ;
   }
+  if ( cmd[ CMD_USE_PIPELINED ] ) {
+    s << " PIPELINED-CG" ;
+  }
   if ( cmd[ CMD_USE_TRIALS ] ) {
     s << " TRIALS(" << cmd[ CMD_USE_TRIALS ] << ")" ;
   }
@@ -137,11 +141,11 @@ void print_perf_value( std::ostream & s , const std::vector<size_t> & widths,  c
   s << std::setw(widths[i++]) << perf.global_node_count << " ,";
   s << std::setw(widths[i++]) << perf.newton_iter_count << " ,";
   s << std::setw(widths[i++]) << perf.cg_iter_count << " ,";
-  s << std::setw(widths[i++]) << perf.map_ratio << " ,";
-  s << std::setw(widths[i++]) << ( perf.fill_node_set * 1000.0 ) / perf.global_node_count << " ,";
-  s << std::setw(widths[i++]) << ( perf.scan_node_count * 1000.0 ) / perf.global_node_count << " ,";
+  s << std::setw(widths[i++]) << perf.graph_ratio << " ,";
+  s << std::setw(widths[i++]) << ( perf.fill_node_elem * 1000.0 ) / perf.global_node_count << " ,";
+  s << std::setw(widths[i++]) << ( perf.fill_candidates * 1000.0 ) / perf.global_node_count << " ,";
+  s << std::setw(widths[i++]) << ( perf.sort_candidates * 1000.0 ) / perf.global_node_count << " ,";
   s << std::setw(widths[i++]) << ( perf.fill_graph_entries * 1000.0 ) / perf.global_node_count << " ,";
-  s << std::setw(widths[i++]) << ( perf.sort_graph_entries * 1000.0 ) / perf.global_node_count << " ,";
   s << std::setw(widths[i++]) << ( perf.fill_element_graph * 1000.0 ) / perf.global_node_count << " ,";
   s << std::setw(widths[i++]) << ( perf.create_sparse_matrix * 1000.0 ) / perf.global_node_count << " ,";
   s << std::setw(widths[i++]) << ( perf.fill_time * 1000.0 ) / perf.global_node_count << " ,";
@@ -176,6 +180,8 @@ void run( MPI_Comm comm , const int cmd[] )
     else { std::cout << " , LINEAR-ELEMENT" ; }
 
     if ( cmd[ CMD_USE_ATOMIC ] ) { std::cout << " , USING ATOMICS" ; }
+
+    if ( cmd[ CMD_USE_PIPELINED ] ) { std::cout << " , PIPELINED CG" ; }
   }
 
   std::vector< std::pair<std::string,std::string> > headers;
@@ -185,11 +191,11 @@ void run( MPI_Comm comm , const int cmd[] )
   headers.push_back(std::make_pair("NODES","count"));
   headers.push_back(std::make_pair("NEWTON","iter"));
   headers.push_back(std::make_pair("CG","iter"));
-  headers.push_back(std::make_pair("MAP_RATIO","ratio"));
-  headers.push_back(std::make_pair("SET_FILL/NODE","millisec"));
-  headers.push_back(std::make_pair("SCAN/NODE","millisec"));
-  headers.push_back(std::make_pair("GRAPH_FILL/NODE","millisec"));
+  headers.push_back(std::make_pair("GRAPH_RATIO","ratio"));
+  headers.push_back(std::make_pair("NODE_ELEM/NODE","millisec"));
+  headers.push_back(std::make_pair("CANDIDATES/NODE","millisec"));
   headers.push_back(std::make_pair("SORT/NODE","millisec"));
+  headers.push_back(std::make_pair("GRAPH_FILL/NODE","millisec"));
   headers.push_back(std::make_pair("ELEM_GRAPH_FILL/NODE","millisec"));
   headers.push_back(std::make_pair("MATRIX_CREATE/NODE","millisec"));
   headers.push_back(std::make_pair("MATRIX_FILL/NODE","millisec"));
@@ -228,9 +234,9 @@ void run( MPI_Comm comm , const int cmd[] )
       const Kokkos::Example::FENL::Perf perf =
         cmd[ CMD_USE_FIXTURE_QUADRATIC ]
         ? Kokkos::Example::FENL::fenl< Device , Kokkos::Example::BoxElemPart::ElemQuadratic >
-            ( comm , cmd[CMD_PRINT], cmd[CMD_USE_TRIALS], cmd[CMD_USE_ATOMIC], nelem )
+            ( comm , cmd[CMD_PRINT], cmd[CMD_USE_TRIALS], cmd[CMD_USE_ATOMIC], cmd[CMD_USE_PIPELINED], nelem )
         : Kokkos::Example::FENL::fenl< Device , Kokkos::Example::BoxElemPart::ElemLinear >
-            ( comm , cmd[CMD_PRINT], cmd[CMD_USE_TRIALS], cmd[CMD_USE_ATOMIC], nelem )
+            ( comm , cmd[CMD_PRINT], cmd[CMD_USE_TRIALS], cmd[CMD_USE_ATOMIC], cmd[CMD_USE_PIPELINED], nelem )
         ;
 
       if ( 0 == comm_rank ) print_perf_value( std::cout , widths, perf );
@@ -244,9 +250,9 @@ void run( MPI_Comm comm , const int cmd[] )
     const Kokkos::Example::FENL::Perf perf =
       cmd[ CMD_USE_FIXTURE_QUADRATIC ]
       ? Kokkos::Example::FENL::fenl< Device , Kokkos::Example::BoxElemPart::ElemQuadratic >
-          ( comm , cmd[CMD_PRINT], cmd[CMD_USE_TRIALS], cmd[CMD_USE_ATOMIC], nelem )
+          ( comm , cmd[CMD_PRINT], cmd[CMD_USE_TRIALS], cmd[CMD_USE_ATOMIC], cmd[CMD_USE_PIPELINED], nelem )
       : Kokkos::Example::FENL::fenl< Device , Kokkos::Example::BoxElemPart::ElemLinear >
-          ( comm , cmd[CMD_PRINT], cmd[CMD_USE_TRIALS], cmd[CMD_USE_ATOMIC], nelem )
+          ( comm , cmd[CMD_PRINT], cmd[CMD_USE_TRIALS], cmd[CMD_USE_ATOMIC], cmd[CMD_USE_PIPELINED], nelem )
       ;
 
     if ( 0 == comm_rank ) print_perf_value( std::cout , widths, perf );
@@ -312,6 +318,9 @@ int main( int argc , char ** argv )
       else if ( 0 == strcasecmp( argv[i] , "atomic" ) ) {
         cmdline[ CMD_USE_ATOMIC ] = 1 ;
       }
+      else if ( 0 == strcasecmp( argv[i] , "pipelined" ) ) {
+        cmdline[ CMD_USE_PIPELINED ] = 1 ;
+      }
       else if ( 0 == strcasecmp( argv[i] , "trials" ) ) {
         cmdline[ CMD_USE_TRIALS ] = atoi( argv[++i] ) ;
       }
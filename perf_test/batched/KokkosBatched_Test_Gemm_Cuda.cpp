@@ -22,6 +22,7 @@
 #include "KokkosBatched_Gemm_Decl.hpp"
 #include "KokkosBatched_Gemm_Serial_Impl.hpp"
 #include "KokkosBatched_Gemm_Team_Impl.hpp"
+#include "KokkosBatched_Gemm_TeamVector_Impl.hpp"
 
 namespace KokkosBatched {
   namespace Experimental {
@@ -44,6 +45,7 @@ namespace KokkosBatched {
       struct TeamTagV2 {};
       struct TeamTagV3 {};
       struct TeamTagHandmade {};
+      struct TeamVectorTag {};
 
       template<typename ViewType, typename AlgoTagType, int VectorLength = 0>
       struct Functor {
@@ -138,6 +140,21 @@ namespace KokkosBatched {
             });
         }
           
+        template<typename MemberType>
+        KOKKOS_INLINE_FUNCTION
+        void operator()(const TeamVectorTag &, const MemberType &member) const {
+          // a matrix per thread and its entries over the vector lanes
+          const int k = member.league_rank()*member.team_size() + member.team_rank();
+          if (k < int(_c.extent(0))) {
+            auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+            auto bb = Kokkos::subview(_b, k, Kokkos::ALL(), Kokkos::ALL());
+            auto cc = Kokkos::subview(_c, k, Kokkos::ALL(), Kokkos::ALL());
+
+            TeamVectorGemm<MemberType,Trans::NoTranspose,Trans::NoTranspose,Algo::Gemm::Unblocked>::
+              invoke(member, 1.0, aa, bb, 1.0, cc);
+          }
+        }
+
         template<typename MemberType>
         KOKKOS_INLINE_FUNCTION
         void operator()(const TeamTagHandmade &, const MemberType &member) const {
@@ -639,6 +656,76 @@ namespace KokkosBatched {
           }
         }
 
+        if (1) {
+          ///
+          /// TeamVector (a matrix per thread, entries over vector lanes; unblocked only)
+          ///
+          typedef Kokkos::View<value_type***,DeviceSpaceType> view_type;
+          view_type
+            a("a", N*VectorLength, BlkSize, BlkSize),
+            b("b", N*VectorLength, BlkSize, BlkSize),
+            c("c", N*VectorLength, BlkSize, BlkSize);
+
+          double tavg = 0, tmin = tmax;
+          {
+            typedef Kokkos::TeamPolicy<DeviceSpaceType,ScheduleType,TeamVectorTag> policy_type;
+
+            typedef Functor<view_type,AlgoTagType,VectorLength> functor_type;
+            typedef Kokkos::Impl::ParallelFor<functor_type,policy_type,DeviceSpaceType> parallel_for_type;
+
+            int vector_size = 1;
+            while (vector_size < BlkSize*BlkSize && vector_size < 32) vector_size *= 2;
+
+            const int max_cuda_blocksize = Kokkos::Impl::cuda_get_max_block_size<parallel_for_type>(functor_type(), vector_size, 0, 0);
+            const int team_size = min(256, max_cuda_blocksize)/vector_size;
+            const int league_size = (N*VectorLength)/team_size + ((N*VectorLength)%team_size > 0);
+
+            const policy_type policy(league_size, team_size, vector_size);
+            for (int iter=iter_begin;iter<iter_end;++iter) {
+              // flush
+              flush.run();
+
+              // initialize matrices
+              Kokkos::deep_copy(a, amat);
+              Kokkos::deep_copy(b, bmat);
+              Kokkos::deep_copy(c, 0);
+
+              DeviceSpaceType::fence();
+              timer.reset();
+
+              Kokkos::parallel_for(policy, functor_type(a,b,c));
+
+              DeviceSpaceType::fence();
+              const double t = timer.seconds();
+              tmin = std::min(tmin, t);
+              tavg += (iter >= 0)*t;
+            }
+            tavg /= iter_end;
+
+            auto csol = Kokkos::create_mirror_view(typename HostSpaceType::memory_space(), c);
+            Kokkos::deep_copy(csol, c);
+
+            double diff = 0;
+            for (int i=0,iend=cref.extent(0);i<iend;++i)
+              for (int j=0,jend=cref.extent(1);j<jend;++j)
+                for (int k=0,kend=cref.extent(2);k<kend;++k)
+                  diff += std::abs(cref(i,j,k) - csol(i,j,k));
+
+            std::cout << std::setw(8) << "Kokkos"
+                      << std::setw(8) << "TeamVec"
+                      << " BlkSize = " << std::setw(3) << BlkSize
+                      << " TeamSize = " << std::setw(3) << team_size
+                      << " VectorSize = " << std::setw(3) << vector_size
+                      << " time = " << std::scientific << tmin
+                      << " avg flop/s = " << (flop/tavg)
+                      << " max flop/s = " << (flop/tmin);
+#if defined(__KOKKOSKERNELS_NVIDIA_CUBLAS__)
+            std::cout << " diff to ref = " << diff;
+#endif
+            std::cout << std::endl;
+          }
+        }
+
         std::cout << std::endl;
       }
     }
@@ -3,6 +3,7 @@
 //#define __KOKKOSBATCHED_INTEL_MKL_BATCHED__
 
 #include <iomanip>
+#include <vector>
 
 #include "KokkosBatched_Util.hpp"
 #if defined(__KOKKOSBATCHED_LIBXSMM__)
@@ -18,6 +19,7 @@
 #include "Kokkos_Random.hpp"
 
 #include "KokkosBatched_Vector.hpp"
+#include "KokkosKernels_Benchmark.hpp"
 
 #include "KokkosBatched_Gemm_Decl.hpp"
 #include "KokkosBatched_Gemm_Serial_Impl.hpp"
@@ -47,17 +49,20 @@ namespace KokkosBatched {
                 FLOP_ADD*(m*n*k));
       }
     
-      template<int BlkSize, typename HostSpaceType, typename AlgoTagType>
-      void Gemm(const int NN) {
+      template<int BlkSize, typename HostSpaceType, typename AlgoTagType, typename ValueType = value_type>
+      void Gemm(const int NN, const std::string &algo_name, KokkosKernels::Experiment::BenchmarkReport &report) {
+        typedef ValueType value_type;
         typedef Kokkos::Schedule<Kokkos::Static> ScheduleType;
 
         constexpr int VectorLength = DefaultVectorLength<value_type,typename HostSpaceType::memory_space>::value;
         const int N = NN/VectorLength;
 
+        std::string value_type_name;
+        if (std::is_same<value_type,double>::value)                   value_type_name = "double";
+        if (std::is_same<value_type,Kokkos::complex<double> >::value) value_type_name = "Kokkos::complex<double>";
+        if (std::is_same<value_type,float>::value)                    value_type_name = "float";
+        if (std::is_same<value_type,Kokkos::complex<float> >::value)  value_type_name = "Kokkos::complex<float>";
         {
-          std::string value_type_name;
-          if (std::is_same<value_type,double>::value)                   value_type_name = "double";
-          if (std::is_same<value_type,Kokkos::complex<double> >::value) value_type_name = "Kokkos::complex<double>";
 #if   defined(__AVX512F__)
           std::cout << "AVX512 is defined: datatype " << value_type_name <<  " a vector length " << VectorLength << "\n";
 #elif defined(__AVX__) || defined(__AVX2__)
@@ -68,10 +73,8 @@ namespace KokkosBatched {
         }
 
         const double flop = (N*VectorLength)*FlopCount(BlkSize,BlkSize,BlkSize);
-        const double tmax = 1.0e15;
-
-        const int iter_begin = -10, iter_end = 100;
-        Kokkos::Impl::Timer timer;
+        // A and B are read, C is read and written
+        const double bytes = (N*VectorLength)*(4.0*BlkSize*BlkSize)*sizeof(value_type);
 
         Kokkos::View<value_type***,Kokkos::LayoutRight,HostSpaceType> cref;
         Kokkos::View<value_type***,Kokkos::LayoutRight,HostSpaceType> 
@@ -115,60 +118,74 @@ namespace KokkosBatched {
           {
             const Kokkos::RangePolicy<HostSpaceType,ScheduleType> policy(0, N*VectorLength);
           
-            double tavg = 0, tmin = tmax;
-            for (int iter=iter_begin;iter<iter_end;++iter) {
-              // flush
-              flush.run();
-
-              // initialize matrices
-              Kokkos::deep_copy(a, amat);
-              Kokkos::deep_copy(b, bmat);
-              Kokkos::deep_copy(c, 0);
-
-              HostSpaceType::fence();
-              timer.reset();
-
-              Kokkos::parallel_for
-                (policy, 
-                 KOKKOS_LAMBDA(const int k) {
-                  auto aa = Kokkos::subview(a, k, Kokkos::ALL(), Kokkos::ALL());
-                  auto bb = Kokkos::subview(b, k, Kokkos::ALL(), Kokkos::ALL());
-                  auto cc = Kokkos::subview(c, k, Kokkos::ALL(), Kokkos::ALL());
+            KokkosKernels::Experiment::BenchmarkResult result;
+            KokkosKernels::Experiment::run_benchmark<HostSpaceType>
+              (report.options(), result,
+               [&]() {
+                // flush
+                flush.run();
+
+                // initialize matrices
+                Kokkos::deep_copy(a, amat);
+                Kokkos::deep_copy(b, bmat);
+                Kokkos::deep_copy(c, 0);
+               },
+               [&]() {
+                Kokkos::parallel_for
+                  (policy, 
+                   KOKKOS_LAMBDA(const int k) {
+                    auto aa = Kokkos::subview(a, k, Kokkos::ALL(), Kokkos::ALL());
+                    auto bb = Kokkos::subview(b, k, Kokkos::ALL(), Kokkos::ALL());
+                    auto cc = Kokkos::subview(c, k, Kokkos::ALL(), Kokkos::ALL());
                 
-                  const double one = 1.0;
-                  if (std::is_same<value_type,double>::value) {
-                    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
-                                BlkSize, BlkSize, BlkSize,
-                                one,
-                                (double*)aa.data(), aa.stride_0(),
-                                (double*)bb.data(), bb.stride_0(),
-                                one,
-                                (double*)cc.data(), cc.stride_0());
-                  } else if (std::is_same<value_type,Kokkos::complex<double> >::value) {
-                    cblas_zgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
-                                BlkSize, BlkSize, BlkSize,
-                                (void*)&one,
-                                (void*)aa.data(), aa.stride_0(),
-                                (void*)bb.data(), bb.stride_0(),
-                                (void*)&one,
-                                (void*)cc.data(), cc.stride_0());
-                  } 
+                    const double one = 1.0;
+                    if (std::is_same<value_type,double>::value) {
+                      cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                                  BlkSize, BlkSize, BlkSize,
+                                  one,
+                                  (double*)aa.data(), aa.stride_0(),
+                                  (double*)bb.data(), bb.stride_0(),
+                                  one,
+                                  (double*)cc.data(), cc.stride_0());
+                    } else if (std::is_same<value_type,Kokkos::complex<double> >::value) {
+                      cblas_zgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                                  BlkSize, BlkSize, BlkSize,
+                                  (void*)&one,
+                                  (void*)aa.data(), aa.stride_0(),
+                                  (void*)bb.data(), bb.stride_0(),
+                                  (void*)&one,
+                                  (void*)cc.data(), cc.stride_0());
+                    } else if (std::is_same<value_type,float>::value) {
+                      const float onef = 1.0;
+                      cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                                  BlkSize, BlkSize, BlkSize,
+                                  onef,
+                                  (float*)aa.data(), aa.stride_0(),
+                                  (float*)bb.data(), bb.stride_0(),
+                                  onef,
+                                  (float*)cc.data(), cc.stride_0());
+                    } else if (std::is_same<value_type,Kokkos::complex<float> >::value) {
+                      const Kokkos::complex<float> onec(1.0);
+                      cblas_cgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                                  BlkSize, BlkSize, BlkSize,
+                                  (void*)&onec,
+                                  (void*)aa.data(), aa.stride_0(),
+                                  (void*)bb.data(), bb.stride_0(),
+                                  (void*)&onec,
+                                  (void*)cc.data(), cc.stride_0());
+                    }
                   
-                });
+                  });
             
-              HostSpaceType::fence();
-              const double t = timer.seconds();
-              tmin = std::min(tmin, t);
-              tavg += (iter >= 0)*t;
-            }
-            tavg /= iter_end;
-
-            std::cout << std::setw(12) << "MKL DGEMM"
-                      << " BlkSize = " << std::setw(3) << BlkSize
-                      << " time = " << std::scientific << tmin
-                      << " avg flop/s = " << (flop/tavg)
-                      << " max flop/s = " << (flop/tmin)
-                      << std::endl;
+               });
+
+            result.name = "MKL DGEMM";
+            result.add_param("algo", algo_name)
+                  .add_param("value_type", value_type_name)
+                  .add_param("BlkSize", BlkSize);
+            result.flops = flop;
+            result.bytes = bytes;
+            report.add(result);
 
             cref = c;
           }
@@ -182,10 +199,11 @@ namespace KokkosBatched {
             b("b", N*VectorLength, BlkSize, BlkSize),
             c("c", N*VectorLength, BlkSize, BlkSize);
 
-          value_type
-            *aa[N*VectorLength],
-            *bb[N*VectorLength],
-            *cc[N*VectorLength];
+          // the pointer arrays are captured by the timed lambda, so they cannot be VLAs
+          std::vector<value_type*>
+            aa(N*VectorLength),
+            bb(N*VectorLength),
+            cc(N*VectorLength);
 
           for (int k=0;k<N*VectorLength;++k) {
             aa[k] = &a(k, 0, 0);
@@ -194,7 +212,7 @@ namespace KokkosBatched {
           }
 
           {
-            double tavg = 0, tmin = tmax;
+            KokkosKernels::Experiment::BenchmarkResult result;
 
             MKL_INT blksize[1] = { BlkSize };
             MKL_INT lda[1] = { a.stride_1() };
@@ -207,48 +225,67 @@ namespace KokkosBatched {
             double one[1] = { 1.0 };
             MKL_INT size_per_grp[1] = { N*VectorLength };
 
-            for (int iter=iter_begin;iter<iter_end;++iter) {
-              // flush
-              flush.run();
-
-              // initialize matrices
-              Kokkos::deep_copy(a, amat);
-              Kokkos::deep_copy(b, bmat);
-              Kokkos::deep_copy(c, 0);
-
-              HostSpaceType::fence();
-              timer.reset();
+            KokkosKernels::Experiment::run_benchmark<HostSpaceType>
+              (report.options(), result,
+               [&]() {
+                // flush
+                flush.run();
+
+                // initialize matrices
+                Kokkos::deep_copy(a, amat);
+                Kokkos::deep_copy(b, bmat);
+                Kokkos::deep_copy(c, 0);
+               },
+               [&]() {
             
-              if (std::is_same<value_type,double>::value) {
-                cblas_dgemm_batch(CblasRowMajor, 
-                                  transA,
-                                  transB,
-                                  blksize, blksize, blksize, 
-                                  one,
-                                  (const double**)aa, lda,
-                                  (const double**)bb, ldb,
-                                  one,
-                                  cc, ldc,
-                                  1, size_per_grp);
-              } else if (std::is_same<value_type,Kokkos::complex<double> >::value) {
-                cblas_zgemm_batch(CblasRowMajor,
-                                  transA,
-                                  transB,
-                                  blksize, blksize, blksize,
-                                  one,
-                                  (const void**)aa, lda,
-                                  (const void**)bb, ldb,
-                                  one,
-                                  (void**)cc, ldc,
-                                  1, size_per_grp);                
-              }
-
-              HostSpaceType::fence();
-              const double t = timer.seconds();
-              tmin = std::min(tmin, t);
-              tavg += (iter >= 0)*t;
-            }
-            tavg /= iter_end;
+                if (std::is_same<value_type,double>::value) {
+                  cblas_dgemm_batch(CblasRowMajor, 
+                                    transA,
+                                    transB,
+                                    blksize, blksize, blksize, 
+                                    one,
+                                    (const double**)aa.data(), lda,
+                                    (const double**)bb.data(), ldb,
+                                    one,
+                                    (double**)cc.data(), ldc,
+                                    1, size_per_grp);
+                } else if (std::is_same<value_type,Kokkos::complex<double> >::value) {
+                  cblas_zgemm_batch(CblasRowMajor,
+                                    transA,
+                                    transB,
+                                    blksize, blksize, blksize,
+                                    one,
+                                    (const void**)aa.data(), lda,
+                                    (const void**)bb.data(), ldb,
+                                    one,
+                                    (void**)cc.data(), ldc,
+                                    1, size_per_grp);                
+                } else if (std::is_same<value_type,float>::value) {
+                  float onef[1] = { 1.0 };
+                  cblas_sgemm_batch(CblasRowMajor, 
+                                    transA,
+                                    transB,
+                                    blksize, blksize, blksize, 
+                                    onef,
+                                    (const float**)aa.data(), lda,
+                                    (const float**)bb.data(), ldb,
+                                    onef,
+                                    (float**)cc.data(), ldc,
+                                    1, size_per_grp);
+                } else if (std::is_same<value_type,Kokkos::complex<float> >::value) {
+                  Kokkos::complex<float> onec[1] = { Kokkos::complex<float>(1.0) };
+                  cblas_cgemm_batch(CblasRowMajor,
+                                    transA,
+                                    transB,
+                                    blksize, blksize, blksize,
+                                    (const void*)onec,
+                                    (const void**)aa.data(), lda,
+                                    (const void**)bb.data(), ldb,
+                                    (const void*)onec,
+                                    (void**)cc.data(), ldc,
+                                    1, size_per_grp);                
+                }
+               });
 
             double diff = 0;
             for (int i=0,iend=cref.extent(2);i<iend;++i)
@@ -256,25 +293,27 @@ namespace KokkosBatched {
                 for (int k=0,kend=cref.extent(2);k<kend;++k)
                   diff += abs(cref(i,j,k) - c(i,j,k));
 
-            std::cout << std::setw(12) << "MKL Batch"
-                      << " BlkSize = " << std::setw(3) << BlkSize
-                      << " time = " << std::scientific << tmin
-                      << " avg flop/s = " << (flop/tavg)
-                      << " max flop/s = " << (flop/tmin)
-                      << " diff to ref = " << diff
-                      << std::endl;
+            result.name = "MKL Batch";
+            result.add_param("algo", algo_name)
+                  .add_param("value_type", value_type_name)
+                  .add_param("BlkSize", BlkSize)
+                  .add_param("diff_to_ref", diff);
+            result.flops = flop;
+            result.bytes = bytes;
+            report.add(result);
           }
         }
 #endif
 #if defined(__KOKKOSBATCHED_INTEL_MKL_COMPACT_BATCHED__)
-        {
+        // compact and libxsmm references below are double precision only
+        if (std::is_same<typename Kokkos::Details::ArithTraits<value_type>::mag_type,double>::value) {
           Kokkos::View<VectorType***,Kokkos::LayoutRight,HostSpaceType> 
             a("a", N, BlkSize, BlkSize),
             b("b", N, BlkSize, BlkSize),
             c("c", N, BlkSize, BlkSize);
 
           {
-            double tavg = 0, tmin = tmax;
+            KokkosKernels::Experiment::BenchmarkResult result;
 
             MKL_INT blksize[1] = { BlkSize };
             MKL_INT lda[1] = { a.stride_1() };
@@ -315,42 +354,36 @@ namespace KokkosBatched {
             C_p.format = VectorLength;
             C_p.mat = (double*)c.data();
 
-            for (int iter=iter_begin;iter<iter_end;++iter) {
-              // flush
-              flush.run();
-
-              // initialize matrices
-              Kokkos::deep_copy(a, amat_simd);
-              Kokkos::deep_copy(b, bmat_simd);
-              Kokkos::deep_copy(c, 0);
-
-              HostSpaceType::fence();
-              timer.reset();
-
-              if (std::is_same<value_type,double>::value) {
-                cblas_dgemm_compute_batch(transA, 
-                                          transB, 
-                                          one, 
-                                          &A_p, 
-                                          &B_p, 
-                                          one, 
-                                          &C_p);
-              } else if (std::is_same<value_type,Kokkos::complex<double> >::value) {
-                cblas_zgemm_compute_batch(transA, 
-                                          transB, 
-                                          one, 
-                                          &A_p, 
-                                          &B_p, 
-                                          one, 
-                                          &C_p);
-              }
-
-              HostSpaceType::fence();
-              const double t = timer.seconds();
-              tmin = std::min(tmin, t);
-              tavg += (iter >= 0)*t;
-            }
-            tavg /= iter_end;
+            KokkosKernels::Experiment::run_benchmark<HostSpaceType>
+              (report.options(), result,
+               [&]() {
+                // flush
+                flush.run();
+
+                // initialize matrices
+                Kokkos::deep_copy(a, amat_simd);
+                Kokkos::deep_copy(b, bmat_simd);
+                Kokkos::deep_copy(c, 0);
+               },
+               [&]() {
+                if (std::is_same<value_type,double>::value) {
+                  cblas_dgemm_compute_batch(transA, 
+                                            transB, 
+                                            one, 
+                                            &A_p, 
+                                            &B_p, 
+                                            one, 
+                                            &C_p);
+                } else if (std::is_same<value_type,Kokkos::complex<double> >::value) {
+                  cblas_zgemm_compute_batch(transA, 
+                                            transB, 
+                                            one, 
+                                            &A_p, 
+                                            &B_p, 
+                                            one, 
+                                            &C_p);
+                }
+               });
 
             double diff = 0;
             for (int i=0,iend=cref.extent(2);i<iend;++i)
@@ -358,20 +391,21 @@ namespace KokkosBatched {
                 for (int k=0,kend=cref.extent(2);k<kend;++k)
                   diff += abs(cref(i,j,k) - c(i/VectorLength,j,k)[i%VectorLength]);
           
-            std::cout << std::setw(12) << "MKL Cmpct"
-                      << " BlkSize = " << std::setw(3) << BlkSize
-                      << " time = " << std::scientific << tmin
-                      << " avg flop/s = " << (flop/tavg)
-                      << " max flop/s = " << (flop/tmin)
-                      << " diff to ref = " << diff
-                      << std::endl;
+            result.name = "MKL Cmpct";
+            result.add_param("algo", algo_name)
+                  .add_param("value_type", value_type_name)
+                  .add_param("BlkSize", BlkSize)
+                  .add_param("diff_to_ref", diff);
+            result.flops = flop;
+            result.bytes = bytes;
+            report.add(result);
           }
         }
 #endif
 #endif
 
 #if defined(__KOKKOSBATCHED_LIBXSMM__)
-        {
+        if (std::is_same<value_type,double>::value) {
           libxsmm_init();
 
           Kokkos::View<value_type***,Kokkos::LayoutRight,HostSpaceType> 
@@ -387,49 +421,44 @@ namespace KokkosBatched {
           {
             const Kokkos::RangePolicy<HostSpaceType,ScheduleType> policy(0, N*VectorLength);
           
-            double tavg = 0, tmin = tmax;
+            KokkosKernels::Experiment::BenchmarkResult result;
 
             // adjust column major order in xsmm
             char transA = 'N',  transB = 'N';
             libxsmm_blasint blksize = BlkSize;
             double one = 1.0;
 
-            for (int iter=iter_begin;iter<iter_end;++iter) {
-              // flush
-              flush.run();
-
-              // initialize matrices
-              Kokkos::deep_copy(a, amat);
-              Kokkos::deep_copy(b, bmat);
-              Kokkos::deep_copy(c, 0);
-
-              HostSpaceType::fence();
-              timer.reset();
-
-              Kokkos::parallel_for
-                (policy, 
-                 KOKKOS_LAMBDA(const int k) {
-                  auto aa = Kokkos::subview(a, k, Kokkos::ALL(), Kokkos::ALL());
-                  auto bb = Kokkos::subview(b, k, Kokkos::ALL(), Kokkos::ALL());
-                  auto cc = Kokkos::subview(c, k, Kokkos::ALL(), Kokkos::ALL());
+            KokkosKernels::Experiment::run_benchmark<HostSpaceType>
+              (report.options(), result,
+               [&]() {
+                // flush
+                flush.run();
+
+                // initialize matrices
+                Kokkos::deep_copy(a, amat);
+                Kokkos::deep_copy(b, bmat);
+                Kokkos::deep_copy(c, 0);
+               },
+               [&]() {
+                Kokkos::parallel_for
+                  (policy, 
+                   KOKKOS_LAMBDA(const int k) {
+                    auto aa = Kokkos::subview(a, k, Kokkos::ALL(), Kokkos::ALL());
+                    auto bb = Kokkos::subview(b, k, Kokkos::ALL(), Kokkos::ALL());
+                    auto cc = Kokkos::subview(c, k, Kokkos::ALL(), Kokkos::ALL());
                 
-                  // column major
-                  libxsmm_gemm((const char*)&transA, 
-                               (const char*)&transB, 
-                               blksize, blksize, blksize,
-                               (const double*)&one, 
-                               (const double*)bb.data(), (const libxsmm_blasint*)&ldb,
-                               (const double*)aa.data(), (const libxsmm_blasint*)&lda, 
-                               (const double*)&one, 
-                               (double*)cc.data(), (const libxsmm_blasint*)&ldc);
-                });
+                    // column major
+                    libxsmm_gemm((const char*)&transA, 
+                                 (const char*)&transB, 
+                                 blksize, blksize, blksize,
+                                 (const double*)&one, 
+                                 (const double*)bb.data(), (const libxsmm_blasint*)&ldb,
+                                 (const double*)aa.data(), (const libxsmm_blasint*)&lda, 
+                                 (const double*)&one, 
+                                 (double*)cc.data(), (const libxsmm_blasint*)&ldc);
+                  });
             
-              HostSpaceType::fence();
-              const double t = timer.seconds();
-              tmin = std::min(tmin, t);
-              tavg += (iter >= 0)*t;
-            }
-            tavg /= iter_end;
+               });
 
             // adjust transpose
             double diff = 0;
@@ -438,13 +467,14 @@ namespace KokkosBatched {
                 for (int k=0,kend=cref.extent(2);k<kend;++k)
                   diff += abs(cref(i,j,k) - c(i,j,k));
 
-            std::cout << std::setw(12) << "libxsmm"
-                      << " BlkSize = " << std::setw(3) << BlkSize
-                      << " time = " << std::scientific << tmin
-                      << " avg flop/s = " << (flop/tavg)
-                      << " max flop/s = " << (flop/tmin)
-                      << " diff to ref = " << diff
-                      << std::endl;
+            result.name = "libxsmm";
+            result.add_param("algo", algo_name)
+                  .add_param("value_type", value_type_name)
+                  .add_param("BlkSize", BlkSize)
+                  .add_param("diff_to_ref", diff);
+            result.flops = flop;
+            result.bytes = bytes;
+            report.add(result);
           }
           libxsmm_finalize();
         }
@@ -461,37 +491,32 @@ namespace KokkosBatched {
           {
             const Kokkos::RangePolicy<HostSpaceType,ScheduleType> policy(0, N*VectorLength);
           
-            double tavg = 0, tmin = tmax;
-
-            for (int iter=iter_begin;iter<iter_end;++iter) {
-              // flush
-              flush.run();
-
-              // initialize matrices
-              Kokkos::deep_copy(a, amat);
-              Kokkos::deep_copy(b, bmat);
-              Kokkos::deep_copy(c, 0);
-
-              HostSpaceType::fence();
-              timer.reset();
-
-              Kokkos::parallel_for
-                (policy, 
-                 KOKKOS_LAMBDA(const int k) {
-                  auto aa = Kokkos::subview(a, k, Kokkos::ALL(), Kokkos::ALL());
-                  auto bb = Kokkos::subview(b, k, Kokkos::ALL(), Kokkos::ALL());
-                  auto cc = Kokkos::subview(c, k, Kokkos::ALL(), Kokkos::ALL());
+            KokkosKernels::Experiment::BenchmarkResult result;
+
+            KokkosKernels::Experiment::run_benchmark<HostSpaceType>
+              (report.options(), result,
+               [&]() {
+                // flush
+                flush.run();
+
+                // initialize matrices
+                Kokkos::deep_copy(a, amat);
+                Kokkos::deep_copy(b, bmat);
+                Kokkos::deep_copy(c, 0);
+               },
+               [&]() {
+                Kokkos::parallel_for
+                  (policy, 
+                   KOKKOS_LAMBDA(const int k) {
+                    auto aa = Kokkos::subview(a, k, Kokkos::ALL(), Kokkos::ALL());
+                    auto bb = Kokkos::subview(b, k, Kokkos::ALL(), Kokkos::ALL());
+                    auto cc = Kokkos::subview(c, k, Kokkos::ALL(), Kokkos::ALL());
                 
-                  SerialGemm<Trans::NoTranspose,Trans::NoTranspose,AlgoTagType>::
-                    invoke(1.0, aa, bb, 1.0, cc);
-                });
+                    SerialGemm<Trans::NoTranspose,Trans::NoTranspose,AlgoTagType>::
+                      invoke(1.0, aa, bb, 1.0, cc);
+                  });
             
-              HostSpaceType::fence();
-              const double t = timer.seconds();
-              tmin = std::min(tmin, t);
-              tavg += (iter >= 0)*t;
-            }
-            tavg /= iter_end;
+               });
 
             double diff = 0;
             for (int i=0,iend=cref.extent(2);i<iend;++i)
@@ -499,13 +524,14 @@ namespace KokkosBatched {
                 for (int k=0,kend=cref.extent(2);k<kend;++k)
                   diff += abs(cref(i,j,k) - c(i,j,k));
 
-            std::cout << std::setw(12) << "KK Scalar"
-                      << " BlkSize = " << std::setw(3) << BlkSize
-                      << " time = " << std::scientific << tmin
-                      << " avg flop/s = " << (flop/tavg)
-                      << " max flop/s = " << (flop/tmin)
-                      << " diff to ref = " << diff
-                      << std::endl;
+            result.name = "KK Scalar";
+            result.add_param("algo", algo_name)
+                  .add_param("value_type", value_type_name)
+                  .add_param("BlkSize", BlkSize)
+                  .add_param("diff_to_ref", diff);
+            result.flops = flop;
+            result.bytes = bytes;
+            report.add(result);
           }
         }
 
@@ -521,37 +547,89 @@ namespace KokkosBatched {
           {
             const Kokkos::RangePolicy<HostSpaceType,ScheduleType> policy(0, N);
           
-            double tavg = 0, tmin = tmax;
-
-            for (int iter=iter_begin;iter<iter_end;++iter) {
-              // flush
-              flush.run();
-
-              // initialize matrices
-              Kokkos::deep_copy(a, amat_simd);
-              Kokkos::deep_copy(b, bmat_simd);
-              Kokkos::deep_copy(c, 0);
-
-              HostSpaceType::fence();
-              timer.reset();
-
-              Kokkos::parallel_for
-                (policy, 
-                 KOKKOS_LAMBDA(const int k) {
-                  auto aa = Kokkos::subview(a, k, Kokkos::ALL(), Kokkos::ALL());
-                  auto bb = Kokkos::subview(b, k, Kokkos::ALL(), Kokkos::ALL());
-                  auto cc = Kokkos::subview(c, k, Kokkos::ALL(), Kokkos::ALL());
+            KokkosKernels::Experiment::BenchmarkResult result;
+
+            KokkosKernels::Experiment::run_benchmark<HostSpaceType>
+              (report.options(), result,
+               [&]() {
+                // flush
+                flush.run();
+
+                // initialize matrices
+                Kokkos::deep_copy(a, amat_simd);
+                Kokkos::deep_copy(b, bmat_simd);
+                Kokkos::deep_copy(c, 0);
+               },
+               [&]() {
+                Kokkos::parallel_for
+                  (policy, 
+                   KOKKOS_LAMBDA(const int k) {
+                    auto aa = Kokkos::subview(a, k, Kokkos::ALL(), Kokkos::ALL());
+                    auto bb = Kokkos::subview(b, k, Kokkos::ALL(), Kokkos::ALL());
+                    auto cc = Kokkos::subview(c, k, Kokkos::ALL(), Kokkos::ALL());
+                
+                    SerialGemm<Trans::NoTranspose,Trans::NoTranspose,AlgoTagType>::
+                      invoke(1.0, aa, bb, 1.0, cc);
+                  });
+            
+               });
+
+            double diff = 0;
+            for (int i=0,iend=cref.extent(2);i<iend;++i)
+              for (int j=0,jend=cref.extent(2);j<jend;++j)
+                for (int k=0,kend=cref.extent(2);k<kend;++k)
+                  diff += abs(cref(i,j,k) - c(i/VectorLength,j,k)[i%VectorLength]);
+
+            result.name = "KK Vector";
+            result.add_param("algo", algo_name)
+                  .add_param("value_type", value_type_name)
+                  .add_param("BlkSize", BlkSize)
+                  .add_param("diff_to_ref", diff);
+            result.flops = flop;
+            result.bytes = bytes;
+            report.add(result);
+          }
+        }
+#if defined( KokkosBatched_Test_Gemm_Host_Real )
+        ///
+        /// Serial SIMD with compile-time sizes (compared against the runtime size path above)
+        ///
+        {
+          Kokkos::View<VectorType***,Kokkos::LayoutRight,HostSpaceType> 
+            a("a", N, BlkSize, BlkSize),
+            b("b", N, BlkSize, BlkSize),
+            c("c", N, BlkSize, BlkSize);
+        
+          {
+            const Kokkos::RangePolicy<HostSpaceType,ScheduleType> policy(0, N);
+          
+            KokkosKernels::Experiment::BenchmarkResult result;
+
+            KokkosKernels::Experiment::run_benchmark<HostSpaceType>
+              (report.options(), result,
+               [&]() {
+                // flush
+                flush.run();
+
+                // initialize matrices
+                Kokkos::deep_copy(a, amat_simd);
+                Kokkos::deep_copy(b, bmat_simd);
+                Kokkos::deep_copy(c, 0);
+               },
+               [&]() {
+                Kokkos::parallel_for
+                  (policy, 
+                   KOKKOS_LAMBDA(const int k) {
+                    auto aa = Kokkos::subview(a, k, Kokkos::ALL(), Kokkos::ALL());
+                    auto bb = Kokkos::subview(b, k, Kokkos::ALL(), Kokkos::ALL());
+                    auto cc = Kokkos::subview(c, k, Kokkos::ALL(), Kokkos::ALL());
                 
-                  SerialGemm<Trans::NoTranspose,Trans::NoTranspose,AlgoTagType>::
-                    invoke(1.0, aa, bb, 1.0, cc);
-                });
+                    SerialGemmFixedSize<Trans::NoTranspose,Trans::NoTranspose,Algo::Gemm::Blocked,
+                                        BlkSize,BlkSize,BlkSize>::
+                      invoke(1.0, aa, bb, 1.0, cc);
+                  });
             
-              HostSpaceType::fence();
-              const double t = timer.seconds();
-              tmin = std::min(tmin, t);
-              tavg += (iter >= 0)*t;
-            }
-            tavg /= iter_end;
+               });
 
             double diff = 0;
             for (int i=0,iend=cref.extent(2);i<iend;++i)
@@ -559,16 +637,17 @@ namespace KokkosBatched {
                 for (int k=0,kend=cref.extent(2);k<kend;++k)
                   diff += abs(cref(i,j,k) - c(i/VectorLength,j,k)[i%VectorLength]);
 
-            std::cout << std::setw(12) << "KK Vector"
-                      << " BlkSize = " << std::setw(3) << BlkSize
-                      << " time = " << std::scientific << tmin
-                      << " avg flop/s = " << (flop/tavg)
-                      << " max flop/s = " << (flop/tmin)
-                      << " diff to ref = " << diff
-                      << std::endl;
+            result.name = "KK Fixed";
+            result.add_param("algo", algo_name)
+                  .add_param("value_type", value_type_name)
+                  .add_param("BlkSize", BlkSize)
+                  .add_param("diff_to_ref", diff);
+            result.flops = flop;
+            result.bytes = bytes;
+            report.add(result);
           }
         }
-        std::cout << std::endl;
+#endif
       }
         
     } // end perftest
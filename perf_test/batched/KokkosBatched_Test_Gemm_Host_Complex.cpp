@@ -7,7 +7,7 @@
 using namespace KokkosBatched::Experimental;
 
 template<typename AlgoTagType>
-void run(const int N) {
+void run(const int N, const std::string &algo_name, KokkosKernels::Experiment::BenchmarkReport &report) {
   typedef Kokkos::DefaultHostExecutionSpace HostSpaceType;
 
   Kokkos::print_configuration(std::cout);
@@ -19,35 +19,47 @@ void run(const int N) {
   // Test::Gemm<32, AlgoTagType>(N);
   // Test::Gemm<64, AlgoTagType>(N);
 
-  PerfTest::Gemm< 3, HostSpaceType, AlgoTagType>(N);
-  PerfTest::Gemm< 5, HostSpaceType, AlgoTagType>(N);
-  PerfTest::Gemm<10, HostSpaceType, AlgoTagType>(N);
-  PerfTest::Gemm<15, HostSpaceType, AlgoTagType>(N);
+  PerfTest::Gemm< 3, HostSpaceType, AlgoTagType>(N, algo_name, report);
+  PerfTest::Gemm< 5, HostSpaceType, AlgoTagType>(N, algo_name, report);
+  PerfTest::Gemm<10, HostSpaceType, AlgoTagType>(N, algo_name, report);
+  PerfTest::Gemm<15, HostSpaceType, AlgoTagType>(N, algo_name, report);
+
+  // single precision
+  PerfTest::Gemm< 3, HostSpaceType, AlgoTagType, Kokkos::complex<float>>(N, algo_name, report);
+  PerfTest::Gemm< 5, HostSpaceType, AlgoTagType, Kokkos::complex<float>>(N, algo_name, report);
+  PerfTest::Gemm<10, HostSpaceType, AlgoTagType, Kokkos::complex<float>>(N, algo_name, report);
+  PerfTest::Gemm<15, HostSpaceType, AlgoTagType, Kokkos::complex<float>>(N, algo_name, report);
 }
 
 int main(int argc, char *argv[]) {
-  
-  Kokkos::initialize(argc, argv);
-
   const int ntest = 1;
   //const int N[6] = { 256, 512, 768, 1024, 1280, 1536 };
   int N[1] = { 128*128 };
 
+  KokkosKernels::Experiment::BenchmarkOptions opts;
+  opts.warmup = 10;
+  opts.repeat = 100;
+
   for (int i=1;i<argc;++i) {
     const std::string& token = argv[i];
+    if (KokkosKernels::Experiment::parse_benchmark_option(opts, argc, argv, i)) continue;
     if (token == std::string("-N")) N[0] = std::atoi(argv[++i]);
   }
 
-  {        
+  Kokkos::initialize(KokkosKernels::Experiment::get_benchmark_init_arguments(opts));
+
+  {
+    KokkosKernels::Experiment::BenchmarkReport report(opts);
     for (int i=0;i<ntest;++i) {
       std::cout << " N = " << N[i] << std::endl;
       
       std::cout << "\n Testing Algo::Gemm::Unblocked\n";
-      run<Algo::Gemm::Unblocked>(N[i]);
+      run<Algo::Gemm::Unblocked>(N[i], "Unblocked", report);
       
       std::cout << "\n Testing Algo::Gemm::Blocked\n";
-      run<Algo::Gemm::Blocked>(N[i]);
+      run<Algo::Gemm::Blocked>(N[i], "Blocked", report);
     }
+    report.write();
   }
 
   Kokkos::finalize();
@@ -0,0 +1,179 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+/// Sweeps the register blocking of the batched Gemm inner kernel on host
+/// and writes a tuning table consumed by KokkosBatched_Tuning.hpp, e.g.,
+///
+///   ./KokkosBatched_Test_Tune_Blocking_Host.exe -N 16384 -lo 3 -hi 15 -o KokkosBatched_Tuning_Table.hpp
+///
+/// The table selects the mb with the smallest total time over the block
+/// sizes in [lo,hi] for real and complex value types.
+
+#include <iomanip>
+#include <fstream>
+
+#include "Kokkos_Core.hpp"
+#include "impl/Kokkos_Timer.hpp"
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_Gemm_Serial_Internal.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+    namespace PerfTest {
+
+      typedef Kokkos::DefaultHostExecutionSpace HostSpaceType;
+
+      enum : int { MaxMB = 5, NumBlkSizes = 7 };
+      static const int BlkSizes[NumBlkSizes] = { 3, 5, 8, 10, 15, 20, 32 };
+
+      template<int MB>
+      struct GemmTuneAlgo {
+        template<typename ValueType>
+        KOKKOS_INLINE_FUNCTION
+        static void invoke(const int m, const ValueType *A, const ValueType *B, ValueType *C) {
+          SerialGemmInternalRegisterBlocked<MB,MB>::
+            invoke(m, m, m, 1.0, A, m, 1, B, m, 1, 1.0, C, m, 1);
+        }
+      };
+
+      template<>
+      struct GemmTuneAlgo<0> {
+        template<typename ValueType>
+        KOKKOS_INLINE_FUNCTION
+        static void invoke(const int m, const ValueType *A, const ValueType *B, ValueType *C) {
+          SerialGemmInternal<Algo::Gemm::Unblocked>::
+            invoke(m, m, m, 1.0, A, m, 1, B, m, 1, 1.0, C, m, 1);
+        }
+      };
+
+      /// returns the minimum time over a few repetitions; MB = 0 is unblocked
+      template<int MB, int BlkSize, typename VectorType>
+      double TimeGemm(const int N) {
+        typedef Kokkos::Schedule<Kokkos::Static> ScheduleType;
+        Kokkos::View<VectorType***,Kokkos::LayoutRight,HostSpaceType>
+          a("a", N, BlkSize, BlkSize),
+          b("b", N, BlkSize, BlkSize),
+          c("c", N, BlkSize, BlkSize);
+        Kokkos::deep_copy(a, VectorType(0.5));
+        Kokkos::deep_copy(b, VectorType(0.25));
+
+        const Kokkos::RangePolicy<HostSpaceType,ScheduleType> policy(0, N);
+        Kokkos::Impl::Timer timer;
+
+        const int iter_begin = -3, iter_end = 10;
+        double tmin = 1.0e15;
+        for (int iter=iter_begin;iter<iter_end;++iter) {
+          Kokkos::deep_copy(c, VectorType(0));
+          HostSpaceType::fence();
+          timer.reset();
+          Kokkos::parallel_for
+            (policy,
+             KOKKOS_LAMBDA(const int k) {
+              GemmTuneAlgo<MB>::invoke(BlkSize, &a(k,0,0), &b(k,0,0), &c(k,0,0));
+            });
+          HostSpaceType::fence();
+          const double t = timer.seconds();
+          if (iter >= 0) tmin = std::min(tmin, t);
+        }
+        return tmin;
+      }
+
+      template<int BlkSize, typename VectorType>
+      void SweepBlkSize(const int N, double *t) {
+        t[0] = TimeGemm<0,BlkSize,VectorType>(N);
+        t[1] = TimeGemm<1,BlkSize,VectorType>(N);
+        t[2] = TimeGemm<2,BlkSize,VectorType>(N);
+        t[3] = TimeGemm<3,BlkSize,VectorType>(N);
+        t[4] = TimeGemm<4,BlkSize,VectorType>(N);
+        t[5] = TimeGemm<5,BlkSize,VectorType>(N);
+      }
+
+      /// fills t[NumBlkSizes][MaxMB+1] and returns the best mb over [lo,hi]
+      template<typename ValueType>
+      int Sweep(const int NN, const int lo, const int hi, const std::string &label) {
+        constexpr int VectorLength = DefaultVectorLength<ValueType,typename HostSpaceType::memory_space>::value;
+        typedef Vector<SIMD<ValueType>,VectorLength> VectorType;
+        const int N = NN/VectorLength;
+
+        double t[NumBlkSizes][MaxMB+1];
+        SweepBlkSize< 3,VectorType>(N, t[0]);
+        SweepBlkSize< 5,VectorType>(N, t[1]);
+        SweepBlkSize< 8,VectorType>(N, t[2]);
+        SweepBlkSize<10,VectorType>(N, t[3]);
+        SweepBlkSize<15,VectorType>(N, t[4]);
+        SweepBlkSize<20,VectorType>(N, t[5]);
+        SweepBlkSize<32,VectorType>(N, t[6]);
+
+        std::cout << "\n " << label << " (vector length " << VectorLength << ", time relative to unblocked)\n";
+        std::cout << std::setw(10) << "BlkSize" << std::setw(12) << "Unblocked";
+        for (int mb=1;mb<=MaxMB;++mb) std::cout << std::setw(9) << "mb = " << mb;
+        std::cout << std::setw(10) << "best" << std::endl;
+
+        double tsum[MaxMB+1] = {};
+        for (int s=0;s<NumBlkSizes;++s) {
+          int best = 0;
+          std::cout << std::setw(10) << BlkSizes[s] << std::setw(12) << std::fixed << std::setprecision(3) << 1.0;
+          for (int mb=1;mb<=MaxMB;++mb) {
+            std::cout << std::setw(10) << (t[s][mb]/t[s][0]);
+            if (t[s][mb] < t[s][best]) best = mb;
+          }
+          std::cout << std::setw(10) << (best == 0 ? std::string("unblocked") : std::to_string(best)) << std::endl;
+
+          if (lo <= BlkSizes[s] && BlkSizes[s] <= hi)
+            for (int mb=0;mb<=MaxMB;++mb)
+              tsum[mb] += t[s][mb]/t[s][0];
+        }
+
+        int best = 1;
+        for (int mb=2;mb<=MaxMB;++mb)
+          if (tsum[mb] < tsum[best]) best = mb;
+        if (tsum[0] < tsum[best])
+          std::cout << " Unblocked is faster than Blocked for block sizes in [" << lo << "," << hi << "]\n";
+        return best;
+      }
+
+    } // end perftest
+  } // end experimental
+} // end batched
+
+using namespace KokkosBatched::Experimental;
+
+int main(int argc, char *argv[]) {
+  Kokkos::initialize(argc, argv);
+
+  int N = 128*128, lo = 3, hi = 15;
+  std::string filename("KokkosBatched_Tuning_Table.hpp");
+
+  for (int i=1;i<argc;++i) {
+    const std::string& token = argv[i];
+    if (token == std::string("-N"))  N  = std::atoi(argv[++i]);
+    if (token == std::string("-lo")) lo = std::atoi(argv[++i]);
+    if (token == std::string("-hi")) hi = std::atoi(argv[++i]);
+    if (token == std::string("-o"))  filename = argv[++i];
+  }
+
+  {
+    Kokkos::print_configuration(std::cout);
+    std::cout << " N = " << N << ", block sizes in [" << lo << "," << hi << "]\n";
+
+    const int mb_real    = PerfTest::Sweep<double>(N, lo, hi, "double");
+    const int mb_complex = PerfTest::Sweep<Kokkos::complex<double> >(N, lo, hi, "Kokkos::complex<double>");
+
+    std::ofstream os(filename);
+    os << "#ifndef __KOKKOSBATCHED_TUNING_TABLE_HPP__\n"
+       << "#define __KOKKOSBATCHED_TUNING_TABLE_HPP__\n\n"
+       << "/// generated by KokkosBatched_Test_Tune_Blocking_Host"
+       << " for N = " << N << " and block sizes in [" << lo << "," << hi << "]\n\n"
+       << "#define KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST " << mb_real << "\n"
+       << "#define KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST_COMPLEX " << mb_complex << "\n\n"
+       << "#endif\n";
+    std::cout << "\n Tuning table is written to " << filename
+              << " (mb real = " << mb_real << ", mb complex = " << mb_complex << ")\n";
+  }
+
+  Kokkos::finalize();
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include <iomanip>
+#include <cmath>
+#include <limits>
+
+#include "Kokkos_Core.hpp"
+#include "impl/Kokkos_Timer.hpp"
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace KokkosBatched {
+  namespace Experimental {
+    namespace PerfTest {
+
+      ///
+      /// per lane version, equivalent to the generic implementation
+      ///
+      struct LaneExp   { static double apply(const double x) { return std::exp(x); } };
+      struct LaneLog   { static double apply(const double x) { return std::log(x); } };
+      struct LaneSin   { static double apply(const double x) { return std::sin(x); } };
+      struct LaneCos   { static double apply(const double x) { return std::cos(x); } };
+      struct LanePow   { static double apply(const double x) { return std::pow(x, 1.7); } };
+
+      template<int VectorLength> struct SimdExp { static Vector<SIMD<double>,VectorLength> apply(const Vector<SIMD<double>,VectorLength> &x) { return exp(x); } };
+      template<int VectorLength> struct SimdLog { static Vector<SIMD<double>,VectorLength> apply(const Vector<SIMD<double>,VectorLength> &x) { return log(x); } };
+      template<int VectorLength> struct SimdSin { static Vector<SIMD<double>,VectorLength> apply(const Vector<SIMD<double>,VectorLength> &x) { return sin(x); } };
+      template<int VectorLength> struct SimdCos { static Vector<SIMD<double>,VectorLength> apply(const Vector<SIMD<double>,VectorLength> &x) { return cos(x); } };
+      template<int VectorLength> struct SimdPow { static Vector<SIMD<double>,VectorLength> apply(const Vector<SIMD<double>,VectorLength> &x) { return pow(x, 1.7); } };
+
+      template<typename HostSpaceType, int VectorLength, typename LaneOp, typename SimdOp>
+      void VectorMath(const char *name, const int N, const double xmin, const double xmax) {
+        typedef Vector<SIMD<double>,VectorLength> vector_type;
+        typedef Kokkos::RangePolicy<HostSpaceType,Kokkos::Schedule<Kokkos::Static> > policy_type;
+
+        Kokkos::View<vector_type*,HostSpaceType> x("x", N), y("y", N), yref("yref", N);
+        Kokkos::parallel_for(policy_type(0, N), KOKKOS_LAMBDA(const int i) {
+            for (int k=0;k<VectorLength;++k)
+              x(i)[k] = xmin + (xmax - xmin)*((long(i*VectorLength + k)*7919) % 100003)/100003.0;
+          });
+
+        const int iter_begin = -3, iter_end = 20;
+        Kokkos::Impl::Timer timer;
+        double tlane = 0, tsimd = 0;
+
+        for (int iter=iter_begin;iter<iter_end;++iter) {
+          HostSpaceType::fence();
+          timer.reset();
+          Kokkos::parallel_for(policy_type(0, N), KOKKOS_LAMBDA(const int i) {
+              vector_type r;
+              for (int k=0;k<VectorLength;++k)
+                r[k] = LaneOp::apply(x(i)[k]);
+              yref(i) = r;
+            });
+          HostSpaceType::fence();
+          tlane += (iter >= 0)*timer.seconds();
+
+          timer.reset();
+          Kokkos::parallel_for(policy_type(0, N), KOKKOS_LAMBDA(const int i) {
+              y(i) = SimdOp::apply(x(i));
+            });
+          HostSpaceType::fence();
+          tsimd += (iter >= 0)*timer.seconds();
+        }
+        tlane /= iter_end;
+        tsimd /= iter_end;
+
+        /// maximum relative error against the per lane version in ulp
+        double maxerr = 0;
+        for (int i=0;i<N;++i)
+          for (int k=0;k<VectorLength;++k) {
+            const double ref = yref(i)[k];
+            if (ref != 0) maxerr = std::max(maxerr, std::abs(y(i)[k] - ref)/std::abs(ref));
+          }
+
+        const double neval = double(N)*VectorLength;
+        std::cout << std::setw(6) << name
+                  << " [" << std::setw(8) << xmin << ", " << std::setw(8) << xmax << "]"
+                  << " per lane time = " << std::scientific << tlane
+                  << " (" << (neval/tlane) << " eval/s)"
+                  << " vector time = " << tsimd
+                  << " (" << (neval/tsimd) << " eval/s)"
+                  << " speedup = " << std::fixed << std::setprecision(2) << (tlane/tsimd)
+                  << " max error = " << std::setprecision(1) << (maxerr/std::numeric_limits<double>::epsilon()) << " ulp"
+                  << std::defaultfloat << std::setprecision(6)
+                  << std::endl;
+      }
+    }
+  }
+}
+
+template<int VectorLength>
+void run(const int N) {
+  typedef Kokkos::DefaultHostExecutionSpace HostSpaceType;
+  using namespace KokkosBatched::Experimental::PerfTest;
+
+  std::cout << "\n Vector<SIMD<double>," << VectorLength << ">\n";
+  VectorMath<HostSpaceType,VectorLength,LaneExp,SimdExp<VectorLength> >("exp", N, -50.0, 50.0);
+  VectorMath<HostSpaceType,VectorLength,LaneLog,SimdLog<VectorLength> >("log", N, 1.0e-3, 1.0e3);
+  VectorMath<HostSpaceType,VectorLength,LaneSin,SimdSin<VectorLength> >("sin", N, -100.0, 100.0);
+  VectorMath<HostSpaceType,VectorLength,LaneCos,SimdCos<VectorLength> >("cos", N, -100.0, 100.0);
+  VectorMath<HostSpaceType,VectorLength,LanePow,SimdPow<VectorLength> >("pow", N, 1.0e-3, 1.0e3);
+}
+
+int main(int argc, char *argv[]) {
+
+  Kokkos::initialize(argc, argv);
+
+  const int N = 1024*1024;
+  {
+    Kokkos::print_configuration(std::cout);
+
+#if   defined(__AVX512F__)
+    std::cout << "AVX512 is defined\n";
+#elif defined(__AVX2__)
+    std::cout << "AVX2 is defined\n";
+#else
+    std::cout << "SIMD (compiler vectorization) is defined\n";
+#endif
+
+    run<4>(N/4);
+    run<8>(N/8);
+  }
+
+  Kokkos::finalize();
+
+  return 0;
+}
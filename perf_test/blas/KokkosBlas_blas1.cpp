@@ -41,6 +41,8 @@
 //@HEADER
 */
 #include <KokkosBlas.hpp>
+#include <KokkosBlas1_reproducible.hpp>
+#include <cmath>
 #include <Teuchos_CommandLineProcessor.hpp>
 #include <Teuchos_TimeMonitor.hpp>
 #include <Teuchos_Comm.hpp>
@@ -78,6 +80,9 @@ benchmarkKokkos (std::ostream& out,
   RCP<Time> vecCreateTimer = getTimer ("Kokkos: Vector: Create");
   RCP<Time> vecFillTimer = getTimer ("Kokkos: Vector: Fill");
   RCP<Time> vecDotTimer = getTimer ("Kokkos: Vector: Dot");
+  RCP<Time> vecReproDotTimer = getTimer ("Kokkos: Vector: Dot (reproducible)");
+  RCP<Time> vecNrm2Timer = getTimer ("Kokkos: Vector: Nrm2");
+  RCP<Time> vecReproNrm2Timer = getTimer ("Kokkos: Vector: Nrm2 (reproducible)");
 
   // Benchmark creation of a Vector.
   vector_type x;
@@ -112,15 +117,63 @@ benchmarkKokkos (std::ostream& out,
     }
   }
 
+  // Benchmark the fixed-order (reproducible) dot product, to measure
+  // its overhead over the default one.
+  double reproDotResults[2];
+  reproDotResults[0] = 0.0;
+  reproDotResults[1] = 0.0;
+  {
+    TimeMonitor timeMon (*vecReproDotTimer);
+    for (int k = 0; k < numTrials; ++k) {
+      reproDotResults[k % 2] = KokkosBlas::Experimental::reproducible_dot (x, y);
+    }
+  }
+
+  // Same for the 2-norm.
+  double nrm2Results[2];
+  double reproNrm2Results[2];
+  nrm2Results[0] = nrm2Results[1] = 0.0;
+  reproNrm2Results[0] = reproNrm2Results[1] = 0.0;
+  {
+    TimeMonitor timeMon (*vecNrm2Timer);
+    for (int k = 0; k < numTrials; ++k) {
+      nrm2Results[k % 2] = KokkosBlas::nrm2 (y);
+    }
+  }
+  {
+    TimeMonitor timeMon (*vecReproNrm2Timer);
+    for (int k = 0; k < numTrials; ++k) {
+      reproNrm2Results[k % 2] = KokkosBlas::Experimental::reproducible_nrm2 (y);
+    }
+  }
+
   if (numTrials > 0) {
     const double expectedResult = static_cast<double> (lclNumRows) * -1.0;
     if (dotResults[0] != expectedResult) {
       out << "Kokkos dot product result is wrong!  Expected " << expectedResult
           << " but got " << dotResults[0] << " instead." << endl;
       return false;
-    } else {
-      return true;
     }
+    if (reproDotResults[0] != expectedResult) {
+      out << "Kokkos reproducible dot product result is wrong!  Expected "
+          << expectedResult << " but got " << reproDotResults[0]
+          << " instead." << endl;
+      return false;
+    }
+    if (numTrials > 1 && reproNrm2Results[0] != reproNrm2Results[1]) {
+      out << "Kokkos reproducible nrm2 is not reproducible!  Got "
+          << reproNrm2Results[0] << " and " << reproNrm2Results[1] << endl;
+      return false;
+    }
+    const double expectedNrm2 = std::sqrt (static_cast<double> (lclNumRows));
+    if (std::abs (nrm2Results[0] - expectedNrm2) > 1.0e-12 * expectedNrm2 ||
+        std::abs (reproNrm2Results[0] - expectedNrm2) > 1.0e-12 * expectedNrm2) {
+      out << "Kokkos nrm2 result is wrong!  Expected " << expectedNrm2
+          << " but got " << nrm2Results[0] << " and " << reproNrm2Results[0]
+          << " (reproducible) instead." << endl;
+      return false;
+    }
+    return true;
   }
   return true;
 }
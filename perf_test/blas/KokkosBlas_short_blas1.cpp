@@ -0,0 +1,157 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+/// Times the BLAS1 kernels on short vectors, where the cost of a call is
+/// dominated by its overhead rather than by the memory traffic. The
+/// Makefile builds this driver twice, as KokkosBlas_short_blas1.exe
+/// through the explicitly instantiated library and as
+/// KokkosBlas_short_blas1_inline.exe with KOKKOSKERNELS_INLINE_BLAS1, so
+/// that the two reports compare the ETI and the header-only paths, e.g.,
+///
+///   ./KokkosBlas_short_blas1.exe --openmp 4 --length 64 --calls 10000
+///   ./KokkosBlas_short_blas1_inline.exe --openmp 4 --length 64 --calls 10000
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "Kokkos_Core.hpp"
+#include "KokkosBlas1_axpby.hpp"
+#include "KokkosBlas1_dot.hpp"
+#include "KokkosBlas1_scal.hpp"
+#include "KokkosKernels_Benchmark.hpp"
+
+#ifdef KOKKOSKERNELS_INLINE_BLAS1
+static const char *blas1_path = "inline";
+#else
+static const char *blas1_path = "eti";
+#endif
+
+void print_options(){
+  std::cerr << "Options\n" << std::endl;
+  KokkosKernels::Experiment::print_benchmark_options(std::cerr);
+  std::cerr << "\t'--length [N ...]': vector lengths, default 16 64 256 1024" << std::endl;
+  std::cerr << "\t'--calls [N]': number of kernel calls per timed run, default 10000" << std::endl;
+}
+
+template <typename ExecSpace>
+void run_short_blas1(const KokkosKernels::Experiment::BenchmarkOptions &opts,
+                     const std::vector<int> &lengths, const int calls){
+  typedef Kokkos::View<double*, ExecSpace> vector_type;
+  using KokkosKernels::Experiment::BenchmarkResult;
+
+  KokkosKernels::Experiment::BenchmarkReport report(opts);
+  for (size_t l = 0; l < lengths.size(); ++l){
+    const int n = lengths[l];
+    vector_type x("x", n), y("y", n), z("z", n);
+    Kokkos::deep_copy(x, 1.0);
+    Kokkos::deep_copy(y, 0.5);
+
+    // per call: axpby reads x, y and writes y; dot reads x, y; scal reads y and writes z
+    BenchmarkResult axpby_result("axpby"), dot_result("dot"), scal_result("scal");
+    BenchmarkResult *results[3] = {&axpby_result, &dot_result, &scal_result};
+    const double flops[3] = {3.0*n, 2.0*n, 1.0*n};
+    const double bytes[3] = {3.0*n*sizeof(double), 2.0*n*sizeof(double), 2.0*n*sizeof(double)};
+    for (int k = 0; k < 3; ++k){
+      results[k]->add_param("path", blas1_path).add_param("length", n).add_param("calls", calls);
+      results[k]->flops = flops[k]*calls;
+      results[k]->bytes = bytes[k]*calls;
+    }
+
+    KokkosKernels::Experiment::run_benchmark<ExecSpace>(opts, axpby_result, [&](){
+        for (int c = 0; c < calls; ++c) KokkosBlas::axpby(1.0, x, -1.0, y);
+      });
+    double sum = 0;
+    KokkosKernels::Experiment::run_benchmark<ExecSpace>(opts, dot_result, [&](){
+        for (int c = 0; c < calls; ++c) sum += KokkosBlas::dot(x, y);
+      });
+    KokkosKernels::Experiment::run_benchmark<ExecSpace>(opts, scal_result, [&](){
+        for (int c = 0; c < calls; ++c) KokkosBlas::scal(z, 2.0, y);
+      });
+    // keeps the dot calls from being optimized away
+    if (sum != sum) std::cerr << "dot returned NaN" << std::endl;
+
+    report.add(axpby_result);
+    report.add(dot_result);
+    report.add(scal_result);
+  }
+  report.write();
+}
+
+int main(int argc, char *argv[]){
+  KokkosKernels::Experiment::BenchmarkOptions opts;
+  std::vector<int> lengths;
+  int calls = 10000;
+
+  for (int i = 1; i < argc; ++i){
+    if ( 0 == strcasecmp( argv[i] , "--length" ) ) {
+      while (KokkosKernels::Experiment::Impl::next_is_integer(argc, argv, i))
+        lengths.push_back(atoi( argv[++i] ));
+    }
+    else if ( 0 == strcasecmp( argv[i] , "--calls" ) && i + 1 < argc ) {
+      calls = atoi( argv[++i] );
+    }
+    else if ( KokkosKernels::Experiment::parse_benchmark_option( opts, argc, argv, i ) ) {
+    }
+    else if ( 0 == strcasecmp( argv[i] , "--help" ) || 0 == strcasecmp( argv[i] , "-h" ) ) {
+      print_options();
+      return 0;
+    }
+    else {
+      std::cerr << "Unrecognized command line argument #" << i << ": " << argv[i] << std::endl;
+      print_options();
+      return 1;
+    }
+  }
+  if (lengths.empty()){
+    lengths.push_back(16);
+    lengths.push_back(64);
+    lengths.push_back(256);
+    lengths.push_back(1024);
+  }
+
+  Kokkos::initialize(KokkosKernels::Experiment::get_benchmark_init_arguments(opts));
+  run_short_blas1<Kokkos::DefaultExecutionSpace>(opts, lengths, calls);
+  Kokkos::finalize();
+  return 0;
+}
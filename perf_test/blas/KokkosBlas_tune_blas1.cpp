@@ -0,0 +1,91 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// Calibrates the multivector axpby and dot kernels on the default
+/// execution space and writes the tuning table, e.g.,
+///
+///   ./KokkosBlas_tune_blas1.exe -o blas1_tuning.txt
+///
+/// Run applications with KOKKOSKERNELS_BLAS1_TUNING_FILE=blas1_tuning.txt
+/// to use it.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "Kokkos_Core.hpp"
+#include "KokkosBlas1_tuning.hpp"
+
+int main(int argc, char *argv[]) {
+  Kokkos::initialize(argc, argv);
+
+  std::string filename("blas1_tuning.txt");
+  int numTrials = 10;
+  size_t maxRows = size_t(1) << 21;
+
+  for (int i=1;i<argc;++i) {
+    const std::string& token = argv[i];
+    if (token == std::string("-o"))       filename = argv[++i];
+    if (token == std::string("-trials"))  numTrials = std::atoi(argv[++i]);
+    if (token == std::string("-maxrows")) maxRows = std::atol(argv[++i]);
+  }
+
+  {
+    typedef Kokkos::DefaultExecutionSpace execution_space;
+    Kokkos::print_configuration(std::cout);
+
+    // one length per rows bucket from 2^8, and every column count the
+    // strip-mining distinguishes
+    std::vector<size_t> numRows, numCols;
+    for (size_t m = 256; m <= maxRows; m *= 2) numRows.push_back(m);
+    for (size_t n = 2; n <= 17; ++n) numCols.push_back(n);
+
+    KokkosBlas::Experimental::calibrate_blas1<execution_space,double>(numRows, numCols, numTrials);
+    KokkosBlas::Experimental::save_blas1_tuning(filename);
+    std::cout << " Tuning table for " << execution_space::name()
+              << " is written to " << filename << std::endl;
+  }
+
+  Kokkos::finalize();
+
+  return 0;
+}
@@ -57,26 +57,20 @@
 
 
 void print_options(){
-
+  std::cerr << "Options\n" << std::endl;
+  KokkosKernels::Experiment::print_benchmark_options(std::cerr);
+  std::cerr << "\t[Required] INPUT MATRIX: '--amtx [graph.mtx]'" << std::endl;
+  std::cerr << "\t[Optional] '--algorithm [COLORING_DEFAULT|COLORING_SERIAL|COLORING_VB|COLORING_VBBIT|COLORING_VBCS|COLORING_EB|COLORING_JPL]'" << std::endl;
+  std::cerr << "\t[Optional] '--chunksize [N]' '--teamsize [N]' '--vectorsize [N]' '--dynamic'" << std::endl;
+  std::cerr << "\t[Optional] '--ordering [NATURAL|LARGEST_FIRST|SMALLEST_LAST|ALL]' (ALL reports the colors and the time of each one)" << std::endl;
+  std::cerr << "\t[Optional] '--deterministic' (the same colors on every execution space, with JPL)" << std::endl;
+  std::cerr << "\tVerbose Output: '--verbose' (also prints the colors)" << std::endl;
 }
 int parse_inputs (KokkosKernels::Experiment::Parameters &params, int argc, char **argv){
   for ( int i = 1 ; i < argc ; ++i ) {
-    if ( 0 == strcasecmp( argv[i] , "--threads" ) ) {
-      params.use_threads = atoi( argv[++i] );
-    }
-    else if ( 0 == strcasecmp( argv[i] , "--serial" ) ) {
-      params.use_serial = atoi( argv[++i] );
-    }
-    else if ( 0 == strcasecmp( argv[i] , "--openmp" ) ) {
-      params.use_openmp = atoi( argv[++i] );
-    }
-    else if ( 0 == strcasecmp( argv[i] , "--cuda" ) ) {
-      params.use_cuda = 1;
+    if ( KokkosKernels::Experiment::parse_benchmark_option( params, argc, argv, i ) ) {
+      //backend, repeat, warmup and report options.
     }
-    else if ( 0 == strcasecmp( argv[i] , "--repeat" ) ) {
-      params.repeat = atoi( argv[++i] );
-    }
-
     else if ( 0 == strcasecmp( argv[i] , "--chunksize" ) ) {
       params.chunk_size = atoi( argv[++i] ) ;
     }
@@ -89,6 +83,29 @@ int parse_inputs (KokkosKernels::Experiment::Parameters &params, int argc, char
     else if ( 0 == strcasecmp( argv[i] , "--amtx" ) ) {
       params.a_mtx_bin_file = argv[++i];
     }
+    else if ( 0 == strcasecmp( argv[i] , "--ordering" ) ) {
+      ++i;
+      if ( 0 == strcasecmp( argv[i] , "NATURAL" ) ) {
+        params.coloring_ordering = 0;
+      }
+      else if ( 0 == strcasecmp( argv[i] , "LARGEST_FIRST" ) ) {
+        params.coloring_ordering = 1;
+      }
+      else if ( 0 == strcasecmp( argv[i] , "SMALLEST_LAST" ) ) {
+        params.coloring_ordering = 2;
+      }
+      else if ( 0 == strcasecmp( argv[i] , "ALL" ) ) {
+        params.coloring_ordering = -1;
+      }
+      else {
+        std::cerr << "2-Unrecognized command line argument #" << i << ": " << argv[i] << std::endl ;
+        print_options();
+        return 1;
+      }
+    }
+    else if ( 0 == strcasecmp( argv[i] , "--deterministic" ) ) {
+      params.coloring_deterministic = 1;
+    }
     else if ( 0 == strcasecmp( argv[i] , "--dynamic" ) ) {
       params.use_dynamic_scheduling = 1;
     }
@@ -115,6 +132,9 @@ int parse_inputs (KokkosKernels::Experiment::Parameters &params, int argc, char
       else if ( 0 == strcasecmp( argv[i] , "COLORING_EB" ) ) {
         params.algorithm = 6;
       }
+      else if ( 0 == strcasecmp( argv[i] , "COLORING_JPL" ) ) {
+        params.algorithm = 7;
+      }
       else {
         std::cerr << "2-Unrecognized command line argument #" << i << ": " << argv[i] << std::endl ;
         print_options();
@@ -181,44 +201,75 @@ void run_experiment(
     kh.set_verbose(true);
   }
 
-  for (int i = 0; i < repeat; ++i){
-
-    switch (algorithm){
-    case 1:
-      kh.create_graph_coloring_handle(COLORING_DEFAULT);
-
-      break;
-    case 2:
-      kh.create_graph_coloring_handle(COLORING_SERIAL);
-
-      break;
-    case 3:
-      kh.create_graph_coloring_handle(COLORING_VB);
-      break;
-    case 4:
-      kh.create_graph_coloring_handle(COLORING_VBBIT);
-
-      break;
-    case 5:
-      kh.create_graph_coloring_handle(COLORING_VBCS);
-
-      break;
-    case 6:
-      kh.create_graph_coloring_handle(COLORING_EB);
-      break;
-    default:
-      kh.create_graph_coloring_handle(COLORING_DEFAULT);
+  //with ALL, one result per ordering, for the colors against the time.
+  std::vector<ColoringOrdering> orderings;
+  if (params.coloring_ordering < 0){
+    orderings.push_back(COLORING_ORDER_NATURAL);
+    orderings.push_back(COLORING_ORDER_LARGEST_FIRST);
+    orderings.push_back(COLORING_ORDER_SMALLEST_LAST);
+  }
+  else {
+    orderings.push_back(ColoringOrdering(params.coloring_ordering));
+  }
+  const char *ordering_names[] = {"NATURAL", "LARGEST_FIRST", "SMALLEST_LAST"};
+
+  BenchmarkReport report(params);
+  for (size_t o = 0; o < orderings.size(); ++o){
+    BenchmarkResult result("graph_color");
+    result.add_param("algorithm", algorithm)
+          .add_param("ordering", ordering_names[orderings[o]])
+          .add_param("deterministic", params.coloring_deterministic)
+          .add_param("num_vertices", crsGraph.numRows())
+          .add_param("num_edges", crsGraph.entries.extent(0));
+    int num_colors = 0, num_phases = 0;
+
+    for (int i = -params.warmup; i < repeat; ++i){
+
+      switch (algorithm){
+      case 1:
+        kh.create_graph_coloring_handle(COLORING_DEFAULT);
+
+        break;
+      case 2:
+        kh.create_graph_coloring_handle(COLORING_SERIAL);
+
+        break;
+      case 3:
+        kh.create_graph_coloring_handle(COLORING_VB);
+        break;
+      case 4:
+        kh.create_graph_coloring_handle(COLORING_VBBIT);
+
+        break;
+      case 5:
+        kh.create_graph_coloring_handle(COLORING_VBCS);
+
+        break;
+      case 6:
+        kh.create_graph_coloring_handle(COLORING_EB);
+        break;
+      case 7:
+        kh.create_graph_coloring_handle(COLORING_JPL);
+        break;
+      default:
+        kh.create_graph_coloring_handle(COLORING_DEFAULT);
 
+      }
+      kh.get_graph_coloring_handle()->set_coloring_ordering(orderings[o]);
+      kh.get_graph_coloring_handle()->set_deterministic(params.coloring_deterministic != 0);
+      graph_color_symbolic(&kh,crsGraph.numRows(), crsGraph.numCols(), crsGraph.row_map, crsGraph.entries);
+
+      if (i >= 0) result.record(kh.get_graph_coloring_handle()->get_overall_coloring_time());
+      num_colors = kh.get_graph_coloring_handle()->get_num_colors();
+      num_phases = kh.get_graph_coloring_handle()->get_num_phases();
+      if (verbose){
+        std::cout << "\t"; KokkosKernels::Impl::print_1Dview(kh.get_graph_coloring_handle()->get_vertex_colors());
+      }
     }
-    graph_color_symbolic(&kh,crsGraph.numRows(), crsGraph.numCols(), crsGraph.row_map, crsGraph.entries);
-
-    std::cout <<
-        "Time:" << kh.get_graph_coloring_handle()->get_overall_coloring_time() << " "
-        "Num colors:" << kh.get_graph_coloring_handle()->get_num_colors() << " "
-        "Num Phases:" << kh.get_graph_coloring_handle()->get_num_phases() << std::endl;
-    std::cout << "\t"; KokkosKernels::Impl::print_1Dview(kh.get_graph_coloring_handle()->get_vertex_colors());
-
+    result.add_param("num_colors", num_colors).add_param("num_phases", num_phases);
+    report.add(result);
   }
+  report.write();
 }
 
 template <typename size_type, typename lno_t,
@@ -429,13 +480,12 @@ int main (int argc, char ** argv){
   }
   if (params.a_mtx_bin_file == NULL){
     std::cerr << "Provide a matrix file" << std::endl ;
+    print_options();
     return 0;
   }
   std::cout << "Sizeof(idx):" << sizeof(idx) << " sizeof(size_type):" << sizeof(size_type) << std::endl;
 
-  const int num_threads = params.use_openmp; // Assumption is that use_openmp variable is provided as number of threads
-  const int device_id = 0;
-  Kokkos::initialize( Kokkos::InitArguments( num_threads, -1, device_id ) );
+  Kokkos::initialize( KokkosKernels::Experiment::get_benchmark_init_arguments( params ) );
   Kokkos::print_configuration(std::cout);
 
 #if defined( KOKKOS_ENABLE_OPENMP )
@@ -0,0 +1,172 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <cstdlib>
+#include <iostream>
+
+#include "KokkosGraph_ConnectedComponents.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+#include "KokkosKernels_MyCRSMatrix.hpp"
+#include "KokkosKernels_TestParameters.hpp"
+
+
+
+void print_options(){
+  std::cerr << "Options\n" << std::endl;
+  std::cerr << "Choose BackEnd                     : --serial | --openmp [numthreads] | --cuda" << std::endl;
+  std::cerr << "Input Matrix                       : --amtx [path_to_input_matrix]" << std::endl;
+  std::cerr << "--symmetrize                       : If set, the graph is symmetrized first; connected_components needs a symmetric graph." << std::endl;
+  std::cerr << "--repeat [repeatnum]               : how many repeats will be run." << std::endl;
+}
+int parse_inputs (KokkosKernels::Experiment::Parameters &params, int argc, char **argv){
+  for ( int i = 1 ; i < argc ; ++i ) {
+    if ( 0 == strcasecmp( argv[i] , "--serial" ) ) {
+      params.use_serial = 1;
+    }
+    else if ( 0 == strcasecmp( argv[i] , "--openmp" ) ) {
+      params.use_openmp = atoi( argv[++i] );
+    }
+    else if ( 0 == strcasecmp( argv[i] , "--cuda" ) ) {
+      params.use_cuda = 1;
+    }
+    else if ( 0 == strcasecmp( argv[i] , "--repeat" ) ) {
+      params.repeat = atoi( argv[++i] );
+    }
+    else if ( 0 == strcasecmp( argv[i] , "--amtx" ) ) {
+      params.a_mtx_bin_file = argv[++i];
+    }
+    else if ( 0 == strcasecmp( argv[i] , "--symmetrize" ) ) {
+      params.symmetrize = 1;
+    }
+    else {
+      std::cerr << "Unrecognized command line argument #" << i << ": " << argv[i] << std::endl ;
+      print_options();
+      return 1;
+    }
+  }
+  return 0;
+}
+
+namespace KokkosKernels{
+
+namespace Experiment{
+
+template <typename size_type, typename lno_t, typename exec_space>
+void run_experiment(Parameters params){
+  typedef Kokkos::Device<exec_space, typename exec_space::memory_space> device_t;
+  typedef typename MyKokkosSparse::CrsMatrix<double, lno_t, device_t, void, size_type > crstmat_t;
+  typedef typename crstmat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type row_map_view_t;
+  typedef typename graph_t::entries_type::non_const_type cols_view_t;
+
+  crstmat_t crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<crstmat_t>(params.a_mtx_bin_file);
+  const lno_t num_verts = crsmat.numRows();
+
+  row_map_view_t row_map = crsmat.graph.row_map;
+  cols_view_t entries = crsmat.graph.entries;
+  if (params.symmetrize){
+    row_map_view_t sym_row_map;
+    cols_view_t sym_entries;
+    KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap
+      <row_map_view_t, cols_view_t, row_map_view_t, cols_view_t, exec_space>
+      (num_verts, row_map, entries, sym_row_map, sym_entries);
+    row_map = sym_row_map;
+    entries = sym_entries;
+  }
+  std::cout << "num_verts:" << num_verts << " num_edges:" << entries.extent(0) << std::endl;
+
+  cols_view_t labels("labels", num_verts);
+  for (int i = 0; i < params.repeat; ++i){
+    Kokkos::Impl::Timer timer1;
+    lno_t num_components = KokkosGraph::Experimental::connected_components(num_verts, row_map, entries, labels);
+    double cc_time = timer1.seconds();
+    std::cout << "Time:" << cc_time << " Num components:" << num_components << std::endl;
+  }
+}
+
+}
+}
+
+int main (int argc, char ** argv){
+
+  typedef unsigned size_type;
+  typedef int idx;
+
+  KokkosKernels::Experiment::Parameters params;
+
+  if (parse_inputs (params, argc, argv) ){
+    return 1;
+  }
+  if (params.a_mtx_bin_file == NULL){
+    std::cerr << "Provide a matrix file" << std::endl ;
+    return 0;
+  }
+  std::cout << "Sizeof(idx):" << sizeof(idx) << " sizeof(size_type):" << sizeof(size_type) << std::endl;
+
+  const int num_threads = params.use_openmp; // Assumption is that use_openmp variable is provided as number of threads
+  const int device_id = 0;
+  Kokkos::initialize( Kokkos::InitArguments( num_threads, -1, device_id ) );
+  Kokkos::print_configuration(std::cout);
+
+#if defined( KOKKOS_ENABLE_OPENMP )
+  if (params.use_openmp) {
+    KokkosKernels::Experiment::run_experiment<size_type, idx, Kokkos::OpenMP>(params);
+  }
+#endif
+
+#if defined( KOKKOS_ENABLE_CUDA )
+  if (params.use_cuda) {
+    KokkosKernels::Experiment::run_experiment<size_type, idx, Kokkos::Cuda>(params);
+  }
+#endif
+
+#if defined( KOKKOS_ENABLE_SERIAL )
+  if (params.use_serial) {
+    KokkosKernels::Experiment::run_experiment<size_type, idx, Kokkos::Serial>(params);
+  }
+#endif
+
+  Kokkos::finalize();
+
+  return 0;
+}
@@ -43,6 +43,8 @@
 
 #include "KokkosGraph_run_triangle.hpp"
 #include "KokkosKernels_MyCRSMatrix.hpp"
+#include "KokkosKernels_MemoryPlacement.hpp"
+#include <vector>
 namespace KokkosKernels{
 
 namespace Experiment{
@@ -81,7 +83,59 @@ namespace Experiment{
 
 
     //read a and b matrices and store them on slow or fast memory.
-    if (params.a_mem_space == 1){
+    if (params.fast_memory_size > 0){
+      //read to slow memory, and let the placement policy choose the memory spaces.
+      slow_crstmat_t a_slow_crsmat;
+      a_slow_crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<slow_crstmat_t>(a_mat_file);
+
+      //multiplications of the lower triangle product, on the host.
+      auto row_map = Kokkos::create_mirror_view(a_slow_crsmat.graph.row_map);
+      auto entries = Kokkos::create_mirror_view(a_slow_crsmat.graph.entries);
+      Kokkos::deep_copy(row_map, a_slow_crsmat.graph.row_map);
+      Kokkos::deep_copy(entries, a_slow_crsmat.graph.entries);
+      const size_t nv = a_slow_crsmat.numRows();
+      std::vector<size_t> lower_row_sizes(nv, 0);
+      size_t lower_nnz = 0;
+      for (size_t i = 0; i < nv; ++i){
+        for (size_t j = row_map(i); j < size_t(row_map(i + 1)); ++j){
+          if (size_t(entries(j)) < i) ++lower_row_sizes[i];
+        }
+        lower_nnz += lower_row_sizes[i];
+      }
+      size_t flops = 0, max_row_flops = 0;
+      for (size_t i = 0; i < nv; ++i){
+        size_t row_flops = 0;
+        for (size_t j = row_map(i); j < size_t(row_map(i + 1)); ++j){
+          if (size_t(entries(j)) < i) row_flops += lower_row_sizes[entries(j)];
+        }
+        flops += row_flops;
+        if (row_flops > max_row_flops) max_row_flops = row_flops;
+      }
+
+      KokkosKernels::MemoryPlacement placement(params.fast_memory_size);
+      placement.predict_triangle<size_type, lno_t>(
+          nv, lower_nnz, flops, max_row_flops, myExecSpace::concurrency());
+      const int memspaces = placement.place();
+      placement.print(std::cout);
+
+      typedef KokkosKernels::MemoryPlacement placement_t;
+      params.a_mem_space = placement_t::is_fast(memspaces, placement_t::A);
+      params.b_mem_space = placement_t::is_fast(memspaces, placement_t::B);
+      params.c_mem_space = placement_t::is_fast(memspaces, placement_t::C);
+      params.work_mem_space = placement_t::is_fast(memspaces, placement_t::WORK);
+
+      if (params.a_mem_space == 1){
+        fast_crstmat_t a_fast_crsmat =
+            MyKokkosSparse::copy_crsmat<myExecSpace, slow_crstmat_t, fast_crstmat_t>(a_slow_crsmat);
+        a_fast_crsgraph = a_fast_crsmat.graph;
+        a_fast_crsgraph.num_cols = a_fast_crsmat.numCols();
+      }
+      else {
+        a_slow_crsgraph = a_slow_crsmat.graph;
+        a_slow_crsgraph.num_cols = a_slow_crsmat.numCols();
+      }
+    }
+    else if (params.a_mem_space == 1){
       fast_crstmat_t a_fast_crsmat;
       a_fast_crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<fast_crstmat_t>(a_mat_file);
       a_fast_crsgraph = a_fast_crsmat.graph;
@@ -238,7 +238,12 @@ void run_experiment(
 
 
 
-  for (int i = 0; i < repeat; ++i){
+  BenchmarkResult count_result("triangle_count"), preprocess_result("triangle_preprocess"), total_result("triangle");
+  count_result.add_param("algorithm", algorithm).add_param("num_rows", m).add_param("nnz", crsGraph.entries.extent(0));
+  preprocess_result.params = total_result.params = count_result.params;
+  size_t num_triangles = 0;
+
+  for (int i = -params.warmup; i < repeat; ++i){
     size_type rowmap_size = crsGraph.entries.extent(0) ;
     switch (algorithm){
     case 16:
@@ -247,7 +252,6 @@ void run_experiment(
       break;
     case 17:
       kh.create_spgemm_handle(SPGEMM_KK_TRIANGLE_IA);
-      std::cout << "IA" << std::endl;
       break;
     case 18:
       kh.create_spgemm_handle(SPGEMM_KK_TRIANGLE_IA_UNION);
@@ -271,6 +275,7 @@ void run_experiment(
     kh.get_spgemm_handle()->set_create_lower_triangular(params.right_lower_triangle);
     kh.get_spgemm_handle()->set_compression(params.apply_compression);
     kh.get_spgemm_handle()->set_sort_option(params.sort_option);
+    kh.get_spgemm_handle()->set_relabel_by_degree(params.relabel_by_degree);
     kh.get_spgemm_handle()->set_min_hash_size_scale(params.minhashscale);
 
     switch (accumulator){
@@ -290,11 +295,11 @@ void run_experiment(
     constexpr size_t LLC_CAPACITY = 256*4*1024*1024;
     if (params.cache_flush)
     {
-    std::cout << "Flushing cache with option:" << params.cache_flush << std::endl;
+    if (verbose) std::cout << "Flushing cache with option:" << params.cache_flush << std::endl;
     Flush<LLC_CAPACITY, ExecSpace> flush(params.cache_flush);
         flush.run();
     }
-    if (i == 0){
+    if (i == -params.warmup){
       kh.get_spgemm_handle()->set_read_write_cost_calc(params.calculate_read_write_cost);
     }
 
@@ -309,6 +314,7 @@ void run_experiment(
     valuesC  = lno_nnz_view_t ("");
 
     double symbolic_time = 0;
+    double preprocess_time = 0;
     if (params.triangle_options == 0 ){
       if (params.apply_compression){
         triangle_generic (
@@ -339,18 +345,29 @@ void run_experiment(
         );
       }
 
-      size_t num_triangles = 0;
+      num_triangles = 0;
       KokkosKernels::Impl::kk_reduce_view< Kokkos::View <size_t *,ExecSpace>, ExecSpace>(rowmap_size, row_mapC, num_triangles);
       ExecSpace::fence();
 
       symbolic_time = timer1.seconds();
-      std::cout << "num_triangles:" << num_triangles << std::endl;
+      preprocess_time = kh.get_spgemm_handle()->get_triangle_preprocess_time();
     }
     kh.destroy_spgemm_handle();
-    std::cout  << "mm_time:" << symbolic_time << std::endl;
+    if (i >= 0){
+      total_result.record(symbolic_time);
+      preprocess_result.record(preprocess_time);
+      count_result.record(symbolic_time - preprocess_time);
+    }
     //only do this once
     //kh.get_spgemm_handle()->set_read_write_cost_calc(false);
   }
+  total_result.add_param("num_triangles", num_triangles);
+
+  BenchmarkReport report(params);
+  report.add(preprocess_result);
+  report.add(count_result);
+  report.add(total_result);
+  report.write();
 }
 
 
@@ -53,7 +53,7 @@
 
 void print_options(){
   std::cerr << "Options\n" << std::endl;
-  std::cerr << "Choose BackEnd                     : --openmp [numthreads] | --cuda" << std::endl;
+  KokkosKernels::Experiment::print_benchmark_options(std::cerr);
   std::cerr << "Input Matrix                       : --amtx [path_to_input_matrix]" << std::endl;
   std::cerr << "\tInput Matrix format can be multiple formats. If it ends with:" << std::endl;
   std::cerr << "\t\t.mtx: it will read matrix market format." << std::endl;
@@ -68,14 +68,15 @@ void print_options(){
   std::cerr << "--FLOP                               : Calculate and print the number of operations. This will be calculated on the first run." << std::endl;
   std::cerr << "--COMPRESSION [0|1]                   : Enable disable compression. Default:1." << std::endl;
   std::cerr << "--RS [0|1|2]                         : Whether to sort lower triangular matrix. 0 - no sort, 1 - sort, 2 - algorithm decides based on max row size (default)" << std::endl;
+  std::cerr << "--relabel                            : If given, vertices are relabeled by degree before the lower triangle is created. The order follows --sort_option." << std::endl;
   std::cerr << "--accumulator [default|dense|sparse] : what type of accumulator to use." << std::endl;
   std::cerr << "--RLT                                : If given, lower triangle will be used for AdjxIncidence or Incidence x Adj algorithms." << std::endl;
   std::cerr << "--dynamic                            : If set, dynamic schedule will be used. Currently default is dynamic scheduling as well." << std::endl;
   std::cerr << "--verbose                            : If set, the inner timer stats will be printed." << std::endl;
-  std::cerr << "--repeat [repeatnum]                 : how many repeats will be run." << std::endl;
   std::cerr << "--chunksize [chunksize]              : how many vertices are executed with in a loop index. Default is 16." << std::endl;
   std::cerr << "--sort_option [0|1|2]                : How lower triangle will be sorted. 0: for largest to bottom, 1 for largest to top, 2 for interleaved." << std::endl;
   std::cerr << "--cache_flush [0|1|2]                : Flush between repetitions. 0 - no flush, 1 - soft flush, 2 - hard flush with random numbers." << std::endl;
+  std::cerr << "--fastmemsize [MB]                   : Instead of --memspaces, place the arrays that are accessed the most per byte on HBM, as long as they fit this size." << std::endl;
 
   std::cerr << "\nSuggested use of LL: executable --amtx path_to_file.bin --algorithm TRIANGLELL --repeat 6 --verbose --chunksize [4|16]" << std::endl;
   std::cerr << "Suggested use of LU: executable --amtx path_to_file.bin --algorithm TRIANGLELU --repeat 6 --verbose --chunksize [4|16]" << std::endl;
@@ -86,17 +87,8 @@ void print_options(){
 
 int parse_inputs (KokkosKernels::Experiment::Parameters &params, int argc, char **argv){
   for ( int i = 1 ; i < argc ; ++i ) {
-    if ( 0 == strcasecmp( argv[i] , "--threads" ) ) {
-      params.use_threads = atoi( argv[++i] );
-    }
-    else if ( 0 == strcasecmp( argv[i] , "--openmp" ) ) {
-      params.use_openmp = atoi( argv[++i] );
-    }
-    else if ( 0 == strcasecmp( argv[i] , "--cuda" ) ) {
-      params.use_cuda = 1;
-    }
-    else if ( 0 == strcasecmp( argv[i] , "--repeat" ) ) {
-      params.repeat = atoi( argv[++i] );
+    if ( KokkosKernels::Experiment::parse_benchmark_option( params, argc, argv, i ) ) {
+      //backend, repeat, warmup and report options.
     }
     else if ( 0 == strcasecmp( argv[i] , "--triangle_operation" ) ) {
       params.triangle_options = atoi( argv[++i] );
@@ -116,6 +108,9 @@ int parse_inputs (KokkosKernels::Experiment::Parameters &params, int argc, char
     else if ( 0 == strcasecmp( argv[i] , "--sort_option" ) ) {
       params.sort_option = atoi( argv[++i] ) ;
     }
+    else if ( 0 == strcasecmp( argv[i] , "--fastmemsize" ) ) {
+      params.fast_memory_size = size_t(atof( argv[++i] ) * 1024 * 1024);
+    }
     else if ( 0 == strcasecmp( argv[i] , "--memspaces" ) ) {
       int memspaces = atoi( argv[++i] ) ;
       int memspaceinfo = memspaces;
@@ -212,6 +207,9 @@ int parse_inputs (KokkosKernels::Experiment::Parameters &params, int argc, char
     else if ( 0 == strcasecmp( argv[i] , "--RS" ) ) {
       params.right_sort = atoi(argv[++i]);
     }
+    else if ( 0 == strcasecmp( argv[i] , "--relabel" ) ) {
+      params.relabel_by_degree = 1;
+    }
 
     else if ( 0 == strcasecmp( argv[i] , "--verbose" ) ) {
       params.verbose = 1;
@@ -287,9 +285,7 @@ int main (int argc, char ** argv){
 
   std::cout << "Sizeof(idx):" << sizeof(idx) << " sizeof(size_type):" << sizeof(size_type) << std::endl;
 
-  const int num_threads = params.use_openmp; // Assumption is that use_openmp variable is provided as number of threads
-  const int device_id = 0;
-  Kokkos::initialize( Kokkos::InitArguments( num_threads, -1, device_id ) );
+  Kokkos::initialize( KokkosKernels::Experiment::get_benchmark_init_arguments( params ) );
 
 #if !defined (KOKKOS_ENABLE_CUDA)
 #if defined( KOKKOS_ENABLE_OPENMP )
@@ -0,0 +1,79 @@
+#! /usr/bin/env python
+
+"""
+Compare two result directories written by run_suite.sh, e.g.,
+
+  ./compare_results.py --threshold 5 perf_results/1a2b3c4 perf_results/5d6e7f8
+
+Results are matched by report file, name and parameters; the median times
+(or the minimum times with --min) are compared and a result slower than
+the baseline by more than the threshold (in percent) is a regression. The
+exit code is 1 when there is a regression.
+"""
+
+from __future__ import print_function
+
+import argparse, glob, json, os, sys
+
+# parameters that describe the outcome of a run rather than its input
+volatile_params = set(["num_errors", "num_colors", "num_phases", "num_triangles", "num_iter", "diff_to_ref"])
+
+def load_results(directory):
+  results = {}
+  for filename in sorted(glob.glob(os.path.join(directory, "*.json"))):
+    try:
+      with open(filename) as f:
+        report = json.load(f)
+    except ValueError:
+      print("Skipping %s: not a valid report" % filename, file=sys.stderr)
+      continue
+    for res in report.get("results", []):
+      params = tuple(sorted((k, v) for k, v in res.get("params", {}).items() if k not in volatile_params))
+      results[(os.path.basename(filename), res["name"], params)] = res
+  return results
+
+def describe(key):
+  filename, name, params = key
+  label = "%s %s" % (os.path.splitext(filename)[0], name)
+  if params:
+    label += " (" + ", ".join("%s=%s" % p for p in params) + ")"
+  return label
+
+def main():
+  parser = argparse.ArgumentParser(description="Compare benchmark results against a baseline.")
+  parser.add_argument("baseline", help="directory of the baseline results")
+  parser.add_argument("current", help="directory of the current results")
+  parser.add_argument("--threshold", type=float, default=5.0, help="slowdown in percent flagged as a regression (default 5)")
+  parser.add_argument("--min", action="store_true", dest="use_min", help="compare minimum instead of median times")
+  args = parser.parse_args()
+
+  stat = "min" if args.use_min else "median"
+  baseline = load_results(args.baseline)
+  current = load_results(args.current)
+  if not baseline or not current:
+    print("No results to compare in %s and %s" % (args.baseline, args.current), file=sys.stderr)
+    return 1
+
+  regressions = 0
+  print("%-70s %12s %12s %9s" % ("result", "baseline", "current", "change"))
+  for key in sorted(set(baseline) & set(current)):
+    t0, t1 = baseline[key][stat], current[key][stat]
+    if t0 <= 0:
+      continue
+    change = 100.0*(t1 - t0)/t0
+    flag = ""
+    if change > args.threshold:
+      flag = " REGRESSION"
+      regressions += 1
+    print("%-70s %12.6g %12.6g %+8.1f%%%s" % (describe(key)[:70], t0, t1, change, flag))
+
+  for key in sorted(set(baseline) - set(current)):
+    print("%-70s missing in %s" % (describe(key)[:70], args.current))
+  for key in sorted(set(current) - set(baseline)):
+    print("%-70s new in %s" % (describe(key)[:70], args.current))
+
+  print("\n%d regressions beyond %.1f%% in %s times" % (regressions, args.threshold, stat))
+  return 1 if regressions else 0
+
+if __name__ == "__main__":
+  sys.exit(main())
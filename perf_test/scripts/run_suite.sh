@@ -0,0 +1,155 @@
+#!/bin/bash
+#
+# Runs the SpMV, SpGEMM, Gauss-Seidel (PCG), coloring and triangle perf tests
+# over the matrices of a suite file and stores the JSON reports under
+# RESULTS/<commit>. With --baseline, the results are compared against an
+# earlier run and the script fails if a kernel slowed down by more than
+# the threshold, e.g.,
+#
+#   ./run_suite.sh --bin ../../build/perf_test --backend "--openmp 16"
+#   ./run_suite.sh --bin ../../build/perf_test --backend "--openmp 16" \
+#                  --baseline perf_results/1a2b3c4 --threshold 5
+#
+
+script_dir=$(cd $(dirname $0) && pwd)
+
+bin=.
+suite=$script_dir/suite.txt
+results=perf_results
+cache=perf_matrices
+backend="--openmp 1"
+repeat=6
+drivers="spmv spgemm gs color triangle"
+baseline=
+threshold=5
+commit=
+
+usage() {
+    echo "Usage: $0 [--bin DIR] [--suite FILE] [--results DIR] [--cache DIR]"
+    echo "          [--backend \"--openmp N\" | \"--cuda\"] [--repeat N] [--drivers \"$drivers\"]"
+    echo "          [--commit ID] [--baseline DIR] [--threshold PERCENT]"
+}
+
+while [ $# -gt 0 ]; do
+    case $1 in
+        --bin)       bin=$2; shift;;
+        --suite)     suite=$2; shift;;
+        --results)   results=$2; shift;;
+        --cache)     cache=$2; shift;;
+        --backend)   backend=$2; shift;;
+        --repeat)    repeat=$2; shift;;
+        --drivers)   drivers=$2; shift;;
+        --commit)    commit=$2; shift;;
+        --baseline)  baseline=$2; shift;;
+        --threshold) threshold=$2; shift;;
+        -h|--help)   usage; exit 0;;
+        *)           echo "Unknown option $1"; usage; exit 1;;
+    esac
+    shift
+done
+
+if [ -z "$commit" ]; then
+    commit=$(git -C $script_dir rev-parse --short HEAD 2>/dev/null || echo unknown)
+fi
+out=$results/$commit
+mkdir -p $out $cache
+
+# executable names of the Makefile and of the CMake build
+find_exe() {
+    for name in "$@"; do
+        for exe in $bin/$name.exe $bin/KokkosKernels_$name.exe $bin/*/KokkosKernels_$name.exe; do
+            if [ -x "$exe" ]; then echo $exe; return; fi
+        done
+    done
+}
+
+converter=$(find_exe KokkosKernels_MatrixConverter matrix_converter)
+
+# prepares <label>.mtx and <label>.bin in the cache and prints the label
+prepare_matrix() {
+    local spec=$1 label
+    case $spec in
+        gen:*)
+            label=$(echo ${spec#gen:} | tr ':' '_')
+            if [ ! -f $cache/$label.mtx ]; then
+                $converter --generate ${spec#gen:} --out_mtx $cache/$label.mtx > /dev/null || return 1
+            fi;;
+        ss:*)
+            label=$(basename ${spec#ss:})
+            if [ ! -f $cache/$label.mtx ]; then
+                curl -sSfL -o $cache/$label.tar.gz https://sparse.tamu.edu/MM/${spec#ss:}.tar.gz || return 1
+                tar -xzf $cache/$label.tar.gz -C $cache $label/$label.mtx || return 1
+                mv $cache/$label/$label.mtx $cache/$label.mtx
+                rm -rf $cache/$label $cache/$label.tar.gz
+            fi;;
+        *)
+            label=$(basename ${spec%.*})
+            if [ ! -f $cache/$label.mtx ] && [ ! -f $cache/$label.bin ]; then
+                cp $spec $cache/ || return 1
+            fi;;
+    esac
+    if [ ! -f $cache/$label.bin ] && [ -n "$converter" ]; then
+        $converter --in_mtx $cache/$label.mtx --out_mtx $cache/$label.bin > /dev/null || return 1
+    fi
+    echo $label
+}
+
+# the backend options of the PCG driver have no argument for cuda
+gs_backend=$(echo $backend | sed 's/--cuda \([0-9]*\)/--cuda-dev \1/')
+
+{
+    echo "commit: $commit"
+    echo "date: $(date -u +%Y-%m-%dT%H:%M:%SZ)"
+    echo "host: $(hostname)"
+    echo "backend: $backend"
+    echo "repeat: $repeat"
+    echo "suite: $suite"
+} > $out/manifest.txt
+
+failures=0
+while read -r spec; do
+    spec=${spec%%#*}
+    spec=$(echo $spec)
+    [ -z "$spec" ] && continue
+
+    label=$(prepare_matrix $spec)
+    if [ -z "$label" ]; then
+        echo "Cannot prepare $spec"
+        failures=$((failures+1))
+        continue
+    fi
+    echo "matrix: $spec ($label)" >> $out/manifest.txt
+
+    for driver in $drivers; do
+        common="--repeat $repeat --format json --output $out/$driver-$label.json"
+        case $driver in
+            spmv)     exe=$(find_exe KokkosSparse_spmv sparse_spmv)
+                      args="-f $cache/$label.mtx --test all $backend $common";;
+            spgemm)   exe=$(find_exe KokkosSparse_spgemm sparse_spgemm)
+                      args="--amtx $cache/$label.bin $backend $common";;
+            gs)       exe=$(find_exe KokkosSparse_pcg sparse_pcg)
+                      args="--mtx $cache/$label.bin $gs_backend --repeat 1 --format json --output $out/$driver-$label.json";;
+            color)    exe=$(find_exe KokkosGraph_color graph_color)
+                      args="--amtx $cache/$label.bin $backend --algorithm COLORING_DEFAULT $common";;
+            triangle) exe=$(find_exe KokkosGraph_triangle graph_triangle)
+                      args="--amtx $cache/$label.bin $backend --algorithm TRIANGLELL $common";;
+            *)        echo "Unknown driver $driver"; continue;;
+        esac
+        if [ -z "$exe" ]; then
+            echo "Skipping $driver: no executable in $bin"
+            continue
+        fi
+        echo "$exe $args"
+        if ! $exe $args > $out/$driver-$label.log 2>&1 || [ ! -s $out/$driver-$label.json ]; then
+            echo "  failed, see $out/$driver-$label.log"
+            failures=$((failures+1))
+        fi
+    done
+done < $suite
+
+echo "Results are in $out ($failures failures)"
+
+if [ -n "$baseline" ]; then
+    ${PYTHON:-python} $script_dir/compare_results.py --threshold $threshold $baseline $out || exit 1
+fi
+[ $failures -eq 0 ]
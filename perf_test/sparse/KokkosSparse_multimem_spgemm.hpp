@@ -43,6 +43,7 @@
 
 #include "KokkosKernels_MyCRSMatrix.hpp"
 #include "KokkosSparse_run_spgemm.hpp"
+#include "KokkosKernels_MemoryPlacement.hpp"
 namespace KokkosKernels{
 
 namespace Experiment{
@@ -81,27 +82,68 @@ namespace Experiment{
     fast_crstmat_t a_fast_crsmat, b_fast_crsmat, c_fast_crsmat;
 
     //read a and b matrices and store them on slow or fast memory.
-
-    if (params.a_mem_space == 1){
-      a_fast_crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<fast_crstmat_t>(a_mat_file);
-    }
-    else {
+    if (params.fast_memory_size > 0){
+      //read both to slow memory, and let the placement policy choose the memory spaces.
       a_slow_crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<slow_crstmat_t>(a_mat_file);
-    }
+      const bool b_is_a = b_mat_file == NULL || strcmp(b_mat_file, a_mat_file) == 0;
+      if (b_is_a){
+        std::cout << "Using A matrix for B as well" << std::endl;
+        b_slow_crsmat = a_slow_crsmat;
+      }
+      else {
+        b_slow_crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<slow_crstmat_t>(b_mat_file);
+      }
 
+      size_t flops = 0, max_row_flops = 0;
+      MyKokkosSparse::get_spgemm_flops(a_slow_crsmat, b_slow_crsmat, flops, max_row_flops);
+      //nnz of C is not known before the symbolic phase, flops bounds it.
+      const size_t m = a_slow_crsmat.numRows(), n = b_slow_crsmat.numCols();
+      const size_t nnzC = std::min(flops, m * n);
 
-    if ((b_mat_file == NULL || strcmp(b_mat_file, a_mat_file) == 0) && params.b_mem_space == params.a_mem_space){
-      std::cout << "Using A matrix for B as well" << std::endl;
-      b_fast_crsmat = a_fast_crsmat;
-      b_slow_crsmat = a_slow_crsmat;
-    }
-    else if (params.b_mem_space == 1){
-      if (b_mat_file == NULL) b_mat_file = a_mat_file;
-      b_fast_crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<fast_crstmat_t>(b_mat_file);
+      KokkosKernels::MemoryPlacement placement(params.fast_memory_size);
+      placement.predict_spgemm<size_type, lno_t, scalar_t>(
+          m, b_slow_crsmat.numRows(), n,
+          a_slow_crsmat.nnz(), b_slow_crsmat.nnz(), nnzC,
+          flops, max_row_flops, myExecSpace::concurrency());
+      const int memspaces = placement.place();
+      placement.print(std::cout);
+
+      typedef KokkosKernels::MemoryPlacement placement_t;
+      params.a_mem_space = placement_t::is_fast(memspaces, placement_t::A);
+      params.b_mem_space = placement_t::is_fast(memspaces, placement_t::B);
+      params.c_mem_space = placement_t::is_fast(memspaces, placement_t::C);
+      params.work_mem_space = placement_t::is_fast(memspaces, placement_t::WORK);
+
+      if (params.a_mem_space == 1){
+        a_fast_crsmat = MyKokkosSparse::copy_crsmat<myExecSpace, slow_crstmat_t, fast_crstmat_t>(a_slow_crsmat);
+      }
+      if (params.b_mem_space == 1){
+        if (b_is_a && params.a_mem_space == 1) b_fast_crsmat = a_fast_crsmat;
+        else b_fast_crsmat = MyKokkosSparse::copy_crsmat<myExecSpace, slow_crstmat_t, fast_crstmat_t>(b_slow_crsmat);
+      }
     }
     else {
-      if (b_mat_file == NULL) b_mat_file = a_mat_file;
-      b_slow_crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<slow_crstmat_t>(b_mat_file);
+      if (params.a_mem_space == 1){
+        a_fast_crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<fast_crstmat_t>(a_mat_file);
+      }
+      else {
+        a_slow_crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<slow_crstmat_t>(a_mat_file);
+      }
+
+
+      if ((b_mat_file == NULL || strcmp(b_mat_file, a_mat_file) == 0) && params.b_mem_space == params.a_mem_space){
+        std::cout << "Using A matrix for B as well" << std::endl;
+        b_fast_crsmat = a_fast_crsmat;
+        b_slow_crsmat = a_slow_crsmat;
+      }
+      else if (params.b_mem_space == 1){
+        if (b_mat_file == NULL) b_mat_file = a_mat_file;
+        b_fast_crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<fast_crstmat_t>(b_mat_file);
+      }
+      else {
+        if (b_mat_file == NULL) b_mat_file = a_mat_file;
+        b_slow_crsmat = KokkosKernels::Impl::read_kokkos_crst_matrix<slow_crstmat_t>(b_mat_file);
+      }
     }
 
     if (params.a_mem_space == 1){
@@ -50,6 +50,7 @@
 #include "KokkosKernels_Utils.hpp"
 #include <iostream>
 #include "KokkosKernels_IOUtils.hpp"
+#include "KokkosKernels_Benchmark.hpp"
 
 #define MAXVAL 1
 
@@ -85,7 +86,7 @@ vector_t create_y_vector(crsMat_t crsMat, vector_t x_vector){
 
 template <typename ExecSpace, typename crsMat_t>
 void run_experiment(
-    crsMat_t crsmat){
+    crsMat_t crsmat, const KokkosKernels::Experiment::BenchmarkOptions &opts){
 
 
   typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
@@ -100,7 +101,7 @@ void run_experiment(
   INDEX_TYPE nv = crsmat.numRows();
   scalar_view_t kok_x_original = create_x_vector<scalar_view_t>(nv, MAXVAL);
 
-  KokkosKernels::Impl::print_1Dview(kok_x_original);
+  if (opts.format == KokkosKernels::Experiment::BENCHMARK_TEXT) KokkosKernels::Impl::print_1Dview(kok_x_original);
   scalar_view_t kok_b_vector = create_y_vector(crsmat, kok_x_original);
 
   //create X vector
@@ -125,35 +126,76 @@ void run_experiment(
   KernelHandle kh;
 
 
-  kh.create_gs_handle();
-  Kokkos::Impl::Timer timer1;
-  KokkosKernels::Experimental::Example::pcgsolve(
-        kh
-      , crsmat
-      , kok_b_vector
-      , kok_x_vector
-      , cg_iteration_limit
-      , cg_iteration_tolerance
-      , & cg_result
-      , true
-  );
-  Kokkos::fence();
-
-  solve_time = timer1.seconds();
-
-
-  std::cout  << "DEFAULT SOLVE:"
-      << "\n\t(P)CG_NUM_ITER              [" << cg_result.iteration << "]"
-      << "\n\tMATVEC_TIME                 [" << cg_result.matvec_time << "]"
-      << "\n\tCG_RESIDUAL                 [" << cg_result.norm_res << "]"
-      << "\n\tCG_ITERATION_TIME           [" << cg_result.iter_time << "]"
-      << "\n\tPRECONDITIONER_TIME         [" << cg_result.precond_time << "]"
-      << "\n\tPRECONDITIONER_INIT_TIME    [" << cg_result.precond_init_time << "]"
-      << "\n\tPRECOND_APPLY_TIME_PER_ITER [" << cg_result.precond_time / (cg_result.iteration  + 1) << "]"
-      << "\n\tSOLVE_TIME                  [" << solve_time<< "]"
-      << std::endl ;
-
-
+  KokkosKernels::Experiment::BenchmarkReport report(opts);
+  const char *solve_names[3] = { "DEFAULT SOLVE", "FUSED COLORS SOLVE", "CAPTURED ITERATION SOLVE" };
+  const char *result_names[3] = { "pcg_gs", "pcg_gs_fused_colors", "pcg_gs_captured" };
+
+  for (int variant = 0; variant < 3; ++variant){
+    KokkosKernels::Experiment::BenchmarkResult solve_result(result_names[variant]);
+    solve_result.add_param("num_rows", nv).add_param("nnz", crsmat.nnz());
+    KokkosKernels::Experiment::BenchmarkResult init_result = solve_result, apply_result = solve_result;
+    init_result.name += "_init";
+    apply_result.name += "_apply";
+
+    for (int i = -opts.warmup; i < opts.repeat; ++i){
+      kh.destroy_gs_handle();
+      kh.create_gs_handle();
+      //the same solve, sweeping the consecutive small colors in one launch.
+      if (variant == 1) kh.get_gs_handle()->set_fused_color_size(256);
+
+      kok_x_vector = scalar_view_t("kok_x_vector", nv);
+      Kokkos::Impl::Timer timer1;
+      //the iteration is recorded once and replayed, as a Cuda Graph on Cuda.
+      if (variant == 2)
+        KokkosKernels::Experimental::Example::pcgsolve_captured(
+              kh
+            , crsmat
+            , kok_b_vector
+            , kok_x_vector
+            , cg_iteration_limit
+            , cg_iteration_tolerance
+            , & cg_result
+            , true
+        );
+      else
+        KokkosKernels::Experimental::Example::pcgsolve(
+              kh
+            , crsmat
+            , kok_b_vector
+            , kok_x_vector
+            , cg_iteration_limit
+            , cg_iteration_tolerance
+            , & cg_result
+            , true
+        );
+      Kokkos::fence();
+
+      solve_time = timer1.seconds();
+      if (i < 0) continue;
+
+      solve_result.record(solve_time);
+      init_result.record(cg_result.precond_init_time);
+      apply_result.record(cg_result.precond_time);
+      if (opts.format == KokkosKernels::Experiment::BENCHMARK_TEXT)
+        std::cout  << "\n" << solve_names[variant] << ":"
+            << "\n\t(P)CG_NUM_ITER              [" << cg_result.iteration << "]"
+            << "\n\tMATVEC_TIME                 [" << cg_result.matvec_time << "]"
+            << "\n\tCG_RESIDUAL                 [" << cg_result.norm_res << "]"
+            << "\n\tCG_ITERATION_TIME           [" << cg_result.iter_time << "]"
+            << "\n\tPRECONDITIONER_TIME         [" << cg_result.precond_time << "]"
+            << "\n\tPRECONDITIONER_INIT_TIME    [" << cg_result.precond_init_time << "]"
+            << "\n\tPRECOND_APPLY_TIME_PER_ITER [" << cg_result.precond_time / (cg_result.iteration  + 1) << "]"
+            << "\n\tSOLVE_TIME                  [" << solve_time<< "]"
+            << "\n\tGS_APPLY_LAUNCHES           [" << kh.get_gs_handle()->get_num_apply_launches() << "]"
+            << std::endl ;
+    }
+    solve_result.add_param("num_iter", cg_result.iteration);
+    apply_result.add_param("num_iter", cg_result.iteration);
+    report.add(init_result);
+    report.add(apply_result);
+    report.add(solve_result);
+  }
+  report.write();
 
   /*
   kh.destroy_gs_handle();
@@ -266,6 +308,10 @@ int main (int argc, char ** argv){
   char *mtx_bin_file = NULL;
   for ( int i = 0 ; i < CMD_COUNT ; ++i ) cmdline[i] = 0 ;
 
+  //the solve is long, so a single timed run by default
+  KokkosKernels::Experiment::BenchmarkOptions opts;
+  opts.repeat = 1;
+
 
   for ( int i = 1 ; i < argc ; ++i ) {
     if ( 0 == strcasecmp( argv[i] , "--threads" ) ) {
@@ -290,10 +336,14 @@ int main (int argc, char ** argv){
     else if ( 0 == strcasecmp( argv[i] , "--mtx" ) ) {
       mtx_bin_file = argv[++i];
     }
+    else if ( KokkosKernels::Experiment::parse_benchmark_option( opts, argc, argv, i ) ) {
+      //repeat, warmup and report options.
+    }
     else {
       cmdline[ CMD_ERROR ] = 1 ;
       std::cerr << "Unrecognized command line argument #" << i << ": " << argv[i] << std::endl ;
       std::cerr << "OPTIONS\n\t--threads [numThreads]\n\t--openmp [numThreads]\n\t--cuda\n\t--cuda-dev[DeviceIndex]\n\t--mtx[binary_mtx_file]" << std::endl;
+      KokkosKernels::Experiment::print_benchmark_options(std::cerr);
 
       return 0;
     }
@@ -302,6 +352,7 @@ int main (int argc, char ** argv){
   if (mtx_bin_file == NULL){
     std::cerr << "Provide a mtx binary file" << std::endl ;
     std::cerr << "OPTIONS\n\t--threads [numThreads]\n\t--openmp [numThreads]\n\t--cuda\n\t--cuda-dev[DeviceIndex]\n\t--mtx[binary_mtx_file]" << std::endl;
+      KokkosKernels::Experiment::print_benchmark_options(std::cerr);
 
     return 0;
   }
@@ -357,7 +408,7 @@ int main (int argc, char ** argv){
       delete [] adj;
       delete [] ew;
 
-      run_experiment<myExecSpace, crsMat_t>(crsmat);
+      run_experiment<myExecSpace, crsMat_t>(crsmat, opts);
 
       Kokkos::finalize();
     }
@@ -412,7 +463,7 @@ int main (int argc, char ** argv){
       delete [] adj;
       delete [] ew;
 
-      run_experiment<myExecSpace, crsMat_t>(crsmat);
+      run_experiment<myExecSpace, crsMat_t>(crsmat, opts);
 
       Kokkos::finalize();
     }
@@ -477,7 +528,7 @@ int main (int argc, char ** argv){
       delete [] adj;
       delete [] ew;
 
-      run_experiment<myExecSpace, crsMat_t>(crsmat);
+      run_experiment<myExecSpace, crsMat_t>(crsmat, opts);
 
       Kokkos::finalize();
     }
@@ -44,6 +44,7 @@
 #ifndef KOKKOS_EXAMPLE_CG_SOLVE
 #define KOKKOS_EXAMPLE_CG_SOLVE
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <Kokkos_Core.hpp>
@@ -55,8 +56,11 @@
 #include <iostream>
 #include "KokkosKernels_Handle.hpp"
 #include <KokkosSparse_spmv.hpp>
+#include <KokkosSparse_spmv_dot.hpp>
 #include <KokkosBlas.hpp>
+#include <KokkosBlas1_fused.hpp>
 #include <KokkosSparse_gauss_seidel.hpp>
+#include "KokkosKernels_GraphCapture.hpp"
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 
@@ -188,7 +192,8 @@ void block_pcgsolve(
 
 
     timer.reset();
-    /* Ap = A * p   */  KokkosSparse::spmv("N", 1, point_crsMat, pAll, 0, Ap);
+    /* Ap = A * p, pAp_dot = dot(Ap , p ) */
+    const double pAp_dot = KokkosSparse::Experimental::spmv_axpby_dot("N", 1, point_crsMat, pAll, 0, Ap, p);
 
 
     Space::fence();
@@ -197,7 +202,6 @@ void block_pcgsolve(
     //const double pAp_dot = Kokkos::Example::all_reduce( dot( count_owned , p , Ap ) , import.comm );
     //const double pAp_dot = dot<y_vector_t,y_vector_t, Space>( count_total , p , Ap ) ;
 
-    /* pAp_dot = dot(Ap , p ) */ const double pAp_dot = KokkosBlas::dot( p , Ap ) ;
 
 
     double alpha  = 0;
@@ -208,11 +212,10 @@ void block_pcgsolve(
       alpha = old_rdot / pAp_dot ;
     }
 
-    /* x +=  alpha * p ;  */  KokkosBlas::axpby(alpha, p, 1.0, x_vector);
-
-    /* r += -alpha * Ap ; */  KokkosBlas::axpby(-alpha, Ap, 1.0, r);
-
-    const double r_dot = KokkosBlas::dot( r , r );
+    /* x +=  alpha * p ;  */
+    /* r += -alpha * Ap ; */
+    /* r_dot = dot(r, r) ; */
+    const double r_dot = KokkosBlas::Experimental::axpby2_dot(alpha, p, 1.0, x_vector, -alpha, Ap, 1.0, r, r);
 
     const double beta_original  = r_dot / old_rdot ;
     double precond_r_dot = 1;
@@ -385,7 +388,8 @@ void pcgsolve(
 
 
     timer.reset();
-    /* Ap = A * p   */  KokkosSparse::spmv("N", 1, crsMat, pAll, 0, Ap);
+    /* Ap = A * p, pAp_dot = dot(Ap , p ) */
+    const double pAp_dot = KokkosSparse::Experimental::spmv_axpby_dot("N", 1, crsMat, pAll, 0, Ap, p);
 
 
     Space::fence();
@@ -394,7 +398,6 @@ void pcgsolve(
     //const double pAp_dot = Kokkos::Example::all_reduce( dot( count_owned , p , Ap ) , import.comm );
     //const double pAp_dot = dot<y_vector_t,y_vector_t, Space>( count_total , p , Ap ) ;
 
-    /* pAp_dot = dot(Ap , p ) */ const double pAp_dot = KokkosBlas::dot( p , Ap ) ;
 
 
     double alpha  = 0;
@@ -405,11 +408,10 @@ void pcgsolve(
       alpha = old_rdot / pAp_dot ;
     }
 
-    /* x +=  alpha * p ;  */  KokkosBlas::axpby(alpha, p, 1.0, x_vector);
-
-    /* r += -alpha * Ap ; */  KokkosBlas::axpby(-alpha, Ap, 1.0, r);
-
-    const double r_dot = KokkosBlas::dot( r , r );
+    /* x +=  alpha * p ;  */
+    /* r += -alpha * Ap ; */
+    /* r_dot = dot(r, r) ; */
+    const double r_dot = KokkosBlas::Experimental::axpby2_dot(alpha, p, 1.0, x_vector, -alpha, Ap, 1.0, r, r);
 
     const double beta_original  = r_dot / old_rdot ;
     double precond_r_dot = 1;
@@ -476,6 +478,188 @@ void pcgsolve(
   }
 }
 
+/* The scalars of the captured iteration stay on the device:
+ * scalars = { dot(r, z), dot(p, Ap), dot(r, z) of the next iteration, dot(r, r) }
+ */
+template <typename vector_t, typename scalar_view_t>
+struct CapturedCGUpdateXR {
+  typedef typename vector_t::non_const_value_type scalar_t;
+  vector_t x, r;
+  typename vector_t::const_type p, Ap;
+  scalar_view_t scalars;
+
+  CapturedCGUpdateXR(const vector_t &x_, const vector_t &r_, const vector_t &p_, const vector_t &Ap_,
+      const scalar_view_t &scalars_) : x(x_), r(r_), p(p_), Ap(Ap_), scalars(scalars_) {}
+
+  /* x += alpha * p ; r -= alpha * Ap ; alpha = dot(r, z) / dot(p, Ap) */
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i) const {
+    const scalar_t alpha = scalars(0) / scalars(1);
+    x(i) += alpha * p(i);
+    r(i) -= alpha * Ap(i);
+  }
+};
+
+template <typename vector_t, typename scalar_view_t>
+struct CapturedCGUpdateP {
+  typedef typename vector_t::non_const_value_type scalar_t;
+  vector_t p;
+  typename vector_t::const_type z;
+  scalar_view_t scalars;
+
+  CapturedCGUpdateP(const vector_t &p_, const vector_t &z_, const scalar_view_t &scalars_)
+    : p(p_), z(z_), scalars(scalars_) {}
+
+  /* p = z + beta * p ; beta = dot(r, z)_new / dot(r, z) */
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i) const {
+    p(i) = z(i) + (scalars(2) / scalars(0)) * p(i);
+  }
+};
+
+template <typename scalar_view_t>
+struct CapturedCGShiftScalars {
+  scalar_view_t scalars;
+
+  CapturedCGShiftScalars(const scalar_view_t &scalars_) : scalars(scalars_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int) const { scalars(0) = scalars(2); }
+};
+
+/* The symmetric Gauss-Seidel preconditioned CG of pcgsolve with the
+ * iteration recorded once by GraphCapture and replayed. All scalars of an
+ * iteration stay on the device, so the kernels of check_interval
+ * iterations are launched back to back and the residual is only read on
+ * the host between them; the solve can therefore take up to
+ * check_interval - 1 iterations more than pcgsolve. On Cuda the iteration
+ * is a single graph launch, see KokkosKernels_GraphCapture.hpp.
+ */
+template< typename KernelHandle_t,
+          typename crsMatrix_t,
+          typename y_vector_t,
+          typename x_vector_t
+          >
+void pcgsolve_captured(
+               KernelHandle_t &kh
+            ,  const crsMatrix_t &crsMat
+            ,  const y_vector_t &y_vector
+            ,  x_vector_t x_vector
+            ,  const size_t  maximum_iteration = 200
+            ,  const double  tolerance = std::numeric_limits<double>::epsilon()
+            ,  CGSolveResult * result = 0
+            ,  bool use_sgs = true
+            ,  const size_t  check_interval = 10) {
+
+  using namespace KokkosSparse;
+  using namespace KokkosSparse::Experimental;
+  typedef typename KernelHandle_t::HandleExecSpace Space;
+  typedef typename y_vector_t::non_const_value_type scalar_t;
+  typedef Kokkos::View<scalar_t*, typename y_vector_t::device_type> scalar_view_t;
+
+  const size_t count_total = crsMat.numRows();
+
+  size_t  iteration = 0 ;
+  double  norm_res = 0 ;
+  double precond_init_time = 0;
+
+  Kokkos::Impl::Timer timer;
+
+  y_vector_t p ( "cg::p" , count_total );
+  y_vector_t r ( "cg::r" , count_total );
+  y_vector_t Ap( "cg::Ap", count_total );
+  y_vector_t z = r;
+  scalar_view_t scalars( "cg::scalars" , 4 );
+  auto rz = Kokkos::subview(scalars, 0);
+  auto pAp = Kokkos::subview(scalars, 1);
+  auto rz_next = Kokkos::subview(scalars, 2);
+  auto rr = Kokkos::subview(scalars, 3);
+  auto h_scalars = Kokkos::create_mirror_view(scalars);
+
+  /* r = b - A * x ; */
+  KokkosSparse::spmv("N", 1, crsMat, x_vector, 0, Ap);
+  KokkosBlas::update(1.0, y_vector, -1.0, Ap, 0.0, r);
+
+  bool owner_handle = false;
+  if (use_sgs){
+    if (kh.get_gs_handle() == NULL){
+      owner_handle = true;
+      kh.create_gs_handle();
+    }
+    timer.reset();
+    gauss_seidel_numeric
+      (&kh, count_total, count_total, crsMat.graph.row_map, crsMat.graph.entries, crsMat.values);
+    Space::fence();
+    precond_init_time += timer.seconds();
+
+    z = y_vector_t( "pcg::z" , count_total );
+    symmetric_gauss_seidel_apply
+        (&kh, count_total, count_total, crsMat.graph.row_map, crsMat.graph.entries, crsMat.values, z, r, true, true, 1);
+  }
+  /* p = z ; */
+  Kokkos::deep_copy( p , z );
+  KokkosBlas::dot( rz , r , z );
+  KokkosBlas::dot( rr , r , r );
+  Kokkos::deep_copy( h_scalars , scalars );
+  norm_res = std::sqrt( h_scalars(3) );
+
+  auto cg_iteration = [&](){
+    /* Ap = A * p ; */
+    KokkosSparse::spmv("N", 1, crsMat, p, 0, Ap);
+    KokkosBlas::dot( pAp , p , Ap );
+    Kokkos::parallel_for( "KokkosKernels::Example::CapturedCG::UpdateXR",
+        Kokkos::RangePolicy<Space>(0, count_total),
+        CapturedCGUpdateXR<y_vector_t, scalar_view_t>(x_vector, r, p, Ap, scalars) );
+    if (use_sgs){
+      symmetric_gauss_seidel_apply
+          (&kh, count_total, count_total, crsMat.graph.row_map, crsMat.graph.entries, crsMat.values, z, r, true, true, 1);
+    }
+    KokkosBlas::dot( rz_next , r , z );
+    KokkosBlas::dot( rr , r , r );
+    Kokkos::parallel_for( "KokkosKernels::Example::CapturedCG::UpdateP",
+        Kokkos::RangePolicy<Space>(0, count_total),
+        CapturedCGUpdateP<y_vector_t, scalar_view_t>(p, z, scalars) );
+    Kokkos::parallel_for( "KokkosKernels::Example::CapturedCG::ShiftScalars",
+        Kokkos::RangePolicy<Space>(0, 1),
+        CapturedCGShiftScalars<scalar_view_t>(scalars) );
+  };
+
+  KokkosKernels::Experimental::GraphCapture<Space> graph;
+  timer.reset();
+  if ( tolerance < norm_res && iteration < maximum_iteration ) {
+    /* the first iteration runs eagerly, so that the kernels have their buffers before the capture */
+    cg_iteration();
+    ++iteration;
+    graph.capture(cg_iteration);
+
+    Kokkos::deep_copy( h_scalars , scalars );
+    norm_res = std::sqrt( h_scalars(3) );
+  }
+  while ( tolerance < norm_res && iteration < maximum_iteration ) {
+    const size_t n = std::min(check_interval, maximum_iteration - iteration);
+    graph.replay(n);
+    iteration += n;
+
+    Kokkos::deep_copy( h_scalars , scalars );
+    norm_res = std::sqrt( h_scalars(3) );
+  }
+  Space::fence();
+  const double iter_time = timer.seconds();
+
+  if ( 0 != result ) {
+    result->iteration   = iteration ;
+    result->iter_time   = iter_time ;
+    result->matvec_time = 0 ;
+    result->norm_res    = norm_res ;
+    result->precond_time = 0;
+    result->precond_init_time = precond_init_time;
+  }
+
+  if (use_sgs & owner_handle ){
+    kh.destroy_gs_handle();
+  }
+}
+
 } // namespace Example
 } // namespace Kokkos
 }
@@ -43,6 +43,7 @@
 
 
 #include "KokkosSparse_spgemm.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
 #include "KokkosKernels_TestParameters.hpp"
 
 
@@ -207,6 +208,9 @@ crsMat_t3 run_experiment(
   if (use_dynamic_scheduling){
     kh.set_dynamic_scheduling(true);
   }
+  if (params.use_prefetch){
+    kh.set_prefetch_before_numeric(true);
+  }
   if (verbose){
     kh.set_verbose(true);
   }
@@ -290,8 +294,31 @@ crsMat_t3 run_experiment(
     Ccrsmat_ref = Ccrsmat;
   }
 
-  for (int i = 0; i < repeat; ++i){
-	  kh.create_spgemm_handle(KokkosSparse::SPGEMMAlgorithm(algorithm));
+  BenchmarkResult symbolic_result("spgemm_symbolic"), numeric_result("spgemm_numeric"), total_result("spgemm");
+  symbolic_result.add_param("algorithm", algorithm).add_param("m", m).add_param("n", n).add_param("k", k);
+  numeric_result.params = total_result.params = symbolic_result.params;
+  //flops of the numeric phase (a multiply and an add per scalar multiplication)
+  numeric_result.flops = total_result.flops = 2.0 * KokkosKernels::Impl::kk_get_spgemm_multiplication_count
+      <typename crsMat_t::StaticCrsGraphType::row_map_type, typename crsMat_t::StaticCrsGraphType::entries_type,
+       typename crsMat_t2::StaticCrsGraphType::row_map_type, ExecSpace>
+      (m, crsMat.graph.row_map, crsMat.graph.entries, crsMat2.graph.row_map);
+
+  BenchmarkResult compare_symbolic_result("spgemm_symbolic"), compare_numeric_result("spgemm_numeric"), compare_total_result("spgemm");
+  const bool compare = params.compare_algorithm >= 0;
+  if (compare){
+    compare_symbolic_result.add_param("algorithm", params.compare_algorithm).add_param("m", m).add_param("n", n).add_param("k", k);
+    compare_numeric_result.params = compare_total_result.params = compare_symbolic_result.params;
+    compare_numeric_result.flops = compare_total_result.flops = numeric_result.flops;
+  }
+
+  //the compared algorithm runs first, so that C below is the result of algorithm.
+  for (int run = compare ? 0 : 1; run < 2; ++run){
+  const int run_algorithm = run ? algorithm : params.compare_algorithm;
+  BenchmarkResult &run_symbolic_result = run ? symbolic_result : compare_symbolic_result;
+  BenchmarkResult &run_numeric_result = run ? numeric_result : compare_numeric_result;
+  BenchmarkResult &run_total_result = run ? total_result : compare_total_result;
+  for (int i = -params.warmup; i < repeat; ++i){
+	  kh.create_spgemm_handle(KokkosSparse::SPGEMMAlgorithm(run_algorithm));
 
 	  kh.get_spgemm_handle()->mkl_keep_output = mkl_keep_output;
           kh.get_spgemm_handle()->set_mkl_sort_option(params.mkl_sort_option);
@@ -302,7 +329,7 @@ crsMat_t3 run_experiment(
 	  //250000 default. if cache-mode is used on KNL can increase to 1M.
 	  kh.get_spgemm_handle()->MaxColDenseAcc = params.MaxColDenseAcc;
 
-	  if (i == 0){
+	  if (i == -params.warmup){
 		  kh.get_spgemm_handle()->set_read_write_cost_calc (calculate_read_write_cost);
 	  }
 	  //do the compression whether in 2 step, or 1 step.
@@ -369,10 +396,33 @@ crsMat_t3 run_experiment(
 	  ExecSpace::fence();
 	  double numeric_time = timer3.seconds();
 
-	  std::cout
-	  << "mm_time:" << symbolic_time + numeric_time
-	  << " symbolic_time:" << symbolic_time
-	  << " numeric_time:" << numeric_time << std::endl;
+	  if (i >= 0){
+		  run_symbolic_result.record(symbolic_time);
+		  run_numeric_result.record(numeric_time);
+		  run_total_result.record(symbolic_time + numeric_time);
+	  }
+  }
+  }
+  if (compare && repeat > 0){
+    total_result.add_param("speedup", compare_total_result.stats().median / total_result.stats().median);
+  }
+  {
+    BenchmarkReport report(params);
+    report.add(symbolic_result);
+    report.add(numeric_result);
+    report.add(total_result);
+    if (compare){
+      report.add(compare_symbolic_result);
+      report.add(compare_numeric_result);
+      report.add(compare_total_result);
+    }
+    report.write();
+  }
+  if (params.tuning_file != NULL && repeat > 0){
+    //keep the entries of earlier runs, the file may not exist yet.
+    KokkosKernels::Impl::tuning_database().load(params.tuning_file);
+    kh.record_tuning("spgemm", m, crsMat.graph.entries.extent(0), algorithm, total_result.stats().median);
+    KokkosKernels::Experimental::save_tuning_database(params.tuning_file);
   }
   if (verbose) {
 	  std::cout << "row_mapC:" << row_mapC.extent(0) << std::endl;
@@ -54,36 +54,78 @@
 #define SCALAR_TYPE double
 //double
 
+#if defined(KOKKOSKERNELS_INST_COMPLEX_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+#define KOKKOSKERNELS_SPGEMM_BENCHMARK_COMPLEX
+#endif
+
+//runs the benchmark with SCALAR_TYPE, or with complex values if requested.
+template <typename exec_space, typename hbm_mem_space, typename sbm_mem_space>
+void run_spgemm_benchmark(KokkosKernels::Experiment::Parameters params){
+#if defined(KOKKOSKERNELS_SPGEMM_BENCHMARK_COMPLEX)
+  if (params.use_complex) {
+    KokkosKernels::Experiment::run_multi_mem_spgemm
+    <SIZE_TYPE, INDEX_TYPE, Kokkos::complex<SCALAR_TYPE>, exec_space, hbm_mem_space, sbm_mem_space>(
+        params
+        );
+    return;
+  }
+#else
+  if (params.use_complex) {
+    std::cerr << "Complex values are not instantiated, running with real values" << std::endl;
+  }
+#endif
+  KokkosKernels::Experiment::run_multi_mem_spgemm
+  <SIZE_TYPE, INDEX_TYPE, SCALAR_TYPE, exec_space, hbm_mem_space, sbm_mem_space>(
+      params
+      );
+}
+
 void print_options(){
   std::cerr << "Options\n" << std::endl;
 
-  std::cerr << "\t[Required] BACKEND: '--threads[numThreads]' | '--openmp [numThreads]' | '--cuda [cudaDeviceIndex]'" << std::endl;
+  std::cerr << "\t[Required] BACKEND: '--openmp [numThreads]' | '--cuda [cudaDeviceIndex]'" << std::endl;
+  KokkosKernels::Experiment::print_benchmark_options(std::cerr);
 
   std::cerr << "\t[Required] INPUT MATRIX: '--amtx [left_hand_side.mtx]' -- for C=AxA" << std::endl;
 
-  std::cerr << "\t[Optional] '--algorithm [DEFAULT=KKDEFAULT=KKSPGEMM|KKMEM|KKDENSE|MKL|CUSPARSE|CUSP|VIENNA|MKL2]' --> to choose algorithm. KKMEM is outdated, use KKSPGEMM instead." << std::endl;
+  std::cerr << "\t[Optional] '--algorithm [DEFAULT=KKDEFAULT=KKSPGEMM|KKAUTO|KKMEM|KKDENSE|MKL|CUSPARSE|CUSP|VIENNA|MKL2|SERIAL]' --> to choose algorithm. KKMEM is outdated, use KKSPGEMM instead. KKAUTO is the default of the handle on host execution spaces." << std::endl;
+  std::cerr << "\t[Optional] '--compare [ALGORITHM]' --> also time the given algorithm, e.g. MKL, and report the speedup of --algorithm over it." << std::endl;
   std::cerr << "\t[Optional] --bmtx [righ_hand_side.mtx]' for C= AxB" << std::endl;
   std::cerr << "\t[Optional] OUTPUT MATRICES: '--cmtx [output_matrix.mtx]' --> to write output C=AxB"  << std::endl;
   std::cerr << "\t[Optional] --DENSEACCMAX: on CPUs default algorithm may choose to use dense accumulators. This parameter defaults to 250k, which is max k value to choose dense accumulators. This can be increased with more memory bandwidth." << std::endl;
   std::cerr << "\tThe memory space used for each matrix: '--memspaces [0|1|....15]' --> Bits representing the use of HBM for Work, C, B, and A respectively. For example 12 = 1100, will store work arrays and C on HBM. A and B will be stored DDR. To use this enable multilevel memory in Kokkos, check generate_makefile.sh" << std::endl;
+  std::cerr << "\tFast memory size: '--fastmemsize [MB]' --> Instead of --memspaces, place the arrays that are accessed the most per byte on HBM, as long as they fit this size (work arrays, then B)." << std::endl;
   std::cerr << "\tLoop scheduling: '--dynamic': Use this for dynamic scheduling of the loops. (Better performance most of the time)" << std::endl;
+  std::cerr << "\tPrefetching: '--prefetch': prefetch the matrices and the handle to the device before the numeric phase, for CudaUVMSpace" << std::endl;
+  std::cerr << "\tTuning database: '--tuning-file [database.json]': record the best time of the run with its algorithm, team size, vector size, shared memory size and scheduling in the JSON database, read by KOKKOSKERNELS_TUNING_FILE" << std::endl;
   std::cerr << "\tVerbose Output: '--verbose'" << std::endl;
+  std::cerr << "\tComplex values: '--complex': multiply with Kokkos::complex<double> values, e.g. to compare with the real run" << std::endl;
 }
 
 
+//the SPGEMMAlgorithm of an --algorithm or --compare name, -1 if unknown.
+int parse_algorithm(const char *name){
+  if ( 0 == strcasecmp( name , "DEFAULT" ) ) return KokkosSparse::SPGEMM_KK;
+  if ( 0 == strcasecmp( name , "KKDEFAULT" ) ) return KokkosSparse::SPGEMM_KK;
+  if ( 0 == strcasecmp( name , "KKSPGEMM" ) ) return KokkosSparse::SPGEMM_KK;
+  if ( 0 == strcasecmp( name , "KKAUTO" ) ) return KokkosSparse::SPGEMM_KK_AUTO;
+  if ( 0 == strcasecmp( name , "KKMEM" ) ) return KokkosSparse::SPGEMM_KK_MEMORY;
+  if ( 0 == strcasecmp( name , "KKDENSE" ) ) return KokkosSparse::SPGEMM_KK_DENSE;
+  if ( 0 == strcasecmp( name , "KKLP" ) ) return KokkosSparse::SPGEMM_KK_LP;
+  if ( 0 == strcasecmp( name , "MKL" ) ) return KokkosSparse::SPGEMM_MKL;
+  if ( 0 == strcasecmp( name , "CUSPARSE" ) ) return KokkosSparse::SPGEMM_CUSPARSE;
+  if ( 0 == strcasecmp( name , "CUSP" ) ) return KokkosSparse::SPGEMM_CUSP;
+  if ( 0 == strcasecmp( name , "KKDEBUG" ) ) return KokkosSparse::SPGEMM_KK_LP;
+  if ( 0 == strcasecmp( name , "MKL2" ) ) return KokkosSparse::SPGEMM_MKL2PHASE;
+  if ( 0 == strcasecmp( name , "VIENNA" ) ) return KokkosSparse::SPGEMM_VIENNA;
+  if ( 0 == strcasecmp( name , "SERIAL" ) ) return KokkosSparse::SPGEMM_SERIAL;
+  return -1;
+}
+
 int parse_inputs (KokkosKernels::Experiment::Parameters &params, int argc, char **argv){
   for ( int i = 1 ; i < argc ; ++i ) {
-    if ( 0 == strcasecmp( argv[i] , "--threads" ) ) {
-      params.use_threads = atoi( argv[++i] );
-    }
-    else if ( 0 == strcasecmp( argv[i] , "--openmp" ) ) {
-      params.use_openmp = atoi( argv[++i] );
-    }
-    else if ( 0 == strcasecmp( argv[i] , "--cuda" ) ) {
-      params.use_cuda = atoi( argv[++i] ) + 1;
-    }
-    else if ( 0 == strcasecmp( argv[i] , "--repeat" ) ) {
-      params.repeat = atoi( argv[++i] );
+    if ( KokkosKernels::Experiment::parse_benchmark_option( params, argc, argv, i ) ) {
+      //backend, repeat, warmup and report options.
     }
     else if ( 0 == strcasecmp( argv[i] , "--hashscale" ) ) {
       params.minhashscale = atoi( argv[++i] );
@@ -104,6 +146,9 @@ int parse_inputs (KokkosKernels::Experiment::Parameters &params, int argc, char
     else if ( 0 == strcasecmp( argv[i] , "--shmem" ) ) {
       params.shmemsize =  atoi( argv[++i] ) ;
     }
+    else if ( 0 == strcasecmp( argv[i] , "--fastmemsize" ) ) {
+      params.fast_memory_size = size_t(atof( argv[++i] ) * 1024 * 1024);
+    }
     else if ( 0 == strcasecmp( argv[i] , "--memspaces" ) ) {
       int memspaces = atoi( argv[++i] ) ;
       int memspaceinfo = memspaces;
@@ -213,6 +258,15 @@ int parse_inputs (KokkosKernels::Experiment::Parameters &params, int argc, char
     	//this cut-off can be increased to be more than 250,000
         params.MaxColDenseAcc= atoi( argv[++i] ) ;
     }
+    else if ( 0 == strcasecmp( argv[i] , "--complex" ) ) {
+        params.use_complex = 1;
+    }
+    else if ( 0 == strcasecmp( argv[i] , "--prefetch" ) ) {
+        params.use_prefetch = 1;
+    }
+    else if ( 0 == strcasecmp( argv[i] , "--tuning-file" ) ) {
+        params.tuning_file = argv[++i];
+    }
     else if ( 0 == strcasecmp( argv[i] , "--verbose" ) ) {
     	//print the timing and information about the inner steps.
     	//if you are timing TPL libraries, for correct timing use verbose option,
@@ -221,46 +275,18 @@ int parse_inputs (KokkosKernels::Experiment::Parameters &params, int argc, char
     }
     else if ( 0 == strcasecmp( argv[i] , "--algorithm" ) ) {
       ++i;
-
-      if ( 0 == strcasecmp( argv[i] , "DEFAULT" ) ) {
-    	  params.algorithm = KokkosSparse::SPGEMM_KK;
-      }
-      else if ( 0 == strcasecmp( argv[i] , "KKDEFAULT" ) ) {
-    	  params.algorithm = KokkosSparse::SPGEMM_KK;
-      }
-      else if ( 0 == strcasecmp( argv[i] , "KKSPGEMM" ) ) {
-    	  params.algorithm = KokkosSparse::SPGEMM_KK;
-      }
-
-      else if ( 0 == strcasecmp( argv[i] , "KKMEM" ) ) {
-    	  params.algorithm = KokkosSparse::SPGEMM_KK_MEMORY;
-      }
-      else if ( 0 == strcasecmp( argv[i] , "KKDENSE" ) ) {
-        params.algorithm =  KokkosSparse::SPGEMM_KK_DENSE;
-      }
-      else if ( 0 == strcasecmp( argv[i] , "KKLP" ) ) {
-    	  params.algorithm = KokkosSparse::SPGEMM_KK_LP;
-      }
-      else if ( 0 == strcasecmp( argv[i] , "MKL" ) ) {
-    	  params.algorithm = KokkosSparse::SPGEMM_MKL;
-      }
-      else if ( 0 == strcasecmp( argv[i] , "CUSPARSE" ) ) {
-    	  params.algorithm = KokkosSparse::SPGEMM_CUSPARSE;
-      }
-      else if ( 0 == strcasecmp( argv[i] , "CUSP" ) ) {
-    	  params.algorithm = KokkosSparse::SPGEMM_CUSP;
-      }
-      else if ( 0 == strcasecmp( argv[i] , "KKDEBUG" ) ) {
-    	  params.algorithm = KokkosSparse::SPGEMM_KK_LP;
-      }
-      else if ( 0 == strcasecmp( argv[i] , "MKL2" ) ) {
-    	  params.algorithm = KokkosSparse::SPGEMM_MKL2PHASE;
-      }
-      else if ( 0 == strcasecmp( argv[i] , "VIENNA" ) ) {
-    	  params.algorithm = KokkosSparse::SPGEMM_VIENNA;
+      params.algorithm = parse_algorithm(argv[i]);
+      if (params.algorithm < 0) {
+        std::cerr << "Unrecognized command line argument #" << i << ": " << argv[i] << std::endl ;
+        print_options();
+        return 1;
       }
-
-      else {
+    }
+    else if ( 0 == strcasecmp( argv[i] , "--compare" ) ) {
+      //runs the multiplication with a second algorithm as well, and reports the speedup.
+      ++i;
+      params.compare_algorithm = parse_algorithm(argv[i]);
+      if (params.compare_algorithm < 0) {
         std::cerr << "Unrecognized command line argument #" << i << ": " << argv[i] << std::endl ;
         print_options();
         return 1;
@@ -291,10 +317,7 @@ int main (int argc, char ** argv){
     std::cout << "B is not provided. Multiplying AxA." << std::endl;
   }
 
-  const int num_threads = params.use_openmp; // Assumption is that use_openmp variable is provided as number of threads
-  const int device_id = params.use_cuda - 1;
-
-  Kokkos::initialize( Kokkos::InitArguments( num_threads, -1, device_id ) );
+  Kokkos::initialize( KokkosKernels::Experiment::get_benchmark_init_arguments( params ) );
   Kokkos::print_configuration(std::cout);
 
 
@@ -302,15 +325,9 @@ int main (int argc, char ** argv){
 
   if (params.use_openmp) {
 #ifdef KOKKOSKERNELS_INST_MEMSPACE_HBWSPACE
-    KokkosKernels::Experiment::run_multi_mem_spgemm
-    <SIZE_TYPE, INDEX_TYPE, SCALAR_TYPE, Kokkos::OpenMP, Kokkos::Experimental::HBWSpace, Kokkos::HostSpace>(
-        params
-        );
+    run_spgemm_benchmark<Kokkos::OpenMP, Kokkos::Experimental::HBWSpace, Kokkos::HostSpace>(params);
 #else 
-    KokkosKernels::Experiment::run_multi_mem_spgemm
-    <SIZE_TYPE, INDEX_TYPE, SCALAR_TYPE, Kokkos::OpenMP, Kokkos::OpenMP::memory_space, Kokkos::OpenMP::memory_space>(
-        params
-        );
+    run_spgemm_benchmark<Kokkos::OpenMP, Kokkos::OpenMP::memory_space, Kokkos::OpenMP::memory_space>(params);
 #endif
   }
 #endif
@@ -318,15 +335,9 @@ int main (int argc, char ** argv){
 #if defined( KOKKOS_ENABLE_CUDA )
   if (params.use_cuda) {
 #ifdef KOKKOSKERNELS_INST_MEMSPACE_CUDAHOSTPINNEDSPACE
-    KokkosKernels::Experiment::run_multi_mem_spgemm
-    <SIZE_TYPE, INDEX_TYPE, SCALAR_TYPE, Kokkos::Cuda, Kokkos::Cuda::memory_space, Kokkos::CudaHostPinnedSpace>(
-        params
-        );
+    run_spgemm_benchmark<Kokkos::Cuda, Kokkos::Cuda::memory_space, Kokkos::CudaHostPinnedSpace>(params);
 #else
-    KokkosKernels::Experiment::run_multi_mem_spgemm
-    <SIZE_TYPE, INDEX_TYPE, SCALAR_TYPE, Kokkos::Cuda, Kokkos::Cuda::memory_space, Kokkos::Cuda::memory_space>(
-        params
-        );
+    run_spgemm_benchmark<Kokkos::Cuda, Kokkos::Cuda::memory_space, Kokkos::Cuda::memory_space>(params);
 
 #endif
   }
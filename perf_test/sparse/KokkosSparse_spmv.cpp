@@ -58,20 +58,9 @@
 #include <Kokkos_Core.hpp>
 #include <matrix_market.hpp>
 
-#include <KokkosKernels_SPMV.hpp>
-#include <Kokkos_SPMV.hpp>
-#include <Kokkos_SPMV_Inspector.hpp>
-#include <CuSparse_SPMV.hpp>
-#include <MKL_SPMV.hpp>
-
-#ifdef _OPENMP
-#include <OpenMPStatic_SPMV.hpp>
-#include <OpenMPDynamic_SPMV.hpp>
-#include <OpenMPSmartStatic_SPMV.hpp>
-#endif
-
-enum {KOKKOS, MKL, CUSPARSE, KK_KERNELS, KK_KERNELS_INSP, KK_INSP, OMP_STATIC, OMP_DYNAMIC, OMP_INSP};
-enum {AUTO, DYNAMIC, STATIC};
+#include <SPMV_Plan.hpp>
+#include "KokkosKernels_Benchmark.hpp"
+#include "KokkosBatched_Util.hpp"
 
 #ifdef INT64
 typedef long long int LocalOrdinalType;
@@ -110,71 +99,8 @@ int SparseMatrix_generate(OrdinalType nrows, OrdinalType ncols, OrdinalType &nnz
   return nnz;
 }
 
-template<typename AType, typename XType, typename YType>
-void matvec(AType& A, XType x, YType y, int rows_per_thread, int team_size, int vector_length, int test, int schedule) {
-
-        switch(test) {
-
-        case KOKKOS:
-                if(schedule == AUTO)
-                  schedule = A.nnz()>10000000?DYNAMIC:STATIC;
-                if(schedule == STATIC)
-                  kk_matvec<AType,XType,YType,Kokkos::Static>(A, x, y, rows_per_thread, team_size, vector_length);
-                if(schedule == DYNAMIC)
-                  kk_matvec<AType,XType,YType,Kokkos::Dynamic>(A, x, y, rows_per_thread, team_size, vector_length);
-                break;
-        case KK_INSP:
-                if(schedule == AUTO)
-                  schedule = A.nnz()>10000000?DYNAMIC:STATIC;
-                if(schedule == STATIC)
-                  kk_inspector_matvec<AType,XType,YType,Kokkos::Static>(A, x, y, rows_per_thread, team_size, vector_length);
-                if(schedule == DYNAMIC)
-                  kk_inspector_matvec<AType,XType,YType,Kokkos::Dynamic>(A, x, y, rows_per_thread, team_size, vector_length);
-                break;
-
-#ifdef _OPENMP
-        case OMP_STATIC:
-                openmp_static_matvec<AType, XType, YType, int, double>(A, x, y, rows_per_thread, team_size, vector_length);
-                break;
-        case OMP_DYNAMIC:
-                openmp_dynamic_matvec<AType, XType, YType, int, double>(A, x, y, rows_per_thread, team_size, vector_length);
-                break;
-        case OMP_INSP:
-                openmp_smart_static_matvec<AType, XType, YType, int, double>(A, x, y, rows_per_thread, team_size, vector_length);
-                break;
-#endif
-
-#ifdef HAVE_MKL
-        case MKL:
-                mkl_matvec(A, x, y, rows_per_thread, team_size, vector_length);
-                break;
-#endif
-#ifdef HAVE_CUSPARSE
-        case CUSPARSE:
-                cusparse_matvec(A, x, y, rows_per_thread, team_size, vector_length);
-                break;
-#endif
-#ifdef HAVE_KK_KERNELS
-        case KK_KERNELS:
-                kokkoskernels_matvec(A, x, y, rows_per_thread, team_size, vector_length);
-                break;
-  case KK_KERNELS_INSP:
-    if(A.graph.row_block_offsets.data()==NULL) {
-      printf("PTR: %p\n",A.graph.row_block_offsets.data());
-      A.graph.create_block_partitioning(AType::execution_space::concurrency());
-      printf("PTR2: %p\n",A.graph.row_block_offsets.data());
-    }
-    kokkoskernels_matvec(A, x, y, rows_per_thread, team_size, vector_length);
-    break;
-#endif
-        default:
-                fprintf(stderr, "Selected test is not available.\n");
-
-        }
-}
-
 template<typename Scalar>
-int test_crs_matrix_singlevec(int numRows, int numCols, int nnz, int test, const char* filename, const bool binaryfile, int rows_per_thread, int team_size, int vector_length,int idx_offset, int schedule, int loop) {
+int test_crs_matrix_singlevec(int numRows, int numCols, int nnz, const std::vector<int>& tests, const char* filename, const bool binaryfile, int rows_per_thread, int team_size, int vector_length,int idx_offset, int schedule, const bool flush_cache, const KokkosKernels::Experiment::BenchmarkOptions &opts) {
   typedef KokkosSparse::CrsMatrix<Scalar,int,Kokkos::DefaultExecutionSpace,void,int> matrix_type ;
   typedef typename Kokkos::View<Scalar*,Kokkos::LayoutLeft> mv_type;
   typedef typename Kokkos::View<Scalar*,Kokkos::LayoutLeft,Kokkos::MemoryRandomAccess > mv_random_read_type;
@@ -236,52 +162,60 @@ int test_crs_matrix_singlevec(int numRows, int numCols, int nnz, int test, const
   Kokkos::deep_copy(x1,h_x);
   typename KokkosSparse::CrsMatrix<Scalar,int,Kokkos::DefaultExecutionSpace,void,int>::values_type y1("Y1",numRows);
 
-  //int nnz_per_row = A.nnz()/A.numRows();
-  matvec(A,x1,y1,rows_per_thread,team_size,vector_length,test,schedule);
-
-  // Error Check
-  Kokkos::deep_copy(h_y,y1);
-  Scalar error = 0;
-  Scalar sum = 0;
-  for(int i=0;i<numRows;i++) {
-    error += (h_y_compare(i)-h_y(i))*(h_y_compare(i)-h_y(i));
-    sum += h_y_compare(i)*h_y_compare(i);
-  }
-
-  int num_errors = 0;
-  double total_error = 0;
-  double total_sum = 0;
-  num_errors += (error/(sum==0?1:sum))>1e-5?1:0;
-  total_error += error;
-  total_sum += sum;
-
   // Benchmark
-  double min_time = 1.0e32;
-  double max_time = 0.0;
-  double ave_time = 0.0;
-  for(int i=0;i<loop;i++) {
-    Kokkos::Timer timer;
-    matvec(A,x1,y1,rows_per_thread,team_size,vector_length,test,schedule);
-    Kokkos::fence();
-    double time = timer.seconds();
-    ave_time += time;
-    if(time>max_time) max_time = time;
-    if(time<min_time) min_time = time;
+  double matrix_size = 1.0*((nnz*(sizeof(Scalar)+sizeof(int)) + numRows*sizeof(int)));
+  double vector_readwrite = 1.0*(nnz+numCols)*sizeof(Scalar);
+
+  // Every kernel runs with the same warmup, repetitions and, unless disabled,
+  // a flush of the last level cache before each timed run.
+  constexpr size_t LLC_CAPACITY = 256*1024*1024;
+  KokkosBatched::Experimental::Flush<LLC_CAPACITY,Kokkos::DefaultExecutionSpace> flush;
+
+  const std::string matrix = filename == NULL ? std::string("generated") : std::string(filename);
+  KokkosKernels::Experiment::BenchmarkReport report(opts);
+  int total_errors = 0, best = -1;
+  for(size_t t=0;t<tests.size();t++) {
+    const SpmvPlan plan(tests[t],schedule,rows_per_thread,team_size,vector_length);
+
+    Kokkos::deep_copy(y1,0);
+    plan.apply(A,x1,y1);
+
+    // Error Check
+    Kokkos::deep_copy(h_y,y1);
+    Scalar error = 0;
+    Scalar sum = 0;
+    for(int i=0;i<numRows;i++) {
+      error += (h_y_compare(i)-h_y(i))*(h_y_compare(i)-h_y(i));
+      sum += h_y_compare(i)*h_y_compare(i);
+    }
+    const int num_errors = (error/(sum==0?1:sum))>1e-5?1:0;
+    total_errors += num_errors;
+
+    KokkosKernels::Experiment::BenchmarkResult result("spmv");
+    result.add_param("matrix", matrix).add_param("kernel", plan.name())
+          .add_param("nnz", nnz).add_param("num_rows", numRows).add_param("num_cols", numCols)
+          .add_param("num_errors", num_errors);
+    result.flops = 2.0*nnz;
+    result.bytes = matrix_size+vector_readwrite;
+    KokkosKernels::Experiment::run_benchmark<Kokkos::DefaultExecutionSpace>
+      (opts, result,
+       [&]() { if(flush_cache) flush.run(); },
+       [&]() { plan.apply(A,x1,y1); });
+    report.add(result);
+
+    if(num_errors == 0 &&
+       (best < 0 || result.stats().median < report.results()[best].stats().median))
+      best = report.results().size()-1;
   }
 
-  // Performance Output
-  double matrix_size = 1.0*((nnz*(sizeof(Scalar)+sizeof(int)) + numRows*sizeof(int)))/1024/1024;
-  double vector_size = 2.0*numRows*sizeof(Scalar)/1024/1024;
-  double vector_readwrite = (nnz+numCols)*sizeof(Scalar)/1024/1024;
-
-  double problem_size = matrix_size+vector_size;
-  printf("NNZ NumRows NumCols ProblemSize(MB) AveBandwidth(GB/s) MinBandwidth(GB/s) MaxBandwidth(GB/s) AveGFlop MinGFlop MaxGFlop aveTime(ms) maxTime(ms) minTime(ms) numErrors\n");
-  printf("%i %i %i %6.2lf ( %6.2lf %6.2lf %6.2lf ) ( %6.3lf %6.3lf %6.3lf ) ( %6.3lf %6.3lf %6.3lf ) %i RESULT\n",nnz, numRows,numCols,problem_size,
-          (matrix_size+vector_readwrite)/ave_time*loop/1024, (matrix_size+vector_readwrite)/max_time/1024,(matrix_size+vector_readwrite)/min_time/1024,
-          2.0*nnz*loop/ave_time/1e9, 2.0*nnz/max_time/1e9, 2.0*nnz/min_time/1e9,
-          ave_time/loop*1000, max_time*1000, min_time*1000,
-          num_errors);
-  return (int)total_error;
+  // The fastest correct kernel for this matrix, as input to spmv plan selection.
+  if(best >= 0) {
+    KokkosKernels::Experiment::BenchmarkResult result = report.results()[best];
+    result.name = "spmv_best";
+    report.add(result);
+  }
+  report.write();
+  return total_errors;
 }
 
 void print_help() {
@@ -290,10 +224,12 @@ void print_help() {
   printf("Options:\n");
   printf("  -s [N]          : generate a semi-random banded (band size 0.01xN) NxN matrix\n");
   printf("                    with average of 10 entries per row.\n");
-  printf("  --test [OPTION] : Use different kernel implementations\n");
-  printf("                    Options:\n");
+  printf("  --test [LIST]   : Comma separated list of kernel implementations, or all.\n");
+  printf("                    Every kernel is timed the same way and the fastest\n");
+  printf("                    one is reported as spmv_best. Options:\n");
   printf("                      kk,kk-kernels          (Kokkos/Trilinos)\n");
   printf("                      kk-insp                (Kokkos Structure Inspection)\n");
+  printf("                      kk-kernels-insp        (Kokkos Kernels Structure Inspection)\n");
 #ifdef _OPENMP
   printf("                      omp-dynamic,omp-static (Standard OpenMP)\n");
   printf("                      omp-insp               (OpenMP Structure Inspection)\n");
@@ -308,14 +244,16 @@ void print_help() {
   printf("  -rpt [K]        : Number of Rows assigned to a thread.\n");
   printf("  -ts [T]         : Number of threads per team.\n");
   printf("  -vl [V]         : Vector-length (i.e. how many Cuda threads are a Kokkos 'thread').\n");
-  printf("  -l [LOOP]       : How many spmv to run to aggregate average time. \n");
+  printf("  -l [LOOP]       : How many spmv to run to aggregate average time (same as --repeat). \n");
+  printf("  --no-flush      : Do not flush the cache before every timed spmv.\n");
+  KokkosKernels::Experiment::print_benchmark_options(std::cout);
 }
 
 int main(int argc, char **argv)
 {
  long long int size = 110503; // a prime number
  //int numVecs = 4;
- int test=KOKKOS;
+ std::vector<int> tests(1,KOKKOS);
  //int type=-1;
  char* filename = NULL;
  bool binaryfile = false;
@@ -326,7 +264,9 @@ int main(int argc, char **argv)
  int team_size = -1;
  int idx_offset = 0;
  int schedule=AUTO;
- int loop = 100;
+ bool flush_cache = true;
+ KokkosKernels::Experiment::BenchmarkOptions opts;
+ opts.repeat = 100;
 
  if(argc == 1) {
    print_help();
@@ -335,30 +275,12 @@ int main(int argc, char **argv)
 
  for(int i=0;i<argc;i++)
  {
+  if(KokkosKernels::Experiment::parse_benchmark_option(opts,argc,argv,i)) continue;
   if((strcmp(argv[i],"-s")==0)) {size=atoi(argv[++i]); continue;}
   //if((strcmp(argv[i],"-v")==0)) {numVecs=atoi(argv[++i]); continue;}
   if((strcmp(argv[i],"--test")==0)) {
-    i++;
-    if((strcmp(argv[i],"mkl")==0))
-      test = MKL;
-    if((strcmp(argv[i],"kk")==0))
-      test = KOKKOS;
-    if((strcmp(argv[i],"cusparse")==0))
-      test = CUSPARSE;
-    if((strcmp(argv[i],"kk-kernels")==0))
-      test = KK_KERNELS;
-    if((strcmp(argv[i],"kk-kernels-insp")==0))
-      test = KK_KERNELS_INSP;
-    if((strcmp(argv[i],"kk-insp")==0))
-      test = KK_INSP;
-#ifdef _OPENMP
-    if((strcmp(argv[i],"omp-static") == 0))
-      test = OMP_STATIC;
-    if((strcmp(argv[i], "omp-dynamic") == 0))
-      test = OMP_DYNAMIC;
-    if((strcmp(argv[i], "omp-insp") == 0))
-      test = OMP_INSP;
-#endif
+    if(!parse_spmv_kernels(argv[++i],tests))
+      return 1;
     continue;
   }
   //if((strcmp(argv[i],"--type")==0)) {type=atoi(argv[++i]); continue;}
@@ -369,7 +291,8 @@ int main(int argc, char **argv)
   if((strcmp(argv[i],"-vl")==0)) {vector_length=atoi(argv[++i]); continue;}
   if((strcmp(argv[i],"--offset")==0)) {idx_offset=atoi(argv[++i]); continue;}
   if((strcmp(argv[i],"--write-binary")==0)) {write_binary=true;}
-  if((strcmp(argv[i],"-l")==0)) {loop=atoi(argv[++i]); continue;}
+  if((strcmp(argv[i],"-l")==0)) {opts.repeat=atoi(argv[++i]); continue;}
+  if((strcmp(argv[i],"--no-flush")==0)) {flush_cache=false; continue;}
   if((strcmp(argv[i],"--schedule")==0)) {
     i++;
     if((strcmp(argv[i],"auto")==0))
@@ -395,9 +318,9 @@ int main(int argc, char **argv)
    return 0;
  }
 
- Kokkos::initialize(argc,argv);
+ Kokkos::initialize(KokkosKernels::Experiment::get_benchmark_init_arguments(opts));
 
- int total_errors = test_crs_matrix_singlevec<double>(size,size,size*10,test,filename,binaryfile,rows_per_thread,team_size,vector_length,idx_offset,schedule,loop);
+ int total_errors = test_crs_matrix_singlevec<double>(size,size,size*10,tests,filename,binaryfile,rows_per_thread,team_size,vector_length,idx_offset,schedule,flush_cache,opts);
 
  if(total_errors == 0)
    printf("Kokkos::MultiVector Test: Passed\n");
@@ -0,0 +1,217 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef SPMV_PLAN_HPP_
+#define SPMV_PLAN_HPP_
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+#include <KokkosKernels_SPMV.hpp>
+#include <Kokkos_SPMV.hpp>
+#include <Kokkos_SPMV_Inspector.hpp>
+#include <CuSparse_SPMV.hpp>
+#include <MKL_SPMV.hpp>
+
+#ifdef _OPENMP
+#include <OpenMPStatic_SPMV.hpp>
+#include <OpenMPDynamic_SPMV.hpp>
+#include <OpenMPSmartStatic_SPMV.hpp>
+#endif
+
+enum {KOKKOS, MKL, CUSPARSE, KK_KERNELS, KK_KERNELS_INSP, KK_INSP, OMP_STATIC, OMP_DYNAMIC, OMP_INSP, NUM_SPMV_KERNELS};
+enum {AUTO, DYNAMIC, STATIC};
+
+// Name of a kernel on the command line and whether it is compiled in.
+struct SpmvKernel {
+  int test;
+  const char* name;
+  bool available;
+};
+
+inline const std::vector<SpmvKernel>& spmv_kernels() {
+  static const std::vector<SpmvKernel> kernels = {
+    {KOKKOS,          "kk",              true},
+    {KK_INSP,         "kk-insp",         true},
+#ifdef HAVE_KK_KERNELS
+    {KK_KERNELS,      "kk-kernels",      true},
+    {KK_KERNELS_INSP, "kk-kernels-insp", true},
+#else
+    {KK_KERNELS,      "kk-kernels",      false},
+    {KK_KERNELS_INSP, "kk-kernels-insp", false},
+#endif
+#ifdef _OPENMP
+    {OMP_STATIC,      "omp-static",      true},
+    {OMP_DYNAMIC,     "omp-dynamic",     true},
+    {OMP_INSP,        "omp-insp",        true},
+#else
+    {OMP_STATIC,      "omp-static",      false},
+    {OMP_DYNAMIC,     "omp-dynamic",     false},
+    {OMP_INSP,        "omp-insp",        false},
+#endif
+#ifdef HAVE_MKL
+    {MKL,             "mkl",             true},
+#else
+    {MKL,             "mkl",             false},
+#endif
+#ifdef HAVE_CUSPARSE
+    {CUSPARSE,        "cusparse",        true},
+#else
+    {CUSPARSE,        "cusparse",        false},
+#endif
+  };
+  return kernels;
+}
+
+inline const char* spmv_kernel_name(const int test) {
+  for(const SpmvKernel& k : spmv_kernels())
+    if(k.test == test) return k.name;
+  return "unknown";
+}
+
+// Parses a comma separated list of kernel names, or "all" for every
+// available kernel. Returns false on an unknown or unavailable name.
+inline bool parse_spmv_kernels(const char* list, std::vector<int>& tests) {
+  tests.clear();
+  std::string s(list);
+  size_t begin = 0;
+  while(begin <= s.size()) {
+    size_t end = s.find(',', begin);
+    if(end == std::string::npos) end = s.size();
+    const std::string name = s.substr(begin, end - begin);
+    bool found = false;
+    for(const SpmvKernel& k : spmv_kernels()) {
+      if(name == "all" ? k.available : name == k.name) {
+        if(!k.available) {
+          fprintf(stderr, "SpMV kernel %s is not compiled in.\n", k.name);
+          return false;
+        }
+        tests.push_back(k.test);
+        found = true;
+      }
+    }
+    if(!found) {
+      fprintf(stderr, "Unknown SpMV kernel %s.\n", name.c_str());
+      return false;
+    }
+    begin = end + 1;
+  }
+  return true;
+}
+
+// One way of computing y = A*x: the kernel and its launch parameters.
+// Every implementation is called through apply so that the driver times
+// all of them the same way.
+struct SpmvPlan {
+  int test;
+  int schedule;
+  int rows_per_thread;
+  int team_size;
+  int vector_length;
+
+  SpmvPlan(int test_ = KOKKOS, int schedule_ = AUTO, int rows_per_thread_ = -1, int team_size_ = -1, int vector_length_ = -1)
+    : test(test_), schedule(schedule_), rows_per_thread(rows_per_thread_), team_size(team_size_), vector_length(vector_length_) {}
+
+  const char* name() const { return spmv_kernel_name(test); }
+
+  // Inspection based kernels set up their partitioning of A on the first call.
+  template<typename AType, typename XType, typename YType>
+  void apply(AType& A, XType x, YType y) const {
+    int sched = schedule;
+    switch(test) {
+    case KOKKOS:
+      if(sched == AUTO)
+        sched = A.nnz()>10000000?DYNAMIC:STATIC;
+      if(sched == STATIC)
+        kk_matvec<AType,XType,YType,Kokkos::Static>(A, x, y, rows_per_thread, team_size, vector_length);
+      if(sched == DYNAMIC)
+        kk_matvec<AType,XType,YType,Kokkos::Dynamic>(A, x, y, rows_per_thread, team_size, vector_length);
+      break;
+    case KK_INSP:
+      if(sched == AUTO)
+        sched = A.nnz()>10000000?DYNAMIC:STATIC;
+      if(sched == STATIC)
+        kk_inspector_matvec<AType,XType,YType,Kokkos::Static>(A, x, y, rows_per_thread, team_size, vector_length);
+      if(sched == DYNAMIC)
+        kk_inspector_matvec<AType,XType,YType,Kokkos::Dynamic>(A, x, y, rows_per_thread, team_size, vector_length);
+      break;
+#ifdef _OPENMP
+    case OMP_STATIC:
+      openmp_static_matvec<AType, XType, YType, int, double>(A, x, y, rows_per_thread, team_size, vector_length);
+      break;
+    case OMP_DYNAMIC:
+      openmp_dynamic_matvec<AType, XType, YType, int, double>(A, x, y, rows_per_thread, team_size, vector_length);
+      break;
+    case OMP_INSP:
+      openmp_smart_static_matvec<AType, XType, YType, int, double>(A, x, y, rows_per_thread, team_size, vector_length);
+      break;
+#endif
+#ifdef HAVE_MKL
+    case MKL:
+      mkl_matvec(A, x, y, rows_per_thread, team_size, vector_length);
+      break;
+#endif
+#ifdef HAVE_CUSPARSE
+    case CUSPARSE:
+      cusparse_matvec(A, x, y, rows_per_thread, team_size, vector_length);
+      break;
+#endif
+#ifdef HAVE_KK_KERNELS
+    case KK_KERNELS:
+      kokkoskernels_matvec(A, x, y, rows_per_thread, team_size, vector_length);
+      break;
+    case KK_KERNELS_INSP:
+      if(A.graph.row_block_offsets.data()==NULL)
+        A.graph.create_block_partitioning(AType::execution_space::concurrency());
+      kokkoskernels_matvec(A, x, y, rows_per_thread, team_size, vector_length);
+      break;
+#endif
+    default:
+      fprintf(stderr, "Selected test is not available.\n");
+    }
+  }
+};
+
+#endif /* SPMV_PLAN_HPP_ */
@@ -22,6 +22,8 @@ ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function_sparse.bash trsv
 #spmv
 ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function_sparse.bash spmv KokkosSparse_spmv KokkosSparse_spmv_spec.hpp KokkosSparse ${KOKKOSKERNELS_PATH}
 ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function_sparse.bash spmv KokkosSparse_spmv_mv KokkosSparse_spmv_spec.hpp KokkosSparse ${KOKKOSKERNELS_PATH}
+${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function_sparse_mixed.bash spmv KokkosSparse_spmv_mixed KokkosSparse_spmv_spec.hpp KokkosSparse ${KOKKOSKERNELS_PATH}
+${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function_sparse_mixed.bash spmv KokkosSparse_spmv_mv_mixed KokkosSparse_spmv_spec.hpp KokkosSparse ${KOKKOSKERNELS_PATH}
 
 
 #abs
@@ -31,10 +33,12 @@ ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash abs KokkosBl
 #axpby
 ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash axpby KokkosBlas1_axpby KokkosBlas1_axpby_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
 ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash axpby KokkosBlas1_axpby_mv KokkosBlas1_axpby_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
+${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function_mixed.bash axpby KokkosBlas1_axpby_mixed KokkosBlas1_axpby_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
 
 #dot
 ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash dot KokkosBlas1_dot KokkosBlas1_dot_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
 ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash dot KokkosBlas1_dot_mv KokkosBlas1_dot_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
+${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function_mixed.bash dot KokkosBlas1_dot_mixed KokkosBlas1_dot_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
 
 #mult
 ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash mult KokkosBlas1_mult KokkosBlas1_mult_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
@@ -71,9 +75,16 @@ ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash sum KokkosBl
 #update
 ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash update KokkosBlas1_update KokkosBlas1_update_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
 ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash update KokkosBlas1_update_mv KokkosBlas1_update_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
+${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function_mixed.bash update KokkosBlas1_update_mixed KokkosBlas1_update_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
 
 #gemv
 ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash gemv KokkosBlas2_gemv KokkosBlas2_gemv_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
 
 #gemm
 ${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash gemm KokkosBlas3_gemm KokkosBlas3_gemm_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
+
+#trsm
+${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash trsm KokkosBlas3_trsm KokkosBlas3_trsm_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
+
+#syrk
+${KOKKOSKERNELS_PATH}/scripts/generate_specialization_function.bash syrk KokkosBlas3_syrk KokkosBlas3_syrk_spec.hpp KokkosBlas ${KOKKOSKERNELS_PATH}
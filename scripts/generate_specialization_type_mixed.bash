@@ -0,0 +1,65 @@
+#!/bin/bash
+Function=$1                 #e.g. dot: function name
+FunctionExtended=$2         #e.g. KokkosBlas1_dot_mixed: prefix for files etc.
+ScalarX=$3                  #e.g. float: value type of the input X
+ScalarY=$4                  #e.g. double: value type of the input/output Y
+Layout=$5                   #e.g. LayoutLeft
+ExecSpace=$6                #e.g. OpenMP
+MemSpace=$7                 #e.g. HostSpace
+filename_master_hpp=$8      #e.g. KokkosBlas1_dot_spec.hpp: where the actual function definition and declaration lives 
+NameSpace=$9                #e.g. KokkosBlas: namespace it lives in
+KokkosKernelsPath=${10}
+
+Macro=`echo ${FunctionExtended} | awk '{print toupper($0)}'`
+ScalarX_UpperCase=`echo ${ScalarX} | awk '{print toupper($0)}' | sed 's|\:\:|\_|g' | sed 's|<|_|g' | sed 's|>|_|g'`
+ScalarY_UpperCase=`echo ${ScalarY} | awk '{print toupper($0)}' | sed 's|\:\:|\_|g' | sed 's|<|_|g' | sed 's|>|_|g'`
+ScalarX_FileName=`echo ${ScalarX} | sed 's|\:\:|\_|g' | sed 's|<|_|g' | sed 's|>|_|g'`
+ScalarY_FileName=`echo ${ScalarY} | sed 's|\:\:|\_|g' | sed 's|<|_|g' | sed 's|>|_|g'`
+Layout_UpperCase=`echo ${Layout} | awk '{print toupper($0)}'`
+ExecSpace_UpperCase=`echo ${ExecSpace} | awk '{print toupper($0)}'`
+
+prefix="Experimental::"
+MemSpace_UpperCase=`echo ${MemSpace#$prefix} | awk '{print toupper($0)}'`
+
+# The file name starts with ScalarX, so that the build picks it up
+# together with the other instantiations for ScalarX.
+filename_cpp=generated_specializations_cpp/${Function}/${FunctionExtended}_eti_spec_inst_${ScalarX_FileName}_${ScalarY_FileName}_${Layout}_${ExecSpace}_${MemSpace#$prefix}.cpp
+filename_spec_avail_hpp=generated_specializations_hpp/${FunctionExtended}_eti_spec_avail.hpp
+filename_spec_decl_hpp=generated_specializations_hpp/${FunctionExtended}_eti_spec_decl.hpp
+
+
+cat ${KokkosKernelsPath}/scripts/header > ${filename_cpp}
+echo "" >> ${filename_cpp}
+echo "#define KOKKOSKERNELS_IMPL_COMPILE_LIBRARY true" >> ${filename_cpp}
+echo "#include \"KokkosKernels_config.h\"" >> ${filename_cpp}
+echo "#if defined (KOKKOSKERNELS_INST_${ScalarX_UpperCase}) \\" >> ${filename_cpp}
+echo " && defined (KOKKOSKERNELS_INST_${ScalarY_UpperCase}) \\" >> ${filename_cpp}
+echo " && defined (KOKKOSKERNELS_INST_${Layout_UpperCase}) \\" >> ${filename_cpp}
+echo " && defined (KOKKOSKERNELS_INST_EXECSPACE_${ExecSpace_UpperCase}) \\" >> ${filename_cpp}
+echo " && defined (KOKKOSKERNELS_INST_MEMSPACE_${MemSpace_UpperCase})" >> ${filename_cpp}
+echo "#include \"${filename_master_hpp}\"" >> ${filename_cpp}
+echo "" >> ${filename_cpp}
+echo "namespace ${NameSpace} {" >> ${filename_cpp}
+echo "namespace Impl {" >> ${filename_cpp}
+echo " ${Macro}_ETI_SPEC_INST(${ScalarX}, ${ScalarY}, Kokkos::${Layout}, Kokkos::${ExecSpace}, Kokkos::${MemSpace})" >> ${filename_cpp}
+echo "} // Impl" >> ${filename_cpp} 
+echo "} // ${NameSpace}" >> ${filename_cpp}
+echo "#endif" >> ${filename_cpp}
+
+echo "" >> ${filename_spec_avail_hpp}
+echo "#if defined (KOKKOSKERNELS_INST_${ScalarX_UpperCase}) \\" >> ${filename_spec_avail_hpp}
+echo " && defined (KOKKOSKERNELS_INST_${ScalarY_UpperCase}) \\" >> ${filename_spec_avail_hpp}
+echo " && defined (KOKKOSKERNELS_INST_${Layout_UpperCase}) \\" >> ${filename_spec_avail_hpp}
+echo " && defined (KOKKOSKERNELS_INST_EXECSPACE_${ExecSpace_UpperCase}) \\" >> ${filename_spec_avail_hpp}
+echo " && defined (KOKKOSKERNELS_INST_MEMSPACE_${MemSpace_UpperCase})" >> ${filename_spec_avail_hpp}
+echo " ${Macro}_ETI_SPEC_AVAIL(${ScalarX}, ${ScalarY}, Kokkos::${Layout}, Kokkos::${ExecSpace}, Kokkos::${MemSpace})" >> ${filename_spec_avail_hpp}
+echo "#endif" >> ${filename_spec_avail_hpp}
+
+echo "" >> ${filename_spec_decl_hpp}
+echo "#if defined (KOKKOSKERNELS_INST_${ScalarX_UpperCase}) \\" >> ${filename_spec_decl_hpp}
+echo " && defined (KOKKOSKERNELS_INST_${ScalarY_UpperCase}) \\" >> ${filename_spec_decl_hpp}
+echo " && defined (KOKKOSKERNELS_INST_${Layout_UpperCase}) \\" >> ${filename_spec_decl_hpp}
+echo " && defined (KOKKOSKERNELS_INST_EXECSPACE_${ExecSpace_UpperCase}) \\" >> ${filename_spec_decl_hpp}
+echo " && defined (KOKKOSKERNELS_INST_MEMSPACE_${MemSpace_UpperCase})" >> ${filename_spec_decl_hpp}
+echo " ${Macro}_ETI_SPEC_DECL(${ScalarX}, ${ScalarY}, Kokkos::${Layout}, Kokkos::${ExecSpace}, Kokkos::${MemSpace})" >> ${filename_spec_decl_hpp}
+echo "#endif" >> ${filename_spec_decl_hpp}
@@ -0,0 +1,80 @@
+#!/bin/bash
+Function=$1                 #e.g. spmv: function name
+FunctionExtended=$2         #e.g. KokkosSparse_spmv_mixed: prefix for files etc.
+ScalarA=$3                  #e.g. float: value type of the matrix
+ScalarX=$4                  #e.g. double: value type of the vectors
+Layout=$5                   #e.g. LayoutLeft
+ExecSpace=$6                #e.g. OpenMP
+MemSpace=$7                 #e.g. HostSpace
+OffsetType=$8
+OrdinalType=$9
+
+filename_master_hpp=${10}   #e.g. KokkosSparse_spmv_spec.hpp: where the actual function definition and declaration lives 
+NameSpace=${11}             #e.g. KokkosSparse: namespace it lives in
+KokkosKernelsPath=${12}
+
+Macro=`echo ${FunctionExtended} | awk '{print toupper($0)}'`
+ScalarA_UpperCase=`echo ${ScalarA} | awk '{print toupper($0)}' | sed 's|\:\:|\_|g' | sed 's|<|_|g' | sed 's|>|_|g'`
+ScalarX_UpperCase=`echo ${ScalarX} | awk '{print toupper($0)}' | sed 's|\:\:|\_|g' | sed 's|<|_|g' | sed 's|>|_|g'`
+
+Offset_UpperCase=`echo ${OffsetType} | awk '{print toupper($0)}' | sed 's|\:\:|\_|g' | sed 's|<|_|g' | sed 's|>|_|g'`
+Ordinal_UpperCase=`echo ${OrdinalType} | awk '{print toupper($0)}' | sed 's|\:\:|\_|g' | sed 's|<|_|g' | sed 's|>|_|g'`
+
+ScalarA_FileName=`echo ${ScalarA} | sed 's|\:\:|\_|g' | sed 's|<|_|g' | sed 's|>|_|g'`
+ScalarX_FileName=`echo ${ScalarX} | sed 's|\:\:|\_|g' | sed 's|<|_|g' | sed 's|>|_|g'`
+Layout_UpperCase=`echo ${Layout} | awk '{print toupper($0)}'`
+ExecSpace_UpperCase=`echo ${ExecSpace} | awk '{print toupper($0)}'`
+prefix="Experimental::"
+MemSpace_UpperCase=`echo ${MemSpace#$prefix} | awk '{print toupper($0)}'`
+
+OffsetType_FileName=`echo ${OffsetType} | sed 's|\ |\_|g'`
+OrdinalType_FileName=`echo ${OrdinalType} | sed 's|\ |\_|g'`
+
+# The file name starts with ScalarA, so that the build picks it up
+# together with the other instantiations for ScalarA.
+filename_cpp=generated_specializations_cpp/${Function}/${FunctionExtended}_eti_spec_inst_${ScalarA_FileName}_${ScalarX_FileName}_${OffsetType_FileName}_${OrdinalType_FileName}_${Layout}_${ExecSpace}_${MemSpace#$prefix}.cpp
+filename_spec_avail_hpp=generated_specializations_hpp/${FunctionExtended}_eti_spec_avail.hpp
+filename_spec_decl_hpp=generated_specializations_hpp/${FunctionExtended}_eti_spec_decl.hpp
+
+
+cat ${KokkosKernelsPath}/scripts/header > ${filename_cpp}
+echo "" >> ${filename_cpp}
+echo "#define KOKKOSKERNELS_IMPL_COMPILE_LIBRARY true" >> ${filename_cpp}
+echo "#include \"KokkosKernels_config.h\"" >> ${filename_cpp}
+echo "#if defined (KOKKOSKERNELS_INST_${ScalarA_UpperCase}) \\" >> ${filename_cpp}
+echo " && defined (KOKKOSKERNELS_INST_${ScalarX_UpperCase}) \\" >> ${filename_cpp}
+echo " && defined (KOKKOSKERNELS_INST_${Layout_UpperCase}) \\" >> ${filename_cpp}
+echo " && defined (KOKKOSKERNELS_INST_EXECSPACE_${ExecSpace_UpperCase}) \\" >> ${filename_cpp}
+echo " && defined (KOKKOSKERNELS_INST_MEMSPACE_${MemSpace_UpperCase}) \\" >> ${filename_cpp}
+echo " && defined (KOKKOSKERNELS_INST_ORDINAL_${Ordinal_UpperCase}) \\" >> ${filename_cpp}
+echo " && defined (KOKKOSKERNELS_INST_OFFSET_${Offset_UpperCase}) " >> ${filename_cpp}
+echo "#include \"${filename_master_hpp}\"" >> ${filename_cpp}
+echo "" >> ${filename_cpp}
+echo "namespace ${NameSpace} {" >> ${filename_cpp}
+echo "namespace Impl {" >> ${filename_cpp}
+echo " ${Macro}_ETI_SPEC_INST(${ScalarA}, ${ScalarX}, ${OrdinalType}, ${OffsetType}, Kokkos::${Layout}, Kokkos::${ExecSpace}, Kokkos::${MemSpace})" >> ${filename_cpp}
+echo "} // Impl" >> ${filename_cpp} 
+echo "} // ${NameSpace}" >> ${filename_cpp}
+echo "#endif" >> ${filename_cpp}
+
+echo "" >> ${filename_spec_avail_hpp}
+echo "#if defined (KOKKOSKERNELS_INST_${ScalarA_UpperCase}) \\" >> ${filename_spec_avail_hpp}
+echo " && defined (KOKKOSKERNELS_INST_${ScalarX_UpperCase}) \\" >> ${filename_spec_avail_hpp}
+echo " && defined (KOKKOSKERNELS_INST_${Layout_UpperCase}) \\" >> ${filename_spec_avail_hpp}
+echo " && defined (KOKKOSKERNELS_INST_EXECSPACE_${ExecSpace_UpperCase}) \\" >> ${filename_spec_avail_hpp}
+echo " && defined (KOKKOSKERNELS_INST_MEMSPACE_${MemSpace_UpperCase}) \\" >> ${filename_spec_avail_hpp}
+echo " && defined (KOKKOSKERNELS_INST_ORDINAL_${Ordinal_UpperCase}) \\" >> ${filename_spec_avail_hpp} 
+echo " && defined (KOKKOSKERNELS_INST_OFFSET_${Offset_UpperCase}) " >> ${filename_spec_avail_hpp}
+echo " ${Macro}_ETI_SPEC_AVAIL(${ScalarA}, ${ScalarX}, ${OrdinalType}, ${OffsetType}, Kokkos::${Layout}, Kokkos::${ExecSpace}, Kokkos::${MemSpace})" >> ${filename_spec_avail_hpp}
+echo "#endif" >> ${filename_spec_avail_hpp}
+
+echo "" >> ${filename_spec_decl_hpp}
+echo "#if defined (KOKKOSKERNELS_INST_${ScalarA_UpperCase}) \\" >> ${filename_spec_decl_hpp}
+echo " && defined (KOKKOSKERNELS_INST_${ScalarX_UpperCase}) \\" >> ${filename_spec_decl_hpp}
+echo " && defined (KOKKOSKERNELS_INST_${Layout_UpperCase}) \\" >> ${filename_spec_decl_hpp}
+echo " && defined (KOKKOSKERNELS_INST_EXECSPACE_${ExecSpace_UpperCase}) \\" >> ${filename_spec_decl_hpp}
+echo " && defined (KOKKOSKERNELS_INST_MEMSPACE_${MemSpace_UpperCase}) \\" >> ${filename_spec_decl_hpp}
+echo " && defined (KOKKOSKERNELS_INST_ORDINAL_${Ordinal_UpperCase}) \\" >> ${filename_spec_decl_hpp} 
+echo " && defined (KOKKOSKERNELS_INST_OFFSET_${Offset_UpperCase}) " >> ${filename_spec_decl_hpp}
+echo " ${Macro}_ETI_SPEC_DECL(${ScalarA}, ${ScalarX}, ${OrdinalType}, ${OffsetType}, Kokkos::${Layout}, Kokkos::${ExecSpace}, Kokkos::${MemSpace})" >> ${filename_spec_decl_hpp}
+echo "#endif" >> ${filename_spec_decl_hpp}
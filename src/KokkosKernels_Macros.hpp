@@ -52,4 +52,95 @@
 #define KOKKOSKERNELS_DEBUG_LEVEL 1
 #endif
 
+// Header-only fast path for the BLAS1 kernels. Defining
+// KOKKOSKERNELS_INLINE_<KERNEL> (ABS, AXPBY, DOT, MULT, NRM1, NRM2, NRM2W,
+// NRMINF, RECIPROCAL, SCAL, SUM, UPDATE) or KOKKOSKERNELS_INLINE_BLAS1 for
+// all of them, before any KokkosKernels header is included, makes the
+// kernel skip the explicitly instantiated library version and instantiate
+// the implementation in the calling translation unit, so that the compiler
+// can inline it. This pays off for short vectors, where the cost of the
+// call is comparable to the work. TPL specializations are still preferred
+// and the library itself is never affected. Since the public functions are
+// the same templates in either case, define the macros consistently in all
+// translation units of a program that call the kernel.
+//
+// KOKKOSKERNELS_BLAS1_INLINE(KERNEL) is true where the kernel takes that
+// path; the spec headers use it both to include the implementation and to
+// turn off the ETI specialization of their unification layer.
+
+#if defined(KOKKOSKERNELS_INLINE_ABS) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_ABS true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_ABS false
+#endif
+
+#if defined(KOKKOSKERNELS_INLINE_AXPBY) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_AXPBY true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_AXPBY false
+#endif
+
+#if defined(KOKKOSKERNELS_INLINE_DOT) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_DOT true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_DOT false
+#endif
+
+#if defined(KOKKOSKERNELS_INLINE_MULT) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_MULT true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_MULT false
+#endif
+
+#if defined(KOKKOSKERNELS_INLINE_NRM1) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_NRM1 true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_NRM1 false
+#endif
+
+#if defined(KOKKOSKERNELS_INLINE_NRM2) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_NRM2 true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_NRM2 false
+#endif
+
+#if defined(KOKKOSKERNELS_INLINE_NRM2W) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_NRM2W true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_NRM2W false
+#endif
+
+#if defined(KOKKOSKERNELS_INLINE_NRMINF) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_NRMINF true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_NRMINF false
+#endif
+
+#if defined(KOKKOSKERNELS_INLINE_RECIPROCAL) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_RECIPROCAL true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_RECIPROCAL false
+#endif
+
+#if defined(KOKKOSKERNELS_INLINE_SCAL) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_SCAL true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_SCAL false
+#endif
+
+#if defined(KOKKOSKERNELS_INLINE_SUM) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_SUM true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_SUM false
+#endif
+
+#if defined(KOKKOSKERNELS_INLINE_UPDATE) || defined(KOKKOSKERNELS_INLINE_BLAS1)
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_UPDATE true
+#else
+#define KOKKOSKERNELS_IMPL_INLINE_REQUESTED_UPDATE false
+#endif
+
+#define KOKKOSKERNELS_BLAS1_INLINE(KERNEL) \
+  (KOKKOSKERNELS_IMPL_INLINE_REQUESTED_ ## KERNEL && !KOKKOSKERNELS_IMPL_COMPILE_LIBRARY)
+
 #endif // KOKKOSKERNELS_MACROS_HPP_
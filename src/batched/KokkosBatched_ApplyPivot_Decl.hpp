@@ -0,0 +1,45 @@
+#ifndef __KOKKOSBATCHED_APPLY_PIVOT_DECL_HPP__
+#define __KOKKOSBATCHED_APPLY_PIVOT_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial ApplyPivot
+    ///
+    /// Apply the row interchanges from LUPivot to b (rank 1) or B (rank 2);
+    /// b := P b. Follow with Trsv/Trsm on L then U to solve A x = b.
+    ///
+
+    struct SerialApplyPivot {
+      template<typename PivViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const PivViewType &ipiv,
+             const BViewType &B);
+    };
+
+    ///
+    /// Team ApplyPivot
+    ///
+
+    template<typename MemberType>
+    struct TeamApplyPivot {
+      template<typename PivViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const PivViewType &ipiv,
+             const BViewType &B);
+    };
+
+  }
+}
+
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef __KOKKOSBATCHED_APPLY_PIVOT_IMPL_HPP__
+#define __KOKKOSBATCHED_APPLY_PIVOT_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_ApplyPivot_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Impl
+    /// ===========
+
+    template<typename PivViewType,
+             typename BViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialApplyPivot::
+    invoke(const PivViewType &ipiv,
+           const BViewType &B) {
+      return SerialApplyPivotInternal::
+        invoke(ipiv.extent(0),
+               ipiv.data(), ipiv.stride_0(), ipiv.stride_1(),
+               B.extent(1),
+               B.data(), B.stride_0(), B.stride_1());
+    }
+
+    ///
+    /// Team Impl
+    /// =========
+    
+    template<typename MemberType>
+    template<typename PivViewType,
+             typename BViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamApplyPivot<MemberType>::
+    invoke(const MemberType &member,
+           const PivViewType &ipiv,
+           const BViewType &B) {
+      return TeamApplyPivotInternal::
+        invoke(member,
+               ipiv.extent(0),
+               ipiv.data(), ipiv.stride_0(), ipiv.stride_1(),
+               B.extent(1),
+               B.data(), B.stride_0(), B.stride_1());
+    }
+
+  }
+}
+
+
+#endif
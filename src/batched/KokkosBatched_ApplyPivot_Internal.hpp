@@ -0,0 +1,84 @@
+#ifndef __KOKKOSBATCHED_APPLY_PIVOT_INTERNAL_HPP__
+#define __KOKKOSBATCHED_APPLY_PIVOT_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Internal Impl
+    /// ==================== 
+        
+    struct SerialApplyPivotInternal {
+      template<typename ValueType>
+      KOKKOS_FORCEINLINE_FUNCTION
+      static int
+      invoke(const int k, 
+             const int *__restrict__ ipiv, const int ips0, const int ips1,
+             const int n,
+             /* */ ValueType *__restrict__ B, const int bs0, const int bs1) {
+        typedef VectorLane<ValueType> lane_type;
+        typedef typename lane_type::value_type value_type;
+
+        for (int p=0;p<k;++p) 
+          for (int l=0;l<lane_type::vector_length;++l) {
+            const int piv = ipiv[p*ips0+l*ips1];
+            if (piv != p) 
+              for (int j=0;j<n;++j) {
+                value_type 
+                  &a = lane_type::get(B[p  *bs0+j*bs1], l),
+                  &b = lane_type::get(B[piv*bs0+j*bs1], l);
+                const value_type tmp = a; a = b; b = tmp;
+              }
+          }
+        return 0;
+      }
+    };        
+    
+    ///
+    /// Team Internal Impl
+    /// ==================
+
+    struct TeamApplyPivotInternal {
+      template<typename MemberType,
+               typename ValueType>
+      KOKKOS_FORCEINLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const int k, 
+             const int *__restrict__ ipiv, const int ips0, const int ips1,
+             const int n,
+             /* */ ValueType *__restrict__ B, const int bs0, const int bs1) {
+        typedef VectorLane<ValueType> lane_type;
+        typedef typename lane_type::value_type value_type;
+
+        // interchanges are sequential in p; each thread owns a (column, lane)
+        const int vl = lane_type::vector_length;
+        Kokkos::parallel_for
+          (Kokkos::TeamThreadRange(member,0,n*vl),
+           [&](const int &jl) {
+            const int j = jl/vl, l = jl%vl;
+            for (int p=0;p<k;++p) {
+              const int piv = ipiv[p*ips0+l*ips1];
+              if (piv != p) {
+                value_type 
+                  &a = lane_type::get(B[p  *bs0+j*bs1], l),
+                  &b = lane_type::get(B[piv*bs0+j*bs1], l);
+                const value_type tmp = a; a = b; b = tmp;
+              }
+            }
+          });
+        return 0;
+      }
+    };
+
+  }
+}
+
+
+#endif
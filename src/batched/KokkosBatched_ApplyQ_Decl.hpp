@@ -0,0 +1,56 @@
+#ifndef __KOKKOSBATCHED_APPLY_Q_DECL_HPP__
+#define __KOKKOSBATCHED_APPLY_Q_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial ApplyQ
+    ///
+    /// B := Q B (Trans::NoTranspose) or B := Q^T B (Trans::Transpose) where
+    /// Q is given by the Householder vectors in A and t from QR.
+    /// Only Side::Left is provided.
+    ///
+
+    template<typename ArgSide,
+             typename ArgTrans,
+             typename ArgAlgo>
+    struct SerialApplyQ {
+      template<typename AViewType,
+               typename tViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A,
+             const tViewType &t,
+             const BViewType &B);
+    };
+
+    ///
+    /// Team ApplyQ
+    ///
+
+    template<typename MemberType,
+             typename ArgSide,
+             typename ArgTrans,
+             typename ArgAlgo>
+    struct TeamApplyQ {
+      template<typename AViewType,
+               typename tViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const AViewType &A,
+             const tViewType &t,
+             const BViewType &B);
+    };
+
+  }
+}
+
+
+#endif
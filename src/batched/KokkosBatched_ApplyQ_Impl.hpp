@@ -0,0 +1,65 @@
+#ifndef __KOKKOSBATCHED_APPLY_Q_IMPL_HPP__
+#define __KOKKOSBATCHED_APPLY_Q_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_ApplyQ_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Impl
+    /// ===========
+
+    template<typename ArgTrans>
+    struct SerialApplyQ<Side::Left,ArgTrans,Algo::QR::Unblocked> {
+      template<typename AViewType,
+               typename tViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A,
+             const tViewType &t,
+             const BViewType &B) {
+        return SerialApplyQ_LeftInternal::
+          invoke(std::is_same<ArgTrans,Trans::Transpose>::value,
+                 B.extent(0), B.extent(1), A.extent(1),
+                 A.data(), A.stride_0(), A.stride_1(),
+                 t.data(), t.stride_0(),
+                 B.data(), B.stride_0(), B.stride_1());
+      }
+    };
+
+    ///
+    /// Team Impl
+    /// =========
+    
+    template<typename MemberType, typename ArgTrans>
+    struct TeamApplyQ<MemberType,Side::Left,ArgTrans,Algo::QR::Unblocked> {
+      template<typename AViewType,
+               typename tViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const AViewType &A,
+             const tViewType &t,
+             const BViewType &B) {
+        return TeamApplyQ_LeftInternal::
+          invoke(member,
+                 std::is_same<ArgTrans,Trans::Transpose>::value,
+                 B.extent(0), B.extent(1), A.extent(1),
+                 A.data(), A.stride_0(), A.stride_1(),
+                 t.data(), t.stride_0(),
+                 B.data(), B.stride_0(), B.stride_1());
+      }
+    };
+
+  }
+}
+
+
+#endif
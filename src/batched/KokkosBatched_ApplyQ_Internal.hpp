@@ -0,0 +1,70 @@
+#ifndef __KOKKOSBATCHED_APPLY_Q_INTERNAL_HPP__
+#define __KOKKOSBATCHED_APPLY_Q_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Householder_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Internal Impl
+    /// ==================== 
+        
+    struct SerialApplyQ_LeftInternal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const bool is_transpose,
+             const int m, const int n, const int k,
+             const ValueType *__restrict__ A, const int as0, const int as1,
+             const ValueType *__restrict__ t, const int ts,
+             /* */ ValueType *__restrict__ B, const int bs0, const int bs1) {
+        // Q^T = H(k-1) ... H(0) and Q = H(0) ... H(k-1)
+        for (int q=0;q<k;++q) {
+          const int p = is_transpose ? q : k-q-1;
+          SerialApplyLeftHouseholderInternal::
+            invoke(m-p-1, n, 
+                   t+p*ts, 
+                   A+(p+1)*as0+p*as1, as0, 
+                   B+p*bs0, bs1, 
+                   B+(p+1)*bs0, bs0, bs1);
+        }
+        return 0;
+      }
+    };        
+    
+    ///
+    /// Team Internal Impl
+    /// ==================
+
+    struct TeamApplyQ_LeftInternal {
+      template<typename MemberType,
+               typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const bool is_transpose,
+             const int m, const int n, const int k,
+             const ValueType *__restrict__ A, const int as0, const int as1,
+             const ValueType *__restrict__ t, const int ts,
+             /* */ ValueType *__restrict__ B, const int bs0, const int bs1) {
+        // a thread applies all reflectors to its own column
+        Kokkos::parallel_for
+          (Kokkos::TeamThreadRange(member,0,n),
+           [&](const int &j) {
+            SerialApplyQ_LeftInternal::
+              invoke(is_transpose, m, 1, k, A, as0, as1, t, ts, B+j*bs1, bs0, bs1);
+          });
+        return 0;
+      }
+    };
+
+  }
+}
+
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef __KOKKOSBATCHED_BAND_LU_DECL_HPP__
+#define __KOKKOSBATCHED_BAND_LU_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Vector.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Band LU
+    /// =======
+    ///
+    /// LU factorization without pivoting of a band matrix A (n x n) with kl
+    /// sub and ku super diagonals, intended for small bandwidths (up to 8 or
+    /// so). As in LAPACK gbtrf, but with no extra rows for pivoting fill-in,
+    /// AB is (kl+ku+1 x n) and
+    ///
+    ///   AB(ku+i-j,j) = A(i,j) for max(0,j-ku) <= i <= min(n-1,j+kl).
+    ///
+    /// SerialBandLU overwrites AB with L (unit, below the diagonal) and U;
+    /// SerialBandLUSolve overwrites b (n) by the solution of A x = b using
+    /// the factors. With Vector<SIMD<T>,l> values, l interleaved systems
+    /// are factorized at once.
+    ///
+
+    template<typename ArgAlgo>
+    struct SerialBandLU {
+      template<typename ABViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const ABViewType &AB,
+             const int kl,
+             const int ku);
+    };
+
+    template<typename ArgAlgo>
+    struct SerialBandLUSolve {
+      template<typename ABViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const ABViewType &AB,
+             const int kl,
+             const int ku,
+             const BViewType &b);
+    };
+
+  }
+}
+
+#endif
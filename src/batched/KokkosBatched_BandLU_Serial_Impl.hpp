@@ -0,0 +1,49 @@
+#ifndef __KOKKOSBATCHED_BAND_LU_SERIAL_IMPL_HPP__
+#define __KOKKOSBATCHED_BAND_LU_SERIAL_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_BandLU_Serial_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Impl
+    /// ===========
+
+    template<>
+    template<typename ABViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialBandLU<Algo::LU::Unblocked>::
+    invoke(const ABViewType &AB,
+           const int kl,
+           const int ku) {
+      return SerialBandLU_Internal<Algo::LU::Unblocked>::
+        invoke(AB.extent(1), kl, ku,
+               AB.data(), AB.stride_0(), AB.stride_1());
+    }
+
+    template<>
+    template<typename ABViewType,
+             typename BViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialBandLUSolve<Algo::LU::Unblocked>::
+    invoke(const ABViewType &AB,
+           const int kl,
+           const int ku,
+           const BViewType &b) {
+      return SerialBandLUSolve_Internal<Algo::LU::Unblocked>::
+        invoke(AB.extent(1), kl, ku,
+               AB.data(), AB.stride_0(), AB.stride_1(),
+               b.data(), b.stride_0());
+    }
+
+  }
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef __KOKKOSBATCHED_BAND_LU_SERIAL_INTERNAL_HPP__
+#define __KOKKOSBATCHED_BAND_LU_SERIAL_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Serial Internal Impl
+    /// ==================== 
+    ///
+    /// A(i,j) is AB[(ku+i-j)*as0+j*as1]
+    ///
+
+    template<typename AlgoType>
+    struct SerialBandLU_Internal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int 
+      invoke(const int n, const int kl, const int ku,
+             ValueType *__restrict__ AB, const int as0, const int as1);
+    };
+
+    template<>
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialBandLU_Internal<Algo::LU::Unblocked>::
+    invoke(const int n, const int kl, const int ku,
+           ValueType *__restrict__ AB, const int as0, const int as1) {
+      const ValueType one(1);
+
+      // moving along a column of A is as0, along a row is as1-as0
+      const int rs = as1 - as0;
+      for (int p=0;p<n;++p) {
+        const int 
+          iend = (kl < (n-p-1) ? kl : (n-p-1)),
+          jend = (ku < (n-p-1) ? ku : (n-p-1));
+        
+        ValueType 
+          *__restrict__ alpha11 = AB+ku*as0+p*as1,
+          *__restrict__ a21 = alpha11+as0,
+          *__restrict__ a12t = alpha11+rs,
+          *__restrict__ A22 = alpha11+as0+rs;
+
+        const ValueType inv_alpha11 = one/alpha11[0];
+        for (int i=0;i<iend;++i) {
+          a21[i*as0] *= inv_alpha11;
+          for (int j=0;j<jend;++j)
+            A22[i*as0+j*rs] -= a21[i*as0]*a12t[j*rs];
+        }
+      }
+      return 0;
+    }
+
+    template<typename AlgoType>
+    struct SerialBandLUSolve_Internal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int 
+      invoke(const int n, const int kl, const int ku,
+             const ValueType *__restrict__ AB, const int as0, const int as1,
+             /**/  ValueType *__restrict__ b, const int bs);
+    };
+
+    template<>
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialBandLUSolve_Internal<Algo::LU::Unblocked>::
+    invoke(const int n, const int kl, const int ku,
+           const ValueType *__restrict__ AB, const int as0, const int as1,
+           /**/  ValueType *__restrict__ b, const int bs) {
+      // L y = b
+      for (int p=0;p<n;++p) {
+        const int iend = (kl < (n-p-1) ? kl : (n-p-1));
+        const ValueType *__restrict__ a21 = AB+(ku+1)*as0+p*as1;
+        const ValueType beta1 = b[p*bs];
+        for (int i=0;i<iend;++i)
+          b[(p+i+1)*bs] -= a21[i*as0]*beta1;
+      }
+
+      // U x = y
+      for (int p=(n-1);p>=0;--p) {
+        const int iend = (ku < p ? ku : p);
+        const ValueType *__restrict__ alpha11 = AB+ku*as0+p*as1;
+        const ValueType beta1 = (b[p*bs] /= alpha11[0]);
+        for (int i=1;i<=iend;++i)
+          b[(p-i)*bs] -= alpha11[-i*as0]*beta1;
+      }
+      return 0;
+    }
+
+  }
+}
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef __KOKKOSBATCHED_BLOCKTRIDIAG_DECL_HPP__
+#define __KOKKOSBATCHED_BLOCKTRIDIAG_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "Kokkos_Core.hpp"
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Block tridiagonal matrices
+    /// ==========================
+    ///
+    /// A set of ntridiags block tridiagonal matrices, each with nrows x nrows
+    /// blocks of size blocksize. The matrices are interleaved along the
+    /// leading dimension; when ValueType is a SIMD vector, one entry of the
+    /// leading dimension packs vector_length matrices.
+    ///
+    ///   A(t,i,:,:) : diagonal block (i,i)
+    ///   B(t,i,:,:) : upper block    (i,i+1)
+    ///   C(t,i,:,:) : lower block    (i+1,i)
+    ///
+    template <typename ExecSpace, typename ValueType, typename ArrayLayout>
+    class BlockTridiagMatrices {
+    public:
+      typedef ExecSpace exec_space;
+      typedef ValueType value_type;
+      typedef ArrayLayout array_layout;
+
+      typedef Kokkos::View<value_type****,array_layout,exec_space> value_array_type;
+      
+    private:
+      const int _ntridiags, _nrows, _blocksize;
+      // A B
+      // C
+      value_array_type _A, _B, _C;
+      
+    public:
+
+      BlockTridiagMatrices (const int ntridiags,
+                            const int nrows,
+                            const int blocksize)
+        : _ntridiags(ntridiags), 
+          _nrows(nrows),
+          _blocksize(blocksize), 
+          _A("BlockTridiagMatrix::_A", _ntridiags, _nrows,   _blocksize, _blocksize),
+          _B("BlockTridiagMatrix::_B", _ntridiags, _nrows-1, _blocksize, _blocksize),
+          _C("BlockTridiagMatrix::_C", _ntridiags, _nrows-1, _blocksize, _blocksize) {}
+
+      BlockTridiagMatrices (const int ntridiags,
+                            const int nrows,
+                            const int blocksize,
+                            const value_array_type A_,
+                            const value_array_type B_,
+                            const value_array_type C_)
+        : _ntridiags(ntridiags), 
+          _nrows(nrows),
+          _blocksize(blocksize), 
+          _A(A_),
+          _B(B_),
+          _C(C_) {}
+
+      value_array_type A() const { return _A; }
+      value_array_type B() const { return _B; }
+      value_array_type C() const { return _C; }
+      
+      int BlockSize() const { return _blocksize; }
+      int NumRows() const { return _nrows; }
+      int NumTridiagMatrices() const { return _ntridiags; }
+    };
+
+    /// ntridiags is the number of scalar tridiagonal matrices; it is packed 
+    /// by the vector length of ValueType.
+    template<typename ExecSpace, typename ValueType, typename ArrayLayout>
+    BlockTridiagMatrices<ExecSpace,ValueType,ArrayLayout> 
+    create_block_tridiag_matrices(const int ntridiags, 
+                                  const int nrows,
+                                  const int blocksize) {
+      return BlockTridiagMatrices<ExecSpace,ValueType,ArrayLayout>
+        (adjustDimension<ValueType>(ntridiags), nrows, blocksize);
+    }
+
+    template<typename DstSpace, typename SrcSpace, typename ValueType, typename ArrayLayout>
+    inline 
+    BlockTridiagMatrices<DstSpace,ValueType,ArrayLayout>
+    create_mirror(const BlockTridiagMatrices<SrcSpace,ValueType,ArrayLayout> src) {
+      return BlockTridiagMatrices<DstSpace,ValueType,ArrayLayout>
+        (src.NumTridiagMatrices(),
+         src.NumRows(),
+         src.BlockSize(),
+         Kokkos::create_mirror_view(typename DstSpace::memory_space(), src.A()),
+         Kokkos::create_mirror_view(typename DstSpace::memory_space(), src.B()),
+         Kokkos::create_mirror_view(typename DstSpace::memory_space(), src.C()));
+    }
+    
+    template<typename DstSpace, typename SrcSpace, typename ValueType, typename ArrayLayout>
+    inline 
+    void
+    deep_copy(const BlockTridiagMatrices<DstSpace,ValueType,ArrayLayout> dst, 
+              const BlockTridiagMatrices<SrcSpace,ValueType,ArrayLayout> src) {
+      Kokkos::deep_copy(dst.A(), src.A());
+      Kokkos::deep_copy(dst.B(), src.B());
+      Kokkos::deep_copy(dst.C(), src.C());
+    }
+
+    ///
+    /// Partitioned block multivector
+    /// =============================
+    ///
+    /// Right hand sides (or solutions) matching BlockTridiagMatrices;
+    /// Values()(t,j,i,:) is block row i of vector j of the t-th partition.
+    ///
+    template <typename ExecSpace, typename ValueType, typename ArrayLayout>
+    class PartitionedBlockMultiVector {
+    public:
+      typedef ExecSpace exec_space;
+      typedef ValueType value_type;
+      typedef ArrayLayout array_layout;
+
+      typedef Kokkos::View<value_type****,array_layout,exec_space> value_array_type;
+
+    private:
+      value_array_type _values;
+
+    public:
+      PartitionedBlockMultiVector(const int nparts,
+                                  const int nvectors,
+                                  const int nrows,
+                                  const int blocksize)
+        : _values("BlockMultiVector::_values", nparts, nvectors, nrows, blocksize) {}
+
+      PartitionedBlockMultiVector(const value_array_type values) 
+        : _values(values) {}
+      
+      int NumPartitions() const { return _values.extent(0); }
+      int NumVectors() const { return _values.extent(1); }      
+      int NumRows() const { return _values.extent(2); }
+      int BlockSize() const { return _values.extent(3); }
+
+      value_array_type Values() const { return _values; }
+    };
+
+    template<typename ExecSpace, typename ValueType, typename ArrayLayout>
+    PartitionedBlockMultiVector<ExecSpace,ValueType,ArrayLayout> 
+    create_partitioned_block_multi_vector(const int nparts,
+                                          const int nvectors,
+                                          const int nrows,
+                                          const int blocksize) {
+      return PartitionedBlockMultiVector
+        <ExecSpace,ValueType,ArrayLayout>(adjustDimension<ValueType>(nparts), 
+                                          nvectors,
+                                          nrows, 
+                                          blocksize);
+    }
+    
+    template<typename DstSpace, typename SrcSpace, typename ValueType, typename ArrayLayout>
+    inline 
+    PartitionedBlockMultiVector<DstSpace,ValueType,ArrayLayout>
+    create_mirror(const PartitionedBlockMultiVector<SrcSpace,ValueType,ArrayLayout> src) {
+      return PartitionedBlockMultiVector<DstSpace,ValueType,ArrayLayout>
+        (Kokkos::create_mirror_view(typename DstSpace::memory_space(), src.Values()));
+    }
+    
+    template<typename DstSpace, typename SrcSpace, typename ValueType, typename ArrayLayout>
+    inline 
+    void
+    deep_copy(const PartitionedBlockMultiVector<DstSpace,ValueType,ArrayLayout> dst, 
+              const PartitionedBlockMultiVector<SrcSpace,ValueType,ArrayLayout> src) {
+      Kokkos::deep_copy(dst.Values(), src.Values());
+    }
+
+    ///
+    /// Serial BlockTridiag
+    /// ===================
+    ///
+    /// Factorize and solve a single (packed) block tridiagonal matrix.
+    /// A, B, C are rank 3 views (nrows or nrows-1, blocksize, blocksize) and
+    /// x, b are rank 3 views (nvectors, nrows, blocksize). 
+    /// Factorization is done in place; A holds LU factors of the Schur 
+    /// complements, B holds L^{-1} B and C holds C U^{-1}.
+    ///
+
+    template<typename ArgAlgoLU,
+             typename ArgAlgoTrsm,
+             typename ArgAlgoGemm>
+    struct SerialBlockTridiagFactorize {
+      template<typename AViewType,
+               typename BViewType,
+               typename CViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A,
+             const BViewType &B,
+             const CViewType &C,
+             const typename MagnitudeScalarType<typename AViewType::non_const_value_type>::type tiny = 0);
+    };
+
+    template<typename ArgAlgoTrsv,
+             typename ArgAlgoGemv>
+    struct SerialBlockTridiagSolve {
+      template<typename AViewType,
+               typename BViewType,
+               typename CViewType,
+               typename xViewType,
+               typename bViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A,
+             const BViewType &B,
+             const CViewType &C,
+             const xViewType &x,
+             const bViewType &b);
+    };
+
+    ///
+    /// BlockTridiag 
+    /// ============
+    ///
+    /// Device level interface over all packs of BlockTridiagMatrices.
+    /// x and b may be the same multivector.
+    ///
+
+    template<typename ArgAlgoLU,
+             typename ArgAlgoTrsm,
+             typename ArgAlgoGemm>
+    struct BlockTridiagFactorize {
+      template<typename ExecSpace,
+               typename ValueType,
+               typename ArrayLayout>
+      static int
+      invoke(const BlockTridiagMatrices<ExecSpace,ValueType,ArrayLayout> &T,
+             const typename MagnitudeScalarType<ValueType>::type tiny = 0);
+    };
+
+    template<typename ArgAlgoTrsv,
+             typename ArgAlgoGemv>
+    struct BlockTridiagSolve {
+      template<typename ExecSpace,
+               typename ValueType,
+               typename ArrayLayout>
+      static int
+      invoke(const BlockTridiagMatrices<ExecSpace,ValueType,ArrayLayout> &T,
+             const PartitionedBlockMultiVector<ExecSpace,ValueType,ArrayLayout> &x,
+             const PartitionedBlockMultiVector<ExecSpace,ValueType,ArrayLayout> &b);
+    };
+
+  }
+}
+
+#endif
@@ -0,0 +1,313 @@
+#ifndef __KOKKOSBATCHED_BLOCKTRIDIAG_SERIAL_IMPL_HPP__
+#define __KOKKOSBATCHED_BLOCKTRIDIAG_SERIAL_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include <sstream>
+
+#include "KokkosBatched_Util.hpp"
+
+#include "KokkosBatched_Copy_Decl.hpp"
+#include "KokkosBatched_Copy_Impl.hpp"
+
+#include "KokkosBatched_Gemv_Decl.hpp"
+#include "KokkosBatched_Gemv_Serial_Impl.hpp"
+
+#include "KokkosBatched_Trsv_Decl.hpp"
+#include "KokkosBatched_Trsv_Serial_Impl.hpp"
+
+#include "KokkosBatched_Gemm_Decl.hpp"
+#include "KokkosBatched_Gemm_Serial_Impl.hpp"
+
+#include "KokkosBatched_Trsm_Decl.hpp"
+#include "KokkosBatched_Trsm_Serial_Impl.hpp"
+
+#include "KokkosBatched_LU_Decl.hpp"
+#include "KokkosBatched_LU_Serial_Impl.hpp"
+
+#include "KokkosBatched_BlockTridiag_Decl.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Impl
+    /// ===========
+
+    ///
+    /// SerialBlockTridiagFactorize
+    ///
+
+    template<typename ArgAlgoLU,
+             typename ArgAlgoTrsm,
+             typename ArgAlgoGemm>
+    template<typename AViewType,
+             typename BViewType,
+             typename CViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialBlockTridiagFactorize<ArgAlgoLU,ArgAlgoTrsm,ArgAlgoGemm>::
+    invoke(const AViewType &A,
+           const BViewType &B,
+           const CViewType &C,
+           const typename MagnitudeScalarType<typename AViewType::non_const_value_type>::type tiny) {
+      const int m = A.extent(0);
+      if (m <= 0) return 0;
+
+      auto AA = Kokkos::subview(A, 0, Kokkos::ALL(), Kokkos::ALL());
+      auto BB = Kokkos::subview(B, 0, Kokkos::ALL(), Kokkos::ALL());
+      auto CC = Kokkos::subview(C, 0, Kokkos::ALL(), Kokkos::ALL());
+      auto DD = AA;
+
+      const int kend = m - 1;
+      for (int k=0;k<kend;++k) {
+        AA.assign_data( &A(k  ,0,0) );
+        BB.assign_data( &B(k  ,0,0) );
+        CC.assign_data( &C(k  ,0,0) );
+        DD.assign_data( &A(k+1,0,0) );
+
+        SerialLU<ArgAlgoLU>
+          ::invoke(AA, tiny);
+        SerialTrsm<Side::Left,Uplo::Lower,Trans::NoTranspose,Diag::Unit,ArgAlgoTrsm>
+          ::invoke(1.0, AA, BB);
+        SerialTrsm<Side::Right,Uplo::Upper,Trans::NoTranspose,Diag::NonUnit,ArgAlgoTrsm>
+          ::invoke(1.0, AA, CC);
+        SerialGemm<Trans::NoTranspose,Trans::NoTranspose,ArgAlgoGemm>
+          ::invoke(-1.0, CC, BB, 1.0, DD);
+      }
+      AA.assign_data( &A(kend,0,0) );
+      SerialLU<ArgAlgoLU>
+        ::invoke(AA, tiny);
+
+      return 0;
+    }
+
+    ///
+    /// SerialBlockTridiagSolve
+    ///
+
+    template<typename ArgAlgoTrsv,
+             typename ArgAlgoGemv>
+    template<typename AViewType,
+             typename BViewType,
+             typename CViewType,
+             typename xViewType,
+             typename bViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialBlockTridiagSolve<ArgAlgoTrsv,ArgAlgoGemv>::
+    invoke(const AViewType &A,
+           const BViewType &B,
+           const CViewType &C,
+           const xViewType &X,
+           const bViewType &Bv) {
+      const int m = A.extent(0), nvectors = X.extent(0);
+      if (m <= 0 || nvectors <= 0) return 0;
+
+      // subview patterns
+      auto A_0_all_all = Kokkos::subview(A, 0, Kokkos::ALL(), Kokkos::ALL());
+      auto B_0_all_all = Kokkos::subview(B, 0, Kokkos::ALL(), Kokkos::ALL());
+      auto C_0_all_all = Kokkos::subview(C, 0, Kokkos::ALL(), Kokkos::ALL());
+
+      auto x = Kokkos::subview(X,  0, Kokkos::ALL(), Kokkos::ALL());
+      auto b = Kokkos::subview(Bv, 0, Kokkos::ALL(), Kokkos::ALL());
+
+      auto xt = Kokkos::subview(x, 0, Kokkos::ALL());
+      auto xb = xt;
+
+      auto bt = Kokkos::subview(b, 0, Kokkos::ALL());
+      auto bb = bt;
+
+      ///
+      /// loop over multivectors
+      ///
+      for (int jvec=0;jvec<nvectors;++jvec) {
+        x.assign_data( &X (jvec,0,0) );
+        b.assign_data( &Bv(jvec,0,0) );
+
+        ///
+        /// forward substitution
+        ///
+        {
+          auto &LT = A_0_all_all; 
+          auto &LB = C_0_all_all; 
+
+          const bool is_same_x_and_b = (x.data() == b.data());
+          if (!is_same_x_and_b) {
+            xt.assign_data( &x(0,0) );
+            bt.assign_data( &b(0,0) );
+            SerialCopy<Trans::NoTranspose>::invoke(bt, xt);
+          }
+
+          const int kend = m - 1;
+          for (int k=0;k<kend;++k) {
+            LT.assign_data( &A(k,0,0) );
+            LB.assign_data( &C(k,0,0) );
+              
+            xt.assign_data( &x(k  ,0) );
+            xb.assign_data( &x(k+1,0) );
+
+            if (!is_same_x_and_b) {
+              bb.assign_data( &b(k+1,0) );
+              SerialCopy<Trans::NoTranspose>::invoke(bb, xb);
+            }
+              
+            SerialTrsv<Uplo::Lower,Trans::NoTranspose,Diag::Unit,ArgAlgoTrsv>
+              ::invoke(1.0, LT, xt);
+            SerialGemv<Trans::NoTranspose,ArgAlgoGemv>
+              ::invoke(-1.0, LB, xt, 1.0, xb);
+          }
+            
+          LT.assign_data( &A(kend,0,0) );
+          xt.assign_data( &x(kend,0) );
+          SerialTrsv<Uplo::Lower,Trans::NoTranspose,Diag::Unit,ArgAlgoTrsv>
+            ::invoke(1.0, LT, xt);
+        }
+
+        ///
+        /// backward substitution
+        ///
+        {
+          auto &UT = B_0_all_all;
+          auto &UB = A_0_all_all;
+
+          const int kbegin = m - 1;
+          for (int k=kbegin;k>0;--k) {
+            UT.assign_data( &B(k-1,0,0) );
+            UB.assign_data( &A(k  ,0,0) );
+              
+            xt.assign_data( &x(k-1,0) );
+            xb.assign_data( &x(k  ,0) );
+
+            SerialTrsv<Uplo::Upper,Trans::NoTranspose,Diag::NonUnit,ArgAlgoTrsv>
+              ::invoke(1.0, UB, xb);
+            SerialGemv<Trans::NoTranspose,ArgAlgoGemv>
+              ::invoke(-1.0, UT, xb, 1.0, xt);
+          }
+          UB.assign_data( &A(0,0,0) );
+          xt.assign_data( &x(0,0) );
+          SerialTrsv<Uplo::Upper,Trans::NoTranspose,Diag::NonUnit,ArgAlgoTrsv>
+            ::invoke(1.0, UB, xt);
+        }
+      }
+      return 0;
+    }
+
+    ///
+    /// Device level functors
+    /// =====================
+
+    template<typename ArgAlgoLU,
+             typename ArgAlgoTrsm,
+             typename ArgAlgoGemm,
+             typename ValueArrayType,
+             typename MagnitudeType>
+    struct Functor_BlockTridiagFactorize {
+      ValueArrayType _A, _B, _C;
+      MagnitudeType _tiny;
+
+      Functor_BlockTridiagFactorize(const ValueArrayType &A,
+                                    const ValueArrayType &B,
+                                    const ValueArrayType &C,
+                                    const MagnitudeType tiny)
+        : _A(A), _B(B), _C(C), _tiny(tiny) {}
+
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const int t) const {
+        SerialBlockTridiagFactorize<ArgAlgoLU,ArgAlgoTrsm,ArgAlgoGemm>
+          ::invoke(Kokkos::subview(_A, t, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()),
+                   Kokkos::subview(_B, t, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()),
+                   Kokkos::subview(_C, t, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()),
+                   _tiny);
+      }
+    };
+
+    template<typename ArgAlgoTrsv,
+             typename ArgAlgoGemv,
+             typename ValueArrayType>
+    struct Functor_BlockTridiagSolve {
+      ValueArrayType _A, _B, _C, _x, _b;
+
+      Functor_BlockTridiagSolve(const ValueArrayType &A,
+                                const ValueArrayType &B,
+                                const ValueArrayType &C,
+                                const ValueArrayType &x,
+                                const ValueArrayType &b)
+        : _A(A), _B(B), _C(C), _x(x), _b(b) {}
+
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const int t) const {
+        SerialBlockTridiagSolve<ArgAlgoTrsv,ArgAlgoGemv>
+          ::invoke(Kokkos::subview(_A, t, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()),
+                   Kokkos::subview(_B, t, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()),
+                   Kokkos::subview(_C, t, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()),
+                   Kokkos::subview(_x, t, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()),
+                   Kokkos::subview(_b, t, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL()));
+      }
+    };
+
+    ///
+    /// BlockTridiagFactorize
+    ///
+
+    template<typename ArgAlgoLU,
+             typename ArgAlgoTrsm,
+             typename ArgAlgoGemm>
+    template<typename ExecSpace,
+             typename ValueType,
+             typename ArrayLayout>
+    int
+    BlockTridiagFactorize<ArgAlgoLU,ArgAlgoTrsm,ArgAlgoGemm>::
+    invoke(const BlockTridiagMatrices<ExecSpace,ValueType,ArrayLayout> &T,
+           const typename MagnitudeScalarType<ValueType>::type tiny) {
+      typedef typename BlockTridiagMatrices<ExecSpace,ValueType,ArrayLayout>::value_array_type value_array_type;
+      typedef typename MagnitudeScalarType<ValueType>::type magnitude_type;
+      typedef Functor_BlockTridiagFactorize
+        <ArgAlgoLU,ArgAlgoTrsm,ArgAlgoGemm,value_array_type,magnitude_type> functor_type;
+
+      const Kokkos::RangePolicy<ExecSpace> policy(0, T.NumTridiagMatrices());
+      Kokkos::parallel_for("KokkosBatched::BlockTridiagFactorize", 
+                           policy, functor_type(T.A(), T.B(), T.C(), tiny));
+      return 0;
+    }
+
+    ///
+    /// BlockTridiagSolve
+    ///
+
+    template<typename ArgAlgoTrsv,
+             typename ArgAlgoGemv>
+    template<typename ExecSpace,
+             typename ValueType,
+             typename ArrayLayout>
+    int
+    BlockTridiagSolve<ArgAlgoTrsv,ArgAlgoGemv>::
+    invoke(const BlockTridiagMatrices<ExecSpace,ValueType,ArrayLayout> &T,
+           const PartitionedBlockMultiVector<ExecSpace,ValueType,ArrayLayout> &x,
+           const PartitionedBlockMultiVector<ExecSpace,ValueType,ArrayLayout> &b) {
+      typedef typename BlockTridiagMatrices<ExecSpace,ValueType,ArrayLayout>::value_array_type value_array_type;
+      typedef Functor_BlockTridiagSolve<ArgAlgoTrsv,ArgAlgoGemv,value_array_type> functor_type;
+
+      if (x.NumPartitions() < T.NumTridiagMatrices() ||
+          b.NumPartitions() < T.NumTridiagMatrices() ||
+          x.NumVectors() != b.NumVectors() ||
+          x.NumRows() != T.NumRows() || b.NumRows() != T.NumRows() ||
+          x.BlockSize() != T.BlockSize() || b.BlockSize() != T.BlockSize()) {
+        std::ostringstream os;
+        os << "KokkosBatched::BlockTridiagSolve: Dimensions do not match: "
+           << "T: " << T.NumTridiagMatrices() << " x " << T.NumRows() << " x " << T.BlockSize()
+           << ", x: " << x.NumPartitions() << " x " << x.NumVectors() << " x " << x.NumRows() << " x " << x.BlockSize()
+           << ", b: " << b.NumPartitions() << " x " << b.NumVectors() << " x " << b.NumRows() << " x " << b.BlockSize();
+        Kokkos::Impl::throw_runtime_exception(os.str());
+      }
+
+      const Kokkos::RangePolicy<ExecSpace> policy(0, T.NumTridiagMatrices());
+      Kokkos::parallel_for("KokkosBatched::BlockTridiagSolve", 
+                           policy, functor_type(T.A(), T.B(), T.C(), x.Values(), b.Values()));
+      return 0;
+    }
+
+  }
+}
+
+#endif
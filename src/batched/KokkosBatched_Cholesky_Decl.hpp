@@ -0,0 +1,44 @@
+#ifndef __KOKKOSBATCHED_CHOLESKY_DECL_HPP__
+#define __KOKKOSBATCHED_CHOLESKY_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Vector.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Cholesky factorization A = U^T U of a real symmetric positive
+    /// definite matrix. U overwrites the upper triangle of A; the strictly
+    /// lower triangle is not referenced as input but the blocked algorithm
+    /// may overwrite it. Returns p+1 when the p-th pivot is not positive in
+    /// some lane, otherwise 0.
+    ///
+    /// Solve A x = b with Trsv (or Trsm with Side::Left) on U using
+    /// Trans::Transpose followed by Trans::NoTranspose.
+    ///
+      
+    template<typename ArgAlgo>
+    struct SerialCholesky {
+      template<typename AViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A);
+    };       
+
+    template<typename MemberType,
+             typename ArgAlgo>
+    struct TeamCholesky {
+      template<typename AViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const AViewType &A);
+    };       
+      
+  }
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef __KOKKOSBATCHED_CHOLESKY_SERIAL_IMPL_HPP__
+#define __KOKKOSBATCHED_CHOLESKY_SERIAL_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Cholesky_Serial_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Impl
+    /// ===========
+
+    template<>
+    template<typename AViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialCholesky<Algo::Cholesky::Unblocked>::
+    invoke(const AViewType &A) {
+      return SerialCholeskyInternal<Algo::Cholesky::Unblocked>::invoke(A.extent(0),
+                                                                       A.data(), A.stride_0(), A.stride_1());
+    }
+    
+    template<>
+    template<typename AViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialCholesky<Algo::Cholesky::Blocked>::
+    invoke(const AViewType &A) {
+      return SerialCholeskyInternal<Algo::Cholesky::Blocked>::invoke(A.extent(0),
+                                                                     A.data(), A.stride_0(), A.stride_1());
+    }
+
+  }
+}
+
+#endif
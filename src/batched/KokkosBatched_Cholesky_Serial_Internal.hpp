@@ -0,0 +1,132 @@
+#ifndef __KOKKOSBATCHED_CHOLESKY_SERIAL_INTERNAL_HPP__
+#define __KOKKOSBATCHED_CHOLESKY_SERIAL_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+#include "KokkosBatched_InnerTrsm_Serial_Impl.hpp"
+#include "KokkosBatched_Gemm_Serial_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+  
+    ///
+    /// Serial Internal Impl
+    /// ====================
+
+    template<typename AlgoType>
+    struct SerialCholeskyInternal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int 
+      invoke(const int m,
+             ValueType *__restrict__ A, const int as0, const int as1);
+    };
+
+    template<>
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialCholeskyInternal<Algo::Cholesky::Unblocked>::
+    invoke(const int m,
+           ValueType *__restrict__ A, const int as0, const int as1) {
+      typedef VectorLane<ValueType> lane_type;
+      typedef typename lane_type::value_type value_type;
+      typedef Kokkos::Details::ArithTraits<value_type> ats;
+
+      if (m <= 0) return 0;
+
+      int r_val = 0;
+      for (int p=0;p<m;++p) {
+        const int jend = m-p-1;
+
+        ValueType
+          &alpha11 = A[p*as0+p*as1],
+          *__restrict__ a12t = A+(p  )*as0+(p+1)*as1,
+          *__restrict__ A22  = A+(p+1)*as0+(p+1)*as1;
+
+        // lane-wise square root of the pivot
+        for (int l=0;l<lane_type::vector_length;++l) {
+          value_type &a = lane_type::get(alpha11, l);
+          if (!(a > value_type(0)) && r_val == 0) r_val = p+1;
+          a = ats::sqrt(a);
+        }
+
+        for (int j=0;j<jend;++j)
+          a12t[j*as1] /= alpha11;
+
+        // upper triangle of A22 -= a12t^T a12t
+        for (int i=0;i<jend;++i) {
+          const ValueType a12t_i = a12t[i*as1];
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+          for (int j=i;j<jend;++j)
+            A22[i*as0+j*as1] -= a12t_i * a12t[j*as1];
+        }
+      }
+      return r_val;
+    }
+    
+    template<>
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialCholeskyInternal<Algo::Cholesky::Blocked>::
+    invoke(const int m,
+           ValueType *__restrict__ A, const int as0, const int as1) {
+      enum : int {
+        mbAlgo = Algo::Cholesky::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace>()
+      };
+      const typename MagnitudeScalarType<ValueType>::type one(1.0), minus_one(-1.0);
+
+      if (m <= 0) return 0;
+      
+      // U11^T X = A12 ; U11^T is lower triangular with transposed strides
+      InnerTrsmLeftLowerNonUnitDiag<mbAlgo> trsm_lln(as1, as0, as0, as1);
+
+      int r_val = 0;
+      const int mb = mbAlgo;
+      for (int p=0;p<m;p+=mb) {
+        const int pb = (p+mb) > m ? (m-p) : mb;
+
+        // diagonal block
+        ValueType *__restrict__ Ap = A+p*as0+p*as1;
+
+        // cholesky on a block
+        const int r = SerialCholeskyInternal<Algo::Cholesky::Unblocked>::invoke(pb, Ap, as0, as1);
+        if (r && r_val == 0) r_val = p+r;
+
+        // dimension ABR
+        const int n_abr = m-p-pb;
+        if (n_abr <= 0) break;
+
+        ValueType 
+          *__restrict__ A12 = Ap+pb*as1,
+          *__restrict__ A22 = Ap+pb*as0+pb*as1;
+
+        // trsm update
+        trsm_lln.serial_invoke(Ap, pb, n_abr, A12);
+
+        // syrk update on the upper block triangle of A22 
+        for (int j=0;j<n_abr;j+=mb) {
+          const int jb = (j+mb) > n_abr ? (n_abr-j) : mb;
+          SerialGemmInternal<Algo::Gemm::Blocked>::
+            invoke(j+jb, jb, pb,
+                   minus_one,
+                   A12,        as1, as0,
+                   A12+j*as1,  as0, as1,
+                   one,
+                   A22+j*as1,  as0, as1);
+        }
+      }
+      return r_val;
+    }
+
+  }
+}
+
+#endif
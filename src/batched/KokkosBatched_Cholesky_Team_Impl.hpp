@@ -0,0 +1,44 @@
+#ifndef __KOKKOSBATCHED_CHOLESKY_TEAM_IMPL_HPP__
+#define __KOKKOSBATCHED_CHOLESKY_TEAM_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Cholesky_Team_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Team Impl
+    /// =========
+    
+    template<typename MemberType>
+    struct TeamCholesky<MemberType,Algo::Cholesky::Unblocked> {
+      template<typename AViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, const AViewType &A) {
+        return TeamCholeskyInternal<Algo::Cholesky::Unblocked>::invoke(member,
+                                                                       A.extent(0),
+                                                                       A.data(), A.stride_0(), A.stride_1());
+      }
+    };
+    
+    template<typename MemberType>
+    struct TeamCholesky<MemberType,Algo::Cholesky::Blocked> {
+      template<typename AViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, const AViewType &A) {
+        return TeamCholeskyInternal<Algo::Cholesky::Blocked>::invoke(member,
+                                                                     A.extent(0),
+                                                                     A.data(), A.stride_0(), A.stride_1());
+      }
+    };
+
+  }
+}
+
+#endif
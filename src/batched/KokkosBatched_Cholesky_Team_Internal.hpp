@@ -0,0 +1,161 @@
+#ifndef __KOKKOSBATCHED_CHOLESKY_TEAM_INTERNAL_HPP__
+#define __KOKKOSBATCHED_CHOLESKY_TEAM_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+#include "KokkosBatched_InnerTrsm_Serial_Impl.hpp"
+#include "KokkosBatched_Gemm_Serial_Internal.hpp"
+#include "KokkosBatched_Cholesky_Serial_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+  
+    ///
+    /// Team Internal Impl
+    /// ==================
+
+    template<typename AlgoType>
+    struct TeamCholeskyInternal {
+      template<typename MemberType, typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int 
+      invoke(const MemberType &member,
+             const int m,
+             ValueType *__restrict__ A, const int as0, const int as1);
+    };
+
+    template<>
+    template<typename MemberType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamCholeskyInternal<Algo::Cholesky::Unblocked>::
+    invoke(const MemberType &member, 
+           const int m,
+           ValueType *__restrict__ A, const int as0, const int as1) {
+      typedef VectorLane<ValueType> lane_type;
+      typedef typename lane_type::value_type value_type;
+      typedef Kokkos::Details::ArithTraits<value_type> ats;
+
+      if (m <= 0) return 0;
+
+      int r_val = 0;
+      for (int p=0;p<m;++p) {
+        const int jend = m-p-1;
+
+        ValueType
+          &alpha11 = A[p*as0+p*as1],
+          *__restrict__ a12t = A+(p  )*as0+(p+1)*as1,
+          *__restrict__ A22  = A+(p+1)*as0+(p+1)*as1;
+
+        // every thread checks the same pivot
+        for (int l=0;l<lane_type::vector_length && r_val == 0;++l)
+          if (!(lane_type::get(alpha11, l) > value_type(0))) r_val = p+1;
+        member.team_barrier();
+
+        if (member.team_rank() == 0) 
+          for (int l=0;l<lane_type::vector_length;++l) {
+            value_type &a = lane_type::get(alpha11, l);
+            a = ats::sqrt(a);
+          }
+        member.team_barrier();
+
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,jend),[&](const int &j) {
+            a12t[j*as1] /= alpha11;
+          });
+        member.team_barrier();
+
+        // upper triangle of A22 -= a12t^T a12t
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,jend),[&](const int &i) {
+            const ValueType a12t_i = a12t[i*as1];
+            for (int j=i;j<jend;++j)
+              A22[i*as0+j*as1] -= a12t_i * a12t[j*as1];
+          });
+        member.team_barrier();
+      }
+      return r_val;
+    }
+    
+    template<>
+    template<typename MemberType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamCholeskyInternal<Algo::Cholesky::Blocked>::
+    invoke(const MemberType &member, 
+           const int m,
+           ValueType *__restrict__ A, const int as0, const int as1) {
+      typedef VectorLane<ValueType> lane_type;
+      typedef typename lane_type::value_type value_type;
+
+      enum : int {
+        mbAlgo = Algo::Cholesky::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace>()
+      };
+      const typename MagnitudeScalarType<ValueType>::type one(1.0), minus_one(-1.0);
+
+      if (m <= 0) return 0;
+
+      // U11^T X = A12 ; U11^T is lower triangular with transposed strides
+      InnerTrsmLeftLowerNonUnitDiag<mbAlgo> trsm_lln(as1, as0, as0, as1);
+
+      int r_val = 0;
+      const int mb = mbAlgo;
+      for (int p=0;p<m;p+=mb) {
+        const int pb = (p+mb) > m ? (m-p) : mb;
+
+        // diagonal block
+        ValueType *__restrict__ Ap = A+p*as0+p*as1;
+
+        // cholesky on a block; the return value is broadcast through the block
+        member.team_barrier();
+        if (member.team_rank() == 0)
+          SerialCholeskyInternal<Algo::Cholesky::Unblocked>::invoke(pb, Ap, as0, as1);
+        member.team_barrier();
+        // a failed pivot leaves a nan or zero after the square root
+        for (int q=0;q<pb && r_val == 0;++q) 
+          for (int l=0;l<lane_type::vector_length;++l) 
+            if (!(lane_type::get(Ap[q*as0+q*as1], l) > value_type(0))) { r_val = p+q+1; break; }
+
+        // dimension ABR
+        const int n_abr = m-p-pb;
+        if (n_abr <= 0) break;
+
+        ValueType 
+          *__restrict__ A12 = Ap+pb*as1,
+          *__restrict__ A22 = Ap+pb*as0+pb*as1;
+
+        const int nq_abr = (n_abr/mb) + (n_abr%mb > 0);
+
+        // trsm update; a thread takes a block of columns
+        Kokkos::parallel_for
+          (Kokkos::TeamThreadRange(member,0,nq_abr),
+           [&](const int &jj) {
+            const int j = jj*mb, jb = (j+mb) > n_abr ? (n_abr-j) : mb;
+            trsm_lln.serial_invoke(Ap, pb, jb, A12+j*as1);
+          });
+        member.team_barrier();
+
+        // syrk update on the upper block triangle of A22
+        Kokkos::parallel_for
+          (Kokkos::TeamThreadRange(member,0,nq_abr),
+           [&](const int &jj) {
+            const int j = jj*mb, jb = (j+mb) > n_abr ? (n_abr-j) : mb;
+            SerialGemmInternal<Algo::Gemm::Blocked>::
+              invoke(j+jb, jb, pb,
+                     minus_one,
+                     A12,        as1, as0,
+                     A12+j*as1,  as0, as1,
+                     one,
+                     A22+j*as1,  as0, as1);
+          });
+        member.team_barrier();
+      }
+      return r_val;
+    }
+  }
+}
+
+
+#endif
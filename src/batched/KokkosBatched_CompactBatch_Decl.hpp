@@ -0,0 +1,132 @@
+#ifndef __KOKKOSBATCHED_COMPACTBATCH_DECL_HPP__
+#define __KOKKOSBATCHED_COMPACTBATCH_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "Kokkos_Core.hpp"
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Compact batch
+    /// =============
+    ///
+    /// A batch of nmatrices (m x n) scalar matrices stored interleaved by
+    /// the vector length of ValueType, i.e., Values()(p,i,j)[l] is entry
+    /// (i,j) of matrix p*vector_length+l. Batched kernels are invoked on
+    /// Kokkos::subview(Values(), p, Kokkos::ALL(), Kokkos::ALL()).
+    ///
+    /// When nmatrices is not a multiple of the vector length, the unused
+    /// lanes of the last pack are filled with the identity by pack so that
+    /// factorizations stay well defined there; unpack ignores them.
+    ///
+    template <typename ExecSpace, typename ValueType>
+    class CompactBatch {
+    public:
+      typedef ExecSpace exec_space;
+      typedef ValueType value_type;
+      typedef typename ValueType::value_type scalar_type;
+
+      enum : int { vector_length = ValueType::vector_length };
+
+      typedef Kokkos::View<value_type***,Kokkos::LayoutRight,exec_space> value_array_type;
+
+      static_assert(is_vector<ValueType>::value, "CompactBatch: ValueType must be a Vector<SIMD<T>,l> type");
+
+    private:
+      int _nmatrices;
+      value_array_type _values;
+
+    public:
+      CompactBatch(const int nmatrices,
+                   const int m,
+                   const int n)
+        : _nmatrices(nmatrices),
+          _values("CompactBatch::_values",
+                  nmatrices/vector_length + (nmatrices%vector_length > 0), m, n) {}
+
+      CompactBatch(const int nmatrices,
+                   const value_array_type values)
+        : _nmatrices(nmatrices),
+          _values(values) {}
+
+      value_array_type Values() const { return _values; }
+
+      int NumMatrices() const { return _nmatrices; }
+      int NumPacks() const { return _values.extent(0); }
+      int NumRows() const { return _values.extent(1); }
+      int NumCols() const { return _values.extent(2); }
+
+      /// number of valid lanes in pack p
+      int NumLanes(const int p) const {
+        const int r = _nmatrices - p*vector_length;
+        return (r < vector_length ? r : vector_length);
+      }
+    };
+
+    template<typename ExecSpace, typename ValueType>
+    CompactBatch<ExecSpace,ValueType>
+    create_compact_batch(const int nmatrices,
+                         const int m,
+                         const int n) {
+      return CompactBatch<ExecSpace,ValueType>(nmatrices, m, n);
+    }
+
+    template<typename DstSpace, typename SrcSpace, typename ValueType>
+    inline
+    CompactBatch<DstSpace,ValueType>
+    create_mirror(const CompactBatch<SrcSpace,ValueType> src) {
+      return CompactBatch<DstSpace,ValueType>
+        (src.NumMatrices(),
+         Kokkos::create_mirror_view(typename DstSpace::memory_space(), src.Values()));
+    }
+
+    template<typename DstSpace, typename SrcSpace, typename ValueType>
+    inline
+    void
+    deep_copy(const CompactBatch<DstSpace,ValueType> dst,
+              const CompactBatch<SrcSpace,ValueType> src) {
+      Kokkos::deep_copy(dst.Values(), src.Values());
+    }
+
+    ///
+    /// Pack/unpack between a rank 3 scalar view A(nmatrices, m, n), in any
+    /// layout and in the same space, and the compact batch.
+    ///
+
+    template<typename ExecSpace, typename ValueType, typename ScalarViewType>
+    void
+    pack_compact_batch(const CompactBatch<ExecSpace,ValueType> &dst,
+                       const ScalarViewType &src);
+
+    template<typename ScalarViewType, typename ExecSpace, typename ValueType>
+    void
+    unpack_compact_batch(const ScalarViewType &dst,
+                         const CompactBatch<ExecSpace,ValueType> &src);
+
+    ///
+    /// Same as above, but enqueued on the given execution space instance
+    /// without fencing, e.g., on a stream of a streamed batch.
+    ///
+
+    template<typename ExecSpace, typename ValueType, typename ScalarViewType>
+    void
+    pack_compact_batch(const typename ExecSpace::execution_space &space,
+                       const CompactBatch<ExecSpace,ValueType> &dst,
+                       const ScalarViewType &src);
+
+    template<typename ScalarViewType, typename ExecSpace, typename ValueType>
+    void
+    unpack_compact_batch(const typename ExecSpace::execution_space &space,
+                         const ScalarViewType &dst,
+                         const CompactBatch<ExecSpace,ValueType> &src);
+
+  }
+}
+
+#endif
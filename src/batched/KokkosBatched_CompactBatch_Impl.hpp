@@ -0,0 +1,254 @@
+#ifndef __KOKKOSBATCHED_COMPACTBATCH_IMPL_HPP__
+#define __KOKKOSBATCHED_COMPACTBATCH_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include <sstream>
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_CompactBatch_Decl.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Device level functors
+    /// =====================
+    ///
+    /// The range policy operator handles one row of a pack per thread; when
+    /// a pack is full and the scalar view is strided by one in the batch
+    /// index (LayoutLeft), the lanes are contiguous and a row is moved with
+    /// unaligned vector loads/stores, otherwise lanes are gathered.
+    ///
+    /// The team policy operator handles one pack per team; the loop over
+    /// the contiguous index is mapped to the vector lanes so that global
+    /// memory accesses coalesce for either layout.
+    ///
+
+    template<typename VectorViewType,
+             typename ScalarViewType>
+    struct Functor_PackCompactBatch {
+      typedef typename VectorViewType::non_const_value_type value_type;
+      typedef typename value_type::value_type scalar_type;
+      enum : int { vector_length = value_type::vector_length };
+
+      VectorViewType _v;
+      ScalarViewType _s;
+      int _nmatrices, _m, _n;
+
+      Functor_PackCompactBatch(const VectorViewType &v,
+                               const ScalarViewType &s,
+                               const int nmatrices)
+        : _v(v), _s(s), _nmatrices(nmatrices), _m(v.extent(1)), _n(v.extent(2)) {}
+
+      KOKKOS_INLINE_FUNCTION
+      scalar_type padding(const int i, const int j) const {
+        return (i == j ? scalar_type(1) : scalar_type(0));
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const int idx) const {
+        const int p = idx/_m, i = idx%_m, k0 = p*vector_length;
+        const int r = _nmatrices - k0, nl = (r < vector_length ? r : int(vector_length));
+        if (nl == vector_length && _s.stride_0() == 1) {
+          for (int j=0;j<_n;++j)
+            _v(p,i,j).loadUnaligned(&_s(k0,i,j));
+        } else {
+          for (int j=0;j<_n;++j) {
+            auto &v = _v(p,i,j);
+            for (int l=0;l<nl;++l)
+              v[l] = _s(k0+l,i,j);
+            for (int l=nl;l<vector_length;++l)
+              v[l] = padding(i,j);
+          }
+        }
+      }
+
+      template<typename MemberType>
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const MemberType &member) const {
+        const int p = member.league_rank(), k0 = p*vector_length, mn = _m*_n;
+        const int r = _nmatrices - k0, nl = (r < vector_length ? r : int(vector_length));
+        if (_s.stride_0() == 1) {
+          Kokkos::parallel_for
+            (Kokkos::TeamThreadRange(member, mn), [&](const int &ij) {
+              const int i = ij/_n, j = ij%_n;
+              Kokkos::parallel_for
+                (Kokkos::ThreadVectorRange(member, int(vector_length)), [&](const int &l) {
+                  _v(p,i,j)[l] = (l < nl ? _s(k0+l,i,j) : padding(i,j));
+                });
+            });
+        } else {
+          Kokkos::parallel_for
+            (Kokkos::TeamThreadRange(member, int(vector_length)), [&](const int &l) {
+              Kokkos::parallel_for
+                (Kokkos::ThreadVectorRange(member, mn), [&](const int &ij) {
+                  const int i = ij/_n, j = ij%_n;
+                  _v(p,i,j)[l] = (l < nl ? _s(k0+l,i,j) : padding(i,j));
+                });
+            });
+        }
+      }
+    };
+
+    template<typename ScalarViewType,
+             typename VectorViewType>
+    struct Functor_UnpackCompactBatch {
+      typedef typename VectorViewType::non_const_value_type value_type;
+      enum : int { vector_length = value_type::vector_length };
+
+      ScalarViewType _s;
+      VectorViewType _v;
+      int _nmatrices, _m, _n;
+
+      Functor_UnpackCompactBatch(const ScalarViewType &s,
+                                 const VectorViewType &v,
+                                 const int nmatrices)
+        : _s(s), _v(v), _nmatrices(nmatrices), _m(v.extent(1)), _n(v.extent(2)) {}
+
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const int idx) const {
+        const int p = idx/_m, i = idx%_m, k0 = p*vector_length;
+        const int r = _nmatrices - k0, nl = (r < vector_length ? r : int(vector_length));
+        if (nl == vector_length && _s.stride_0() == 1) {
+          for (int j=0;j<_n;++j)
+            _v(p,i,j).storeUnaligned(&_s(k0,i,j));
+        } else {
+          for (int j=0;j<_n;++j) {
+            const auto &v = _v(p,i,j);
+            for (int l=0;l<nl;++l)
+              _s(k0+l,i,j) = v[l];
+          }
+        }
+      }
+
+      template<typename MemberType>
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const MemberType &member) const {
+        const int p = member.league_rank(), k0 = p*vector_length, mn = _m*_n;
+        const int r = _nmatrices - k0, nl = (r < vector_length ? r : int(vector_length));
+        if (_s.stride_0() == 1) {
+          Kokkos::parallel_for
+            (Kokkos::TeamThreadRange(member, mn), [&](const int &ij) {
+              const int i = ij/_n, j = ij%_n;
+              Kokkos::parallel_for
+                (Kokkos::ThreadVectorRange(member, nl), [&](const int &l) {
+                  _s(k0+l,i,j) = _v(p,i,j)[l];
+                });
+            });
+        } else {
+          Kokkos::parallel_for
+            (Kokkos::TeamThreadRange(member, nl), [&](const int &l) {
+              Kokkos::parallel_for
+                (Kokkos::ThreadVectorRange(member, mn), [&](const int &ij) {
+                  const int i = ij/_n, j = ij%_n;
+                  _s(k0+l,i,j) = _v(p,i,j)[l];
+                });
+            });
+        }
+      }
+    };
+
+    template<typename ExecSpace, typename ValueType, typename ScalarViewType>
+    inline
+    void
+    check_compact_batch_dimensions(const char *label,
+                                   const CompactBatch<ExecSpace,ValueType> &c,
+                                   const ScalarViewType &s) {
+      if (int(s.extent(0)) != c.NumMatrices() ||
+          int(s.extent(1)) != c.NumRows() ||
+          int(s.extent(2)) != c.NumCols()) {
+        std::ostringstream os;
+        os << label << ": Dimensions do not match: "
+           << "compact batch: " << c.NumMatrices() << " x " << c.NumRows() << " x " << c.NumCols()
+           << ", view: " << s.extent(0) << " x " << s.extent(1) << " x " << s.extent(2);
+        Kokkos::Impl::throw_runtime_exception(os.str());
+      }
+    }
+
+    template<typename ExecSpace, typename Functor, int VectorLength>
+    inline
+    void
+    run_compact_batch_functor(const char *label,
+                              const typename ExecSpace::execution_space &space,
+                              const int npacks,
+                              const int m,
+                              const Functor &functor) {
+      if (npacks <= 0 || m <= 0) return;
+#if defined(KOKKOS_ENABLE_CUDA)
+      if (std::is_same<typename ExecSpace::execution_space,Kokkos::Cuda>::value) {
+        const int vector_size = ((VectorLength <= 32 && (VectorLength & (VectorLength-1)) == 0) ? VectorLength : 1);
+        const Kokkos::TeamPolicy<ExecSpace> policy(space, npacks, Kokkos::AUTO, vector_size);
+        Kokkos::parallel_for(label, policy, functor);
+        return;
+      }
+#endif
+      const Kokkos::RangePolicy<ExecSpace> policy(space, 0, npacks*m);
+      Kokkos::parallel_for(label, policy, functor);
+    }
+
+    template<typename ExecSpace, typename Functor, int VectorLength>
+    inline
+    void
+    run_compact_batch_functor(const char *label,
+                              const int npacks,
+                              const int m,
+                              const Functor &functor) {
+      run_compact_batch_functor<ExecSpace,Functor,VectorLength>
+        (label, typename ExecSpace::execution_space(), npacks, m, functor);
+    }
+
+    ///
+    /// pack_compact_batch
+    ///
+
+    template<typename ExecSpace, typename ValueType, typename ScalarViewType>
+    void
+    pack_compact_batch(const typename ExecSpace::execution_space &space,
+                       const CompactBatch<ExecSpace,ValueType> &dst,
+                       const ScalarViewType &src) {
+      typedef typename CompactBatch<ExecSpace,ValueType>::value_array_type value_array_type;
+      typedef Functor_PackCompactBatch<value_array_type,ScalarViewType> functor_type;
+
+      check_compact_batch_dimensions("KokkosBatched::pack_compact_batch", dst, src);
+      run_compact_batch_functor<ExecSpace,functor_type,ValueType::vector_length>
+        ("KokkosBatched::pack_compact_batch", space, dst.NumPacks(), dst.NumRows(),
+         functor_type(dst.Values(), src, dst.NumMatrices()));
+    }
+
+    template<typename ExecSpace, typename ValueType, typename ScalarViewType>
+    void
+    pack_compact_batch(const CompactBatch<ExecSpace,ValueType> &dst,
+                       const ScalarViewType &src) {
+      pack_compact_batch(typename ExecSpace::execution_space(), dst, src);
+    }
+
+    ///
+    /// unpack_compact_batch
+    ///
+
+    template<typename ScalarViewType, typename ExecSpace, typename ValueType>
+    void
+    unpack_compact_batch(const typename ExecSpace::execution_space &space,
+                         const ScalarViewType &dst,
+                         const CompactBatch<ExecSpace,ValueType> &src) {
+      typedef typename CompactBatch<ExecSpace,ValueType>::value_array_type value_array_type;
+      typedef Functor_UnpackCompactBatch<ScalarViewType,value_array_type> functor_type;
+
+      check_compact_batch_dimensions("KokkosBatched::unpack_compact_batch", src, dst);
+      run_compact_batch_functor<ExecSpace,functor_type,ValueType::vector_length>
+        ("KokkosBatched::unpack_compact_batch", space, src.NumPacks(), src.NumRows(),
+         functor_type(dst, src.Values(), src.NumMatrices()));
+    }
+
+    template<typename ScalarViewType, typename ExecSpace, typename ValueType>
+    void
+    unpack_compact_batch(const ScalarViewType &dst,
+                         const CompactBatch<ExecSpace,ValueType> &src) {
+      unpack_compact_batch(typename ExecSpace::execution_space(), dst, src);
+    }
+
+  }
+}
+
+#endif
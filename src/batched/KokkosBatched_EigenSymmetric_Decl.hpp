@@ -0,0 +1,50 @@
+#ifndef __KOKKOSBATCHED_EIGEN_SYMMETRIC_DECL_HPP__
+#define __KOKKOSBATCHED_EIGEN_SYMMETRIC_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Vector.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Serial EigenSymmetric
+    ///
+    /// A = V diag(e) V^T for a real symmetric A (m x m); eigenvalues e are
+    /// in ascending order and the columns of V are the eigenvectors. With
+    /// Vector<SIMD<T>,l> all lanes are diagonalized in lockstep and each
+    /// lane is sorted independently. A is overwritten.
+    ///
+    /// Algo::EigenSymmetric::Jacobi : any m; returns 1 when some lane has
+    ///   not converged within the maximum number of sweeps, otherwise 0.
+    /// Algo::EigenSymmetric::Analytic : closed form eigenvalues for m = 3
+    ///   (returns -1 for other sizes), A is left unchanged; eigenvectors
+    ///   are computed with Jacobi when V is given.
+    ///
+
+    template<typename ArgAlgo>
+    struct SerialEigenSymmetric {
+      template<typename AViewType,
+               typename EViewType,
+               typename VViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A,
+             const EViewType &e,
+             const VViewType &V);
+
+      // eigenvalues only
+      template<typename AViewType,
+               typename EViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A,
+             const EViewType &e);
+    };
+
+  }
+}
+
+#endif
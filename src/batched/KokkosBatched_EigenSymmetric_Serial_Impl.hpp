@@ -0,0 +1,95 @@
+#ifndef __KOKKOSBATCHED_EIGEN_SYMMETRIC_SERIAL_IMPL_HPP__
+#define __KOKKOSBATCHED_EIGEN_SYMMETRIC_SERIAL_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_EigenSymmetric_Serial_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Impl
+    /// ===========
+
+    ///
+    /// Jacobi
+    ///
+
+    template<>
+    template<typename AViewType,
+             typename EViewType,
+             typename VViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialEigenSymmetric<Algo::EigenSymmetric::Jacobi>::
+    invoke(const AViewType &A,
+           const EViewType &e,
+           const VViewType &V) {
+      return SerialEigenSymmetricInternal<Algo::EigenSymmetric::Jacobi>::
+        invoke(A.extent(0),
+               A.data(), A.stride_0(), A.stride_1(),
+               e.data(), e.stride_0(),
+               V.data(), V.stride_0(), V.stride_1());
+    }
+
+    template<>
+    template<typename AViewType,
+             typename EViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialEigenSymmetric<Algo::EigenSymmetric::Jacobi>::
+    invoke(const AViewType &A,
+           const EViewType &e) {
+      typedef typename AViewType::non_const_value_type value_type;
+      return SerialEigenSymmetricInternal<Algo::EigenSymmetric::Jacobi>::
+        invoke(A.extent(0),
+               A.data(), A.stride_0(), A.stride_1(),
+               e.data(), e.stride_0(),
+               (value_type*)NULL, 0, 0);
+    }
+
+    ///
+    /// Analytic
+    ///
+
+    template<>
+    template<typename AViewType,
+             typename EViewType,
+             typename VViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialEigenSymmetric<Algo::EigenSymmetric::Analytic>::
+    invoke(const AViewType &A,
+           const EViewType &e,
+           const VViewType &V) {
+      if (A.extent(0) != 3) return -1;
+      return SerialEigenSymmetricInternal<Algo::EigenSymmetric::Jacobi>::
+        invoke(A.extent(0),
+               A.data(), A.stride_0(), A.stride_1(),
+               e.data(), e.stride_0(),
+               V.data(), V.stride_0(), V.stride_1());
+    }
+
+    template<>
+    template<typename AViewType,
+             typename EViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialEigenSymmetric<Algo::EigenSymmetric::Analytic>::
+    invoke(const AViewType &A,
+           const EViewType &e) {
+      typedef typename AViewType::non_const_value_type value_type;
+      return SerialEigenSymmetricInternal<Algo::EigenSymmetric::Analytic>::
+        invoke(A.extent(0),
+               A.data(), A.stride_0(), A.stride_1(),
+               e.data(), e.stride_0(),
+               (value_type*)NULL, 0, 0);
+    }
+
+  }
+}
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef __KOKKOSBATCHED_EIGEN_SYMMETRIC_SERIAL_INTERNAL_HPP__
+#define __KOKKOSBATCHED_EIGEN_SYMMETRIC_SERIAL_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Serial Internal Impl
+    /// ==================== 
+
+    ///
+    /// sort e ascending lane by lane and permute the columns of V alike
+    ///
+    struct SerialEigenSymmetricSortInternal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const int m,
+             /* */ ValueType *__restrict__ e, const int es,
+             /* */ ValueType *__restrict__ V, const int vs0, const int vs1) {
+        typedef VectorLane<ValueType> lane_type;
+        typedef typename lane_type::value_type value_type;
+
+        for (int l=0;l<lane_type::vector_length;++l) 
+          for (int i=0;i<m;++i) {
+            int jmin = i;
+            for (int j=i+1;j<m;++j) 
+              if (lane_type::get(e[j*es], l) < lane_type::get(e[jmin*es], l)) jmin = j;
+            if (jmin != i) {
+              value_type 
+                &ei = lane_type::get(e[i   *es], l),
+                &ej = lane_type::get(e[jmin*es], l);
+              const value_type tmp = ei; ei = ej; ej = tmp;
+              if (V != NULL) 
+                for (int k=0;k<m;++k) {
+                  value_type 
+                    &vi = lane_type::get(V[k*vs0+i   *vs1], l),
+                    &vj = lane_type::get(V[k*vs0+jmin*vs1], l);
+                  const value_type tmpv = vi; vi = vj; vj = tmpv;
+                }
+            }
+          }
+        return 0;
+      }
+    };
+
+    template<typename AlgoType>
+    struct SerialEigenSymmetricInternal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const int m,
+             /* */ ValueType *__restrict__ A, const int as0, const int as1,
+             /* */ ValueType *__restrict__ e, const int es,
+             /* */ ValueType *__restrict__ V, const int vs0, const int vs1);
+    };
+
+    ///
+    /// cyclic Jacobi; the rotation J(p,q) zeroing a_pq is computed lane by 
+    /// lane and A := J^T A J, V := V J are applied to all lanes at once. 
+    /// Sweeps stop when off(A) <= eps^2 |A|_F^2 holds in every lane.
+    /// V is optional (NULL).
+    ///
+    template<>
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialEigenSymmetricInternal<Algo::EigenSymmetric::Jacobi>::
+    invoke(const int m,
+           /* */ ValueType *__restrict__ A, const int as0, const int as1,
+           /* */ ValueType *__restrict__ e, const int es,
+           /* */ ValueType *__restrict__ V, const int vs0, const int vs1) {
+      typedef VectorLane<ValueType> lane_type;
+      typedef typename lane_type::value_type value_type;
+      typedef Kokkos::Details::ArithTraits<value_type> ats;
+
+      if (m <= 0) return 0;
+
+      const int max_sweeps = 30;
+      const value_type zero(0), one(1), eps = ats::epsilon();
+
+      if (V != NULL) 
+        for (int i=0;i<m;++i) 
+          for (int j=0;j<m;++j) 
+            V[i*vs0+j*vs1] = (i == j ? one : zero);
+
+      ValueType norm(0);
+      for (int i=0;i<m;++i) 
+        for (int j=0;j<m;++j) 
+          norm += A[i*as0+j*as1]*A[i*as0+j*as1];
+
+      int r_val = 1;
+      for (int sweep=0;sweep<max_sweeps;++sweep) {
+        ValueType off(0);
+        for (int i=0;i<m;++i) 
+          for (int j=i+1;j<m;++j) 
+            off += A[i*as0+j*as1]*A[i*as0+j*as1];
+
+        bool converged = true;
+        for (int l=0;l<lane_type::vector_length;++l) 
+          converged &= (lane_type::get(off, l) <= eps*eps*lane_type::get(norm, l));
+        if (converged) { r_val = 0; break; }
+
+        for (int p=0;p<(m-1);++p) 
+          for (int q=p+1;q<m;++q) {
+            ValueType c, s;
+            for (int l=0;l<lane_type::vector_length;++l) {
+              const value_type 
+                a_pq = lane_type::get(A[p*as0+q*as1], l),
+                a_pp = lane_type::get(A[p*as0+p*as1], l),
+                a_qq = lane_type::get(A[q*as0+q*as1], l);
+              value_type &c_l = lane_type::get(c, l), &s_l = lane_type::get(s, l);
+              if (a_pq == zero) {
+                c_l = one; s_l = zero;
+              } else {
+                const value_type theta = (a_qq - a_pp)/(2*a_pq);
+                value_type t = one/(ats::abs(theta) + ats::sqrt(theta*theta + one));
+                if (theta < zero) t = -t;
+                c_l = one/ats::sqrt(t*t + one);
+                s_l = t*c_l;
+              }
+            }
+
+            // columns p and q
+            for (int k=0;k<m;++k) {
+              ValueType &a_kp = A[k*as0+p*as1], &a_kq = A[k*as0+q*as1];
+              const ValueType tmp = a_kp;
+              a_kp = c*tmp - s*a_kq;
+              a_kq = s*tmp + c*a_kq;
+            }
+            // rows p and q
+            for (int k=0;k<m;++k) {
+              ValueType &a_pk = A[p*as0+k*as1], &a_qk = A[q*as0+k*as1];
+              const ValueType tmp = a_pk;
+              a_pk = c*tmp - s*a_qk;
+              a_qk = s*tmp + c*a_qk;
+            }
+            if (V != NULL) 
+              for (int k=0;k<m;++k) {
+                ValueType &v_kp = V[k*vs0+p*vs1], &v_kq = V[k*vs0+q*vs1];
+                const ValueType tmp = v_kp;
+                v_kp = c*tmp - s*v_kq;
+                v_kq = s*tmp + c*v_kq;
+              }
+          }
+      }
+
+      for (int i=0;i<m;++i)
+        e[i*es] = A[i*as0+i*as1];
+      SerialEigenSymmetricSortInternal::invoke(m, e, es, V, vs0, vs1);
+
+      return r_val;
+    }
+
+    ///
+    /// trigonometric method for 3x3; with q = tr(A)/3, p = |A - q I|_F/sqrt(6)
+    /// and B = (A - q I)/p, the eigenvalues are q + 2p cos(phi + 2 pi k/3)
+    /// where phi = acos(det(B)/2)/3. V is not referenced.
+    ///
+    template<>
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialEigenSymmetricInternal<Algo::EigenSymmetric::Analytic>::
+    invoke(const int m,
+           /* */ ValueType *__restrict__ A, const int as0, const int as1,
+           /* */ ValueType *__restrict__ e, const int es,
+           /* */ ValueType *__restrict__ /* V */, const int /* vs0 */, const int /* vs1 */) {
+      typedef VectorLane<ValueType> lane_type;
+      typedef typename lane_type::value_type value_type;
+      typedef Kokkos::Details::ArithTraits<value_type> ats;
+
+      if (m != 3) return -1;
+
+      const value_type zero(0), one(1), two(2), three(3), six(6);
+      const value_type two_pi_over_three = two*ats::acos(-one)/three;
+
+      for (int l=0;l<lane_type::vector_length;++l) {
+        const value_type
+          a00 = lane_type::get(A[0*as0+0*as1], l),
+          a11 = lane_type::get(A[1*as0+1*as1], l),
+          a22 = lane_type::get(A[2*as0+2*as1], l),
+          a01 = lane_type::get(A[0*as0+1*as1], l),
+          a02 = lane_type::get(A[0*as0+2*as1], l),
+          a12 = lane_type::get(A[1*as0+2*as1], l);
+        value_type 
+          &e0 = lane_type::get(e[0*es], l),
+          &e1 = lane_type::get(e[1*es], l),
+          &e2 = lane_type::get(e[2*es], l);
+
+        const value_type p1 = a01*a01 + a02*a02 + a12*a12;
+        if (p1 == zero) {
+          // diagonal
+          e0 = a00; e1 = a11; e2 = a22;
+        } else {
+          const value_type 
+            q  = (a00 + a11 + a22)/three,
+            p2 = (a00-q)*(a00-q) + (a11-q)*(a11-q) + (a22-q)*(a22-q) + two*p1,
+            p  = ats::sqrt(p2/six), inv_p = one/p;
+          const value_type
+            b00 = (a00-q)*inv_p, b11 = (a11-q)*inv_p, b22 = (a22-q)*inv_p,
+            b01 = a01*inv_p, b02 = a02*inv_p, b12 = a12*inv_p;
+          value_type r = (b00*(b11*b22 - b12*b12) - 
+                          b01*(b01*b22 - b12*b02) + 
+                          b02*(b01*b12 - b11*b02))/two;
+          if (r < -one) r = -one;
+          if (r >  one) r =  one;
+          const value_type phi = ats::acos(r)/three;
+          e2 = q + two*p*ats::cos(phi);
+          e0 = q + two*p*ats::cos(phi + two_pi_over_three);
+          e1 = three*q - e0 - e2;
+        }
+      }
+      SerialEigenSymmetricSortInternal::invoke(m, e, es, (ValueType*)NULL, 0, 0);
+
+      return 0;
+    }
+
+  }
+}
+
+#endif
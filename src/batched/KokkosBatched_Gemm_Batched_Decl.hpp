@@ -0,0 +1,80 @@
+#ifndef __KOKKOSBATCHED_GEMM_BATCHED_DECL_HPP__
+#define __KOKKOSBATCHED_GEMM_BATCHED_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "Kokkos_Core.hpp"
+
+#include "KokkosBatched_Util.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Batched Gemm
+    /// ============
+    ///
+    /// C(l,:,:) = beta C(l,:,:) + alpha op(A(l,:,:)) op(B(l,:,:)) for all
+    /// l in [0, C.extent(0)), called from host on rank 3 views of scalars 
+    /// or of Vector<SIMD<T>,l> packs. The kernel (serial, team or team 
+    /// vector), the algorithm and the team policy are chosen from the 
+    /// execution space, the value type and the matrix size (BatchedGemmMode) 
+    /// so that users do not need to write a functor around SerialGemm or 
+    /// TeamGemm.
+    ///
+    /// When a vendor library is enabled and the batch is above the crossover
+    /// in KokkosBatched_Tuning.hpp, the batch is handed to it instead:
+    /// cublas<t>gemmStridedBatched on Cuda for float and double with each
+    /// matrix row major (stride_2 == 1), and the MKL compact Gemm on host
+    /// for Vector<SIMD<double>,l> packs with contiguous packs. Other cases 
+    /// fall back to the native kernels.
+    ///
+    /// When the views are not conformable, an exception is thrown.
+    ///
+
+    struct BatchedGemmMode {
+      enum : int { Serial = 0, TeamVector = 1, Team = 2, Vendor = 3 };
+
+      /// mode for the given largest dimension of a matrix and the batch size;
+      /// vendor_available tells whether a vendor library accepts the views
+      template<typename ExecSpace, typename ValueType>
+      static int select(const int mnk, const int nbatch, const bool vendor_available = false) {
+#if defined(KOKKOS_ENABLE_CUDA)
+        if (std::is_same<typename ExecSpace::execution_space,Kokkos::Cuda>::value) {
+          if (vendor_available &&
+              KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_SIZE_CUDA >= 0 &&
+              mnk >= KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_SIZE_CUDA &&
+              nbatch >= KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_BATCH_CUDA) return Vendor;
+          if (is_vector<ValueType>::value) return Serial;
+          return (mnk <= 8  ? Serial :
+                  mnk <= 32 ? TeamVector : Team);
+        }
+#endif
+        if (vendor_available &&
+            KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_SIZE_HOST >= 0 &&
+            mnk >= KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_SIZE_HOST &&
+            nbatch >= KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_BATCH_HOST) return Vendor;
+        return Serial;
+      }
+    };
+
+    template<typename ArgTransA,
+             typename ArgTransB>
+    struct BatchedGemm {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType,
+               typename CViewType>
+      static int
+      invoke(const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B,
+             const ScalarType beta,
+             const CViewType &C);
+    };
+
+  }
+}
+
+#endif
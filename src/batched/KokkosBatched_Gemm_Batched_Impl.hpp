@@ -0,0 +1,383 @@
+#ifndef __KOKKOSBATCHED_GEMM_BATCHED_IMPL_HPP__
+#define __KOKKOSBATCHED_GEMM_BATCHED_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include <sstream>
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_Gemm_Decl.hpp"
+#include "KokkosBatched_Gemm_Serial_Impl.hpp"
+#include "KokkosBatched_Gemm_Team_Impl.hpp"
+#include "KokkosBatched_Gemm_TeamVector_Impl.hpp"
+
+#include "KokkosBatched_Gemm_Batched_Decl.hpp"
+
+#if defined(__KOKKOSKERNELS_NVIDIA_CUBLAS__)
+#include "cublas_v2.h"
+#endif
+#if                                                     \
+  defined(__KOKKOSBATCHED_INTEL_MKL__) &&               \
+  defined(__KOKKOSBATCHED_INTEL_MKL_BATCHED__) &&       \
+  defined(__KOKKOSBATCHED_INTEL_MKL_COMPACT_BATCHED__)
+#include "mkl.h"
+#endif
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Device level functors
+    /// =====================
+
+    struct BatchedGemmTeamVectorTag {};
+    struct BatchedGemmTeamTag {};
+
+    template<typename ArgTransA,
+             typename ArgTransB,
+             typename ArgAlgo,
+             typename ScalarType,
+             typename AViewType,
+             typename BViewType,
+             typename CViewType>
+    struct Functor_BatchedGemm {
+      ScalarType _alpha, _beta;
+      AViewType _A;
+      BViewType _B;
+      CViewType _C;
+
+      Functor_BatchedGemm(const ScalarType alpha,
+                          const AViewType &A,
+                          const BViewType &B,
+                          const ScalarType beta,
+                          const CViewType &C)
+        : _alpha(alpha), _beta(beta), _A(A), _B(B), _C(C) {}
+
+      /// serial kernel per matrix
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const int l) const {
+        auto aa = Kokkos::subview(_A, l, Kokkos::ALL(), Kokkos::ALL());
+        auto bb = Kokkos::subview(_B, l, Kokkos::ALL(), Kokkos::ALL());
+        auto cc = Kokkos::subview(_C, l, Kokkos::ALL(), Kokkos::ALL());
+
+        SerialGemm<ArgTransA,ArgTransB,ArgAlgo>::
+          invoke(_alpha, aa, bb, _beta, cc);
+      }
+
+      /// one matrix per thread, its entries over the vector lanes
+      template<typename MemberType>
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const BatchedGemmTeamVectorTag &, const MemberType &member) const {
+        const int l = member.league_rank()*member.team_size() + member.team_rank();
+        if (l < int(_C.extent(0))) {
+          auto aa = Kokkos::subview(_A, l, Kokkos::ALL(), Kokkos::ALL());
+          auto bb = Kokkos::subview(_B, l, Kokkos::ALL(), Kokkos::ALL());
+          auto cc = Kokkos::subview(_C, l, Kokkos::ALL(), Kokkos::ALL());
+
+          TeamVectorGemm<MemberType,ArgTransA,ArgTransB,Algo::Gemm::Unblocked>::
+            invoke(member, _alpha, aa, bb, _beta, cc);
+        }
+      }
+
+      /// team kernel per matrix
+      template<typename MemberType>
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const BatchedGemmTeamTag &, const MemberType &member) const {
+        const int l = member.league_rank();
+        auto aa = Kokkos::subview(_A, l, Kokkos::ALL(), Kokkos::ALL());
+        auto bb = Kokkos::subview(_B, l, Kokkos::ALL(), Kokkos::ALL());
+        auto cc = Kokkos::subview(_C, l, Kokkos::ALL(), Kokkos::ALL());
+
+        TeamGemm<MemberType,ArgTransA,ArgTransB,ArgAlgo>::
+          invoke(member, _alpha, aa, bb, _beta, cc);
+      }
+    };
+
+    ///
+    /// Vendor libraries
+    /// ================
+    ///
+    /// invoke returns 0 when the batch is handed to a vendor library and -1
+    /// when the value type or the view layout is not supported; available
+    /// only inspects types and strides so that it can be used to select the 
+    /// mode before launching anything.
+    ///
+
+    template<typename ArgTransA,
+             typename ArgTransB>
+    struct BatchedGemmVendor {
+      template<typename ValueType>
+      inline
+      static bool 
+      supported(const ValueType * /* dummy */) { return false; }
+
+      template<typename ScalarType,
+               typename ValueTypeA,
+               typename ValueTypeB,
+               typename ValueTypeC>
+      inline
+      static int
+      gemm(const int /* nbatch */, const int /* m */, const int /* n */, const int /* k */,
+           const ScalarType /* alpha */,
+           const ValueTypeA * /* A */, const int /* as0 */, const int /* as1 */,
+           const ValueTypeB * /* B */, const int /* bs0 */, const int /* bs1 */,
+           const ScalarType /* beta */,
+           /**/  ValueTypeC * /* C */, const int /* cs0 */, const int /* cs1 */) {
+        return -1;
+      }
+
+#if defined(__KOKKOSKERNELS_NVIDIA_CUBLAS__)
+      /// the handle is created on first use and intentionally not destroyed
+      /// as the Cuda context may be gone at static destruction
+      inline
+      static cublasHandle_t handle() {
+        static cublasHandle_t h = NULL;
+        if (h == NULL && cublasCreate(&h) != CUBLAS_STATUS_SUCCESS) 
+          Kokkos::Impl::throw_runtime_exception("KokkosBatched::BatchedGemm: cublasCreate failed");
+        return h;
+      }
+
+      inline
+      static cublasOperation_t op(const bool is_trans) {
+        return is_trans ? CUBLAS_OP_T : CUBLAS_OP_N;
+      }
+
+      inline static bool supported(const float  * /* dummy */) { return true; }
+      inline static bool supported(const double * /* dummy */) { return true; }
+
+      /// row major C = op(A) op(B) is column major C^T = op(B)^T op(A)^T
+      template<typename ScalarType>
+      inline
+      static int
+      gemm(const int nbatch, const int m, const int n, const int k,
+           const ScalarType alpha,
+           const double *A, const int as0, const int as1,
+           const double *B, const int bs0, const int bs1,
+           const ScalarType beta,
+           /**/  double *C, const int cs0, const int cs1) {
+        const double alpha_d(alpha), beta_d(beta);
+        const bool
+          is_trans_a = std::is_same<ArgTransA,Trans::Transpose>::value,
+          is_trans_b = std::is_same<ArgTransB,Trans::Transpose>::value;
+        const cublasStatus_t stat = 
+          cublasDgemmStridedBatched(handle(), op(is_trans_b), op(is_trans_a),
+                                    n, m, k,
+                                    &alpha_d, 
+                                    B, bs1, (long long)bs0,
+                                    A, as1, (long long)as0,
+                                    &beta_d,
+                                    C, cs1, (long long)cs0,
+                                    nbatch);
+        return (stat == CUBLAS_STATUS_SUCCESS ? 0 : -1);
+      }
+
+      template<typename ScalarType>
+      inline
+      static int
+      gemm(const int nbatch, const int m, const int n, const int k,
+           const ScalarType alpha,
+           const float *A, const int as0, const int as1,
+           const float *B, const int bs0, const int bs1,
+           const ScalarType beta,
+           /**/  float *C, const int cs0, const int cs1) {
+        const float alpha_s(alpha), beta_s(beta);
+        const bool
+          is_trans_a = std::is_same<ArgTransA,Trans::Transpose>::value,
+          is_trans_b = std::is_same<ArgTransB,Trans::Transpose>::value;
+        const cublasStatus_t stat = 
+          cublasSgemmStridedBatched(handle(), op(is_trans_b), op(is_trans_a),
+                                    n, m, k,
+                                    &alpha_s, 
+                                    B, bs1, (long long)bs0,
+                                    A, as1, (long long)as0,
+                                    &beta_s,
+                                    C, cs1, (long long)cs0,
+                                    nbatch);
+        return (stat == CUBLAS_STATUS_SUCCESS ? 0 : -1);
+      }
+#endif
+
+#if                                                     \
+  defined(__KOKKOSBATCHED_INTEL_MKL__) &&               \
+  defined(__KOKKOSBATCHED_INTEL_MKL_BATCHED__) &&       \
+  defined(__KOKKOSBATCHED_INTEL_MKL_COMPACT_BATCHED__)
+      template<int VectorLength>
+      inline static bool supported(const Vector<SIMD<double>,VectorLength> * /* dummy */) { return true; }
+
+      /// a batch of contiguous row major packs is the MKL compact format
+      /// with nm = nbatch*vl matrices
+      template<typename ScalarType, int VectorLength>
+      inline
+      static int
+      gemm(const int nbatch, const int m, const int n, const int k,
+           const ScalarType alpha,
+           const Vector<SIMD<double>,VectorLength> *A, const int as0, const int as1,
+           const Vector<SIMD<double>,VectorLength> *B, const int bs0, const int bs1,
+           const ScalarType beta,
+           /**/  Vector<SIMD<double>,VectorLength> *C, const int cs0, const int cs1) {
+        const bool
+          is_trans_a = std::is_same<ArgTransA,Trans::Transpose>::value,
+          is_trans_b = std::is_same<ArgTransB,Trans::Transpose>::value;
+        const int 
+          arows = (is_trans_a ? k : m), 
+          brows = (is_trans_b ? n : k);
+        if (as0 != arows*as1 || bs0 != brows*bs1 || cs0 != m*cs1) return -1;
+        cblas_dgemm_compact(CblasRowMajor, 
+                            is_trans_a ? CblasTrans : CblasNoTrans,
+                            is_trans_b ? CblasTrans : CblasNoTrans,
+                            m, n, k, 
+                            double(alpha), 
+                            (const double*)A, as1, 
+                            (const double*)B, bs1, 
+                            double(beta),
+                            (double*)C, cs1,
+                            (MKL_INT)VectorLength, (MKL_INT)(nbatch*VectorLength));
+        return 0;
+      }
+#endif
+
+      template<typename ExecSpace,
+               typename AViewType,
+               typename BViewType,
+               typename CViewType>
+      inline
+      static bool
+      available(const AViewType &A,
+                const BViewType &B,
+                const CViewType &C) {
+        typedef typename CViewType::non_const_value_type value_type;
+        const bool 
+          is_same_value_type = (std::is_same<typename AViewType::non_const_value_type,value_type>::value &&
+                                std::is_same<typename BViewType::non_const_value_type,value_type>::value),
+          is_row_major = (A.stride_2() == 1 && B.stride_2() == 1 && C.stride_2() == 1),
+          is_scalar = !is_vector<value_type>::value;
+        bool is_space = false;
+#if defined(KOKKOS_ENABLE_CUDA)
+        if (std::is_same<typename ExecSpace::execution_space,Kokkos::Cuda>::value) is_space = is_scalar;
+        else 
+#endif
+          is_space = !is_scalar;
+        return (is_same_value_type && is_row_major && is_space && 
+                supported((const value_type*)NULL));
+      }
+
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType,
+               typename CViewType>
+      inline
+      static int
+      invoke(const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B,
+             const ScalarType beta,
+             const CViewType &C) {
+        const bool is_trans_a = std::is_same<ArgTransA,Trans::Transpose>::value;
+        return gemm(C.extent(0), C.extent(1), C.extent(2), 
+                    is_trans_a ? A.extent(1) : A.extent(2),
+                    alpha,
+                    A.data(), A.stride_0(), A.stride_1(),
+                    B.data(), B.stride_0(), B.stride_1(),
+                    beta,
+                    C.data(), C.stride_0(), C.stride_1());
+      }
+    };
+
+    ///
+    /// BatchedGemm
+    ///
+
+    template<typename ArgTransA,
+             typename ArgTransB>
+    template<typename ScalarType,
+             typename AViewType,
+             typename BViewType,
+             typename CViewType>
+    int
+    BatchedGemm<ArgTransA,ArgTransB>::
+    invoke(const ScalarType alpha,
+           const AViewType &A,
+           const BViewType &B,
+           const ScalarType beta,
+           const CViewType &C) {
+      typedef typename CViewType::execution_space exec_space;
+      typedef typename CViewType::non_const_value_type value_type;
+
+      static_assert(AViewType::rank == 3 && BViewType::rank == 3 && CViewType::rank == 3,
+                    "KokkosBatched::BatchedGemm: A, B and C must be rank 3 views");
+
+      const bool is_trans_a = !std::is_same<ArgTransA,Trans::NoTranspose>::value;
+      const bool is_trans_b = !std::is_same<ArgTransB,Trans::NoTranspose>::value;
+
+      const int 
+        nbatch = C.extent(0), m = C.extent(1), n = C.extent(2),
+        am = (is_trans_a ? A.extent(2) : A.extent(1)), ak = (is_trans_a ? A.extent(1) : A.extent(2)),
+        bk = (is_trans_b ? B.extent(2) : B.extent(1)), bn = (is_trans_b ? B.extent(1) : B.extent(2));
+      if (int(A.extent(0)) != nbatch || int(B.extent(0)) != nbatch ||
+          am != m || bn != n || ak != bk) {
+        std::ostringstream os;
+        os << "KokkosBatched::BatchedGemm: Dimensions do not match: "
+           << "A: " << A.extent(0) << " x " << A.extent(1) << " x " << A.extent(2)
+           << ", B: " << B.extent(0) << " x " << B.extent(1) << " x " << B.extent(2)
+           << ", C: " << C.extent(0) << " x " << C.extent(1) << " x " << C.extent(2);
+        Kokkos::Impl::throw_runtime_exception(os.str());
+      }
+      if (nbatch <= 0) return 0;
+
+      const int mn = (m > n ? m : n), mnk = (mn > ak ? mn : ak);
+
+      typedef Functor_BatchedGemm
+        <ArgTransA,ArgTransB,Algo::Gemm::Unblocked,ScalarType,AViewType,BViewType,CViewType> functor_unblocked_type;
+      typedef Functor_BatchedGemm
+        <ArgTransA,ArgTransB,Algo::Gemm::Blocked,ScalarType,AViewType,BViewType,CViewType> functor_blocked_type;
+
+      typedef BatchedGemmVendor<ArgTransA,ArgTransB> vendor_type;
+      const bool vendor_available = vendor_type::template available<exec_space>(A, B, C);
+
+      int mode = BatchedGemmMode::select<exec_space,value_type>(mnk, nbatch, vendor_available);
+      if (mode == BatchedGemmMode::Vendor) {
+        if (vendor_type::invoke(alpha, A, B, beta, C) == 0) return 0;
+        // the vendor library declined the batch; use the native kernels
+        mode = BatchedGemmMode::select<exec_space,value_type>(mnk, nbatch);
+      }
+
+      switch (mode) {
+      case BatchedGemmMode::TeamVector: {
+        // a thread per matrix and its entries over vector lanes
+        typedef Kokkos::TeamPolicy<exec_space,BatchedGemmTeamVectorTag> policy_type;
+        const functor_unblocked_type functor(alpha, A, B, beta, C);
+        const int vector_size = (mn <= 4 ? 4 : mn <= 8 ? 8 : mn <= 16 ? 16 : 32);
+        const int team_size = policy_type::team_size_recommended(functor, vector_size);
+        const int league_size = nbatch/team_size + (nbatch%team_size > 0);
+        const policy_type policy(league_size, team_size, vector_size);
+        Kokkos::parallel_for("KokkosBatched::BatchedGemm::TeamVectorUnblocked", policy, functor);
+        break;
+      }
+      case BatchedGemmMode::Team: {
+        // large matrices are mapped to a team
+        const Kokkos::TeamPolicy<exec_space,BatchedGemmTeamTag> policy(nbatch, Kokkos::AUTO);
+        Kokkos::parallel_for("KokkosBatched::BatchedGemm::TeamBlocked", policy, 
+                             functor_blocked_type(alpha, A, B, beta, C));
+        break;
+      }
+      default: {
+        const Kokkos::RangePolicy<exec_space> policy(0, nbatch);
+        if (mnk <= 4) 
+          // tiny matrices do not benefit from register blocking
+          Kokkos::parallel_for("KokkosBatched::BatchedGemm::SerialUnblocked", policy, 
+                               functor_unblocked_type(alpha, A, B, beta, C));
+        else 
+          Kokkos::parallel_for("KokkosBatched::BatchedGemm::SerialBlocked", policy, 
+                               functor_blocked_type(alpha, A, B, beta, C));
+        break;
+      }
+      }
+      return 0;
+    }
+
+  }
+}
+
+#endif
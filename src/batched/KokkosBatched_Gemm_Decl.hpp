@@ -4,6 +4,7 @@
 
 /// \author Kyungjoo Kim (kyukim@sandia.gov)
 
+#include "KokkosBatched_Util.hpp"
 
 namespace KokkosBatched {
   namespace Experimental {
@@ -51,6 +52,126 @@ namespace KokkosBatched {
              const CViewType &C);
     };
   
+    ///
+    /// TeamVector Gemm
+    ///
+    /// Invoked by a single thread of a team on its own matrix; the matrix
+    /// entries are distributed over the vector lanes of that thread
+    /// (ThreadVectorRange) so that a team processes team_size matrices.
+    /// Only Algo::Gemm::Unblocked is provided.
+    ///
+
+    template<typename MemberType,
+             typename ArgTransA,
+             typename ArgTransB,
+             typename ArgAlgo>
+    struct TeamVectorGemm {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType,
+               typename CViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B,
+             const ScalarType beta,
+             const CViewType &C);
+    };
+
+    ///
+    /// Serial Gemm with compile-time sizes
+    ///
+    /// C (M x N) = beta C + alpha op(A) (M x K) op(B) (K x N) is fully unrolled
+    /// for the given sizes; when the view extents do not match M, N and K,
+    /// it falls back to SerialGemm with ArgAlgo.
+    ///
+
+    template<typename ArgTransA,
+             typename ArgTransB,
+             typename ArgAlgo,
+             int M, int N, int K>
+    struct SerialGemmFixedSize {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType,
+               typename CViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B,
+             const ScalarType beta,
+             const CViewType &C);
+    };
+
+    ///
+    /// Serial Gemm with epilogue
+    ///
+    /// C(i,j) = op(i, j, beta C(i,j) + alpha (op(A) op(B))(i,j)) where the
+    /// epilogue op is applied to each element while it is still in registers,
+    /// so C is read and written once. An epilogue is a functor
+    ///
+    ///   template<typename ValueType>
+    ///   KOKKOS_INLINE_FUNCTION
+    ///   ValueType operator()(const int i, const int j, const ValueType &c) const;
+    ///
+    /// ConjTranspose is not yet implemented.
+    ///
+
+    template<typename ArgTransA,
+             typename ArgTransB,
+             typename ArgAlgo>
+    struct SerialGemmEpilogue {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType,
+               typename CViewType,
+               typename EpilogueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B,
+             const ScalarType beta,
+             const CViewType &C,
+             const EpilogueType &op);
+    };
+
+    struct GemmEpilogue {
+      /// C = beta C + alpha A B
+      struct Identity {
+        template<typename ValueType>
+        KOKKOS_INLINE_FUNCTION
+        ValueType operator()(const int /* i */, const int /* j */, const ValueType &c) const {
+          return c;
+        }
+      };
+
+      /// same as SerialAddRadial applied to C afterwards
+      template<typename ScalarType>
+      struct AddRadial {
+        ScalarType _tiny;
+
+        KOKKOS_INLINE_FUNCTION
+        AddRadial(const ScalarType tiny) : _tiny(tiny) {}
+
+        template<typename ValueType>
+        KOKKOS_INLINE_FUNCTION
+        ValueType operator()(const int i, const int j, const ValueType &c) const {
+          if (i != j) return c;
+          const auto       abs_tiny = _tiny > 0 ? _tiny : -_tiny;
+          const auto minus_abs_tiny = -abs_tiny;
+          const auto a_real = Kokkos::Details::ArithTraits<ValueType>::real(c);
+          ValueType r = c;
+          r += ValueType(minus_abs_tiny)*ValueType(a_real <  0);
+          r += ValueType(      abs_tiny)*ValueType(a_real >= 0);
+          return r;
+        }
+      };
+    };
+
     // specialized for different m and n
     // C(mxn) += alpha * A(mxk) B(kxn)
 
@@ -442,7 +442,95 @@ namespace KokkosBatched {
                beta,
                C.data(), C.stride_0(), C.stride_1());
     }
-        
+
+    ///
+    /// Fixed size
+    /// ==========
+
+    template<typename ArgTransA,
+             typename ArgTransB,
+             typename ArgAlgo,
+             int M, int N, int K>
+    template<typename ScalarType,
+             typename AViewType,
+             typename BViewType,
+             typename CViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialGemmFixedSize<ArgTransA,ArgTransB,ArgAlgo,M,N,K>::
+    invoke(const ScalarType alpha,
+           const AViewType &A,
+           const BViewType &B,
+           const ScalarType beta,
+           const CViewType &C) {
+      static_assert(!std::is_same<ArgTransA,Trans::ConjTranspose>::value &&
+                    !std::is_same<ArgTransB,Trans::ConjTranspose>::value,
+                    "SerialGemmFixedSize: ConjTranspose is not supported");
+      const bool is_trans_a = std::is_same<ArgTransA,Trans::Transpose>::value;
+      const bool is_trans_b = std::is_same<ArgTransB,Trans::Transpose>::value;
+
+      const int 
+        m = C.extent(0), n = C.extent(1),
+        ka = is_trans_a ? A.extent(0) : A.extent(1),
+        kb = is_trans_b ? B.extent(1) : B.extent(0);
+
+      if (m != M || n != N || ka != K || kb != K)
+        return SerialGemm<ArgTransA,ArgTransB,ArgAlgo>::invoke(alpha, A, B, beta, C);
+
+      // C = beta C + alpha A B
+      // C (M x N), A(M x K), B(K x N)
+      return SerialGemmInternalFixedSize<M,N,K>::
+        invoke(alpha, 
+               A.data(), (is_trans_a ? A.stride_1() : A.stride_0()), (is_trans_a ? A.stride_0() : A.stride_1()),
+               B.data(), (is_trans_b ? B.stride_1() : B.stride_0()), (is_trans_b ? B.stride_0() : B.stride_1()),
+               beta,
+               C.data(), C.stride_0(), C.stride_1());
+    }
+
+
+    ///
+    /// Epilogue
+    /// ========
+    ///
+    /// op(A) and op(B) are expressed by swapping strides.
+    ///
+
+    template<typename ArgTransA,
+             typename ArgTransB,
+             typename ArgAlgo>
+    template<typename ScalarType,
+             typename AViewType,
+             typename BViewType,
+             typename CViewType,
+             typename EpilogueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialGemmEpilogue<ArgTransA,ArgTransB,ArgAlgo>::
+    invoke(const ScalarType alpha,
+           const AViewType &A,
+           const BViewType &B,
+           const ScalarType beta,
+           const CViewType &C,
+           const EpilogueType &op) {
+      static_assert(!std::is_same<ArgTransA,Trans::ConjTranspose>::value &&
+                    !std::is_same<ArgTransB,Trans::ConjTranspose>::value,
+                    "SerialGemmEpilogue: ConjTranspose is not yet implemented");
+      const bool
+        is_trans_a = std::is_same<ArgTransA,Trans::Transpose>::value,
+        is_trans_b = std::is_same<ArgTransB,Trans::Transpose>::value;
+
+      // C = op(beta C + alpha op(A) op(B))
+      // C (m x n), op(A)(m x k), op(B)(k x n)
+      return SerialGemmEpilogueInternal<ArgAlgo>::
+        invoke(C.extent(0), C.extent(1), (is_trans_a ? A.extent(0) : A.extent(1)),
+               alpha, 
+               A.data(), (is_trans_a ? A.stride_1() : A.stride_0()), (is_trans_a ? A.stride_0() : A.stride_1()),
+               B.data(), (is_trans_b ? B.stride_1() : B.stride_0()), (is_trans_b ? B.stride_0() : B.stride_1()),
+               beta,
+               C.data(), C.stride_0(), C.stride_1(),
+               op);
+    }
+
   }
 }
 
@@ -5,6 +5,7 @@
 /// \author Kyungjoo Kim (kyukim@sandia.gov)
 
 #include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Gemm_Decl.hpp"
 
 #include "KokkosBatched_Set_Internal.hpp"
 #include "KokkosBatched_Scale_Internal.hpp"
@@ -31,6 +32,19 @@ namespace KokkosBatched {
              const ValueType *__restrict__ B, const int bs0, const int bs1,
              const ScalarType beta,
              /**/  ValueType *__restrict__ C, const int cs0, const int cs1);
+
+      // mixed precision; A and B are widened to the value type of C
+      template<typename ScalarType,
+               typename ValueTypeAB,
+               typename ValueTypeC>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const int m, const int n, const int k,
+             const ScalarType alpha, 
+             const ValueTypeAB *__restrict__ A, const int as0, const int as1,
+             const ValueTypeAB *__restrict__ B, const int bs0, const int bs1,
+             const ScalarType beta,
+             /**/  ValueTypeC *__restrict__ C, const int cs0, const int cs1);
     };
         
     template<>
@@ -75,6 +89,82 @@ namespace KokkosBatched {
       return 0;
     }
 
+    ///
+    /// register blocking with compile-time mb x nb tiles;
+    /// Algo::Gemm::Blocked uses the tuned blocking (KokkosBatched_Tuning.hpp)
+    ///
+    template<int mbAlgo, int nbAlgo>
+    struct SerialGemmInternalRegisterBlocked {
+      template<typename ScalarType,
+               typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const int m, const int n, const int k,
+             const ScalarType alpha, 
+             const ValueType *__restrict__ A, const int as0, const int as1,
+             const ValueType *__restrict__ B, const int bs0, const int bs1,
+             const ScalarType beta,
+             /**/  ValueType *__restrict__ C, const int cs0, const int cs1) {
+        // C = beta C + alpha A B
+        // C (m x n), A(m x k), B(k x n)
+
+        const ScalarType one(1.0), zero(0.0);      
+      
+        if      (beta == zero) SerialSetInternal  ::invoke(m, n, zero, C, cs0, cs1);
+        else if (beta != one ) SerialScaleInternal::invoke(m, n, beta, C, cs0, cs1);
+      
+        if (alpha != zero) {
+          if (m <= 0 || n <= 0 || k <= 0) return 0;
+          const ValueType alpha_value(alpha);
+
+          InnerGemmFixC<mbAlgo,nbAlgo> inner(as0, as1, bs0, bs1, cs0, cs1);
+          auto gemm = [&](const int ib, 
+                          const int jb,
+                          const int pb,
+                          const ValueType *__restrict__ AA,
+                          const ValueType *__restrict__ BB,
+                          /**/  ValueType *__restrict__ CC) {
+            const int mb = mbAlgo, nb = nbAlgo;
+            for (int i=0;i<ib;i+=mb) 
+              for (int j=0;j<jb;j+=nb)
+                inner.serial_invoke(alpha_value, 
+                                    AA+i*as0, BB+j*bs1, 
+                                    (i+mb) > ib ? (ib-i) : mb, 
+                                    (j+nb) > jb ? (jb-j) : nb, 
+                                    pb, 
+                                    CC+i*cs0+j*cs1);
+          };          
+            
+          const bool is_small = true; //(m*n*k <= 64*64*64);
+          if (is_small) {
+            gemm(m, n, k, A, B, C);
+          } else {
+            // // cache blocking
+            // const int 
+            //   nc = nb*10, kc = mb*4, mc = mb*4;
+              
+            // for (int jj=0;jj<n;jj+=nc) {
+            //   const int tj = n-jj, jb = (tj < nc ? tj : nc);
+            //   for (int pp=0;pp<k;pp+=kc) {
+            //     const int tp = k-pp, pb = (tp < kc ? tp : kc);
+            //     //const int pb = k, pp = 0;
+            //     for (int ii=0;ii<m;ii+=mc) {
+            //       const int ti = m-ii, ib = (ti < mc ? ti : mc);
+              
+            //       const ValueType *__restrict__ AA = A+ii*as0+pp*as1;
+            //       const ValueType *__restrict__ BB = B+pp*bs0+jj*bs1;
+            //       /**/  ValueType *__restrict__ CC = C+ii*cs0+jj*cs1;
+              
+            //       gemm(ib, jb, pb, AA, BB, CC);                  
+            //     } // for ii
+            //   } // for pp
+            // } // for jj
+          }
+        }
+        return 0;
+      }
+    };
+
     template<>
     template<typename ScalarType,
              typename ValueType>
@@ -91,65 +181,229 @@ namespace KokkosBatched {
       // C (m x n), A(m x k), B(k x n)
 
       enum : int {
-        mbAlgo = Algo::Gemm::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace>(),
-        nbAlgo = Algo::Gemm::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace>() 
+        mbAlgo = Algo::Gemm::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace,ValueType>(),
+        nbAlgo = Algo::Gemm::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace,ValueType>() 
       };
-      
-      const ScalarType one(1.0), zero(0.0);      
-      
-      if      (beta == zero) SerialSetInternal  ::invoke(m, n, zero, C, cs0, cs1);
-      else if (beta != one ) SerialScaleInternal::invoke(m, n, beta, C, cs0, cs1);
-      
-      if (alpha != zero) {
-        if (m <= 0 || n <= 0 || k <= 0) return 0;
-        const ValueType alpha_value(alpha);
-
-        InnerGemmFixC<mbAlgo,nbAlgo> inner(as0, as1, bs0, bs1, cs0, cs1);
-        auto gemm = [&](const int ib, 
-                        const int jb,
-                        const int pb,
-                        const ValueType *__restrict__ AA,
-                        const ValueType *__restrict__ BB,
-                        /**/  ValueType *__restrict__ CC) {
-          const int mb = mbAlgo, nb = nbAlgo;
-          for (int i=0;i<ib;i+=mb) 
-            for (int j=0;j<jb;j+=nb)
-              inner.serial_invoke(alpha_value, 
-                                  AA+i*as0, BB+j*bs1, 
-                                  (i+mb) > ib ? (ib-i) : mb, 
-                                  (j+nb) > jb ? (jb-j) : nb, 
-                                  pb, 
-                                  CC+i*cs0+j*cs1);
-        };          
-            
-        const bool is_small = true; //(m*n*k <= 64*64*64);
-        if (is_small) {
-          gemm(m, n, k, A, B, C);
-        } else {
-          // // cache blocking
-          // const int 
-          //   nc = nb*10, kc = mb*4, mc = mb*4;
-              
-          // for (int jj=0;jj<n;jj+=nc) {
-          //   const int tj = n-jj, jb = (tj < nc ? tj : nc);
-          //   for (int pp=0;pp<k;pp+=kc) {
-          //     const int tp = k-pp, pb = (tp < kc ? tp : kc);
-          //     //const int pb = k, pp = 0;
-          //     for (int ii=0;ii<m;ii+=mc) {
-          //       const int ti = m-ii, ib = (ti < mc ? ti : mc);
-              
-          //       const ValueType *__restrict__ AA = A+ii*as0+pp*as1;
-          //       const ValueType *__restrict__ BB = B+pp*bs0+jj*bs1;
-          //       /**/  ValueType *__restrict__ CC = C+ii*cs0+jj*cs1;
-              
-          //       gemm(ib, jb, pb, AA, BB, CC);                  
-          //     } // for ii
-          //   } // for pp
-          // } // for jj
+
+      return SerialGemmInternalRegisterBlocked<mbAlgo,nbAlgo>::
+        invoke(m, n, k, 
+               alpha, 
+               A, as0, as1, 
+               B, bs0, bs1, 
+               beta, 
+               C, cs0, cs1);
+    }
+
+    ///
+    /// Epilogue
+    /// ========
+    ///
+    /// C = op(i, j, beta C + alpha A B); each element is finalized once in
+    /// registers instead of scaling C up front and updating it in place.
+    /// A and B may be stored in lower precision than C, e.g., float and
+    /// double; they are widened on load and products accumulate in C's type.
+    ///
+
+    template<typename ArgAlgo>
+    struct SerialGemmEpilogueInternal {
+      template<typename ScalarType,
+               typename ValueTypeAB,
+               typename ValueTypeC,
+               typename EpilogueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const int m, const int n, const int k,
+             const ScalarType alpha, 
+             const ValueTypeAB *__restrict__ A, const int as0, const int as1,
+             const ValueTypeAB *__restrict__ B, const int bs0, const int bs1,
+             const ScalarType beta,
+             /**/  ValueTypeC *__restrict__ C, const int cs0, const int cs1,
+             const EpilogueType &op);
+    };
+
+    template<>
+    template<typename ScalarType,
+             typename ValueTypeAB,
+             typename ValueTypeC,
+             typename EpilogueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialGemmEpilogueInternal<Algo::Gemm::Unblocked>::
+    invoke(const int m, const int n, const int k,
+           const ScalarType alpha, 
+           const ValueTypeAB *__restrict__ A, const int as0, const int as1,
+           const ValueTypeAB *__restrict__ B, const int bs0, const int bs1,
+           const ScalarType beta,
+           /**/  ValueTypeC *__restrict__ C, const int cs0, const int cs1,
+           const EpilogueType &op) {
+      // C = op(beta C + alpha A B)
+      // C (m x n), A(m x k), B(k x n)
+
+      const ScalarType zero(0.0);
+
+      for (int i=0;i<m;++i) {
+        const ValueTypeAB *__restrict__ pA = A+i*as0;
+        for (int j=0;j<n;++j) {
+          const ValueTypeAB *__restrict__ pB = B+j*bs1;
+
+          ValueTypeC c = 0;
+          for (int p=0;p<k;++p) 
+            c += ValueTypeC(pA[p*as1])*ValueTypeC(pB[p*bs0]);
+
+          ValueTypeC &cij = C[i*cs0+j*cs1];
+          if (beta == zero) cij = op(i, j, ValueTypeC(alpha*c));
+          else              cij = op(i, j, ValueTypeC(beta*cij + alpha*c));
         }
       }
       return 0;
     }
+
+    template<>
+    template<typename ScalarType,
+             typename ValueTypeAB,
+             typename ValueTypeC,
+             typename EpilogueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialGemmEpilogueInternal<Algo::Gemm::Blocked>::
+    invoke(const int m, const int n, const int k,
+           const ScalarType alpha, 
+           const ValueTypeAB *__restrict__ A, const int as0, const int as1,
+           const ValueTypeAB *__restrict__ B, const int bs0, const int bs1,
+           const ScalarType beta,
+           /**/  ValueTypeC *__restrict__ C, const int cs0, const int cs1,
+           const EpilogueType &op) {
+      // C = op(beta C + alpha A B)
+      // C (m x n), A(m x k), B(k x n)
+
+      enum : int {
+        mbAlgo = Algo::Gemm::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace,ValueTypeC>(),
+        nbAlgo = Algo::Gemm::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace,ValueTypeC>() 
+      };
+
+      InnerGemmFixC<mbAlgo,nbAlgo> inner(as0, as1, bs0, bs1, cs0, cs1);
+      const int mb = mbAlgo, nb = nbAlgo;
+      for (int i=0;i<m;i+=mb) 
+        for (int j=0;j<n;j+=nb)
+          inner.serial_invoke_epilogue(alpha, beta,
+                                       A+i*as0, B+j*bs1, 
+                                       (i+mb) > m ? (m-i) : mb, 
+                                       (j+nb) > n ? (n-j) : nb, 
+                                       k, 
+                                       C+i*cs0+j*cs1,
+                                       i, j, op);
+      return 0;
+    }
+
+    ///
+    /// Mixed precision
+    /// ===============
+    ///
+    /// C = beta C + alpha A B with A and B in lower precision than C; used
+    /// when the value types of A/B and C differ.
+    ///
+
+    template<typename ArgAlgo>
+    template<typename ScalarType,
+             typename ValueTypeAB,
+             typename ValueTypeC>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialGemmInternal<ArgAlgo>::
+    invoke(const int m, const int n, const int k,
+           const ScalarType alpha, 
+           const ValueTypeAB *__restrict__ A, const int as0, const int as1,
+           const ValueTypeAB *__restrict__ B, const int bs0, const int bs1,
+           const ScalarType beta,
+           /**/  ValueTypeC *__restrict__ C, const int cs0, const int cs1) {
+      return SerialGemmEpilogueInternal<ArgAlgo>::
+        invoke(m, n, k, 
+               alpha, 
+               A, as0, as1, 
+               B, bs0, bs1, 
+               beta, 
+               C, cs0, cs1,
+               GemmEpilogue::Identity());
+    }
+
+    ///
+    /// Fixed size
+    /// ==========
+    ///
+    /// All loop bounds are compile-time constants so the compiler fully
+    /// unrolls the kernel into straight-line multiply-add code with C held
+    /// in registers. Intended for small sizes only.
+    ///
+
+    template<int M, int N, int K>
+    struct SerialGemmInternalFixedSize {
+      template<typename ScalarType,
+               typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const ScalarType alpha, 
+             const ValueType *__restrict__ A, const int as0, const int as1,
+             const ValueType *__restrict__ B, const int bs0, const int bs1,
+             const ScalarType beta,
+             /**/  ValueType *__restrict__ C, const int cs0, const int cs1) {
+        // C = beta C + alpha A B
+        // C (M x N), A(M x K), B(K x N)
+        const ScalarType zero(0.0);
+
+        ValueType c[M*N];
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+        for (int ij=0;ij<(M*N);++ij)
+          c[ij] = zero;
+
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+        for (int p=0;p<K;++p) {
+          ValueType b[N];
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+          for (int j=0;j<N;++j)
+            b[j] = B[p*bs0+j*bs1];
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+          for (int i=0;i<M;++i) {
+            const ValueType a = A[i*as0+p*as1];
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+            for (int j=0;j<N;++j)
+              c[i*N+j] += a*b[j];
+          }
+        }
+
+        if (beta == zero) {
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+          for (int i=0;i<M;++i)
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+            for (int j=0;j<N;++j)
+              C[i*cs0+j*cs1] = alpha*c[i*N+j];
+        } else {
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+          for (int i=0;i<M;++i)
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+            for (int j=0;j<N;++j)
+              C[i*cs0+j*cs1] = beta*C[i*cs0+j*cs1] + alpha*c[i*N+j];
+        }
+        return 0;
+      }
+    };
     
   }
 }
@@ -0,0 +1,76 @@
+#ifndef __KOKKOSBATCHED_GEMM_TEAMVECTOR_INTERNAL_HPP__
+#define __KOKKOSBATCHED_GEMM_TEAMVECTOR_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// TeamVector Internal Impl
+    /// ========================
+
+    template<typename ArgAlgo>
+    struct TeamVectorGemmInternal {
+      template<typename MemberType,
+               typename ScalarType,
+               typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const int m, const int n, const int k,
+             const ScalarType alpha,
+             const ValueType *__restrict__ A, const int as0, const int as1,
+             const ValueType *__restrict__ B, const int bs0, const int bs1,
+             const ScalarType beta,
+             /**/  ValueType *__restrict__ C, const int cs0, const int cs1);
+    };
+
+    template<>
+    template<typename MemberType,
+             typename ScalarType,
+             typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamVectorGemmInternal<Algo::Gemm::Unblocked>::
+    invoke(const MemberType &member,
+           const int m, const int n, const int k,
+           const ScalarType alpha,
+           const ValueType *__restrict__ A, const int as0, const int as1,
+           const ValueType *__restrict__ B, const int bs0, const int bs1,
+           const ScalarType beta,
+           /**/  ValueType *__restrict__ C, const int cs0, const int cs1) {
+      // C = beta C + alpha A B
+      // C (m x n), A(m x k), B(k x n)
+
+      const ScalarType zero(0.0);
+
+      if (m <= 0 || n <= 0) return 0;
+
+      // each lane computes one entry of C; no lane reads what another writes
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,m*n),[&](const int &ij) {
+          const int i = ij/n, j = ij%n;
+          const ValueType
+            *__restrict__ pA = A+i*as0,
+            *__restrict__ pB = B+j*bs1;
+
+          ValueType c(0);
+          for (int p=0;p<k;++p)
+            c += pA[p*as1]*pB[p*bs0];
+
+          ValueType &cij = C[i*cs0+j*cs1];
+          if (beta == zero) cij = alpha*c;
+          else              cij = beta*cij + alpha*c;
+        });
+      vector_barrier(member);
+
+      return 0;
+    }
+
+  }
+}
+
+#endif
@@ -5,6 +5,7 @@
 /// \author Kyungjoo Kim (kyukim@sandia.gov)
 
 #include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Gemm_Decl.hpp"
 
 #include "KokkosBatched_Set_Internal.hpp"
 #include "KokkosBatched_Scale_Internal.hpp"
@@ -31,6 +32,21 @@ namespace KokkosBatched {
              const ValueType *__restrict__ B, const int bs0, const int bs1,
              const ScalarType beta,
              /**/  ValueType *__restrict__ C, const int cs0, const int cs1);
+
+      // mixed precision; A and B are widened to the value type of C
+      template<typename MemberType,
+               typename ScalarType,
+               typename ValueTypeAB,
+               typename ValueTypeC>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const int m, const int n, const int k,
+             const ScalarType alpha, 
+             const ValueTypeAB *__restrict__ A, const int as0, const int as1,
+             const ValueTypeAB *__restrict__ B, const int bs0, const int bs1,
+             const ScalarType beta,
+             /**/  ValueTypeC *__restrict__ C, const int cs0, const int cs1);
     };
 
     template<>
@@ -96,8 +112,8 @@ namespace KokkosBatched {
       // C (m x n), A(m x k), B(k x n)
 
       enum : int {
-        mbAlgo = Algo::Gemm::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace>(),
-        nbAlgo = Algo::Gemm::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace>() 
+        mbAlgo = Algo::Gemm::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace,ValueType>(),
+        nbAlgo = Algo::Gemm::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace,ValueType>() 
       };
 
       const ScalarType one(1.0), zero(0.0);
@@ -174,6 +190,68 @@ namespace KokkosBatched {
       return 0;
     }
 
+
+    ///
+    /// Mixed precision
+    /// ===============
+    ///
+    /// C = beta C + alpha A B with A and B in lower precision than C; each
+    /// thread computes (mb x nb) tiles of C accumulated in C's value type
+    /// and stores them once, so C is not scaled up front.
+    ///
+
+    template<typename ArgAlgo>
+    template<typename MemberType,
+             typename ScalarType,
+             typename ValueTypeAB,
+             typename ValueTypeC>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamGemmInternal<ArgAlgo>::
+    invoke(const MemberType &member, 
+           const int m, const int n, const int k,
+           const ScalarType alpha, 
+           const ValueTypeAB *__restrict__ A, const int as0, const int as1,
+           const ValueTypeAB *__restrict__ B, const int bs0, const int bs1,
+           const ScalarType beta,
+           /**/  ValueTypeC *__restrict__ C, const int cs0, const int cs1) {
+      // C = beta C + alpha A B
+      // C (m x n), A(m x k), B(k x n)
+
+      enum : int {
+        mbAlgo = (std::is_same<ArgAlgo,Algo::Gemm::Unblocked>::value ? 1 :
+                  Algo::Gemm::Blocked::mb<Kokkos::Impl::ActiveExecutionMemorySpace,ValueTypeC>()),
+        nbAlgo = mbAlgo
+      };
+
+      if (m <= 0 || n <= 0) return 0;
+
+      InnerGemmFixC<mbAlgo,nbAlgo> inner(as0, as1, bs0, bs1, cs0, cs1);
+      const int
+        mb = mbAlgo, mp = (m%mb), mq = (m/mb) + (mp>0),
+        nb = nbAlgo, np = (n%nb), nq = (n/nb) + (np>0);
+
+      Kokkos::parallel_for
+        (Kokkos::TeamThreadRange(member, mq*nq ),
+         [&](const int &ij) {
+#if                                                     \
+  defined (KOKKOS_ENABLE_CUDA) &&                         \
+  defined (KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_CUDA)
+          const int i = ij%mq*mb, j = ij/mq*nb;
+#else
+          const int i = ij/nq*mb, j = ij%nq*nb;
+#endif
+          inner.serial_invoke_epilogue(alpha, beta,
+                                       A+i*as0, B+j*bs1, 
+                                       (i+mb) > m ? mp : mb, 
+                                       (j+nb) > n ? np : nb, 
+                                       k, 
+                                       C+i*cs0+j*cs1,
+                                       i, j, GemmEpilogue::Identity());
+        });
+      return 0;
+    }
+
   }
 }
 
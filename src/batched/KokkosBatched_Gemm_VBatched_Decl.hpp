@@ -0,0 +1,80 @@
+#ifndef __KOKKOSBATCHED_GEMM_VBATCHED_DECL_HPP__
+#define __KOKKOSBATCHED_GEMM_VBATCHED_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "Kokkos_Core.hpp"
+
+#include "KokkosBatched_Util.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Variable size batched Gemm
+    /// ==========================
+    ///
+    /// C_i = beta C_i + alpha op(A_i) op(B_i), i = 0 .. nbatch-1
+    ///
+    /// C_i is m(i) x n(i) and the inner dimension is k(i). Each matrix is
+    /// stored contiguously in row major order in a flat value array starting
+    /// at its offset, i.e., A_i is (m(i) x k(i)) at A.data()+a_offset(i) when
+    /// ArgTransA is NoTranspose and (k(i) x m(i)) when it is Transpose; the
+    /// same holds for B_i. C_i is (m(i) x n(i)) at C.data()+c_offset(i).
+    ///
+    /// Matrices are binned by their largest dimension and each bin is
+    /// dispatched with a single launch to a kernel specialized for the bin;
+    /// small bins use a serial kernel per matrix and the largest bin uses a
+    /// team per matrix.
+    ///
+
+    struct VBatchedGemmBins {
+      enum : int { NumBins = 5 };
+
+      /// upper bound of the largest dimension of each bin; the last bin is open
+      KOKKOS_INLINE_FUNCTION
+      static int upper(const int b) {
+        return (b == 0 ? 4 :
+                b == 1 ? 8 :
+                b == 2 ? 16 :
+                b == 3 ? 32 : -1);
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      static int bin(const int m, const int n, const int k) {
+        const int mn = (m > n ? m : n), mnk = (mn > k ? mn : k);
+        int b = 0;
+        for (;b<(NumBins-1);++b)
+          if (mnk <= upper(b)) break;
+        return b;
+      }
+    };
+
+    template<typename ArgTransA,
+             typename ArgTransB>
+    struct VBatchedGemm {
+      template<typename ScalarType,
+               typename SizeViewType,
+               typename OffsetViewType,
+               typename AViewType,
+               typename BViewType,
+               typename CViewType>
+      static int
+      invoke(const ScalarType alpha,
+             const SizeViewType &m,
+             const SizeViewType &n,
+             const SizeViewType &k,
+             const AViewType &A,
+             const OffsetViewType &a_offset,
+             const BViewType &B,
+             const OffsetViewType &b_offset,
+             const ScalarType beta,
+             const CViewType &C,
+             const OffsetViewType &c_offset);
+    };
+
+  }
+}
+
+#endif
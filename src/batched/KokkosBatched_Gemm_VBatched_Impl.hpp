@@ -0,0 +1,235 @@
+#ifndef __KOKKOSBATCHED_GEMM_VBATCHED_IMPL_HPP__
+#define __KOKKOSBATCHED_GEMM_VBATCHED_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include <sstream>
+
+#include "KokkosKernels_Profiling.hpp"
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Gemm_Serial_Internal.hpp"
+#include "KokkosBatched_Gemm_Team_Internal.hpp"
+
+#include "KokkosBatched_Gemm_VBatched_Decl.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Device level functors
+    /// =====================
+
+    ///
+    /// strides of op(X) (rows x cols) for a row major matrix stored
+    /// as (rows x cols) or, when transposed, as (cols x rows)
+    ///
+    template<typename ArgTrans>
+    struct VBatchedGemmStride;
+
+    template<>
+    struct VBatchedGemmStride<Trans::NoTranspose> {
+      KOKKOS_INLINE_FUNCTION
+      static void get(const int /* rows */, const int cols, int &s0, int &s1) {
+        s0 = cols; s1 = 1;
+      }
+    };
+
+    template<>
+    struct VBatchedGemmStride<Trans::Transpose> {
+      KOKKOS_INLINE_FUNCTION
+      static void get(const int rows, const int /* cols */, int &s0, int &s1) {
+        s0 = 1; s1 = rows;
+      }
+    };
+
+    template<typename ArgTransA,
+             typename ArgTransB,
+             typename ArgAlgo,
+             typename ScalarType,
+             typename PermViewType,
+             typename SizeViewType,
+             typename OffsetViewType,
+             typename AViewType,
+             typename BViewType,
+             typename CViewType>
+    struct Functor_VBatchedGemm {
+      ScalarType _alpha, _beta;
+      PermViewType _perm;
+      int _begin;
+      SizeViewType _m, _n, _k;
+      AViewType _A; OffsetViewType _a_offset;
+      BViewType _B; OffsetViewType _b_offset;
+      CViewType _C; OffsetViewType _c_offset;
+
+      Functor_VBatchedGemm(const ScalarType alpha,
+                           const PermViewType &perm,
+                           const int begin,
+                           const SizeViewType &m,
+                           const SizeViewType &n,
+                           const SizeViewType &k,
+                           const AViewType &A, const OffsetViewType &a_offset,
+                           const BViewType &B, const OffsetViewType &b_offset,
+                           const ScalarType beta,
+                           const CViewType &C, const OffsetViewType &c_offset)
+        : _alpha(alpha), _beta(beta), _perm(perm), _begin(begin),
+          _m(m), _n(n), _k(k),
+          _A(A), _a_offset(a_offset),
+          _B(B), _b_offset(b_offset),
+          _C(C), _c_offset(c_offset) {}
+
+      /// serial kernel per matrix
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const int idx) const {
+        const int i = _perm(idx), m = _m(i), n = _n(i), k = _k(i);
+        int as0, as1, bs0, bs1;
+        VBatchedGemmStride<ArgTransA>::get(m, k, as0, as1);
+        VBatchedGemmStride<ArgTransB>::get(k, n, bs0, bs1);
+        SerialGemmInternal<ArgAlgo>::
+          invoke(m, n, k,
+                 _alpha,
+                 _A.data()+_a_offset(i), as0, as1,
+                 _B.data()+_b_offset(i), bs0, bs1,
+                 _beta,
+                 _C.data()+_c_offset(i), n, 1);
+      }
+
+      /// team kernel per matrix
+      template<typename MemberType>
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const MemberType &member) const {
+        const int i = _perm(_begin + member.league_rank()), m = _m(i), n = _n(i), k = _k(i);
+        int as0, as1, bs0, bs1;
+        VBatchedGemmStride<ArgTransA>::get(m, k, as0, as1);
+        VBatchedGemmStride<ArgTransB>::get(k, n, bs0, bs1);
+        TeamGemmInternal<ArgAlgo>::
+          invoke(member,
+                 m, n, k,
+                 _alpha,
+                 _A.data()+_a_offset(i), as0, as1,
+                 _B.data()+_b_offset(i), bs0, bs1,
+                 _beta,
+                 _C.data()+_c_offset(i), n, 1);
+      }
+    };
+
+    ///
+    /// VBatchedGemm
+    ///
+
+    template<typename ArgTransA,
+             typename ArgTransB>
+    template<typename ScalarType,
+             typename SizeViewType,
+             typename OffsetViewType,
+             typename AViewType,
+             typename BViewType,
+             typename CViewType>
+    int
+    VBatchedGemm<ArgTransA,ArgTransB>::
+    invoke(const ScalarType alpha,
+           const SizeViewType &m,
+           const SizeViewType &n,
+           const SizeViewType &k,
+           const AViewType &A,
+           const OffsetViewType &a_offset,
+           const BViewType &B,
+           const OffsetViewType &b_offset,
+           const ScalarType beta,
+           const CViewType &C,
+           const OffsetViewType &c_offset) {
+      typedef typename CViewType::execution_space exec_space;
+      typedef Kokkos::View<int*,typename CViewType::device_type> perm_view_type;
+
+      const int nbatch = m.extent(0);
+      if (int(n.extent(0)) != nbatch || int(k.extent(0)) != nbatch ||
+          int(a_offset.extent(0)) < nbatch ||
+          int(b_offset.extent(0)) < nbatch ||
+          int(c_offset.extent(0)) < nbatch) {
+        std::ostringstream os;
+        os << "KokkosBatched::VBatchedGemm: Dimensions do not match: "
+           << "m: " << m.extent(0) << ", n: " << n.extent(0) << ", k: " << k.extent(0)
+           << ", a_offset: " << a_offset.extent(0)
+           << ", b_offset: " << b_offset.extent(0)
+           << ", c_offset: " << c_offset.extent(0);
+        Kokkos::Impl::throw_runtime_exception(os.str());
+      }
+      if (nbatch <= 0) return 0;
+
+      ///
+      /// bin matrices by size on host (counting sort)
+      ///
+      enum : int { NumBins = VBatchedGemmBins::NumBins };
+
+      auto m_host = Kokkos::create_mirror_view(m);
+      auto n_host = Kokkos::create_mirror_view(n);
+      auto k_host = Kokkos::create_mirror_view(k);
+      Kokkos::deep_copy(m_host, m);
+      Kokkos::deep_copy(n_host, n);
+      Kokkos::deep_copy(k_host, k);
+
+      perm_view_type perm(Kokkos::ViewAllocateWithoutInitializing("KokkosBatched::VBatchedGemm::perm"), nbatch);
+      auto perm_host = Kokkos::create_mirror_view(perm);
+
+      int bin_ptr[NumBins+1] = {}, bin_cnt[NumBins] = {};
+      for (int i=0;i<nbatch;++i)
+        ++bin_ptr[VBatchedGemmBins::bin(m_host(i), n_host(i), k_host(i)) + 1];
+      for (int b=0;b<NumBins;++b)
+        bin_ptr[b+1] += bin_ptr[b];
+      for (int i=0;i<nbatch;++i) {
+        const int b = VBatchedGemmBins::bin(m_host(i), n_host(i), k_host(i));
+        perm_host(bin_ptr[b] + bin_cnt[b]++) = i;
+      }
+      Kokkos::deep_copy(perm, perm_host);
+
+#if !defined(KOKKOSKERNELS_DISABLE_PROFILING_REGIONS)
+      double flops = 0, bytes = 0;
+      if (KokkosKernels::get_kernel_counts_callback())
+        for (int i=0;i<nbatch;++i) {
+          const double mi = m_host(i), ni = n_host(i), ki = k_host(i);
+          flops += 2*mi*ni*ki;
+          bytes += (mi*ki + ki*ni + 2*mi*ni)*sizeof(typename CViewType::non_const_value_type);
+        }
+      KOKKOSKERNELS_KERNEL_COUNTS("KokkosBatched::VBatchedGemm", flops, bytes);
+#endif
+
+      ///
+      /// one launch per bin
+      ///
+      typedef Functor_VBatchedGemm
+        <ArgTransA,ArgTransB,Algo::Gemm::Unblocked,
+         ScalarType,perm_view_type,SizeViewType,OffsetViewType,AViewType,BViewType,CViewType> functor_unblocked_type;
+      typedef Functor_VBatchedGemm
+        <ArgTransA,ArgTransB,Algo::Gemm::Blocked,
+         ScalarType,perm_view_type,SizeViewType,OffsetViewType,AViewType,BViewType,CViewType> functor_blocked_type;
+
+      for (int b=0;b<NumBins;++b) {
+        const int begin = bin_ptr[b], end = bin_ptr[b+1];
+        if (begin == end) continue;
+
+        if (b < 2) {
+          // tiny matrices do not benefit from register blocking
+          const Kokkos::RangePolicy<exec_space> policy(begin, end);
+          Kokkos::parallel_for("KokkosBatched::VBatchedGemm::SerialUnblocked", policy,
+                               functor_unblocked_type(alpha, perm, begin, m, n, k,
+                                                      A, a_offset, B, b_offset, beta, C, c_offset));
+        } else if (b < (NumBins-1)) {
+          const Kokkos::RangePolicy<exec_space> policy(begin, end);
+          Kokkos::parallel_for("KokkosBatched::VBatchedGemm::SerialBlocked", policy,
+                               functor_blocked_type(alpha, perm, begin, m, n, k,
+                                                    A, a_offset, B, b_offset, beta, C, c_offset));
+        } else {
+          // large matrices are mapped to a team so that a few of them still fill the device
+          const Kokkos::TeamPolicy<exec_space> policy(end - begin, Kokkos::AUTO);
+          Kokkos::parallel_for("KokkosBatched::VBatchedGemm::TeamBlocked", policy,
+                               functor_blocked_type(alpha, perm, begin, m, n, k,
+                                                    A, a_offset, B, b_offset, beta, C, c_offset));
+        }
+      }
+      return 0;
+    }
+
+  }
+}
+
+#endif
@@ -66,6 +66,34 @@ namespace KokkosBatched {
     KokkosBatched::Experimental::TeamGemvInternal<ALGOTYPE>           \
     ::invoke(MEMBER, N, M, ALPHA, A, AS1, AS0, X, XS, BETA, Y, YS)
 
+
+    ///
+    /// TeamVector Gemv
+    ///
+    /// Invoked by a single thread of a team on its own matrix; the entries
+    /// are distributed over the vector lanes of that thread
+    /// (ThreadVectorRange) so that a team processes team_size problems.
+    /// Only Algo::Gemv::Unblocked is provided.
+    ///
+
+    template<typename MemberType,
+             typename ArgTrans,
+             typename ArgAlgo>
+    struct TeamVectorGemv {
+      template<typename ScalarType,
+               typename AViewType,
+               typename xViewType,
+               typename yViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const ScalarType alpha,
+             const AViewType &A,
+             const xViewType &x,
+             const ScalarType beta,
+             const yViewType &y);
+    };
+
   }
 }
 
@@ -0,0 +1,72 @@
+#ifndef __KOKKOSBATCHED_GEMV_TEAMVECTOR_INTERNAL_HPP__
+#define __KOKKOSBATCHED_GEMV_TEAMVECTOR_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// TeamVector Internal Impl
+    /// ========================
+
+    template<typename ArgAlgo>
+    struct TeamVectorGemvInternal {
+      template<typename MemberType,
+               typename ScalarType,
+               typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const int m, const int n,
+             const ScalarType alpha,
+             const ValueType *__restrict__ A, const int as0, const int as1,
+             const ValueType *__restrict__ x, const int xs0,
+             const ScalarType beta,
+             /**/  ValueType *__restrict__ y, const int ys0);
+    };
+
+    template<>
+    template<typename MemberType,
+             typename ScalarType,
+             typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamVectorGemvInternal<Algo::Gemv::Unblocked>::
+    invoke(const MemberType &member,
+           const int m, const int n,
+           const ScalarType alpha,
+           const ValueType *__restrict__ A, const int as0, const int as1,
+           const ValueType *__restrict__ x, const int xs0,
+           const ScalarType beta,
+           /**/  ValueType *__restrict__ y, const int ys0) {
+      // y = beta y + alpha A x
+      // y (m), A(m x n), x(n)
+
+      const ScalarType zero(0.0);
+
+      if (m <= 0) return 0;
+
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,m),[&](const int &i) {
+          const ValueType *__restrict__ pA = A+i*as0;
+
+          ValueType t(0);
+          for (int j=0;j<n;++j)
+            t += pA[j*as1]*x[j*xs0];
+
+          ValueType &yi = y[i*ys0];
+          if (beta == zero) yi = alpha*t;
+          else              yi = beta*yi + alpha*t;
+        });
+      vector_barrier(member);
+
+      return 0;
+    }
+
+  }
+}
+
+#endif
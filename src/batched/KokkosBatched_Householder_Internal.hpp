@@ -0,0 +1,122 @@
+#ifndef __KOKKOSBATCHED_HOUSEHOLDER_INTERNAL_HPP__
+#define __KOKKOSBATCHED_HOUSEHOLDER_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Internal Impl
+    /// ==================== 
+
+    ///
+    /// generate a left Householder reflector 
+    ///   H [chi1; x2] = [alpha; 0], H = I - tau [1; v2] [1; v2]^T
+    /// chi1 := alpha, x2 := v2; tau is zero when x2 is already zero.
+    ///
+    struct SerialLeftHouseholderInternal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const int m_x2,
+             /* */ ValueType *chi1,
+             /* */ ValueType *__restrict__ x2, const int x2s,
+             /* */ ValueType *tau) {
+        typedef VectorLane<ValueType> lane_type;
+        typedef typename lane_type::value_type value_type;
+        typedef Kokkos::Details::ArithTraits<value_type> ats;
+
+        ValueType norm_x2_square(0);
+        for (int i=0;i<m_x2;++i) 
+          norm_x2_square += x2[i*x2s]*x2[i*x2s];
+
+        // scalar quantities are computed lane by lane
+        ValueType inv_chi1_minus_alpha(0);
+        for (int l=0;l<lane_type::vector_length;++l) {
+          value_type 
+            &chi1_l = lane_type::get(*chi1, l), 
+            &tau_l  = lane_type::get(*tau, l),
+            &inv_l  = lane_type::get(inv_chi1_minus_alpha, l);
+          const value_type norm_l = lane_type::get(norm_x2_square, l);
+          if (norm_l == value_type(0)) {
+            tau_l = 0; inv_l = 0;
+          } else {
+            value_type alpha = ats::sqrt(chi1_l*chi1_l + norm_l);
+            if (chi1_l > value_type(0)) alpha = -alpha;
+            tau_l = (alpha - chi1_l)/alpha;
+            inv_l = value_type(1)/(chi1_l - alpha);
+            chi1_l = alpha;
+          }
+        }
+
+        for (int i=0;i<m_x2;++i) 
+          x2[i*x2s] *= inv_chi1_minus_alpha;
+
+        return 0;
+      }
+    };
+
+    ///
+    /// apply a left Householder reflector to [a1t; A2] (1+m, n)
+    ///
+    struct SerialApplyLeftHouseholderInternal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const int m, const int n,
+             const ValueType *tau,
+             const ValueType *__restrict__ u2, const int u2s,
+             /* */ ValueType *__restrict__ a1t, const int a1ts,
+             /* */ ValueType *__restrict__ A2, const int as0, const int as1) {
+        for (int j=0;j<n;++j) {
+          ValueType w1t = a1t[j*a1ts];
+          for (int i=0;i<m;++i) 
+            w1t += u2[i*u2s]*A2[i*as0+j*as1];
+          w1t *= *tau;
+
+          a1t[j*a1ts] -= w1t;
+          for (int i=0;i<m;++i) 
+            A2[i*as0+j*as1] -= w1t*u2[i*u2s];
+        }
+        return 0;
+      }
+    };
+
+    ///
+    /// Team Internal Impl
+    /// ==================
+
+    ///
+    /// columns are distributed over the team 
+    ///
+    struct TeamApplyLeftHouseholderInternal {
+      template<typename MemberType,
+               typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const int m, const int n,
+             const ValueType *tau,
+             const ValueType *__restrict__ u2, const int u2s,
+             /* */ ValueType *__restrict__ a1t, const int a1ts,
+             /* */ ValueType *__restrict__ A2, const int as0, const int as1) {
+        Kokkos::parallel_for
+          (Kokkos::TeamThreadRange(member,0,n),
+           [&](const int &j) {
+            SerialApplyLeftHouseholderInternal::
+              invoke(m, 1, tau, u2, u2s, a1t+j*a1ts, a1ts, A2+j*as1, as0, as1);
+          });
+        return 0;
+      }
+    };
+
+  }
+}
+
+
+#endif
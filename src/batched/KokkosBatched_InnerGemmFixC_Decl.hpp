@@ -50,6 +50,24 @@ namespace KokkosBatched {
                         const int m, const int n, const int k,
                         /**/  ValueType *__restrict__ C);
 
+      // serial rank update of an (m x n) <= (mb x nb) tile accumulated in
+      // registers; C = op(i0+i, j0+j, beta C + alpha A B) is stored once.
+      // A and B may be of lower precision; they are widened to the value
+      // type of C which is used for accumulation
+      template<typename ScalarType,
+               typename ValueTypeAB,
+               typename ValueTypeC,
+               typename EpilogueType>
+      KOKKOS_INLINE_FUNCTION
+      int serial_invoke_epilogue(const ScalarType alpha,
+                                 const ScalarType beta,
+                                 const ValueTypeAB *__restrict__ A,
+                                 const ValueTypeAB *__restrict__ B,
+                                 const int m, const int n, const int k,
+                                 /**/  ValueTypeC *__restrict__ C,
+                                 const int i0, const int j0,
+                                 const EpilogueType &op);
+
       template<typename MemberType,
                typename ScalarType,
                typename ValueType>
@@ -1305,6 +1305,67 @@ namespace KokkosBatched {
       return serial_invoke(alpha, A, B, k, C);;
     }
 
+    ///
+    /// Inner kernel with epilogue (mb x nb)
+    /// ====================================
+
+    template<int mb, int nb>
+    template<typename ScalarType,
+             typename ValueTypeAB,
+             typename ValueTypeC,
+             typename EpilogueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    InnerGemmFixC<mb,nb>::
+    serial_invoke_epilogue(const ScalarType alpha,
+                           const ScalarType beta,
+                           const ValueTypeAB *__restrict__ A,
+                           const ValueTypeAB *__restrict__ B,
+                           const int m, const int n, const int k,
+                           /**/  ValueTypeC *__restrict__ C,
+                           const int i0, const int j0,
+                           const EpilogueType &op) {
+      if (m <= 0 || n <= 0) return 0;
+      const ScalarType zero(0.0);
+
+      ValueTypeC c[mb*nb];
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+      for (int ij=0;ij<(mb*nb);++ij)
+        c[ij] = 0;
+
+      for (int p=0;p<k;++p) {
+        ValueTypeC b[nb];
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+        for (int j=0;j<nb;++j)
+          b[j] = (j < n ? ValueTypeC(B[p*_bs0+j*_bs1]) : ValueTypeC(0));
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+        for (int i=0;i<mb;++i) {
+          if (i < m) {
+            const ValueTypeC a(A[i*_as0+p*_as1]);
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+            for (int j=0;j<nb;++j)
+              c[i*nb+j] += a*b[j];
+          }
+        }
+      }
+
+      for (int i=0;i<m;++i)
+        for (int j=0;j<n;++j) {
+          ValueTypeC &cij = C[i*_cs0+j*_cs1];
+          if (beta == zero) cij = op(i0+i, j0+j, ValueTypeC(alpha*c[i*nb+j]));
+          else              cij = op(i0+i, j0+j, ValueTypeC(beta*cij + alpha*c[i*nb+j]));
+        }
+      return 0;
+    }
+
   }
 }
 
@@ -0,0 +1,84 @@
+#ifndef __KOKKOSBATCHED_INVERSELU_DECL_HPP__
+#define __KOKKOSBATCHED_INVERSELU_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Vector.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Explicit inverse from the no piv LU factors
+    /// ===========================================
+    ///
+    /// On entry A (m x m) holds the factors computed by SerialLU/TeamLU;
+    /// on exit A is overwritten by inv(A). W (m x m) is a workspace. The
+    /// inverse is computed as inv(U) inv(L) I with two Trsm calls of the
+    /// given Algo::Trsm type.
+    ///
+    /// For small blocks applied many times (e.g., block Jacobi), the inverse
+    /// is applied with ApplyInverse which is a single Gemv instead of two
+    /// triangular solves.
+    ///
+
+    template<typename ArgAlgo>
+    struct SerialInverseLU {
+      template<typename AViewType,
+               typename WViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A,
+             const WViewType &W);
+    };
+
+    template<typename MemberType,
+             typename ArgAlgo>
+    struct TeamInverseLU {
+      template<typename AViewType,
+               typename WViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const AViewType &A,
+             const WViewType &W);
+    };
+
+    ///
+    /// x := op(inv(A)) b where Ainv is computed by InverseLU;
+    /// ArgAlgo is an Algo::Gemv type, Algo::Level2::Blocked is recommended.
+    ///
+
+    template<typename ArgTrans,
+             typename ArgAlgo>
+    struct SerialApplyInverse {
+      template<typename AViewType,
+               typename bViewType,
+               typename xViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &Ainv,
+             const bViewType &b,
+             const xViewType &x);
+    };
+
+    template<typename MemberType,
+             typename ArgTrans,
+             typename ArgAlgo>
+    struct TeamApplyInverse {
+      template<typename AViewType,
+               typename bViewType,
+               typename xViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const AViewType &Ainv,
+             const bViewType &b,
+             const xViewType &x);
+    };
+
+  }
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef __KOKKOSBATCHED_INVERSELU_SERIAL_IMPL_HPP__
+#define __KOKKOSBATCHED_INVERSELU_SERIAL_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Set_Internal.hpp"
+#include "KokkosBatched_Copy_Internal.hpp"
+#include "KokkosBatched_Trsm_Serial_Internal.hpp"
+#include "KokkosBatched_Gemv_Decl.hpp"
+#include "KokkosBatched_Gemv_Serial_Impl.hpp"
+
+#include "KokkosBatched_InverseLU_Decl.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Impl
+    /// ===========
+
+    ///
+    /// SerialInverseLU
+    ///
+
+    template<typename ArgAlgo>
+    template<typename AViewType,
+             typename WViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialInverseLU<ArgAlgo>::
+    invoke(const AViewType &A,
+           const WViewType &W) {
+      typedef typename AViewType::non_const_value_type value_type;
+      const typename MagnitudeScalarType<value_type>::type one(1.0), zero(0.0);
+
+      const int m = A.extent(0);
+      if (m <= 0) return 0;
+
+      value_type *__restrict__ w = W.data();
+      const int ws0 = W.stride_0(), ws1 = W.stride_1();
+
+      // W = I
+      SerialSetInternal::invoke(m, m, zero, w, ws0, ws1);
+      SerialSetInternal::invoke(m, one, w, ws0+ws1);
+
+      // W = inv(U) inv(L) W
+      SerialTrsmInternalLeftLower<ArgAlgo>::invoke(true,
+                                                   m, m,
+                                                   one,
+                                                   A.data(), A.stride_0(), A.stride_1(),
+                                                   w, ws0, ws1);
+      SerialTrsmInternalLeftUpper<ArgAlgo>::invoke(false,
+                                                   m, m,
+                                                   one,
+                                                   A.data(), A.stride_0(), A.stride_1(),
+                                                   w, ws0, ws1);
+
+      // A = W
+      SerialCopyInternal::invoke(m, m,
+                                 w, ws0, ws1,
+                                 A.data(), A.stride_0(), A.stride_1());
+      return 0;
+    }
+
+    ///
+    /// SerialApplyInverse
+    ///
+
+    template<typename ArgTrans,
+             typename ArgAlgo>
+    template<typename AViewType,
+             typename bViewType,
+             typename xViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialApplyInverse<ArgTrans,ArgAlgo>::
+    invoke(const AViewType &Ainv,
+           const bViewType &b,
+           const xViewType &x) {
+      typedef typename AViewType::non_const_value_type value_type;
+      const typename MagnitudeScalarType<value_type>::type one(1.0), zero(0.0);
+
+      return SerialGemv<ArgTrans,ArgAlgo>::invoke(one, Ainv, b, zero, x);
+    }
+
+  }
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef __KOKKOSBATCHED_INVERSELU_TEAM_IMPL_HPP__
+#define __KOKKOSBATCHED_INVERSELU_TEAM_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Set_Internal.hpp"
+#include "KokkosBatched_Copy_Internal.hpp"
+#include "KokkosBatched_Trsm_Team_Internal.hpp"
+#include "KokkosBatched_Gemv_Decl.hpp"
+#include "KokkosBatched_Gemv_Team_Impl.hpp"
+
+#include "KokkosBatched_InverseLU_Decl.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Team Impl
+    /// =========
+
+    ///
+    /// TeamInverseLU
+    ///
+
+    template<typename MemberType,
+             typename ArgAlgo>
+    template<typename AViewType,
+             typename WViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamInverseLU<MemberType,ArgAlgo>::
+    invoke(const MemberType &member,
+           const AViewType &A,
+           const WViewType &W) {
+      typedef typename AViewType::non_const_value_type value_type;
+      const typename MagnitudeScalarType<value_type>::type one(1.0), zero(0.0);
+
+      const int m = A.extent(0);
+      if (m <= 0) return 0;
+
+      value_type *__restrict__ w = W.data();
+      const int ws0 = W.stride_0(), ws1 = W.stride_1();
+
+      // W = I
+      TeamSetInternal::invoke(member, m, m, zero, w, ws0, ws1);
+      member.team_barrier();
+      TeamSetInternal::invoke(member, m, one, w, ws0+ws1);
+      member.team_barrier();
+
+      // W = inv(U) inv(L) W
+      TeamTrsmInternalLeftLower<ArgAlgo>::invoke(member,
+                                                 true,
+                                                 m, m,
+                                                 one,
+                                                 A.data(), A.stride_0(), A.stride_1(),
+                                                 w, ws0, ws1);
+      member.team_barrier();
+      TeamTrsmInternalLeftUpper<ArgAlgo>::invoke(member,
+                                                 false,
+                                                 m, m,
+                                                 one,
+                                                 A.data(), A.stride_0(), A.stride_1(),
+                                                 w, ws0, ws1);
+      member.team_barrier();
+
+      // A = W
+      TeamCopyInternal::invoke(member,
+                               m, m,
+                               w, ws0, ws1,
+                               A.data(), A.stride_0(), A.stride_1());
+      member.team_barrier();
+      return 0;
+    }
+
+    ///
+    /// TeamApplyInverse
+    ///
+
+    template<typename MemberType,
+             typename ArgTrans,
+             typename ArgAlgo>
+    template<typename AViewType,
+             typename bViewType,
+             typename xViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamApplyInverse<MemberType,ArgTrans,ArgAlgo>::
+    invoke(const MemberType &member,
+           const AViewType &Ainv,
+           const bViewType &b,
+           const xViewType &x) {
+      typedef typename AViewType::non_const_value_type value_type;
+      const typename MagnitudeScalarType<value_type>::type one(1.0), zero(0.0);
+
+      return TeamGemv<MemberType,ArgTrans,ArgAlgo>::invoke(member, one, Ainv, b, zero, x);
+    }
+
+  }
+}
+
+#endif
@@ -30,6 +30,88 @@ namespace KokkosBatched {
              const AViewType &A,
              const typename MagnitudeScalarType<typename AViewType::non_const_value_type>::type tiny = 0);
     };       
+
+    ///
+    /// TeamVector LU
+    ///
+    /// Invoked by a single thread of a team on its own matrix; the entries
+    /// are distributed over the vector lanes of that thread
+    /// (ThreadVectorRange) so that a team processes team_size problems.
+    /// Only Algo::LU::Unblocked is provided.
+    ///
+
+    template<typename MemberType,
+             typename ArgAlgo>
+    struct TeamVectorLU {
+      // no piv version
+      template<typename AViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const AViewType &A,
+             const typename MagnitudeScalarType<typename AViewType::non_const_value_type>::type tiny = 0);
+    };
+
+    ///
+    /// LU with partial pivoting; on exit P A = L U where P is given by 
+    /// sequential row interchanges, row p swapped with row ipiv(p).
+    /// With Vector<SIMD<T>,l> the pivots are chosen lane by lane and ipiv 
+    /// is a rank 2 integer view (min(m,n), l); otherwise ipiv is rank 1.
+    /// Use ApplyPivot on the right hand side before Trsv/Trsm.
+    /// Only Algo::LU::Unblocked is provided; returns p+1 when the p-th
+    /// pivot is zero in some lane, otherwise 0.
+    ///
+
+    template<typename ArgAlgo>
+    struct SerialLUPivot {
+      template<typename AViewType,
+               typename PivViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A,
+             const PivViewType &ipiv);
+    };       
+
+    template<typename MemberType,
+             typename ArgAlgo>
+    struct TeamLUPivot {
+      template<typename AViewType,
+               typename PivViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const AViewType &A,
+             const PivViewType &ipiv);
+    };       
+
+
+    ///
+    /// LU with mixed precision accumulation (no piv); A is stored in its
+    /// own value type, e.g., float, while every entry of L and U is computed
+    /// as one dot product accumulated in AccumulationValueType, e.g., double,
+    /// and rounded once (Crout ordering). Used for the low precision factors
+    /// of iterative refinement. Only Algo::LU::Unblocked is provided.
+    ///
+
+    template<typename ArgAlgo>
+    struct SerialLUMixed {
+      template<typename AViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A,
+             const typename MagnitudeScalarType<typename AViewType::non_const_value_type>::type tiny = 0);
+    };       
+
+    template<typename MemberType,
+             typename ArgAlgo>
+    struct TeamLUMixed {
+      template<typename AViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const AViewType &A,
+             const typename MagnitudeScalarType<typename AViewType::non_const_value_type>::type tiny = 0);
+    };       
       
   }
 }
@@ -79,6 +79,39 @@ namespace KokkosBatched {
                                                           tiny);
     }
 
+    ///
+    /// SerialLU partial piv
+    ///
+
+    template<>
+    template<typename AViewType,
+             typename PivViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialLUPivot<Algo::LU::Unblocked>::
+    invoke(const AViewType &A,
+           const PivViewType &ipiv) {
+      return SerialLU_Pivot_Internal<Algo::LU::Unblocked>::invoke(A.extent(0), A.extent(1),
+                                                                  A.data(), A.stride_0(), A.stride_1(),
+                                                                  ipiv.data(), ipiv.stride_0(), ipiv.stride_1());
+    }
+
+    ///
+    /// SerialLU mixed precision accumulation
+    ///
+
+    template<>
+    template<typename AViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialLUMixed<Algo::LU::Unblocked>::
+    invoke(const AViewType &A,
+           const typename MagnitudeScalarType<typename AViewType::non_const_value_type>::type tiny) {
+      return SerialLUMixed_Internal<Algo::LU::Unblocked>::invoke(A.extent(0), A.extent(1),
+                                                                 A.data(), A.stride_0(), A.stride_1(),
+                                                                 tiny);
+    }
+
   }
 }
 
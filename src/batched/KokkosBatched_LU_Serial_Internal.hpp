@@ -140,6 +140,157 @@ namespace KokkosBatched {
       return 0;
     }
 
+    ///
+    /// Serial Internal Impl with partial pivoting
+    /// ==========================================
+
+    template<typename AlgoType>
+    struct SerialLU_Pivot_Internal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int 
+      invoke(const int m, const int n,
+             ValueType *__restrict__ A, const int as0, const int as1,
+             int *__restrict__ ipiv, const int ips0, const int ips1);
+    };
+
+    template<>
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialLU_Pivot_Internal<Algo::LU::Unblocked>::
+    invoke(const int m, const int n,
+           ValueType *__restrict__ A, const int as0, const int as1,
+           int *__restrict__ ipiv, const int ips0, const int ips1) {
+      typedef VectorLane<ValueType> lane_type;
+      typedef typename lane_type::value_type value_type;
+      typedef Kokkos::Details::ArithTraits<value_type> ats;
+      typedef typename ats::mag_type mag_type;
+
+      const int k = (m < n ? m : n);
+      if (k <= 0) return 0;
+
+      int r_val = 0;
+      for (int p=0;p<k;++p) {
+        const int iend = m-p-1, jend = n-p-1;
+
+        // pivot search and row interchange lane by lane
+        for (int l=0;l<lane_type::vector_length;++l) {
+          int piv = p;
+          mag_type amax = ats::abs(lane_type::get(A[p*as0+p*as1], l));
+          for (int i=p+1;i<m;++i) {
+            const mag_type val = ats::abs(lane_type::get(A[i*as0+p*as1], l));
+            if (val > amax) { amax = val; piv = i; }
+          }
+          ipiv[p*ips0+l*ips1] = piv;
+          if (amax == mag_type(0) && r_val == 0) r_val = p+1;
+
+          if (piv != p) {
+            for (int j=0;j<n;++j) {
+              value_type 
+                &a = lane_type::get(A[p  *as0+j*as1], l),
+                &b = lane_type::get(A[piv*as0+j*as1], l);
+              const value_type tmp = a; a = b; b = tmp;
+            }
+          }
+        }
+
+        const ValueType
+          *__restrict__ a12t = A+(p  )*as0+(p+1)*as1;
+        
+        ValueType
+          *__restrict__ a21  = A+(p+1)*as0+(p  )*as1,
+          *__restrict__ A22  = A+(p+1)*as0+(p+1)*as1;
+
+        const ValueType
+          alpha11 = A[p*as0+p*as1];
+
+        // a zero pivot leaves its column unscaled as in getf2; its column is zero,
+        // so the update below is a no-op in that lane
+        const value_type zero(0);
+        bool is_pivot_nonzero = true;
+        for (int l=0;l<lane_type::vector_length;++l)
+          if (lane_type::get(alpha11, l) == zero) is_pivot_nonzero = false;
+
+        for (int i=0;i<iend;++i) {
+          if (is_pivot_nonzero)
+            a21[i*as0] /= alpha11;
+          else
+            for (int l=0;l<lane_type::vector_length;++l)
+              if (lane_type::get(alpha11, l) != zero)
+                lane_type::get(a21[i*as0], l) /= lane_type::get(alpha11, l);
+
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+          for (int j=0;j<jend;++j)
+            A22[i*as0+j*as1] -= a21[i*as0] * a12t[j*as1];
+        }
+      }
+      return r_val;
+    }
+
+    ///
+    /// Mixed precision (Crout)
+    /// =======================
+    ///
+    /// u_pj = a_pj - sum_q l_pq u_qj and l_ip = (a_ip - sum_q l_iq u_qp)/u_pp
+    /// are accumulated in AccumulationValueType<ValueType> and rounded once
+    /// when stored; the stored pivot is used so that L U reproduces A.
+    ///
+
+    template<typename AlgoType>
+    struct SerialLUMixed_Internal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int 
+      invoke(const int m, const int n,
+             ValueType *__restrict__ A, const int as0, const int as1,
+             const typename MagnitudeScalarType<ValueType>::type tiny);
+    };
+
+    template<>
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialLUMixed_Internal<Algo::LU::Unblocked>::
+    invoke(const int m, const int n,
+           ValueType *__restrict__ A, const int as0, const int as1,
+           const typename MagnitudeScalarType<ValueType>::type tiny) {
+      typedef typename AccumulationValueType<ValueType>::type accum_type;
+
+      const int k = (m < n ? m : n);
+      if (k <= 0) return 0;
+
+      const auto       abs_tiny =  tiny > 0 ? tiny : -tiny;
+      const auto minus_abs_tiny = -abs_tiny;
+
+      for (int p=0;p<k;++p) {
+        // row p of U
+        for (int j=p;j<n;++j) {
+          accum_type u(A[p*as0+j*as1]);
+          for (int q=0;q<p;++q)
+            u -= accum_type(A[p*as0+q*as1])*accum_type(A[q*as0+j*as1]);
+          if (j == p && tiny != 0) {
+            const auto u_real = Kokkos::Details::ArithTraits<accum_type>::real(u);
+            u += accum_type(minus_abs_tiny)*accum_type(u_real <  0);
+            u += accum_type(      abs_tiny)*accum_type(u_real >= 0);
+          }
+          A[p*as0+j*as1] = ValueType(u);
+        }
+
+        // column p of L
+        const accum_type alpha11(A[p*as0+p*as1]);
+        for (int i=p+1;i<m;++i) {
+          accum_type l(A[i*as0+p*as1]);
+          for (int q=0;q<p;++q)
+            l -= accum_type(A[i*as0+q*as1])*accum_type(A[q*as0+p*as1]);
+          A[i*as0+p*as1] = ValueType(l/alpha11);
+        }
+      }
+      return 0;
+    }
+
   }
 }
 
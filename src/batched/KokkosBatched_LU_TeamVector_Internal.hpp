@@ -0,0 +1,84 @@
+#ifndef __KOKKOSBATCHED_LU_TEAMVECTOR_INTERNAL_HPP__
+#define __KOKKOSBATCHED_LU_TEAMVECTOR_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// TeamVector Internal Impl
+    /// ========================
+
+    template<typename AlgoType>
+    struct TeamVectorLU_Internal {
+      template<typename MemberType, typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const int m, const int n,
+             ValueType *__restrict__ A, const int as0, const int as1,
+             const typename MagnitudeScalarType<ValueType>::type tiny);
+    };
+
+    template<>
+    template<typename MemberType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamVectorLU_Internal<Algo::LU::Unblocked>::
+    invoke(const MemberType &member,
+           const int m, const int n,
+           ValueType *__restrict__ A, const int as0, const int as1,
+           const typename MagnitudeScalarType<ValueType>::type tiny) {
+
+      const int k = (m < n ? m : n);
+      if (k <= 0) return 0;
+
+      const auto       abs_tiny =  tiny > 0 ? tiny : -tiny;
+      const auto minus_abs_tiny = -abs_tiny;
+
+      for (int p=0;p<k;++p) {
+        const int iend = m-p-1, jend = n-p-1;
+
+        const ValueType
+          *__restrict__ a12t = A+(p  )*as0+(p+1)*as1;
+
+        ValueType
+          *__restrict__ a21  = A+(p+1)*as0+(p  )*as1,
+          *__restrict__ A22  = A+(p+1)*as0+(p+1)*as1;
+
+        if (tiny != 0) {
+          Kokkos::single(Kokkos::PerThread(member), [&]() {
+              ValueType &alpha11_reference = A[p*as0+p*as1];
+              const auto alpha11_real = Kokkos::Details::ArithTraits<ValueType>::real(alpha11_reference);
+              alpha11_reference += minus_abs_tiny*ValueType(alpha11_real <  0);
+              alpha11_reference +=       abs_tiny*ValueType(alpha11_real >= 0);
+            });
+          vector_barrier(member);
+        }
+
+        const ValueType
+          alpha11 = A[p*as0+p*as1];
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,iend),[&](const int &i) {
+            a21[i*as0] /= alpha11;
+          });
+        vector_barrier(member);
+
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,iend*jend),[&](const int &ij) {
+            const int i = ij/jend, j = ij%jend;
+            A22[i*as0+j*as1] -= a21[i*as0] * a12t[j*as1];
+          });
+        vector_barrier(member);
+      }
+      return 0;
+    }
+
+  }
+}
+
+#endif
@@ -46,6 +46,43 @@ namespace KokkosBatched {
       }
     };
 
+    ///
+    /// LU partial piv
+    ///
+
+    template<typename MemberType>
+    struct TeamLUPivot<MemberType,Algo::LU::Unblocked> {
+      template<typename AViewType,
+               typename PivViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, const AViewType &A,
+             const PivViewType &ipiv) {
+        return TeamLU_Pivot_Internal<Algo::LU::Unblocked>::invoke(member,
+                                                                  A.extent(0), A.extent(1),
+                                                                  A.data(), A.stride_0(), A.stride_1(),
+                                                                  ipiv.data(), ipiv.stride_0(), ipiv.stride_1());
+      }
+    };
+
+    ///
+    /// LU mixed precision accumulation
+    ///
+
+    template<typename MemberType>
+    struct TeamLUMixed<MemberType,Algo::LU::Unblocked> {
+      template<typename AViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, const AViewType &A,
+             const typename MagnitudeScalarType<typename AViewType::non_const_value_type>::type tiny = 0) {
+        return TeamLUMixed_Internal<Algo::LU::Unblocked>::invoke(member,
+                                                                 A.extent(0), A.extent(1),
+                                                                 A.data(), A.stride_0(), A.stride_1(),
+                                                                 tiny);
+      }
+    };
+
   }
 }
 
@@ -170,6 +170,175 @@ namespace KokkosBatched {
 
       return 0;
     }
+
+    ///
+    /// Team Internal Impl with partial pivoting
+    /// ========================================
+
+    template<typename AlgoType>
+    struct TeamLU_Pivot_Internal {
+      template<typename MemberType, typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int 
+      invoke(const MemberType &member,
+             const int m, const int n,
+             ValueType *__restrict__ A, const int as0, const int as1,
+             int *__restrict__ ipiv, const int ips0, const int ips1);
+    };
+
+    template<>
+    template<typename MemberType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamLU_Pivot_Internal<Algo::LU::Unblocked>::
+    invoke(const MemberType &member, 
+           const int m, const int n,
+           ValueType *__restrict__ A, const int as0, const int as1,
+           int *__restrict__ ipiv, const int ips0, const int ips1) {
+      typedef VectorLane<ValueType> lane_type;
+      typedef typename lane_type::value_type value_type;
+      typedef Kokkos::Details::ArithTraits<value_type> ats;
+      typedef typename ats::mag_type mag_type;
+
+      const int k = (m < n ? m : n);
+      if (k <= 0) return 0;
+
+      const int vl = lane_type::vector_length;
+      int r_val = 0;
+      for (int p=0;p<k;++p) {
+        const int iend = m-p-1, jend = n-p-1;
+
+        // pivot search lane by lane
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,vl),[&](const int &l) {
+            int piv = p;
+            mag_type amax = ats::abs(lane_type::get(A[p*as0+p*as1], l));
+            for (int i=p+1;i<m;++i) {
+              const mag_type val = ats::abs(lane_type::get(A[i*as0+p*as1], l));
+              if (val > amax) { amax = val; piv = i; }
+            }
+            ipiv[p*ips0+l*ips1] = piv;
+          });
+        member.team_barrier();
+
+        // row interchange; lanes that do not pivot are left untouched
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,vl*n),[&](const int &lj) {
+            const int l = lj/n, j = lj%n, piv = ipiv[p*ips0+l*ips1];
+            if (piv != p) {
+              value_type 
+                &a = lane_type::get(A[p  *as0+j*as1], l),
+                &b = lane_type::get(A[piv*as0+j*as1], l);
+              const value_type tmp = a; a = b; b = tmp;
+            }
+          });
+        member.team_barrier();
+
+        const ValueType 
+          *__restrict__ a12t = A+(p  )*as0+(p+1)*as1;
+
+        ValueType
+          *__restrict__ a21  = A+(p+1)*as0+(p  )*as1,
+          *__restrict__ A22  = A+(p+1)*as0+(p+1)*as1;
+
+        const ValueType
+          alpha11 = A[p*as0+p*as1];
+
+        // every thread sees the same pivot
+        const value_type zero(0);
+        bool is_pivot_nonzero = true;
+        for (int l=0;l<vl;++l)
+          if (lane_type::get(alpha11, l) == zero) {
+            is_pivot_nonzero = false;
+            if (r_val == 0) r_val = p+1;
+          }
+
+        // a zero pivot leaves its column unscaled as in getf2; its column is zero,
+        // so the update below is a no-op in that lane
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,iend),[&](const int &i) {
+            if (is_pivot_nonzero)
+              a21[i*as0] /= alpha11;
+            else
+              for (int l=0;l<vl;++l)
+                if (lane_type::get(alpha11, l) != zero)
+                  lane_type::get(a21[i*as0], l) /= lane_type::get(alpha11, l);
+          });
+            
+        member.team_barrier();
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,iend*jend),[&](const int &ij) {
+            // assume layout right for batched computation
+            const int i = ij/jend, j = ij%jend;
+            A22[i*as0+j*as1] -= a21[i*as0] * a12t[j*as1];
+          });
+        member.team_barrier();
+      }
+      return r_val;
+    }
+
+    ///
+    /// Mixed precision (Crout)
+    /// =======================
+    ///
+    /// see SerialLUMixed_Internal; a row of U and then a column of L are
+    /// distributed over the team at each step.
+    ///
+
+    template<typename AlgoType>
+    struct TeamLUMixed_Internal {
+      template<typename MemberType, typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int 
+      invoke(const MemberType &member,
+             const int m, const int n,
+             ValueType *__restrict__ A, const int as0, const int as1,
+             const typename MagnitudeScalarType<ValueType>::type tiny);
+    };
+
+    template<>
+    template<typename MemberType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamLUMixed_Internal<Algo::LU::Unblocked>::
+    invoke(const MemberType &member, 
+           const int m, const int n,
+           ValueType *__restrict__ A, const int as0, const int as1,
+           const typename MagnitudeScalarType<ValueType>::type tiny) {
+      typedef typename AccumulationValueType<ValueType>::type accum_type;
+
+      const int k = (m < n ? m : n);
+      if (k <= 0) return 0;
+
+      const auto       abs_tiny =  tiny > 0 ? tiny : -tiny;
+      const auto minus_abs_tiny = -abs_tiny;
+
+      for (int p=0;p<k;++p) {
+        // row p of U
+        member.team_barrier();
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,n-p),[&](const int &jj) {
+            const int j = p+jj;
+            accum_type u(A[p*as0+j*as1]);
+            for (int q=0;q<p;++q)
+              u -= accum_type(A[p*as0+q*as1])*accum_type(A[q*as0+j*as1]);
+            if (j == p && tiny != 0) {
+              const auto u_real = Kokkos::Details::ArithTraits<accum_type>::real(u);
+              u += accum_type(minus_abs_tiny)*accum_type(u_real <  0);
+              u += accum_type(      abs_tiny)*accum_type(u_real >= 0);
+            }
+            A[p*as0+j*as1] = ValueType(u);
+          });
+
+        // column p of L
+        member.team_barrier();
+        const accum_type alpha11(A[p*as0+p*as1]);
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,m-p-1),[&](const int &ii) {
+            const int i = p+1+ii;
+            accum_type l(A[i*as0+p*as1]);
+            for (int q=0;q<p;++q)
+              l -= accum_type(A[i*as0+q*as1])*accum_type(A[q*as0+p*as1]);
+            A[i*as0+p*as1] = ValueType(l/alpha11);
+          });
+      }
+      return 0;
+    }
+
   }
 }
 
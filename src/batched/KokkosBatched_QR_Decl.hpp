@@ -0,0 +1,79 @@
+#ifndef __KOKKOSBATCHED_QR_DECL_HPP__
+#define __KOKKOSBATCHED_QR_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Vector.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Householder QR of a real m x n matrix (m >= n); A = Q R.
+    /// R overwrites the upper triangle of A and the Householder vectors 
+    /// (with implicit unit leading entry) are stored below the diagonal; 
+    /// t(p) holds the scalar factor of the p-th reflector,
+    /// H(p) = I - t(p) v(p) v(p)^T and Q = H(0) H(1) ... H(n-1). 
+    /// With Vector<SIMD<T>,l> every lane is an independent matrix and a 
+    /// pack is factored in lockstep. Only Algo::QR::Unblocked is provided.
+    ///
+      
+    template<typename ArgAlgo>
+    struct SerialQR {
+      template<typename AViewType,
+               typename tViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A,
+             const tViewType &t);
+    };       
+
+    template<typename MemberType,
+             typename ArgAlgo>
+    struct TeamQR {
+      template<typename AViewType,
+               typename tViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const AViewType &A,
+             const tViewType &t);
+    };       
+
+    ///
+    /// Least squares solve min || A x - b || with A factored by QR;
+    /// b := Q^T b and the leading n rows are overwritten by x = inv(R) b.
+    /// B may be a vector or a multivector (m x nrhs).
+    ///
+
+    template<typename ArgAlgo>
+    struct SerialSolveLeastSquares {
+      template<typename AViewType,
+               typename tViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const AViewType &A,
+             const tViewType &t,
+             const BViewType &B);
+    };       
+
+    template<typename MemberType,
+             typename ArgAlgo>
+    struct TeamSolveLeastSquares {
+      template<typename AViewType,
+               typename tViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const AViewType &A,
+             const tViewType &t,
+             const BViewType &B);
+    };       
+      
+  }
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef __KOKKOSBATCHED_QR_SERIAL_IMPL_HPP__
+#define __KOKKOSBATCHED_QR_SERIAL_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_QR_Serial_Internal.hpp"
+#include "KokkosBatched_ApplyQ_Internal.hpp"
+#include "KokkosBatched_Trsm_Serial_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Impl
+    /// ===========
+
+    ///
+    /// SerialQR
+    ///
+
+    template<>
+    template<typename AViewType,
+             typename tViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialQR<Algo::QR::Unblocked>::
+    invoke(const AViewType &A,
+           const tViewType &t) {
+      return SerialQR_Internal<Algo::QR::Unblocked>::invoke(A.extent(0), A.extent(1),
+                                                            A.data(), A.stride_0(), A.stride_1(),
+                                                            t.data(), t.stride_0());
+    }
+
+    ///
+    /// SerialSolveLeastSquares
+    ///
+
+    template<>
+    template<typename AViewType,
+             typename tViewType,
+             typename BViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialSolveLeastSquares<Algo::QR::Unblocked>::
+    invoke(const AViewType &A,
+           const tViewType &t,
+           const BViewType &B) {
+      const int m = B.extent(0), n = A.extent(1), nrhs = B.extent(1);
+
+      // B := Q^T B
+      SerialApplyQ_LeftInternal::
+        invoke(true,
+               m, nrhs, n,
+               A.data(), A.stride_0(), A.stride_1(),
+               t.data(), t.stride_0(),
+               B.data(), B.stride_0(), B.stride_1());
+
+      // B(0:n,:) := inv(R) B(0:n,:)
+      return SerialTrsmInternalLeftUpper<Algo::Trsm::Unblocked>::
+        invoke(false,
+               n, nrhs,
+               1.0,
+               A.data(), A.stride_0(), A.stride_1(),
+               B.data(), B.stride_0(), B.stride_1());
+    }
+
+  }
+}
+
+#endif
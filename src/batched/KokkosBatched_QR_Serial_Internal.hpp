@@ -0,0 +1,64 @@
+#ifndef __KOKKOSBATCHED_QR_SERIAL_INTERNAL_HPP__
+#define __KOKKOSBATCHED_QR_SERIAL_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+#include "KokkosBatched_Householder_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+  
+    ///
+    /// Serial Internal Impl
+    /// ====================
+
+    template<typename AlgoType>
+    struct SerialQR_Internal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int 
+      invoke(const int m, const int n,
+             ValueType *__restrict__ A, const int as0, const int as1,
+             ValueType *__restrict__ t, const int ts);
+    };
+
+    template<>
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialQR_Internal<Algo::QR::Unblocked>::
+    invoke(const int m, const int n,
+           ValueType *__restrict__ A, const int as0, const int as1,
+           ValueType *__restrict__ t, const int ts) {
+      const int k = (m < n ? m : n);
+      if (k <= 0) return 0;
+
+      for (int p=0;p<k;++p) {
+        const int m_A22 = m-p-1, n_A22 = n-p-1;
+
+        ValueType
+          *__restrict__ alpha11 = A+(p  )*as0+(p  )*as1,
+          *__restrict__ a21     = A+(p+1)*as0+(p  )*as1,
+          *__restrict__ a12t    = A+(p  )*as0+(p+1)*as1,
+          *__restrict__ A22     = A+(p+1)*as0+(p+1)*as1,
+          *__restrict__ tau     = t+p*ts;
+
+        // reflector annihilating a21
+        SerialLeftHouseholderInternal::
+          invoke(m_A22, alpha11, a21, as0, tau);
+
+        // update trailing columns
+        SerialApplyLeftHouseholderInternal::
+          invoke(m_A22, n_A22, tau, a21, as0, a12t, as1, A22, as0, as1);
+      }
+      return 0;
+    }
+
+  }
+}
+
+#endif
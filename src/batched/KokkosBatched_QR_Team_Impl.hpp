@@ -0,0 +1,80 @@
+#ifndef __KOKKOSBATCHED_QR_TEAM_IMPL_HPP__
+#define __KOKKOSBATCHED_QR_TEAM_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_QR_Team_Internal.hpp"
+#include "KokkosBatched_ApplyQ_Internal.hpp"
+#include "KokkosBatched_Trsm_Team_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Team Impl
+    /// =========
+
+    ///
+    /// TeamQR
+    ///
+    
+    template<typename MemberType>
+    struct TeamQR<MemberType,Algo::QR::Unblocked> {
+      template<typename AViewType,
+               typename tViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const AViewType &A,
+             const tViewType &t) {
+        return TeamQR_Internal<Algo::QR::Unblocked>::invoke(member,
+                                                            A.extent(0), A.extent(1),
+                                                            A.data(), A.stride_0(), A.stride_1(),
+                                                            t.data(), t.stride_0());
+      }
+    };
+
+    ///
+    /// TeamSolveLeastSquares
+    ///
+    
+    template<typename MemberType>
+    struct TeamSolveLeastSquares<MemberType,Algo::QR::Unblocked> {
+      template<typename AViewType,
+               typename tViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const AViewType &A,
+             const tViewType &t,
+             const BViewType &B) {
+        const int m = B.extent(0), n = A.extent(1), nrhs = B.extent(1);
+
+        // B := Q^T B
+        TeamApplyQ_LeftInternal::
+          invoke(member,
+                 true,
+                 m, nrhs, n,
+                 A.data(), A.stride_0(), A.stride_1(),
+                 t.data(), t.stride_0(),
+                 B.data(), B.stride_0(), B.stride_1());
+        member.team_barrier();
+
+        // B(0:n,:) := inv(R) B(0:n,:)
+        return TeamTrsmInternalLeftUpper<Algo::Trsm::Unblocked>::
+          invoke(member,
+                 false,
+                 n, nrhs,
+                 1.0,
+                 A.data(), A.stride_0(), A.stride_1(),
+                 B.data(), B.stride_0(), B.stride_1());
+      }
+    };
+
+  }
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef __KOKKOSBATCHED_STREAMINGBATCH_DECL_HPP__
+#define __KOKKOSBATCHED_STREAMINGBATCH_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "Kokkos_Core.hpp"
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+#include "KokkosBatched_CompactBatch_Decl.hpp"
+
+#include "KokkosBatched_LU_Decl.hpp"
+#include "KokkosBatched_Trsm_Decl.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Streaming batch
+    /// ===============
+    ///
+    /// Applies a pack level operation to a batch of A(nmatrices, m, n) and
+    /// B(nmatrices, m, nrhs) scalar matrices residing in host memory, in
+    /// chunks of chunk_size matrices, so that the batch need not fit in
+    /// the memory of ExecSpace. The operation is a device functor
+    ///
+    ///   KOKKOS_INLINE_FUNCTION
+    ///   void operator()(const AViewType &A, const BViewType &B) const;
+    ///
+    /// invoked on the (m x n) and (m x nrhs) pack subviews of a CompactBatch
+    /// of ValueType; A and B are overwritten by the result.
+    ///
+    /// Each chunk is uploaded, packed, computed, unpacked and downloaded on
+    /// one of two execution space instances (CUDA streams), in alternation,
+    /// with its own pinned staging and device buffers; while one chunk is
+    /// computed on the device, the other is copied between the user views
+    /// and its staging buffers on the host and transferred over the bus.
+    /// When ExecSpace can access the user views, chunks are packed from and
+    /// unpacked to them in place.
+    ///
+    /// chunk_size is rounded up to a multiple of the vector length so that
+    /// only the last pack of the batch is partial.
+    ///
+
+    template<typename ExecSpace,
+             typename ValueType,
+             typename OperatorType,
+             typename AViewType,
+             typename BViewType>
+    void
+    streaming_batch_invoke(const OperatorType &op,
+                           const AViewType &A,
+                           const BViewType &B,
+                           const int chunk_size);
+
+    ///
+    /// Streamed LU without pivoting and solve, A := LU, B := A^{-1} B
+    ///
+
+    template<typename ArgAlgoLU,
+             typename ArgAlgoTrsm>
+    struct StreamingLUSolve {
+      template<typename AViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const AViewType &A,
+                      const BViewType &B) const;
+    };
+
+    template<typename ExecSpace,
+             typename ValueType,
+             typename AViewType,
+             typename BViewType>
+    void
+    streaming_batched_lu_solve(const AViewType &A,
+                               const BViewType &B,
+                               const int chunk_size);
+
+  }
+}
+
+#endif
@@ -0,0 +1,323 @@
+#ifndef __KOKKOSBATCHED_STREAMINGBATCH_IMPL_HPP__
+#define __KOKKOSBATCHED_STREAMINGBATCH_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include <sstream>
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_CompactBatch_Decl.hpp"
+#include "KokkosBatched_CompactBatch_Impl.hpp"
+#include "KokkosBatched_StreamingBatch_Decl.hpp"
+
+#include "KokkosBatched_LU_Serial_Impl.hpp"
+#include "KokkosBatched_Trsm_Serial_Impl.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Host staging memory for transfers to a memory space; pinned for
+    /// CUDA so that the copies are asynchronous.
+    ///
+
+    template<typename MemorySpace>
+    struct StreamingBatchStagingSpace {
+      typedef Kokkos::HostSpace type;
+    };
+
+#if defined(KOKKOS_ENABLE_CUDA)
+    template<>
+    struct StreamingBatchStagingSpace<Kokkos::CudaSpace> {
+      typedef Kokkos::CudaHostPinnedSpace type;
+    };
+#endif
+
+    ///
+    /// The two execution space instances the chunks alternate on; default
+    /// instances unless the backend has streams.
+    ///
+
+    template<typename ExecSpace>
+    class StreamingBatchPipelines {
+    private:
+      ExecSpace _space[2];
+
+    public:
+      StreamingBatchPipelines() {}
+
+      const ExecSpace &space(const int k) const { return _space[k]; }
+    };
+
+#if defined(KOKKOS_ENABLE_CUDA)
+    template<>
+    class StreamingBatchPipelines<Kokkos::Cuda> {
+    private:
+      cudaStream_t _stream[2];
+      Kokkos::Cuda _space[2];
+
+      StreamingBatchPipelines(const StreamingBatchPipelines &);
+      StreamingBatchPipelines &operator=(const StreamingBatchPipelines &);
+
+    public:
+      StreamingBatchPipelines() {
+        for (int k=0;k<2;++k) {
+          cudaStreamCreate(&_stream[k]);
+          _space[k] = Kokkos::Cuda(_stream[k]);
+        }
+      }
+
+      ~StreamingBatchPipelines() {
+        for (int k=0;k<2;++k) {
+          _space[k].fence();
+          _space[k] = Kokkos::Cuda();
+          cudaStreamDestroy(_stream[k]);
+        }
+      }
+
+      const Kokkos::Cuda &space(const int k) const { return _space[k]; }
+    };
+#endif
+
+    ///
+    /// Device level functors
+    /// =====================
+    ///
+
+    template<typename VectorViewType,
+             typename OperatorType>
+    struct Functor_StreamingBatch {
+      VectorViewType _a, _b;
+      OperatorType _op;
+
+      Functor_StreamingBatch(const VectorViewType &a,
+                             const VectorViewType &b,
+                             const OperatorType &op)
+        : _a(a), _b(b), _op(op) {}
+
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const int p) const {
+        auto aa = Kokkos::subview(_a, p, Kokkos::ALL(), Kokkos::ALL());
+        auto bb = Kokkos::subview(_b, p, Kokkos::ALL(), Kokkos::ALL());
+        _op(aa, bb);
+      }
+    };
+
+    /// host copy of a chunk between the user views and the staging buffers;
+    /// run on the host execution space so that no device work is fenced
+    template<typename DstViewType,
+             typename SrcViewType>
+    struct Functor_StreamingBatchCopy {
+      DstViewType _dst;
+      SrcViewType _src;
+      int _m, _n;
+
+      Functor_StreamingBatchCopy(const DstViewType &dst,
+                                 const SrcViewType &src)
+        : _dst(dst), _src(src), _m(src.extent(1)), _n(src.extent(2)) {}
+
+      KOKKOS_INLINE_FUNCTION
+      void operator()(const int k) const {
+        for (int i=0;i<_m;++i)
+          for (int j=0;j<_n;++j)
+            _dst(k,i,j) = _src(k,i,j);
+      }
+    };
+
+    template<typename DstViewType,
+             typename SrcViewType>
+    inline
+    void
+    streaming_batch_host_copy(const DstViewType &dst,
+                              const SrcViewType &src) {
+      typedef Kokkos::DefaultHostExecutionSpace host_space;
+      typedef Functor_StreamingBatchCopy<DstViewType,SrcViewType> functor_type;
+
+      const host_space space;
+      Kokkos::parallel_for("KokkosBatched::streaming_batch_host_copy",
+                           Kokkos::RangePolicy<host_space>(0, src.extent(0)),
+                           functor_type(dst, src));
+      space.fence();
+    }
+
+    ///
+    /// streaming_batch_invoke
+    ///
+
+    template<typename ExecSpace,
+             typename ValueType,
+             typename OperatorType,
+             typename AViewType,
+             typename BViewType>
+    void
+    streaming_batch_invoke(const OperatorType &op,
+                           const AViewType &A,
+                           const BViewType &B,
+                           const int chunk_size) {
+      typedef typename ExecSpace::execution_space execution_space;
+      typedef typename ExecSpace::memory_space memory_space;
+      typedef typename AViewType::non_const_value_type scalar_type;
+      typedef CompactBatch<ExecSpace,ValueType> compact_batch_type;
+      typedef typename compact_batch_type::value_array_type value_array_type;
+      typedef typename StreamingBatchStagingSpace<memory_space>::type staging_space;
+      typedef Kokkos::View<scalar_type***,Kokkos::LayoutRight,staging_space> staging_view_type;
+      typedef Kokkos::View<scalar_type***,Kokkos::LayoutRight,ExecSpace> device_view_type;
+      typedef Functor_StreamingBatch<value_array_type,OperatorType> functor_type;
+      typedef Kokkos::pair<int,int> range_type;
+      enum : int { vector_length = ValueType::vector_length };
+
+      static_assert(AViewType::rank == 3 && BViewType::rank == 3,
+                    "KokkosBatched::streaming_batch_invoke: A and B must be rank 3 views");
+      static_assert(std::is_same<scalar_type,typename BViewType::non_const_value_type>::value,
+                    "KokkosBatched::streaming_batch_invoke: A and B must have the same value type");
+      static_assert(std::is_same<scalar_type,typename compact_batch_type::scalar_type>::value,
+                    "KokkosBatched::streaming_batch_invoke: the views must hold the scalar type of ValueType");
+
+      const int nmatrices = A.extent(0), m = A.extent(1), n = A.extent(2), nrhs = B.extent(2);
+      if (int(B.extent(0)) != nmatrices || int(B.extent(1)) != m) {
+        std::ostringstream os;
+        os << "KokkosBatched::streaming_batch_invoke: Dimensions do not match: "
+           << "A: " << A.extent(0) << " x " << A.extent(1) << " x " << A.extent(2)
+           << ", B: " << B.extent(0) << " x " << B.extent(1) << " x " << B.extent(2);
+        Kokkos::Impl::throw_runtime_exception(os.str());
+      }
+      if (chunk_size <= 0) {
+        std::ostringstream os;
+        os << "KokkosBatched::streaming_batch_invoke: chunk_size must be positive, chunk_size = " << chunk_size;
+        Kokkos::Impl::throw_runtime_exception(os.str());
+      }
+      if (nmatrices == 0) return;
+
+      const int chunk_rounded = ((chunk_size + vector_length - 1)/vector_length)*vector_length;
+      const int chunk = (chunk_rounded < nmatrices ? chunk_rounded : nmatrices);
+      const int npacks = chunk/vector_length + (chunk%vector_length > 0);
+      const int nbuffers = (chunk < nmatrices ? 2 : 1);
+      const bool in_place =
+        (Kokkos::Impl::SpaceAccessibility<execution_space,typename AViewType::memory_space>::accessible &&
+         Kokkos::Impl::SpaceAccessibility<execution_space,typename BViewType::memory_space>::accessible);
+
+      StreamingBatchPipelines<execution_space> pipelines;
+
+      value_array_type a_packs[2], b_packs[2];
+      device_view_type a_device[2], b_device[2];
+      staging_view_type a_staging[2], b_staging[2];
+      for (int k=0;k<nbuffers;++k) {
+        a_packs[k] = value_array_type(Kokkos::ViewAllocateWithoutInitializing("StreamingBatch::a_packs"), npacks, m, n);
+        b_packs[k] = value_array_type(Kokkos::ViewAllocateWithoutInitializing("StreamingBatch::b_packs"), npacks, m, nrhs);
+        if (!in_place) {
+          a_device[k] = device_view_type(Kokkos::ViewAllocateWithoutInitializing("StreamingBatch::a_device"), chunk, m, n);
+          b_device[k] = device_view_type(Kokkos::ViewAllocateWithoutInitializing("StreamingBatch::b_device"), chunk, m, nrhs);
+          a_staging[k] = staging_view_type(Kokkos::ViewAllocateWithoutInitializing("StreamingBatch::a_staging"), chunk, m, n);
+          b_staging[k] = staging_view_type(Kokkos::ViewAllocateWithoutInitializing("StreamingBatch::b_staging"), chunk, m, nrhs);
+        }
+      }
+
+      /// the chunk last downloaded to the staging buffers of each pipeline,
+      /// to be copied to the user views once that pipeline is fenced
+      range_type pending[2] = { range_type(0,0), range_type(0,0) };
+      const auto copy_back = [&](const int k) {
+        const int len = pending[k].second - pending[k].first;
+        if (len > 0) {
+          streaming_batch_host_copy(Kokkos::subview(A, pending[k], Kokkos::ALL(), Kokkos::ALL()),
+                                    staging_view_type(a_staging[k].data(), len, m, n));
+          streaming_batch_host_copy(Kokkos::subview(B, pending[k], Kokkos::ALL(), Kokkos::ALL()),
+                                    staging_view_type(b_staging[k].data(), len, m, nrhs));
+        }
+        pending[k] = range_type(0,0);
+      };
+
+      for (int begin=0,c=0;begin<nmatrices;begin+=chunk,++c) {
+        const int k = c%2, len = (chunk < nmatrices-begin ? chunk : nmatrices-begin);
+        const int np = len/vector_length + (len%vector_length > 0);
+        const range_type range(begin, begin+len);
+        const execution_space &space = pipelines.space(k);
+
+        const compact_batch_type a_compact(len, value_array_type(a_packs[k].data(), np, m, n));
+        const compact_batch_type b_compact(len, value_array_type(b_packs[k].data(), np, m, nrhs));
+        const functor_type functor(a_compact.Values(), b_compact.Values(), op);
+        const Kokkos::RangePolicy<execution_space> policy(space, 0, np);
+
+        if (in_place) {
+          /// work on one instance is ordered, so the pack buffers are reused
+          /// without fencing
+          const auto a = Kokkos::subview(A, range, Kokkos::ALL(), Kokkos::ALL());
+          const auto b = Kokkos::subview(B, range, Kokkos::ALL(), Kokkos::ALL());
+          pack_compact_batch(space, a_compact, a);
+          pack_compact_batch(space, b_compact, b);
+          Kokkos::parallel_for("KokkosBatched::streaming_batch_invoke", policy, functor);
+          unpack_compact_batch(space, a, a_compact);
+          unpack_compact_batch(space, b, b_compact);
+        } else {
+          const staging_view_type a_stage(a_staging[k].data(), len, m, n);
+          const staging_view_type b_stage(b_staging[k].data(), len, m, nrhs);
+          const device_view_type a_dev(a_device[k].data(), len, m, n);
+          const device_view_type b_dev(b_device[k].data(), len, m, nrhs);
+
+          /// the previous chunk of this pipeline is downloaded, so its
+          /// staging buffers are copied back and reused while the other
+          /// pipeline computes
+          space.fence();
+          copy_back(k);
+          streaming_batch_host_copy(a_stage, Kokkos::subview(A, range, Kokkos::ALL(), Kokkos::ALL()));
+          streaming_batch_host_copy(b_stage, Kokkos::subview(B, range, Kokkos::ALL(), Kokkos::ALL()));
+
+          Kokkos::deep_copy(space, a_dev, a_stage);
+          Kokkos::deep_copy(space, b_dev, b_stage);
+          pack_compact_batch(space, a_compact, a_dev);
+          pack_compact_batch(space, b_compact, b_dev);
+          Kokkos::parallel_for("KokkosBatched::streaming_batch_invoke", policy, functor);
+          unpack_compact_batch(space, a_dev, a_compact);
+          unpack_compact_batch(space, b_dev, b_compact);
+          Kokkos::deep_copy(space, a_stage, a_dev);
+          Kokkos::deep_copy(space, b_stage, b_dev);
+          pending[k] = range;
+        }
+      }
+
+      for (int k=0;k<2;++k) {
+        pipelines.space(k).fence();
+        copy_back(k);
+      }
+    }
+
+    ///
+    /// StreamingLUSolve
+    ///
+
+    template<typename ArgAlgoLU,
+             typename ArgAlgoTrsm>
+    template<typename AViewType,
+             typename BViewType>
+    KOKKOS_INLINE_FUNCTION
+    void
+    StreamingLUSolve<ArgAlgoLU,ArgAlgoTrsm>::
+    operator()(const AViewType &A,
+               const BViewType &B) const {
+      SerialLU<ArgAlgoLU>::invoke(A);
+      SerialTrsm<Side::Left,Uplo::Lower,Trans::NoTranspose,Diag::Unit,ArgAlgoTrsm>::invoke(1.0, A, B);
+      SerialTrsm<Side::Left,Uplo::Upper,Trans::NoTranspose,Diag::NonUnit,ArgAlgoTrsm>::invoke(1.0, A, B);
+    }
+
+    template<typename ExecSpace,
+             typename ValueType,
+             typename AViewType,
+             typename BViewType>
+    void
+    streaming_batched_lu_solve(const AViewType &A,
+                               const BViewType &B,
+                               const int chunk_size) {
+      if (A.extent(1) != A.extent(2)) {
+        std::ostringstream os;
+        os << "KokkosBatched::streaming_batched_lu_solve: A is not square: "
+           << A.extent(1) << " x " << A.extent(2);
+        Kokkos::Impl::throw_runtime_exception(os.str());
+      }
+      typedef StreamingLUSolve<Algo::LU::Unblocked,Algo::Trsm::Unblocked> operator_type;
+      streaming_batch_invoke<ExecSpace,ValueType>(operator_type(), A, B, chunk_size);
+    }
+
+  }
+}
+
+#endif
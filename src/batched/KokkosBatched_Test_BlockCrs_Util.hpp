@@ -8,6 +8,7 @@
 #include "impl/Kokkos_Timer.hpp"
 
 #include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_BlockTridiag_Decl.hpp"
 
 #define TEST_ASSERT(m, success)                                 \
   if ( !(m)) {                                                  \
@@ -412,87 +413,6 @@ namespace KokkosBatched {
             B_val(j, i, k) = static_cast<double>((i+j+k)%7) - 3;
     }
     
-    template <typename ExecSpace, typename ValueType, typename ArrayLayout>
-    class BlockTridiagMatrices {
-    public:
-      typedef ExecSpace exec_space;
-      typedef ValueType value_type;
-      typedef ArrayLayout array_layout;
-
-      typedef Kokkos::View<value_type****,array_layout,exec_space> value_array_type;
-      
-    private:
-      const ordinal_type _ntridiags, _nrows, _blocksize;
-      // A B
-      // C
-      value_array_type _A, _B, _C;
-      
-    public:
-
-      BlockTridiagMatrices (const ordinal_type ntridiags,
-                            const ordinal_type nrows,
-                            const ordinal_type blocksize)
-        : _ntridiags(ntridiags), 
-          _nrows(nrows),
-          _blocksize(blocksize), 
-          _A("BlockTridiagMatrix::_A", _ntridiags, _nrows,   _blocksize, _blocksize),
-          _B("BlockTridiagMatrix::_B", _ntridiags, _nrows-1, _blocksize, _blocksize),
-          _C("BlockTridiagMatrix::_C", _ntridiags, _nrows-1, _blocksize, _blocksize) {}
-
-      BlockTridiagMatrices (const ordinal_type ntridiags,
-                            const ordinal_type nrows,
-                            const ordinal_type blocksize,
-                            const value_array_type A_,
-                            const value_array_type B_,
-                            const value_array_type C_)
-        : _ntridiags(ntridiags), 
-          _nrows(nrows),
-          _blocksize(blocksize), 
-          _A(A_),
-          _B(B_),
-          _C(C_) {}
-
-      value_array_type A() const { return _A; }
-      value_array_type B() const { return _B; }
-      value_array_type C() const { return _C; }
-      
-      ordinal_type BlockSize() const { return _blocksize; }
-      ordinal_type NumRows() const { return _nrows; }
-      ordinal_type NumTridiagMatrices() const { return _ntridiags; }
-    };
-
-    template<typename ExecSpace, typename ValueType, typename ArrayLayout>
-    BlockTridiagMatrices<ExecSpace,ValueType,ArrayLayout> 
-    create_block_tridiag_matrices(const ordinal_type ntridiags, 
-                                  const ordinal_type nrows,
-                                  const ordinal_type blocksize) {
-      return BlockTridiagMatrices<ExecSpace,ValueType,ArrayLayout>
-        (adjustDimension<ValueType>(ntridiags), nrows, blocksize);
-    }
-
-    template<typename DstSpace, typename SrcSpace, typename ValueType, typename ArrayLayout>
-    inline 
-    BlockTridiagMatrices<DstSpace,ValueType,ArrayLayout>
-    create_mirror(const BlockTridiagMatrices<SrcSpace,ValueType,ArrayLayout> src) {
-      return BlockTridiagMatrices<DstSpace,ValueType,ArrayLayout>
-        (src.NumTridiagMatrices(),
-         src.NumRows(),
-         src.BlockSize(),
-         Kokkos::create_mirror_view(typename DstSpace::memory_space(), src.A()),
-         Kokkos::create_mirror_view(typename DstSpace::memory_space(), src.B()),
-         Kokkos::create_mirror_view(typename DstSpace::memory_space(), src.C()));
-    }
-    
-    template<typename DstSpace, typename SrcSpace, typename ValueType, typename ArrayLayout>
-    inline 
-    void
-    deep_copy(const BlockTridiagMatrices<DstSpace,ValueType,ArrayLayout> dst, 
-              const BlockTridiagMatrices<SrcSpace,ValueType,ArrayLayout> src) {
-      Kokkos::deep_copy(dst.A(), src.A());
-      Kokkos::deep_copy(dst.B(), src.B());
-      Kokkos::deep_copy(dst.C(), src.C());
-    }
-
     template<typename ViewType>
     KOKKOS_INLINE_FUNCTION
     typename std::enable_if< std::is_same<typename ViewType::value_type,scalar_type>::value, scalar_type&>::type
@@ -516,65 +436,6 @@ namespace KokkosBatched {
       return A(t/value_type::vector_length, i, ii, jj)[t%value_type::vector_length];
     }
 
-    template <typename ExeSpace, typename ValueType, typename ArrayLayout>
-    class PartitionedBlockMultiVector {
-    public:
-      typedef ExeSpace exec_space;
-      typedef ValueType value_type;
-      typedef ArrayLayout array_layout;
-
-      typedef Kokkos::View<value_type****,array_layout,exec_space> value_array_type;
-
-    private:
-      value_array_type _values;
-
-    public:
-      PartitionedBlockMultiVector(const ordinal_type nparts,
-                                  const ordinal_type nvectors,
-                                  const ordinal_type nrows,
-                                  const ordinal_type blocksize)
-        : _values("BlockMultiVector::_values", nparts, nvectors, nrows, blocksize) {}
-
-      PartitionedBlockMultiVector(const value_array_type values) 
-        : _values(values) {}
-      
-      ordinal_type NumPartitions() const { return _values.extent(0); }
-      ordinal_type NumVectors() const { return _values.extent(1); }      
-      ordinal_type NumRows() const { return _values.extent(2); }
-      ordinal_type BlockSize() const { return _values.extent(3); }
-
-      value_array_type Values() const { return _values; }
-    };
-
-    template<typename ExecSpace, typename ValueType, typename ArrayLayout>
-    PartitionedBlockMultiVector<ExecSpace,ValueType,ArrayLayout> 
-    create_partitioned_block_multi_vector(const ordinal_type nparts,
-                                          const ordinal_type nvectors,
-                                          const ordinal_type nrows,
-                                          const ordinal_type blocksize) {
-      return PartitionedBlockMultiVector
-        <ExecSpace,ValueType,ArrayLayout>(adjustDimension<ValueType>(nparts), 
-                                          nvectors,
-                                          nrows, 
-                                          blocksize);
-    }
-    
-    template<typename DstSpace, typename SrcSpace, typename ValueType, typename ArrayLayout>
-    inline 
-    PartitionedBlockMultiVector<DstSpace,ValueType,ArrayLayout>
-    create_mirror(const PartitionedBlockMultiVector<SrcSpace,ValueType,ArrayLayout> src) {
-      return PartitionedBlockMultiVector<DstSpace,ValueType,ArrayLayout>
-        (Kokkos::create_mirror_view(typename DstSpace::memory_space(), src.Values()));
-    }
-    
-    template<typename DstSpace, typename SrcSpace, typename ValueType, typename ArrayLayout>
-    inline 
-    void
-    deep_copy(const PartitionedBlockMultiVector<DstSpace,ValueType,ArrayLayout> dst, 
-              const PartitionedBlockMultiVector<SrcSpace,ValueType,ArrayLayout> src) {
-      Kokkos::deep_copy(dst.Values(), src.Values());
-    }
-    
     template<typename ValueType, typename ArrayLayout>
     void fill_partitioned_block_multi_vector_host
     (PartitionedBlockMultiVector<Kokkos::DefaultHostExecutionSpace,ValueType,ArrayLayout> B,
@@ -0,0 +1,67 @@
+#ifndef __KOKKOSBATCHED_TRIDIAGONAL_DECL_HPP__
+#define __KOKKOSBATCHED_TRIDIAGONAL_DECL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Vector.hpp"
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Tridiagonal solve
+    /// =================
+    ///
+    /// Solves A x = b for a tridiagonal A (n x n) without pivoting, which
+    /// is suitable for diagonally dominant or spd systems as they arise in
+    /// line implicit and ADI methods. As in LAPACK gtsv,
+    ///
+    ///   dl (n-1) : sub diagonal,   dl(i) = A(i+1,i)
+    ///   d  (n)   : diagonal,       d(i)  = A(i,i)
+    ///   du (n-1) : super diagonal, du(i) = A(i,i+1)
+    ///
+    /// and b (n) is overwritten by x. With Vector<SIMD<T>,l> values, l
+    /// interleaved systems are solved at once.
+    ///
+    /// Algo::Tridiagonal::Thomas (Serial): dl and d are overwritten by the
+    ///   LU factors; du is unchanged.
+    /// Algo::Tridiagonal::CyclicReduction (Team): each level of the
+    ///   reduction is distributed over the team; dl, d and du are
+    ///   overwritten by the reduced systems.
+    ///
+
+    template<typename ArgAlgo>
+    struct SerialTridiagonalSolve {
+      template<typename DLViewType,
+               typename DViewType,
+               typename DUViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const DLViewType &dl,
+             const DViewType &d,
+             const DUViewType &du,
+             const BViewType &b);
+    };
+
+    template<typename MemberType,
+             typename ArgAlgo>
+    struct TeamTridiagonalSolve {
+      template<typename DLViewType,
+               typename DViewType,
+               typename DUViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const DLViewType &dl,
+             const DViewType &d,
+             const DUViewType &du,
+             const BViewType &b);
+    };
+
+  }
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef __KOKKOSBATCHED_TRIDIAGONAL_SERIAL_IMPL_HPP__
+#define __KOKKOSBATCHED_TRIDIAGONAL_SERIAL_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Tridiagonal_Serial_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Serial Impl
+    /// ===========
+
+    template<>
+    template<typename DLViewType,
+             typename DViewType,
+             typename DUViewType,
+             typename BViewType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialTridiagonalSolve<Algo::Tridiagonal::Thomas>::
+    invoke(const DLViewType &dl,
+           const DViewType &d,
+           const DUViewType &du,
+           const BViewType &b) {
+      return SerialTridiagonalSolveInternal<Algo::Tridiagonal::Thomas>::
+        invoke(d.extent(0),
+               dl.data(), dl.stride_0(),
+               d.data(),  d.stride_0(),
+               du.data(), du.stride_0(),
+               b.data(),  b.stride_0());
+    }
+
+  }
+}
+
+#endif
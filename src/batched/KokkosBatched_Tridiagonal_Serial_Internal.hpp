@@ -0,0 +1,61 @@
+#ifndef __KOKKOSBATCHED_TRIDIAGONAL_SERIAL_INTERNAL_HPP__
+#define __KOKKOSBATCHED_TRIDIAGONAL_SERIAL_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Serial Internal Impl
+    /// ==================== 
+
+    template<typename AlgoType>
+    struct SerialTridiagonalSolveInternal {
+      template<typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const int n,
+             /**/  ValueType *__restrict__ dl, const int dls,
+             /**/  ValueType *__restrict__ d,  const int ds,
+             const ValueType *__restrict__ du, const int dus,
+             /**/  ValueType *__restrict__ b,  const int bs);
+    };
+
+    template<>
+    template<typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    SerialTridiagonalSolveInternal<Algo::Tridiagonal::Thomas>::
+    invoke(const int n,
+           /**/  ValueType *__restrict__ dl, const int dls,
+           /**/  ValueType *__restrict__ d,  const int ds,
+           const ValueType *__restrict__ du, const int dus,
+           /**/  ValueType *__restrict__ b,  const int bs) {
+      if (n <= 0) return 0;
+
+      // forward elimination; A = L U with unit L
+      for (int i=1;i<n;++i) {
+        const ValueType l = dl[(i-1)*dls]/d[(i-1)*ds];
+        dl[(i-1)*dls] = l;
+        d[i*ds] -= l*du[(i-1)*dus];
+        b[i*bs] -= l*b[(i-1)*bs];
+      }
+
+      // backward substitution
+      b[(n-1)*bs] /= d[(n-1)*ds];
+      for (int i=(n-2);i>=0;--i) 
+        b[i*bs] = (b[i*bs] - du[i*dus]*b[(i+1)*bs])/d[i*ds];
+
+      return 0;
+    }
+
+  }
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef __KOKKOSBATCHED_TRIDIAGONAL_TEAM_IMPL_HPP__
+#define __KOKKOSBATCHED_TRIDIAGONAL_TEAM_IMPL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Tridiagonal_Team_Internal.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// Team Impl
+    /// =========
+
+    template<typename MemberType>
+    struct TeamTridiagonalSolve<MemberType,Algo::Tridiagonal::CyclicReduction> {
+      template<typename DLViewType,
+               typename DViewType,
+               typename DUViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const DLViewType &dl,
+             const DViewType &d,
+             const DUViewType &du,
+             const BViewType &b) {
+        return TeamTridiagonalSolveInternal<Algo::Tridiagonal::CyclicReduction>::
+          invoke(member,
+                 d.extent(0),
+                 dl.data(), dl.stride_0(),
+                 d.data(),  d.stride_0(),
+                 du.data(), du.stride_0(),
+                 b.data(),  b.stride_0());
+      }
+    };
+
+  }
+}
+
+#endif
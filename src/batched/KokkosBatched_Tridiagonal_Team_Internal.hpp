@@ -0,0 +1,98 @@
+#ifndef __KOKKOSBATCHED_TRIDIAGONAL_TEAM_INTERNAL_HPP__
+#define __KOKKOSBATCHED_TRIDIAGONAL_TEAM_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Vector.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    ///
+    /// Team Internal Impl
+    /// ==================
+
+    template<typename AlgoType>
+    struct TeamTridiagonalSolveInternal {
+      template<typename MemberType, typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const int n,
+             /**/  ValueType *__restrict__ dl, const int dls,
+             /**/  ValueType *__restrict__ d,  const int ds,
+             /**/  ValueType *__restrict__ du, const int dus,
+             /**/  ValueType *__restrict__ b,  const int bs);
+    };
+
+    ///
+    /// in-place cyclic reduction; at level s, the equations i = 2s-1 mod 2s
+    /// eliminate their couplings to i-s and i+s, after which they only couple 
+    /// to i-2s and i+2s. The back substitution solves the equations 
+    /// i = s-1 mod 2s from the top level down. Row i couples to x(i-1) through 
+    /// dl(i-1) and to x(i+1) through du(i); both are zero outside of A.
+    ///
+    template<>
+    template<typename MemberType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamTridiagonalSolveInternal<Algo::Tridiagonal::CyclicReduction>::
+    invoke(const MemberType &member,
+           const int n,
+           /**/  ValueType *__restrict__ dl, const int dls,
+           /**/  ValueType *__restrict__ d,  const int ds,
+           /**/  ValueType *__restrict__ du, const int dus,
+           /**/  ValueType *__restrict__ b,  const int bs) {
+      if (n <= 0) return 0;
+
+      const ValueType zero(0);
+
+      // forward reduction
+      int s = 1;
+      for (;2*s<=n;s*=2) {
+        const int s2 = 2*s, iend = n/s2;
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,iend),[&](const int &j) {
+            const int i = s2*j+s2-1, il = i-s, ir = i+s;
+            const ValueType alpha = -dl[(i-1)*dls]/d[il*ds];
+
+            ValueType 
+              a_i = alpha*(il > 0 ? dl[(il-1)*dls] : zero), c_i = zero,
+              d_i = d[i*ds] + alpha*du[il*dus],
+              b_i = b[i*bs] + alpha*b[il*bs];
+            if (ir < n) {
+              const ValueType gamma = -du[i*dus]/d[ir*ds];
+              c_i  = gamma*(ir < (n-1) ? du[ir*dus] : zero);
+              d_i += gamma*dl[(ir-1)*dls];
+              b_i += gamma*b[ir*bs];
+            }
+            dl[(i-1)*dls] = a_i;
+            if (i < (n-1)) du[i*dus] = c_i;
+            d[i*ds] = d_i;
+            b[i*bs] = b_i;
+          });
+        member.team_barrier();
+      }
+
+      // back substitution
+      for (;s>=1;s/=2) {
+        const int s2 = 2*s, iend = (n+s)/s2;
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member,0,iend),[&](const int &j) {
+            const int i = s2*j+s-1, il = i-s, ir = i+s;
+            ValueType r = b[i*bs];
+            if (il >= 0) r -= dl[(i-1)*dls]*b[il*bs];
+            if (ir <  n) r -= du[i*dus]*b[ir*bs];
+            b[i*bs] = r/d[i*ds];
+          });
+        member.team_barrier();
+      }
+
+      return 0;
+    }
+
+  }
+}
+
+#endif
@@ -42,6 +42,33 @@ namespace KokkosBatched {
              const BViewType &B);
     };
 
+    ///
+    /// TeamVector Trsm
+    ///
+    /// Invoked by a single thread of a team on its own matrix; the entries
+    /// are distributed over the vector lanes of that thread
+    /// (ThreadVectorRange) so that a team processes team_size problems.
+    /// Only Algo::Trsm::Unblocked is provided.
+    ///
+
+    template<typename MemberType,
+             typename ArgSide,
+             typename ArgUplo,
+             typename ArgTrans,
+             typename ArgDiag,
+             typename ArgAlgo>
+    struct TeamVectorTrsm {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B);
+    };
+
   }
 }
 
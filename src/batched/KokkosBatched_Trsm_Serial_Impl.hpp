@@ -285,6 +285,90 @@ namespace KokkosBatched {
       }
     };
 
+    ///
+    /// L/U/T
+    ///
+    /// B := inv(triu(A)^T) (alpha*B)
+    /// A(m x m), B(m x n); triu(A)^T is solved through the transposed strides of A
+
+    template<typename ArgDiag>
+    struct SerialTrsm<Side::Left,Uplo::Upper,Trans::Transpose,ArgDiag,Algo::Trsm::Unblocked> {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B) {
+        return SerialTrsmInternalLeftLower<Algo::Trsm::Unblocked>::invoke(ArgDiag::use_unit_diag,
+                                                                    B.extent(0), B.extent(1),
+                                                                    alpha, 
+                                                                    A.data(), A.stride_1(), A.stride_0(),
+                                                                    B.data(), B.stride_0(), B.stride_1());
+      }
+    };
+
+    template<typename ArgDiag>
+    struct SerialTrsm<Side::Left,Uplo::Upper,Trans::Transpose,ArgDiag,Algo::Trsm::Blocked> {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B) {
+        return SerialTrsmInternalLeftLower<Algo::Trsm::Blocked>::invoke(ArgDiag::use_unit_diag,
+                                                                    B.extent(0), B.extent(1),
+                                                                    alpha, 
+                                                                    A.data(), A.stride_1(), A.stride_0(),
+                                                                    B.data(), B.stride_0(), B.stride_1());
+      }
+    };
+
+    ///
+    /// L/L/T
+    ///
+    /// B := inv(tril(A)^T) (alpha*B)
+    /// A(m x m), B(m x n); tril(A)^T is solved through the transposed strides of A
+
+    template<typename ArgDiag>
+    struct SerialTrsm<Side::Left,Uplo::Lower,Trans::Transpose,ArgDiag,Algo::Trsm::Unblocked> {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B) {
+        return SerialTrsmInternalLeftUpper<Algo::Trsm::Unblocked>::invoke(ArgDiag::use_unit_diag,
+                                                                    B.extent(0), B.extent(1),
+                                                                    alpha, 
+                                                                    A.data(), A.stride_1(), A.stride_0(),
+                                                                    B.data(), B.stride_0(), B.stride_1());
+      }
+    };
+
+    template<typename ArgDiag>
+    struct SerialTrsm<Side::Left,Uplo::Lower,Trans::Transpose,ArgDiag,Algo::Trsm::Blocked> {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B) {
+        return SerialTrsmInternalLeftUpper<Algo::Trsm::Blocked>::invoke(ArgDiag::use_unit_diag,
+                                                                    B.extent(0), B.extent(1),
+                                                                    alpha, 
+                                                                    A.data(), A.stride_1(), A.stride_0(),
+                                                                    B.data(), B.stride_0(), B.stride_1());
+      }
+    };
+
   }
 }
 
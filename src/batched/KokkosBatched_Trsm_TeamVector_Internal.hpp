@@ -0,0 +1,164 @@
+#ifndef __KOKKOSBATCHED_TRSM_TEAMVECTOR_INTERNAL_HPP__
+#define __KOKKOSBATCHED_TRSM_TEAMVECTOR_INTERNAL_HPP__
+
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "KokkosBatched_Util.hpp"
+
+
+namespace KokkosBatched {
+  namespace Experimental {
+    ///
+    /// TeamVector Internal Impl
+    /// ========================
+
+    ///
+    /// B := alpha B in the vector lanes of the calling thread
+    ///
+    struct TeamVectorTrsmInternalScale {
+      template<typename MemberType,
+               typename ScalarType,
+               typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static void
+      invoke(const MemberType &member,
+             const int m, const int n,
+             const ScalarType alpha,
+             /**/  ValueType *__restrict__ B, const int bs0, const int bs1) {
+        const ScalarType one(1.0), zero(0.0);
+        if (alpha == one) return;
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,m*n),[&](const int &ij) {
+            const int i = ij/n, j = ij%n;
+            if (alpha == zero) B[i*bs0+j*bs1] = zero;
+            else               B[i*bs0+j*bs1] *= alpha;
+          });
+        vector_barrier(member);
+      }
+    };
+
+    template<typename AlgoType>
+    struct TeamVectorTrsmInternalLeftLower {
+      template<typename MemberType,
+               typename ScalarType,
+               typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const bool use_unit_diag,
+             const int m, const int n,
+             const ScalarType alpha,
+             const ValueType *__restrict__ A, const int as0, const int as1,
+             /**/  ValueType *__restrict__ B, const int bs0, const int bs1);
+    };
+
+    template<>
+    template<typename MemberType,
+             typename ScalarType,
+             typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamVectorTrsmInternalLeftLower<Algo::Trsm::Unblocked>::
+    invoke(const MemberType &member,
+           const bool use_unit_diag,
+           const int m, const int n,
+           const ScalarType alpha,
+           const ValueType *__restrict__ A, const int as0, const int as1,
+           /**/  ValueType *__restrict__ B, const int bs0, const int bs1) {
+
+      const ScalarType zero(0.0);
+
+      if (m <= 0 || n <= 0) return 0;
+
+      TeamVectorTrsmInternalScale::invoke(member, m, n, alpha, B, bs0, bs1);
+      if (alpha == zero) return 0;
+
+      for (int p=0;p<m;++p) {
+        const int iend = m-p-1, jend = n;
+
+        const ValueType
+          *__restrict__ a21 = iend ? A+(p+1)*as0+p*as1 : NULL;
+
+        ValueType
+          *__restrict__ b1t =        B+p*bs0,
+          *__restrict__ B2  = iend ? B+(p+1)*bs0 : NULL;
+
+        if (!use_unit_diag) {
+          const ValueType alpha11 = A[p*as0+p*as1];
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,jend),[&](const int &j) {
+              b1t[j*bs1] = b1t[j*bs1] / alpha11;
+            });
+          vector_barrier(member);
+        }
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,iend*jend),[&](const int &ij) {
+            const int i = ij/jend, j = ij%jend;
+            B2[i*bs0+j*bs1] -= a21[i*as0] * b1t[j*bs1];
+          });
+        vector_barrier(member);
+      }
+      return 0;
+    }
+
+    template<typename AlgoType>
+    struct TeamVectorTrsmInternalLeftUpper {
+      template<typename MemberType,
+               typename ScalarType,
+               typename ValueType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const bool use_unit_diag,
+             const int m, const int n,
+             const ScalarType alpha,
+             const ValueType *__restrict__ A, const int as0, const int as1,
+             /**/  ValueType *__restrict__ B, const int bs0, const int bs1);
+    };
+
+    template<>
+    template<typename MemberType,
+             typename ScalarType,
+             typename ValueType>
+    KOKKOS_INLINE_FUNCTION
+    int
+    TeamVectorTrsmInternalLeftUpper<Algo::Trsm::Unblocked>::
+    invoke(const MemberType &member,
+           const bool use_unit_diag,
+           const int m, const int n,
+           const ScalarType alpha,
+           const ValueType *__restrict__ A, const int as0, const int as1,
+           /**/  ValueType *__restrict__ B, const int bs0, const int bs1) {
+
+      const ScalarType zero(0.0);
+
+      if (m <= 0 || n <= 0) return 0;
+
+      TeamVectorTrsmInternalScale::invoke(member, m, n, alpha, B, bs0, bs1);
+      if (alpha == zero) return 0;
+
+      ValueType *__restrict__ B0 = B;
+      for (int p=(m-1);p>=0;--p) {
+        const int iend = p, jend = n;
+
+        const ValueType *__restrict__ a01 = A+p*as1;
+        /**/  ValueType *__restrict__ b1t = B+p*bs0;
+
+        if (!use_unit_diag) {
+          const ValueType alpha11 = A[p*as0+p*as1];
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,jend),[&](const int &j) {
+              b1t[j*bs1] = b1t[j*bs1] / alpha11;
+            });
+          vector_barrier(member);
+        }
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member,iend*jend),[&](const int &ij) {
+            const int i = ij/jend, j = ij%jend;
+            B0[i*bs0+j*bs1] -= a01[i*as0] * b1t[j*bs1];
+          });
+        vector_barrier(member);
+      }
+      return 0;
+    }
+
+  }
+}
+
+#endif
@@ -152,6 +152,98 @@ namespace KokkosBatched {
       }
     };
 
+    ///
+    /// L/U/T
+    ///
+    /// B := inv(triu(A)^T) (alpha*B)
+    /// A(m x m), B(m x n); triu(A)^T is solved through the transposed strides of A
+
+    template<typename MemberType, typename ArgDiag>
+    struct TeamTrsm<MemberType,Side::Left,Uplo::Upper,Trans::Transpose,ArgDiag,Algo::Trsm::Unblocked> {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B) {
+        return TeamTrsmInternalLeftLower<Algo::Trsm::Unblocked>::invoke(member,
+                                                                      ArgDiag::use_unit_diag,
+                                                                      B.extent(0), B.extent(1),
+                                                                      alpha, 
+                                                                      A.data(), A.stride_1(), A.stride_0(),
+                                                                      B.data(), B.stride_0(), B.stride_1());
+      }
+    };
+
+    template<typename MemberType, typename ArgDiag>
+    struct TeamTrsm<MemberType,Side::Left,Uplo::Upper,Trans::Transpose,ArgDiag,Algo::Trsm::Blocked> {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B) {
+        return TeamTrsmInternalLeftLower<Algo::Trsm::Blocked>::invoke(member,
+                                                                      ArgDiag::use_unit_diag,
+                                                                      B.extent(0), B.extent(1),
+                                                                      alpha, 
+                                                                      A.data(), A.stride_1(), A.stride_0(),
+                                                                      B.data(), B.stride_0(), B.stride_1());
+      }
+    };
+
+    ///
+    /// L/L/T
+    ///
+    /// B := inv(tril(A)^T) (alpha*B)
+    /// A(m x m), B(m x n); tril(A)^T is solved through the transposed strides of A
+
+    template<typename MemberType, typename ArgDiag>
+    struct TeamTrsm<MemberType,Side::Left,Uplo::Lower,Trans::Transpose,ArgDiag,Algo::Trsm::Unblocked> {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B) {
+        return TeamTrsmInternalLeftUpper<Algo::Trsm::Unblocked>::invoke(member,
+                                                                      ArgDiag::use_unit_diag,
+                                                                      B.extent(0), B.extent(1),
+                                                                      alpha, 
+                                                                      A.data(), A.stride_1(), A.stride_0(),
+                                                                      B.data(), B.stride_0(), B.stride_1());
+      }
+    };
+
+    template<typename MemberType, typename ArgDiag>
+    struct TeamTrsm<MemberType,Side::Left,Uplo::Lower,Trans::Transpose,ArgDiag,Algo::Trsm::Blocked> {
+      template<typename ScalarType,
+               typename AViewType,
+               typename BViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member, 
+             const ScalarType alpha,
+             const AViewType &A,
+             const BViewType &B) {
+        return TeamTrsmInternalLeftUpper<Algo::Trsm::Blocked>::invoke(member,
+                                                                      ArgDiag::use_unit_diag,
+                                                                      B.extent(0), B.extent(1),
+                                                                      alpha, 
+                                                                      A.data(), A.stride_1(), A.stride_0(),
+                                                                      B.data(), B.stride_0(), B.stride_1());
+      }
+    };
+
   }
 }
 
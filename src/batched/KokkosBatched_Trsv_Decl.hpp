@@ -73,6 +73,33 @@ namespace KokkosBatched {
 #define KOKKOSBATCHED_TEAM_TRSV_UPPER_TRANSPOSE_INTERNAL_INVOKE(ALGOTYPE,MEMBER,DIAG,M,N,ALPHA,A,AS0,AS1,B,BS) \
     KokkosBatched::Experimental::TeamTrsvInternalLower<ALGOTYPE>::invoke(MEMBER,DIAG::use_unit_diag, N, ALPHA, A, AS1, AS0, B, BS) 
 
+
+    ///
+    /// TeamVector Trsv
+    ///
+    /// Invoked by a single thread of a team on its own matrix; the entries
+    /// are distributed over the vector lanes of that thread
+    /// (ThreadVectorRange) so that a team processes team_size problems.
+    /// Only Algo::Trsv::Unblocked is provided.
+    ///
+
+    template<typename MemberType,
+             typename ArgUplo,
+             typename ArgTrans,
+             typename ArgDiag,
+             typename ArgAlgo>
+    struct TeamVectorTrsv {
+      template<typename ScalarType,
+               typename AViewType,
+               typename bViewType>
+      KOKKOS_INLINE_FUNCTION
+      static int
+      invoke(const MemberType &member,
+             const ScalarType alpha,
+             const AViewType &A,
+             const bViewType &b);
+    };
+
   }
 }
 
@@ -0,0 +1,68 @@
+#ifndef __KOKKOSBATCHED_TUNING_HPP__
+#define __KOKKOSBATCHED_TUNING_HPP__
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+///
+/// Register blocking used by Algo::Level3::Blocked
+/// ===============================================
+///
+/// The blocking is selected per space and per real/complex value type.
+/// A table generated by perf_test/batched/KokkosBatched_Test_Tune_Blocking_Host
+/// can be used by compiling with
+///
+///   -DKOKKOSBATCHED_TUNING_TABLE=\"KokkosBatched_Tuning_Table.hpp\"
+///
+/// or the macros below can be defined individually. Valid values are 1 to 5,
+/// which are the register blocks available in InnerGemmFixC.
+///
+
+#if defined(KOKKOSBATCHED_TUNING_TABLE)
+#include KOKKOSBATCHED_TUNING_TABLE
+#endif
+
+#if !defined(KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST)
+#define KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST 4
+#endif
+#if !defined(KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST_COMPLEX)
+#define KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST_COMPLEX KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST
+#endif
+
+#if !defined(KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA)
+#define KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA 2
+#endif
+#if !defined(KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA_COMPLEX)
+#define KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA_COMPLEX KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA
+#endif
+
+static_assert(KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST         >= 1 && KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST         <= 5 &&
+              KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST_COMPLEX >= 1 && KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST_COMPLEX <= 5 &&
+              KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA         >= 1 && KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA         <= 5 &&
+              KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA_COMPLEX >= 1 && KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA_COMPLEX <= 5,
+              "KokkosBatched:: Level3 register blocking must be in [1,5]");
+
+///
+/// Crossover to vendor libraries used by BatchedGemm
+/// =================================================
+///
+/// cublas<t>gemmStridedBatched is used on Cuda and the MKL compact Gemm on
+/// host (vector packs) when the largest matrix dimension is at least
+/// MIN_SIZE and the batch has at least MIN_BATCH matrices. A negative
+/// MIN_SIZE disables the vendor path.
+///
+
+#if !defined(KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_SIZE_CUDA)
+#define KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_SIZE_CUDA 24
+#endif
+#if !defined(KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_BATCH_CUDA)
+#define KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_BATCH_CUDA 64
+#endif
+
+#if !defined(KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_SIZE_HOST)
+#define KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_SIZE_HOST 5
+#endif
+#if !defined(KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_BATCH_HOST)
+#define KOKKOSBATCHED_BATCHED_GEMM_VENDOR_MIN_BATCH_HOST 1
+#endif
+
+#endif
@@ -22,6 +22,8 @@
 
 #include "KokkosKernels_config.h"
 
+#include "KokkosBatched_Tuning.hpp"
+
 namespace KokkosBatched {
   namespace Experimental {
 
@@ -47,6 +49,10 @@ namespace KokkosBatched {
 
     template<typename T> struct is_vector : public std::false_type {};
 
+    template<typename T> struct is_complex_value : public std::false_type {};
+    template<typename T> struct is_complex_value<Kokkos::complex<T> > : public std::true_type {};
+    template<typename T> struct is_complex_value<std::complex<T> > : public std::true_type {};
+
     template<typename Ta, typename Tb>
     struct is_same_mag_type {
       static const bool is_specialized = ( Kokkos::Details::ArithTraits<Ta>::is_specialized &&
@@ -236,6 +242,18 @@ namespace KokkosBatched {
       struct NonUnit { static const bool use_unit_diag = false; };
     };
 
+    // synchronize the vector lanes of the calling thread; the lanes of a
+    // warp are not guaranteed to run in lockstep on Volta and later
+    template<typename MemberType>
+    KOKKOS_FORCEINLINE_FUNCTION
+    void vector_barrier(const MemberType & /* member */) {
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 700)
+      const unsigned int vs = blockDim.x;
+      const unsigned int mask = (vs >= 32 ? 0xffffffffu : (((1u << vs) - 1u) << ((threadIdx.y*vs) % 32)));
+      __syncwarp(mask);
+#endif
+    }
+
     struct Algo {
       struct Level3 {
 	struct Unblocked {
@@ -243,8 +261,8 @@ namespace KokkosBatched {
 	};
 	struct Blocked {
 	  static const char* name() { return "Blocked"; }
-	  // TODO:: for now harwire the blocksizes; this should reflect
-	  // regieter blocking (not about team parallelism).
+	  // register blocking (not about team parallelism); the defaults can be
+	  // replaced by a tuned table (see KokkosBatched_Tuning.hpp).
 	  // this mb should vary according to
 	  // - team policy (smaller) or range policy (bigger)
 	  // - space (cuda vs host)
@@ -252,11 +270,25 @@ namespace KokkosBatched {
 #if defined(KOKKOS_ENABLE_CUDA)
 	  template<typename ActiveMemorySpaceType> KOKKOS_INLINE_FUNCTION static constexpr
 	  typename std::enable_if<std::is_same<ActiveMemorySpaceType,Kokkos::CudaSpace>::value,int>
-	  ::type mb() { return 2; }
+	  ::type mb() { return KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA; }
+	  template<typename ActiveMemorySpaceType, typename ValueType> KOKKOS_INLINE_FUNCTION static constexpr
+	  typename std::enable_if<std::is_same<ActiveMemorySpaceType,Kokkos::CudaSpace>::value,int>
+	  ::type mb() { 
+	    return (is_complex_value<ValueType>::value ? 
+		    KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA_COMPLEX : 
+		    KOKKOSBATCHED_LEVEL3_BLOCKED_MB_CUDA); 
+	  }
 #endif
 	  template<typename ActiveMemorySpaceType> KOKKOS_INLINE_FUNCTION static constexpr
 	  typename std::enable_if<std::is_same<ActiveMemorySpaceType,Kokkos::HostSpace>::value,int>
-	  ::type mb() { return 4; }
+	  ::type mb() { return KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST; }
+	  template<typename ActiveMemorySpaceType, typename ValueType> KOKKOS_INLINE_FUNCTION static constexpr
+	  typename std::enable_if<std::is_same<ActiveMemorySpaceType,Kokkos::HostSpace>::value,int>
+	  ::type mb() { 
+	    return (is_complex_value<ValueType>::value ? 
+		    KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST_COMPLEX : 
+		    KOKKOSBATCHED_LEVEL3_BLOCKED_MB_HOST); 
+	  }
 	};
 	struct MKL {
 	  static const char* name() { return "MKL"; }
@@ -269,6 +301,8 @@ namespace KokkosBatched {
       using Gemm = Level3;
       using Trsm = Level3;
       using LU   = Level3;
+      using Cholesky = Level3;
+      using QR   = Level3;
 
       struct Level2 {
 	struct Unblocked {};
@@ -295,6 +329,28 @@ namespace KokkosBatched {
       using Gemv = Level2;
       using Trsv = Level2;
 
+      struct Tridiagonal {
+	// no pivoting; sequential elimination
+	struct Thomas {
+	  static const char* name() { return "Thomas"; }
+	};
+	// no pivoting; log2(n) levels of independent eliminations
+	struct CyclicReduction {
+	  static const char* name() { return "CyclicReduction"; }
+	};
+      };
+
+      struct EigenSymmetric {
+	// closed form eigenvalues of 3x3 matrices (trigonometric method)
+	struct Analytic {
+	  static const char* name() { return "Analytic"; }
+	};
+	// cyclic Jacobi rotations
+	struct Jacobi {
+	  static const char* name() { return "Jacobi"; }
+	};
+      };
+
       //         struct Level1 {
       //           struct Unblocked {};
       //           struct Blocked {
@@ -5,6 +5,14 @@
 
 #include "KokkosBatched_Util.hpp"
 
+// arm explicit vectorization; SVE requires a fixed vector length (-msve-vector-bits=512)
+#if !defined(__CUDA_ARCH__)
+#if   defined(__ARM_FEATURE_SVE) && defined(__ARM_FEATURE_SVE_BITS) && (__ARM_FEATURE_SVE_BITS == 512)
+#define __KOKKOSBATCHED_ENABLE_SVE512__
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define __KOKKOSBATCHED_ENABLE_NEON__
+#endif
+#endif
 
 // forward declaration
 namespace KokkosBatched {
@@ -15,6 +23,9 @@ namespace KokkosBatched {
     template<typename T, int l>
     struct is_vector<Vector<SIMD<T>,l> > : public std::true_type {};
 
+    template<typename T, int l>
+    struct is_complex_value<Vector<SIMD<T>,l> > : public is_complex_value<T> {};
+
     template<typename ValueType, typename MemorySpace>
     struct DefaultVectorLength {
       enum : int { value = 1 };
@@ -36,6 +47,10 @@ namespace KokkosBatched {
       enum : int { value = 8 };
 #elif defined(__AVX__) || defined(__AVX2__)
       enum : int { value = 4 };
+#elif defined(__KOKKOSBATCHED_ENABLE_SVE512__)
+      enum : int { value = 8 };
+#elif defined(__KOKKOSBATCHED_ENABLE_NEON__)
+      enum : int { value = 2 };
 #else
       enum : int { value = 8 };      
 #endif
@@ -109,6 +124,35 @@ namespace KokkosBatched {
     template<int l> struct MagnitudeScalarType<Vector<SIMD<Kokkos::complex<float> >,l> > { typedef float type; };
     template<int l> struct MagnitudeScalarType<Vector<SIMD<Kokkos::complex<double> >,l> > { typedef double type; };
 
+    // value type in which mixed precision kernels accumulate; single
+    // precision is widened to double lane by lane
+    template<typename T> struct AccumulationValueType { typedef T type; };
+
+    template<> struct AccumulationValueType<float> { typedef double type; };
+    template<> struct AccumulationValueType<Kokkos::complex<float> > { typedef Kokkos::complex<double> type; };
+
+    template<int l> struct AccumulationValueType<Vector<SIMD<float>,l> > { typedef Vector<SIMD<double>,l> type; };
+    template<int l> struct AccumulationValueType<Vector<SIMD<Kokkos::complex<float> >,l> > { typedef Vector<SIMD<Kokkos::complex<double> >,l> type; };
+
+    // lane access; a scalar is a vector of length one
+    template<typename T>
+    struct VectorLane {
+      enum : int { vector_length = 1 };
+      typedef T value_type;
+      KOKKOS_FORCEINLINE_FUNCTION
+      static value_type& get(T &a, const int /* i */) { return a; }
+      KOKKOS_FORCEINLINE_FUNCTION
+      static const value_type& get(const T &a, const int /* i */) { return a; }
+    };
+
+    template<typename T, int l>
+    struct VectorLane<Vector<SIMD<T>,l> > {
+      enum : int { vector_length = l };
+      typedef T value_type;
+      KOKKOS_FORCEINLINE_FUNCTION
+      static value_type& get(const Vector<SIMD<T>,l> &a, const int i) { return a[i]; }
+    };
+
   }
 }
 
@@ -132,6 +176,23 @@ namespace Kokkos {
       static KOKKOS_FORCEINLINE_FUNCTION mag_type real (const val_type &val) {
         return val;
       }
+      static KOKKOS_FORCEINLINE_FUNCTION mag_type imag (const val_type &) {
+        return mag_type(ArithTraits<mag_scalar_type>::zero());
+      }
+      static KOKKOS_FORCEINLINE_FUNCTION val_type conj (const val_type &val) {
+        return val;
+      }
+      static KOKKOS_FORCEINLINE_FUNCTION mag_type abs (const val_type &val) {
+        mag_type r_val;
+        for (int i=0;i<l;++i) { r_val[i] = ArithTraits<T>::abs(val[i]); }
+        return r_val;
+      }
+      static KOKKOS_FORCEINLINE_FUNCTION val_type zero () {
+        return val_type(ArithTraits<T>::zero());
+      }
+      static KOKKOS_FORCEINLINE_FUNCTION val_type one () {
+        return val_type(ArithTraits<T>::one());
+      }
  
       static const bool is_specialized = ArithTraits<T>::is_specialized;
       static const bool is_signed = ArithTraits<T>::is_signed;
@@ -160,6 +221,32 @@ namespace Kokkos {
         for (int i=0;i<l;++i) { r_val[i] = val[i].imag(); }
         return r_val;
       }
+      static KOKKOS_FORCEINLINE_FUNCTION val_type conj (const val_type &val) {
+        val_type r_val;
+        for (int i=0;i<l;++i) { r_val[i] = ArithTraits<Kokkos::complex<T> >::conj(val[i]); }
+        return r_val;
+      }
+      static KOKKOS_FORCEINLINE_FUNCTION mag_type abs (const val_type &val) {
+        mag_type r_val;
+        for (int i=0;i<l;++i) { r_val[i] = ArithTraits<Kokkos::complex<T> >::abs(val[i]); }
+        return r_val;
+      }
+      static KOKKOS_FORCEINLINE_FUNCTION val_type zero () {
+        val_type r_val;
+        for (int i=0;i<l;++i) { r_val[i] = ArithTraits<Kokkos::complex<T> >::zero(); }
+        return r_val;
+      }
+      static KOKKOS_FORCEINLINE_FUNCTION val_type one () {
+        val_type r_val;
+        for (int i=0;i<l;++i) { r_val[i] = ArithTraits<Kokkos::complex<T> >::one(); }
+        return r_val;
+      }
+
+      static const bool is_specialized = ArithTraits<Kokkos::complex<T> >::is_specialized;
+      static const bool is_signed = ArithTraits<Kokkos::complex<T> >::is_signed;
+      static const bool is_integer = ArithTraits<Kokkos::complex<T> >::is_integer;
+      static const bool is_exact = ArithTraits<Kokkos::complex<T> >::is_exact;
+      static const bool is_complex = ArithTraits<Kokkos::complex<T> >::is_complex;
     };
 
   }
@@ -155,6 +155,8 @@ namespace KokkosBatched {
       KOKKOS_INLINE_FUNCTION Vector(const value_type &val) { _data = _mm256_set1_pd(val); }
       KOKKOS_INLINE_FUNCTION Vector(const type &b) { _data = b._data; }
       KOKKOS_INLINE_FUNCTION Vector(const __m256d &val) { _data = val; }
+      // widening from single precision for mixed precision kernels
+      KOKKOS_INLINE_FUNCTION Vector(const Vector<SIMD<float>,4> &b) { _data = _mm256_cvtps_pd(_mm_loadu_ps(&b[0])); }
 
       template<typename ArgValueType>
       KOKKOS_INLINE_FUNCTION Vector(const ArgValueType &val) {
@@ -338,6 +340,8 @@ namespace KokkosBatched {
       KOKKOS_INLINE_FUNCTION Vector(const value_type &val) { _data = _mm512_set1_pd(val); }
       KOKKOS_INLINE_FUNCTION Vector(const type &b) { _data = b._data; }
       KOKKOS_INLINE_FUNCTION Vector(const __m512d &val) { _data = val; }
+      // widening from single precision for mixed precision kernels
+      KOKKOS_INLINE_FUNCTION Vector(const Vector<SIMD<float>,8> &b) { _data = _mm512_cvtps_pd(_mm256_loadu_ps(&b[0])); }
 
       template<typename ArgValueType>
       KOKKOS_INLINE_FUNCTION Vector(const ArgValueType &val) {
@@ -501,6 +505,378 @@ namespace KokkosBatched {
       }
     };
 #endif
+    template<>
+    class Vector<SIMD<float>,16> {
+    public:
+      using type = Vector<SIMD<float>,16>;
+      using value_type = float;
+      using mag_type = float;
+
+      enum : int { vector_length = 16 };
+      typedef __m512 data_type __attribute__ ((aligned(64)));
+
+      KOKKOS_INLINE_FUNCTION
+      static const char* label() { return "AVX512"; }
+
+      template<typename,int>
+      friend class Vector;
+
+    private:
+      mutable data_type _data;
+
+    public:
+      KOKKOS_INLINE_FUNCTION Vector() { _data = _mm512_setzero_ps(); }
+      KOKKOS_INLINE_FUNCTION Vector(const value_type &val) { _data = _mm512_set1_ps(val); }
+      KOKKOS_INLINE_FUNCTION Vector(const type &b) { _data = b._data; }
+      KOKKOS_INLINE_FUNCTION Vector(const __m512 &val) { _data = val; }
+
+      template<typename ArgValueType>
+      KOKKOS_INLINE_FUNCTION Vector(const ArgValueType &val) {
+        auto d = reinterpret_cast<value_type*>(&_data);
+#if defined( KOKKOS_ENABLE_PRAGMA_IVDEP )
+#pragma ivdep
+#endif
+#if defined( KOKKOS_ENABLE_PRAGMA_VECTOR )
+#pragma vector always
+#endif
+        for (int i=0;i<vector_length;++i)
+          d[i] = val;
+      }
+      template<typename ArgValueType>
+      KOKKOS_INLINE_FUNCTION Vector(const Vector<SIMD<ArgValueType>,vector_length> &b) {
+        static_assert(std::is_convertible<value_type,ArgValueType>::value, "input type is not convertible");
+        auto dd = reinterpret_cast<value_type*>(&_data);
+        auto bb = reinterpret_cast<ArgValueType*>(&b._data);
+#if defined( KOKKOS_ENABLE_PRAGMA_IVDEP )
+#pragma ivdep
+#endif
+#if defined( KOKKOS_ENABLE_PRAGMA_VECTOR )
+#pragma vector always
+#endif
+        for (int i=0;i<vector_length;++i)
+          dd[i] = bb[i];
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& operator=(const __m512 &val) {
+        _data = val;
+        return *this;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      operator __m512() const {
+        return _data;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& loadAligned(const value_type *p) {
+        _data = _mm512_load_ps((mag_type*)p);
+        return *this;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& loadUnaligned(const value_type *p) {
+        _data = _mm512_loadu_ps((mag_type*)p);
+        return *this;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      void storeAligned(value_type *p) const {
+        _mm512_store_ps((mag_type*)p, _data);
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      void storeUnaligned(value_type *p) const {
+        _mm512_storeu_ps((mag_type*)p, _data);
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      value_type& operator[](const int &i) const {
+        return reinterpret_cast<value_type*>(&_data)[i];
+      }
+    };
+
+    template<>
+    class Vector<SIMD<Kokkos::complex<float> >,8> {
+    public:
+      using type = Vector<SIMD<Kokkos::complex<float> >,8>;
+      using value_type = Kokkos::complex<float>;
+      using mag_type = float;
+
+      enum : int { vector_length = 8 };
+      typedef __m512 data_type __attribute__ ((aligned(64)));
+
+      KOKKOS_INLINE_FUNCTION
+      static const char* label() { return "AVX512"; }
+
+      template<typename,int>
+      friend class Vector;
+
+    private:
+      mutable data_type _data;
+
+    public:
+      KOKKOS_INLINE_FUNCTION Vector() { _data = _mm512_setzero_ps(); }
+      KOKKOS_INLINE_FUNCTION Vector(const value_type &val) { _data = _mm512_castpd_ps(_mm512_set1_pd(*(const double*)&val)); }
+      KOKKOS_INLINE_FUNCTION Vector(const mag_type &val) { const value_type a(val); _data = _mm512_castpd_ps(_mm512_set1_pd(*(const double*)&a)); }
+      KOKKOS_INLINE_FUNCTION Vector(const type &b) { _data = b._data; }
+      KOKKOS_INLINE_FUNCTION Vector(const __m512 &val) { _data = val; }
+
+      template<typename ArgValueType>
+      KOKKOS_INLINE_FUNCTION Vector(const ArgValueType &val) {
+        auto d = reinterpret_cast<value_type*>(&_data);
+#if defined( KOKKOS_ENABLE_PRAGMA_IVDEP )
+#pragma ivdep
+#endif
+#if defined( KOKKOS_ENABLE_PRAGMA_VECTOR )
+#pragma vector always
+#endif
+        for (int i=0;i<vector_length;++i)
+          d[i] = val;
+      }
+      template<typename ArgValueType>
+      KOKKOS_INLINE_FUNCTION Vector(const Vector<SIMD<ArgValueType>,vector_length> &b) {
+        static_assert(std::is_convertible<value_type,ArgValueType>::value, "input type is not convertible");
+        auto dd = reinterpret_cast<value_type*>(&_data);
+        auto bb = reinterpret_cast<ArgValueType*>(&b._data);
+#if defined( KOKKOS_ENABLE_PRAGMA_IVDEP )
+#pragma ivdep
+#endif
+#if defined( KOKKOS_ENABLE_PRAGMA_VECTOR )
+#pragma vector always
+#endif
+        for (int i=0;i<vector_length;++i)
+          dd[i] = bb[i];
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& operator=(const __m512 &val) {
+        _data = val;
+        return *this;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      operator __m512() const {
+        return _data;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& loadAligned(const value_type *p) {
+        _data = _mm512_load_ps((mag_type*)p);
+        return *this;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& loadUnaligned(const value_type *p) {
+        _data = _mm512_loadu_ps((mag_type*)p);
+        return *this;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      void storeAligned(value_type *p) const {
+        _mm512_store_ps((mag_type*)p, _data);
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      void storeUnaligned(value_type *p) const {
+        _mm512_storeu_ps((mag_type*)p, _data);
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      value_type& operator[](const int &i) const {
+        return reinterpret_cast<value_type*>(&_data)[i];
+      }
+    };
+
+#endif
+
+#if defined(__KOKKOSBATCHED_ENABLE_SVE512__)
+#include <arm_sve.h>
+
+    template<>
+    class Vector<SIMD<double>,8> {
+    public:
+      using type = Vector<SIMD<double>,8>;
+      using value_type = double;
+      using mag_type = double;
+
+      enum : int { vector_length = 8 };
+      typedef svfloat64_t sve_type;
+      typedef svfloat64_t data_type __attribute__ ((arm_sve_vector_bits(512)));
+
+      KOKKOS_INLINE_FUNCTION
+      static const char* label() { return "SVE512"; }
+
+      template<typename,int>
+      friend class Vector;
+
+    private:
+      mutable data_type _data;
+
+    public:
+      KOKKOS_INLINE_FUNCTION Vector() { _data = svdup_n_f64(0.0); }
+      KOKKOS_INLINE_FUNCTION Vector(const value_type &val) { _data = svdup_n_f64(val); }
+      KOKKOS_INLINE_FUNCTION Vector(const type &b) { _data = b._data; }
+      KOKKOS_INLINE_FUNCTION Vector(const sve_type &val) { _data = val; }
+
+      template<typename ArgValueType>
+      KOKKOS_INLINE_FUNCTION Vector(const ArgValueType &val) {
+        auto d = reinterpret_cast<value_type*>(&_data);
+#if defined( KOKKOS_ENABLE_PRAGMA_IVDEP )
+#pragma ivdep
+#endif
+#if defined( KOKKOS_ENABLE_PRAGMA_VECTOR )
+#pragma vector always
+#endif
+        for (int i=0;i<vector_length;++i)
+          d[i] = val;
+      }
+      template<typename ArgValueType>
+      KOKKOS_INLINE_FUNCTION Vector(const Vector<SIMD<ArgValueType>,vector_length> &b) {
+        static_assert(std::is_convertible<value_type,ArgValueType>::value, "input type is not convertible");
+        auto dd = reinterpret_cast<value_type*>(&_data);
+        auto bb = reinterpret_cast<ArgValueType*>(&b._data);
+#if defined( KOKKOS_ENABLE_PRAGMA_IVDEP )
+#pragma ivdep
+#endif
+#if defined( KOKKOS_ENABLE_PRAGMA_VECTOR )
+#pragma vector always
+#endif
+        for (int i=0;i<vector_length;++i)
+          dd[i] = bb[i];
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& operator=(const sve_type &val) {
+        _data = val;
+        return *this;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      operator sve_type() const {
+        return _data;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& loadAligned(const value_type *p) {
+        _data = svld1_f64(svptrue_b64(), p);
+        return *this;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& loadUnaligned(const value_type *p) {
+        return loadAligned(p);
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      void storeAligned(value_type *p) const {
+        svst1_f64(svptrue_b64(), p, _data);
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      void storeUnaligned(value_type *p) const {
+        storeAligned(p);
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      value_type& operator[](const int &i) const {
+        return reinterpret_cast<value_type*>(&_data)[i];
+      }
+    };
+#endif
+
+#if defined(__KOKKOSBATCHED_ENABLE_NEON__)
+#include <arm_neon.h>
+
+    template<>
+    class Vector<SIMD<double>,2> {
+    public:
+      using type = Vector<SIMD<double>,2>;
+      using value_type = double;
+      using mag_type = double;
+
+      enum : int { vector_length = 2 };
+      typedef float64x2_t data_type __attribute__ ((aligned(16)));
+
+      KOKKOS_INLINE_FUNCTION
+      static const char* label() { return "NEON"; }
+
+      template<typename,int>
+      friend class Vector;
+
+    private:
+      mutable data_type _data;
+
+    public:
+      KOKKOS_INLINE_FUNCTION Vector() { _data = vdupq_n_f64(0.0); }
+      KOKKOS_INLINE_FUNCTION Vector(const value_type &val) { _data = vdupq_n_f64(val); }
+      KOKKOS_INLINE_FUNCTION Vector(const type &b) { _data = b._data; }
+      KOKKOS_INLINE_FUNCTION Vector(const float64x2_t &val) { _data = val; }
+
+      template<typename ArgValueType>
+      KOKKOS_INLINE_FUNCTION Vector(const ArgValueType &val) {
+        auto d = reinterpret_cast<value_type*>(&_data);
+#if defined( KOKKOS_ENABLE_PRAGMA_IVDEP )
+#pragma ivdep
+#endif
+#if defined( KOKKOS_ENABLE_PRAGMA_VECTOR )
+#pragma vector always
+#endif
+        for (int i=0;i<vector_length;++i)
+          d[i] = val;
+      }
+      template<typename ArgValueType>
+      KOKKOS_INLINE_FUNCTION Vector(const Vector<SIMD<ArgValueType>,vector_length> &b) {
+        static_assert(std::is_convertible<value_type,ArgValueType>::value, "input type is not convertible");
+        auto dd = reinterpret_cast<value_type*>(&_data);
+        auto bb = reinterpret_cast<ArgValueType*>(&b._data);
+#if defined( KOKKOS_ENABLE_PRAGMA_IVDEP )
+#pragma ivdep
+#endif
+#if defined( KOKKOS_ENABLE_PRAGMA_VECTOR )
+#pragma vector always
+#endif
+        for (int i=0;i<vector_length;++i)
+          dd[i] = bb[i];
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& operator=(const float64x2_t &val) {
+        _data = val;
+        return *this;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      operator float64x2_t() const {
+        return _data;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& loadAligned(const value_type *p) {
+        _data = vld1q_f64(p);
+        return *this;
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      type& loadUnaligned(const value_type *p) {
+        return loadAligned(p);
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      void storeAligned(value_type *p) const {
+        vst1q_f64(p, _data);
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      void storeUnaligned(value_type *p) const {
+        storeAligned(p);
+      }
+
+      KOKKOS_INLINE_FUNCTION
+      value_type& operator[](const int &i) const {
+        return reinterpret_cast<value_type*>(&_data)[i];
+      }
+    };
 #endif
   }
 }
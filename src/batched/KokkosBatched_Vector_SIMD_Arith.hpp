@@ -52,6 +52,38 @@ namespace KokkosBatched {
 #endif
 #endif
 
+#if defined(__KOKKOSBATCHED_ENABLE_AVX__) && defined(__AVX512F__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(float,16)
+    operator + (const Vector<SIMD<float>,16> &a, const Vector<SIMD<float>,16> &b) {
+      return _mm512_add_ps(a, b);
+    }
+
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(Kokkos::complex<float>,8)
+    operator + (const Vector<SIMD<Kokkos::complex<float> >,8> &a, const Vector<SIMD<Kokkos::complex<float> >,8> &b) {
+      return _mm512_add_ps(a, b);
+    }
+#endif
+#if defined(__KOKKOSBATCHED_ENABLE_SVE512__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(double,8)
+    operator + (const Vector<SIMD<double>,8> &a, const Vector<SIMD<double>,8> &b) {
+      return svadd_f64_x(svptrue_b64(), a, b);
+    }
+#endif
+#if defined(__KOKKOSBATCHED_ENABLE_NEON__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(double,2)
+    operator + (const Vector<SIMD<double>,2> &a, const Vector<SIMD<double>,2> &b) {
+      return vaddq_f64(a, b);
+    }
+#endif
+
     template<typename T, int l>
     KOKKOS_FORCEINLINE_FUNCTION 
     static
@@ -221,6 +253,38 @@ namespace KokkosBatched {
 #endif
 #endif
 
+#if defined(__KOKKOSBATCHED_ENABLE_AVX__) && defined(__AVX512F__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(float,16)
+    operator - (const Vector<SIMD<float>,16> &a, const Vector<SIMD<float>,16> &b) {
+      return _mm512_sub_ps(a, b);
+    }
+
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(Kokkos::complex<float>,8)
+    operator - (const Vector<SIMD<Kokkos::complex<float> >,8> &a, const Vector<SIMD<Kokkos::complex<float> >,8> &b) {
+      return _mm512_sub_ps(a, b);
+    }
+#endif
+#if defined(__KOKKOSBATCHED_ENABLE_SVE512__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(double,8)
+    operator - (const Vector<SIMD<double>,8> &a, const Vector<SIMD<double>,8> &b) {
+      return svsub_f64_x(svptrue_b64(), a, b);
+    }
+#endif
+#if defined(__KOKKOSBATCHED_ENABLE_NEON__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(double,2)
+    operator - (const Vector<SIMD<double>,2> &a, const Vector<SIMD<double>,2> &b) {
+      return vsubq_f64(a, b);
+    }
+#endif
+
     template<typename T, int l>
     KOKKOS_FORCEINLINE_FUNCTION
     static 
@@ -433,6 +497,43 @@ namespace KokkosBatched {
 #endif
 #endif
 
+#if defined(__KOKKOSBATCHED_ENABLE_AVX__) && defined(__AVX512F__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(float,16)
+    operator * (const Vector<SIMD<float>,16> &a, const Vector<SIMD<float>,16> &b) {
+      return _mm512_mul_ps(a, b);
+    }
+
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(Kokkos::complex<float>,8)
+    operator * (const Vector<SIMD<Kokkos::complex<float> >,8> &a, const Vector<SIMD<Kokkos::complex<float> >,8> &b) {
+      // (ar br - ai bi, ai br + ar bi)
+      const __m512
+        as = _mm512_permute_ps(a, 0xB1),
+        br = _mm512_moveldup_ps(b),
+        bi = _mm512_movehdup_ps(b);
+      return _mm512_fmaddsub_ps(a, br, _mm512_mul_ps(as, bi));
+    }
+#endif
+#if defined(__KOKKOSBATCHED_ENABLE_SVE512__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(double,8)
+    operator * (const Vector<SIMD<double>,8> &a, const Vector<SIMD<double>,8> &b) {
+      return svmul_f64_x(svptrue_b64(), a, b);
+    }
+#endif
+#if defined(__KOKKOSBATCHED_ENABLE_NEON__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(double,2)
+    operator * (const Vector<SIMD<double>,2> &a, const Vector<SIMD<double>,2> &b) {
+      return vmulq_f64(a, b);
+    }
+#endif
+
     template<typename T, int l>
     KOKKOS_FORCEINLINE_FUNCTION
     static 
@@ -672,6 +773,46 @@ namespace KokkosBatched {
 #endif
 #endif
 
+#if defined(__KOKKOSBATCHED_ENABLE_AVX__) && defined(__AVX512F__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(float,16)
+    operator / (const Vector<SIMD<float>,16> &a, const Vector<SIMD<float>,16> &b) {
+      return _mm512_div_ps(a, b);
+    }
+
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(Kokkos::complex<float>,8)
+    operator / (const Vector<SIMD<Kokkos::complex<float> >,8> &a, const Vector<SIMD<Kokkos::complex<float> >,8> &b) {
+      // a conj(b) / |b|^2
+      const __m512
+        as = _mm512_permute_ps(a, 0xB1),
+        cb = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(b),
+                                                  _mm512_set1_epi64((long long)0x8000000000000000ULL))),
+        br = _mm512_moveldup_ps(cb),
+        bi = _mm512_movehdup_ps(cb);
+      return _mm512_div_ps(_mm512_fmaddsub_ps(a,  br, _mm512_mul_ps(as, bi)),
+                           _mm512_fmadd_ps   (br, br, _mm512_mul_ps(bi, bi)));
+    }
+#endif
+#if defined(__KOKKOSBATCHED_ENABLE_SVE512__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(double,8)
+    operator / (const Vector<SIMD<double>,8> &a, const Vector<SIMD<double>,8> &b) {
+      return svdiv_f64_x(svptrue_b64(), a, b);
+    }
+#endif
+#if defined(__KOKKOSBATCHED_ENABLE_NEON__)
+    KOKKOS_FORCEINLINE_FUNCTION
+    static
+    KOKKOSKERNELS_SIMD_ARITH_RETURN_TYPE(double,2)
+    operator / (const Vector<SIMD<double>,2> &a, const Vector<SIMD<double>,2> &b) {
+      return vdivq_f64(a, b);
+    }
+#endif
+
     template<typename T, int l>
     KOKKOS_FORCEINLINE_FUNCTION
     static 
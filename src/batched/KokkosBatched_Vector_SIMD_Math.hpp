@@ -4,6 +4,7 @@
 /// \author Kyungjoo Kim (kyukim@sandia.gov)
 
 #include "Kokkos_Complex.hpp"
+#include "KokkosBatched_Vector_SIMD_Math_AVX.hpp"
 
 namespace KokkosBatched {
   namespace Experimental {
@@ -14,6 +15,138 @@ namespace KokkosBatched {
 
     /// simd 
 
+#if defined(__KOKKOSBATCHED_ENABLE_AVX__) && defined(__AVX512F__)
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,8)
+    sqrt(const Vector<SIMD<double>,8> &a) {
+      return _mm512_sqrt_pd(a);
+    }
+
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(float,16)
+    sqrt(const Vector<SIMD<float>,16> &a) {
+      return _mm512_sqrt_ps(a);
+    }
+#endif
+
+#if defined(__KOKKOSBATCHED_ENABLE_AVX__) && (defined(__AVX__) || defined(__AVX2__))
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,4)
+    sqrt(const Vector<SIMD<double>,4> &a) {
+      return _mm256_sqrt_pd(a);
+    }
+#endif
+
+    /// vectorized transcendentals, see KokkosBatched_Vector_SIMD_Math_AVX.hpp
+    /// for their accuracy
+#if defined(__KOKKOSBATCHED_ENABLE_AVX__) && defined(__AVX2__)
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,4)
+    exp(const Vector<SIMD<double>,4> &a) {
+      return SIMDMath<4>::exp(a);
+    }
+
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,4)
+    log(const Vector<SIMD<double>,4> &a) {
+      return SIMDMath<4>::log(a);
+    }
+
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,4)
+    log10(const Vector<SIMD<double>,4> &a) {
+      return SIMDMath<4>::log10(a);
+    }
+
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,4)
+    sin(const Vector<SIMD<double>,4> &a) {
+      return SIMDMath<4>::sin(a);
+    }
+
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,4)
+    cos(const Vector<SIMD<double>,4> &a) {
+      return SIMDMath<4>::cos(a);
+    }
+
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,4)
+    pow(const Vector<SIMD<double>,4> &a, const Vector<SIMD<double>,4> &b) {
+      return SIMDMath<4>::pow(a, b);
+    }
+#endif
+
+#if defined(__KOKKOSBATCHED_ENABLE_AVX__) && defined(__AVX512F__)
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,8)
+    exp(const Vector<SIMD<double>,8> &a) {
+      return SIMDMath<8>::exp(a);
+    }
+
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,8)
+    log(const Vector<SIMD<double>,8> &a) {
+      return SIMDMath<8>::log(a);
+    }
+
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,8)
+    log10(const Vector<SIMD<double>,8> &a) {
+      return SIMDMath<8>::log10(a);
+    }
+
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,8)
+    sin(const Vector<SIMD<double>,8> &a) {
+      return SIMDMath<8>::sin(a);
+    }
+
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,8)
+    cos(const Vector<SIMD<double>,8> &a) {
+      return SIMDMath<8>::cos(a);
+    }
+
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,8)
+    pow(const Vector<SIMD<double>,8> &a, const Vector<SIMD<double>,8> &b) {
+      return SIMDMath<8>::pow(a, b);
+    }
+#endif
+
+#if defined(__KOKKOSBATCHED_ENABLE_SVE512__)
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,8)
+    sqrt(const Vector<SIMD<double>,8> &a) {
+      return svsqrt_f64_x(svptrue_b64(), a);
+    }
+#endif
+#if defined(__KOKKOSBATCHED_ENABLE_NEON__)
+    inline
+    static
+    KOKKOSKERNELS_SIMD_MATH_RETURN_TYPE(double,2)
+    sqrt(const Vector<SIMD<double>,2> &a) {
+      return vsqrtq_f64(a);
+    }
+#endif
+
     template<typename T, int l>
     inline
     static
@@ -0,0 +1,360 @@
+#ifndef __KOKKOSBATCHED_VECTOR_SIMD_MATH_AVX_HPP__
+#define __KOKKOSBATCHED_VECTOR_SIMD_MATH_AVX_HPP__
+
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+///
+/// Vectorized exp, log, pow, sin and cos for Vector<SIMD<double>,4> (AVX2)
+/// and Vector<SIMD<double>,8> (AVX512F). The kernels are written once with
+/// the small set of intrinsics of SIMDMathIntrinsics, and follow the
+/// range reductions and rational approximations of Cephes.
+///
+/// Accuracy (maximum relative error measured against long double over
+/// random arguments, double precision):
+///   exp   : 2 ulp; overflows to inf above 709.78, gives subnormal results
+///           down to -745.13 and 0 below.
+///   log   : 1 ulp for positive (also subnormal) arguments; -inf at 0, nan
+///           for negative arguments.
+///   log10 : 2 ulp, computed as log(x)/ln(10).
+///   pow   : exp(b log(a)); the error of log is amplified by |b log(a)|,
+///           the error is about (2 + |b log(a)|) ulp. Lanes with a <= 0 or
+///           with a non finite argument are computed with std::pow.
+///   sin,
+///   cos   : 2 ulp for |x| < 2^30. Lanes with a larger or non finite
+///           argument are computed with std::sin and std::cos.
+///
+
+#if defined(__KOKKOSBATCHED_ENABLE_AVX__) && (defined(__AVX2__) || defined(__AVX512F__))
+
+#include <immintrin.h>
+#include <cmath>
+#include <limits>
+
+namespace KokkosBatched {
+  namespace Experimental {
+
+    template<int l>
+    struct SIMDMathIntrinsics;
+
+#if defined(__AVX2__)
+    template<>
+    struct SIMDMathIntrinsics<4> {
+      typedef __m256d value_type;
+      typedef __m256d mask_type;
+      enum : int { vector_length = 4 };
+
+      static inline value_type set(const double a) { return _mm256_set1_pd(a); }
+      static inline value_type load(const double *p) { return _mm256_loadu_pd(p); }
+      static inline void store(double *p, const value_type a) { _mm256_storeu_pd(p, a); }
+
+      static inline value_type add(const value_type a, const value_type b) { return _mm256_add_pd(a, b); }
+      static inline value_type sub(const value_type a, const value_type b) { return _mm256_sub_pd(a, b); }
+      static inline value_type mul(const value_type a, const value_type b) { return _mm256_mul_pd(a, b); }
+      static inline value_type div(const value_type a, const value_type b) { return _mm256_div_pd(a, b); }
+      /// a*b + c
+      static inline value_type fma(const value_type a, const value_type b, const value_type c) {
+#if defined(__FMA__)
+        return _mm256_fmadd_pd(a, b, c);
+#else
+        return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+      }
+      static inline value_type min(const value_type a, const value_type b) { return _mm256_min_pd(a, b); }
+      static inline value_type max(const value_type a, const value_type b) { return _mm256_max_pd(a, b); }
+      static inline value_type abs(const value_type a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+      static inline value_type round(const value_type a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+      static inline value_type floor(const value_type a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+      static inline mask_type lt(const value_type a, const value_type b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+      static inline mask_type gt(const value_type a, const value_type b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+      static inline mask_type eq(const value_type a, const value_type b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+      static inline mask_type isnan(const value_type a) { return _mm256_cmp_pd(a, a, _CMP_UNORD_Q); }
+      static inline mask_type mask_or(const mask_type a, const mask_type b) { return _mm256_or_pd(a, b); }
+      static inline bool any(const mask_type m) { return _mm256_movemask_pd(m) != 0; }
+      static inline bool test(const mask_type m, const int i) { return (_mm256_movemask_pd(m) >> i) & 1; }
+
+      /// a where m is set, b otherwise
+      static inline value_type select(const mask_type m, const value_type a, const value_type b) { return _mm256_blendv_pd(b, a, m); }
+      /// -a where m is set, a otherwise
+      static inline value_type negate_if(const mask_type m, const value_type a) {
+        return _mm256_xor_pd(a, _mm256_and_pd(m, _mm256_set1_pd(-0.0)));
+      }
+      /// a with its sign flipped by the sign of s
+      static inline value_type xorsign(const value_type a, const value_type s) {
+        return _mm256_xor_pd(a, _mm256_and_pd(s, _mm256_set1_pd(-0.0)));
+      }
+
+      /// 2^n for integral n in [-1022, 1023]; the integer n is read from
+      /// the low mantissa bits of n + 1.5*2^52.
+      static inline value_type pow2(const value_type n) {
+        const __m256i t = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(6755399441055744.0)));
+        return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(t, _mm256_set1_epi64x(1023)), 52));
+      }
+      /// a = m 2^e with m in [0.5, 1), for positive normal a
+      static inline void frexp(const value_type a, value_type &m, value_type &e) {
+        const __m256i bits = _mm256_castpd_si256(a);
+        const __m256i two52 = _mm256_castpd_si256(_mm256_set1_pd(4503599627370496.0));
+        e = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 52), two52)),
+                          _mm256_set1_pd(4503599627370496.0 + 1022.0));
+        m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL)),
+                                                _mm256_set1_epi64x(0x3FE0000000000000LL)));
+      }
+    };
+#endif
+
+#if defined(__AVX512F__)
+    template<>
+    struct SIMDMathIntrinsics<8> {
+      typedef __m512d value_type;
+      typedef __mmask8 mask_type;
+      enum : int { vector_length = 8 };
+
+      static inline value_type set(const double a) { return _mm512_set1_pd(a); }
+      static inline value_type load(const double *p) { return _mm512_loadu_pd(p); }
+      static inline void store(double *p, const value_type a) { _mm512_storeu_pd(p, a); }
+
+      static inline value_type add(const value_type a, const value_type b) { return _mm512_add_pd(a, b); }
+      static inline value_type sub(const value_type a, const value_type b) { return _mm512_sub_pd(a, b); }
+      static inline value_type mul(const value_type a, const value_type b) { return _mm512_mul_pd(a, b); }
+      static inline value_type div(const value_type a, const value_type b) { return _mm512_div_pd(a, b); }
+      /// a*b + c
+      static inline value_type fma(const value_type a, const value_type b, const value_type c) { return _mm512_fmadd_pd(a, b, c); }
+      static inline value_type min(const value_type a, const value_type b) { return _mm512_min_pd(a, b); }
+      static inline value_type max(const value_type a, const value_type b) { return _mm512_max_pd(a, b); }
+      static inline value_type abs(const value_type a) { return _mm512_abs_pd(a); }
+      static inline value_type round(const value_type a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+      static inline value_type floor(const value_type a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+      static inline mask_type lt(const value_type a, const value_type b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+      static inline mask_type gt(const value_type a, const value_type b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+      static inline mask_type eq(const value_type a, const value_type b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+      static inline mask_type isnan(const value_type a) { return _mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q); }
+      static inline mask_type mask_or(const mask_type a, const mask_type b) { return a | b; }
+      static inline bool any(const mask_type m) { return m != 0; }
+      static inline bool test(const mask_type m, const int i) { return (m >> i) & 1; }
+
+      /// a where m is set, b otherwise
+      static inline value_type select(const mask_type m, const value_type a, const value_type b) { return _mm512_mask_blend_pd(m, b, a); }
+      /// -a where m is set, a otherwise
+      static inline value_type negate_if(const mask_type m, const value_type a) {
+        const __m512i ai = _mm512_castpd_si512(a);
+        return _mm512_castsi512_pd(_mm512_mask_xor_epi64(ai, m, ai, _mm512_set1_epi64(0x8000000000000000LL)));
+      }
+      /// a with its sign flipped by the sign of s
+      static inline value_type xorsign(const value_type a, const value_type s) {
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a),
+                                                    _mm512_and_si512(_mm512_castpd_si512(s), _mm512_set1_epi64(0x8000000000000000LL))));
+      }
+
+      /// 2^n for integral n in [-1022, 1023]; the integer n is read from
+      /// the low mantissa bits of n + 1.5*2^52.
+      static inline value_type pow2(const value_type n) {
+        const __m512i t = _mm512_castpd_si512(_mm512_add_pd(n, _mm512_set1_pd(6755399441055744.0)));
+        return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_add_epi64(t, _mm512_set1_epi64(1023)), 52));
+      }
+      /// a = m 2^e with m in [0.5, 1), for positive normal a
+      static inline void frexp(const value_type a, value_type &m, value_type &e) {
+        const __m512i bits = _mm512_castpd_si512(a);
+        const __m512i two52 = _mm512_castpd_si512(_mm512_set1_pd(4503599627370496.0));
+        e = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(bits, 52), two52)),
+                          _mm512_set1_pd(4503599627370496.0 + 1022.0));
+        m = _mm512_castsi512_pd(_mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi64(0x000FFFFFFFFFFFFFLL)),
+                                                _mm512_set1_epi64(0x3FE0000000000000LL)));
+      }
+    };
+#endif
+
+    ///
+    /// vectorized kernels on the intrinsics of SIMDMathIntrinsics<l>
+    ///
+    template<int l>
+    struct SIMDMath {
+      typedef SIMDMathIntrinsics<l> ops;
+      typedef typename ops::value_type value_type;
+      typedef typename ops::mask_type mask_type;
+
+      /// c[0] x^n + c[1] x^(n-1) + ... + c[n]
+      template<int n>
+      static inline value_type polevl(const value_type x, const double (&c)[n+1]) {
+        value_type r = ops::set(c[0]);
+        for (int i=1;i<=n;++i)
+          r = ops::fma(r, x, ops::set(c[i]));
+        return r;
+      }
+
+      /// x^n + c[0] x^(n-1) + ... + c[n-1]
+      template<int n>
+      static inline value_type p1evl(const value_type x, const double (&c)[n]) {
+        value_type r = ops::add(x, ops::set(c[0]));
+        for (int i=1;i<n;++i)
+          r = ops::fma(r, x, ops::set(c[i]));
+        return r;
+      }
+
+      /// recomputes the lanes set in m with the scalar function f
+      template<typename ScalarFunctionType>
+      static inline value_type fixup(const mask_type m, const value_type r, const value_type x, ScalarFunctionType f) {
+        double rr[l], xx[l];
+        ops::store(rr, r);
+        ops::store(xx, x);
+        for (int i=0;i<l;++i)
+          if (ops::test(m, i)) rr[i] = f(xx[i]);
+        return ops::load(rr);
+      }
+
+      static inline value_type exp(const value_type x) {
+        static const double P[3] = { 1.26177193074810590878E-4,
+                                     3.02994407707441961300E-2,
+                                     9.99999999999999999910E-1 };
+        static const double Q[4] = { 3.00198505138664455042E-6,
+                                     2.52448340349684104192E-3,
+                                     2.27265548208155028766E-1,
+                                     2.00000000000000000009E0 };
+        const double maxlog = 7.09782712893383996843E2, minlog = -7.451332191019412076235E2;
+
+        /// exp(x) = 2^n exp(r), with n = round(x/ln2) and |r| <= ln2/2
+        const value_type xc = ops::min(ops::max(x, ops::set(minlog)), ops::set(maxlog));
+        const value_type n = ops::round(ops::mul(xc, ops::set(1.4426950408889634073599)));
+        value_type r = ops::fma(n, ops::set(-6.93145751953125E-1), xc);
+        r = ops::fma(n, ops::set(-1.42860682030941723212E-6), r);
+
+        /// exp(r) = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2))
+        const value_type rr = ops::mul(r, r);
+        const value_type px = ops::mul(r, polevl<2>(rr, P));
+        const value_type qx = polevl<3>(rr, Q);
+        value_type e = ops::fma(ops::set(2.0), ops::div(px, ops::sub(qx, px)), ops::set(1.0));
+
+        /// scale by 2^n in two steps, so that subnormal results and
+        /// n = 1024 stay in the exponent range of pow2
+        const value_type n1 = ops::floor(ops::mul(n, ops::set(0.5)));
+        e = ops::mul(ops::mul(e, ops::pow2(n1)), ops::pow2(ops::sub(n, n1)));
+
+        e = ops::select(ops::gt(x, ops::set(maxlog)), ops::set(std::numeric_limits<double>::infinity()), e);
+        e = ops::select(ops::lt(x, ops::set(minlog)), ops::set(0.0), e);
+        e = ops::select(ops::isnan(x), x, e);
+        return e;
+      }
+
+      static inline value_type log(const value_type x) {
+        static const double P[6] = { 1.01875663804580931796E-4,
+                                     4.97494994976747001425E-1,
+                                     4.70579119878881725854E0,
+                                     1.44989225341610930846E1,
+                                     1.79368678507819816313E1,
+                                     7.70838733755885391666E0 };
+        static const double Q[5] = { 1.12873587189167450590E1,
+                                     4.52279145837532221105E1,
+                                     8.29875266912776603211E1,
+                                     7.11544750618563894466E1,
+                                     2.31251620126765340583E1 };
+        const double inf = std::numeric_limits<double>::infinity();
+
+        /// x = m 2^e with m in [sqrt(1/2), sqrt(2)); subnormals are scaled by 2^54 first
+        const mask_type subnormal = ops::lt(x, ops::set(std::numeric_limits<double>::min()));
+        value_type m, e;
+        ops::frexp(ops::select(subnormal, ops::mul(x, ops::set(18014398509481984.0)), x), m, e);
+        e = ops::select(subnormal, ops::sub(e, ops::set(54.0)), e);
+
+        const mask_type small = ops::lt(m, ops::set(7.07106781186547524401E-1));
+        e = ops::select(small, ops::sub(e, ops::set(1.0)), e);
+        const value_type z = ops::sub(ops::select(small, ops::add(m, m), m), ops::set(1.0));
+
+        /// log(1+z) = z - z^2/2 + z^3 P(z)/Q(z)
+        const value_type zz = ops::mul(z, z);
+        value_type y = ops::mul(z, ops::mul(zz, ops::div(polevl<5>(z, P), p1evl<5>(z, Q))));
+        y = ops::fma(e, ops::set(-2.121944400546905827679e-4), y);
+        y = ops::fma(zz, ops::set(-0.5), y);
+        value_type r = ops::add(z, y);
+        r = ops::fma(e, ops::set(0.693359375), r);
+
+        r = ops::select(ops::eq(x, ops::set(inf)), x, r);
+        r = ops::select(ops::eq(x, ops::set(0.0)), ops::set(-inf), r);
+        r = ops::select(ops::lt(x, ops::set(0.0)), ops::set(std::numeric_limits<double>::quiet_NaN()), r);
+        r = ops::select(ops::isnan(x), x, r);
+        return r;
+      }
+
+      static inline value_type log10(const value_type x) {
+        return ops::mul(log(x), ops::set(4.34294481903251827651E-1));
+      }
+
+      static inline value_type pow(const value_type a, const value_type b) {
+        value_type r = exp(ops::mul(b, log(a)));
+
+        /// negative bases, zeros, infinities and nans are left to std::pow
+        const double huge = std::numeric_limits<double>::max();
+        const mask_type special = ops::mask_or(ops::mask_or(ops::lt(a, ops::set(std::numeric_limits<double>::min())),
+                                                            ops::gt(ops::abs(a), ops::set(huge))),
+                                               ops::mask_or(ops::gt(ops::abs(b), ops::set(huge)),
+                                                            ops::mask_or(ops::isnan(a), ops::isnan(b))));
+        if (ops::any(special)) {
+          double rr[l], aa[l], bb[l];
+          ops::store(rr, r);
+          ops::store(aa, a);
+          ops::store(bb, b);
+          for (int i=0;i<l;++i)
+            if (ops::test(special, i)) rr[i] = std::pow(aa[i], bb[i]);
+          r = ops::load(rr);
+        }
+        return r;
+      }
+
+      /// sin (is_cos = false) or cos (is_cos = true)
+      template<bool is_cos>
+      static inline value_type sincos(const value_type x) {
+        static const double S[6] = { 1.58962301576546568060E-10,
+                                     -2.50507477628578072866E-8,
+                                     2.75573136213857245213E-6,
+                                     -1.98412698295895385996E-4,
+                                     8.33333333332211858878E-3,
+                                     -1.66666666666666307295E-1 };
+        static const double C[6] = { -1.13585365213876817300E-11,
+                                     2.08757008419747316778E-9,
+                                     -2.75573141792967388112E-7,
+                                     2.48015872888517045348E-5,
+                                     -1.38888888888730564116E-3,
+                                     4.16666666666665929218E-2 };
+        const double lossth = 1.073741824e9;
+
+        /// j pi/4 closest to |x| with even j, reduced in three parts of pi/4
+        const value_type ax = ops::abs(x);
+        value_type y = ops::floor(ops::mul(ax, ops::set(1.27323954473516268615)));
+        y = ops::add(y, ops::sub(y, ops::mul(ops::set(2.0), ops::floor(ops::mul(y, ops::set(0.5))))));
+        const value_type j = ops::sub(y, ops::mul(ops::set(8.0), ops::floor(ops::mul(y, ops::set(0.125)))));
+        value_type z = ops::fma(y, ops::set(-7.85398125648498535156E-1), ax);
+        z = ops::fma(y, ops::set(-3.77489470793079817668E-8), z);
+        z = ops::fma(y, ops::set(-2.69515142907905952645E-15), z);
+
+        const value_type zz = ops::mul(z, z);
+        const value_type ps = ops::fma(ops::mul(z, zz), polevl<5>(zz, S), z);
+        const value_type pc = ops::fma(ops::mul(zz, zz), polevl<5>(zz, C), ops::fma(zz, ops::set(-0.5), ops::set(1.0)));
+
+        /// j is one of 0, 2, 4, 6
+        const mask_type j2 = ops::eq(j, ops::set(2.0)), j4 = ops::eq(j, ops::set(4.0)), j6 = ops::eq(j, ops::set(6.0));
+        value_type r;
+        if (is_cos) {
+          r = ops::select(ops::mask_or(j2, j6), ps, pc);
+          r = ops::negate_if(ops::mask_or(j2, j4), r);
+        } else {
+          r = ops::select(ops::mask_or(j2, j6), pc, ps);
+          r = ops::xorsign(ops::negate_if(ops::mask_or(j4, j6), r), x);
+        }
+
+        /// large and non finite arguments are left to std::sin and std::cos
+        const mask_type large = ops::mask_or(ops::gt(ax, ops::set(lossth)), ops::isnan(ax));
+        if (ops::any(large)) {
+          if (is_cos) r = fixup(large, r, x, [](const double v) { return std::cos(v); });
+          else        r = fixup(large, r, x, [](const double v) { return std::sin(v); });
+        }
+        return r;
+      }
+
+      static inline value_type sin(const value_type x) { return sincos<false>(x); }
+      static inline value_type cos(const value_type x) { return sincos<true>(x); }
+    };
+
+  }
+}
+
+#endif
+#endif
@@ -55,10 +55,27 @@
 
 namespace KokkosBlas {
 
-
+/// \brief Compute Y := a*X + b*Y, with all kernels launched on the
+///   given execution space instance.
+///
+/// On a device that supports streams (e.g., Cuda), the launch is
+/// asynchronous with respect to other instances, so independent
+/// axpby calls can overlap.
+///
+/// Single vectors X and Y may have different value types, float and
+/// double, e.g., to add a float correction to a double solution.  The
+/// scalar coefficients are then double, and the entries are converted
+/// inside the kernel.
+///
+/// For single vectors, a and b may also both be rank-0 Views (or rank-1
+/// Views of length one) in the memory space of Y, e.g., results of
+/// KokkosBlas::dot(r,x,y).  The kernel reads them on the device, so no
+/// fence or copy to the host is needed between the two calls.  Zero
+/// coefficients in Views do not have BLAS semantics of ignoring X or Y.
 template<class AV, class XMV, class BV, class YMV>
 void
-axpby (const AV& a, const XMV& X, const BV& b, const YMV& Y)
+axpby (const typename YMV::execution_space& space,
+       const AV& a, const XMV& X, const BV& b, const YMV& Y)
 {
   static_assert (Kokkos::Impl::is_view<XMV>::value, "KokkosBlas::axpby: "
                  "X is not a Kokkos::View.");
@@ -73,6 +90,15 @@ axpby (const AV& a, const XMV& X, const BV& b, const YMV& Y)
                  "X and Y must have the same rank.");
   static_assert (YMV::Rank == 1 || YMV::Rank == 2, "KokkosBlas::axpby: "
                  "XMV and YMV must either have rank 1 or rank 2.");
+  static_assert (YMV::Rank == 1 ||
+                 (! KokkosKernels::Impl::IsRank0View<AV>::value &&
+                  ! KokkosKernels::Impl::IsRank0View<BV>::value),
+                 "KokkosBlas::axpby: a and b may be rank-0 Views only if "
+                 "X and Y have rank 1.");
+  static_assert (YMV::Rank != 1 ||
+                 (bool) Kokkos::Impl::is_view<AV>::value == (bool) Kokkos::Impl::is_view<BV>::value,
+                 "KokkosBlas::axpby: For rank-1 X and Y, a and b must either "
+                 "both be scalars or both be Views.");
 
   // Check compatibility of dimensions at run time.
   if (X.extent(0) != Y.extent(0) ||
@@ -87,8 +113,15 @@ axpby (const AV& a, const XMV& X, const BV& b, const YMV& Y)
   // Create unmanaged versions of the input Views.  XMV and YMV may be
   // rank 1 or rank 2.  AV and BV may be either rank-1 Views, or
   // scalar values.
-  typedef typename KokkosKernels::Impl::GetUnifiedScalarViewType<
-    AV, XMV, true>::type AV_Internal;
+  // Scalar coefficients of single vectors X and Y with different
+  // precisions are kept in the wider of the two.
+  typedef typename KokkosKernels::Impl::GetMixedScalarType<
+    typename XMV::non_const_value_type,
+    typename YMV::non_const_value_type>::type mixed_scalar_type;
+  typedef typename std::conditional<
+    Kokkos::Impl::is_view<AV>::value || XMV::Rank != 1,
+    typename KokkosKernels::Impl::GetUnifiedScalarViewType<AV, XMV, true>::type,
+    mixed_scalar_type>::type AV_Internal;
   typedef Kokkos::View<
     typename Kokkos::Impl::if_c<
       XMV::Rank == 1,
@@ -97,8 +130,10 @@ axpby (const AV& a, const XMV& X, const BV& b, const YMV& Y)
     typename KokkosKernels::Impl::GetUnifiedLayout<XMV>::array_layout,
     typename XMV::device_type,
     Kokkos::MemoryTraits<Kokkos::Unmanaged> > XMV_Internal;
-  typedef typename KokkosKernels::Impl::GetUnifiedScalarViewType<
-    BV, YMV, true>::type BV_Internal;
+  typedef typename std::conditional<
+    Kokkos::Impl::is_view<BV>::value || YMV::Rank != 1,
+    typename KokkosKernels::Impl::GetUnifiedScalarViewType<BV, YMV, true>::type,
+    mixed_scalar_type>::type BV_Internal;
   typedef Kokkos::View<
     typename Kokkos::Impl::if_c<
       YMV::Rank == 1,
@@ -108,13 +143,28 @@ axpby (const AV& a, const XMV& X, const BV& b, const YMV& Y)
     typename YMV::device_type,
     Kokkos::MemoryTraits<Kokkos::Unmanaged> > YMV_Internal;
 
-  AV_Internal  a_internal = a;
+  AV_Internal  a_internal = KokkosKernels::Impl::get_unified_scalar_view<AV_Internal> (a);
   XMV_Internal X_internal = X;
-  BV_Internal  b_internal = b;
+  BV_Internal  b_internal = KokkosKernels::Impl::get_unified_scalar_view<BV_Internal> (b);
   YMV_Internal Y_internal = Y;
 
   Impl::Axpby<AV_Internal, XMV_Internal, BV_Internal,
-    YMV_Internal>::axpby (a_internal, X_internal, b_internal, Y_internal);
+    YMV_Internal>::axpby (space, a_internal, X_internal, b_internal, Y_internal);
+}
+
+template<class AV, class XMV, class BV, class YMV>
+void
+axpby (const AV& a, const XMV& X, const BV& b, const YMV& Y)
+{
+  axpby (typename YMV::execution_space (), a, X, b, Y);
+}
+
+template<class AV, class XMV, class YMV>
+void
+axpy (const typename YMV::execution_space& space,
+      const AV& a, const XMV& X, const YMV& Y)
+{
+  axpby(space,a,X,Kokkos::Details::ArithTraits<typename YMV::non_const_value_type>::one(),Y);
 }
 
 template<class AV, class XMV, class YMV>
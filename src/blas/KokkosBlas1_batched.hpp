@@ -0,0 +1,187 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSBLAS1_BATCHED_HPP_
+#define KOKKOSBLAS1_BATCHED_HPP_
+
+/// \file KokkosBlas1_batched.hpp
+/// \brief BLAS1 on many independent short vectors.
+///
+/// The functions here take a rank 2 view whose columns X(:,k) are
+/// independent vectors, e.g. 100k vectors of length 50, and process all
+/// of them in one launch.  The multivector KokkosBlas::dot, nrm2 and
+/// axpby parallelize over the rows and are built for a few long
+/// columns; with many short columns they launch once per few columns
+/// or leave most of the device idle.  The mapping of vectors onto
+/// teams, threads and vector lanes is chosen from the vector length
+/// and the layout (see Impl::batched_mapping).  Within a kernel, use
+/// the team versions (KokkosBlas1_team_dot.hpp etc.) instead.
+
+#include <sstream>
+#include <type_traits>
+#include <Kokkos_Core.hpp>
+#include <KokkosBlas1_batched_impl.hpp>
+
+namespace KokkosBlas {
+namespace Experimental {
+
+/// \brief R(k) = dot(X(:,k), Y(:,k)) for every column k.
+///
+/// \param R [out] Rank 1 Kokkos::View with X.extent(1) entries.
+/// \param X [in] Rank 2 Kokkos::View, one vector per column.
+/// \param Y [in] Rank 2 Kokkos::View, same dimensions as X.
+template<class RV, class XMV, class YMV>
+void
+batched_dot (const RV& R, const XMV& X, const YMV& Y)
+{
+  static_assert (Kokkos::Impl::is_view<RV>::value &&
+                 Kokkos::Impl::is_view<XMV>::value &&
+                 Kokkos::Impl::is_view<YMV>::value,
+                 "KokkosBlas::Experimental::batched_dot: R, X and Y must be Kokkos::View.");
+  static_assert ((int) RV::rank == 1 && (int) XMV::rank == 2 && (int) YMV::rank == 2,
+                 "KokkosBlas::Experimental::batched_dot: R must have rank 1, X and Y rank 2.");
+  static_assert (std::is_same<typename RV::value_type,
+                   typename RV::non_const_value_type>::value,
+                 "KokkosBlas::Experimental::batched_dot: R must be non-const.");
+
+  if (X.extent(0) != Y.extent(0) || X.extent(1) != Y.extent(1) ||
+      R.extent(0) != X.extent(1)) {
+    std::ostringstream os;
+    os << "KokkosBlas::Experimental::batched_dot: Dimensions do not match: "
+       << "R: " << R.extent(0)
+       << ", X: " << X.extent(0) << " x " << X.extent(1)
+       << ", Y: " << Y.extent(0) << " x " << Y.extent(1);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  if (X.extent(1) == 0) return;
+
+  typedef typename XMV::execution_space execution_space;
+  const Impl::BatchedMapping m = Impl::batched_mapping<execution_space>
+    (X.extent_int(0), X.stride_0() == 1 && Y.stride_0() == 1);
+  Impl::run_batched_functor<execution_space>
+    ("KokkosBlas::Experimental::batched_dot", X.extent_int(1), m,
+     Impl::Batched_Dot_Functor<RV, XMV, YMV> (R, X, Y, m));
+}
+
+/// \brief R(k) = nrm2(X(:,k)) for every column k.
+///
+/// \param R [out] Rank 1 Kokkos::View with X.extent(1) entries.
+/// \param X [in] Rank 2 Kokkos::View, one vector per column.
+template<class RV, class XMV>
+void
+batched_nrm2 (const RV& R, const XMV& X)
+{
+  static_assert (Kokkos::Impl::is_view<RV>::value &&
+                 Kokkos::Impl::is_view<XMV>::value,
+                 "KokkosBlas::Experimental::batched_nrm2: R and X must be Kokkos::View.");
+  static_assert ((int) RV::rank == 1 && (int) XMV::rank == 2,
+                 "KokkosBlas::Experimental::batched_nrm2: R must have rank 1, X rank 2.");
+  static_assert (std::is_same<typename RV::value_type,
+                   typename RV::non_const_value_type>::value,
+                 "KokkosBlas::Experimental::batched_nrm2: R must be non-const.");
+
+  if (R.extent(0) != X.extent(1)) {
+    std::ostringstream os;
+    os << "KokkosBlas::Experimental::batched_nrm2: Dimensions do not match: "
+       << "R: " << R.extent(0)
+       << ", X: " << X.extent(0) << " x " << X.extent(1);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  if (X.extent(1) == 0) return;
+
+  typedef typename XMV::execution_space execution_space;
+  const Impl::BatchedMapping m = Impl::batched_mapping<execution_space>
+    (X.extent_int(0), X.stride_0() == 1);
+  Impl::run_batched_functor<execution_space>
+    ("KokkosBlas::Experimental::batched_nrm2", X.extent_int(1), m,
+     Impl::Batched_Nrm2_Functor<RV, XMV> (R, X, m));
+}
+
+/// \brief Y(:,k) = a(k)*X(:,k) + b(k)*Y(:,k) for every column k.
+///
+/// \param a [in] Scalar, or rank 1 Kokkos::View with one coefficient
+///   per vector.
+/// \param X [in] Rank 2 Kokkos::View, one vector per column.
+/// \param b [in] Scalar, or rank 1 Kokkos::View with one coefficient
+///   per vector.
+/// \param Y [in/out] Rank 2 Kokkos::View, same dimensions as X.
+template<class AV, class XMV, class BV, class YMV>
+void
+batched_axpby (const AV& a, const XMV& X, const BV& b, const YMV& Y)
+{
+  static_assert (Kokkos::Impl::is_view<XMV>::value &&
+                 Kokkos::Impl::is_view<YMV>::value,
+                 "KokkosBlas::Experimental::batched_axpby: X and Y must be Kokkos::View.");
+  static_assert ((int) XMV::rank == 2 && (int) YMV::rank == 2,
+                 "KokkosBlas::Experimental::batched_axpby: X and Y must have rank 2.");
+  static_assert (std::is_same<typename YMV::value_type,
+                   typename YMV::non_const_value_type>::value,
+                 "KokkosBlas::Experimental::batched_axpby: Y must be non-const.");
+
+  if (X.extent(0) != Y.extent(0) || X.extent(1) != Y.extent(1)) {
+    std::ostringstream os;
+    os << "KokkosBlas::Experimental::batched_axpby: Dimensions do not match: "
+       << "X: " << X.extent(0) << " x " << X.extent(1)
+       << ", Y: " << Y.extent(0) << " x " << Y.extent(1);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  if (! Impl::BatchedCoefficient<AV>::valid (a, Y.extent(1)) ||
+      ! Impl::BatchedCoefficient<BV>::valid (b, Y.extent(1))) {
+    std::ostringstream os;
+    os << "KokkosBlas::Experimental::batched_axpby: a and b must be scalars "
+       << "or rank 1 views with one entry per vector (" << Y.extent(1) << ")";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  if (Y.extent(1) == 0) return;
+
+  typedef typename YMV::execution_space execution_space;
+  const Impl::BatchedMapping m = Impl::batched_mapping<execution_space>
+    (Y.extent_int(0), X.stride_0() == 1 && Y.stride_0() == 1);
+  Impl::run_batched_functor<execution_space>
+    ("KokkosBlas::Experimental::batched_axpby", Y.extent_int(1), m,
+     Impl::Batched_Axpby_Functor<AV, XMV, BV, YMV> (a, X, b, Y, m));
+}
+
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_BATCHED_HPP_
@@ -0,0 +1,121 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSBLAS1_BLOCK_DOT_HPP_
+#define KOKKOSBLAS1_BLOCK_DOT_HPP_
+
+/// \file KokkosBlas1_block_dot.hpp
+
+#include <sstream>
+#include <type_traits>
+#include <Kokkos_Core.hpp>
+#include <KokkosBlas3_gemm.hpp>
+#include <KokkosBlas3_gemm_impl.hpp>
+
+namespace KokkosBlas {
+namespace Experimental {
+
+/// \brief Block inner product: R(i,j) = dot(X(:,i), Y(:,j)).
+///
+/// Computes the m x k matrix R = X^H * Y of all inner products of the
+/// m columns of X with the k columns of Y in one pass over X and Y.
+/// For classical Gram-Schmidt, put the vector to orthogonalize as the
+/// last column of X and of Y: R(:,k-1) then holds its projections onto
+/// the basis and R(k-1,k-1) its squared norm.
+///
+/// While R has at most a few thousand entries, each team reduces over
+/// a chunk of the rows into its own partial R, and the partial results
+/// are summed in a second pass; there are no atomics on R and the
+/// result does not depend on the schedule.  Larger R go to gemm.
+///
+/// \param R [out] Rank 2 Kokkos::View, m x k, in the memory space of X.
+/// \param X [in] Rank 2 Kokkos::View, n x m.
+/// \param Y [in] Rank 2 Kokkos::View, n x k.
+template<class RV, class XMV, class YMV>
+void
+block_dot (const RV& R, const XMV& X, const YMV& Y)
+{
+  static_assert (Kokkos::Impl::is_view<RV>::value &&
+                 Kokkos::Impl::is_view<XMV>::value &&
+                 Kokkos::Impl::is_view<YMV>::value,
+                 "KokkosBlas::Experimental::block_dot: R, X and Y must be Kokkos::View.");
+  static_assert ((int) RV::rank == 2 && (int) XMV::rank == 2 && (int) YMV::rank == 2,
+                 "KokkosBlas::Experimental::block_dot: R, X and Y must have rank 2.");
+  static_assert (std::is_same<typename RV::value_type,
+                   typename RV::non_const_value_type>::value,
+                 "KokkosBlas::Experimental::block_dot: R must be non-const.");
+
+  if (X.extent(0) != Y.extent(0) ||
+      R.extent(0) != X.extent(1) ||
+      R.extent(1) != Y.extent(1)) {
+    std::ostringstream os;
+    os << "KokkosBlas::Experimental::block_dot: Dimensions do not match: "
+       << "R: " << R.extent(0) << " x " << R.extent(1)
+       << ", X: " << X.extent(0) << " x " << X.extent(1)
+       << ", Y: " << Y.extent(0) << " x " << Y.extent(1);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  typedef typename RV::non_const_value_type scalar_type;
+  typedef Kokkos::Details::ArithTraits<scalar_type> AT;
+
+  const int m = R.extent_int(0), k = R.extent_int(1), n = X.extent_int(0);
+  if (m == 0 || k == 0) return;
+  if (n == 0) {
+    Kokkos::deep_copy (R, AT::zero ());
+    return;
+  }
+
+  if (m*k <= 4096) {
+    KokkosBlas::Impl::impl_gemm_tall_skinny<typename RV::execution_space,XMV,YMV,RV,2>
+      (AT::one (), X, Y, AT::zero (), R);
+  }
+  else {
+    KokkosBlas::gemm ("C", "N", AT::one (), X, Y, AT::zero (), R);
+  }
+}
+
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_BLOCK_DOT_HPP_
@@ -0,0 +1,153 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSBLAS1_COMPENSATED_HPP_
+#define KOKKOSBLAS1_COMPENSATED_HPP_
+
+#include <sstream>
+#include <climits>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include <KokkosBlas1_compensated_impl.hpp>
+
+/// \file KokkosBlas1_compensated.hpp
+/// \brief Compensated (higher accuracy) dot, nrm2 and sum of real
+///   single vectors.
+///
+/// These keep the rounding error of every addition and product next to
+/// the running sum (TwoSum and FMA-based TwoProduct), so that the result
+/// is as accurate as if it were computed in twice the working precision
+/// and then rounded.  This lets float vectors be reduced with close to
+/// double accuracy, at the cost of several times the floating-point
+/// work of KokkosBlas::dot; the memory traffic is the same.
+///
+/// The error-free transformations rely on IEEE arithmetic being
+/// evaluated as written; do not compile callers with -ffast-math or
+/// similar flags that allow reassociation.
+
+namespace KokkosBlas {
+namespace Experimental {
+
+/// \brief Compensated dot(x, y) of two real single vectors.
+template<class XVector, class YVector>
+typename XVector::non_const_value_type
+compensated_dot (const XVector& x, const YVector& y)
+{
+  static_assert (Kokkos::Impl::is_view<XVector>::value && Kokkos::Impl::is_view<YVector>::value,
+                 "KokkosBlas::Experimental::compensated_dot: x and y must be Kokkos::View.");
+  static_assert ((int) XVector::rank == 1 && (int) YVector::rank == 1,
+                 "KokkosBlas::Experimental::compensated_dot: x and y must have rank 1.");
+  static_assert (! Kokkos::Details::ArithTraits<typename XVector::non_const_value_type>::is_complex,
+                 "KokkosBlas::Experimental::compensated_dot: x and y must be real.");
+  if (x.extent(0) != y.extent(0)) {
+    std::ostringstream os;
+    os << "KokkosBlas::Experimental::compensated_dot: Dimensions do not match: "
+       << "x: " << x.extent(0) << ", y: " << y.extent(0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  const size_t n = x.extent(0);
+  if (n < static_cast<size_t> (INT_MAX)) {
+    return Impl::compensated_reduce ("KokkosBlas::Experimental::compensated_dot",
+                                     Impl::Compensated_Dot_Functor<XVector, YVector, int> (x, y), n);
+  }
+  else {
+    return Impl::compensated_reduce ("KokkosBlas::Experimental::compensated_dot",
+                                     Impl::Compensated_Dot_Functor<XVector, YVector, int64_t> (x, y), n);
+  }
+}
+
+/// \brief Compensated 2-norm of a real single vector.
+///
+/// The squared norm is accumulated with Dot2 and rounded once before
+/// the square root.  As in KokkosBlas::nrm2, there is no scaling, so
+/// entries whose squares overflow give inf.
+template<class XVector>
+typename XVector::non_const_value_type
+compensated_nrm2 (const XVector& x)
+{
+  static_assert (Kokkos::Impl::is_view<XVector>::value,
+                 "KokkosBlas::Experimental::compensated_nrm2: x must be a Kokkos::View.");
+  static_assert ((int) XVector::rank == 1,
+                 "KokkosBlas::Experimental::compensated_nrm2: x must have rank 1.");
+  static_assert (! Kokkos::Details::ArithTraits<typename XVector::non_const_value_type>::is_complex,
+                 "KokkosBlas::Experimental::compensated_nrm2: x must be real.");
+  typedef typename XVector::non_const_value_type scalar_type;
+  const size_t n = x.extent(0);
+  scalar_type sum;
+  if (n < static_cast<size_t> (INT_MAX)) {
+    sum = Impl::compensated_reduce ("KokkosBlas::Experimental::compensated_nrm2",
+                                    Impl::Compensated_Dot_Functor<XVector, XVector, int> (x, x), n);
+  }
+  else {
+    sum = Impl::compensated_reduce ("KokkosBlas::Experimental::compensated_nrm2",
+                                    Impl::Compensated_Dot_Functor<XVector, XVector, int64_t> (x, x), n);
+  }
+  return Kokkos::Details::ArithTraits<scalar_type>::sqrt (sum);
+}
+
+/// \brief Compensated sum of the entries of a real single vector.
+template<class XVector>
+typename XVector::non_const_value_type
+compensated_sum (const XVector& x)
+{
+  static_assert (Kokkos::Impl::is_view<XVector>::value,
+                 "KokkosBlas::Experimental::compensated_sum: x must be a Kokkos::View.");
+  static_assert ((int) XVector::rank == 1,
+                 "KokkosBlas::Experimental::compensated_sum: x must have rank 1.");
+  static_assert (! Kokkos::Details::ArithTraits<typename XVector::non_const_value_type>::is_complex,
+                 "KokkosBlas::Experimental::compensated_sum: x must be real.");
+  const size_t n = x.extent(0);
+  if (n < static_cast<size_t> (INT_MAX)) {
+    return Impl::compensated_reduce ("KokkosBlas::Experimental::compensated_sum",
+                                     Impl::Compensated_Sum_Functor<XVector, int> (x), n);
+  }
+  else {
+    return Impl::compensated_reduce ("KokkosBlas::Experimental::compensated_sum",
+                                     Impl::Compensated_Sum_Functor<XVector, int64_t> (x), n);
+  }
+}
+
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_COMPENSATED_HPP_
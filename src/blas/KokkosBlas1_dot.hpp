@@ -54,13 +54,22 @@ namespace KokkosBlas {
 /// \tparam XVector Type of the first vector x; a 1-D Kokkos::View.
 /// \tparam YVector Type of the second vector y; a 1-D Kokkos::View.
 ///
+/// \param space [in] Execution space instance on which to launch
+///   the reduction.  Only that instance is fenced before returning.
 /// \param x [in] Input 1-D View.
 /// \param y [in] Input 1-D View.
 ///
 /// \return The dot product result; a single value.
+///
+/// x and y may have different value types, float and double.  Then
+/// the entries are converted to double inside the kernel, and the
+/// result is double.
 template<class XVector,class YVector>
-typename Kokkos::Details::InnerProductSpaceTraits<typename XVector::non_const_value_type>::dot_type
-dot (const XVector& x, const YVector& y)
+typename Kokkos::Details::InnerProductSpaceTraits<
+  typename KokkosKernels::Impl::GetMixedScalarType<typename XVector::non_const_value_type,
+                                                   typename YVector::non_const_value_type>::type>::dot_type
+dot (const typename XVector::execution_space& space,
+     const XVector& x, const YVector& y)
 {
   static_assert (Kokkos::Impl::is_view<XVector>::value,
                  "KokkosBlas::dot: XVector must be a Kokkos::View.");
@@ -90,21 +99,37 @@ dot (const XVector& x, const YVector& y)
     typename YVector::device_type,
     Kokkos::MemoryTraits<Kokkos::Unmanaged> > YVector_Internal;
 
-  typedef Kokkos::View<typename XVector::non_const_value_type,
+  typedef typename KokkosKernels::Impl::GetMixedScalarType<
+    typename XVector::non_const_value_type,
+    typename YVector::non_const_value_type>::type result_type;
+  typedef Kokkos::View<result_type,
     Kokkos::LayoutLeft,
     Kokkos::HostSpace,
     Kokkos::MemoryTraits<Kokkos::Unmanaged> > RVector_Internal;
 
-  typename XVector::non_const_value_type result;
+  result_type result;
   RVector_Internal R = RVector_Internal(&result);
   XVector_Internal X = x;
   YVector_Internal Y = y;
 
-  Impl::Dot<RVector_Internal,XVector_Internal,YVector_Internal>::dot (R,X,Y);
-  Kokkos::fence();
+  Impl::Dot<RVector_Internal,XVector_Internal,YVector_Internal>::dot (space,R,X,Y);
+  space.fence();
   return result;
 }
 
+/// \brief Return the dot product of the two vectors x and y.
+///
+/// Same as above, on a default-constructed instance of XVector's
+/// execution space.
+template<class XVector,class YVector>
+typename Kokkos::Details::InnerProductSpaceTraits<
+  typename KokkosKernels::Impl::GetMixedScalarType<typename XVector::non_const_value_type,
+                                                   typename YVector::non_const_value_type>::type>::dot_type
+dot (const XVector& x, const YVector& y)
+{
+  return dot (typename XVector::execution_space (), x, y);
+}
+
 /// \brief Compute the column-wise dot products of two multivectors.
 ///
 /// \tparam RV 0-D resp. 1-D output View
@@ -128,12 +153,17 @@ dot (const XVector& x, const YVector& y)
 ///   product X with each column of Y, in turn.  R must be 1-D. </li>
 /// </ul>
 ///
+/// If R is a rank 0 View in the memory space of X, the result stays
+/// on the device and this function does not wait for the kernel, so
+/// it can be passed on to axpby or scal without a host round trip.
+///
 /// \note To implementers: We use enable_if here so that the compiler
 ///   doesn't confuse this version of dot() with the three-argument
 ///   version of dot() in Kokkos_Blas1.hpp.
 template<class RV, class XMV, class YMV>
 void
-dot (const RV& R, const XMV& X, const YMV& Y,
+dot (const typename XMV::execution_space& space,
+     const RV& R, const XMV& X, const YMV& Y,
      typename std::enable_if<Kokkos::Impl::is_view<RV>::value, int>::type = 0)
 {
   static_assert (Kokkos::Impl::is_view<RV>::value, "KokkosBlas::dot: "
@@ -222,7 +252,17 @@ dot (const RV& R, const XMV& X, const YMV& Y,
   XMV_Internal X_internal = X;
   YMV_Internal Y_internal = Y;
 
-  Impl::Dot<RV_Internal, XMV_Internal, YMV_Internal>::dot(R_internal, X_internal, Y_internal);
+  Impl::Dot<RV_Internal, XMV_Internal, YMV_Internal>::dot(space, R_internal, X_internal, Y_internal);
+}
+
+/// \brief Compute the column-wise dot products of two multivectors,
+///   on a default-constructed instance of XMV's execution space.
+template<class RV, class XMV, class YMV>
+void
+dot (const RV& R, const XMV& X, const YMV& Y,
+     typename std::enable_if<Kokkos::Impl::is_view<RV>::value, int>::type = 0)
+{
+  dot (typename XMV::execution_space (), R, X, Y);
 }
 }
 
@@ -0,0 +1,161 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSBLAS1_ENSEMBLE_HPP_
+#define KOKKOSBLAS1_ENSEMBLE_HPP_
+
+/// \file KokkosBlas1_ensemble.hpp
+/// \brief BLAS1 on vectors of ensemble scalars.
+///
+/// The entries of the vectors here are KokkosBatched SIMD vectors
+/// (KokkosBatched::Experimental::Vector<SIMD<T>,l>) holding one value
+/// per ensemble member, e.g. l samples of an uncertainty quantification
+/// sweep that share a sparsity pattern.  One pass over the vector
+/// processes all the members; the reductions return one result per
+/// member, as an ensemble scalar.
+
+#include <sstream>
+#include <type_traits>
+#include <Kokkos_Core.hpp>
+#include <KokkosBlas1_ensemble_impl.hpp>
+
+namespace KokkosBlas {
+namespace Experimental {
+
+/// \brief Per-member dot product of the rank 1 ensemble views x and y.
+template<class XV, class YV>
+typename XV::non_const_value_type
+ensemble_dot (const XV& x, const YV& y)
+{
+  static_assert (Kokkos::Impl::is_view<XV>::value && Kokkos::Impl::is_view<YV>::value,
+                 "KokkosBlas::Experimental::ensemble_dot: x and y must be Kokkos::View.");
+  static_assert ((int) XV::rank == 1 && (int) YV::rank == 1,
+                 "KokkosBlas::Experimental::ensemble_dot: x and y must have rank 1.");
+  static_assert (KokkosBatched::Experimental::is_vector<typename XV::non_const_value_type>::value &&
+                 std::is_same<typename XV::non_const_value_type,
+                   typename YV::non_const_value_type>::value,
+                 "KokkosBlas::Experimental::ensemble_dot: x and y must have the same ensemble scalar type.");
+
+  if (x.extent(0) != y.extent(0)) {
+    std::ostringstream os;
+    os << "KokkosBlas::Experimental::ensemble_dot: Dimensions do not match: "
+       << "x: " << x.extent(0) << ", y: " << y.extent(0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  typedef Impl::Ensemble_Dot_Functor<XV, YV> functor_type;
+  typedef typename functor_type::execution_space execution_space;
+  typedef typename XV::non_const_value_type ensemble_type;
+
+  Kokkos::View<typename functor_type::lane_type*, Kokkos::HostSpace>
+    r ("KokkosBlas::ensemble_dot::r", ensemble_type::vector_length);
+  Kokkos::parallel_reduce ("KokkosBlas::Experimental::ensemble_dot",
+      Kokkos::RangePolicy<execution_space, typename XV::size_type> (0, x.extent(0)),
+      functor_type (x, y), r);
+  ensemble_type result;
+  for (int k = 0; k < ensemble_type::vector_length; ++k) result[k] = r(k);
+  return result;
+}
+
+/// \brief Per-member 2-norm of the rank 1 ensemble view x.
+template<class XV>
+KokkosBatched::Experimental::Vector<
+  KokkosBatched::Experimental::SIMD<typename Impl::Ensemble_Nrm2Squared_Functor<XV>::mag_type>,
+  XV::non_const_value_type::vector_length>
+ensemble_nrm2 (const XV& x)
+{
+  static_assert (Kokkos::Impl::is_view<XV>::value,
+                 "KokkosBlas::Experimental::ensemble_nrm2: x must be a Kokkos::View.");
+  static_assert ((int) XV::rank == 1,
+                 "KokkosBlas::Experimental::ensemble_nrm2: x must have rank 1.");
+
+  typedef Impl::Ensemble_Nrm2Squared_Functor<XV> functor_type;
+  typedef typename functor_type::execution_space execution_space;
+  typedef typename functor_type::mag_type mag_type;
+  typedef Kokkos::Details::ArithTraits<mag_type> ATM;
+  enum : int { l = XV::non_const_value_type::vector_length };
+
+  Kokkos::View<mag_type*, Kokkos::HostSpace> r ("KokkosBlas::ensemble_nrm2::r", l);
+  Kokkos::parallel_reduce ("KokkosBlas::Experimental::ensemble_nrm2",
+      Kokkos::RangePolicy<execution_space, typename XV::size_type> (0, x.extent(0)),
+      functor_type (x), r);
+  KokkosBatched::Experimental::Vector<KokkosBatched::Experimental::SIMD<mag_type>, l> result;
+  for (int k = 0; k < l; ++k) result[k] = ATM::sqrt (r(k));
+  return result;
+}
+
+/// \brief y = a*x + b*y for rank 1 ensemble views; a and b are ensemble
+///   scalars (one coefficient per member) or plain scalars.
+template<class AV, class XV, class BV, class YV>
+void
+ensemble_axpby (const AV& a, const XV& x, const BV& b, const YV& y)
+{
+  static_assert (Kokkos::Impl::is_view<XV>::value && Kokkos::Impl::is_view<YV>::value,
+                 "KokkosBlas::Experimental::ensemble_axpby: x and y must be Kokkos::View.");
+  static_assert ((int) XV::rank == 1 && (int) YV::rank == 1,
+                 "KokkosBlas::Experimental::ensemble_axpby: x and y must have rank 1.");
+  static_assert (std::is_same<typename YV::value_type,
+                   typename YV::non_const_value_type>::value,
+                 "KokkosBlas::Experimental::ensemble_axpby: y must be non-const.");
+  static_assert (KokkosBatched::Experimental::is_vector<typename YV::non_const_value_type>::value &&
+                 std::is_same<typename XV::non_const_value_type,
+                   typename YV::non_const_value_type>::value,
+                 "KokkosBlas::Experimental::ensemble_axpby: x and y must have the same ensemble scalar type.");
+
+  if (x.extent(0) != y.extent(0)) {
+    std::ostringstream os;
+    os << "KokkosBlas::Experimental::ensemble_axpby: Dimensions do not match: "
+       << "x: " << x.extent(0) << ", y: " << y.extent(0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  typedef typename YV::non_const_value_type ensemble_type;
+  typedef typename YV::execution_space execution_space;
+  Kokkos::parallel_for ("KokkosBlas::Experimental::ensemble_axpby",
+      Kokkos::RangePolicy<execution_space, typename YV::size_type> (0, y.extent(0)),
+      Impl::Ensemble_Axpby_Functor<XV, YV> (ensemble_type (a), x, ensemble_type (b), y));
+}
+
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_ENSEMBLE_HPP_
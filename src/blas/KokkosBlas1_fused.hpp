@@ -0,0 +1,239 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSBLAS1_FUSED_HPP_
+#define KOKKOSBLAS1_FUSED_HPP_
+
+#include <sstream>
+#include <type_traits>
+#include <climits>
+#include <Kokkos_Core.hpp>
+#include <KokkosBlas1_fused_impl.hpp>
+
+/// \file KokkosBlas1_fused.hpp
+/// \brief Fused sequences of BLAS 1 operations on single vectors.
+///
+/// Krylov solvers call axpby, update, dot and nrm2 back to back, and
+/// each call is a full sweep over memory.  The functions here do a
+/// fixed sequence of such operations in one parallel_reduce.  The
+/// results are those of the separate calls, e.g.
+///
+///   axpby(a, x, b, y); r = dot(w, y);   <=>   r = axpby_dot(a, x, b, y, w);
+///
+/// up to the rounding of the reductions.  Vectors in a reduction may
+/// alias the vector that is updated; they see the updated entries.
+
+namespace KokkosBlas {
+namespace Experimental {
+namespace Impl {
+
+template<class XV, class YV>
+void fused_check_extents (const char label[], const XV& x, const YV& y)
+{
+  if (x.extent(0) != y.extent(0)) {
+    std::ostringstream os;
+    os << label << ": Dimensions do not match: "
+       << "x: " << x.extent(0) << ", y: " << y.extent(0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+}
+
+} // namespace Impl
+
+/// \brief y := a*x + b*y, then return dot(w, y).
+///
+/// \param a [in] Scalar multiplier for x.
+/// \param x [in] Rank 1 Kokkos::View.
+/// \param b [in] Scalar multiplier for y.  If 0, y is overwritten.
+/// \param y [in/out] Rank 1 Kokkos::View, with as many entries as x.
+/// \param w [in] Rank 1 Kokkos::View, with as many entries as x; may be y.
+template<class AV, class XV, class BV, class YV, class WV>
+typename Kokkos::Details::InnerProductSpaceTraits<typename WV::non_const_value_type>::dot_type
+axpby_dot (const AV& a, const XV& x, const BV& b, const YV& y, const WV& w)
+{
+  static_assert ((int) XV::rank == 1 && (int) YV::rank == 1 && (int) WV::rank == 1,
+                 "KokkosBlas::Experimental::axpby_dot: x, y and w must have rank 1.");
+  static_assert (std::is_same<typename YV::value_type,
+                   typename YV::non_const_value_type>::value,
+                 "KokkosBlas::Experimental::axpby_dot: y must be non-const.");
+  Impl::fused_check_extents ("KokkosBlas::Experimental::axpby_dot", x, y);
+  Impl::fused_check_extents ("KokkosBlas::Experimental::axpby_dot", w, y);
+
+  typedef typename YV::execution_space execution_space;
+  typename Kokkos::Details::InnerProductSpaceTraits<typename WV::non_const_value_type>::dot_type result;
+  const size_t n = y.extent(0);
+  if (n < static_cast<size_t> (INT_MAX)) {
+    typedef Impl::V_Axpby_Dot_Functor<AV, XV, BV, YV, WV, int> functor_type;
+    Kokkos::parallel_reduce ("KokkosBlas::Experimental::axpby_dot",
+                             Kokkos::RangePolicy<execution_space, int> (0, n),
+                             functor_type (a, x, b, y, w), result);
+  }
+  else {
+    typedef Impl::V_Axpby_Dot_Functor<AV, XV, BV, YV, WV, int64_t> functor_type;
+    Kokkos::parallel_reduce ("KokkosBlas::Experimental::axpby_dot",
+                             Kokkos::RangePolicy<execution_space, int64_t> (0, n),
+                             functor_type (a, x, b, y, w), result);
+  }
+  return result;
+}
+
+/// \brief y := a*x + b*y and v := c*u + d*v, then return dot(w, v).
+///
+/// For CG, axpby2_dot(alpha, p, 1, x, -alpha, Ap, 1, r, r) updates the
+/// solution x and the residual r and returns dot(r, r) in one sweep.
+///
+/// \param y [in/out] Rank 1 Kokkos::View; it must not alias v.
+/// \param v [in/out] Rank 1 Kokkos::View.  If d is 0, v is overwritten.
+/// \param w [in] Rank 1 Kokkos::View; may be v.
+template<class AV, class XV, class BV, class YV,
+         class CV, class UV, class DV, class VV, class WV>
+typename Kokkos::Details::InnerProductSpaceTraits<typename WV::non_const_value_type>::dot_type
+axpby2_dot (const AV& a, const XV& x, const BV& b, const YV& y,
+            const CV& c, const UV& u, const DV& d, const VV& v,
+            const WV& w)
+{
+  static_assert ((int) XV::rank == 1 && (int) YV::rank == 1 &&
+                 (int) UV::rank == 1 && (int) VV::rank == 1 && (int) WV::rank == 1,
+                 "KokkosBlas::Experimental::axpby2_dot: x, y, u, v and w must have rank 1.");
+  static_assert (std::is_same<typename YV::value_type,
+                   typename YV::non_const_value_type>::value &&
+                 std::is_same<typename VV::value_type,
+                   typename VV::non_const_value_type>::value,
+                 "KokkosBlas::Experimental::axpby2_dot: y and v must be non-const.");
+  Impl::fused_check_extents ("KokkosBlas::Experimental::axpby2_dot", x, y);
+  Impl::fused_check_extents ("KokkosBlas::Experimental::axpby2_dot", u, y);
+  Impl::fused_check_extents ("KokkosBlas::Experimental::axpby2_dot", v, y);
+  Impl::fused_check_extents ("KokkosBlas::Experimental::axpby2_dot", w, y);
+
+  typedef typename VV::execution_space execution_space;
+  typename Kokkos::Details::InnerProductSpaceTraits<typename WV::non_const_value_type>::dot_type result;
+  const size_t n = v.extent(0);
+  if (n < static_cast<size_t> (INT_MAX)) {
+    typedef Impl::V_Axpby2_Dot_Functor<AV, XV, BV, YV, CV, UV, DV, VV, WV, int> functor_type;
+    Kokkos::parallel_reduce ("KokkosBlas::Experimental::axpby2_dot",
+                             Kokkos::RangePolicy<execution_space, int> (0, n),
+                             functor_type (a, x, b, y, c, u, d, v, w), result);
+  }
+  else {
+    typedef Impl::V_Axpby2_Dot_Functor<AV, XV, BV, YV, CV, UV, DV, VV, WV, int64_t> functor_type;
+    Kokkos::parallel_reduce ("KokkosBlas::Experimental::axpby2_dot",
+                             Kokkos::RangePolicy<execution_space, int64_t> (0, n),
+                             functor_type (a, x, b, y, c, u, d, v, w), result);
+  }
+  return result;
+}
+
+/// \brief z := gamma*z + alpha*x + beta*y, then return nrm2(z).
+///
+/// \param z [in/out] Rank 1 Kokkos::View.  If gamma is 0, z is overwritten.
+template<class AV, class XV, class BV, class YV, class GV, class ZV>
+typename Kokkos::Details::InnerProductSpaceTraits<typename ZV::non_const_value_type>::mag_type
+update_nrm2 (const AV& alpha, const XV& x, const BV& beta, const YV& y,
+             const GV& gamma, const ZV& z)
+{
+  static_assert ((int) XV::rank == 1 && (int) YV::rank == 1 && (int) ZV::rank == 1,
+                 "KokkosBlas::Experimental::update_nrm2: x, y and z must have rank 1.");
+  static_assert (std::is_same<typename ZV::value_type,
+                   typename ZV::non_const_value_type>::value,
+                 "KokkosBlas::Experimental::update_nrm2: z must be non-const.");
+  Impl::fused_check_extents ("KokkosBlas::Experimental::update_nrm2", x, z);
+  Impl::fused_check_extents ("KokkosBlas::Experimental::update_nrm2", y, z);
+
+  typedef typename ZV::execution_space execution_space;
+  typedef typename Kokkos::Details::InnerProductSpaceTraits<typename ZV::non_const_value_type>::mag_type mag_type;
+  mag_type result;
+  const size_t n = z.extent(0);
+  if (n < static_cast<size_t> (INT_MAX)) {
+    typedef Impl::V_Update_Nrm2_Functor<AV, XV, BV, YV, GV, ZV, int> functor_type;
+    Kokkos::parallel_reduce ("KokkosBlas::Experimental::update_nrm2",
+                             Kokkos::RangePolicy<execution_space, int> (0, n),
+                             functor_type (alpha, x, beta, y, gamma, z), result);
+  }
+  else {
+    typedef Impl::V_Update_Nrm2_Functor<AV, XV, BV, YV, GV, ZV, int64_t> functor_type;
+    Kokkos::parallel_reduce ("KokkosBlas::Experimental::update_nrm2",
+                             Kokkos::RangePolicy<execution_space, int64_t> (0, n),
+                             functor_type (alpha, x, beta, y, gamma, z), result);
+  }
+  return Kokkos::Details::ArithTraits<mag_type>::sqrt (result);
+}
+
+/// \brief Return dot(x, y) and dot(u, v), computed in one sweep.
+template<class XV, class YV, class UV, class VV>
+Kokkos::pair<typename Kokkos::Details::InnerProductSpaceTraits<typename XV::non_const_value_type>::dot_type,
+             typename Kokkos::Details::InnerProductSpaceTraits<typename XV::non_const_value_type>::dot_type>
+dot2 (const XV& x, const YV& y, const UV& u, const VV& v)
+{
+  static_assert ((int) XV::rank == 1 && (int) YV::rank == 1 &&
+                 (int) UV::rank == 1 && (int) VV::rank == 1,
+                 "KokkosBlas::Experimental::dot2: x, y, u and v must have rank 1.");
+  static_assert (std::is_same<typename Kokkos::Details::InnerProductSpaceTraits<typename XV::non_const_value_type>::dot_type,
+                   typename Kokkos::Details::InnerProductSpaceTraits<typename UV::non_const_value_type>::dot_type>::value,
+                 "KokkosBlas::Experimental::dot2: x and u must have the same dot type.");
+  Impl::fused_check_extents ("KokkosBlas::Experimental::dot2", x, y);
+  Impl::fused_check_extents ("KokkosBlas::Experimental::dot2", u, y);
+  Impl::fused_check_extents ("KokkosBlas::Experimental::dot2", v, y);
+
+  typedef typename YV::execution_space execution_space;
+  typedef typename Kokkos::Details::InnerProductSpaceTraits<typename XV::non_const_value_type>::dot_type dot_type;
+  dot_type result[2];
+  const size_t n = y.extent(0);
+  if (n < static_cast<size_t> (INT_MAX)) {
+    typedef Impl::V_Dot2_Functor<XV, YV, UV, VV, int> functor_type;
+    Kokkos::parallel_reduce ("KokkosBlas::Experimental::dot2",
+                             Kokkos::RangePolicy<execution_space, int> (0, n),
+                             functor_type (x, y, u, v), result);
+  }
+  else {
+    typedef Impl::V_Dot2_Functor<XV, YV, UV, VV, int64_t> functor_type;
+    Kokkos::parallel_reduce ("KokkosBlas::Experimental::dot2",
+                             Kokkos::RangePolicy<execution_space, int64_t> (0, n),
+                             functor_type (x, y, u, v), result);
+  }
+  return Kokkos::pair<dot_type, dot_type> (result[0], result[1]);
+}
+
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_FUSED_HPP_
@@ -94,6 +94,10 @@ nrm2 (const XVector& x)
 /// \tparam XMV 1-D or 2-D Kokkos::View specialization.  It must have
 ///   the same rank as RMV, and its entries must be assignable to
 ///   those of RMV.
+///
+/// If R is a rank 0 View in the memory space of X, the result stays
+/// on the device and this function does not wait for the kernel, so
+/// it can be passed on to axpby or scal without a host round trip.
 template<class RV, class XMV>
 void
 nrm2 (const RV& R, const XMV& X,
@@ -0,0 +1,118 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSBLAS1_REPRODUCIBLE_HPP_
+#define KOKKOSBLAS1_REPRODUCIBLE_HPP_
+
+/// \file KokkosBlas1_reproducible.hpp
+/// \brief Reproducible dot, nrm2 and sum of single vectors.
+///
+/// The results of KokkosBlas::dot, nrm2 and sum depend on how the
+/// reduction is split among threads, hence on the thread count and on
+/// the launch configuration.  The functions here sum in a fixed order
+/// (see Impl::reproducible_reduce) and return the same bits for the
+/// same input on any number of threads.  They cost an extra, small
+/// pass over the block sums and do not vectorize across blocks as well;
+/// perf_test/blas/KokkosBlas_blas1.cpp measures the overhead.
+
+#include <sstream>
+#include <Kokkos_Core.hpp>
+#include <KokkosBlas1_reproducible_impl.hpp>
+
+namespace KokkosBlas {
+namespace Experimental {
+
+/// \brief Reproducible dot(x, y) of two single vectors.
+template<class XVector, class YVector>
+typename Kokkos::Details::InnerProductSpaceTraits<typename XVector::non_const_value_type>::dot_type
+reproducible_dot (const XVector& x, const YVector& y)
+{
+  static_assert (Kokkos::Impl::is_view<XVector>::value && Kokkos::Impl::is_view<YVector>::value,
+                 "KokkosBlas::Experimental::reproducible_dot: x and y must be Kokkos::View.");
+  static_assert ((int) XVector::rank == 1 && (int) YVector::rank == 1,
+                 "KokkosBlas::Experimental::reproducible_dot: x and y must have rank 1.");
+  if (x.extent(0) != y.extent(0)) {
+    std::ostringstream os;
+    os << "KokkosBlas::Experimental::reproducible_dot: Dimensions do not match: "
+       << "x: " << x.extent(0) << ", y: " << y.extent(0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  return Impl::reproducible_reduce<typename XVector::execution_space>
+    ("KokkosBlas::Experimental::reproducible_dot",
+     Impl::Reproducible_Dot_Terms<XVector, YVector> (x, y), x.extent(0));
+}
+
+/// \brief Reproducible 2-norm of a single vector.
+template<class XVector>
+typename Kokkos::Details::InnerProductSpaceTraits<typename XVector::non_const_value_type>::mag_type
+reproducible_nrm2 (const XVector& x)
+{
+  static_assert (Kokkos::Impl::is_view<XVector>::value,
+                 "KokkosBlas::Experimental::reproducible_nrm2: x must be a Kokkos::View.");
+  static_assert ((int) XVector::rank == 1,
+                 "KokkosBlas::Experimental::reproducible_nrm2: x must have rank 1.");
+  typedef typename Kokkos::Details::InnerProductSpaceTraits<typename XVector::non_const_value_type>::mag_type mag_type;
+  return Kokkos::Details::ArithTraits<mag_type>::sqrt
+    (Impl::reproducible_reduce<typename XVector::execution_space>
+     ("KokkosBlas::Experimental::reproducible_nrm2",
+      Impl::Reproducible_Nrm2_Squared_Terms<XVector> (x), x.extent(0)));
+}
+
+/// \brief Reproducible sum of the entries of a single vector.
+template<class XVector>
+typename XVector::non_const_value_type
+reproducible_sum (const XVector& x)
+{
+  static_assert (Kokkos::Impl::is_view<XVector>::value,
+                 "KokkosBlas::Experimental::reproducible_sum: x must be a Kokkos::View.");
+  static_assert ((int) XVector::rank == 1,
+                 "KokkosBlas::Experimental::reproducible_sum: x must have rank 1.");
+  return Impl::reproducible_reduce<typename XVector::execution_space>
+    ("KokkosBlas::Experimental::reproducible_sum",
+     Impl::Reproducible_Sum_Terms<XVector> (x), x.extent(0));
+}
+
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_REPRODUCIBLE_HPP_
@@ -49,9 +49,17 @@
 
 namespace KokkosBlas {
 
+/// \brief Compute R := a*X, launching on the given execution space
+///   instance.
+///
+/// For single vectors, a may also be a rank-0 View (or a rank-1 View
+/// of length one) in the memory space of X, e.g., the result of
+/// KokkosBlas::nrm2(r,x).  The kernel reads it on the device, so no
+/// fence or copy to the host is needed between the two calls.
 template<class RMV, class AV, class XMV>
 void
-scal (const RMV& R, const AV& a, const XMV& X)
+scal (const typename RMV::execution_space& space,
+      const RMV& R, const AV& a, const XMV& X)
 {
   static_assert (Kokkos::Impl::is_view<RMV>::value, "KokkosBlas::scal: "
                  "R is not a Kokkos::View.");
@@ -66,6 +74,9 @@ scal (const RMV& R, const AV& a, const XMV& X)
                  "R and X must have the same rank.");
   static_assert (RMV::rank == 1 || RMV::rank == 2, "KokkosBlas::scal: "
                  "RMV and XMV must either have rank 1 or rank 2.");
+  static_assert (RMV::rank == 1 || ! KokkosKernels::Impl::IsRank0View<AV>::value,
+                 "KokkosBlas::scal: a may be a rank-0 View only if R and X "
+                 "have rank 1.");
 
   // Check compatibility of dimensions at run time.
   if (X.extent(0) != R.extent(0) ||
@@ -100,10 +111,17 @@ scal (const RMV& R, const AV& a, const XMV& X)
     Kokkos::MemoryTraits<Kokkos::Unmanaged> > XMV_Internal;
 
   RMV_Internal R_internal = R;
-  AV_Internal  a_internal = a;
+  AV_Internal  a_internal = KokkosKernels::Impl::get_unified_scalar_view<AV_Internal> (a);
   XMV_Internal X_internal = X;
 
-  Impl::Scal<RMV_Internal, AV_Internal, XMV_Internal>::scal (R_internal, a_internal, X_internal);
+  Impl::Scal<RMV_Internal, AV_Internal, XMV_Internal>::scal (space, R_internal, a_internal, X_internal);
+}
+
+template<class RMV, class AV, class XMV>
+void
+scal (const RMV& R, const AV& a, const XMV& X)
+{
+  scal (typename RMV::execution_space (), R, a, X);
 }
 
 }
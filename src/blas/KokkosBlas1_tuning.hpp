@@ -0,0 +1,187 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSBLAS1_TUNING_HPP_
+#define KOKKOSBLAS1_TUNING_HPP_
+
+/// \file KokkosBlas1_tuning.hpp
+/// \brief Calibration of the multivector axpby and dot kernels.
+///
+/// Multivector axpby (LayoutLeft) and dot either strip-mine the columns
+/// into several launches of unrolled functors, or do one launch that
+/// loops over all columns.  calibrate_blas1 times both for the given
+/// sizes and records the faster one per (kernel, execution space,
+/// log2(rows), columns) bucket; later calls of KokkosBlas::axpby and
+/// KokkosBlas::dot in the same bucket use it.  The results can be saved
+/// and are loaded at first use from the file named by the environment
+/// variable KOKKOSKERNELS_BLAS1_TUNING_FILE, e.g.
+///
+///   KokkosBlas::Experimental::calibrate_blas1<Kokkos::Cuda> ({1000, 100000, 10000000}, {2, 5, 12, 32});
+///   KokkosBlas::Experimental::save_blas1_tuning ("blas1_tuning.txt");
+///
+/// and then run with KOKKOSKERNELS_BLAS1_TUNING_FILE=blas1_tuning.txt.
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <Kokkos_Core.hpp>
+#include <impl/Kokkos_Timer.hpp>
+#include <KokkosBlas1_axpby.hpp>
+#include <KokkosBlas1_dot.hpp>
+#include <KokkosBlas1_tuning_impl.hpp>
+
+namespace KokkosBlas {
+namespace Experimental {
+
+namespace Impl {
+
+/// \brief Time the variants of one kernel on one size and record the
+///   faster one.  run () launches the kernel once.
+template<class ExecSpace, class Run>
+void
+calibrate_blas1_kernel (const int kernel, const size_t numRows, const size_t numCols,
+                        const int numTrials, const Run& run)
+{
+  KokkosBlas::Impl::Blas1TuningTable& table = KokkosBlas::Impl::blas1_tuning_table ();
+  const int variants[2] = { KokkosBlas::Impl::Blas1Variant_Unrolled,
+                            KokkosBlas::Impl::Blas1Variant_Generic };
+  double best_time = 0;
+  int best = variants[0];
+  for (int v = 0; v < 2; ++v) {
+    table.set (kernel, ExecSpace::name (), numRows, numCols, variants[v]);
+    run ();
+    ExecSpace::fence ();
+    Kokkos::Impl::Timer timer;
+    for (int trial = 0; trial < numTrials; ++trial)
+      run ();
+    ExecSpace::fence ();
+    const double t = timer.seconds ();
+    if (v == 0 || t < best_time) {
+      best_time = t;
+      best = variants[v];
+    }
+  }
+  table.set (kernel, ExecSpace::name (), numRows, numCols, best);
+}
+
+} // namespace Impl
+
+/// \brief Time the multivector axpby and dot variants on ExecSpace
+///   for every pair of numRows and numCols, and record the fastest.
+///
+/// Each size allocates two numRows x numCols multivectors of Scalar in
+/// each layout.  Sizes within a bucket share the entry of the last one
+/// calibrated.
+template<class ExecSpace, class Scalar = double>
+void
+calibrate_blas1 (const std::vector<size_t>& numRows,
+                 const std::vector<size_t>& numCols,
+                 const int numTrials = 10)
+{
+  typedef Kokkos::View<Scalar**, Kokkos::LayoutLeft, ExecSpace> left_mv_type;
+  typedef Kokkos::View<Scalar**, Kokkos::LayoutRight, ExecSpace> right_mv_type;
+  typedef Kokkos::View<typename Kokkos::Details::InnerProductSpaceTraits<Scalar>::dot_type*,
+                       ExecSpace> result_type;
+
+  for (const size_t m : numRows) {
+    for (const size_t n : numCols) {
+      if (m == 0 || n <= 1) continue;
+      result_type r ("KokkosBlas::Experimental::calibrate_blas1::r", n);
+      {
+        left_mv_type X ("KokkosBlas::Experimental::calibrate_blas1::X", m, n);
+        left_mv_type Y ("KokkosBlas::Experimental::calibrate_blas1::Y", m, n);
+        Kokkos::deep_copy (X, Scalar (1));
+        Kokkos::deep_copy (Y, Scalar (1));
+        const Scalar alpha (0.5), beta (0.5);
+        Impl::calibrate_blas1_kernel<ExecSpace>
+          (KokkosBlas::Impl::Blas1Tuned_Axpby_MV_Left, m, n, numTrials,
+           [&] () { KokkosBlas::axpby (alpha, X, beta, Y); });
+        Impl::calibrate_blas1_kernel<ExecSpace>
+          (KokkosBlas::Impl::Blas1Tuned_Dot_MV_Left, m, n, numTrials,
+           [&] () { KokkosBlas::dot (r, X, Y); });
+      }
+      {
+        right_mv_type X ("KokkosBlas::Experimental::calibrate_blas1::X", m, n);
+        right_mv_type Y ("KokkosBlas::Experimental::calibrate_blas1::Y", m, n);
+        Kokkos::deep_copy (X, Scalar (1));
+        Kokkos::deep_copy (Y, Scalar (1));
+        Impl::calibrate_blas1_kernel<ExecSpace>
+          (KokkosBlas::Impl::Blas1Tuned_Dot_MV_Right, m, n, numTrials,
+           [&] () { KokkosBlas::dot (r, X, Y); });
+      }
+    }
+  }
+}
+
+/// \brief Write the tuning table to filename.
+inline void
+save_blas1_tuning (const std::string& filename)
+{
+  if (! KokkosBlas::Impl::blas1_tuning_table ().save (filename)) {
+    std::ostringstream os;
+    os << "KokkosBlas::Experimental::save_blas1_tuning: Cannot write " << filename;
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+}
+
+/// \brief Add the entries of filename to the tuning table.
+inline void
+load_blas1_tuning (const std::string& filename)
+{
+  if (! KokkosBlas::Impl::blas1_tuning_table ().load (filename)) {
+    std::ostringstream os;
+    os << "KokkosBlas::Experimental::load_blas1_tuning: Cannot read " << filename;
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+}
+
+/// \brief Forget all tuning; every kernel uses its default variant.
+inline void
+clear_blas1_tuning ()
+{
+  KokkosBlas::Impl::blas1_tuning_table ().clear ();
+}
+
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_TUNING_HPP_
@@ -58,10 +58,18 @@ namespace KokkosBlas {
 ///   the same rank as XMV and YMV, and it must make sense to add up
 ///   the entries of XMV and YMV and assign them to the entries of
 ///   ZMV.
+///
+/// For single vectors, X and Y may have a lower precision than Z
+/// (float vs. double).  Then alpha resp. beta keep the precision of Z,
+/// and the entries of X and Y are converted inside the kernel.
 template<class XMV, class YMV, class ZMV>
 void
-update (const typename XMV::non_const_value_type& alpha, const XMV& X,
-        const typename YMV::non_const_value_type& beta, const YMV& Y,
+update (const typename KokkosKernels::Impl::GetMixedScalarType<
+          typename XMV::non_const_value_type,
+          typename ZMV::non_const_value_type>::type& alpha, const XMV& X,
+        const typename KokkosKernels::Impl::GetMixedScalarType<
+          typename YMV::non_const_value_type,
+          typename ZMV::non_const_value_type>::type& beta, const YMV& Y,
         const typename ZMV::non_const_value_type& gamma, const ZMV& Z)
 {
   static_assert (Kokkos::Impl::is_view<XMV>::value, "KokkosBlas::update: "
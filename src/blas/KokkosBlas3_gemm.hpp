@@ -48,6 +48,7 @@
 #include <KokkosKernels_Macros.hpp>
 #include <KokkosBlas3_gemm_spec.hpp>
 #include <KokkosKernels_helpers.hpp>
+#include <KokkosKernels_Profiling.hpp>
 #include <sstream>
 #include <type_traits>
 
@@ -155,6 +156,12 @@ gemm (const char transA[],
     typename CViewType::device_type,
     Kokkos::MemoryTraits<Kokkos::Unmanaged> > CVT;
   typedef Impl::GEMM<AVT, BVT, CVT> impl_type;
+  // A holds the m x k entries of op(A) in either orientation.
+  KOKKOSKERNELS_KERNEL_COUNTS("KokkosBlas::gemm",
+      2.0 * A.extent(0) * A.extent(1) * C.extent(1),
+      (double(A.extent(0)) * A.extent(1) * sizeof(typename AViewType::non_const_value_type) +
+       double(B.extent(0)) * B.extent(1) * sizeof(typename BViewType::non_const_value_type) +
+       2.0 * C.extent(0) * C.extent(1) * sizeof(typename CViewType::non_const_value_type)));
   impl_type::gemm (transA, transB, alpha, A, B, beta, C);
 }
 
@@ -0,0 +1,207 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSBLAS3_SYRK_HPP_
+#define KOKKOSBLAS3_SYRK_HPP_
+
+/// \file KokkosBlas3_syrk.hpp
+
+#include <KokkosKernels_Macros.hpp>
+#include <KokkosBlas3_syrk_spec.hpp>
+#include <KokkosKernels_helpers.hpp>
+#include <sstream>
+#include <type_traits>
+
+namespace KokkosBlas {
+
+namespace Impl {
+// Argument checks shared by syrk and herk
+template<class AViewType,
+         class CViewType>
+void
+syrk_check_args (const char name[],
+                 const char uplo[],
+                 const char trans[],
+                 const bool herm,
+                 const AViewType& A,
+                 const CViewType& C)
+{
+  static_assert (Kokkos::Impl::is_view<AViewType>::value,
+                 "AViewType must be a Kokkos::View.");
+  static_assert (Kokkos::Impl::is_view<CViewType>::value,
+                 "CViewType must be a Kokkos::View.");
+  static_assert (static_cast<int> (AViewType::rank) == 2,
+                 "AViewType must have rank 2.");
+  static_assert (static_cast<int> (CViewType::rank) == 2,
+                 "CViewType must have rank 2.");
+
+  // Check validity of mode arguments
+  bool valid_uplo  = (uplo[0] == 'U') || (uplo[0] == 'u') ||
+                     (uplo[0] == 'L') || (uplo[0] == 'l');
+  bool valid_trans = (trans[0] == 'N') || (trans[0] == 'n') ||
+                     (herm ? ((trans[0] == 'C') || (trans[0] == 'c')) :
+                             ((trans[0] == 'T') || (trans[0] == 't')));
+  if(!(valid_uplo && valid_trans)) {
+    std::ostringstream os;
+    os << name << ": uplo[0] = '" << uplo[0] << "' trans[0] = '" << trans[0] << "'. " <<
+      "Valid values include uplo 'U' or 'L' and trans 'N' or " << (herm ? "'C'" : "'T'") << " (either case).";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  // Check compatibility of dimensions at run time.
+  bool A_t = !(trans[0] == 'N' || trans[0] == 'n');
+  int64_t A0 = A.extent(0);
+  int64_t A1 = A.extent(1);
+  int64_t C0 = C.extent(0);
+  int64_t C1 = C.extent(1);
+
+  if ( (C0 != C1) ||
+       ((A_t?A1:A0) != C0) ) {
+      std::ostringstream os;
+      os << name << ": Dimensions of A and C do not match: "
+         << "trans: " << trans[0]
+         << " A: " << A.extent(0) << " x " << A.extent(1)
+         << " C: " << C.extent(0) << " x " << C.extent(1);
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+}
+}
+
+/// \brief Symmetric rank-k update: C = beta*C + alpha*A*A^T if trans
+///   is "N", or C = beta*C + alpha*A^T*A if trans is "T".  Only the
+///   triangle of C given by uplo is referenced and updated.
+///
+/// \tparam AViewType Input matrix, as a 2-D Kokkos::View
+/// \tparam CViewType Output matrix, as a nonconst 2-D Kokkos::View
+///
+/// \param uplo [in] "U" or "u" (update the upper triangle of C), "L" or
+///   "l" (update the lower triangle of C).
+/// \param trans [in] "N" for non-transpose, "T" for transpose.  All
+///   characters after the first are ignored.
+/// \param alpha [in] Input coefficient of A*A^T
+/// \param A [in] Input matrix, as a 2-D Kokkos::View
+/// \param beta [in] Input coefficient of C
+/// \param C [in/out] Output matrix, as a nonconst 2-D Kokkos::View
+template<class AViewType,
+         class CViewType>
+void
+syrk (const char uplo[],
+      const char trans[],
+      typename AViewType::const_value_type& alpha,
+      const AViewType& A,
+      typename CViewType::const_value_type& beta,
+      const CViewType& C)
+{
+  #if (KOKKOSKERNELS_DEBUG_LEVEL > 0)
+  Impl::syrk_check_args("KokkosBlas::syrk", uplo, trans, false, A, C);
+  #endif // KOKKOSKERNELS_DEBUG_LEVEL > 0
+
+  // Return if degenerated matrices are provided
+  if(C.extent(0) == 0)
+    return;
+
+  // Minimize the number of Impl::SYRK instantiations, by
+  // standardizing on particular View specializations for its template
+  // parameters.
+  typedef Kokkos::View<typename AViewType::const_value_type**,
+    typename AViewType::array_layout,
+    typename AViewType::device_type,
+    Kokkos::MemoryTraits<Kokkos::Unmanaged> > AVT;
+  typedef Kokkos::View<typename CViewType::non_const_value_type**,
+    typename CViewType::array_layout,
+    typename CViewType::device_type,
+    Kokkos::MemoryTraits<Kokkos::Unmanaged> > CVT;
+  typedef Impl::SYRK<AVT, CVT> impl_type;
+  impl_type::syrk (uplo, trans, false, alpha, A, beta, C);
+}
+
+/// \brief Hermitian rank-k update: C = beta*C + alpha*A*A^H if trans
+///   is "N", or C = beta*C + alpha*A^H*A if trans is "C".  Only the
+///   triangle of C given by uplo is referenced and updated; the
+///   imaginary parts of the diagonal of C are set to zero.
+///
+/// \tparam AViewType Input matrix, as a 2-D Kokkos::View
+/// \tparam CViewType Output matrix, as a nonconst 2-D Kokkos::View
+///
+/// \param uplo [in] "U" or "u" (update the upper triangle of C), "L" or
+///   "l" (update the lower triangle of C).
+/// \param trans [in] "N" for non-transpose, "C" for conjugate
+///   transpose.  All characters after the first are ignored.
+/// \param alpha [in] Real input coefficient of A*A^H
+/// \param A [in] Input matrix, as a 2-D Kokkos::View
+/// \param beta [in] Real input coefficient of C
+/// \param C [in/out] Output matrix, as a nonconst 2-D Kokkos::View
+template<class AViewType,
+         class CViewType>
+void
+herk (const char uplo[],
+      const char trans[],
+      typename Kokkos::Details::ArithTraits<typename AViewType::non_const_value_type>::mag_type alpha,
+      const AViewType& A,
+      typename Kokkos::Details::ArithTraits<typename CViewType::non_const_value_type>::mag_type beta,
+      const CViewType& C)
+{
+  #if (KOKKOSKERNELS_DEBUG_LEVEL > 0)
+  Impl::syrk_check_args("KokkosBlas::herk", uplo, trans, true, A, C);
+  #endif // KOKKOSKERNELS_DEBUG_LEVEL > 0
+
+  // Return if degenerated matrices are provided
+  if(C.extent(0) == 0)
+    return;
+
+  typedef Kokkos::View<typename AViewType::const_value_type**,
+    typename AViewType::array_layout,
+    typename AViewType::device_type,
+    Kokkos::MemoryTraits<Kokkos::Unmanaged> > AVT;
+  typedef Kokkos::View<typename CViewType::non_const_value_type**,
+    typename CViewType::array_layout,
+    typename CViewType::device_type,
+    Kokkos::MemoryTraits<Kokkos::Unmanaged> > CVT;
+  typedef Impl::SYRK<AVT, CVT> impl_type;
+  const typename AViewType::non_const_value_type alpha_scalar = alpha;
+  const typename CViewType::non_const_value_type beta_scalar = beta;
+  impl_type::syrk (uplo, trans, true, alpha_scalar, A, beta_scalar, C);
+}
+
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS3_SYRK_HPP_
@@ -46,6 +46,7 @@
 #include "KokkosKernels_config.h"
 #include "Kokkos_Core.hpp"
 #include "Kokkos_InnerProductSpaceTraits.hpp"
+#include "KokkosKernels_helpers.hpp"
 
 #ifndef KOKKOSBLAS_OPTIMIZATION_LEVEL_AXPBY
 #define KOKKOSBLAS_OPTIMIZATION_LEVEL_AXPBY 2
@@ -207,23 +208,31 @@ struct Axpby_Functor {
 // coefficients.  Any literal coefficient of zero has BLAS semantics
 // of ignoring the corresponding (multi)vector entry.  This does not
 // apply to coefficients in the a and b vectors, if they are used.
+//
+// If XV and YV have different value types, a and b have the wider one
+// and the entries of x are converted in the kernel.
 template<class XV, class YV,
          int scalar_x, int scalar_y, class SizeType>
-struct Axpby_Functor<typename XV::non_const_value_type, XV,
-                       typename YV::non_const_value_type, YV,
+struct Axpby_Functor<typename KokkosKernels::Impl::GetMixedScalarType<typename XV::non_const_value_type,
+                                                                      typename YV::non_const_value_type>::type, XV,
+                       typename KokkosKernels::Impl::GetMixedScalarType<typename XV::non_const_value_type,
+                                                                        typename YV::non_const_value_type>::type, YV,
                        scalar_x, scalar_y, SizeType> {
   typedef typename YV::execution_space execution_space;
   typedef SizeType size_type;
   typedef Kokkos::Details::ArithTraits<typename YV::non_const_value_type> ATS;
+  typedef typename KokkosKernels::Impl::GetMixedScalarType<
+    typename XV::non_const_value_type,
+    typename YV::non_const_value_type>::type coefficient_type;
 
   XV m_x;
   YV m_y;
-  const typename XV::non_const_value_type m_a;
-  const typename YV::non_const_value_type m_b;
+  const coefficient_type m_a;
+  const coefficient_type m_b;
 
   Axpby_Functor (const XV& x, const YV& y,
-                   const typename XV::non_const_value_type& a,
-                   const typename YV::non_const_value_type& b,
+                   const coefficient_type& a,
+                   const coefficient_type& b,
                    const SizeType /* startingColumn */) :
     m_x (x), m_y (y), m_a (a), m_b (b)
   {
@@ -327,10 +336,11 @@ struct Axpby_Functor<typename XV::non_const_value_type, XV,
 // Views, then the functor can take a subview if appropriate.
 template<class AV, class XV, class BV, class YV, class SizeType>
 void
-Axpby_Generic (const AV& av, const XV& x,
-                 const BV& bv, const YV& y,
-                 const SizeType startingColumn,
-                 int a = 2, int b = 2)
+Axpby_Generic (const typename YV::execution_space& space,
+               const AV& av, const XV& x,
+               const BV& bv, const YV& y,
+               const SizeType startingColumn,
+               int a = 2, int b = 2)
 {
   static_assert (Kokkos::Impl::is_view<XV>::value, "KokkosBlas::Impl::"
                  "Axpby_Generic: X is not a Kokkos::View.");
@@ -348,7 +358,7 @@ Axpby_Generic (const AV& av, const XV& x,
 
   typedef typename YV::execution_space execution_space;
   const SizeType numRows = x.extent(0);
-  Kokkos::RangePolicy<execution_space, SizeType> policy (0, numRows);
+  Kokkos::RangePolicy<execution_space, SizeType> policy (space, 0, numRows);
 
   if (a == 0 && b == 0) {
     Axpby_Functor<AV, XV, BV, YV, 0, 0, SizeType> op (x, y, av, bv, startingColumn);
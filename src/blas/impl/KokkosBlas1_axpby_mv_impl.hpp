@@ -44,6 +44,7 @@
 #define KOKKOSBLAS1_AXPBY_MV_IMPL_HPP_
 
 #include<KokkosBlas1_axpby_impl.hpp>
+#include<KokkosBlas1_tuning_impl.hpp>
 
 namespace KokkosBlas {
 namespace Impl {
@@ -971,7 +972,8 @@ struct Axpby_MV_Unroll_Functor<typename XMV::non_const_value_type, XMV,
 template<class AV, class XMV, class BV, class YMV,
          int UNROLL, class SizeType>
 void
-Axpby_MV_Unrolled (const AV& av, const XMV& x,
+Axpby_MV_Unrolled (const typename YMV::execution_space& space,
+                   const AV& av, const XMV& x,
                    const BV& bv, const YMV& y,
                    const SizeType startingColumn,
                    int a = 2, int b = 2)
@@ -992,7 +994,7 @@ Axpby_MV_Unrolled (const AV& av, const XMV& x,
 
   typedef typename YMV::execution_space execution_space;
   const SizeType numRows = x.extent(0);
-  Kokkos::RangePolicy<execution_space, SizeType> policy (0, numRows);
+  Kokkos::RangePolicy<execution_space, SizeType> policy (space, 0, numRows);
 
   if (a == 0 && b == 0) {
     Axpby_MV_Unroll_Functor<AV, XMV, BV, YMV, 0, 0, UNROLL, SizeType> op (x, y, av, bv, startingColumn);
@@ -1110,7 +1112,8 @@ Axpby_MV_Unrolled (const AV& av, const XMV& x,
 // Either av and bv are both 1-D Views, or av and bv are both scalars.
 template<class AV, class XMV, class BV, class YMV, class SizeType>
 void
-Axpby_MV_Generic (const AV& av, const XMV& x,
+Axpby_MV_Generic (const typename YMV::execution_space& space,
+                  const AV& av, const XMV& x,
                   const BV& bv, const YMV& y,
                   int a = 2, int b = 2)
 {
@@ -1130,7 +1133,7 @@ Axpby_MV_Generic (const AV& av, const XMV& x,
 
   typedef typename YMV::execution_space execution_space;
   const SizeType numRows = x.extent(0);
-  Kokkos::RangePolicy<execution_space, SizeType> policy (0, numRows);
+  Kokkos::RangePolicy<execution_space, SizeType> policy (space, 0, numRows);
 
   if (a == 0 && b == 0) {
     Axpby_MV_Functor<AV, XMV, BV, YMV, 0, 0, SizeType> op (x, y, av, bv);
@@ -1250,7 +1253,8 @@ template<class AV, class XMV, class BV, class YMV, class SizeType>
 struct
 Axpby_MV_Invoke_Left {
 
-  static void run(const AV& av, const XMV& x,
+  static void run(const typename YMV::execution_space& space,
+                  const AV& av, const XMV& x,
                   const BV& bv, const YMV& y,
                   int a = 2, int b = 2)
 {
@@ -1270,6 +1274,15 @@ Axpby_MV_Invoke_Left {
 
   const SizeType numCols = x.extent(1);
 
+  // The tuning table may have found one launch over all columns to be
+  // faster than strip-mining for this size.
+  if (numCols > 1 &&
+      blas1_tuned_variant<typename YMV::execution_space>
+        (Blas1Tuned_Axpby_MV_Left, x.extent(0), numCols) == Blas1Variant_Generic) {
+    Axpby_MV_Generic<AV, XMV, BV, YMV, SizeType> (space, av, x, bv, y, a, b);
+    return;
+  }
+
   // Strip-mine by 8, then 4.  After that, do one column at a time.
   // We limit the number of strip-mine values in order to keep down
   // the amount of code to compile.
@@ -1281,7 +1294,7 @@ Axpby_MV_Invoke_Left {
     // Passing in the starting column index lets the functor take
     // subviews of av and bv, if they are Views.  If they are scalars,
     // the functor doesn't have to do anything to them.
-    Axpby_MV_Unrolled<AV, XMV, BV, YMV, 8, SizeType> (av, X_cur, bv, Y_cur, j, a, b);
+    Axpby_MV_Unrolled<AV, XMV, BV, YMV, 8, SizeType> (space, av, X_cur, bv, Y_cur, j, a, b);
   }
   for ( ; j + 4 <= numCols; j += 4) {
     XMV X_cur = Kokkos::subview (x, Kokkos::ALL (), std::make_pair (j, j+4));
@@ -1290,7 +1303,7 @@ Axpby_MV_Invoke_Left {
     // Passing in the starting column index lets the functor take
     // subviews of av and bv, if they are Views.  If they are scalars,
     // the functor doesn't have to do anything to them.
-    Axpby_MV_Unrolled<AV, XMV, BV, YMV, 4, SizeType> (av, X_cur, bv, Y_cur, j, a, b);
+    Axpby_MV_Unrolled<AV, XMV, BV, YMV, 4, SizeType> (space, av, X_cur, bv, Y_cur, j, a, b);
   }
   for ( ; j < numCols; ++j) {
     auto x_cur = Kokkos::subview (x, Kokkos::ALL (), j);
@@ -1301,7 +1314,7 @@ Axpby_MV_Invoke_Left {
     // the functor doesn't have to do anything to them.
     typedef decltype (x_cur) XV;
     typedef decltype (y_cur) YV;
-    Axpby_Generic<AV, XV, BV, YV, SizeType> (av, x_cur, bv, y_cur, j, a, b);
+    Axpby_Generic<AV, XV, BV, YV, SizeType> (space, av, x_cur, bv, y_cur, j, a, b);
   }
 }
 };
@@ -1329,7 +1342,8 @@ template<class AV, class XMV, class BV, class YMV, class SizeType>
 struct
 Axpby_MV_Invoke_Right {
 
-static void run(const AV& av, const XMV& x,
+static void run(const typename YMV::execution_space& space,
+                const AV& av, const XMV& x,
                 const BV& bv, const YMV& y,
                 int a = 2, int b = 2)
 {
@@ -1353,10 +1367,10 @@ static void run(const AV& av, const XMV& x,
     auto y_0 = Kokkos::subview (y, Kokkos::ALL (), 0);
     typedef decltype (x_0) XV;
     typedef decltype (y_0) YV;
-    Axpby_Generic<AV, XV, BV, YV, SizeType> (av, x_0, bv, y_0, 0, a, b);
+    Axpby_Generic<AV, XV, BV, YV, SizeType> (space, av, x_0, bv, y_0, 0, a, b);
   }
   else {
-    Axpby_MV_Generic<AV, XMV, BV, YMV, SizeType> (av, x, bv, y, a, b);
+    Axpby_MV_Generic<AV, XMV, BV, YMV, SizeType> (space, av, x, bv, y, a, b);
   }
 }
 };
@@ -45,9 +45,11 @@
 
 #include "KokkosKernels_config.h"
 #include "Kokkos_Core.hpp"
+#include "KokkosKernels_Macros.hpp"
 #include "Kokkos_InnerProductSpaceTraits.hpp"
+#include "KokkosKernels_helpers.hpp"
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(AXPBY)
 #include<KokkosBlas1_axpby_impl.hpp>
 #include<KokkosBlas1_axpby_mv_impl.hpp>
 #endif
@@ -76,6 +78,17 @@ struct axpby_eti_spec_avail {
          Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                       Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
          SCALAR, \
+         Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         1> { enum : bool { value = true }; }; \
+    template<> \
+    struct axpby_eti_spec_avail< \
+         Kokkos::View<const SCALAR*, Kokkos::LayoutLeft, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         Kokkos::View<const SCALAR*, Kokkos::LayoutLeft, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
          Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                       Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
          1> { enum : bool { value = true }; };
@@ -109,10 +122,28 @@ struct axpby_eti_spec_avail {
                       Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
          2> { enum : bool { value = true }; };
 
+//
+// Macro for declaration of full specialization availability
+// KokkosBlas::Impl::Axpby for rank == 1, with X and Y of different
+// value types, e.g., float and double (mixed precision).  The scalar
+// coefficients have the wider type.  This is NOT for users!!!
+//
+#define KOKKOSBLAS1_AXPBY_MIXED_ETI_SPEC_AVAIL( XSCALAR, YSCALAR, LAYOUT, EXEC_SPACE, MEM_SPACE ) \
+    template<> \
+    struct axpby_eti_spec_avail< \
+         KokkosKernels::Impl::GetMixedScalarType<XSCALAR, YSCALAR>::type, \
+         Kokkos::View<const XSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         KokkosKernels::Impl::GetMixedScalarType<XSCALAR, YSCALAR>::type, \
+         Kokkos::View<YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         1> { enum : bool { value = true }; };
+
 // Include the actual specialization declarations
 #include<KokkosBlas1_axpby_tpl_spec_avail.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_axpby_eti_spec_avail.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_axpby_mv_eti_spec_avail.hpp>
+#include<generated_specializations_hpp/KokkosBlas1_axpby_mixed_eti_spec_avail.hpp>
 
 namespace KokkosBlas {
 namespace Impl {
@@ -143,19 +174,21 @@ namespace Impl {
 /// apply to coefficients in av and bv vectors, if they are used.
 template<class AV, class XMV, class BV, class YMV, int rank = YMV::Rank,
          bool tpl_spec_avail = axpby_tpl_spec_avail<AV,XMV,BV,YMV>::value,
-         bool eti_spec_avail = axpby_eti_spec_avail<AV,XMV,BV,YMV>::value>
+         bool eti_spec_avail = axpby_eti_spec_avail<AV,XMV,BV,YMV>::value && !KOKKOSKERNELS_BLAS1_INLINE(AXPBY)>
 struct Axpby {
-  static void axpby (const AV& av, const XMV& X, const BV& bv, const YMV& Y);
+  static void axpby (const typename YMV::execution_space& space,
+                     const AV& av, const XMV& X, const BV& bv, const YMV& Y);
 };
 
 template<class AV, class XMV, class BV, class YMV>
 struct Axpby<AV,XMV,BV,YMV,0,true,true> {
-  static void axpby (const AV& av, const XMV& X, const BV& bv, const YMV& Y) {
+  static void axpby (const typename YMV::execution_space& space,
+                     const AV& av, const XMV& X, const BV& bv, const YMV& Y) {
     static_assert(YMV::Rank==0,"Oh My God");
   }
 };
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(AXPBY)
 // Full specialization for XMV and YMV rank-2 Views.
 template<class AV, class XMV, class BV, class YMV>
 struct Axpby<AV, XMV, BV, YMV, 2, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
@@ -163,7 +196,8 @@ struct Axpby<AV, XMV, BV, YMV, 2, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
   typedef typename YMV::size_type size_type;
 
   static void
-  axpby (const AV& av, const XMV& X, const BV& bv, const YMV& Y)
+  axpby (const typename YMV::execution_space& space,
+         const AV& av, const XMV& X, const BV& bv, const YMV& Y)
   {
     static_assert (Kokkos::Impl::is_view<XMV>::value, "KokkosBlas::Impl::"
                    "Axpby<rank-2>::axpby: X is not a Kokkos::View.");
@@ -204,14 +238,14 @@ struct Axpby<AV, XMV, BV, YMV, 2, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
       typedef typename std::conditional<std::is_same<typename XMV::array_layout,Kokkos::LayoutLeft>::value,
         Axpby_MV_Invoke_Right<AV, XMV, BV, YMV, index_type>,
         Axpby_MV_Invoke_Left<AV, XMV, BV, YMV, index_type> >::type Axpby_MV_Invoke_Layout;
-      Axpby_MV_Invoke_Layout::run(av, X, bv, Y, a, b);
+      Axpby_MV_Invoke_Layout::run(space, av, X, bv, Y, a, b);
     }
     else {
       typedef typename XMV::size_type index_type;
       typedef typename std::conditional<std::is_same<typename XMV::array_layout,Kokkos::LayoutLeft>::value,
         Axpby_MV_Invoke_Right<AV, XMV, BV, YMV, index_type>,
         Axpby_MV_Invoke_Left<AV, XMV, BV, YMV, index_type> >::type Axpby_MV_Invoke_Layout;
-      Axpby_MV_Invoke_Layout::run(av, X, bv, Y, a, b);
+      Axpby_MV_Invoke_Layout::run(space, av, X, bv, Y, a, b);
     }
   }
 };
@@ -229,7 +263,8 @@ struct Axpby<typename XMV::non_const_value_type, XMV,
   typedef Kokkos::Details::ArithTraits<typename YMV::non_const_value_type> ATB;
 
   static void
-  axpby (const AV& alpha, const XMV& X, const BV& beta, const YMV& Y)
+  axpby (const typename YMV::execution_space& space,
+         const AV& alpha, const XMV& X, const BV& beta, const YMV& Y)
   {
     static_assert (Kokkos::Impl::is_view<XMV>::value,
                    "KokkosBlas::Impl::Axpby::axpby (MV): "
@@ -296,34 +331,39 @@ struct Axpby<typename XMV::non_const_value_type, XMV,
       typedef typename std::conditional<std::is_same<typename XMV::array_layout,Kokkos::LayoutLeft>::value,
         Axpby_MV_Invoke_Right<AV, XMV, BV, YMV, index_type>,
         Axpby_MV_Invoke_Left<AV, XMV, BV, YMV, index_type> >::type Axpby_MV_Invoke_Layout;
-      Axpby_MV_Invoke_Layout::run(alpha, X,
-                                                          beta, Y, a, b);
+      Axpby_MV_Invoke_Layout::run(space, alpha, X, beta, Y, a, b);
     }
     else {
       typedef typename XMV::size_type index_type;
       typedef typename std::conditional<std::is_same<typename XMV::array_layout,Kokkos::LayoutLeft>::value,
         Axpby_MV_Invoke_Right<AV, XMV, BV, YMV, index_type>,
         Axpby_MV_Invoke_Left<AV, XMV, BV, YMV, index_type> >::type Axpby_MV_Invoke_Layout;
-      Axpby_MV_Invoke_Layout::run(alpha, X,
-                                                          beta, Y, a, b);
+      Axpby_MV_Invoke_Layout::run(space, alpha, X, beta, Y, a, b);
     }
   }
 };
 
 // Partial specialization for XV and YV rank-1 Views,
-// and AV and BV scalars.
+// and AV and BV scalars.  If XV and YV have different value types,
+// AV and BV are the wider one (see KokkosBlas::axpby).
 template<class XV, class YV>
-struct Axpby<typename XV::non_const_value_type, XV,
-             typename YV::non_const_value_type, YV, 1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
+struct Axpby<typename KokkosKernels::Impl::GetMixedScalarType<typename XV::non_const_value_type,
+                                                              typename YV::non_const_value_type>::type, XV,
+             typename KokkosKernels::Impl::GetMixedScalarType<typename XV::non_const_value_type,
+                                                              typename YV::non_const_value_type>::type, YV,
+             1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
 {
-  typedef typename XV::non_const_value_type AV;
-  typedef typename YV::non_const_value_type BV;
+  typedef typename KokkosKernels::Impl::GetMixedScalarType<
+    typename XV::non_const_value_type,
+    typename YV::non_const_value_type>::type AV;
+  typedef AV BV;
   typedef typename YV::size_type size_type;
-  typedef Kokkos::Details::ArithTraits<typename XV::non_const_value_type> ATA;
-  typedef Kokkos::Details::ArithTraits<typename YV::non_const_value_type> ATB;
+  typedef Kokkos::Details::ArithTraits<AV> ATA;
+  typedef Kokkos::Details::ArithTraits<BV> ATB;
 
   static void
-  axpby (const AV& alpha, const XV& X, const BV& beta, const YV& Y)
+  axpby (const typename YV::execution_space& space,
+         const AV& alpha, const XV& X, const BV& beta, const YV& Y)
   {
     static_assert (Kokkos::Impl::is_view<XV>::value, "KokkosBlas::Impl::"
                    "Axpby<rank-1>::axpby: X is not a Kokkos::View.");
@@ -376,15 +416,65 @@ struct Axpby<typename XV::non_const_value_type, XV,
 
     if (numRows < static_cast<size_type> (INT_MAX)) {
       typedef int index_type;
-      Axpby_Generic<typename XV::non_const_value_type, XV,
-        typename YV::non_const_value_type, YV,
-        index_type> (alpha, X, beta, Y, 0, a, b);
+      Axpby_Generic<AV, XV, BV, YV,
+        index_type> (space, alpha, X, beta, Y, 0, a, b);
     }
     else {
       typedef typename XV::size_type index_type;
-      Axpby_Generic<typename XV::non_const_value_type, XV,
-        typename YV::non_const_value_type, YV,
-        index_type> (alpha, X, beta, Y, 0, a, b);
+      Axpby_Generic<AV, XV, BV, YV,
+        index_type> (space, alpha, X, beta, Y, 0, a, b);
+    }
+  }
+};
+
+// Partial specialization for XV and YV rank-1 Views, and AV and BV
+// rank-1 Views of length one (single coefficients in device memory,
+// see KokkosBlas::axpby).  Only a(0) and b(0) are read, inside the
+// kernel.
+template<class AT, class ... AP, class XV, class BT, class ... BP, class YV>
+struct Axpby<Kokkos::View<AT*, AP...>, XV, Kokkos::View<BT*, BP...>, YV,
+             1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
+{
+  typedef Kokkos::View<AT*, AP...> AV;
+  typedef Kokkos::View<BT*, BP...> BV;
+  typedef typename YV::size_type size_type;
+
+  static void
+  axpby (const typename YV::execution_space& space,
+         const AV& av, const XV& X, const BV& bv, const YV& Y)
+  {
+    static_assert (Kokkos::Impl::is_view<XV>::value, "KokkosBlas::Impl::"
+                   "Axpby<rank-1>::axpby: X is not a Kokkos::View.");
+    static_assert (Kokkos::Impl::is_view<YV>::value, "KokkosBlas::Impl::"
+                   "Axpby<rank-1>::axpby: Y is not a Kokkos::View.");
+    static_assert (Kokkos::Impl::is_same<typename YV::value_type,
+                     typename YV::non_const_value_type>::value,
+                   "KokkosBlas::Impl::Axpby<rank-1>::axpby: Y is const.  "
+                   "It must be nonconst, because it is an output argument "
+                   "(we have to be able to write to its entries).");
+    static_assert ((int) YV::Rank == (int) XV::Rank, "KokkosBlas::Impl::"
+                   "Axpby<rank-1>::axpby: X and Y must have the same rank.");
+    static_assert (YV::Rank == 1, "KokkosBlas::Impl::Axpby<rank-1>::axpby: "
+                   "X and Y must have rank 1.");
+
+    #ifdef KOKKOSKERNELS_ENABLE_CHECK_SPECIALIZATION
+    if(KOKKOSKERNELS_IMPL_COMPILE_LIBRARY)
+      printf("KokkosBlas1::axpby<> ETI specialization for < %s , %s , %s , %s >\n",typeid(AV).name(),typeid(XV).name(),typeid(BV).name(),typeid(YV).name());
+    else {
+      printf("KokkosBlas1::axpby<> non-ETI specialization for < %s , %s , %s , %s >\n",typeid(AV).name(),typeid(XV).name(),typeid(BV).name(),typeid(YV).name());
+    }
+    #endif
+
+    const size_type numRows = X.extent(0);
+    if (numRows < static_cast<size_type> (INT_MAX)) {
+      typedef int index_type;
+      Axpby_Generic<AV, XV, BV, YV,
+        index_type> (space, av, X, bv, Y, 0, 2, 2);
+    }
+    else {
+      typedef typename XV::size_type index_type;
+      Axpby_Generic<AV, XV, BV, YV,
+        index_type> (space, av, X, bv, Y, 0, 2, 2);
     }
   }
 };
@@ -409,6 +499,16 @@ extern template struct Axpby< \
         Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         SCALAR, \
+        Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1, false, true>; \
+extern template struct Axpby< \
+        Kokkos::View<const SCALAR*, Kokkos::LayoutLeft, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const SCALAR*, Kokkos::LayoutLeft, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         1, false, true>;
@@ -419,6 +519,16 @@ template struct Axpby< \
         Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         SCALAR, \
+        Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1, false, true>; \
+template struct Axpby< \
+        Kokkos::View<const SCALAR*, Kokkos::LayoutLeft, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const SCALAR*, Kokkos::LayoutLeft, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         1, false, true>;
@@ -472,8 +582,34 @@ template struct Axpby< \
      2, false, true>;
 
 
+//
+// Macros for declaration and definition of full specializations of
+// KokkosBlas::Impl::Axpby for rank == 1 and mixed precision.  This is
+// NOT for users!!!
+//
+#define KOKKOSBLAS1_AXPBY_MIXED_ETI_SPEC_DECL( XSCALAR, YSCALAR, LAYOUT, EXEC_SPACE, MEM_SPACE ) \
+extern template struct Axpby< \
+        KokkosKernels::Impl::GetMixedScalarType<XSCALAR, YSCALAR>::type, \
+        Kokkos::View<const XSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        KokkosKernels::Impl::GetMixedScalarType<XSCALAR, YSCALAR>::type, \
+        Kokkos::View<YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1, false, true>;
+
+#define KOKKOSBLAS1_AXPBY_MIXED_ETI_SPEC_INST( XSCALAR, YSCALAR, LAYOUT, EXEC_SPACE, MEM_SPACE ) \
+template struct Axpby< \
+        KokkosKernels::Impl::GetMixedScalarType<XSCALAR, YSCALAR>::type, \
+        Kokkos::View<const XSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        KokkosKernels::Impl::GetMixedScalarType<XSCALAR, YSCALAR>::type, \
+        Kokkos::View<YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1, false, true>;
+
 #include<KokkosBlas1_axpby_tpl_spec_decl.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_axpby_eti_spec_decl.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_axpby_mv_eti_spec_decl.hpp>
+#include<generated_specializations_hpp/KokkosBlas1_axpby_mixed_eti_spec_decl.hpp>
 
 #endif // KOKKOS_BLAS1_MV_IMPL_AXPBY_HPP_
@@ -0,0 +1,269 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSBLAS1_BATCHED_IMPL_HPP_
+#define KOKKOSBLAS1_BATCHED_IMPL_HPP_
+
+#include <type_traits>
+#include <KokkosKernels_config.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include <Kokkos_InnerProductSpaceTraits.hpp>
+
+namespace KokkosBlas {
+namespace Experimental {
+namespace Impl {
+
+// Batched BLAS1 on a rank 2 view treats each column X(:,k) as an
+// independent short vector.  Each team handles a chunk of consecutive
+// vectors; within the team, one thread (with its vector lanes) handles
+// one vector.  Vectors at least BatchedTeamPerVectorLength long get a
+// whole team each instead.
+enum { BatchedTeamPerVectorLength = 256 };
+
+/// \brief Launch parameters of a batched BLAS1 kernel.
+struct BatchedMapping {
+  bool team_per_vector;
+  int team_size;
+  int vector_length;
+  int vecs_per_team;
+};
+
+/// \brief Pick the mapping of nvec vectors of length len onto teams.
+///
+/// On host each thread loops over whole vectors.  On Cuda, when the
+/// entries of a vector are contiguous (stride_0 == 1, e.g. LayoutLeft)
+/// the vector lanes split the entries of a vector, so that a warp reads
+/// 32/vector_length vectors with coalesced loads; when the vectors are
+/// interleaved (LayoutRight) a thread per vector already coalesces.
+template<class ExecSpace>
+BatchedMapping
+batched_mapping (const int len, const bool contiguous)
+{
+  BatchedMapping m;
+  m.team_per_vector = (len >= BatchedTeamPerVectorLength);
+  m.team_size = 1;
+  m.vector_length = 1;
+  m.vecs_per_team = m.team_per_vector ? 1 : 32;
+#if defined(KOKKOS_ENABLE_CUDA)
+  if (std::is_same<ExecSpace, Kokkos::Cuda>::value && ! m.team_per_vector) {
+    if (contiguous) {
+      while (m.vector_length < len && m.vector_length < 32)
+        m.vector_length *= 2;
+    }
+    m.team_size = 128 / m.vector_length;
+    m.vecs_per_team = m.team_size;
+  }
+#else
+  (void) contiguous;
+#endif
+  return m;
+}
+
+template<class ExecSpace, class Functor>
+void
+run_batched_functor (const char* label, const int nvec, const BatchedMapping& m,
+                     const Functor& functor)
+{
+  typedef Kokkos::TeamPolicy<ExecSpace> policy_type;
+  const int league_size = (nvec + m.vecs_per_team - 1) / m.vecs_per_team;
+  if (m.team_per_vector) {
+    Kokkos::parallel_for (label, policy_type (league_size, Kokkos::AUTO), functor);
+  }
+  else {
+    Kokkos::parallel_for (label, policy_type (league_size, m.team_size, m.vector_length), functor);
+  }
+}
+
+/// \brief Coefficient k of a batched update: either one scalar for
+///   all vectors, or entry k of a rank 1 view.
+template<class AV, bool is_view = Kokkos::Impl::is_view<AV>::value>
+struct BatchedCoefficient {
+  typedef typename AV::const_type type;
+  KOKKOS_INLINE_FUNCTION
+  static typename AV::non_const_value_type get (const type& a, const int k) { return a(k); }
+  static bool valid (const AV& a, const size_t nvec) { return AV::rank == 1 && a.extent(0) == nvec; }
+};
+
+template<class AV>
+struct BatchedCoefficient<AV, false> {
+  typedef AV type;
+  KOKKOS_INLINE_FUNCTION
+  static AV get (const type& a, const int /* k */) { return a; }
+  static bool valid (const AV& /* a */, const size_t /* nvec */) { return true; }
+};
+
+/// \brief R(k) = dot(X(:,k), Y(:,k)).
+template<class RV, class XMV, class YMV>
+struct Batched_Dot_Functor {
+  typedef typename XMV::execution_space execution_space;
+  typedef typename Kokkos::TeamPolicy<execution_space>::member_type member_type;
+  typedef Kokkos::Details::InnerProductSpaceTraits<typename XMV::non_const_value_type> IPT;
+  typedef typename IPT::dot_type value_type;
+
+  RV m_r;
+  typename XMV::const_type m_x;
+  typename YMV::const_type m_y;
+  int m_len, m_nvec, m_vecs_per_team;
+  bool m_team_per_vector;
+
+  Batched_Dot_Functor (const RV& r, const XMV& x, const YMV& y, const BatchedMapping& m) :
+    m_r (r), m_x (x), m_y (y), m_len (x.extent_int(0)), m_nvec (x.extent_int(1)),
+    m_vecs_per_team (m.vecs_per_team), m_team_per_vector (m.team_per_vector)
+  {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const member_type& member) const {
+    if (m_team_per_vector) {
+      const int k = member.league_rank ();
+      value_type sum = Kokkos::Details::ArithTraits<value_type>::zero ();
+      Kokkos::parallel_reduce (Kokkos::TeamThreadRange (member, m_len), [&] (const int i, value_type& update) {
+          update += IPT::dot (m_x(i,k), m_y(i,k));
+        }, sum);
+      Kokkos::single (Kokkos::PerTeam (member), [&] () { m_r(k) = sum; });
+      return;
+    }
+    const int k0 = member.league_rank () * m_vecs_per_team;
+    const int nk = (m_nvec - k0 < m_vecs_per_team ? m_nvec - k0 : m_vecs_per_team);
+    Kokkos::parallel_for (Kokkos::TeamThreadRange (member, nk), [&] (const int j) {
+        const int k = k0 + j;
+        value_type sum = Kokkos::Details::ArithTraits<value_type>::zero ();
+        Kokkos::parallel_reduce (Kokkos::ThreadVectorRange (member, m_len), [&] (const int i, value_type& update) {
+            update += IPT::dot (m_x(i,k), m_y(i,k));
+          }, sum);
+        Kokkos::single (Kokkos::PerThread (member), [&] () { m_r(k) = sum; });
+      });
+  }
+};
+
+/// \brief R(k) = nrm2(X(:,k)).
+template<class RV, class XMV>
+struct Batched_Nrm2_Functor {
+  typedef typename XMV::execution_space execution_space;
+  typedef typename Kokkos::TeamPolicy<execution_space>::member_type member_type;
+  typedef Kokkos::Details::InnerProductSpaceTraits<typename XMV::non_const_value_type> IPT;
+  typedef typename IPT::mag_type value_type;
+  typedef Kokkos::Details::ArithTraits<value_type> AT;
+
+  RV m_r;
+  typename XMV::const_type m_x;
+  int m_len, m_nvec, m_vecs_per_team;
+  bool m_team_per_vector;
+
+  Batched_Nrm2_Functor (const RV& r, const XMV& x, const BatchedMapping& m) :
+    m_r (r), m_x (x), m_len (x.extent_int(0)), m_nvec (x.extent_int(1)),
+    m_vecs_per_team (m.vecs_per_team), m_team_per_vector (m.team_per_vector)
+  {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const member_type& member) const {
+    if (m_team_per_vector) {
+      const int k = member.league_rank ();
+      value_type sum = AT::zero ();
+      Kokkos::parallel_reduce (Kokkos::TeamThreadRange (member, m_len), [&] (const int i, value_type& update) {
+          const value_type tmp = IPT::norm (m_x(i,k));
+          update += tmp * tmp;
+        }, sum);
+      Kokkos::single (Kokkos::PerTeam (member), [&] () { m_r(k) = AT::sqrt (sum); });
+      return;
+    }
+    const int k0 = member.league_rank () * m_vecs_per_team;
+    const int nk = (m_nvec - k0 < m_vecs_per_team ? m_nvec - k0 : m_vecs_per_team);
+    Kokkos::parallel_for (Kokkos::TeamThreadRange (member, nk), [&] (const int j) {
+        const int k = k0 + j;
+        value_type sum = AT::zero ();
+        Kokkos::parallel_reduce (Kokkos::ThreadVectorRange (member, m_len), [&] (const int i, value_type& update) {
+            const value_type tmp = IPT::norm (m_x(i,k));
+            update += tmp * tmp;
+          }, sum);
+        Kokkos::single (Kokkos::PerThread (member), [&] () { m_r(k) = AT::sqrt (sum); });
+      });
+  }
+};
+
+/// \brief Y(:,k) = a(k)*X(:,k) + b(k)*Y(:,k).
+template<class AV, class XMV, class BV, class YMV>
+struct Batched_Axpby_Functor {
+  typedef typename YMV::execution_space execution_space;
+  typedef typename Kokkos::TeamPolicy<execution_space>::member_type member_type;
+
+  typename BatchedCoefficient<AV>::type m_a;
+  typename XMV::const_type m_x;
+  typename BatchedCoefficient<BV>::type m_b;
+  YMV m_y;
+  int m_len, m_nvec, m_vecs_per_team;
+  bool m_team_per_vector;
+
+  Batched_Axpby_Functor (const AV& a, const XMV& x, const BV& b, const YMV& y, const BatchedMapping& m) :
+    m_a (a), m_x (x), m_b (b), m_y (y), m_len (y.extent_int(0)), m_nvec (y.extent_int(1)),
+    m_vecs_per_team (m.vecs_per_team), m_team_per_vector (m.team_per_vector)
+  {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const member_type& member) const {
+    if (m_team_per_vector) {
+      const int k = member.league_rank ();
+      const auto a = BatchedCoefficient<AV>::get (m_a, k);
+      const auto b = BatchedCoefficient<BV>::get (m_b, k);
+      Kokkos::parallel_for (Kokkos::TeamThreadRange (member, m_len), [&] (const int i) {
+          m_y(i,k) = a*m_x(i,k) + b*m_y(i,k);
+        });
+      return;
+    }
+    const int k0 = member.league_rank () * m_vecs_per_team;
+    const int nk = (m_nvec - k0 < m_vecs_per_team ? m_nvec - k0 : m_vecs_per_team);
+    Kokkos::parallel_for (Kokkos::TeamThreadRange (member, nk), [&] (const int j) {
+        const int k = k0 + j;
+        const auto a = BatchedCoefficient<AV>::get (m_a, k);
+        const auto b = BatchedCoefficient<BV>::get (m_b, k);
+        Kokkos::parallel_for (Kokkos::ThreadVectorRange (member, m_len), [&] (const int i) {
+            m_y(i,k) = a*m_x(i,k) + b*m_y(i,k);
+          });
+      });
+  }
+};
+
+} // namespace Impl
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_BATCHED_IMPL_HPP_
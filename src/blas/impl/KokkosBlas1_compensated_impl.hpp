@@ -0,0 +1,209 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSBLAS1_COMPENSATED_IMPL_HPP_
+#define KOKKOSBLAS1_COMPENSATED_IMPL_HPP_
+
+#include <cmath>
+#include <KokkosKernels_config.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+
+namespace KokkosBlas {
+namespace Experimental {
+namespace Impl {
+
+/// \brief Unevaluated sum s + c of a running sum s and its error c.
+template<class T>
+struct CompensatedSum {
+  T s;
+  T c;
+};
+
+/// \brief a*b + c with a single rounding.
+KOKKOS_INLINE_FUNCTION float compensated_fma (const float a, const float b, const float c)
+{
+#ifdef __CUDA_ARCH__
+  return ::fmaf (a, b, c);
+#else
+  return std::fma (a, b, c);
+#endif
+}
+
+KOKKOS_INLINE_FUNCTION double compensated_fma (const double a, const double b, const double c)
+{
+#ifdef __CUDA_ARCH__
+  return ::fma (a, b, c);
+#else
+  return std::fma (a, b, c);
+#endif
+}
+
+/// \brief TwoSum (Knuth): s + e == a + b exactly, with s = fl(a + b).
+template<class T>
+KOKKOS_INLINE_FUNCTION void two_sum (const T a, const T b, T& s, T& e)
+{
+  s = a + b;
+  const T bb = s - a;
+  e = (a - (s - bb)) + (b - bb);
+}
+
+/// \brief TwoProduct: p + e == a * b exactly, with p = fl(a * b).
+template<class T>
+KOKKOS_INLINE_FUNCTION void two_product (const T a, const T b, T& p, T& e)
+{
+  p = a * b;
+  e = compensated_fma (a, b, -p);
+}
+
+/// \brief sum += p, keeping the rounding error of the addition.
+template<class T>
+KOKKOS_INLINE_FUNCTION void compensated_add (CompensatedSum<T>& sum, const T p)
+{
+  T s, e;
+  two_sum (sum.s, p, s, e);
+  sum.s = s;
+  sum.c += e;
+}
+
+/// \brief Dot2 (Ogita, Rump and Oishi, 2005) of two real vectors.
+///
+/// The result is as accurate as if dot(x, y) were computed in twice
+/// the working precision and then rounded.  Also used for the squared
+/// 2-norm with y == x.
+template<class XVector, class YVector, typename SizeType>
+struct Compensated_Dot_Functor
+{
+  typedef typename XVector::execution_space execution_space;
+  typedef SizeType size_type;
+  typedef typename XVector::non_const_value_type scalar_type;
+  typedef CompensatedSum<scalar_type> value_type;
+
+  typename XVector::const_type m_x;
+  typename YVector::const_type m_y;
+
+  Compensated_Dot_Functor (const XVector& x, const YVector& y) : m_x (x), m_y (y) {}
+
+  KOKKOS_FORCEINLINE_FUNCTION void
+  operator() (const size_type& i, value_type& sum) const
+  {
+    scalar_type p, ep;
+    two_product (static_cast<scalar_type> (m_x(i)), static_cast<scalar_type> (m_y(i)), p, ep);
+    compensated_add (sum, p);
+    sum.c += ep;
+  }
+
+  KOKKOS_INLINE_FUNCTION void
+  init (value_type& update) const
+  {
+    update.s = Kokkos::Details::ArithTraits<scalar_type>::zero ();
+    update.c = Kokkos::Details::ArithTraits<scalar_type>::zero ();
+  }
+
+  KOKKOS_INLINE_FUNCTION void
+  join (volatile value_type& update,
+        const volatile value_type& source) const
+  {
+    scalar_type s, e;
+    two_sum<scalar_type> (update.s, source.s, s, e);
+    update.s = s;
+    update.c = update.c + source.c + e;
+  }
+};
+
+/// \brief Compensated (Kahan-Babuska / Sum2) sum of a real vector.
+template<class XVector, typename SizeType>
+struct Compensated_Sum_Functor
+{
+  typedef typename XVector::execution_space execution_space;
+  typedef SizeType size_type;
+  typedef typename XVector::non_const_value_type scalar_type;
+  typedef CompensatedSum<scalar_type> value_type;
+
+  typename XVector::const_type m_x;
+
+  Compensated_Sum_Functor (const XVector& x) : m_x (x) {}
+
+  KOKKOS_FORCEINLINE_FUNCTION void
+  operator() (const size_type& i, value_type& sum) const
+  {
+    compensated_add (sum, static_cast<scalar_type> (m_x(i)));
+  }
+
+  KOKKOS_INLINE_FUNCTION void
+  init (value_type& update) const
+  {
+    update.s = Kokkos::Details::ArithTraits<scalar_type>::zero ();
+    update.c = Kokkos::Details::ArithTraits<scalar_type>::zero ();
+  }
+
+  KOKKOS_INLINE_FUNCTION void
+  join (volatile value_type& update,
+        const volatile value_type& source) const
+  {
+    scalar_type s, e;
+    two_sum<scalar_type> (update.s, source.s, s, e);
+    update.s = s;
+    update.c = update.c + source.c + e;
+  }
+};
+
+/// \brief Run the compensated reduction \c Functor<..., SizeType> over
+///   [0, n) and return s + c.
+template<class Functor>
+typename Functor::scalar_type
+compensated_reduce (const char label[], const Functor& functor, const size_t n)
+{
+  typedef typename Functor::execution_space execution_space;
+  typedef typename Functor::size_type size_type;
+  typename Functor::value_type result;
+  Kokkos::parallel_reduce (label, Kokkos::RangePolicy<execution_space, size_type> (0, n),
+                           functor, result);
+  return result.s + result.c;
+}
+
+} // namespace Impl
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_COMPENSATED_IMPL_HPP_
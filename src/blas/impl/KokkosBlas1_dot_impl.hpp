@@ -71,8 +71,8 @@ struct DotFunctor
 
   DotFunctor (const XVector& x, const YVector& y) : m_x (x), m_y (y) {}
 
-  void run(const char* label, AV result) {
-    Kokkos::RangePolicy<execution_space,size_type> policy(0,m_x.extent(0));
+  void run(const char* label, const execution_space& space, AV result) {
+    Kokkos::RangePolicy<execution_space,size_type> policy(space,0,m_x.extent(0));
     Kokkos::parallel_reduce(label,policy,*this,result);
   }
 
@@ -52,6 +52,7 @@
 #include <Kokkos_InnerProductSpaceTraits.hpp>
 #include <type_traits>
 #include <KokkosBlas1_dot_impl.hpp>
+#include <KokkosBlas1_tuning_impl.hpp>
 
 namespace KokkosBlas {
 namespace Impl {
@@ -393,14 +394,16 @@ template<class RV, class XMV, class YMV, class SizeType,
 struct MV_V_Dot_Invoke_Impl
 {
   static void
-  run (const RV& r, const XMV& X, const YMV& Y, const SizeType numRows);
+  run (const typename XMV::execution_space& space,
+       const RV& r, const XMV& X, const YMV& Y, const SizeType numRows);
 };
 
 template<class RV, class XMV, class YMV, class SizeType>
 struct MV_V_Dot_Invoke_Impl<RV, XMV, YMV, SizeType, 2, 1>
 {
   static void
-  run (const RV& r, const XMV& X, const YMV& Y, const SizeType numRows)
+  run (const typename XMV::execution_space& space,
+       const RV& r, const XMV& X, const YMV& Y, const SizeType numRows)
   {
     static_assert (static_cast<int> (XMV::rank) == 2 && static_cast<int> (YMV::rank) == 1,
                    "XMV must have rank 2, and YMV must have rank 1.");
@@ -415,7 +418,7 @@ struct MV_V_Dot_Invoke_Impl<RV, XMV, YMV, SizeType, 2, 1>
     typedef MV_V_Dot_Functor<RV, XMV, YMV, size_type> op_type;
     constexpr bool reverseOrder = false;
     op_type op (r, X, Y, reverseOrder);
-    Kokkos::parallel_reduce (range_type (0, numRows), op, r);
+    Kokkos::parallel_reduce (range_type (space, 0, numRows), op, r);
   }
 };
 
@@ -423,7 +426,8 @@ template<class RV, class XMV, class YMV, class SizeType>
 struct MV_V_Dot_Invoke_Impl<RV, XMV, YMV, SizeType, 1, 2>
 {
   static void
-  run (const RV& r, const XMV& X, const YMV& Y, const SizeType numRows)
+  run (const typename XMV::execution_space& space,
+       const RV& r, const XMV& X, const YMV& Y, const SizeType numRows)
   {
     static_assert (static_cast<int> (XMV::rank) == 1 && static_cast<int> (YMV::rank) == 2,
                    "XMV must have rank 1, and YMV must have rank 2.");
@@ -439,44 +443,59 @@ struct MV_V_Dot_Invoke_Impl<RV, XMV, YMV, SizeType, 1, 2>
     typedef MV_V_Dot_Functor<RV, YMV, XMV, size_type> op_type;
     constexpr bool reverseOrder = true;
     op_type op (r, Y, X, reverseOrder);
-    Kokkos::parallel_reduce (range_type (0, numRows), op, r);
+    Kokkos::parallel_reduce (range_type (space, 0, numRows), op, r);
   }
 };
 
 //! Special case where XMV has rank 2 and YMV has rank 1, or vice versa.
 template<class RV, class XMV, class YMV, class SizeType>
 void
-MV_V_Dot_Invoke (const RV& r, const XMV& X, const YMV& Y, const SizeType numRows)
+MV_V_Dot_Invoke (const typename XMV::execution_space& space,
+                 const RV& r, const XMV& X, const YMV& Y, const SizeType numRows)
 {
-  MV_V_Dot_Invoke_Impl<RV, XMV, YMV, SizeType>::run (r, X, Y, numRows);
+  MV_V_Dot_Invoke_Impl<RV, XMV, YMV, SizeType>::run (space, r, X, Y, numRows);
 }
 
 //! Special case where XMV and YMV both have rank 2.
 template<class RV, class XMV, class YMV, class SizeType>
 void
-MV_Dot_Invoke (const RV& r, const XMV& X, const YMV& Y)
+MV_Dot_Invoke (const typename XMV::execution_space& space,
+               const RV& r, const XMV& X, const YMV& Y)
 {
   const SizeType numRows = static_cast<SizeType> (X.extent(0));
   const SizeType numCols = static_cast<SizeType> (X.extent(1));
-  Kokkos::RangePolicy<typename XMV::execution_space, SizeType> policy (0, numRows);
+  Kokkos::RangePolicy<typename XMV::execution_space, SizeType> policy (space, 0, numRows);
 
   if (static_cast<int> (X.extent(1)) != 1 && static_cast<int> (Y.extent(1)) == 1) {
     // X has > 1 columns, and Y has 1 column.
     auto Y_0 = Kokkos::subview (Y, Kokkos::ALL (), 0);
     typedef typename decltype (Y_0)::const_type YV;
-    MV_V_Dot_Invoke<RV, XMV, YV, SizeType> (r, X, Y_0, numRows);
+    MV_V_Dot_Invoke<RV, XMV, YV, SizeType> (space, r, X, Y_0, numRows);
     return;
   }
   else if (static_cast<int> (X.extent(1)) == 1 && static_cast<int> (Y.extent(1)) != 1) {
     // X has 1 column, and Y has > 1 columns.
     auto X_0 = Kokkos::subview (X, Kokkos::ALL (), 0);
     typedef typename decltype (X_0)::const_type XV;
-    MV_V_Dot_Invoke<RV, XV, YMV, SizeType> (r, X_0, Y, numRows);
+    MV_V_Dot_Invoke<RV, XV, YMV, SizeType> (space, r, X_0, Y, numRows);
     return;
   }
 
 #if KOKKOSBLAS_OPTIMIZATION_LEVEL_DOT <= 2
 
+  // The tuning table may have found one launch over all columns to be
+  // faster than strip-mining for this size.
+  if (numCols > 1) {
+    const int kernel = std::is_same<typename XMV::array_layout, Kokkos::LayoutLeft>::value ?
+      Blas1Tuned_Dot_MV_Left : Blas1Tuned_Dot_MV_Right;
+    if (blas1_tuned_variant<typename XMV::execution_space> (kernel, numRows, numCols) ==
+        Blas1Variant_Generic) {
+      MV_Dot_Right_FunctorVector<RV, XMV, YMV, SizeType> op (r, X, Y);
+      Kokkos::parallel_reduce (policy, op, r);
+      return;
+    }
+  }
+
   // Strip-mine by 8, then 4.  After that, do one column at a time.
   // We limit the number of strip-mine values in order to keep down
   // the amount of code to compile.
@@ -635,9 +654,10 @@ struct Dot_MV<RV, XMV, YMV, SizeType, 2, 2>
   /// \brief Compute the dot product(s) of the column(s) of the
   ///   multivectors (2-D views) X and Y, and store result(s) in the
   ///   1-D View r.
-  static void dot (const RV& r, const XMV& X, const YMV& Y)
+  static void dot (const typename XMV::execution_space& space,
+                   const RV& r, const XMV& X, const YMV& Y)
   {
-      MV_Dot_Invoke<RV, XMV, YMV, SizeType> (r, X, Y);
+      MV_Dot_Invoke<RV, XMV, YMV, SizeType> (space, r, X, Y);
   }
 };
 
@@ -647,9 +667,10 @@ template<class RV, class XMV, class YV, class SizeType>
 struct Dot_MV<RV, XMV, YV, SizeType, 2, 1> {
   /// \brief Compute the dot product(s) of each column of X with the
   ///   single vector Y, and store result(s) in the 1-D View r.
-  static void dot (const RV& r, const XMV& X, const YV& Y)
+  static void dot (const typename XMV::execution_space& space,
+                   const RV& r, const XMV& X, const YV& Y)
   {
-    MV_V_Dot_Invoke<RV, XMV, YV, SizeType> (r, X, Y, static_cast<int> (X.extent(0)));
+    MV_V_Dot_Invoke<RV, XMV, YV, SizeType> (space, r, X, Y, static_cast<int> (X.extent(0)));
   }
 };
 
@@ -659,10 +680,11 @@ template<class RV, class XV, class YMV, class SizeType>
 struct Dot_MV<RV, XV, YMV, SizeType, 1, 2> {
   /// \brief Compute the dot product(s) of the single vector X with
   ///   each column of Y, and store result(s) in the 1-D View r.
-  static void dot (const RV& r, const XV& X, const YMV& Y)
+  static void dot (const typename XV::execution_space& space,
+                   const RV& r, const XV& X, const YMV& Y)
   {
     const SizeType numRows = X.extent(0);
-    MV_V_Dot_Invoke<RV, XV, YMV, SizeType> (r, X, Y, numRows);
+    MV_V_Dot_Invoke<RV, XV, YMV, SizeType> (space, r, X, Y, numRows);
   }
 };
 
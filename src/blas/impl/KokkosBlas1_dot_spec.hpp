@@ -45,11 +45,13 @@
 
 #include <KokkosKernels_config.h>
 #include <Kokkos_Core.hpp>
+#include <KokkosKernels_Macros.hpp>
 #include <Kokkos_ArithTraits.hpp>
 #include <Kokkos_InnerProductSpaceTraits.hpp>
+#include <KokkosKernels_helpers.hpp>
 
 // Include the actual functors
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY 
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(DOT)
 #include <KokkosBlas1_dot_impl.hpp>
 #include <KokkosBlas1_dot_mv_impl.hpp>
 #endif
@@ -135,10 +137,28 @@ struct dot_eti_spec_avail {
         1,2> { enum : bool { value = true }; };
 
 
+//
+// Macro for declaration of full specialization availability
+// KokkosBlas::Impl::Dot for rank == 1, with X and Y of different value
+// types, e.g., float and double (mixed precision).  The result has the
+// wider type.  This is NOT for users!!!
+//
+#define KOKKOSBLAS1_DOT_MIXED_ETI_SPEC_AVAIL( XSCALAR, YSCALAR, LAYOUT, EXEC_SPACE, MEM_SPACE ) \
+    template<> \
+    struct dot_eti_spec_avail< \
+        Kokkos::View<KokkosKernels::Impl::GetMixedScalarType<XSCALAR, YSCALAR>::type, LAYOUT, Kokkos::HostSpace, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const XSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1,1> { enum : bool { value = true }; };
+
 // Include the actual specialization declarations
 #include<KokkosBlas1_dot_tpl_spec_avail.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_dot_eti_spec_avail.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_dot_mv_eti_spec_avail.hpp>
+#include<generated_specializations_hpp/KokkosBlas1_dot_mixed_eti_spec_avail.hpp>
 
 namespace KokkosBlas {
 namespace Impl {
@@ -146,19 +166,21 @@ namespace Impl {
 // Unification layer
 template<class RV, class XV, class YV, int XV_Rank = XV::rank, int YV_Rank = YV::rank,
          bool tpl_spec_avail = dot_tpl_spec_avail<RV,XV,YV>::value,
-         bool eti_spec_avail = dot_eti_spec_avail<RV,XV,YV>::value>
+         bool eti_spec_avail = dot_eti_spec_avail<RV,XV,YV>::value && !KOKKOSKERNELS_BLAS1_INLINE(DOT)>
 struct Dot {
-  static void dot (const RV&, const XV& R, const YV& X);
+  static void dot (const typename XV::execution_space& space,
+                   const RV&, const XV& R, const YV& X);
 };
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(DOT)
 //! Full specialization of Dot for single vectors (1-D Views).
 template<class RV, class XV, class YV>
 struct Dot<RV, XV, YV, 1, 1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
 {
   typedef typename YV::size_type size_type;
 
-  static void dot (const RV& R, const XV& X, const YV& Y)
+  static void dot (const typename XV::execution_space& space,
+                   const RV& R, const XV& X, const YV& Y)
   {
     static_assert (Kokkos::Impl::is_view<RV>::value, "KokkosBlas::Impl::"
                    "Dot<1-D>: RV is not a Kokkos::View.");
@@ -189,12 +211,12 @@ struct Dot<RV, XV, YV, 1, 1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
     if (numElems < static_cast<size_type> (INT_MAX)) {
       typedef int index_type;
       DotFunctor<RV,XV,YV,index_type> f(X,Y);
-      f.run("KokkosBlas::dot<1D>",R);
+      f.run("KokkosBlas::dot<1D>",space,R);
     }
     else {
       typedef int64_t index_type;
       DotFunctor<RV,XV,YV,index_type> f(X,Y);
-      f.run("KokkosBlas::dot<1D>",R);
+      f.run("KokkosBlas::dot<1D>",space,R);
     }
   }
 };
@@ -203,7 +225,8 @@ template<class RV,class XV, class YV, int X_Rank, int Y_Rank>
 struct Dot<RV, XV, YV, X_Rank, Y_Rank, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY> {
   typedef typename YV::size_type size_type;
 
-  static void dot (const RV& R, const XV& X, const YV& Y)
+  static void dot (const typename XV::execution_space& space,
+                   const RV& R, const XV& X, const YV& Y)
   {
     static_assert (Kokkos::Impl::is_view<XV>::value, "KokkosBlas::Impl::"
                    "Dot<2-D>: XV is not a Kokkos::View.");
@@ -225,11 +248,11 @@ struct Dot<RV, XV, YV, X_Rank, Y_Rank, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
     if (numRows < static_cast<size_type> (INT_MAX) &&
         numRows * numCols < static_cast<size_type> (INT_MAX)) {
       typedef int index_type;
-      Dot_MV<RV,XV,YV,index_type>::dot(R,X,Y);
+      Dot_MV<RV,XV,YV,index_type>::dot(space,R,X,Y);
     }
     else {
       typedef std::int64_t index_type;
-      Dot_MV<RV,XV,YV,index_type>::dot(R,X,Y);
+      Dot_MV<RV,XV,YV,index_type>::dot(space,R,X,Y);
     }
   }
 };
@@ -351,8 +374,34 @@ template struct Dot< \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         1,2,false,true>;
 
+//
+// Macros for declaration and definition of full specializations of
+// KokkosBlas::Impl::Dot for rank == 1 and mixed precision.  This is
+// NOT for users!!!
+//
+#define KOKKOSBLAS1_DOT_MIXED_ETI_SPEC_DECL( XSCALAR, YSCALAR, LAYOUT, EXEC_SPACE, MEM_SPACE ) \
+extern template struct Dot< \
+        Kokkos::View<KokkosKernels::Impl::GetMixedScalarType<XSCALAR, YSCALAR>::type, LAYOUT, Kokkos::HostSpace, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const XSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1,1,false,true>;
+
+#define KOKKOSBLAS1_DOT_MIXED_ETI_SPEC_INST( XSCALAR, YSCALAR, LAYOUT, EXEC_SPACE, MEM_SPACE ) \
+template struct Dot< \
+        Kokkos::View<KokkosKernels::Impl::GetMixedScalarType<XSCALAR, YSCALAR>::type, LAYOUT, Kokkos::HostSpace, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const XSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1,1,false,true>;
+
 #include<KokkosBlas1_dot_tpl_spec_decl.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_dot_eti_spec_decl.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_dot_mv_eti_spec_decl.hpp>
+#include<generated_specializations_hpp/KokkosBlas1_dot_mixed_eti_spec_decl.hpp>
 
 #endif // KOKKOS_BLAS1_MV_IMPL_DOT_HPP_
@@ -0,0 +1,160 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSBLAS1_ENSEMBLE_IMPL_HPP_
+#define KOKKOSBLAS1_ENSEMBLE_IMPL_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosBatched_Vector.hpp"
+
+namespace KokkosBlas {
+namespace Experimental {
+namespace Impl {
+
+// The ensemble reductions accumulate one partial sum per ensemble member
+// in an array reduction of length l, so that the joins only need the
+// member scalar type and not a volatile SIMD vector.
+template<class XV, class YV>
+struct Ensemble_Dot_Functor {
+  typedef typename XV::execution_space                  execution_space;
+  typedef typename XV::size_type                        size_type;
+  typedef typename XV::non_const_value_type             ensemble_type;
+  typedef typename ensemble_type::value_type            lane_type;
+  typedef Kokkos::Details::ArithTraits<lane_type>       ATL;
+  typedef lane_type                                     value_type[];
+
+  const unsigned value_count;
+  XV m_x;
+  YV m_y;
+
+  Ensemble_Dot_Functor (const XV& x, const YV& y) :
+    value_count (ensemble_type::vector_length), m_x (x), m_y (y) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& i, value_type sum) const
+  {
+    const ensemble_type x = m_x(i);
+    const ensemble_type y = m_y(i);
+    for (unsigned k = 0; k < value_count; ++k) {
+      sum[k] += ATL::conj (x[k]) * y[k];
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init (value_type sum) const
+  {
+    for (unsigned k = 0; k < value_count; ++k) sum[k] = ATL::zero ();
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join (volatile value_type dst, const volatile value_type src) const
+  {
+    for (unsigned k = 0; k < value_count; ++k) dst[k] += src[k];
+  }
+};
+
+template<class XV>
+struct Ensemble_Nrm2Squared_Functor {
+  typedef typename XV::execution_space                  execution_space;
+  typedef typename XV::size_type                        size_type;
+  typedef typename XV::non_const_value_type             ensemble_type;
+  typedef typename ensemble_type::value_type            lane_type;
+  typedef Kokkos::Details::ArithTraits<lane_type>       ATL;
+  typedef typename ATL::mag_type                        mag_type;
+  typedef mag_type                                      value_type[];
+
+  const unsigned value_count;
+  XV m_x;
+
+  Ensemble_Nrm2Squared_Functor (const XV& x) :
+    value_count (ensemble_type::vector_length), m_x (x) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& i, value_type sum) const
+  {
+    const ensemble_type x = m_x(i);
+    for (unsigned k = 0; k < value_count; ++k) {
+      const mag_type t = ATL::abs (x[k]);
+      sum[k] += t * t;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init (value_type sum) const
+  {
+    for (unsigned k = 0; k < value_count; ++k) sum[k] = Kokkos::Details::ArithTraits<mag_type>::zero ();
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join (volatile value_type dst, const volatile value_type src) const
+  {
+    for (unsigned k = 0; k < value_count; ++k) dst[k] += src[k];
+  }
+};
+
+template<class XV, class YV>
+struct Ensemble_Axpby_Functor {
+  typedef typename YV::size_type                        size_type;
+  typedef typename YV::non_const_value_type             ensemble_type;
+
+  const ensemble_type a;
+  XV m_x;
+  const ensemble_type b;
+  YV m_y;
+
+  Ensemble_Axpby_Functor (const ensemble_type& a_, const XV& x,
+                          const ensemble_type& b_, const YV& y) :
+    a (a_), m_x (x), b (b_), m_y (y) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& i) const
+  {
+    m_y(i) = a * m_x(i) + b * m_y(i);
+  }
+};
+
+} // namespace Impl
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_ENSEMBLE_IMPL_HPP_
@@ -0,0 +1,231 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSBLAS1_FUSED_IMPL_HPP_
+#define KOKKOSBLAS1_FUSED_IMPL_HPP_
+
+#include <KokkosKernels_config.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include <Kokkos_InnerProductSpaceTraits.hpp>
+
+namespace KokkosBlas {
+namespace Experimental {
+namespace Impl {
+
+// Each functor below writes its updated vectors and reduces over the
+// entries it has just written, so that the reduction does not sweep
+// over memory again.  An updated entry is stored before the vectors of
+// the reduction are read, so that those may alias the updated vector
+// (e.g. w == y in axpby_dot yields dot(y, y) of the new y).  As in
+// axpby and update, a vector whose coefficient is zero is not read.
+
+/// \brief y := a*x + b*y and dot(w, y), for single vectors.
+template<class AV, class XV, class BV, class YV, class WV, class SizeType = typename YV::size_type>
+struct V_Axpby_Dot_Functor
+{
+  typedef typename YV::execution_space                 execution_space;
+  typedef SizeType                                     size_type;
+  typedef typename YV::non_const_value_type            y_value_type;
+  typedef Kokkos::Details::InnerProductSpaceTraits<typename WV::non_const_value_type> IPT;
+  typedef typename IPT::dot_type                       value_type;
+
+  AV m_a;
+  typename XV::const_type m_x;
+  BV m_b;
+  YV m_y;
+  typename WV::const_type m_w;
+  bool m_read_y;
+
+  V_Axpby_Dot_Functor (const AV& a, const XV& x, const BV& b, const YV& y, const WV& w) :
+    m_a (a), m_x (x), m_b (b), m_y (y), m_w (w),
+    m_read_y (b != Kokkos::Details::ArithTraits<BV>::zero ())
+  {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& i, value_type& sum) const
+  {
+    const y_value_type y_i = m_read_y ?
+      static_cast<y_value_type> (m_a*m_x(i) + m_b*m_y(i)) :
+      static_cast<y_value_type> (m_a*m_x(i));
+    m_y(i) = y_i;
+    sum += IPT::dot (m_w(i), m_y(i));
+  }
+};
+
+/// \brief y := a*x + b*y, v := c*u + d*v and dot(w, v), for single
+///   vectors; e.g. the updates of the solution and of the residual
+///   and the residual norm of a CG iteration.
+template<class AV, class XV, class BV, class YV,
+         class CV, class UV, class DV, class VV,
+         class WV, class SizeType = typename VV::size_type>
+struct V_Axpby2_Dot_Functor
+{
+  typedef typename VV::execution_space                 execution_space;
+  typedef SizeType                                     size_type;
+  typedef typename YV::non_const_value_type            y_value_type;
+  typedef typename VV::non_const_value_type            v_value_type;
+  typedef Kokkos::Details::InnerProductSpaceTraits<typename WV::non_const_value_type> IPT;
+  typedef typename IPT::dot_type                       value_type;
+
+  AV m_a;
+  typename XV::const_type m_x;
+  BV m_b;
+  YV m_y;
+  CV m_c;
+  typename UV::const_type m_u;
+  DV m_d;
+  VV m_v;
+  typename WV::const_type m_w;
+  bool m_read_y, m_read_v;
+
+  V_Axpby2_Dot_Functor (const AV& a, const XV& x, const BV& b, const YV& y,
+                        const CV& c, const UV& u, const DV& d, const VV& v,
+                        const WV& w) :
+    m_a (a), m_x (x), m_b (b), m_y (y),
+    m_c (c), m_u (u), m_d (d), m_v (v), m_w (w),
+    m_read_y (b != Kokkos::Details::ArithTraits<BV>::zero ()),
+    m_read_v (d != Kokkos::Details::ArithTraits<DV>::zero ())
+  {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& i, value_type& sum) const
+  {
+    const y_value_type y_i = m_read_y ?
+      static_cast<y_value_type> (m_a*m_x(i) + m_b*m_y(i)) :
+      static_cast<y_value_type> (m_a*m_x(i));
+    m_y(i) = y_i;
+    const v_value_type v_i = m_read_v ?
+      static_cast<v_value_type> (m_c*m_u(i) + m_d*m_v(i)) :
+      static_cast<v_value_type> (m_c*m_u(i));
+    m_v(i) = v_i;
+    sum += IPT::dot (m_w(i), m_v(i));
+  }
+};
+
+/// \brief z := gamma*z + alpha*x + beta*y and the squared 2-norm of z,
+///   for single vectors.
+template<class AV, class XV, class BV, class YV, class GV, class ZV, class SizeType = typename ZV::size_type>
+struct V_Update_Nrm2_Functor
+{
+  typedef typename ZV::execution_space                 execution_space;
+  typedef SizeType                                     size_type;
+  typedef typename ZV::non_const_value_type            z_value_type;
+  typedef Kokkos::Details::InnerProductSpaceTraits<z_value_type> IPT;
+  typedef typename IPT::mag_type                       value_type;
+
+  AV m_alpha;
+  typename XV::const_type m_x;
+  BV m_beta;
+  typename YV::const_type m_y;
+  GV m_gamma;
+  ZV m_z;
+  bool m_read_z;
+
+  V_Update_Nrm2_Functor (const AV& alpha, const XV& x, const BV& beta, const YV& y,
+                         const GV& gamma, const ZV& z) :
+    m_alpha (alpha), m_x (x), m_beta (beta), m_y (y), m_gamma (gamma), m_z (z),
+    m_read_z (gamma != Kokkos::Details::ArithTraits<GV>::zero ())
+  {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& i, value_type& sum) const
+  {
+    const z_value_type z_i = m_read_z ?
+      static_cast<z_value_type> (m_gamma*m_z(i) + m_alpha*m_x(i) + m_beta*m_y(i)) :
+      static_cast<z_value_type> (m_alpha*m_x(i) + m_beta*m_y(i));
+    m_z(i) = z_i;
+    const value_type tmp = IPT::norm (z_i);
+    sum += tmp * tmp;
+  }
+};
+
+/// \brief dot(x, y) and dot(u, v) in one sweep, for single vectors;
+///   e.g. the (t,s) and (t,t) of the omega step of BiCGStab.
+template<class XV, class YV, class UV, class VV, class SizeType = typename YV::size_type>
+struct V_Dot2_Functor
+{
+  typedef typename YV::execution_space                 execution_space;
+  typedef SizeType                                     size_type;
+  typedef Kokkos::Details::InnerProductSpaceTraits<typename XV::non_const_value_type> IPT;
+  typedef typename IPT::dot_type                       dot_type;
+  typedef dot_type                                     value_type[];
+  size_type value_count;
+
+  typename XV::const_type m_x;
+  typename YV::const_type m_y;
+  typename UV::const_type m_u;
+  typename VV::const_type m_v;
+
+  V_Dot2_Functor (const XV& x, const YV& y, const UV& u, const VV& v) :
+    value_count (2), m_x (x), m_y (y), m_u (u), m_v (v)
+  {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& i, value_type sum) const
+  {
+    sum[0] += IPT::dot (m_x(i), m_y(i));
+    sum[1] += IPT::dot (m_u(i), m_v(i));
+  }
+
+  KOKKOS_INLINE_FUNCTION void
+  init (value_type update) const
+  {
+    update[0] = Kokkos::Details::ArithTraits<dot_type>::zero ();
+    update[1] = Kokkos::Details::ArithTraits<dot_type>::zero ();
+  }
+
+  KOKKOS_INLINE_FUNCTION void
+  join (volatile value_type update,
+        const volatile value_type source) const
+  {
+    update[0] += source[0];
+    update[1] += source[1];
+  }
+};
+
+} // namespace Impl
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_FUSED_IMPL_HPP_
@@ -45,9 +45,10 @@
 
 #include "KokkosKernels_config.h"
 #include "Kokkos_Core.hpp"
+#include "KokkosKernels_Macros.hpp"
 #include "Kokkos_InnerProductSpaceTraits.hpp"
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(MULT)
 #include<KokkosBlas1_mult_impl.hpp>
 #endif
 
@@ -128,14 +129,14 @@ namespace Impl {
 /// with special cases for alpha, or gamma = 0.
 template<class YMV, class AV, class XMV, int rank = XMV::rank,
     bool tpl_spec_avail = mult_tpl_spec_avail<YMV,AV,XMV>::value,
-    bool eti_spec_avail = mult_eti_spec_avail<YMV,AV,XMV>::value>
+    bool eti_spec_avail = mult_eti_spec_avail<YMV,AV,XMV>::value && !KOKKOSKERNELS_BLAS1_INLINE(MULT)>
 struct Mult {
   static void
     mult (const typename YMV::non_const_value_type& gamma, const YMV& Y,
           const typename XMV::non_const_value_type& alpha, const AV& A, const XMV& X);
 };
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(MULT)
 // Partial specialization for YMV, AV, and XMV rank-2 Views.
 template<class YMV, class AV, class XMV>
 struct Mult<YMV, AV, XMV, 2, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
@@ -45,11 +45,12 @@
 
 #include <KokkosKernels_config.h>
 #include <Kokkos_Core.hpp>
+#include <KokkosKernels_Macros.hpp>
 #include <Kokkos_ArithTraits.hpp>
 #include <Kokkos_InnerProductSpaceTraits.hpp>
 
 // Include the actual functors
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY 
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(NRM2)
 #include <KokkosBlas1_nrm2_impl.hpp>
 #endif
 
@@ -77,6 +78,14 @@ struct nrm2_eti_spec_avail {
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1> { enum : bool { value = true }; }; \
+    template<> \
+    struct nrm2_eti_spec_avail< \
+        Kokkos::View<typename Kokkos::Details::InnerProductSpaceTraits<SCALAR>::mag_type, LAYOUT, \
+                     Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         1> { enum : bool { value = true }; };
 
 //
@@ -109,12 +118,12 @@ namespace Impl {
 // Unification layer
 template<class RMV, class XMV, int rank = XMV::rank,
          bool tpl_spec_avail = nrm2_tpl_spec_avail<RMV,XMV>::value,
-         bool eti_spec_avail = nrm2_eti_spec_avail<RMV,XMV>::value>
+         bool eti_spec_avail = nrm2_eti_spec_avail<RMV,XMV>::value && !KOKKOSKERNELS_BLAS1_INLINE(NRM2)>
 struct Nrm2 {
   static void nrm2 (const RMV& R, const XMV& X, const bool& take_sqrt);
 };
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(NRM2)
 //! Full specialization of Nrm2 for single vectors (1-D Views).
 template<class RMV, class XMV>
 struct Nrm2<RMV, XMV, 1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
@@ -206,6 +215,13 @@ extern template struct Nrm2< \
                       Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
          Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                       Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         1, false, true>; \
+extern template struct Nrm2< \
+         Kokkos::View<typename Kokkos::Details::InnerProductSpaceTraits<SCALAR>::mag_type, \
+                      LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
          1, false, true>;
 
 //
@@ -220,6 +236,13 @@ template struct Nrm2< \
                       Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
          Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                       Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         1, false, true>; \
+template struct Nrm2< \
+         Kokkos::View<typename Kokkos::Details::InnerProductSpaceTraits<SCALAR>::mag_type, \
+                      LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
          1, false, true>;
 
 //
@@ -45,10 +45,11 @@
 
 #include <KokkosKernels_config.h>
 #include <Kokkos_Core.hpp>
+#include <KokkosKernels_Macros.hpp>
 #include <Kokkos_ArithTraits.hpp>
 
 // Include the actual functors
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY 
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(NRM2W)
 #include <KokkosBlas1_nrm2w_impl.hpp>
 #endif
 
@@ -105,12 +106,12 @@ namespace Impl {
 // Unification layer
 template<class RMV, class XMV, int rank = XMV::rank,
          bool tpl_spec_avail = nrm2w_tpl_spec_avail<RMV,XMV>::value,
-         bool eti_spec_avail = nrm2w_eti_spec_avail<RMV,XMV>::value>
+         bool eti_spec_avail = nrm2w_eti_spec_avail<RMV,XMV>::value && !KOKKOSKERNELS_BLAS1_INLINE(NRM2W)>
 struct Nrm2w {
   static void nrm2w (const RMV& R, const XMV& X, const XMV& W, const bool& take_sqrt);
 };
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(NRM2W)
 //! Full specialization of Nrm2w for single vectors (1-D Views).
 template<class RMV, class XMV>
 struct Nrm2w<RMV, XMV, 1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
@@ -45,10 +45,11 @@
 
 #include <KokkosKernels_config.h>
 #include <Kokkos_Core.hpp>
+#include <KokkosKernels_Macros.hpp>
 #include <Kokkos_ArithTraits.hpp>
 
 // Include the actual functors
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY 
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(RECIPROCAL)
 #include <KokkosBlas1_reciprocal_impl.hpp>
 #endif
 
@@ -105,12 +106,12 @@ namespace Impl {
 // Unification layer
 template<class RMV, class XMV, int rank = RMV::rank,
          bool tpl_spec_avail = reciprocal_tpl_spec_avail<RMV,XMV>::value,
-         bool eti_spec_avail = reciprocal_eti_spec_avail<RMV,XMV>::value>
+         bool eti_spec_avail = reciprocal_eti_spec_avail<RMV,XMV>::value && !KOKKOSKERNELS_BLAS1_INLINE(RECIPROCAL)>
 struct Reciprocal {
   static void reciprocal (const RMV& R, const XMV& X);
 };
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(RECIPROCAL)
 //! Full specialization of Reciprocal for single vectors (1-D Views).
 template<class RMV, class XMV>
 struct Reciprocal<RMV, XMV, 1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
@@ -0,0 +1,171 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSBLAS1_REPRODUCIBLE_IMPL_HPP_
+#define KOKKOSBLAS1_REPRODUCIBLE_IMPL_HPP_
+
+#include <KokkosKernels_config.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include <Kokkos_InnerProductSpaceTraits.hpp>
+
+namespace KokkosBlas {
+namespace Experimental {
+namespace Impl {
+
+// Reproducible reductions use a fixed-order blocked summation.  The
+// terms are split into blocks of ReproducibleBlockSize consecutive
+// entries, each block is summed sequentially in index order by one work
+// item, and the block sums are reduced the same way, level by level,
+// until one value is left.  Neither the blocks nor the order within a
+// block depend on the number of threads or on the launch configuration,
+// so the result is the same bit for bit for a given n.
+enum { ReproducibleBlockSize = 512 };
+
+/// \brief Term i of dot(x, y).
+template<class XV, class YV>
+struct Reproducible_Dot_Terms {
+  typedef Kokkos::Details::InnerProductSpaceTraits<typename XV::non_const_value_type> IPT;
+  typedef typename IPT::dot_type value_type;
+
+  typename XV::const_type m_x;
+  typename YV::const_type m_y;
+
+  Reproducible_Dot_Terms (const XV& x, const YV& y) : m_x (x), m_y (y) {}
+
+  KOKKOS_INLINE_FUNCTION
+  value_type operator() (const size_t i) const { return IPT::dot (m_x(i), m_y(i)); }
+};
+
+/// \brief Term i of the squared 2-norm of x.
+template<class XV>
+struct Reproducible_Nrm2_Squared_Terms {
+  typedef Kokkos::Details::InnerProductSpaceTraits<typename XV::non_const_value_type> IPT;
+  typedef typename IPT::mag_type value_type;
+
+  typename XV::const_type m_x;
+
+  Reproducible_Nrm2_Squared_Terms (const XV& x) : m_x (x) {}
+
+  KOKKOS_INLINE_FUNCTION
+  value_type operator() (const size_t i) const {
+    const value_type tmp = IPT::norm (m_x(i));
+    return tmp * tmp;
+  }
+};
+
+/// \brief Term i of the sum of the entries of x; also used for the
+///   block sums of the previous level.
+template<class XV>
+struct Reproducible_Sum_Terms {
+  typedef typename XV::non_const_value_type value_type;
+
+  typename XV::const_type m_x;
+
+  Reproducible_Sum_Terms (const XV& x) : m_x (x) {}
+
+  KOKKOS_INLINE_FUNCTION
+  value_type operator() (const size_t i) const { return m_x(i); }
+};
+
+/// \brief P(b) = sum of the terms in block b, in index order.
+template<class Terms, class PV>
+struct Reproducible_Block_Sum_Functor {
+  typedef typename Terms::value_type value_type;
+
+  Terms m_terms;
+  PV m_P;
+  size_t m_n;
+
+  Reproducible_Block_Sum_Functor (const Terms& terms, const PV& P, const size_t n) :
+    m_terms (terms), m_P (P), m_n (n) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t b) const {
+    const size_t begin = b*ReproducibleBlockSize;
+    const size_t end = (begin + ReproducibleBlockSize) < m_n ? (begin + ReproducibleBlockSize) : m_n;
+    value_type sum = Kokkos::Details::ArithTraits<value_type>::zero ();
+    for (size_t i = begin; i < end; ++i)
+      sum += m_terms(i);
+    m_P(b) = sum;
+  }
+};
+
+/// \brief Fixed-order sum of terms(0), ..., terms(n-1).
+template<class ExecSpace, class Terms>
+typename Terms::value_type
+reproducible_reduce (const char label[], const Terms& terms, const size_t n)
+{
+  typedef typename Terms::value_type value_type;
+  typedef Kokkos::View<value_type*, ExecSpace> partial_view_type;
+
+  if (n == 0) return Kokkos::Details::ArithTraits<value_type>::zero ();
+
+  size_t nblocks = (n + ReproducibleBlockSize - 1)/ReproducibleBlockSize;
+  partial_view_type P (Kokkos::ViewAllocateWithoutInitializing ("KokkosBlas::reproducible::P"), nblocks);
+  Kokkos::parallel_for (label, Kokkos::RangePolicy<ExecSpace, size_t> (0, nblocks),
+                        Reproducible_Block_Sum_Functor<Terms, partial_view_type> (terms, P, n));
+
+  // Reduce the block sums level by level; each level is at most
+  // 1/ReproducibleBlockSize of the previous one.
+  while (nblocks > 1) {
+    const size_t nsums = nblocks;
+    nblocks = (nsums + ReproducibleBlockSize - 1)/ReproducibleBlockSize;
+    partial_view_type Q (Kokkos::ViewAllocateWithoutInitializing ("KokkosBlas::reproducible::P"), nblocks);
+    Kokkos::parallel_for (label, Kokkos::RangePolicy<ExecSpace, size_t> (0, nblocks),
+                          Reproducible_Block_Sum_Functor<Reproducible_Sum_Terms<partial_view_type>, partial_view_type>
+                          (Reproducible_Sum_Terms<partial_view_type> (P), Q, nsums));
+    P = Q;
+  }
+
+  value_type result;
+  Kokkos::View<value_type, Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::Unmanaged> > R (&result);
+  Kokkos::deep_copy (R, Kokkos::subview (P, 0));
+  return result;
+}
+
+} // namespace Impl
+} // namespace Experimental
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_REPRODUCIBLE_IMPL_HPP_
@@ -170,7 +170,8 @@ struct V_Scal_Functor<RV, typename XV::non_const_value_type,
 // read), or a scalar.
 template<class RV, class AV, class XV, class SizeType>
 void
-V_Scal_Generic (const RV& r, const AV& av, const XV& x,
+V_Scal_Generic (const typename RV::execution_space& space,
+                const RV& r, const AV& av, const XV& x,
                 const SizeType startingColumn, int a = 2)
 {
   static_assert (Kokkos::Impl::is_view<RV>::value,
@@ -184,7 +185,7 @@ V_Scal_Generic (const RV& r, const AV& av, const XV& x,
 
   typedef typename RV::execution_space execution_space;
   const SizeType numRows = x.extent(0);
-  Kokkos::RangePolicy<execution_space, SizeType> policy (0, numRows);
+  Kokkos::RangePolicy<execution_space, SizeType> policy (space, 0, numRows);
 
   if (a == 0) {
     V_Scal_Functor<RV, AV, XV, 0, SizeType> op (r, x, av, startingColumn);
@@ -45,10 +45,11 @@
 
 #include <KokkosKernels_config.h>
 #include <Kokkos_Core.hpp>
+#include <KokkosKernels_Macros.hpp>
 #include <Kokkos_ArithTraits.hpp>
 
 // Include the actual functors
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY 
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(SCAL)
 #include <KokkosBlas1_scal_impl.hpp>
 #include <KokkosBlas1_scal_mv_impl.hpp>
 #endif
@@ -76,6 +77,15 @@ struct scal_eti_spec_avail {
         Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         SCALAR, \
+        Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1> { enum : bool { value = true }; }; \
+    template<> \
+    struct scal_eti_spec_avail< \
+        Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const SCALAR*, Kokkos::LayoutLeft, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         1> { enum : bool { value = true }; };
@@ -119,12 +129,13 @@ namespace Impl {
 // Unification layer
 template<class RV, class AV, class XV, int XV_Rank = XV::rank,
          bool tpl_spec_avail = scal_tpl_spec_avail<RV,AV,XV>::value,
-         bool eti_spec_avail = scal_eti_spec_avail<RV,AV,XV>::value>
+         bool eti_spec_avail = scal_eti_spec_avail<RV,AV,XV>::value && !KOKKOSKERNELS_BLAS1_INLINE(SCAL)>
 struct Scal {
-  static void scal (const RV& R, const AV& A, const XV& X);
+  static void scal (const typename XV::execution_space& space,
+                    const RV& R, const AV& A, const XV& X);
 };
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(SCAL)
 //! Full specialization of Scal for single vectors (1-D Views).
 template<class RV, class XV>
 struct Scal<RV,  typename XV::non_const_value_type, XV, 1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
@@ -134,7 +145,8 @@ struct Scal<RV,  typename XV::non_const_value_type, XV, 1, false, KOKKOSKERNELS_
   typedef Kokkos::Details::ArithTraits<typename XV::non_const_value_type> ATA;
 
   static void
-  scal (const RV& R, const AV& alpha, const XV& X)
+  scal (const typename XV::execution_space& space,
+        const RV& R, const AV& alpha, const XV& X)
   {
     static_assert (Kokkos::Impl::is_view<RV>::value, "KokkosBlas::Impl::"
                    "Scal<1-D>: RV is not a Kokkos::View.");
@@ -167,11 +179,54 @@ struct Scal<RV,  typename XV::non_const_value_type, XV, 1, false, KOKKOSKERNELS_
 
     if (numRows < static_cast<size_type> (INT_MAX)) {
       typedef int index_type;
-      V_Scal_Generic<RV, AV, XV, index_type> (R, alpha, X, a);
+      V_Scal_Generic<RV, AV, XV, index_type> (space, R, alpha, X, a);
+    }
+    else {
+      typedef typename XV::size_type index_type;
+      V_Scal_Generic<RV, AV, XV, index_type> (space, R, alpha, X, a);
+    }
+  }
+};
+
+/// \brief Partial specialization of Scal for single vectors (1-D Views)
+///   and a 1-D View AV of length one.
+///
+/// Computes R(i) = av(0)*X(i), reading av(0) inside the kernel (see
+/// KokkosBlas::scal).
+template<class RV, class AT, class ... AP, class XV>
+struct Scal<RV, Kokkos::View<AT*, AP...>, XV, 1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
+{
+  typedef Kokkos::View<AT*, AP...> AV;
+  typedef typename XV::size_type size_type;
+
+  static void
+  scal (const typename XV::execution_space& space,
+        const RV& R, const AV& av, const XV& X)
+  {
+    static_assert (Kokkos::Impl::is_view<RV>::value, "KokkosBlas::Impl::"
+                   "Scal<1-D>: RV is not a Kokkos::View.");
+    static_assert (Kokkos::Impl::is_view<XV>::value, "KokkosBlas::Impl::"
+                   "Scal<1-D>: XV is not a Kokkos::View.");
+    static_assert (RV::rank == 1, "KokkosBlas::Impl::Scal<1-D>: "
+                   "RV is not rank 1.");
+    static_assert (XV::rank == 1, "KokkosBlas::Impl::Scal<1-D>: "
+                   "XV is not rank 1.");
+
+    #ifdef KOKKOSKERNELS_ENABLE_CHECK_SPECIALIZATION
+    if(KOKKOSKERNELS_IMPL_COMPILE_LIBRARY)
+      printf("KokkosBlas1::scal<1D> ETI specialization for < %s , %s , %s >\n",typeid(RV).name(),typeid(AV).name(),typeid(XV).name());
+    else
+      printf("KokkosBlas1::scal<1D> non-ETI specialization for < %s , %s , %s >\n",typeid(RV).name(),typeid(AV).name(),typeid(XV).name());
+    #endif
+
+    const size_type numRows = X.extent(0);
+    if (numRows < static_cast<size_type> (INT_MAX)) {
+      typedef int index_type;
+      V_Scal_Generic<RV, AV, XV, index_type> (space, R, av, X, 0, 2);
     }
     else {
       typedef typename XV::size_type index_type;
-      V_Scal_Generic<RV, AV, XV, index_type> (R, alpha, X, a);
+      V_Scal_Generic<RV, AV, XV, index_type> (space, R, av, X, 0, 2);
     }
   }
 };
@@ -188,7 +243,8 @@ struct Scal<RMV, AV, XMV, 2, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY> {
   typedef Kokkos::Details::ArithTraits<typename XMV::non_const_value_type> ATA;
 
   static void
-  scal (const RMV& R, const AV& av, const XMV& X)
+  scal (const typename XMV::execution_space& space,
+        const RMV& R, const AV& av, const XMV& X)
   {
     static_assert (Kokkos::Impl::is_view<RMV>::value, "KokkosBlas::Impl::"
                    "Scal<2-D>: RMV is not a Kokkos::View.");
@@ -216,11 +272,11 @@ struct Scal<RMV, AV, XMV, 2, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY> {
     if (numRows < static_cast<size_type> (INT_MAX) &&
         numRows * numCols < static_cast<size_type> (INT_MAX)) {
       typedef int index_type;
-      MV_Scal_Invoke_Left<RMV, AV, XMV, index_type> (R, av, X, a);
+      MV_Scal_Invoke_Left<RMV, AV, XMV, index_type> (space, R, av, X, a);
     }
     else {
       typedef typename XMV::size_type index_type;
-      MV_Scal_Invoke_Left<RMV, AV, XMV, index_type> (R, av, X, a);
+      MV_Scal_Invoke_Left<RMV, AV, XMV, index_type> (space, R, av, X, a);
     }
   }
 };
@@ -238,7 +294,8 @@ struct Scal<RMV, typename XMV::non_const_value_type, XMV, 2, false, KOKKOSKERNEL
   typedef Kokkos::Details::ArithTraits<typename XMV::non_const_value_type> ATA;
 
   static void
-  scal (const RMV& R, const AV& alpha, const XMV& X)
+  scal (const typename XMV::execution_space& space,
+        const RMV& R, const AV& alpha, const XMV& X)
   {
     static_assert (Kokkos::Impl::is_view<RMV>::value, "KokkosBlas::Impl::"
                    "Scal<2-D, AV=scalar>: RMV is not a Kokkos::View.");
@@ -274,12 +331,12 @@ struct Scal<RMV, typename XMV::non_const_value_type, XMV, 2, false, KOKKOSKERNEL
         numRows * numCols < static_cast<size_type> (INT_MAX)) {
       typedef int index_type;
       MV_Scal_Invoke_Left<RMV, typename XMV::non_const_value_type, XMV,
-        index_type> (R, alpha, X, a);
+        index_type> (space, R, alpha, X, a);
     }
     else {
       typedef typename XMV::size_type index_type;
       MV_Scal_Invoke_Left<RMV, typename XMV::non_const_value_type, XMV,
-        index_type> (R, alpha, X, a);
+        index_type> (space, R, alpha, X, a);
     }
   }
 };
@@ -300,6 +357,14 @@ extern template struct Scal< \
         Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         SCALAR, \
+        Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1,false,true>; \
+extern template struct Scal< \
+        Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const SCALAR*, Kokkos::LayoutLeft, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         1,false,true>;
@@ -309,6 +374,14 @@ template struct Scal< \
         Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         SCALAR, \
+        Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1,false,true>; \
+template struct Scal< \
+        Kokkos::View<SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const SCALAR*, Kokkos::LayoutLeft, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         Kokkos::View<const SCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
         1,false,true>;
@@ -45,11 +45,12 @@
 
 #include <KokkosKernels_config.h>
 #include <Kokkos_Core.hpp>
+#include <KokkosKernels_Macros.hpp>
 #include <Kokkos_ArithTraits.hpp>
 #include <Kokkos_InnerProductSpaceTraits.hpp>
 
 // Include the actual functors
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY 
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(SUM)
 #include <KokkosBlas1_sum_impl.hpp>
 #endif
 
@@ -109,12 +110,12 @@ namespace Impl {
 // Unification layer
 template<class RMV, class XMV, int rank = XMV::rank,
          bool tpl_spec_avail = sum_tpl_spec_avail<RMV,XMV>::value,
-         bool eti_spec_avail = sum_eti_spec_avail<RMV,XMV>::value>
+         bool eti_spec_avail = sum_eti_spec_avail<RMV,XMV>::value && !KOKKOSKERNELS_BLAS1_INLINE(SUM)>
 struct Sum {
   static void sum (const RMV& R, const XMV& X);
 };
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(SUM)
 //! Full specialization of Sum for single vectors (1-D Views).
 template<class RMV, class XMV>
 struct Sum<RMV, XMV, 1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
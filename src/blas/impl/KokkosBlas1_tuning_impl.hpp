@@ -0,0 +1,184 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSBLAS1_TUNING_IMPL_HPP_
+#define KOKKOSBLAS1_TUNING_IMPL_HPP_
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace KokkosBlas {
+namespace Impl {
+
+// Tuning table of the multivector BLAS1 kernels that can run either
+// strip-mined (several launches of Unroll functors over 8, 4 and then
+// single columns) or as one launch of the generic functor that loops
+// over all columns.  Which one is faster depends on the device, the
+// number of rows and the number of columns; the table records the
+// variant measured fastest per bucket (see
+// KokkosBlas::Experimental::calibrate_blas1) and the kernels look it up
+// on every call.  Buckets without an entry keep the default variant.
+//
+// The table is read at first use from the file named by the
+// environment variable KOKKOSKERNELS_BLAS1_TUNING_FILE, if set.  It is
+// not thread safe to change it while kernels are being launched.
+
+enum Blas1TunedKernel {
+  Blas1Tuned_Axpby_MV_Left = 0,
+  Blas1Tuned_Dot_MV_Left,
+  Blas1Tuned_Dot_MV_Right,
+  Blas1Tuned_NumKernels
+};
+
+enum Blas1Variant {
+  Blas1Variant_Default = 0,
+  Blas1Variant_Unrolled,
+  Blas1Variant_Generic
+};
+
+inline const char* blas1_tuned_kernel_name (const int kernel)
+{
+  static const char* names[Blas1Tuned_NumKernels] =
+    { "axpby_mv_left", "dot_mv_left", "dot_mv_right" };
+  return (kernel >= 0 && kernel < Blas1Tuned_NumKernels) ? names[kernel] : "unknown";
+}
+
+/// \brief floor(log2(numRows)), 0 for numRows <= 1.
+inline int blas1_tuning_rows_bucket (size_t numRows)
+{
+  int b = 0;
+  for ( ; numRows > 1; numRows >>= 1) ++b;
+  return b;
+}
+
+/// \brief numCols up to 16, 17 for anything wider.
+inline int blas1_tuning_cols_bucket (const size_t numCols)
+{
+  return numCols > 16 ? 17 : static_cast<int> (numCols);
+}
+
+class Blas1TuningTable {
+public:
+  // (kernel, execution space name, rows bucket, cols bucket)
+  typedef std::tuple<int, std::string, int, int> key_type;
+
+  bool empty () const { return m_table.empty (); }
+  void clear () { m_table.clear (); }
+
+  int get (const int kernel, const char* space, const size_t numRows, const size_t numCols) const {
+    if (m_table.empty ()) return Blas1Variant_Default;
+    const auto it = m_table.find (key (kernel, space, numRows, numCols));
+    return it == m_table.end () ? int (Blas1Variant_Default) : it->second;
+  }
+
+  void set (const int kernel, const char* space, const size_t numRows, const size_t numCols,
+            const int variant) {
+    if (variant == Blas1Variant_Default)
+      m_table.erase (key (kernel, space, numRows, numCols));
+    else
+      m_table[key (kernel, space, numRows, numCols)] = variant;
+  }
+
+  /// One entry per line: kernel space rows_bucket cols_bucket variant.
+  /// Entries are added to the table; returns false if the file cannot
+  /// be read or is malformed.
+  bool load (const std::string& filename) {
+    std::ifstream is (filename.c_str ());
+    if (! is) return false;
+    std::string name, space;
+    int rb, cb, variant;
+    while (is >> name >> space >> rb >> cb >> variant) {
+      int kernel = 0;
+      while (kernel < Blas1Tuned_NumKernels && name != blas1_tuned_kernel_name (kernel)) ++kernel;
+      if (kernel == Blas1Tuned_NumKernels ||
+          variant < Blas1Variant_Default || variant > Blas1Variant_Generic)
+        return false;
+      m_table[key_type (kernel, space, rb, cb)] = variant;
+    }
+    return is.eof ();
+  }
+
+  bool save (const std::string& filename) const {
+    std::ofstream os (filename.c_str ());
+    if (! os) return false;
+    for (const auto& entry : m_table)
+      os << blas1_tuned_kernel_name (std::get<0> (entry.first)) << " "
+         << std::get<1> (entry.first) << " "
+         << std::get<2> (entry.first) << " "
+         << std::get<3> (entry.first) << " "
+         << entry.second << "\n";
+    return bool (os);
+  }
+
+private:
+  static key_type key (const int kernel, const char* space, const size_t numRows, const size_t numCols) {
+    return key_type (kernel, std::string (space),
+                     blas1_tuning_rows_bucket (numRows), blas1_tuning_cols_bucket (numCols));
+  }
+
+  std::map<key_type, int> m_table;
+};
+
+inline Blas1TuningTable& blas1_tuning_table ()
+{
+  static Blas1TuningTable table = [] () {
+    Blas1TuningTable t;
+    const char* filename = std::getenv ("KOKKOSKERNELS_BLAS1_TUNING_FILE");
+    if (filename != nullptr) t.load (filename);
+    return t;
+  } ();
+  return table;
+}
+
+template<class ExecSpace>
+int blas1_tuned_variant (const int kernel, const size_t numRows, const size_t numCols)
+{
+  return blas1_tuning_table ().get (kernel, ExecSpace::name (), numRows, numCols);
+}
+
+} // namespace Impl
+} // namespace KokkosBlas
+
+#endif // KOKKOSBLAS1_TUNING_IMPL_HPP_
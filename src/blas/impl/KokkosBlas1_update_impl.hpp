@@ -46,6 +46,7 @@
 #include "KokkosKernels_config.h"
 #include "Kokkos_Core.hpp"
 #include "Kokkos_InnerProductSpaceTraits.hpp"
+#include "KokkosKernels_helpers.hpp"
 
 namespace KokkosBlas {
 namespace Impl {
@@ -245,17 +246,25 @@ struct V_Update_Functor
   typedef typename ZV::execution_space execution_space;
   typedef SizeType                            size_type;
   typedef Kokkos::Details::ArithTraits<typename ZV::non_const_value_type> ATS;
+  // If X or Y has a lower precision than Z, keep its coefficient in the
+  // precision of Z; the entries are converted inside the kernel.
+  typedef typename KokkosKernels::Impl::GetMixedScalarType<
+    typename XV::non_const_value_type,
+    typename ZV::non_const_value_type>::type alpha_type;
+  typedef typename KokkosKernels::Impl::GetMixedScalarType<
+    typename YV::non_const_value_type,
+    typename ZV::non_const_value_type>::type beta_type;
 
   const size_type numCols;
-  const typename XV::non_const_value_type alpha_;
+  const alpha_type alpha_;
   XV X_;
-  const typename YV::non_const_value_type beta_;
+  const beta_type beta_;
   YV Y_;
   const typename ZV::non_const_value_type gamma_;
   ZV Z_;
 
-  V_Update_Functor (const typename XV::non_const_value_type& alpha, const XV& X,
-                    const typename YV::non_const_value_type& beta, const YV& Y,
+  V_Update_Functor (const alpha_type& alpha, const XV& X,
+                    const beta_type& beta, const YV& Y,
                     const typename ZV::non_const_value_type& gamma, const ZV& Z) :
     numCols (X.extent(1)),
     alpha_ (alpha), X_ (X),
@@ -444,8 +453,12 @@ MV_Update_Generic (const typename XMV::non_const_value_type& alpha, const XMV& X
 // corresponding vector entry.
 template<class XV, class YV, class ZV, class SizeType>
 void
-V_Update_Generic (const typename XV::non_const_value_type& alpha, const XV& X,
-                  const typename YV::non_const_value_type& beta, const YV& Y,
+V_Update_Generic (const typename KokkosKernels::Impl::GetMixedScalarType<
+                    typename XV::non_const_value_type,
+                    typename ZV::non_const_value_type>::type& alpha, const XV& X,
+                  const typename KokkosKernels::Impl::GetMixedScalarType<
+                    typename YV::non_const_value_type,
+                    typename ZV::non_const_value_type>::type& beta, const YV& Y,
                   const typename ZV::non_const_value_type& gamma, const ZV& Z,
                   int a = 2, int b = 2, int c = 2)
 {
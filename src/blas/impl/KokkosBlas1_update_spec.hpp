@@ -45,9 +45,11 @@
 
 #include "KokkosKernels_config.h"
 #include "Kokkos_Core.hpp"
+#include "KokkosKernels_Macros.hpp"
 #include "Kokkos_InnerProductSpaceTraits.hpp"
+#include "KokkosKernels_helpers.hpp"
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(UPDATE)
 #include<KokkosBlas1_update_impl.hpp>
 #endif
 
@@ -98,10 +100,28 @@ struct update_eti_spec_avail {
          2> { enum : bool { value = true }; };
 
 
+//
+// Macro for declaration of full specialization availability
+// KokkosBlas::Impl::Update for rank == 1, with X of value type XSCALAR
+// and Y and Z of a different value type YSCALAR, e.g., float and
+// double (mixed precision).  This is NOT for users!!!
+//
+#define KOKKOSBLAS1_UPDATE_MIXED_ETI_SPEC_AVAIL( XSCALAR, YSCALAR, LAYOUT, EXEC_SPACE, MEM_SPACE ) \
+    template<> \
+    struct update_eti_spec_avail< \
+         Kokkos::View<const XSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         Kokkos::View<const YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         Kokkos::View<YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                      Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+         1> { enum : bool { value = true }; };
+
 // Include the actual specialization declarations
 #include<KokkosBlas1_update_tpl_spec_avail.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_update_eti_spec_avail.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_update_mv_eti_spec_avail.hpp>
+#include<generated_specializations_hpp/KokkosBlas1_update_mixed_eti_spec_avail.hpp>
 
 namespace KokkosBlas {
 namespace Impl {
@@ -120,15 +140,19 @@ namespace Impl {
 /// with special cases for alpha, beta, or gamma = 0.
 template<class XMV, class YMV, class ZMV, int rank = ZMV::rank,
     bool tpl_spec_avail = update_tpl_spec_avail<XMV,YMV,ZMV>::value,
-    bool eti_spec_avail = update_eti_spec_avail<XMV,YMV,ZMV>::value>
+    bool eti_spec_avail = update_eti_spec_avail<XMV,YMV,ZMV>::value && !KOKKOSKERNELS_BLAS1_INLINE(UPDATE)>
 struct Update {
   static void
-    update (const typename XMV::non_const_value_type& alpha, const XMV& X,
-            const typename YMV::non_const_value_type& beta, const YMV& Y,
+    update (const typename KokkosKernels::Impl::GetMixedScalarType<
+              typename XMV::non_const_value_type,
+              typename ZMV::non_const_value_type>::type& alpha, const XMV& X,
+            const typename KokkosKernels::Impl::GetMixedScalarType<
+              typename YMV::non_const_value_type,
+              typename ZMV::non_const_value_type>::type& beta, const YMV& Y,
             const typename ZMV::non_const_value_type& gamma, const ZMV& Z);
 };
 
-#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
+#if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY || KOKKOSKERNELS_BLAS1_INLINE(UPDATE)
 // Partial specialization for XMV, YMV, and ZMV rank-2 Views.
 template<class XMV, class YMV, class ZMV>
 struct Update<XMV, YMV, ZMV, 2, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
@@ -234,8 +258,12 @@ struct Update<XV, YV, ZV, 1, false, KOKKOSKERNELS_IMPL_COMPILE_LIBRARY>
   typedef Kokkos::Details::ArithTraits<typename ZV::non_const_value_type> ATC;
 
   static void
-  update (const typename XV::non_const_value_type& alpha, const XV& X,
-          const typename YV::non_const_value_type& beta, const YV& Y,
+  update (const typename KokkosKernels::Impl::GetMixedScalarType<
+            typename XV::non_const_value_type,
+            typename ZV::non_const_value_type>::type& alpha, const XV& X,
+          const typename KokkosKernels::Impl::GetMixedScalarType<
+            typename YV::non_const_value_type,
+            typename ZV::non_const_value_type>::type& beta, const YV& Y,
           const typename ZV::non_const_value_type& gamma, const ZV& Z)
   {
     // XV, YV, and ZV must be Kokkos::View specializations.
@@ -363,8 +391,34 @@ template struct Update< \
      2, false, true>;
 
 
+//
+// Macros for declaration and definition of full specializations of
+// KokkosBlas::Impl::Update for rank == 1 and mixed precision.  This is
+// NOT for users!!!
+//
+#define KOKKOSBLAS1_UPDATE_MIXED_ETI_SPEC_DECL( XSCALAR, YSCALAR, LAYOUT, EXEC_SPACE, MEM_SPACE ) \
+extern template struct Update< \
+        Kokkos::View<const XSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1, false, true>;
+
+#define KOKKOSBLAS1_UPDATE_MIXED_ETI_SPEC_INST( XSCALAR, YSCALAR, LAYOUT, EXEC_SPACE, MEM_SPACE ) \
+template struct Update< \
+        Kokkos::View<const XSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<const YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        Kokkos::View<YSCALAR*, LAYOUT, Kokkos::Device<EXEC_SPACE, MEM_SPACE>, \
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+        1, false, true>;
+
 #include<KokkosBlas1_update_tpl_spec_decl.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_update_eti_spec_decl.hpp>
 #include<generated_specializations_hpp/KokkosBlas1_update_mv_eti_spec_decl.hpp>
+#include<generated_specializations_hpp/KokkosBlas1_update_mixed_eti_spec_decl.hpp>
 
 #endif // KOKKOSBLAS1_UPDATE_SPEC_HPP_
@@ -479,6 +479,197 @@ singleLevelGemv (const char trans[],
   }
 }
 
+// Functor for the first pass of a two-level (team + vector) version of
+// transpose GEMV, for A with many more rows than columns, e.g., the
+// orthogonalization step of a block Krylov method.  Each team owns a
+// chunk of rowsPerTeam rows of A.  The threads of the team take the
+// columns of A and the vector lanes of a thread reduce over the rows
+// of the chunk, so consecutive lanes read consecutive entries of a
+// column.  The team's partial result for column j is written to
+// P(league_rank, j); TwoLevelTransposeGEMVFinal sums them into y.
+//
+// Unlike SingleLevelTransposeGEMV, each reduction value is a scalar,
+// so it does not need an array of length A.extent(1) per thread.
+template<class AViewType,
+         class XViewType,
+         class PartialViewType,
+         const bool conj,
+         class IndexType = typename AViewType::size_type>
+struct TwoLevelTransposeGEMV {
+  typedef typename PartialViewType::non_const_value_type partial_value_type;
+  typedef typename Kokkos::TeamPolicy<typename AViewType::execution_space>::member_type member_type;
+
+  TwoLevelTransposeGEMV (const IndexType rowsPerTeam,
+                         const AViewType& A,
+                         const XViewType& x,
+                         const PartialViewType& P) :
+    rowsPerTeam_ (rowsPerTeam), A_ (A), x_ (x), P_ (P)
+  {
+    static_assert (Kokkos::Impl::is_view<AViewType>::value,
+                   "AViewType must be a Kokkos::View.");
+    static_assert (Kokkos::Impl::is_view<XViewType>::value,
+                   "XViewType must be a Kokkos::View.");
+    static_assert (Kokkos::Impl::is_view<PartialViewType>::value,
+                   "PartialViewType must be a Kokkos::View.");
+    static_assert (static_cast<int> (AViewType::rank) == 2,
+                   "AViewType must have rank 2.");
+    static_assert (static_cast<int> (XViewType::rank) == 1,
+                   "XViewType must have rank 1.");
+    static_assert (static_cast<int> (PartialViewType::rank) == 2,
+                   "PartialViewType must have rank 2.");
+    static_assert (std::is_integral<IndexType>::value,
+                   "IndexType must be an integer.");
+  }
+
+public:
+  KOKKOS_INLINE_FUNCTION void
+  operator () (const member_type& team) const
+  {
+    using Kokkos::Details::ArithTraits;
+    typedef ArithTraits<typename AViewType::non_const_value_type> KAT;
+
+    const IndexType numRows = A_.extent(0);
+    const IndexType numCols = A_.extent(1);
+    const IndexType rowBeg = static_cast<IndexType> (team.league_rank ()) * rowsPerTeam_;
+    const IndexType rowCnt = (numRows - rowBeg) < rowsPerTeam_ ? (numRows - rowBeg) : rowsPerTeam_;
+
+    Kokkos::parallel_for (Kokkos::TeamThreadRange (team, numCols), [&] (const IndexType& j) {
+      partial_value_type sum = ArithTraits<partial_value_type>::zero ();
+      Kokkos::parallel_reduce (Kokkos::ThreadVectorRange (team, rowCnt),
+        [&] (const IndexType& k, partial_value_type& lsum) {
+          const IndexType i = rowBeg + k;
+          const auto A_ij = conj ? KAT::conj (A_(i,j)) : A_(i,j);
+          lsum += A_ij * x_(i);
+        }, sum);
+      Kokkos::single (Kokkos::PerThread (team), [&] () {
+        P_(team.league_rank (), j) = sum;
+      });
+    });
+  }
+
+private:
+  IndexType rowsPerTeam_;
+  typename AViewType::const_type A_;
+  typename XViewType::const_type x_;
+  PartialViewType P_;
+};
+
+// Functor for the second pass of the two-level transpose GEMV.  It sums
+// the per-team partial results in a fixed order, so the result does not
+// depend on the schedule, and applies alpha and beta.
+template<class PartialViewType,
+         class YViewType,
+         class AlphaCoeffType,
+         class IndexType = typename YViewType::size_type>
+struct TwoLevelTransposeGEMVFinal {
+  typedef typename YViewType::non_const_value_type y_value_type;
+  typedef typename YViewType::non_const_value_type BetaCoeffType;
+
+  TwoLevelTransposeGEMVFinal (const AlphaCoeffType& alpha,
+                              const PartialViewType& P,
+                              const BetaCoeffType& beta,
+                              const YViewType& y) :
+    alpha_ (alpha), P_ (P), beta_ (beta), y_ (y)
+  {}
+
+public:
+  KOKKOS_INLINE_FUNCTION void
+  operator () (const IndexType& j) const
+  {
+    using Kokkos::Details::ArithTraits;
+
+    const IndexType numTeams = P_.extent(0);
+    y_value_type sum = ArithTraits<y_value_type>::zero ();
+    for (IndexType t = 0; t < numTeams; ++t) {
+      sum += P_(t,j);
+    }
+    // Sum into initial y_ values; use beta as a pre-multiplier if nonzero.
+    const y_value_type y_j =
+      beta_ == ArithTraits<BetaCoeffType>::zero () ?
+      ArithTraits<y_value_type>::zero () :
+      beta_ * y_(j);
+    y_(j) = y_j + alpha_ * sum;
+  }
+
+private:
+  AlphaCoeffType alpha_;
+  typename PartialViewType::const_type P_;
+  BetaCoeffType beta_;
+  YViewType y_;
+};
+
+// Two-level parallel version of transpose GEMV.  The caller must make
+// sure that alpha is nonzero and that A has at least one row and one
+// column; singleLevelGemv covers the remaining cases.
+template<class AViewType,
+         class XViewType,
+         class YViewType,
+         class IndexType = typename AViewType::size_type>
+void
+twoLevelTransposeGemv (const char trans[],
+                       typename AViewType::const_value_type& alpha,
+                       const AViewType& A,
+                       const XViewType& x,
+                       typename YViewType::const_value_type& beta,
+                       const YViewType& y)
+{
+  static_assert (std::is_integral<IndexType>::value,
+                 "IndexType must be an integer");
+
+  typedef typename YViewType::non_const_value_type y_value_type;
+  typedef typename AViewType::execution_space execution_space;
+  typedef typename AViewType::non_const_value_type AlphaCoeffType;
+  typedef Kokkos::View<y_value_type**, Kokkos::LayoutRight,
+    typename AViewType::device_type> partial_view_type;
+
+  const char tr = trans[0];
+  const IndexType numRows = A.extent(0);
+  const IndexType numCols = A.extent(1);
+
+  // One thread per team and no vector lanes on CPUs; on GPUs, a warp
+  // of vector lanes reduces over the rows and the team's threads take
+  // different columns.
+  int teamSize = 1, vectorLength = 1;
+#if defined(KOKKOS_ENABLE_CUDA)
+  if (std::is_same<execution_space, Kokkos::Cuda>::value) {
+    vectorLength = 32;
+    teamSize = numCols < 8 ? static_cast<int> (numCols) : 8;
+  }
+#endif
+
+  // Make just enough teams to fill the device, but give each team at
+  // least minRowsPerTeam rows so that the partial results stay small.
+  const IndexType minRowsPerTeam = 256;
+  const int concurrency = execution_space::concurrency ();
+  const IndexType maxTeams =
+    concurrency > teamSize*vectorLength ? concurrency / (teamSize*vectorLength) : 1;
+  IndexType rowsPerTeam = (numRows + maxTeams - 1) / maxTeams;
+  if (rowsPerTeam < minRowsPerTeam) rowsPerTeam = minRowsPerTeam;
+  const IndexType numTeams = (numRows + rowsPerTeam - 1) / rowsPerTeam;
+
+  partial_view_type P (Kokkos::ViewAllocateWithoutInitializing ("KokkosBlas::gemv::partial"),
+                       numTeams, numCols);
+  Kokkos::TeamPolicy<execution_space> policy (numTeams, teamSize, vectorLength);
+  if (tr == 'C' || tr == 'c' || tr == 'H' || tr == 'h') {
+    typedef TwoLevelTransposeGEMV<AViewType, XViewType, partial_view_type,
+      true, IndexType> functor_type;
+    Kokkos::parallel_for ("KokkosBlas::gemv[TwoLevelTranspose]", policy,
+                          functor_type (rowsPerTeam, A, x, P));
+  }
+  else {
+    typedef TwoLevelTransposeGEMV<AViewType, XViewType, partial_view_type,
+      false, IndexType> functor_type;
+    Kokkos::parallel_for ("KokkosBlas::gemv[TwoLevelTranspose]", policy,
+                          functor_type (rowsPerTeam, A, x, P));
+  }
+
+  typedef TwoLevelTransposeGEMVFinal<partial_view_type, YViewType,
+    AlphaCoeffType, IndexType> final_functor_type;
+  Kokkos::parallel_for ("KokkosBlas::gemv[TwoLevelTransposeFinal]",
+                        Kokkos::RangePolicy<execution_space, IndexType> (0, numCols),
+                        final_functor_type (alpha, P, beta, y));
+}
+
 } // namespace Impl
 } // namespace KokkosBlas
 
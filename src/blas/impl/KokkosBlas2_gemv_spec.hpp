@@ -132,15 +132,31 @@ struct GEMV {
     const size_type numRows = A.extent(0);
     const size_type numCols = A.extent(1);
 
+    // A tall and skinny A in the transpose cases goes to the two-level
+    // kernel, whose reduction values are scalars rather than a vector
+    // of length numCols.
+    const bool useTwoLevel =
+      trans[0] != 'N' && trans[0] != 'n' &&
+      alpha != Kokkos::Details::ArithTraits<typename AViewType::non_const_value_type>::zero () &&
+      numCols > 0 && numCols <= 256 && numRows >= 16*numCols;
+
     // Prefer int as the index type, but use a larger type if needed.
     if (numRows < static_cast<size_type> (INT_MAX) &&
         numCols < static_cast<size_type> (INT_MAX)) {
-      singleLevelGemv<AViewType, XViewType, YViewType,int>
-         (trans, alpha, A, x, beta, y);
+      if (useTwoLevel)
+        twoLevelTransposeGemv<AViewType, XViewType, YViewType, int>
+          (trans, alpha, A, x, beta, y);
+      else
+        singleLevelGemv<AViewType, XViewType, YViewType, int>
+          (trans, alpha, A, x, beta, y);
     }
     else {
-      singleLevelGemv<AViewType, XViewType, YViewType, int64_t>
-         (trans, alpha, A, x, beta, y);
+      if (useTwoLevel)
+        twoLevelTransposeGemv<AViewType, XViewType, YViewType, int64_t>
+          (trans, alpha, A, x, beta, y);
+      else
+        singleLevelGemv<AViewType, XViewType, YViewType, int64_t>
+          (trans, alpha, A, x, beta, y);
     }
   }
   #else
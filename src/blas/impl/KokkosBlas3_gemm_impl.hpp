@@ -415,8 +415,48 @@ struct impl_gemm_label<2,2> {
 };
 
 
+// Choose tile sizes of C (blockA0 x blockB1) and of the inner dimension (blockA1) per architecture.
+// NumBuffers = 2 double buffers the A and B tiles in scratch: tile k+1 is loaded while tile k is
+// multiplied, which hides the global memory latency of the copy behind the block multiply.
+template<class ExecSpace, class ScalarA, class ScalarB, class ScalarC>
+struct impl_gemm_choose_block_sizes {
+  // On CPUs a team is a single thread; the packed A and B panels and the C tile are sized
+  // to stay in L2 cache (96KB for double) rather than in a small shared memory.
+  static constexpr int blockA0 = 64;
+  static constexpr int blockB1 = 64;
+  static constexpr int blockA1 = 64;
+  static constexpr int NumBuffers = 1;
+};
+
+#ifdef KOKKOS_ENABLE_CUDA
+template<class ScalarA, class ScalarB, class ScalarC>
+struct impl_gemm_choose_block_sizes<Kokkos::Cuda,ScalarA,ScalarB,ScalarC> {
+  // Two A and B tiles and one C tile must fit into 24KB of level 0 scratch
+  static constexpr int blockA0 = 24;
+  static constexpr int blockB1 = 64;
+  static constexpr int NumBuffers = 2;
+  static constexpr int blockA1 =
+    (NumBuffers*(sizeof(ScalarA)*blockA0*16 + sizeof(ScalarB)*16*blockB1) + sizeof(ScalarC)*blockA0*blockB1 < 24000) ? 16 :
+    (NumBuffers*(sizeof(ScalarA)*blockA0*8  + sizeof(ScalarB)*8*blockB1)  + sizeof(ScalarC)*blockA0*blockB1 < 24000) ? 8 :
+    (NumBuffers*(sizeof(ScalarA)*blockA0*4  + sizeof(ScalarB)*4*blockB1)  + sizeof(ScalarC)*blockA0*blockB1 < 24000) ? 4 : 16 ;
+};
+#endif
+
+#ifdef KOKKOS_ENABLE_ROCM
+template<class ScalarA, class ScalarB, class ScalarC>
+struct impl_gemm_choose_block_sizes<Kokkos::ROCm,ScalarA,ScalarB,ScalarC> {
+  static constexpr int blockA0 = 24;
+  static constexpr int blockB1 = 64;
+  static constexpr int NumBuffers = 1;
+  static constexpr int blockA1 =
+    (sizeof(ScalarA)*blockA0*16 + sizeof(ScalarB)*16*blockB1 + sizeof(ScalarC)*blockA0*blockB1 < 24000) ? 16 :
+    (sizeof(ScalarA)*blockA0*8  + sizeof(ScalarB)*8*blockB1  + sizeof(ScalarC)*blockA0*blockB1 < 24000) ? 8 :
+    (sizeof(ScalarA)*blockA0*4  + sizeof(ScalarB)*4*blockB1  + sizeof(ScalarC)*blockA0*blockB1 < 24000) ? 4 : 16 ;
+};
+#endif
+
 template<class ExecSpace, class ViewTypeA, class ViewTypeB, class ViewTypeC,
-          int blockA0, int blockA1, int blockB1, int TransposeA, int TransposeB>
+          int blockA0, int blockA1, int blockB1, int TransposeA, int TransposeB, int NumBuffers = 1>
 struct GEMMImpl {
   ViewTypeA A;
   ViewTypeB B;
@@ -444,18 +484,43 @@ struct GEMMImpl {
     beta = beta_;
   }
 
+  static int scratch_size() {
+    return
+      NumBuffers*ViewTypeAScratch::required_allocation_size() +
+      NumBuffers*ViewTypeBScratch::required_allocation_size() +
+      ViewTypeCScratch::required_allocation_size();
+  }
+
   void run(int team_size, int vector_length, int scr_level) {
     scratch_level = scr_level;
-    int scratch_memory_size =
-      ViewTypeAScratch::required_allocation_size() +
-      ViewTypeBScratch::required_allocation_size() +
-      ViewTypeCScratch::required_allocation_size();
+    int scratch_memory_size = scratch_size();
 
     Kokkos::TeamPolicy<ExecSpace,Kokkos::LaunchBounds<384,2>> policy(num_blocks_0*num_blocks_1,team_size,vector_length);
 
     Kokkos::parallel_for(impl_gemm_label<TransposeA,TransposeB>::label,policy.set_scratch_size(scratch_level,Kokkos::PerTeam(scratch_memory_size)),*this);
   }
 
+  KOKKOS_INLINE_FUNCTION
+  void load_blocks(const typename Kokkos::TeamPolicy<ExecSpace>::member_type& team,
+                   const ViewTypeAScratch& A_scr, const ViewTypeBScratch& B_scr,
+                   const int& i_offset, const int& j_offset, const int& A_j) const {
+    // Load A block into scratch
+    impl_deep_copy_matrix_block<typename Kokkos::TeamPolicy<ExecSpace>::member_type,
+                                ViewTypeAScratch,ViewTypeA,
+                                typename impl_gemm_choose_copy_layout<ExecSpace,
+                                   typename ViewTypeA::array_layout,
+                                   typename ViewTypeAScratch::array_layout>::type,
+                                blockA0,blockA1,TransposeA>::copy(team,A_scr,A,i_offset,A_j);
+
+    // Load B block into scratch
+    impl_deep_copy_matrix_block<typename Kokkos::TeamPolicy<ExecSpace>::member_type,
+                                ViewTypeBScratch,ViewTypeB,
+                                typename impl_gemm_choose_copy_layout<ExecSpace,
+                                   typename ViewTypeB::array_layout,
+                                   typename ViewTypeBScratch::array_layout>::type,
+                                blockA1,blockB1,TransposeB>::copy(team,B_scr,B,A_j,j_offset);
+  }
+
   KOKKOS_INLINE_FUNCTION
   void operator() (const typename Kokkos::TeamPolicy<ExecSpace>::member_type& team) const {
     // This team is responsible for computing a single block of C
@@ -464,8 +529,12 @@ struct GEMMImpl {
     const int i_offset = (league_rank/num_blocks)*blockA0;
     const int j_offset = (league_rank%num_blocks)*blockB1;
 
-    ViewTypeAScratch A_scr(team.team_scratch(scratch_level));
-    ViewTypeBScratch B_scr(team.team_scratch(scratch_level));
+    ViewTypeAScratch A_scr[NumBuffers];
+    ViewTypeBScratch B_scr[NumBuffers];
+    for(int buf = 0; buf < NumBuffers; buf++) {
+      A_scr[buf] = ViewTypeAScratch(team.team_scratch(scratch_level));
+      B_scr[buf] = ViewTypeBScratch(team.team_scratch(scratch_level));
+    }
     ViewTypeCScratch C_scr(team.team_scratch(scratch_level));
     Kokkos::parallel_for(Kokkos::TeamThreadRange(team,blockA0), [&] (const int i) {
       Kokkos::parallel_for(Kokkos::ThreadVectorRange(team,blockB1), [&] (const int j) {
@@ -476,32 +545,36 @@ struct GEMMImpl {
 
     // Move along the inner dimension in blocks
     const int length = TransposeA>0?A.extent_int(0):A.extent_int(1);
-    for(int A_j = 0; A_j < length; A_j += blockA1) {
-      // Load A block into scratch
-
-      impl_deep_copy_matrix_block<typename Kokkos::TeamPolicy<ExecSpace>::member_type,
-                                  ViewTypeAScratch,ViewTypeA,
-                                  typename impl_gemm_choose_copy_layout<ExecSpace,
-                                     typename ViewTypeA::array_layout,
-                                     typename ViewTypeAScratch::array_layout>::type,
-                                  blockA0,blockA1,TransposeA>::copy(team,A_scr,A,i_offset,A_j);
-
-      // Load B block into scratch
-      impl_deep_copy_matrix_block<typename Kokkos::TeamPolicy<ExecSpace>::member_type,
-                                  ViewTypeBScratch,ViewTypeB,
-                                  typename impl_gemm_choose_copy_layout<ExecSpace,
-                                     typename ViewTypeB::array_layout,
-                                     typename ViewTypeBScratch::array_layout>::type,
-                                  blockA1,blockB1,TransposeB>::copy(team,B_scr,B,A_j,j_offset);
-
-      // Wait for A and B block to be in scratch memory
+    if(NumBuffers > 1) {
+      // Load the first A and B block, then prefetch block k+1 while multiplying block k
+      if(length > 0)
+        load_blocks(team,A_scr[0],B_scr[0],i_offset,j_offset,0);
       team.team_barrier();
 
-      // Add contribution from multiplying the A and B block to the C block
-      impl_team_gemm_block(team,C_scr,A_scr,B_scr);
+      for(int A_j = 0, buf = 0; A_j < length; A_j += blockA1, buf = (buf+1)%NumBuffers) {
+        if(A_j + blockA1 < length)
+          load_blocks(team,A_scr[(buf+1)%NumBuffers],B_scr[(buf+1)%NumBuffers],i_offset,j_offset,A_j+blockA1);
 
-      // Wait for subblock computation to be done before loading the next A and B block
-      team.team_barrier();
+        // Add contribution from multiplying the A and B block to the C block
+        impl_team_gemm_block(team,C_scr,A_scr[buf],B_scr[buf]);
+
+        // Wait for the prefetch and the subblock computation before swapping buffers
+        team.team_barrier();
+      }
+    } else {
+      for(int A_j = 0; A_j < length; A_j += blockA1) {
+        // Load A and B block into scratch
+        load_blocks(team,A_scr[0],B_scr[0],i_offset,j_offset,A_j);
+
+        // Wait for A and B block to be in scratch memory
+        team.team_barrier();
+
+        // Add contribution from multiplying the A and B block to the C block
+        impl_team_gemm_block(team,C_scr,A_scr[0],B_scr[0]);
+
+        // Wait for subblock computation to be done before loading the next A and B block
+        team.team_barrier();
+      }
     }
     // Write back the C block from scratch to main memory
     impl_update_matrix_block<typename Kokkos::TeamPolicy<ExecSpace>::member_type,
@@ -511,6 +584,116 @@ struct GEMMImpl {
   }
 };
 
+// Tall and skinny C = alpha*op(A)*B + beta*C with op(A) = A^T or A^H, e.g., the inner products
+// X^T Y of two multivectors with many rows and a few columns. GEMMImpl would launch a handful
+// of teams for such a small C, each walking the whole inner dimension. Here each team instead
+// owns a chunk of rows of A and B: its threads take the entries of C and its vector lanes reduce
+// over the rows of the chunk. The per-team partial products are written to a workspace and then
+// summed in a fixed order by GEMMTallSkinnyFinal.
+template<class ExecSpace, class ViewTypeA, class ViewTypeB, class ViewTypeP, int TransposeA>
+struct GEMMTallSkinny {
+  typedef typename ViewTypeP::non_const_value_type ScalarP;
+  typedef typename Kokkos::TeamPolicy<ExecSpace>::member_type member_type;
+
+  ViewTypeA A;
+  ViewTypeB B;
+  ViewTypeP P;
+  int rows_per_team;
+
+  GEMMTallSkinny(const ViewTypeA& A_, const ViewTypeB& B_, const ViewTypeP& P_, const int rows_per_team_):
+    A(A_),B(B_),P(P_),rows_per_team(rows_per_team_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const member_type& team) const {
+    typedef Kokkos::Details::ArithTraits<typename ViewTypeA::non_const_value_type> ATA;
+    const int K = A.extent_int(0);
+    const int N = B.extent_int(1);
+    const int MN = A.extent_int(1)*N;
+    const int l_offset = team.league_rank()*rows_per_team;
+    const int length = (K-l_offset) < rows_per_team ? (K-l_offset) : rows_per_team;
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team,MN), [&] (const int ij) {
+      const int i = ij/N;
+      const int j = ij%N;
+      ScalarP sum = 0;
+      Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(team,length), [&] (const int k, ScalarP& lsum) {
+        const int l = l_offset + k;
+        lsum += (TransposeA==2?ATA::conj(A(l,i)):A(l,i))*B(l,j);
+      },sum);
+      Kokkos::single(Kokkos::PerThread(team), [&] () {
+        P(team.league_rank(),ij) = sum;
+      });
+    });
+  }
+};
+
+template<class ViewTypeC, class ViewTypeP>
+struct GEMMTallSkinnyFinal {
+  typedef typename ViewTypeC::non_const_value_type ScalarC;
+
+  ScalarC alpha, beta;
+  ViewTypeC C;
+  ViewTypeP P;
+
+  GEMMTallSkinnyFinal(const ScalarC& alpha_, const ViewTypeP& P_, const ScalarC& beta_, const ViewTypeC& C_):
+    alpha(alpha_),beta(beta_),C(C_),P(P_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int ij) const {
+    const int N = C.extent_int(1);
+    const int i = ij/N;
+    const int j = ij%N;
+    const int num_teams = P.extent_int(0);
+    ScalarC sum = 0;
+    for(int t = 0; t < num_teams; t++)
+      sum += P(t,ij);
+    // As in BLAS, C is not read when beta is zero
+    if(beta == Kokkos::Details::ArithTraits<ScalarC>::zero())
+      C(i,j) = alpha*sum;
+    else
+      C(i,j) = beta*C(i,j) + alpha*sum;
+  }
+};
+
+// C is small enough that a team can hold all of its entries and the inner dimension is long
+// enough to give every team a chunk of rows.
+inline bool impl_gemm_use_tall_skinny(const int M, const int N, const int K) {
+  return M > 0 && N > 0 && M*N <= 4096 && K >= 16*(M>N?M:N);
+}
+
+template<class ExecSpace, class ViewTypeA, class ViewTypeB, class ViewTypeC, int TransposeA>
+void impl_gemm_tall_skinny(const typename ViewTypeC::non_const_value_type& alpha, const ViewTypeA& A, const ViewTypeB& B,
+                           const typename ViewTypeC::non_const_value_type& beta, const ViewTypeC& C) {
+  typedef typename ViewTypeC::non_const_value_type ScalarC;
+  typedef Kokkos::View<ScalarC**,Kokkos::LayoutRight,typename ViewTypeC::device_type> ViewTypeP;
+
+  const int K = A.extent_int(0);
+  const int MN = C.extent_int(0)*C.extent_int(1);
+
+  // On CPUs a team is a single thread; on GPUs a warp of vector lanes reduces over the rows
+  int team_size = 1, vector_length = 1;
+  #if defined(KOKKOS_ENABLE_CUDA)
+  if(std::is_same<ExecSpace,Kokkos::Cuda>::value) {
+    vector_length = 32;
+    team_size = MN < 8 ? MN : 8;
+  }
+  #endif
+
+  // Just enough teams to fill the device, each with at least 256 rows
+  const int concurrency = ExecSpace::concurrency();
+  const int max_teams = concurrency > team_size*vector_length ? concurrency/(team_size*vector_length) : 1;
+  int rows_per_team = (K+max_teams-1)/max_teams;
+  if(rows_per_team < 256) rows_per_team = 256;
+  const int num_teams = (K+rows_per_team-1)/rows_per_team;
+
+  ViewTypeP P(Kokkos::ViewAllocateWithoutInitializing("KokkosBlas::gemm::partial"),num_teams,MN);
+  Kokkos::TeamPolicy<ExecSpace> policy(num_teams,team_size,vector_length);
+  Kokkos::parallel_for(TransposeA==2?"KokkosBlas::gemm[CN,TallSkinny]":"KokkosBlas::gemm[TN,TallSkinny]",policy,
+                       GEMMTallSkinny<ExecSpace,ViewTypeA,ViewTypeB,ViewTypeP,TransposeA>(A,B,P,rows_per_team));
+  Kokkos::parallel_for("KokkosBlas::gemm[TallSkinnyFinal]",Kokkos::RangePolicy<ExecSpace>(0,MN),
+                       GEMMTallSkinnyFinal<ViewTypeC,ViewTypeP>(alpha,P,beta,C));
+}
+
 }
 }
 #endif
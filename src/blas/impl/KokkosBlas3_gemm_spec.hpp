@@ -135,19 +135,16 @@ struct GEMM {
   typedef typename CViewType::non_const_value_type ScalarC;
 
   // Define Blocking sizes (this will be used for scratch spaces)
-  static constexpr int blockA0 = 24;
-  static constexpr int blockB1 = 64;
-  static constexpr int blockA1 = (sizeof(ScalarA)*blockA0*16 + sizeof(ScalarB)*16*blockB1 + sizeof(ScalarC)*blockA0*blockB1 < 24000) ? 16 :
-                                 (sizeof(ScalarA)*blockA0*8 + sizeof(ScalarB)*8*blockB1 + sizeof(ScalarC)*blockA0*blockB1 < 24000) ? 8 :
-                                 (sizeof(ScalarA)*blockA0*4 + sizeof(ScalarB)*4*blockB1 + sizeof(ScalarC)*blockA0*blockB1 < 24000) ? 4 : 16 ;
+  typedef KokkosBlas::Impl::impl_gemm_choose_block_sizes<typename CViewType::execution_space,ScalarA,ScalarB,ScalarC> block_sizes;
+  static constexpr int blockA0 = block_sizes::blockA0;
+  static constexpr int blockB1 = block_sizes::blockB1;
+  static constexpr int blockA1 = block_sizes::blockA1;
+  static constexpr int nbuffers = block_sizes::NumBuffers;
   static constexpr int vector_length = blockB1/4;
 
   // Compute scratch space size
-  typedef KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,0,0> gemm_dummy_type;
-  const int scratch_memory_size =
-        gemm_dummy_type::ViewTypeAScratch::required_allocation_size() +
-        gemm_dummy_type::ViewTypeBScratch::required_allocation_size() +
-        gemm_dummy_type::ViewTypeCScratch::required_allocation_size();
+  typedef KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,0,0,nbuffers> gemm_dummy_type;
+  const int scratch_memory_size = gemm_dummy_type::scratch_size();
   const int scratch_level = scratch_memory_size < 24000 ? 0 : 1;
 
   // Figure out Team Sizes
@@ -161,41 +158,52 @@ struct GEMM {
     team_size = blockA0;
   #endif
 
+  // Inner products of tall and skinny matrices, C = op(A)*B with a small C and a long inner dimension
+  if((transA[0]=='T' || transA[0]=='t' || transA[0]=='C' || transA[0]=='c') && (transB[0]=='N' || transB[0]=='n') &&
+     KokkosBlas::Impl::impl_gemm_use_tall_skinny(C.extent_int(0),C.extent_int(1),A.extent_int(0))) {
+    if(transA[0]=='T' || transA[0]=='t')
+      KokkosBlas::Impl::impl_gemm_tall_skinny<typename CViewType::execution_space,AViewType,BViewType,CViewType,1>(alpha,A,B,beta,C);
+    else
+      KokkosBlas::Impl::impl_gemm_tall_skinny<typename CViewType::execution_space,AViewType,BViewType,CViewType,2>(alpha,A,B,beta,C);
+    Kokkos::Profiling::popRegion();
+    return;
+  }
+
   // Call the correct kernel
   if((transA[0]=='N' || transA[0]=='n') && (transB[0]=='N' || transB[0]=='n')) {
-    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,0,0> gemm(alpha,A,B,beta,C);
+    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,0,0,nbuffers> gemm(alpha,A,B,beta,C);
     gemm.run(team_size,vector_length,scratch_level);
   }
   if((transA[0]=='T' || transA[0]=='t') && (transB[0]=='N' || transB[0]=='n')) {
-    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,1,0> gemm(alpha,A,B,beta,C);
+    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,1,0,nbuffers> gemm(alpha,A,B,beta,C);
     gemm.run(team_size,vector_length,scratch_level);
   }
   if((transA[0]=='C' || transA[0]=='c') && (transB[0]=='N' || transB[0]=='n')) {
-    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,2,0> gemm(alpha,A,B,beta,C);
+    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,2,0,nbuffers> gemm(alpha,A,B,beta,C);
     gemm.run(team_size,vector_length,scratch_level);
   }
   if((transA[0]=='N' || transA[0]=='n') && (transB[0]=='T' || transB[0]=='t')) {
-    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,0,1> gemm(alpha,A,B,beta,C);
+    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,0,1,nbuffers> gemm(alpha,A,B,beta,C);
     gemm.run(team_size,vector_length,scratch_level);
   }
   if((transA[0]=='T' || transA[0]=='t') && (transB[0]=='T' || transB[0]=='t')) {
-    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,1,1> gemm(alpha,A,B,beta,C);
+    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,1,1,nbuffers> gemm(alpha,A,B,beta,C);
     gemm.run(team_size,vector_length,scratch_level);
   }
   if((transA[0]=='C' || transA[0]=='c') && (transB[0]=='T' || transB[0]=='t')) {
-    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,2,1> gemm(alpha,A,B,beta,C);
+    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,2,1,nbuffers> gemm(alpha,A,B,beta,C);
     gemm.run(team_size,vector_length,scratch_level);
   }
   if((transA[0]=='N' || transA[0]=='n') && (transB[0]=='C' || transB[0]=='c')) {
-    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,0,2> gemm(alpha,A,B,beta,C);
+    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,0,2,nbuffers> gemm(alpha,A,B,beta,C);
     gemm.run(team_size,vector_length,scratch_level);
   }
   if((transA[0]=='T' || transA[0]=='t') && (transB[0]=='C' || transB[0]=='c')) {
-    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,1,2> gemm(alpha,A,B,beta,C);
+    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,1,2,nbuffers> gemm(alpha,A,B,beta,C);
     gemm.run(team_size,vector_length,scratch_level);
   }
   if((transA[0]=='C' || transA[0]=='c') && (transB[0]=='C' || transB[0]=='c')) {
-    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,2,2> gemm(alpha,A,B,beta,C);
+    KokkosBlas::Impl::GEMMImpl<typename CViewType::execution_space,AViewType,BViewType,CViewType,blockA0,blockA1,blockB1,2,2,nbuffers> gemm(alpha,A,B,beta,C);
     gemm.run(team_size,vector_length,scratch_level);
   }
   Kokkos::Profiling::popRegion();
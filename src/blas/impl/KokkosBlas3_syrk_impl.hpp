@@ -0,0 +1,209 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_BLAS3_SYRK_IMPL_HPP_
+#define KOKKOS_BLAS3_SYRK_IMPL_HPP_
+
+#include<Kokkos_Core.hpp>
+#include<KokkosBlas3_gemm.hpp>
+
+namespace KokkosBlas {
+namespace Impl {
+
+// Size of the diagonal blocks of C; the blocks below (lower) or right of
+// (upper) a diagonal block are computed with a single gemm.
+template<class ExecSpace>
+struct impl_syrk_choose_block_size {
+  static constexpr int value = 64;
+};
+
+#ifdef KOKKOS_ENABLE_CUDA
+template<>
+struct impl_syrk_choose_block_size<Kokkos::Cuda> {
+  static constexpr int value = 32;
+};
+#endif
+
+// C = beta*C on the referenced triangle; used when there is nothing to add
+template<class CViewType>
+struct SyrkScaleFunctor {
+  typedef typename CViewType::non_const_value_type ScalarC;
+  typedef Kokkos::Details::ArithTraits<ScalarC> ATC;
+
+  CViewType C;
+  ScalarC beta;
+  bool lower, herm;
+
+  SyrkScaleFunctor(const CViewType& C_, const ScalarC& beta_, const bool lower_, const bool herm_)
+    : C(C_), beta(beta_), lower(lower_), herm(herm_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int& i) const {
+    const int j0 = lower ? 0 : i;
+    const int j1 = lower ? i+1 : C.extent_int(1);
+    for(int j=j0; j<j1; j++) {
+      const ScalarC c = (beta == ATC::zero() ? ATC::zero() : beta*C(i,j));
+      C(i,j) = (herm && i == j) ? ScalarC(ATC::real(c)) : c;
+    }
+  }
+};
+
+// Triangle of the diagonal block C(j0:j1,j0:j1); one team per entry
+// reduces over the inner dimension k.
+template<class AViewType, class CViewType, class ExecSpace>
+struct SyrkDiagonalBlockFunctor {
+  typedef typename AViewType::non_const_value_type ScalarA;
+  typedef typename CViewType::non_const_value_type ScalarC;
+  typedef Kokkos::Details::ArithTraits<ScalarA> ATA;
+  typedef Kokkos::Details::ArithTraits<ScalarC> ATC;
+
+  AViewType A;
+  CViewType C;
+  ScalarC alpha, beta;
+  int j0, k, trans;
+  bool lower, herm;
+
+  SyrkDiagonalBlockFunctor(const AViewType& A_, const CViewType& C_,
+                           const ScalarC& alpha_, const ScalarC& beta_,
+                           const int j0_, const int trans_, const bool lower_, const bool herm_)
+    : A(A_), C(C_), alpha(alpha_), beta(beta_), j0(j0_),
+      k(trans_ == 0 ? A_.extent_int(1) : A_.extent_int(0)),
+      trans(trans_), lower(lower_), herm(herm_) {}
+
+  // op(A)(i,l)
+  KOKKOS_INLINE_FUNCTION
+  ScalarA opA(const int i, const int l) const {
+    return trans == 0 ? A(i,l) : trans == 1 ? A(l,i) : ATA::conj(A(l,i));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const typename Kokkos::TeamPolicy<ExecSpace>::member_type& team) const {
+    // map the team to (r,c), r >= c, of the lower triangle of the block
+    const int t = team.league_rank();
+    int r = int((Kokkos::Details::ArithTraits<double>::sqrt(8.0*t+1.0)-1.0)/2.0);
+    while(r*(r+1)/2 > t) r--;
+    while((r+1)*(r+2)/2 <= t) r++;
+    const int c = t - r*(r+1)/2;
+
+    const int p = j0 + (lower ? r : c);
+    const int q = j0 + (lower ? c : r);
+
+    ScalarC sum = ATC::zero();
+    Kokkos::parallel_reduce(Kokkos::TeamThreadRange(team,k), [&] (const int& l, ScalarC& lsum) {
+      const ScalarA b = opA(q,l);
+      lsum += opA(p,l)*(herm ? ATA::conj(b) : b);
+    },sum);
+
+    Kokkos::single(Kokkos::PerTeam(team), [&] () {
+      const ScalarC val = (beta == ATC::zero() ? alpha*sum : beta*C(p,q) + alpha*sum);
+      C(p,q) = (herm && p == q) ? ScalarC(ATC::real(val)) : val;
+    });
+  }
+};
+
+// Blocked rank-k update. The diagonal blocks are computed entry by entry
+// so that only the referenced triangle is touched; the rectangular panel
+// next to each diagonal block goes to gemm.
+//
+//   trans: 0 (A*op(A)), 1 (A^T*A), 2 (A^H*A)
+template<class AViewType, class CViewType>
+void impl_syrk_blocked(const bool lower,
+                       const int trans,
+                       const bool herm,
+                       typename AViewType::const_value_type& alpha,
+                       const AViewType& A,
+                       typename CViewType::const_value_type& beta,
+                       const CViewType& C) {
+  typedef typename CViewType::execution_space execution_space;
+  typedef typename CViewType::non_const_value_type ScalarC;
+  typedef Kokkos::Details::ArithTraits<ScalarC> ATC;
+  typedef Kokkos::pair<int,int> range_type;
+
+  const int n = C.extent_int(0);
+  const int k = (trans == 0 ? A.extent_int(1) : A.extent_int(0));
+  if(n == 0) return;
+
+  if(k == 0 || alpha == ATC::zero()) {
+    if(beta != ATC::one() || herm)
+      Kokkos::parallel_for("KokkosBlas::syrk[scale]", Kokkos::RangePolicy<execution_space>(0,n),
+                           SyrkScaleFunctor<CViewType>(C,beta,lower,herm));
+    return;
+  }
+
+  const char* opA = (trans == 0 ? "N" : trans == 1 ? "T" : "C");
+  const char* opB = (trans == 0 ? (herm ? "C" : "T") : "N");
+
+  const int bs = impl_syrk_choose_block_size<execution_space>::value;
+  for(int j0=0; j0<n; j0+=bs) {
+    const int j1 = (j0+bs < n ? j0+bs : n), nb = j1-j0;
+
+    Kokkos::parallel_for("KokkosBlas::syrk[diagonal]",
+                         Kokkos::TeamPolicy<execution_space>(nb*(nb+1)/2,Kokkos::AUTO),
+                         SyrkDiagonalBlockFunctor<AViewType,CViewType,execution_space>
+                         (A,C,alpha,beta,j0,trans,lower,herm));
+
+    if(j1 == n) continue;
+    const range_type J(j0,j1), R(j1,n);
+
+    // lower: C(R,J) = beta*C(R,J) + alpha*op(A)(R,:)*op(A)(J,:)^{T,H}
+    // upper: C(J,R) = beta*C(J,R) + alpha*op(A)(J,:)*op(A)(R,:)^{T,H}
+    const range_type P = lower ? R : J, Q = lower ? J : R;
+    if(trans == 0)
+      KokkosBlas::gemm(opA,opB,alpha,
+                       Kokkos::subview(A,P,Kokkos::ALL()),
+                       Kokkos::subview(A,Q,Kokkos::ALL()),
+                       beta,
+                       Kokkos::subview(C,P,Q));
+    else
+      KokkosBlas::gemm(opA,opB,alpha,
+                       Kokkos::subview(A,Kokkos::ALL(),P),
+                       Kokkos::subview(A,Kokkos::ALL(),Q),
+                       beta,
+                       Kokkos::subview(C,P,Q));
+  }
+}
+
+} // namespace Impl
+} // namespace KokkosBlas
+
+#endif // KOKKOS_BLAS3_SYRK_IMPL_HPP_
@@ -0,0 +1,238 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_BLAS3_TRSM_IMPL_HPP_
+#define KOKKOS_BLAS3_TRSM_IMPL_HPP_
+
+#include<Kokkos_Core.hpp>
+#include<KokkosBlas3_gemm.hpp>
+
+namespace KokkosBlas {
+namespace Impl {
+
+// Size of the diagonal blocks; the triangular solve with a diagonal block
+// is done by one thread per right-hand side and the rest of B is updated
+// with gemm, so larger blocks move more of the flops into gemm.
+template<class ExecSpace>
+struct impl_trsm_choose_block_size {
+  static constexpr int value = 64;
+};
+
+#ifdef KOKKOS_ENABLE_CUDA
+template<>
+struct impl_trsm_choose_block_size<Kokkos::Cuda> {
+  static constexpr int value = 32;
+};
+#endif
+
+// B = alpha*B
+template<class BViewType>
+struct TrsmScaleFunctor {
+  typedef typename BViewType::non_const_value_type ScalarB;
+  typedef Kokkos::Details::ArithTraits<ScalarB> ATB;
+
+  BViewType B;
+  ScalarB alpha;
+
+  TrsmScaleFunctor(const BViewType& B_, const ScalarB& alpha_)
+    : B(B_), alpha(alpha_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int& i) const {
+    const int n = B.extent_int(1);
+    if(alpha == ATB::zero()) {
+      for(int j=0; j<n; j++)
+        B(i,j) = ATB::zero();
+    } else {
+      for(int j=0; j<n; j++)
+        B(i,j) = alpha*B(i,j);
+    }
+  }
+};
+
+// Solve with the diagonal block op(A)(k0:k1,k0:k1); one right-hand side per
+// work item, i.e. column j of B(k0:k1,:) for side left and row i of
+// B(:,k0:k1) for side right.
+template<class AViewType, class BViewType>
+struct TrsmDiagonalBlockFunctor {
+  typedef typename AViewType::non_const_value_type ScalarA;
+  typedef typename BViewType::non_const_value_type ScalarB;
+  typedef Kokkos::Details::ArithTraits<ScalarA> ATA;
+
+  AViewType A;
+  BViewType B;
+  int k0, k1;
+  bool left, op_lower, unit;
+  int trans;
+
+  TrsmDiagonalBlockFunctor(const AViewType& A_, const BViewType& B_,
+                           const int k0_, const int k1_,
+                           const bool left_, const bool op_lower_, const bool unit_, const int trans_)
+    : A(A_), B(B_), k0(k0_), k1(k1_), left(left_), op_lower(op_lower_), unit(unit_), trans(trans_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  ScalarA opA(const int i, const int j) const {
+    return trans == 0 ? A(i,j) : trans == 1 ? A(j,i) : ATA::conj(A(j,i));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int& idx) const {
+    if(left) {
+      // op(A) x = b with x = B(k0:k1,idx)
+      const int j = idx;
+      if(op_lower) {
+        for(int r=k0; r<k1; r++) {
+          ScalarB s = B(r,j);
+          for(int c=k0; c<r; c++)
+            s -= opA(r,c)*B(c,j);
+          B(r,j) = unit ? s : s/opA(r,r);
+        }
+      } else {
+        for(int r=k1-1; r>=k0; r--) {
+          ScalarB s = B(r,j);
+          for(int c=r+1; c<k1; c++)
+            s -= opA(r,c)*B(c,j);
+          B(r,j) = unit ? s : s/opA(r,r);
+        }
+      }
+    } else {
+      // x op(A) = b with x = B(idx,k0:k1)
+      const int i = idx;
+      if(!op_lower) {
+        for(int c=k0; c<k1; c++) {
+          ScalarB s = B(i,c);
+          for(int r=k0; r<c; r++)
+            s -= B(i,r)*opA(r,c);
+          B(i,c) = unit ? s : s/opA(c,c);
+        }
+      } else {
+        for(int c=k1-1; c>=k0; c--) {
+          ScalarB s = B(i,c);
+          for(int r=c+1; r<k1; r++)
+            s -= B(i,r)*opA(r,c);
+          B(i,c) = unit ? s : s/opA(c,c);
+        }
+      }
+    }
+  }
+};
+
+// Blocked triangular solve. The diagonal blocks of op(A) are processed in
+// the order of the substitution; after each block solve the remaining
+// right-hand sides are updated with a single gemm.
+//
+//   trans: 0 (no transpose), 1 (transpose), 2 (conjugate transpose)
+template<class AViewType, class BViewType>
+void impl_trsm_blocked(const bool left,
+                       const bool lower,
+                       const int trans,
+                       const bool unit,
+                       typename BViewType::const_value_type& alpha,
+                       const AViewType& A,
+                       const BViewType& B) {
+  typedef typename BViewType::execution_space execution_space;
+  typedef typename BViewType::non_const_value_type ScalarB;
+  typedef Kokkos::Details::ArithTraits<ScalarB> ATB;
+  typedef Kokkos::pair<int,int> range_type;
+
+  const int m = B.extent_int(0);
+  const int n = B.extent_int(1);
+  const int na = left ? m : n;
+  if(m == 0 || n == 0) return;
+
+  if(alpha != ATB::one()) {
+    Kokkos::parallel_for("KokkosBlas::trsm[scale]", Kokkos::RangePolicy<execution_space>(0,m),
+                         TrsmScaleFunctor<BViewType>(B,alpha));
+    if(alpha == ATB::zero()) return;
+  }
+
+  // op(A) is lower triangular if A is lower and not transposed or A is upper and transposed
+  const bool op_lower = (lower == (trans == 0));
+
+  // left:  forward substitution if op(A) is lower
+  // right: forward substitution if op(A) is upper
+  const bool forward = (left == op_lower);
+
+  const char* op = (trans == 0 ? "N" : trans == 1 ? "T" : "C");
+  const ScalarB minus_one = -ATB::one();
+
+  const int bs = impl_trsm_choose_block_size<execution_space>::value;
+  const int nblk = (na + bs - 1)/bs;
+  for(int s=0; s<nblk; s++) {
+    const int kb = forward ? s : nblk-1-s;
+    const int k0 = kb*bs, k1 = (k0+bs < na ? k0+bs : na);
+
+    Kokkos::parallel_for("KokkosBlas::trsm[diagonal]", Kokkos::RangePolicy<execution_space>(0,left?n:m),
+                         TrsmDiagonalBlockFunctor<AViewType,BViewType>(A,B,k0,k1,left,op_lower,unit,trans));
+
+    const range_type K(k0,k1);
+    const range_type R = forward ? range_type(k1,na) : range_type(0,k0);
+    if(R.first == R.second) continue;
+
+    if(left) {
+      // B(R,:) -= op(A)(R,K)*B(K,:)
+      auto A_RK = (trans == 0 ?
+                   Kokkos::subview(A,R,K) :
+                   Kokkos::subview(A,K,R));
+      KokkosBlas::gemm(op,"N",minus_one,A_RK,
+                       Kokkos::subview(B,K,Kokkos::ALL()),
+                       ATB::one(),
+                       Kokkos::subview(B,R,Kokkos::ALL()));
+    } else {
+      // B(:,R) -= B(:,K)*op(A)(K,R)
+      auto A_KR = (trans == 0 ?
+                   Kokkos::subview(A,K,R) :
+                   Kokkos::subview(A,R,K));
+      KokkosBlas::gemm("N",op,minus_one,
+                       Kokkos::subview(B,Kokkos::ALL(),K),
+                       A_KR,
+                       ATB::one(),
+                       Kokkos::subview(B,Kokkos::ALL(),R));
+    }
+  }
+}
+
+} // namespace Impl
+} // namespace KokkosBlas
+
+#endif // KOKKOS_BLAS3_TRSM_IMPL_HPP_
@@ -0,0 +1,146 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSKERNELS_BITMAPACCUMULATOR_HPP
+#define _KOKKOSKERNELS_BITMAPACCUMULATOR_HPP
+
+#include <Kokkos_Core.hpp>
+#include "KokkosKernels_BitUtils.hpp"
+
+namespace KokkosKernels{
+
+namespace Experimental{
+
+/**
+ * Dense accumulator over num_cols columns whose occupied columns are kept in
+ * a bitmap of bit_type words instead of a marker per column.
+ * The values of a column are assigned when its bit is first set, so they need
+ * no reset between rows, and only the bitmap has to be initialized to 0.
+ * The range of words touched by the current row is tracked, and the output
+ * visits only the set bits of this range, giving the keys in increasing order.
+ * bit_type should not be wider than value_type is aligned, so that a bitmap
+ * stored right after the values stays aligned, see get_memory_size.
+ * Insertion is sequential, to be used by a single thread.
+ */
+template <typename size_type, typename key_type, typename value_type, typename bit_type = unsigned>
+struct BitmapAccumulator{
+  key_type num_cols;
+  value_type *values;
+  bit_type *bits;
+  key_type min_word;
+  key_type max_word;
+
+  enum { bits_per_word = sizeof(bit_type) * 8 };
+
+  KOKKOS_INLINE_FUNCTION
+  BitmapAccumulator(): num_cols(0), values(), bits(), min_word(0), max_word(-1){}
+
+  /**
+   * Assumption: the get_num_words(num_cols_) words of bits_ are 0.
+   */
+  KOKKOS_INLINE_FUNCTION
+  BitmapAccumulator(const key_type num_cols_, value_type *values_, bit_type *bits_):
+    num_cols(num_cols_), values(values_), bits(bits_), min_word(num_cols_), max_word(-1){}
+
+  KOKKOS_INLINE_FUNCTION
+  static key_type get_num_words(const key_type num_cols_){
+    return (num_cols_ + bits_per_word - 1) / bits_per_word;
+  }
+
+  //memory of the accumulator in units of value_type, the values followed by the bitmap.
+  KOKKOS_INLINE_FUNCTION
+  static size_t get_memory_size(const key_type num_cols_){
+    return size_t (num_cols_) +
+        (size_t (get_num_words(num_cols_)) * sizeof(bit_type) + sizeof(value_type) - 1) / sizeof(value_type);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void sequential_insert_mergeAdd(const key_type key, const value_type value){
+    const key_type word = key / bits_per_word;
+    const bit_type mask = bit_type(1) << (key % bits_per_word);
+    if (bits[word] & mask){
+      values[key] += value;
+    }
+    else {
+      bits[word] |= mask;
+      values[key] = value;
+      if (word < min_word) min_word = word;
+      if (word > max_word) max_word = word;
+    }
+  }
+
+  //number of the keys inserted since the last export.
+  KOKKOS_INLINE_FUNCTION
+  size_type size() const {
+    size_type num_keys = 0;
+    for (key_type w = min_word; w <= max_word; ++w){
+      num_keys += KokkosKernels::Impl::pop_count(bits[w]);
+    }
+    return num_keys;
+  }
+
+  //writes the keys in increasing order with their values, clears the bitmap,
+  //and returns the number of keys written.
+  KOKKOS_INLINE_FUNCTION
+  size_type sequential_export_and_clear(key_type *out_keys, value_type *out_values){
+    size_type num_keys = 0;
+    for (key_type w = min_word; w <= max_word; ++w){
+      bit_type word = bits[w];
+      while (word){
+        //least_set_bit is 1 based.
+        const key_type key = w * bits_per_word + KokkosKernels::Impl::least_set_bit(word) - 1;
+        out_keys[num_keys] = key;
+        out_values[num_keys++] = values[key];
+        word &= word - 1;
+      }
+      bits[w] = 0;
+    }
+    min_word = num_cols;
+    max_word = -1;
+    return num_keys;
+  }
+};
+
+}
+}
+
+#endif
@@ -43,6 +43,7 @@
 
 #include "Kokkos_Core.hpp"
 #include "Kokkos_Atomic.hpp"
+#include <cmath>
 
 #ifndef _KOKKOSKERNELSUTILSEXECSPACEUTILS_HPP
 #define _KOKKOSKERNELSUTILSEXECSPACEUTILS_HPP
@@ -126,6 +127,142 @@ inline int kk_get_suggested_vector_size(
 }
 
 
+//bins of kk_row_length_histogram: one per row length up to 32, then one
+//per power of two up to 2^32, the last one also counting the longer rows.
+#define KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS 60
+
+/**
+ * \brief Histogram of the row lengths of a graph, computed with
+ * kk_get_row_length_histogram.
+ */
+struct kk_row_length_histogram{
+  size_t counts[KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS];
+
+  KOKKOS_INLINE_FUNCTION
+  kk_row_length_histogram(){
+    for (int b = 0; b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS; ++b) counts[b] = 0;
+  }
+
+  //the longest row length of bin b.
+  KOKKOS_INLINE_FUNCTION
+  static size_t bin_length(const int b){
+    return b <= 32 ? size_t(b) : size_t(1) << (b - 27);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static int bin(const size_t length){
+    if (length <= 32) return int(length);
+    int b = 33;
+    while (b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS - 1 && bin_length(b) < length) ++b;
+    return b;
+  }
+
+  size_t num_rows() const{
+    size_t n = 0;
+    for (int b = 0; b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS; ++b) n += counts[b];
+    return n;
+  }
+
+  /**
+   * \brief Returns the smallest bin length that at least the fraction p of
+   * the rows do not exceed, e.g. p = 0.5 for the median row length.
+   */
+  size_t percentile(const double p) const{
+    const double n = double(num_rows());
+    size_t cumulative = 0;
+    for (int b = 0; b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS; ++b){
+      cumulative += counts[b];
+      if (counts[b] > 0 && double(cumulative) >= p * n) return bin_length(b);
+    }
+    return 0;
+  }
+};
+
+template <typename row_map_view_t>
+struct RowLengthHistogram{
+  typedef kk_row_length_histogram value_type;
+  row_map_view_t row_map;
+
+  RowLengthHistogram(row_map_view_t row_map_): row_map(row_map_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t &i, value_type &h) const{
+    ++h.counts[value_type::bin(size_t(row_map(i + 1) - row_map(i)))];
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init(value_type &h) const{
+    for (int b = 0; b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS; ++b) h.counts[b] = 0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join(volatile value_type &dst, const volatile value_type &src) const{
+    for (int b = 0; b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS; ++b) dst.counts[b] += src.counts[b];
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join(value_type &dst, const value_type &src) const{
+    for (int b = 0; b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS; ++b) dst.counts[b] += src.counts[b];
+  }
+};
+
+/**
+ * \brief Computes in parallel the histogram of the lengths of the nr rows
+ * of row_map.
+ */
+template <typename row_map_view_t, typename MyExecSpace>
+kk_row_length_histogram kk_get_row_length_histogram(const size_t nr, const row_map_view_t &row_map){
+  kk_row_length_histogram h;
+  if (nr > 0)
+    Kokkos::parallel_reduce("KokkosKernels::RowLengthHistogram", Kokkos::RangePolicy<MyExecSpace>(0, nr),
+        RowLengthHistogram<row_map_view_t>(row_map), h);
+  return h;
+}
+
+/**
+ * \brief Returns the suggested vector size from the distribution of the
+ * row lengths as well as their average. On GPUs, the 32 / V rows of a warp
+ * with vector size V each take ceil(length / V) steps, and the warp runs
+ * as long as the longest of them. The expected longest row of a warp is
+ * computed from the histogram, and the V with the fewest expected steps
+ * per row is chosen, the larger one on ties. The result is never smaller
+ * than the suggestion from the average alone, so that it only differs for
+ * long tailed distributions, whose few long rows stall the warps they are
+ * part of. On CPUs, it returns 1.
+ * \param nr, nnz: number of rows and nonzeroes.
+ * \param h: the histogram of the row lengths, from kk_get_row_length_histogram.
+ */
+inline int kk_get_suggested_vector_size(
+    const size_t nr, const size_t nnz, const kk_row_length_histogram &h, const ExecSpaceType exec_space){
+  if (exec_space != Exec_CUDA) return 1;
+  const double n = double(h.num_rows());
+  if (nr == 0 || n == 0) return 2;
+  const int average_vector_size = kk_get_suggested_vector_size(nr, nnz, exec_space);
+
+  int suggested_vector_size_ = 2;
+  double best_cost = 0;
+  for (int vector_size = 2; vector_size <= 32; vector_size *= 2){
+    const int rows_per_warp = 32 / vector_size;
+    double cost = 0, previous = 0;
+    size_t cumulative = 0;
+    for (int b = 0; b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS; ++b){
+      if (h.counts[b] == 0) continue;
+      cumulative += h.counts[b];
+      //probability that the longest row of a warp is in bins up to b.
+      const double p = std::pow(double(cumulative) / n, rows_per_warp);
+      const size_t steps = (h.bin_length(b) + vector_size - 1) / vector_size;
+      cost += double(steps > 0 ? steps : 1) * (p - previous);
+      previous = p;
+    }
+    cost /= rows_per_warp;
+    if (vector_size == 2 || cost <= best_cost){
+      suggested_vector_size_ = vector_size;
+      best_cost = cost;
+    }
+  }
+  return suggested_vector_size_ > average_vector_size ? suggested_vector_size_ : average_vector_size;
+}
+
 inline int kk_get_suggested_team_size(const int vector_size, const ExecSpaceType exec_space){
   if (exec_space == Exec_CUDA){
     return 256 / vector_size;
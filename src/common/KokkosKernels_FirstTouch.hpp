@@ -0,0 +1,170 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSKERNELS_FIRSTTOUCH_HPP
+#define _KOKKOSKERNELS_FIRSTTOUCH_HPP
+
+#include <Kokkos_Core.hpp>
+#include <type_traits>
+#ifdef KOKKOS_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace KokkosKernels{
+
+namespace Impl{
+
+/*! \brief First touch initialization of host arrays.
+ *
+ *  On a NUMA host each page is placed on the socket of the thread that
+ *  writes it first. Arrays that are filled serially, or allocated without
+ *  initialization and filled by a different schedule than the one of the
+ *  kernels that read them, end up on a single socket or split the wrong
+ *  way, and the kernels are limited by the bandwidth of that socket. The
+ *  functions below zero the arrays with the schedule of the kernels before
+ *  they are filled.
+ */
+
+template <typename view_t>
+struct FirstTouchFill{
+  typedef typename view_t::non_const_value_type value_t;
+  view_t view;
+
+  FirstTouchFill(view_t view_): view(view_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t &i) const{
+    view(i) = value_t();
+  }
+};
+
+/**
+ * \brief Zeroes a rank 1 view with a static range policy on exec_space,
+ * the schedule of the range policy kernels, so that each thread touches
+ * first the part of the view it later works on. Meant for the views
+ * allocated with ViewAllocateWithoutInitializing.
+ */
+template <typename view_t, typename exec_space>
+void kk_first_touch_view(view_t view){
+  if (view.extent(0) == 0) return;
+  Kokkos::parallel_for("KokkosKernels::FirstTouch",
+      Kokkos::RangePolicy<exec_space, Kokkos::Schedule<Kokkos::Static> >(0, view.extent(0)),
+      FirstTouchFill<view_t>(view));
+}
+
+#ifdef KOKKOS_ENABLE_OPENMP
+/**
+ * \brief Zeroes the entries and the values of the rows of each row block
+ * on the OpenMP thread with the same id, the schedule of
+ * spmv_raw_openmp_no_transpose.
+ */
+template <typename row_block_view_t, typename row_map_view_t, typename entries_view_t, typename values_view_t>
+void kk_first_touch_row_blocks_openmp(
+    row_block_view_t row_block_offsets,
+    row_map_view_t row_map,
+    entries_view_t entries,
+    values_view_t values){
+  typedef typename row_map_view_t::non_const_value_type size_type;
+  typedef typename entries_view_t::non_const_value_type lno_t;
+  typedef typename values_view_t::non_const_value_type scalar_t;
+
+  const size_type *block_offsets = row_block_offsets.data();
+  const size_type *rowmap = row_map.data();
+  lno_t *e = entries.data();
+  scalar_t *v = values.data();
+  const int num_blocks = row_block_offsets.extent(0) - 1;
+  //the row map may come from a file that is not checked yet.
+  const size_type nnz = entries.extent(0);
+
+  #pragma omp parallel
+  {
+    const int myID = omp_get_thread_num();
+    if (myID < num_blocks){
+      const size_type myStart = rowmap[block_offsets[myID]];
+      const size_type myEnd = rowmap[block_offsets[myID + 1]] < nnz ? rowmap[block_offsets[myID + 1]] : nnz;
+      for (size_type k = myStart; k < myEnd; ++k){
+        e[k] = lno_t();
+        v[k] = scalar_t();
+      }
+    }
+  }
+}
+#endif
+
+/**
+ * \brief Allocates a matrix with the given filled row map and nnz zero
+ * entries, touched first with the schedule of spmv. On OpenMP the graph
+ * is split into a row block per thread balanced by the number of
+ * entries, create_block_partitioning, so that spmv takes its raw OpenMP
+ * path on the same blocks; otherwise the entries are zeroed with a
+ * static range policy.
+ * \param row_map: the row map of the matrix, already filled.
+ */
+template <typename crsMat_t>
+crsMat_t kk_allocate_first_touch_crs_matrix(
+    typename crsMat_t::const_ordinal_type ncols,
+    typename crsMat_t::StaticCrsGraphType::row_map_type::non_const_type row_map,
+    typename crsMat_t::non_const_size_type nnz){
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::entries_type::non_const_type cols_view_t;
+  typedef typename crsMat_t::values_type::non_const_type values_view_t;
+  typedef typename crsMat_t::execution_space exec_space;
+
+  cols_view_t entries(Kokkos::ViewAllocateWithoutInitializing("colsmap_view"), nnz);
+  values_view_t values(Kokkos::ViewAllocateWithoutInitializing("values_view"), nnz);
+  graph_t static_graph (entries, row_map);
+#ifdef KOKKOS_ENABLE_OPENMP
+  if (std::is_same<exec_space, Kokkos::OpenMP>::value && row_map.extent(0) > 1){
+    static_graph.create_block_partitioning(omp_get_max_threads());
+    kk_first_touch_row_blocks_openmp(static_graph.row_block_offsets, row_map, entries, values);
+    return crsMat_t("CrsMatrix", ncols, values, static_graph);
+  }
+#endif
+  kk_first_touch_view<cols_view_t, exec_space>(entries);
+  kk_first_touch_view<values_view_t, exec_space>(values);
+  return crsMat_t("CrsMatrix", ncols, values, static_graph);
+}
+
+}
+}
+
+#endif
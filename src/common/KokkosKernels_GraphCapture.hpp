@@ -0,0 +1,177 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef _KOKKOSKERNELS_GRAPHCAPTURE_HPP
+#define _KOKKOSKERNELS_GRAPHCAPTURE_HPP
+
+#include <functional>
+#include <sstream>
+#include "Kokkos_Core.hpp"
+
+namespace KokkosKernels{
+
+namespace Experimental{
+
+/**
+ * \brief Records the kernels that a function launches once and replays them.
+ *
+ * On Cuda (CUDA 10 or later) the kernels f launches on the stream of the
+ * instance are captured into a Cuda Graph, so that a replay costs a single
+ * launch however many kernels an iteration has. The default instance runs
+ * on the legacy default stream, which cannot be captured; when the code is
+ * compiled with --default-stream per-thread its per-thread stream is
+ * captured instead. On the other spaces, or when the stream cannot be
+ * captured, replay calls f again and is_graph() is false. capture() itself
+ * does not run f.
+ *
+ * f must behave the same on every replay. It must not synchronize with the
+ * host (no fence, no deep_copy, no reduction into a host scalar; keep the
+ * scalars of the iteration in device Views), must not allocate, and must
+ * launch on the captured stream only. Run f once before capture() so that
+ * Kokkos allocates its lazily sized scratch and reduction buffers, and do
+ * not set a kernel counts callback while capturing, since it fences.
+ * symmetric_gauss_seidel_apply after gauss_seidel_numeric, spmv on a
+ * CrsMatrix, axpby, scal and dot into a rank 0 device View qualify.
+ */
+template <typename ExecSpace>
+class GraphCapture{
+  ExecSpace _space;
+  std::function<void()> _f;
+
+  GraphCapture(const GraphCapture &);
+  GraphCapture &operator=(const GraphCapture &);
+public:
+  GraphCapture(const ExecSpace &space = ExecSpace()) : _space(space) {}
+
+  template <typename Functor>
+  void capture(const Functor &f){
+    _f = f;
+  }
+
+  /// launches the recorded work n times; it is asynchronous like the kernels
+  void replay(const int n = 1) const {
+    for (int i = 0; i < n; ++i) _f();
+  }
+
+  bool is_graph() const { return false; }
+};
+
+#if defined( KOKKOS_ENABLE_CUDA ) && defined( CUDART_VERSION ) && (CUDART_VERSION >= 10000)
+template <>
+class GraphCapture<Kokkos::Cuda>{
+  Kokkos::Cuda _space;
+  std::function<void()> _f;
+  cudaGraph_t _graph;
+  cudaGraphExec_t _exec;
+  bool _is_graph;
+
+  GraphCapture(const GraphCapture &);
+  GraphCapture &operator=(const GraphCapture &);
+
+  static void check(const cudaError_t err, const char *what){
+    if (err != cudaSuccess){
+      std::ostringstream os;
+      os << "KokkosKernels::GraphCapture: " << what << " failed: " << cudaGetErrorString(err);
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+  }
+
+  void release(){
+    if (_is_graph){
+      cudaGraphExecDestroy(_exec);
+      cudaGraphDestroy(_graph);
+      _is_graph = false;
+    }
+  }
+
+  cudaStream_t stream() const {
+    cudaStream_t s = _space.cuda_stream();
+#if defined( CUDA_API_PER_THREAD_DEFAULT_STREAM )
+    if (s == 0) s = cudaStreamPerThread;
+#endif
+    return s;
+  }
+
+public:
+  GraphCapture(const Kokkos::Cuda &space = Kokkos::Cuda()) : _space(space), _is_graph(false) {}
+
+  ~GraphCapture(){ this->release(); }
+
+  template <typename Functor>
+  void capture(const Functor &f){
+    this->release();
+    _f = f;
+    const cudaStream_t s = this->stream();
+    //the legacy default stream cannot be captured.
+    if (s == 0) return;
+
+    _space.fence();
+    check(cudaStreamBeginCapture(s, cudaStreamCaptureModeThreadLocal), "cudaStreamBeginCapture");
+    f();
+    check(cudaStreamEndCapture(s, &_graph), "cudaStreamEndCapture");
+    const cudaError_t err = cudaGraphInstantiate(&_exec, _graph, NULL, NULL, 0);
+    if (err != cudaSuccess){
+      cudaGraphDestroy(_graph);
+      check(err, "cudaGraphInstantiate");
+    }
+    _is_graph = true;
+  }
+
+  void replay(const int n = 1) const {
+    if (!_is_graph){
+      for (int i = 0; i < n; ++i) _f();
+      return;
+    }
+    const cudaStream_t s = this->stream();
+    for (int i = 0; i < n; ++i)
+      check(cudaGraphLaunch(_exec, s), "cudaGraphLaunch");
+  }
+
+  bool is_graph() const { return _is_graph; }
+};
+#endif
+
+}
+}
+
+#endif
@@ -45,6 +45,14 @@
 #include "KokkosSparse_gauss_seidel_handle.hpp"
 #include "KokkosSparse_spgemm_handle.hpp"
 #include "KokkosSparse_spadd_handle.hpp"
+#include "KokkosSparse_sptrsv_handle.hpp"
+#include "KokkosSparse_spiluk_handle.hpp"
+#include "KokkosSparse_spchol_handle.hpp"
+#include "KokkosSparse_analysis.hpp"
+#include "KokkosKernels_Uniform_Initialized_MemoryPool.hpp"
+#include "KokkosKernels_Workspace.hpp"
+#include "KokkosKernels_MemoryPlacement.hpp"
+#include "KokkosKernels_TuningDatabase.hpp"
 #ifndef _KOKKOSKERNELHANDLE_HPP
 #define _KOKKOSKERNELHANDLE_HPP
 
@@ -135,6 +143,11 @@ public:
 	  this->gcHandle = right_side_handle.get_graph_coloring_handle();
 	  this->gsHandle = right_side_handle.get_gs_handle();
 	  this->spgemmHandle = right_side_handle.get_spgemm_handle();
+	  this->sptrsvHandle = right_side_handle.get_sptrsv_handle();
+	  this->spilukHandle = right_side_handle.get_spiluk_handle();
+	  this->spcholHandle = right_side_handle.get_spchol_handle();
+	  this->poolStorage = right_side_handle.get_persistent_pool();
+	  this->workspace = right_side_handle.get_workspace();
 
 
 	  this->team_work_size = right_side_handle.get_set_team_work_size();
@@ -143,13 +156,21 @@ public:
 
 	  this->my_exec_space = right_side_handle.get_handle_exec_space();
 	  this->use_dynamic_scheduling = right_side_handle.is_dynamic_scheduling();
+	  this->prefetch_before_numeric = right_side_handle.get_prefetch_before_numeric();
+	  this->memory_placement = right_side_handle.get_memory_placement();
 	  this->KKVERBOSE = right_side_handle.get_verbose();
 	  this->vector_size = right_side_handle.get_set_suggested_vector_size();
+	  this->reset_row_length_histograms();
 
 	  is_owner_of_the_gc_handle = false;
 	  is_owner_of_the_gs_handle = false;
 	  is_owner_of_the_spgemm_handle = false;
 	  is_owner_of_the_spadd_handle = false;
+	  is_owner_of_the_sptrsv_handle = false;
+	  is_owner_of_the_spiluk_handle = false;
+	  is_owner_of_the_spchol_handle = false;
+	  is_owner_of_the_persistent_pool = false;
+	  is_owner_of_the_workspace = false;
 	  //return *this;
   }
 
@@ -188,12 +209,33 @@ public:
           HandleExecSpace,
           HandleTempMemorySpace> SPADDHandleType;
 
+  typedef typename KokkosSparse::SPTRSVHandle
+      <const_size_type, const_nnz_lno_t, const_nnz_scalar_t,
+	  HandleExecSpace, HandleTempMemorySpace, HandlePersistentMemorySpace> SPTRSVHandleType;
+
+  typedef typename KokkosSparse::SPILUKHandle
+      <const_size_type, const_nnz_lno_t, const_nnz_scalar_t,
+	  HandleExecSpace, HandleTempMemorySpace, HandlePersistentMemorySpace> SPILUKHandleType;
+
+  typedef typename KokkosSparse::SPCHOLHandle
+      <const_size_type, const_nnz_lno_t, const_nnz_scalar_t,
+	  HandleExecSpace, HandleTempMemorySpace, HandlePersistentMemorySpace> SPCHOLHandleType;
+
+  typedef typename KokkosKernels::Impl::UniformMemoryPool<HandleTempMemorySpace, nnz_lno_t> PoolMemorySpaceType;
+  typedef typename KokkosKernels::Impl::UniformMemoryPoolStorage<HandleTempMemorySpace, nnz_lno_t> PoolStorageType;
+  typedef typename KokkosKernels::Impl::WorkspaceArena<HandleTempMemorySpace> WorkspaceType;
+
 private:
 
   GraphColoringHandleType *gcHandle;
   GaussSeidelHandleType *gsHandle;
   SPGEMMHandleType *spgemmHandle;
   SPADDHandleType *spaddHandle;
+  SPTRSVHandleType *sptrsvHandle;
+  SPILUKHandleType *spilukHandle;
+  SPCHOLHandleType *spcholHandle;
+  PoolStorageType *poolStorage;
+  WorkspaceType *workspace;
 
   int team_work_size;
   size_t shared_memory_size;
@@ -201,13 +243,37 @@ private:
 
   KokkosKernels::Impl::ExecSpaceType my_exec_space;
   bool use_dynamic_scheduling;
+  bool prefetch_before_numeric;
+  KokkosKernels::MemoryPlacement memory_placement;
   bool KKVERBOSE;
   int vector_size;
 
+  //row length histograms of the last few row maps, see get_row_length_histogram.
+  enum : int { max_cached_histograms = 4 };
+  struct RowLengthHistogramEntry{
+    const void *row_map;
+    size_t num_rows;
+    KokkosKernels::Impl::kk_row_length_histogram histogram;
+  };
+  RowLengthHistogramEntry cached_histograms[max_cached_histograms];
+  int num_cached_histograms;
+  int next_cached_histogram;
+
+  //analyses of the last few matrices, see set_matrix_analysis.
+  enum : int { max_cached_analyses = 4 };
+  KokkosSparse::MatrixAnalysis cached_analyses[max_cached_analyses];
+  int num_cached_analyses;
+  int next_cached_analysis;
+
   bool is_owner_of_the_gc_handle;
   bool is_owner_of_the_gs_handle;
   bool is_owner_of_the_spgemm_handle;
   bool is_owner_of_the_spadd_handle;
+  bool is_owner_of_the_sptrsv_handle;
+  bool is_owner_of_the_spiluk_handle;
+  bool is_owner_of_the_spchol_handle;
+  bool is_owner_of_the_persistent_pool;
+  bool is_owner_of_the_workspace;
 
 
 public:
@@ -215,19 +281,29 @@ public:
 
 
   KokkosKernelsHandle():
-      gcHandle(NULL), gsHandle(NULL),spgemmHandle(NULL),spaddHandle(NULL),
+      gcHandle(NULL), gsHandle(NULL),spgemmHandle(NULL),spaddHandle(NULL), sptrsvHandle(NULL),
+      spilukHandle(NULL), spcholHandle(NULL), poolStorage(NULL), workspace(NULL),
       team_work_size (-1), shared_memory_size(16128),
       suggested_team_size(-1),
       my_exec_space(KokkosKernels::Impl::kk_get_exec_space_type<HandleExecSpace>()),
-      use_dynamic_scheduling(true), KKVERBOSE(false),vector_size(-1),
+      use_dynamic_scheduling(true), prefetch_before_numeric(false), memory_placement(), KKVERBOSE(false),vector_size(-1),
+      num_cached_histograms(0), next_cached_histogram(0),
+      num_cached_analyses(0), next_cached_analysis(0),
 	  is_owner_of_the_gc_handle(true), is_owner_of_the_gs_handle(true), is_owner_of_the_spgemm_handle(true),
-    is_owner_of_the_spadd_handle(true) {}
+    is_owner_of_the_spadd_handle(true), is_owner_of_the_sptrsv_handle(true),
+    is_owner_of_the_spiluk_handle(true), is_owner_of_the_spchol_handle(true),
+    is_owner_of_the_persistent_pool(true), is_owner_of_the_workspace(true) {}
 
   ~KokkosKernelsHandle(){
     this->destroy_gs_handle();
     this->destroy_graph_coloring_handle();
     this->destroy_spgemm_handle();
     this->destroy_spadd_handle();
+    this->destroy_sptrsv_handle();
+    this->destroy_spiluk_handle();
+    this->destroy_spchol_handle();
+    this->destroy_persistent_pool();
+    this->destroy_workspace();
   }
 
 
@@ -301,6 +377,45 @@ public:
     return this->use_dynamic_scheduling;
   }
 
+  /**
+   * \brief Sets whether the numeric phases prefetch the matrices and the
+   * views of the kernel handle to the device before they run. This only
+   * matters for unified memory (CudaUVMSpace), where the first touch of each
+   * page by a kernel otherwise costs a page fault.
+   * \input prefetch: true or false -> prefetch or not.
+   */
+  void set_prefetch_before_numeric(const bool prefetch){
+    this->prefetch_before_numeric = prefetch;
+  }
+
+  /**
+   * \brief Returns true or false, prefetch before the numeric phases or not.
+   */
+  bool get_prefetch_before_numeric(){
+    return this->prefetch_before_numeric;
+  }
+
+  /**
+   * \brief Sets the size of the fast memory space (HBM, MCDRAM) in bytes
+   * for the placement policy of get_memory_placement. 0, the default,
+   * places every array in the fast memory.
+   */
+  void set_fast_memory_capacity(const size_t capacity){
+    this->memory_placement.set_fast_memory_capacity(capacity);
+  }
+
+  /**
+   * \brief Returns the placement policy that decides which arrays of
+   * SpGEMM, Gauss-Seidel and triangle counting go to the fast memory.
+   * Call its predict function of the kernel, then place().
+   */
+  KokkosKernels::MemoryPlacement &get_memory_placement(){
+    return this->memory_placement;
+  }
+  const KokkosKernels::MemoryPlacement &get_memory_placement() const {
+    return this->memory_placement;
+  }
+
 
 
   /**
@@ -335,6 +450,97 @@ public:
     }
   }
 
+  /**
+   * \brief Returns the suggested vector size from the distribution of the
+   * row lengths of row_map, see kk_get_suggested_vector_size. On GPUs, the
+   * histogram of the row lengths is computed on the first call for a row map
+   * and cached in the handle.
+   * \param nr: number of rows, of vertices.
+   * \param nnz: number of nonzeroes, or edges.
+   * \param row_map: the nr + 1 offsets of the rows.
+   */
+  template <typename row_map_view_t>
+  int get_suggested_vector_size(const size_t nr, const size_t nnz, const row_map_view_t &row_map){
+    if (vector_size != -1){
+      return vector_size;
+    }
+    if (my_exec_space != KokkosKernels::Impl::Exec_CUDA){
+      return KokkosKernels::Impl::kk_get_suggested_vector_size(nr, nnz, my_exec_space);
+    }
+    const KokkosSparse::MatrixAnalysis *analysis = this->get_matrix_analysis(row_map.data(), nr, nnz);
+    if (analysis != NULL){
+      return KokkosKernels::Impl::kk_get_suggested_vector_size(
+          nr, nnz, analysis->row_length_histogram, my_exec_space);
+    }
+    return KokkosKernels::Impl::kk_get_suggested_vector_size(
+        nr, nnz, this->get_row_length_histogram(nr, row_map), my_exec_space);
+  }
+
+  /**
+   * \brief Attaches the analysis of a matrix, from KokkosSparse::analyze, to
+   * the handle. The last few analyses are kept, the one of the same row map
+   * being replaced. They are used by the kernels called with the matrix
+   * instead of their own inspection: the row length histogram by
+   * get_suggested_vector_size, and the bandwidths by the SPGEMM_KK_AUTO
+   * algorithm choice.
+   * Call reset_matrix_analyses() if the pattern of a matrix changes in place.
+   */
+  void set_matrix_analysis(const KokkosSparse::MatrixAnalysis &analysis){
+    for (int i = 0; i < num_cached_analyses; ++i){
+      if (cached_analyses[i].row_map == analysis.row_map){
+        cached_analyses[i] = analysis;
+        return;
+      }
+    }
+    cached_analyses[next_cached_analysis] = analysis;
+    next_cached_analysis = (next_cached_analysis + 1) % max_cached_analyses;
+    if (num_cached_analyses < max_cached_analyses) ++num_cached_analyses;
+  }
+
+  /**
+   * \brief Returns the attached analysis of the matrix with this row map and
+   * sizes, or NULL.
+   */
+  const KokkosSparse::MatrixAnalysis *get_matrix_analysis(const void *row_map, const size_t nr, const size_t nnz) const {
+    for (int i = 0; i < num_cached_analyses; ++i){
+      if (cached_analyses[i].is_for(row_map, int64_t(nr), nnz)) return &cached_analyses[i];
+    }
+    return NULL;
+  }
+
+  void reset_matrix_analyses(){
+    this->num_cached_analyses = 0;
+    this->next_cached_analysis = 0;
+  }
+
+  /**
+   * \brief Returns the histogram of the lengths of the nr rows of row_map. It
+   * is computed in parallel on the first call for a row map, and cached for
+   * the last few row maps, which are identified by their data pointer.
+   * Call reset_row_length_histograms() if the pattern of a matrix changes in
+   * place.
+   */
+  template <typename row_map_view_t>
+  const KokkosKernels::Impl::kk_row_length_histogram &get_row_length_histogram(const size_t nr, const row_map_view_t &row_map){
+    for (int i = 0; i < num_cached_histograms; ++i){
+      if (cached_histograms[i].row_map == row_map.data() && cached_histograms[i].num_rows == nr){
+        return cached_histograms[i].histogram;
+      }
+    }
+    RowLengthHistogramEntry &entry = cached_histograms[next_cached_histogram];
+    entry.row_map = row_map.data();
+    entry.num_rows = nr;
+    entry.histogram = KokkosKernels::Impl::kk_get_row_length_histogram<row_map_view_t, HandleExecSpace>(nr, row_map);
+    next_cached_histogram = (next_cached_histogram + 1) % max_cached_histograms;
+    if (num_cached_histograms < max_cached_histograms) ++num_cached_histograms;
+    return entry.histogram;
+  }
+
+  void reset_row_length_histograms(){
+    this->num_cached_histograms = 0;
+    this->next_cached_histogram = 0;
+  }
+
   void set_suggested_vector_size(int vector_size_){
     this->vector_size = vector_size_;
   }
@@ -370,6 +576,48 @@ public:
     }
   }
 
+  /**
+   * \brief Sets team size, vector size, shared memory size and dynamic scheduling
+   * from the tuning database entry of kernel for a matrix with nr rows and nnz
+   * nonzeroes on HandleExecSpace, see KokkosKernels::Impl::TuningDatabase.
+   * Parameters the entry does not hold are left unchanged.
+   * \param tuning: output, the entry, whose algorithm can be used to create the kernel handle.
+   * \return whether the database has an entry.
+   */
+  bool apply_tuning(const std::string &kernel, const size_t nr, const size_t nnz,
+                    KokkosKernels::Impl::KernelTuning &tuning){
+    if (!KokkosKernels::Impl::tuning_database().get(kernel, HandleExecSpace::name(), nr, nnz, tuning))
+      return false;
+    if (tuning.team_size > 0) this->set_suggested_team_size(tuning.team_size);
+    if (tuning.vector_size > 0) this->set_suggested_vector_size(tuning.vector_size);
+    if (tuning.shmem_size > 0) this->set_shmem_size(tuning.shmem_size);
+    if (tuning.dynamic_scheduling >= 0) this->set_dynamic_scheduling(tuning.dynamic_scheduling != 0);
+    return true;
+  }
+
+  bool apply_tuning(const std::string &kernel, const size_t nr, const size_t nnz){
+    KokkosKernels::Impl::KernelTuning tuning;
+    return this->apply_tuning(kernel, nr, nnz, tuning);
+  }
+
+  /**
+   * \brief Records the current parameters of the handle, with algorithm and the
+   * measured time, in the tuning database entry of kernel for a matrix with nr rows
+   * and nnz nonzeroes, unless the entry has a faster time.
+   * \return whether the entry was recorded.
+   */
+  bool record_tuning(const std::string &kernel, const size_t nr, const size_t nnz,
+                     const int algorithm, const double time){
+    KokkosKernels::Impl::KernelTuning tuning;
+    tuning.team_size = this->suggested_team_size;
+    tuning.vector_size = this->vector_size;
+    tuning.shmem_size = this->shared_memory_size;
+    tuning.dynamic_scheduling = this->use_dynamic_scheduling;
+    tuning.algorithm = algorithm;
+    tuning.time = time;
+    return KokkosKernels::Impl::tuning_database().record(kernel, HandleExecSpace::name(), nr, nnz, tuning);
+  }
+
 
 
 
@@ -447,6 +695,150 @@ public:
     }
   }
 
+  SPTRSVHandleType *get_sptrsv_handle(){
+    return this->sptrsvHandle;
+  }
+
+  void create_sptrsv_handle(KokkosSparse::SPTRSVAlgorithm algm, nnz_lno_t nrows, bool lower_tri = true) {
+    this->destroy_sptrsv_handle();
+    this->is_owner_of_the_sptrsv_handle = true;
+    this->sptrsvHandle = new SPTRSVHandleType(algm, nrows, lower_tri);
+  }
+
+  void create_sptrsv_handle(nnz_lno_t nrows, bool lower_tri = true) {
+    this->create_sptrsv_handle(KokkosSparse::SPTRSV_DEFAULT, nrows, lower_tri);
+  }
+
+  void destroy_sptrsv_handle(){
+    if (is_owner_of_the_sptrsv_handle && this->sptrsvHandle != NULL)
+    {
+      delete this->sptrsvHandle;
+      this->sptrsvHandle = NULL;
+    }
+  }
+
+  SPILUKHandleType *get_spiluk_handle(){
+    return this->spilukHandle;
+  }
+
+  void create_spiluk_handle(KokkosSparse::SPILUKAlgorithm algm, nnz_lno_t nrows, nnz_lno_t fill_level = 0) {
+    this->destroy_spiluk_handle();
+    this->is_owner_of_the_spiluk_handle = true;
+    this->spilukHandle = new SPILUKHandleType(algm, nrows, fill_level);
+  }
+
+  void create_spiluk_handle(nnz_lno_t nrows, nnz_lno_t fill_level = 0) {
+    this->create_spiluk_handle(KokkosSparse::SPILUK_DEFAULT, nrows, fill_level);
+  }
+
+  void destroy_spiluk_handle(){
+    if (is_owner_of_the_spiluk_handle && this->spilukHandle != NULL)
+    {
+      delete this->spilukHandle;
+      this->spilukHandle = NULL;
+    }
+  }
+
+  SPCHOLHandleType *get_spchol_handle(){
+    return this->spcholHandle;
+  }
+
+  void create_spchol_handle(nnz_lno_t nrows) {
+    this->destroy_spchol_handle();
+    this->is_owner_of_the_spchol_handle = true;
+    this->spcholHandle = new SPCHOLHandleType(nrows);
+  }
+
+  void destroy_spchol_handle(){
+    if (is_owner_of_the_spchol_handle && this->spcholHandle != NULL)
+    {
+      delete this->spcholHandle;
+      this->spcholHandle = NULL;
+    }
+  }
+
+  PoolStorageType *get_persistent_pool(){
+    return this->poolStorage;
+  }
+
+  /**
+   * \brief Creates the memory kept by the handle for the memory pools of
+   * SpGEMM and triangle counting. The memory is allocated by the first call,
+   * and is reused and grown by the later calls instead of being allocated
+   * and initialized by each call.
+   */
+  void create_persistent_pool(){
+    this->destroy_persistent_pool();
+    this->is_owner_of_the_persistent_pool = true;
+    this->poolStorage = new PoolStorageType();
+  }
+
+  void destroy_persistent_pool(){
+    if (is_owner_of_the_persistent_pool && this->poolStorage != NULL)
+    {
+      delete this->poolStorage;
+      this->poolStorage = NULL;
+    }
+  }
+
+  /**
+   * \brief Returns a memory pool with the given chunks, on the persistent pool
+   * of the handle if it is created, otherwise on newly allocated memory.
+   * \param label: name of the kernel using the pool.
+   * \param layout_param: parameter of the kernel fixing which entries of a chunk
+   * must hold initialized_value, e.g. the hash size.
+   */
+  PoolMemorySpaceType get_memory_pool(
+      const char *label, size_t layout_param,
+      size_t num_chunks, size_t chunk_size,
+      nnz_lno_t initialized_value, KokkosKernels::Impl::PoolType pool_type){
+    if (this->poolStorage != NULL){
+      return this->poolStorage->borrow_pool(label, layout_param, num_chunks, chunk_size, initialized_value, pool_type);
+    }
+    return PoolMemorySpaceType(num_chunks, chunk_size, initialized_value, pool_type);
+  }
+
+  WorkspaceType *get_workspace(){
+    return this->workspace;
+  }
+
+  /**
+   * \brief Creates the workspace kept by the handle for the temporaries of
+   * the kernels, e.g. the row pointers of the graph transpose and the
+   * compressed B of the SpGEMM symbolic phase. It grows to the largest use,
+   * so that the later calls take their temporaries without allocating.
+   */
+  void create_workspace(){
+    this->destroy_workspace();
+    this->is_owner_of_the_workspace = true;
+    this->workspace = new WorkspaceType();
+  }
+
+  /**
+   * \brief Frees the memory of the workspace, the next call allocates it again.
+   */
+  void release_workspace(){
+    if (this->workspace != NULL)
+      this->workspace->release();
+  }
+
+  void destroy_workspace(){
+    if (is_owner_of_the_workspace && this->workspace != NULL)
+    {
+      delete this->workspace;
+      this->workspace = NULL;
+    }
+  }
+
+  /**
+   * \brief Returns a view of n uninitialized entries for a temporary, on the
+   * workspace of the handle if it is created, otherwise newly allocated.
+   */
+  template <typename view_t>
+  view_t get_workspace_view(const char *label, size_t n){
+    return KokkosKernels::Impl::kk_get_workspace_view<view_t>(this->workspace, label, n);
+  }
+
 };
 
 }
@@ -214,6 +214,22 @@ struct HashmapAccumulator{
     return 0;
   }
 
+  //used in the masked spgemm, where the hashmap holds the mask row.
+  //as in the triangle counting, it does not insert the key if it is not
+  //already there. Returns the index of the key, or -1 if it is not found.
+  KOKKOS_INLINE_FUNCTION
+  size_type sequential_find_index (
+      size_type hash,
+      key_type key) const {
+    size_type i = hash_begins[hash];
+    for (; i != -1; i = hash_nexts[i]){
+      if (keys[i] == key){
+        return i;
+      }
+    }
+    return -1;
+  }
+
   //this is used in slow triangle counting method.
   //L x Incidence
   KOKKOS_INLINE_FUNCTION
@@ -728,6 +744,203 @@ struct HashmapAccumulator{
 
 };
 
+/**
+ * Open addressing variant of HashmapAccumulator with linear probing.
+ * hash_slots_ has hash_key_size entries, hash_key_size a power of 2 not
+ * smaller than the max value size, all initialized to -1. A slot holds the
+ * index of its key in keys/values, so the keys and values stay compact in
+ * [0, used_size) as in HashmapAccumulator, and the lanes of a vector probe
+ * consecutive slots instead of following the linked lists.
+ * It can be built with the arguments of HashmapAccumulator, hash_begins_ are
+ * then used as the slots and hash_nexts_ are not read.
+ */
+template <typename size_type, typename key_type, typename value_type>
+struct LinearProbingHashmapAccumulator{
+  size_type hash_key_size;
+  size_type max_value_size;
+  size_type used_size;
+
+  size_type *hash_slots;
+  key_type *keys;
+  value_type *values;
+  const int INSERT_SUCCESS;
+  const int INSERT_FULL;
+
+  KOKKOS_INLINE_FUNCTION
+  LinearProbingHashmapAccumulator ():
+        hash_key_size(),
+        max_value_size(),
+        used_size(0),
+        hash_slots(),
+        keys(),
+        values(), INSERT_SUCCESS(0), INSERT_FULL(1){}
+
+  /**
+   * Assumption: hash_slots_ are all initialized to -1.
+   */
+  KOKKOS_INLINE_FUNCTION
+  LinearProbingHashmapAccumulator (
+      const size_type hash_key_size_,
+      const size_type value_size_,
+      size_type *hash_slots_,
+      key_type *keys_,
+      value_type *values_):
+
+        hash_key_size(hash_key_size_),
+        max_value_size(value_size_),
+        used_size(0),
+        hash_slots(hash_slots_),
+        keys(keys_),
+        values(values_), INSERT_SUCCESS(0), INSERT_FULL(1){}
+
+  /**
+   * Assumption: hash_begins_ are all initialized to -1.
+   */
+  KOKKOS_INLINE_FUNCTION
+  LinearProbingHashmapAccumulator (
+      const size_type hash_key_size_,
+      const size_type value_size_,
+      size_type *hash_begins_,
+      size_type * /*hash_nexts_*/,
+      key_type *keys_,
+      value_type *values_):
+
+        hash_key_size(hash_key_size_),
+        max_value_size(value_size_),
+        used_size(0),
+        hash_slots(hash_begins_),
+        keys(keys_),
+        values(values_), INSERT_SUCCESS(0), INSERT_FULL(1){}
+
+  //function to be called from device.
+  //Accumulation is Add operation.
+  //Insertion is sequential, no race condition for the insertion.
+  KOKKOS_INLINE_FUNCTION
+  int sequential_insert_into_hash_mergeAdd (
+      size_type hash,
+      key_type key,
+      value_type value){
+    const size_type hash_mask = hash_key_size - 1;
+    for (size_type probe = 0; probe < hash_key_size; ++probe){
+      const size_type slot = (hash + probe) & hash_mask;
+      const size_type i = hash_slots[slot];
+      if (i == -1){
+        if (used_size >= max_value_size){
+          return INSERT_FULL;
+        }
+        keys[used_size] = key;
+        values[used_size] = value;
+        hash_slots[slot] = used_size++;
+        return INSERT_SUCCESS;
+      }
+      if (keys[i] == key){
+        values[i] = values[i] + value;
+        return INSERT_SUCCESS;
+      }
+    }
+    return INSERT_FULL;
+  }
+
+  //function to be called from device.
+  //Accumulation is Add operation. It is not atomicAdd, as this
+  //is for the cases where we know that none of the simultanous
+  //insertions will have the same key.
+  //Insertion is simulteanous for the vector lanes of a thread.
+  //used_size should be a shared pointer among the thread vectors
+  //A lane reserves its index in keys/values when it first finds an empty
+  //slot, and keeps probing with it if another key takes that slot first.
+  template <typename team_member_t>
+  KOKKOS_INLINE_FUNCTION
+  int vector_atomic_insert_into_hash_mergeAdd (
+      const team_member_t & teamMember,
+      const int vector_size,
+      size_type &hash,
+      const key_type key,
+      const value_type value,
+      volatile size_type *used_size_,
+      const size_type max_value_size_ ){
+    if (hash == -1){
+      return INSERT_SUCCESS;
+    }
+    const size_type hash_mask = hash_key_size - 1;
+    size_type my_write_index = -1;
+    for (size_type probe = 0; probe < hash_key_size; ++probe){
+      const size_type slot = (hash + probe) & hash_mask;
+      size_type i = ((volatile size_type *) hash_slots)[slot];
+      if (i == -1){
+        if (my_write_index == -1){
+          if (used_size_[0] >= max_value_size_){
+            return INSERT_FULL;
+          }
+          my_write_index = Kokkos::atomic_fetch_add(used_size_, size_type(1));
+          if (my_write_index >= max_value_size_) {
+            return INSERT_FULL;
+          }
+          keys[my_write_index] = key;
+          values[my_write_index] = value;
+          //the key has to be visible before the slot is published.
+          Kokkos::memory_fence();
+        }
+        i = Kokkos::atomic_compare_exchange(hash_slots + slot, size_type(-1), my_write_index);
+        if (i == -1){
+          return INSERT_SUCCESS;
+        }
+      }
+      //no other lane inserts the same key, so a key found after reserving
+      //an index is a different key.
+      if (my_write_index == -1 && ((volatile key_type *) keys)[i] == key){
+        values[i] = values[i] + value;
+        return INSERT_SUCCESS;
+      }
+    }
+    return INSERT_FULL;
+  }
+
+  //used in symbolic phases if the values are not needed.
+  template <typename team_member_t>
+  KOKKOS_INLINE_FUNCTION
+  int vector_atomic_insert_into_hash (
+      const team_member_t & teamMember,
+      const int &vector_size,
+      size_type &hash,
+      const key_type &key,
+      volatile size_type *used_size_,
+      const size_type &max_value_size_){
+    if (hash == -1){
+      return INSERT_SUCCESS;
+    }
+    const size_type hash_mask = hash_key_size - 1;
+    size_type my_write_index = -1;
+    for (size_type probe = 0; probe < hash_key_size; ++probe){
+      const size_type slot = (hash + probe) & hash_mask;
+      size_type i = ((volatile size_type *) hash_slots)[slot];
+      if (i == -1){
+        if (my_write_index == -1){
+          if (used_size_[0] >= max_value_size_){
+            return INSERT_FULL;
+          }
+          my_write_index = Kokkos::atomic_fetch_add(used_size_, size_type(1));
+          if (my_write_index >= max_value_size_) {
+            return INSERT_FULL;
+          }
+          keys[my_write_index] = key;
+          Kokkos::memory_fence();
+        }
+        i = Kokkos::atomic_compare_exchange(hash_slots + slot, size_type(-1), my_write_index);
+        if (i == -1){
+          return INSERT_SUCCESS;
+        }
+      }
+      if (my_write_index == -1 && ((volatile key_type *) keys)[i] == key){
+        return INSERT_SUCCESS;
+      }
+    }
+    return INSERT_FULL;
+  }
+};
+
+
+
 
 
 }
@@ -53,7 +53,15 @@
 #include "Kokkos_ArithTraits.hpp"
 #include <Kokkos_Core.hpp>
 #include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosKernels_FirstTouch.hpp"
+#include <cstring>
+#include <stdint.h>
 #include <sys/stat.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 namespace KokkosKernels{
 
@@ -231,29 +239,31 @@ crsMat_t kk_generate_diagonally_dominant_sparse_matrix(
       values, xadj, adj);
 
   row_map_view_t rowmap_view("rowmap_view", nrows+1);
-  cols_view_t columns_view("colsmap_view", nnz);
-  values_view_t values_view("values_view", nnz);
-
   {
     typename row_map_view_t::HostMirror hr = Kokkos::create_mirror_view (rowmap_view);
-    typename cols_view_t::HostMirror hc = Kokkos::create_mirror_view (columns_view);
-    typename values_view_t::HostMirror hv = Kokkos::create_mirror_view (values_view);
-
     for (lno_t i = 0; i <= nrows; ++i){
       hr(i) = xadj[i];
     }
+    Kokkos::deep_copy (rowmap_view , hr);
+  }
+
+  //the entries are filled serially, touch them first in parallel.
+  crsMat_t crsmat = kk_allocate_first_touch_crs_matrix<crsMat_t>(ncols, rowmap_view, nnz);
+  cols_view_t columns_view = crsmat.graph.entries;
+  values_view_t values_view = crsmat.values;
+
+  {
+    typename cols_view_t::HostMirror hc = Kokkos::create_mirror_view (columns_view);
+    typename values_view_t::HostMirror hv = Kokkos::create_mirror_view (values_view);
 
     for (size_type i = 0; i < nnz; ++i){
       hc(i) = adj[i];
       hv(i) = values[i];
     }
-    Kokkos::deep_copy (rowmap_view , hr);
     Kokkos::deep_copy (columns_view , hc);
     Kokkos::deep_copy (values_view , hv);
   }
 
-  graph_t static_graph (columns_view, rowmap_view);
-  crsMat_t crsmat("CrsMatrix", ncols, values_view, static_graph);
   delete [] xadj; delete [] adj; delete [] values;
   return crsmat;
 }
@@ -287,30 +297,32 @@ crsMat_t kk_generate_triangular_sparse_matrix(
       values, xadj, adj);
 
   row_map_view_t rowmap_view("rowmap_view", nrows+1);
-  cols_view_t columns_view("colsmap_view", nnz);
-  values_view_t values_view("values_view", nnz);
-
   {
     typename row_map_view_t::HostMirror hr = Kokkos::create_mirror_view (rowmap_view);
-    typename cols_view_t::HostMirror hc = Kokkos::create_mirror_view (columns_view);
-    typename values_view_t::HostMirror hv = Kokkos::create_mirror_view (values_view);
-
     for (lno_t i = 0; i <= nrows; ++i){
       hr(i) = xadj[i];
     }
+    Kokkos::deep_copy (rowmap_view , hr);
+  }
+
+  //the entries are filled serially, touch them first in parallel.
+  crsMat_t crsmat = kk_allocate_first_touch_crs_matrix<crsMat_t>(ncols, rowmap_view, nnz);
+  cols_view_t columns_view = crsmat.graph.entries;
+  values_view_t values_view = crsmat.values;
+
+  {
+    typename cols_view_t::HostMirror hc = Kokkos::create_mirror_view (columns_view);
+    typename values_view_t::HostMirror hv = Kokkos::create_mirror_view (values_view);
 
     for (size_type i = 0; i < nnz; ++i){
       hc(i) = adj[i];
       hv(i) = values[i];
     }
-    Kokkos::deep_copy (rowmap_view , hr);
     Kokkos::deep_copy (columns_view , hc);
     Kokkos::deep_copy (values_view , hv);
     Kokkos::fence();
   }
 
-  graph_t static_graph (columns_view, rowmap_view);
-  crsMat_t crsmat("CrsMatrix", ncols, values_view, static_graph);
   delete [] xadj; delete [] adj; delete [] values;
   return crsmat;
 }
@@ -341,30 +353,32 @@ crsMat_t kk_generate_sparse_matrix(
       values, xadj, adj);
 
   row_map_view_t rowmap_view("rowmap_view", nrows+1);
-  cols_view_t columns_view("colsmap_view", nnz);
-  values_view_t values_view("values_view", nnz);
-
   {
     typename row_map_view_t::HostMirror hr = Kokkos::create_mirror_view (rowmap_view);
-    typename cols_view_t::HostMirror hc = Kokkos::create_mirror_view (columns_view);
-    typename values_view_t::HostMirror hv = Kokkos::create_mirror_view (values_view);
-
     for (lno_t i = 0; i <= nrows; ++i){
       hr(i) = xadj[i];
     }
+    Kokkos::deep_copy (rowmap_view , hr);
+  }
+
+  //the entries are filled serially, touch them first in parallel.
+  crsMat_t crsmat = kk_allocate_first_touch_crs_matrix<crsMat_t>(ncols, rowmap_view, nnz);
+  cols_view_t columns_view = crsmat.graph.entries;
+  values_view_t values_view = crsmat.values;
+
+  {
+    typename cols_view_t::HostMirror hc = Kokkos::create_mirror_view (columns_view);
+    typename values_view_t::HostMirror hv = Kokkos::create_mirror_view (values_view);
 
     for (size_type i = 0; i < nnz; ++i){
       hc(i) = adj[i];
       hv(i) = values[i];
     }
-    Kokkos::deep_copy (rowmap_view , hr);
     Kokkos::deep_copy (columns_view , hc);
     Kokkos::deep_copy (values_view , hv);
     Kokkos::fence();
   }
 
-  graph_t static_graph (columns_view, rowmap_view);
-  crsMat_t crsmat("CrsMatrix", ncols, values_view, static_graph);
   delete [] xadj; delete [] adj; delete [] values;
   return crsmat;
 }
@@ -782,6 +796,277 @@ inline bool endswith (std::string const &fullString, std::string const &ending)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+// Mapped binary CRS format (.kkcrs)
+////////////////////////////////////////////////////////////////////////////////
+
+// Layout of a .kkcrs file, in native byte order: this header, then
+// row_map, entries and values, each starting at a multiple of
+// kk_crs_file_alignment so that the arrays of a memory mapped file can
+// be used in place.
+enum : uint32_t { kk_crs_file_version = 1 };
+enum : uint64_t { kk_crs_file_alignment = 64 };
+enum : uint32_t { kk_crs_file_symmetric = 1, kk_crs_file_sorted_rows = 2 };
+
+struct kk_crs_file_header{
+  char magic[8];              // "KKCRSBIN"
+  uint32_t version;
+  uint32_t byte_order;        // 0x01020304
+  uint32_t ordinal_type, offset_type, scalar_type;     // kk_crs_file_type
+  uint32_t ordinal_bytes, offset_bytes, scalar_bytes;
+  uint32_t flags;
+  uint32_t reserved;
+  uint64_t nrows, ncols, nnz;
+  uint64_t row_map_offset, entries_offset, values_offset, file_bytes;
+  uint64_t checksum;
+  uint64_t padding[2];
+};
+
+// Type codes of the arrays; 0 for other types, which are then
+// only checked by size.
+template <typename T>
+struct kk_crs_file_type{
+  enum : uint32_t { value = std::is_integral<T>::value ?
+      (std::is_signed<T>::value ? (sizeof(T) == 4 ? 1 : sizeof(T) == 8 ? 2 : 0)
+                                : (sizeof(T) == 4 ? 3 : sizeof(T) == 8 ? 4 : 0)) : 0 };
+};
+template <> struct kk_crs_file_type<float>{ enum : uint32_t { value = 5 }; };
+template <> struct kk_crs_file_type<double>{ enum : uint32_t { value = 6 }; };
+template <> struct kk_crs_file_type<Kokkos::complex<float> >{ enum : uint32_t { value = 7 }; };
+template <> struct kk_crs_file_type<Kokkos::complex<double> >{ enum : uint32_t { value = 8 }; };
+
+// Order dependent hash of each 1 MB block of an array, summed over the
+// blocks so that it can be computed in parallel.
+struct CrsFileChecksum{
+  enum : size_t { block_bytes = 1 << 20 };
+  const char *data;
+  size_t bytes;
+  size_t first_block;         // index of the block at data in the array
+
+  CrsFileChecksum(const char *data_, size_t bytes_, size_t first_block_ = 0):
+    data(data_), bytes(bytes_), first_block(first_block_){}
+
+  void operator()(const size_t b, uint64_t &sum) const {
+    const size_t begin = b * block_bytes, end = std::min(bytes, begin + block_bytes);
+    uint64_t h = 0xcbf29ce484222325ULL ^ ((first_block + b) * 0x9e3779b97f4a7c15ULL);
+    for (size_t i = begin; i < end; i += 8){
+      uint64_t w = 0;
+      memcpy(&w, data + i, std::min(size_t(8), end - i));
+      h = (h ^ w) * 0x100000001b3ULL;
+      h ^= h >> 29;
+    }
+    sum += h;
+  }
+};
+
+// Checksum of bytes at data, which start at block first_block of an
+// array; the checksums of consecutive pieces of an array add up.
+inline uint64_t kk_crs_file_checksum(const void *data, size_t bytes, size_t first_block = 0){
+  uint64_t sum = 0;
+  const size_t num_blocks = (bytes + CrsFileChecksum::block_bytes - 1) / CrsFileChecksum::block_bytes;
+  Kokkos::parallel_reduce("KokkosKernels::kk_crs_file_checksum",
+      Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, num_blocks),
+      CrsFileChecksum(static_cast<const char *>(data), bytes, first_block), sum);
+  return sum;
+}
+
+inline uint64_t kk_crs_file_combine_checksums(const uint64_t c0, const uint64_t c1, const uint64_t c2){
+  return c0 ^ ((c1 << 21) | (c1 >> 43)) ^ ((c2 << 42) | (c2 >> 22));
+}
+
+inline uint64_t kk_crs_file_checksum(const void *row_map, const void *entries, const void *values,
+    const kk_crs_file_header &h){
+  return kk_crs_file_combine_checksums(
+      kk_crs_file_checksum(row_map, (h.nrows + 1) * h.offset_bytes),
+      kk_crs_file_checksum(entries, h.nnz * h.ordinal_bytes),
+      kk_crs_file_checksum(values, h.nnz * h.scalar_bytes));
+}
+
+inline uint64_t kk_crs_file_align(const uint64_t offset){
+  return (offset + kk_crs_file_alignment - 1) / kk_crs_file_alignment * kk_crs_file_alignment;
+}
+
+/**
+ * \brief Writes a CrsMatrix to a .kkcrs file, which
+ * kk_mapped_crs_file maps back without parsing or copying.
+ *
+ * The rows are checked for sorted columns, and the result is recorded
+ * in the header together with is_symmetric, which the caller asserts.
+ */
+template <typename crs_matrix_t>
+void write_kokkos_crst_matrix_mapped(crs_matrix_t a_crsmat, const char *filename,
+    bool is_symmetric = false){
+
+  typedef typename crs_matrix_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_value_type size_type;
+  typedef typename graph_t::entries_type::non_const_value_type lno_t;
+  typedef typename crs_matrix_t::values_type::non_const_value_type scalar_t;
+
+  typename graph_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view (a_crsmat.graph.row_map);
+  typename graph_t::entries_type::HostMirror hc = Kokkos::create_mirror_view (a_crsmat.graph.entries);
+  typename crs_matrix_t::values_type::HostMirror hv = Kokkos::create_mirror_view (a_crsmat.values);
+  Kokkos::deep_copy (hr, a_crsmat.graph.row_map);
+  Kokkos::deep_copy (hc, a_crsmat.graph.entries);
+  Kokkos::deep_copy (hv, a_crsmat.values);
+
+  const lno_t nrows = a_crsmat.numRows();
+  const size_type zero_offset = 0;
+  const size_type *row_map_data = hr.extent(0) > 0 ? hr.data() : &zero_offset;
+  const size_type nnz = row_map_data[nrows];
+  bool sorted = true;
+  for (lno_t i = 0; i < nrows && sorted; ++i)
+    for (size_type k = hr(i) + 1; k < hr(i + 1); ++k)
+      if (hc(k) < hc(k - 1)) { sorted = false; break; }
+
+  kk_crs_file_header h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, "KKCRSBIN", 8);
+  h.version = kk_crs_file_version;
+  h.byte_order = 0x01020304;
+  h.ordinal_type = kk_crs_file_type<lno_t>::value;
+  h.offset_type = kk_crs_file_type<size_type>::value;
+  h.scalar_type = kk_crs_file_type<scalar_t>::value;
+  h.ordinal_bytes = sizeof(lno_t);
+  h.offset_bytes = sizeof(size_type);
+  h.scalar_bytes = sizeof(scalar_t);
+  h.flags = (is_symmetric ? kk_crs_file_symmetric : 0) | (sorted ? kk_crs_file_sorted_rows : 0);
+  h.nrows = nrows;
+  h.ncols = a_crsmat.numCols();
+  h.nnz = nnz;
+  h.row_map_offset = kk_crs_file_align(sizeof(h));
+  h.entries_offset = kk_crs_file_align(h.row_map_offset + (h.nrows + 1) * h.offset_bytes);
+  h.values_offset = kk_crs_file_align(h.entries_offset + h.nnz * h.ordinal_bytes);
+  h.file_bytes = kk_crs_file_align(h.values_offset + h.nnz * h.scalar_bytes);
+  h.checksum = kk_crs_file_checksum(row_map_data, hc.data(), hv.data(), h);
+
+  std::ofstream myFile (filename, std::ios::out | std::ios::binary);
+  if (!myFile.is_open()) {
+    throw std::runtime_error ("File cannot be opened\n");
+  }
+  const char zeros[kk_crs_file_alignment] = {};
+  myFile.write((const char *) &h, sizeof(h));
+  myFile.write(zeros, h.row_map_offset - sizeof(h));
+  myFile.write((const char *) row_map_data, (h.nrows + 1) * h.offset_bytes);
+  myFile.write(zeros, h.entries_offset - h.row_map_offset - (h.nrows + 1) * h.offset_bytes);
+  myFile.write((const char *) hc.data(), h.nnz * h.ordinal_bytes);
+  myFile.write(zeros, h.values_offset - h.entries_offset - h.nnz * h.ordinal_bytes);
+  myFile.write((const char *) hv.data(), h.nnz * h.scalar_bytes);
+  myFile.write(zeros, h.file_bytes - h.values_offset - h.nnz * h.scalar_bytes);
+  myFile.close();
+  if (!myFile) {
+    throw std::runtime_error ("File cannot be written\n");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Compressed graph format (.kkcg)
+////////////////////////////////////////////////////////////////////////////////
+
+// Layout of a .kkcg file, in native byte order: this header, the block
+// index and the blocks. Block b holds the rows from b * rows_per_block
+// up to (b + 1) * rows_per_block; each row is coded as its degree, its
+// first column and the gaps between its sorted columns, all as LEB128
+// variable-byte integers. The index holds num_blocks + 1 byte offsets of the blocks
+// from data_offset, followed by num_blocks + 1 entry offsets, so that
+// the blocks are decoded independently.
+enum : uint32_t { kk_graph_file_version = 1 };
+
+struct kk_graph_file_header{
+  char magic[8];              // "KKCGRAPH"
+  uint32_t version;
+  uint32_t byte_order;        // 0x01020304
+  uint32_t rows_per_block;
+  uint32_t reserved;
+  uint64_t nrows, ncols, nnz, num_blocks;
+  uint64_t index_offset, data_offset, file_bytes;
+  uint64_t padding[6];
+};
+
+inline void kk_varint_encode(uint64_t v, std::vector<unsigned char> &out){
+  while (v >= 0x80){
+    out.push_back((unsigned char) (v | 0x80));
+    v >>= 7;
+  }
+  out.push_back((unsigned char) v);
+}
+
+// Encodes the rows of each block, with the columns of each row sorted.
+template <typename lno_t, typename size_type>
+struct GraphFileEncodeBlocks{
+  lno_t nrows;
+  const size_type *xadj;
+  const lno_t *adj;
+  size_t rows_per_block;
+  std::vector<std::vector<unsigned char> > *blocks;
+
+  GraphFileEncodeBlocks(lno_t nrows_, const size_type *xadj_, const lno_t *adj_, size_t rows_per_block_,
+      std::vector<std::vector<unsigned char> > *blocks_):
+    nrows(nrows_), xadj(xadj_), adj(adj_), rows_per_block(rows_per_block_), blocks(blocks_){}
+
+  void operator()(const size_t b) const {
+    std::vector<unsigned char> &out = (*blocks)[b];
+    std::vector<lno_t> row;
+    const size_t end = std::min(size_t(nrows), (b + 1) * rows_per_block);
+    for (size_t i = b * rows_per_block; i < end; ++i){
+      row.assign(adj + xadj[i], adj + xadj[i + 1]);
+      std::sort(row.begin(), row.end());
+      kk_varint_encode(row.size(), out);
+      for (size_t k = 0; k < row.size(); ++k)
+        kk_varint_encode(uint64_t(k == 0 ? row[k] : row[k] - row[k - 1]), out);
+    }
+  }
+};
+
+/**
+ * \brief Writes the graph (xadj, adj) of nv rows and ncols columns to a
+ * compressed .kkcg file, encoding blocks of rows_per_block rows in
+ * parallel. The columns of each row are written sorted.
+ */
+template <typename lno_t, typename size_type>
+void write_graph_compressed(lno_t nv, lno_t ncols, const size_type *xadj, const lno_t *adj,
+    const char *filename, size_t rows_per_block = 1024){
+
+  kk_graph_file_header h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, "KKCGRAPH", 8);
+  h.version = kk_graph_file_version;
+  h.byte_order = 0x01020304;
+  h.rows_per_block = uint32_t(std::max(size_t(1), rows_per_block));
+  h.nrows = nv;
+  h.ncols = ncols;
+  h.nnz = nv > 0 ? xadj[nv] : 0;
+  h.num_blocks = (h.nrows + h.rows_per_block - 1) / h.rows_per_block;
+
+  std::vector<std::vector<unsigned char> > blocks (h.num_blocks);
+  if (h.num_blocks > 0)
+    Kokkos::parallel_for("KokkosKernels::write_graph_compressed",
+        Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, h.num_blocks),
+        GraphFileEncodeBlocks<lno_t, size_type>(nv, xadj, adj, h.rows_per_block, &blocks));
+
+  std::vector<uint64_t> index (2 * (h.num_blocks + 1), 0);
+  for (uint64_t b = 0; b < h.num_blocks; ++b){
+    index[b + 1] = index[b] + blocks[b].size();
+    index[h.num_blocks + 1 + b + 1] =
+      xadj[std::min(h.nrows, (b + 1) * h.rows_per_block)];
+  }
+  h.index_offset = sizeof(h);
+  h.data_offset = h.index_offset + index.size() * sizeof(uint64_t);
+  h.file_bytes = h.data_offset + index[h.num_blocks];
+
+  std::ofstream myFile (filename, std::ios::out | std::ios::binary);
+  if (!myFile.is_open()) {
+    throw std::runtime_error ("File cannot be opened\n");
+  }
+  myFile.write((const char *) &h, sizeof(h));
+  myFile.write((const char *) &index[0], index.size() * sizeof(uint64_t));
+  for (uint64_t b = 0; b < h.num_blocks; ++b)
+    if (!blocks[b].empty()) myFile.write((const char *) &blocks[b][0], blocks[b].size());
+  myFile.close();
+  if (!myFile) {
+    throw std::runtime_error ("File cannot be written\n");
+  }
+}
+
 template <typename crs_matrix_t>
 void write_kokkos_crst_matrix(crs_matrix_t a_crsmat,const  char *filename){
 
@@ -796,7 +1081,10 @@ void write_kokkos_crst_matrix(crs_matrix_t a_crsmat,const  char *filename){
   typedef typename values_view_t::value_type scalar_t;
 
   std::string strfilename(filename);
-  if (endswith(strfilename, ".mtx")){
+  if (endswith(strfilename, ".kkcrs")){
+    write_kokkos_crst_matrix_mapped(a_crsmat, filename);
+  }
+  else if (endswith(strfilename, ".mtx")){
     write_graph_mtx<lno_t, size_type, scalar_t>(a_crsmat.numRows(),
         a_crsmat.graph.entries.extent(0),
         a_crsmat.graph.row_map.data(),
@@ -811,6 +1099,12 @@ void write_kokkos_crst_matrix(crs_matrix_t a_crsmat,const  char *filename){
         a_crsmat.graph.entries.data(),
         a_crsmat.values.data(),filename);
   }
+  else if (endswith(strfilename, ".kkcg")){
+    write_graph_compressed<lno_t, size_type>(a_crsmat.numRows(),
+        a_crsmat.numCols(),
+        a_crsmat.graph.row_map.data(),
+        a_crsmat.graph.entries.data(),filename);
+  }
   else if (endswith(strfilename, ".ligra")){
     write_graph_ligra<lno_t, size_type, scalar_t>(a_crsmat.numRows(),
         a_crsmat.graph.entries.extent(0),
@@ -1011,6 +1305,871 @@ int read_mtx (
   return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Parallel MatrixMarket reader
+////////////////////////////////////////////////////////////////////////////////
+
+// Read-only contents of a whole file; memory mapped where available,
+// otherwise read into a buffer.
+class kk_mapped_file {
+  char *file_data;
+  size_t file_size;
+  bool writable;
+  std::vector<char> buffer;
+
+  kk_mapped_file(const kk_mapped_file &);
+  kk_mapped_file &operator=(const kk_mapped_file &);
+public:
+  // With writable_, the mapping is private and copy on write, so the
+  // contents may be changed without changing the file.
+  explicit kk_mapped_file(const char *fileName, bool writable_ = false):
+    file_data(NULL), file_size(0), writable(writable_){
+#ifndef _WIN32
+    const int fd = open(fileName, O_RDONLY);
+    if (fd < 0){
+      throw std::runtime_error ("File cannot be opened\n");
+    }
+    struct stat stat_buf;
+    if (fstat(fd, &stat_buf) == 0 && stat_buf.st_size > 0){
+      file_size = size_t(stat_buf.st_size);
+      void *p = mmap(NULL, file_size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED){
+        madvise(p, file_size, MADV_SEQUENTIAL);
+        file_data = static_cast<char *>(p);
+      }
+    }
+    close(fd);
+    if (file_data != NULL) return;
+#endif
+    std::ifstream in (fileName, std::ifstream::in | std::ifstream::binary);
+    if (!in.is_open()) {
+      throw std::runtime_error ("File cannot be opened\n");
+    }
+    in.seekg(0, std::ios::end);
+    buffer.resize(size_t(in.tellg()));
+    in.seekg(0, std::ios::beg);
+    if (!buffer.empty()) in.read(&buffer[0], buffer.size());
+    file_data = buffer.empty() ? NULL : &buffer[0];
+    file_size = buffer.size();
+  }
+
+  ~kk_mapped_file(){
+#ifndef _WIN32
+    if (buffer.empty() && file_data != NULL)
+      munmap(file_data, file_size);
+#endif
+  }
+
+  const char *data() const { return file_data; }
+  char *writable_data() const { return writable ? file_data : NULL; }
+  size_t size() const { return file_size; }
+};
+
+inline bool kk_is_blank(const char c){
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Returns the position after the next newline in [p, end).
+inline const char *kk_next_line(const char *p, const char *end){
+  const char *nl = static_cast<const char *>(memchr(p, '\n', end - p));
+  return nl == NULL ? end : nl + 1;
+}
+
+// Parses a decimal integer at p, independently of the locale.
+inline bool kk_parse_integer(const char *&p, const char *end, long long &v){
+  while (p < end && kk_is_blank(*p)) ++p;
+  bool neg = false;
+  if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+  if (p == end || *p < '0' || *p > '9') return false;
+  long long r = 0;
+  while (p < end && *p >= '0' && *p <= '9') r = 10 * r + (*p++ - '0');
+  v = neg ? -r : r;
+  return true;
+}
+
+// Parses a floating point number at p, independently of the locale.
+// Numbers whose decimal mantissa fits in 53 bits and whose exponent is
+// at most 22 in magnitude are converted exactly with one multiplication
+// or division; others (and inf, nan) fall back to strtod.
+inline bool kk_parse_real(const char *&p, const char *end, double &v){
+  static const double pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  while (p < end && kk_is_blank(*p)) ++p;
+  const char *begin = p;
+  bool neg = false;
+  if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+
+  unsigned long long mantissa = 0;
+  int num_digits = 0, exponent = 0;
+  bool any_digit = false;
+  while (p < end && *p >= '0' && *p <= '9'){
+    if (num_digits < 19){
+      mantissa = 10 * mantissa + (*p - '0');
+      if (mantissa) ++num_digits;
+    }
+    else ++exponent;
+    ++p; any_digit = true;
+  }
+  if (p < end && *p == '.'){
+    ++p;
+    while (p < end && *p >= '0' && *p <= '9'){
+      if (num_digits < 19){
+        mantissa = 10 * mantissa + (*p - '0');
+        if (mantissa) ++num_digits;
+        --exponent;
+      }
+      ++p; any_digit = true;
+    }
+  }
+  if (any_digit && p < end && (*p == 'e' || *p == 'E' || *p == 'd' || *p == 'D')){
+    const char *q = p + 1;
+    long long e = 0;
+    if (q < end && !kk_is_blank(*q) && kk_parse_integer(q, end, e)){
+      exponent += int(std::max(-100000LL, std::min(100000LL, e)));
+      p = q;
+    }
+  }
+
+  if (any_digit && (p == end || kk_is_blank(*p) || *p == '\n') &&
+      mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22){
+    const double m = double(mantissa);
+    v = exponent < 0 ? m / pow10[-exponent] : m * pow10[exponent];
+    if (neg) v = -v;
+    return true;
+  }
+
+  // slow path on a null terminated copy of the token
+  char token[128];
+  size_t len = 0;
+  for (p = begin; p < end && !kk_is_blank(*p) && *p != '\n' && len + 1 < sizeof(token); ++p)
+    token[len++] = (*p == 'd' || *p == 'D') ? 'e' : *p;
+  token[len] = '\0';
+  char *token_end = NULL;
+  v = strtod(token, &token_end);
+  return len > 0 && token_end == token + len;
+}
+
+template <typename scalar_t>
+struct kk_mtx_value{
+  static scalar_t make(const double re, const double /* im */){ return scalar_t(re); }
+};
+
+template <typename T>
+struct kk_mtx_value<Kokkos::complex<T> >{
+  static Kokkos::complex<T> make(const double re, const double im){ return Kokkos::complex<T>(re, im); }
+};
+
+// Counts the entry lines of each chunk of the file.
+template <typename offset_view_t>
+struct MtxCountLines{
+  const char *data;
+  offset_view_t chunk_begin;
+  offset_view_t chunk_counts;
+
+  MtxCountLines(const char *data_, offset_view_t chunk_begin_, offset_view_t chunk_counts_):
+    data(data_), chunk_begin(chunk_begin_), chunk_counts(chunk_counts_){}
+
+  void operator()(const size_t c) const {
+    const char *p = data + chunk_begin(c), *end = data + chunk_begin(c + 1);
+    size_t count = 0;
+    while (p < end){
+      const char *q = p;
+      while (q < end && kk_is_blank(*q)) ++q;
+      if (q < end && *q != '\n' && *q != '%') ++count;
+      p = kk_next_line(q, end);
+    }
+    chunk_counts(c) = count;
+  }
+};
+
+// Parses the entry lines of each chunk into (row, column, value)
+// triplets, in file order; returns the number of invalid lines.
+template <typename offset_view_t, typename lno_view_t, typename scalar_view_t>
+struct MtxParseLines{
+  typedef typename lno_view_t::non_const_value_type lno_t;
+  typedef typename scalar_view_t::non_const_value_type scalar_t;
+
+  const char *data;
+  offset_view_t chunk_begin;
+  offset_view_t chunk_offsets;
+  lno_view_t rows, cols;
+  scalar_view_t vals;
+  long long nr, nc;
+  int num_values;           // 0 for pattern, 1 for real, 2 for complex
+
+  MtxParseLines(const char *data_, offset_view_t chunk_begin_, offset_view_t chunk_offsets_,
+      lno_view_t rows_, lno_view_t cols_, scalar_view_t vals_,
+      long long nr_, long long nc_, int num_values_):
+    data(data_), chunk_begin(chunk_begin_), chunk_offsets(chunk_offsets_),
+    rows(rows_), cols(cols_), vals(vals_), nr(nr_), nc(nc_), num_values(num_values_){}
+
+  void operator()(const size_t c, size_t &num_bad) const {
+    const char *p = data + chunk_begin(c), *end = data + chunk_begin(c + 1);
+    size_t k = chunk_offsets(c);
+    while (p < end){
+      const char *q = p;
+      while (q < end && kk_is_blank(*q)) ++q;
+      if (q < end && *q != '\n' && *q != '%'){
+        long long s = 0, d = 0;
+        double re = 1, im = 0;
+        bool ok = kk_parse_integer(q, end, s) && kk_parse_integer(q, end, d);
+        if (ok && num_values > 0) ok = kk_parse_real(q, end, re);
+        if (ok && num_values > 1) ok = kk_parse_real(q, end, im);
+        if (!ok || s < 1 || s > nr || d < 1 || d > nc){
+          ++num_bad;
+          s = d = 1;
+        }
+        rows(k) = lno_t(s - 1);
+        cols(k) = lno_t(d - 1);
+        vals(k) = kk_mtx_value<scalar_t>::make(re, im);
+        ++k;
+      }
+      p = kk_next_line(q, end);
+    }
+  }
+};
+
+// Counting sort of the edges of the triplets by source.  Edge 2k is
+// triplet k and edge 2k+1 its mirror, so that sorting the edges of a
+// row by (destination, edge) gives the same order for any number of
+// threads.
+template <typename lno_view_t, typename row_view_t, typename edge_view_t>
+struct MtxBuildEdges{
+  typedef typename lno_view_t::non_const_value_type lno_t;
+  typedef typename row_view_t::non_const_value_type size_type;
+
+  lno_view_t rows, cols;
+  row_view_t row_offsets;
+  edge_view_t edges;
+  bool mirror, remove_diagonal, transpose;
+
+  MtxBuildEdges(lno_view_t rows_, lno_view_t cols_, row_view_t row_offsets_, edge_view_t edges_,
+      bool mirror_, bool remove_diagonal_, bool transpose_):
+    rows(rows_), cols(cols_), row_offsets(row_offsets_), edges(edges_),
+    mirror(mirror_), remove_diagonal(remove_diagonal_), transpose(transpose_){}
+
+  lno_t src(const size_t e) const {
+    const size_t k = e >> 1;
+    return ((e & 1) != transpose) ? cols(k) : rows(k);
+  }
+  lno_t dst(const size_t e) const {
+    const size_t k = e >> 1;
+    return ((e & 1) != transpose) ? rows(k) : cols(k);
+  }
+
+  // counts the edges of each row when edges is empty, else places them
+  void add(const size_t e) const {
+    const lno_t s = src(e);
+    if (edges.extent(0) == 0){
+      Kokkos::atomic_fetch_add(&row_offsets(s), size_type(1));
+    }
+    else {
+      const size_type pos = Kokkos::atomic_fetch_add(&row_offsets(s), size_type(1));
+      edges(pos) = e;
+    }
+  }
+
+  void operator()(const size_t k) const {
+    if (rows(k) == cols(k)){
+      if (!remove_diagonal) add(2 * k);
+      return;
+    }
+    add(2 * k);
+    if (mirror) add(2 * k + 1);
+  }
+};
+
+// Sorts the edges of each row and counts the entries that are kept;
+// with symmetrize, repeated destinations are kept once.
+template <typename lno_view_t, typename row_view_t, typename edge_view_t>
+struct MtxSortRows{
+  typedef MtxBuildEdges<lno_view_t, row_view_t, edge_view_t> build_t;
+  typedef typename row_view_t::non_const_value_type size_type;
+  typedef typename lno_view_t::non_const_value_type lno_t;
+
+  build_t build;
+  row_view_t row_offsets, row_map;
+  bool symmetrize;
+
+  struct EdgeLess{
+    const build_t *b;
+    bool operator()(const size_t a, const size_t c) const {
+      const lno_t da = b->dst(a), dc = b->dst(c);
+      return da < dc || (da == dc && a < c);
+    }
+  };
+
+  MtxSortRows(build_t build_, row_view_t row_offsets_, row_view_t row_map_, bool symmetrize_):
+    build(build_), row_offsets(row_offsets_), row_map(row_map_), symmetrize(symmetrize_){}
+
+  void operator()(const lno_t i) const {
+    const size_type begin = row_offsets(i), end = row_offsets(i + 1);
+    if (end == begin) {
+      row_map(i) = 0;
+      return;
+    }
+    EdgeLess less;
+    less.b = &build;
+    std::sort(&build.edges(begin), &build.edges(begin) + (end - begin), less);
+    size_type n = 1;
+    for (size_type k = begin + 1; k < end; ++k)
+      if (!symmetrize || build.dst(build.edges(k)) != build.dst(build.edges(k - 1))) ++n;
+    row_map(i) = n;
+  }
+};
+
+template <typename lno_view_t, typename scalar_view_t, typename row_view_t, typename edge_view_t,
+          typename entries_view_t, typename values_view_t>
+struct MtxFillRows{
+  typedef MtxBuildEdges<lno_view_t, row_view_t, edge_view_t> build_t;
+  typedef typename row_view_t::non_const_value_type size_type;
+  typedef typename lno_view_t::non_const_value_type lno_t;
+
+  build_t build;
+  scalar_view_t vals;
+  row_view_t row_offsets, row_map;
+  entries_view_t entries;
+  values_view_t values;
+  bool symmetrize;
+
+  MtxFillRows(build_t build_, scalar_view_t vals_, row_view_t row_offsets_, row_view_t row_map_,
+      entries_view_t entries_, values_view_t values_, bool symmetrize_):
+    build(build_), vals(vals_), row_offsets(row_offsets_), row_map(row_map_),
+    entries(entries_), values(values_), symmetrize(symmetrize_){}
+
+  void operator()(const lno_t i) const {
+    size_type write = row_map(i);
+    for (size_type k = row_offsets(i); k < row_offsets(i + 1); ++k){
+      const size_t e = build.edges(k);
+      const lno_t d = build.dst(e);
+      if (symmetrize && k != row_offsets(i) && d == entries(write - 1)) continue;
+      entries(write) = d;
+      values(write) = vals(e >> 1);
+      ++write;
+    }
+  }
+};
+
+/**
+ * \brief Reads a MatrixMarket coordinate file in parallel on the host
+ * execution space and returns it as a crsMat_t.
+ *
+ * The file is memory mapped and split at line boundaries into chunks
+ * that are parsed concurrently with a locale independent number parser;
+ * the CRS arrays are then assembled with a parallel counting sort by
+ * row and a sort of each row by column. The options are those of
+ * read_mtx, and the rows have the same columns in the same order; in
+ * addition, entries may be separated by comment or blank lines, pattern
+ * entries are ones, with symmetrize the first of repeated entries in
+ * file order is kept, and the number of columns is taken from the size
+ * line.
+ */
+template <typename crsMat_t>
+crsMat_t read_mtx_parallel (
+    const char *fileName,
+    bool symmetrize = false, bool remove_diagonal = true,
+    bool transpose = false){
+
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type row_map_view_t;
+  typedef typename graph_t::entries_type::non_const_type cols_view_t;
+  typedef typename crsMat_t::values_type::non_const_type values_view_t;
+
+  typedef typename row_map_view_t::value_type size_type;
+  typedef typename cols_view_t::value_type lno_t;
+  typedef typename values_view_t::value_type scalar_t;
+
+  typedef Kokkos::DefaultHostExecutionSpace host_space_t;
+  typedef Kokkos::View<size_t *, Kokkos::HostSpace> offset_view_t;
+  typedef Kokkos::View<lno_t *, Kokkos::HostSpace> lno_view_t;
+  typedef Kokkos::View<scalar_t *, Kokkos::HostSpace> scalar_view_t;
+  typedef Kokkos::View<size_t *, Kokkos::HostSpace> edge_view_t;
+  typedef typename row_map_view_t::HostMirror host_row_map_view_t;
+  typedef MtxBuildEdges<lno_view_t, host_row_map_view_t, edge_view_t> build_t;
+
+  kk_mapped_file mmf (fileName);
+  const char *p = mmf.data(), *end = mmf.data() + mmf.size();
+
+  // banner line
+  const char *banner_end = kk_next_line(p, end);
+  std::string fline (p, banner_end);
+  if (fline.size() < 2 || fline[0] != '%' || fline[1] != '%'){
+    throw std::runtime_error ("Invalid MM file. Line-1\n");
+  }
+  if (fline.find("vector") != std::string::npos) {
+    throw std::runtime_error ("VECTOR TYPE NOT HANDLED YET\n");
+  }
+  if (fline.find("array") != std::string::npos) {
+    throw std::runtime_error ("ARRAY TYPE NOT HANDLED YET\n");
+  }
+  int num_values = 1;
+  if (fline.find("pattern") != std::string::npos) num_values = 0;
+  else if (fline.find("complex") != std::string::npos) num_values = 2;
+
+  int mtx_sym = 0; //0-general, 1-symmetric, 2-skew-symmetric, 3-hermitian
+  if (fline.find("skew-symmetric") != std::string::npos) mtx_sym = 2;
+  else if (fline.find("symmetric") != std::string::npos) mtx_sym = 1;
+  else if (fline.find("hermitian") != std::string::npos) mtx_sym = 3;
+  if (!symmetrize && (mtx_sym == 2 || mtx_sym == 3)) {
+    throw std::runtime_error ("SKEW-SYMMETRIC and HERMITIAN TYPE NOT HANDLED YET\n");
+  }
+
+  // comments and size line
+  p = banner_end;
+  while (p < end && *p == '%') p = kk_next_line(p, end);
+  long long nr = 0, nc = 0, nnz = 0;
+  if (!kk_parse_integer(p, end, nr) || !kk_parse_integer(p, end, nc) || !kk_parse_integer(p, end, nnz)){
+    throw std::runtime_error ("Invalid MM file. Size line\n");
+  }
+  const char *data_begin = kk_next_line(p, end);
+
+  // chunks of the entry lines, split after a newline
+  const size_t data_size = end - data_begin;
+  size_t num_chunks = 8 * size_t(host_space_t::concurrency());
+  num_chunks = std::max(size_t(1), std::min(num_chunks, data_size / 4096 + 1));
+  offset_view_t chunk_begin ("chunk_begin", num_chunks + 1);
+  offset_view_t chunk_offsets ("chunk_offsets", num_chunks + 1);
+  chunk_begin(0) = data_begin - mmf.data();
+  for (size_t c = 1; c < num_chunks; ++c){
+    const char *q = data_begin + (data_size / num_chunks) * c;
+    q = q == data_begin ? q : kk_next_line(q - 1, end);
+    chunk_begin(c) = std::max(size_t(q - mmf.data()), chunk_begin(c - 1));
+  }
+  chunk_begin(num_chunks) = mmf.size();
+
+  Kokkos::parallel_for("KokkosKernels::read_mtx_parallel::count",
+      Kokkos::RangePolicy<host_space_t>(0, num_chunks),
+      MtxCountLines<offset_view_t>(mmf.data(), chunk_begin, chunk_offsets));
+  size_t num_triplets = 0;
+  for (size_t c = 0; c <= num_chunks; ++c){
+    const size_t count = c < num_chunks ? chunk_offsets(c) : 0;
+    chunk_offsets(c) = num_triplets;
+    num_triplets += count;
+  }
+  if (num_triplets != size_t(nnz)){
+    std::ostringstream os;
+    os << "Invalid MM file. " << num_triplets << " entries are found, " << nnz << " are expected\n";
+    throw std::runtime_error (os.str());
+  }
+
+  lno_view_t rows (Kokkos::ViewAllocateWithoutInitializing("rows"), num_triplets);
+  lno_view_t cols (Kokkos::ViewAllocateWithoutInitializing("cols"), num_triplets);
+  scalar_view_t vals (Kokkos::ViewAllocateWithoutInitializing("vals"), num_triplets);
+  size_t num_bad = 0;
+  Kokkos::parallel_reduce("KokkosKernels::read_mtx_parallel::parse",
+      Kokkos::RangePolicy<host_space_t>(0, num_chunks),
+      MtxParseLines<offset_view_t, lno_view_t, scalar_view_t>
+        (mmf.data(), chunk_begin, chunk_offsets, rows, cols, vals, nr, nc, num_values), num_bad);
+  if (num_bad > 0){
+    std::ostringstream os;
+    os << "Invalid MM file. " << num_bad << " entries cannot be parsed or are out of range\n";
+    throw std::runtime_error (os.str());
+  }
+
+  if (transpose) std::swap(nr, nc);
+  const lno_t nrows = lno_t(nr);
+  const bool mirror = mtx_sym == 1 || symmetrize;
+
+  // counting sort of the edges by row
+  host_row_map_view_t row_offsets ("row_offsets", nrows + 1);
+  Kokkos::parallel_for("KokkosKernels::read_mtx_parallel::count_rows",
+      Kokkos::RangePolicy<host_space_t>(0, num_triplets),
+      build_t(rows, cols, row_offsets, edge_view_t(), mirror, remove_diagonal, transpose));
+  kk_exclusive_parallel_prefix_sum<host_row_map_view_t, host_space_t>(nrows + 1, row_offsets);
+
+  const size_type num_edges = row_offsets(nrows);
+  edge_view_t edges (Kokkos::ViewAllocateWithoutInitializing("edges"), num_edges);
+  host_row_map_view_t cursor (Kokkos::ViewAllocateWithoutInitializing("cursor"), nrows + 1);
+  Kokkos::deep_copy(cursor, row_offsets);
+  const build_t build (rows, cols, cursor, edges, mirror, remove_diagonal, transpose);
+  Kokkos::parallel_for("KokkosKernels::read_mtx_parallel::scatter",
+      Kokkos::RangePolicy<host_space_t>(0, num_triplets), build);
+
+  // sort the rows and assemble
+  row_map_view_t rowmap_view ("rowmap_view", nrows + 1);
+  host_row_map_view_t hr = Kokkos::create_mirror_view (rowmap_view);
+  Kokkos::parallel_for("KokkosKernels::read_mtx_parallel::sort_rows",
+      Kokkos::RangePolicy<host_space_t>(0, nrows),
+      MtxSortRows<lno_view_t, host_row_map_view_t, edge_view_t>(build, row_offsets, hr, symmetrize));
+  kk_exclusive_parallel_prefix_sum<host_row_map_view_t, host_space_t>(nrows + 1, hr);
+
+  const size_type nnzA = hr(nrows);
+  Kokkos::deep_copy (rowmap_view , hr);
+  crsMat_t crsmat = kk_allocate_first_touch_crs_matrix<crsMat_t>(lno_t(nc), rowmap_view, nnzA);
+  cols_view_t columns_view = crsmat.graph.entries;
+  values_view_t values_view = crsmat.values;
+  typename cols_view_t::HostMirror hc = Kokkos::create_mirror_view (columns_view);
+  typename values_view_t::HostMirror hv = Kokkos::create_mirror_view (values_view);
+  Kokkos::parallel_for("KokkosKernels::read_mtx_parallel::fill_rows",
+      Kokkos::RangePolicy<host_space_t>(0, nrows),
+      MtxFillRows<lno_view_t, scalar_view_t, host_row_map_view_t, edge_view_t,
+                  typename cols_view_t::HostMirror, typename values_view_t::HostMirror>
+        (build, vals, row_offsets, hr, hc, hv, symmetrize));
+
+  Kokkos::deep_copy (columns_view , hc);
+  Kokkos::deep_copy (values_view , hv);
+  return crsmat;
+}
+
+// Throws if a .kkcrs header of a file of file_bytes bytes does not
+// describe arrays of the given types inside the file.
+template <typename lno_t, typename size_type, typename scalar_t>
+void kk_check_crs_file_header(const kk_crs_file_header &h, const size_t file_bytes){
+  const char *what = NULL;
+  if (memcmp(h.magic, "KKCRSBIN", 8) != 0) what = "bad magic";
+  else if (h.byte_order != 0x01020304) what = "wrong byte order";
+  else if (h.version != kk_crs_file_version) what = "unsupported version";
+  else if (h.ordinal_bytes != sizeof(lno_t) || h.ordinal_type != kk_crs_file_type<lno_t>::value)
+    what = "ordinal type does not match";
+  else if (h.offset_bytes != sizeof(size_type) || h.offset_type != kk_crs_file_type<size_type>::value)
+    what = "offset type does not match";
+  else if (h.scalar_bytes != sizeof(scalar_t) || h.scalar_type != kk_crs_file_type<scalar_t>::value)
+    what = "scalar type does not match";
+  else if (!(h.file_bytes <= file_bytes &&
+             h.row_map_offset % kk_crs_file_alignment == 0 &&
+             h.entries_offset % kk_crs_file_alignment == 0 &&
+             h.values_offset % kk_crs_file_alignment == 0 &&
+             h.row_map_offset + (h.nrows + 1) * h.offset_bytes <= h.entries_offset &&
+             h.entries_offset + h.nnz * h.ordinal_bytes <= h.values_offset &&
+             h.values_offset + h.nnz * h.scalar_bytes <= h.file_bytes))
+    what = "truncated or bad offsets";
+  if (what != NULL){
+    std::ostringstream os;
+    os << "Invalid .kkcrs file: " << what << "\n";
+    throw std::runtime_error (os.str());
+  }
+}
+
+/**
+ * \brief A .kkcrs file written by write_kokkos_crst_matrix_mapped,
+ * memory mapped and exposed as unmanaged host Views.
+ *
+ * Nothing is parsed or copied: the Views point into the mapping, which
+ * is private and copy on write, so the entries and values may be
+ * modified without changing the file. The Views, and matrices built
+ * from them by crs_matrix(), are valid while this object lives. The
+ * types must match those of the writer; the checksum of the arrays is
+ * verified on request only, since it reads the whole file.
+ */
+template <typename lno_t, typename size_type, typename scalar_t>
+class kk_mapped_crs_file{
+public:
+  typedef Kokkos::View<const size_type *, Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::Unmanaged> > row_map_view_t;
+  typedef Kokkos::View<lno_t *, Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::Unmanaged> > entries_view_t;
+  typedef Kokkos::View<scalar_t *, Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::Unmanaged> > values_view_t;
+
+private:
+  kk_mapped_file file;
+  kk_crs_file_header h;
+
+public:
+  explicit kk_mapped_crs_file(const char *fileName, bool verify_checksum = false):
+    file(fileName, true){
+    if (file.size() < sizeof(h)) {
+      throw std::runtime_error ("Invalid .kkcrs file: too short\n");
+    }
+    memcpy(&h, file.data(), sizeof(h));
+    kk_check_crs_file_header<lno_t, size_type, scalar_t>(h, file.size());
+    if (verify_checksum &&
+        kk_crs_file_checksum(file.data() + h.row_map_offset, file.data() + h.entries_offset,
+                             file.data() + h.values_offset, h) != h.checksum) {
+      throw std::runtime_error ("Invalid .kkcrs file: checksum does not match\n");
+    }
+  }
+
+  lno_t numRows() const { return lno_t(h.nrows); }
+  lno_t numCols() const { return lno_t(h.ncols); }
+  size_type nnz() const { return size_type(h.nnz); }
+  bool isSymmetric() const { return (h.flags & kk_crs_file_symmetric) != 0; }
+  bool hasSortedRows() const { return (h.flags & kk_crs_file_sorted_rows) != 0; }
+
+  row_map_view_t row_map() const {
+    return row_map_view_t(reinterpret_cast<const size_type *>(file.data() + h.row_map_offset), h.nrows + 1);
+  }
+  entries_view_t entries() const {
+    return entries_view_t(reinterpret_cast<lno_t *>(file.writable_data() + h.entries_offset), h.nnz);
+  }
+  values_view_t values() const {
+    return values_view_t(reinterpret_cast<scalar_t *>(file.writable_data() + h.values_offset), h.nnz);
+  }
+
+  /// A CrsMatrix in host memory over the mapped arrays.
+  template <typename crsMat_t>
+  crsMat_t crs_matrix() const {
+    static_assert(std::is_same<typename crsMat_t::memory_space, Kokkos::HostSpace>::value,
+                  "kk_mapped_crs_file::crs_matrix: the matrix must be in HostSpace");
+    typedef typename crsMat_t::StaticCrsGraphType graph_t;
+    graph_t static_graph (entries(), row_map());
+    return crsMat_t("CrsMatrix", numCols(), values(), static_graph);
+  }
+};
+
+// Host memory from which a device copies asynchronously: pinned memory
+// for CUDA, otherwise host memory.
+template <typename memory_space>
+struct kk_staging_space{
+  typedef Kokkos::HostSpace type;
+};
+
+#ifdef KOKKOS_ENABLE_CUDA
+template <>
+struct kk_staging_space<Kokkos::CudaSpace>{
+  typedef Kokkos::CudaHostPinnedSpace type;
+};
+#endif
+
+// Reads dst.extent(0) elements at byte offset of the file into dst, in
+// chunks of about staging_bytes, and returns their checksum if asked.
+// Host accessible Views are read in place. Otherwise each chunk is read
+// into one of two staging buffers and copied asynchronously to dst, so
+// that the next chunk is read while the previous one is uploaded.
+template <typename view_t>
+uint64_t kk_stream_file_to_view(std::ifstream &in, const uint64_t offset, const view_t &dst,
+    const size_t staging_bytes, const bool checksum){
+  typedef typename view_t::non_const_value_type value_t;
+  typedef typename view_t::execution_space exec_space_t;
+  typedef typename view_t::memory_space memory_space_t;
+  typedef typename kk_staging_space<memory_space_t>::type staging_space_t;
+  typedef Kokkos::View<char *, staging_space_t> staging_view_t;
+  typedef Kokkos::View<value_t *, typename view_t::array_layout, staging_space_t,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged> > chunk_view_t;
+  enum : size_t { block_bytes = CrsFileChecksum::block_bytes };
+
+  const bool in_place = Kokkos::Impl::SpaceAccessibility<typename Kokkos::HostSpace::execution_space, memory_space_t>::accessible;
+  const size_t n = dst.extent(0);
+  // whole checksum blocks per chunk, so that the chunk checksums add up
+  const size_t unit = block_bytes / std::min(size_t(block_bytes), sizeof(value_t) & (~sizeof(value_t) + 1));
+  const size_t chunk = std::max(size_t(1), staging_bytes / (unit * sizeof(value_t))) * unit;
+
+  staging_view_t staging[2];
+  if (!in_place && n > 0){
+    const size_t bytes = std::min(chunk, n) * sizeof(value_t);
+    staging[0] = staging_view_t(Kokkos::ViewAllocateWithoutInitializing("staging 0"), bytes);
+    staging[1] = staging_view_t(Kokkos::ViewAllocateWithoutInitializing("staging 1"), bytes);
+  }
+
+  exec_space_t exec;
+  uint64_t sum = 0;
+  in.seekg(offset);
+  for (size_t begin = 0, i = 0; begin < n; begin += chunk, ++i){
+    const size_t len = std::min(chunk, n - begin);
+    const std::pair<size_t, size_t> range (begin, begin + len);
+    value_t *buf = in_place ? dst.data() + begin : reinterpret_cast<value_t *>(staging[i % 2].data());
+    in.read(reinterpret_cast<char *>(buf), len * sizeof(value_t));
+    if (!in) {
+      throw std::runtime_error ("Invalid .kkcrs file: cannot be read\n");
+    }
+    if (checksum) sum += kk_crs_file_checksum(buf, len * sizeof(value_t), begin * sizeof(value_t) / block_bytes);
+    if (!in_place){
+      // the copy of the previous chunk is done, so its buffer may be reused
+      exec.fence();
+      Kokkos::deep_copy(exec, Kokkos::subview(dst, range), chunk_view_t(buf, len));
+    }
+  }
+  exec.fence();
+  return sum;
+}
+
+/**
+ * \brief Reads a .kkcrs file into a crsMat_t, uploading each chunk of
+ * the arrays while the next one is read.
+ *
+ * The host only holds two staging buffers of staging_bytes each, in
+ * pinned memory for CUDA, and none for host accessible matrices, which
+ * are read in place. The checksum is computed on the fly on request.
+ */
+template <typename crsMat_t>
+crsMat_t read_kokkos_crst_matrix_streamed(const char *filename,
+    size_t staging_bytes = size_t(64) << 20, bool verify_checksum = false){
+
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type row_map_view_t;
+  typedef typename graph_t::entries_type::non_const_type cols_view_t;
+  typedef typename crsMat_t::values_type::non_const_type values_view_t;
+
+  typedef typename row_map_view_t::value_type size_type;
+  typedef typename cols_view_t::value_type lno_t;
+  typedef typename values_view_t::value_type scalar_t;
+
+  std::ifstream in (filename, std::ios::in | std::ios::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error ("File cannot be opened\n");
+  }
+  kk_crs_file_header h;
+  in.seekg(0, std::ios::end);
+  const size_t file_bytes = size_t(in.tellg());
+  in.seekg(0, std::ios::beg);
+  if (file_bytes < sizeof(h) || !in.read(reinterpret_cast<char *>(&h), sizeof(h))) {
+    throw std::runtime_error ("Invalid .kkcrs file: too short\n");
+  }
+  kk_check_crs_file_header<lno_t, size_type, scalar_t>(h, file_bytes);
+
+  row_map_view_t rowmap_view (Kokkos::ViewAllocateWithoutInitializing("rowmap_view"), h.nrows + 1);
+  const uint64_t c0 = kk_stream_file_to_view(in, h.row_map_offset, rowmap_view, staging_bytes, verify_checksum);
+
+  //the entries are read by a single thread, touch them first in parallel.
+  crsMat_t crsmat = kk_allocate_first_touch_crs_matrix<crsMat_t>(lno_t(h.ncols), rowmap_view, h.nnz);
+  cols_view_t columns_view = crsmat.graph.entries;
+  values_view_t values_view = crsmat.values;
+
+  const uint64_t c1 = kk_stream_file_to_view(in, h.entries_offset, columns_view, staging_bytes, verify_checksum);
+  const uint64_t c2 = kk_stream_file_to_view(in, h.values_offset, values_view, staging_bytes, verify_checksum);
+  if (verify_checksum && kk_crs_file_combine_checksums(c0, c1, c2) != h.checksum) {
+    throw std::runtime_error ("Invalid .kkcrs file: checksum does not match\n");
+  }
+  return crsmat;
+}
+
+inline bool kk_varint_decode(const unsigned char *&p, const unsigned char *end, uint64_t &v){
+  v = 0;
+  for (int shift = 0; p < end && shift < 64; shift += 7){
+    const unsigned char c = *p++;
+    v |= uint64_t(c & 0x7f) << shift;
+    if (c < 0x80) return true;
+  }
+  return false;
+}
+
+// Decodes each block of a .kkcg file into row_map and entries, and
+// counts the blocks that are not consistent with the header.
+template <typename row_map_view_t, typename entries_view_t>
+struct GraphFileDecodeBlocks{
+  typedef typename row_map_view_t::non_const_value_type size_type;
+  typedef typename entries_view_t::non_const_value_type lno_t;
+
+  const unsigned char *data;
+  const uint64_t *block_offsets, *block_entries;
+  kk_graph_file_header h;
+  row_map_view_t row_map;
+  entries_view_t entries;
+
+  GraphFileDecodeBlocks(const char *file, const kk_graph_file_header &h_,
+      row_map_view_t row_map_, entries_view_t entries_):
+    data(reinterpret_cast<const unsigned char *>(file + h_.data_offset)),
+    block_offsets(reinterpret_cast<const uint64_t *>(file + h_.index_offset)),
+    block_entries(block_offsets + h_.num_blocks + 1),
+    h(h_), row_map(row_map_), entries(entries_){}
+
+  void operator()(const size_t b, size_t &num_bad) const {
+    const unsigned char *p = data + block_offsets[b], *end = data + block_offsets[b + 1];
+    uint64_t k = block_entries[b];
+    const uint64_t k_end = block_entries[b + 1];
+    const uint64_t i_end = std::min(h.nrows, (b + 1) * uint64_t(h.rows_per_block));
+    for (uint64_t i = b * uint64_t(h.rows_per_block); i < i_end; ++i){
+      row_map(i) = size_type(k);
+      uint64_t degree = 0, col = 0, gap = 0;
+      if (!kk_varint_decode(p, end, degree) || degree > k_end - k) { ++num_bad; return; }
+      for (uint64_t j = 0; j < degree; ++j){
+        if (!kk_varint_decode(p, end, gap)) { ++num_bad; return; }
+        col = (j == 0) ? gap : col + gap;
+        if (col >= h.ncols) { ++num_bad; return; }
+        entries(k++) = lno_t(col);
+      }
+    }
+    if (k != k_end || p != end) ++num_bad;
+  }
+};
+
+// Maps a .kkcg file and checks its header and index.
+class kk_mapped_graph_file{
+  kk_mapped_file file;
+  kk_graph_file_header h;
+
+public:
+  explicit kk_mapped_graph_file(const char *fileName): file(fileName){
+    const char *what = NULL;
+    if (file.size() < sizeof(h)) what = "too short";
+    else {
+      memcpy(&h, file.data(), sizeof(h));
+      if (memcmp(h.magic, "KKCGRAPH", 8) != 0) what = "bad magic";
+      else if (h.byte_order != 0x01020304) what = "wrong byte order";
+      else if (h.version != kk_graph_file_version) what = "unsupported version";
+      else if (h.rows_per_block == 0 ||
+               h.num_blocks != (h.nrows + h.rows_per_block - 1) / h.rows_per_block ||
+               h.index_offset % sizeof(uint64_t) != 0 ||
+               h.data_offset < h.index_offset + 2 * (h.num_blocks + 1) * sizeof(uint64_t) ||
+               h.data_offset > file.size() || h.file_bytes > file.size())
+        what = "truncated or bad offsets";
+      else {
+        const uint64_t *offsets = block_offsets(), *first = block_entries();
+        if (offsets[0] != 0 || first[0] != 0 || first[h.num_blocks] != h.nnz ||
+            h.data_offset + offsets[h.num_blocks] != h.file_bytes)
+          what = "bad block index";
+        for (uint64_t b = 0; b < h.num_blocks && what == NULL; ++b)
+          if (offsets[b + 1] < offsets[b] || first[b + 1] < first[b]) what = "bad block index";
+      }
+    }
+    if (what != NULL){
+      std::ostringstream os;
+      os << "Invalid .kkcg file: " << what << "\n";
+      throw std::runtime_error (os.str());
+    }
+  }
+
+  const kk_graph_file_header &header() const { return h; }
+  const uint64_t *block_offsets() const { return reinterpret_cast<const uint64_t *>(file.data() + h.index_offset); }
+  const uint64_t *block_entries() const { return block_offsets() + h.num_blocks + 1; }
+
+  /// Decodes all blocks in parallel into host accessible row_map and entries.
+  template <typename row_map_view_t, typename entries_view_t>
+  void decode(row_map_view_t row_map, entries_view_t entries) const {
+    typedef GraphFileDecodeBlocks<row_map_view_t, entries_view_t> decode_t;
+    size_t num_bad = 0;
+    if (h.num_blocks > 0)
+      Kokkos::parallel_reduce("KokkosKernels::kk_mapped_graph_file::decode",
+          Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, h.num_blocks),
+          decode_t(file.data(), h, row_map, entries), num_bad);
+    row_map(h.nrows) = typename decode_t::size_type(h.nnz);
+    if (num_bad > 0){
+      std::ostringstream os;
+      os << "Invalid .kkcg file: " << num_bad << " blocks cannot be decoded\n";
+      throw std::runtime_error (os.str());
+    }
+  }
+};
+
+template <typename lno_t, typename size_type, typename scalar_t>
+void read_graph_compressed(lno_t *nv, size_type *ne, size_type **xadj, lno_t **adj, scalar_t **ew,
+    const char *filename){
+  typedef Kokkos::View<size_type *, Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::Unmanaged> > row_map_view_t;
+  typedef Kokkos::View<lno_t *, Kokkos::HostSpace, Kokkos::MemoryTraits<Kokkos::Unmanaged> > entries_view_t;
+
+  kk_mapped_graph_file mapped (filename);
+  const kk_graph_file_header &h = mapped.header();
+  *nv = lno_t(h.nrows);
+  *ne = size_type(h.nnz);
+  md_malloc<size_type>(xadj, *nv + 1);
+  md_malloc<lno_t>(adj, *ne);
+  md_malloc<scalar_t>(ew, *ne);
+  mapped.decode(row_map_view_t(*xadj, *nv + 1), entries_view_t(*adj, *ne));
+  std::fill(*ew, *ew + *ne, scalar_t(1));
+}
+
+/**
+ * \brief Reads a compressed .kkcg file into a crsGraph_t. The blocks of
+ * rows are decoded in parallel on the host, into the Views of the graph
+ * when they are host accessible and into host mirrors otherwise.
+ */
+template <typename crsGraph_t>
+crsGraph_t read_kokkos_crst_graph_compressed(const char *filename){
+  typedef typename crsGraph_t::row_map_type::non_const_type row_map_view_t;
+  typedef typename crsGraph_t::entries_type::non_const_type cols_view_t;
+  typedef typename cols_view_t::value_type lno_t;
+
+  kk_mapped_graph_file mapped (filename);
+  const kk_graph_file_header &h = mapped.header();
+  row_map_view_t rowmap_view (Kokkos::ViewAllocateWithoutInitializing("rowmap_view"), h.nrows + 1);
+  cols_view_t columns_view (Kokkos::ViewAllocateWithoutInitializing("colsmap_view"), h.nnz);
+  typename row_map_view_t::HostMirror hr = Kokkos::create_mirror_view (rowmap_view);
+  typename cols_view_t::HostMirror hc = Kokkos::create_mirror_view (columns_view);
+  mapped.decode(hr, hc);
+  Kokkos::deep_copy (rowmap_view , hr);
+  Kokkos::deep_copy (columns_view , hc);
+  return crsGraph_t(columns_view, rowmap_view, lno_t(h.ncols));
+}
+
 template <typename lno_t, typename size_type, typename scalar_t>
 void read_matrix(lno_t *nv, size_type *ne,size_type **xadj, lno_t **adj, scalar_t **ew, const char *filename){
 
@@ -1031,6 +2190,10 @@ void read_matrix(lno_t *nv, size_type *ne,size_type **xadj, lno_t **adj, scalar_
     read_graph_crs(nv, ne,xadj, adj, ew, filename);
   }
 
+  else if (endswith(strfilename, ".kkcg")){
+    read_graph_compressed(nv, ne,xadj, adj, ew, filename);
+  }
+
   else {
     throw std::runtime_error ("Reader is not available\n");
   }
@@ -1048,6 +2211,12 @@ crsMat_t read_kokkos_crst_matrix(const char * filename_){
   typedef typename cols_view_t::value_type   lno_t;
   typedef typename values_view_t::value_type scalar_t;
 
+  if (endswith(std::string(filename_), ".mtx")){
+    return read_mtx_parallel<crsMat_t>(filename_, false, false, false);
+  }
+  if (endswith(std::string(filename_), ".kkcrs")){
+    return read_kokkos_crst_matrix_streamed<crsMat_t>(filename_);
+  }
 
   lno_t nv, *adj;
   size_type *xadj, nnzA;
@@ -1056,24 +2225,27 @@ crsMat_t read_kokkos_crst_matrix(const char * filename_){
       &nv, &nnzA, &xadj, &adj, &values, filename_);
 
   row_map_view_t rowmap_view("rowmap_view", nv+1);
-  cols_view_t columns_view("colsmap_view", nnzA);
-  values_view_t values_view("values_view", nnzA);
-
-
   {
     typename row_map_view_t::HostMirror hr = Kokkos::create_mirror_view (rowmap_view);
-    typename cols_view_t::HostMirror hc = Kokkos::create_mirror_view (columns_view);
-    typename values_view_t::HostMirror hv = Kokkos::create_mirror_view (values_view);
-
     for (lno_t i = 0; i <= nv; ++i){
       hr(i) = xadj[i];
     }
+    Kokkos::deep_copy (rowmap_view , hr);
+  }
+
+  //the entries are copied serially, touch them first in parallel.
+  crsMat_t crsmat = kk_allocate_first_touch_crs_matrix<crsMat_t>(0, rowmap_view, nnzA);
+  cols_view_t columns_view = crsmat.graph.entries;
+  values_view_t values_view = crsmat.values;
+
+  {
+    typename cols_view_t::HostMirror hc = Kokkos::create_mirror_view (columns_view);
+    typename values_view_t::HostMirror hv = Kokkos::create_mirror_view (values_view);
 
     for (size_type i = 0; i < nnzA; ++i){
       hc(i) = adj[i];
       hv(i) = values[i];
     }
-    Kokkos::deep_copy (rowmap_view , hr);
     Kokkos::deep_copy (columns_view , hc);
     Kokkos::deep_copy (values_view , hv);
   }
@@ -1082,11 +2254,9 @@ crsMat_t read_kokkos_crst_matrix(const char * filename_){
   KokkosKernels::Impl::kk_view_reduce_max
       <cols_view_t, typename crsMat_t::execution_space>(nnzA, columns_view, ncols);
   ncols += 1;
-  
-  graph_t static_graph (columns_view, rowmap_view);
-  crsMat_t crsmat("CrsMatrix", ncols, values_view, static_graph);
+
   delete [] xadj; delete [] adj; delete [] values;
-  return crsmat;
+  return crsMat_t("CrsMatrix", ncols, values_view, crsmat.graph);
 }
 
 
@@ -1100,6 +2270,10 @@ crsGraph_t read_kokkos_crst_graph(const char * filename_){
   typedef typename cols_view_t::value_type   lno_t;
   typedef double scalar_t ;
 
+  if (endswith(std::string(filename_), ".kkcg")){
+    return read_kokkos_crst_graph_compressed<crsGraph_t>(filename_);
+  }
+
   lno_t nv, *adj;
   size_type *xadj, nnzA;
   scalar_t *values;
@@ -0,0 +1,123 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+ */
+
+#ifndef _KOKKOSKERNELS_MEMORYFOOTPRINT_HPP
+#define _KOKKOSKERNELS_MEMORYFOOTPRINT_HPP
+
+#include <cstddef>
+#include <ostream>
+#include "Kokkos_Core.hpp"
+
+namespace KokkosKernels{
+
+namespace Impl{
+
+/***
+ * \brief Bytes of the allocation spanned by a view, 0 if it is not allocated.
+ */
+template <typename view_t>
+size_t kk_view_bytes(const view_t &view){
+  return view.span() * sizeof(typename view_t::value_type);
+}
+
+}
+
+/***
+ * \brief Memory held by a kernel handle.
+ * persistent_bytes and temporary_bytes are the views the handle keeps in its
+ * persistent and temporary memory spaces between calls. temporary_peak_bytes
+ * is the largest scratch memory (memory pools, accumulators) a single call
+ * allocated and released.
+ */
+struct MemoryFootprint{
+  size_t persistent_bytes;
+  size_t temporary_bytes;
+  size_t temporary_peak_bytes;
+
+  MemoryFootprint(): persistent_bytes(0), temporary_bytes(0), temporary_peak_bytes(0){}
+
+  template <typename view_t>
+  void add_persistent(const view_t &view){
+    persistent_bytes += Impl::kk_view_bytes(view);
+  }
+
+  template <typename view_t>
+  void add_temporary(const view_t &view){
+    temporary_bytes += Impl::kk_view_bytes(view);
+  }
+
+  /***
+   * \brief Bytes held between calls.
+   */
+  size_t held_bytes() const {
+    return persistent_bytes + temporary_bytes;
+  }
+
+  /***
+   * \brief Bytes held between calls plus the peak of a call.
+   */
+  size_t total_bytes() const {
+    return persistent_bytes + temporary_bytes + temporary_peak_bytes;
+  }
+
+  void print(std::ostream &os) const {
+    os << "persistent_bytes:" << persistent_bytes
+       << " temporary_bytes:" << temporary_bytes
+       << " temporary_peak_bytes:" << temporary_peak_bytes << std::endl;
+  }
+};
+
+namespace Impl{
+
+/***
+ * \brief True if extra_bytes more than the footprint fit into budget; a
+ * budget of 0 means no limit.
+ */
+inline bool kk_fits_memory_budget(size_t budget, const MemoryFootprint &footprint, size_t extra_bytes){
+  return budget == 0 || footprint.held_bytes() + extra_bytes <= budget;
+}
+
+}
+}
+
+#endif
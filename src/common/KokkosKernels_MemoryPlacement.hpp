@@ -0,0 +1,232 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+ */
+
+#ifndef _KOKKOSKERNELS_MEMORYPLACEMENT_HPP
+#define _KOKKOSKERNELS_MEMORYPLACEMENT_HPP
+
+#include <cstddef>
+#include <ostream>
+
+namespace KokkosKernels{
+
+/***
+ * \brief Decides which arrays of a kernel are stored in the fast memory
+ * space (HBM, MCDRAM) of a multi level memory, when the fast memory cannot
+ * hold all of them.
+ * The kernels are described by four arrays, in the bit order of the
+ * --memspaces option of the perf tests: A and B are the inputs, C is the
+ * output and WORK is the memory of the kernel itself (work arrays, the
+ * memory pool of the accumulators). For each array the predict functions
+ * set its size and the bytes the kernel is expected to read or write from
+ * it. place() then fills the fast memory with the arrays that have the
+ * most accesses per byte.
+ */
+class MemoryPlacement{
+public:
+  enum Array: int { A = 0, B = 1, C = 2, WORK = 3, NUM_ARRAYS = 4 };
+
+private:
+  size_t fast_memory_capacity;
+  size_t bytes[NUM_ARRAYS];
+  double accesses[NUM_ARRAYS];
+
+public:
+  /***
+   * \brief capacity is the size of the fast memory in bytes, 0 places
+   * every array in the fast memory.
+   */
+  MemoryPlacement(size_t capacity = 0): fast_memory_capacity(capacity){
+    for (int i = 0; i < NUM_ARRAYS; ++i){
+      bytes[i] = 0;
+      accesses[i] = 0;
+    }
+  }
+
+  void set_fast_memory_capacity(size_t capacity){
+    this->fast_memory_capacity = capacity;
+  }
+  size_t get_fast_memory_capacity() const {
+    return this->fast_memory_capacity;
+  }
+
+  void set_array(Array array, size_t array_bytes, double array_accesses){
+    bytes[array] = array_bytes;
+    accesses[array] = array_accesses;
+  }
+  size_t get_bytes(Array array) const {
+    return bytes[array];
+  }
+  double get_accesses(Array array) const {
+    return accesses[array];
+  }
+
+  /***
+   * \brief Returns the placement as a bitmask, bit i is set if array i
+   * goes to the fast memory. The arrays are taken greedily by accesses per
+   * byte as long as they fit, ties are broken in the order WORK, B, C, A.
+   */
+  int place() const {
+    const int all_arrays = (1 << NUM_ARRAYS) - 1;
+    if (fast_memory_capacity == 0) return all_arrays;
+
+    Array order[NUM_ARRAYS] = {WORK, B, C, A};
+    //insertion sort, stable to keep the tie breaking order.
+    for (int i = 1; i < NUM_ARRAYS; ++i){
+      const Array current = order[i];
+      int j = i;
+      for (; j > 0 && density(current) > density(order[j - 1]); --j){
+        order[j] = order[j - 1];
+      }
+      order[j] = current;
+    }
+
+    int placement = 0;
+    size_t remaining = fast_memory_capacity;
+    for (int i = 0; i < NUM_ARRAYS; ++i){
+      const Array array = order[i];
+      if (bytes[array] <= remaining){
+        remaining -= bytes[array];
+        placement |= (1 << array);
+      }
+    }
+    return placement;
+  }
+
+  static bool is_fast(int placement, Array array){
+    return (placement >> array) & 1;
+  }
+
+  /***
+   * \brief Predicts the arrays of C = A x B, where A is m x k and B is
+   * k x n. flops is the number of multiplications, max_row_flops the
+   * largest number of them in a row of C, and concurrency the number of
+   * threads (or teams) that own an accumulator of the memory pool.
+   * A is read in the symbolic and the numeric phases, and C is written
+   * once. Every multiplication reads an entry of B, and inserts into the
+   * accumulator in both phases, which makes the work arrays the most
+   * accessed ones, followed by B.
+   */
+  template <typename size_type, typename lno_t, typename scalar_t>
+  void predict_spgemm(
+      size_t m, size_t k, size_t /*n*/,
+      size_t nnzA, size_t nnzB, size_t nnzC,
+      size_t flops, size_t max_row_flops, size_t concurrency){
+    const size_t a_bytes = crs_bytes<size_type, lno_t, scalar_t>(m, nnzA);
+    const size_t b_bytes = crs_bytes<size_type, lno_t, scalar_t>(k, nnzB);
+    const size_t c_bytes = crs_bytes<size_type, lno_t, scalar_t>(m, nnzC);
+    //compressed B, and a hashmap of twice the row flops per thread.
+    const size_t work_bytes =
+        (k + 1) * sizeof(size_type) + 2 * nnzB * sizeof(lno_t) +
+        concurrency * 2 * max_row_flops * (3 * sizeof(lno_t) + sizeof(scalar_t));
+
+    set_array(A, a_bytes, 2.0 * a_bytes);
+    set_array(B, b_bytes, double(flops) * (2 * sizeof(lno_t) + sizeof(scalar_t)));
+    set_array(C, c_bytes, double(c_bytes) + (m + 1) * sizeof(size_type));
+    set_array(WORK, work_bytes, 2.0 * flops * (2 * sizeof(lno_t) + sizeof(scalar_t)));
+  }
+
+  /***
+   * \brief Predicts the arrays of num_sweeps Gauss-Seidel sweeps on a
+   * num_rows x num_rows matrix A with nnz entries. B is the right hand side
+   * and C is the left hand side. The numeric phase reads A once to make
+   * the permuted copy of the handle, which is read in every sweep together
+   * with the permuted vectors and the inverse of the diagonal.
+   */
+  template <typename size_type, typename lno_t, typename scalar_t>
+  void predict_gauss_seidel(size_t num_rows, size_t nnz, size_t num_sweeps){
+    const size_t a_bytes = crs_bytes<size_type, lno_t, scalar_t>(num_rows, nnz);
+    const size_t vector_bytes = num_rows * sizeof(scalar_t);
+    const size_t work_bytes = a_bytes + 3 * vector_bytes;
+
+    set_array(A, a_bytes, double(a_bytes));
+    set_array(B, vector_bytes, 2.0 * vector_bytes);
+    set_array(C, vector_bytes, 2.0 * vector_bytes);
+    set_array(WORK, work_bytes, double(num_sweeps) * work_bytes);
+  }
+
+  /***
+   * \brief Predicts the arrays of triangle counting on a graph with
+   * num_rows vertices and nnz edges, which is a masked L x L product of the
+   * lower triangle L of the graph. A and B are the two operands (the same
+   * graph), C holds a count per row. flops and max_row_flops are those of
+   * the product.
+   */
+  template <typename size_type, typename lno_t>
+  void predict_triangle(
+      size_t num_rows, size_t nnz,
+      size_t flops, size_t max_row_flops, size_t concurrency){
+    const size_t graph_bytes = (num_rows + 1) * sizeof(size_type) + nnz * sizeof(lno_t);
+    //compressed L, and a bitmap hashmap of the row flops per thread.
+    const size_t work_bytes =
+        (num_rows + 1) * sizeof(size_type) + nnz * sizeof(lno_t) +
+        concurrency * 2 * max_row_flops * (3 * sizeof(lno_t));
+
+    set_array(A, graph_bytes, 2.0 * graph_bytes);
+    set_array(B, graph_bytes, double(flops) * 2 * sizeof(lno_t));
+    set_array(C, num_rows * sizeof(size_type), double(num_rows * sizeof(size_type)));
+    set_array(WORK, work_bytes, 2.0 * flops * 2 * sizeof(lno_t));
+  }
+
+  void print(std::ostream &os) const {
+    const char *names[NUM_ARRAYS] = {"A", "B", "C", "work"};
+    const int placement = place();
+    for (int i = 0; i < NUM_ARRAYS; ++i){
+      os << names[i] << " bytes:" << bytes[i] << " accesses:" << accesses[i]
+         << (is_fast(placement, Array(i)) ? " fast" : " slow") << std::endl;
+    }
+  }
+
+private:
+  double density(Array array) const {
+    return bytes[array] == 0 ? accesses[array] + 1 : accesses[array] / bytes[array];
+  }
+
+  template <typename size_type, typename lno_t, typename scalar_t>
+  static size_t crs_bytes(size_t num_rows, size_t nnz){
+    return (num_rows + 1) * sizeof(size_type) + nnz * (sizeof(lno_t) + sizeof(scalar_t));
+  }
+};
+
+}
+
+#endif
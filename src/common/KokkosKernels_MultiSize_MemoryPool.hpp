@@ -0,0 +1,314 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSKERNELS_MULTISIZE_MEMPOOL_HPP
+#define _KOKKOSKERNELS_MULTISIZE_MEMPOOL_HPP
+
+#include <Kokkos_Core.hpp>
+#include "KokkosKernels_Utils.hpp"
+#include <vector>
+#include <iostream>
+
+namespace KokkosKernels{
+
+namespace Impl{
+
+/*! \brief Memory pool with chunks of several power of two sizes.
+ *  UniformMemoryPool hands out chunks of a single size, so a single long row
+ *  makes every chunk as large as that row. This pool has size classes
+ *  c = 0, 1, ..., num_classes - 1 with chunks of min_chunk_size * 2^c entries,
+ *  and the number of chunks of each class is set at the constructor, e.g. by the
+ *  number of rows needing that class, bounded by the concurrency.
+ *
+ *  Each class keeps its free chunks in a lock-free stack. The head of the stack
+ *  packs the index of the top chunk with a counter that is incremented by each
+ *  update, so that a chunk released and allocated again between the read and the
+ *  compare-exchange of another thread does not corrupt the stack.
+ *
+ *  allocate_chunk(size) returns a chunk of the smallest class holding size entries,
+ *  or of a larger class if it has no free chunk, or NULL if all such chunks are in use.
+ *  As in UniformMemoryPool, the threads retry until they get a chunk:
+ *
+ *      volatile idx * myData = NULL;
+ *      while (myData == NULL){
+ *        Kokkos::single(Kokkos::PerThread(teamMember),[&] (volatile idx * &memptr) {
+ *          memptr = (volatile idx * )this->my_memory_pool.allocate_chunk(row_size);
+ *        }, myData);
+ *      }
+ *      /////..............work on myData................../////
+ *      Kokkos::single(Kokkos::PerThread(teamMember),[&] () {
+ *        this->my_memory_pool.release_chunk((idx *) myData);
+ *      });
+ *
+ *  The chunks are initialized once at the constructor; as in UniformMemoryPool,
+ *  threads that rely on the initialized values must reset them before the release.
+ */
+template <typename MyExecSpace, typename data_type>
+class MultiSizeMemoryPool{
+public:
+  typedef unsigned long long head_type;
+  typedef unsigned int chunk_index_type;
+
+private:
+  typedef typename Kokkos::View <data_type *, MyExecSpace> data_view_t;
+  typedef typename Kokkos::View <size_t *, MyExecSpace> size_view_t;
+  typedef typename Kokkos::View <head_type *, MyExecSpace> head_view_t;
+  typedef typename Kokkos::View <chunk_index_type *, MyExecSpace> index_view_t;
+
+  static const chunk_index_type empty_chunk = 0xffffffff;
+
+  int num_classes;
+  size_t min_chunk_size;
+  size_t num_chunks;
+  size_t overall_size;
+
+  //offset of the first entry and the index of the first chunk of each class.
+  size_view_t class_offsets;
+  size_view_t class_first_chunks;
+  head_view_t class_heads;
+  index_view_t chunk_nexts;
+  data_view_t data_view;
+  data_type *data;
+
+public:
+
+  /**
+   * \brief MultiSizeMemoryPool constructor.
+   * \param min_chunk_size_: size of the chunks of class 0.
+   * \param num_class_chunks: number of chunks of each class, class c has
+   * chunks of size min_chunk_size_ * 2^c.
+   * \param initialized_value: the value to initialize
+   */
+  MultiSizeMemoryPool(const size_t min_chunk_size_,
+                      const std::vector<size_t> &num_class_chunks,
+                      const data_type initialized_value = 0):
+    num_classes(num_class_chunks.size()),
+    min_chunk_size(min_chunk_size_),
+    num_chunks(0), overall_size(0),
+    class_offsets(), class_first_chunks(), class_heads(), chunk_nexts(),
+    data_view(), data(){
+
+    class_offsets = size_view_t("pool class offsets", num_classes + 1);
+    class_first_chunks = size_view_t("pool class first chunks", num_classes + 1);
+    class_heads = head_view_t("pool class heads", num_classes);
+    typename size_view_t::HostMirror h_class_offsets = Kokkos::create_mirror_view(class_offsets);
+    typename size_view_t::HostMirror h_class_first_chunks = Kokkos::create_mirror_view(class_first_chunks);
+    typename head_view_t::HostMirror h_class_heads = Kokkos::create_mirror_view(class_heads);
+
+    for (int c = 0; c < num_classes; ++c){
+      h_class_offsets(c) = overall_size;
+      h_class_first_chunks(c) = num_chunks;
+      h_class_heads(c) = num_class_chunks[c] ? head_type (num_chunks) : head_type (empty_chunk);
+      overall_size += num_class_chunks[c] * (min_chunk_size << c);
+      num_chunks += num_class_chunks[c];
+    }
+    h_class_offsets(num_classes) = overall_size;
+    h_class_first_chunks(num_classes) = num_chunks;
+
+    //each free chunk points to the next chunk of its class.
+    chunk_nexts = index_view_t(Kokkos::ViewAllocateWithoutInitializing("pool chunk nexts"), num_chunks);
+    typename index_view_t::HostMirror h_chunk_nexts = Kokkos::create_mirror_view(chunk_nexts);
+    for (int c = 0; c < num_classes; ++c){
+      for (size_t i = h_class_first_chunks(c); i < h_class_first_chunks(c + 1); ++i){
+        h_chunk_nexts(i) = i + 1 < h_class_first_chunks(c + 1) ? chunk_index_type (i + 1) : chunk_index_type (empty_chunk);
+      }
+    }
+
+    Kokkos::deep_copy(class_offsets, h_class_offsets);
+    Kokkos::deep_copy(class_first_chunks, h_class_first_chunks);
+    Kokkos::deep_copy(class_heads, h_class_heads);
+    Kokkos::deep_copy(chunk_nexts, h_chunk_nexts);
+
+    if (overall_size > 0){
+      data_view = data_view_t(Kokkos::ViewAllocateWithoutInitializing("pool data"), overall_size);
+      Kokkos::deep_copy(data_view, initialized_value);
+    }
+    data = data_view.data();
+  }
+
+  /**
+   * \brief MultiSizeMemoryPool constructor
+   */
+  MultiSizeMemoryPool():
+    num_classes(0), min_chunk_size(1), num_chunks(0), overall_size(0),
+    class_offsets(), class_first_chunks(), class_heads(), chunk_nexts(),
+    data_view(), data(){}
+
+  ~MultiSizeMemoryPool() = default;
+
+  MultiSizeMemoryPool( MultiSizeMemoryPool && ) = default;
+  MultiSizeMemoryPool( const MultiSizeMemoryPool & ) = default;
+  MultiSizeMemoryPool & operator = ( MultiSizeMemoryPool && ) = default;
+  MultiSizeMemoryPool & operator = ( const MultiSizeMemoryPool & ) = default;
+
+  /**
+   * \brief Returns the smallest class whose chunks hold size entries.
+   */
+  KOKKOS_INLINE_FUNCTION
+  static int get_size_class(const size_t size, const size_t min_chunk_size_){
+    int size_class = 0;
+    while ((min_chunk_size_ << size_class) < size){
+      ++size_class;
+    }
+    return size_class;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  int get_num_classes() const {return num_classes;}
+
+  KOKKOS_INLINE_FUNCTION
+  size_t get_class_chunk_size(const int size_class) const {return min_chunk_size << size_class;}
+
+  size_t get_overall_size() const {return overall_size;}
+  size_t get_num_chunks() const {return num_chunks;}
+
+  /**
+   * \brief Returns a free chunk of at least size entries, or NULL if there is none.
+   */
+  KOKKOS_INLINE_FUNCTION
+  data_type *allocate_chunk(const size_t size) const{
+    for (int c = get_size_class(size, min_chunk_size); c < num_classes; ++c){
+      data_type *chunk_ptr = this->pop_chunk(c);
+      if (chunk_ptr != NULL) return chunk_ptr;
+    }
+    return NULL;
+  }
+
+  /**
+   * \brief Releases a chunk returned by allocate_chunk.
+   */
+  KOKKOS_INLINE_FUNCTION
+  void release_chunk(const data_type *chunk_ptr) const{
+    const size_t offset = chunk_ptr - data;
+    int c = 0;
+    while (class_offsets(c + 1) <= offset){
+      ++c;
+    }
+    const chunk_index_type chunk_index =
+        class_first_chunks(c) + (offset - class_offsets(c)) / (min_chunk_size << c);
+    this->push_chunk(c, chunk_index);
+  }
+
+  /**
+   * \brief Returns the size of a chunk returned by allocate_chunk.
+   */
+  KOKKOS_INLINE_FUNCTION
+  size_t get_chunk_size(const data_type *chunk_ptr) const{
+    const size_t offset = chunk_ptr - data;
+    int c = 0;
+    while (class_offsets(c + 1) <= offset){
+      ++c;
+    }
+    return min_chunk_size << c;
+  }
+
+  /**
+   * \brief Returns the index of the top chunk packed in a stack head.
+   */
+  KOKKOS_INLINE_FUNCTION
+  static chunk_index_type get_head_chunk(const head_type head){
+    return chunk_index_type (head & 0xffffffff);
+  }
+
+  /**
+   * \brief Returns the head that replaces old_head with chunk_index on top.
+   * The counter in the upper 32 bits is incremented and wraps around to 0.
+   */
+  KOKKOS_INLINE_FUNCTION
+  static head_type get_next_head(const head_type old_head, const chunk_index_type chunk_index){
+    return (((old_head >> 32) + 1) << 32) | head_type (chunk_index);
+  }
+
+  /**
+   * \brief Print the sizes of the classes of memory pool
+   */
+  void print_memory_pool() const{
+    typename size_view_t::HostMirror h_class_first_chunks = Kokkos::create_mirror_view(class_first_chunks);
+    Kokkos::deep_copy(h_class_first_chunks, class_first_chunks);
+    std::cout << "num_classes:" << num_classes << std::endl;
+    std::cout << "num_chunks:" << num_chunks << std::endl;
+    std::cout << "overall_size:" << overall_size << std::endl;
+    for (int c = 0; c < num_classes; ++c){
+      std::cout << "class:" << c << " chunk_size:" << (min_chunk_size << c)
+                << " num_chunks:" << h_class_first_chunks(c + 1) - h_class_first_chunks(c) << std::endl;
+    }
+  }
+
+private:
+  KOKKOS_INLINE_FUNCTION
+  data_type *pop_chunk(const int c) const{
+    head_type *head_ptr = &(class_heads(c));
+    head_type old_head = *((volatile head_type *) head_ptr);
+    while (true){
+      const chunk_index_type chunk_index = get_head_chunk(old_head);
+      if (chunk_index == chunk_index_type (empty_chunk)) return NULL;
+      const chunk_index_type next = *((volatile chunk_index_type *) &(chunk_nexts(chunk_index)));
+      const head_type new_head = get_next_head(old_head, next);
+      const head_type prev_head = Kokkos::atomic_compare_exchange(head_ptr, old_head, new_head);
+      if (prev_head == old_head){
+        return data + class_offsets(c) + (chunk_index - class_first_chunks(c)) * (min_chunk_size << c);
+      }
+      old_head = prev_head;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void push_chunk(const int c, const chunk_index_type chunk_index) const{
+    head_type *head_ptr = &(class_heads(c));
+    head_type old_head = *((volatile head_type *) head_ptr);
+    //the writes to the chunk are visible before it can be allocated again.
+    Kokkos::memory_fence();
+    while (true){
+      *((volatile chunk_index_type *) &(chunk_nexts(chunk_index))) = get_head_chunk(old_head);
+      Kokkos::memory_fence();
+      const head_type new_head = get_next_head(old_head, chunk_index);
+      const head_type prev_head = Kokkos::atomic_compare_exchange(head_ptr, old_head, new_head);
+      if (prev_head == old_head) return;
+      old_head = prev_head;
+    }
+  }
+};
+
+}
+}
+
+#endif
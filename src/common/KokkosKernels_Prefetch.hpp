@@ -0,0 +1,120 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+ */
+
+#ifndef _KOKKOSKERNELS_PREFETCH_HPP
+#define _KOKKOSKERNELS_PREFETCH_HPP
+
+#include <cstddef>
+#include "Kokkos_Core.hpp"
+
+namespace KokkosKernels{
+
+namespace Impl{
+
+/*! \brief Prefetch hints for unified memory.
+ *
+ *  Pages of CudaUVMSpace allocations migrate to the device on the first
+ *  access of a kernel, one page fault at a time. When the data was filled
+ *  on the host, these faults can cost more than the kernel itself. The
+ *  functions below ask the driver to migrate the pages asynchronously on
+ *  the stream of the execution space before the kernels run. For all the
+ *  other memory and execution spaces they do nothing.
+ */
+template <typename memory_space, typename exec_space>
+struct PrefetchMemory{
+  static void prefetch(const void *, size_t, const exec_space &, bool){}
+};
+
+#if defined( KOKKOS_ENABLE_CUDA ) && defined( CUDART_VERSION ) && ( CUDART_VERSION >= 8000 )
+template <>
+struct PrefetchMemory<Kokkos::CudaUVMSpace, Kokkos::Cuda>{
+  static void prefetch(const void *ptr, size_t bytes, const Kokkos::Cuda &exec, bool read_mostly){
+    if (ptr == NULL || bytes == 0) return;
+    const int device = exec.cuda_device();
+    if (read_mostly){
+      cudaMemAdvise(ptr, bytes, cudaMemAdviseSetReadMostly, device);
+    }
+    cudaMemPrefetchAsync(ptr, bytes, device, exec.cuda_stream());
+    //the hints are not supported by all the devices, which is not an error.
+    cudaGetLastError();
+  }
+};
+#endif
+
+/**
+ * \brief Prefetches the allocation spanned by a view to the device of
+ * exec. read_mostly also advises the driver that the view is mostly read,
+ * so that its pages can be duplicated instead of migrated when the host
+ * reads them.
+ */
+template <typename view_t, typename exec_space>
+void kk_prefetch_view(const view_t &view, const exec_space &exec, bool read_mostly = false){
+  PrefetchMemory<typename view_t::memory_space, typename exec_space::execution_space>::prefetch(
+      view.data(), view.span() * sizeof(typename view_t::value_type), exec, read_mostly);
+}
+
+/**
+ * \brief Visitor of the views of a handle, see visit_views of the handles,
+ * that prefetches all of them.
+ */
+template <typename exec_space>
+struct MemoryPrefetch{
+  exec_space exec;
+
+  MemoryPrefetch(const exec_space &exec_): exec(exec_){}
+
+  template <typename view_t>
+  void add_persistent(const view_t &view){
+    kk_prefetch_view(view, exec);
+  }
+
+  template <typename view_t>
+  void add_temporary(const view_t &view){
+    kk_prefetch_view(view, exec);
+  }
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,165 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+ */
+
+#ifndef _KOKKOSKERNELS_PROFILING_HPP
+#define _KOKKOSKERNELS_PROFILING_HPP
+
+#include <string>
+#include "Kokkos_Core.hpp"
+#include "impl/Kokkos_Timer.hpp"
+#include "KokkosKernels_config.h"
+
+namespace KokkosKernels{
+
+namespace Impl{
+
+/***
+ * \brief Kokkos Tools region covering the scope of the object, so that the
+ * kernels of a public entry point are nested under its name in the
+ * space-time-stack and nvtx-connector traces. Regions and kernel counts
+ * are removed at compile time with KOKKOSKERNELS_DISABLE_PROFILING_REGIONS.
+ */
+class ProfilingRegion{
+public:
+  explicit ProfilingRegion(const std::string &name){
+    Kokkos::Profiling::pushRegion(name);
+  }
+  ~ProfilingRegion(){
+    Kokkos::Profiling::popRegion();
+  }
+private:
+  ProfilingRegion(const ProfilingRegion &);
+  ProfilingRegion &operator=(const ProfilingRegion &);
+};
+
+}
+
+/***
+ * \brief Receives the analytical counts of one call of a kernel: its name,
+ * the floating point operations, the bytes moved to and from memory
+ * assuming every array is read or written once, and the time of the call,
+ * so that achieved GFLOP/s and GB/s can be derived per call.
+ */
+typedef void (*kernel_counts_callback_type)(const char *name, double flops, double bytes, double seconds);
+
+namespace Impl{
+
+inline kernel_counts_callback_type &kernel_counts_callback(){
+  static kernel_counts_callback_type callback = NULL;
+  return callback;
+}
+
+//the number of fences KernelCounts has issued to time its kernels.
+inline size_t &kernel_counts_num_fences(){
+  static size_t num_fences = 0;
+  return num_fences;
+}
+
+inline void kernel_counts_fence(){
+  Kokkos::fence();
+  ++kernel_counts_num_fences();
+}
+
+}
+
+/***
+ * \brief Registers the callback receiving the counts of spmv, the SpGEMM
+ * numeric phase, the Gauss-Seidel sweeps, gemm and the variable size
+ * batched gemm; NULL removes it. While a callback is registered, these
+ * kernels fence before and after each call to time it.
+ */
+inline void set_kernel_counts_callback(kernel_counts_callback_type callback){
+  Impl::kernel_counts_callback() = callback;
+}
+
+inline kernel_counts_callback_type get_kernel_counts_callback(){
+  return Impl::kernel_counts_callback();
+}
+
+namespace Impl{
+
+/***
+ * \brief Times the scope of the object and reports the given counts to the
+ * registered callback. Does nothing when no callback is registered.
+ */
+class KernelCounts{
+  const char *name;
+  double flops, bytes;
+  kernel_counts_callback_type callback;
+  Kokkos::Impl::Timer timer;
+public:
+  KernelCounts(const char *name_, double flops_, double bytes_):
+    name(name_), flops(flops_), bytes(bytes_), callback(kernel_counts_callback()){
+    if (callback){
+      kernel_counts_fence();
+      timer.reset();
+    }
+  }
+  ~KernelCounts(){
+    if (callback){
+      kernel_counts_fence();
+      callback(name, flops, bytes, timer.seconds());
+    }
+  }
+private:
+  KernelCounts(const KernelCounts &);
+  KernelCounts &operator=(const KernelCounts &);
+};
+
+}
+}
+
+#define KOKKOSKERNELS_PROFILING_REGION_CONCAT_IMPL(x, y) x ## y
+#define KOKKOSKERNELS_PROFILING_REGION_CONCAT(x, y) KOKKOSKERNELS_PROFILING_REGION_CONCAT_IMPL(x, y)
+
+#if defined(KOKKOSKERNELS_DISABLE_PROFILING_REGIONS)
+#define KOKKOSKERNELS_PROFILING_REGION(name)
+#define KOKKOSKERNELS_KERNEL_COUNTS(name, flops, bytes)
+#else
+#define KOKKOSKERNELS_PROFILING_REGION(name) \
+  KokkosKernels::Impl::ProfilingRegion KOKKOSKERNELS_PROFILING_REGION_CONCAT(kk_profiling_region_, __LINE__)(name)
+#define KOKKOSKERNELS_KERNEL_COUNTS(name, flops, bytes) \
+  KokkosKernels::Impl::KernelCounts KOKKOSKERNELS_PROFILING_REGION_CONCAT(kk_kernel_counts_, __LINE__)(name, flops, bytes)
+#endif
+
+#endif
@@ -46,6 +46,7 @@
 #include "Kokkos_Atomic.hpp"
 #include "Kokkos_ArithTraits.hpp"
 #include "impl/Kokkos_Timer.hpp"
+#include "KokkosKernels_ExecSpaceUtils.hpp"
 #include <type_traits>
 
 
@@ -57,6 +58,31 @@ namespace KokkosKernels{
 
 namespace Impl{
 
+/**
+ * \brief Atomic *dest += val.
+ */
+template <typename dest_t, typename value_t>
+KOKKOS_FORCEINLINE_FUNCTION
+void kk_atomic_add(dest_t *dest, const value_t &val){
+  Kokkos::atomic_add(dest, static_cast<dest_t>(val));
+}
+
+/**
+ * \brief Atomic *dest += val for complex values: the real and imaginary
+ * parts are added with two atomics of the real type, which are native on
+ * the hardware, instead of the compare and swap loop (or the lock) of a
+ * complex atomic. The parts are not updated together, which sums do not
+ * need.
+ */
+template <typename real_t, typename value_t>
+KOKKOS_FORCEINLINE_FUNCTION
+void kk_atomic_add(Kokkos::complex<real_t> *dest, const value_t &val){
+  const Kokkos::complex<real_t> v = static_cast<Kokkos::complex<real_t> >(val);
+  real_t *parts = reinterpret_cast<real_t *>(dest);
+  Kokkos::atomic_add(parts, v.real());
+  Kokkos::atomic_add(parts + 1, v.imag());
+}
+
 template<class ViewType>
 class SquareRootFunctor {
 public:
@@ -106,18 +132,248 @@ struct InclusiveParallelPrefixSum{
 };
 
 
+//Elements of a tile of the single-pass Cuda scan, and the smallest array
+//for which it replaces parallel_scan (below, parallel_scan is one launch
+//less and needs no tile descriptors).
+#define KOKKOSKERNELS_SCAN_TILE_SIZE 4096
+#define KOKKOSKERNELS_SCAN_LOOKBACK_MIN_SIZE (1 << 20)
+//Elements per thread of a block of the cache-blocked host scan.
+#define KOKKOSKERNELS_SCAN_HOST_BLOCK_SIZE (1 << 15)
+
+//Exclusive prefix sum of a block of the cache-blocked host scan, shifted
+//by the sum of the previous blocks.
+template <typename view_t>
+struct OffsetExclusiveParallelPrefixSum{
+  typedef typename view_t::non_const_value_type idx;
+  view_t array_sum;
+  idx offset;
+  OffsetExclusiveParallelPrefixSum(view_t arr_, idx offset_): array_sum(arr_), offset(offset_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t ii, idx &update, const bool final) const {
+    idx val = array_sum(ii);
+    if (final) {
+      array_sum(ii) = offset + update;
+    }
+    update += val;
+  }
+};
+
+/***
+ * \brief Single-pass exclusive prefix sum with decoupled look-back. Tiles
+ * are numbered in the order in which teams start, so a team only waits on
+ * tiles of teams already running. A team publishes the sum of its tile,
+ * then walks back over the previous tiles adding their sums until it finds
+ * one whose inclusive prefix is known, and publishes its own inclusive
+ * prefix. The array is read twice from the cache and written once, instead
+ * of the three global passes of a reduce-then-scan.
+ */
+template <typename view_t, typename MyExecSpace>
+struct LookBackExclusiveParallelPrefixSum{
+  typedef typename view_t::non_const_value_type idx;
+  typedef Kokkos::TeamPolicy<MyExecSpace> team_policy_t;
+  typedef typename team_policy_t::member_type team_member_t;
+  typedef Kokkos::View<int *, typename view_t::device_type> flag_view_t;
+  typedef Kokkos::View<idx *, typename view_t::device_type> sum_view_t;
+
+  enum { TILE_INVALID = 0, TILE_AGGREGATE = 1, TILE_PREFIX = 2 };
+
+  size_t num_elements;
+  view_t array_sum;
+  //tile_flags(num_tiles) is the counter handing out tile numbers.
+  flag_view_t tile_flags;
+  sum_view_t tile_aggregates, tile_prefixes;
+
+  LookBackExclusiveParallelPrefixSum(size_t num_elements_, view_t arr_, size_t num_tiles):
+    num_elements(num_elements_), array_sum(arr_),
+    tile_flags("KokkosKernels::PrefixSum::TileFlags", num_tiles + 1),
+    tile_aggregates(Kokkos::ViewAllocateWithoutInitializing("KokkosKernels::PrefixSum::TileAggregates"), num_tiles),
+    tile_prefixes(Kokkos::ViewAllocateWithoutInitializing("KokkosKernels::PrefixSum::TilePrefixes"), num_tiles){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const team_member_t &teamMember) const {
+    int tile = 0;
+    Kokkos::single(Kokkos::PerTeam(teamMember), [&] (int &t) {
+      t = Kokkos::atomic_fetch_add(&(tile_flags(tile_flags.extent(0) - 1)), 1);
+    }, tile);
+
+    const size_t begin = size_t(tile) * KOKKOSKERNELS_SCAN_TILE_SIZE;
+    const size_t end = KOKKOSKERNELS_MACRO_MIN(begin + KOKKOSKERNELS_SCAN_TILE_SIZE, num_elements);
+    const int tile_size = end - begin;
+
+    idx aggregate = 0;
+    Kokkos::parallel_reduce(Kokkos::TeamThreadRange(teamMember, tile_size), [&] (const int i, idx &update) {
+      update += array_sum(begin + i);
+    }, aggregate);
+
+    idx prefix = 0;
+    Kokkos::single(Kokkos::PerTeam(teamMember), [&] (idx &exclusive) {
+      volatile int *flags = tile_flags.data();
+      volatile idx *aggregates = tile_aggregates.data();
+      volatile idx *prefixes = tile_prefixes.data();
+      if (tile == 0){
+        prefixes[0] = aggregate;
+        Kokkos::memory_fence();
+        flags[0] = TILE_PREFIX;
+        exclusive = 0;
+        return;
+      }
+      aggregates[tile] = aggregate;
+      Kokkos::memory_fence();
+      flags[tile] = TILE_AGGREGATE;
+
+      idx sum = 0;
+      for (int pred = tile - 1; ; --pred){
+        int flag;
+        while ((flag = flags[pred]) == TILE_INVALID);
+        Kokkos::memory_fence();
+        if (flag == TILE_PREFIX){
+          sum += prefixes[pred];
+          break;
+        }
+        sum += aggregates[pred];
+      }
+      prefixes[tile] = sum + aggregate;
+      Kokkos::memory_fence();
+      flags[tile] = TILE_PREFIX;
+      exclusive = sum;
+    }, prefix);
+
+    Kokkos::parallel_scan(Kokkos::TeamThreadRange(teamMember, tile_size), [&] (const int i, idx &update, const bool final) {
+      idx val = array_sum(begin + i);
+      if (final) {
+        array_sum(begin + i) = prefix + update;
+      }
+      update += val;
+    });
+  }
+};
+
 /***
  * \brief Function performs the exclusive parallel prefix sum. That is each entry holds the sum
  * until itself.
+ * On Cuda, large arrays are scanned in a single pass with decoupled look-back. On OpenMP and
+ * Threads, large arrays are scanned in blocks small enough to stay in the caches between the two
+ * passes of parallel_scan.
  * \param num_elements: size of the array
  * \param arr: the array for which the prefix sum will be performed.
  */
 template <typename view_t, typename MyExecSpace>
 inline void kk_exclusive_parallel_prefix_sum(typename view_t::value_type num_elements, view_t arr){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef typename view_t::non_const_value_type idx;
+  const size_t n = num_elements;
+  const ExecSpaceType exec_space = kk_get_exec_space_type<MyExecSpace>();
+
+  if (exec_space == Exec_CUDA && n >= KOKKOSKERNELS_SCAN_LOOKBACK_MIN_SIZE){
+    typedef LookBackExclusiveParallelPrefixSum<view_t, MyExecSpace> lookback_t;
+    const size_t num_tiles = (n + KOKKOSKERNELS_SCAN_TILE_SIZE - 1) / KOKKOSKERNELS_SCAN_TILE_SIZE;
+    Kokkos::parallel_for("KokkosKernels::PrefixSum::LookBack",
+        typename lookback_t::team_policy_t(num_tiles, Kokkos::AUTO), lookback_t(n, arr, num_tiles));
+    return;
+  }
+
+  const size_t block_size = size_t(KOKKOSKERNELS_SCAN_HOST_BLOCK_SIZE) * MyExecSpace::concurrency();
+  if ((exec_space == Exec_OMP || exec_space == Exec_PTHREADS) && n >= 2 * block_size){
+    //the host spaces can read the array between the blocks.
+    idx offset = 0;
+    for (size_t begin = 0; begin < n; begin += block_size){
+      const size_t end = KOKKOSKERNELS_MACRO_MIN(begin + block_size, n);
+      const idx last = arr(end - 1);
+      Kokkos::parallel_scan("KokkosKernels::PrefixSum::Blocked", my_exec_space(begin, end),
+          OffsetExclusiveParallelPrefixSum<view_t>(arr, offset));
+      MyExecSpace::fence();
+      offset = arr(end - 1) + last;
+    }
+    return;
+  }
+
   Kokkos::parallel_scan( "KokkosKernels::PrefixSum", my_exec_space(0, num_elements), ExclusiveParallelPrefixSum<view_t>(arr));
 }
 
+//Running sum of the segmented scan, and whether a segment starts in the
+//range it covers. Once a segment starts, the sums on its left are dropped.
+template <typename idx>
+struct SegmentedPrefixSumValue{
+  idx sum;
+  bool head;
+};
+
+template <typename view_t, typename offset_view_t>
+struct SegmentedExclusiveParallelPrefixSum{
+  typedef typename view_t::non_const_value_type idx;
+  typedef typename offset_view_t::non_const_value_type offset_t;
+  typedef SegmentedPrefixSumValue<idx> value_type;
+
+  size_t num_segments;
+  offset_view_t segment_offsets;
+  view_t array_sum;
+  SegmentedExclusiveParallelPrefixSum(size_t num_segments_, offset_view_t segment_offsets_, view_t arr_):
+    num_segments(num_segments_), segment_offsets(segment_offsets_), array_sum(arr_){}
+
+  //whether ii is the first element of a nonempty segment.
+  KOKKOS_INLINE_FUNCTION
+  bool is_head(const size_t ii) const {
+    size_t lo = 0, hi = num_segments;
+    while (lo < hi){
+      const size_t mid = (lo + hi) / 2;
+      if (size_t(segment_offsets(mid)) < ii) lo = mid + 1;
+      else hi = mid;
+    }
+    return lo < num_segments && size_t(segment_offsets(lo)) == ii;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t ii, value_type &update, const bool final) const {
+    idx val = array_sum(ii);
+    if (is_head(ii)){
+      update.sum = 0;
+      update.head = true;
+    }
+    if (final) {
+      array_sum(ii) = update.sum;
+    }
+    update.sum += val;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init(value_type &update) const {
+    update.sum = 0;
+    update.head = false;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join(value_type &update, const value_type &input) const {
+    update.sum = input.head ? input.sum : update.sum + input.sum;
+    update.head = update.head || input.head;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join(volatile value_type &update, const volatile value_type &input) const {
+    update.sum = input.head ? input.sum : update.sum + input.sum;
+    update.head = update.head || input.head;
+  }
+};
+
+/***
+ * \brief Function performs the exclusive parallel prefix sum of every segment
+ * [segment_offsets(s), segment_offsets(s + 1)) of the array, for s < num_segments,
+ * in a single parallel_scan instead of one scan per segment.
+ * \param num_segments: number of segments
+ * \param segment_offsets: the num_segments + 1 increasing segment boundaries
+ * \param arr: the array for which the segmented prefix sum will be performed.
+ */
+template <typename view_t, typename offset_view_t, typename MyExecSpace>
+inline void kk_exclusive_parallel_segmented_prefix_sum(size_t num_segments, offset_view_t segment_offsets, view_t arr){
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  if (num_segments == 0) return;
+  typedef typename offset_view_t::non_const_value_type offset_t;
+  Kokkos::View<offset_t, Kokkos::HostSpace> h_begin("begin"), h_end("end");
+  Kokkos::deep_copy(h_begin, Kokkos::subview(segment_offsets, 0));
+  Kokkos::deep_copy(h_end, Kokkos::subview(segment_offsets, num_segments));
+  Kokkos::parallel_scan( "KokkosKernels::SegmentedPrefixSum", my_exec_space(h_begin(), h_end()),
+      SegmentedExclusiveParallelPrefixSum<view_t, offset_view_t>(num_segments, segment_offsets, arr));
+}
 
 
 
@@ -172,7 +428,7 @@ struct DiffReductionFunctor{
 template <typename view_t, typename view2_t, typename MyExecSpace>
 inline void kk_reduce_diff_view(size_t num_elements, view_t smaller, view2_t bigger, typename view_t::non_const_value_type & reduction){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
-  Kokkos::parallel_reduce( my_exec_space(0, num_elements), DiffReductionFunctor<view_t, view2_t>(smaller, bigger), reduction);
+  Kokkos::parallel_reduce( "KokkosKernels::ReduceDiffView", my_exec_space(0, num_elements), DiffReductionFunctor<view_t, view2_t>(smaller, bigger), reduction);
 }
 
 template <typename it>
@@ -190,7 +446,7 @@ struct DiffReductionFunctorP{
 template <typename it,  typename MyExecSpace>
 inline void kkp_reduce_diff_view(const size_t num_elements, const it *smaller, const it *bigger, it & reduction){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
-  Kokkos::parallel_reduce( my_exec_space(0, num_elements), DiffReductionFunctorP<it>(smaller, bigger), reduction);
+  Kokkos::parallel_reduce( "KokkosKernels::ReduceDiffView", my_exec_space(0, num_elements), DiffReductionFunctorP<it>(smaller, bigger), reduction);
 }
 
 
@@ -204,13 +460,13 @@ inline void kkp_reduce_diff_view(const size_t num_elements, const it *smaller, c
 template <typename view_t, typename MyExecSpace>
 inline void kk_reduce_view(size_t num_elements, view_t arr, typename view_t::value_type & reduction){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
-  Kokkos::parallel_reduce( my_exec_space(0, num_elements), ReductionFunctor<view_t>(arr), reduction);
+  Kokkos::parallel_reduce( "KokkosKernels::ReduceView", my_exec_space(0, num_elements), ReductionFunctor<view_t>(arr), reduction);
 }
 
 template <typename view_t, typename MyExecSpace>
 inline void kk_reduce_view2(size_t num_elements, view_t arr, size_t & reduction){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
-  Kokkos::parallel_reduce( my_exec_space(0, num_elements), ReductionFunctor2<view_t>(arr), reduction);
+  Kokkos::parallel_reduce( "KokkosKernels::ReduceView", my_exec_space(0, num_elements), ReductionFunctor2<view_t>(arr), reduction);
 }
 
 template<typename view_type1, typename view_type2, typename eps_type = typename Kokkos::Details::ArithTraits<typename view_type2::non_const_value_type>::mag_type>
@@ -248,7 +504,7 @@ bool kk_is_identical_view(view_type1 view1, view_type2 view2, eps_type eps){
 
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
   size_t issame = 0;
-  Kokkos::parallel_reduce( my_exec_space(0,num_elements),
+  Kokkos::parallel_reduce( "KokkosKernels::IsIdentical", my_exec_space(0,num_elements),
       IsIdenticalFunctor<view_type1, view_type2, eps_type>(view1, view2, eps), issame);
   MyExecSpace::fence();
   if (issame > 0){
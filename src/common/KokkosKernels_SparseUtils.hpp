@@ -44,11 +44,14 @@
 #define _KOKKOSKERNELS_SPARSEUTILS_HPP
 #include "Kokkos_Core.hpp"
 #include "Kokkos_Atomic.hpp"
+#include "Kokkos_Random.hpp"
 #include "impl/Kokkos_Timer.hpp"
 #include "KokkosKernels_SimpleUtils.hpp"
 #include "KokkosKernels_IOUtils.hpp"
 #include "KokkosKernels_ExecSpaceUtils.hpp"
+#include "KokkosKernels_Workspace.hpp"
 #include <vector>
+#include <stdint.h>
 #include "KokkosKernels_PrintUtils.hpp"
 
 #ifdef KOKKOSKERNELS_HAVE_PARALLEL_GNUSORT
@@ -307,6 +310,158 @@ void kk_create_blockcrs_from_blockcrs_formatted_point_crs(
 
 }
 
+//returns true if the sorted point rows hr/cols are made of dense, aligned
+//block_size x block_size blocks: the rows of each block row have the same
+//columns, covering whole blocks of columns.
+template <typename host_row_view_t, typename lno_t>
+bool kk_is_point_crs_block_structured(
+    lno_t block_size,
+    size_t num_rows,
+    size_t num_cols,
+    const host_row_view_t &hr,
+    const std::vector<lno_t> &cols){
+  typedef typename host_row_view_t::non_const_value_type size_type;
+
+  if (num_rows % block_size || num_cols % block_size) return false;
+  for (size_t i = 0; i < num_rows; i += block_size){
+    const size_type row_begin = hr(i);
+    const size_type row_size = hr(i + 1) - row_begin;
+    if (row_size % block_size) return false;
+    for (size_type k = 0; k < row_size; ++k){
+      const lno_t col = cols[row_begin + k];
+      const lno_t lane = k % block_size;
+      if (col % block_size != lane || col - lane != cols[row_begin + k - lane]) return false;
+    }
+    for (size_t r = i + 1; r < i + block_size; ++r){
+      if (size_type(hr(r + 1) - hr(r)) != row_size) return false;
+      if (!std::equal(cols.begin() + hr(r), cols.begin() + hr(r + 1), cols.begin() + row_begin)) return false;
+    }
+  }
+  return true;
+}
+
+//the largest block size up to max_block_size of the sorted point rows
+//hr/cols, 1 if they have no block structure.
+template <typename host_row_view_t, typename lno_t>
+lno_t kk_find_sorted_point_crs_block_size(
+    lno_t max_block_size,
+    size_t num_rows,
+    size_t num_cols,
+    const host_row_view_t &hr,
+    const std::vector<lno_t> &cols){
+  for (lno_t block_size = max_block_size; block_size > 1; --block_size){
+    if (kk_is_point_crs_block_structured(block_size, num_rows, num_cols, hr, cols)) return block_size;
+  }
+  return 1;
+}
+
+/**
+ * \brief Returns the natural block size of a point crs matrix, i.e., the
+ * largest block size up to max_block_size such that the matrix is made of
+ * dense block_size x block_size blocks aligned to the block size, as the
+ * matrices of problems with block_size degrees of freedom per node. Returns 1
+ * if there is no block structure. The columns of the rows need not be sorted.
+ */
+template <typename in_row_view_t,
+          typename in_nnz_view_t>
+typename in_nnz_view_t::non_const_value_type kk_find_point_crs_block_size(
+    typename in_nnz_view_t::non_const_value_type max_block_size,
+    size_t num_rows,
+    size_t num_cols,
+    in_row_view_t in_xadj,
+    in_nnz_view_t in_adj){
+  typedef typename in_nnz_view_t::non_const_value_type lno_t;
+
+  typename in_row_view_t::HostMirror hr = Kokkos::create_mirror_view (in_xadj);
+  Kokkos::deep_copy (hr, in_xadj);
+  typename in_nnz_view_t::HostMirror he = Kokkos::create_mirror_view (in_adj);
+  Kokkos::deep_copy (he, in_adj);
+
+  std::vector<lno_t> cols (he.data(), he.data() + in_adj.extent(0));
+  for (size_t i = 0; i < num_rows; ++i){
+    std::sort (cols.begin() + hr(i), cols.begin() + hr(i + 1));
+  }
+  return kk_find_sorted_point_crs_block_size(max_block_size, num_rows, num_cols, hr, cols);
+}
+
+/**
+ * \brief Returns the BlockCrsMatrix of the point crs matrix A, with the
+ * block size found by kk_find_point_crs_block_size. The values are copied in
+ * the order of the blocks, so the columns of A need not be sorted. With no
+ * block structure, the result has block size 1, the same entries as A.
+ */
+template <typename blockcrsMat_t, typename crsMat_t>
+blockcrsMat_t kk_create_blockcrs_matrix_from_point_crs(
+    const crsMat_t &A,
+    typename crsMat_t::non_const_ordinal_type max_block_size = 8){
+  typedef typename crsMat_t::non_const_ordinal_type lno_t;
+  typedef typename crsMat_t::non_const_size_type size_type;
+  typedef typename crsMat_t::non_const_value_type scalar_t;
+  typedef typename blockcrsMat_t::row_map_type::non_const_type out_row_view_t;
+  typedef typename blockcrsMat_t::index_type::non_const_type out_nnz_view_t;
+  typedef typename blockcrsMat_t::values_type::non_const_type out_val_view_t;
+
+  const size_t num_rows = A.numRows();
+  const size_t num_cols = A.numCols();
+  const size_type nnz = A.nnz();
+
+  typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view (A.graph.row_map);
+  Kokkos::deep_copy (hr, A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view (A.graph.entries);
+  Kokkos::deep_copy (he, A.graph.entries);
+  typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view (A.values);
+  Kokkos::deep_copy (hv, A.values);
+
+  //the point rows sorted by column.
+  std::vector<std::pair<lno_t, scalar_t> > row;
+  std::vector<lno_t> cols (nnz);
+  std::vector<scalar_t> vals (nnz);
+  for (size_t i = 0; i < num_rows; ++i){
+    row.clear();
+    for (size_type k = hr(i); k < hr(i + 1); ++k){
+      row.push_back(std::make_pair(he(k), hv(k)));
+    }
+    std::sort (row.begin(), row.end(),
+        [](const std::pair<lno_t, scalar_t> &a, const std::pair<lno_t, scalar_t> &b){return a.first < b.first;});
+    for (size_t k = 0; k < row.size(); ++k){
+      cols[hr(i) + k] = row[k].first;
+      vals[hr(i) + k] = row[k].second;
+    }
+  }
+
+  const lno_t block_size = kk_find_sorted_point_crs_block_size(max_block_size, num_rows, num_cols, hr, cols);
+  const size_t out_num_rows = num_rows / block_size;
+  const size_t num_blocks = nnz / (block_size * block_size);
+
+  //a block row holds the point rows of its blocks one after the other, as
+  //the sorted point rows.
+  out_row_view_t out_xadj ("BlockedCRS XADJ", out_num_rows + 1);
+  out_nnz_view_t out_adj (Kokkos::ViewAllocateWithoutInitializing("BlockedCRS ADJ"), num_blocks);
+  out_val_view_t out_vals (Kokkos::ViewAllocateWithoutInitializing("BlockedCRS VALS"), nnz);
+
+  typename out_row_view_t::HostMirror hor = Kokkos::create_mirror_view (out_xadj);
+  typename out_nnz_view_t::HostMirror hoe = Kokkos::create_mirror_view (out_adj);
+  typename out_val_view_t::HostMirror hov = Kokkos::create_mirror_view (out_vals);
+  for (size_t i = 0; i <= out_num_rows; ++i){
+    hor(i) = hr(i * block_size) / (block_size * block_size);
+  }
+  for (size_t i = 0; i < out_num_rows; ++i){
+    const size_type row_begin = hr(i * block_size);
+    for (size_type b = hor(i); b < hor(i + 1); ++b){
+      hoe(b) = cols[row_begin + (b - hor(i)) * block_size] / block_size;
+    }
+  }
+  for (size_type k = 0; k < nnz; ++k){
+    hov(k) = vals[k];
+  }
+  Kokkos::deep_copy (out_xadj, hor);
+  Kokkos::deep_copy (out_adj, hoe);
+  Kokkos::deep_copy (out_vals, hov);
+
+  return blockcrsMat_t ("BlockCrsMatrix", out_num_rows, num_cols / block_size, nnz,
+                        out_vals, out_xadj, out_adj, block_size);
+}
+
 template <typename in_row_view_t,
           typename in_nnz_view_t,
           typename in_scalar_view_t,
@@ -431,13 +586,15 @@ struct TransposeMatrix{
  * \param suggested_team_size: suggested team size, optional. if -1, kernel will decide.
  * \param team_work_chunk_size: suggested work size of a team, optional. if -1, kernel will decide.
  * \param use_dynamic_scheduling: whether to use dynamic scheduling. Default is true.
+ * \param workspace: the workspace of a handle for the temporaries, optional. If NULL, they are allocated.
  */
 template <typename in_row_view_t,
           typename in_nnz_view_t,
           typename out_row_view_t,
           typename out_nnz_view_t,
           typename tempwork_row_view_t,
-          typename MyExecSpace>
+          typename MyExecSpace,
+          typename workspace_t = WorkspaceArena<typename tempwork_row_view_t::memory_space> >
 inline void kk_transpose_graph(
     typename in_nnz_view_t::non_const_value_type num_rows,
     typename in_nnz_view_t::non_const_value_type num_cols,
@@ -448,11 +605,13 @@ inline void kk_transpose_graph(
     int vector_size = -1,
     int suggested_team_size = -1,
     typename in_nnz_view_t::non_const_value_type team_work_chunk_size = -1,
-    bool use_dynamic_scheduling = true
+    bool use_dynamic_scheduling = true,
+    workspace_t *workspace = NULL
     ){
 
   //allocate some memory for work for row pointers
-  tempwork_row_view_t tmp_row_view(Kokkos::ViewAllocateWithoutInitializing("tmp_row_view"), num_cols + 1);
+  WorkspaceScope<workspace_t> workspace_scope(workspace);
+  tempwork_row_view_t tmp_row_view = kk_get_workspace_view<tempwork_row_view_t>(workspace, "tmp_row_view", num_cols + 1);
 
   in_nnz_view_t tmp1;
   out_nnz_view_t tmp2;
@@ -491,10 +650,10 @@ inline void kk_transpose_graph(
 
 
   if (use_dynamic_scheduling){
-    Kokkos::parallel_for(  d_count_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
+    Kokkos::parallel_for(  "KokkosKernels::TransposeGraph::Count", d_count_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
   }
   else {
-    Kokkos::parallel_for(  count_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
+    Kokkos::parallel_for(  "KokkosKernels::TransposeGraph::Count", count_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
   }
   MyExecSpace::fence();
 
@@ -506,10 +665,109 @@ inline void kk_transpose_graph(
 
 
   if (use_dynamic_scheduling){
-    Kokkos::parallel_for(  fill_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
+    Kokkos::parallel_for(  "KokkosKernels::TransposeGraph::Fill", fill_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
+  }
+  else {
+    Kokkos::parallel_for(  "KokkosKernels::TransposeGraph::Fill", d_fill_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
+  }
+  MyExecSpace::fence();
+}
+
+/**
+ * \brief function returns transpose of the given matrix.
+ * \param num_rows: num rows in input matrix
+ * \param num_cols: num cols in input matrix
+ * \param xadj: row pointers of the input matrix
+ * \param adj: column indices of the input matrix
+ * \param vals: values of the input matrix
+ * \param t_xadj: output, the row indices of the output matrix. MUST BE INITIALIZED WITH ZEROES.
+ * \param t_adj: output, column indices. No need for initializations.
+ * \param t_vals: output, values. No need for initializations.
+ * \param vector_size: suggested vector size, optional. if -1, kernel will decide.
+ * \param suggested_team_size: suggested team size, optional. if -1, kernel will decide.
+ * \param team_work_chunk_size: suggested work size of a team, optional. if -1, kernel will decide.
+ * \param use_dynamic_scheduling: whether to use dynamic scheduling. Default is true.
+ * \param workspace: the workspace of a handle for the temporaries, optional. If NULL, they are allocated.
+ */
+template <typename in_row_view_t,
+          typename in_nnz_view_t,
+          typename in_scalar_view_t,
+          typename out_row_view_t,
+          typename out_nnz_view_t,
+          typename out_scalar_view_t,
+          typename tempwork_row_view_t,
+          typename MyExecSpace,
+          typename workspace_t = WorkspaceArena<typename tempwork_row_view_t::memory_space> >
+inline void kk_transpose_matrix(
+    typename in_nnz_view_t::non_const_value_type num_rows,
+    typename in_nnz_view_t::non_const_value_type num_cols,
+    in_row_view_t xadj,
+    in_nnz_view_t adj,
+    in_scalar_view_t vals,
+    out_row_view_t t_xadj, //pre-allocated -- initialized with 0
+    out_nnz_view_t t_adj,  //pre-allocated -- no need for initialize
+    out_scalar_view_t t_vals,  //pre-allocated -- no need for initialize
+    int vector_size = -1,
+    int suggested_team_size = -1,
+    typename in_nnz_view_t::non_const_value_type team_work_chunk_size = -1,
+    bool use_dynamic_scheduling = true,
+    workspace_t *workspace = NULL
+    ){
+
+  //allocate some memory for work for row pointers
+  WorkspaceScope<workspace_t> workspace_scope(workspace);
+  tempwork_row_view_t tmp_row_view = kk_get_workspace_view<tempwork_row_view_t>(workspace, "tmp_row_view", num_cols + 1);
+
+  //create the functor for tranpose.
+  typedef TransposeMatrix <
+      in_row_view_t, in_nnz_view_t, in_scalar_view_t,
+      out_row_view_t, out_nnz_view_t, out_scalar_view_t,
+      tempwork_row_view_t, MyExecSpace>  TransposeFunctor_t;
+
+  typedef typename TransposeFunctor_t::team_count_policy_t count_tp_t;
+  typedef typename TransposeFunctor_t::team_fill_policy_t fill_tp_t;
+  typedef typename TransposeFunctor_t::dynamic_team_count_policy_t d_count_tp_t;
+  typedef typename TransposeFunctor_t::dynamic_team_fill_policy_t d_fill_tp_t;
+
+  typename in_row_view_t::non_const_value_type nnz = adj.extent(0);
+
+  //set the vector size, if not suggested.
+  if (vector_size == -1)
+    vector_size = kk_get_suggested_vector_size(num_rows, nnz, kk_get_exec_space_type<MyExecSpace>());
+
+  //set the team size, if not suggested.
+  if (suggested_team_size == -1)
+    suggested_team_size = kk_get_suggested_team_size(vector_size, kk_get_exec_space_type<MyExecSpace>());
+
+  //set the chunk size, if not suggested.
+  if (team_work_chunk_size == -1)
+    team_work_chunk_size = suggested_team_size;
+
+  TransposeFunctor_t tm ( num_rows, num_cols, xadj, adj, vals,
+                          t_xadj, t_adj, t_vals,
+                          tmp_row_view,
+                          true,
+                          team_work_chunk_size);
+
+  if (use_dynamic_scheduling){
+    Kokkos::parallel_for(  "KokkosKernels::TransposeMatrix::Count", d_count_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
+  }
+  else {
+    Kokkos::parallel_for(  "KokkosKernels::TransposeMatrix::Count", count_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
+  }
+  MyExecSpace::fence();
+
+  kk_exclusive_parallel_prefix_sum<out_row_view_t, MyExecSpace>(num_cols+1, t_xadj);
+  MyExecSpace::fence();
+
+  Kokkos::deep_copy(tmp_row_view, t_xadj);
+  MyExecSpace::fence();
+
+  if (use_dynamic_scheduling){
+    Kokkos::parallel_for(  "KokkosKernels::TransposeMatrix::Fill", d_fill_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
   }
   else {
-    Kokkos::parallel_for(  d_fill_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
+    Kokkos::parallel_for(  "KokkosKernels::TransposeMatrix::Fill", fill_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
   }
   MyExecSpace::fence();
 }
@@ -683,7 +941,7 @@ void kk_create_reverse_map(
     frsf frm (forward_map, tmp_color_xadj, reverse_map_adj,
             multiply_shift_for_scale, division_shift_for_bucket);
 
-    Kokkos::parallel_for (my_cnt_exec_space (0, num_forward_elements) , frm);
+    Kokkos::parallel_for ("KokkosKernels::CreateReverseMap::Count", my_cnt_exec_space (0, num_forward_elements) , frm);
     MyExecSpace::fence();
 
 
@@ -693,11 +951,11 @@ void kk_create_reverse_map(
     MyExecSpace::fence();
 
     Kokkos::parallel_for (
-        my_exec_space (0, num_reverse_elements + 1) ,
+        "KokkosKernels::CreateReverseMap::StridedCopy", my_exec_space (0, num_reverse_elements + 1) ,
         StridedCopy1<reverse_array_type, reverse_array_type>
           (tmp_color_xadj, reverse_map_xadj, scale_size));
     MyExecSpace::fence();
-    Kokkos::parallel_for (my_fill_exec_space (0, num_forward_elements) , frm);
+    Kokkos::parallel_for ("KokkosKernels::CreateReverseMap::Fill", my_fill_exec_space (0, num_forward_elements) , frm);
     MyExecSpace::fence();
   }
   else
@@ -713,7 +971,7 @@ void kk_create_reverse_map(
 
     rmp_functor_type frm (forward_map, tmp_color_xadj, reverse_map_adj);
 
-    Kokkos::parallel_for (my_cnt_exec_space (0, num_forward_elements) , frm);
+    Kokkos::parallel_for ("KokkosKernels::CreateReverseMap::Count", my_cnt_exec_space (0, num_forward_elements) , frm);
     MyExecSpace::fence();
 
     //kk_inclusive_parallel_prefix_sum<reverse_array_type, MyExecSpace>(num_reverse_elements + 1, reverse_map_xadj);
@@ -724,7 +982,7 @@ void kk_create_reverse_map(
     Kokkos::deep_copy (reverse_map_xadj, tmp_color_xadj);
     MyExecSpace::fence();
 
-    Kokkos::parallel_for (my_fill_exec_space (0, num_forward_elements) , frm);
+    Kokkos::parallel_for ("KokkosKernels::CreateReverseMap::Fill", my_fill_exec_space (0, num_forward_elements) , frm);
     MyExecSpace::fence();
   }
 }
@@ -823,7 +1081,7 @@ inline size_t kk_is_d1_coloring_valid(
 
   struct ColorChecker <in_row_view_t, in_nnz_view_t, in_color_view_t, team_member_t>  cc(num_rows, xadj, adj, v_colors, team_work_chunk_size);
   size_t num_conf = 0;
-  Kokkos::parallel_reduce( dynamic_team_policy(num_rows / team_work_chunk_size + 1 ,
+  Kokkos::parallel_reduce( "KokkosKernels::IsD1ColoringValid", dynamic_team_policy(num_rows / team_work_chunk_size + 1 ,
       suggested_team_size, vector_size), cc, num_conf);
 
   MyExecSpace::fence();
@@ -831,90 +1089,251 @@ inline size_t kk_is_d1_coloring_valid(
 }
 
 
-template <typename lno_view_t,
-          typename lno_nnz_view_t,
-          typename scalar_view_t,
+KOKKOS_INLINE_FUNCTION
+uint64_t kk_hash_mix(uint64_t x){
+  //finalizer of splitmix64.
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
 
-          typename out_nnz_view_t,
-          typename out_scalar_view_t,
-          typename MyExecSpace>
-void kk_sort_graph(
-    lno_view_t in_xadj,
-    lno_nnz_view_t in_adj,
-    scalar_view_t in_vals,
+template <typename row_map_view_t, typename entries_view_t>
+struct HashGraph{
+  row_map_view_t row_map;
+  entries_view_t entries;
+  size_t num_row_map;
 
-    out_nnz_view_t out_adj,
-    out_scalar_view_t out_vals){
-  ExecSpaceType exec = kk_get_exec_space_type<MyExecSpace>();
+  HashGraph(row_map_view_t row_map_, entries_view_t entries_, size_t num_row_map_):
+    row_map(row_map_), entries(entries_), num_row_map(num_row_map_){}
 
-  if (exec == Exec_CUDA){
-    typename lno_view_t::HostMirror hr = Kokkos::create_mirror_view (in_xadj);
-    Kokkos::deep_copy (hr, in_xadj);
-    typename lno_nnz_view_t::HostMirror he = Kokkos::create_mirror_view (in_adj);
-    Kokkos::deep_copy (he, in_adj);
-    typename scalar_view_t::HostMirror hv = Kokkos::create_mirror_view (in_vals);
-    Kokkos::deep_copy (hv, in_vals);
-    MyExecSpace::fence();
+  //each value is hashed with its position; the hashes are summed, so that
+  //the result does not depend on the order of the reduction.
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t &i, uint64_t &hash) const{
+    if (i < num_row_map){
+      hash += kk_hash_mix(kk_hash_mix(i) ^ uint64_t(row_map(i)));
+    }
+    else {
+      const size_t k = i - num_row_map;
+      hash += kk_hash_mix(kk_hash_mix(k + 0x5bd1e995ULL) + uint64_t(entries(k)));
+    }
+  }
+};
 
-    typename lno_nnz_view_t::HostMirror heo = Kokkos::create_mirror_view (out_adj);
-    typename scalar_view_t::HostMirror hvo = Kokkos::create_mirror_view (out_vals);
+/**
+ * \brief 64-bit fingerprint of the pattern of a graph, computed in parallel.
+ * Handles keep the fingerprint of the graph their symbolic phase was called
+ * with, to skip the symbolic phase when it is called again with the same
+ * pattern, even with other views.
+ * \param num_rows, num_cols: the size of the graph, part of the fingerprint.
+ * \param row_map: the row map of the graph.
+ * \param entries: the entries of the graph. Only the entries up to
+ * row_map(num_rows) count.
+ * \param seed: a previous fingerprint to combine with, e.g. of another
+ * operand.
+ */
+template <typename row_map_view_t, typename entries_view_t, typename MyExecSpace>
+uint64_t kk_hash_graph(
+    size_t num_rows, size_t num_cols,
+    row_map_view_t row_map, entries_view_t entries, uint64_t seed = 0){
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  size_t nnz = 0;
+  if (row_map.extent(0) > num_rows){
+    typename row_map_view_t::non_const_value_type last = 0;
+    Kokkos::deep_copy(last, Kokkos::subview(row_map, num_rows));
+    nnz = last;
+  }
+  const size_t num_row_map = KOKKOSKERNELS_MACRO_MIN(size_t(row_map.extent(0)), num_rows + 1);
+  uint64_t hash = 0;
+  Kokkos::parallel_reduce("KokkosKernels::HashGraph", my_exec_space(0, num_row_map + nnz),
+      HashGraph<row_map_view_t, entries_view_t>(row_map, entries, num_row_map), hash);
+  return kk_hash_mix(seed ^ kk_hash_mix(hash ^ kk_hash_mix(num_rows) ^ kk_hash_mix(kk_hash_mix(num_cols))));
+}
 
+//rows with at most this many entries are sorted by one thread;
+//longer rows are sorted by a team.
+#define KOKKOSKERNELS_SORT_ROW_TEAM_THRESHOLD 64
 
-    typedef typename lno_view_t::non_const_value_type size_type;
-    typedef typename lno_nnz_view_t::non_const_value_type lno_t;
-    typedef typename scalar_view_t::non_const_value_type scalar_t;
+/**
+ * \brief Sorts the entries of each row of a graph in place, and the values
+ * in lockstep. Rows with at most KOKKOSKERNELS_SORT_ROW_TEAM_THRESHOLD
+ * entries are insertion sorted by a thread; longer rows are bitonic sorted
+ * by a team.
+ */
+template <typename row_map_view_t, typename entries_view_t, typename values_view_t>
+struct SortCrsRows{
+  typedef typename row_map_view_t::non_const_value_type size_type;
+  typedef typename entries_view_t::non_const_value_type lno_t;
+  typedef typename values_view_t::non_const_value_type scalar_t;
+  typedef typename entries_view_t::execution_space MyExecSpace;
 
-    lno_t nrows = in_xadj.extent(0) - 1;
-    std::vector <Edge<lno_t, scalar_t> > edges(in_adj.extent(0));
+  struct CountTag{};
+  struct ListTag{};
+  struct ShortTag{};
+  struct LongTag{};
+  typedef typename Kokkos::TeamPolicy<LongTag, MyExecSpace>::member_type team_member_t;
+  typedef Kokkos::View<lno_t *, typename entries_view_t::device_type> lno_view_t;
+
+  row_map_view_t row_map;
+  entries_view_t entries;
+  values_view_t values;
+  lno_view_t long_rows;
+  bool sort_values;
+
+  SortCrsRows(row_map_view_t row_map_, entries_view_t entries_, values_view_t values_,
+      lno_view_t long_rows_, bool sort_values_):
+    row_map(row_map_), entries(entries_), values(values_), long_rows(long_rows_), sort_values(sort_values_){}
 
-    size_type row_size = 0;
-    for (lno_t i = 0; i < nrows; ++i){
-      for (size_type j = hr(i); j < hr(i + 1); ++j){
-        edges[row_size].src = i;
-        edges[row_size].dst = he(j);
-        edges[row_size++].ew = hv(j);
-      }
-    }
-    std::sort (edges.begin(), edges.begin() + row_size);
-    size_type ne = in_adj.extent(0);
-    for(size_type i = 0; i < ne; ++i){
-      heo(i) = edges[i].dst;
-      hvo(i) = edges[i].ew;
+  KOKKOS_INLINE_FUNCTION
+  void swap_entries(const size_type a, const size_type b) const{
+    const lno_t e = entries(a);
+    entries(a) = entries(b);
+    entries(b) = e;
+    if (sort_values){
+      const scalar_t v = values(a);
+      values(a) = values(b);
+      values(b) = v;
     }
-
-
-    Kokkos::deep_copy (out_adj, heo);
-    Kokkos::deep_copy (out_vals, hvo);
-    MyExecSpace::fence();
   }
-  else {
 
+  //counts the long rows.
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const CountTag&, const lno_t &i, lno_t &num_long) const{
+    if (row_map(i + 1) - row_map(i) > KOKKOSKERNELS_SORT_ROW_TEAM_THRESHOLD) ++num_long;
+  }
 
-    typedef typename lno_view_t::non_const_value_type size_type;
-    typedef typename lno_nnz_view_t::non_const_value_type lno_t;
-    typedef typename scalar_view_t::non_const_value_type scalar_t;
-
-    lno_t nrows = in_xadj.extent(0) - 1;
-    std::vector <Edge<lno_t, scalar_t> > edges(in_adj.extent(0));
+  //lists the long rows.
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const ListTag&, const lno_t &i, lno_t &update, const bool final) const{
+    if (row_map(i + 1) - row_map(i) > KOKKOSKERNELS_SORT_ROW_TEAM_THRESHOLD){
+      if (final) long_rows(update) = i;
+      ++update;
+    }
+  }
 
-    size_type row_size = 0;
-    for (lno_t i = 0; i < nrows; ++i){
-      for (size_type j = in_xadj(i); j < in_xadj(i + 1); ++j){
-        edges[row_size].src = i;
-        edges[row_size].dst = in_adj(j);
-        edges[row_size++].ew = in_vals(j);
+  //insertion sort of a short row.
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const ShortTag&, const lno_t &i) const{
+    const size_type begin = row_map(i);
+    const size_type end = row_map(i + 1);
+    if (end - begin > KOKKOSKERNELS_SORT_ROW_TEAM_THRESHOLD) return;
+    for (size_type j = begin + 1; j < end; ++j){
+      const lno_t e = entries(j);
+      scalar_t v = scalar_t();
+      if (sort_values) v = values(j);
+      size_type k = j;
+      for (; k > begin && entries(k - 1) > e; --k){
+        entries(k) = entries(k - 1);
+        if (sort_values) values(k) = values(k - 1);
       }
+      entries(k) = e;
+      if (sort_values) values(k) = v;
     }
-    std::sort (edges.begin(), edges.begin() + row_size);
-    size_type ne = in_adj.extent(0);
-    for(size_type i = 0; i < ne; ++i){
-      out_adj(i) = edges[i].dst;
-      out_vals(i) = edges[i].ew;
+  }
+
+  //bitonic sort of a long row. The row is padded to a power of two with
+  //virtual maximum entries; as every comparator puts the minimum first,
+  //comparisons with the padding never swap and are skipped.
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const LongTag&, const team_member_t &team) const{
+    const lno_t row = long_rows(team.league_rank());
+    const size_type begin = row_map(row);
+    const size_type n = row_map(row + 1) - begin;
+    size_type padded = 1;
+    while (padded < n) padded *= 2;
+    const size_type half = padded / 2;
+
+    for (size_type k = 2; k <= padded; k *= 2){
+      const size_type half_block = k / 2;
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, half), [&] (const size_type &t){
+        const size_type block = t / half_block, offset = t % half_block;
+        const size_type lo = block * k + offset;
+        const size_type hi = block * k + k - 1 - offset;
+        if (hi < n && entries(begin + hi) < entries(begin + lo)) swap_entries(begin + lo, begin + hi);
+      });
+      team.team_barrier();
+      for (size_type j = k / 4; j > 0; j /= 2){
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, half), [&] (const size_type &t){
+          const size_type block = t / j, offset = t % j;
+          const size_type lo = block * 2 * j + offset;
+          const size_type hi = lo + j;
+          if (hi < n && entries(begin + hi) < entries(begin + lo)) swap_entries(begin + lo, begin + hi);
+        });
+        team.team_barrier();
+      }
     }
+  }
+};
 
+/**
+ * \brief Sorts the entries of each row of a graph in place, in parallel on
+ * MyExecSpace, and the values in lockstep.
+ * \param row_map: the row map of the graph.
+ * \param entries: the entries of the graph.
+ * \param values: the values of the matrix; if it is empty, only the
+ * entries are sorted.
+ */
+template <typename row_map_view_t, typename entries_view_t, typename values_view_t, typename MyExecSpace>
+void kk_sort_crs_rows(row_map_view_t row_map, entries_view_t entries, values_view_t values){
+  typedef SortCrsRows<row_map_view_t, entries_view_t, values_view_t> sort_t;
+  typedef typename sort_t::lno_t lno_t;
+  typedef Kokkos::RangePolicy<typename sort_t::CountTag, MyExecSpace> count_policy_t;
+  typedef Kokkos::RangePolicy<typename sort_t::ListTag, MyExecSpace> list_policy_t;
+  typedef Kokkos::RangePolicy<typename sort_t::ShortTag, MyExecSpace> short_policy_t;
+  typedef Kokkos::TeamPolicy<typename sort_t::LongTag, MyExecSpace> long_policy_t;
+
+  if (row_map.extent(0) == 0) return;
+  const lno_t nrows = row_map.extent(0) - 1;
+  const bool sort_values = values.extent(0) > 0;
+
+  lno_t num_long_rows = 0;
+  Kokkos::parallel_reduce("KokkosKernels::SortCrsRows::CountLongRows", count_policy_t(0, nrows),
+      sort_t(row_map, entries, values, typename sort_t::lno_view_t(), sort_values), num_long_rows);
+
+  Kokkos::parallel_for("KokkosKernels::SortCrsRows::ShortRows", short_policy_t(0, nrows),
+      sort_t(row_map, entries, values, typename sort_t::lno_view_t(), sort_values));
+
+  if (num_long_rows > 0){
+    typename sort_t::lno_view_t long_rows(Kokkos::ViewAllocateWithoutInitializing("long rows"), num_long_rows);
+    sort_t sort_long(row_map, entries, values, long_rows, sort_values);
+    Kokkos::parallel_scan("KokkosKernels::SortCrsRows::ListLongRows", list_policy_t(0, nrows), sort_long);
+    Kokkos::parallel_for("KokkosKernels::SortCrsRows::LongRows", long_policy_t(num_long_rows, Kokkos::AUTO), sort_long);
+  }
+  MyExecSpace::fence();
+}
 
+/**
+ * \brief Sorts the entries of each row of a graph, and the values in
+ * lockstep, in parallel on MyExecSpace.
+ * \param in_xadj, in_adj, in_vals: the input matrix.
+ * \param out_adj, out_vals: output, the sorted entries and values, at
+ * least as long as the input. out_vals may be in_vals.
+ */
+template <typename lno_view_t,
+          typename lno_nnz_view_t,
+          typename scalar_view_t,
 
-  }
+          typename out_nnz_view_t,
+          typename out_scalar_view_t,
+          typename MyExecSpace>
+void kk_sort_graph(
+    lno_view_t in_xadj,
+    lno_nnz_view_t in_adj,
+    scalar_view_t in_vals,
+
+    out_nnz_view_t out_adj,
+    out_scalar_view_t out_vals){
+
+  //the output may be longer than the input.
+  const size_t ne = in_adj.extent(0);
+  const size_t nv = in_vals.extent(0) < ne ? 0 : ne;
+  auto sorted_adj = Kokkos::subview(out_adj, Kokkos::make_pair(size_t(0), ne));
+  auto sorted_vals = Kokkos::subview(out_vals, Kokkos::make_pair(size_t(0), nv));
+  Kokkos::deep_copy(sorted_adj, in_adj);
+  Kokkos::deep_copy(sorted_vals, Kokkos::subview(in_vals, Kokkos::make_pair(size_t(0), nv)));
+  MyExecSpace::fence();
+  kk_sort_crs_rows<lno_view_t, decltype(sorted_adj), decltype(sorted_vals), MyExecSpace>(in_xadj, sorted_adj, sorted_vals);
 }
 
 /*
@@ -1053,10 +1472,10 @@ inline void kk_create_incidence_matrix(
 
 
   if (use_dynamic_scheduling){
-    Kokkos::parallel_for(  fill_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
+    Kokkos::parallel_for(  "KokkosKernels::CreateIncidenceMatrix::Fill", fill_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
   }
   else {
-    Kokkos::parallel_for(  d_fill_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
+    Kokkos::parallel_for(  "KokkosKernels::CreateIncidenceMatrix::Fill", d_fill_tp_t(num_rows  / team_work_chunk_size + 1 , suggested_team_size, vector_size), tm);
   }
   MyExecSpace::fence();
 
@@ -1288,10 +1707,10 @@ void kk_get_lower_triangle_count_parallel(
 
 
   if (use_dynamic_scheduling){
-    Kokkos::parallel_for(  d_count_tp_t(nv  / team_work_chunk_size + 1 , suggested_team_size, vector_size), ltm);
+    Kokkos::parallel_for(  "KokkosKernels::LowerTriangleCount", d_count_tp_t(nv  / team_work_chunk_size + 1 , suggested_team_size, vector_size), ltm);
   }
   else {
-    Kokkos::parallel_for(  count_tp_t(nv  / team_work_chunk_size + 1 , suggested_team_size, vector_size), ltm);
+    Kokkos::parallel_for(  "KokkosKernels::LowerTriangleCount", count_tp_t(nv  / team_work_chunk_size + 1 , suggested_team_size, vector_size), ltm);
   }
   ExecutionSpace::fence();
 }
@@ -1387,7 +1806,7 @@ void kk_sort_by_row_size_parallel(
   SortItem * num_elements = &(vnum_elements[0]);
 
 
-  Kokkos::parallel_for( my_exec_space(0, nv),
+  Kokkos::parallel_for( "KokkosKernels::SortByRowSize::RowSizes", my_exec_space(0, nv),
       KOKKOS_LAMBDA(const lno_t& row) {
         lno_t row_size = in_xadj[row+1] - in_xadj[row];
         num_elements[row].size = row_size; 
@@ -1398,19 +1817,19 @@ void kk_sort_by_row_size_parallel(
       std::less<struct SortItem >());
 
       if (sort_decreasing_order == 1){
-        Kokkos::parallel_for( my_exec_space(0, nv),
+        Kokkos::parallel_for( "KokkosKernels::SortByRowSize::Permutation", my_exec_space(0, nv),
         KOKKOS_LAMBDA(const lno_t& row) {
           new_indices[num_elements[row].id] = row;
         });
       }
       else if (sort_decreasing_order == 0){
-        Kokkos::parallel_for( my_exec_space(0, nv),
+        Kokkos::parallel_for( "KokkosKernels::SortByRowSize::Permutation", my_exec_space(0, nv),
         KOKKOS_LAMBDA(const lno_t& row) {
           new_indices[num_elements[row].id] = nv - row - 1;
         });
       } 
       else {
-        Kokkos::parallel_for( my_exec_space(0, nv),
+        Kokkos::parallel_for( "KokkosKernels::SortByRowSize::Permutation", my_exec_space(0, nv),
         KOKKOS_LAMBDA(const lno_t& row) {
           if (row   & 1){
           new_indices[num_elements[row].id] = nv - (row + 1) / 2;
@@ -1475,10 +1894,10 @@ void kk_get_lower_triangle_fill_parallel(
 
 
   if (use_dynamic_scheduling){
-    Kokkos::parallel_for(  d_fill_p_t(nv  / team_work_chunk_size + 1 , suggested_team_size, vector_size), ltm);
+    Kokkos::parallel_for(  "KokkosKernels::LowerTriangleFill", d_fill_p_t(nv  / team_work_chunk_size + 1 , suggested_team_size, vector_size), ltm);
   }
   else {
-    Kokkos::parallel_for(  fill_p_t(nv  / team_work_chunk_size + 1 , suggested_team_size, vector_size), ltm);
+    Kokkos::parallel_for(  "KokkosKernels::LowerTriangleFill", fill_p_t(nv  / team_work_chunk_size + 1 , suggested_team_size, vector_size), ltm);
   }
   ExecutionSpace::fence();
 }
@@ -1848,7 +2267,7 @@ void kk_create_incidence_tranpose_matrix_from_lower_triangle(
   //const lno_t nr = in_rowmap.extent(0) - 1;
   typedef Kokkos::RangePolicy<exec_space> my_exec_space;
 
-  Kokkos::parallel_for(my_exec_space(0, ne + 1),
+  Kokkos::parallel_for("KokkosKernels::IncidenceTransposeFromLowerTriangle::RowMap", my_exec_space(0, ne + 1),
       KOKKOS_LAMBDA(const lno_t& i) {
     out_rowmap[i] = i * 2;
     });
@@ -1862,7 +2281,7 @@ void kk_create_incidence_tranpose_matrix_from_lower_triangle(
   out_entries = out_cols_view_t(Kokkos::ViewAllocateWithoutInitializing("LL"), 2 * ne);
 
   //TODO MAKE IT WITH TEAMS.
-  Kokkos::parallel_for(my_exec_space(0, nr),
+  Kokkos::parallel_for("KokkosKernels::IncidenceTransposeFromLowerTriangle::Fill", my_exec_space(0, nr),
       KOKKOS_LAMBDA(const size_type& row) {
     size_type begin = in_rowmap(row);
     lno_t row_size = in_rowmap(row + 1) - begin;
@@ -1908,7 +2327,7 @@ void kk_create_incidence_matrix_from_lower_triangle(
   typedef Kokkos::RangePolicy<exec_space> my_exec_space;
   out_rowmap = out_row_map_view_t("LL", nr+1);
 
-  Kokkos::parallel_for(my_exec_space(0, ne),
+  Kokkos::parallel_for("KokkosKernels::IncidenceFromLowerTriangle::Count", my_exec_space(0, ne),
       KOKKOS_LAMBDA(const lno_t& i) {
     typedef typename std::remove_reference< decltype( out_rowmap[0] ) >::type atomic_incr_type;
     Kokkos::atomic_fetch_add(&(out_rowmap[in_lower_entries[i]]), atomic_incr_type(1));
@@ -1918,7 +2337,7 @@ void kk_create_incidence_matrix_from_lower_triangle(
   kk_exclusive_parallel_prefix_sum<out_row_map_view_t, exec_space>(nr+1, out_rowmap);
 
   exec_space::fence();
-  Kokkos::parallel_for(my_exec_space(0, nr + 1),
+  Kokkos::parallel_for("KokkosKernels::IncidenceFromLowerTriangle::RowMap", my_exec_space(0, nr + 1),
       KOKKOS_LAMBDA(const lno_t& i) {
     out_rowmap[i] += in_lower_rowmap[i];
   });
@@ -1928,7 +2347,7 @@ void kk_create_incidence_matrix_from_lower_triangle(
 
   out_entries = out_cols_view_t(Kokkos::ViewAllocateWithoutInitializing("LL"), 2*ne);
 
-  Kokkos::parallel_for(my_exec_space(0, nr),
+  Kokkos::parallel_for("KokkosKernels::IncidenceFromLowerTriangle::FillLower", my_exec_space(0, nr),
       KOKKOS_LAMBDA(const size_type& row) {
     size_type begin = in_lower_rowmap(row);
     lno_t row_size = in_lower_rowmap(row + 1) - begin;
@@ -1945,7 +2364,7 @@ void kk_create_incidence_matrix_from_lower_triangle(
     }
   });
   exec_space::fence();
-  Kokkos::parallel_for(my_exec_space(0, ne),
+  Kokkos::parallel_for("KokkosKernels::IncidenceFromLowerTriangle::FillUpper", my_exec_space(0, ne),
       KOKKOS_LAMBDA(const size_type& edge_ind) {
     lno_t col = in_lower_entries[edge_ind];
     typedef typename std::remove_reference< decltype( out_rowmap_copy(0) ) >::type atomic_incr_type;
@@ -1974,7 +2393,8 @@ template <typename row_map_view_t,
           typename out_row_map_view_t,
           typename out_cols_view_t,
           typename permutation_view_t,
-          typename exec_space
+          typename exec_space,
+          typename workspace_t = WorkspaceArena<typename out_row_map_view_t::memory_space>
           >
 void kk_create_incidence_matrix_from_original_matrix(
     typename cols_view_t::non_const_value_type nr,
@@ -1984,7 +2404,8 @@ void kk_create_incidence_matrix_from_original_matrix(
     out_cols_view_t &out_entries,
     permutation_view_t permutation,
     bool use_dynamic_scheduling = false,
-    bool chunksize = 4){
+    bool chunksize = 4,
+    workspace_t *workspace = NULL){
 #ifndef KOKKOS_ENABLE_CUDA
 
   //typedef typename row_map_view_t::const_type const_row_map_view_t;
@@ -2015,15 +2436,16 @@ void kk_create_incidence_matrix_from_original_matrix(
 
   //kk_print_1Dview(out_rowmap, false, 20);
 
-  out_row_map_view_t out_rowmap_copy (Kokkos::ViewAllocateWithoutInitializing("tmp"), nr+1);
+  WorkspaceScope<workspace_t> workspace_scope(workspace);
+  out_row_map_view_t out_rowmap_copy = kk_get_workspace_view<out_row_map_view_t>(workspace, "tmp", nr+1);
   //out_rowmap = out_row_map_view_t("LL", nr+1);
-  Kokkos::parallel_for(my_exec_space(0, nr+1),
+  Kokkos::parallel_for("KokkosKernels::IncidenceFromOriginalMatrix::CopyRowMap", my_exec_space(0, nr+1),
       KOKKOS_LAMBDA(const lno_t& i) {
     out_rowmap_copy[i] = in_rowmap[i];
   });
 
   if (sort_decreasing_order){
-    Kokkos::parallel_for(my_exec_space(0, nr),
+    Kokkos::parallel_for("KokkosKernels::IncidenceFromOriginalMatrix::Fill", my_exec_space(0, nr),
         KOKKOS_LAMBDA(const size_type& row) {
       size_type begin = in_rowmap(row);
       lno_t row_size = in_rowmap(row + 1) - begin;
@@ -2055,7 +2477,7 @@ void kk_create_incidence_matrix_from_original_matrix(
 
   }
   else {
-  Kokkos::parallel_for(my_exec_space(0, nr),
+  Kokkos::parallel_for("KokkosKernels::IncidenceFromOriginalMatrix::Fill", my_exec_space(0, nr),
       KOKKOS_LAMBDA(const size_type& row) {
     size_type begin = in_rowmap(row);
     lno_t row_size = in_rowmap(row + 1) - begin;
@@ -2087,7 +2509,7 @@ void kk_create_incidence_matrix_from_original_matrix(
 
 
   //out_rowmap = out_row_map_view_t("LL", nr+1);
-  Kokkos::parallel_for(my_exec_space(0, nr+1),
+  Kokkos::parallel_for("KokkosKernels::IncidenceFromOriginalMatrix::CopyRowMap", my_exec_space(0, nr+1),
       KOKKOS_LAMBDA(const lno_t& i) {
     out_rowmap[i] = in_rowmap[i];
   });
@@ -2130,7 +2552,542 @@ template <typename view_type , typename MyExecSpace>
 void kk_reduce_numrows_larger_than_threshold(size_t num_elements, view_type view_to_reduce,
 		typename view_type::const_value_type threshold, typename view_type::non_const_value_type &sum_reduction){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
-  Kokkos::parallel_reduce( my_exec_space(0,num_elements), ReduceLargerRowCount<view_type>(view_to_reduce, threshold), sum_reduction);
+  Kokkos::parallel_reduce( "KokkosKernels::ReduceLargerRowCount", my_exec_space(0,num_elements), ReduceLargerRowCount<view_type>(view_to_reduce, threshold), sum_reduction);
+}
+
+template<typename a_row_view_t, typename a_nnz_view_t, typename b_row_view_t>
+struct ReduceMultiplicationCount{
+
+  a_row_view_t row_mapA;
+  a_nnz_view_t entriesA;
+  b_row_view_t row_mapB;
+
+  ReduceMultiplicationCount(a_row_view_t row_mapA_, a_nnz_view_t entriesA_, b_row_view_t row_mapB_):
+    row_mapA(row_mapA_), entriesA(entriesA_), row_mapB(row_mapB_){}
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t &i, size_t &sum_reduction) const {
+    for (auto j = row_mapA(i); j < row_mapA(i+1); ++j){
+      const auto col = entriesA(j);
+      sum_reduction += row_mapB(col+1) - row_mapB(col);
+    }
+  }
+};
+
+/**
+ * \brief The number of scalar multiplications of C = A * B, i.e. the sum
+ * over the entries (i, j) of A of the number of entries in row j of B.
+ */
+template <typename a_row_view_t, typename a_nnz_view_t, typename b_row_view_t, typename MyExecSpace>
+size_t kk_get_spgemm_multiplication_count(size_t num_rows_a, a_row_view_t row_mapA, a_nnz_view_t entriesA, b_row_view_t row_mapB){
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  size_t num_multiplications = 0;
+  Kokkos::parallel_reduce( "KokkosKernels::ReduceMultiplicationCount", my_exec_space(0,num_rows_a),
+      ReduceMultiplicationCount<a_row_view_t, a_nnz_view_t, b_row_view_t>(row_mapA, entriesA, row_mapB), num_multiplications);
+  return num_multiplications;
+}
+
+
+/**
+ * \brief The random stream of row or edge i of a generated matrix. Each
+ * row or edge draws from its own generator seeded from (seed, i), so that
+ * generated matrices do not depend on the number of threads, unlike
+ * draws from a Kokkos::Random_XorShift64_Pool.
+ */
+template <typename device_t>
+KOKKOS_INLINE_FUNCTION
+Kokkos::Random_XorShift64<device_t> kk_generator_stream(uint64_t seed, uint64_t i){
+  return Kokkos::Random_XorShift64<device_t>(kk_hash_mix(seed ^ kk_hash_mix(i)));
+}
+
+//Random rows in the band of the original kk_sparseMatrix_generate: the
+//count pass draws the row sizes and the fill pass draws distinct columns
+//and the values from the same streams. With diagonally_dominant, the last
+//entry of each row is the diagonal, ten times the sum of the others.
+template <typename row_map_view_t, typename entries_view_t, typename values_view_t>
+struct GenerateRandomRows{
+  typedef typename row_map_view_t::non_const_value_type size_type;
+  typedef typename entries_view_t::non_const_value_type lno_t;
+  typedef typename values_view_t::non_const_value_type scalar_t;
+  typedef typename Kokkos::Details::ArithTraits<scalar_t>::mag_type mag_t;
+  typedef typename entries_view_t::device_type device_t;
+  typedef Kokkos::Random_XorShift64<device_t> generator_t;
+
+  struct CountTag{};
+  struct FillTag{};
+
+  lno_t ncols, elements_per_row, row_size_variance, bandwidth;
+  bool diagonally_dominant;
+  uint64_t seed;
+  row_map_view_t row_map;
+  entries_view_t entries;
+  values_view_t values;
+
+  GenerateRandomRows(lno_t ncols_, lno_t elements_per_row_, lno_t row_size_variance_, lno_t bandwidth_,
+      bool diagonally_dominant_, uint64_t seed_,
+      row_map_view_t row_map_, entries_view_t entries_, values_view_t values_):
+    ncols(ncols_), elements_per_row(elements_per_row_), row_size_variance(row_size_variance_),
+    bandwidth(bandwidth_ < 1 ? 1 : (bandwidth_ > ncols_ ? ncols_ : bandwidth_)),
+    diagonally_dominant(diagonally_dominant_), seed(seed_),
+    row_map(row_map_), entries(entries_), values(values_){}
+
+  KOKKOS_INLINE_FUNCTION
+  lno_t row_size(generator_t &gen) const{
+    lno_t n = elements_per_row + lno_t((gen.drand() - 0.5) * row_size_variance);
+    const lno_t lo = diagonally_dominant ? 1 : 0;
+    return n < lo ? lo : (n > bandwidth ? bandwidth : n);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const CountTag&, const lno_t &row) const{
+    generator_t gen = kk_generator_stream<device_t>(seed, row);
+    row_map(row) = row_size(gen);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const FillTag&, const lno_t &row) const{
+    generator_t gen = kk_generator_stream<device_t>(seed, row);
+    row_size(gen);
+    const size_type begin = row_map(row);
+    const size_type end = row_map(row + 1) - (diagonally_dominant ? 1 : 0);
+    mag_t total = 0;
+    for (size_type k = begin; k < end; ++k){
+      while (true){
+        lno_t pos = (row + lno_t(gen.urand64(bandwidth)) - bandwidth / 2) % ncols;
+        if (pos < 0) pos += ncols;
+        if (diagonally_dominant && pos == row) continue;
+        bool is_already_in_the_row = false;
+        for (size_type j = begin; j < k; ++j){
+          if (entries(j) == pos){
+            is_already_in_the_row = true;
+            break;
+          }
+        }
+        if (!is_already_in_the_row){
+          entries(k) = pos;
+          values(k) = Kokkos::rand<generator_t, scalar_t>::draw(gen, scalar_t(-50), scalar_t(50));
+          total += Kokkos::Details::ArithTraits<scalar_t>::abs(values(k));
+          break;
+        }
+      }
+    }
+    if (diagonally_dominant){
+      entries(end) = row;
+      values(end) = scalar_t(10 * total);
+    }
+  }
+};
+
+//Rows of a band [row - lower, row + upper], with random off diagonal
+//values in [-1, 1] and the diagonal lower + upper + 1.
+template <typename row_map_view_t, typename entries_view_t, typename values_view_t>
+struct GenerateBandedRows{
+  typedef typename row_map_view_t::non_const_value_type size_type;
+  typedef typename entries_view_t::non_const_value_type lno_t;
+  typedef typename values_view_t::non_const_value_type scalar_t;
+  typedef typename entries_view_t::device_type device_t;
+  typedef Kokkos::Random_XorShift64<device_t> generator_t;
+
+  struct CountTag{};
+  struct FillTag{};
+
+  lno_t ncols, lower, upper;
+  uint64_t seed;
+  row_map_view_t row_map;
+  entries_view_t entries;
+  values_view_t values;
+
+  GenerateBandedRows(lno_t ncols_, lno_t lower_, lno_t upper_, uint64_t seed_,
+      row_map_view_t row_map_, entries_view_t entries_, values_view_t values_):
+    ncols(ncols_), lower(lower_), upper(upper_), seed(seed_),
+    row_map(row_map_), entries(entries_), values(values_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void columns(const lno_t row, lno_t &first, lno_t &last) const{
+    first = row > lower ? row - lower : 0;
+    last = row + upper < ncols ? row + upper + 1 : ncols;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const CountTag&, const lno_t &row) const{
+    lno_t first, last;
+    columns(row, first, last);
+    row_map(row) = first < last ? last - first : 0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const FillTag&, const lno_t &row) const{
+    generator_t gen = kk_generator_stream<device_t>(seed, row);
+    lno_t first, last;
+    columns(row, first, last);
+    size_type k = row_map(row);
+    for (lno_t col = first; col < last; ++col, ++k){
+      entries(k) = col;
+      values(k) = (col == row) ?
+          scalar_t(lower + upper + 1) :
+          Kokkos::rand<generator_t, scalar_t>::draw(gen, scalar_t(-1), scalar_t(1));
+    }
+  }
+};
+
+//The 7 point Laplacian of a nx x ny x nz grid with Dirichlet boundaries;
+//the 5 point one when nz is 1. Rows are ordered x first, then y and z.
+template <typename row_map_view_t, typename entries_view_t, typename values_view_t>
+struct GenerateLaplacianRows{
+  typedef typename row_map_view_t::non_const_value_type size_type;
+  typedef typename entries_view_t::non_const_value_type lno_t;
+  typedef typename values_view_t::non_const_value_type scalar_t;
+
+  struct CountTag{};
+  struct FillTag{};
+
+  lno_t nx, ny, nz;
+  row_map_view_t row_map;
+  entries_view_t entries;
+  values_view_t values;
+
+  GenerateLaplacianRows(lno_t nx_, lno_t ny_, lno_t nz_,
+      row_map_view_t row_map_, entries_view_t entries_, values_view_t values_):
+    nx(nx_), ny(ny_), nz(nz_), row_map(row_map_), entries(entries_), values(values_){}
+
+  //the neighbors of row in increasing order; returns their number.
+  KOKKOS_INLINE_FUNCTION
+  int neighbors(const lno_t row, lno_t *cols) const{
+    const lno_t i = row % nx, j = (row / nx) % ny, l = row / (nx * ny);
+    int n = 0;
+    if (l > 0) cols[n++] = row - nx * ny;
+    if (j > 0) cols[n++] = row - nx;
+    if (i > 0) cols[n++] = row - 1;
+    cols[n++] = row;
+    if (i + 1 < nx) cols[n++] = row + 1;
+    if (j + 1 < ny) cols[n++] = row + nx;
+    if (l + 1 < nz) cols[n++] = row + nx * ny;
+    return n;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const CountTag&, const lno_t &row) const{
+    lno_t cols[7];
+    row_map(row) = neighbors(row, cols);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const FillTag&, const lno_t &row) const{
+    lno_t cols[7];
+    const int n = neighbors(row, cols);
+    const scalar_t diagonal = (nz > 1) ? scalar_t(6) : scalar_t(4);
+    size_type k = row_map(row);
+    for (int c = 0; c < n; ++c, ++k){
+      entries(k) = cols[c];
+      values(k) = (cols[c] == row) ? diagonal : scalar_t(-1);
+    }
+  }
+};
+
+//Undirected R-MAT edges: each edge descends scale levels of the adjacency
+//matrix, choosing a quadrant with probabilities a, b, c and 1 - a - b - c,
+//and is stored in both directions. Self loops are dropped.
+template <typename row_map_view_t, typename entries_view_t>
+struct GenerateRmatEdges{
+  typedef typename row_map_view_t::non_const_value_type size_type;
+  typedef typename entries_view_t::non_const_value_type lno_t;
+  typedef typename entries_view_t::device_type device_t;
+  typedef Kokkos::Random_XorShift64<device_t> generator_t;
+  typedef Kokkos::View<size_type *, device_t> counter_view_t;
+
+  struct CountTag{};
+  struct FillTag{};
+
+  int scale;
+  double a, ab, abc;
+  uint64_t seed;
+  row_map_view_t row_map;
+  counter_view_t counters;
+  entries_view_t entries;
+
+  GenerateRmatEdges(int scale_, double a_, double b_, double c_, uint64_t seed_,
+      row_map_view_t row_map_, counter_view_t counters_, entries_view_t entries_):
+    scale(scale_), a(a_), ab(a_ + b_), abc(a_ + b_ + c_), seed(seed_),
+    row_map(row_map_), counters(counters_), entries(entries_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void edge(const size_type e, lno_t &src, lno_t &dst) const{
+    generator_t gen = kk_generator_stream<device_t>(seed, e);
+    src = 0;
+    dst = 0;
+    for (int level = 0; level < scale; ++level){
+      const double r = gen.drand();
+      src = 2 * src + (r >= ab ? 1 : 0);
+      dst = 2 * dst + ((r >= a && r < ab) || r >= abc ? 1 : 0);
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const CountTag&, const size_type &e) const{
+    lno_t src, dst;
+    edge(e, src, dst);
+    if (src == dst) return;
+    Kokkos::atomic_fetch_add(&row_map(src), size_type(1));
+    Kokkos::atomic_fetch_add(&row_map(dst), size_type(1));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const FillTag&, const size_type &e) const{
+    lno_t src, dst;
+    edge(e, src, dst);
+    if (src == dst) return;
+    entries(row_map(src) + Kokkos::atomic_fetch_add(&counters(src), size_type(1))) = dst;
+    entries(row_map(dst) + Kokkos::atomic_fetch_add(&counters(dst), size_type(1))) = src;
+  }
+};
+
+//Counts, then moves, the distinct entries of each sorted row.
+template <typename in_row_map_view_t, typename in_entries_view_t, typename row_map_view_t, typename entries_view_t>
+struct UniqueSortedRows{
+  typedef typename row_map_view_t::non_const_value_type size_type;
+  typedef typename entries_view_t::non_const_value_type lno_t;
+
+  struct CountTag{};
+  struct FillTag{};
+
+  in_row_map_view_t in_row_map;
+  in_entries_view_t in_entries;
+  row_map_view_t row_map;
+  entries_view_t entries;
+
+  UniqueSortedRows(in_row_map_view_t in_row_map_, in_entries_view_t in_entries_,
+      row_map_view_t row_map_, entries_view_t entries_):
+    in_row_map(in_row_map_), in_entries(in_entries_), row_map(row_map_), entries(entries_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const CountTag&, const lno_t &row) const{
+    size_type n = 0;
+    for (size_type k = in_row_map(row); k < in_row_map(row + 1); ++k)
+      if (k == in_row_map(row) || in_entries(k) != in_entries(k - 1)) ++n;
+    row_map(row) = n;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const FillTag&, const lno_t &row) const{
+    size_type n = row_map(row);
+    for (size_type k = in_row_map(row); k < in_row_map(row + 1); ++k)
+      if (k == in_row_map(row) || in_entries(k) != in_entries(k - 1)) entries(n++) = in_entries(k);
+  }
+};
+
+//Runs the CountTag pass of generator over the rows, turns the counts into
+//the row map and returns the number of entries.
+template <typename generator_t, typename row_map_view_t, typename MyExecSpace>
+typename row_map_view_t::non_const_value_type kk_generate_row_map(
+    const char *label, const generator_t &generator, size_t nrows, row_map_view_t row_map){
+  typedef typename row_map_view_t::non_const_value_type size_type;
+  Kokkos::parallel_for(label, Kokkos::RangePolicy<typename generator_t::CountTag, MyExecSpace>(0, nrows), generator);
+  kk_exclusive_parallel_prefix_sum<row_map_view_t, MyExecSpace>(nrows + 1, row_map);
+  size_type nnz = 0;
+  Kokkos::deep_copy(nnz, Kokkos::subview(row_map, nrows));
+  return nnz;
+}
+
+template <typename crsMat_t>
+crsMat_t kk_generate_random_rows_parallel(
+    typename crsMat_t::const_ordinal_type nrows,
+    typename crsMat_t::const_ordinal_type ncols,
+    typename crsMat_t::non_const_size_type &nnz,
+    typename crsMat_t::const_ordinal_type row_size_variance,
+    typename crsMat_t::const_ordinal_type bandwidth,
+    bool diagonally_dominant, uint64_t seed){
+
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type row_map_view_t;
+  typedef typename graph_t::entries_type::non_const_type cols_view_t;
+  typedef typename crsMat_t::values_type::non_const_type values_view_t;
+  typedef typename crsMat_t::execution_space MyExecSpace;
+  typedef GenerateRandomRows<row_map_view_t, cols_view_t, values_view_t> generator_t;
+
+  row_map_view_t rowmap_view("rowmap_view", nrows + 1);
+  const typename crsMat_t::non_const_ordinal_type elements_per_row = nrows > 0 ? nnz / nrows : 0;
+  nnz = kk_generate_row_map<generator_t, row_map_view_t, MyExecSpace>(
+      "KokkosKernels::GenerateRandomRows::Count",
+      generator_t(ncols, elements_per_row, row_size_variance, bandwidth, diagonally_dominant, seed,
+          rowmap_view, cols_view_t(), values_view_t()),
+      nrows, rowmap_view);
+
+  crsMat_t crsmat = kk_allocate_first_touch_crs_matrix<crsMat_t>(ncols, rowmap_view, nnz);
+  cols_view_t columns_view = crsmat.graph.entries;
+  values_view_t values_view = crsmat.values;
+  Kokkos::parallel_for("KokkosKernels::GenerateRandomRows::Fill",
+      Kokkos::RangePolicy<typename generator_t::FillTag, MyExecSpace>(0, nrows),
+      generator_t(ncols, elements_per_row, row_size_variance, bandwidth, diagonally_dominant, seed,
+          rowmap_view, columns_view, values_view));
+  MyExecSpace::fence();
+  return crsmat;
+}
+
+/**
+ * \brief Parallel version of kk_generate_sparse_matrix: rows of about
+ * nnz / nrows distinct random columns, within bandwidth of the diagonal
+ * (modulo ncols), with random values in [-50, 50]. Generated on the
+ * execution space of crsMat_t; the matrix depends only on the arguments
+ * and the seed.
+ * \param nnz: in, the requested number of entries; out, the actual one.
+ */
+template <typename crsMat_t>
+crsMat_t kk_generate_sparse_matrix_parallel(
+    typename crsMat_t::const_ordinal_type nrows,
+    typename crsMat_t::const_ordinal_type ncols,
+    typename crsMat_t::non_const_size_type &nnz,
+    typename crsMat_t::const_ordinal_type row_size_variance,
+    typename crsMat_t::const_ordinal_type bandwidth,
+    uint64_t seed = 13721){
+  return kk_generate_random_rows_parallel<crsMat_t>(nrows, ncols, nnz, row_size_variance, bandwidth, false, seed);
+}
+
+/**
+ * \brief Parallel version of kk_generate_diagonally_dominant_sparse_matrix,
+ * as kk_generate_sparse_matrix_parallel with the diagonal entry of each
+ * row ten times the sum of the magnitudes of the others. nrows must not
+ * exceed ncols.
+ */
+template <typename crsMat_t>
+crsMat_t kk_generate_diagonally_dominant_sparse_matrix_parallel(
+    typename crsMat_t::const_ordinal_type nrows,
+    typename crsMat_t::const_ordinal_type ncols,
+    typename crsMat_t::non_const_size_type &nnz,
+    typename crsMat_t::const_ordinal_type row_size_variance,
+    typename crsMat_t::const_ordinal_type bandwidth,
+    uint64_t seed = 13721){
+  return kk_generate_random_rows_parallel<crsMat_t>(nrows, ncols, nnz, row_size_variance, bandwidth, true, seed);
+}
+
+/**
+ * \brief Generates in parallel the nrows x ncols banded matrix with the
+ * entries [row - lower, row + upper] of each row, random off diagonal
+ * values in [-1, 1] and diagonal lower + upper + 1, so that it is
+ * diagonally dominant.
+ */
+template <typename crsMat_t>
+crsMat_t kk_generate_banded_matrix(
+    typename crsMat_t::const_ordinal_type nrows,
+    typename crsMat_t::const_ordinal_type ncols,
+    typename crsMat_t::const_ordinal_type lower,
+    typename crsMat_t::const_ordinal_type upper,
+    uint64_t seed = 13721){
+
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type row_map_view_t;
+  typedef typename graph_t::entries_type::non_const_type cols_view_t;
+  typedef typename crsMat_t::values_type::non_const_type values_view_t;
+  typedef typename crsMat_t::execution_space MyExecSpace;
+  typedef GenerateBandedRows<row_map_view_t, cols_view_t, values_view_t> generator_t;
+
+  row_map_view_t rowmap_view("rowmap_view", nrows + 1);
+  const typename crsMat_t::non_const_size_type nnz = kk_generate_row_map<generator_t, row_map_view_t, MyExecSpace>(
+      "KokkosKernels::GenerateBandedRows::Count",
+      generator_t(ncols, lower, upper, seed, rowmap_view, cols_view_t(), values_view_t()),
+      nrows, rowmap_view);
+
+  crsMat_t crsmat = kk_allocate_first_touch_crs_matrix<crsMat_t>(ncols, rowmap_view, nnz);
+  cols_view_t columns_view = crsmat.graph.entries;
+  values_view_t values_view = crsmat.values;
+  Kokkos::parallel_for("KokkosKernels::GenerateBandedRows::Fill",
+      Kokkos::RangePolicy<typename generator_t::FillTag, MyExecSpace>(0, nrows),
+      generator_t(ncols, lower, upper, seed, rowmap_view, columns_view, values_view));
+  MyExecSpace::fence();
+  return crsmat;
+}
+
+/**
+ * \brief Generates in parallel the Laplacian of a nx x ny x nz grid with
+ * Dirichlet boundaries: the 5 point stencil when nz is 1, the 7 point
+ * one otherwise. The entries of each row are sorted.
+ */
+template <typename crsMat_t>
+crsMat_t kk_generate_laplacian_matrix(
+    typename crsMat_t::const_ordinal_type nx,
+    typename crsMat_t::const_ordinal_type ny,
+    typename crsMat_t::const_ordinal_type nz = 1){
+
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type row_map_view_t;
+  typedef typename graph_t::entries_type::non_const_type cols_view_t;
+  typedef typename crsMat_t::values_type::non_const_type values_view_t;
+  typedef typename crsMat_t::execution_space MyExecSpace;
+  typedef GenerateLaplacianRows<row_map_view_t, cols_view_t, values_view_t> generator_t;
+
+  const typename crsMat_t::non_const_ordinal_type nrows = nx * ny * nz;
+  row_map_view_t rowmap_view("rowmap_view", nrows + 1);
+  const typename crsMat_t::non_const_size_type nnz = kk_generate_row_map<generator_t, row_map_view_t, MyExecSpace>(
+      "KokkosKernels::GenerateLaplacianRows::Count",
+      generator_t(nx, ny, nz, rowmap_view, cols_view_t(), values_view_t()),
+      nrows, rowmap_view);
+
+  crsMat_t crsmat = kk_allocate_first_touch_crs_matrix<crsMat_t>(nrows, rowmap_view, nnz);
+  cols_view_t columns_view = crsmat.graph.entries;
+  values_view_t values_view = crsmat.values;
+  Kokkos::parallel_for("KokkosKernels::GenerateLaplacianRows::Fill",
+      Kokkos::RangePolicy<typename generator_t::FillTag, MyExecSpace>(0, nrows),
+      generator_t(nx, ny, nz, rowmap_view, columns_view, values_view));
+  MyExecSpace::fence();
+  return crsmat;
+}
+
+/**
+ * \brief Generates in parallel the undirected R-MAT (Kronecker) graph of
+ * 2^scale vertices from edge_factor * 2^scale random edges, as a matrix
+ * of ones with sorted rows, without self loops and duplicate entries.
+ * The default probabilities are those of Graph500; vertices are not
+ * permuted.
+ */
+template <typename crsMat_t>
+crsMat_t kk_generate_rmat_matrix(
+    int scale, size_t edge_factor,
+    double a = 0.57, double b = 0.19, double c = 0.19,
+    uint64_t seed = 13721){
+
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type row_map_view_t;
+  typedef typename graph_t::entries_type::non_const_type cols_view_t;
+  typedef typename crsMat_t::values_type::non_const_type values_view_t;
+  typedef typename crsMat_t::execution_space MyExecSpace;
+  typedef typename crsMat_t::non_const_ordinal_type lno_t;
+  typedef typename crsMat_t::non_const_size_type size_type;
+  typedef GenerateRmatEdges<row_map_view_t, cols_view_t> edges_t;
+  typedef UniqueSortedRows<row_map_view_t, cols_view_t, row_map_view_t, cols_view_t> unique_t;
+
+  const lno_t nrows = lno_t(1) << scale;
+  const size_type nedges = size_type(edge_factor) << scale;
+
+  //all edges in both directions, with duplicates
+  row_map_view_t edge_row_map("rowmap_view", nrows + 1);
+  typename edges_t::counter_view_t counters("counters", nrows);
+  Kokkos::parallel_for("KokkosKernels::GenerateRmatEdges::Count",
+      Kokkos::RangePolicy<typename edges_t::CountTag, MyExecSpace>(0, nedges),
+      edges_t(scale, a, b, c, seed, edge_row_map, counters, cols_view_t()));
+  kk_exclusive_parallel_prefix_sum<row_map_view_t, MyExecSpace>(nrows + 1, edge_row_map);
+  size_type num_edge_entries = 0;
+  Kokkos::deep_copy(num_edge_entries, Kokkos::subview(edge_row_map, nrows));
+
+  cols_view_t edge_entries(Kokkos::ViewAllocateWithoutInitializing("edge_entries"), num_edge_entries);
+  Kokkos::parallel_for("KokkosKernels::GenerateRmatEdges::Fill",
+      Kokkos::RangePolicy<typename edges_t::FillTag, MyExecSpace>(0, nedges),
+      edges_t(scale, a, b, c, seed, edge_row_map, counters, edge_entries));
+  MyExecSpace::fence();
+  kk_sort_crs_rows<row_map_view_t, cols_view_t, values_view_t, MyExecSpace>(edge_row_map, edge_entries, values_view_t());
+
+  row_map_view_t rowmap_view("rowmap_view", nrows + 1);
+  const size_type nnz = kk_generate_row_map<unique_t, row_map_view_t, MyExecSpace>(
+      "KokkosKernels::UniqueSortedRows::Count",
+      unique_t(edge_row_map, edge_entries, rowmap_view, cols_view_t()),
+      nrows, rowmap_view);
+
+  crsMat_t crsmat = kk_allocate_first_touch_crs_matrix<crsMat_t>(nrows, rowmap_view, nnz);
+  cols_view_t columns_view = crsmat.graph.entries;
+  values_view_t values_view = crsmat.values;
+  Kokkos::parallel_for("KokkosKernels::UniqueSortedRows::Fill",
+      Kokkos::RangePolicy<typename unique_t::FillTag, MyExecSpace>(0, nrows),
+      unique_t(edge_row_map, edge_entries, rowmap_view, columns_view));
+  Kokkos::deep_copy(values_view, typename values_view_t::non_const_value_type(1));
+  MyExecSpace::fence();
+  return crsmat;
 }
 
 }
@@ -0,0 +1,301 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSKERNELS_TUNINGDATABASE_HPP
+#define _KOKKOSKERNELS_TUNINGDATABASE_HPP
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <Kokkos_Core.hpp>
+
+namespace KokkosKernels{
+
+namespace Impl{
+
+/*! \brief The parameters of a kernel handle tuned for one kernel and one class of inputs.
+ *
+ * A negative value leaves the handle default. algorithm is the value of the
+ * algorithm enum of the kernel (SPGEMMAlgorithm, ColoringAlgorithm,
+ * GSAlgorithm ...), time the time of the run that recorded the entry.
+ */
+struct KernelTuning{
+  int team_size;
+  int vector_size;
+  long long shmem_size;
+  int dynamic_scheduling;
+  int algorithm;
+  double time;
+
+  KernelTuning(): team_size(-1), vector_size(-1), shmem_size(-1),
+      dynamic_scheduling(-1), algorithm(-1), time(-1){}
+};
+
+/*! \brief Tuned handle parameters, keyed by (kernel, execution space, rows bucket, degree bucket).
+ *
+ * The rows bucket is floor(log2(num_rows)), the degree bucket floor(log2(nnz / num_rows + 1)),
+ * so matrices of the same order of size and average row length share an entry.
+ * The database is a JSON array of flat objects, one per entry:
+ *
+ *   [
+ *     {"kernel": "spgemm", "space": "Cuda", "rows_bucket": 20, "degree_bucket": 4,
+ *      "team_size": 4, "vector_size": 8, "shmem_size": 32768, "dynamic_scheduling": 1,
+ *      "algorithm": 3, "time": 0.0125}
+ *   ]
+ *
+ * Missing parameters are left to the handle. It is read at first use from the file
+ * named by the environment variable KOKKOSKERNELS_TUNING_FILE, if set. It is not
+ * thread safe to change it while handles consult it.
+ */
+class TuningDatabase{
+public:
+  typedef std::tuple<std::string, std::string, int, int> key_type;
+
+  static int rows_bucket(size_t num_rows){
+    int b = 0;
+    for ( ; num_rows > 1; num_rows >>= 1) ++b;
+    return b;
+  }
+
+  static int degree_bucket(const size_t num_rows, const size_t nnz){
+    return rows_bucket(num_rows == 0 ? 1 : nnz / num_rows + 1);
+  }
+
+  static key_type key(const std::string &kernel, const std::string &space, const size_t num_rows, const size_t nnz){
+    return key_type(kernel, space, rows_bucket(num_rows), degree_bucket(num_rows, nnz));
+  }
+
+  bool empty() const { return table.empty(); }
+  size_t size() const { return table.size(); }
+  void clear(){ table.clear(); }
+
+  //! The entry of the bucket of (num_rows, nnz); false if there is none.
+  bool get(const std::string &kernel, const std::string &space, const size_t num_rows, const size_t nnz,
+           KernelTuning &tuning) const{
+    if (table.empty()) return false;
+    const std::map<key_type, KernelTuning>::const_iterator it = table.find(key(kernel, space, num_rows, nnz));
+    if (it == table.end()) return false;
+    tuning = it->second;
+    return true;
+  }
+
+  void set(const std::string &kernel, const std::string &space, const size_t num_rows, const size_t nnz,
+           const KernelTuning &tuning){
+    table[key(kernel, space, num_rows, nnz)] = tuning;
+  }
+
+  /*! \brief Sets the entry unless the bucket has one with a shorter time, as a
+   *  tuner trying several parameters on the same inputs does.
+   *  \return whether the entry was set.
+   */
+  bool record(const std::string &kernel, const std::string &space, const size_t num_rows, const size_t nnz,
+              const KernelTuning &tuning){
+    KernelTuning old;
+    if (get(kernel, space, num_rows, nnz, old) && old.time >= 0 && (tuning.time < 0 || old.time <= tuning.time))
+      return false;
+    set(kernel, space, num_rows, nnz, tuning);
+    return true;
+  }
+
+  bool save(const std::string &filename) const{
+    std::ofstream os(filename.c_str());
+    if (!os) return false;
+    os << "[";
+    bool first = true;
+    for (std::map<key_type, KernelTuning>::const_iterator it = table.begin(); it != table.end(); ++it){
+      const KernelTuning &t = it->second;
+      os << (first ? "\n" : ",\n")
+         << "  {\"kernel\": \"" << std::get<0>(it->first) << "\", \"space\": \"" << std::get<1>(it->first)
+         << "\", \"rows_bucket\": " << std::get<2>(it->first) << ", \"degree_bucket\": " << std::get<3>(it->first)
+         << ", \"team_size\": " << t.team_size << ", \"vector_size\": " << t.vector_size
+         << ", \"shmem_size\": " << t.shmem_size << ", \"dynamic_scheduling\": " << t.dynamic_scheduling
+         << ", \"algorithm\": " << t.algorithm << ", \"time\": " << t.time << "}";
+      first = false;
+    }
+    os << "\n]\n";
+    return bool(os);
+  }
+
+  /*! \brief Adds the entries of a database written by save. Unknown keys are
+   *  ignored. Returns false if the file cannot be read or is malformed, in which
+   *  case no entry is added.
+   */
+  bool load(const std::string &filename){
+    std::ifstream is(filename.c_str());
+    if (!is) return false;
+    std::stringstream ss;
+    ss << is.rdbuf();
+    const std::string text = ss.str();
+    size_t pos = 0;
+
+    std::map<key_type, KernelTuning> entries;
+    if (!expect(text, pos, '[')) return false;
+    skip_space(text, pos);
+    if (pos < text.size() && text[pos] == ']') return true;
+    while (true){
+      if (!expect(text, pos, '{')) return false;
+      std::string kernel, space;
+      int rb = -1, db = -1;
+      KernelTuning t;
+      while (true){
+        std::string name, str_value;
+        double num_value = 0;
+        bool is_string = false;
+        if (!parse_string(text, pos, name) || !expect(text, pos, ':')) return false;
+        skip_space(text, pos);
+        if (pos < text.size() && text[pos] == '"'){
+          if (!parse_string(text, pos, str_value)) return false;
+          is_string = true;
+        }
+        else if (!parse_number(text, pos, num_value)) return false;
+
+        if (name == "kernel" && is_string) kernel = str_value;
+        else if (name == "space" && is_string) space = str_value;
+        else if (is_string) {}
+        else if (name == "rows_bucket") rb = int(num_value);
+        else if (name == "degree_bucket") db = int(num_value);
+        else if (name == "team_size") t.team_size = int(num_value);
+        else if (name == "vector_size") t.vector_size = int(num_value);
+        else if (name == "shmem_size") t.shmem_size = (long long)(num_value);
+        else if (name == "dynamic_scheduling") t.dynamic_scheduling = int(num_value);
+        else if (name == "algorithm") t.algorithm = int(num_value);
+        else if (name == "time") t.time = num_value;
+
+        skip_space(text, pos);
+        if (pos < text.size() && text[pos] == ','){ ++pos; continue; }
+        if (!expect(text, pos, '}')) return false;
+        break;
+      }
+      if (kernel.empty() || space.empty() || rb < 0 || db < 0) return false;
+      entries[key_type(kernel, space, rb, db)] = t;
+
+      skip_space(text, pos);
+      if (pos < text.size() && text[pos] == ','){ ++pos; continue; }
+      if (!expect(text, pos, ']')) return false;
+      break;
+    }
+    for (std::map<key_type, KernelTuning>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+      table[it->first] = it->second;
+    return true;
+  }
+
+private:
+  static void skip_space(const std::string &text, size_t &pos){
+    while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+  }
+
+  static bool expect(const std::string &text, size_t &pos, const char c){
+    skip_space(text, pos);
+    if (pos >= text.size() || text[pos] != c) return false;
+    ++pos;
+    return true;
+  }
+
+  //a string without escapes, as save writes them.
+  static bool parse_string(const std::string &text, size_t &pos, std::string &value){
+    if (!expect(text, pos, '"')) return false;
+    const size_t end = text.find('"', pos);
+    if (end == std::string::npos) return false;
+    value = text.substr(pos, end - pos);
+    pos = end + 1;
+    return true;
+  }
+
+  static bool parse_number(const std::string &text, size_t &pos, double &value){
+    skip_space(text, pos);
+    const char *begin = text.c_str() + pos;
+    char *end = NULL;
+    value = std::strtod(begin, &end);
+    if (end == begin) return false;
+    pos += end - begin;
+    return true;
+  }
+
+  std::map<key_type, KernelTuning> table;
+};
+
+//! The tuning database of the process, consulted by KokkosKernelsHandle::apply_tuning.
+inline TuningDatabase &tuning_database(){
+  static TuningDatabase database = [] (){
+    TuningDatabase d;
+    const char *filename = std::getenv("KOKKOSKERNELS_TUNING_FILE");
+    if (filename != NULL) d.load(filename);
+    return d;
+  }();
+  return database;
+}
+
+}
+
+namespace Experimental{
+
+//! Writes the tuning database to filename as JSON.
+inline void save_tuning_database(const std::string &filename){
+  if (!KokkosKernels::Impl::tuning_database().save(filename)){
+    std::ostringstream os;
+    os << "KokkosKernels::Experimental::save_tuning_database: Cannot write " << filename;
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+}
+
+//! Adds the entries of the JSON file filename to the tuning database.
+inline void load_tuning_database(const std::string &filename){
+  if (!KokkosKernels::Impl::tuning_database().load(filename)){
+    std::ostringstream os;
+    os << "KokkosKernels::Experimental::load_tuning_database: Cannot read " << filename;
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+}
+
+//! Forgets every tuned entry; handles keep their defaults.
+inline void clear_tuning_database(){
+  KokkosKernels::Impl::tuning_database().clear();
+}
+
+}
+}
+
+#endif
@@ -46,6 +46,7 @@
 #include <Kokkos_Core.hpp>
 #include "KokkosKernels_Utils.hpp"
 #include <iostream>
+#include <string>
 
 namespace KokkosKernels{
 
@@ -164,6 +165,9 @@ private:
   data_view_t data_view;
   data_type *data;
   PoolType pool_type;
+  //flags of the chunks handed out, only set for pools on a UniformMemoryPoolStorage.
+  lock_view_t chunk_touched;
+  lock_type *pchunk_touched;
 
 public:
 
@@ -191,7 +195,9 @@ public:
                     pchunk_locks(),
                     data_view (),
                     data(),
-                    pool_type (pool_type_)
+                    pool_type (pool_type_),
+                    chunk_touched(),
+                    pchunk_touched(NULL)
                     {
 
     num_chunks = 1;
@@ -228,7 +234,39 @@ public:
                     pchunk_locks(),
                     data_view (),
                     data(),
-                    pool_type ()
+                    pool_type (),
+                    chunk_touched(),
+                    pchunk_touched(NULL)
+                    {
+  }
+
+  /**
+   * \brief UniformMemoryPool constructor on memory that is already allocated and
+   * initialized, used by UniformMemoryPoolStorage.
+   * \param num_chunks_: number of chunks, must be a power of 2.
+   * \param chunk_size_: chunk size, the size of each allocation.
+   * \param pool_type_: whether ManyThread2OneChunk or OneThread2OneChunk
+   * \param data_view_: the memory of the chunks, at least num_chunks_ * chunk_size_.
+   * \param chunk_locks_: zero locks of at least num_chunks_ chunks.
+   * \param chunk_touched_: flags set for the chunks allocated from the pool.
+   */
+  UniformMemoryPool(const size_t num_chunks_,
+                    const size_t chunk_size_,
+                    const PoolType pool_type_,
+                    data_view_t data_view_,
+                    lock_view_t chunk_locks_,
+                    lock_view_t chunk_touched_):
+                    num_chunks(num_chunks_),
+                    num_set_chunks(num_chunks_), modular_num_chunks(num_chunks_ - 1),
+                    chunk_size(chunk_size_),
+                    overall_size(num_chunks_ * chunk_size_),
+                    chunk_locks (chunk_locks_),
+                    pchunk_locks(chunk_locks_.data()),
+                    data_view (data_view_),
+                    data(data_view_.data()),
+                    pool_type (pool_type_),
+                    chunk_touched(chunk_touched_),
+                    pchunk_touched(chunk_touched_.data())
                     {
   }
 
@@ -319,15 +357,22 @@ public:
   KOKKOS_INLINE_FUNCTION
   data_type* allocate_chunk(const size_t &thread_index) const{
 
+    data_type *chunk_ptr = NULL;
     switch(this->pool_type){
     default:
     case OneThread2OneChunk:
       //printf("OneThread2OneChunk alloc for :%ld\n", thread_index);
-      return this->get_my_chunk(thread_index);
+      chunk_ptr = this->get_my_chunk(thread_index);
+      break;
     case ManyThread2OneChunk:
       //printf("ManyThread2OneChunk alloc for :%ld\n", thread_index);
-      return this->get_arbitrary_free_chunk(thread_index, num_chunks);
+      chunk_ptr = this->get_arbitrary_free_chunk(thread_index, num_chunks);
+      break;
     }
+    if (pchunk_touched != NULL && chunk_ptr != NULL){
+      pchunk_touched[(chunk_ptr - data) / chunk_size] = 1;
+    }
+    return chunk_ptr;
   }
 
   /**
@@ -371,6 +416,168 @@ public:
 
 };
 
+/**
+ * \brief Functor resetting the chunks of a persistent pool that were handed out.
+ */
+template <typename data_view_t, typename lock_view_t>
+struct ResetTouchedChunks{
+  typedef typename data_view_t::non_const_value_type data_type;
+  data_view_t data_view;
+  lock_view_t chunk_touched;
+  size_t chunk_size;
+  data_type initialized_value;
+
+  ResetTouchedChunks(data_view_t data_view_, lock_view_t chunk_touched_,
+                     size_t chunk_size_, data_type initialized_value_):
+    data_view(data_view_), chunk_touched(chunk_touched_),
+    chunk_size(chunk_size_), initialized_value(initialized_value_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t &i) const {
+    if (chunk_touched(i / chunk_size)) data_view(i) = initialized_value;
+  }
+};
+
+/*! \brief Persistent memory of UniformMemoryPools, reused across kernel calls.
+ *  Constructing a UniformMemoryPool allocates and initializes its whole memory,
+ *  which dominates the kernels on small inputs called many times.
+ *  The storage keeps the memory, the locks and the chunks handed out across calls,
+ *  and grows when a call needs more memory.
+ *
+ *  The pools return chunks as they find them, so after a call the chunks still hold
+ *  the initialized values at the places the kernel relies on. A later pool with the
+ *  same label, layout_param, chunk size and initialized value therefore needs no
+ *  initialization. Otherwise, only the chunks handed out since the layout was set
+ *  are reset, plus the memory the previous pools did not cover.
+ *  The label and layout_param identify which entries of a chunk a kernel expects
+ *  initialized, e.g. the name of the kernel and its hash size.
+ *
+ *  The pools must not be used by two kernels at the same time.
+ */
+template <typename MyExecSpace, typename data_type>
+class UniformMemoryPoolStorage{
+public:
+  typedef UniformMemoryPool<MyExecSpace, data_type> pool_type;
+
+private:
+  typedef int lock_type;
+  typedef typename Kokkos::View <lock_type *, MyExecSpace> lock_view_t;
+  typedef typename Kokkos::View <data_type *, MyExecSpace> data_view_t;
+  typedef typename MyExecSpace::execution_space pool_exec_space;
+
+  data_view_t data_view;
+  lock_view_t chunk_locks;
+  lock_view_t chunk_touched;
+
+  //layout of the last pool.
+  std::string layout_label;
+  size_t layout_param;
+  size_t num_chunks;
+  size_t chunk_size;
+  data_type initialized_value;
+  //entries of data_view holding initialized values, or returned as found.
+  size_t initialized_size;
+
+  size_t num_allocations;
+  size_t num_layout_resets;
+
+public:
+  UniformMemoryPoolStorage():
+    data_view(), chunk_locks(), chunk_touched(),
+    layout_label(), layout_param(0), num_chunks(0), chunk_size(0),
+    initialized_value(), initialized_size(0),
+    num_allocations(0), num_layout_resets(0){}
+
+  /**
+   * \brief Returns a pool with the arguments of the UniformMemoryPool constructor
+   * on the persistent memory, resetting only the memory the layout needs.
+   * \param label: name of the kernel using the pool.
+   * \param layout_param_: parameter of the kernel fixing the layout of a chunk.
+   */
+  pool_type borrow_pool(const std::string &label, const size_t layout_param_,
+                        const size_t num_chunks_, const size_t chunk_size_,
+                        const data_type initialized_value_, const PoolType pool_type_){
+    size_t pow2_num_chunks = 1;
+    while (num_chunks_ > pow2_num_chunks){
+      pow2_num_chunks *= 2;
+    }
+    const size_t required_size = pow2_num_chunks * chunk_size_;
+    bool same_layout = label == layout_label && layout_param_ == layout_param &&
+        chunk_size_ == chunk_size && initialized_value_ == initialized_value;
+
+    if (required_size > data_view.extent(0)){
+      data_view = data_view_t(Kokkos::ViewAllocateWithoutInitializing("persistent pool data"), required_size);
+      Kokkos::deep_copy(data_view, initialized_value_);
+      initialized_size = required_size;
+      ++num_allocations;
+      //no chunk of the new memory is handed out yet.
+      same_layout = false;
+      num_chunks = 0;
+    }
+    else if (!same_layout){
+      if (!(initialized_value_ == initialized_value)){
+        initialized_size = 0;
+      }
+      else if (num_chunks > 0 && chunk_size > 0){
+        //only the chunks handed out since the last layout are dirty.
+        const size_t touched_size = KOKKOSKERNELS_MACRO_MIN(num_chunks * chunk_size, initialized_size);
+        Kokkos::parallel_for("KokkosKernels::ResetTouchedChunks",
+            Kokkos::RangePolicy<pool_exec_space>(0, touched_size),
+            ResetTouchedChunks<data_view_t, lock_view_t>(data_view, chunk_touched, chunk_size, initialized_value_));
+        ++num_layout_resets;
+      }
+    }
+    if (required_size > initialized_size){
+      Kokkos::deep_copy(
+          Kokkos::subview(data_view, std::make_pair(initialized_size, required_size)),
+          initialized_value_);
+      initialized_size = required_size;
+    }
+
+    if (chunk_locks.extent(0) < pow2_num_chunks){
+      chunk_locks = lock_view_t("persistent pool locks", pow2_num_chunks);
+    }
+    if (!same_layout && chunk_touched.extent(0) >= pow2_num_chunks){
+      Kokkos::deep_copy(chunk_touched, lock_type(0));
+    }
+    else if (chunk_touched.extent(0) < pow2_num_chunks){
+      lock_view_t new_chunk_touched("persistent pool touched chunks", pow2_num_chunks);
+      if (same_layout && chunk_touched.extent(0) > 0){
+        Kokkos::deep_copy(
+            Kokkos::subview(new_chunk_touched, std::make_pair(size_t (0), size_t (chunk_touched.extent(0)))),
+            chunk_touched);
+      }
+      chunk_touched = new_chunk_touched;
+    }
+    pool_exec_space::fence();
+
+    if (!same_layout || pow2_num_chunks > num_chunks){
+      num_chunks = pow2_num_chunks;
+    }
+    layout_label = label;
+    layout_param = layout_param_;
+    chunk_size = chunk_size_;
+    initialized_value = initialized_value_;
+
+    return pool_type(pow2_num_chunks, chunk_size_, pool_type_, data_view, chunk_locks, chunk_touched);
+  }
+
+  /**
+   * \brief Frees the memory, the next pool allocates it again.
+   */
+  void clear(){
+    data_view = data_view_t();
+    chunk_locks = lock_view_t();
+    chunk_touched = lock_view_t();
+    layout_label = std::string();
+    num_chunks = chunk_size = initialized_size = 0;
+  }
+
+  size_t get_allocated_bytes() const {return data_view.extent(0) * sizeof(data_type);}
+  size_t get_num_allocations() const {return num_allocations;}
+  size_t get_num_layout_resets() const {return num_layout_resets;}
+};
+
 }
 }
 
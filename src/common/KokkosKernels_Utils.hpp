@@ -609,14 +609,14 @@ struct LinearInitialization{
 template <typename array_type, typename MyExecSpace>
 void linear_init(typename array_type::value_type num_elements, array_type arr){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
-  Kokkos::parallel_for( my_exec_space(0, num_elements), LinearInitialization<array_type>(arr));
+  Kokkos::parallel_for( "KokkosKernels::LinearInitialization", my_exec_space(0, num_elements), LinearInitialization<array_type>(arr));
 }
 
 
 template <typename forward_array_type, typename MyExecSpace>
 void remove_zeros_in_xadj_vector(typename forward_array_type::value_type num_elements, forward_array_type arr){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
-  Kokkos::parallel_scan( my_exec_space(0, num_elements), PropogataMaxValstoZeros<forward_array_type>(arr));
+  Kokkos::parallel_scan( "KokkosKernels::PropagateMaxValsToZeros", my_exec_space(0, num_elements), PropogataMaxValstoZeros<forward_array_type>(arr));
 }
 
 
@@ -859,6 +859,47 @@ void permute_vector(
 
 }
 
+template <typename value_array_type, typename out_value_array_type, typename idx_array_type>
+struct PermuteMultiVector{
+  typedef typename idx_array_type::value_type idx;
+  value_array_type old_vector;
+  out_value_array_type new_vector;
+  idx_array_type old_to_new_mapping;
+  idx mapping_size;
+  idx num_vectors;
+  PermuteMultiVector(
+      value_array_type old_vector_,
+      out_value_array_type new_vector_,
+      idx_array_type old_to_new_mapping_):
+        old_vector(old_vector_), new_vector(new_vector_),old_to_new_mapping(old_to_new_mapping_),
+        mapping_size(old_to_new_mapping_.extent(0)), num_vectors(old_vector_.extent(1)){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const idx &ii) const {
+
+    idx mapping = ii;
+    if (ii < mapping_size) mapping = old_to_new_mapping[ii];
+    for (idx k = 0; k < num_vectors; ++k){
+      new_vector(mapping, k) = old_vector(ii, k);
+    }
+  }
+};
+
+//permutes the rows of a multivector, as permute_vector does for a vector.
+template <typename value_array_type, typename out_value_array_type, typename idx_array_type, typename MyExecSpace>
+void permute_multivector(
+    typename idx_array_type::value_type num_elements,
+    idx_array_type &old_to_new_index_map,
+    value_array_type &old_vector,
+    out_value_array_type &new_vector
+    ){
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+
+  Kokkos::parallel_for("KokkosKernels::Impl::PermuteMultiVector", my_exec_space(0,num_elements),
+      PermuteMultiVector<value_array_type, out_value_array_type, idx_array_type>(old_vector, new_vector, old_to_new_index_map));
+
+}
+
 
 template <typename value_array_type, typename out_value_array_type, typename idx_array_type>
 struct PermuteBlockVector{
@@ -1040,7 +1081,7 @@ void symmetrize_and_get_lower_diagonal_edge_list(
     //std::cout << "max_allowed_team_size:" << max_allowed_team_size << " vs:" << vector_size << " tsm:" << teamSizeMax<< std::endl;
 
     Kokkos::parallel_for(
-        team_policy(num_rows_to_symmetrize / teamSizeMax + 1 , teamSizeMax, vector_size),
+        "KokkosKernels::SymmetrizeLowerDiagonalEdgeList::Count", team_policy(num_rows_to_symmetrize / teamSizeMax + 1 , teamSizeMax, vector_size),
         fse/*, num_symmetric_edges*/);
     MyExecSpace::fence();
 
@@ -1085,7 +1126,7 @@ void symmetrize_and_get_lower_diagonal_edge_list(
         xadj.extent(0) - 1, nnz);
 
     Kokkos::parallel_for(
-        team_policy(num_rows_to_symmetrize / teamSizeMax + 1 , teamSizeMax, vector_size),
+        "KokkosKernels::SymmetrizeLowerDiagonalEdgeList::Fill", team_policy(num_rows_to_symmetrize / teamSizeMax + 1 , teamSizeMax, vector_size),
         FSCH);
     MyExecSpace::fence();
   }
@@ -1159,7 +1200,7 @@ void symmetrize_graph_symbolic_hashmap(
         xadj.extent(0) - 1, nnz);
 
     Kokkos::parallel_for(
-        team_policy(num_rows_to_symmetrize / teamSizeMax + 1 , teamSizeMax, vector_size),
+        "KokkosKernels::SymmetrizeGraphHashmap::Count", team_policy(num_rows_to_symmetrize / teamSizeMax + 1 , teamSizeMax, vector_size),
         fse/*, num_symmetric_edges*/);
     MyExecSpace::fence();
   }
@@ -1201,7 +1242,7 @@ void symmetrize_graph_symbolic_hashmap(
         xadj.extent(0) - 1, nnz);
 
     Kokkos::parallel_for(
-        team_policy(num_rows_to_symmetrize / teamSizeMax + 1 , teamSizeMax, vector_size),
+        "KokkosKernels::SymmetrizeGraphHashmap::Fill", team_policy(num_rows_to_symmetrize / teamSizeMax + 1 , teamSizeMax, vector_size),
         FSCH);
     MyExecSpace::fence();
   }
@@ -1210,6 +1251,123 @@ void symmetrize_graph_symbolic_hashmap(
 
 }
 
+//Merges row i of a sorted graph and of its sorted transpose, without duplicates
+//and optionally without the diagonal: the rows of the pattern of A + A^T.
+template <typename a_row_view_t, typename a_nnz_view_t,
+          typename t_row_view_t, typename t_nnz_view_t,
+          typename out_row_view_t, typename out_nnz_view_t>
+struct SymmetrizeSortedRows{
+  typedef typename out_row_view_t::non_const_value_type size_type;
+  typedef typename out_nnz_view_t::non_const_value_type lno_t;
+
+  struct CountTag{};
+  struct FillTag{};
+
+  a_row_view_t xadj;
+  a_nnz_view_t adj;
+  t_row_view_t t_xadj;
+  t_nnz_view_t t_adj;
+  out_row_view_t sym_xadj;
+  out_nnz_view_t sym_adj;
+  bool remove_diagonal;
+
+  SymmetrizeSortedRows(a_row_view_t xadj_, a_nnz_view_t adj_, t_row_view_t t_xadj_, t_nnz_view_t t_adj_,
+      out_row_view_t sym_xadj_, out_nnz_view_t sym_adj_, bool remove_diagonal_):
+    xadj(xadj_), adj(adj_), t_xadj(t_xadj_), t_adj(t_adj_),
+    sym_xadj(sym_xadj_), sym_adj(sym_adj_), remove_diagonal(remove_diagonal_){}
+
+  //the merged row i, written from position k if fill is true; returns its length.
+  KOKKOS_INLINE_FUNCTION
+  size_type merge(const lno_t i, size_type k, const bool fill) const{
+    const size_type k_begin = k;
+    size_type a = xadj(i), t = t_xadj(i);
+    const size_type a_end = xadj(i + 1), t_end = t_xadj(i + 1);
+    bool has_last = false;
+    lno_t last = 0;
+    while (a < a_end || t < t_end){
+      lno_t j;
+      if (t == t_end || (a < a_end && adj(a) <= t_adj(t))) j = adj(a++);
+      else j = t_adj(t++);
+      if ((has_last && j == last) || (remove_diagonal && j == i)) continue;
+      if (fill) sym_adj(k) = j;
+      ++k;
+      last = j;
+      has_last = true;
+    }
+    return k - k_begin;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const CountTag&, const lno_t &i) const{
+    sym_xadj(i) = merge(i, 0, false);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const FillTag&, const lno_t &i) const{
+    merge(i, sym_xadj(i), true);
+  }
+};
+
+/**
+ * \brief The pattern of A + A^T of a square graph A, in parallel: the transpose
+ * is built on the device, the rows of both are sorted, and row i of the result
+ * merges row i of A and of A^T. Duplicate entries are removed, and so is the
+ * diagonal if remove_diagonal is true.
+ *
+ * \param num_rows: the number of rows and columns of the graph.
+ * \param xadj, adj: the graph. Its entries must be in [0, num_rows).
+ * \param sym_xadj, sym_adj: output, the symmetric graph with sorted rows. Allocated here.
+ * \param remove_diagonal: whether to drop the self loops.
+ */
+template <typename in_lno_row_view_t,
+          typename in_lno_nnz_view_t,
+          typename out_lno_row_view_t,
+          typename out_lno_nnz_view_t,
+          typename MyExecSpace>
+void symmetrize_graph(
+    typename in_lno_nnz_view_t::non_const_value_type num_rows,
+    in_lno_row_view_t xadj,
+    in_lno_nnz_view_t adj,
+    out_lno_row_view_t &sym_xadj,
+    out_lno_nnz_view_t &sym_adj,
+    bool remove_diagonal = false){
+
+  typedef typename out_lno_row_view_t::non_const_type row_view_t;
+  typedef typename out_lno_nnz_view_t::non_const_type nnz_view_t;
+  typedef SymmetrizeSortedRows<in_lno_row_view_t, nnz_view_t, row_view_t, nnz_view_t,
+      out_lno_row_view_t, out_lno_nnz_view_t> symmetrize_t;
+
+  const size_t nnz = adj.extent(0);
+  sym_xadj = out_lno_row_view_t("sym_xadj", num_rows + 1);
+  if (num_rows == 0){
+    sym_adj = out_lno_nnz_view_t("sym_adj", 0);
+    return;
+  }
+
+  nnz_view_t null_values;
+  nnz_view_t sorted_adj(Kokkos::ViewAllocateWithoutInitializing("sorted adj"), nnz);
+  kk_sort_graph<in_lno_row_view_t, in_lno_nnz_view_t, nnz_view_t, nnz_view_t, nnz_view_t, MyExecSpace>
+      (xadj, adj, null_values, sorted_adj, null_values);
+
+  row_view_t t_xadj("transpose xadj", num_rows + 1);
+  nnz_view_t t_adj(Kokkos::ViewAllocateWithoutInitializing("transpose adj"), nnz);
+  kk_transpose_graph<in_lno_row_view_t, in_lno_nnz_view_t, row_view_t, nnz_view_t, row_view_t, MyExecSpace>
+      (num_rows, num_rows, xadj, adj, t_xadj, t_adj);
+  nnz_view_t sorted_t_adj(Kokkos::ViewAllocateWithoutInitializing("sorted transpose adj"), nnz);
+  kk_sort_graph<row_view_t, nnz_view_t, nnz_view_t, nnz_view_t, nnz_view_t, MyExecSpace>
+      (t_xadj, t_adj, null_values, sorted_t_adj, null_values);
+
+  const size_t sym_nnz = kk_generate_row_map<symmetrize_t, out_lno_row_view_t, MyExecSpace>(
+      "KokkosKernels::SymmetrizeGraph::Count",
+      symmetrize_t(xadj, sorted_adj, t_xadj, sorted_t_adj, sym_xadj, out_lno_nnz_view_t(), remove_diagonal),
+      num_rows, sym_xadj);
+  sym_adj = out_lno_nnz_view_t(Kokkos::ViewAllocateWithoutInitializing("sym_adj"), sym_nnz);
+  Kokkos::parallel_for("KokkosKernels::SymmetrizeGraph::Fill",
+      Kokkos::RangePolicy<typename symmetrize_t::FillTag, MyExecSpace>(0, num_rows),
+      symmetrize_t(xadj, sorted_adj, t_xadj, sorted_t_adj, sym_xadj, sym_adj, remove_diagonal));
+  MyExecSpace::fence();
+}
+
 template <typename from_vector, typename to_vector, typename MyExecSpace>
 void copy_vector(
                 size_t num_elements,
@@ -1239,7 +1397,7 @@ void copy_view(
                 from_vector from, to_vector to){
 
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
-  Kokkos::parallel_for( my_exec_space(0,num_elements), CopyView<from_vector, to_vector>(from, to));
+  Kokkos::parallel_for( "KokkosKernels::CopyView", my_exec_space(0,num_elements), CopyView<from_vector, to_vector>(from, to));
 
 }
 
@@ -1322,7 +1480,7 @@ struct ReduceSumFunctor{
 template <typename view_type , typename MyExecSpace>
 void view_reduce_sum(size_t num_elements, view_type view_to_reduce, typename view_type::non_const_value_type &sum_reduction){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
-  Kokkos::parallel_reduce( my_exec_space(0,num_elements), ReduceSumFunctor<view_type>(view_to_reduce), sum_reduction);
+  Kokkos::parallel_reduce( "KokkosKernels::ReduceSum", my_exec_space(0,num_elements), ReduceSumFunctor<view_type>(view_to_reduce), sum_reduction);
 }
 
 
@@ -1373,7 +1531,7 @@ void kk_view_reduce_max_row_size(const size_t num_rows,
                 const size_type *rowmap_view_ends,
                 size_type &max_row_size){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
-  Kokkos::parallel_reduce( my_exec_space(0,num_rows),
+  Kokkos::parallel_reduce( "KokkosKernels::ReduceMaxRowSize", my_exec_space(0,num_rows),
       ReduceRowSizeFunctor<size_type>(rowmap_view_begins, rowmap_view_ends), max_row_size);
 }
 
@@ -1415,7 +1573,7 @@ struct ReduceMaxRowFunctor{
 template <typename view_type , typename MyExecSpace>
 void view_reduce_maxsizerow(size_t num_rows, view_type rowmap_view, typename view_type::non_const_value_type &max_reduction){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
-  Kokkos::parallel_reduce( my_exec_space(0,num_rows), ReduceMaxRowFunctor<view_type>(rowmap_view), max_reduction);
+  Kokkos::parallel_reduce( "KokkosKernels::ReduceMaxRow", my_exec_space(0,num_rows), ReduceMaxRowFunctor<view_type>(rowmap_view), max_reduction);
 }
 
 
@@ -1452,7 +1610,7 @@ template <typename view_type1, typename view_type2, typename MyExecSpace>
 bool isSame(size_t num_elements, view_type1 view1, view_type2 view2){
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
   int issame = 1;
-  Kokkos::parallel_reduce( my_exec_space(0,num_elements), IsEqualFunctor<view_type1, view_type2>(view1, view2), issame);
+  Kokkos::parallel_reduce( "KokkosKernels::IsEqual", my_exec_space(0,num_elements), IsEqualFunctor<view_type1, view_type2>(view1, view2), issame);
   MyExecSpace::fence();
   return issame;
 }
@@ -1620,7 +1778,7 @@ void transpose_matrix(
   int vector_size = get_suggested_vector__size(num_rows, nnz, get_exec_space_type<MyExecSpace>());
 
   Kokkos::Impl::Timer timer1;
-  Kokkos::parallel_for(  tcp_t(num_rows / team_row_work_size + 1 , Kokkos::AUTO_t(), vector_size), tm);
+  Kokkos::parallel_for(  "KokkosKernels::TransposeMatrix::Count", tcp_t(num_rows / team_row_work_size + 1 , Kokkos::AUTO_t(), vector_size), tm);
   MyExecSpace::fence();
 
   exclusive_parallel_prefix_sum<out_row_view_t, MyExecSpace>(num_cols+1, t_xadj);
@@ -1629,7 +1787,7 @@ void transpose_matrix(
   MyExecSpace::fence();
 
   timer1.reset();
-  Kokkos::parallel_for(  tfp_t(num_rows / team_row_work_size + 1 , Kokkos::AUTO_t(), vector_size), tm);
+  Kokkos::parallel_for(  "KokkosKernels::TransposeMatrix::Fill", tfp_t(num_rows / team_row_work_size + 1 , Kokkos::AUTO_t(), vector_size), tm);
   MyExecSpace::fence();
 }
 
@@ -1698,7 +1856,7 @@ void transpose_graph2(
   int vector_size = get_suggested_vector__size(num_rows, nnz, get_exec_space_type<MyExecSpace>());
 
   Kokkos::Impl::Timer timer1;
-  Kokkos::parallel_for(  tcp_t(num_rows  , Kokkos::AUTO_t(), vector_size), tm);
+  Kokkos::parallel_for(  "KokkosKernels::TransposeGraph::Count", tcp_t(num_rows  , Kokkos::AUTO_t(), vector_size), tm);
   MyExecSpace::fence();
 
   exclusive_parallel_prefix_sum<out_row_view_t, MyExecSpace>(num_cols+1, t_xadj);
@@ -1707,7 +1865,7 @@ void transpose_graph2(
   MyExecSpace::fence();
 
   timer1.reset();
-  Kokkos::parallel_for(  tfp_t(num_rows , Kokkos::AUTO_t(), vector_size), tm);
+  Kokkos::parallel_for(  "KokkosKernels::TransposeGraph::Fill", tfp_t(num_rows , Kokkos::AUTO_t(), vector_size), tm);
   MyExecSpace::fence();
 
 
@@ -1760,7 +1918,7 @@ void init_view_withscalar(typename in_row_view_t::size_type num_elements, in_row
   int vector_size = 1;
 
   Kokkos::Impl::Timer timer1;
-  Kokkos::parallel_for(  tcp_t(num_elements / chunk_size + 1 , team_size, vector_size), tm);
+  Kokkos::parallel_for(  "KokkosKernels::InitViewWithScalar", tcp_t(num_elements / chunk_size + 1 , team_size, vector_size), tm);
   MyExecSpace::fence();
 }
 
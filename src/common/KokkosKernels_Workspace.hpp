@@ -0,0 +1,179 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSKERNELS_WORKSPACE_HPP
+#define _KOKKOSKERNELS_WORKSPACE_HPP
+
+#include <Kokkos_Core.hpp>
+#include <type_traits>
+#include "KokkosKernels_FirstTouch.hpp"
+
+namespace KokkosKernels{
+
+namespace Impl{
+
+/*! \brief Grow-only bump allocator for the temporaries of the kernels.
+ *
+ *  The temporaries are carved out of a single allocation in a stack order:
+ *  a kernel opens a WorkspaceScope, takes its views with get_view, and the
+ *  scope returns them when it is closed. A request that does not fit falls
+ *  back to a regular allocation, and the workspace grows to the largest
+ *  use seen once the outermost scope is closed, so that from the second
+ *  call on the kernels do not allocate. The views are unmanaged, they must
+ *  not be used after the scope is closed. Kernels are launched in order on
+ *  the execution space, so memory returned by a scope can be reused by the
+ *  next kernel without a fence.
+ */
+template <typename MemorySpace>
+class WorkspaceArena{
+public:
+  typedef typename MemorySpace::memory_space memory_space;
+  enum : size_t { alignment = 128 };
+
+private:
+  typedef Kokkos::View<char *, memory_space> buffer_view_t;
+
+  buffer_view_t buffer;
+  //bytes handed out, may be larger than the buffer when requests did not fit.
+  size_t offset;
+  //the largest offset since the workspace was last grown.
+  size_t peak;
+  size_t num_allocations;
+  size_t num_fallback_allocations;
+
+  WorkspaceArena(const WorkspaceArena &);
+  WorkspaceArena &operator=(const WorkspaceArena &);
+
+public:
+  WorkspaceArena(): buffer(), offset(0), peak(0), num_allocations(0), num_fallback_allocations(0){}
+
+  /**
+   * \brief Returns a rank 1 view of n entries on the workspace, or newly
+   * allocated if it does not fit or is on another memory space. The
+   * entries are not initialized.
+   * \param label: label of the view if it is allocated.
+   */
+  template <typename view_t>
+  view_t get_view(const char *label, const size_t n){
+    static_assert (view_t::rank == 1, "KokkosKernels::WorkspaceArena: the views must have rank 1.");
+    typedef typename view_t::non_const_value_type value_t;
+
+    if (!std::is_same<typename view_t::memory_space, memory_space>::value){
+      return view_t(Kokkos::ViewAllocateWithoutInitializing(label), n);
+    }
+    const size_t begin = (offset + alignment - 1) / alignment * alignment;
+    const size_t end = begin + n * sizeof(value_t);
+    offset = end;
+    if (end > peak) peak = end;
+    if (end > buffer.extent(0)){
+      ++num_fallback_allocations;
+      return view_t(Kokkos::ViewAllocateWithoutInitializing(label), n);
+    }
+    return view_t(reinterpret_cast<value_t *>(buffer.data() + begin), n);
+  }
+
+  size_t mark() const {return offset;}
+
+  /**
+   * \brief Returns the views taken since mark m. Closing the outermost
+   * scope grows the workspace to the largest use.
+   */
+  void release_to(const size_t m){
+    offset = m;
+    if (offset == 0 && peak > buffer.extent(0)){
+      buffer = buffer_view_t();
+      buffer = buffer_view_t(Kokkos::ViewAllocateWithoutInitializing("KokkosKernels::Workspace"), peak);
+      //spread the pages over the sockets of the host rather than the
+      //first kernel that uses them.
+      kk_first_touch_view<buffer_view_t, typename memory_space::execution_space>(buffer);
+      ++num_allocations;
+    }
+    if (offset == 0) peak = 0;
+  }
+
+  /**
+   * \brief Frees the memory, the next use allocates it again.
+   */
+  void release(){
+    buffer = buffer_view_t();
+    offset = peak = 0;
+  }
+
+  size_t get_allocated_bytes() const {return buffer.extent(0);}
+  size_t get_num_allocations() const {return num_allocations;}
+  size_t get_num_fallback_allocations() const {return num_fallback_allocations;}
+};
+
+/*! \brief Returns the views a kernel takes from the workspace when it goes
+ *  out of scope. A NULL workspace is allowed, then nothing is done.
+ */
+template <typename workspace_t>
+class WorkspaceScope{
+  workspace_t *workspace;
+  size_t m;
+
+  WorkspaceScope(const WorkspaceScope &);
+  WorkspaceScope &operator=(const WorkspaceScope &);
+public:
+  WorkspaceScope(workspace_t *workspace_):
+    workspace(workspace_), m(workspace_ == NULL ? 0 : workspace_->mark()){}
+  ~WorkspaceScope(){
+    if (workspace != NULL) workspace->release_to(m);
+  }
+};
+
+/**
+ * \brief Returns a rank 1 view of n uninitialized entries, on the workspace
+ * if one is given, otherwise newly allocated.
+ */
+template <typename view_t, typename workspace_t>
+inline view_t kk_get_workspace_view(workspace_t *workspace, const char *label, const size_t n){
+  if (workspace != NULL){
+    return workspace->template get_view<view_t>(label, n);
+  }
+  return view_t(Kokkos::ViewAllocateWithoutInitializing(label), n);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_BFS_HPP
+#define _KOKKOSGRAPH_BFS_HPP
+
+#include "KokkosGraph_BFS_impl.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+/**
+ * \brief Direction-optimizing breadth first search.
+ *
+ * Small frontiers are expanded top-down from a queue, large ones bottom-up
+ * from a bitmap, so the levels of low diameter graphs cost close to one pass
+ * over the vertices. The graph should be structurally symmetric for the
+ * bottom-up steps to follow the same edges as the top-down ones.
+ *
+ * \param num_verts: number of vertices in the graph.
+ * \param row_map: the xadj array of the graph. Its size is num_verts + 1.
+ * \param entries: adjacency array of the graph. Entries not in [0, num_verts)
+ *   are ignored.
+ * \param root: the source vertex.
+ * \param direction: BFS_DIRECTION_OPTIMIZING (default), or BFS_TOP_DOWN or
+ *   BFS_BOTTOM_UP to use a single kind of step.
+ * \return the level of each vertex, -1 for vertices not reached from root.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_>
+typename Impl::BFS<lno_row_view_t_, lno_nnz_view_t_>::nnz_lno_temp_work_view_t
+graph_bfs(
+    typename lno_nnz_view_t_::non_const_value_type num_verts,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries,
+    typename lno_nnz_view_t_::non_const_value_type root,
+    BFSDirection direction = BFS_DIRECTION_OPTIMIZING){
+  typedef Impl::BFS<lno_row_view_t_, lno_nnz_view_t_> bfs_t;
+  typename bfs_t::nnz_lno_temp_work_view_t levels(
+      Kokkos::ViewAllocateWithoutInitializing("BFS Levels"), num_verts);
+  bfs_t bfs(num_verts, row_map, entries);
+  bfs.bfs(root, levels, direction);
+  return levels;
+}
+
+}
+}
+
+#endif
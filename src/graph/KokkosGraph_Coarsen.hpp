@@ -0,0 +1,179 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_COARSEN_HPP
+#define _KOKKOSGRAPH_COARSEN_HPP
+
+#include <sstream>
+#include <utility>
+#include "KokkosGraph_Coarsen_impl.hpp"
+#include "KokkosSparse_spgemm_triple.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+/**
+ * \brief Heavy edge matching of a weighted graph.
+ *
+ * The matching is maximal and deterministic. The graph must be
+ * structurally symmetric with symmetric weights.
+ *
+ * \param num_verts: number of vertices in the graph.
+ * \param row_map: the xadj array of the graph. Its size is num_verts + 1.
+ * \param entries: adjacency array of the graph. Entries not in [0, num_verts)
+ *   are ignored, as are self loops.
+ * \param weights: the weight of each entry.
+ * \return the vertex matched with each vertex, or the vertex itself if it
+ *   is not matched.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_view_t_>
+typename Impl::HeavyEdgeMatching<lno_row_view_t_, lno_nnz_view_t_, scalar_view_t_>::nnz_lno_temp_work_view_t
+graph_heavy_edge_matching(
+    typename lno_nnz_view_t_::non_const_value_type num_verts,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries,
+    scalar_view_t_ weights){
+  typedef Impl::HeavyEdgeMatching<lno_row_view_t_, lno_nnz_view_t_, scalar_view_t_> hem_t;
+  typename hem_t::nnz_lno_temp_work_view_t match(
+      Kokkos::ViewAllocateWithoutInitializing("HEM Match"), num_verts);
+  hem_t hem(num_verts, row_map, entries, weights);
+  hem.matching(match);
+  return match;
+}
+
+/**
+ * \brief Contracts the pairs of a matching.
+ *
+ * The coarse graph is P^T A P, where P has a one at (v, labels(v)), computed
+ * with spgemm_triple on the spgemm handle of handle, which must be created.
+ * Everything stays on device. The weight of a coarse edge is the sum of the
+ * fine edges between the two pairs, and the diagonal holds the weights inside
+ * a pair, twice the matched edge plus any self loops.
+ *
+ * \param handle: kernel handle with the spgemm handle created.
+ * \param num_verts: number of vertices in the graph.
+ * \param row_map, entries, weights: the weighted graph.
+ * \param match: a matching, as returned by graph_heavy_edge_matching.
+ * \param labels: output, the coarse vertex of each vertex. A pair is numbered
+ *   by its smaller vertex, in increasing order. Its size is num_verts.
+ * \param coarse_row_map, coarse_entries, coarse_weights: output, the coarse graph.
+ * \return the number of coarse vertices.
+ */
+template <typename KernelHandle,
+  typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_view_t_,
+  typename match_view_t_, typename label_view_t_,
+  typename c_row_view_t_, typename c_nnz_view_t_, typename c_scalar_view_t_>
+typename KernelHandle::nnz_lno_t
+graph_coarsen(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t num_verts,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries,
+    scalar_view_t_ weights,
+    match_view_t_ match,
+    label_view_t_ labels,
+    c_row_view_t_ &coarse_row_map,
+    c_nnz_view_t_ &coarse_entries,
+    c_scalar_view_t_ &coarse_weights){
+
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::nnz_scalar_t nnz_scalar_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::row_lno_temp_work_view_t row_lno_temp_work_view_t;
+  typedef typename KernelHandle::nnz_lno_temp_work_view_t nnz_lno_temp_work_view_t;
+  typedef typename KernelHandle::scalar_temp_work_view_t scalar_temp_work_view_t;
+  typedef Impl::MatchingOperators<match_view_t_, label_view_t_, row_lno_temp_work_view_t, nnz_lno_temp_work_view_t> operators_t;
+
+  if (match.extent(0) != size_t(num_verts) || labels.extent(0) != size_t(num_verts)){
+    std::ostringstream os;
+    os << "KokkosGraph::graph_coarsen: Dimensions do not match: "
+       << "match: " << match.extent(0) << ", labels: " << labels.extent(0) << ", num_verts: " << num_verts;
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+  if (handle->get_spgemm_handle() == NULL){
+    Kokkos::Impl::throw_runtime_exception(
+        "KokkosGraph::graph_coarsen: the spgemm handle has not been created, call create_spgemm_handle first");
+  }
+
+  //R = P^T, with the pairs as rows.
+  row_lno_temp_work_view_t row_mapR("coarsen R row map", num_verts + 1);
+  nnz_lno_temp_work_view_t entriesR(Kokkos::ViewAllocateWithoutInitializing("coarsen R entries"), num_verts);
+  operators_t operators(match, labels, row_mapR, entriesR);
+  nnz_lno_t num_coarse = 0;
+  Kokkos::parallel_reduce("KokkosGraph::Coarsen::CountPairs",
+      Kokkos::RangePolicy<MyExecSpace, typename operators_t::CountPairs>(0, num_verts), operators, num_coarse);
+  Kokkos::parallel_scan("KokkosGraph::Coarsen::NumberPairs",
+      Kokkos::RangePolicy<MyExecSpace, typename operators_t::NumberPairs>(0, num_verts), operators);
+  KokkosKernels::Impl::exclusive_parallel_prefix_sum<row_lno_temp_work_view_t, MyExecSpace>(num_coarse + 1, row_mapR);
+  Kokkos::parallel_for("KokkosGraph::Coarsen::FillOperators",
+      Kokkos::RangePolicy<MyExecSpace, typename operators_t::FillOperators>(0, num_verts), operators);
+  scalar_temp_work_view_t ones(Kokkos::ViewAllocateWithoutInitializing("coarsen ones"), num_verts);
+  Kokkos::deep_copy(ones, nnz_scalar_t(1));
+  auto row_mapR_coarse = Kokkos::subview(row_mapR, std::make_pair(nnz_lno_t(0), num_coarse + 1));
+
+  row_lno_temp_work_view_t row_mapP(Kokkos::ViewAllocateWithoutInitializing("coarsen P row map"), num_verts + 1);
+  KokkosKernels::Impl::linear_init<row_lno_temp_work_view_t, MyExecSpace>(num_verts + 1, row_mapP);
+
+  coarse_row_map = c_row_view_t_("coarse row map", num_coarse + 1);
+  KokkosSparse::Experimental::spgemm_triple_symbolic(
+      handle, num_coarse, num_verts, num_verts, num_coarse,
+      row_mapR_coarse, entriesR,
+      row_map, entries,
+      row_mapP, labels,
+      coarse_row_map);
+  const size_t coarse_nnz = handle->get_spgemm_handle()->get_c_nnz();
+  coarse_entries = c_nnz_view_t_(Kokkos::ViewAllocateWithoutInitializing("coarse entries"), coarse_nnz);
+  coarse_weights = c_scalar_view_t_(Kokkos::ViewAllocateWithoutInitializing("coarse weights"), coarse_nnz);
+  KokkosSparse::Experimental::spgemm_triple_numeric(
+      handle, num_coarse, num_verts, num_verts, num_coarse,
+      row_mapR_coarse, entriesR, ones,
+      row_map, entries, weights,
+      row_mapP, labels, ones,
+      coarse_row_map, coarse_entries, coarse_weights);
+  return num_coarse;
+}
+
+}
+}
+
+#endif
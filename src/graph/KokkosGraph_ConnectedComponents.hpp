@@ -0,0 +1,91 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_CONNECTEDCOMPONENTS_HPP
+#define _KOKKOSGRAPH_CONNECTEDCOMPONENTS_HPP
+
+#include <sstream>
+#include "KokkosGraph_ConnectedComponents_impl.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+/**
+ * \brief Connected components of a graph.
+ *
+ * Uses the sampling scheme of Afforest: a few edges per vertex are linked
+ * first, and the remaining edges only for vertices outside the largest
+ * component found so far, so graphs with a giant component cost much less
+ * than one pass over the edges. The graph must be structurally symmetric
+ * (see KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap).
+ *
+ * \param num_verts: number of vertices in the graph.
+ * \param row_map: the xadj array of the graph. Its size is num_verts + 1.
+ * \param entries: adjacency array of the graph. Entries not in [0, num_verts)
+ *   are ignored.
+ * \param labels: output, the component of each vertex in [0, num_components),
+ *   numbered in increasing order of the smallest vertex of each component.
+ *   Its size is num_verts.
+ * \return num_components.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_, typename label_view_t_>
+typename lno_nnz_view_t_::non_const_value_type
+connected_components(
+    typename lno_nnz_view_t_::non_const_value_type num_verts,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries,
+    label_view_t_ labels){
+  if (labels.extent(0) != size_t(num_verts)){
+    std::ostringstream os;
+    os << "KokkosGraph::connected_components: Dimensions do not match: "
+       << "labels: " << labels.extent(0) << ", num_verts: " << num_verts;
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+  Impl::ConnectedComponents<lno_row_view_t_, lno_nnz_view_t_> cc(num_verts, row_map, entries);
+  return cc.components(labels);
+}
+
+}
+}
+
+#endif
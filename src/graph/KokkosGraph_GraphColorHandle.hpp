@@ -43,6 +43,8 @@
 #include <Kokkos_MemoryTraits.hpp>
 #include <Kokkos_Core.hpp>
 #include <KokkosKernels_Utils.hpp>
+#include <KokkosKernels_SparseUtils.hpp>
+#include <KokkosKernels_MemoryFootprint.hpp>
 
 #ifndef _GRAPHCOLORHANDLE_HPP
 #define _GRAPHCOLORHANDLE_HPP
@@ -59,13 +61,21 @@ enum ColoringAlgorithm { COLORING_DEFAULT,
                          COLORING_SERIAL2,
                          COLORING_SPGEMM,
                          COLORING_D2_MATRIX_SQUARED,          // Distance-2 Graph Coloring (Brian's Code)
-                         COLORING_D2                          // Distance-2 Graph Coloring (WCMCLEN)
+                         COLORING_D2,                         // Distance-2 Graph Coloring (WCMCLEN)
+                         COLORING_JPL,                        // Jones-Plassmann-Luby, one kernel per round, no conflicts
+                         COLORING_D2_VB_BIT                   // Distance-2 Graph Coloring, bitmask forbidden colors, team-vector traversal
                        };
 
 enum ConflictList{COLORING_NOCONFLICT, COLORING_ATOMIC, COLORING_PPS};
 
 enum ColoringType {Distance1, Distance2};
 
+//The order in which the distance-1 algorithms color the vertices.
+enum ColoringOrdering { COLORING_ORDER_NATURAL,          // by index
+                        COLORING_ORDER_LARGEST_FIRST,    // by decreasing degree
+                        COLORING_ORDER_SMALLEST_LAST     // by decreasing round of an approximate smallest-last peeling
+                      };
+
 template <class size_type_, class color_t_, class lno_t_, 
          //class lno_row_view_t_, class nonconst_color_view_t_, class lno_nnz_view_t_,
           class ExecutionSpace, class TemporaryMemorySpace, class PersistentMemorySpace>
@@ -151,6 +161,17 @@ private:
   bool is_coloring_called_before;
   nnz_lno_t num_colors;
 
+  bool balance_colors; //move vertices from overfull to underfull colors after the coloring.
+  nnz_lno_persistent_work_host_view_t color_histogram; //number of vertices of each color, computed on demand.
+  nnz_lno_persistent_work_view_t color_set_xadj; //offsets of the vertices of each color in color_set_adj, computed on demand.
+  nnz_lno_persistent_work_host_view_t h_color_set_xadj; //host copy of color_set_xadj.
+  nnz_lno_persistent_work_view_t color_set_adj; //vertices grouped by color, ascending within a color.
+
+  size_t memory_budget; //bytes the handle and a coloring call may use, 0 for no limit.
+
+  ColoringOrdering coloring_ordering; //the order of the vertices for VB, VBBIT, VBCS and JPL.
+  bool deterministic; //color with JPL, whose colors depend only on the graph.
+
 
 
   public:
@@ -173,7 +194,10 @@ private:
     overall_coloring_time(0),
     coloring_time(0),
     num_phases(0), size_of_edge_list(0), lower_triangle_src(), lower_triangle_dst(),
-    vertex_colors(), is_coloring_called_before(false), num_colors(0){
+    vertex_colors(), is_coloring_called_before(false), num_colors(0),
+    balance_colors(false), color_histogram(),
+    color_set_xadj(), h_color_set_xadj(), color_set_adj(), memory_budget(0),
+    coloring_ordering(COLORING_ORDER_NATURAL), deterministic(false){
     this->choose_default_algorithm();
     this->set_defaults(this->coloring_algorithm_type);
   }
@@ -196,7 +220,7 @@ private:
 
 
   /** \brief Changes the graph coloring algorithm.
-   *  \param col_algo: Coloring algorithm: one of COLORING_VB, COLORING_VBBIT, COLORING_VBCS, COLORING_EB
+   *  \param col_algo: Coloring algorithm: one of COLORING_VB, COLORING_VBBIT, COLORING_VBCS, COLORING_EB, COLORING_JPL
    *  \param set_default_parameters: whether or not to reset the default parameters for the given algorithm.
    */
   void set_algorithm(const ColoringAlgorithm &col_algo, bool set_default_parameters = true){
@@ -598,6 +622,7 @@ private:
     case COLORING_SPGEMM:
     case COLORING_D2_MATRIX_SQUARED:
     case COLORING_D2:
+    case COLORING_D2_VB_BIT:
       this->conflict_list_type = COLORING_ATOMIC;
       this->min_reduction_for_conflictlist = 0.35;
       this->min_elements_for_conflictlist = 1000;
@@ -608,6 +633,17 @@ private:
       this->max_number_of_iterations = 200;
       this->eb_num_initial_colors = 1;
       break;
+    case COLORING_JPL:
+      this->conflict_list_type = COLORING_NOCONFLICT;
+      this->min_reduction_for_conflictlist = 0.35;
+      this->min_elements_for_conflictlist = 1000;
+      this->serial_conflict_resolution = false;
+      this->tictoc = false;
+      this->vb_edge_filtering = false;
+      this->vb_chunk_size = 8;
+      this->max_number_of_iterations = 200;
+      this->eb_num_initial_colors = 1;
+      break;
     case COLORING_EB:
       this->conflict_list_type = COLORING_PPS;
       this->min_reduction_for_conflictlist = 0.35;
@@ -664,6 +700,148 @@ private:
     this->vertex_colors = vertex_colors_;
     this->is_coloring_called_before = true;
     this->num_colors = 0;
+    this->color_histogram = nnz_lno_persistent_work_host_view_t();
+    this->color_set_xadj = nnz_lno_persistent_work_view_t();
+    this->h_color_set_xadj = nnz_lno_persistent_work_host_view_t();
+    this->color_set_adj = nnz_lno_persistent_work_view_t();
+  }
+
+  /** \brief If set, after the coloring, vertices of the colors larger than
+   *  the average are moved to the smallest colors below the average that
+   *  none of their neighbors have, so that the color classes are closer in
+   *  size. The number of colors does not change. This runs on the host.
+   */
+  void set_balance_colors(const bool balance_colors_ = true){this->balance_colors = balance_colors_;}
+  bool get_balance_colors() const {return this->balance_colors;}
+
+  /** \brief Sets the order in which the vertices are colored. The VB family
+   *  colors its worklist in this order, which decides the colors the
+   *  speculative greedy phase picks within a thread's range, and keeps the
+   *  color of the vertex first in the order on a conflict. JPL uses it
+   *  as the priority of the vertices, with the pseudo random priority to
+   *  break ties. Largest-first and smallest-last usually need fewer colors
+   *  than the natural order, at the cost of the degree pass, and for
+   *  smallest-last of a peeling kernel per round.
+   */
+  void set_coloring_ordering(const ColoringOrdering &ordering){this->coloring_ordering = ordering;}
+  ColoringOrdering get_coloring_ordering() const {return this->coloring_ordering;}
+
+  /** \brief If set, graph_color_symbolic colors with COLORING_JPL whatever
+   *  the algorithm of the handle, except COLORING_SERIAL, and
+   *  graph_color_incremental recolors the whole graph. A JPL round reads
+   *  only the colors of the previous round, so the colors are a function of
+   *  the graph and the ordering alone: they are the same on every execution
+   *  space and for any number of threads, unlike the speculative VB and EB
+   *  colorings whose conflicts depend on the scheduling.
+   */
+  void set_deterministic(const bool deterministic_ = true){this->deterministic = deterministic_;}
+  bool get_deterministic() const {return this->deterministic;}
+
+  /** \brief Sets the bytes the handle may hold plus the work arrays of a
+   *  coloring call, 0 (the default) for no limit. If the edge list and the
+   *  edge work arrays of COLORING_EB do not fit, COLORING_VB is used instead.
+   */
+  void set_memory_budget(const size_t memory_budget_){this->memory_budget = memory_budget_;}
+  size_t get_memory_budget() const {return this->memory_budget;}
+
+  /** \brief Returns the bytes of the views the handle keeps: the colors,
+   *  the lower triangular edge list of the edge based coloring, the
+   *  color histogram and the color sets.
+   */
+  KokkosKernels::MemoryFootprint get_memory_footprint() const {
+    KokkosKernels::MemoryFootprint footprint;
+    footprint.add_persistent(this->lower_triangle_src);
+    footprint.add_persistent(this->lower_triangle_dst);
+    footprint.add_persistent(this->vertex_colors);
+    footprint.add_persistent(this->color_histogram);
+    footprint.add_persistent(this->color_set_xadj);
+    footprint.add_persistent(this->h_color_set_xadj);
+    footprint.add_persistent(this->color_set_adj);
+    return footprint;
+  }
+
+  /** \brief Switches COLORING_EB to COLORING_VB, with its default
+   *  parameters, if the edge list and the edge work arrays of a graph with
+   *  nv vertices and ne entries do not fit into the memory budget.
+   */
+  void fit_into_memory_budget(const nnz_lno_t nv, const size_type ne){
+    if (this->coloring_algorithm_type != COLORING_EB) return;
+    //each undirected edge is stored once, with a worklist entry, a next worklist entry,
+    //a prefix sum and a marker.
+    size_t eb_bytes = nv * (2 * sizeof(color_t) + sizeof(nnz_lno_t)) +
+        (ne / 2) * (3 * sizeof(size_type) + sizeof(char));
+    if (this->size_of_edge_list == 0) eb_bytes += (ne / 2) * 2 * sizeof(nnz_lno_t);
+    if (!KokkosKernels::Impl::kk_fits_memory_budget(this->memory_budget, this->get_memory_footprint(), eb_bytes)){
+      this->set_algorithm(COLORING_VB, true);
+    }
+  }
+
+  /** \brief Returns the number of vertices of each color: entry c - 1 is
+   *  the size of color c. Computed on the host at the first call after a
+   *  coloring.
+   */
+  nnz_lno_persistent_work_host_view_t get_color_histogram(){
+    if (this->color_histogram.extent(0) == 0 && this->is_coloring_called_before){
+      nnz_lno_t nc = this->get_num_colors();
+      nnz_lno_persistent_work_host_view_t histogram("color histogram", nc);
+      color_host_view_t h_colors = Kokkos::create_mirror_view(this->vertex_colors);
+      Kokkos::deep_copy(h_colors, this->vertex_colors);
+      for (size_t i = 0; i < h_colors.extent(0); ++i){
+        if (h_colors(i) > 0) ++histogram(h_colors(i) - 1);
+      }
+      this->color_histogram = histogram;
+    }
+    return this->color_histogram;
+  }
+
+  /** \brief Returns the offsets of the color sets: the vertices of color
+   *  c are color_set_adj(color_set_xadj(c - 1)) to
+   *  color_set_adj(color_set_xadj(c) - 1), num_colors + 1 entries. The sets
+   *  are built at the first call after a coloring, in ascending vertex
+   *  order within each color, and are shared by every caller of the
+   *  getters until the next coloring, so a consumer that reorders
+   *  color_set_adj has to copy it first.
+   */
+  nnz_lno_persistent_work_view_t get_color_set_xadj(){
+    this->build_color_sets();
+    return this->color_set_xadj;
+  }
+
+  /** \brief Returns a host copy of get_color_set_xadj().
+   */
+  nnz_lno_persistent_work_host_view_t get_host_color_set_xadj(){
+    this->build_color_sets();
+    return this->h_color_set_xadj;
+  }
+
+  /** \brief Returns the vertices grouped by color, see get_color_set_xadj().
+   */
+  nnz_lno_persistent_work_view_t get_color_set_adj(){
+    this->build_color_sets();
+    return this->color_set_adj;
+  }
+
+private:
+  void build_color_sets(){
+    if (this->color_set_xadj.extent(0) != 0 || !this->is_coloring_called_before) return;
+    nnz_lno_t nv = this->vertex_colors.extent(0);
+    nnz_lno_t nc = this->get_num_colors();
+    nnz_lno_persistent_work_view_t xadj, adj;
+    KokkosKernels::Impl::create_reverse_map
+      <color_view_t, nnz_lno_persistent_work_view_t, HandleExecSpace>
+        (nv, nc, this->vertex_colors, xadj, adj);
+    //the reverse map fills a color in any order, one sort of all the colors
+    //makes the sets deterministic.
+    KokkosKernels::Impl::kk_sort_crs_rows
+      <nnz_lno_persistent_work_view_t, nnz_lno_persistent_work_view_t,
+       nnz_lno_persistent_work_view_t, HandleExecSpace>
+        (xadj, adj, nnz_lno_persistent_work_view_t());
+    HandleExecSpace::fence();
+    nnz_lno_persistent_work_host_view_t h_xadj = Kokkos::create_mirror_view(xadj);
+    Kokkos::deep_copy(h_xadj, xadj);
+    this->color_set_xadj = xadj;
+    this->h_color_set_xadj = h_xadj;
+    this->color_set_adj = adj;
   }
 
 
@@ -0,0 +1,132 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_MIS_HPP
+#define _KOKKOSGRAPH_MIS_HPP
+
+#include <sstream>
+#include "KokkosGraph_MIS_impl.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+/**
+ * \brief Maximal independent set of a graph.
+ *
+ * The set is deterministic: it only depends on the graph. The graph
+ * should be structurally symmetric.
+ *
+ * \param num_verts: number of vertices in the graph.
+ * \param row_map: the xadj array of the graph. Its size is num_verts + 1.
+ * \param entries: adjacency array of the graph. Entries not in [0, num_verts)
+ *   are ignored.
+ * \return the vertices of the set in increasing order.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_>
+typename Impl::MIS<lno_row_view_t_, lno_nnz_view_t_>::nnz_lno_temp_work_view_t
+graph_mis(
+    typename lno_nnz_view_t_::non_const_value_type num_verts,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries){
+  Impl::MIS<lno_row_view_t_, lno_nnz_view_t_> mis(num_verts, row_map, entries);
+  return mis.set_list(mis.compute(false));
+}
+
+/**
+ * \brief Distance-2 maximal independent set: no two vertices of the set are
+ * neighbors or have a common neighbor, and every other vertex is within
+ * distance 2 of the set.
+ *
+ * \param num_verts: number of vertices in the graph.
+ * \param row_map: the xadj array of the graph. Its size is num_verts + 1.
+ * \param entries: adjacency array of the graph. Entries not in [0, num_verts)
+ *   are ignored.
+ * \return the vertices of the set in increasing order.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_>
+typename Impl::MIS<lno_row_view_t_, lno_nnz_view_t_>::nnz_lno_temp_work_view_t
+graph_mis2(
+    typename lno_nnz_view_t_::non_const_value_type num_verts,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries){
+  Impl::MIS<lno_row_view_t_, lno_nnz_view_t_> mis(num_verts, row_map, entries);
+  return mis.set_list(mis.compute(true));
+}
+
+/**
+ * \brief Aggregation for smoothed aggregation AMG.
+ *
+ * The roots are a distance-2 MIS, numbered in increasing order. Every vertex
+ * next to a root joins it, and the remaining vertices join a neighboring
+ * aggregate; so every aggregate is connected and has diameter at most 4.
+ * The tentative prolongator has a one at (v, aggregates(v)) for every vertex v.
+ *
+ * \param num_verts: number of vertices in the graph.
+ * \param row_map: the xadj array of the graph. Its size is num_verts + 1.
+ * \param entries: adjacency array of the graph. Entries not in [0, num_verts)
+ *   are ignored. The graph must be structurally symmetric.
+ * \param aggregates: output, the aggregate of each vertex in [0, num_aggregates).
+ *   Its size is num_verts.
+ * \return num_aggregates.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_, typename aggregate_view_t_>
+typename lno_nnz_view_t_::non_const_value_type
+graph_mis2_aggregate(
+    typename lno_nnz_view_t_::non_const_value_type num_verts,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries,
+    aggregate_view_t_ aggregates){
+  if (aggregates.extent(0) != size_t(num_verts)){
+    std::ostringstream os;
+    os << "KokkosGraph::graph_mis2_aggregate: Dimensions do not match: "
+       << "aggregates: " << aggregates.extent(0) << ", num_verts: " << num_verts;
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+  Impl::MIS<lno_row_view_t_, lno_nnz_view_t_> mis(num_verts, row_map, entries);
+  return mis.aggregate(aggregates);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,126 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_PAGERANK_HPP
+#define _KOKKOSGRAPH_PAGERANK_HPP
+
+#include <sstream>
+#include "KokkosGraph_PageRank_impl.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+/**
+ * \brief PageRank of a directed graph by power iteration.
+ *
+ * The rank of the vertices without out edges is spread over all vertices,
+ * so the ranks sum to one. The graph is transposed and normalized once, and
+ * each iteration is a single fused spmv kernel.
+ *
+ * \param num_verts: number of vertices in the graph.
+ * \param row_map: the xadj array of the graph. Its size is num_verts + 1.
+ * \param entries: adjacency array of the graph, the out edges of each vertex.
+ *   All entries must be in [0, num_verts).
+ * \param ranks: output, the rank of each vertex. Its size is num_verts, and
+ *   its value type a real floating point type.
+ * \param damping: the probability to follow an edge rather than to teleport.
+ * \param tolerance: the iteration stops when the sum of the changes of the
+ *   ranks is at most tolerance.
+ * \param max_iterations: the maximum number of iterations.
+ * \return the number of iterations.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_view_t_>
+int pagerank(
+    typename lno_nnz_view_t_::non_const_value_type num_verts,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries,
+    scalar_view_t_ ranks,
+    typename scalar_view_t_::non_const_value_type damping = 0.85,
+    typename scalar_view_t_::non_const_value_type tolerance = 1e-8,
+    int max_iterations = 100){
+  if (ranks.extent(0) != size_t(num_verts)){
+    std::ostringstream os;
+    os << "KokkosGraph::pagerank: Dimensions do not match: "
+       << "ranks: " << ranks.extent(0) << ", num_verts: " << num_verts;
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+  Impl::PageRank<lno_row_view_t_, lno_nnz_view_t_, scalar_view_t_> pr(num_verts, row_map, entries, damping);
+  return pr.power_iteration(ranks, tolerance, max_iterations);
+}
+
+/**
+ * \brief PageRank of a directed graph with a dynamic worklist.
+ *
+ * Same as pagerank, except that a round only recomputes the vertices with an
+ * in neighbor whose rank changed by more than tolerance in the previous
+ * round. Once most ranks settle, a round is much cheaper than an iteration
+ * over the whole graph. The ranks are within about tolerance times the in
+ * degree of those of pagerank.
+ *
+ * \param tolerance: a rank changing by more than tolerance puts its out
+ *   neighbors in the next round; the iteration stops when no rank does.
+ * \return the number of rounds.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_view_t_>
+int pagerank_worklist(
+    typename lno_nnz_view_t_::non_const_value_type num_verts,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries,
+    scalar_view_t_ ranks,
+    typename scalar_view_t_::non_const_value_type damping = 0.85,
+    typename scalar_view_t_::non_const_value_type tolerance = 1e-10,
+    int max_iterations = 1000){
+  if (ranks.extent(0) != size_t(num_verts)){
+    std::ostringstream os;
+    os << "KokkosGraph::pagerank_worklist: Dimensions do not match: "
+       << "ranks: " << ranks.extent(0) << ", num_verts: " << num_verts;
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+  Impl::PageRank<lno_row_view_t_, lno_nnz_view_t_, scalar_view_t_> pr(num_verts, row_map, entries, damping);
+  return pr.worklist_iteration(ranks, tolerance, max_iterations);
+}
+
+}
+}
+
+#endif
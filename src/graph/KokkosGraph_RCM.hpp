@@ -0,0 +1,116 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_RCM_HPP
+#define _KOKKOSGRAPH_RCM_HPP
+
+#include "KokkosGraph_RCM_impl.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+/**
+ * \brief Reverse Cuthill-McKee ordering of a graph.
+ *
+ * The ordering reduces the bandwidth of a matrix with this graph, which
+ * improves the cache reuse of spmv, Gauss-Seidel and trsv. It is meant to
+ * be computed once at setup; KokkosSparse::Experimental::permute_crs_matrix
+ * and permute_vector apply it. The graph should be structurally symmetric
+ * (see KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap); otherwise
+ * the ordering follows the out edges only.
+ *
+ * \param num_verts: number of vertices in the graph.
+ * \param row_map: the xadj array of the graph. Its size is num_verts + 1.
+ * \param entries: adjacency array of the graph. Entries not in [0, num_verts)
+ *   are ignored.
+ * \return the new index of each vertex.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_>
+typename Impl::RCM<lno_row_view_t_, lno_nnz_view_t_>::nnz_lno_temp_work_view_t
+graph_rcm(
+    typename lno_nnz_view_t_::non_const_value_type num_verts,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries){
+  typedef Impl::RCM<lno_row_view_t_, lno_nnz_view_t_> rcm_t;
+  typename rcm_t::nnz_lno_temp_work_view_t old_to_new(
+      Kokkos::ViewAllocateWithoutInitializing("RCM Permutation"), num_verts);
+  rcm_t rcm(num_verts, row_map, entries);
+  rcm.rcm(old_to_new);
+  return old_to_new;
+}
+
+/**
+ * \brief Order of the rows for locality aware scheduling.
+ *
+ * The rows in the order of graph_rcm: the BFS levels are consecutive, so
+ * that any range of the order is a cluster of rows close in the graph,
+ * which share most of their columns. Unlike graph_rcm, the matrix is not
+ * permuted: the order is given to the kernels that schedule their rows by
+ * ranges, KokkosSparse::SPMVHandle::set_row_order for the worksets of spmv
+ * and KokkosSparse::GaussSeidelHandle::set_row_order for the color sets of
+ * Gauss-Seidel. The graph should be structurally symmetric, as for graph_rcm.
+ *
+ * \param num_verts: number of vertices in the graph.
+ * \param row_map: the xadj array of the graph. Its size is num_verts + 1.
+ * \param entries: adjacency array of the graph. Entries not in [0, num_verts)
+ *   are ignored.
+ * \return the vertex at each position of the order.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_>
+typename Impl::RCM<lno_row_view_t_, lno_nnz_view_t_>::nnz_lno_temp_work_view_t
+graph_row_cluster_order(
+    typename lno_nnz_view_t_::non_const_value_type num_verts,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries){
+  typedef Impl::RCM<lno_row_view_t_, lno_nnz_view_t_> rcm_t;
+  typename rcm_t::nnz_lno_temp_work_view_t new_to_old(
+      Kokkos::ViewAllocateWithoutInitializing("Row Cluster Order"), num_verts);
+  rcm_t rcm(num_verts, row_map, entries);
+  rcm.rcm_sequence(new_to_old);
+  return new_to_old;
+}
+
+}
+}
+
+#endif
@@ -45,6 +45,9 @@
 #include "KokkosSparse_spgemm_impl.hpp"
 #include "KokkosKernels_IOUtils.hpp"
 #include "KokkosKernels_Handle.hpp"
+#include "KokkosGraph_TriangleCount_impl.hpp"
+#include "KokkosGraph_TriangleSampling_impl.hpp"
+#include "KokkosGraph_EdgeSimilarity_impl.hpp"
 namespace KokkosGraph{
 
 namespace Experimental{
@@ -236,6 +239,41 @@ void triangle_generic(
 
   spgemmHandleType *sh = handle->get_spgemm_handle();
   Kokkos::Impl::Timer timer1;
+  Kokkos::Impl::Timer preprocess_timer;
+
+  //////RELABEL BY DEGREE/////
+  //The graph is renumbered before any other preprocessing and the triangles are found on
+  //the renumbered graph, so the visitor receives the new labels. The permutation is kept in
+  //the handle to map them back.
+  if (sh->get_relabel_by_degree()){
+    int sort_order = 1;
+    if (sh->get_algorithm_type() == SPGEMM_KK_TRIANGLE_AI || sh->get_algorithm_type() == SPGEMM_KK_TRIANGLE_LU){
+      sort_order = 0;
+    }
+    if (sh->get_sort_option() != -1){
+      sort_order = sh->get_sort_option();
+    }
+    nnz_lno_persistent_work_view_t old_to_new, relabeled_entries;
+    row_lno_persistent_work_view_t relabeled_row_map;
+    Impl::relabel_by_degree<KernelHandle>(
+        m, row_mapA, entriesA, sort_order, old_to_new, relabeled_row_map, relabeled_entries);
+    sh->set_degree_relabel_permutation(old_to_new);
+    double relabel_time = preprocess_timer.seconds();
+    if (handle->get_verbose()){
+      std::cout << "Preprocess Relabel By Degree Time:" << relabel_time << std::endl;
+    }
+
+    //the relabeled graph is already in degree order, so the row size sort is skipped.
+    int sort_lower_triangle = sh->get_sort_lower_triangular();
+    sh->set_relabel_by_degree(false);
+    sh->set_sort_lower_triangular(0);
+    triangle_generic(handle, m, relabeled_row_map, relabeled_entries, visit_struct);
+    sh->set_relabel_by_degree(true);
+    sh->set_sort_lower_triangular(sort_lower_triangle);
+    sh->set_triangle_preprocess_time(relabel_time + sh->get_triangle_preprocess_time());
+    return;
+  }
+  //////RELABEL BY DEGREE/////
 
   //////SORT BASE ON THE SIZE OF ROWS/////
   int sort_lower_triangle = sh->get_sort_lower_triangular();
@@ -401,7 +439,7 @@ void triangle_generic(
             (m,
                 row_mapA, entriesA,
             incidence_rowmap, incidence_entries, sh->get_lower_triangular_permutation(),
-            handle->is_dynamic_scheduling());
+            handle->is_dynamic_scheduling(), 4, handle->get_workspace());
   }
   break;
   case SPGEMM_KK_TRIANGLE_LU:
@@ -418,7 +456,7 @@ void triangle_generic(
   ////
   ///CREATE INCIDENCE MATRIX END
   ///
-
+  sh->set_triangle_preprocess_time(preprocess_timer.seconds());
 
   switch (sh->get_algorithm_type()){
   default:
@@ -518,6 +556,227 @@ void triangle_generic(
 
 }
 
+/**
+ * \brief Counts, for each edge of a symmetric graph, the triangles it belongs to (its support).
+ *
+ * Unlike triangle_generic, the counts are reduced within the team that owns a row
+ * and written once, so hub vertices do not serialize on per-triangle atomics.
+ * Self loops and entries not in [0, m) are ignored; rows must not have duplicate entries.
+ *
+ * \param m: number of vertices.
+ * \param row_mapA, entriesA: the graph, with both directions of every edge.
+ * \param edge_triangles: output, the support of the edge stored at each position of entriesA.
+ */
+template <typename KernelHandle,
+typename alno_row_view_t_,
+typename alno_nnz_view_t_,
+typename edge_count_view_t_>
+void triangle_count_per_edge(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    alno_row_view_t_ row_mapA,
+    alno_nnz_view_t_ entriesA,
+    edge_count_view_t_ edge_triangles){
+
+  if (edge_triangles.extent(0) < entriesA.extent(0)){
+    std::ostringstream os;
+    os << "KokkosGraph::triangle_count_per_edge: Dimensions do not match: "
+       << "edge_triangles: " << edge_triangles.extent(0) << ", entries: " << entriesA.extent(0);
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+  Impl::triangle_support(handle, m, row_mapA, entriesA,
+      edge_triangles, edge_count_view_t_(), true, false);
+}
+
+/**
+ * \brief Counts, for each vertex of a symmetric graph, the triangles it belongs to.
+ *
+ * The local clustering coefficient of v is vertex_triangles(v) / (d(v) (d(v) - 1) / 2).
+ * See triangle_count_per_edge for the requirements on the graph.
+ *
+ * \param vertex_triangles: output, the triangle count of each of the m vertices.
+ */
+template <typename KernelHandle,
+typename alno_row_view_t_,
+typename alno_nnz_view_t_,
+typename vertex_count_view_t_>
+void triangle_count_per_vertex(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    alno_row_view_t_ row_mapA,
+    alno_nnz_view_t_ entriesA,
+    vertex_count_view_t_ vertex_triangles){
+
+  if (vertex_triangles.extent(0) < size_t(m)){
+    std::ostringstream os;
+    os << "KokkosGraph::triangle_count_per_vertex: Dimensions do not match: "
+       << "vertex_triangles: " << vertex_triangles.extent(0) << ", num_rows: " << m;
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+  Impl::triangle_support(handle, m, row_mapA, entriesA,
+      vertex_count_view_t_(), vertex_triangles, false, true);
+}
+
+/**
+ * \brief Enumerates the triangles of a symmetric graph, streaming them to the
+ * host in buffers of a fixed size instead of holding them all on the device.
+ *
+ * Each triangle {i, j, k} is given once. Two device buffers are used: while the
+ * triangles of one are given to flush, the next batch is written to the other.
+ * See triangle_count_per_edge for the requirements on the graph.
+ *
+ * \param buffer_size: the number of triangles of a buffer. It is raised to the
+ *   largest number of triangles of an edge if that is larger.
+ * \param flush: a host functor called as flush(triangles, num_triangles) for each
+ *   buffer, where triangles(t, 0..2) are the vertices of the t-th triangle, for
+ *   t < num_triangles. The view is reused after flush returns.
+ * \return the number of triangles.
+ */
+template <typename KernelHandle,
+typename alno_row_view_t_,
+typename alno_nnz_view_t_,
+typename flush_t>
+size_t triangle_enumerate_streaming(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    alno_row_view_t_ row_mapA,
+    alno_nnz_view_t_ entriesA,
+    size_t buffer_size,
+    flush_t flush){
+
+  if (buffer_size == 0){
+    std::ostringstream os;
+    os << "KokkosGraph::triangle_enumerate_streaming: buffer_size must be positive";
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+  Impl::TriangleStream<KernelHandle, alno_row_view_t_, alno_nnz_view_t_> stream(m, row_mapA, entriesA);
+  return stream.enumerate(buffer_size, flush);
+}
+
+/**
+ * \brief k-truss of a symmetric graph: the largest subgraph whose edges are each in
+ * at least k - 2 of its triangles.
+ *
+ * The supports are counted once on a sorted copy of the graph that stays resident;
+ * each round then removes the edges with too little support and decrements the
+ * supports of the edges that shared a triangle with them, instead of recounting.
+ * See triangle_count_per_edge for the requirements on the graph.
+ *
+ * \param k: the truss number, k <= 2 keeps every edge but the self loops.
+ * \param edge_in_truss: output, 1 at each position of entriesA whose edge is in the k-truss, 0 otherwise.
+ * \return the number of peeling rounds.
+ */
+template <typename KernelHandle,
+typename alno_row_view_t_,
+typename alno_nnz_view_t_,
+typename edge_flag_view_t_>
+int ktruss(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    alno_row_view_t_ row_mapA,
+    alno_nnz_view_t_ entriesA,
+    int k,
+    edge_flag_view_t_ edge_in_truss){
+
+  if (edge_in_truss.extent(0) < entriesA.extent(0)){
+    std::ostringstream os;
+    os << "KokkosGraph::ktruss: Dimensions do not match: "
+       << "edge_in_truss: " << edge_in_truss.extent(0) << ", entries: " << entriesA.extent(0);
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+  Impl::KTruss<KernelHandle, alno_row_view_t_, alno_nnz_view_t_> truss(handle, m, row_mapA, entriesA);
+  return truss.ktruss(k, edge_in_truss);
+}
+
+/**
+ * \brief Estimates the number of triangles of a symmetric graph from uniformly sampled wedges.
+ *
+ * The error does not depend on the size of the graph, only on num_samples and on
+ * the fraction of closed wedges p: the relative standard error is about
+ * sqrt((1 - p) / (p num_samples)). See triangle_count_per_edge for the
+ * requirements on the graph.
+ *
+ * \param num_samples: the number of wedges to sample.
+ * \param seed: the seed of the samples; the estimate does not depend on the number of threads.
+ * \return the estimate, its standard error and its 95% confidence interval.
+ */
+template <typename KernelHandle,
+typename alno_row_view_t_,
+typename alno_nnz_view_t_>
+TriangleCountEstimate triangle_count_wedge_sampling(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    alno_row_view_t_ row_mapA,
+    alno_nnz_view_t_ entriesA,
+    size_t num_samples,
+    uint64_t seed = 0){
+
+  return Impl::triangle_count_wedge_sampling(handle, m, row_mapA, entriesA, num_samples, seed);
+}
+
+/**
+ * \brief Estimates the number of triangles of a symmetric graph by colorful triangle counting.
+ *
+ * Each trial colors the vertices at random and counts exactly, with the kernel of
+ * triangle_count_per_vertex, the triangles whose vertices share a color; the count of
+ * the graph is scaled from there. The number of colors is chosen so that the sampled
+ * subgraphs of all trials have about sample_budget entries, and the count is exact if
+ * sample_budget covers num_trials copies of the graph.
+ * See triangle_count_per_edge for the requirements on the graph.
+ *
+ * \param sample_budget: the number of entries of the sampled subgraphs over all trials, 0 for no limit.
+ * \param num_trials: the number of colorings to average.
+ * \return the estimate, its standard error from the trials and its 95% confidence interval.
+ */
+template <typename KernelHandle,
+typename alno_row_view_t_,
+typename alno_nnz_view_t_>
+TriangleCountEstimate triangle_count_colorful(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    alno_row_view_t_ row_mapA,
+    alno_nnz_view_t_ entriesA,
+    size_t sample_budget,
+    int num_trials = 4,
+    uint64_t seed = 0){
+
+  return Impl::triangle_count_colorful(handle, m, row_mapA, entriesA, sample_budget, num_trials, seed);
+}
+
+/**
+ * \brief The similarity of the two vertices of each edge of a symmetric graph, for
+ * link prediction: their common neighbors, Jaccard or Adamic-Adar index.
+ *
+ * The neighborhoods are intersected by the kernel of triangle_count_per_edge, one
+ * value per entry of the input, without forming the product A A. In N(u) and N(v),
+ * self loops and entries not in [0, m) are ignored, and these entries get 0.
+ * See triangle_count_per_edge for the requirements on the graph.
+ *
+ * \param measure: SIMILARITY_COMMON_NEIGHBORS, SIMILARITY_JACCARD or SIMILARITY_ADAMIC_ADAR.
+ * \param similarity: output, the similarity of the edge stored at each position of entriesA.
+ *   It must have a floating point value type for SIMILARITY_JACCARD and SIMILARITY_ADAMIC_ADAR.
+ */
+template <typename KernelHandle,
+typename alno_row_view_t_,
+typename alno_nnz_view_t_,
+typename similarity_view_t_>
+void edge_similarity(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    alno_row_view_t_ row_mapA,
+    alno_nnz_view_t_ entriesA,
+    EdgeSimilarity measure,
+    similarity_view_t_ similarity){
+
+  if (similarity.extent(0) < entriesA.extent(0)){
+    std::ostringstream os;
+    os << "KokkosGraph::edge_similarity: Dimensions do not match: "
+       << "similarity: " << similarity.extent(0) << ", entries: " << entriesA.extent(0);
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+  Impl::edge_similarity(handle, m, row_mapA, entriesA, measure, similarity);
+}
+
 }
 }
 #endif
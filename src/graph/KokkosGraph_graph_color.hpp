@@ -48,6 +48,7 @@
 #include "KokkosGraph_GraphColor_impl.hpp"
 #include "KokkosGraph_GraphColorHandle.hpp"
 #include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_Profiling.hpp"
 
 namespace KokkosGraph{
 
@@ -63,12 +64,15 @@ void graph_color_symbolic(
     lno_row_view_t_ row_map,
     lno_nnz_view_t_ entries,
     bool is_symmetric = true){
+  KOKKOSKERNELS_PROFILING_REGION("KokkosGraph::graph_color_symbolic");
 
   Kokkos::Impl::Timer timer;
 
   typename KernelHandle::GraphColoringHandleType *gch = handle->get_graph_coloring_handle();
 
+  gch->fit_into_memory_budget(num_rows, entries.extent(0));
   ColoringAlgorithm algorithm = gch->get_coloring_algo_type();
+  if (gch->get_deterministic() && algorithm != COLORING_SERIAL) algorithm = COLORING_JPL;
 
   typedef typename KernelHandle::GraphColoringHandleType::color_view_t color_view_type;
 
@@ -102,6 +106,11 @@ void graph_color_symbolic(
     typedef typename Impl::GraphColor_EB <typename KernelHandle::GraphColoringHandleType, lno_row_view_t_, lno_nnz_view_t_> EBGraphColoring;
     gc = new EBGraphColoring(num_rows, entries.extent(0),row_map, entries, gch);
     break;
+
+  case COLORING_JPL:
+    typedef typename Impl::GraphColor_JPL <typename KernelHandle::GraphColoringHandleType, lno_row_view_t_, lno_nnz_view_t_> JPLGraphColoring;
+    gc = new JPLGraphColoring(num_rows, entries.extent(0), row_map, entries, gch);
+    break;
  
   case COLORING_SPGEMM:
   case COLORING_D2_MATRIX_SQUARED:
@@ -135,6 +144,11 @@ void graph_color_symbolic(
   gc->color_graph(colors_out, num_phases);
 
   delete gc;
+  if (gch->get_balance_colors()){
+    Impl::balance_color_classes
+      <typename KernelHandle::GraphColoringHandleType, lno_row_view_t_, lno_nnz_view_t_>
+      (num_rows, row_map, entries, colors_out);
+  }
   double coloring_time = timer.seconds();
   gch->add_to_overall_coloring_time(coloring_time);
   gch->set_coloring_time(coloring_time);
@@ -153,12 +167,101 @@ void graph_color(
     lno_nnz_view_t_ entries,
     bool is_symmetric = true)
 {
+  KOKKOSKERNELS_PROFILING_REGION("KokkosGraph::graph_color");
   //std::cout << ">>> WCMCLEN graph_color (KokkosGraph_graph_color.hpp)" << std::endl;
   graph_color_symbolic(handle, num_rows, num_cols, row_map, entries, is_symmetric);
 }
 
 
 
+/**
+ * \brief Recolors a graph after a local change, starting from the coloring stored in the handle.
+ *
+ * Only the changed vertices are recolored, together with the neighbors they conflict with
+ * while they are colored in parallel; the others keep their colors. A changed vertex is one
+ * whose adjacency gained an edge: both end points of every new edge must be listed. Removed
+ * edges need no recoloring. If the new graph has more vertices than the previous coloring,
+ * the new ones are recolored as well and must not be listed.
+ *
+ * It runs with the VB kernels (VBBIT if it is the algorithm of the handle), and falls back to
+ * graph_color_symbolic if the handle has no coloring yet or is deterministic.
+ *
+ * \param changed_vertices: the distinct changed vertices, all smaller than num_rows.
+ */
+template <class KernelHandle,typename lno_row_view_t_, typename lno_nnz_view_t_, typename lno_changed_view_t_>
+void graph_color_incremental(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t num_rows,
+    typename KernelHandle::nnz_lno_t num_cols,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries,
+    lno_changed_view_t_ changed_vertices){
+  KOKKOSKERNELS_PROFILING_REGION("KokkosGraph::graph_color_incremental");
+
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::GraphColoringHandleType::color_view_t color_view_type;
+  typedef typename KernelHandle::GraphColoringHandleType::nnz_lno_temp_work_view_t nnz_lno_temp_work_view_t;
+
+  typename KernelHandle::GraphColoringHandleType *gch = handle->get_graph_coloring_handle();
+
+  color_view_type old_colors = gch->get_vertex_colors();
+  if (old_colors.extent(0) == 0 || gch->get_deterministic()){
+    graph_color_symbolic(handle, num_rows, num_cols, row_map, entries);
+    return;
+  }
+
+  Kokkos::Impl::Timer timer;
+
+  const nnz_lno_t num_kept = old_colors.extent(0) < size_t(num_rows) ? nnz_lno_t(old_colors.extent(0)) : num_rows;
+  const nnz_lno_t num_changed = changed_vertices.extent(0);
+  const nnz_lno_t num_recolor = num_changed + (num_rows - num_kept);
+
+  if (num_recolor > num_rows){
+    std::ostringstream os;
+    os << "KokkosGraph::graph_color_incremental: " << num_changed
+       << " changed vertices for a graph of " << num_rows << " vertices";
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+
+  color_view_type colors_out = color_view_type("Graph Colors", num_rows);
+  Kokkos::deep_copy(
+      Kokkos::subview(colors_out, Kokkos::make_pair(nnz_lno_t(0), num_kept)),
+      Kokkos::subview(old_colors, Kokkos::make_pair(nnz_lno_t(0), num_kept)));
+
+  //the changed vertices, followed by the new ones. The list is small, it is built on the host.
+  nnz_lno_temp_work_view_t recolor_list(Kokkos::ViewAllocateWithoutInitializing("recolorList"), num_recolor);
+  typename nnz_lno_temp_work_view_t::HostMirror h_recolor_list = Kokkos::create_mirror_view(recolor_list);
+  typename lno_changed_view_t_::HostMirror h_changed = Kokkos::create_mirror_view(changed_vertices);
+  Kokkos::deep_copy(h_changed, changed_vertices);
+  for (nnz_lno_t i = 0; i < num_changed; ++i){
+    if (h_changed(i) < 0 || h_changed(i) >= num_rows){
+      std::ostringstream os;
+      os << "KokkosGraph::graph_color_incremental: changed vertex " << h_changed(i)
+         << " is not in a graph of " << num_rows << " vertices";
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+    h_recolor_list(i) = h_changed(i);
+  }
+  for (nnz_lno_t i = num_kept; i < num_rows; ++i){
+    h_recolor_list(num_changed + i - num_kept) = i;
+  }
+  Kokkos::deep_copy(recolor_list, h_recolor_list);
+
+  Impl::GraphColor_VB <typename KernelHandle::GraphColoringHandleType, lno_row_view_t_, lno_nnz_view_t_>
+      gc(num_rows, entries.extent(0), row_map, entries, gch);
+
+  int num_phases = 0;
+  gc.recolor_graph(colors_out, recolor_list, num_recolor, num_phases);
+
+  double coloring_time = timer.seconds();
+  gch->add_to_overall_coloring_time(coloring_time);
+  gch->set_coloring_time(coloring_time);
+  gch->set_num_phases(num_phases);
+  gch->set_vertex_colors(colors_out);
+}
+
+
+
 // initial distance 2 graph coloring -- serial only (work in progress) - wcmclen
 template <class KernelHandle,
           typename lno_row_view_t_, typename lno_nnz_view_t_,
@@ -172,6 +275,7 @@ void d2_graph_color(
     lno_col_view_t_ col_map,        //if graph is symmetric, simply give same for col_map and row_map, and row_entries and col_entries.
     lno_colnnz_view_t_ col_entries)
 {
+  KOKKOSKERNELS_PROFILING_REGION("KokkosGraph::d2_graph_color");
 
   Kokkos::Impl::Timer timer;
   typename KernelHandle::GraphColoringHandleType *gch = handle->get_graph_coloring_handle();
@@ -46,6 +46,7 @@
 #include "KokkosGraph_Distance2Color_impl.hpp"
 #include "KokkosGraph_GraphColorHandle.hpp"
 #include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_Profiling.hpp"
 
 namespace KokkosGraph{
 
@@ -64,6 +65,7 @@ void graph_color_d2(KernelHandle *handle,
                     lno_col_view_t_    col_map, 
                     lno_colnnz_view_t_ col_entries)
 {
+  KOKKOSKERNELS_PROFILING_REGION("KokkosGraph::graph_color_d2");
   Kokkos::Impl::Timer timer;
 
   // Set our handle pointer to a GraphColoringHandleType.
@@ -92,6 +94,7 @@ void graph_color_d2(KernelHandle *handle,
     }
 
     case COLORING_D2:
+    case COLORING_D2_VB_BIT:
     {
       Impl::GraphColorD2 <KernelHandle, lno_row_view_t_,lno_nnz_view_t_, lno_col_view_t_, lno_colnnz_view_t_>
           gc(num_rows, num_cols, row_entries.extent(0), row_map, row_entries, col_map, col_entries, handle);
@@ -110,6 +113,57 @@ void graph_color_d2(KernelHandle *handle,
   gch->set_coloring_time(coloring_time);
 }
 
+
+
+/**
+ * \brief Partial distance-2 coloring of the columns of a (possibly non-square) matrix.
+ *
+ * Two columns get different colors if they have a nonzero in a common row, so the columns
+ * of one color can be perturbed together when a Jacobian is computed by finite differences:
+ * the number of function evaluations is the number of colors.
+ *
+ * \param handle: the kernel handle. The algorithm of its graph coloring handle must be
+ *    COLORING_D2 or COLORING_D2_VB_BIT; the colors (one per column) are stored there.
+ * \param num_rows, num_cols: the dimensions of the matrix.
+ * \param row_map, row_entries: the rows of the matrix (num_rows + 1 offsets).
+ * \param col_map, col_entries: the rows of its transpose (num_cols + 1 offsets).
+ */
+template <class KernelHandle, typename lno_row_view_t_, typename lno_nnz_view_t_, typename lno_col_view_t_, typename lno_colnnz_view_t_>
+void bipartite_color_columns(KernelHandle *handle,
+                             typename KernelHandle::nnz_lno_t num_rows,
+                             typename KernelHandle::nnz_lno_t num_cols,
+                             lno_row_view_t_    row_map,
+                             lno_nnz_view_t_    row_entries,
+                             lno_col_view_t_    col_map,
+                             lno_colnnz_view_t_ col_entries)
+{
+  KOKKOSKERNELS_PROFILING_REGION("KokkosGraph::bipartite_color_columns");
+  Kokkos::Impl::Timer timer;
+
+  typename KernelHandle::GraphColoringHandleType *gch = handle->get_graph_coloring_handle();
+
+  ColoringAlgorithm algorithm = gch->get_coloring_algo_type();
+
+  if(algorithm != COLORING_D2 && algorithm != COLORING_D2_VB_BIT)
+  {
+    std::ostringstream os;
+    os << "KokkosGraph::bipartite_color_columns: only COLORING_D2 and COLORING_D2_VB_BIT are supported";
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+
+  gch->set_tictoc( handle->get_verbose() );
+
+  // The columns are the vertices: the transpose gives the rows of a column, and the
+  // matrix gives the columns of these rows, which are the distance-2 neighbors.
+  Impl::GraphColorD2 <KernelHandle, lno_col_view_t_, lno_colnnz_view_t_, lno_row_view_t_, lno_nnz_view_t_>
+      gc(num_cols, num_rows, col_entries.extent(0), col_map, col_entries, row_map, row_entries, handle);
+  gc.color_graph_d2();
+
+  double coloring_time = timer.seconds();
+  gch->add_to_overall_coloring_time(coloring_time);
+  gch->set_coloring_time(coloring_time);
+}
+
 }  // end namespace Experimental
 }  // end namespace KokkosGraph
 
@@ -0,0 +1,415 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_BFS_IMPL_HPP
+#define _KOKKOSGRAPH_BFS_IMPL_HPP
+
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_BitUtils.hpp"
+#include <utility>
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+enum BFSDirection{
+  BFS_DIRECTION_OPTIMIZING, //switches between the two by the frontier size
+  BFS_TOP_DOWN,             //always expands the frontier queue
+  BFS_BOTTOM_UP             //always searches the frontier from unvisited vertices
+};
+
+namespace Impl{
+
+/*! \brief Direction-optimizing parallel BFS (Beamer, Asanovic and Patterson).
+ *
+ * A top-down step expands the frontier, kept as a queue of vertices. Each team
+ * takes a chunk of the queue; a vertex is claimed with a compare-exchange on its
+ * level and written to a queue in team scratch memory, which is appended to the
+ * next frontier with one atomic per team. A bottom-up step keeps the frontier as
+ * a bitmap: each unvisited vertex looks for a neighbor in the frontier and stops
+ * at the first one. A bottom-up thread owns one 64 bit word of the next bitmap,
+ * so it needs no atomics.
+ *
+ * In BFS_DIRECTION_OPTIMIZING mode, bottom-up is used while the frontier has more
+ * than 1/alpha of the unexplored edges, and top-down again once the frontier is
+ * shrinking and has fewer than num_verts/beta vertices.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_>
+class BFS{
+public:
+  typedef typename lno_row_view_t_::const_type const_lno_row_view_t;
+  typedef typename lno_nnz_view_t_::const_type const_lno_nnz_view_t;
+  typedef typename lno_row_view_t_::non_const_value_type size_type;
+  typedef typename lno_nnz_view_t_::non_const_value_type nnz_lno_t;
+  typedef typename lno_nnz_view_t_::device_type device_type;
+  typedef typename device_type::execution_space MyExecSpace;
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef Kokkos::TeamPolicy<MyExecSpace, Kokkos::Schedule<Kokkos::Dynamic> > team_policy_t;
+  typedef typename team_policy_t::member_type team_member_t;
+  typedef Kokkos::View<nnz_lno_t *, device_type> nnz_lno_temp_work_view_t;
+  typedef unsigned long long bitset_t;
+  typedef Kokkos::View<bitset_t *, device_type> bitset_view_t;
+
+  static const int bits_per_word = 64;
+  //! Frontier vertices given to each thread of a top-down team.
+  static const int vertices_per_thread = 8;
+  //! Capacity of the team queue; vertices past it are appended one by one.
+  static const int team_queue_capacity = 1024;
+  //! Default alpha and beta, from the paper.
+  static const int default_alpha = 14;
+  static const int default_beta = 24;
+
+private:
+  nnz_lno_t num_verts;
+  const_lno_row_view_t xadj;
+  const_lno_nnz_view_t adj;
+  int alpha, beta;
+  int vector_size, team_size;
+
+  nnz_lno_temp_work_view_t frontier;
+  nnz_lno_temp_work_view_t next_frontier;
+  nnz_lno_temp_work_view_t next_frontier_size;
+  bitset_view_t frontier_bits;
+  bitset_view_t next_frontier_bits;
+
+public:
+  /**
+   * \brief BFS constructor.
+   * \param nv_: number of vertices in the graph.
+   * \param row_map: the xadj array of the graph. Its size is nv_ + 1.
+   * \param entries: adjacency array of the graph. Entries not in
+   *   [0, nv_) are ignored.
+   */
+  BFS (nnz_lno_t nv_, const_lno_row_view_t row_map, const_lno_nnz_view_t entries):
+    num_verts(nv_), xadj(row_map), adj(entries),
+    alpha(default_alpha), beta(default_beta),
+    vector_size(1), team_size(1),
+    frontier(Kokkos::ViewAllocateWithoutInitializing("BFS frontier"), nv_),
+    next_frontier(Kokkos::ViewAllocateWithoutInitializing("BFS next frontier"), nv_),
+    next_frontier_size("BFS next frontier size", 1),
+    frontier_bits(Kokkos::ViewAllocateWithoutInitializing("BFS frontier bits"), (nv_ + bits_per_word - 1) / bits_per_word),
+    next_frontier_bits(Kokkos::ViewAllocateWithoutInitializing("BFS next frontier bits"), (nv_ + bits_per_word - 1) / bits_per_word){
+    KokkosKernels::Impl::ExecSpaceType exec = KokkosKernels::Impl::kk_get_exec_space_type<MyExecSpace>();
+    vector_size = KokkosKernels::Impl::kk_get_suggested_vector_size(nv_, entries.extent(0), exec);
+    team_size = KokkosKernels::Impl::kk_get_suggested_team_size(vector_size, exec);
+  }
+
+  /**
+   * \brief Sets the switching thresholds of BFS_DIRECTION_OPTIMIZING.
+   */
+  void set_alpha_beta(int alpha_, int beta_){
+    this->alpha = alpha_;
+    this->beta = beta_;
+  }
+
+  //one team per chunk of the frontier queue.
+  struct TopDownStep{
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t levels;
+    nnz_lno_temp_work_view_t frontier;
+    nnz_lno_temp_work_view_t next_frontier;
+    nnz_lno_temp_work_view_t next_frontier_size;
+    nnz_lno_t frontier_size;
+    nnz_lno_t next_level;
+    nnz_lno_t chunk_size;
+    TopDownStep(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t levels_, nnz_lno_temp_work_view_t frontier_,
+        nnz_lno_temp_work_view_t next_frontier_, nnz_lno_temp_work_view_t next_frontier_size_,
+        nnz_lno_t frontier_size_, nnz_lno_t next_level_, nnz_lno_t chunk_size_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), levels(levels_), frontier(frontier_),
+      next_frontier(next_frontier_), next_frontier_size(next_frontier_size_),
+      frontier_size(frontier_size_), next_level(next_level_), chunk_size(chunk_size_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const team_member_t &teamMember) const{
+      nnz_lno_t *queue = (nnz_lno_t *) teamMember.team_shmem().get_shmem(sizeof(nnz_lno_t) * team_queue_capacity);
+      nnz_lno_t *queue_size = (nnz_lno_t *) teamMember.team_shmem().get_shmem(sizeof(nnz_lno_t));
+      Kokkos::single(Kokkos::PerTeam(teamMember), [&] (){
+        *queue_size = 0;
+      });
+      teamMember.team_barrier();
+
+      const nnz_lno_t begin = teamMember.league_rank() * chunk_size;
+      const nnz_lno_t end = begin + chunk_size < frontier_size ? begin + chunk_size : frontier_size;
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, begin, end), [&] (const nnz_lno_t i){
+        const nnz_lno_t v = frontier(i);
+        const size_type row_begin = xadj(v);
+        const nnz_lno_t row_size = xadj(v + 1) - row_begin;
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, row_size), [&] (const nnz_lno_t j){
+          const nnz_lno_t n = adj(row_begin + j);
+          if (n < 0 || n >= num_verts) return;
+          if (levels(n) != -1) return;
+          if (Kokkos::atomic_compare_exchange(&levels(n), nnz_lno_t(-1), next_level) != -1) return;
+          const nnz_lno_t pos = Kokkos::atomic_fetch_add(queue_size, nnz_lno_t(1));
+          if (pos < team_queue_capacity) queue[pos] = n;
+          else next_frontier(Kokkos::atomic_fetch_add(&next_frontier_size(0), nnz_lno_t(1))) = n;
+        });
+      });
+      teamMember.team_barrier();
+
+      const nnz_lno_t num_queued = *queue_size < team_queue_capacity ? *queue_size : nnz_lno_t(team_queue_capacity);
+      nnz_lno_t offset = 0;
+      Kokkos::single(Kokkos::PerTeam(teamMember), [&] (nnz_lno_t &team_offset){
+        team_offset = Kokkos::atomic_fetch_add(&next_frontier_size(0), num_queued);
+      }, offset);
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_queued), [&] (const nnz_lno_t k){
+        next_frontier(offset + k) = queue[k];
+      });
+    }
+
+    size_t team_shmem_size(int /* team_size */) const {
+      return sizeof(nnz_lno_t) * (team_queue_capacity + 1);
+    }
+  };
+
+  //the number of vertices and the sum of their degrees.
+  struct FrontierStats{
+    nnz_lno_t num_verts;
+    size_type num_edges;
+  };
+
+  //each thread owns a word of the next frontier bitmap.
+  struct BottomUpStep{
+    typedef FrontierStats value_type;
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t levels;
+    bitset_view_t frontier_bits;
+    bitset_view_t next_frontier_bits;
+    nnz_lno_t next_level;
+    BottomUpStep(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t levels_, bitset_view_t frontier_bits_, bitset_view_t next_frontier_bits_,
+        nnz_lno_t next_level_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), levels(levels_),
+      frontier_bits(frontier_bits_), next_frontier_bits(next_frontier_bits_), next_level(next_level_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &w, value_type &stats) const{
+      bitset_t word = 0;
+      const nnz_lno_t first = w * bits_per_word;
+      for (int b = 0; b < bits_per_word && first + b < num_verts; ++b){
+        const nnz_lno_t v = first + b;
+        if (levels(v) != -1) continue;
+        const size_type end = xadj(v + 1);
+        for (size_type j = xadj(v); j < end; ++j){
+          const nnz_lno_t n = adj(j);
+          if (n < 0 || n >= num_verts) continue;
+          if ((frontier_bits(n / bits_per_word) >> (n % bits_per_word)) & bitset_t(1)){
+            levels(v) = next_level;
+            word |= bitset_t(1) << b;
+            stats.num_edges += end - xadj(v);
+            break;
+          }
+        }
+      }
+      next_frontier_bits(w) = word;
+      stats.num_verts += KokkosKernels::Impl::pop_count(word);
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void join (volatile value_type& dst, const volatile value_type& src) const {
+      dst.num_verts += src.num_verts;
+      dst.num_edges += src.num_edges;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void join (value_type& dst, const value_type& src) const {
+      dst.num_verts += src.num_verts;
+      dst.num_edges += src.num_edges;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void init (value_type& dst) const {
+      dst.num_verts = 0;
+      dst.num_edges = 0;
+    }
+  };
+
+  //sum of the degrees of a frontier queue.
+  struct QueueDegrees{
+    typedef size_type value_type;
+    const_lno_row_view_t xadj;
+    nnz_lno_temp_work_view_t queue;
+    QueueDegrees(const_lno_row_view_t xadj_, nnz_lno_temp_work_view_t queue_):
+      xadj(xadj_), queue(queue_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i, size_type &num_edges) const{
+      const nnz_lno_t v = queue(i);
+      num_edges += xadj(v + 1) - xadj(v);
+    }
+  };
+
+  //bitmap of the vertices at level.
+  struct LevelToBitmap{
+    nnz_lno_t num_verts;
+    nnz_lno_temp_work_view_t levels;
+    bitset_view_t bits;
+    nnz_lno_t level;
+    LevelToBitmap(nnz_lno_t num_verts_, nnz_lno_temp_work_view_t levels_, bitset_view_t bits_, nnz_lno_t level_):
+      num_verts(num_verts_), levels(levels_), bits(bits_), level(level_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &w) const{
+      bitset_t word = 0;
+      const nnz_lno_t first = w * bits_per_word;
+      for (int b = 0; b < bits_per_word && first + b < num_verts; ++b){
+        if (levels(first + b) == level) word |= bitset_t(1) << b;
+      }
+      bits(w) = word;
+    }
+  };
+
+  //queue of the vertices at level, in increasing order.
+  struct LevelToQueue{
+    typedef nnz_lno_t value_type;
+    nnz_lno_temp_work_view_t levels;
+    nnz_lno_temp_work_view_t queue;
+    nnz_lno_t level;
+    LevelToQueue(nnz_lno_temp_work_view_t levels_, nnz_lno_temp_work_view_t queue_, nnz_lno_t level_):
+      levels(levels_), queue(queue_), level(level_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v, nnz_lno_t &update, const bool final) const{
+      if (levels(v) == level){
+        if (final) queue(update) = v;
+        ++update;
+      }
+    }
+  };
+
+private:
+  nnz_lno_t top_down_step(nnz_lno_temp_work_view_t levels, nnz_lno_t frontier_size, nnz_lno_t next_level){
+    Kokkos::deep_copy(next_frontier_size, nnz_lno_t(0));
+    const nnz_lno_t chunk_size = team_size * vertices_per_thread;
+    const nnz_lno_t num_teams = (frontier_size + chunk_size - 1) / chunk_size;
+    Kokkos::parallel_for("KokkosGraph::BFS::TopDownStep", team_policy_t(num_teams, team_size, vector_size),
+        TopDownStep(num_verts, xadj, adj, levels, frontier, next_frontier, next_frontier_size,
+            frontier_size, next_level, chunk_size));
+    nnz_lno_t next_size = 0;
+    Kokkos::deep_copy(next_size, Kokkos::subview(next_frontier_size, 0));
+    std::swap(frontier, next_frontier);
+    return next_size;
+  }
+
+public:
+  /**
+   * \brief BFS from root.
+   * \param root: the source vertex.
+   * \param levels: output, the distance of each vertex from root, or -1 if it
+   *   is not reached. Its size is num_verts.
+   * \param direction: the step kind, see BFSDirection.
+   * \return the number of levels, which is the eccentricity of root plus one.
+   */
+  nnz_lno_t bfs(nnz_lno_t root, nnz_lno_temp_work_view_t levels, BFSDirection direction = BFS_DIRECTION_OPTIMIZING){
+    Kokkos::deep_copy(levels, nnz_lno_t(-1));
+    if (root < 0 || root >= num_verts) return 0;
+    Kokkos::deep_copy(Kokkos::subview(levels, root), nnz_lno_t(0));
+    Kokkos::deep_copy(Kokkos::subview(frontier, 0), root);
+
+    const nnz_lno_t num_words = frontier_bits.extent(0);
+    size_type root_begin = 0, root_end = 0;
+    Kokkos::deep_copy(root_begin, Kokkos::subview(xadj, root));
+    Kokkos::deep_copy(root_end, Kokkos::subview(xadj, root + 1));
+
+    bool bottom_up = direction == BFS_BOTTOM_UP;
+    if (bottom_up){
+      Kokkos::parallel_for("KokkosGraph::BFS::LevelToBitmap", my_exec_space(0, num_words),
+          LevelToBitmap(num_verts, levels, frontier_bits, 0));
+    }
+    nnz_lno_t frontier_size = 1;
+    size_type frontier_edges = root_end - root_begin;
+    size_type unexplored_edges = adj.extent(0) - frontier_edges;
+    nnz_lno_t level = 0;
+    bool growing = true;
+    while (frontier_size > 0){
+      nnz_lno_t next_size = 0;
+      size_type next_edges = 0;
+      if (direction == BFS_DIRECTION_OPTIMIZING){
+        if (!bottom_up && frontier_edges > unexplored_edges / alpha){
+          bottom_up = true;
+          Kokkos::parallel_for("KokkosGraph::BFS::LevelToBitmap", my_exec_space(0, num_words),
+              LevelToBitmap(num_verts, levels, frontier_bits, level));
+        }
+        else if (bottom_up && !growing && frontier_size < num_verts / beta){
+          bottom_up = false;
+          Kokkos::parallel_scan("KokkosGraph::BFS::LevelToQueue", my_exec_space(0, num_verts),
+              LevelToQueue(levels, frontier, level));
+        }
+      }
+
+      if (bottom_up){
+        FrontierStats stats;
+        stats.num_verts = 0;
+        stats.num_edges = 0;
+        Kokkos::parallel_reduce("KokkosGraph::BFS::BottomUpStep", my_exec_space(0, num_words),
+            BottomUpStep(num_verts, xadj, adj, levels, frontier_bits, next_frontier_bits, level + 1), stats);
+        std::swap(frontier_bits, next_frontier_bits);
+        next_size = stats.num_verts;
+        next_edges = stats.num_edges;
+      }
+      else {
+        next_size = top_down_step(levels, frontier_size, level + 1);
+        Kokkos::parallel_reduce("KokkosGraph::BFS::QueueDegrees", my_exec_space(0, next_size),
+            QueueDegrees(xadj, frontier), next_edges);
+      }
+
+      if (next_size == 0) break;
+      growing = next_size > frontier_size;
+      frontier_size = next_size;
+      frontier_edges = next_edges;
+      unexplored_edges = unexplored_edges > next_edges ? unexplored_edges - next_edges : 0;
+      ++level;
+    }
+    MyExecSpace::fence();
+    return level + 1;
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,264 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_COARSEN_IMPL_HPP
+#define _KOKKOSGRAPH_COARSEN_IMPL_HPP
+
+#include "KokkosKernels_Utils.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+namespace Impl{
+
+/*! \brief Parallel heavy edge matching by handshakes.
+ *
+ * In every round each unmatched vertex points to the unmatched neighbor
+ * with the heaviest edge, and two vertices that point to each other are
+ * matched. Edges of equal weight are ordered by a hash of their end points,
+ * so the edge order is strict and the heaviest remaining edge is always
+ * matched; the hash keeps runs of equal weights, like unweighted paths, from
+ * being matched one pair per round. Rounds stop when none makes a match.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_view_t_>
+class HeavyEdgeMatching{
+public:
+  typedef typename lno_row_view_t_::const_type const_lno_row_view_t;
+  typedef typename lno_nnz_view_t_::const_type const_lno_nnz_view_t;
+  typedef typename scalar_view_t_::const_type const_scalar_view_t;
+  typedef typename lno_row_view_t_::non_const_value_type size_type;
+  typedef typename lno_nnz_view_t_::non_const_value_type nnz_lno_t;
+  typedef typename scalar_view_t_::non_const_value_type nnz_scalar_t;
+  typedef typename lno_nnz_view_t_::device_type device_type;
+  typedef typename device_type::execution_space MyExecSpace;
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef Kokkos::View<nnz_lno_t *, device_type> nnz_lno_temp_work_view_t;
+  typedef unsigned long long hash_t;
+
+private:
+  nnz_lno_t num_verts;
+  const_lno_row_view_t xadj;
+  const_lno_nnz_view_t adj;
+  const_scalar_view_t weights;
+
+  nnz_lno_temp_work_view_t candidates;
+
+public:
+  /**
+   * \brief HeavyEdgeMatching constructor.
+   * \param nv_: number of vertices in the graph.
+   * \param row_map: the xadj array of the graph. Its size is nv_ + 1.
+   * \param entries: adjacency array of the graph. Entries not in
+   *   [0, nv_) are ignored.
+   * \param values: the weight of each edge.
+   */
+  HeavyEdgeMatching (nnz_lno_t nv_, const_lno_row_view_t row_map, const_lno_nnz_view_t entries,
+      const_scalar_view_t values):
+    num_verts(nv_), xadj(row_map), adj(entries), weights(values),
+    candidates(Kokkos::ViewAllocateWithoutInitializing("HEM candidates"), nv_){}
+
+  //splitmix64 finalizer of the end points; the same from both ends.
+  KOKKOS_INLINE_FUNCTION
+  static hash_t edge_hash(nnz_lno_t u, nnz_lno_t v){
+    const hash_t lo = u < v ? u : v, hi = u < v ? v : u;
+    hash_t x = (hi << 32) ^ lo ^ (hi >> 32);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+
+  struct InitMatch{
+    nnz_lno_temp_work_view_t match;
+    InitMatch(nnz_lno_temp_work_view_t match_): match(match_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      match(i) = -1;
+    }
+  };
+
+  //the unmatched neighbor of the heaviest edge, or -1.
+  struct PickHeaviest{
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    const_scalar_view_t weights;
+    nnz_lno_temp_work_view_t match;
+    nnz_lno_temp_work_view_t candidates;
+    PickHeaviest(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        const_scalar_view_t weights_, nnz_lno_temp_work_view_t match_, nnz_lno_temp_work_view_t candidates_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), weights(weights_), match(match_), candidates(candidates_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v) const{
+      nnz_lno_t best = -1;
+      if (match(v) == -1){
+        nnz_scalar_t best_weight = nnz_scalar_t();
+        hash_t best_hash = 0;
+        const size_type end = xadj(v + 1);
+        for (size_type j = xadj(v); j < end; ++j){
+          const nnz_lno_t n = adj(j);
+          if (n < 0 || n >= num_verts || n == v || match(n) != -1) continue;
+          const nnz_scalar_t w = weights(j);
+          const hash_t h = edge_hash(v, n);
+          if (best == -1 || w > best_weight || (!(w < best_weight) && h > best_hash)){
+            best = n;
+            best_weight = w;
+            best_hash = h;
+          }
+        }
+      }
+      candidates(v) = best;
+    }
+  };
+
+  //matches the mutual candidates and counts the new matches.
+  struct Handshake{
+    typedef nnz_lno_t value_type;
+    nnz_lno_temp_work_view_t match;
+    nnz_lno_temp_work_view_t candidates;
+    Handshake(nnz_lno_temp_work_view_t match_, nnz_lno_temp_work_view_t candidates_):
+      match(match_), candidates(candidates_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v, nnz_lno_t &num_matched) const{
+      const nnz_lno_t c = candidates(v);
+      if (c != -1 && candidates(c) == v){
+        match(v) = c;
+        ++num_matched;
+      }
+    }
+  };
+
+  struct MatchSelf{
+    nnz_lno_temp_work_view_t match;
+    MatchSelf(nnz_lno_temp_work_view_t match_): match(match_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      if (match(i) == -1) match(i) = i;
+    }
+  };
+
+  /**
+   * \brief Computes the matching.
+   * \param match: output, the vertex matched with each vertex, or the vertex
+   *   itself if it is not matched.
+   * \return the number of rounds.
+   */
+  int matching(nnz_lno_temp_work_view_t match){
+    Kokkos::parallel_for("KokkosGraph::HEM::InitMatch", my_exec_space(0, num_verts), InitMatch(match));
+    int num_rounds = 0;
+    while (true){
+      ++num_rounds;
+      Kokkos::parallel_for("KokkosGraph::HEM::PickHeaviest", my_exec_space(0, num_verts),
+          PickHeaviest(num_verts, xadj, adj, weights, match, candidates));
+      nnz_lno_t num_matched = 0;
+      Kokkos::parallel_reduce("KokkosGraph::HEM::Handshake", my_exec_space(0, num_verts),
+          Handshake(match, candidates), num_matched);
+      if (num_matched == 0) break;
+    }
+    Kokkos::parallel_for("KokkosGraph::HEM::MatchSelf", my_exec_space(0, num_verts), MatchSelf(match));
+    MyExecSpace::fence();
+    return num_rounds;
+  }
+};
+
+/*! \brief Builds the aggregation operators of a matching.
+ *
+ * A pair is numbered by its smaller vertex, in increasing order. P is
+ * num_verts x num_coarse with a one at (v, labels(v)); R = P^T has the
+ * smaller vertex of a pair first.
+ */
+template <typename match_view_t, typename label_view_t, typename row_view_t, typename nnz_view_t>
+struct MatchingOperators{
+  typedef typename match_view_t::non_const_value_type nnz_lno_t;
+  typedef typename row_view_t::non_const_value_type size_type;
+
+  match_view_t match;
+  label_view_t labels;
+  row_view_t row_mapR;
+  nnz_view_t entriesR;
+
+  MatchingOperators(match_view_t match_, label_view_t labels_, row_view_t row_mapR_, nnz_view_t entriesR_):
+    match(match_), labels(labels_), row_mapR(row_mapR_), entriesR(entriesR_){}
+
+  struct CountPairs{};
+  struct NumberPairs{};
+  struct FillOperators{};
+
+  typedef nnz_lno_t value_type;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const CountPairs &, const nnz_lno_t &v, nnz_lno_t &num_pairs) const{
+    if (match(v) >= v) ++num_pairs;
+  }
+
+  //labels of the smaller vertices, and the row sizes of R.
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const NumberPairs &, const nnz_lno_t &v, nnz_lno_t &update, const bool final) const{
+    const nnz_lno_t m = match(v);
+    if (m < v) return;
+    if (final){
+      labels(v) = update;
+      row_mapR(update) = m == v ? 1 : 2;
+    }
+    ++update;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const FillOperators &, const nnz_lno_t &v) const{
+    const nnz_lno_t m = match(v);
+    if (m < v) {
+      labels(v) = labels(m);
+      entriesR(row_mapR(labels(m)) + 1) = v;
+    }
+    else entriesR(row_mapR(labels(v))) = v;
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,315 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_CONNECTEDCOMPONENTS_IMPL_HPP
+#define _KOKKOSGRAPH_CONNECTEDCOMPONENTS_IMPL_HPP
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "KokkosKernels_Utils.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+namespace Impl{
+
+/*! \brief Afforest connected components (Sutton, Ben-Nun and Barak).
+ *
+ * parent is a forest where every tree is a subset of a component; a root
+ * is its own parent and has the smallest vertex id of its tree. link hooks the
+ * larger of two roots under the smaller with a compare-exchange, and compress
+ * points every vertex to its root.
+ *
+ * The first neighbor_rounds edges of every vertex are linked first, which is
+ * usually enough to connect most of the largest component. Its root is then
+ * estimated from num_samples random vertices, and only the vertices outside it
+ * link their remaining edges. Every edge of a vertex in the largest tree is
+ * also seen from its other end as long as the graph is symmetric.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_>
+class ConnectedComponents{
+public:
+  typedef typename lno_row_view_t_::const_type const_lno_row_view_t;
+  typedef typename lno_nnz_view_t_::const_type const_lno_nnz_view_t;
+  typedef typename lno_row_view_t_::non_const_value_type size_type;
+  typedef typename lno_nnz_view_t_::non_const_value_type nnz_lno_t;
+  typedef typename lno_nnz_view_t_::device_type device_type;
+  typedef typename device_type::execution_space MyExecSpace;
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef Kokkos::View<nnz_lno_t *, device_type> nnz_lno_temp_work_view_t;
+
+  //! The number of edges of each vertex linked before sampling.
+  static const int neighbor_rounds = 2;
+  //! The number of vertices sampled to find the largest component.
+  static const int num_samples = 1024;
+
+private:
+  nnz_lno_t num_verts;
+  const_lno_row_view_t xadj;
+  const_lno_nnz_view_t adj;
+
+  nnz_lno_temp_work_view_t parent;
+
+public:
+  /**
+   * \brief ConnectedComponents constructor.
+   * \param nv_: number of vertices in the graph.
+   * \param row_map: the xadj array of the graph. Its size is nv_ + 1.
+   * \param entries: adjacency array of the graph. Entries not in
+   *   [0, nv_) are ignored.
+   */
+  ConnectedComponents (nnz_lno_t nv_, const_lno_row_view_t row_map, const_lno_nnz_view_t entries):
+    num_verts(nv_), xadj(row_map), adj(entries),
+    parent(Kokkos::ViewAllocateWithoutInitializing("CC parent"), nv_){}
+
+  KOKKOS_INLINE_FUNCTION
+  static void link(const nnz_lno_temp_work_view_t &parent, nnz_lno_t u, nnz_lno_t v){
+    nnz_lno_t p1 = parent(u);
+    nnz_lno_t p2 = parent(v);
+    while (p1 != p2){
+      const nnz_lno_t high = p1 > p2 ? p1 : p2;
+      const nnz_lno_t low = p1 > p2 ? p2 : p1;
+      const nnz_lno_t p_high = parent(high);
+      //high is already under low, or was a root and is now hooked under it.
+      if (p_high == low) break;
+      if (p_high == high && Kokkos::atomic_compare_exchange(&parent(high), high, low) == high) break;
+      p1 = parent(parent(high));
+      p2 = parent(low);
+    }
+  }
+
+  struct InitParent{
+    nnz_lno_temp_work_view_t parent;
+    InitParent(nnz_lno_temp_work_view_t parent_): parent(parent_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      parent(i) = i;
+    }
+  };
+
+  //links the edge at position round of every vertex.
+  struct LinkRound{
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t parent;
+    size_type round;
+    LinkRound(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t parent_, size_type round_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), parent(parent_), round(round_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      const size_type j = xadj(i) + round;
+      if (j >= xadj(i + 1)) return;
+      const nnz_lno_t n = adj(j);
+      if (n < 0 || n >= num_verts) return;
+      link(parent, i, n);
+    }
+  };
+
+  //links the remaining edges of the vertices outside the tree of skip_root.
+  struct LinkRemaining{
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t parent;
+    nnz_lno_t skip_root;
+    LinkRemaining(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t parent_, nnz_lno_t skip_root_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), parent(parent_), skip_root(skip_root_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      if (parent(i) == skip_root) return;
+      const size_type end = xadj(i + 1);
+      for (size_type j = xadj(i) + neighbor_rounds; j < end; ++j){
+        const nnz_lno_t n = adj(j);
+        if (n < 0 || n >= num_verts) continue;
+        link(parent, i, n);
+      }
+    }
+  };
+
+  struct Compress{
+    nnz_lno_temp_work_view_t parent;
+    Compress(nnz_lno_temp_work_view_t parent_): parent(parent_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      while (parent(i) != parent(parent(i))){
+        parent(i) = parent(parent(i));
+      }
+    }
+  };
+
+  struct GatherSamples{
+    nnz_lno_temp_work_view_t parent;
+    nnz_lno_temp_work_view_t samples;
+    GatherSamples(nnz_lno_temp_work_view_t parent_, nnz_lno_temp_work_view_t samples_):
+      parent(parent_), samples(samples_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      samples(i) = parent(samples(i));
+    }
+  };
+
+  //component ids of the roots, in increasing order of the roots.
+  struct NumberRoots{
+    typedef nnz_lno_t value_type;
+    nnz_lno_temp_work_view_t parent;
+    nnz_lno_temp_work_view_t ids;
+    NumberRoots(nnz_lno_temp_work_view_t parent_, nnz_lno_temp_work_view_t ids_):
+      parent(parent_), ids(ids_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i, nnz_lno_t &update, const bool final) const{
+      if (parent(i) == i){
+        if (final) ids(i) = update;
+        ++update;
+      }
+    }
+  };
+
+  struct CountRoots{
+    typedef nnz_lno_t value_type;
+    nnz_lno_temp_work_view_t parent;
+    CountRoots(nnz_lno_temp_work_view_t parent_): parent(parent_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i, nnz_lno_t &num_roots) const{
+      if (parent(i) == i) ++num_roots;
+    }
+  };
+
+  template <typename label_view_t>
+  struct WriteLabels{
+    nnz_lno_temp_work_view_t parent;
+    nnz_lno_temp_work_view_t ids;
+    label_view_t labels;
+    WriteLabels(nnz_lno_temp_work_view_t parent_, nnz_lno_temp_work_view_t ids_, label_view_t labels_):
+      parent(parent_), ids(ids_), labels(labels_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      labels(i) = ids(parent(i));
+    }
+  };
+
+private:
+  void compress(){
+    Kokkos::parallel_for("KokkosGraph::ConnectedComponents::Compress", my_exec_space(0, num_verts),
+        Compress(parent));
+  }
+
+  //the most frequent root among the sampled vertices.
+  nnz_lno_t sample_frequent_root(){
+    nnz_lno_temp_work_view_t samples(Kokkos::ViewAllocateWithoutInitializing("CC samples"), num_samples);
+    typename nnz_lno_temp_work_view_t::HostMirror h_samples = Kokkos::create_mirror_view(samples);
+    std::mt19937 gen(27491095);
+    std::uniform_int_distribution<nnz_lno_t> distribution(0, num_verts - 1);
+    for (int i = 0; i < num_samples; ++i) h_samples(i) = distribution(gen);
+    Kokkos::deep_copy(samples, h_samples);
+    Kokkos::parallel_for("KokkosGraph::ConnectedComponents::GatherSamples", my_exec_space(0, num_samples),
+        GatherSamples(parent, samples));
+    Kokkos::deep_copy(h_samples, samples);
+
+    std::sort(h_samples.data(), h_samples.data() + num_samples);
+    nnz_lno_t best = h_samples(0);
+    int best_count = 0;
+    for (int i = 0; i < num_samples; ){
+      int j = i;
+      while (j < num_samples && h_samples(j) == h_samples(i)) ++j;
+      if (j - i > best_count){
+        best_count = j - i;
+        best = h_samples(i);
+      }
+      i = j;
+    }
+    return best;
+  }
+
+public:
+  /**
+   * \brief Computes the connected components.
+   * \param labels: output, the component of each vertex in [0, num_components).
+   *   Components are numbered in increasing order of their smallest vertex.
+   * \return num_components.
+   */
+  template <typename label_view_t>
+  nnz_lno_t components(label_view_t labels){
+    if (num_verts == 0) return 0;
+    Kokkos::parallel_for("KokkosGraph::ConnectedComponents::InitParent", my_exec_space(0, num_verts),
+        InitParent(parent));
+    for (int round = 0; round < neighbor_rounds; ++round){
+      Kokkos::parallel_for("KokkosGraph::ConnectedComponents::LinkRound", my_exec_space(0, num_verts),
+          LinkRound(num_verts, xadj, adj, parent, round));
+      compress();
+    }
+
+    const nnz_lno_t frequent_root = sample_frequent_root();
+    Kokkos::parallel_for("KokkosGraph::ConnectedComponents::LinkRemaining", my_exec_space(0, num_verts),
+        LinkRemaining(num_verts, xadj, adj, parent, frequent_root));
+    compress();
+
+    nnz_lno_temp_work_view_t ids(Kokkos::ViewAllocateWithoutInitializing("CC ids"), num_verts);
+    Kokkos::parallel_scan("KokkosGraph::ConnectedComponents::NumberRoots", my_exec_space(0, num_verts),
+        NumberRoots(parent, ids));
+    nnz_lno_t num_components = 0;
+    Kokkos::parallel_reduce("KokkosGraph::ConnectedComponents::CountRoots", my_exec_space(0, num_verts),
+        CountRoots(parent), num_components);
+    Kokkos::parallel_for("KokkosGraph::ConnectedComponents::WriteLabels", my_exec_space(0, num_verts),
+        WriteLabels<label_view_t>(parent, ids, labels));
+    MyExecSpace::fence();
+    return num_components;
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -50,6 +50,7 @@
 #include <Kokkos_MemoryTraits.hpp>
 
 #include "KokkosKernels_Handle.hpp"
+#include "KokkosKernels_BitUtils.hpp"
 #include "KokkosGraph_GraphColorHandle.hpp"
 #include "KokkosGraph_graph_color.hpp"
 
@@ -252,6 +253,10 @@ public:
 
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
 
+  typedef Kokkos::TeamPolicy<MyExecSpace>     team_policy_t;
+  typedef typename team_policy_t::member_type team_member_t;
+  typedef unsigned long long                  forbidden_t;    // VBBIT window of forbidden colors
+
 
 protected:
   nnz_lno_t             nr;       // num_rows  (# verts)
@@ -271,8 +276,10 @@ private:
   int  _max_num_iterations;
   char _conflictList;              // 0: none, 1: atomic (default), 2: parallel prefix sums (0, 2 not implemented)
   bool _serialConflictResolution;  // true if using serial conflict resolution, false otherwise (default)
-  char _use_color_set;             // The VB Algorithm Type: 0: VB,  1: VBCS,  2: VBBIT  (1, 2 not implemented).
+  char _use_color_set;             // The VB Algorithm Type: 0: VB,  1: VBCS,  2: VBBIT  (1 not implemented).
   bool _ticToc;                    // if true print info in each step
+  int  _vector_size;               // vector and team sizes of the VBBIT team-vector kernel
+  int  _team_size;
 
 public:
 
@@ -306,8 +313,10 @@ public:
         _max_num_iterations(handle->get_graph_coloring_handle()->get_max_number_of_iterations()),
         _conflictList(1),
         _serialConflictResolution(false),
-        _use_color_set(0),
-        _ticToc(handle->get_verbose())
+        _use_color_set(handle->get_graph_coloring_handle()->get_coloring_algo_type() == COLORING_D2_VB_BIT ? 2 : 0),
+        _ticToc(handle->get_verbose()),
+        _vector_size(handle->get_suggested_vector_size(nr_, ne_, row_map)),
+        _team_size(handle->get_suggested_team_size(_vector_size))
   {
     //std::cout << ">>> WCMCLEN GraphColorD2() (KokkosGraph_Distance2Color_impl.hpp)" << std::endl
     //          << ">>> WCMCLEN :    coloring_algo_type = " << handle->get_coloring_algo_type() << std::endl
@@ -360,7 +369,7 @@ public:
     nnz_lno_temp_work_view_t current_vertexList = nnz_lno_temp_work_view_t(Kokkos::ViewAllocateWithoutInitializing("vertexList"), this->nv);
 
     // init conflictlist sequentially.
-    Kokkos::parallel_for(my_exec_space(0, this->nv), functorInitList<nnz_lno_temp_work_view_t>(current_vertexList));
+    Kokkos::parallel_for("KokkosGraph::Distance2Coloring::InitList", my_exec_space(0, this->nv), functorInitList<nnz_lno_temp_work_view_t>(current_vertexList));
 
     // Next iteratons's conflictList
     nnz_lno_temp_work_view_t next_iteration_recolorList;
@@ -502,6 +511,22 @@ private:
       chunkSize_ = 1;
     }
 
+    if(2 == this->_use_color_set)
+    {
+      // VBBIT: a thread per vertex, the vector lanes share the distance-2 neighbors.
+      functorGreedyColor_BIT gc(this->nv,
+                                xadj_,
+                                adj_,
+                                t_xadj_,
+                                t_adj_,
+                                vertex_colors_,
+                                current_vertexList_,
+                                current_vertexListLength_);
+
+      Kokkos::parallel_for("KokkosGraph::Distance2Coloring::GreedyColorTeam", team_policy_t(current_vertexListLength_ / this->_team_size + 1, this->_team_size, this->_vector_size), gc);
+      return;
+    }
+
     functorGreedyColor gc(this->nv,
                           xadj_,
                           adj_,
@@ -513,7 +538,7 @@ private:
                           chunkSize_
                           );
 
-    Kokkos::parallel_for(my_exec_space(0, current_vertexListLength_ / chunkSize_ + 1), gc);
+    Kokkos::parallel_for("KokkosGraph::Distance2Coloring::GreedyColor", my_exec_space(0, current_vertexListLength_ / chunkSize_ + 1), gc);
 
   }  // colorGreedy (end)
 
@@ -562,19 +587,19 @@ private:
     // conflictList mode: ATOMIC
     else if(1 == this->_conflictList)
     {
-      if(0 == this->_use_color_set)
-      {
-        functorFindConflicts_Atomic<adj_view_t> conf(this->nv,
-                                                     xadj_,
-                                                     adj_,
-                                                     t_xadj_,
-                                                     t_adj_,
-                                                     vertex_colors_,
-                                                     current_vertexList_,
-                                                     next_iteration_recolorList_,
-                                                     next_iteration_recolorListLength_);
-        Kokkos::parallel_reduce(my_exec_space(0, current_vertexListLength_), conf, output_numUncolored);
-      }
+      // VBBIT only uncolors the smaller vertex of a conflicting pair. Both come from the
+      // worklist of this phase, so the larger one keeps a valid color.
+      functorFindConflicts_Atomic<adj_view_t> conf(this->nv,
+                                                   xadj_,
+                                                   adj_,
+                                                   t_xadj_,
+                                                   t_adj_,
+                                                   vertex_colors_,
+                                                   current_vertexList_,
+                                                   next_iteration_recolorList_,
+                                                   next_iteration_recolorListLength_,
+                                                   2 == this->_use_color_set);
+      Kokkos::parallel_reduce("KokkosGraph::Distance2Coloring::FindConflicts", my_exec_space(0, current_vertexListLength_), conf, output_numUncolored);
     }
     else
     {
@@ -867,6 +892,7 @@ private:
     nnz_lno_temp_work_view_t   _vertexList;
     nnz_lno_temp_work_view_t   _recolorList;
     single_dim_index_view_type _recolorListLength;
+    bool                       _break_ties;   // if true, only the smaller vertex of a conflict is uncolored
 
 
     functorFindConflicts_Atomic(nnz_lno_t                  nv_,
@@ -877,7 +903,8 @@ private:
                                 color_view_type            colors,
                                 nnz_lno_temp_work_view_t   vertexList,
                                 nnz_lno_temp_work_view_t   recolorList,
-                                single_dim_index_view_type recolorListLength)
+                                single_dim_index_view_type recolorListLength,
+                                bool                       break_ties = false)
              : nv (nv_),
                _idx(xadj_),
                _adj(adj_),
@@ -886,7 +913,8 @@ private:
                _colors(colors),
                _vertexList(vertexList),
                _recolorList(recolorList),
-               _recolorListLength(recolorListLength)
+               _recolorListLength(recolorListLength),
+               _break_ties(break_ties)
     { }
 
     KOKKOS_INLINE_FUNCTION
@@ -911,7 +939,7 @@ private:
 
           if(vid == vid_2idx || vid_2idx >= nv) continue;
 
-          if(_colors(vid_2idx) == my_color)
+          if(_colors(vid_2idx) == my_color && (!_break_ties || vid < vid_2idx))
           {
             _colors(vid) = 0;   // uncolor vertex
             // Atomically add vertex to recolorList
@@ -928,6 +956,102 @@ private:
   }; // struct functorFindConflicts_Atomic (end)
 
 
+
+  /**
+   * Functor for VBBIT algorithm speculative coloring.
+   *
+   * Each thread of a team colors one vertex of the worklist. Colors are searched in
+   * windows of 64: the vector lanes or-reduce the colors of the distance-2 neighbors
+   * that fall in the window into a bitmask, and the vertex takes the lowest clear bit.
+   */
+  struct functorGreedyColor_BIT
+  {
+    nnz_lno_t                nv;                  // num vertices
+    const_lno_row_view_t     _idx;                // vertex degree list
+    const_lno_nnz_view_t     _adj;                // vertex adjacency list
+    const_clno_row_view_t    _t_idx;              // transpose vertex degree list
+    const_clno_nnz_view_t    _t_adj;              // transpose vertex adjacency list
+    color_view_type          _colors;             // vertex colors
+    nnz_lno_temp_work_view_t _vertexList;         //
+    nnz_lno_t                _vertexListLength;   //
+
+    functorGreedyColor_BIT(nnz_lno_t                nv_,
+                           const_lno_row_view_t     xadj_,
+                           const_lno_nnz_view_t     adj_,
+                           const_clno_row_view_t    t_xadj_,
+                           const_clno_nnz_view_t    t_adj_,
+                           color_view_type          colors,
+                           nnz_lno_temp_work_view_t vertexList,
+                           nnz_lno_t                vertexListLength)
+          : nv(nv_),
+            _idx(xadj_),
+            _adj(adj_),
+            _t_idx(t_xadj_),
+            _t_adj(t_adj_),
+            _colors(colors),
+            _vertexList(vertexList),
+            _vertexListLength(vertexListLength)
+    {
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const team_member_t &teamMember) const
+    {
+      const nnz_lno_t work = teamMember.league_rank() * teamMember.team_size() + teamMember.team_rank();
+      if(work >= _vertexListLength) return;
+
+      const nnz_lno_t vid = _vertexList(work);
+
+      // Already colored this vertex.
+      if(_colors(vid) > 0) return;
+
+      const color_t window_size = 8 * sizeof(forbidden_t);
+
+      // by convention, colors start at 1
+      for(color_t offset = 1; ; offset += window_size)
+      {
+        forbidden_t forbidden = 0;
+
+        for(size_type vid_1adj=_idx(vid); vid_1adj < _idx(vid+1); vid_1adj++)
+        {
+          const nnz_lno_t vid_1idx   = _adj(vid_1adj);
+          const size_type vid_2begin = _t_idx(vid_1idx);
+          forbidden_t d2_forbidden = 0;
+
+          Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(teamMember, _t_idx(vid_1idx+1) - vid_2begin),
+                                  [&] (const size_type i, forbidden_t &mask)
+          {
+            const nnz_lno_t vid_2idx = _t_adj(vid_2begin + i);
+
+            // Skip distance-2-self-loops
+            if(vid_2idx == vid || vid_2idx >= nv) return;
+
+            const color_t c = _colors(vid_2idx);
+            if(c >= offset && c - offset < window_size)
+            {
+              mask |= forbidden_t(1) << (c - offset);
+            }
+          }, Kokkos::BOr<forbidden_t>(d2_forbidden));
+
+          forbidden |= d2_forbidden;
+
+          // the whole window is taken, move on to the next one.
+          if(~forbidden == 0) break;
+        }
+
+        if(~forbidden != 0)
+        {
+          Kokkos::single(Kokkos::PerThread(teamMember), [&] ()
+          {
+            _colors(vid) = offset + KokkosKernels::Impl::least_set_bit(~forbidden) - 1;
+          });
+          return;
+        }
+      }
+    }   // operator() (end)
+  };  // struct functorGreedyColor_BIT (end)
+
+
 };  // end class GraphColorD2
 
 
@@ -0,0 +1,189 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_EDGESIMILARITY_IMPL_HPP
+#define _KOKKOSGRAPH_EDGESIMILARITY_IMPL_HPP
+
+#include <cmath>
+#include "KokkosGraph_TriangleCount_impl.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+//! The similarity of the two vertices of an edge, see edge_similarity.
+enum EdgeSimilarity{
+  SIMILARITY_COMMON_NEIGHBORS,  //|N(u) & N(v)|
+  SIMILARITY_JACCARD,           //|N(u) & N(v)| / |N(u) | N(v)|
+  SIMILARITY_ADAMIC_ADAR        //sum of 1 / log(d(w)) over the common neighbors w
+};
+
+namespace Impl{
+
+//! The degree of each vertex without its self loops and its entries out of the graph.
+template <typename row_map_t, typename entries_t, typename degree_view_t>
+struct ValidDegree{
+  typedef typename row_map_t::non_const_value_type size_type;
+  typedef typename entries_t::non_const_value_type nnz_lno_t;
+
+  nnz_lno_t num_rows;
+  row_map_t xadj;
+  entries_t adj;
+  degree_view_t degree;
+  ValidDegree(nnz_lno_t num_rows_, row_map_t xadj_, entries_t adj_, degree_view_t degree_):
+    num_rows(num_rows_), xadj(xadj_), adj(adj_), degree(degree_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const nnz_lno_t i) const{
+    nnz_lno_t d = 0;
+    for (size_type e = xadj(i); e < xadj(i + 1); ++e){
+      const nnz_lno_t j = adj(e);
+      if (j != i && j >= 0 && j < num_rows) ++d;
+    }
+    degree(i) = d;
+  }
+};
+
+//! The Adamic-Adar weight of a common neighbor, 1 / log of its degree.
+template <typename weight_view_t>
+struct AdamicAdarWeight{
+  typedef typename weight_view_t::non_const_value_type weight_value_t;
+  weight_view_t inverse_log_degree;
+  AdamicAdarWeight(weight_view_t inverse_log_degree_): inverse_log_degree(inverse_log_degree_){}
+
+  template <typename nnz_lno_t>
+  KOKKOS_INLINE_FUNCTION
+  weight_value_t operator()(const nnz_lno_t k) const{
+    return inverse_log_degree(k);
+  }
+};
+
+//! 1 / log(d), or 0 for vertices of degree below 2, which are nobody's common neighbor.
+template <typename degree_view_t, typename weight_view_t>
+struct InverseLogDegree{
+  typedef typename weight_view_t::non_const_value_type weight_value_t;
+  degree_view_t degree;
+  weight_view_t inverse_log_degree;
+  InverseLogDegree(degree_view_t degree_, weight_view_t inverse_log_degree_):
+    degree(degree_), inverse_log_degree(inverse_log_degree_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i) const{
+    inverse_log_degree(i) = degree(i) > 1 ? weight_value_t(1.0 / log(double(degree(i)))) : weight_value_t(0);
+  }
+};
+
+//! The common neighbors of each edge divided by the size of the union of the two neighborhoods.
+template <typename row_map_t, typename entries_t, typename degree_view_t, typename similarity_view_t>
+struct JaccardFromCommon{
+  typedef typename row_map_t::non_const_value_type size_type;
+  typedef typename entries_t::non_const_value_type nnz_lno_t;
+  typedef typename similarity_view_t::non_const_value_type similarity_t;
+
+  nnz_lno_t num_rows;
+  row_map_t xadj;
+  entries_t adj;
+  degree_view_t degree;
+  similarity_view_t similarity;
+  JaccardFromCommon(nnz_lno_t num_rows_, row_map_t xadj_, entries_t adj_,
+      degree_view_t degree_, similarity_view_t similarity_):
+    num_rows(num_rows_), xadj(xadj_), adj(adj_), degree(degree_), similarity(similarity_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const nnz_lno_t i) const{
+    for (size_type e = xadj(i); e < xadj(i + 1); ++e){
+      const nnz_lno_t j = adj(e);
+      if (j == i || j < 0 || j >= num_rows) continue;
+      const similarity_t common = similarity(e);
+      similarity(e) = common / (similarity_t(degree(i) + degree(j)) - common);
+    }
+  }
+};
+
+/*! \brief One similarity per entry of a symmetric graph, from the intersections of
+ *  TriangleSupport: its support is the number of common neighbors, and with the
+ *  Adamic-Adar weights, their weighted sum. Jaccard divides the common neighbors
+ *  by the degrees afterwards. Self loops and entries out of the graph get 0.
+ */
+template <typename KernelHandle, typename row_map_t, typename entries_t, typename similarity_view_t>
+void edge_similarity(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    row_map_t row_map,
+    entries_t entries,
+    EdgeSimilarity measure,
+    similarity_view_t similarity){
+
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::HandleTempMemorySpace MyTempMemorySpace;
+  typedef typename KernelHandle::nnz_lno_temp_work_view_t degree_view_t;
+  typedef typename similarity_view_t::non_const_value_type similarity_t;
+  typedef Kokkos::View<similarity_t *, MyTempMemorySpace> weight_view_t;
+
+  if (m == 0) return;
+  if (measure == SIMILARITY_COMMON_NEIGHBORS){
+    triangle_support(handle, m, row_map, entries, similarity, similarity_view_t(), true, false);
+    return;
+  }
+
+  degree_view_t degree(Kokkos::ViewAllocateWithoutInitializing("valid degree"), m);
+  Kokkos::parallel_for("KokkosGraph::EdgeSimilarity::Degree", Kokkos::RangePolicy<MyExecSpace>(0, m),
+      ValidDegree<row_map_t, entries_t, degree_view_t>(m, row_map, entries, degree));
+  if (measure == SIMILARITY_JACCARD){
+    triangle_support(handle, m, row_map, entries, similarity, similarity_view_t(), true, false);
+    Kokkos::parallel_for("KokkosGraph::EdgeSimilarity::Jaccard", Kokkos::RangePolicy<MyExecSpace>(0, m),
+        JaccardFromCommon<row_map_t, entries_t, degree_view_t, similarity_view_t>(m, row_map, entries, degree, similarity));
+  }
+  else {
+    weight_view_t inverse_log_degree(Kokkos::ViewAllocateWithoutInitializing("inverse log degree"), m);
+    Kokkos::parallel_for("KokkosGraph::EdgeSimilarity::InverseLogDegree", Kokkos::RangePolicy<MyExecSpace>(0, m),
+        InverseLogDegree<degree_view_t, weight_view_t>(degree, inverse_log_degree));
+    triangle_support(handle, m, row_map, entries, similarity, similarity_view_t(), true, false, false,
+        AdamicAdarWeight<weight_view_t>(inverse_log_degree));
+  }
+  MyExecSpace::fence();
+}
+
+}
+}
+}
+#endif
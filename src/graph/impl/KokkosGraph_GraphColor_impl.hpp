@@ -47,6 +47,7 @@
 #include <Kokkos_MemoryTraits.hpp>
 #include <vector>
 #include "KokkosGraph_GraphColorHandle.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
 
 #ifndef _KOKKOSCOLORINGIMP_HPP
 #define _KOKKOSCOLORINGIMP_HPP
@@ -59,6 +60,191 @@ namespace Impl{
 
 #define VB_COLORING_FORBIDDEN_SIZE 64
 #define VBBIT_COLORING_FORBIDDEN_SIZE 64
+/*! \brief Functor of the vertex priorities of the coloring orderings.
+ *  DegreeTag: the degree of each vertex, self loops and ghost vertices excluded.
+ *  MaxDegreeTag: the largest degree.
+ *  MinDegreeTag: the smallest degree of the vertices not peeled yet.
+ *  PeelTag: the vertices not peeled yet of degree at most threshold get the
+ *    priority round; counts them.
+ *  UpdateTag: the vertices of priority round decrement the degree of their
+ *    neighbors not peeled yet.
+ *  BucketTag: bucket(v) = max_priority - priority(v), for the worklist.
+ */
+template <typename row_view_t, typename adj_view_t, typename lno_view_t>
+struct ColoringPriorityFunctor{
+  typedef typename lno_view_t::non_const_value_type nnz_lno_t;
+  typedef typename row_view_t::non_const_value_type size_type;
+
+  struct DegreeTag{};
+  struct MaxDegreeTag{};
+  struct MinDegreeTag{};
+  struct PeelTag{};
+  struct UpdateTag{};
+  struct BucketTag{};
+
+  nnz_lno_t nv;
+  row_view_t xadj;
+  adj_view_t adj;
+  lno_view_t degree;
+  lno_view_t priority;
+  lno_view_t bucket;
+  nnz_lno_t threshold;
+  nnz_lno_t round;
+  nnz_lno_t max_priority;
+
+  ColoringPriorityFunctor(
+      nnz_lno_t nv_, row_view_t xadj_, adj_view_t adj_,
+      lno_view_t degree_, lno_view_t priority_, lno_view_t bucket_):
+        nv(nv_), xadj(xadj_), adj(adj_), degree(degree_), priority(priority_), bucket(bucket_),
+        threshold(0), round(0), max_priority(0){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const DegreeTag&, const nnz_lno_t &v) const {
+    nnz_lno_t d = 0;
+    for (size_type k = xadj(v); k < xadj(v + 1); ++k){
+      const nnz_lno_t u = adj(k);
+      if (u != v && u < nv) ++d;
+    }
+    degree(v) = d;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const MaxDegreeTag&, const nnz_lno_t &v, nnz_lno_t &max_degree) const {
+    if (degree(v) > max_degree) max_degree = degree(v);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const MinDegreeTag&, const nnz_lno_t &v, nnz_lno_t &min_degree) const {
+    if (priority(v) < 0 && degree(v) < min_degree) min_degree = degree(v);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const PeelTag&, const nnz_lno_t &v, nnz_lno_t &num_peeled) const {
+    if (priority(v) < 0 && degree(v) <= threshold){
+      priority(v) = round;
+      ++num_peeled;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const UpdateTag&, const nnz_lno_t &v) const {
+    if (priority(v) != round) return;
+    for (size_type k = xadj(v); k < xadj(v + 1); ++k){
+      const nnz_lno_t u = adj(k);
+      if (u != v && u < nv && priority(u) < 0) Kokkos::atomic_add(&degree(u), nnz_lno_t(-1));
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const BucketTag&, const nnz_lno_t &v) const {
+    bucket(v) = max_priority - priority(v);
+  }
+};
+
+/*! \brief Computes the priorities of the vertices for a coloring ordering;
+ *  the vertices of larger priority are colored first.
+ *  COLORING_ORDER_LARGEST_FIRST: the priority is the degree.
+ *  COLORING_ORDER_SMALLEST_LAST: the vertices are peeled in rounds, each one
+ *    removing at once all the vertices whose degree in the remaining graph is
+ *    within a factor 1.5 of the smallest one, and the priority is the round.
+ *    Peeling a degree bucket instead of a single vertex keeps the number of
+ *    rounds small, at the cost of approximating the smallest-last order.
+ *  \return an empty view for COLORING_ORDER_NATURAL.
+ *  \param max_priority: the largest priority given.
+ */
+template <typename lno_view_t, typename MyExecSpace, typename row_view_t, typename adj_view_t>
+lno_view_t coloring_priorities(
+    const ColoringOrdering ordering,
+    const typename lno_view_t::non_const_value_type nv,
+    const row_view_t xadj,
+    const adj_view_t adj,
+    typename lno_view_t::non_const_value_type &max_priority){
+
+  typedef typename lno_view_t::non_const_value_type nnz_lno_t;
+  typedef ColoringPriorityFunctor<row_view_t, adj_view_t, lno_view_t> functor_t;
+
+  max_priority = 0;
+  if (ordering == COLORING_ORDER_NATURAL || nv == 0) return lno_view_t();
+
+  lno_view_t degree(Kokkos::ViewAllocateWithoutInitializing("coloring degree"), nv);
+  lno_view_t priority = degree;
+  if (ordering == COLORING_ORDER_SMALLEST_LAST){
+    priority = lno_view_t(Kokkos::ViewAllocateWithoutInitializing("coloring priority"), nv);
+    Kokkos::deep_copy(priority, nnz_lno_t(-1));
+  }
+  functor_t func(nv, xadj, adj, degree, priority, lno_view_t());
+  Kokkos::parallel_for("KokkosGraph::ColoringPriorities::Degree",
+      Kokkos::RangePolicy<typename functor_t::DegreeTag, MyExecSpace>(0, nv), func);
+
+  if (ordering == COLORING_ORDER_LARGEST_FIRST){
+    Kokkos::parallel_reduce("KokkosGraph::ColoringPriorities::MaxDegree",
+        Kokkos::RangePolicy<typename functor_t::MaxDegreeTag, MyExecSpace>(0, nv), func,
+        Kokkos::Max<nnz_lno_t>(max_priority));
+    return priority;
+  }
+
+  nnz_lno_t num_remaining = nv;
+  for (; num_remaining > 0; ++func.round){
+    nnz_lno_t min_degree = nv;
+    Kokkos::parallel_reduce("KokkosGraph::ColoringPriorities::MinDegree",
+        Kokkos::RangePolicy<typename functor_t::MinDegreeTag, MyExecSpace>(0, nv), func,
+        Kokkos::Min<nnz_lno_t>(min_degree));
+    func.threshold = min_degree + (min_degree / 2 > 0 ? min_degree / 2 : 1);
+    nnz_lno_t num_peeled = 0;
+    Kokkos::parallel_reduce("KokkosGraph::ColoringPriorities::Peel",
+        Kokkos::RangePolicy<typename functor_t::PeelTag, MyExecSpace>(0, nv), func, num_peeled);
+    Kokkos::parallel_for("KokkosGraph::ColoringPriorities::Update",
+        Kokkos::RangePolicy<typename functor_t::UpdateTag, MyExecSpace>(0, nv), func);
+    num_remaining -= num_peeled;
+  }
+  max_priority = func.round - 1;
+  return priority;
+}
+
+/*! \brief Fills vertexList with the vertices by decreasing priority, with a
+ *  counting sort of the priorities through the reverse map functor.
+ */
+template <typename lno_view_t, typename MyExecSpace>
+void coloring_order(
+    const typename lno_view_t::non_const_value_type nv,
+    const lno_view_t priority,
+    const typename lno_view_t::non_const_value_type max_priority,
+    lno_view_t vertexList){
+
+  typedef typename lno_view_t::non_const_value_type nnz_lno_t;
+  typedef ColoringPriorityFunctor<lno_view_t, lno_view_t, lno_view_t> functor_t;
+  typedef KokkosKernels::Impl::Reverse_Map_Functor<lno_view_t, lno_view_t> reverse_map_t;
+
+  lno_view_t bucket(Kokkos::ViewAllocateWithoutInitializing("coloring bucket"), nv);
+  lno_view_t bucket_xadj("coloring bucket xadj", max_priority + 2);
+  functor_t func(nv, lno_view_t(), lno_view_t(), lno_view_t(), priority, bucket);
+  func.max_priority = max_priority;
+  Kokkos::parallel_for("KokkosGraph::ColoringOrder::Bucket",
+      Kokkos::RangePolicy<typename functor_t::BucketTag, MyExecSpace>(0, nv), func);
+
+  reverse_map_t rmf(bucket, bucket_xadj, vertexList);
+  Kokkos::parallel_for("KokkosGraph::ColoringOrder::Count",
+      Kokkos::RangePolicy<typename reverse_map_t::CountTag, MyExecSpace>(0, nv), rmf);
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<lno_view_t, MyExecSpace>(max_priority + 2, bucket_xadj);
+  Kokkos::parallel_for("KokkosGraph::ColoringOrder::Fill",
+      Kokkos::RangePolicy<typename reverse_map_t::FillTag, MyExecSpace>(0, nv), rmf);
+  MyExecSpace::fence();
+}
+
+/*! \brief True if v gives up its color on a conflict with its neighbor u:
+ *  the vertex of lower priority loses, the lower index if the priorities are
+ *  equal. Without priorities the index alone decides.
+ */
+template <typename lno_view_t>
+KOKKOS_INLINE_FUNCTION
+bool coloring_conflict_loser(
+    const lno_view_t &priority,
+    const typename lno_view_t::non_const_value_type v,
+    const typename lno_view_t::non_const_value_type u){
+  if (priority.extent(0) == 0) return v < u;
+  return priority(v) < priority(u) || (priority(v) == priority(u) && v < u);
+}
+
 /*! \brief Base class for graph coloring purposes.
  *  Each color represents the set of the vertices that are independent,
  *  e.g. no vertex having same color shares an edge.
@@ -798,6 +984,7 @@ protected:
                         // 2: for VBBIT
 
   int _max_num_iterations;
+  nnz_lno_temp_work_view_t _priority; //the priorities of the ordering of the handle, empty for the natural order.
 
 public:
   /**
@@ -822,7 +1009,8 @@ public:
     _edge_filtering(coloring_handle->get_vb_edge_filtering()),
     _chunkSize(coloring_handle->get_vb_chunk_size()),
     _use_color_set(),
-    _max_num_iterations(coloring_handle->get_max_number_of_iterations())
+    _max_num_iterations(coloring_handle->get_max_number_of_iterations()),
+    _priority()
     {
       switch (coloring_handle->get_coloring_algo_type()){
       case COLORING_VB:
@@ -883,6 +1071,79 @@ public:
           << "\tchunkSize:" << this->_chunkSize << std::endl;
     }
 
+    //the conflictlist
+    nnz_lno_temp_work_view_t current_vertexList =
+        nnz_lno_temp_work_view_t(Kokkos::ViewAllocateWithoutInitializing("vertexList"), this->nv);
+
+    //init vertexList in the order of the handle, sequentially by default.
+    //the conflicts are resolved in favor of the vertices of larger priority too.
+    nnz_lno_t max_priority = 0;
+    this->_priority = coloring_priorities<nnz_lno_temp_work_view_t, MyExecSpace>(
+        this->cp->get_coloring_ordering(), this->nv, this->xadj, this->adj, max_priority);
+    if (this->_priority.extent(0) > 0){
+      coloring_order<nnz_lno_temp_work_view_t, MyExecSpace>(this->nv, this->_priority, max_priority, current_vertexList);
+    }
+    else {
+      Kokkos::parallel_for("KokkosGraph::GraphColoring::InitList",
+          my_exec_space(0, this->nv), functorInitList<nnz_lno_temp_work_view_t> (current_vertexList));
+    }
+
+    this->color_vertex_list(colors, current_vertexList, this->nv, num_loops);
+  }    // color_graph (end)
+
+
+  /** \brief Recolors the given vertices, keeping the colors of all the others.
+   * Used after a local change of the graph: the vertices whose adjacency changed
+   * (the end points of every added edge, and the new vertices) are uncolored and
+   * go through the speculative coloring and conflict resolution again.
+   * \param colors: the colors of the previous coloring, size this->nv. The vertices
+   *   of the list are overwritten, the others are kept as they are.
+   * \param vertexList: the distinct vertices to recolor.
+   * \param vertexListLength: the size of vertexList, at most this->nv.
+   * \param num_loops: The number of iterations (phases) that algorithm takes to converge.
+   */
+  void recolor_graph(
+      color_view_type colors,
+      nnz_lno_temp_work_view_t vertexList,
+      nnz_lno_t vertexListLength,
+      int &num_loops){
+
+    //VBCS keeps the colors in its own encoding, and the no-conflictlist
+    //kernels go over all the vertices; both are replaced by the VB defaults.
+    if (this->_use_color_set == 1) this->_use_color_set = 0;
+    if (this->_conflictlist == 0) this->_conflictlist = 1;
+    this->_priority = nnz_lno_temp_work_view_t();
+
+    //the vertices of the list are fixed by nothing.
+    Kokkos::parallel_for("KokkosGraph::GraphColoring::UncolorList",
+        my_exec_space(0, vertexListLength), functorUncolorList<nnz_lno_temp_work_view_t> (vertexList, colors));
+
+    //the conflictlist is consumed by the coloring, so it works on a copy.
+    nnz_lno_temp_work_view_t current_vertexList =
+        nnz_lno_temp_work_view_t(Kokkos::ViewAllocateWithoutInitializing("vertexList"), this->nv);
+    Kokkos::deep_copy(
+        Kokkos::subview(current_vertexList, Kokkos::make_pair(nnz_lno_t(0), vertexListLength)),
+        Kokkos::subview(vertexList, Kokkos::make_pair(nnz_lno_t(0), vertexListLength)));
+
+    this->color_vertex_list(colors, current_vertexList, vertexListLength, num_loops);
+  }    // recolor_graph (end)
+
+
+protected:
+  /** \brief Colors the uncolored vertices of a list with speculative coloring and conflict
+   *  resolution rounds. The vertices out of the list must be colored already.
+   *  \param colors: colors corresponding to each vertex
+   *  \param current_vertexList: the vertices to color, it is overwritten by the conflictlists.
+   *    Its size must be this->nv.
+   *  \param current_vertexListLength: number of vertices in current_vertexList
+   *  \param num_loops: The number of iterations (phases) that algorithm takes to converge.
+   */
+  void color_vertex_list(
+      color_view_type colors,
+      nnz_lno_temp_work_view_t current_vertexList,
+      nnz_lno_t current_vertexListLength,
+      int &num_loops){
+
     //if the edge filtering is selected, then we do swaps on the adj array.
     //to not to touch the given one, we copy the adj array.
     nnz_lno_temp_work_view_t adj_copy;
@@ -900,15 +1161,6 @@ public:
       vertex_color_set = nnz_lno_temp_work_view_t("colorset", this->nv);
     }
 
-    //the conflictlist
-    nnz_lno_temp_work_view_t current_vertexList =
-        nnz_lno_temp_work_view_t(Kokkos::ViewAllocateWithoutInitializing("vertexList"), this->nv);
-
-    //init vertexList sequentially.
-    Kokkos::parallel_for("KokkosGraph::GraphColoring::InitList",
-        my_exec_space(0, this->nv), functorInitList<nnz_lno_temp_work_view_t> (current_vertexList));
-
-
     // the next iteration's conflict list
     nnz_lno_temp_work_view_t next_iteration_recolorList;
     // the size of the current conflictlist
@@ -929,8 +1181,7 @@ public:
       }
     }
 
-    nnz_lno_t numUncolored = this->nv;
-    nnz_lno_t current_vertexListLength = this->nv;
+    nnz_lno_t numUncolored = current_vertexListLength;
 
 
     double t, total=0.0;
@@ -1051,7 +1302,7 @@ public:
     	}
     }
     num_loops = iter;
-  }    // color_graph (end)
+  }    // color_vertex_list (end)
 
 
 private:
@@ -1206,25 +1457,25 @@ private:
     nnz_lno_t numUncolored = 0;
     if (this->_conflictlist == 0){
       if (this->_use_color_set == 0 || this->_use_color_set == 2){
-        functorFindConflicts_No_Conflist<adj_view_t> conf( this->nv, xadj_, adj_, vertex_colors_);
-        Kokkos::parallel_reduce(my_exec_space(0, current_vertexListLength_), conf, numUncolored);
+        functorFindConflicts_No_Conflist<adj_view_t> conf( this->nv, xadj_, adj_, vertex_colors_, this->_priority);
+        Kokkos::parallel_reduce("KokkosGraph::GraphColoring::FindConflicts", my_exec_space(0, current_vertexListLength_), conf, numUncolored);
       }
       else {
-        functorFindConflicts_No_Conflist_IMP<adj_view_t> conf(this->nv, xadj_, adj_,vertex_colors_, vertex_color_set_);
-        Kokkos::parallel_reduce(my_exec_space(0, current_vertexListLength_), conf, numUncolored);
+        functorFindConflicts_No_Conflist_IMP<adj_view_t> conf(this->nv, xadj_, adj_,vertex_colors_, vertex_color_set_, this->_priority);
+        Kokkos::parallel_reduce("KokkosGraph::GraphColoring::FindConflicts", my_exec_space(0, current_vertexListLength_), conf, numUncolored);
       }
     }
     else if (this->_conflictlist == 2){ //IF PPS
       if (this->_use_color_set == 0 || this->_use_color_set == 2){
         // Check for conflicts. Compute numUncolored == numConflicts.
-        functorFindConflicts_PPS<adj_view_t> conf(this->nv, xadj_, adj_,vertex_colors_,current_vertexList_,next_iteration_recolorList_);
-        Kokkos::parallel_reduce(my_exec_space(0, current_vertexListLength_), conf, numUncolored);
+        functorFindConflicts_PPS<adj_view_t> conf(this->nv, xadj_, adj_,vertex_colors_,current_vertexList_,next_iteration_recolorList_, this->_priority);
+        Kokkos::parallel_reduce("KokkosGraph::GraphColoring::FindConflictsPPS", my_exec_space(0, current_vertexListLength_), conf, numUncolored);
       }
       else {
         functorFindConflicts_PPS_IMP<adj_view_t> conf(this->nv,
             xadj_, adj_,vertex_colors_, vertex_color_set_,
-            current_vertexList_,next_iteration_recolorList_);
-        Kokkos::parallel_reduce(my_exec_space(0, current_vertexListLength_), conf, numUncolored);
+            current_vertexList_,next_iteration_recolorList_, this->_priority);
+        Kokkos::parallel_reduce("KokkosGraph::GraphColoring::FindConflictsPPS", my_exec_space(0, current_vertexListLength_), conf, numUncolored);
       }
 
 
@@ -1257,14 +1508,14 @@ private:
         // Check for conflicts. Compute numUncolored == numConflicts.
         functorFindConflicts_Atomic<adj_view_t> conf(this->nv,
             xadj_, adj_,vertex_colors_,current_vertexList_,
-            next_iteration_recolorList_, next_iteration_recolorListLength_);
+            next_iteration_recolorList_, next_iteration_recolorListLength_, this->_priority);
         Kokkos::parallel_reduce("KokkosGraph::GraphColoring::FindConflictsAtomic",
             my_exec_space(0, current_vertexListLength_), conf, numUncolored);
       }
       else {
         functorFindConflicts_Atomic_IMP<adj_view_t> conf(this->nv,
             xadj_, adj_,vertex_colors_, vertex_color_set_,
-            current_vertexList_,next_iteration_recolorList_, next_iteration_recolorListLength_);
+            current_vertexList_,next_iteration_recolorList_, next_iteration_recolorListLength_, this->_priority);
         Kokkos::parallel_reduce("KokkosGraph::GraphColoring::FindConflictsAtomic_IMP",
             my_exec_space(0, current_vertexListLength_), conf, numUncolored);
       }
@@ -1894,13 +2145,15 @@ public:
     const_lno_row_view_t _idx;
     adj_view_t _adj;
     color_view_type _colors;
+    nnz_lno_temp_work_view_t _priority;
 
     functorFindConflicts_No_Conflist(
         nnz_lno_t nv_,
         const_lno_row_view_t xadj_,
 		adj_view_t adj_,
-        color_view_type colors) : nv (nv_),
-          _idx(xadj_), _adj(adj_),_colors(colors)
+        color_view_type colors,
+        nnz_lno_temp_work_view_t priority) : nv (nv_),
+          _idx(xadj_), _adj(adj_),_colors(colors), _priority(priority)
     {
     }
 
@@ -1918,7 +2171,7 @@ public:
 
         if (
 #ifndef DEGREECOMP
-            ii < neighbor && neighbor < nv &&
+            neighbor < nv && coloring_conflict_loser(_priority, ii, neighbor) &&
 #endif
             _colors(neighbor) == my_color
 #ifdef DEGREECOMP
@@ -1947,6 +2200,7 @@ public:
     color_view_type _colors;
     nnz_lno_temp_work_view_t _vertexList;
     nnz_lno_temp_work_view_t _recolorList;
+    nnz_lno_temp_work_view_t _priority;
 
 
 
@@ -1956,11 +2210,13 @@ public:
 		adj_view_t adj_,
         color_view_type colors,
         nnz_lno_temp_work_view_t vertexList,
-        nnz_lno_temp_work_view_t recolorList) :
+        nnz_lno_temp_work_view_t recolorList,
+        nnz_lno_temp_work_view_t priority) :
           nv (nv_),
           _idx(xadj_), _adj(adj_), _colors(colors),
           _vertexList(vertexList),
-          _recolorList(recolorList){}
+          _recolorList(recolorList),
+          _priority(priority){}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const nnz_lno_t ii, nnz_lno_t &numConflicts) const {
@@ -1978,7 +2234,7 @@ public:
         nnz_lno_t neighbor = _adj(j);
         if (
 #ifndef DEGREECOMP
-            i < neighbor && neighbor < nv &&
+            neighbor < nv && coloring_conflict_loser(_priority, i, neighbor) &&
 #endif
             _colors(neighbor) == my_color
 #ifdef DEGREECOMP
@@ -2008,6 +2264,7 @@ public:
     nnz_lno_temp_work_view_t _vertexList;
     nnz_lno_temp_work_view_t _recolorList;
     single_dim_index_view_type _recolorListLength;
+    nnz_lno_temp_work_view_t _priority;
 
 
     functorFindConflicts_Atomic(
@@ -2017,12 +2274,14 @@ public:
         color_view_type colors,
         nnz_lno_temp_work_view_t vertexList,
         nnz_lno_temp_work_view_t recolorList,
-        single_dim_index_view_type recolorListLength
+        single_dim_index_view_type recolorListLength,
+        nnz_lno_temp_work_view_t priority
     ) : nv (nv_),
       _idx(xadj_), _adj(adj_), _colors(colors),
       _vertexList(vertexList),
       _recolorList(recolorList),
-      _recolorListLength(recolorListLength){}
+      _recolorListLength(recolorListLength),
+      _priority(priority){}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const nnz_lno_t ii, nnz_lno_t &numConflicts) const {
@@ -2041,7 +2300,7 @@ public:
         nnz_lno_t neighbor = _adj(j);
         if (
 #ifndef DEGREECOMP
-            i < neighbor && neighbor < nv &&
+            neighbor < nv && coloring_conflict_loser(_priority, i, neighbor) &&
 #endif
             _colors(neighbor) == my_color
 #ifdef DEGREECOMP
@@ -2073,6 +2332,7 @@ public:
     adj_view_t _adj;
     color_view_type _colors;
     nnz_lno_temp_work_view_t _color_sets;
+    nnz_lno_temp_work_view_t _priority;
 
 
     functorFindConflicts_No_Conflist_IMP(
@@ -2080,9 +2340,10 @@ public:
         const_lno_row_view_t xadj_,
 		adj_view_t adj_,
         color_view_type colors,
-        nnz_lno_temp_work_view_t color_sets
+        nnz_lno_temp_work_view_t color_sets,
+        nnz_lno_temp_work_view_t priority
     ) : nv (nv_),
-      _xadj(xadj_), _adj(adj_), _colors(colors), _color_sets(color_sets){}
+      _xadj(xadj_), _adj(adj_), _colors(colors), _color_sets(color_sets), _priority(priority){}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const nnz_lno_t ii, nnz_lno_t &numConflicts) const {
@@ -2105,7 +2366,7 @@ public:
           nnz_lno_t neighbor = _adj(j);
           if (
 #ifndef DEGREECOMP
-              ii < neighbor && neighbor < nv &&
+              neighbor < nv && coloring_conflict_loser(_priority, ii, neighbor) &&
 #endif
               _colors(neighbor) == my_color && my_color_set == _color_sets(neighbor)
 #ifdef DEGREECOMP
@@ -2137,6 +2398,7 @@ public:
     nnz_lno_temp_work_view_t _color_sets;
     nnz_lno_temp_work_view_t _vertexList;
     nnz_lno_temp_work_view_t _recolorList;
+    nnz_lno_temp_work_view_t _priority;
 
     functorFindConflicts_PPS_IMP(
         nnz_lno_t nv_,
@@ -2145,11 +2407,13 @@ public:
         color_view_type colors,
         nnz_lno_temp_work_view_t color_sets,
         nnz_lno_temp_work_view_t vertexList,
-        nnz_lno_temp_work_view_t recolorList
+        nnz_lno_temp_work_view_t recolorList,
+        nnz_lno_temp_work_view_t priority
     ) : nv (nv_),
       _xadj(xadj_), _adj(adj_), _colors(colors), _color_sets(color_sets),
       _vertexList(vertexList),
-      _recolorList(recolorList){}
+      _recolorList(recolorList),
+      _priority(priority){}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const nnz_lno_t ii, nnz_lno_t &numConflicts) const {
@@ -2173,7 +2437,7 @@ public:
           nnz_lno_t neighbor = _adj(j);
           if (
 #ifndef DEGREECOMP
-              i < neighbor && neighbor < nv &&
+              neighbor < nv && coloring_conflict_loser(_priority, i, neighbor) &&
 #endif
               _colors(neighbor) == my_color && my_color_set == _color_sets(neighbor)
 #ifdef DEGREECOMP
@@ -2207,6 +2471,7 @@ public:
     nnz_lno_temp_work_view_t _vertexList;
     nnz_lno_temp_work_view_t _recolorList;
     single_dim_index_view_type _recolorListLength;
+    nnz_lno_temp_work_view_t _priority;
 
 
     functorFindConflicts_Atomic_IMP(
@@ -2217,12 +2482,14 @@ public:
         nnz_lno_temp_work_view_t color_sets,
         nnz_lno_temp_work_view_t vertexList,
         nnz_lno_temp_work_view_t recolorList,
-        single_dim_index_view_type recolorListLength
+        single_dim_index_view_type recolorListLength,
+        nnz_lno_temp_work_view_t priority
     ) : nv (nv_),
       _xadj(xadj_), _adj(adj_), _colors(colors), _color_sets(color_sets),
       _vertexList(vertexList),
       _recolorList(recolorList),
-      _recolorListLength(recolorListLength){}
+      _recolorListLength(recolorListLength),
+      _priority(priority){}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const nnz_lno_t ii, nnz_lno_t &numConflicts) const {
@@ -2248,7 +2515,7 @@ public:
           nnz_lno_t neighbor = _adj(j);
           if (
 #ifndef DEGREECOMP
-              i < neighbor && neighbor < nv &&
+              neighbor < nv && coloring_conflict_loser(_priority, i, neighbor) &&
 #endif
               _colors(neighbor) == my_color && my_color_set == _color_sets(neighbor)
 #ifdef DEGREECOMP
@@ -2284,6 +2551,20 @@ public:
     }
   };
 
+  /**
+   * Functor to uncolor the vertices of a list, that is colors[list[i]] = 0
+   */
+  template <typename view_type>
+  struct functorUncolorList{
+    view_type _vertexList;
+    color_view_type _colors;
+    functorUncolorList (view_type vertexList, color_view_type colors) : _vertexList(vertexList), _colors(colors) { }
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t i) const {
+      _colors(_vertexList(i)) = 0;
+    }
+  };
+
 
   /**
    * Functor for parallel prefix sum
@@ -3272,6 +3553,228 @@ public:
   };
 };
 
+
+/*! \brief Class for the Jones-Plassmann-Luby graph coloring.
+ * Each vertex gets a pseudo random priority from a hash of its index. In a
+ * round, every uncolored vertex whose priority is the largest among its
+ * uncolored neighbors takes the smallest color not used by its neighbors.
+ * These vertices form an independent set, so there are no conflicts to
+ * resolve, and a round is a single kernel that reads the colors of the
+ * previous round and writes the new ones. The rounds stop when all the
+ * vertices are colored; there are at most as many rounds as the longest
+ * path of increasing priorities, which for random priorities grows like
+ * log(nv) on bounded degree graphs. The graph must be symmetric.
+ * With a largest-first or smallest-last ordering in the handle, the priority
+ * of the ordering comes first and the pseudo random one breaks the ties.
+ */
+template <typename HandleType, typename lno_row_view_t_, typename lno_nnz_view_t_>
+class GraphColor_JPL:public GraphColor <HandleType,lno_row_view_t_,lno_nnz_view_t_>{
+public:
+
+  typedef lno_row_view_t_ in_lno_row_view_t;
+  typedef lno_nnz_view_t_ in_lno_nnz_view_t;
+  typedef typename HandleType::color_view_t color_view_type;
+
+  typedef typename HandleType::size_type size_type;
+  typedef typename HandleType::nnz_lno_t nnz_lno_t;
+  typedef typename HandleType::color_t color_t;
+  typedef typename HandleType::nnz_lno_temp_work_view_t nnz_lno_temp_work_view_t;
+
+  typedef typename HandleType::HandleExecSpace MyExecSpace;
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+
+  typedef typename in_lno_row_view_t::const_type const_lno_row_view_t;
+  typedef typename lno_nnz_view_t_::const_type const_lno_nnz_view_t;
+
+  /**
+   * \brief GraphColor_JPL constructor.
+   * \param nv_ number of vertices in the graph
+   * \param ne_ number of edges in the graph
+   * \param row_map the xadj array of the graph. Its size is nv_ +1
+   * \param entries adjacency array of the graph. Its size is ne_
+   * \param coloring_handle GraphColoringHandle object that holds the specification about the graph coloring.
+   */
+  GraphColor_JPL(
+      nnz_lno_t nv_,
+      size_type ne_,
+      const_lno_row_view_t row_map,
+      const_lno_nnz_view_t entries,
+      HandleType *coloring_handle):
+        GraphColor<HandleType,lno_row_view_t_,lno_nnz_view_t_>(nv_, ne_, row_map, entries, coloring_handle){}
+
+  virtual ~GraphColor_JPL(){}
+
+  /** \brief Function to color the vertices of the graphs.
+   * \param colors is the output array corresponding the color of each vertex. Size is this->nv.
+   *   Vertices with a positive color on input keep it.
+   * \param num_phases is the output for the number of rounds.
+   */
+  virtual void color_graph(
+      color_view_type colors,
+      int &num_phases){
+
+    color_view_type colors_in = colors;
+    color_view_type colors_out (Kokkos::ViewAllocateWithoutInitializing("JPL colors"), this->nv);
+
+    nnz_lno_t max_priority = 0;
+    nnz_lno_temp_work_view_t priority = coloring_priorities<nnz_lno_temp_work_view_t, MyExecSpace>(
+        this->cp->get_coloring_ordering(), this->nv, this->xadj, this->adj, max_priority);
+
+    num_phases = 0;
+    nnz_lno_t num_uncolored = this->nv;
+    while (num_uncolored > 0){
+      num_uncolored = 0;
+      Kokkos::parallel_reduce("KokkosGraph::GraphColor_JPL::round", my_exec_space(0, this->nv),
+          functorJPLRound(this->nv, this->xadj, this->adj, colors_in, colors_out, priority), num_uncolored);
+      MyExecSpace::fence();
+      color_view_type tmp = colors_in;
+      colors_in = colors_out;
+      colors_out = tmp;
+      ++num_phases;
+    }
+    if (colors_in.data() != colors.data()){
+      Kokkos::deep_copy(colors, colors_in);
+      MyExecSpace::fence();
+    }
+  }
+
+  /**
+   * \brief Functor for a round of the JPL coloring. Colors the uncolored
+   * vertices that have the largest priority among their uncolored
+   * neighbors, and counts the vertices left uncolored.
+   */
+  struct functorJPLRound{
+    nnz_lno_t nv;
+    const_lno_row_view_t _xadj;
+    const_lno_nnz_view_t _adj;
+    color_view_type _colors_in;
+    color_view_type _colors_out;
+    nnz_lno_temp_work_view_t _priority;
+
+    functorJPLRound(
+        nnz_lno_t nv_,
+        const_lno_row_view_t xadj_,
+        const_lno_nnz_view_t adj_,
+        color_view_type colors_in_,
+        color_view_type colors_out_,
+        nnz_lno_temp_work_view_t priority_):
+          nv(nv_), _xadj(xadj_), _adj(adj_), _colors_in(colors_in_), _colors_out(colors_out_),
+          _priority(priority_){}
+
+    //pseudo random priority of a vertex.
+    KOKKOS_INLINE_FUNCTION
+    static unsigned int priority(nnz_lno_t v){
+      unsigned int h = static_cast<unsigned int>(v) * 2654435761u;
+      h ^= h >> 16;
+      h *= 0x45d9f3bu;
+      h ^= h >> 16;
+      return h;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v, nnz_lno_t &num_uncolored) const {
+      const color_t my_color = _colors_in(v);
+      if (my_color > 0){
+        _colors_out(v) = my_color;
+        return;
+      }
+      const size_type v_begin = _xadj(v);
+      const size_type v_end = _xadj(v + 1);
+      const bool ordered = _priority.extent(0) > 0;
+      const nnz_lno_t my_order = ordered ? _priority(v) : nnz_lno_t(0);
+      const unsigned int my_priority = priority(v);
+      for (size_type k = v_begin; k < v_end; ++k){
+        const nnz_lno_t u = _adj(k);
+        if (u == v || u >= nv || _colors_in(u) > 0) continue;
+        const nnz_lno_t u_order = ordered ? _priority(u) : nnz_lno_t(0);
+        const unsigned int u_priority = priority(u);
+        if (u_order > my_order || (u_order == my_order &&
+            (u_priority > my_priority || (u_priority == my_priority && u > v)))){
+          _colors_out(v) = 0;
+          ++num_uncolored;
+          return;
+        }
+      }
+      //the smallest color that no neighbor has, looked for 64 colors at a time.
+      for (color_t base = 1; ; base += 64){
+        unsigned long long used = 0;
+        for (size_type k = v_begin; k < v_end; ++k){
+          const nnz_lno_t u = _adj(k);
+          if (u >= nv) continue;
+          const color_t u_color = _colors_in(u);
+          if (u_color >= base && u_color < base + 64) used |= 1ULL << (u_color - base);
+        }
+        if (~used){
+          color_t offset = 0;
+          while ((used >> offset) & 1ULL) ++offset;
+          _colors_out(v) = base + offset;
+          return;
+        }
+      }
+    }
+  };
+};
+
+/**
+ * \brief Evens out the sizes of the color classes of a distance-1 coloring.
+ * Visits the vertices in order, and moves a vertex whose color has more than
+ * ceil(nv / num_colors) vertices to the smallest color below that size that
+ * none of its neighbors has. The moves are sequential, so the coloring stays
+ * valid and the number of colors does not change.
+ */
+template <typename HandleType, typename lno_row_view_t_, typename lno_nnz_view_t_>
+void balance_color_classes(
+    typename HandleType::nnz_lno_t nv,
+    lno_row_view_t_ row_map,
+    lno_nnz_view_t_ entries,
+    typename HandleType::color_view_t colors){
+  typedef typename HandleType::nnz_lno_t nnz_lno_t;
+  typedef typename HandleType::color_t color_t;
+  typedef typename HandleType::HandleExecSpace MyExecSpace;
+  typedef typename lno_row_view_t_::const_type const_lno_row_view_t;
+  typedef typename lno_nnz_view_t_::const_type const_lno_nnz_view_t;
+
+  if (nv == 0) return;
+  typename HandleType::color_host_view_t h_colors = Kokkos::create_mirror_view (colors);
+  typename const_lno_row_view_t::HostMirror h_xadj = Kokkos::create_mirror_view (row_map);
+  typename const_lno_nnz_view_t::HostMirror h_adj = Kokkos::create_mirror_view (entries);
+  Kokkos::deep_copy (h_colors, colors);
+  Kokkos::deep_copy (h_xadj, row_map);
+  Kokkos::deep_copy (h_adj, entries);
+  MyExecSpace::fence();
+
+  color_t num_colors = 0;
+  for (nnz_lno_t i = 0; i < nv; ++i){
+    if (h_colors(i) > num_colors) num_colors = h_colors(i);
+  }
+  std::vector<nnz_lno_t> class_size(num_colors + 1, 0);
+  for (nnz_lno_t i = 0; i < nv; ++i) ++class_size[h_colors(i)];
+  const nnz_lno_t target = (nv + num_colors - 1) / num_colors;
+
+  //banned[c] == i if a neighbor of i has color c.
+  std::vector<nnz_lno_t> banned(num_colors + 1, -1);
+  for (nnz_lno_t i = 0; i < nv; ++i){
+    const color_t my_color = h_colors(i);
+    if (my_color <= 0 || class_size[my_color] <= target) continue;
+    for (size_t k = h_xadj(i); k < size_t(h_xadj(i + 1)); ++k){
+      const nnz_lno_t u = h_adj(k);
+      if (u < nv) banned[h_colors(u)] = i;
+    }
+    color_t best = 0;
+    for (color_t c = 1; c <= num_colors; ++c){
+      if (banned[c] == i || class_size[c] >= target) continue;
+      if (best == 0 || class_size[c] < class_size[best]) best = c;
+    }
+    if (best > 0){
+      h_colors(i) = best;
+      --class_size[my_color];
+      ++class_size[best];
+    }
+  }
+  Kokkos::deep_copy (colors, h_colors);
+  MyExecSpace::fence();
+}
+
 }
 }
 
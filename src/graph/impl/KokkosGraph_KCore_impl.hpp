@@ -0,0 +1,247 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_KCORE_IMPL_HPP
+#define _KOKKOSGRAPH_KCORE_IMPL_HPP
+
+#include <algorithm>
+#include "KokkosKernels_Utils.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+namespace Impl{
+
+/*! \brief Parallel k-core decomposition by peeling.
+ *
+ * The level k starts at the smallest degree of the remaining vertices, and
+ * every remaining vertex of degree at most k is removed with coreness k. A
+ * removed vertex decrements the degree of its remaining neighbors with an atomic;
+ * the one decrement that brings a neighbor from k + 1 down to k puts it in the
+ * next frontier of the level, so each vertex is removed exactly once. The level
+ * ends when a frontier is empty.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_>
+class KCore{
+public:
+  typedef typename lno_row_view_t_::const_type const_lno_row_view_t;
+  typedef typename lno_nnz_view_t_::const_type const_lno_nnz_view_t;
+  typedef typename lno_row_view_t_::non_const_value_type size_type;
+  typedef typename lno_nnz_view_t_::non_const_value_type nnz_lno_t;
+  typedef typename lno_nnz_view_t_::device_type device_type;
+  typedef typename device_type::execution_space MyExecSpace;
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef Kokkos::View<nnz_lno_t *, device_type> nnz_lno_temp_work_view_t;
+  typedef Kokkos::View<nnz_lno_t, device_type> single_dim_index_view_type;
+
+private:
+  nnz_lno_t num_verts;
+  const_lno_row_view_t xadj;
+  const_lno_nnz_view_t adj;
+
+  nnz_lno_temp_work_view_t degree;
+  nnz_lno_temp_work_view_t core;      //-1 while the vertex remains
+  nnz_lno_temp_work_view_t frontier;
+  nnz_lno_temp_work_view_t next_frontier;
+  single_dim_index_view_type next_size;
+
+public:
+  /**
+   * \brief KCore constructor.
+   * \param nv_: number of vertices in the graph.
+   * \param row_map: the xadj array of the graph. Its size is nv_ + 1.
+   * \param entries: adjacency array of the graph. Self loops and entries
+   *   not in [0, nv_) are ignored.
+   */
+  KCore (nnz_lno_t nv_, const_lno_row_view_t row_map, const_lno_nnz_view_t entries):
+    num_verts(nv_), xadj(row_map), adj(entries),
+    degree(Kokkos::ViewAllocateWithoutInitializing("k-core degree"), nv_),
+    core(Kokkos::ViewAllocateWithoutInitializing("k-core coreness"), nv_),
+    frontier(Kokkos::ViewAllocateWithoutInitializing("k-core frontier"), nv_),
+    next_frontier(Kokkos::ViewAllocateWithoutInitializing("k-core next frontier"), nv_),
+    next_size("k-core next frontier size"){}
+
+  struct InitDegree{
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t degree;
+    nnz_lno_temp_work_view_t core;
+    InitDegree(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t degree_, nnz_lno_temp_work_view_t core_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), degree(degree_), core(core_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      nnz_lno_t d = 0;
+      for (size_type j = xadj(i); j < xadj(i + 1); ++j){
+        const nnz_lno_t n = adj(j);
+        if (n != i && n >= 0 && n < num_verts) ++d;
+      }
+      degree(i) = d;
+      core(i) = -1;
+    }
+  };
+
+  //the smallest degree of the remaining vertices, the identity of Min if there are none.
+  struct MinDegree{
+    nnz_lno_temp_work_view_t degree;
+    nnz_lno_temp_work_view_t core;
+    MinDegree(nnz_lno_temp_work_view_t degree_, nnz_lno_temp_work_view_t core_):
+      degree(degree_), core(core_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i, nnz_lno_t &min_degree) const{
+      if (core(i) < 0 && degree(i) < min_degree) min_degree = degree(i);
+    }
+  };
+
+  //removes the remaining vertices of degree at most k: the first frontier of the level.
+  struct Collect{
+    nnz_lno_temp_work_view_t degree;
+    nnz_lno_temp_work_view_t core;
+    nnz_lno_temp_work_view_t frontier;
+    single_dim_index_view_type frontier_size;
+    nnz_lno_t k;
+    Collect(nnz_lno_temp_work_view_t degree_, nnz_lno_temp_work_view_t core_,
+        nnz_lno_temp_work_view_t frontier_, single_dim_index_view_type frontier_size_, nnz_lno_t k_):
+      degree(degree_), core(core_), frontier(frontier_), frontier_size(frontier_size_), k(k_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      if (core(i) >= 0 || degree(i) > k) return;
+      core(i) = k;
+      frontier(Kokkos::atomic_fetch_add(&frontier_size(), nnz_lno_t(1))) = i;
+    }
+  };
+
+  //the frontier decrements its remaining neighbors, and removes those that reach k.
+  struct Peel{
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t degree;
+    nnz_lno_temp_work_view_t core;
+    nnz_lno_temp_work_view_t frontier;
+    nnz_lno_temp_work_view_t next_frontier;
+    single_dim_index_view_type next_size;
+    nnz_lno_t k;
+    Peel(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t degree_, nnz_lno_temp_work_view_t core_,
+        nnz_lno_temp_work_view_t frontier_, nnz_lno_temp_work_view_t next_frontier_,
+        single_dim_index_view_type next_size_, nnz_lno_t k_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), degree(degree_), core(core_),
+      frontier(frontier_), next_frontier(next_frontier_), next_size(next_size_), k(k_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &f) const{
+      const nnz_lno_t i = frontier(f);
+      for (size_type j = xadj(i); j < xadj(i + 1); ++j){
+        const nnz_lno_t n = adj(j);
+        if (n == i || n < 0 || n >= num_verts || core(n) >= 0) continue;
+        if (Kokkos::atomic_fetch_add(&degree(n), nnz_lno_t(-1)) == k + 1){
+          core(n) = k;
+          next_frontier(Kokkos::atomic_fetch_add(&next_size(), nnz_lno_t(1))) = n;
+        }
+      }
+    }
+  };
+
+  template <typename core_view_t>
+  struct WriteCoreness{
+    nnz_lno_temp_work_view_t core;
+    core_view_t coreness;
+    WriteCoreness(nnz_lno_temp_work_view_t core_, core_view_t coreness_): core(core_), coreness(coreness_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      coreness(i) = core(i);
+    }
+  };
+
+  /**
+   * \brief Computes the coreness of every vertex.
+   * \param coreness: output, the largest k such that the vertex is in the k-core.
+   * \return the largest coreness, the degeneracy of the graph.
+   */
+  template <typename core_view_t>
+  nnz_lno_t kcore(core_view_t coreness){
+    if (num_verts == 0) return 0;
+    Kokkos::parallel_for("KokkosGraph::KCore::InitDegree", my_exec_space(0, num_verts),
+        InitDegree(num_verts, xadj, adj, degree, core));
+
+    nnz_lno_t k = 0;
+    while (true){
+      nnz_lno_t min_degree = 0;
+      Kokkos::parallel_reduce("KokkosGraph::KCore::MinDegree", my_exec_space(0, num_verts),
+          MinDegree(degree, core), Kokkos::Min<nnz_lno_t>(min_degree));
+      if (min_degree == Kokkos::reduction_identity<nnz_lno_t>::min()) break;
+      if (min_degree > k) k = min_degree;
+
+      Kokkos::deep_copy(next_size, nnz_lno_t(0));
+      Kokkos::parallel_for("KokkosGraph::KCore::Collect", my_exec_space(0, num_verts),
+          Collect(degree, core, next_frontier, next_size, k));
+      nnz_lno_t frontier_size = 0;
+      Kokkos::deep_copy(frontier_size, next_size);
+      while (frontier_size > 0){
+        std::swap(frontier, next_frontier);
+        Kokkos::deep_copy(next_size, nnz_lno_t(0));
+        Kokkos::parallel_for("KokkosGraph::KCore::Peel", my_exec_space(0, frontier_size),
+            Peel(num_verts, xadj, adj, degree, core, frontier, next_frontier, next_size, k));
+        Kokkos::deep_copy(frontier_size, next_size);
+      }
+      ++k;
+    }
+
+    Kokkos::parallel_for("KokkosGraph::KCore::WriteCoreness", my_exec_space(0, num_verts),
+        WriteCoreness<core_view_t>(core, coreness));
+    MyExecSpace::fence();
+    return k - 1;
+  }
+};
+
+}
+}
+}
+
+#endif
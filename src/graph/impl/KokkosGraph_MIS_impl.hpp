@@ -0,0 +1,325 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_MIS_IMPL_HPP
+#define _KOKKOSGRAPH_MIS_IMPL_HPP
+
+#include "KokkosKernels_Utils.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+namespace Impl{
+
+/*! \brief Luby style distance-1 and distance-2 maximal independent sets.
+ *
+ * In every round each undecided vertex gets a priority, a bijective hash of its
+ * id and the round, so the priorities are distinct and the result does not
+ * depend on the execution space. A round has two passes. The first computes, for
+ * every vertex w, the largest priority of an undecided vertex of N[w] (w and
+ * its neighbors), or notes that N[w] has a vertex in the set. The second merges
+ * these over N[v] for MIS-2, or takes the one of v for MIS-1. An undecided
+ * vertex leaves if the merge saw a set vertex, and joins if its own priority is
+ * the largest. Each pass only writes the entries of its own vertex.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_>
+class MIS{
+public:
+  typedef typename lno_row_view_t_::const_type const_lno_row_view_t;
+  typedef typename lno_nnz_view_t_::const_type const_lno_nnz_view_t;
+  typedef typename lno_row_view_t_::non_const_value_type size_type;
+  typedef typename lno_nnz_view_t_::non_const_value_type nnz_lno_t;
+  typedef typename lno_nnz_view_t_::device_type device_type;
+  typedef typename device_type::execution_space MyExecSpace;
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef Kokkos::View<nnz_lno_t *, device_type> nnz_lno_temp_work_view_t;
+  typedef unsigned long long priority_t;
+  typedef Kokkos::View<priority_t *, device_type> priority_view_t;
+
+  //vertex states.
+  static const nnz_lno_t UNDECIDED = 0;
+  static const nnz_lno_t IN_SET = 1;
+  static const nnz_lno_t OUT_SET = 2;
+
+private:
+  nnz_lno_t num_verts;
+  const_lno_row_view_t xadj;
+  const_lno_nnz_view_t adj;
+
+  nnz_lno_temp_work_view_t status;
+  nnz_lno_temp_work_view_t neighborhood_state;
+  priority_view_t neighborhood_max;
+
+public:
+  /**
+   * \brief MIS constructor.
+   * \param nv_: number of vertices in the graph.
+   * \param row_map: the xadj array of the graph. Its size is nv_ + 1.
+   * \param entries: adjacency array of the graph. Entries not in
+   *   [0, nv_) are ignored.
+   */
+  MIS (nnz_lno_t nv_, const_lno_row_view_t row_map, const_lno_nnz_view_t entries):
+    num_verts(nv_), xadj(row_map), adj(entries),
+    status("MIS status", nv_),
+    neighborhood_state(Kokkos::ViewAllocateWithoutInitializing("MIS neighborhood state"), nv_),
+    neighborhood_max(Kokkos::ViewAllocateWithoutInitializing("MIS neighborhood max"), nv_){}
+
+  //splitmix64 finalizer, a bijection on 64 bit words.
+  KOKKOS_INLINE_FUNCTION
+  static priority_t priority(nnz_lno_t v, int round){
+    priority_t x = priority_t(v) + priority_t(round + 1) * 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+
+  //neighborhood_state is IN_SET if N[w] has a set vertex, UNDECIDED if it has an
+  //undecided one, whose largest priority is in neighborhood_max, otherwise OUT_SET.
+  struct NeighborhoodMax{
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t status;
+    nnz_lno_temp_work_view_t neighborhood_state;
+    priority_view_t neighborhood_max;
+    int round;
+    NeighborhoodMax(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t status_, nnz_lno_temp_work_view_t neighborhood_state_,
+        priority_view_t neighborhood_max_, int round_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), status(status_),
+      neighborhood_state(neighborhood_state_), neighborhood_max(neighborhood_max_), round(round_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &w) const{
+      nnz_lno_t state = OUT_SET;
+      priority_t max_priority = 0;
+      const size_type end = xadj(w + 1);
+      for (size_type j = xadj(w); j <= end; ++j){
+        //the last iteration visits w itself.
+        const nnz_lno_t n = j < end ? adj(j) : w;
+        if (n < 0 || n >= num_verts) continue;
+        const nnz_lno_t s = status(n);
+        if (s == IN_SET){
+          state = IN_SET;
+          break;
+        }
+        if (s == UNDECIDED){
+          const priority_t p = priority(n, round);
+          if (state == OUT_SET || p > max_priority) max_priority = p;
+          state = UNDECIDED;
+        }
+      }
+      neighborhood_state(w) = state;
+      neighborhood_max(w) = max_priority;
+    }
+  };
+
+  //decides the undecided vertices, and counts those left.
+  struct Decide{
+    typedef nnz_lno_t value_type;
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t status;
+    nnz_lno_temp_work_view_t neighborhood_state;
+    priority_view_t neighborhood_max;
+    int round;
+    bool distance2;
+    Decide(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t status_, nnz_lno_temp_work_view_t neighborhood_state_,
+        priority_view_t neighborhood_max_, int round_, bool distance2_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), status(status_),
+      neighborhood_state(neighborhood_state_), neighborhood_max(neighborhood_max_),
+      round(round_), distance2(distance2_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v, nnz_lno_t &num_undecided) const{
+      if (status(v) != UNDECIDED) return;
+      bool saw_set = false;
+      priority_t max_priority = 0;
+      const size_type end = distance2 ? xadj(v + 1) : xadj(v);
+      for (size_type j = xadj(v); j <= end; ++j){
+        const nnz_lno_t w = j < end ? adj(j) : v;
+        if (w < 0 || w >= num_verts) continue;
+        const nnz_lno_t s = neighborhood_state(w);
+        if (s == IN_SET){
+          saw_set = true;
+          break;
+        }
+        if (s == UNDECIDED && neighborhood_max(w) > max_priority) max_priority = neighborhood_max(w);
+      }
+      if (saw_set) status(v) = OUT_SET;
+      //v is undecided, so max_priority is at least its own priority.
+      else if (max_priority == priority(v, round)) status(v) = IN_SET;
+      else ++num_undecided;
+    }
+  };
+
+  struct CountSet{
+    typedef nnz_lno_t value_type;
+    nnz_lno_temp_work_view_t status;
+    CountSet(nnz_lno_temp_work_view_t status_): status(status_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v, nnz_lno_t &num_in_set) const{
+      if (status(v) == IN_SET) ++num_in_set;
+    }
+  };
+
+  //writes the set vertices in increasing order, or their index in that order.
+  struct CompactSet{
+    typedef nnz_lno_t value_type;
+    nnz_lno_temp_work_view_t status;
+    nnz_lno_temp_work_view_t out;
+    bool write_index;
+    CompactSet(nnz_lno_temp_work_view_t status_, nnz_lno_temp_work_view_t out_, bool write_index_):
+      status(status_), out(out_), write_index(write_index_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v, nnz_lno_t &update, const bool final) const{
+      if (status(v) == IN_SET){
+        if (final){
+          if (write_index) out(v) = update;
+          else out(update) = v;
+        }
+        ++update;
+      }
+      else if (final && write_index) out(v) = -1;
+    }
+  };
+
+  //non-roots next to a root join the aggregate of the root with the smallest index.
+  struct AggregateNeighbors{
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t root_aggregates;
+    nnz_lno_temp_work_view_t aggregates;
+    AggregateNeighbors(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t root_aggregates_, nnz_lno_temp_work_view_t aggregates_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), root_aggregates(root_aggregates_), aggregates(aggregates_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v) const{
+      nnz_lno_t aggregate = root_aggregates(v);
+      if (aggregate == -1){
+        const size_type end = xadj(v + 1);
+        for (size_type j = xadj(v); j < end; ++j){
+          const nnz_lno_t n = adj(j);
+          if (n < 0 || n >= num_verts) continue;
+          const nnz_lno_t a = root_aggregates(n);
+          if (a != -1 && (aggregate == -1 || a < aggregate)) aggregate = a;
+        }
+      }
+      aggregates(v) = aggregate;
+    }
+  };
+
+public:
+  /**
+   * \brief Computes the set; status(v) is then IN_SET or OUT_SET.
+   * \param distance2: whether two vertices of the set must be at least 3 edges apart.
+   * \return the number of vertices in the set.
+   */
+  nnz_lno_t compute(bool distance2){
+    Kokkos::deep_copy(status, nnz_lno_t(UNDECIDED));
+    nnz_lno_t num_undecided = num_verts;
+    for (int round = 0; num_undecided > 0; ++round){
+      Kokkos::parallel_for("KokkosGraph::MIS::NeighborhoodMax", my_exec_space(0, num_verts),
+          NeighborhoodMax(num_verts, xadj, adj, status, neighborhood_state, neighborhood_max, round));
+      num_undecided = 0;
+      Kokkos::parallel_reduce("KokkosGraph::MIS::Decide", my_exec_space(0, num_verts),
+          Decide(num_verts, xadj, adj, status, neighborhood_state, neighborhood_max, round, distance2),
+          num_undecided);
+    }
+    nnz_lno_t num_in_set = 0;
+    Kokkos::parallel_reduce("KokkosGraph::MIS::CountSet", my_exec_space(0, num_verts),
+        CountSet(status), num_in_set);
+    return num_in_set;
+  }
+
+  /**
+   * \brief The vertices of the set in increasing order.
+   */
+  nnz_lno_temp_work_view_t set_list(nnz_lno_t num_in_set){
+    nnz_lno_temp_work_view_t list(Kokkos::ViewAllocateWithoutInitializing("MIS list"), num_in_set);
+    Kokkos::parallel_scan("KokkosGraph::MIS::CompactSet", my_exec_space(0, num_verts),
+        CompactSet(status, list, false));
+    MyExecSpace::fence();
+    return list;
+  }
+
+  /**
+   * \brief Aggregates around the roots of a distance-2 MIS.
+   *
+   * Root r of index i in increasing order is the center of aggregate i. A vertex
+   * next to roots joins the one with the smallest index. Every other vertex is
+   * then next to such a vertex, since the set is maximal at distance 2, and joins
+   * the smallest aggregate among its neighbors.
+   *
+   * \param aggregates: output, the aggregate of each vertex.
+   * \return the number of aggregates.
+   */
+  template <typename aggregate_view_t>
+  nnz_lno_t aggregate(aggregate_view_t aggregates){
+    const nnz_lno_t num_aggregates = compute(true);
+    nnz_lno_temp_work_view_t root_aggregates(Kokkos::ViewAllocateWithoutInitializing("MIS root aggregates"), num_verts);
+    Kokkos::parallel_scan("KokkosGraph::MIS::CompactSet", my_exec_space(0, num_verts),
+        CompactSet(status, root_aggregates, true));
+    //neighborhood_state is free once the set is computed.
+    nnz_lno_temp_work_view_t first_aggregates = neighborhood_state;
+    Kokkos::parallel_for("KokkosGraph::MIS::AggregateNeighbors", my_exec_space(0, num_verts),
+        AggregateNeighbors(num_verts, xadj, adj, root_aggregates, first_aggregates));
+    Kokkos::parallel_for("KokkosGraph::MIS::AggregateNeighbors", my_exec_space(0, num_verts),
+        AggregateNeighbors(num_verts, xadj, adj, first_aggregates, root_aggregates));
+    Kokkos::deep_copy(aggregates, root_aggregates);
+    MyExecSpace::fence();
+    return num_aggregates;
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,392 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_PAGERANK_IMPL_HPP
+#define _KOKKOSGRAPH_PAGERANK_IMPL_HPP
+
+#include <utility>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+namespace Impl{
+
+/*! \brief PageRank by power iteration.
+ *
+ * The edges u -> v of the graph are transposed once into the pull matrix P,
+ * whose row v has the value 1 / outdegree(u) for each u -> v, so that an
+ * iteration is y = teleport + damping * (P x + dangling / n), where dangling
+ * is the rank of the vertices without out edges, spread over all vertices.
+ * The spmv, the teleportation term, the change |y - x| and the dangling rank
+ * of y are computed by a single kernel.
+ * The worklist variant only recomputes the vertices with an in neighbor whose
+ * rank changed by more than the tolerance in the previous round.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_view_t_>
+class PageRank{
+public:
+  typedef typename lno_row_view_t_::const_type const_lno_row_view_t;
+  typedef typename lno_nnz_view_t_::const_type const_lno_nnz_view_t;
+  typedef typename lno_row_view_t_::non_const_value_type size_type;
+  typedef typename lno_nnz_view_t_::non_const_value_type nnz_lno_t;
+  typedef typename scalar_view_t_::non_const_value_type scalar_t;
+  typedef typename lno_nnz_view_t_::device_type device_type;
+  typedef typename device_type::execution_space MyExecSpace;
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef Kokkos::View<nnz_lno_t *, device_type> nnz_lno_temp_work_view_t;
+  typedef Kokkos::View<size_type *, device_type> row_lno_temp_work_view_t;
+  typedef Kokkos::View<scalar_t *, device_type> scalar_temp_work_view_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> KAT;
+
+private:
+  nnz_lno_t num_verts;
+  const_lno_row_view_t xadj;
+  const_lno_nnz_view_t adj;
+  scalar_t damping;
+
+  //the pull matrix, column normalized.
+  row_lno_temp_work_view_t t_xadj;
+  nnz_lno_temp_work_view_t t_adj;
+  scalar_temp_work_view_t t_values;
+
+  scalar_temp_work_view_t x;
+  scalar_temp_work_view_t y;
+
+public:
+  /**
+   * \brief PageRank constructor, builds the pull matrix.
+   * \param nv_: number of vertices in the graph.
+   * \param row_map: the xadj array of the graph. Its size is nv_ + 1.
+   * \param entries: adjacency array of the graph, the out edges of each vertex.
+   * \param damping_: the probability to follow an edge.
+   */
+  PageRank (nnz_lno_t nv_, const_lno_row_view_t row_map, const_lno_nnz_view_t entries, scalar_t damping_):
+    num_verts(nv_), xadj(row_map), adj(entries), damping(damping_),
+    t_xadj("PageRank pull row_map", nv_ + 1),
+    t_adj(Kokkos::ViewAllocateWithoutInitializing("PageRank pull entries"), entries.extent(0)),
+    t_values(Kokkos::ViewAllocateWithoutInitializing("PageRank pull values"), entries.extent(0)),
+    x(Kokkos::ViewAllocateWithoutInitializing("PageRank x"), nv_),
+    y(Kokkos::ViewAllocateWithoutInitializing("PageRank y"), nv_){
+    if (num_verts == 0) return;
+    KokkosKernels::Impl::kk_transpose_graph
+      <const_lno_row_view_t, const_lno_nnz_view_t, row_lno_temp_work_view_t, nnz_lno_temp_work_view_t,
+       row_lno_temp_work_view_t, MyExecSpace>
+      (num_verts, num_verts, xadj, adj, t_xadj, t_adj);
+    Kokkos::parallel_for("KokkosGraph::PageRank::Normalize", my_exec_space(0, t_adj.extent(0)),
+        Normalize(xadj, t_adj, t_values));
+  }
+
+  //value 1 / outdegree(u) for each entry u of the pull matrix.
+  struct Normalize{
+    const_lno_row_view_t xadj;
+    nnz_lno_temp_work_view_t t_adj;
+    scalar_temp_work_view_t t_values;
+    Normalize(const_lno_row_view_t xadj_, nnz_lno_temp_work_view_t t_adj_, scalar_temp_work_view_t t_values_):
+      xadj(xadj_), t_adj(t_adj_), t_values(t_values_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const size_type &k) const{
+      const nnz_lno_t u = t_adj(k);
+      t_values(k) = KAT::one() / scalar_t(xadj(u + 1) - xadj(u));
+    }
+  };
+
+  struct Initialize{
+    scalar_temp_work_view_t x;
+    scalar_t value;
+    Initialize(scalar_temp_work_view_t x_, scalar_t value_): x(x_), value(value_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v) const{
+      x(v) = value;
+    }
+  };
+
+  //rank of the vertices without out edges.
+  struct DanglingRank{
+    typedef scalar_t value_type;
+    const_lno_row_view_t xadj;
+    scalar_temp_work_view_t x;
+    DanglingRank(const_lno_row_view_t xadj_, scalar_temp_work_view_t x_): xadj(xadj_), x(x_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v, value_type &dangling) const{
+      if (xadj(v + 1) == xadj(v)) dangling += x(v);
+    }
+  };
+
+  struct StepStats{
+    //sum of |y - x|.
+    scalar_t change;
+    //dangling rank of y, or its change for the worklist.
+    scalar_t dangling;
+  };
+
+  //y(v) = teleport + damping * (P x + dangling / n)(v) for v = i, or v = worklist(i).
+  struct PowerStep{
+    typedef StepStats value_type;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    row_lno_temp_work_view_t t_xadj;
+    nnz_lno_temp_work_view_t t_adj;
+    scalar_temp_work_view_t t_values;
+    scalar_temp_work_view_t x;
+    scalar_temp_work_view_t y;
+    scalar_t teleport;
+    scalar_t damping;
+    scalar_t dangling_share;
+    //worklist mode: marks the out neighbors of the vertices that changed by more than tolerance.
+    nnz_lno_temp_work_view_t worklist;
+    nnz_lno_temp_work_view_t active;
+    bool use_worklist;
+    scalar_t tolerance;
+    PowerStep(const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        row_lno_temp_work_view_t t_xadj_, nnz_lno_temp_work_view_t t_adj_, scalar_temp_work_view_t t_values_,
+        scalar_temp_work_view_t x_, scalar_temp_work_view_t y_,
+        scalar_t teleport_, scalar_t damping_, scalar_t dangling_share_,
+        nnz_lno_temp_work_view_t worklist_, nnz_lno_temp_work_view_t active_, bool use_worklist_,
+        scalar_t tolerance_):
+      xadj(xadj_), adj(adj_), t_xadj(t_xadj_), t_adj(t_adj_), t_values(t_values_), x(x_), y(y_),
+      teleport(teleport_), damping(damping_), dangling_share(dangling_share_),
+      worklist(worklist_), active(active_), use_worklist(use_worklist_), tolerance(tolerance_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i, value_type &stats) const{
+      const nnz_lno_t v = use_worklist ? worklist(i) : i;
+      scalar_t sum = KAT::zero();
+      const size_type end = t_xadj(v + 1);
+      for (size_type j = t_xadj(v); j < end; ++j){
+        sum += t_values(j) * x(t_adj(j));
+      }
+      const scalar_t rank = teleport + damping * (sum + dangling_share);
+      y(v) = rank;
+      const scalar_t delta = rank - x(v);
+      stats.change += KAT::abs(delta);
+      const bool is_dangling = xadj(v + 1) == xadj(v);
+      if (!use_worklist){
+        if (is_dangling) stats.dangling += rank;
+        return;
+      }
+      if (is_dangling) stats.dangling += delta;
+      if (KAT::abs(delta) > tolerance){
+        const size_type out_end = xadj(v + 1);
+        for (size_type j = xadj(v); j < out_end; ++j){
+          active(adj(j)) = 1;
+        }
+      }
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void join (volatile value_type& dst, const volatile value_type& src) const {
+      dst.change += src.change;
+      dst.dangling += src.dangling;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void join (value_type& dst, const value_type& src) const {
+      dst.change += src.change;
+      dst.dangling += src.dangling;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void init (value_type& dst) const {
+      dst.change = KAT::zero();
+      dst.dangling = KAT::zero();
+    }
+  };
+
+  //x(v) = y(v) for the vertices of the worklist.
+  struct ApplyWorklist{
+    nnz_lno_temp_work_view_t worklist;
+    scalar_temp_work_view_t x;
+    scalar_temp_work_view_t y;
+    ApplyWorklist(nnz_lno_temp_work_view_t worklist_, scalar_temp_work_view_t x_, scalar_temp_work_view_t y_):
+      worklist(worklist_), x(x_), y(y_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      const nnz_lno_t v = worklist(i);
+      x(v) = y(v);
+    }
+  };
+
+  struct CountActive{
+    typedef nnz_lno_t value_type;
+    nnz_lno_temp_work_view_t active;
+    CountActive(nnz_lno_temp_work_view_t active_): active(active_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v, nnz_lno_t &count) const{
+      if (active(v)) ++count;
+    }
+  };
+
+  //compacts the marked vertices into the worklist, and clears the marks.
+  struct ActiveToWorklist{
+    typedef nnz_lno_t value_type;
+    nnz_lno_temp_work_view_t active;
+    nnz_lno_temp_work_view_t worklist;
+    ActiveToWorklist(nnz_lno_temp_work_view_t active_, nnz_lno_temp_work_view_t worklist_):
+      active(active_), worklist(worklist_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &v, nnz_lno_t &update, const bool final) const{
+      if (active(v)){
+        if (final){
+          worklist(update) = v;
+          active(v) = 0;
+        }
+        ++update;
+      }
+    }
+  };
+
+private:
+  scalar_t dangling_rank(){
+    scalar_t dangling = KAT::zero();
+    Kokkos::parallel_reduce("KokkosGraph::PageRank::DanglingRank", my_exec_space(0, num_verts),
+        DanglingRank(xadj, x), dangling);
+    return dangling;
+  }
+
+public:
+  /**
+   * \brief Power iteration from the uniform ranks, until the sum of the
+   * changes of an iteration is at most tolerance.
+   * \param ranks: output, the rank of each vertex.
+   * \return the number of iterations.
+   */
+  template <typename out_view_t>
+  int power_iteration(out_view_t ranks, scalar_t tolerance, int max_iterations){
+    if (num_verts == 0) return 0;
+    const scalar_t n = scalar_t(num_verts);
+    const scalar_t teleport = (KAT::one() - damping) / n;
+    Kokkos::parallel_for("KokkosGraph::PageRank::Initialize", my_exec_space(0, num_verts),
+        Initialize(x, KAT::one() / n));
+    scalar_t dangling = dangling_rank();
+
+    int iteration = 0;
+    while (iteration < max_iterations){
+      StepStats stats;
+      stats.change = KAT::zero();
+      stats.dangling = KAT::zero();
+      Kokkos::parallel_reduce("KokkosGraph::PageRank::PowerStep", my_exec_space(0, num_verts),
+          PowerStep(xadj, adj, t_xadj, t_adj, t_values, x, y, teleport, damping, dangling / n,
+              nnz_lno_temp_work_view_t(), nnz_lno_temp_work_view_t(), false, tolerance), stats);
+      std::swap(x, y);
+      dangling = stats.dangling;
+      ++iteration;
+      if (stats.change <= tolerance) break;
+    }
+    Kokkos::deep_copy(ranks, x);
+    MyExecSpace::fence();
+    return iteration;
+  }
+
+  /**
+   * \brief Worklist iteration from the uniform ranks: a round only recomputes
+   * the vertices with an in neighbor whose rank changed by more than
+   * tolerance in the previous round, and all the vertices if the dangling rank
+   * drifted by more than tolerance since the last round over all of them.
+   * It stops when no rank changes by more than tolerance.
+   * \param ranks: output, the rank of each vertex.
+   * \return the number of rounds.
+   */
+  template <typename out_view_t>
+  int worklist_iteration(out_view_t ranks, scalar_t tolerance, int max_iterations){
+    if (num_verts == 0) return 0;
+    const scalar_t n = scalar_t(num_verts);
+    const scalar_t teleport = (KAT::one() - damping) / n;
+    Kokkos::parallel_for("KokkosGraph::PageRank::Initialize", my_exec_space(0, num_verts),
+        Initialize(x, KAT::one() / n));
+    scalar_t dangling = dangling_rank();
+    scalar_t full_round_dangling = dangling;
+
+    nnz_lno_temp_work_view_t worklist(Kokkos::ViewAllocateWithoutInitializing("PageRank worklist"), num_verts);
+    nnz_lno_temp_work_view_t active("PageRank active", num_verts);
+    KokkosKernels::Impl::linear_init<nnz_lno_temp_work_view_t, MyExecSpace>(num_verts, worklist);
+    nnz_lno_t worklist_size = num_verts;
+
+    int iteration = 0;
+    while (iteration < max_iterations && worklist_size > 0){
+      StepStats stats;
+      stats.change = KAT::zero();
+      stats.dangling = KAT::zero();
+      Kokkos::parallel_reduce("KokkosGraph::PageRank::WorklistStep", my_exec_space(0, worklist_size),
+          PowerStep(xadj, adj, t_xadj, t_adj, t_values, x, y, teleport, damping, dangling / n,
+              worklist, active, true, tolerance), stats);
+      Kokkos::parallel_for("KokkosGraph::PageRank::ApplyWorklist", my_exec_space(0, worklist_size),
+          ApplyWorklist(worklist, x, y));
+      dangling += stats.dangling;
+      ++iteration;
+
+      if (damping * KAT::abs(dangling - full_round_dangling) / n > tolerance){
+        KokkosKernels::Impl::linear_init<nnz_lno_temp_work_view_t, MyExecSpace>(num_verts, worklist);
+        Kokkos::deep_copy(active, nnz_lno_t(0));
+        worklist_size = num_verts;
+        full_round_dangling = dangling;
+      }
+      else {
+        worklist_size = 0;
+        Kokkos::parallel_reduce("KokkosGraph::PageRank::CountActive", my_exec_space(0, num_verts),
+            CountActive(active), worklist_size);
+        if (worklist_size > 0){
+          Kokkos::parallel_scan("KokkosGraph::PageRank::ActiveToWorklist", my_exec_space(0, num_verts),
+              ActiveToWorklist(active, worklist));
+        }
+      }
+    }
+    Kokkos::deep_copy(ranks, x);
+    MyExecSpace::fence();
+    return iteration;
+  }
+};
+
+}
+}
+}
+
+#endif
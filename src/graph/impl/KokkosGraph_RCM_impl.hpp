@@ -0,0 +1,413 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_RCM_IMPL_HPP
+#define _KOKKOSGRAPH_RCM_IMPL_HPP
+
+#include "KokkosKernels_Utils.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+namespace Impl{
+
+/*! \brief Parallel Reverse Cuthill-McKee ordering of a graph.
+ *
+ * The Cuthill-McKee order is built one BFS level at a time. order holds
+ * the vertices in the order they are reached; the current level is the
+ * range [level_begin, level_end) of order, and the next level is written
+ * right after it. Each unvisited neighbor of the level is given to the
+ * level vertex with the smallest position (parent). The children of a
+ * vertex are appended in the order of their parents, each group sorted
+ * by increasing degree, which is the sequential Cuthill-McKee order.
+ *
+ * parent of a vertex is num_verts when it has not been reached; during
+ * a level it is its parent's position, -position-2 once it is counted,
+ * and the parent's position again once it is placed. The root has -1.
+ */
+template <typename lno_row_view_t_, typename lno_nnz_view_t_>
+class RCM{
+public:
+  typedef typename lno_row_view_t_::const_type const_lno_row_view_t;
+  typedef typename lno_nnz_view_t_::const_type const_lno_nnz_view_t;
+  typedef typename lno_row_view_t_::non_const_value_type size_type;
+  typedef typename lno_nnz_view_t_::non_const_value_type nnz_lno_t;
+  typedef typename lno_nnz_view_t_::device_type device_type;
+  typedef typename device_type::execution_space MyExecSpace;
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef Kokkos::View<nnz_lno_t *, device_type> nnz_lno_temp_work_view_t;
+
+  //! At most this many BFS are run to look for a pseudo-peripheral root.
+  static const int max_peripheral_sweeps = 4;
+
+private:
+  nnz_lno_t num_verts;
+  const_lno_row_view_t xadj;
+  const_lno_nnz_view_t adj;
+
+  nnz_lno_temp_work_view_t order;
+  nnz_lno_temp_work_view_t parent;
+  nnz_lno_temp_work_view_t counts;
+
+public:
+  /**
+   * \brief RCM constructor.
+   * \param nv_: number of vertices in the graph.
+   * \param row_map: the xadj array of the graph. Its size is nv_ + 1.
+   * \param entries: adjacency array of the graph. Entries not in
+   *   [0, nv_) are ignored.
+   */
+  RCM (nnz_lno_t nv_, const_lno_row_view_t row_map, const_lno_nnz_view_t entries):
+    num_verts(nv_), xadj(row_map), adj(entries),
+    order(Kokkos::ViewAllocateWithoutInitializing("RCM order"), nv_),
+    parent(Kokkos::ViewAllocateWithoutInitializing("RCM parent"), nv_),
+    counts(Kokkos::ViewAllocateWithoutInitializing("RCM counts"), nv_ + 1){}
+
+  struct ResetParent{
+    nnz_lno_temp_work_view_t order;
+    nnz_lno_temp_work_view_t parent;
+    nnz_lno_t unreached;
+    ResetParent(nnz_lno_temp_work_view_t order_, nnz_lno_temp_work_view_t parent_, nnz_lno_t unreached_):
+      order(order_), parent(parent_), unreached(unreached_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      parent(order(i)) = unreached;
+    }
+  };
+
+  //gives each unvisited neighbor of the level to its smallest level position.
+  struct MarkNeighbors{
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t order;
+    nnz_lno_temp_work_view_t parent;
+    nnz_lno_t level_begin;
+    MarkNeighbors(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t order_, nnz_lno_temp_work_view_t parent_, nnz_lno_t level_begin_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), order(order_), parent(parent_), level_begin(level_begin_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      const nnz_lno_t v = order(i);
+      const size_type end = xadj(v + 1);
+      for (size_type j = xadj(v); j < end; ++j){
+        const nnz_lno_t n = adj(j);
+        if (n < 0 || n >= num_verts) continue;
+        //parents of the earlier levels are below level_begin and do not change.
+        nnz_lno_t current = parent(n);
+        while (current >= level_begin && current > i){
+          const nnz_lno_t old = Kokkos::atomic_compare_exchange(&parent(n), current, i);
+          if (old == current) break;
+          current = old;
+        }
+      }
+    }
+  };
+
+  //counts the children of each level vertex, once each.
+  struct CountChildren{
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t order;
+    nnz_lno_temp_work_view_t parent;
+    nnz_lno_temp_work_view_t counts;
+    CountChildren(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t order_, nnz_lno_temp_work_view_t parent_, nnz_lno_temp_work_view_t counts_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), order(order_), parent(parent_), counts(counts_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      const nnz_lno_t v = order(i);
+      const size_type end = xadj(v + 1);
+      nnz_lno_t num_children = 0;
+      for (size_type j = xadj(v); j < end; ++j){
+        const nnz_lno_t n = adj(j);
+        if (n < 0 || n >= num_verts) continue;
+        //a repeated entry finds the child already counted.
+        if (parent(n) == i){
+          parent(n) = -i - 2;
+          ++num_children;
+        }
+      }
+      counts(i) = num_children;
+    }
+  };
+
+  //writes the children of each level vertex after the level, by degree.
+  struct FillChildren{
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    const_lno_nnz_view_t adj;
+    nnz_lno_temp_work_view_t order;
+    nnz_lno_temp_work_view_t parent;
+    nnz_lno_temp_work_view_t counts;
+    nnz_lno_t level_end;
+    FillChildren(nnz_lno_t num_verts_, const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_,
+        nnz_lno_temp_work_view_t order_, nnz_lno_temp_work_view_t parent_, nnz_lno_temp_work_view_t counts_,
+        nnz_lno_t level_end_):
+      num_verts(num_verts_), xadj(xadj_), adj(adj_), order(order_), parent(parent_), counts(counts_),
+      level_end(level_end_){}
+
+    KOKKOS_INLINE_FUNCTION
+    size_type degree(const nnz_lno_t v) const{
+      return xadj(v + 1) - xadj(v);
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      const nnz_lno_t v = order(i);
+      const size_type end = xadj(v + 1);
+      const nnz_lno_t first = level_end + counts(i);
+      nnz_lno_t write = first;
+      for (size_type j = xadj(v); j < end; ++j){
+        const nnz_lno_t n = adj(j);
+        if (n < 0 || n >= num_verts) continue;
+        if (parent(n) == -i - 2){
+          parent(n) = i;
+          //insertion sort by (degree, vertex).
+          nnz_lno_t k = write++;
+          const size_type d = degree(n);
+          while (k > first && (degree(order(k - 1)) > d || (degree(order(k - 1)) == d && order(k - 1) > n))){
+            order(k) = order(k - 1);
+            --k;
+          }
+          order(k) = n;
+        }
+      }
+    }
+  };
+
+  struct MinDegree{
+    nnz_lno_t v;
+    size_type degree;
+  };
+
+  //vertex of smallest degree either in order[begin, end), or unreached.
+  struct FindMinDegree{
+    typedef MinDegree value_type;
+    nnz_lno_t num_verts;
+    const_lno_row_view_t xadj;
+    nnz_lno_temp_work_view_t order;
+    nnz_lno_temp_work_view_t parent;
+    bool unreached;
+    FindMinDegree(nnz_lno_t num_verts_, const_lno_row_view_t xadj_,
+        nnz_lno_temp_work_view_t order_, nnz_lno_temp_work_view_t parent_, bool unreached_):
+      num_verts(num_verts_), xadj(xadj_), order(order_), parent(parent_), unreached(unreached_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i, value_type &min_degree) const{
+      nnz_lno_t v = i;
+      if (unreached){
+        if (parent(v) != num_verts) return;
+      }
+      else v = order(i);
+      value_type mine;
+      mine.v = v;
+      mine.degree = xadj(v + 1) - xadj(v);
+      join(min_degree, mine);
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void join (volatile value_type& dst, const volatile value_type& src) const {
+      if (src.v != num_verts && (dst.v == num_verts || src.degree < dst.degree ||
+          (src.degree == dst.degree && src.v < dst.v))){
+        dst.v = src.v;
+        dst.degree = src.degree;
+      }
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void join (value_type& dst, const value_type& src) const {
+      if (src.v != num_verts && (dst.v == num_verts || src.degree < dst.degree ||
+          (src.degree == dst.degree && src.v < dst.v))){
+        dst.v = src.v;
+        dst.degree = src.degree;
+      }
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void init (value_type& dst) const {
+      dst.v = num_verts;
+      dst.degree = 0;
+    }
+  };
+
+  struct ReverseOrder{
+    nnz_lno_t num_verts;
+    nnz_lno_temp_work_view_t order;
+    nnz_lno_temp_work_view_t old_to_new;
+    ReverseOrder(nnz_lno_t num_verts_, nnz_lno_temp_work_view_t order_, nnz_lno_temp_work_view_t old_to_new_):
+      num_verts(num_verts_), order(order_), old_to_new(old_to_new_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      old_to_new(order(i)) = num_verts - 1 - i;
+    }
+  };
+
+  struct ReverseSequence{
+    nnz_lno_t num_verts;
+    nnz_lno_temp_work_view_t order;
+    nnz_lno_temp_work_view_t new_to_old;
+    ReverseSequence(nnz_lno_t num_verts_, nnz_lno_temp_work_view_t order_, nnz_lno_temp_work_view_t new_to_old_):
+      num_verts(num_verts_), order(order_), new_to_old(new_to_old_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      new_to_old(num_verts - 1 - i) = order(i);
+    }
+  };
+
+private:
+  nnz_lno_t min_degree_vertex(nnz_lno_t begin, nnz_lno_t end, bool unreached){
+    MinDegree result;
+    result.v = num_verts;
+    result.degree = 0;
+    Kokkos::parallel_reduce("KokkosGraph::RCM::FindMinDegree", my_exec_space(begin, end),
+        FindMinDegree(num_verts, xadj, order, parent, unreached), result);
+    return result.v;
+  }
+
+  void reset_parent(nnz_lno_t begin, nnz_lno_t end){
+    Kokkos::parallel_for("KokkosGraph::RCM::ResetParent", my_exec_space(begin, end),
+        ResetParent(order, parent, num_verts));
+  }
+
+  /**
+   * \brief Cuthill-McKee BFS of the component of root into order[begin, end).
+   * \param num_levels: the number of BFS levels.
+   * \param last_level_begin: the position of the first vertex of the last level.
+   * \return end.
+   */
+  nnz_lno_t bfs(nnz_lno_t root, nnz_lno_t begin, nnz_lno_t &num_levels, nnz_lno_t &last_level_begin){
+    Kokkos::deep_copy(Kokkos::subview(order, begin), root);
+    Kokkos::deep_copy(Kokkos::subview(parent, root), nnz_lno_t(-1));
+
+    nnz_lno_t level_begin = begin, level_end = begin + 1;
+    num_levels = 1;
+    while (true){
+      Kokkos::parallel_for("KokkosGraph::RCM::MarkNeighbors", my_exec_space(level_begin, level_end),
+          MarkNeighbors(num_verts, xadj, adj, order, parent, level_begin));
+      Kokkos::parallel_for("KokkosGraph::RCM::CountChildren", my_exec_space(level_begin, level_end),
+          CountChildren(num_verts, xadj, adj, order, parent, counts));
+      Kokkos::deep_copy(Kokkos::subview(counts, level_end), nnz_lno_t(0));
+      Kokkos::parallel_scan("KokkosGraph::RCM::PrefixSum", my_exec_space(level_begin, level_end + 1),
+          KokkosKernels::Impl::ExclusiveParallelPrefixSum<nnz_lno_temp_work_view_t>(counts));
+      nnz_lno_t next_level_size = 0;
+      Kokkos::deep_copy(next_level_size, Kokkos::subview(counts, level_end));
+      if (next_level_size == 0) break;
+
+      Kokkos::parallel_for("KokkosGraph::RCM::FillChildren", my_exec_space(level_begin, level_end),
+          FillChildren(num_verts, xadj, adj, order, parent, counts, level_end));
+      level_begin = level_end;
+      level_end += next_level_size;
+      ++num_levels;
+    }
+    last_level_begin = level_begin;
+    return level_end;
+  }
+
+  /**
+   * \brief Cuthill-McKee order of all the vertices into order.
+   *
+   * Each connected component is ordered from a pseudo-peripheral root,
+   * found as in George and Liu: starting from an unreached vertex of
+   * minimum degree, the BFS is restarted from a minimum degree vertex of
+   * its last level while the number of levels grows.
+   */
+  void cuthill_mckee(){
+    Kokkos::deep_copy(parent, num_verts);
+
+    nnz_lno_t num_placed = 0;
+    while (num_placed < num_verts){
+      nnz_lno_t root = min_degree_vertex(0, num_verts, true);
+      nnz_lno_t num_levels = 0, last_level_begin = 0;
+      nnz_lno_t end = bfs(root, num_placed, num_levels, last_level_begin);
+
+      for (int sweep = 1; sweep < max_peripheral_sweeps && end - num_placed > 2; ++sweep){
+        nnz_lno_t candidate = min_degree_vertex(last_level_begin, end, false);
+        reset_parent(num_placed, end);
+        nnz_lno_t candidate_levels = 0;
+        bfs(candidate, num_placed, candidate_levels, last_level_begin);
+        //the BFS of the candidate is kept; it is at least as deep.
+        if (candidate_levels <= num_levels) break;
+        num_levels = candidate_levels;
+      }
+      num_placed = end;
+    }
+  }
+
+public:
+  /**
+   * \brief Computes the Reverse Cuthill-McKee permutation.
+   * \param old_to_new: output, the new index of each vertex.
+   */
+  void rcm(nnz_lno_temp_work_view_t old_to_new){
+    if (num_verts == 0) return;
+    cuthill_mckee();
+    Kokkos::parallel_for("KokkosGraph::RCM::ReverseOrder", my_exec_space(0, num_verts),
+        ReverseOrder(num_verts, order, old_to_new));
+    MyExecSpace::fence();
+  }
+
+  /**
+   * \brief Computes the inverse of the Reverse Cuthill-McKee permutation.
+   * \param new_to_old: output, the vertex of each new index.
+   */
+  void rcm_sequence(nnz_lno_temp_work_view_t new_to_old){
+    if (num_verts == 0) return;
+    cuthill_mckee();
+    Kokkos::parallel_for("KokkosGraph::RCM::ReverseSequence", my_exec_space(0, num_verts),
+        ReverseSequence(num_verts, order, new_to_old));
+    MyExecSpace::fence();
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,887 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_TRIANGLECOUNT_IMPL_HPP
+#define _KOKKOSGRAPH_TRIANGLECOUNT_IMPL_HPP
+
+#include <sstream>
+#include <algorithm>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+namespace Impl{
+
+//! Position of v in the sorted entries [begin, end), or end if it is not there.
+template <typename entries_t, typename size_type, typename nnz_lno_t>
+KOKKOS_INLINE_FUNCTION
+size_type find_in_sorted_row(const entries_t &entries, size_type begin, const size_type end, const nnz_lno_t v){
+  size_type last = end;
+  while (begin < last){
+    const size_type mid = begin + (last - begin) / 2;
+    const nnz_lno_t w = entries(mid);
+    if (w == v) return mid;
+    if (w < v) begin = mid + 1;
+    else last = mid;
+  }
+  return end;
+}
+
+//! The weight of every common neighbor in TriangleSupport: the plain count.
+struct TriangleUnitWeight{
+  template <typename nnz_lno_t>
+  KOKKOS_INLINE_FUNCTION
+  int operator()(const nnz_lno_t) const{
+    return 1;
+  }
+};
+
+/*! \brief Counts the triangles of each edge and each vertex of a symmetric graph.
+ *
+ * A team owns a vertex i. Its thread for the edge (i, j) counts the common
+ * neighbors of i and j, with an intersection chosen from the degrees:
+ *  - if i is a hub, of degree at least hub_degree, whose neighbors span at most
+ *    bitmap_bits consecutive ids, the team first marks them in a bitmap in its
+ *    scratch, and the vector lanes test the neighbors of j against it;
+ *  - if merging the two sorted rows is cheaper than searching the shorter one
+ *    in the longer one, and the team has a single vector lane, they are merged;
+ *  - otherwise the vector lanes search each neighbor of the shorter row in the
+ *    sorted longer row.
+ * That count is the support of (i, j), written to the position of the edge;
+ * with a weight functor, each common neighbor k adds weight(k) instead of 1.
+ * the vertex count is the team reduction of the supports of its edges, halved
+ * since each triangle at i is seen from both of its edges. Every output has a
+ * single writer, so no atomics are needed, even at hub vertices.
+ */
+template <typename row_map_t, typename entries_t, typename sorted_entries_t,
+          typename edge_count_t, typename vertex_count_t, typename MyExecSpace,
+          typename weight_t = TriangleUnitWeight>
+struct TriangleSupport{
+  typedef typename row_map_t::non_const_value_type size_type;
+  typedef typename entries_t::non_const_value_type nnz_lno_t;
+  typedef typename edge_count_t::non_const_value_type edge_value_t;
+  typedef typename vertex_count_t::non_const_value_type vertex_value_t;
+  typedef Kokkos::TeamPolicy<MyExecSpace> team_policy_t;
+  typedef Kokkos::TeamPolicy<MyExecSpace, Kokkos::Schedule<Kokkos::Dynamic> > dynamic_team_policy_t;
+  typedef typename team_policy_t::member_type team_member_t;
+  typedef Kokkos::View<unsigned int*, typename MyExecSpace::scratch_memory_space,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged> > bitmap_t;
+
+  nnz_lno_t num_rows;
+  row_map_t xadj;
+  entries_t adj;
+  sorted_entries_t sorted_adj;
+  edge_count_t edge_counts;
+  vertex_count_t vertex_counts;
+  bool count_edges;
+  bool count_vertices;
+  nnz_lno_t hub_degree;
+  nnz_lno_t bitmap_bits;
+  bool use_merge;
+  weight_t weight;
+
+  TriangleSupport(nnz_lno_t num_rows_, row_map_t xadj_, entries_t adj_, sorted_entries_t sorted_adj_,
+                  edge_count_t edge_counts_, vertex_count_t vertex_counts_,
+                  bool count_edges_, bool count_vertices_,
+                  nnz_lno_t hub_degree_ = 0, nnz_lno_t bitmap_bits_ = 0, bool use_merge_ = false,
+                  weight_t weight_ = weight_t()):
+    num_rows(num_rows_), xadj(xadj_), adj(adj_), sorted_adj(sorted_adj_),
+    edge_counts(edge_counts_), vertex_counts(vertex_counts_),
+    count_edges(count_edges_), count_vertices(count_vertices_),
+    hub_degree(hub_degree_), bitmap_bits(bitmap_bits_), use_merge(use_merge_), weight(weight_){}
+
+  KOKKOS_INLINE_FUNCTION
+  bool is_neighbor(const size_type begin, const size_type end, const nnz_lno_t v) const{
+    return find_in_sorted_row(sorted_adj, begin, end, v) != end;
+  }
+
+  //whether k is a third vertex of a triangle with i and j.
+  KOKKOS_INLINE_FUNCTION
+  bool is_other(const nnz_lno_t k, const nnz_lno_t i, const nnz_lno_t j) const{
+    return k != i && k != j && k >= 0 && k < num_rows;
+  }
+
+  //the ids of the valid neighbors of i are in [lo, hi]; false if there are none.
+  KOKKOS_INLINE_FUNCTION
+  bool valid_span(const size_type begin, const size_type end, nnz_lno_t &lo, nnz_lno_t &hi) const{
+    size_type first = begin, last = end;
+    while (first < last && sorted_adj(first) < 0) ++first;
+    while (last > first && sorted_adj(last - 1) >= num_rows) --last;
+    if (first == last) return false;
+    lo = sorted_adj(first);
+    hi = sorted_adj(last - 1);
+    return true;
+  }
+
+  //the weighted common neighbors of the sorted rows [a, a_end) and [b, b_end).
+  KOKKOS_INLINE_FUNCTION
+  edge_value_t merge_count(size_type a, const size_type a_end, size_type b, const size_type b_end,
+                           const nnz_lno_t i, const nnz_lno_t j) const{
+    edge_value_t count = 0;
+    while (a < a_end && b < b_end){
+      const nnz_lno_t ka = sorted_adj(a), kb = sorted_adj(b);
+      if (ka < kb) ++a;
+      else if (kb < ka) ++b;
+      else {
+        if (is_other(ka, i, j)) count += weight(ka);
+        ++a;
+        ++b;
+      }
+    }
+    return count;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const team_member_t &teamMember) const{
+    const nnz_lno_t i = teamMember.league_rank();
+    const size_type row_begin = xadj(i);
+    const size_type row_end = xadj(i + 1);
+    const nnz_lno_t i_degree = row_end - row_begin;
+
+    //the bitmap of the neighbors of a hub, bit k - lo for the neighbor k.
+    nnz_lno_t lo = 0, hi = -1;
+    bool use_bitmap = false;
+    if (bitmap_bits > 0 && i_degree >= hub_degree && valid_span(row_begin, row_end, lo, hi)){
+      use_bitmap = hi - lo < bitmap_bits;
+    }
+    bitmap_t bitmap;
+    if (use_bitmap){
+      const nnz_lno_t num_words = (hi - lo) / 32 + 1;
+      bitmap = bitmap_t(teamMember.team_scratch(0), num_words);
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, num_words), [&] (const nnz_lno_t w){
+        bitmap(w) = 0;
+      });
+      teamMember.team_barrier();
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, row_begin, row_end), [&] (const size_type e){
+        const nnz_lno_t k = sorted_adj(e);
+        if (k >= lo && k <= hi) Kokkos::atomic_fetch_or(&bitmap((k - lo) / 32), 1u << ((k - lo) % 32));
+      });
+      teamMember.team_barrier();
+    }
+
+    vertex_value_t row_sum = 0;
+    Kokkos::parallel_reduce(Kokkos::TeamThreadRange(teamMember, row_begin, row_end),
+        [&] (const size_type e, vertex_value_t &sum){
+      const nnz_lno_t j = adj(e);
+      edge_value_t support = 0;
+      if (j != i && j >= 0 && j < num_rows){
+        const size_type j_begin = xadj(j);
+        const size_type j_end = xadj(j + 1);
+        const nnz_lno_t j_degree = j_end - j_begin;
+        if (use_bitmap){
+          Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(teamMember, j_degree),
+              [&] (const size_type f, edge_value_t &s){
+            const nnz_lno_t k = sorted_adj(j_begin + f);
+            if (k >= lo && k <= hi && is_other(k, i, j) &&
+                ((bitmap((k - lo) / 32) >> ((k - lo) % 32)) & 1u)) s += weight(k);
+          }, support);
+        }
+        else {
+          //search the shorter row in the longer one, unless merging them costs less.
+          const bool i_shorter = i_degree <= j_degree;
+          const size_type s_begin = i_shorter ? row_begin : j_begin;
+          const nnz_lno_t s_degree = i_shorter ? i_degree : j_degree;
+          const size_type l_begin = i_shorter ? j_begin : row_begin;
+          const size_type l_end = i_shorter ? j_end : row_end;
+          const nnz_lno_t l_degree = i_shorter ? j_degree : i_degree;
+          nnz_lno_t log_l = 1;
+          while (log_l < 31 && (nnz_lno_t(1) << log_l) < l_degree) ++log_l;
+          if (use_merge && size_t(s_degree) * log_l >= size_t(s_degree) + l_degree){
+            Kokkos::single(Kokkos::PerThread(teamMember), [&] (edge_value_t &s){
+              s = merge_count(row_begin, row_end, j_begin, j_end, i, j);
+            }, support);
+          }
+          else {
+            Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(teamMember, s_degree),
+                [&] (const size_type f, edge_value_t &s){
+              const nnz_lno_t k = sorted_adj(s_begin + f);
+              if (is_other(k, i, j) && is_neighbor(l_begin, l_end, k)) s += weight(k);
+            }, support);
+          }
+        }
+      }
+      if (count_edges){
+        Kokkos::single(Kokkos::PerThread(teamMember), [&] (){
+          edge_counts(e) = support;
+        });
+      }
+      sum += support;
+    }, row_sum);
+
+    if (count_vertices){
+      Kokkos::single(Kokkos::PerTeam(teamMember), [&] (){
+        vertex_counts(i) = row_sum / 2;
+      });
+    }
+  }
+};
+
+/*! \brief The largest span of the valid neighbor ids of the vertices of
+ *  degree at least hub_degree, 0 if there are none.
+ */
+template <typename support_t>
+struct TriangleHubSpan{
+  typedef typename support_t::nnz_lno_t nnz_lno_t;
+  support_t support;
+
+  TriangleHubSpan(const support_t &support_): support(support_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const nnz_lno_t i, nnz_lno_t &max_span) const{
+    const typename support_t::size_type row_begin = support.xadj(i);
+    const typename support_t::size_type row_end = support.xadj(i + 1);
+    nnz_lno_t lo = 0, hi = -1;
+    if (nnz_lno_t(row_end - row_begin) >= support.hub_degree && support.valid_span(row_begin, row_end, lo, hi)){
+      if (hi - lo + 1 > max_span) max_span = hi - lo + 1;
+    }
+  }
+};
+
+/*! \brief Runs TriangleSupport on a graph. Unless sorted is true, a sorted
+ *  copy of the entries is made for the intersections. The vertices of degree
+ *  at least 128 are hubs, and their bitmaps may use the shared memory size of
+ *  the handle, if one of them needs it. weight is given to TriangleSupport.
+ */
+template <typename KernelHandle, typename row_map_t, typename entries_t,
+          typename edge_count_t, typename vertex_count_t, typename weight_t = TriangleUnitWeight>
+void triangle_support(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    row_map_t row_map,
+    entries_t entries,
+    edge_count_t edge_counts,
+    vertex_count_t vertex_counts,
+    bool count_edges,
+    bool count_vertices,
+    bool sorted = false,
+    weight_t weight = weight_t()){
+
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename entries_t::non_const_type sorted_entries_t;
+  typedef typename entries_t::const_type const_entries_t;
+  typedef TriangleSupport<row_map_t, entries_t, const_entries_t,
+      edge_count_t, vertex_count_t, MyExecSpace, weight_t> support_t;
+  typedef typename support_t::nnz_lno_t nnz_lno_t;
+
+  if (m == 0) return;
+
+  const size_t nnz = entries.extent(0);
+  const_entries_t sorted_entries = entries;
+  if (!sorted){
+    sorted_entries_t sorted_copy(Kokkos::ViewAllocateWithoutInitializing("sorted entries"), nnz);
+    sorted_entries_t null_values;
+    KokkosKernels::Impl::kk_sort_graph
+        <row_map_t, entries_t, sorted_entries_t, sorted_entries_t, sorted_entries_t, MyExecSpace>
+        (row_map, entries, null_values, sorted_copy, null_values);
+    sorted_entries = sorted_copy;
+  }
+
+  const int vector_size = handle->get_suggested_vector_size(m, nnz);
+  const int team_size = handle->get_suggested_team_size(vector_size);
+  const nnz_lno_t hub_degree = 128;
+  const nnz_lno_t max_bitmap_bits = nnz_lno_t(handle->get_shmem_size() / sizeof(unsigned int)) * 32;
+
+  support_t support(m, row_map, entries, sorted_entries,
+      edge_counts, vertex_counts, count_edges, count_vertices,
+      hub_degree, max_bitmap_bits, vector_size == 1, weight);
+
+  //the scratch of the widest hub that fits, none if there is no such hub.
+  nnz_lno_t max_span = 0;
+  Kokkos::parallel_reduce("KokkosGraph::TriangleSupport::HubSpan",
+      Kokkos::RangePolicy<MyExecSpace>(0, m), TriangleHubSpan<support_t>(support),
+      Kokkos::Max<nnz_lno_t>(max_span));
+  if (max_span > max_bitmap_bits) max_span = max_bitmap_bits;
+  support.bitmap_bits = max_span;
+  const size_t bitmap_bytes = max_span > 0 ? size_t((max_span - 1) / 32 + 1) * sizeof(unsigned int) : 0;
+
+  if (handle->is_dynamic_scheduling()){
+    Kokkos::parallel_for("KokkosGraph::TriangleSupport",
+        typename support_t::dynamic_team_policy_t(m, team_size, vector_size).set_scratch_size(
+            0, Kokkos::PerTeam(bitmap_bytes)), support);
+  }
+  else {
+    Kokkos::parallel_for("KokkosGraph::TriangleSupport",
+        typename support_t::team_policy_t(m, team_size, vector_size).set_scratch_size(
+            0, Kokkos::PerTeam(bitmap_bytes)), support);
+  }
+  MyExecSpace::fence();
+}
+
+/*! \brief Renumbers the vertices of a graph by degree and builds the permuted graph.
+ *
+ * The vertices are bucketed by degree in parallel with create_reverse_map, which gives
+ * them in increasing degree. sort_order follows kk_sort_by_row_size: 1 gives label 0 to
+ * the largest degree, 0 to the smallest, 2 interleaves the two ends.
+ *
+ * \param old_to_new: output, the new label of each vertex.
+ * \param new_row_map, new_entries: output, row new_to_old(r) of the graph as row r, with
+ *   its entries relabeled. Entries not in [0, m) are copied as they are.
+ */
+template <typename KernelHandle, typename row_map_t, typename entries_t>
+void relabel_by_degree(
+    typename KernelHandle::nnz_lno_t m,
+    row_map_t row_map,
+    entries_t entries,
+    int sort_order,
+    typename KernelHandle::nnz_lno_persistent_work_view_t &old_to_new,
+    typename KernelHandle::row_lno_persistent_work_view_t &new_row_map,
+    typename KernelHandle::nnz_lno_persistent_work_view_t &new_entries){
+
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::nnz_lno_persistent_work_view_t nnz_lno_persistent_work_view_t;
+  typedef typename KernelHandle::row_lno_persistent_work_view_t row_lno_persistent_work_view_t;
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+
+  //1-based degrees, so they can be used as the colors of create_reverse_map.
+  nnz_lno_persistent_work_view_t degree_key(Kokkos::ViewAllocateWithoutInitializing("degree key"), m);
+  nnz_lno_t max_key = 0;
+  Kokkos::parallel_reduce("KokkosGraph::RelabelByDegree::Degrees", my_exec_space(0, m),
+      KOKKOS_LAMBDA(const nnz_lno_t i, nnz_lno_t &lmax){
+    const nnz_lno_t key = row_map(i + 1) - row_map(i) + 1;
+    degree_key(i) = key;
+    if (key > lmax) lmax = key;
+  }, Kokkos::Max<nnz_lno_t>(max_key));
+
+  nnz_lno_persistent_work_view_t bucket_xadj, by_degree;
+  KokkosKernels::Impl::create_reverse_map
+      <nnz_lno_persistent_work_view_t, nnz_lno_persistent_work_view_t, MyExecSpace>
+      (m, max_key, degree_key, bucket_xadj, by_degree);
+
+  old_to_new = nnz_lno_persistent_work_view_t(Kokkos::ViewAllocateWithoutInitializing("degree relabel"), m);
+  nnz_lno_persistent_work_view_t new_to_old(Kokkos::ViewAllocateWithoutInitializing("degree relabel inverse"), m);
+  Kokkos::parallel_for("KokkosGraph::RelabelByDegree::Labels", my_exec_space(0, m),
+      KOKKOS_LAMBDA(const nnz_lno_t p){
+    //r is the position in decreasing degree.
+    const nnz_lno_t r = m - 1 - p;
+    nnz_lno_t label = p;
+    if (sort_order == 1) label = r;
+    else if (sort_order == 2) label = (r & 1) ? m - (r + 1) / 2 : r / 2;
+    old_to_new(by_degree(p)) = label;
+    new_to_old(label) = by_degree(p);
+  });
+
+  new_row_map = row_lno_persistent_work_view_t("degree relabel row map", m + 1);
+  Kokkos::parallel_for("KokkosGraph::RelabelByDegree::RowSizes", my_exec_space(0, m),
+      KOKKOS_LAMBDA(const nnz_lno_t r){
+    const nnz_lno_t v = new_to_old(r);
+    new_row_map(r) = row_map(v + 1) - row_map(v);
+  });
+  KokkosKernels::Impl::exclusive_parallel_prefix_sum<row_lno_persistent_work_view_t, MyExecSpace>(m + 1, new_row_map);
+
+  new_entries = nnz_lno_persistent_work_view_t(Kokkos::ViewAllocateWithoutInitializing("degree relabel entries"), entries.extent(0));
+  Kokkos::parallel_for("KokkosGraph::RelabelByDegree::Entries", my_exec_space(0, m),
+      KOKKOS_LAMBDA(const nnz_lno_t r){
+    const nnz_lno_t v = new_to_old(r);
+    const size_type old_begin = row_map(v);
+    const size_type row_size = row_map(v + 1) - old_begin;
+    const size_type new_begin = new_row_map(r);
+    for (size_type e = 0; e < row_size; ++e){
+      const nnz_lno_t col = entries(old_begin + e);
+      new_entries(new_begin + e) = (col >= 0 && col < m) ? old_to_new(col) : col;
+    }
+  });
+  MyExecSpace::fence();
+}
+
+/*! \brief k-truss of a symmetric graph by peeling.
+ *
+ * The supports of all the edges are counted once with TriangleSupport on a sorted
+ * copy of the graph. Then each round removes the alive edges whose support is below
+ * k - 2, and only the triangles of these edges are visited to decrement the supports
+ * of their surviving edges. A triangle losing several edges in the same round is
+ * handled by its smallest removed edge, so each survivor loses it exactly once.
+ * Both directions of an edge keep the same support and state.
+ */
+template <typename KernelHandle, typename row_map_t, typename entries_t>
+class KTruss{
+public:
+  typedef typename row_map_t::non_const_value_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::HandleTempMemorySpace MyTempMemorySpace;
+  typedef typename entries_t::non_const_type sorted_entries_t;
+  typedef typename KernelHandle::nnz_lno_temp_work_view_t nnz_lno_temp_work_view_t;
+  typedef typename KernelHandle::row_lno_temp_work_view_t row_lno_temp_work_view_t;
+  typedef Kokkos::View<nnz_lno_t, MyTempMemorySpace> single_dim_index_view_type;
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef Kokkos::TeamPolicy<MyExecSpace> team_policy_t;
+  typedef typename team_policy_t::member_type team_member_t;
+
+  enum { ALIVE = 0, REMOVING = 1, DEAD = 2 };
+
+private:
+  KernelHandle *handle;
+  nnz_lno_t num_rows;
+  row_map_t xadj;
+  entries_t adj;
+  sorted_entries_t sorted_adj;
+  nnz_lno_temp_work_view_t support;
+  nnz_lno_temp_work_view_t state;
+  row_lno_temp_work_view_t removed;        //removed edges of the round, with row < column
+  nnz_lno_temp_work_view_t removed_rows;
+  single_dim_index_view_type num_removed;
+
+  //true if the edge {a1, b1} comes before the edge {a2, b2}.
+  KOKKOS_INLINE_FUNCTION
+  static bool edge_less(nnz_lno_t a1, nnz_lno_t b1, nnz_lno_t a2, nnz_lno_t b2){
+    if (a1 > b1) { const nnz_lno_t t = a1; a1 = b1; b1 = t; }
+    if (a2 > b2) { const nnz_lno_t t = a2; a2 = b2; b2 = t; }
+    return a1 < a2 || (a1 == a2 && b1 < b2);
+  }
+
+public:
+  KTruss(KernelHandle *handle_, nnz_lno_t num_rows_, row_map_t row_map, entries_t entries):
+    handle(handle_), num_rows(num_rows_), xadj(row_map), adj(entries),
+    sorted_adj(Kokkos::ViewAllocateWithoutInitializing("sorted entries"), entries.extent(0)),
+    support("k-truss support", entries.extent(0)),
+    state(Kokkos::ViewAllocateWithoutInitializing("k-truss state"), entries.extent(0)),
+    removed(Kokkos::ViewAllocateWithoutInitializing("k-truss removed"), entries.extent(0)),
+    removed_rows(Kokkos::ViewAllocateWithoutInitializing("k-truss removed rows"), entries.extent(0)),
+    num_removed("k-truss num removed"){}
+
+  //self loops and entries out of the graph are dead from the start.
+  struct InitState{
+    nnz_lno_t num_rows;
+    row_map_t xadj;
+    sorted_entries_t adj;
+    nnz_lno_temp_work_view_t state;
+    InitState(nnz_lno_t num_rows_, row_map_t xadj_, sorted_entries_t adj_, nnz_lno_temp_work_view_t state_):
+      num_rows(num_rows_), xadj(xadj_), adj(adj_), state(state_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      for (size_type e = xadj(i); e < xadj(i + 1); ++e){
+        const nnz_lno_t j = adj(e);
+        state(e) = (j == i || j < 0 || j >= num_rows) ? nnz_lno_t(DEAD) : nnz_lno_t(ALIVE);
+      }
+    }
+  };
+
+  //marks the alive edges with too few triangles, and lists them once.
+  struct MarkRemoved{
+    row_map_t xadj;
+    sorted_entries_t adj;
+    nnz_lno_temp_work_view_t support;
+    nnz_lno_temp_work_view_t state;
+    row_lno_temp_work_view_t removed;
+    nnz_lno_temp_work_view_t removed_rows;
+    single_dim_index_view_type num_removed;
+    nnz_lno_t min_support;
+    MarkRemoved(row_map_t xadj_, sorted_entries_t adj_,
+        nnz_lno_temp_work_view_t support_, nnz_lno_temp_work_view_t state_,
+        row_lno_temp_work_view_t removed_, nnz_lno_temp_work_view_t removed_rows_,
+        single_dim_index_view_type num_removed_, nnz_lno_t min_support_):
+      xadj(xadj_), adj(adj_), support(support_), state(state_),
+      removed(removed_), removed_rows(removed_rows_), num_removed(num_removed_), min_support(min_support_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      for (size_type e = xadj(i); e < xadj(i + 1); ++e){
+        if (state(e) != ALIVE || support(e) >= min_support) continue;
+        state(e) = REMOVING;
+        if (i < adj(e)){
+          const nnz_lno_t k = Kokkos::atomic_fetch_add(&num_removed(), nnz_lno_t(1));
+          removed(k) = e;
+          removed_rows(k) = i;
+        }
+      }
+    }
+  };
+
+  //a team thread per removed edge {i, j}, the vector lanes go over the neighbors w of i.
+  struct RemoveTriangles{
+    row_map_t xadj;
+    sorted_entries_t adj;
+    nnz_lno_temp_work_view_t support;
+    nnz_lno_temp_work_view_t state;
+    row_lno_temp_work_view_t removed;
+    nnz_lno_temp_work_view_t removed_rows;
+    nnz_lno_t num_removed;
+    RemoveTriangles(row_map_t xadj_, sorted_entries_t adj_,
+        nnz_lno_temp_work_view_t support_, nnz_lno_temp_work_view_t state_,
+        row_lno_temp_work_view_t removed_, nnz_lno_temp_work_view_t removed_rows_, nnz_lno_t num_removed_):
+      xadj(xadj_), adj(adj_), support(support_), state(state_),
+      removed(removed_), removed_rows(removed_rows_), num_removed(num_removed_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void decrement(const nnz_lno_t a, const size_type ab, const nnz_lno_t b) const{
+      Kokkos::atomic_add(&support(ab), nnz_lno_t(-1));
+      const size_type ba = find_in_sorted_row(adj, xadj(b), xadj(b + 1), a);
+      Kokkos::atomic_add(&support(ba), nnz_lno_t(-1));
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const team_member_t &teamMember) const{
+      const nnz_lno_t work = teamMember.league_rank() * teamMember.team_size() + teamMember.team_rank();
+      if (work >= num_removed) return;
+
+      const nnz_lno_t i = removed_rows(work);
+      const nnz_lno_t j = adj(removed(work));
+      const size_type i_begin = xadj(i);
+      const size_type j_begin = xadj(j);
+      const size_type j_end = xadj(j + 1);
+
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, xadj(i + 1) - i_begin), [&] (const size_type f){
+        const size_type iw = i_begin + f;
+        const nnz_lno_t w = adj(iw);
+        const nnz_lno_t iw_state = state(iw);
+        if (w == j || iw_state == DEAD) return;
+        const size_type jw = find_in_sorted_row(adj, j_begin, j_end, w);
+        if (jw == j_end) return;
+        const nnz_lno_t jw_state = state(jw);
+        if (jw_state == DEAD) return;
+
+        //the smallest removed edge of the triangle removes it.
+        if (iw_state == REMOVING && edge_less(i, w, i, j)) return;
+        if (jw_state == REMOVING && edge_less(j, w, i, j)) return;
+
+        if (iw_state == ALIVE) decrement(i, iw, w);
+        if (jw_state == ALIVE) decrement(j, jw, w);
+      });
+    }
+  };
+
+  struct KillRemoved{
+    nnz_lno_temp_work_view_t state;
+    KillRemoved(nnz_lno_temp_work_view_t state_): state(state_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const size_type &e) const{
+      if (state(e) == REMOVING) state(e) = DEAD;
+    }
+  };
+
+  //maps the states of the sorted copy back to the given entries.
+  template <typename out_view_t>
+  struct WriteTruss{
+    row_map_t xadj;
+    entries_t adj;
+    sorted_entries_t sorted_adj;
+    nnz_lno_temp_work_view_t state;
+    out_view_t in_truss;
+    WriteTruss(row_map_t xadj_, entries_t adj_, sorted_entries_t sorted_adj_,
+        nnz_lno_temp_work_view_t state_, out_view_t in_truss_):
+      xadj(xadj_), adj(adj_), sorted_adj(sorted_adj_), state(state_), in_truss(in_truss_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      const size_type begin = xadj(i);
+      const size_type end = xadj(i + 1);
+      for (size_type e = begin; e < end; ++e){
+        const size_type p = find_in_sorted_row(sorted_adj, begin, end, adj(e));
+        in_truss(e) = (p != end && state(p) == ALIVE) ? 1 : 0;
+      }
+    }
+  };
+
+  /** \brief Computes the k-truss.
+   *  \param k: the edges of the k-truss are in at least k - 2 of its triangles.
+   *  \param in_truss: output, 1 for the entries that are in the k-truss, 0 for the others.
+   *  \return the number of peeling rounds.
+   */
+  template <typename out_view_t>
+  int ktruss(int k, out_view_t in_truss){
+    const size_t nnz = adj.extent(0);
+    if (num_rows == 0) return 0;
+
+    sorted_entries_t null_values;
+    KokkosKernels::Impl::kk_sort_graph
+        <row_map_t, entries_t, sorted_entries_t, sorted_entries_t, sorted_entries_t, MyExecSpace>
+        (xadj, adj, null_values, sorted_adj, null_values);
+
+    Kokkos::parallel_for("KokkosGraph::KTruss::InitState", my_exec_space(0, num_rows),
+        InitState(num_rows, xadj, sorted_adj, state));
+    triangle_support(handle, num_rows, xadj, sorted_adj, support, support, true, false, true);
+
+    const int vector_size = handle->get_suggested_vector_size(num_rows, nnz);
+    const int team_size = handle->get_suggested_team_size(vector_size);
+    const nnz_lno_t min_support = k > 2 ? k - 2 : 0;
+
+    int round = 0;
+    while (true){
+      Kokkos::deep_copy(num_removed, nnz_lno_t(0));
+      Kokkos::parallel_for("KokkosGraph::KTruss::MarkRemoved", my_exec_space(0, num_rows),
+          MarkRemoved(xadj, sorted_adj, support, state, removed, removed_rows, num_removed, min_support));
+      nnz_lno_t h_num_removed = 0;
+      Kokkos::deep_copy(h_num_removed, num_removed);
+      if (h_num_removed == 0) break;
+      ++round;
+
+      Kokkos::parallel_for("KokkosGraph::KTruss::RemoveTriangles",
+          team_policy_t(h_num_removed / team_size + 1, team_size, vector_size),
+          RemoveTriangles(xadj, sorted_adj, support, state, removed, removed_rows, h_num_removed));
+      Kokkos::parallel_for("KokkosGraph::KTruss::KillRemoved",
+          Kokkos::RangePolicy<MyExecSpace, size_type>(0, nnz), KillRemoved(state));
+      if (handle->get_verbose()){
+        std::cout << "k-truss round " << round << " removed " << h_num_removed << " edges" << std::endl;
+      }
+    }
+
+    Kokkos::parallel_for("KokkosGraph::KTruss::WriteTruss", my_exec_space(0, num_rows),
+        WriteTruss<out_view_t>(xadj, adj, sorted_adj, state, in_truss));
+    MyExecSpace::fence();
+    return round;
+  }
+};
+
+/*! \brief Enumerates the triangles of a symmetric graph into fixed size buffers.
+ *
+ * Each edge is oriented from the endpoint of smaller degree (ties by label), so
+ * a triangle i < j < k in that order is found once, from its edge (i, j), as
+ * the common out neighbors of i and j. A first pass counts the triangles of
+ * each oriented edge; their prefix sum gives the batches of consecutive edges
+ * whose triangles fit in a buffer, and the position of each triangle in it.
+ * There are two buffers: the batch filling one runs while the previous batch,
+ * in the other, is handed to the flush functor on the host.
+ */
+template <typename KernelHandle, typename row_map_t, typename entries_t>
+class TriangleStream{
+public:
+  typedef typename row_map_t::non_const_value_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::HandleTempMemorySpace MyTempMemorySpace;
+  typedef typename KernelHandle::nnz_lno_temp_work_view_t nnz_lno_temp_work_view_t;
+  typedef typename KernelHandle::row_lno_temp_work_view_t row_lno_temp_work_view_t;
+  typedef Kokkos::View<size_t *, MyTempMemorySpace> offset_view_t;
+  typedef Kokkos::View<nnz_lno_t *[3], Kokkos::LayoutRight, MyTempMemorySpace> triangle_view_t;
+  typedef typename triangle_view_t::HostMirror host_triangle_view_t;
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef Kokkos::RangePolicy<MyExecSpace, size_type> edge_exec_space;
+
+private:
+  nnz_lno_t num_rows;
+  row_map_t xadj;
+  entries_t adj;
+
+  //the oriented graph, sorted, and the row of each of its edges.
+  row_lno_temp_work_view_t o_xadj;
+  nnz_lno_temp_work_view_t o_adj;
+  nnz_lno_temp_work_view_t o_rows;
+
+  //true if the edge {i, j} goes from i to j.
+  KOKKOS_INLINE_FUNCTION
+  static bool precedes(const row_map_t &xadj_, const nnz_lno_t i, const nnz_lno_t j){
+    const size_type di = xadj_(i + 1) - xadj_(i);
+    const size_type dj = xadj_(j + 1) - xadj_(j);
+    return di < dj || (di == dj && i < j);
+  }
+
+public:
+  TriangleStream(nnz_lno_t num_rows_, row_map_t row_map, entries_t entries):
+    num_rows(num_rows_), xadj(row_map), adj(entries),
+    o_xadj("oriented row_map", num_rows_ + 1){}
+
+  struct OrientCount{
+    nnz_lno_t num_rows;
+    row_map_t xadj;
+    entries_t adj;
+    row_lno_temp_work_view_t o_xadj;
+    OrientCount(nnz_lno_t num_rows_, row_map_t xadj_, entries_t adj_, row_lno_temp_work_view_t o_xadj_):
+      num_rows(num_rows_), xadj(xadj_), adj(adj_), o_xadj(o_xadj_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      size_type count = 0;
+      for (size_type e = xadj(i); e < xadj(i + 1); ++e){
+        const nnz_lno_t j = adj(e);
+        if (j >= 0 && j < num_rows && j != i && precedes(xadj, i, j)) ++count;
+      }
+      o_xadj(i) = count;
+    }
+  };
+
+  struct OrientFill{
+    nnz_lno_t num_rows;
+    row_map_t xadj;
+    entries_t adj;
+    row_lno_temp_work_view_t o_xadj;
+    nnz_lno_temp_work_view_t o_adj;
+    nnz_lno_temp_work_view_t o_rows;
+    OrientFill(nnz_lno_t num_rows_, row_map_t xadj_, entries_t adj_, row_lno_temp_work_view_t o_xadj_,
+        nnz_lno_temp_work_view_t o_adj_, nnz_lno_temp_work_view_t o_rows_):
+      num_rows(num_rows_), xadj(xadj_), adj(adj_), o_xadj(o_xadj_), o_adj(o_adj_), o_rows(o_rows_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &i) const{
+      size_type write = o_xadj(i);
+      for (size_type e = xadj(i); e < xadj(i + 1); ++e){
+        const nnz_lno_t j = adj(e);
+        if (j >= 0 && j < num_rows && j != i && precedes(xadj, i, j)){
+          o_rows(write) = i;
+          o_adj(write++) = j;
+        }
+      }
+    }
+  };
+
+  //counts, or writes from the position of the edge minus base, the triangles of
+  //the oriented edges: the common out neighbors of their endpoints.
+  struct EdgeTriangles{
+    row_lno_temp_work_view_t o_xadj;
+    nnz_lno_temp_work_view_t o_adj;
+    nnz_lno_temp_work_view_t o_rows;
+    offset_view_t offsets;
+    triangle_view_t triangles;
+    size_t base;
+    bool fill;
+    EdgeTriangles(row_lno_temp_work_view_t o_xadj_, nnz_lno_temp_work_view_t o_adj_, nnz_lno_temp_work_view_t o_rows_,
+        offset_view_t offsets_, triangle_view_t triangles_, size_t base_, bool fill_):
+      o_xadj(o_xadj_), o_adj(o_adj_), o_rows(o_rows_), offsets(offsets_), triangles(triangles_),
+      base(base_), fill(fill_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const size_type &e) const{
+      const nnz_lno_t i = o_rows(e);
+      const nnz_lno_t j = o_adj(e);
+      size_type a = o_xadj(i), b = o_xadj(j);
+      const size_type a_end = o_xadj(i + 1), b_end = o_xadj(j + 1);
+      size_t count = 0;
+      size_t write = fill ? offsets(e) - base : 0;
+      while (a < a_end && b < b_end){
+        const nnz_lno_t x = o_adj(a), y = o_adj(b);
+        if (x == y){
+          if (fill){
+            triangles(write, 0) = i;
+            triangles(write, 1) = j;
+            triangles(write, 2) = x;
+            ++write;
+          }
+          ++count;
+          ++a;
+          ++b;
+        }
+        else if (x < y) ++a;
+        else ++b;
+      }
+      if (!fill) offsets(e) = count;
+    }
+  };
+
+  /** \brief Enumerates the triangles.
+   *  \param buffer_size: the number of triangles of a buffer. It is raised to
+   *    the largest number of triangles of an edge if that is larger.
+   *  \param flush: called with a host view of the triangles of a buffer and their
+   *    number, in the order of the batches.
+   *  \return the number of triangles.
+   */
+  template <typename flush_t>
+  size_t enumerate(size_t buffer_size, flush_t &flush){
+    if (num_rows == 0) return 0;
+
+    Kokkos::parallel_for("KokkosGraph::TriangleStream::OrientCount", my_exec_space(0, num_rows),
+        OrientCount(num_rows, xadj, adj, o_xadj));
+    KokkosKernels::Impl::exclusive_parallel_prefix_sum<row_lno_temp_work_view_t, MyExecSpace>(num_rows + 1, o_xadj);
+    size_type num_edges = 0;
+    Kokkos::deep_copy(num_edges, Kokkos::subview(o_xadj, num_rows));
+    if (num_edges == 0) return 0;
+    nnz_lno_temp_work_view_t unsorted_adj(Kokkos::ViewAllocateWithoutInitializing("oriented entries"), num_edges);
+    o_adj = nnz_lno_temp_work_view_t(Kokkos::ViewAllocateWithoutInitializing("sorted oriented entries"), num_edges);
+    o_rows = nnz_lno_temp_work_view_t(Kokkos::ViewAllocateWithoutInitializing("oriented rows"), num_edges);
+    Kokkos::parallel_for("KokkosGraph::TriangleStream::OrientFill", my_exec_space(0, num_rows),
+        OrientFill(num_rows, xadj, adj, o_xadj, unsorted_adj, o_rows));
+    //the rows keep their positions, so o_rows is still valid after the sort.
+    nnz_lno_temp_work_view_t null_values;
+    KokkosKernels::Impl::kk_sort_graph
+        <row_lno_temp_work_view_t, nnz_lno_temp_work_view_t, nnz_lno_temp_work_view_t,
+         nnz_lno_temp_work_view_t, nnz_lno_temp_work_view_t, MyExecSpace>
+        (o_xadj, unsorted_adj, null_values, o_adj, null_values);
+    unsorted_adj = nnz_lno_temp_work_view_t();
+
+    offset_view_t offsets("triangle offsets", num_edges + 1);
+    Kokkos::parallel_for("KokkosGraph::TriangleStream::CountTriangles", edge_exec_space(0, num_edges),
+        EdgeTriangles(o_xadj, o_adj, o_rows, offsets, triangle_view_t(), 0, false));
+    KokkosKernels::Impl::exclusive_parallel_prefix_sum<offset_view_t, MyExecSpace>(num_edges + 1, offsets);
+    typename offset_view_t::HostMirror h_offsets = Kokkos::create_mirror_view(offsets);
+    Kokkos::deep_copy(h_offsets, offsets);
+    const size_t num_triangles = h_offsets(num_edges);
+    if (num_triangles == 0) return 0;
+
+    size_t max_edge_triangles = 0;
+    for (size_type e = 0; e < num_edges; ++e){
+      max_edge_triangles = std::max(max_edge_triangles, h_offsets(e + 1) - h_offsets(e));
+    }
+    buffer_size = std::min(std::max(buffer_size, max_edge_triangles), num_triangles);
+
+    triangle_view_t buffers[2];
+    host_triangle_view_t host_buffers[2];
+    for (int b = 0; b < 2; ++b){
+      buffers[b] = triangle_view_t(Kokkos::ViewAllocateWithoutInitializing("triangle buffer"), buffer_size);
+      host_buffers[b] = Kokkos::create_mirror_view(buffers[b]);
+    }
+
+    int previous = -1;
+    size_t previous_count = 0;
+    size_type batch_begin = 0;
+    for (int batch = 0; batch_begin < num_edges; ++batch){
+      //the last edge whose triangles still fit in the buffer with those of batch_begin.
+      const size_t limit = h_offsets(batch_begin) + buffer_size;
+      const size_type batch_end = size_type(std::upper_bound(h_offsets.data() + batch_begin + 1,
+          h_offsets.data() + num_edges + 1, limit) - h_offsets.data()) - 1;
+      const size_t count = h_offsets(batch_end) - h_offsets(batch_begin);
+      const int current = batch % 2;
+
+      Kokkos::parallel_for("KokkosGraph::TriangleStream::FillTriangles", edge_exec_space(batch_begin, batch_end),
+          EdgeTriangles(o_xadj, o_adj, o_rows, offsets, buffers[current], h_offsets(batch_begin), true));
+      if (previous >= 0) flush(host_buffers[previous], previous_count);
+      Kokkos::deep_copy(
+          Kokkos::subview(host_buffers[current], Kokkos::make_pair(size_t(0), count), Kokkos::ALL()),
+          Kokkos::subview(buffers[current], Kokkos::make_pair(size_t(0), count), Kokkos::ALL()));
+
+      previous = current;
+      previous_count = count;
+      batch_begin = batch_end;
+    }
+    flush(host_buffers[previous], previous_count);
+    return num_triangles;
+  }
+};
+
+}
+}
+}
+#endif
@@ -0,0 +1,365 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSGRAPH_TRIANGLESAMPLING_IMPL_HPP
+#define _KOKKOSGRAPH_TRIANGLESAMPLING_IMPL_HPP
+
+#include <cmath>
+#include <vector>
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+#include "KokkosGraph_TriangleCount_impl.hpp"
+
+namespace KokkosGraph{
+
+namespace Experimental{
+
+//! An estimated triangle count, with its standard error and a 95% confidence interval.
+struct TriangleCountEstimate{
+  double count;
+  double std_error;
+  double lower;
+  double upper;
+  size_t num_samples;   //sampled wedges, or edges of the sampled subgraphs
+
+  TriangleCountEstimate(): count(0), std_error(0), lower(0), upper(0), num_samples(0){}
+
+  void set(double count_, double std_error_, size_t num_samples_){
+    count = count_;
+    std_error = std_error_;
+    lower = count_ - 1.96 * std_error_;
+    if (lower < 0) lower = 0;
+    upper = count_ + 1.96 * std_error_;
+    num_samples = num_samples_;
+  }
+};
+
+namespace Impl{
+
+/*! \brief The subgraph of the edges whose two vertices have the same color.
+ *
+ * The color of a vertex is a hash of its id and the seed modulo num_colors, so
+ * each edge is kept with probability 1 / num_colors and each triangle with
+ * probability 1 / num_colors^2. Self loops and entries not in [0, m) are dropped.
+ * With a single color, this is the cleaned graph. The rows keep their order.
+ */
+template <typename row_map_t, typename entries_t, typename out_row_map_t, typename out_entries_t>
+struct MonochromaticSubgraph{
+  typedef typename row_map_t::non_const_value_type size_type;
+  typedef typename entries_t::non_const_value_type nnz_lno_t;
+
+  struct CountTag{};
+  struct FillTag{};
+
+  nnz_lno_t m;
+  row_map_t xadj;
+  entries_t adj;
+  out_row_map_t out_xadj;
+  out_entries_t out_adj;
+  uint64_t num_colors;
+  uint64_t seed;
+
+  MonochromaticSubgraph(nnz_lno_t m_, row_map_t xadj_, entries_t adj_,
+      out_row_map_t out_xadj_, out_entries_t out_adj_, uint64_t num_colors_, uint64_t seed_):
+    m(m_), xadj(xadj_), adj(adj_), out_xadj(out_xadj_), out_adj(out_adj_),
+    num_colors(num_colors_), seed(seed_){}
+
+  KOKKOS_INLINE_FUNCTION
+  uint64_t color(const nnz_lno_t v) const{
+    return num_colors == 1 ? 0 : KokkosKernels::Impl::kk_hash_mix(uint64_t(v) ^ seed) % num_colors;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  bool keep(const nnz_lno_t i, const nnz_lno_t j) const{
+    return j != i && j >= 0 && j < m && color(i) == color(j);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const CountTag&, const nnz_lno_t i) const{
+    size_type count = 0;
+    for (size_type e = xadj(i); e < xadj(i + 1); ++e){
+      if (keep(i, adj(e))) ++count;
+    }
+    out_xadj(i) = count;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const FillTag&, const nnz_lno_t i) const{
+    size_type k = out_xadj(i);
+    for (size_type e = xadj(i); e < xadj(i + 1); ++e){
+      const nnz_lno_t j = adj(e);
+      if (keep(i, j)) out_adj(k++) = j;
+    }
+  }
+};
+
+//! The number of wedges centered at each vertex, d (d - 1) / 2.
+template <typename row_map_t, typename wedge_view_t>
+struct WedgeCount{
+  typedef typename row_map_t::non_const_value_type size_type;
+
+  row_map_t xadj;
+  wedge_view_t wedges;
+  WedgeCount(row_map_t xadj_, wedge_view_t wedges_): xadj(xadj_), wedges(wedges_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i) const{
+    const size_t d = xadj(i + 1) - xadj(i);
+    wedges(i) = d > 1 ? d * (d - 1) / 2 : 0;
+  }
+};
+
+/*! \brief Samples wedges uniformly and counts the closed ones.
+ *
+ * Sample s draws a wedge index from its own stream, finds its center in the
+ * prefix sum of the wedge counts, and pairs two distinct neighbors of the center
+ * uniformly; the wedge is closed if they are adjacent. The rows must be sorted.
+ */
+template <typename row_map_t, typename entries_t, typename wedge_view_t>
+struct WedgeSampling{
+  typedef typename row_map_t::non_const_value_type size_type;
+  typedef typename entries_t::non_const_value_type nnz_lno_t;
+  typedef typename entries_t::device_type device_t;
+
+  nnz_lno_t m;
+  row_map_t xadj;
+  entries_t adj;
+  wedge_view_t wedges;
+  size_t num_wedges;
+  uint64_t seed;
+
+  WedgeSampling(nnz_lno_t m_, row_map_t xadj_, entries_t adj_, wedge_view_t wedges_,
+      size_t num_wedges_, uint64_t seed_):
+    m(m_), xadj(xadj_), adj(adj_), wedges(wedges_), num_wedges(num_wedges_), seed(seed_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t s, size_t &closed) const{
+    Kokkos::Random_XorShift64<device_t> gen = KokkosKernels::Impl::kk_generator_stream<device_t>(seed, s);
+    const size_t w = size_t(gen.urand64() % num_wedges);
+
+    //the center is the last vertex whose first wedge is at most w.
+    nnz_lno_t lo = 0, hi = m;
+    while (hi - lo > 1){
+      const nnz_lno_t mid = lo + (hi - lo) / 2;
+      if (wedges(mid) <= w) lo = mid;
+      else hi = mid;
+    }
+    const size_type begin = xadj(lo);
+    const uint64_t d = xadj(lo + 1) - begin;
+    const uint64_t a = gen.urand64() % d;
+    uint64_t b = gen.urand64() % (d - 1);
+    if (b >= a) ++b;
+    const nnz_lno_t u = adj(begin + a), v = adj(begin + b);
+    if (find_in_sorted_row(adj, xadj(u), xadj(u + 1), v) != xadj(u + 1)) ++closed;
+  }
+};
+
+//! Sum of a view of counts.
+template <typename count_view_t>
+struct CountSum{
+  count_view_t counts;
+  CountSum(count_view_t counts_): counts(counts_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i, size_t &sum) const{
+    sum += counts(i);
+  }
+};
+
+/*! \brief Builds the monochromatic subgraph of the sorted graph (xadj, sorted_adj) for
+ * num_colors colors, see MonochromaticSubgraph.
+ *
+ * \return the number of entries of the subgraph.
+ */
+template <typename MyExecSpace, typename row_map_t, typename entries_t,
+          typename out_row_map_t, typename out_entries_t>
+size_t monochromatic_subgraph(
+    typename entries_t::non_const_value_type m,
+    row_map_t xadj,
+    entries_t sorted_adj,
+    uint64_t num_colors,
+    uint64_t seed,
+    out_row_map_t &out_xadj,
+    out_entries_t &out_adj){
+
+  typedef MonochromaticSubgraph<row_map_t, entries_t, out_row_map_t, out_entries_t> subgraph_t;
+  typedef typename subgraph_t::CountTag CountTag;
+  typedef typename subgraph_t::FillTag FillTag;
+
+  out_xadj = out_row_map_t("subgraph row map", m + 1);
+  subgraph_t subgraph(m, xadj, sorted_adj, out_xadj, out_entries_t(), num_colors, seed);
+  Kokkos::parallel_for("KokkosGraph::MonochromaticSubgraph::Count",
+      Kokkos::RangePolicy<MyExecSpace, CountTag>(0, m), subgraph);
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<out_row_map_t, MyExecSpace>(m + 1, out_xadj);
+
+  typename out_row_map_t::value_type nnz = 0;
+  Kokkos::deep_copy(nnz, Kokkos::subview(out_xadj, m));
+  out_adj = out_entries_t(Kokkos::ViewAllocateWithoutInitializing("subgraph entries"), nnz);
+  subgraph.out_adj = out_adj;
+  Kokkos::parallel_for("KokkosGraph::MonochromaticSubgraph::Fill",
+      Kokkos::RangePolicy<MyExecSpace, FillTag>(0, m), subgraph);
+  MyExecSpace::fence();
+  return nnz;
+}
+
+/*! \brief Estimates the triangles of a symmetric graph from uniformly sampled wedges.
+ *
+ * With W wedges of which a fraction p is closed, the graph has p W / 3 triangles.
+ * p is estimated from num_samples wedges, its standard error is sqrt(p (1 - p) / S).
+ */
+template <typename KernelHandle, typename row_map_t, typename entries_t>
+TriangleCountEstimate triangle_count_wedge_sampling(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    row_map_t row_map,
+    entries_t entries,
+    size_t num_samples,
+    uint64_t seed){
+
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::HandleTempMemorySpace MyTempMemorySpace;
+  typedef typename row_map_t::non_const_type out_row_map_t;
+  typedef typename entries_t::non_const_type out_entries_t;
+  typedef Kokkos::View<size_t *, MyTempMemorySpace> wedge_view_t;
+
+  TriangleCountEstimate estimate;
+  if (m == 0 || num_samples == 0) return estimate;
+
+  out_entries_t sorted_adj(Kokkos::ViewAllocateWithoutInitializing("sorted entries"), entries.extent(0));
+  out_entries_t null_values;
+  KokkosKernels::Impl::kk_sort_graph
+      <row_map_t, entries_t, out_entries_t, out_entries_t, out_entries_t, MyExecSpace>
+      (row_map, entries, null_values, sorted_adj, null_values);
+  out_row_map_t xadj;
+  out_entries_t adj;
+  monochromatic_subgraph<MyExecSpace>(m, row_map, sorted_adj, 1, seed, xadj, adj);
+
+  wedge_view_t wedges("wedges", m + 1);
+  Kokkos::parallel_for("KokkosGraph::WedgeCount", Kokkos::RangePolicy<MyExecSpace>(0, m),
+      WedgeCount<out_row_map_t, wedge_view_t>(xadj, wedges));
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<wedge_view_t, MyExecSpace>(m + 1, wedges);
+  size_t num_wedges = 0;
+  Kokkos::deep_copy(num_wedges, Kokkos::subview(wedges, m));
+  if (num_wedges == 0){
+    estimate.num_samples = num_samples;
+    return estimate;
+  }
+
+  size_t closed = 0;
+  Kokkos::parallel_reduce("KokkosGraph::WedgeSampling", Kokkos::RangePolicy<MyExecSpace>(0, num_samples),
+      WedgeSampling<out_row_map_t, out_entries_t, wedge_view_t>(m, xadj, adj, wedges, num_wedges, seed), closed);
+
+  const double p = double(closed) / double(num_samples);
+  const double scale = double(num_wedges) / 3;
+  estimate.set(p * scale, scale * std::sqrt(p * (1 - p) / double(num_samples)), num_samples);
+  return estimate;
+}
+
+/*! \brief Estimates the triangles of a symmetric graph by colorful counting.
+ *
+ * Each trial colors the vertices with N colors, counts the triangles T' of its
+ * monochromatic subgraph exactly with triangle_support, and estimates N^2 T'.
+ * N is chosen so that the trials keep about sample_budget entries in total; it
+ * is 1, and the count exact, when the budget covers every trial of the whole graph.
+ * The standard error is the deviation of the trials over sqrt(num_trials).
+ */
+template <typename KernelHandle, typename row_map_t, typename entries_t>
+TriangleCountEstimate triangle_count_colorful(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    row_map_t row_map,
+    entries_t entries,
+    size_t sample_budget,
+    int num_trials,
+    uint64_t seed){
+
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::HandleTempMemorySpace MyTempMemorySpace;
+  typedef typename row_map_t::non_const_type out_row_map_t;
+  typedef typename entries_t::non_const_type out_entries_t;
+  typedef Kokkos::View<size_t *, MyTempMemorySpace> count_view_t;
+
+  TriangleCountEstimate estimate;
+  if (m == 0) return estimate;
+  if (num_trials < 1) num_trials = 1;
+
+  const size_t nnz = entries.extent(0);
+  uint64_t num_colors = 1;
+  if (sample_budget > 0 && nnz * num_trials > sample_budget) num_colors = (nnz * num_trials) / sample_budget;
+
+  out_entries_t sorted_adj(Kokkos::ViewAllocateWithoutInitializing("sorted entries"), nnz);
+  out_entries_t null_values;
+  KokkosKernels::Impl::kk_sort_graph
+      <row_map_t, entries_t, out_entries_t, out_entries_t, out_entries_t, MyExecSpace>
+      (row_map, entries, null_values, sorted_adj, null_values);
+
+  //a single color gives the same subgraph for every trial.
+  if (num_colors == 1) num_trials = 1;
+  count_view_t vertex_triangles("vertex triangles", m);
+  std::vector<double> trials(num_trials);
+  size_t num_samples = 0;
+  for (int t = 0; t < num_trials; ++t){
+    out_row_map_t xadj;
+    out_entries_t adj;
+    num_samples += monochromatic_subgraph<MyExecSpace>(m, row_map, sorted_adj, num_colors,
+        KokkosKernels::Impl::kk_hash_mix(seed + t), xadj, adj);
+    Kokkos::deep_copy(vertex_triangles, size_t(0));
+    triangle_support(handle, m, xadj, adj, count_view_t(), vertex_triangles, false, true, true);
+    size_t sum = 0;
+    Kokkos::parallel_reduce("KokkosGraph::TriangleColorful::Sum", Kokkos::RangePolicy<MyExecSpace>(0, m),
+        CountSum<count_view_t>(vertex_triangles), sum);
+    trials[t] = double(num_colors) * double(num_colors) * double(sum / 3);
+  }
+
+  double mean = 0, var = 0;
+  for (int t = 0; t < num_trials; ++t) mean += trials[t];
+  mean /= num_trials;
+  for (int t = 0; t < num_trials; ++t) var += (trials[t] - mean) * (trials[t] - mean);
+  const double std_error = num_trials > 1 ? std::sqrt(var / (num_trials - 1) / num_trials) : 0;
+  estimate.set(mean, std_error, num_samples);
+  return estimate;
+}
+
+}
+}
+}
+#endif
@@ -58,6 +58,23 @@ struct GetUnifiedLayout {
        ,Kokkos::LayoutLeft,typename ViewType::array_layout>::type array_layout;
 };
 
+// Scalar type in which mixed-precision BLAS 1 kernels combine entries
+// of types T1 and T2: double for float and double, otherwise T1.
+template<class T1, class T2>
+struct GetMixedScalarType {
+  typedef T1 type;
+};
+
+template<>
+struct GetMixedScalarType<float,double> {
+  typedef double type;
+};
+
+template<>
+struct GetMixedScalarType<double,float> {
+  typedef double type;
+};
+
 template<class T, class TX, bool do_const, bool isView = Kokkos::is_view<T>::value>
 struct GetUnifiedScalarViewType {
   typedef typename TX::non_const_value_type type;
@@ -79,6 +96,33 @@ struct GetUnifiedScalarViewType<T,TX,true,true> {
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > type;
 };
 
+// Whether T is a rank-0 View, i.e., a single (possibly device
+// resident) coefficient.
+template<class T, bool isView = Kokkos::is_view<T>::value>
+struct IsRank0View {
+  enum : bool { value = false };
+};
+
+template<class T>
+struct IsRank0View<T,true> {
+  enum : bool { value = (T::rank == 0) };
+};
+
+// Convert a coefficient to its GetUnifiedScalarViewType.  A rank-0
+// View becomes a rank-1 View of length one over the same value, so
+// the kernels read it as a(0) without copying it to the host.
+template<class ScalarViewType, class T>
+typename std::enable_if<IsRank0View<T>::value, ScalarViewType>::type
+get_unified_scalar_view (const T& a) {
+  return ScalarViewType (a.data (), 1);
+}
+
+template<class ScalarViewType, class T>
+typename std::enable_if<! IsRank0View<T>::value, ScalarViewType>::type
+get_unified_scalar_view (const T& a) {
+  return a;
+}
+
 }
 }
 #endif
@@ -89,14 +89,14 @@ struct Axpby< \
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > YV; \
 \
   static void \
-  axpby (const AV& alpha, const XV& X, const BV& beta, const YV& Y) { \
+  axpby (const ExecSpace& space, const AV& alpha, const XV& X, const BV& beta, const YV& Y) { \
     if((X.extent(0) < INT_MAX) && (beta == 1.0)) { \
       axpby_print_specialization<AV,XV,BV,YV>(); \
       int N = X.extent(0); \
       int one = 1; \
       daxpy_(&N,&alpha,X.data(),&one,Y.data(),&one); \
     } else \
-      Axpby<AV,XV,BV,YV,YV::Rank,false,ETI_SPEC_AVAIL>::axpby(alpha,X,beta,Y); \
+      Axpby<AV,XV,BV,YV,YV::Rank,false,ETI_SPEC_AVAIL>::axpby(space,alpha,X,beta,Y); \
   } \
 };
 
@@ -119,14 +119,14 @@ struct Axpby< \
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > YV; \
 \
   static void \
-  axpby (const AV& alpha, const XV& X, const BV& beta, const YV& Y) { \
+  axpby (const ExecSpace& space, const AV& alpha, const XV& X, const BV& beta, const YV& Y) { \
     if((X.extent(0) < INT_MAX) && (beta == 1.0f)) { \
       axpby_print_specialization<AV,XV,BV,YV>(); \
       int N = X.extent(0); \
       int one = 1; \
       saxpy_(&N,&alpha,X.data(),&one,Y.data(),&one); \
     } else \
-      Axpby<AV,XV,BV,YV,YV::Rank,false,ETI_SPEC_AVAIL>::axpby(alpha,X,beta,Y); \
+      Axpby<AV,XV,BV,YV,YV::Rank,false,ETI_SPEC_AVAIL>::axpby(space,alpha,X,beta,Y); \
   } \
 };
 
@@ -148,7 +148,7 @@ struct Axpby< \
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > YV; \
 \
   static void \
-  axpby (const AV& alpha, const XV& X, const BV& beta, const YV& Y) { \
+  axpby (const ExecSpace& space, const AV& alpha, const XV& X, const BV& beta, const YV& Y) { \
     if((X.extent(0) < INT_MAX) && (beta == 1.0f)) { \
       axpby_print_specialization<AV,XV,BV,YV>(); \
       int N = X.extent(0); \
@@ -157,7 +157,7 @@ struct Axpby< \
                 reinterpret_cast<const std::complex<double>* >(X.data()),&one, \
                 reinterpret_cast<std::complex<double>* >(Y.data()),&one); \
     } else \
-      Axpby<AV,XV,BV,YV,YV::Rank,false,ETI_SPEC_AVAIL>::axpby(alpha,X,beta,Y); \
+      Axpby<AV,XV,BV,YV,YV::Rank,false,ETI_SPEC_AVAIL>::axpby(space,alpha,X,beta,Y); \
   } \
 };
 
@@ -179,7 +179,7 @@ struct Axpby< \
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > YV; \
 \
   static void \
-  axpby (const AV& alpha, const XV& X, const BV& beta, const YV& Y) { \
+  axpby (const ExecSpace& space, const AV& alpha, const XV& X, const BV& beta, const YV& Y) { \
     if((X.extent(0) < INT_MAX) && (beta == 1.0f)) { \
       axpby_print_specialization<AV,XV,BV,YV>(); \
       int N = X.extent(0); \
@@ -188,7 +188,7 @@ struct Axpby< \
                 reinterpret_cast<const std::complex<float>* >(X.data()),&one, \
                 reinterpret_cast<std::complex<float>* >(Y.data()),&one); \
     } else \
-      Axpby<AV,XV,BV,YV,YV::Rank,false,ETI_SPEC_AVAIL>::axpby(alpha,X,beta,Y); \
+      Axpby<AV,XV,BV,YV,YV::Rank,false,ETI_SPEC_AVAIL>::axpby(space,alpha,X,beta,Y); \
   } \
 };
 
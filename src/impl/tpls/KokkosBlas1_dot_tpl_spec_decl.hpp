@@ -86,7 +86,7 @@ Kokkos::View<const double*, LAYOUT, Kokkos::Device<ExecSpace, MEMSPACE>, \
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > XV; \
   typedef typename XV::size_type size_type; \
   \
-  static void dot (RV& R, const XV& X, const XV& Y) \
+  static void dot (const ExecSpace& space, RV& R, const XV& X, const XV& Y) \
   { \
     const size_type numElems = X.extent(0); \
     if (numElems < static_cast<size_type> (INT_MAX)) { \
@@ -95,7 +95,7 @@ Kokkos::View<const double*, LAYOUT, Kokkos::Device<ExecSpace, MEMSPACE>, \
       int one = 1; \
       R() = ddot_(&N,X.data(),&one,Y.data(),&one); \
     } else { \
-      Dot<RV,XV,XV,1,1,false,ETI_SPEC_AVAIL>::dot(R,X,Y); \
+      Dot<RV,XV,XV,1,1,false,ETI_SPEC_AVAIL>::dot(space,R,X,Y); \
     } \
   } \
 };
@@ -117,7 +117,7 @@ Kokkos::View<const float*, LAYOUT, Kokkos::Device<ExecSpace, MEMSPACE>, \
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > XV; \
   typedef typename XV::size_type size_type; \
   \
-  static void dot (RV& R, const XV& X, const XV& Y) \
+  static void dot (const ExecSpace& space, RV& R, const XV& X, const XV& Y) \
   { \
     const size_type numElems = X.extent(0); \
     if (numElems < static_cast<size_type> (INT_MAX)) { \
@@ -126,7 +126,7 @@ Kokkos::View<const float*, LAYOUT, Kokkos::Device<ExecSpace, MEMSPACE>, \
       int one = 1; \
       R() = sdot_(&N,X.data(),&one,Y.data(),&one); \
     } else { \
-      Dot<RV,XV,XV,1,1,false,ETI_SPEC_AVAIL>::dot(R,X,Y); \
+      Dot<RV,XV,XV,1,1,false,ETI_SPEC_AVAIL>::dot(space,R,X,Y); \
     } \
   } \
 };
@@ -148,7 +148,7 @@ Kokkos::View<const Kokkos::complex<double>*, LAYOUT, Kokkos::Device<ExecSpace, M
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > XV; \
   typedef typename XV::size_type size_type; \
   \
-  static void dot (RV& R, const XV& X, const XV& Y) \
+  static void dot (const ExecSpace& space, RV& R, const XV& X, const XV& Y) \
   { \
     const size_type numElems = X.extent(0); \
     if (numElems < static_cast<size_type> (INT_MAX)) { \
@@ -158,7 +158,7 @@ Kokkos::View<const Kokkos::complex<double>*, LAYOUT, Kokkos::Device<ExecSpace, M
       R() = zdotu_(&N,reinterpret_cast<const std::complex<double>* >(X.data()),&one, \
                      reinterpret_cast<const std::complex<double>* >(Y.data()),&one); \
     } else { \
-      Dot<RV,XV,XV,1,1,false,ETI_SPEC_AVAIL>::dot(R,X,Y); \
+      Dot<RV,XV,XV,1,1,false,ETI_SPEC_AVAIL>::dot(space,R,X,Y); \
     } \
   } \
 };
@@ -180,7 +180,7 @@ Kokkos::View<const Kokkos::complex<float>*, LAYOUT, Kokkos::Device<ExecSpace, ME
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > XV; \
   typedef typename XV::size_type size_type; \
   \
-  static void dot (RV& R, const XV& X, const XV& Y) \
+  static void dot (const ExecSpace& space, RV& R, const XV& X, const XV& Y) \
   { \
     const size_type numElems = X.extent(0); \
     if (numElems < static_cast<size_type> (INT_MAX)) { \
@@ -190,7 +190,7 @@ Kokkos::View<const Kokkos::complex<float>*, LAYOUT, Kokkos::Device<ExecSpace, ME
       R() = cdotu_(&N,reinterpret_cast<const std::complex<float>* >(X.data()),&one, \
                      reinterpret_cast<const std::complex<float>* >(Y.data()),&one); \
     } else { \
-      Dot<RV,XV,XV,1,1,false,ETI_SPEC_AVAIL>::dot(R,X,Y); \
+      Dot<RV,XV,XV,1,1,false,ETI_SPEC_AVAIL>::dot(space,R,X,Y); \
     } \
   } \
 };
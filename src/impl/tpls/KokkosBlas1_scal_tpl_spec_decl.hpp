@@ -86,7 +86,7 @@ Kokkos::View<const double*, LAYOUT, Kokkos::Device<ExecSpace, MEMSPACE>, \
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > XV; \
   typedef typename XV::size_type size_type; \
   \
-  static void scal (const RV& R, const double& alpha, const XV& X) \
+  static void scal (const ExecSpace& space, const RV& R, const double& alpha, const XV& X) \
   { \
     const size_type numElems = X.extent(0); \
     if ((numElems < static_cast<size_type> (INT_MAX)) && (R.data() == X.data())) { \
@@ -95,7 +95,7 @@ Kokkos::View<const double*, LAYOUT, Kokkos::Device<ExecSpace, MEMSPACE>, \
       int one = 1; \
       dscal_(&N,&alpha,X.data(),&one); \
     } else { \
-      Scal<RV,AV,XV,1,false,ETI_SPEC_AVAIL>::scal(R,alpha,X); \
+      Scal<RV,AV,XV,1,false,ETI_SPEC_AVAIL>::scal(space,R,alpha,X); \
     } \
   } \
 };
@@ -117,7 +117,7 @@ Kokkos::View<const float*, LAYOUT, Kokkos::Device<ExecSpace, MEMSPACE>, \
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > XV; \
   typedef typename XV::size_type size_type; \
   \
-  static void scal (const RV& R, const float& alpha, const XV& X) \
+  static void scal (const ExecSpace& space, const RV& R, const float& alpha, const XV& X) \
   { \
     const size_type numElems = X.extent(0); \
     if ((numElems < static_cast<size_type> (INT_MAX)) && (R.data() == X.data())) { \
@@ -126,7 +126,7 @@ Kokkos::View<const float*, LAYOUT, Kokkos::Device<ExecSpace, MEMSPACE>, \
       int one = 1; \
       sscal_(&N,&alpha,X.data(),&one); \
     } else { \
-      Scal<RV,AV,XV,1,false,ETI_SPEC_AVAIL>::scal(R,alpha,X); \
+      Scal<RV,AV,XV,1,false,ETI_SPEC_AVAIL>::scal(space,R,alpha,X); \
     } \
   } \
 };
@@ -148,7 +148,7 @@ Kokkos::View<const Kokkos::complex<double>*, LAYOUT, Kokkos::Device<ExecSpace, M
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > XV; \
   typedef typename XV::size_type size_type; \
   \
-  static void scal (const RV& R, const Kokkos::complex<double>& alpha, const XV& X) \
+  static void scal (const ExecSpace& space, const RV& R, const Kokkos::complex<double>& alpha, const XV& X) \
   { \
     const size_type numElems = X.extent(0); \
     if ((numElems < static_cast<size_type> (INT_MAX)) && (R.data() == X.data())) { \
@@ -157,7 +157,7 @@ Kokkos::View<const Kokkos::complex<double>*, LAYOUT, Kokkos::Device<ExecSpace, M
       int one = 1; \
       zscal_(&N,reinterpret_cast<const std::complex<double>*>(&alpha),reinterpret_cast<std::complex<double>*>(R.data()),&one); \
     } else { \
-      Scal<RV,AV,XV,1,false,ETI_SPEC_AVAIL>::scal(R,alpha,X); \
+      Scal<RV,AV,XV,1,false,ETI_SPEC_AVAIL>::scal(space,R,alpha,X); \
     } \
   } \
 };
@@ -179,7 +179,7 @@ Kokkos::View<const Kokkos::complex<float>*, LAYOUT, Kokkos::Device<ExecSpace, ME
                        Kokkos::MemoryTraits<Kokkos::Unmanaged> > XV; \
   typedef typename XV::size_type size_type; \
   \
-  static void scal (const RV& R, const Kokkos::complex<float>& alpha, const XV& X) \
+  static void scal (const ExecSpace& space, const RV& R, const Kokkos::complex<float>& alpha, const XV& X) \
   { \
     const size_type numElems = X.extent(0); \
     if ((numElems < static_cast<size_type> (INT_MAX)) && (R.data() == X.data())) { \
@@ -188,7 +188,7 @@ Kokkos::View<const Kokkos::complex<float>*, LAYOUT, Kokkos::Device<ExecSpace, ME
       int one = 1; \
       cscal_(&N,reinterpret_cast<const std::complex<float>*>(&alpha),reinterpret_cast<std::complex<float>*>(R.data()),&one); \
     } else { \
-      Scal<RV,AV,XV,1,false,ETI_SPEC_AVAIL>::scal(R,alpha,X); \
+      Scal<RV,AV,XV,1,false,ETI_SPEC_AVAIL>::scal(space,R,alpha,X); \
     } \
   } \
 };
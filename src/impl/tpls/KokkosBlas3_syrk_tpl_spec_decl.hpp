@@ -0,0 +1,333 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSBLAS3_SYRK_TPL_SPEC_DECL_HPP_
+#define KOKKOSBLAS3_SYRK_TPL_SPEC_DECL_HPP_
+
+#include<KokkosBlas_tpl_spec.hpp>
+
+#ifdef KOKKOSKERNELS_ENABLE_TPL_BLAS
+extern "C" void dsyrk_( const char* uplo, const char* trans,
+                        const int* N, const int* K,
+                        const double* alpha,
+                        const double* A, const int* LDA,
+                        const double* beta,
+                        double* C, const int* LDC);
+extern "C" void ssyrk_( const char* uplo, const char* trans,
+                        const int* N, const int* K,
+                        const float* alpha,
+                        const float* A, const int* LDA,
+                        const float* beta,
+                        float* C, const int* LDC);
+extern "C" void zsyrk_( const char* uplo, const char* trans,
+                        const int* N, const int* K,
+                        const std::complex<double>* alpha,
+                        const std::complex<double>* A, const int* LDA,
+                        const std::complex<double>* beta,
+                        std::complex<double>* C, const int* LDC);
+extern "C" void csyrk_( const char* uplo, const char* trans,
+                        const int* N, const int* K,
+                        const std::complex<float>* alpha,
+                        const std::complex<float>* A, const int* LDA,
+                        const std::complex<float>* beta,
+                        std::complex<float>* C, const int* LDC);
+extern "C" void zherk_( const char* uplo, const char* trans,
+                        const int* N, const int* K,
+                        const double* alpha,
+                        const std::complex<double>* A, const int* LDA,
+                        const double* beta,
+                        std::complex<double>* C, const int* LDC);
+extern "C" void cherk_( const char* uplo, const char* trans,
+                        const int* N, const int* K,
+                        const float* alpha,
+                        const std::complex<float>* A, const int* LDA,
+                        const float* beta,
+                        std::complex<float>* C, const int* LDC);
+
+namespace KokkosBlas {
+namespace Impl {
+
+// For real types the Hermitian update is the symmetric one
+inline void syrk_tpl_blas(const char* uplo, const char* trans, const bool /* herm */,
+                          const int* N, const int* K, const double* alpha,
+                          const double* A, const int* LDA,
+                          const double* beta, double* C, const int* LDC) {
+  dsyrk_(uplo,trans,N,K,alpha,A,LDA,beta,C,LDC);
+}
+inline void syrk_tpl_blas(const char* uplo, const char* trans, const bool /* herm */,
+                          const int* N, const int* K, const float* alpha,
+                          const float* A, const int* LDA,
+                          const float* beta, float* C, const int* LDC) {
+  ssyrk_(uplo,trans,N,K,alpha,A,LDA,beta,C,LDC);
+}
+inline void syrk_tpl_blas(const char* uplo, const char* trans, const bool herm,
+                          const int* N, const int* K, const Kokkos::complex<double>* alpha,
+                          const Kokkos::complex<double>* A, const int* LDA,
+                          const Kokkos::complex<double>* beta, Kokkos::complex<double>* C, const int* LDC) {
+  if(herm) {
+    const double alpha_r = alpha->real(), beta_r = beta->real();
+    zherk_(uplo,trans,N,K,&alpha_r,
+           reinterpret_cast<const std::complex<double>*>(A),LDA,
+           &beta_r,reinterpret_cast<std::complex<double>*>(C),LDC);
+  } else {
+    zsyrk_(uplo,trans,N,K,
+           reinterpret_cast<const std::complex<double>*>(alpha),
+           reinterpret_cast<const std::complex<double>*>(A),LDA,
+           reinterpret_cast<const std::complex<double>*>(beta),
+           reinterpret_cast<std::complex<double>*>(C),LDC);
+  }
+}
+inline void syrk_tpl_blas(const char* uplo, const char* trans, const bool herm,
+                          const int* N, const int* K, const Kokkos::complex<float>* alpha,
+                          const Kokkos::complex<float>* A, const int* LDA,
+                          const Kokkos::complex<float>* beta, Kokkos::complex<float>* C, const int* LDC) {
+  if(herm) {
+    const float alpha_r = alpha->real(), beta_r = beta->real();
+    cherk_(uplo,trans,N,K,&alpha_r,
+           reinterpret_cast<const std::complex<float>*>(A),LDA,
+           &beta_r,reinterpret_cast<std::complex<float>*>(C),LDC);
+  } else {
+    csyrk_(uplo,trans,N,K,
+           reinterpret_cast<const std::complex<float>*>(alpha),
+           reinterpret_cast<const std::complex<float>*>(A),LDA,
+           reinterpret_cast<const std::complex<float>*>(beta),
+           reinterpret_cast<std::complex<float>*>(C),LDC);
+  }
+}
+
+// A LayoutRight matrix is the transpose of a column major matrix, so the
+// LayoutRight update is the column major update of the other triangle with
+// the transpose mode of A flipped.
+#define KOKKOSBLAS3_SYRK_BLAS( SCALAR, LAYOUT, MEM_SPACE, ETI_SPEC_AVAIL ) \
+template<class ExecSpace> \
+struct SYRK< \
+     Kokkos::View<const SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+                  Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+     Kokkos::View<SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+                  Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+     true, ETI_SPEC_AVAIL> { \
+  typedef Kokkos::View<const SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+      Kokkos::MemoryTraits<Kokkos::Unmanaged> > AViewType; \
+  typedef Kokkos::View<SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+      Kokkos::MemoryTraits<Kokkos::Unmanaged> > CViewType; \
+ \
+  static void \
+  syrk (const char uplo[], \
+        const char trans[], \
+        const bool herm, \
+        typename AViewType::const_value_type& alpha, \
+        const AViewType& A, \
+        typename CViewType::const_value_type& beta, \
+        const CViewType& C) { \
+    \
+    Kokkos::Profiling::pushRegion("KokkosBlas::syrk[TPL_BLAS," #SCALAR "]"); \
+    const bool is_lr = std::is_same<Kokkos::LayoutRight,LAYOUT>::value; \
+    const bool is_lower = (uplo[0]=='L') || (uplo[0]=='l'); \
+    const bool A_t = (trans[0]!='N') && (trans[0]!='n'); \
+    const int N = C.extent(0); \
+    const int K = A.extent(A_t?0:1); \
+    int strides[2]; \
+    \
+    A.stride(strides); \
+    const int LDA = strides[is_lr?0:1] > 0 ? strides[is_lr?0:1] : 1; \
+    C.stride(strides); \
+    const int LDC = strides[is_lr?0:1]; \
+    \
+    const char uplo_blas = (is_lower != is_lr) ? 'L' : 'U'; \
+    const char trans_blas = is_lr ? (A_t ? 'N' : (herm ? 'C' : 'T')) : trans[0]; \
+    syrk_tpl_blas(&uplo_blas,&trans_blas,herm,&N,&K,&alpha,A.data(),&LDA,&beta,C.data(),&LDC); \
+    Kokkos::Profiling::popRegion(); \
+  } \
+};
+
+KOKKOSBLAS3_SYRK_BLAS( double,                  Kokkos::LayoutLeft,  Kokkos::HostSpace, true)
+KOKKOSBLAS3_SYRK_BLAS( double,                  Kokkos::LayoutLeft,  Kokkos::HostSpace, false)
+KOKKOSBLAS3_SYRK_BLAS( double,                  Kokkos::LayoutRight, Kokkos::HostSpace, true)
+KOKKOSBLAS3_SYRK_BLAS( double,                  Kokkos::LayoutRight, Kokkos::HostSpace, false)
+
+KOKKOSBLAS3_SYRK_BLAS( float,                   Kokkos::LayoutLeft,  Kokkos::HostSpace, true)
+KOKKOSBLAS3_SYRK_BLAS( float,                   Kokkos::LayoutLeft,  Kokkos::HostSpace, false)
+KOKKOSBLAS3_SYRK_BLAS( float,                   Kokkos::LayoutRight, Kokkos::HostSpace, true)
+KOKKOSBLAS3_SYRK_BLAS( float,                   Kokkos::LayoutRight, Kokkos::HostSpace, false)
+
+KOKKOSBLAS3_SYRK_BLAS( Kokkos::complex<double>, Kokkos::LayoutLeft,  Kokkos::HostSpace, true)
+KOKKOSBLAS3_SYRK_BLAS( Kokkos::complex<double>, Kokkos::LayoutLeft,  Kokkos::HostSpace, false)
+KOKKOSBLAS3_SYRK_BLAS( Kokkos::complex<double>, Kokkos::LayoutRight, Kokkos::HostSpace, true)
+KOKKOSBLAS3_SYRK_BLAS( Kokkos::complex<double>, Kokkos::LayoutRight, Kokkos::HostSpace, false)
+
+KOKKOSBLAS3_SYRK_BLAS( Kokkos::complex<float>,  Kokkos::LayoutLeft,  Kokkos::HostSpace, true)
+KOKKOSBLAS3_SYRK_BLAS( Kokkos::complex<float>,  Kokkos::LayoutLeft,  Kokkos::HostSpace, false)
+KOKKOSBLAS3_SYRK_BLAS( Kokkos::complex<float>,  Kokkos::LayoutRight, Kokkos::HostSpace, true)
+KOKKOSBLAS3_SYRK_BLAS( Kokkos::complex<float>,  Kokkos::LayoutRight, Kokkos::HostSpace, false)
+
+}
+}
+#endif // KOKKOSKERNELS_ENABLE_TPL_BLAS
+
+// cuBLAS
+#ifdef KOKKOSKERNELS_ENABLE_TPL_CUBLAS
+
+namespace KokkosBlas {
+namespace Impl {
+
+inline cublasStatus_t syrk_tpl_cublas(cublasHandle_t handle, cublasFillMode_t uplo,
+                                      cublasOperation_t trans, const bool /* herm */,
+                                      const int N, const int K, const double* alpha,
+                                      const double* A, const int LDA,
+                                      const double* beta, double* C, const int LDC) {
+  return cublasDsyrk(handle,uplo,(trans == CUBLAS_OP_C ? CUBLAS_OP_T : trans),N,K,alpha,A,LDA,beta,C,LDC);
+}
+inline cublasStatus_t syrk_tpl_cublas(cublasHandle_t handle, cublasFillMode_t uplo,
+                                      cublasOperation_t trans, const bool /* herm */,
+                                      const int N, const int K, const float* alpha,
+                                      const float* A, const int LDA,
+                                      const float* beta, float* C, const int LDC) {
+  return cublasSsyrk(handle,uplo,(trans == CUBLAS_OP_C ? CUBLAS_OP_T : trans),N,K,alpha,A,LDA,beta,C,LDC);
+}
+inline cublasStatus_t syrk_tpl_cublas(cublasHandle_t handle, cublasFillMode_t uplo,
+                                      cublasOperation_t trans, const bool herm,
+                                      const int N, const int K, const Kokkos::complex<double>* alpha,
+                                      const Kokkos::complex<double>* A, const int LDA,
+                                      const Kokkos::complex<double>* beta, Kokkos::complex<double>* C, const int LDC) {
+  if(herm) {
+    const double alpha_r = alpha->real(), beta_r = beta->real();
+    return cublasZherk(handle,uplo,trans,N,K,&alpha_r,
+                       reinterpret_cast<const cuDoubleComplex*>(A),LDA,
+                       &beta_r,reinterpret_cast<cuDoubleComplex*>(C),LDC);
+  }
+  return cublasZsyrk(handle,uplo,trans,N,K,
+                     reinterpret_cast<const cuDoubleComplex*>(alpha),
+                     reinterpret_cast<const cuDoubleComplex*>(A),LDA,
+                     reinterpret_cast<const cuDoubleComplex*>(beta),
+                     reinterpret_cast<cuDoubleComplex*>(C),LDC);
+}
+inline cublasStatus_t syrk_tpl_cublas(cublasHandle_t handle, cublasFillMode_t uplo,
+                                      cublasOperation_t trans, const bool herm,
+                                      const int N, const int K, const Kokkos::complex<float>* alpha,
+                                      const Kokkos::complex<float>* A, const int LDA,
+                                      const Kokkos::complex<float>* beta, Kokkos::complex<float>* C, const int LDC) {
+  if(herm) {
+    const float alpha_r = alpha->real(), beta_r = beta->real();
+    return cublasCherk(handle,uplo,trans,N,K,&alpha_r,
+                       reinterpret_cast<const cuComplex*>(A),LDA,
+                       &beta_r,reinterpret_cast<cuComplex*>(C),LDC);
+  }
+  return cublasCsyrk(handle,uplo,trans,N,K,
+                     reinterpret_cast<const cuComplex*>(alpha),
+                     reinterpret_cast<const cuComplex*>(A),LDA,
+                     reinterpret_cast<const cuComplex*>(beta),
+                     reinterpret_cast<cuComplex*>(C),LDC);
+}
+
+#define KOKKOSBLAS3_SYRK_CUBLAS( SCALAR, LAYOUT, MEM_SPACE, ETI_SPEC_AVAIL ) \
+template<class ExecSpace> \
+struct SYRK< \
+     Kokkos::View<const SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+                  Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+     Kokkos::View<SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+                  Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+     true, ETI_SPEC_AVAIL> { \
+  typedef Kokkos::View<const SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+      Kokkos::MemoryTraits<Kokkos::Unmanaged> > AViewType; \
+  typedef Kokkos::View<SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+      Kokkos::MemoryTraits<Kokkos::Unmanaged> > CViewType; \
+ \
+  static void \
+  syrk (const char uplo[], \
+        const char trans[], \
+        const bool herm, \
+        typename AViewType::const_value_type& alpha, \
+        const AViewType& A, \
+        typename CViewType::const_value_type& beta, \
+        const CViewType& C) { \
+    \
+    Kokkos::Profiling::pushRegion("KokkosBlas::syrk[TPL_CUBLAS," #SCALAR "]"); \
+    const bool is_lr = std::is_same<Kokkos::LayoutRight,LAYOUT>::value; \
+    const bool is_lower = (uplo[0]=='L') || (uplo[0]=='l'); \
+    const bool A_t = (trans[0]!='N') && (trans[0]!='n'); \
+    const int N = C.extent(0); \
+    const int K = A.extent(A_t?0:1); \
+    int strides[2]; \
+    \
+    A.stride(strides); \
+    const int LDA = strides[is_lr?0:1] > 0 ? strides[is_lr?0:1] : 1; \
+    C.stride(strides); \
+    const int LDC = strides[is_lr?0:1]; \
+    \
+    const char uplo_blas[] = { (is_lower != is_lr) ? 'L' : 'U', '\0' }; \
+    const char trans_blas[] = { is_lr ? (A_t ? 'N' : (herm ? 'C' : 'T')) : trans[0], '\0' }; \
+    CudaBlasSingleton & s = CudaBlasSingleton::singleton(); \
+    cublas_check_status(syrk_tpl_cublas(s.handle, \
+                                        uplo_mode_kk_to_cublas(uplo_blas), \
+                                        trans_mode_kk_to_cublas(trans_blas), \
+                                        herm,N,K,&alpha,A.data(),LDA,&beta,C.data(),LDC), \
+                        "KokkosBlas::syrk"); \
+    Kokkos::Profiling::popRegion(); \
+  } \
+};
+
+KOKKOSBLAS3_SYRK_CUBLAS( double,                  Kokkos::LayoutLeft,  Kokkos::CudaSpace, true)
+KOKKOSBLAS3_SYRK_CUBLAS( double,                  Kokkos::LayoutLeft,  Kokkos::CudaSpace, false)
+KOKKOSBLAS3_SYRK_CUBLAS( double,                  Kokkos::LayoutRight, Kokkos::CudaSpace, true)
+KOKKOSBLAS3_SYRK_CUBLAS( double,                  Kokkos::LayoutRight, Kokkos::CudaSpace, false)
+
+KOKKOSBLAS3_SYRK_CUBLAS( float,                   Kokkos::LayoutLeft,  Kokkos::CudaSpace, true)
+KOKKOSBLAS3_SYRK_CUBLAS( float,                   Kokkos::LayoutLeft,  Kokkos::CudaSpace, false)
+KOKKOSBLAS3_SYRK_CUBLAS( float,                   Kokkos::LayoutRight, Kokkos::CudaSpace, true)
+KOKKOSBLAS3_SYRK_CUBLAS( float,                   Kokkos::LayoutRight, Kokkos::CudaSpace, false)
+
+KOKKOSBLAS3_SYRK_CUBLAS( Kokkos::complex<double>, Kokkos::LayoutLeft,  Kokkos::CudaSpace, true)
+KOKKOSBLAS3_SYRK_CUBLAS( Kokkos::complex<double>, Kokkos::LayoutLeft,  Kokkos::CudaSpace, false)
+KOKKOSBLAS3_SYRK_CUBLAS( Kokkos::complex<double>, Kokkos::LayoutRight, Kokkos::CudaSpace, true)
+KOKKOSBLAS3_SYRK_CUBLAS( Kokkos::complex<double>, Kokkos::LayoutRight, Kokkos::CudaSpace, false)
+
+KOKKOSBLAS3_SYRK_CUBLAS( Kokkos::complex<float>,  Kokkos::LayoutLeft,  Kokkos::CudaSpace, true)
+KOKKOSBLAS3_SYRK_CUBLAS( Kokkos::complex<float>,  Kokkos::LayoutLeft,  Kokkos::CudaSpace, false)
+KOKKOSBLAS3_SYRK_CUBLAS( Kokkos::complex<float>,  Kokkos::LayoutRight, Kokkos::CudaSpace, true)
+KOKKOSBLAS3_SYRK_CUBLAS( Kokkos::complex<float>,  Kokkos::LayoutRight, Kokkos::CudaSpace, false)
+
+}
+}
+#endif // KOKKOSKERNELS_ENABLE_TPL_CUBLAS
+
+#endif
@@ -0,0 +1,284 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSBLAS3_TRSM_TPL_SPEC_DECL_HPP_
+#define KOKKOSBLAS3_TRSM_TPL_SPEC_DECL_HPP_
+
+#include<KokkosBlas_tpl_spec.hpp>
+
+#ifdef KOKKOSKERNELS_ENABLE_TPL_BLAS
+extern "C" void dtrsm_( const char* side, const char* uplo,
+                        const char* transA, const char* diag,
+                        const int* M, const int* N,
+                        const double* alpha,
+                        const double* A, const int* LDA,
+                        double* B, const int* LDB);
+extern "C" void strsm_( const char* side, const char* uplo,
+                        const char* transA, const char* diag,
+                        const int* M, const int* N,
+                        const float* alpha,
+                        const float* A, const int* LDA,
+                        float* B, const int* LDB);
+extern "C" void ztrsm_( const char* side, const char* uplo,
+                        const char* transA, const char* diag,
+                        const int* M, const int* N,
+                        const std::complex<double>* alpha,
+                        const std::complex<double>* A, const int* LDA,
+                        std::complex<double>* B, const int* LDB);
+extern "C" void ctrsm_( const char* side, const char* uplo,
+                        const char* transA, const char* diag,
+                        const int* M, const int* N,
+                        const std::complex<float>* alpha,
+                        const std::complex<float>* A, const int* LDA,
+                        std::complex<float>* B, const int* LDB);
+
+namespace KokkosBlas {
+namespace Impl {
+
+inline void trsm_tpl_blas(const char* side, const char* uplo, const char* transA, const char* diag,
+                          const int* M, const int* N, const double* alpha,
+                          const double* A, const int* LDA, double* B, const int* LDB) {
+  dtrsm_(side,uplo,transA,diag,M,N,alpha,A,LDA,B,LDB);
+}
+inline void trsm_tpl_blas(const char* side, const char* uplo, const char* transA, const char* diag,
+                          const int* M, const int* N, const float* alpha,
+                          const float* A, const int* LDA, float* B, const int* LDB) {
+  strsm_(side,uplo,transA,diag,M,N,alpha,A,LDA,B,LDB);
+}
+inline void trsm_tpl_blas(const char* side, const char* uplo, const char* transA, const char* diag,
+                          const int* M, const int* N, const Kokkos::complex<double>* alpha,
+                          const Kokkos::complex<double>* A, const int* LDA, Kokkos::complex<double>* B, const int* LDB) {
+  ztrsm_(side,uplo,transA,diag,M,N,
+         reinterpret_cast<const std::complex<double>*>(alpha),
+         reinterpret_cast<const std::complex<double>*>(A),LDA,
+         reinterpret_cast<std::complex<double>*>(B),LDB);
+}
+inline void trsm_tpl_blas(const char* side, const char* uplo, const char* transA, const char* diag,
+                          const int* M, const int* N, const Kokkos::complex<float>* alpha,
+                          const Kokkos::complex<float>* A, const int* LDA, Kokkos::complex<float>* B, const int* LDB) {
+  ctrsm_(side,uplo,transA,diag,M,N,
+         reinterpret_cast<const std::complex<float>*>(alpha),
+         reinterpret_cast<const std::complex<float>*>(A),LDA,
+         reinterpret_cast<std::complex<float>*>(B),LDB);
+}
+
+// A LayoutRight matrix is the transpose of a column major matrix, so the
+// LayoutRight solve is the column major solve with side and uplo swapped
+// and the dimensions of B exchanged.
+#define KOKKOSBLAS3_TRSM_BLAS( SCALAR, LAYOUT, MEM_SPACE, ETI_SPEC_AVAIL ) \
+template<class ExecSpace> \
+struct TRSM< \
+     Kokkos::View<const SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+                  Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+     Kokkos::View<SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+                  Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+     true, ETI_SPEC_AVAIL> { \
+  typedef Kokkos::View<const SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+      Kokkos::MemoryTraits<Kokkos::Unmanaged> > AViewType; \
+  typedef Kokkos::View<SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+      Kokkos::MemoryTraits<Kokkos::Unmanaged> > BViewType; \
+ \
+  static void \
+  trsm (const char side[], \
+        const char uplo[], \
+        const char trans[], \
+        const char diag[], \
+        typename BViewType::const_value_type& alpha, \
+        const AViewType& A, \
+        const BViewType& B) { \
+    \
+    Kokkos::Profiling::pushRegion("KokkosBlas::trsm[TPL_BLAS," #SCALAR "]"); \
+    const bool is_lr = std::is_same<Kokkos::LayoutRight,LAYOUT>::value; \
+    const bool is_left = (side[0]=='L') || (side[0]=='l'); \
+    const bool is_lower = (uplo[0]=='L') || (uplo[0]=='l'); \
+    const int M = B.extent(is_lr?1:0); \
+    const int N = B.extent(is_lr?0:1); \
+    int strides[2]; \
+    \
+    A.stride(strides); \
+    const int LDA = strides[is_lr?0:1]; \
+    B.stride(strides); \
+    const int LDB = strides[is_lr?0:1]; \
+    \
+    const char side_blas = (is_left != is_lr) ? 'L' : 'R'; \
+    const char uplo_blas = (is_lower != is_lr) ? 'L' : 'U'; \
+    trsm_tpl_blas(&side_blas,&uplo_blas,trans,diag,&M,&N,&alpha,A.data(),&LDA,B.data(),&LDB); \
+    Kokkos::Profiling::popRegion(); \
+  } \
+};
+
+KOKKOSBLAS3_TRSM_BLAS( double,                  Kokkos::LayoutLeft,  Kokkos::HostSpace, true)
+KOKKOSBLAS3_TRSM_BLAS( double,                  Kokkos::LayoutLeft,  Kokkos::HostSpace, false)
+KOKKOSBLAS3_TRSM_BLAS( double,                  Kokkos::LayoutRight, Kokkos::HostSpace, true)
+KOKKOSBLAS3_TRSM_BLAS( double,                  Kokkos::LayoutRight, Kokkos::HostSpace, false)
+
+KOKKOSBLAS3_TRSM_BLAS( float,                   Kokkos::LayoutLeft,  Kokkos::HostSpace, true)
+KOKKOSBLAS3_TRSM_BLAS( float,                   Kokkos::LayoutLeft,  Kokkos::HostSpace, false)
+KOKKOSBLAS3_TRSM_BLAS( float,                   Kokkos::LayoutRight, Kokkos::HostSpace, true)
+KOKKOSBLAS3_TRSM_BLAS( float,                   Kokkos::LayoutRight, Kokkos::HostSpace, false)
+
+KOKKOSBLAS3_TRSM_BLAS( Kokkos::complex<double>, Kokkos::LayoutLeft,  Kokkos::HostSpace, true)
+KOKKOSBLAS3_TRSM_BLAS( Kokkos::complex<double>, Kokkos::LayoutLeft,  Kokkos::HostSpace, false)
+KOKKOSBLAS3_TRSM_BLAS( Kokkos::complex<double>, Kokkos::LayoutRight, Kokkos::HostSpace, true)
+KOKKOSBLAS3_TRSM_BLAS( Kokkos::complex<double>, Kokkos::LayoutRight, Kokkos::HostSpace, false)
+
+KOKKOSBLAS3_TRSM_BLAS( Kokkos::complex<float>,  Kokkos::LayoutLeft,  Kokkos::HostSpace, true)
+KOKKOSBLAS3_TRSM_BLAS( Kokkos::complex<float>,  Kokkos::LayoutLeft,  Kokkos::HostSpace, false)
+KOKKOSBLAS3_TRSM_BLAS( Kokkos::complex<float>,  Kokkos::LayoutRight, Kokkos::HostSpace, true)
+KOKKOSBLAS3_TRSM_BLAS( Kokkos::complex<float>,  Kokkos::LayoutRight, Kokkos::HostSpace, false)
+
+}
+}
+#endif // KOKKOSKERNELS_ENABLE_TPL_BLAS
+
+// cuBLAS
+#ifdef KOKKOSKERNELS_ENABLE_TPL_CUBLAS
+
+namespace KokkosBlas {
+namespace Impl {
+
+inline cublasStatus_t trsm_tpl_cublas(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t uplo,
+                                      cublasOperation_t transA, cublasDiagType_t diag,
+                                      const int M, const int N, const double* alpha,
+                                      const double* A, const int LDA, double* B, const int LDB) {
+  return cublasDtrsm(handle,side,uplo,transA,diag,M,N,alpha,A,LDA,B,LDB);
+}
+inline cublasStatus_t trsm_tpl_cublas(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t uplo,
+                                      cublasOperation_t transA, cublasDiagType_t diag,
+                                      const int M, const int N, const float* alpha,
+                                      const float* A, const int LDA, float* B, const int LDB) {
+  return cublasStrsm(handle,side,uplo,transA,diag,M,N,alpha,A,LDA,B,LDB);
+}
+inline cublasStatus_t trsm_tpl_cublas(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t uplo,
+                                      cublasOperation_t transA, cublasDiagType_t diag,
+                                      const int M, const int N, const Kokkos::complex<double>* alpha,
+                                      const Kokkos::complex<double>* A, const int LDA, Kokkos::complex<double>* B, const int LDB) {
+  return cublasZtrsm(handle,side,uplo,transA,diag,M,N,
+                     reinterpret_cast<const cuDoubleComplex*>(alpha),
+                     reinterpret_cast<const cuDoubleComplex*>(A),LDA,
+                     reinterpret_cast<cuDoubleComplex*>(B),LDB);
+}
+inline cublasStatus_t trsm_tpl_cublas(cublasHandle_t handle, cublasSideMode_t side, cublasFillMode_t uplo,
+                                      cublasOperation_t transA, cublasDiagType_t diag,
+                                      const int M, const int N, const Kokkos::complex<float>* alpha,
+                                      const Kokkos::complex<float>* A, const int LDA, Kokkos::complex<float>* B, const int LDB) {
+  return cublasCtrsm(handle,side,uplo,transA,diag,M,N,
+                     reinterpret_cast<const cuComplex*>(alpha),
+                     reinterpret_cast<const cuComplex*>(A),LDA,
+                     reinterpret_cast<cuComplex*>(B),LDB);
+}
+
+#define KOKKOSBLAS3_TRSM_CUBLAS( SCALAR, LAYOUT, MEM_SPACE, ETI_SPEC_AVAIL ) \
+template<class ExecSpace> \
+struct TRSM< \
+     Kokkos::View<const SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+                  Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+     Kokkos::View<SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+                  Kokkos::MemoryTraits<Kokkos::Unmanaged> >, \
+     true, ETI_SPEC_AVAIL> { \
+  typedef Kokkos::View<const SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+      Kokkos::MemoryTraits<Kokkos::Unmanaged> > AViewType; \
+  typedef Kokkos::View<SCALAR**, LAYOUT, Kokkos::Device<ExecSpace, MEM_SPACE>, \
+      Kokkos::MemoryTraits<Kokkos::Unmanaged> > BViewType; \
+ \
+  static void \
+  trsm (const char side[], \
+        const char uplo[], \
+        const char trans[], \
+        const char diag[], \
+        typename BViewType::const_value_type& alpha, \
+        const AViewType& A, \
+        const BViewType& B) { \
+    \
+    Kokkos::Profiling::pushRegion("KokkosBlas::trsm[TPL_CUBLAS," #SCALAR "]"); \
+    const bool is_lr = std::is_same<Kokkos::LayoutRight,LAYOUT>::value; \
+    const bool is_left = (side[0]=='L') || (side[0]=='l'); \
+    const bool is_lower = (uplo[0]=='L') || (uplo[0]=='l'); \
+    const int M = B.extent(is_lr?1:0); \
+    const int N = B.extent(is_lr?0:1); \
+    int strides[2]; \
+    \
+    A.stride(strides); \
+    const int LDA = strides[is_lr?0:1]; \
+    B.stride(strides); \
+    const int LDB = strides[is_lr?0:1]; \
+    \
+    const char side_blas[] = { (is_left != is_lr) ? 'L' : 'R', '\0' }; \
+    const char uplo_blas[] = { (is_lower != is_lr) ? 'L' : 'U', '\0' }; \
+    CudaBlasSingleton & s = CudaBlasSingleton::singleton(); \
+    cublas_check_status(trsm_tpl_cublas(s.handle, \
+                                        side_mode_kk_to_cublas(side_blas), \
+                                        uplo_mode_kk_to_cublas(uplo_blas), \
+                                        trans_mode_kk_to_cublas(trans), \
+                                        diag_mode_kk_to_cublas(diag), \
+                                        M,N,&alpha,A.data(),LDA,B.data(),LDB), \
+                        "KokkosBlas::trsm"); \
+    Kokkos::Profiling::popRegion(); \
+  } \
+};
+
+KOKKOSBLAS3_TRSM_CUBLAS( double,                  Kokkos::LayoutLeft,  Kokkos::CudaSpace, true)
+KOKKOSBLAS3_TRSM_CUBLAS( double,                  Kokkos::LayoutLeft,  Kokkos::CudaSpace, false)
+KOKKOSBLAS3_TRSM_CUBLAS( double,                  Kokkos::LayoutRight, Kokkos::CudaSpace, true)
+KOKKOSBLAS3_TRSM_CUBLAS( double,                  Kokkos::LayoutRight, Kokkos::CudaSpace, false)
+
+KOKKOSBLAS3_TRSM_CUBLAS( float,                   Kokkos::LayoutLeft,  Kokkos::CudaSpace, true)
+KOKKOSBLAS3_TRSM_CUBLAS( float,                   Kokkos::LayoutLeft,  Kokkos::CudaSpace, false)
+KOKKOSBLAS3_TRSM_CUBLAS( float,                   Kokkos::LayoutRight, Kokkos::CudaSpace, true)
+KOKKOSBLAS3_TRSM_CUBLAS( float,                   Kokkos::LayoutRight, Kokkos::CudaSpace, false)
+
+KOKKOSBLAS3_TRSM_CUBLAS( Kokkos::complex<double>, Kokkos::LayoutLeft,  Kokkos::CudaSpace, true)
+KOKKOSBLAS3_TRSM_CUBLAS( Kokkos::complex<double>, Kokkos::LayoutLeft,  Kokkos::CudaSpace, false)
+KOKKOSBLAS3_TRSM_CUBLAS( Kokkos::complex<double>, Kokkos::LayoutRight, Kokkos::CudaSpace, true)
+KOKKOSBLAS3_TRSM_CUBLAS( Kokkos::complex<double>, Kokkos::LayoutRight, Kokkos::CudaSpace, false)
+
+KOKKOSBLAS3_TRSM_CUBLAS( Kokkos::complex<float>,  Kokkos::LayoutLeft,  Kokkos::CudaSpace, true)
+KOKKOSBLAS3_TRSM_CUBLAS( Kokkos::complex<float>,  Kokkos::LayoutLeft,  Kokkos::CudaSpace, false)
+KOKKOSBLAS3_TRSM_CUBLAS( Kokkos::complex<float>,  Kokkos::LayoutRight, Kokkos::CudaSpace, true)
+KOKKOSBLAS3_TRSM_CUBLAS( Kokkos::complex<float>,  Kokkos::LayoutRight, Kokkos::CudaSpace, false)
+
+}
+}
+#endif // KOKKOSKERNELS_ENABLE_TPL_CUBLAS
+
+#endif
@@ -0,0 +1,100 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSBLAS_TPL_SPEC_HPP_
+#define KOKKOSBLAS_TPL_SPEC_HPP_
+
+#ifdef KOKKOSKERNELS_ENABLE_TPL_CUBLAS
+#include <sstream>
+#include "cublas_v2.h"
+
+namespace KokkosBlas {
+namespace Impl {
+
+// A cuBLAS handle shared by all TPL specializations; it is created on first
+// use and lives until the end of the program.
+struct CudaBlasSingleton {
+  cublasHandle_t handle;
+
+  CudaBlasSingleton() {
+    if(cublasCreate(&handle) != CUBLAS_STATUS_SUCCESS)
+      Kokkos::Impl::throw_runtime_exception("KokkosBlas: cublasCreate failed");
+  }
+
+  static CudaBlasSingleton & singleton() {
+    static CudaBlasSingleton s;
+    return s;
+  }
+};
+
+inline void cublas_check_status(const cublasStatus_t stat, const char name[]) {
+  if(stat != CUBLAS_STATUS_SUCCESS) {
+    std::ostringstream os;
+    os << name << ": cuBLAS call failed with status " << int(stat);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+}
+
+inline cublasOperation_t trans_mode_kk_to_cublas(const char kkMode[]) {
+  if((kkMode[0] == 'N') || (kkMode[0] == 'n')) return CUBLAS_OP_N;
+  if((kkMode[0] == 'T') || (kkMode[0] == 't')) return CUBLAS_OP_T;
+  return CUBLAS_OP_C;
+}
+
+inline cublasFillMode_t uplo_mode_kk_to_cublas(const char kkMode[]) {
+  return ((kkMode[0] == 'L') || (kkMode[0] == 'l')) ? CUBLAS_FILL_MODE_LOWER : CUBLAS_FILL_MODE_UPPER;
+}
+
+inline cublasSideMode_t side_mode_kk_to_cublas(const char kkMode[]) {
+  return ((kkMode[0] == 'L') || (kkMode[0] == 'l')) ? CUBLAS_SIDE_LEFT : CUBLAS_SIDE_RIGHT;
+}
+
+inline cublasDiagType_t diag_mode_kk_to_cublas(const char kkMode[]) {
+  return ((kkMode[0] == 'U') || (kkMode[0] == 'u')) ? CUBLAS_DIAG_UNIT : CUBLAS_DIAG_NON_UNIT;
+}
+
+}
+}
+#endif // KOKKOSKERNELS_ENABLE_TPL_CUBLAS
+
+#endif // KOKKOSBLAS_TPL_SPEC_HPP_
@@ -0,0 +1,189 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+/// \file KokkosSparse_BatchedCrsMatrix.hpp
+/// \brief Batch of sparse matrices with the same sparsity pattern, stored
+///   as one graph and a 2-D view of values.
+
+#ifndef KOKKOS_SPARSE_BATCHEDCRSMATRIX_HPP_
+#define KOKKOS_SPARSE_BATCHEDCRSMATRIX_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+
+namespace KokkosSparse {
+
+namespace Experimental {
+
+/// \class BatchedCrsMatrix
+/// \brief Batch of sparse matrices sharing one sparsity pattern.
+///
+/// All the matrices of the batch have the row map and column indices of
+/// graph; the entries of matrix b are values(b, :), in the order of the
+/// column indices. The pattern is stored once, so a batch of many small
+/// systems, e.g. one Jacobian per cell of a mesh, costs the values plus a
+/// single graph. The batched spmv and the batched solvers assign one
+/// matrix of the batch to each team.
+///
+/// \tparam ScalarType The type of the entries of the sparse matrices.
+/// \tparam OrdinalType The type of the column indices of the sparse matrices.
+/// \tparam Device The Kokkos Device type.
+/// \tparam SizeType The type of the row offsets.
+template<class ScalarType,
+         class OrdinalType,
+         class Device,
+         class SizeType = typename Kokkos::ViewTraits<OrdinalType*, Device, void, void>::size_type>
+class BatchedCrsMatrix {
+public:
+  //! Type of the matrix's execution space.
+  typedef typename Device::execution_space execution_space;
+  //! Type of the matrix's memory space.
+  typedef typename Device::memory_space memory_space;
+  //! Type of the matrix's device type.
+  typedef Kokkos::Device<execution_space, memory_space> device_type;
+
+  //! Type of each value in the matrix.
+  typedef ScalarType value_type;
+  typedef typename std::remove_cv<ScalarType>::type non_const_value_type;
+  //! Type of each (column) index in the matrix.
+  typedef OrdinalType ordinal_type;
+  typedef typename std::remove_cv<OrdinalType>::type non_const_ordinal_type;
+  //! Type of the row offsets.
+  typedef SizeType size_type;
+
+  //! Type of a single matrix of the batch.
+  typedef CrsMatrix<non_const_value_type, non_const_ordinal_type, device_type, void, size_type> matrix_type;
+  typedef typename matrix_type::staticcrsgraph_type staticcrsgraph_type;
+  typedef typename matrix_type::row_map_type row_map_type;
+  typedef typename matrix_type::index_type index_type;
+  //! Type of the values of the batch, [matrix][entry].
+  typedef Kokkos::View<non_const_value_type**, Kokkos::LayoutRight, device_type> values_type;
+
+  //! The sparsity pattern shared by all the matrices.
+  staticcrsgraph_type graph;
+  //! The values of the matrices, one row per matrix.
+  values_type values;
+
+  //! Default constructor; constructs an empty batch.
+  BatchedCrsMatrix () :
+    numCols_ (0)
+  {}
+
+  /// \brief Makes a batch from a pattern and the values of every matrix.
+  ///   The views are not copied.
+  ///
+  /// \param ncols [in] The number of columns of every matrix.
+  /// \param graph_ [in] The sparsity pattern shared by all the matrices.
+  /// \param vals [in] The values, values(b, k) being entry k of matrix b;
+  ///   the second extent must be the number of entries of graph_.
+  BatchedCrsMatrix (const ordinal_type ncols,
+                    const staticcrsgraph_type& graph_,
+                    const values_type& vals) :
+    graph (graph_), values (vals), numCols_ (ncols)
+  {
+    if (values.extent (1) != graph.entries.extent (0)) {
+      std::ostringstream os;
+      os << "KokkosSparse::Experimental::BatchedCrsMatrix: values has "
+         << values.extent (1) << " entries per matrix, but the graph has "
+         << graph.entries.extent (0) << ".";
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+  }
+
+  /// \brief Makes a batch of num_matrices copies of A, sharing its graph.
+  ///   The values are copied, and can then be changed matrix by matrix.
+  ///
+  /// \param A [in] The CrsMatrix, in the same memory space.
+  /// \param num_matrices [in] The number of matrices; must be nonnegative.
+  BatchedCrsMatrix (const matrix_type& A, const int num_matrices) :
+    graph (A.graph), numCols_ (A.numCols ())
+  {
+    if (num_matrices < 0) {
+      std::ostringstream os;
+      os << "KokkosSparse::Experimental::BatchedCrsMatrix: num_matrices = "
+         << num_matrices << " must be nonnegative.";
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+    values = values_type (Kokkos::ViewAllocateWithoutInitializing (A.values.label ()),
+                          num_matrices, A.nnz ());
+    for (int b = 0; b < num_matrices; ++b) {
+      Kokkos::deep_copy (Kokkos::subview (values, b, Kokkos::ALL ()), A.values);
+    }
+  }
+
+  /// \brief Matrix b of the batch, as a CrsMatrix viewing the graph and
+  ///   the values of the batch. Changing its values changes the batch.
+  matrix_type matrix (const int b) const {
+    return matrix_type (values.label (), numCols_,
+                        typename matrix_type::values_type (Kokkos::subview (values, b, Kokkos::ALL ())),
+                        graph);
+  }
+
+  //! The number of matrices in the batch.
+  KOKKOS_INLINE_FUNCTION int numMatrices () const {
+    return static_cast<int> (values.extent (0));
+  }
+
+  //! The number of rows of every matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numRows () const {
+    return graph.numRows ();
+  }
+
+  //! The number of columns of every matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numCols () const {
+    return numCols_;
+  }
+
+  //! The number of stored entries of every matrix.
+  KOKKOS_INLINE_FUNCTION size_type nnz () const {
+    return graph.entries.extent (0);
+  }
+
+private:
+  ordinal_type numCols_;
+};
+
+}
+}
+
+#endif
@@ -467,7 +467,7 @@ public:
   /// these from the graph.
   KOKKOS_INLINE_FUNCTION
   CrsMatrix () :
-    numCols_ (0)
+    numCols_ (0), values_version_ (0)
   {}
 
   //! Copy constructor (shallow copy).
@@ -485,7 +485,8 @@ public:
     cusparse_handle (B.cusparse_handle),
     cusparse_descr (B.cusparse_descr),
 #endif // KOKKOS_USE_CUSPARSE
-    numCols_ (B.numCols ())
+    numCols_ (B.numCols ()),
+    values_version_ (B.valuesVersion ())
   {
     graph.row_block_offsets = B.graph.row_block_offsets;
     //TODO: MD 07/2017: Changed the copy constructor of graph
@@ -499,7 +500,8 @@ public:
              const staticcrsgraph_type& arg_graph) :
     graph (arg_graph),
     values (arg_label, arg_graph.entries.extent(0)),
-    numCols_ (maximum_entry (arg_graph) + 1)
+    numCols_ (maximum_entry (arg_graph) + 1),
+    values_version_ (0)
   {}
 
   /// \brief Constructor that copies raw arrays of host data in
@@ -533,7 +535,8 @@ public:
              ScalarType* val,
              OrdinalType* rows,
              OrdinalType* cols,
-             bool pad = false)
+             bool pad = false) :
+    values_version_ (0)
   {
     (void) pad;
     ctor_impl (label, nrows, ncols, annz, val, rows, cols);
@@ -576,7 +579,8 @@ public:
              const index_type& cols) :
     graph (cols, rows),
     values (vals),
-    numCols_ (ncols)
+    numCols_ (ncols),
+    values_version_ (0)
   {
     const ordinal_type actualNumRows = (rows.extent(0) != 0) ?
       static_cast<ordinal_type> (rows.extent(0) - static_cast<size_type> (1)) :
@@ -619,7 +623,8 @@ public:
              const staticcrsgraph_type& graph_) :
     graph (graph_),
     values (vals),
-    numCols_ (ncols)
+    numCols_ (ncols),
+    values_version_ (0)
   {
 #ifdef KOKKOS_USE_CUSPARSE
     cusparseCreate (&cusparse_handle);
@@ -724,6 +729,7 @@ public:
     graph = mtx.graph;
     values = mtx.values;
     dev_config = mtx.dev_config;
+    values_version_ = mtx.valuesVersion ();
     return *this;
   }
 
@@ -742,6 +748,24 @@ public:
     return graph.entries.extent(0);
   }
 
+  /// \brief Version of the values of the matrix.
+  ///
+  /// The value update functions of KokkosSparse_crs_value_update.hpp
+  /// increment it, so that the handles that keep data computed from the
+  /// values (Gauss-Seidel, SpGEMM, transpose) can tell whether the values
+  /// changed since, and redo only their numeric phase. Call
+  /// bumpValuesVersion() after changing the values in another way. The
+  /// version is copied with the matrix: it is the version of the copy
+  /// the values were changed through.
+  KOKKOS_INLINE_FUNCTION size_t valuesVersion () const {
+    return values_version_;
+  }
+
+  //! Marks the values of the matrix as changed, see valuesVersion().
+  void bumpValuesVersion () {
+    ++values_version_;
+  }
+
   friend struct SparseRowView<CrsMatrix>;
 
   /// \brief Return a view of row i of the matrix.
@@ -862,6 +886,7 @@ public:
 
 private:
   ordinal_type numCols_;
+  size_t values_version_;
 };
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,282 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+/// \file KokkosSparse_DeltaCrsMatrix.hpp
+/// \brief Local sparse matrix in compressed sparse row format, with the
+///   column indices stored as short deltas from a base column of the row.
+
+#ifndef KOKKOS_SPARSE_DELTACRSMATRIX_HPP_
+#define KOKKOS_SPARSE_DELTACRSMATRIX_HPP_
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+
+namespace KokkosSparse {
+
+namespace Experimental {
+
+namespace Impl {
+
+// Base column of each row, its smallest column, and the number of entries
+// stored at full width: all the entries of the row if its columns do not fit
+// in DeltaType deltas from the base, none otherwise.
+template<class CrsMatrixType, class DeltaCrsMatrixType>
+struct DeltaCrsCountFunctor {
+  typedef typename DeltaCrsMatrixType::ordinal_type ordinal_type;
+  typedef typename DeltaCrsMatrixType::size_type size_type;
+  typedef typename DeltaCrsMatrixType::delta_value_type delta_value_type;
+
+  CrsMatrixType A;
+  typename DeltaCrsMatrixType::row_map_type row_map;
+  typename DeltaCrsMatrixType::row_base_type row_base;
+  typename DeltaCrsMatrixType::row_map_type wide_row_map;
+  const ordinal_type numRows;
+  const uint64_t max_delta;
+
+  DeltaCrsCountFunctor (const CrsMatrixType A_, const DeltaCrsMatrixType& D) :
+    A (A_), row_map (D.row_map), row_base (D.row_base),
+    wide_row_map (D.wide_row_map), numRows (D.numRows ()),
+    max_delta (std::numeric_limits<delta_value_type>::max ()) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    const size_type begin = A.graph.row_map(i);
+    const size_type end = A.graph.row_map(i + 1);
+    ordinal_type min_col = 0, max_col = 0;
+    if (begin < end) {
+      min_col = max_col = A.graph.entries(begin);
+    }
+    for (size_type k = begin + 1; k < end; ++k) {
+      const ordinal_type col = A.graph.entries(k);
+      if (col < min_col) min_col = col;
+      if (col > max_col) max_col = col;
+    }
+    row_base(i) = min_col;
+    row_map(i) = begin;
+    const bool is_wide = static_cast<uint64_t> (max_col - min_col) > max_delta;
+    wide_row_map(i) = is_wide ? end - begin : 0;
+    if (i == numRows - 1) {
+      row_map(numRows) = end;
+    }
+  }
+};
+
+// Deltas of the compressed rows, and full width columns of the other rows.
+// The deltas of row i start at row_map(i) - wide_row_map(i), the number of
+// compressed entries of the rows before it.
+template<class CrsMatrixType, class DeltaCrsMatrixType>
+struct DeltaCrsFillFunctor {
+  typedef typename DeltaCrsMatrixType::ordinal_type ordinal_type;
+  typedef typename DeltaCrsMatrixType::size_type size_type;
+  typedef typename DeltaCrsMatrixType::delta_value_type delta_value_type;
+
+  CrsMatrixType A;
+  typename DeltaCrsMatrixType::row_map_type row_map;
+  typename DeltaCrsMatrixType::row_base_type row_base;
+  typename DeltaCrsMatrixType::row_map_type wide_row_map;
+  typename DeltaCrsMatrixType::delta_entries_type delta_entries;
+  typename DeltaCrsMatrixType::index_type wide_entries;
+  typename DeltaCrsMatrixType::values_type values;
+
+  DeltaCrsFillFunctor (const CrsMatrixType A_, const DeltaCrsMatrixType& D) :
+    A (A_), row_map (D.row_map), row_base (D.row_base),
+    wide_row_map (D.wide_row_map), delta_entries (D.delta_entries),
+    wide_entries (D.wide_entries), values (D.values) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    const size_type begin = row_map(i);
+    const size_type end = row_map(i + 1);
+    const size_type wide_begin = wide_row_map(i);
+    const bool is_wide = wide_row_map(i + 1) != wide_begin;
+    const ordinal_type base = row_base(i);
+    for (size_type k = begin; k < end; ++k) {
+      const ordinal_type col = A.graph.entries(k);
+      if (is_wide) {
+        wide_entries(wide_begin + (k - begin)) = col;
+      } else {
+        delta_entries(k - wide_begin) = static_cast<delta_value_type> (col - base);
+      }
+      values(k) = A.values(k);
+    }
+  }
+};
+
+}
+
+/// \class DeltaCrsMatrix
+/// \brief Local sparse matrix in compressed sparse row format, with short
+///   column indices.
+///
+/// The columns of a row are stored as DeltaType offsets from the smallest
+/// column of the row, which halves (uint16_t) or quarters (uint8_t) the
+/// bytes of the column indices of 32 bit ordinals for rows whose columns
+/// span fewer than 2^16 (or 2^8) columns, e.g. banded matrices. The rows
+/// with a wider span keep their columns at full width in wide_entries.
+/// The values stay in the order of the CrsMatrix.
+///
+/// Row i has the values values(row_map(i):row_map(i+1)). If
+/// wide_row_map(i) == wide_row_map(i+1), its columns are row_base(i) plus
+/// the deltas starting at delta_entries(row_map(i) - wide_row_map(i));
+/// otherwise, they are wide_entries(wide_row_map(i):wide_row_map(i+1)).
+///
+/// \tparam ScalarType The type of the entries of the sparse matrix.
+/// \tparam OrdinalType The type of the column indices of the sparse matrix.
+/// \tparam Device The Kokkos Device type.
+/// \tparam SizeType The type of the row offsets.
+/// \tparam DeltaType The unsigned integer type of the column deltas.
+template<class ScalarType,
+         class OrdinalType,
+         class Device,
+         class SizeType = typename Kokkos::ViewTraits<OrdinalType*, Device, void, void>::size_type,
+         class DeltaType = uint16_t>
+class DeltaCrsMatrix {
+  static_assert (std::is_integral<DeltaType>::value && std::is_unsigned<DeltaType>::value,
+                 "KokkosSparse::DeltaCrsMatrix: DeltaType must be an unsigned integer type.");
+public:
+  //! Type of the matrix's execution space.
+  typedef typename Device::execution_space execution_space;
+  //! Type of the matrix's memory space.
+  typedef typename Device::memory_space memory_space;
+  //! Type of the matrix's device type.
+  typedef Kokkos::Device<execution_space, memory_space> device_type;
+
+  //! Type of each value in the matrix.
+  typedef ScalarType value_type;
+  typedef typename std::remove_cv<ScalarType>::type non_const_value_type;
+  //! Type of each (column) index in the matrix.
+  typedef OrdinalType ordinal_type;
+  typedef typename std::remove_cv<OrdinalType>::type non_const_ordinal_type;
+  //! Type of the row offsets.
+  typedef SizeType size_type;
+  //! Type of the column deltas.
+  typedef DeltaType delta_value_type;
+
+  //! Row offsets, of the values and of the full width columns.
+  typedef Kokkos::View<size_type*, device_type> row_map_type;
+  //! Base column of each row.
+  typedef Kokkos::View<non_const_ordinal_type*, device_type> row_base_type;
+  //! Column deltas of the compressed rows.
+  typedef Kokkos::View<delta_value_type*, device_type> delta_entries_type;
+  //! Full width columns of the other rows.
+  typedef Kokkos::View<non_const_ordinal_type*, device_type> index_type;
+  //! Values of the matrix.
+  typedef Kokkos::View<non_const_value_type*, device_type> values_type;
+
+  row_map_type row_map;
+  row_base_type row_base;
+  row_map_type wide_row_map;
+  delta_entries_type delta_entries;
+  index_type wide_entries;
+  values_type values;
+
+  //! Default constructor; constructs an empty sparse matrix.
+  DeltaCrsMatrix () :
+    numRows_ (0), numCols_ (0), nnz_ (0)
+  {}
+
+  /// \brief Converts a CrsMatrix, in parallel on its execution space.
+  ///
+  /// \param A [in] The CrsMatrix, in the same memory space.
+  template<class CrsMatrixType>
+  DeltaCrsMatrix (const CrsMatrixType& A) :
+    numRows_ (A.numRows ()), numCols_ (A.numCols ()), nnz_ (A.nnz ())
+  {
+    row_map = row_map_type ("DeltaCrs row_map", numRows_ + 1);
+    row_base = row_base_type (Kokkos::ViewAllocateWithoutInitializing ("DeltaCrs row_base"), numRows_);
+    wide_row_map = row_map_type ("DeltaCrs wide_row_map", numRows_ + 1);
+    values = values_type (Kokkos::ViewAllocateWithoutInitializing ("DeltaCrs values"), nnz_);
+
+    size_type num_wide = 0;
+    if (numRows_ > 0) {
+      Kokkos::parallel_for ("KokkosSparse::DeltaCrsMatrix::count",
+          Kokkos::RangePolicy<execution_space> (0, numRows_),
+          Impl::DeltaCrsCountFunctor<CrsMatrixType, DeltaCrsMatrix> (A, *this));
+      KokkosKernels::Impl::exclusive_parallel_prefix_sum<row_map_type, execution_space> (numRows_ + 1, wide_row_map);
+      Kokkos::deep_copy (num_wide, Kokkos::subview (wide_row_map, numRows_));
+    }
+    delta_entries = delta_entries_type (Kokkos::ViewAllocateWithoutInitializing ("DeltaCrs delta_entries"), nnz_ - num_wide);
+    wide_entries = index_type (Kokkos::ViewAllocateWithoutInitializing ("DeltaCrs wide_entries"), num_wide);
+    if (numRows_ > 0) {
+      Kokkos::parallel_for ("KokkosSparse::DeltaCrsMatrix::fill",
+          Kokkos::RangePolicy<execution_space> (0, numRows_),
+          Impl::DeltaCrsFillFunctor<CrsMatrixType, DeltaCrsMatrix> (A, *this));
+    }
+  }
+
+  //! The number of rows in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numRows () const {
+    return numRows_;
+  }
+
+  //! The number of columns in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numCols () const {
+    return numCols_;
+  }
+
+  //! The number of stored entries in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION size_type nnz () const {
+    return nnz_;
+  }
+
+  //! The number of entries whose columns are stored at full width.
+  KOKKOS_INLINE_FUNCTION size_type numWideEntries () const {
+    return wide_entries.extent (0);
+  }
+
+private:
+  ordinal_type numRows_;
+  ordinal_type numCols_;
+  size_type nnz_;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,283 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_DiaMatrix.hpp
+/// \brief Local sparse matrix in diagonal (DIA) format.
+
+#ifndef KOKKOS_SPARSE_DIAMATRIX_HPP_
+#define KOKKOS_SPARSE_DIAMATRIX_HPP_
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "KokkosSparse_CrsMatrix.hpp"
+
+namespace KokkosSparse {
+
+namespace Experimental {
+
+namespace Impl {
+
+// Sorted offsets j - i of the diagonals with a stored entry of A, found on the host.
+template<class CrsMatrixType, class OrdinalType>
+void dia_diagonal_offsets (const CrsMatrixType& A, std::vector<OrdinalType>& offsets)
+{
+  typedef typename CrsMatrixType::row_map_type::non_const_type row_map_t;
+  typedef typename CrsMatrixType::index_type::non_const_type entries_t;
+
+  offsets.clear ();
+  const OrdinalType numRows = A.numRows ();
+  const OrdinalType numCols = A.numCols ();
+  if (numRows == 0 || numCols == 0) {
+    return;
+  }
+  typename row_map_t::HostMirror h_row_map (Kokkos::ViewAllocateWithoutInitializing ("DIA h_row_map"), A.graph.row_map.extent (0));
+  typename entries_t::HostMirror h_entries (Kokkos::ViewAllocateWithoutInitializing ("DIA h_entries"), A.graph.entries.extent (0));
+  Kokkos::deep_copy (h_row_map, A.graph.row_map);
+  Kokkos::deep_copy (h_entries, A.graph.entries);
+
+  //diagonal d is used[d + numRows - 1].
+  std::vector<char> used (static_cast<size_t> (numRows) + numCols - 1, 0);
+  for (OrdinalType i = 0; i < numRows; ++i) {
+    for (size_t j = h_row_map(i); j < static_cast<size_t> (h_row_map(i + 1)); ++j) {
+      used[h_entries(j) - i + numRows - 1] = 1;
+    }
+  }
+  for (size_t k = 0; k < used.size (); ++k) {
+    if (used[k]) offsets.push_back (static_cast<OrdinalType> (k) - numRows + 1);
+  }
+}
+
+// Adds the entries of row i of a CrsMatrix to row i of the diagonals of a
+// DiaMatrix: the entry of column j goes to values(i, k), offsets(k) = j - i.
+template<class CrsMatrixType, class DiaMatrixType>
+struct DiaFillFunctor {
+  typedef typename DiaMatrixType::ordinal_type ordinal_type;
+  typedef typename CrsMatrixType::size_type size_type;
+
+  CrsMatrixType A;
+  typename DiaMatrixType::offsets_type offsets;
+  typename DiaMatrixType::values_type values;
+  const ordinal_type numDiagonals;
+
+  DiaFillFunctor (const CrsMatrixType A_, const DiaMatrixType& D) :
+    A (A_), offsets (D.offsets), values (D.values), numDiagonals (D.numDiagonals ()) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    const size_type row_end = A.graph.row_map(i + 1);
+    for (size_type j = A.graph.row_map(i); j < row_end; ++j) {
+      const ordinal_type d = A.graph.entries(j) - i;
+      ordinal_type lo = 0, hi = numDiagonals - 1;
+      while (lo < hi) {
+        const ordinal_type mid = lo + (hi - lo) / 2;
+        if (offsets(mid) < d) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      values(i, lo) += A.values(j);
+    }
+  }
+};
+
+}
+
+/// \brief The number of diagonals of A with a stored entry, i.e. of a
+///   DiaMatrix converted from A. It is computed on the host.
+template<class CrsMatrixType>
+typename CrsMatrixType::non_const_ordinal_type
+count_dia_diagonals (const CrsMatrixType& A)
+{
+  std::vector<typename CrsMatrixType::non_const_ordinal_type> offsets;
+  Impl::dia_diagonal_offsets (A, offsets);
+  return static_cast<typename CrsMatrixType::non_const_ordinal_type> (offsets.size ());
+}
+
+/// \class DiaMatrix
+/// \brief Local sparse matrix in diagonal (DIA) format.
+///
+/// The matrix is stored as its diagonals with a stored entry: diagonal
+/// k has the column offset offsets(k), and values(i, k) is the entry
+/// of row i and column i + offsets(k), or zero. The values are column
+/// major, so that the entries of a diagonal for consecutive rows are
+/// contiguous and the kernels need no column indices. It suits the
+/// matrices of stencils on structured grids, with a few diagonals;
+/// each diagonal costs numRows entries, whatever the number of its
+/// stored entries.
+///
+/// \tparam ScalarType The type of the entries of the sparse matrix.
+/// \tparam OrdinalType The type of the row indices and offsets.
+/// \tparam Device The Kokkos Device type.
+template<class ScalarType,
+         class OrdinalType,
+         class Device>
+class DiaMatrix {
+public:
+  //! Type of the matrix's execution space.
+  typedef typename Device::execution_space execution_space;
+  //! Type of the matrix's memory space.
+  typedef typename Device::memory_space memory_space;
+  //! Type of the matrix's device type.
+  typedef Kokkos::Device<execution_space, memory_space> device_type;
+
+  //! Type of each value in the matrix.
+  typedef ScalarType value_type;
+  typedef typename std::remove_cv<ScalarType>::type non_const_value_type;
+  //! Type of each row index and offset in the matrix.
+  typedef OrdinalType ordinal_type;
+  typedef typename std::remove_cv<OrdinalType>::type non_const_ordinal_type;
+  //! Type of the number of stored entries.
+  typedef size_t size_type;
+
+  //! Column offset of each diagonal, in increasing order.
+  typedef Kokkos::View<non_const_ordinal_type*, device_type> offsets_type;
+  //! Values of the diagonals, one column per diagonal.
+  typedef Kokkos::View<non_const_value_type**, Kokkos::LayoutLeft, device_type> values_type;
+
+  offsets_type offsets;
+  values_type values;
+
+  //! Default constructor; constructs an empty sparse matrix.
+  DiaMatrix () :
+    numRows_ (0), numCols_ (0), nnz_ (0), diagonalIndex_ (-1), numColors_ (1)
+  {}
+
+  /// \brief Converts a CrsMatrix to DIA.
+  ///
+  /// Repeated entries of a row and column are summed.
+  ///
+  /// \param A [in] The CrsMatrix, in the same memory space.
+  /// \param maxDiagonals [in] If positive, the largest number of
+  ///   diagonals accepted; the constructor throws if A has more, see
+  ///   count_dia_diagonals.
+  template<class CrsMatrixType>
+  DiaMatrix (const CrsMatrixType& A,
+             const OrdinalType maxDiagonals = 0) :
+    numRows_ (A.numRows ()), numCols_ (A.numCols ()), nnz_ (A.nnz ()),
+    diagonalIndex_ (-1), numColors_ (1)
+  {
+    std::vector<non_const_ordinal_type> h_offsets_vector;
+    Impl::dia_diagonal_offsets (A, h_offsets_vector);
+    const ordinal_type numDiagonals = static_cast<ordinal_type> (h_offsets_vector.size ());
+    if (maxDiagonals > 0 && numDiagonals > maxDiagonals) {
+      std::ostringstream os;
+      os << "KokkosSparse::DiaMatrix: the matrix has " << numDiagonals
+         << " diagonals, more than maxDiagonals (" << maxDiagonals << ").";
+      throw std::runtime_error (os.str ());
+    }
+
+    offsets = offsets_type (Kokkos::ViewAllocateWithoutInitializing ("DIA offsets"), numDiagonals);
+    typename offsets_type::HostMirror h_offsets = Kokkos::create_mirror_view (offsets);
+    for (ordinal_type k = 0; k < numDiagonals; ++k) {
+      h_offsets(k) = h_offsets_vector[k];
+      if (h_offsets_vector[k] == 0) diagonalIndex_ = k;
+    }
+    Kokkos::deep_copy (offsets, h_offsets);
+
+    //rows i and i + m p are not coupled if no diagonal offset is a multiple of p.
+    bool coupled = true;
+    for (numColors_ = 1; coupled; ) {
+      coupled = false;
+      for (ordinal_type k = 0; k < numDiagonals && !coupled; ++k) {
+        coupled = h_offsets_vector[k] != 0 && h_offsets_vector[k] % numColors_ == 0;
+      }
+      if (coupled) ++numColors_;
+    }
+
+    values = values_type ("DIA values", numRows_, numDiagonals);
+    if (numDiagonals > 0) {
+      Kokkos::parallel_for ("KokkosSparse::DiaMatrix::fill",
+          Kokkos::RangePolicy<execution_space> (0, numRows_),
+          Impl::DiaFillFunctor<CrsMatrixType, DiaMatrix> (A, *this));
+    }
+  }
+
+  //! The number of rows in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numRows () const {
+    return numRows_;
+  }
+
+  //! The number of columns in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numCols () const {
+    return numCols_;
+  }
+
+  //! The number of stored entries of the CrsMatrix.
+  KOKKOS_INLINE_FUNCTION size_type nnz () const {
+    return nnz_;
+  }
+
+  //! The number of diagonals.
+  KOKKOS_INLINE_FUNCTION ordinal_type numDiagonals () const {
+    return static_cast<ordinal_type> (offsets.extent (0));
+  }
+
+  //! The index of the main diagonal in offsets, -1 if it has no stored entry.
+  KOKKOS_INLINE_FUNCTION ordinal_type diagonalIndex () const {
+    return diagonalIndex_;
+  }
+
+  /// \brief The smallest p such that no diagonal offset but 0 is a multiple
+  ///   of p: the rows i with the same i % p are not coupled, which gives the
+  ///   colors of the multicolor Gauss-Seidel sweeps.
+  KOKKOS_INLINE_FUNCTION ordinal_type numColors () const {
+    return numColors_;
+  }
+
+private:
+  ordinal_type numRows_;
+  ordinal_type numCols_;
+  size_type nnz_;
+  ordinal_type diagonalIndex_;
+  ordinal_type numColors_;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,388 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+/// \file KokkosSparse_DynamicCrsMatrix.hpp
+/// \brief Local sparse matrix in compressed sparse row format, with spare
+///   capacity at the end of each row for inserting entries in place.
+
+#ifndef KOKKOS_SPARSE_DYNAMICCRSMATRIX_HPP_
+#define KOKKOS_SPARSE_DYNAMICCRSMATRIX_HPP_
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+#include <type_traits>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+
+namespace KokkosSparse {
+
+namespace Experimental {
+
+namespace Impl {
+
+// Capacity of each row: its current length plus the requested slack. The
+// lengths come from a row map and, for a DynamicCrsMatrix, from its fill
+// counters, which may exceed the capacity after an overflow.
+template<class SrcRowMap, class SrcFill, class RowMap>
+struct DynamicCrsCapacityFunctor {
+  typedef typename RowMap::non_const_value_type size_type;
+
+  SrcRowMap src_row_map;
+  SrcFill src_fill;
+  RowMap row_map;
+  const size_type slack;
+  const bool has_fill;
+
+  DynamicCrsCapacityFunctor (const SrcRowMap& src_row_map_, const SrcFill& src_fill_,
+                             const RowMap& row_map_, const size_type slack_, const bool has_fill_) :
+    src_row_map (src_row_map_), src_fill (src_fill_), row_map (row_map_),
+    slack (slack_), has_fill (has_fill_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  size_type length (const size_type i) const
+  {
+    const size_type capacity = src_row_map(i + 1) - src_row_map(i);
+    if (! has_fill) return capacity;
+    return src_fill(i) < capacity ? size_type (src_fill(i)) : capacity;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type i) const
+  {
+    row_map(i) = length (i) + slack;
+  }
+};
+
+// Copies the filled part of each source row to the start of the row in the
+// new layout and marks the rest of the row as empty.
+template<class SrcRowMap, class SrcFill, class SrcEntries, class SrcValues,
+         class DynamicCrsMatrixType>
+struct DynamicCrsCopyFunctor {
+  typedef typename DynamicCrsMatrixType::size_type size_type;
+  typedef typename DynamicCrsMatrixType::non_const_ordinal_type ordinal_type;
+  typedef typename DynamicCrsMatrixType::non_const_value_type value_type;
+
+  DynamicCrsCapacityFunctor<SrcRowMap, SrcFill, typename DynamicCrsMatrixType::row_map_type> src;
+  SrcEntries src_entries;
+  SrcValues src_values;
+  typename DynamicCrsMatrixType::row_map_type row_map;
+  typename DynamicCrsMatrixType::row_fill_type row_fill;
+  typename DynamicCrsMatrixType::index_type entries;
+  typename DynamicCrsMatrixType::values_type values;
+
+  DynamicCrsCopyFunctor (const SrcRowMap& src_row_map_, const SrcFill& src_fill_, const bool has_fill_,
+                         const SrcEntries& src_entries_, const SrcValues& src_values_,
+                         const DynamicCrsMatrixType& D) :
+    src (src_row_map_, src_fill_, D.row_map, 0, has_fill_),
+    src_entries (src_entries_), src_values (src_values_),
+    row_map (D.row_map), row_fill (D.row_fill), entries (D.entries), values (D.values) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type i) const
+  {
+    const size_type src_begin = src.src_row_map(i);
+    const size_type len = src.length (i);
+    const size_type begin = row_map(i);
+    const size_type end = row_map(i + 1);
+    for (size_type k = 0; k < len; ++k) {
+      entries(begin + k) = src_entries(src_begin + k);
+      values(begin + k) = src_values(src_begin + k);
+    }
+    for (size_type k = begin + len; k < end; ++k) {
+      entries(k) = DynamicCrsMatrixType::emptyColumn ();
+      values(k) = Kokkos::Details::ArithTraits<value_type>::zero ();
+    }
+    row_fill(i) = len;
+  }
+};
+
+template<class DynamicCrsMatrixType>
+struct DynamicCrsOverflowFunctor {
+  typedef typename DynamicCrsMatrixType::size_type size_type;
+  typedef size_type value_type;
+  DynamicCrsMatrixType A;
+
+  DynamicCrsOverflowFunctor (const DynamicCrsMatrixType& A_) : A (A_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type i, size_type& num) const
+  {
+    if (A.row_fill(i) > A.row_map(i + 1) - A.row_map(i)) ++num;
+  }
+};
+
+}
+
+/// \class DynamicCrsMatrix
+/// \brief Local sparse matrix in compressed sparse row format, with spare
+///   capacity in each row.
+///
+/// Row i owns the slots row_map(i):row_map(i+1), of which the first
+/// rowLength(i) hold entries; row_fill(i) counts the slots claimed so far.
+/// Entries are added in place, from inside a parallel kernel, with
+/// sumIntoOrInsert, so adding a few entries per step (contact, adaptivity)
+/// does not rebuild the matrix. The entries of a row are in insertion
+/// order. spmv (KokkosSparse_spmv_dynamiccrs.hpp) works directly on this
+/// layout; compact() returns a CrsMatrix without the spare slots for the
+/// kernels that need one.
+///
+/// When a row runs out of capacity, sumIntoOrInsert returns false and the
+/// entry is dropped. overflowed() tells on the host whether that happened;
+/// reserve() then regrows the rows so that the dropped entries can be
+/// inserted again.
+///
+/// \tparam ScalarType The type of the entries of the sparse matrix.
+/// \tparam OrdinalType The type of the column indices of the sparse matrix.
+/// \tparam Device The Kokkos Device type.
+/// \tparam SizeType The type of the row offsets.
+template<class ScalarType,
+         class OrdinalType,
+         class Device,
+         class SizeType = typename Kokkos::ViewTraits<OrdinalType*, Device, void, void>::size_type>
+class DynamicCrsMatrix {
+public:
+  //! Type of the matrix's execution space.
+  typedef typename Device::execution_space execution_space;
+  //! Type of the matrix's memory space.
+  typedef typename Device::memory_space memory_space;
+  //! Type of the matrix's device type.
+  typedef Kokkos::Device<execution_space, memory_space> device_type;
+
+  //! Type of each value in the matrix.
+  typedef ScalarType value_type;
+  typedef typename std::remove_cv<ScalarType>::type non_const_value_type;
+  //! Type of each (column) index in the matrix.
+  typedef OrdinalType ordinal_type;
+  typedef typename std::remove_cv<OrdinalType>::type non_const_ordinal_type;
+  //! Type of the row offsets.
+  typedef SizeType size_type;
+
+  //! Offsets of the slots of each row.
+  typedef Kokkos::View<size_type*, device_type> row_map_type;
+  //! Number of slots claimed in each row.
+  typedef Kokkos::View<size_type*, device_type> row_fill_type;
+  //! Column indices; the unfilled slots hold emptyColumn().
+  typedef Kokkos::View<non_const_ordinal_type*, device_type> index_type;
+  //! Values of the matrix.
+  typedef Kokkos::View<non_const_value_type*, device_type> values_type;
+  //! The CrsMatrix returned by compact().
+  typedef CrsMatrix<non_const_value_type, non_const_ordinal_type, device_type, void, size_type> crs_matrix_type;
+
+  row_map_type row_map;
+  row_fill_type row_fill;
+  index_type entries;
+  values_type values;
+
+  //! Default constructor; constructs an empty sparse matrix.
+  DynamicCrsMatrix () :
+    numRows_ (0), numCols_ (0), capacity_ (0)
+  {}
+
+  /// \brief Copies a CrsMatrix, in parallel on its execution space, and
+  ///   gives every row room for slack more entries.
+  ///
+  /// \param A [in] The CrsMatrix, in the same memory space.
+  /// \param slack [in] Number of spare slots per row.
+  template<class CrsMatrixType>
+  DynamicCrsMatrix (const CrsMatrixType& A, const size_type slack) :
+    numRows_ (A.numRows ()), numCols_ (A.numCols ()), capacity_ (0)
+  {
+    typedef typename CrsMatrixType::row_map_type src_row_map_type;
+    allocate_from (A.graph.row_map, src_row_map_type (), false,
+                   A.graph.entries, A.values, slack);
+  }
+
+  /// \brief Regrows the rows so that each has at least slack spare slots.
+  ///
+  /// Keeps the filled entries; the entries dropped by an overflow are not
+  /// recovered and have to be inserted again. Must not run concurrently
+  /// with the kernels that use the matrix.
+  void reserve (const size_type slack) {
+    DynamicCrsMatrix old = *this;
+    allocate_from (old.row_map, old.row_fill, true, old.entries, old.values, slack);
+  }
+
+  /// \brief Whether a sumIntoOrInsert call ran out of capacity since the
+  ///   construction or the last reserve().
+  bool overflowed () const {
+    size_type num = 0;
+    if (numRows_ > 0) {
+      Kokkos::parallel_reduce ("KokkosSparse::DynamicCrsMatrix::overflowed",
+          Kokkos::RangePolicy<execution_space> (0, numRows_),
+          Impl::DynamicCrsOverflowFunctor<DynamicCrsMatrix> (*this), num);
+    }
+    return num > 0;
+  }
+
+  /// \brief A CrsMatrix holding the filled entries only, in the order of
+  ///   each row.
+  crs_matrix_type compact () const {
+    typedef typename crs_matrix_type::row_map_type::non_const_type crs_row_map_type;
+    typedef typename crs_matrix_type::index_type::non_const_type crs_index_type;
+    typedef typename crs_matrix_type::values_type::non_const_type crs_values_type;
+
+    crs_row_map_type crs_row_map ("DynamicCrs compact row_map", numRows_ + 1);
+    size_type nnz = 0;
+    if (numRows_ > 0) {
+      Kokkos::parallel_for ("KokkosSparse::DynamicCrsMatrix::compact::count",
+          Kokkos::RangePolicy<execution_space> (0, numRows_),
+          Impl::DynamicCrsCapacityFunctor<row_map_type, row_fill_type, crs_row_map_type>
+            (row_map, row_fill, crs_row_map, 0, true));
+      KokkosKernels::Impl::exclusive_parallel_prefix_sum<crs_row_map_type, execution_space> (numRows_ + 1, crs_row_map);
+      Kokkos::deep_copy (nnz, Kokkos::subview (crs_row_map, numRows_));
+    }
+    crs_index_type crs_entries (Kokkos::ViewAllocateWithoutInitializing ("DynamicCrs compact entries"), nnz);
+    crs_values_type crs_values (Kokkos::ViewAllocateWithoutInitializing ("DynamicCrs compact values"), nnz);
+    if (numRows_ > 0) {
+      // the compact rows have no spare slots, so the copy only fills them.
+      DynamicCrsMatrix C;
+      C.numRows_ = numRows_;
+      C.numCols_ = numCols_;
+      C.row_map = row_map_type (crs_row_map.data (), numRows_ + 1);
+      C.row_fill = row_fill_type (Kokkos::ViewAllocateWithoutInitializing ("DynamicCrs compact fill"), numRows_);
+      C.entries = crs_entries;
+      C.values = crs_values;
+      Kokkos::parallel_for ("KokkosSparse::DynamicCrsMatrix::compact::fill",
+          Kokkos::RangePolicy<execution_space> (0, numRows_),
+          Impl::DynamicCrsCopyFunctor<row_map_type, row_fill_type, index_type, values_type, DynamicCrsMatrix>
+            (row_map, row_fill, true, entries, values, C));
+    }
+    return crs_matrix_type ("DynamicCrs compact", numRows_, numCols_, nnz,
+                            crs_values, crs_row_map, crs_entries);
+  }
+
+  /// \brief Adds val to the entry (row, col), inserting the entry if the
+  ///   row does not have it.
+  ///
+  /// Thread safe: may be called concurrently on any rows, from inside a
+  /// parallel kernel. A new entry claims the next spare slot of the row
+  /// with an atomic increment of row_fill(row). Threads that insert the
+  /// same new column of a row at the same time may each add an entry;
+  /// spmv sums such duplicates, as it does for a CrsMatrix.
+  ///
+  /// \return false if the row had no spare slot left; the entry is then
+  ///   dropped.
+  KOKKOS_INLINE_FUNCTION
+  bool sumIntoOrInsert (const ordinal_type row, const ordinal_type col,
+                        const non_const_value_type& val) const {
+    const size_type begin = row_map(row);
+    const size_type capacity = row_map(row + 1) - begin;
+    const size_type len = rowLength (row);
+    for (size_type k = 0; k < len; ++k) {
+      if (entries(begin + k) == col) {
+        Kokkos::atomic_add (&values(begin + k), val);
+        return true;
+      }
+    }
+    const size_type slot = Kokkos::atomic_fetch_add (&row_fill(row), size_type (1));
+    if (slot >= capacity) {
+      return false;
+    }
+    // publish the value before the column, so that a thread that finds the
+    // column adds to the inserted value and not under it.
+    values(begin + slot) = val;
+    Kokkos::memory_fence ();
+    entries(begin + slot) = col;
+    return true;
+  }
+
+  //! Number of filled slots of a row.
+  KOKKOS_INLINE_FUNCTION size_type rowLength (const ordinal_type row) const {
+    const size_type capacity = row_map(row + 1) - row_map(row);
+    const size_type fill = row_fill(row);
+    return fill < capacity ? fill : capacity;
+  }
+
+  //! Column index of the unfilled slots.
+  KOKKOS_INLINE_FUNCTION static non_const_ordinal_type emptyColumn () {
+    return Kokkos::Details::ArithTraits<non_const_ordinal_type>::max ();
+  }
+
+  //! The number of rows in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numRows () const {
+    return numRows_;
+  }
+
+  //! The number of columns in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numCols () const {
+    return numCols_;
+  }
+
+  //! The number of slots, filled or not.
+  KOKKOS_INLINE_FUNCTION size_type capacity () const {
+    return capacity_;
+  }
+
+private:
+  template<class SrcRowMap, class SrcFill, class SrcEntries, class SrcValues>
+  void allocate_from (const SrcRowMap& src_row_map, const SrcFill& src_fill, const bool has_fill,
+                      const SrcEntries& src_entries, const SrcValues& src_values, const size_type slack) {
+    row_map = row_map_type ("DynamicCrs row_map", numRows_ + 1);
+    row_fill = row_fill_type (Kokkos::ViewAllocateWithoutInitializing ("DynamicCrs row_fill"), numRows_);
+    capacity_ = 0;
+    if (numRows_ > 0) {
+      Kokkos::parallel_for ("KokkosSparse::DynamicCrsMatrix::capacity",
+          Kokkos::RangePolicy<execution_space> (0, numRows_),
+          Impl::DynamicCrsCapacityFunctor<SrcRowMap, SrcFill, row_map_type>
+            (src_row_map, src_fill, row_map, slack, has_fill));
+      KokkosKernels::Impl::exclusive_parallel_prefix_sum<row_map_type, execution_space> (numRows_ + 1, row_map);
+      Kokkos::deep_copy (capacity_, Kokkos::subview (row_map, numRows_));
+    }
+    entries = index_type (Kokkos::ViewAllocateWithoutInitializing ("DynamicCrs entries"), capacity_);
+    values = values_type (Kokkos::ViewAllocateWithoutInitializing ("DynamicCrs values"), capacity_);
+    if (numRows_ > 0) {
+      Kokkos::parallel_for ("KokkosSparse::DynamicCrsMatrix::copy",
+          Kokkos::RangePolicy<execution_space> (0, numRows_),
+          Impl::DynamicCrsCopyFunctor<SrcRowMap, SrcFill, SrcEntries, SrcValues, DynamicCrsMatrix>
+            (src_row_map, src_fill, has_fill, src_entries, src_values, *this));
+    }
+  }
+
+  ordinal_type numRows_;
+  ordinal_type numCols_;
+  size_type capacity_;
+};
+
+}
+}
+
+#endif
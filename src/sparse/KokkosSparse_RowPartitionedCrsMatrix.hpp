@@ -0,0 +1,305 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+/// \file KokkosSparse_RowPartitionedCrsMatrix.hpp
+/// \brief Sparse matrix partitioned by rows into independent CrsMatrix
+///   parts, e.g. one per device or per stream of a device.
+
+#ifndef KOKKOS_SPARSE_ROWPARTITIONEDCRSMATRIX_HPP_
+#define KOKKOS_SPARSE_ROWPARTITIONEDCRSMATRIX_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <algorithm>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+#include "KokkosSparse_CrsMatrix.hpp"
+
+namespace KokkosSparse {
+
+namespace Experimental {
+
+namespace Impl {
+
+// Row map of the rows [row_begin, row_end) of a matrix, starting from 0.
+template<class InRowMapType, class OutRowMapType>
+struct RowPartitionShiftFunctor {
+  typedef typename OutRowMapType::non_const_value_type size_type;
+
+  InRowMapType row_map;
+  OutRowMapType part_row_map;
+  const size_t row_begin;
+
+  RowPartitionShiftFunctor (const InRowMapType& row_map_, const OutRowMapType& part_row_map_,
+                            const size_t row_begin_) :
+    row_map (row_map_), part_row_map (part_row_map_), row_begin (row_begin_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& i) const
+  {
+    part_row_map(i) = row_map(row_begin + i) - row_map(row_begin);
+  }
+};
+
+// Row map of a part written at the rows [row_begin, row_end] of the
+// gathered matrix, shifted by the entries of the previous parts.
+template<class InRowMapType, class OutRowMapType>
+struct RowPartitionGatherFunctor {
+  typedef typename OutRowMapType::non_const_value_type size_type;
+
+  InRowMapType part_row_map;
+  OutRowMapType row_map;
+  const size_t row_begin;
+  const size_type offset;
+
+  RowPartitionGatherFunctor (const InRowMapType& part_row_map_, const OutRowMapType& row_map_,
+                             const size_t row_begin_, const size_type offset_) :
+    part_row_map (part_row_map_), row_map (row_map_), row_begin (row_begin_), offset (offset_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& i) const
+  {
+    row_map(row_begin + i) = part_row_map(i) + offset;
+  }
+};
+
+}
+
+/// \class RowPartitionedCrsMatrix
+/// \brief Sparse matrix partitioned by rows into independent parts.
+///
+/// Part p holds the rows [rowBegin(p), rowBegin(p+1)) of the matrix,
+/// renumbered from zero, with all the columns. Each part owns its row
+/// map, entries and values, so the parts can be computed with separately
+/// and in any order: spmv runs them on one execution space instance each,
+/// and the partitioned SpGEMM computes a part of C from each part of A
+/// with its own kernel handle. The result can be kept partitioned, or
+/// gathered into a single CrsMatrix.
+///
+/// \tparam ScalarType The type of the entries of the sparse matrix.
+/// \tparam OrdinalType The type of the column indices of the sparse matrix.
+/// \tparam Device The Kokkos Device type.
+/// \tparam SizeType The type of the row offsets.
+template<class ScalarType,
+         class OrdinalType,
+         class Device,
+         class SizeType = typename Kokkos::ViewTraits<OrdinalType*, Device, void, void>::size_type>
+class RowPartitionedCrsMatrix {
+public:
+  //! Type of the matrix's execution space.
+  typedef typename Device::execution_space execution_space;
+  //! Type of the matrix's memory space.
+  typedef typename Device::memory_space memory_space;
+  //! Type of the matrix's device type.
+  typedef Kokkos::Device<execution_space, memory_space> device_type;
+
+  //! Type of each value in the matrix.
+  typedef ScalarType value_type;
+  typedef typename std::remove_cv<ScalarType>::type non_const_value_type;
+  //! Type of each (column) index in the matrix.
+  typedef OrdinalType ordinal_type;
+  typedef typename std::remove_cv<OrdinalType>::type non_const_ordinal_type;
+  //! Type of the row offsets.
+  typedef SizeType size_type;
+
+  //! Type of a part, and of the gathered matrix.
+  typedef CrsMatrix<non_const_value_type, non_const_ordinal_type, device_type, void, size_type> matrix_type;
+  typedef Kokkos::View<size_type*, device_type> row_map_type;
+  typedef Kokkos::View<non_const_ordinal_type*, device_type> index_type;
+  typedef Kokkos::View<non_const_value_type*, device_type> values_type;
+
+  //! Default constructor; constructs an empty sparse matrix.
+  RowPartitionedCrsMatrix () :
+    numCols_ (0), rowBegins_ (1, 0)
+  {}
+
+  /// \brief Partitions a CrsMatrix into num_parts parts with about the
+  ///   same number of entries, copying each part.
+  ///
+  /// \param A [in] The CrsMatrix, in the same memory space.
+  /// \param num_parts [in] The number of parts; must be positive. Parts
+  ///   may be empty if A has fewer rows than parts.
+  template<class CrsMatrixType>
+  RowPartitionedCrsMatrix (const CrsMatrixType& A, const int num_parts) :
+    numCols_ (A.numCols ())
+  {
+    if (num_parts <= 0) {
+      std::ostringstream os;
+      os << "KokkosSparse::Experimental::RowPartitionedCrsMatrix: num_parts = "
+         << num_parts << " must be positive.";
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+    const size_t num_rows = A.numRows ();
+    auto h_row_map = Kokkos::create_mirror_view (A.graph.row_map);
+    Kokkos::deep_copy (h_row_map, A.graph.row_map);
+    const size_t nnz = num_rows > 0 ? size_t (h_row_map(num_rows)) : 0;
+
+    // The first row whose offset reaches p/num_parts of the entries.
+    rowBegins_.resize (num_parts + 1);
+    rowBegins_[0] = 0;
+    for (int p = 1; p < num_parts; ++p) {
+      const size_type target = size_type ((double (nnz) * p) / num_parts);
+      const auto first = h_row_map.data ();
+      size_t row = std::lower_bound (first, first + num_rows, target) - first;
+      rowBegins_[p] = std::max (size_t (rowBegins_[p - 1]), row);
+    }
+    rowBegins_[num_parts] = num_rows;
+
+    parts_.resize (num_parts);
+    for (int p = 0; p < num_parts; ++p) {
+      const size_t row_begin = rowBegins_[p];
+      const size_t part_rows = rowBegins_[p + 1] - row_begin;
+      const size_t begin = num_rows > 0 ? size_t (h_row_map(row_begin)) : 0;
+      const size_t end = num_rows > 0 ? size_t (h_row_map(row_begin + part_rows)) : 0;
+
+      row_map_type part_row_map (Kokkos::ViewAllocateWithoutInitializing ("RowPartitionedCrs row_map"), part_rows + 1);
+      if (num_rows > 0) {
+        Kokkos::parallel_for ("KokkosSparse::RowPartitionedCrsMatrix::shift",
+            Kokkos::RangePolicy<execution_space> (0, part_rows + 1),
+            Impl::RowPartitionShiftFunctor<typename CrsMatrixType::row_map_type, row_map_type> (
+                A.graph.row_map, part_row_map, row_begin));
+      } else {
+        Kokkos::deep_copy (part_row_map, size_type (0));
+      }
+      index_type part_entries (Kokkos::ViewAllocateWithoutInitializing ("RowPartitionedCrs entries"), end - begin);
+      values_type part_values (Kokkos::ViewAllocateWithoutInitializing ("RowPartitionedCrs values"), end - begin);
+      Kokkos::deep_copy (part_entries, Kokkos::subview (A.graph.entries, std::make_pair (begin, end)));
+      Kokkos::deep_copy (part_values, Kokkos::subview (A.values, std::make_pair (begin, end)));
+
+      parts_[p] = matrix_type ("RowPartitionedCrs part", part_rows, numCols_, end - begin,
+                               part_values, part_row_map, part_entries);
+    }
+  }
+
+  /// \brief Makes a partitioned matrix of parts that were computed
+  ///   separately, e.g. by the partitioned SpGEMM. The parts are not copied.
+  ///
+  /// \param num_cols [in] The number of columns of every part.
+  /// \param parts [in] The parts, in the order of their rows.
+  RowPartitionedCrsMatrix (const ordinal_type num_cols, const std::vector<matrix_type>& parts) :
+    numCols_ (num_cols), parts_ (parts), rowBegins_ (parts.size () + 1, 0)
+  {
+    for (size_t p = 0; p < parts_.size (); ++p) {
+      if (parts_[p].numCols () != numCols_) {
+        std::ostringstream os;
+        os << "KokkosSparse::Experimental::RowPartitionedCrsMatrix: part " << p
+           << " has " << parts_[p].numCols () << " columns instead of " << numCols_ << ".";
+        Kokkos::Impl::throw_runtime_exception (os.str ());
+      }
+      rowBegins_[p + 1] = rowBegins_[p] + parts_[p].numRows ();
+    }
+  }
+
+  /// \brief Gathers the parts into a single CrsMatrix, in parallel on
+  ///   the execution space of the matrix.
+  matrix_type gather () const
+  {
+    const size_t num_rows = numRows ();
+    const size_t num_nnz = nnz ();
+    row_map_type row_map (Kokkos::ViewAllocateWithoutInitializing ("RowPartitionedCrs gathered row_map"), num_rows + 1);
+    index_type entries (Kokkos::ViewAllocateWithoutInitializing ("RowPartitionedCrs gathered entries"), num_nnz);
+    values_type values (Kokkos::ViewAllocateWithoutInitializing ("RowPartitionedCrs gathered values"), num_nnz);
+    Kokkos::deep_copy (Kokkos::subview (row_map, 0), size_type (0));
+
+    size_type offset = 0;
+    for (size_t p = 0; p < parts_.size (); ++p) {
+      const matrix_type& part = parts_[p];
+      const size_t part_nnz = part.nnz ();
+      if (part.numRows () > 0) {
+        Kokkos::parallel_for ("KokkosSparse::RowPartitionedCrsMatrix::gather",
+            Kokkos::RangePolicy<execution_space> (1, part.numRows () + 1),
+            Impl::RowPartitionGatherFunctor<typename matrix_type::row_map_type, row_map_type> (
+                part.graph.row_map, row_map, rowBegins_[p], offset));
+      }
+      const std::pair<size_t, size_t> range (offset, offset + part_nnz);
+      Kokkos::deep_copy (Kokkos::subview (entries, range), part.graph.entries);
+      Kokkos::deep_copy (Kokkos::subview (values, range), part.values);
+      offset += part_nnz;
+    }
+    return matrix_type ("RowPartitionedCrs gathered", numRows (), numCols_, num_nnz,
+                        values, row_map, entries);
+  }
+
+  //! The number of parts.
+  int numParts () const {
+    return static_cast<int> (parts_.size ());
+  }
+
+  //! Part p, with the rows [rowBegin(p), rowBegin(p+1)).
+  const matrix_type& part (const int p) const {
+    return parts_[p];
+  }
+
+  //! The first row of part p; rowBegin(numParts()) is numRows().
+  ordinal_type rowBegin (const int p) const {
+    return rowBegins_[p];
+  }
+
+  //! The number of rows in the sparse matrix.
+  ordinal_type numRows () const {
+    return rowBegins_.back ();
+  }
+
+  //! The number of columns in the sparse matrix.
+  ordinal_type numCols () const {
+    return numCols_;
+  }
+
+  //! The number of stored entries in the sparse matrix.
+  size_type nnz () const {
+    size_type n = 0;
+    for (size_t p = 0; p < parts_.size (); ++p) {
+      n += parts_[p].nnz ();
+    }
+    return n;
+  }
+
+private:
+  ordinal_type numCols_;
+  std::vector<matrix_type> parts_;
+  std::vector<ordinal_type> rowBegins_;
+};
+
+}
+}
+
+#endif
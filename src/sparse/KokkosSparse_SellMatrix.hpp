@@ -0,0 +1,278 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_SellMatrix.hpp
+/// \brief Local sparse matrix in sliced ELLPACK (SELL-C-sigma) format.
+
+#ifndef KOKKOS_SPARSE_SELLMATRIX_HPP_
+#define KOKKOS_SPARSE_SELLMATRIX_HPP_
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "KokkosSparse_CrsMatrix.hpp"
+
+namespace KokkosSparse {
+
+namespace Experimental {
+
+namespace Impl {
+
+// Fills the padded chunks of a SellMatrix from a CrsMatrix: lane l of chunk c
+// holds the row row_perm(c*C + l), and its j-th entry is at
+// chunk_offsets(c) + j*C + l. Rows shorter than the chunk, and the lanes after
+// the last row, are padded with zeroes in column 0.
+template<class CrsMatrixType, class SellMatrixType>
+struct SellFillFunctor {
+  typedef typename SellMatrixType::ordinal_type ordinal_type;
+  typedef typename SellMatrixType::size_type size_type;
+  typedef typename SellMatrixType::value_type value_type;
+
+  CrsMatrixType A;
+  typename SellMatrixType::row_perm_type row_perm;
+  typename SellMatrixType::chunk_offsets_type chunk_offsets;
+  typename SellMatrixType::index_type entries;
+  typename SellMatrixType::values_type values;
+  const ordinal_type numRows;
+  const ordinal_type chunk_size;
+
+  SellFillFunctor (const CrsMatrixType A_, const SellMatrixType& S) :
+    A (A_), row_perm (S.row_perm), chunk_offsets (S.chunk_offsets),
+    entries (S.entries), values (S.values),
+    numRows (S.numRows ()), chunk_size (S.chunkSize ()) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& lane_index) const
+  {
+    const ordinal_type chunk = lane_index / chunk_size;
+    const ordinal_type lane = lane_index % chunk_size;
+    const size_type begin = chunk_offsets(chunk);
+    const ordinal_type width = (chunk_offsets(chunk + 1) - begin) / chunk_size;
+
+    ordinal_type length = 0;
+    size_type row_begin = 0;
+    if (lane_index < numRows) {
+      const ordinal_type row = row_perm(lane_index);
+      row_begin = A.graph.row_map(row);
+      length = A.graph.row_map(row + 1) - row_begin;
+    }
+    for (ordinal_type j = 0; j < width; ++j) {
+      const size_type pos = begin + j * chunk_size + lane;
+      if (j < length) {
+        entries(pos) = A.graph.entries(row_begin + j);
+        values(pos) = A.values(row_begin + j);
+      } else {
+        entries(pos) = 0;
+        values(pos) = Kokkos::Details::ArithTraits<value_type>::zero ();
+      }
+    }
+  }
+};
+
+}
+
+/// \class SellMatrix
+/// \brief Local sparse matrix in SELL-C-sigma format.
+///
+/// The rows are sorted by decreasing length within windows of sigma
+/// rows, and the sorted rows are grouped into chunks of C rows. A
+/// chunk is stored column major and padded to its longest row, so that
+/// the C lanes of a chunk read consecutive entries: C is the SIMD
+/// width on CPUs, and a multiple of the warp size on Cuda. A larger
+/// sigma reduces the padding, at the cost of less locality in y.
+///
+/// \tparam ScalarType The type of the entries of the sparse matrix.
+/// \tparam OrdinalType The type of the column indices of the sparse matrix.
+/// \tparam Device The Kokkos Device type.
+/// \tparam SizeType The type of the chunk offsets.
+template<class ScalarType,
+         class OrdinalType,
+         class Device,
+         class SizeType = typename Kokkos::ViewTraits<OrdinalType*, Device, void, void>::size_type>
+class SellMatrix {
+public:
+  //! Type of the matrix's execution space.
+  typedef typename Device::execution_space execution_space;
+  //! Type of the matrix's memory space.
+  typedef typename Device::memory_space memory_space;
+  //! Type of the matrix's device type.
+  typedef Kokkos::Device<execution_space, memory_space> device_type;
+
+  //! Type of each value in the matrix.
+  typedef ScalarType value_type;
+  typedef typename std::remove_cv<ScalarType>::type non_const_value_type;
+  //! Type of each (column) index in the matrix.
+  typedef OrdinalType ordinal_type;
+  typedef typename std::remove_cv<OrdinalType>::type non_const_ordinal_type;
+  //! Type of the chunk offsets.
+  typedef SizeType size_type;
+
+  //! Column indices of the padded chunks.
+  typedef Kokkos::View<non_const_ordinal_type*, device_type> index_type;
+  //! Values of the padded chunks.
+  typedef Kokkos::View<non_const_value_type*, device_type> values_type;
+  //! Offset of each chunk in entries and values.
+  typedef Kokkos::View<size_type*, device_type> chunk_offsets_type;
+  //! Row of the CrsMatrix for each sorted row.
+  typedef Kokkos::View<non_const_ordinal_type*, device_type> row_perm_type;
+
+  chunk_offsets_type chunk_offsets;
+  row_perm_type row_perm;
+  index_type entries;
+  values_type values;
+
+  //! Default constructor; constructs an empty sparse matrix.
+  SellMatrix () :
+    numRows_ (0), numCols_ (0), nnz_ (0), chunkSize_ (1), sigma_ (1)
+  {}
+
+  /// \brief Converts a CrsMatrix to SELL-C-sigma.
+  ///
+  /// \param A [in] The CrsMatrix, in the same memory space.
+  /// \param chunkSize [in] The number of rows of a chunk (C).
+  /// \param sigma [in] The number of rows of a sorting window; 1 keeps the
+  ///   rows of A in order.
+  template<class CrsMatrixType>
+  SellMatrix (const CrsMatrixType& A,
+              const OrdinalType chunkSize,
+              const OrdinalType sigma) :
+    numRows_ (A.numRows ()), numCols_ (A.numCols ()), nnz_ (A.nnz ()),
+    chunkSize_ (chunkSize), sigma_ (sigma)
+  {
+    if (chunkSize < 1 || sigma < 1) {
+      std::ostringstream os;
+      os << "KokkosSparse::SellMatrix: chunkSize (" << chunkSize << ") and sigma ("
+         << sigma << ") must be positive.";
+      throw std::runtime_error (os.str ());
+    }
+    typedef typename CrsMatrixType::row_map_type::non_const_type row_map_t;
+
+    //the permutation and the chunk widths are computed on the host; only the
+    //copy of the entries runs on the device.
+    typename row_map_t::HostMirror h_row_map (Kokkos::ViewAllocateWithoutInitializing ("SELL h_row_map"), A.graph.row_map.extent (0));
+    Kokkos::deep_copy (h_row_map, A.graph.row_map);
+
+    const ordinal_type numChunks = (numRows_ + chunkSize - 1) / chunkSize;
+    row_perm = row_perm_type (Kokkos::ViewAllocateWithoutInitializing ("SELL row_perm"), numRows_);
+    chunk_offsets = chunk_offsets_type ("SELL chunk_offsets", numChunks + 1);
+    typename row_perm_type::HostMirror h_row_perm = Kokkos::create_mirror_view (row_perm);
+    typename chunk_offsets_type::HostMirror h_chunk_offsets = Kokkos::create_mirror_view (chunk_offsets);
+
+    for (ordinal_type i = 0; i < numRows_; ++i) {
+      h_row_perm(i) = i;
+    }
+    for (ordinal_type w = 0; w < numRows_; w += sigma) {
+      const ordinal_type w_end = std::min<ordinal_type> (w + sigma, numRows_);
+      std::stable_sort (h_row_perm.data () + w, h_row_perm.data () + w_end,
+          [&] (const non_const_ordinal_type a, const non_const_ordinal_type b) {
+            return h_row_map(a + 1) - h_row_map(a) > h_row_map(b + 1) - h_row_map(b);
+          });
+    }
+
+    h_chunk_offsets(0) = 0;
+    for (ordinal_type c = 0; c < numChunks; ++c) {
+      size_type width = 0;
+      const ordinal_type c_end = std::min<ordinal_type> ((c + 1) * chunkSize, numRows_);
+      for (ordinal_type i = c * chunkSize; i < c_end; ++i) {
+        const size_type length = h_row_map(h_row_perm(i) + 1) - h_row_map(h_row_perm(i));
+        if (length > width) width = length;
+      }
+      h_chunk_offsets(c + 1) = h_chunk_offsets(c) + width * chunkSize;
+    }
+    Kokkos::deep_copy (row_perm, h_row_perm);
+    Kokkos::deep_copy (chunk_offsets, h_chunk_offsets);
+
+    const size_type padded_size = h_chunk_offsets(numChunks);
+    entries = index_type (Kokkos::ViewAllocateWithoutInitializing ("SELL entries"), padded_size);
+    values = values_type (Kokkos::ViewAllocateWithoutInitializing ("SELL values"), padded_size);
+
+    Kokkos::parallel_for ("KokkosSparse::SellMatrix::fill",
+        Kokkos::RangePolicy<execution_space> (0, numChunks * chunkSize),
+        Impl::SellFillFunctor<CrsMatrixType, SellMatrix> (A, *this));
+  }
+
+  //! The number of rows in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numRows () const {
+    return numRows_;
+  }
+
+  //! The number of columns in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numCols () const {
+    return numCols_;
+  }
+
+  //! The number of stored entries of the CrsMatrix, without padding.
+  KOKKOS_INLINE_FUNCTION size_type nnz () const {
+    return nnz_;
+  }
+
+  //! The number of rows of a chunk (C).
+  KOKKOS_INLINE_FUNCTION ordinal_type chunkSize () const {
+    return chunkSize_;
+  }
+
+  //! The number of rows of a sorting window (sigma).
+  KOKKOS_INLINE_FUNCTION ordinal_type sigma () const {
+    return sigma_;
+  }
+
+  //! The number of chunks.
+  KOKKOS_INLINE_FUNCTION ordinal_type numChunks () const {
+    return chunk_offsets.extent (0) == 0 ? 0 : static_cast<ordinal_type> (chunk_offsets.extent (0)) - 1;
+  }
+
+private:
+  ordinal_type numRows_;
+  ordinal_type numCols_;
+  size_type nnz_;
+  ordinal_type chunkSize_;
+  ordinal_type sigma_;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,277 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+/// \file KokkosSparse_SplitCrsMatrix.hpp
+/// \brief Local sparse matrix split by column into the columns owned by
+///   the process and the ghost columns received from other processes.
+
+#ifndef KOKKOS_SPARSE_SPLITCRSMATRIX_HPP_
+#define KOKKOS_SPARSE_SPLITCRSMATRIX_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include <type_traits>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+
+namespace KokkosSparse {
+
+namespace Experimental {
+
+namespace Impl {
+
+// Number of owned and ghost entries of each row.
+template<class CrsMatrixType, class SplitCrsMatrixType>
+struct SplitCrsCountFunctor {
+  typedef typename SplitCrsMatrixType::ordinal_type ordinal_type;
+  typedef typename SplitCrsMatrixType::size_type size_type;
+
+  CrsMatrixType A;
+  typename SplitCrsMatrixType::row_map_type owned_row_map;
+  typename SplitCrsMatrixType::row_map_type ghost_row_map;
+  const ordinal_type threshold;
+
+  SplitCrsCountFunctor (const CrsMatrixType A_,
+                        const typename SplitCrsMatrixType::row_map_type& owned_row_map_,
+                        const typename SplitCrsMatrixType::row_map_type& ghost_row_map_,
+                        const ordinal_type threshold_) :
+    A (A_), owned_row_map (owned_row_map_), ghost_row_map (ghost_row_map_),
+    threshold (threshold_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    const size_type begin = A.graph.row_map(i);
+    const size_type end = A.graph.row_map(i + 1);
+    size_type num_owned = 0;
+    for (size_type k = begin; k < end; ++k) {
+      if (A.graph.entries(k) < threshold) ++num_owned;
+    }
+    owned_row_map(i) = num_owned;
+    ghost_row_map(i) = (end - begin) - num_owned;
+  }
+};
+
+// Entries of each row, in their order in the CrsMatrix. The ghost columns
+// are shifted down by the threshold.
+template<class CrsMatrixType, class SplitCrsMatrixType>
+struct SplitCrsFillFunctor {
+  typedef typename SplitCrsMatrixType::ordinal_type ordinal_type;
+  typedef typename SplitCrsMatrixType::size_type size_type;
+
+  CrsMatrixType A;
+  typename SplitCrsMatrixType::row_map_type owned_row_map;
+  typename SplitCrsMatrixType::index_type owned_entries;
+  typename SplitCrsMatrixType::values_type owned_values;
+  typename SplitCrsMatrixType::row_map_type ghost_row_map;
+  typename SplitCrsMatrixType::index_type ghost_entries;
+  typename SplitCrsMatrixType::values_type ghost_values;
+  const ordinal_type threshold;
+
+  SplitCrsFillFunctor (const CrsMatrixType A_,
+                       const typename SplitCrsMatrixType::row_map_type& owned_row_map_,
+                       const typename SplitCrsMatrixType::index_type& owned_entries_,
+                       const typename SplitCrsMatrixType::values_type& owned_values_,
+                       const typename SplitCrsMatrixType::row_map_type& ghost_row_map_,
+                       const typename SplitCrsMatrixType::index_type& ghost_entries_,
+                       const typename SplitCrsMatrixType::values_type& ghost_values_,
+                       const ordinal_type threshold_) :
+    A (A_),
+    owned_row_map (owned_row_map_), owned_entries (owned_entries_), owned_values (owned_values_),
+    ghost_row_map (ghost_row_map_), ghost_entries (ghost_entries_), ghost_values (ghost_values_),
+    threshold (threshold_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    size_type owned_k = owned_row_map(i);
+    size_type ghost_k = ghost_row_map(i);
+    for (size_type k = A.graph.row_map(i); k < A.graph.row_map(i + 1); ++k) {
+      const ordinal_type col = A.graph.entries(k);
+      if (col < threshold) {
+        owned_entries(owned_k) = col;
+        owned_values(owned_k) = A.values(k);
+        ++owned_k;
+      } else {
+        ghost_entries(ghost_k) = col - threshold;
+        ghost_values(ghost_k) = A.values(k);
+        ++ghost_k;
+      }
+    }
+  }
+};
+
+}
+
+/// \class SplitCrsMatrix
+/// \brief Local sparse matrix split into an owned and a ghost part.
+///
+/// In a distributed matrix whose local columns are ordered owned first
+/// and then received (ghost), the entries of the columns below the
+/// threshold only need the local part of the input vector. Splitting
+/// them into their own CrsMatrix lets the owned product run while the
+/// halo exchange of the ghost entries is in flight; the ghost part then
+/// adds its product once they have arrived.
+///
+/// owned has the columns [0, threshold) of the matrix and threshold
+/// columns. ghost has the columns [threshold, numCols) renumbered from
+/// zero, and numCols - threshold columns. Both have all the rows, and
+/// keep the order of the entries within a row.
+///
+/// \tparam ScalarType The type of the entries of the sparse matrix.
+/// \tparam OrdinalType The type of the column indices of the sparse matrix.
+/// \tparam Device The Kokkos Device type.
+/// \tparam SizeType The type of the row offsets.
+template<class ScalarType,
+         class OrdinalType,
+         class Device,
+         class SizeType = typename Kokkos::ViewTraits<OrdinalType*, Device, void, void>::size_type>
+class SplitCrsMatrix {
+public:
+  //! Type of the matrix's execution space.
+  typedef typename Device::execution_space execution_space;
+  //! Type of the matrix's memory space.
+  typedef typename Device::memory_space memory_space;
+  //! Type of the matrix's device type.
+  typedef Kokkos::Device<execution_space, memory_space> device_type;
+
+  //! Type of each value in the matrix.
+  typedef ScalarType value_type;
+  typedef typename std::remove_cv<ScalarType>::type non_const_value_type;
+  //! Type of each (column) index in the matrix.
+  typedef OrdinalType ordinal_type;
+  typedef typename std::remove_cv<OrdinalType>::type non_const_ordinal_type;
+  //! Type of the row offsets.
+  typedef SizeType size_type;
+
+  //! Type of the owned and of the ghost part.
+  typedef CrsMatrix<non_const_value_type, non_const_ordinal_type, device_type, void, size_type> matrix_type;
+  typedef Kokkos::View<size_type*, device_type> row_map_type;
+  typedef Kokkos::View<non_const_ordinal_type*, device_type> index_type;
+  typedef Kokkos::View<non_const_value_type*, device_type> values_type;
+
+  //! Entries of the columns [0, threshold).
+  matrix_type owned;
+  //! Entries of the columns [threshold, numCols), shifted down by threshold.
+  matrix_type ghost;
+
+  //! Default constructor; constructs an empty sparse matrix.
+  SplitCrsMatrix () :
+    numRows_ (0), numCols_ (0), threshold_ (0)
+  {}
+
+  /// \brief Splits a CrsMatrix, in parallel on its execution space.
+  ///
+  /// \param A [in] The CrsMatrix, in the same memory space.
+  /// \param column_threshold [in] The first ghost column; must be in
+  ///   [0, A.numCols()].
+  template<class CrsMatrixType>
+  SplitCrsMatrix (const CrsMatrixType& A, const ordinal_type column_threshold) :
+    numRows_ (A.numRows ()), numCols_ (A.numCols ()), threshold_ (column_threshold)
+  {
+    if (column_threshold < 0 || column_threshold > numCols_) {
+      std::ostringstream os;
+      os << "KokkosSparse::Experimental::SplitCrsMatrix: column_threshold = "
+         << column_threshold << " is not in [0, " << numCols_ << "].";
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+    row_map_type owned_row_map ("SplitCrs owned row_map", numRows_ + 1);
+    row_map_type ghost_row_map ("SplitCrs ghost row_map", numRows_ + 1);
+
+    size_type owned_nnz = 0, ghost_nnz = 0;
+    if (numRows_ > 0) {
+      Kokkos::parallel_for ("KokkosSparse::SplitCrsMatrix::count",
+          Kokkos::RangePolicy<execution_space> (0, numRows_),
+          Impl::SplitCrsCountFunctor<CrsMatrixType, SplitCrsMatrix> (A, owned_row_map, ghost_row_map, threshold_));
+      KokkosKernels::Impl::exclusive_parallel_prefix_sum<row_map_type, execution_space> (numRows_ + 1, owned_row_map);
+      KokkosKernels::Impl::exclusive_parallel_prefix_sum<row_map_type, execution_space> (numRows_ + 1, ghost_row_map);
+      Kokkos::deep_copy (owned_nnz, Kokkos::subview (owned_row_map, numRows_));
+      Kokkos::deep_copy (ghost_nnz, Kokkos::subview (ghost_row_map, numRows_));
+    }
+    index_type owned_entries (Kokkos::ViewAllocateWithoutInitializing ("SplitCrs owned entries"), owned_nnz);
+    values_type owned_values (Kokkos::ViewAllocateWithoutInitializing ("SplitCrs owned values"), owned_nnz);
+    index_type ghost_entries (Kokkos::ViewAllocateWithoutInitializing ("SplitCrs ghost entries"), ghost_nnz);
+    values_type ghost_values (Kokkos::ViewAllocateWithoutInitializing ("SplitCrs ghost values"), ghost_nnz);
+    if (numRows_ > 0) {
+      Kokkos::parallel_for ("KokkosSparse::SplitCrsMatrix::fill",
+          Kokkos::RangePolicy<execution_space> (0, numRows_),
+          Impl::SplitCrsFillFunctor<CrsMatrixType, SplitCrsMatrix> (A,
+              owned_row_map, owned_entries, owned_values,
+              ghost_row_map, ghost_entries, ghost_values, threshold_));
+    }
+
+    owned = matrix_type ("SplitCrs owned", numRows_, threshold_, owned_nnz,
+                         owned_values, owned_row_map, owned_entries);
+    ghost = matrix_type ("SplitCrs ghost", numRows_, numCols_ - threshold_, ghost_nnz,
+                         ghost_values, ghost_row_map, ghost_entries);
+  }
+
+  //! The number of rows in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION ordinal_type numRows () const {
+    return numRows_;
+  }
+
+  //! The number of columns in the sparse matrix, owned and ghost.
+  KOKKOS_INLINE_FUNCTION ordinal_type numCols () const {
+    return numCols_;
+  }
+
+  //! The first ghost column.
+  KOKKOS_INLINE_FUNCTION ordinal_type columnThreshold () const {
+    return threshold_;
+  }
+
+  //! The number of stored entries in the sparse matrix.
+  KOKKOS_INLINE_FUNCTION size_type nnz () const {
+    return owned.nnz () + ghost.nnz ();
+  }
+
+private:
+  ordinal_type numRows_;
+  ordinal_type numCols_;
+  ordinal_type threshold_;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,138 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_analysis.hpp
+/// \brief Structure statistics of a sparse matrix, computed by
+///   KokkosSparse::analyze and attached to the handles that use them.
+
+#ifndef KOKKOSSPARSE_ANALYSIS_HPP_
+#define KOKKOSSPARSE_ANALYSIS_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include "KokkosKernels_ExecSpaceUtils.hpp"
+
+namespace KokkosSparse {
+
+/**
+ * \brief Structure statistics of a CrsMatrix or a BlockCrsMatrix, computed
+ * by KokkosSparse::analyze.
+ * For a BlockCrsMatrix, the row statistics, the bandwidth, the symmetry and
+ * the sortedness are of the graph of the blocks, block_size is the block
+ * dimension, and the diagonal dominance is of the point rows. For a
+ * CrsMatrix, block_size is the largest of 2, 3, 4, 5, 6 and 8 whose aligned
+ * dense blocks make up the pattern of the matrix, and 1 if there is none.
+ * The matrix is identified by its row map and sizes, like the plans of the
+ * handles, so analyze it again if its pattern changes in place.
+ */
+struct MatrixAnalysis{
+  bool is_analyzed;
+  //the matrix analyzed.
+  const void *row_map;
+  int64_t num_rows;
+  int64_t num_cols;
+  size_t nnz;
+  bool is_block_matrix;
+  int block_size;
+
+  size_t min_row_length;
+  size_t max_row_length;
+  double mean_row_length;
+  double row_length_variance;
+  KokkosKernels::Impl::kk_row_length_histogram row_length_histogram;
+
+  //largest i - j and j - i over the entries (i, j), 0 if there are none.
+  int64_t lower_bandwidth;
+  int64_t upper_bandwidth;
+  //entries (i, j) without an entry (j, i), nnz for rectangular matrices.
+  size_t num_asymmetric_entries;
+  //rows whose columns are not in ascending order.
+  size_t num_unsorted_rows;
+  //point rows with a diagonal entry, and those whose diagonal is at least,
+  //or larger than, the sum of the magnitudes of their off diagonal entries.
+  size_t num_rows_with_diagonal;
+  size_t num_diagonally_dominant_rows;
+  size_t num_strictly_diagonally_dominant_rows;
+
+  MatrixAnalysis():
+    is_analyzed(false), row_map(NULL), num_rows(0), num_cols(0), nnz(0),
+    is_block_matrix(false), block_size(1),
+    min_row_length(0), max_row_length(0), mean_row_length(0), row_length_variance(0),
+    row_length_histogram(), lower_bandwidth(0), upper_bandwidth(0),
+    num_asymmetric_entries(0), num_unsorted_rows(0), num_rows_with_diagonal(0),
+    num_diagonally_dominant_rows(0), num_strictly_diagonally_dominant_rows(0){}
+
+  /**
+   * \brief returns true if this is the analysis of a matrix with this row
+   * map and sizes.
+   */
+  bool is_for(const void *row_map_, const int64_t num_rows_, const size_t nnz_) const {
+    return this->is_analyzed && this->row_map == row_map_ &&
+        this->num_rows == num_rows_ && this->nnz == nnz_;
+  }
+
+  int64_t num_point_rows() const {
+    return this->is_block_matrix ? this->num_rows * this->block_size : this->num_rows;
+  }
+  int64_t bandwidth() const {
+    return this->lower_bandwidth > this->upper_bandwidth ? this->lower_bandwidth : this->upper_bandwidth;
+  }
+  bool is_pattern_symmetric() const {
+    return this->num_rows == this->num_cols && this->num_asymmetric_entries == 0;
+  }
+  bool are_rows_sorted() const {return this->num_unsorted_rows == 0;}
+  bool has_full_diagonal() const {
+    return this->num_rows_with_diagonal == size_t(this->num_point_rows());
+  }
+  bool is_diagonally_dominant() const {
+    return this->num_diagonally_dominant_rows == size_t(this->num_point_rows());
+  }
+  bool is_strictly_diagonally_dominant() const {
+    return this->num_strictly_diagonally_dominant_rows == size_t(this->num_point_rows());
+  }
+  bool has_dense_blocks() const {return this->block_size > 1;}
+};
+
+}
+
+#endif
@@ -0,0 +1,100 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_analyze.hpp
+/// \brief Structure statistics of a CrsMatrix or a BlockCrsMatrix, for
+///   the choice of kernels and their parameters.
+
+#ifndef KOKKOSSPARSE_ANALYZE_HPP_
+#define KOKKOSSPARSE_ANALYZE_HPP_
+
+#include "Kokkos_Core.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_BlockCrsMatrix.hpp"
+#include "KokkosSparse_analysis.hpp"
+#include "KokkosSparse_analyze_impl.hpp"
+
+namespace KokkosSparse {
+
+/// \brief Returns the structure statistics of A: the minimum, maximum,
+///   mean and variance of the row lengths and their histogram, the
+///   lower and upper bandwidths, the entries without a transposed entry,
+///   the unsorted rows, the diagonally dominant rows, and the size of
+///   the aligned dense blocks the pattern is made of.
+///
+/// All but the pattern symmetry are computed in a single parallel pass
+/// over the rows; the symmetry of a square pattern takes a second pass,
+/// with binary searches if the rows are sorted.
+///
+/// Attach the result to the handles that use it, with
+/// KokkosKernelsHandle::set_matrix_analysis (the suggested vector size
+/// and the SPGEMM_KK_AUTO algorithm choice) and
+/// SPMVHandle::set_analysis (the inspection of spmv).
+///
+/// \param A [in] The sparse matrix.
+template <class ScalarType, class OrdinalType, class Device, class MemoryTraits, class SizeType>
+MatrixAnalysis
+analyze (const CrsMatrix<ScalarType, OrdinalType, Device, MemoryTraits, SizeType>& A)
+{
+  typedef CrsMatrix<ScalarType, OrdinalType, Device, MemoryTraits, SizeType> matrix_t;
+  return Impl::analyze_matrix<typename matrix_t::execution_space>
+    (A.numRows (), A.numCols (), A.graph.row_map, A.graph.entries, A.values, 1, false);
+}
+
+/// \brief Returns the structure statistics of the graph of the blocks of
+///   A, with the diagonal dominance of its point rows, see analyze for a
+///   CrsMatrix. block_size is the block dimension of A.
+///
+/// \param A [in] The block sparse matrix.
+template <class ScalarType, class OrdinalType, class Device, class MemoryTraits, class SizeType>
+MatrixAnalysis
+analyze (const Experimental::BlockCrsMatrix<ScalarType, OrdinalType, Device, MemoryTraits, SizeType>& A)
+{
+  typedef Experimental::BlockCrsMatrix<ScalarType, OrdinalType, Device, MemoryTraits, SizeType> matrix_t;
+  return Impl::analyze_matrix<typename matrix_t::execution_space>
+    (A.numRows (), A.numCols (), A.graph.row_map, A.graph.entries, A.values, A.blockDim (), true);
+}
+
+}
+
+#endif
@@ -0,0 +1,426 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_assembly.hpp
+/// \brief Finite element assembly: the CRS graph of an element-to-node
+///   connectivity, and an atomic-free gather of element matrices into it.
+
+#ifndef KOKKOS_SPARSE_ASSEMBLY_HPP_
+#define KOKKOS_SPARSE_ASSEMBLY_HPP_
+
+#include "Kokkos_Core.hpp"
+#include "impl/Kokkos_Timer.hpp"
+#include <sstream>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+
+namespace KokkosSparse {
+
+namespace Experimental {
+
+namespace Impl {
+
+template<class ElemNodeView, class RowMapView>
+struct AssemblyCountFunctor {
+  typedef typename RowMapView::non_const_value_type size_type;
+
+  ElemNodeView elem_node;
+  RowMapView row_counts;
+  const size_t nrows;
+
+  AssemblyCountFunctor (const ElemNodeView& elem_node_, const RowMapView& row_counts_, const size_t nrows_) :
+    elem_node (elem_node_), row_counts (row_counts_), nrows (nrows_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& e) const
+  {
+    for (size_t i = 0; i < elem_node.extent(1); ++i) {
+      const size_t n = elem_node(e, i);
+      if (n < nrows) Kokkos::atomic_fetch_add (&row_counts(n), size_type (1));
+    }
+  }
+};
+
+template<class ElemNodeView, class RowMapView, class NodeElemView>
+struct AssemblyScatterFunctor {
+  typedef typename RowMapView::non_const_value_type size_type;
+
+  ElemNodeView elem_node;
+  RowMapView cursor;
+  NodeElemView node_elem;
+  const size_t nrows;
+
+  AssemblyScatterFunctor (const ElemNodeView& elem_node_, const RowMapView& cursor_,
+                          const NodeElemView& node_elem_, const size_t nrows_) :
+    elem_node (elem_node_), cursor (cursor_), node_elem (node_elem_), nrows (nrows_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& e) const
+  {
+    const size_t nlocal = elem_node.extent(1);
+    for (size_t i = 0; i < nlocal; ++i) {
+      const size_t n = elem_node(e, i);
+      if (n < nrows) {
+        const size_type pos = Kokkos::atomic_fetch_add (&cursor(n), size_type (1));
+        node_elem(pos) = e * nlocal + i;
+      }
+    }
+  }
+};
+
+//the candidate columns of a row are the nodes of all elements of the row
+//node, with duplicates; the candidate row map is the node->element row
+//map scaled by the nodes per element.
+template<class ElemNodeView, class RowMapView, class NodeElemView, class EntriesView>
+struct AssemblyCandidatesFunctor {
+  typedef typename RowMapView::non_const_value_type size_type;
+  typedef typename EntriesView::non_const_value_type ordinal_type;
+
+  struct ScaleTag {};
+  struct FillTag {};
+
+  ElemNodeView elem_node;
+  RowMapView node_elem_map;
+  NodeElemView node_elem;
+  RowMapView cand_map;
+  EntriesView cand;
+
+  AssemblyCandidatesFunctor (const ElemNodeView& elem_node_, const RowMapView& node_elem_map_,
+                             const NodeElemView& node_elem_, const RowMapView& cand_map_,
+                             const EntriesView& cand_) :
+    elem_node (elem_node_), node_elem_map (node_elem_map_), node_elem (node_elem_),
+    cand_map (cand_map_), cand (cand_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ScaleTag&, const size_t& n) const
+  {
+    cand_map(n) = node_elem_map(n) * size_type (elem_node.extent(1));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const FillTag&, const size_t& n) const
+  {
+    const size_t nlocal = elem_node.extent(1);
+    size_type write = cand_map(n);
+    for (size_type k = node_elem_map(n); k < node_elem_map(n + 1); ++k) {
+      const size_t e = node_elem(k) / nlocal;
+      for (size_t j = 0; j < nlocal; ++j)
+        cand(write++) = ordinal_type (elem_node(e, j));
+    }
+  }
+};
+
+//counts and then copies the distinct columns of the sorted candidates.
+template<class RowMapView, class EntriesView>
+struct AssemblyUniqueFunctor {
+  typedef typename RowMapView::non_const_value_type size_type;
+
+  struct CountTag {};
+  struct FillTag {};
+
+  RowMapView cand_map;
+  EntriesView cand;
+  RowMapView row_map;
+  EntriesView entries;
+
+  AssemblyUniqueFunctor (const RowMapView& cand_map_, const EntriesView& cand_,
+                         const RowMapView& row_map_, const EntriesView& entries_) :
+    cand_map (cand_map_), cand (cand_), row_map (row_map_), entries (entries_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const CountTag&, const size_t& n) const
+  {
+    size_type num_distinct = 0;
+    for (size_type k = cand_map(n); k < cand_map(n + 1); ++k)
+      if (k == cand_map(n) || cand(k) != cand(k - 1)) ++num_distinct;
+    row_map(n) = num_distinct;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const FillTag&, const size_t& n) const
+  {
+    size_type write = row_map(n);
+    for (size_type k = cand_map(n); k < cand_map(n + 1); ++k)
+      if (k == cand_map(n) || cand(k) != cand(k - 1)) entries(write++) = cand(k);
+  }
+};
+
+//the offset in the CRS entries of each (element, row node, column node),
+//found by binary search in the sorted row.
+template<class ElemNodeView, class RowMapView, class EntriesView, class ElemGraphView>
+struct AssemblyElemGraphFunctor {
+  typedef typename RowMapView::non_const_value_type size_type;
+  typedef typename EntriesView::non_const_value_type ordinal_type;
+
+  ElemNodeView elem_node;
+  RowMapView row_map;
+  EntriesView entries;
+  ElemGraphView elem_graph;
+  const size_t nrows;
+
+  AssemblyElemGraphFunctor (const ElemNodeView& elem_node_, const RowMapView& row_map_,
+                            const EntriesView& entries_, const ElemGraphView& elem_graph_,
+                            const size_t nrows_) :
+    elem_node (elem_node_), row_map (row_map_), entries (entries_),
+    elem_graph (elem_graph_), nrows (nrows_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& e) const
+  {
+    const size_t nlocal = elem_node.extent(1);
+    for (size_t i = 0; i < nlocal; ++i) {
+      const size_t n = elem_node(e, i);
+      for (size_t j = 0; j < nlocal; ++j) {
+        size_type offset = ~size_type (0);
+        if (n < nrows) {
+          const ordinal_type col = elem_node(e, j);
+          size_type lo = row_map(n), hi = row_map(n + 1);
+          while (lo < hi) {
+            const size_type mid = lo + (hi - lo) / 2;
+            if (entries(mid) < col) lo = mid + 1;
+            else hi = mid;
+          }
+          offset = lo;
+        }
+        elem_graph(e, i, j) = offset;
+      }
+    }
+  }
+};
+
+//each row node sums the contributions of its elements, in element order,
+//so there are no write conflicts and the sums are deterministic.
+template<class RowMapView, class NodeElemView, class ElemGraphView,
+         class ElemVectorsView, class ElemMatricesView, class VectorView, class ValuesView>
+struct AssemblyGatherFunctor {
+  typedef typename RowMapView::non_const_value_type size_type;
+
+  RowMapView node_elem_map;
+  NodeElemView node_elem;
+  ElemGraphView elem_graph;
+  ElemVectorsView elem_vectors;
+  ElemMatricesView elem_matrices;
+  VectorView vector;
+  ValuesView values;
+
+  AssemblyGatherFunctor (const RowMapView& node_elem_map_, const NodeElemView& node_elem_,
+                         const ElemGraphView& elem_graph_,
+                         const ElemVectorsView& elem_vectors_, const ElemMatricesView& elem_matrices_,
+                         const VectorView& vector_, const ValuesView& values_) :
+    node_elem_map (node_elem_map_), node_elem (node_elem_), elem_graph (elem_graph_),
+    elem_vectors (elem_vectors_), elem_matrices (elem_matrices_), vector (vector_), values (values_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& n) const
+  {
+    const size_t nlocal = elem_graph.extent(1);
+    for (size_type k = node_elem_map(n); k < node_elem_map(n + 1); ++k) {
+      const size_t e = node_elem(k) / nlocal;
+      const size_t i = node_elem(k) % nlocal;
+      if (vector.extent(0)) vector(n) += elem_vectors(e, i);
+      for (size_t j = 0; j < nlocal; ++j)
+        values(elem_graph(e, i, j)) += elem_matrices(e, i, j);
+    }
+  }
+};
+
+}
+
+/// \class AssemblyGraph
+/// \brief The matrix graph of a finite element mesh and the maps to
+///   assemble element contributions into it.
+///
+/// The rows are the owned nodes [0, nrows) of the element-to-node
+/// connectivity elem_node(nelem, nodes per element); the columns are all
+/// nodes connected to a row node by an element, sorted. The graph is
+/// built on the device by collecting the nodes of the elements of each
+/// row and sorting them (no hash map).
+///
+/// elem_graph(e, i, j) is the offset in graph.entries of the entry (row
+/// node i, column node j) of element e, or invalid_offset() if node i is
+/// not owned, so that element matrices can be scattered with atomics.
+/// node_elem_map/node_elem list the (element, local node) pairs of each
+/// row node, by which gather() assembles without atomics.
+template<class CrsGraphType, class ElemNodeView>
+class AssemblyGraph {
+public:
+  typedef typename CrsGraphType::execution_space execution_space;
+  typedef typename CrsGraphType::device_type device_type;
+  typedef typename CrsGraphType::row_map_type::non_const_type row_map_type;
+  typedef typename CrsGraphType::entries_type::non_const_type entries_type;
+  typedef typename row_map_type::non_const_value_type size_type;
+  typedef typename entries_type::non_const_value_type ordinal_type;
+  typedef Kokkos::View<size_type*, device_type> node_elem_type;
+  typedef Kokkos::View<size_type***, device_type> elem_graph_type;
+
+  /// Seconds spent in each phase, and the ratio of the graph entries to
+  /// the candidate columns; filled only when requested as it fences.
+  struct Times {
+    double ratio;
+    double node_elem;
+    double candidates;
+    double sort;
+    double graph;
+    double elem_graph;
+  };
+
+  CrsGraphType graph;
+  elem_graph_type elem_graph;
+  row_map_type node_elem_map;
+  node_elem_type node_elem;
+
+  AssemblyGraph () {}
+
+  AssemblyGraph (const ElemNodeView& elem_node, const ordinal_type nrows, Times* times = NULL)
+  {
+    typedef Kokkos::RangePolicy<execution_space> my_exec_space;
+    typedef Impl::AssemblyCandidatesFunctor<ElemNodeView, row_map_type, node_elem_type, entries_type> cand_functor_type;
+    typedef Impl::AssemblyUniqueFunctor<row_map_type, entries_type> unique_functor_type;
+
+    const size_t nelem = elem_node.extent(0);
+    const size_t nlocal = elem_node.extent(1);
+    Kokkos::Impl::Timer timer;
+
+    //node -> (element, local node), in element order
+    node_elem_map = row_map_type ("AssemblyGraph node_elem_map", nrows + 1);
+    Kokkos::parallel_for ("KokkosSparse::AssemblyGraph::count", my_exec_space (0, nelem),
+        Impl::AssemblyCountFunctor<ElemNodeView, row_map_type> (elem_node, node_elem_map, nrows));
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<row_map_type, execution_space> (nrows + 1, node_elem_map);
+    size_type num_node_elem = 0;
+    Kokkos::deep_copy (num_node_elem, Kokkos::subview (node_elem_map, nrows));
+
+    row_map_type cursor (Kokkos::ViewAllocateWithoutInitializing ("AssemblyGraph cursor"), nrows + 1);
+    Kokkos::deep_copy (cursor, node_elem_map);
+    node_elem = node_elem_type (Kokkos::ViewAllocateWithoutInitializing ("AssemblyGraph node_elem"), num_node_elem);
+    Kokkos::parallel_for ("KokkosSparse::AssemblyGraph::scatter", my_exec_space (0, nelem),
+        Impl::AssemblyScatterFunctor<ElemNodeView, row_map_type, node_elem_type> (elem_node, cursor, node_elem, nrows));
+    cursor = row_map_type ();
+    KokkosKernels::Impl::kk_sort_crs_rows<row_map_type, node_elem_type, node_elem_type, execution_space>
+      (node_elem_map, node_elem, node_elem_type ());
+    if (times) times->node_elem = timer.seconds ();
+
+    //candidate columns with duplicates
+    timer.reset ();
+    row_map_type cand_map (Kokkos::ViewAllocateWithoutInitializing ("AssemblyGraph cand_map"), nrows + 1);
+    entries_type cand (Kokkos::ViewAllocateWithoutInitializing ("AssemblyGraph cand"), size_t (num_node_elem) * nlocal);
+    cand_functor_type cand_functor (elem_node, node_elem_map, node_elem, cand_map, cand);
+    Kokkos::parallel_for ("KokkosSparse::AssemblyGraph::candidate_map",
+        Kokkos::RangePolicy<typename cand_functor_type::ScaleTag, execution_space> (0, nrows + 1), cand_functor);
+    Kokkos::parallel_for ("KokkosSparse::AssemblyGraph::candidates",
+        Kokkos::RangePolicy<typename cand_functor_type::FillTag, execution_space> (0, nrows), cand_functor);
+    if (times) { execution_space::fence (); times->candidates = timer.seconds (); }
+
+    //sort-unique
+    timer.reset ();
+    KokkosKernels::Impl::kk_sort_crs_rows<row_map_type, entries_type, entries_type, execution_space>
+      (cand_map, cand, entries_type ());
+    if (times) times->sort = timer.seconds ();
+
+    timer.reset ();
+    row_map_type row_map ("AssemblyGraph row_map", nrows + 1);
+    unique_functor_type unique_functor (cand_map, cand, row_map, entries_type ());
+    Kokkos::parallel_for ("KokkosSparse::AssemblyGraph::count_unique",
+        Kokkos::RangePolicy<typename unique_functor_type::CountTag, execution_space> (0, nrows), unique_functor);
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<row_map_type, execution_space> (nrows + 1, row_map);
+    size_type nnz = 0;
+    Kokkos::deep_copy (nnz, Kokkos::subview (row_map, nrows));
+    entries_type entries (Kokkos::ViewAllocateWithoutInitializing ("AssemblyGraph entries"), nnz);
+    unique_functor.entries = entries;
+    Kokkos::parallel_for ("KokkosSparse::AssemblyGraph::fill_unique",
+        Kokkos::RangePolicy<typename unique_functor_type::FillTag, execution_space> (0, nrows), unique_functor);
+    graph.row_map = row_map;
+    graph.entries = entries;
+    if (times) {
+      execution_space::fence ();
+      times->graph = timer.seconds ();
+      times->ratio = cand.extent(0) ? double (nnz) / double (cand.extent(0)) : 1.0;
+    }
+    cand = entries_type ();
+    cand_map = row_map_type ();
+
+    //element -> CRS offsets
+    timer.reset ();
+    elem_graph = elem_graph_type (Kokkos::ViewAllocateWithoutInitializing ("AssemblyGraph elem_graph"), nelem, nlocal, nlocal);
+    Kokkos::parallel_for ("KokkosSparse::AssemblyGraph::elem_graph", my_exec_space (0, nelem),
+        Impl::AssemblyElemGraphFunctor<ElemNodeView, row_map_type, entries_type, elem_graph_type>
+          (elem_node, row_map, entries, elem_graph, nrows));
+    if (times) { execution_space::fence (); times->elem_graph = timer.seconds (); }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static size_type invalid_offset () { return ~size_type (0); }
+
+  ordinal_type numRows () const { return node_elem_map.extent(0) ? ordinal_type (node_elem_map.extent(0) - 1) : 0; }
+
+  /// \brief Adds the element vectors elem_vectors(nelem, nodes per element)
+  ///   and matrices elem_matrices(nelem, nodes per element, nodes per
+  ///   element) into vector(numRows()) and the matrix values of graph,
+  ///   without atomics. vector may be empty to assemble the matrix only.
+  template<class ElemVectorsView, class ElemMatricesView, class VectorView, class ValuesView>
+  void gather (const ElemVectorsView& elem_vectors, const ElemMatricesView& elem_matrices,
+               const VectorView& vector, const ValuesView& values) const
+  {
+    if (elem_matrices.extent(0) != elem_graph.extent(0) ||
+        (vector.extent(0) && elem_vectors.extent(0) != elem_graph.extent(0)) ||
+        values.extent(0) != graph.entries.extent(0)) {
+      std::ostringstream os;
+      os << "KokkosSparse::Experimental::AssemblyGraph::gather: Dimensions do not match: "
+         << "elements: " << elem_graph.extent(0)
+         << ", elem_vectors: " << elem_vectors.extent(0)
+         << ", elem_matrices: " << elem_matrices.extent(0)
+         << ", entries: " << graph.entries.extent(0)
+         << ", values: " << values.extent(0);
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+    Kokkos::parallel_for ("KokkosSparse::AssemblyGraph::gather",
+        Kokkos::RangePolicy<execution_space> (0, numRows ()),
+        Impl::AssemblyGatherFunctor<row_map_type, node_elem_type, elem_graph_type,
+                                    ElemVectorsView, ElemMatricesView, VectorView, ValuesView>
+          (node_elem_map, node_elem, elem_graph, elem_vectors, elem_matrices, vector, values));
+  }
+};
+
+}
+}
+
+#endif
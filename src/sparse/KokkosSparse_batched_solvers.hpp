@@ -0,0 +1,224 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+/// \file KokkosSparse_batched_solvers.hpp
+/// \brief Krylov solvers for batches of small sparse systems with the
+///   same sparsity pattern, one system per team.
+
+#ifndef KOKKOSSPARSE_BATCHED_SOLVERS_HPP_
+#define KOKKOSSPARSE_BATCHED_SOLVERS_HPP_
+
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_BatchedCrsMatrix.hpp"
+#include "KokkosSparse_batched_solvers_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+namespace Impl {
+
+template<class AMatrix, class BMV, class XMV, class ItersView, class NormsView>
+void check_batched_solver_arguments (const char name[], const AMatrix& A, const BMV& B, const XMV& X,
+                                     const int max_iters, const ItersView& num_iters,
+                                     const NormsView& residual_norms)
+{
+  static_assert ((int) BMV::rank == 2 && (int) XMV::rank == 2,
+                 "KokkosSparse::Experimental::batched solvers: B and X must have rank 2, one row per system.");
+  static_assert (std::is_same<typename XMV::value_type, typename XMV::non_const_value_type>::value,
+                 "KokkosSparse::Experimental::batched solvers: X must be non-const.");
+  static_assert ((int) ItersView::rank == 1 && (int) NormsView::rank == 1,
+                 "KokkosSparse::Experimental::batched solvers: num_iters and residual_norms must have rank 1.");
+
+  const size_t nmat = A.numMatrices ();
+  if (A.numRows () != A.numCols () ||
+      B.extent(0) != nmat || X.extent(0) != nmat ||
+      B.extent(1) != static_cast<size_t> (A.numRows ()) ||
+      X.extent(1) != static_cast<size_t> (A.numRows ()) ||
+      (num_iters.extent(0) != 0 && num_iters.extent(0) != nmat) ||
+      (residual_norms.extent(0) != 0 && residual_norms.extent(0) != nmat)) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::" << name << ": Dimensions do not match: "
+       << "A: " << nmat << " matrices of " << A.numRows () << " x " << A.numCols ()
+       << ", B: " << B.extent(0) << " x " << B.extent(1)
+       << ", X: " << X.extent(0) << " x " << X.extent(1)
+       << ", num_iters: " << num_iters.extent(0)
+       << ", residual_norms: " << residual_norms.extent(0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  if (max_iters < 0) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::" << name << ": max_iters = " << max_iters << " must be nonnegative.";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+}
+
+}
+
+/// \brief Solve A_b X(b,:) = B(b,:) for every matrix A_b of the batch with
+///   the conjugate gradient method; the matrices must be Hermitian
+///   positive definite.
+///
+/// Each system is solved by one team, with its work vectors in team
+/// scratch, starting from the initial guess in X(b,:) and stopping when
+/// ||B(b,:) - A_b X(b,:)|| <= tolerance*||B(b,:)|| or after max_iters
+/// iterations. The residual is the one of the recurrence.
+///
+/// \param A [in] The batch of matrices.
+/// \param B [in] The right hand sides, one row per system.
+/// \param X [in/out] The initial guesses on input, the solutions on output.
+/// \param tolerance [in] The tolerance on the relative residual norm.
+/// \param max_iters [in] The maximum number of iterations per system.
+/// \param num_iters [out] If not empty, the number of iterations of each system.
+/// \param residual_norms [out] If not empty, the relative residual norm of
+///   each system when it stopped.
+/// \return The number of systems that did not converge.
+template<class AMatrix, class BMV, class XMV, class ItersView, class NormsView>
+int
+batched_cg (const AMatrix& A, const BMV& B, const XMV& X,
+            const typename Kokkos::Details::ArithTraits<typename XMV::non_const_value_type>::mag_type tolerance,
+            const int max_iters,
+            const ItersView& num_iters,
+            const NormsView& residual_norms)
+{
+  typedef Impl::BatchedCGFunctor<AMatrix, BMV, XMV, ItersView, NormsView> functor_type;
+  Impl::check_batched_solver_arguments ("batched_cg", A, B, X, max_iters, num_iters, residual_norms);
+  return Impl::run_batched_solver ("KokkosSparse::Experimental::batched_cg",
+                                   functor_type (A, B, X, tolerance, max_iters, num_iters, residual_norms),
+                                   A.numMatrices (), functor_type::team_scratch_size (A.numRows ()));
+}
+
+/// \brief Solve A_b X(b,:) = B(b,:) for every matrix A_b of the batch with
+///   BiCGStab, for general matrices.
+///
+/// The arguments and the stopping criterion are those of batched_cg; an
+/// iteration applies A_b twice. A system also stops, without converging,
+/// if the method breaks down.
+template<class AMatrix, class BMV, class XMV, class ItersView, class NormsView>
+int
+batched_bicgstab (const AMatrix& A, const BMV& B, const XMV& X,
+                  const typename Kokkos::Details::ArithTraits<typename XMV::non_const_value_type>::mag_type tolerance,
+                  const int max_iters,
+                  const ItersView& num_iters,
+                  const NormsView& residual_norms)
+{
+  typedef Impl::BatchedBiCGStabFunctor<AMatrix, BMV, XMV, ItersView, NormsView> functor_type;
+  Impl::check_batched_solver_arguments ("batched_bicgstab", A, B, X, max_iters, num_iters, residual_norms);
+  return Impl::run_batched_solver ("KokkosSparse::Experimental::batched_bicgstab",
+                                   functor_type (A, B, X, tolerance, max_iters, num_iters, residual_norms),
+                                   A.numMatrices (), functor_type::team_scratch_size (A.numRows ()));
+}
+
+/// \brief Solve A_b X(b,:) = B(b,:) for every matrix A_b of the batch with
+///   GMRES restarted every restart iterations, for general matrices.
+///
+/// The arguments and the stopping criterion are those of batched_cg,
+/// with the residual recomputed at every restart. The team scratch holds
+/// restart+1 vectors of the Krylov basis, so for systems of 50 to 200
+/// rows and restart up to 15 it stays in level 0.
+///
+/// \param restart [in] The dimension of the Krylov space; must be positive.
+template<class AMatrix, class BMV, class XMV, class ItersView, class NormsView>
+int
+batched_gmres (const AMatrix& A, const BMV& B, const XMV& X,
+               const typename Kokkos::Details::ArithTraits<typename XMV::non_const_value_type>::mag_type tolerance,
+               const int max_iters,
+               const int restart,
+               const ItersView& num_iters,
+               const NormsView& residual_norms)
+{
+  typedef Impl::BatchedGMRESFunctor<AMatrix, BMV, XMV, ItersView, NormsView> functor_type;
+  Impl::check_batched_solver_arguments ("batched_gmres", A, B, X, max_iters, num_iters, residual_norms);
+  if (restart <= 0) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::batched_gmres: restart = " << restart << " must be positive.";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  return Impl::run_batched_solver ("KokkosSparse::Experimental::batched_gmres",
+                                   functor_type (A, B, X, tolerance, max_iters, restart, num_iters, residual_norms),
+                                   A.numMatrices (), functor_type::team_scratch_size (A.numRows (), restart));
+}
+
+//! batched_cg without the iteration counts and the residual norms.
+template<class AMatrix, class BMV, class XMV>
+int
+batched_cg (const AMatrix& A, const BMV& B, const XMV& X,
+            const typename Kokkos::Details::ArithTraits<typename XMV::non_const_value_type>::mag_type tolerance,
+            const int max_iters)
+{
+  typedef typename Kokkos::Details::ArithTraits<typename XMV::non_const_value_type>::mag_type mag_type;
+  return batched_cg (A, B, X, tolerance, max_iters,
+                     Kokkos::View<int*, typename AMatrix::device_type> (),
+                     Kokkos::View<mag_type*, typename AMatrix::device_type> ());
+}
+
+//! batched_bicgstab without the iteration counts and the residual norms.
+template<class AMatrix, class BMV, class XMV>
+int
+batched_bicgstab (const AMatrix& A, const BMV& B, const XMV& X,
+                  const typename Kokkos::Details::ArithTraits<typename XMV::non_const_value_type>::mag_type tolerance,
+                  const int max_iters)
+{
+  typedef typename Kokkos::Details::ArithTraits<typename XMV::non_const_value_type>::mag_type mag_type;
+  return batched_bicgstab (A, B, X, tolerance, max_iters,
+                           Kokkos::View<int*, typename AMatrix::device_type> (),
+                           Kokkos::View<mag_type*, typename AMatrix::device_type> ());
+}
+
+//! batched_gmres without the iteration counts and the residual norms.
+template<class AMatrix, class BMV, class XMV>
+int
+batched_gmres (const AMatrix& A, const BMV& B, const XMV& X,
+               const typename Kokkos::Details::ArithTraits<typename XMV::non_const_value_type>::mag_type tolerance,
+               const int max_iters,
+               const int restart)
+{
+  typedef typename Kokkos::Details::ArithTraits<typename XMV::non_const_value_type>::mag_type mag_type;
+  return batched_gmres (A, B, X, tolerance, max_iters, restart,
+                        Kokkos::View<int*, typename AMatrix::device_type> (),
+                        Kokkos::View<mag_type*, typename AMatrix::device_type> ());
+}
+
+}
+}
+
+#endif
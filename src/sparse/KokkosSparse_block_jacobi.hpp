@@ -0,0 +1,137 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_block_jacobi.hpp
+/// \brief Block Jacobi preconditioner for a CrsMatrix, with batched
+///   dense LU factors of its diagonal blocks.
+
+#ifndef KOKKOSSPARSE_BLOCK_JACOBI_HPP_
+#define KOKKOSSPARSE_BLOCK_JACOBI_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_block_jacobi_handle.hpp"
+#include "KokkosSparse_block_jacobi_impl.hpp"
+
+namespace KokkosSparse {
+
+/// \brief Partitions the rows of A into the blocks of the handle, as
+///   set by its block size and partition type.
+///
+/// \param handle [in/out] The handle; its ordinal, size and scalar types
+///   must be those of A.
+/// \param A [in] The square sparse matrix.
+template<class HandleType, class AMatrix>
+void
+block_jacobi_symbolic (HandleType& handle, const AMatrix& A)
+{
+  static_assert (std::is_same<typename AMatrix::non_const_size_type, typename HandleType::size_type>::value &&
+                 std::is_same<typename AMatrix::non_const_ordinal_type, typename HandleType::nnz_lno_t>::value &&
+                 std::is_same<typename AMatrix::non_const_value_type, typename HandleType::nnz_scalar_t>::value,
+                 "KokkosSparse::block_jacobi_symbolic: The handle and the matrix must have the same ordinal, size and scalar types.");
+  if (A.numRows () != A.numCols () || handle.get_block_size () < 1) {
+    std::ostringstream os;
+    os << "KokkosSparse::block_jacobi_symbolic: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols ()
+       << ", block size: " << handle.get_block_size ();
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  Impl::block_jacobi_symbolic (handle, A);
+}
+
+/// \brief Extracts the diagonal blocks of A in parallel and LU factors
+///   them with the batched serial LU, one block per thread. The LU has no
+///   pivoting: the diagonal blocks must not need it, e.g. by being
+///   diagonally dominant. Calls block_jacobi_symbolic first if needed;
+///   call again for new values of A with the same pattern.
+///
+/// \param handle [in/out] The handle.
+/// \param A [in] The square sparse matrix.
+template<class HandleType, class AMatrix>
+void
+block_jacobi_numeric (HandleType& handle, const AMatrix& A)
+{
+  if (!handle.is_symbolic_called ()) {
+    block_jacobi_symbolic (handle, A);
+  }
+  if (static_cast<size_t> (handle.get_row_block ().extent (0)) != static_cast<size_t> (A.numRows ())) {
+    std::ostringstream os;
+    os << "KokkosSparse::block_jacobi_numeric: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols ()
+       << ", handle: " << handle.get_row_block ().extent (0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  Impl::block_jacobi_numeric (handle, A);
+}
+
+/// \brief Applies the preconditioner: z = D^{-1} r, where D is the
+///   block diagonal part of A. Each block is solved with the two batched
+///   serial triangular solves of its factors, one block per thread.
+///
+/// \param handle [in] The handle, after block_jacobi_numeric.
+/// \param r [in] 1-D view, the vector to precondition.
+/// \param z [out] 1-D view, the preconditioned vector; may alias r.
+template<class HandleType, class RVector, class ZVector>
+void
+block_jacobi_apply (const HandleType& handle, const RVector& r, const ZVector& z)
+{
+  static_assert (static_cast<int> (RVector::rank) == 1 && static_cast<int> (ZVector::rank) == 1,
+                 "KokkosSparse::block_jacobi_apply: r and z must be 1-D Kokkos::Views.");
+  if (!handle.is_numeric_called () ||
+      static_cast<size_t> (r.extent (0)) != static_cast<size_t> (handle.get_row_block ().extent (0)) ||
+      static_cast<size_t> (z.extent (0)) != static_cast<size_t> (handle.get_row_block ().extent (0))) {
+    std::ostringstream os;
+    os << "KokkosSparse::block_jacobi_apply: Dimensions do not match, or the handle is not factored: "
+       << ", r: " << r.extent (0)
+       << ", z: " << z.extent (0)
+       << ", handle: " << handle.get_row_block ().extent (0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  Impl::block_jacobi_apply (handle, r, z);
+}
+
+}
+
+#endif
@@ -0,0 +1,145 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+
+#ifndef _KOKKOSSPARSE_BLOCK_JACOBI_HANDLE_HPP
+#define _KOKKOSSPARSE_BLOCK_JACOBI_HANDLE_HPP
+
+namespace KokkosSparse{
+
+enum BlockJacobiPartition{
+  BLOCK_JACOBI_CONTIGUOUS, //blocks of consecutive rows.
+  BLOCK_JACOBI_GRAPH //blocks grown by breadth first search in the graph of the matrix.
+};
+
+/**
+ * \brief Partition and factors of a block Jacobi preconditioner. The rows
+ * are split into non-overlapping blocks of at most block_size rows, and the
+ * diagonal block of each is copied into a dense block_size x block_size
+ * matrix and LU factored, padded with the identity if the block is smaller.
+ * The rows of block b are block_rows[block_ptr[b]:block_ptr[b+1]).
+ */
+template <class lno_t_, class size_type_, class scalar_t_, class ExecutionSpace>
+class BlockJacobiHandle{
+public:
+  typedef lno_t_ nnz_lno_t;
+  typedef size_type_ size_type;
+  typedef scalar_t_ nnz_scalar_t;
+  typedef ExecutionSpace execution_space;
+
+  typedef Kokkos::View<nnz_lno_t *, execution_space> lno_view_t;
+  typedef Kokkos::View<nnz_scalar_t ***, Kokkos::LayoutRight, execution_space> block_view_t;
+  typedef Kokkos::View<nnz_scalar_t **, Kokkos::LayoutRight, execution_space> block_vector_view_t;
+
+private:
+  nnz_lno_t block_size;
+  BlockJacobiPartition partition;
+  nnz_lno_t num_blocks;
+
+  lno_view_t block_ptr;
+  lno_view_t block_rows;
+  //block of each row, and its position in block_rows.
+  lno_view_t row_block;
+  lno_view_t row_position;
+
+  //LU factors of the diagonal blocks, and a work vector per block for the applies.
+  block_view_t factored_blocks;
+  block_vector_view_t work;
+
+  bool called_symbolic;
+  bool called_numeric;
+
+public:
+  /**
+   * \brief constructor.
+   * \param block_size_: the largest number of rows in a block.
+   * \param partition_: how the rows are grouped into blocks.
+   */
+  BlockJacobiHandle(nnz_lno_t block_size_ = 8, BlockJacobiPartition partition_ = BLOCK_JACOBI_CONTIGUOUS):
+    block_size(block_size_), partition(partition_), num_blocks(0),
+    block_ptr(), block_rows(), row_block(), row_position(),
+    factored_blocks(), work(), called_symbolic(false), called_numeric(false){}
+
+  nnz_lno_t get_block_size() const {return this->block_size;}
+  BlockJacobiPartition get_partition() const {return this->partition;}
+  nnz_lno_t get_num_blocks() const {return this->num_blocks;}
+  bool is_symbolic_called() const {return this->called_symbolic;}
+  bool is_numeric_called() const {return this->called_numeric;}
+
+  void set_block_size(nnz_lno_t block_size_){
+    this->block_size = block_size_;
+    this->called_symbolic = this->called_numeric = false;
+  }
+  void set_partition(BlockJacobiPartition partition_){
+    this->partition = partition_;
+    this->called_symbolic = this->called_numeric = false;
+  }
+
+  void set_blocks(nnz_lno_t num_blocks_, lno_view_t block_ptr_, lno_view_t block_rows_,
+      lno_view_t row_block_, lno_view_t row_position_){
+    this->num_blocks = num_blocks_;
+    this->block_ptr = block_ptr_;
+    this->block_rows = block_rows_;
+    this->row_block = row_block_;
+    this->row_position = row_position_;
+    this->called_symbolic = true;
+    this->called_numeric = false;
+  }
+  lno_view_t get_block_ptr() const {return this->block_ptr;}
+  lno_view_t get_block_rows() const {return this->block_rows;}
+  lno_view_t get_row_block() const {return this->row_block;}
+  lno_view_t get_row_position() const {return this->row_position;}
+
+  void set_factored_blocks(block_view_t factored_blocks_, block_vector_view_t work_){
+    this->factored_blocks = factored_blocks_;
+    this->work = work_;
+    this->called_numeric = true;
+  }
+  block_view_t get_factored_blocks() const {return this->factored_blocks;}
+  block_vector_view_t get_work() const {return this->work;}
+};
+
+}
+
+#endif
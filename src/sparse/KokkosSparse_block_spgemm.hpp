@@ -0,0 +1,127 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_block_spgemm.hpp
+/// \brief Product of two BlockCrsMatrix, e.g. the Galerkin products of
+///   algebraic multigrid for systems of PDEs.
+
+#ifndef KOKKOSSPARSE_BLOCK_SPGEMM_HPP_
+#define KOKKOSSPARSE_BLOCK_SPGEMM_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include <type_traits>
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosKernels_Profiling.hpp"
+#include "KokkosSparse_BlockCrsMatrix.hpp"
+#include "KokkosSparse_block_spgemm_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+template<class AMatrix, class BMatrix>
+void
+check_block_spgemm_dimensions (const char *label, const AMatrix& A, const BMatrix& B)
+{
+  if (A.numCols () != B.numRows () || A.blockDim () != B.blockDim ()) {
+    std::ostringstream os;
+    os << label << ": Dimensions do not match: "
+       << "A: " << A.numRows () << " x " << A.numCols () << " blocks of size " << A.blockDim ()
+       << ", B: " << B.numRows () << " x " << B.numCols () << " blocks of size " << B.blockDim ();
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+}
+
+/// \brief Symbolic phase of C = A*B for block matrices with the same
+///   block size. Computes the block graph of C with the spgemm of the
+///   kernel handle on the block graphs, so the work of the hashing is that
+///   of the blocks, not of their block_size^2 entries, and allocates C
+///   with zero values.
+///
+/// \param handle [in/out] The kernel handle, with the spgemm handle created.
+/// \param A [in] The left block matrix.
+/// \param B [in] The right block matrix.
+/// \param C [out] The product, with sorted block rows.
+template<class KernelHandle, class AMatrix, class BMatrix, class CMatrix>
+void
+block_spgemm_symbolic (KernelHandle *handle, const AMatrix& A, const BMatrix& B, CMatrix& C)
+{
+  static_assert (std::is_same<typename AMatrix::non_const_size_type, typename KernelHandle::size_type>::value &&
+                 std::is_same<typename AMatrix::non_const_ordinal_type, typename KernelHandle::nnz_lno_t>::value,
+                 "KokkosSparse::block_spgemm_symbolic: The handle and the matrices must have the same ordinal and size types.");
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::block_spgemm_symbolic");
+  check_block_spgemm_dimensions ("KokkosSparse::block_spgemm_symbolic", A, B);
+  Impl::block_spgemm_symbolic (handle, A, B, C);
+}
+
+/// \brief Numeric phase of C = A*B. Each product of two blocks is
+///   accumulated into the block of C with KokkosBatched's serial gemm, one
+///   block row of C per thread. Call again for new values of A and B with
+///   the same patterns.
+///
+/// \param handle [in] The kernel handle of the symbolic phase.
+/// \param A [in] The left block matrix.
+/// \param B [in] The right block matrix.
+/// \param C [in/out] The product from block_spgemm_symbolic; its values
+///   are overwritten.
+template<class KernelHandle, class AMatrix, class BMatrix, class CMatrix>
+void
+block_spgemm_numeric (KernelHandle *handle, const AMatrix& A, const BMatrix& B, const CMatrix& C)
+{
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::block_spgemm_numeric");
+  check_block_spgemm_dimensions ("KokkosSparse::block_spgemm_numeric", A, B);
+  if (C.numRows () != A.numRows () || C.numCols () != B.numCols () || C.blockDim () != A.blockDim ()) {
+    std::ostringstream os;
+    os << "KokkosSparse::block_spgemm_numeric: Dimensions do not match: "
+       << "A: " << A.numRows () << " x " << A.numCols ()
+       << ", B: " << B.numRows () << " x " << B.numCols ()
+       << ", C: " << C.numRows () << " x " << C.numCols () << " blocks of size " << C.blockDim ();
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  Impl::block_spgemm_numeric (handle, A, B, C);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,165 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_blockcrs_gauss_seidel.hpp
+/// \brief Block-row Gauss-Seidel for KokkosSparse::Experimental::BlockCrsMatrix
+///
+/// The block rows are colored once in the symbolic phase. The numeric phase
+/// factors the diagonal blocks with the batched LU, and the sweeps relax the
+/// block rows of each color in parallel, with block gemv products for the
+/// off-diagonal blocks and the batched triangular solves for the diagonal
+/// block. The coloring, color sets and factors are kept in the gs handle of
+/// the kernel handle, which must have been created with create_gs_handle().
+
+#ifndef KOKKOSSPARSE_BLOCKCRS_GAUSS_SEIDEL_HPP_
+#define KOKKOSSPARSE_BLOCKCRS_GAUSS_SEIDEL_HPP_
+
+#include <sstream>
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_BlockCrsMatrix.hpp"
+#include "KokkosSparse_blockcrs_gauss_seidel_impl.hpp"
+
+namespace KokkosSparse{
+namespace Experimental{
+
+namespace Impl{
+  template <typename KernelHandle, typename BlockCrsMatrixType>
+  void check_blockcrs_gauss_seidel(KernelHandle *handle, const BlockCrsMatrixType &A, const char *name){
+    if (handle->get_gs_handle() == NULL){
+      std::ostringstream os;
+      os << "KokkosSparse::" << name << ": the gs handle has not been created, call create_gs_handle first";
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+    if (A.numRows() != A.numCols()){
+      std::ostringstream os;
+      os << "KokkosSparse::" << name << ": Dimensions do not match: "
+         << ", A: " << A.numRows() << " x " << A.numCols() << " blocks";
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+  }
+}
+
+  /// \brief Colors the block rows of A.
+  /// \param is_graph_symmetric [in] false if the block graph of A must be
+  ///   symmetrized before the coloring.
+  template <typename KernelHandle, typename BlockCrsMatrixType>
+  void blockcrs_gauss_seidel_symbolic(
+      KernelHandle *handle,
+      const BlockCrsMatrixType &A,
+      bool is_graph_symmetric = true){
+    Impl::check_blockcrs_gauss_seidel(handle, A, "blockcrs_gauss_seidel_symbolic");
+    KokkosSparse::Impl::blockcrs_gauss_seidel_symbolic(handle, A, is_graph_symmetric);
+  }
+
+  /// \brief Factors the diagonal blocks of A. Calls the symbolic phase
+  /// first if it has not been called.
+  template <typename KernelHandle, typename BlockCrsMatrixType>
+  void blockcrs_gauss_seidel_numeric(
+      KernelHandle *handle,
+      const BlockCrsMatrixType &A,
+      bool is_graph_symmetric = true){
+    Impl::check_blockcrs_gauss_seidel(handle, A, "blockcrs_gauss_seidel_numeric");
+    if (!handle->get_gs_handle()->is_symbolic_called()){
+      KokkosSparse::Impl::blockcrs_gauss_seidel_symbolic(handle, A, is_graph_symmetric);
+    }
+    KokkosSparse::Impl::blockcrs_gauss_seidel_numeric(handle, A);
+  }
+
+namespace Impl{
+  template <typename KernelHandle, typename BlockCrsMatrixType, typename x_scalar_view_t, typename y_scalar_view_t>
+  void apply_blockcrs_gauss_seidel(
+      KernelHandle *handle, const BlockCrsMatrixType &A,
+      x_scalar_view_t x, y_scalar_view_t y,
+      bool init_zero_x_vector, int numIter,
+      bool apply_forward, bool apply_backward, const char *name){
+    static_assert (x_scalar_view_t::rank == 1 && y_scalar_view_t::rank == 1,
+        "KokkosSparse::blockcrs_gauss_seidel_apply: x and y must have rank 1.");
+    check_blockcrs_gauss_seidel(handle, A, name);
+    if (x.extent(0) != size_t(A.numRows()) * A.blockDim() || y.extent(0) != size_t(A.numRows()) * A.blockDim()){
+      std::ostringstream os;
+      os << "KokkosSparse::" << name << ": Dimensions do not match: "
+         << ", A: " << A.numRows() << " x " << A.numCols() << " blocks of size " << A.blockDim()
+         << ", x: " << x.extent(0)
+         << ", y: " << y.extent(0);
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+    if (!handle->get_gs_handle()->is_numeric_called()){
+      KokkosSparse::Experimental::blockcrs_gauss_seidel_numeric(handle, A);
+    }
+    KokkosSparse::Impl::blockcrs_gauss_seidel_apply(handle, A, x, y, init_zero_x_vector, numIter, apply_forward, apply_backward);
+  }
+}
+
+  /// \brief numIter symmetric (forward then backward) block Gauss-Seidel
+  /// sweeps for A x = y. x and y are point vectors of length
+  /// A.numRows() * A.blockDim().
+  template <typename KernelHandle, typename BlockCrsMatrixType, typename x_scalar_view_t, typename y_scalar_view_t>
+  void symmetric_blockcrs_gauss_seidel_apply(
+      KernelHandle *handle, const BlockCrsMatrixType &A,
+      x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+      bool init_zero_x_vector = false, int numIter = 1){
+    Impl::apply_blockcrs_gauss_seidel(handle, A, x_lhs_output_vec, y_rhs_input_vec,
+        init_zero_x_vector, numIter, true, true, "symmetric_blockcrs_gauss_seidel_apply");
+  }
+
+  template <typename KernelHandle, typename BlockCrsMatrixType, typename x_scalar_view_t, typename y_scalar_view_t>
+  void forward_sweep_blockcrs_gauss_seidel_apply(
+      KernelHandle *handle, const BlockCrsMatrixType &A,
+      x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+      bool init_zero_x_vector = false, int numIter = 1){
+    Impl::apply_blockcrs_gauss_seidel(handle, A, x_lhs_output_vec, y_rhs_input_vec,
+        init_zero_x_vector, numIter, true, false, "forward_sweep_blockcrs_gauss_seidel_apply");
+  }
+
+  template <typename KernelHandle, typename BlockCrsMatrixType, typename x_scalar_view_t, typename y_scalar_view_t>
+  void backward_sweep_blockcrs_gauss_seidel_apply(
+      KernelHandle *handle, const BlockCrsMatrixType &A,
+      x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+      bool init_zero_x_vector = false, int numIter = 1){
+    Impl::apply_blockcrs_gauss_seidel(handle, A, x_lhs_output_vec, y_rhs_input_vec,
+        init_zero_x_vector, numIter, false, true, "backward_sweep_blockcrs_gauss_seidel_apply");
+  }
+
+}
+}
+#endif
@@ -0,0 +1,143 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_chebyshev.hpp
+/// \brief Chebyshev polynomial smoother for a CrsMatrix.
+
+#ifndef KOKKOSSPARSE_CHEBYSHEV_HPP_
+#define KOKKOSSPARSE_CHEBYSHEV_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_diagonal.hpp"
+#include "KokkosSparse_linear_operator.hpp"
+#include "KokkosSparse_chebyshev_handle.hpp"
+#include "KokkosSparse_chebyshev_impl.hpp"
+
+namespace KokkosSparse {
+
+/// \brief Prepares handle to smooth with A: computes the inverse
+///   diagonal of A and, unless it was set on the handle, estimates the
+///   largest eigenvalue of D^{-1} A with power iterations.
+///
+/// Unlike the Gauss-Seidel smoothers, Chebyshev needs no coloring: an
+/// apply is a sequence of spmv and vector updates, parallel over all
+/// the rows. It only needs products with A and its diagonal, so A may
+/// also be a matrix-free operator (see KokkosSparse_linear_operator.hpp).
+///
+/// \param handle [in/out] The handle; its ordinal, size and scalar types
+///   must be those of A.
+/// \param A [in] The square sparse matrix or linear operator.
+template<class HandleType, class AMatrix>
+void
+chebyshev_setup (HandleType& handle, const AMatrix& A)
+{
+  static_assert (std::is_same<typename AMatrix::non_const_size_type, typename HandleType::size_type>::value &&
+                 std::is_same<typename AMatrix::non_const_ordinal_type, typename HandleType::nnz_lno_t>::value &&
+                 std::is_same<typename AMatrix::non_const_value_type, typename HandleType::nnz_scalar_t>::value,
+                 "KokkosSparse::chebyshev_setup: The handle and the matrix must have the same ordinal, size and scalar types.");
+  typedef typename HandleType::scalar_view_t scalar_view_t;
+  typedef typename HandleType::mag_t mag_t;
+
+  if (A.numRows () != A.numCols ()) {
+    std::ostringstream os;
+    os << "KokkosSparse::chebyshev_setup: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols ();
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  scalar_view_t inv_diag (Kokkos::ViewAllocateWithoutInitializing ("Chebyshev inverse diagonal"), A.numRows ());
+  scalar_view_t work_r (Kokkos::ViewAllocateWithoutInitializing ("Chebyshev residual"), A.numRows ());
+  scalar_view_t work_d (Kokkos::ViewAllocateWithoutInitializing ("Chebyshev update"), A.numRows ());
+  Experimental::operator_inverse_diagonal (handle.get_diagonal_handle (), A, inv_diag);
+  handle.set_work_views (inv_diag, work_r, work_d);
+
+  if (!handle.is_user_lambda_max ()) {
+    const mag_t lambda = Impl::chebyshev_power_iterations (handle, A);
+    if (!(lambda > 0)) {
+      std::ostringstream os;
+      os << "KokkosSparse::chebyshev_setup: The power iterations estimate a largest eigenvalue of "
+         << lambda << "; set it with set_lambda_max instead.";
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+    handle.set_estimated_lambda_max (lambda * handle.get_boost_factor ());
+  }
+  handle.set_call_setup ();
+}
+
+/// \brief Smooths x for A x = b with handle.get_degree() Chebyshev
+///   iterations, each of them one spmv and two vector updates.
+///
+/// \param handle [in] The handle, set up with chebyshev_setup for A.
+/// \param A [in] The sparse matrix or linear operator.
+/// \param x [in/out] 1-D view, the approximate solution.
+/// \param b [in] 1-D view, the right hand side.
+/// \param zero_initial_guess [in] If true, x is taken as zero on input,
+///   which saves an spmv.
+template<class HandleType, class AMatrix, class XVector, class BVector>
+void
+chebyshev_apply (const HandleType& handle, const AMatrix& A,
+                 const XVector& x, const BVector& b,
+                 const bool zero_initial_guess = false)
+{
+  static_assert (static_cast<int> (XVector::rank) == 1 && static_cast<int> (BVector::rank) == 1,
+                 "KokkosSparse::chebyshev_apply: x and b must be 1-D Kokkos::Views.");
+  if (!handle.is_setup_called () ||
+      static_cast<size_t> (handle.get_inv_diag ().extent (0)) != static_cast<size_t> (A.numRows ()) ||
+      static_cast<size_t> (x.extent (0)) != static_cast<size_t> (A.numCols ()) ||
+      static_cast<size_t> (b.extent (0)) != static_cast<size_t> (A.numRows ())) {
+    std::ostringstream os;
+    os << "KokkosSparse::chebyshev_apply: Dimensions do not match, or the handle is not set up: "
+       << ", A: " << A.numRows () << " x " << A.numCols ()
+       << ", x: " << x.extent (0)
+       << ", b: " << b.extent (0)
+       << ", handle: " << handle.get_inv_diag ().extent (0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  Impl::chebyshev_apply (handle, A, x, b, zero_initial_guess);
+}
+
+}
+
+#endif
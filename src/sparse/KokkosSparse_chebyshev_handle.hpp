@@ -0,0 +1,139 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosSparse_diagonal_handle.hpp"
+
+#ifndef _KOKKOSSPARSE_CHEBYSHEV_HANDLE_HPP
+#define _KOKKOSSPARSE_CHEBYSHEV_HANDLE_HPP
+
+namespace KokkosSparse{
+
+/**
+ * \brief Parameters and state of a Chebyshev smoother for D^{-1} A, where D
+ * is the diagonal of A. The smoother targets the eigenvalues of D^{-1} A in
+ * [lambda_max / eigenvalue_ratio, lambda_max]. chebyshev_setup estimates
+ * lambda_max with power iterations, unless it was given with set_lambda_max,
+ * and keeps the inverse diagonal and the work vectors of the applies.
+ */
+template <class lno_t_, class size_type_, class scalar_t_, class ExecutionSpace>
+class ChebyshevHandle{
+public:
+  typedef lno_t_ nnz_lno_t;
+  typedef size_type_ size_type;
+  typedef scalar_t_ nnz_scalar_t;
+  typedef ExecutionSpace execution_space;
+  typedef typename Kokkos::Details::ArithTraits<nnz_scalar_t>::mag_type mag_t;
+
+  typedef Kokkos::View<nnz_scalar_t *, execution_space> scalar_view_t;
+  typedef DiagonalHandle<nnz_lno_t, size_type, execution_space> diagonal_handle_t;
+
+private:
+  int degree;
+  int num_power_iterations;
+  mag_t eigenvalue_ratio;
+  mag_t boost_factor;
+
+  bool user_lambda_max;
+  mag_t lambda_max;
+  bool called_setup;
+
+  diagonal_handle_t diagonal_handle;
+  scalar_view_t inv_diag;
+  //residual and update of the applies, also the vectors of the power iterations.
+  scalar_view_t work_r;
+  scalar_view_t work_d;
+
+public:
+  /**
+   * \brief constructor.
+   * \param degree_: the degree of the polynomial, i.e. the number of
+   * matrix-vector products of an apply.
+   */
+  ChebyshevHandle(int degree_ = 2):
+    degree(degree_), num_power_iterations(10), eigenvalue_ratio(30), boost_factor(1.1),
+    user_lambda_max(false), lambda_max(0), called_setup(false),
+    diagonal_handle(), inv_diag(), work_r(), work_d(){}
+
+  int get_degree() const {return this->degree;}
+  int get_num_power_iterations() const {return this->num_power_iterations;}
+  mag_t get_eigenvalue_ratio() const {return this->eigenvalue_ratio;}
+  mag_t get_boost_factor() const {return this->boost_factor;}
+  mag_t get_lambda_max() const {return this->lambda_max;}
+  mag_t get_lambda_min() const {return this->lambda_max / this->eigenvalue_ratio;}
+  bool is_user_lambda_max() const {return this->user_lambda_max;}
+  bool is_setup_called() const {return this->called_setup;}
+
+  void set_degree(int degree_){this->degree = degree_;}
+  void set_num_power_iterations(int num_power_iterations_){this->num_power_iterations = num_power_iterations_;}
+  void set_eigenvalue_ratio(mag_t eigenvalue_ratio_){this->eigenvalue_ratio = eigenvalue_ratio_;}
+  //the power iteration estimate is multiplied by boost_factor, as it is below lambda_max.
+  void set_boost_factor(mag_t boost_factor_){this->boost_factor = boost_factor_;}
+
+  /**
+   * \brief sets the largest eigenvalue of D^{-1} A, so that setup skips the
+   * power iterations.
+   */
+  void set_lambda_max(mag_t lambda_max_){
+    this->lambda_max = lambda_max_;
+    this->user_lambda_max = true;
+  }
+
+  void set_estimated_lambda_max(mag_t lambda_max_){this->lambda_max = lambda_max_;}
+  void set_call_setup(bool call = true){this->called_setup = call;}
+
+  diagonal_handle_t &get_diagonal_handle(){return this->diagonal_handle;}
+
+  void set_work_views(scalar_view_t inv_diag_, scalar_view_t work_r_, scalar_view_t work_d_){
+    this->inv_diag = inv_diag_;
+    this->work_r = work_r_;
+    this->work_d = work_d_;
+  }
+  scalar_view_t get_inv_diag() const {return this->inv_diag;}
+  scalar_view_t get_work_r() const {return this->work_r;}
+  scalar_view_t get_work_d() const {return this->work_d;}
+};
+
+}
+
+#endif
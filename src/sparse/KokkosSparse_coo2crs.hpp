@@ -0,0 +1,324 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_coo2crs.hpp
+/// \brief Parallel construction of a CrsMatrix from (row, column, value)
+///   triplets.
+
+#ifndef KOKKOS_SPARSE_COO2CRS_HPP_
+#define KOKKOS_SPARSE_COO2CRS_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+
+namespace KokkosSparse {
+
+namespace Experimental {
+
+namespace Impl {
+
+// Number of triplets with an index out of range.
+template<class RowView, class ColView>
+struct Coo2CrsCheckFunctor {
+  typedef typename RowView::non_const_value_type ordinal_type;
+
+  RowView rows;
+  ColView cols;
+  const ordinal_type nrows;
+  const ordinal_type ncols;
+
+  Coo2CrsCheckFunctor (const RowView& rows_, const ColView& cols_,
+                       const ordinal_type nrows_, const ordinal_type ncols_) :
+    rows (rows_), cols (cols_), nrows (nrows_), ncols (ncols_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& k, size_t& num_bad) const
+  {
+    if (rows(k) < 0 || rows(k) >= nrows || cols(k) < 0 || cols(k) >= ncols) ++num_bad;
+  }
+};
+
+// Number of triplets of each row.
+template<class RowView, class RowMapView>
+struct Coo2CrsCountFunctor {
+  RowView rows;
+  RowMapView row_counts;
+
+  Coo2CrsCountFunctor (const RowView& rows_, const RowMapView& row_counts_) :
+    rows (rows_), row_counts (row_counts_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& k) const
+  {
+    Kokkos::atomic_fetch_add (&row_counts(rows(k)), typename RowMapView::non_const_value_type (1));
+  }
+};
+
+// Counting sort by row: the index of each triplet is placed in its row.
+template<class RowView, class RowMapView, class PermView>
+struct Coo2CrsScatterFunctor {
+  RowView rows;
+  RowMapView cursor;
+  PermView perm;
+
+  Coo2CrsScatterFunctor (const RowView& rows_, const RowMapView& cursor_, const PermView& perm_) :
+    rows (rows_), cursor (cursor_), perm (perm_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& k) const
+  {
+    const typename RowMapView::non_const_value_type pos =
+      Kokkos::atomic_fetch_add (&cursor(rows(k)), typename RowMapView::non_const_value_type (1));
+    perm(pos) = k;
+  }
+};
+
+// Heap sort of the triplet indices perm[begin, end) by (column, index).
+// The index breaks the ties, so that duplicates are summed in input order.
+template<class ColView, class PermView>
+KOKKOS_INLINE_FUNCTION
+void coo2crs_sort_row (const ColView& cols, const PermView& perm,
+                       const size_t begin, const size_t end)
+{
+  typedef typename PermView::non_const_value_type index_type;
+  const size_t n = end - begin;
+  for (size_t start = n / 2; start-- > 0; ) {
+    for (size_t root = start; 2 * root + 1 < n; ) {
+      size_t child = 2 * root + 1;
+      if (child + 1 < n) {
+        const index_type a = perm(begin + child), b = perm(begin + child + 1);
+        if (cols(a) < cols(b) || (cols(a) == cols(b) && a < b)) ++child;
+      }
+      const index_type r = perm(begin + root), c = perm(begin + child);
+      if (!(cols(r) < cols(c) || (cols(r) == cols(c) && r < c))) break;
+      perm(begin + root) = c;
+      perm(begin + child) = r;
+      root = child;
+    }
+  }
+  for (size_t last = n; last-- > 1; ) {
+    const index_type top = perm(begin);
+    perm(begin) = perm(begin + last);
+    perm(begin + last) = top;
+    for (size_t root = 0; 2 * root + 1 < last; ) {
+      size_t child = 2 * root + 1;
+      if (child + 1 < last) {
+        const index_type a = perm(begin + child), b = perm(begin + child + 1);
+        if (cols(a) < cols(b) || (cols(a) == cols(b) && a < b)) ++child;
+      }
+      const index_type r = perm(begin + root), c = perm(begin + child);
+      if (!(cols(r) < cols(c) || (cols(r) == cols(c) && r < c))) break;
+      perm(begin + root) = c;
+      perm(begin + child) = r;
+      root = child;
+    }
+  }
+}
+
+// Sorts each row by column and counts its distinct columns.
+template<class ColView, class RowMapView, class PermView>
+struct Coo2CrsSortFunctor {
+  typedef typename ColView::non_const_value_type ordinal_type;
+
+  ColView cols;
+  RowMapView row_offsets;
+  PermView perm;
+  RowMapView row_map;
+
+  Coo2CrsSortFunctor (const ColView& cols_, const RowMapView& row_offsets_,
+                      const PermView& perm_, const RowMapView& row_map_) :
+    cols (cols_), row_offsets (row_offsets_), perm (perm_), row_map (row_map_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    const size_t begin = row_offsets(i);
+    const size_t end = row_offsets(i + 1);
+    coo2crs_sort_row (cols, perm, begin, end);
+    typename RowMapView::non_const_value_type num_distinct = 0;
+    for (size_t k = begin; k < end; ++k) {
+      if (k == begin || cols(perm(k)) != cols(perm(k - 1))) ++num_distinct;
+    }
+    row_map(i) = num_distinct;
+  }
+};
+
+// Writes the distinct columns of each row, summing the duplicates.
+template<class ColView, class ValView, class RowMapView, class PermView,
+         class IndexView, class ValuesView>
+struct Coo2CrsFillFunctor {
+  typedef typename ColView::non_const_value_type ordinal_type;
+
+  ColView cols;
+  ValView vals;
+  RowMapView row_offsets;
+  PermView perm;
+  RowMapView row_map;
+  IndexView entries;
+  ValuesView values;
+
+  Coo2CrsFillFunctor (const ColView& cols_, const ValView& vals_, const RowMapView& row_offsets_,
+                      const PermView& perm_, const RowMapView& row_map_,
+                      const IndexView& entries_, const ValuesView& values_) :
+    cols (cols_), vals (vals_), row_offsets (row_offsets_), perm (perm_),
+    row_map (row_map_), entries (entries_), values (values_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    size_t write = row_map(i);
+    for (size_t k = row_offsets(i); k < size_t (row_offsets(i + 1)); ++k) {
+      const ordinal_type col = cols(perm(k));
+      if (k != size_t (row_offsets(i)) && col == entries(write - 1)) {
+        values(write - 1) += vals(perm(k));
+      } else {
+        entries(write) = col;
+        values(write) = vals(perm(k));
+        ++write;
+      }
+    }
+  }
+};
+
+}
+
+/// \brief Builds a CrsMatrix from (row, column, value) triplets, in
+///   parallel on the execution space of the matrix.
+///
+/// The triplets are counting-sorted by row, and each row is then sorted
+/// by column. Triplets with the same row and column are summed into one
+/// entry, in their input order, so that the result does not depend on
+/// the number of threads. The columns of each row are sorted.
+///
+/// \tparam CrsMatrixType The CrsMatrix to return; its device type is the
+///   memory space of the result.
+///
+/// \param nrows [in] Number of rows of the matrix.
+/// \param ncols [in] Number of columns of the matrix.
+/// \param rows [in] Row index of each triplet, in [0, nrows).
+/// \param cols [in] Column index of each triplet, in [0, ncols).
+/// \param vals [in] Value of each triplet.
+///
+/// rows, cols and vals are 1-D Views of the same length, with the ordinal
+/// and value types of the matrix, in any memory space; they are copied to
+/// the memory space of the matrix first.
+template<class CrsMatrixType, class RowView, class ColView, class ValView>
+CrsMatrixType
+coo2crs (const typename CrsMatrixType::ordinal_type nrows,
+         const typename CrsMatrixType::ordinal_type ncols,
+         const RowView& rows, const ColView& cols, const ValView& vals)
+{
+  typedef typename CrsMatrixType::execution_space execution_space;
+  typedef typename CrsMatrixType::device_type device_type;
+  typedef typename CrsMatrixType::non_const_ordinal_type ordinal_type;
+  typedef typename CrsMatrixType::non_const_size_type size_type;
+  typedef typename CrsMatrixType::non_const_value_type value_type;
+  typedef typename CrsMatrixType::row_map_type::non_const_type row_map_type;
+  typedef typename CrsMatrixType::index_type::non_const_type index_type;
+  typedef typename CrsMatrixType::values_type::non_const_type values_type;
+  typedef Kokkos::View<ordinal_type*, device_type> coo_index_type;
+  typedef Kokkos::View<value_type*, device_type> coo_values_type;
+  typedef Kokkos::View<size_type*, device_type> perm_type;
+  typedef Kokkos::RangePolicy<execution_space> my_exec_space;
+
+  const size_t num_triplets = rows.extent(0);
+  if (cols.extent(0) != num_triplets || vals.extent(0) != num_triplets) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::coo2crs: Dimensions do not match: "
+       << ", rows: " << rows.extent(0)
+       << ", cols: " << cols.extent(0)
+       << ", vals: " << vals.extent(0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  coo_index_type d_rows (Kokkos::ViewAllocateWithoutInitializing ("coo2crs rows"), num_triplets);
+  coo_index_type d_cols (Kokkos::ViewAllocateWithoutInitializing ("coo2crs cols"), num_triplets);
+  coo_values_type d_vals (Kokkos::ViewAllocateWithoutInitializing ("coo2crs vals"), num_triplets);
+  Kokkos::deep_copy (d_rows, rows);
+  Kokkos::deep_copy (d_cols, cols);
+  Kokkos::deep_copy (d_vals, vals);
+
+  size_t num_bad = 0;
+  Kokkos::parallel_reduce ("KokkosSparse::coo2crs::check", my_exec_space (0, num_triplets),
+      Impl::Coo2CrsCheckFunctor<coo_index_type, coo_index_type> (d_rows, d_cols, nrows, ncols), num_bad);
+  if (num_bad > 0) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::coo2crs: " << num_bad
+       << " triplets are out of range of the " << nrows << " x " << ncols << " matrix.";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  row_map_type row_offsets ("coo2crs row_offsets", nrows + 1);
+  row_map_type cursor (Kokkos::ViewAllocateWithoutInitializing ("coo2crs cursor"), nrows + 1);
+  perm_type perm (Kokkos::ViewAllocateWithoutInitializing ("coo2crs perm"), num_triplets);
+  row_map_type row_map ("coo2crs row_map", nrows + 1);
+
+  Kokkos::parallel_for ("KokkosSparse::coo2crs::count", my_exec_space (0, num_triplets),
+      Impl::Coo2CrsCountFunctor<coo_index_type, row_map_type> (d_rows, row_offsets));
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<row_map_type, execution_space> (nrows + 1, row_offsets);
+  Kokkos::deep_copy (cursor, row_offsets);
+  Kokkos::parallel_for ("KokkosSparse::coo2crs::scatter", my_exec_space (0, num_triplets),
+      Impl::Coo2CrsScatterFunctor<coo_index_type, row_map_type, perm_type> (d_rows, cursor, perm));
+
+  Kokkos::parallel_for ("KokkosSparse::coo2crs::sort", my_exec_space (0, nrows),
+      Impl::Coo2CrsSortFunctor<coo_index_type, row_map_type, perm_type> (d_cols, row_offsets, perm, row_map));
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<row_map_type, execution_space> (nrows + 1, row_map);
+  size_type nnz = 0;
+  Kokkos::deep_copy (nnz, Kokkos::subview (row_map, nrows));
+
+  index_type entries (Kokkos::ViewAllocateWithoutInitializing ("coo2crs entries"), nnz);
+  values_type values (Kokkos::ViewAllocateWithoutInitializing ("coo2crs values"), nnz);
+  Kokkos::parallel_for ("KokkosSparse::coo2crs::fill", my_exec_space (0, nrows),
+      Impl::Coo2CrsFillFunctor<coo_index_type, coo_values_type, row_map_type, perm_type,
+                               index_type, values_type>
+        (d_cols, d_vals, row_offsets, perm, row_map, entries, values));
+
+  return CrsMatrixType ("coo2crs", nrows, ncols, nnz, values, row_map, entries);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,318 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_crs_value_update.hpp
+/// \brief Value-only updates of a CrsMatrix with a fixed pattern: replace or
+///   sum into its values from a stream of (row, column, value) entries on
+///   the device, with or without a cached map of their positions.
+///
+/// Each update increments the values version of the matrix (see
+/// CrsMatrix::valuesVersion()), by which the handles that keep data
+/// computed from the values know that only their numeric phase is to be
+/// redone, e.g. in the Newton loops where the Jacobian is rebuilt with the
+/// same pattern at each iteration.
+
+#ifndef KOKKOSSPARSE_CRS_VALUE_UPDATE_HPP_
+#define KOKKOSSPARSE_CRS_VALUE_UPDATE_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_findRelOffset.hpp"
+
+namespace KokkosSparse {
+
+namespace Experimental {
+
+namespace Impl {
+
+// Position in A.values of each (rows(k), cols(k)), or invalid if the entry is
+// not in the pattern of A.
+template<class CrsMatrixType, class RowView, class ColView, class PositionView>
+struct CrsValuePositionsFunctor {
+  typedef typename CrsMatrixType::non_const_ordinal_type ordinal_type;
+  typedef typename PositionView::non_const_value_type size_type;
+  typedef size_t value_type;
+
+  CrsMatrixType A;
+  RowView rows;
+  ColView cols;
+  PositionView positions;
+  const size_type invalid;
+
+  CrsValuePositionsFunctor (const CrsMatrixType& A_, const RowView& rows_, const ColView& cols_,
+                            const PositionView& positions_, const size_type invalid_) :
+    A (A_), rows (rows_), cols (cols_), positions (positions_), invalid (invalid_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& k, value_type& num_valid) const
+  {
+    const ordinal_type row = rows(k);
+    positions(k) = invalid;
+    if (row < 0 || row >= A.numRows ()) {
+      return;
+    }
+    const size_type start = A.graph.row_map(row);
+    const ordinal_type length = static_cast<ordinal_type> (A.graph.row_map(row + 1) - start);
+    if (length == 0) {
+      return;
+    }
+    const ordinal_type offset = findRelOffset (&A.graph.entries(start), length,
+                                               static_cast<ordinal_type> (cols(k)), ordinal_type (0), false);
+    if (offset != length) {
+      positions(k) = start + offset;
+      ++num_valid;
+    }
+  }
+};
+
+template<class ValuesView, class PositionView, class CooValuesView, bool sum>
+struct CrsValueScatterFunctor {
+  typedef typename PositionView::non_const_value_type size_type;
+
+  ValuesView values;
+  PositionView positions;
+  CooValuesView coo_values;
+  const size_type invalid;
+
+  CrsValueScatterFunctor (const ValuesView& values_, const PositionView& positions_,
+                          const CooValuesView& coo_values_, const size_type invalid_) :
+    values (values_), positions (positions_), coo_values (coo_values_), invalid (invalid_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& k) const
+  {
+    const size_type pos = positions(k);
+    if (pos != invalid) {
+      if (sum) {
+        Kokkos::atomic_add (&values(pos), coo_values(k));
+      } else {
+        values(pos) = coo_values(k);
+      }
+    }
+  }
+};
+
+// Batched sumIntoValues/replaceValues, one entry per iteration, with atomics
+// as the entries may repeat.
+template<class CrsMatrixType, class RowView, class ColView, class CooValuesView, bool sum>
+struct CrsValueUpdateFunctor {
+  typedef typename CrsMatrixType::non_const_ordinal_type ordinal_type;
+  typedef typename CrsMatrixType::non_const_value_type scalar_type;
+  typedef size_t value_type;
+
+  CrsMatrixType A;
+  RowView rows;
+  ColView cols;
+  CooValuesView coo_values;
+
+  CrsValueUpdateFunctor (const CrsMatrixType& A_, const RowView& rows_, const ColView& cols_,
+                         const CooValuesView& coo_values_) :
+    A (A_), rows (rows_), cols (cols_), coo_values (coo_values_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& k, value_type& num_valid) const
+  {
+    const ordinal_type row = rows(k);
+    if (row < 0 || row >= A.numRows ()) {
+      return;
+    }
+    const ordinal_type col = cols(k);
+    const scalar_type val = coo_values(k);
+    num_valid += sum ? A.sumIntoValues (row, &col, 1, &val, false, true) :
+                       A.replaceValues (row, &col, 1, &val, false, true);
+  }
+};
+
+template<class RowView, class ColView, class CooValuesView>
+void check_crs_value_update (const RowView& rows, const ColView& cols, const CooValuesView& coo_values,
+                             const char* name)
+{
+  if (rows.extent(0) != cols.extent(0) || rows.extent(0) != coo_values.extent(0)) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::" << name << ": Dimensions do not match: "
+       << "rows: " << rows.extent(0)
+       << ", cols: " << cols.extent(0)
+       << ", values: " << coo_values.extent(0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+}
+
+template<class CrsMatrixType, class RowView, class ColView, class CooValuesView, bool sum>
+size_t update_crs_values (CrsMatrixType& A, const RowView& rows, const ColView& cols,
+                          const CooValuesView& coo_values, const char* name)
+{
+  typedef typename CrsMatrixType::execution_space execution_space;
+  check_crs_value_update (rows, cols, coo_values, name);
+  size_t num_valid = 0;
+  Kokkos::parallel_reduce (name, Kokkos::RangePolicy<execution_space> (0, rows.extent(0)),
+      CrsValueUpdateFunctor<CrsMatrixType, RowView, ColView, CooValuesView, sum> (A, rows, cols, coo_values),
+      num_valid);
+  A.bumpValuesVersion ();
+  return num_valid;
+}
+
+}
+
+/// \class CrsValueMap
+/// \brief Positions in the values of a CrsMatrix of a stream of
+///   (row, column) entries, for repeated value updates from streams
+///   with the same entries.
+///
+/// The map is built once, with one search of each entry in its row; the
+/// updates then scatter the values without any search. The entries that
+/// are not in the pattern of the matrix are ignored. The map is kept
+/// for the matrix with the row map it was built for; see is_map_for().
+template<class CrsMatrixType>
+class CrsValueMap {
+public:
+  typedef typename CrsMatrixType::execution_space execution_space;
+  typedef typename CrsMatrixType::device_type device_type;
+  typedef typename CrsMatrixType::non_const_size_type size_type;
+  typedef Kokkos::View<size_type*, device_type> positions_type;
+
+  //! Position in the values of the matrix of each entry, or invalid_offset().
+  positions_type positions;
+
+  CrsValueMap () : map_row_map_ (NULL), map_nnz_ (0), num_valid_ (0) {}
+
+  /// \brief Builds the map of the entries (rows(k), cols(k)) of the stream.
+  /// \param A [in] The matrix; only its pattern is used.
+  /// \param rows [in] Row index of each entry.
+  /// \param cols [in] Column index of each entry, in the same memory space.
+  template<class RowView, class ColView>
+  CrsValueMap (const CrsMatrixType& A, const RowView& rows, const ColView& cols) :
+    map_row_map_ (A.graph.row_map.data ()), map_nnz_ (A.nnz ()), num_valid_ (0)
+  {
+    typedef Impl::CrsValuePositionsFunctor<CrsMatrixType, RowView, ColView, positions_type> functor_type;
+    if (rows.extent(0) != cols.extent(0)) {
+      std::ostringstream os;
+      os << "KokkosSparse::Experimental::CrsValueMap: Dimensions do not match: "
+         << "rows: " << rows.extent(0)
+         << ", cols: " << cols.extent(0);
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+    positions = positions_type (Kokkos::ViewAllocateWithoutInitializing ("CrsValueMap positions"), rows.extent(0));
+    Kokkos::parallel_reduce ("KokkosSparse::CrsValueMap", Kokkos::RangePolicy<execution_space> (0, rows.extent(0)),
+        functor_type (A, rows, cols, positions, invalid_offset ()), num_valid_);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static size_type invalid_offset () { return ~size_type (0); }
+
+  //! The number of entries of the stream.
+  size_t numEntries () const { return positions.extent(0); }
+
+  //! The number of entries of the stream in the pattern of the matrix.
+  size_t numValid () const { return num_valid_; }
+
+  //! True if the map was built for a matrix with the row map and nnz of A.
+  bool is_map_for (const CrsMatrixType& A) const {
+    return map_row_map_ == A.graph.row_map.data () && map_nnz_ == A.nnz ();
+  }
+
+  /// \brief Replaces the values of the entries of the stream by
+  ///   coo_values. If an entry repeats, one of its values is kept.
+  template<class CooValuesView>
+  void replace (CrsMatrixType& A, const CooValuesView& coo_values) const
+  {
+    scatter<CooValuesView, false> (A, coo_values, "replace");
+  }
+
+  /// \brief Adds coo_values to the values of the entries of the stream,
+  ///   with atomics. If zero_first, the other values of A are zeroed
+  ///   first, which assembles A from the stream.
+  template<class CooValuesView>
+  void sum_into (CrsMatrixType& A, const CooValuesView& coo_values, const bool zero_first = false) const
+  {
+    if (zero_first) {
+      Kokkos::deep_copy (A.values, Kokkos::Details::ArithTraits<typename CrsMatrixType::non_const_value_type>::zero ());
+    }
+    scatter<CooValuesView, true> (A, coo_values, "sum_into");
+  }
+
+private:
+  template<class CooValuesView, bool sum>
+  void scatter (CrsMatrixType& A, const CooValuesView& coo_values, const char* name) const
+  {
+    if (!is_map_for (A) || coo_values.extent(0) != positions.extent(0)) {
+      std::ostringstream os;
+      os << "KokkosSparse::Experimental::CrsValueMap::" << name
+         << ": the map was not built for this matrix, or Dimensions do not match: "
+         << "entries: " << positions.extent(0)
+         << ", values: " << coo_values.extent(0);
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+    Kokkos::parallel_for ("KokkosSparse::CrsValueMap::scatter", Kokkos::RangePolicy<execution_space> (0, positions.extent(0)),
+        Impl::CrsValueScatterFunctor<typename CrsMatrixType::values_type, positions_type, CooValuesView, sum>
+          (A.values, positions, coo_values, invalid_offset ()));
+    A.bumpValuesVersion ();
+  }
+
+  const void* map_row_map_;
+  size_type map_nnz_;
+  size_t num_valid_;
+};
+
+/// \brief Replaces the values of the entries (rows(k), cols(k)) of A by
+///   coo_values(k) on the device, searching each entry in its row. The
+///   entries that are not in the pattern of A are ignored.
+/// \return The number of entries found in the pattern.
+template<class CrsMatrixType, class RowView, class ColView, class CooValuesView>
+size_t replace_values (CrsMatrixType& A, const RowView& rows, const ColView& cols, const CooValuesView& coo_values)
+{
+  return Impl::update_crs_values<CrsMatrixType, RowView, ColView, CooValuesView, false> (A, rows, cols, coo_values, "replace_values");
+}
+
+/// \brief Adds coo_values(k) to the values of the entries (rows(k), cols(k))
+///   of A on the device, with atomics, like replace_values.
+template<class CrsMatrixType, class RowView, class ColView, class CooValuesView>
+size_t sum_into_values (CrsMatrixType& A, const RowView& rows, const ColView& cols, const CooValuesView& coo_values)
+{
+  return Impl::update_crs_values<CrsMatrixType, RowView, ColView, CooValuesView, true> (A, rows, cols, coo_values, "sum_into_values");
+}
+
+}
+}
+
+#endif
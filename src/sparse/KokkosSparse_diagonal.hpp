@@ -0,0 +1,145 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_diagonal.hpp
+/// \brief Inverse diagonal and symmetric diagonal scaling of a CrsMatrix.
+
+#ifndef KOKKOSSPARSE_DIAGONAL_HPP_
+#define KOKKOSSPARSE_DIAGONAL_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_diagonal_handle.hpp"
+#include "KokkosSparse_diagonal_impl.hpp"
+
+namespace KokkosSparse {
+
+/// \brief Returns the offsets of the diagonal entries of A within their
+///   rows, finding them in parallel the first time the handle is used
+///   with A.
+///
+/// \param handle [in/out] The handle; its ordinal and size types must be
+///   those of A.
+/// \param A [in] The sparse matrix.
+template<class HandleType, class AMatrix>
+typename HandleType::offsets_view_t
+get_diagonal_offsets (HandleType& handle, const AMatrix& A)
+{
+  static_assert (std::is_same<typename AMatrix::non_const_size_type, typename HandleType::size_type>::value &&
+                 std::is_same<typename AMatrix::non_const_ordinal_type, typename HandleType::nnz_lno_t>::value,
+                 "KokkosSparse::get_diagonal_offsets: The handle and the matrix must have the same ordinal and size types.");
+
+  if (!handle.is_plan_for (A.graph.row_map.data (), A.numRows (), A.nnz ())) {
+    Impl::diagonal_offsets_symbolic (handle, A);
+  }
+  return handle.get_diagonal_offsets ();
+}
+
+/// \brief Computes the inverse of the diagonal of A, as needed by
+///   Jacobi and Chebyshev smoothers.
+///
+/// Rows without a stored diagonal entry, or whose diagonal entry is
+/// zero, get 1.
+///
+/// \param handle [in/out] The handle keeping the diagonal offsets of A.
+/// \param A [in] The sparse matrix.
+/// \param inv_diag [out] 1-D view of length A.numRows().
+template<class HandleType, class AMatrix, class DiagType>
+void
+get_inverse_diagonal (HandleType& handle, const AMatrix& A, const DiagType& inv_diag)
+{
+  static_assert (Kokkos::Impl::is_view<DiagType>::value && static_cast<int> (DiagType::rank) == 1,
+                 "KokkosSparse::get_inverse_diagonal: inv_diag must be a 1-D Kokkos::View.");
+  if (static_cast<size_t> (inv_diag.extent (0)) != static_cast<size_t> (A.numRows ())) {
+    std::ostringstream os;
+    os << "KokkosSparse::get_inverse_diagonal: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols ()
+       << ", inv_diag: " << inv_diag.extent (0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  get_diagonal_offsets (handle, A);
+  Impl::diagonal_inverse (handle, A, inv_diag, DiagType ());
+}
+
+/// \brief Scales A in place to D^{-1/2} A D^{-1/2}, where D is the
+///   magnitude of the diagonal of A.
+///
+/// The diagonal is read through the offsets kept in handle, then the
+/// entries of A are scaled in a single pass. Rows without a stored
+/// diagonal entry, or whose diagonal entry is zero, are scaled by 1.
+/// The solution of the scaled system is D^{-1/2} times the solution of
+/// the original one.
+///
+/// \param handle [in/out] The handle keeping the diagonal offsets of A.
+/// \param A [in/out] The square sparse matrix; its values are overwritten.
+/// \param inv_sqrt_diag [out] 1-D view of length A.numRows(), D^{-1/2}.
+/// \param inv_diag [out] 1-D view of length A.numRows() or 0; if not
+///   empty, the inverse of the diagonal of A before the scaling.
+template<class HandleType, class AMatrix, class DiagType>
+void
+symmetric_diagonal_scale (HandleType& handle, const AMatrix& A,
+                          const DiagType& inv_sqrt_diag,
+                          const DiagType& inv_diag = DiagType ())
+{
+  static_assert (Kokkos::Impl::is_view<DiagType>::value && static_cast<int> (DiagType::rank) == 1,
+                 "KokkosSparse::symmetric_diagonal_scale: inv_sqrt_diag must be a 1-D Kokkos::View.");
+  if (A.numRows () != A.numCols () ||
+      static_cast<size_t> (inv_sqrt_diag.extent (0)) != static_cast<size_t> (A.numRows ()) ||
+      (inv_diag.extent (0) != 0 && inv_diag.extent (0) != inv_sqrt_diag.extent (0))) {
+    std::ostringstream os;
+    os << "KokkosSparse::symmetric_diagonal_scale: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols ()
+       << ", inv_sqrt_diag: " << inv_sqrt_diag.extent (0)
+       << ", inv_diag: " << inv_diag.extent (0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  get_diagonal_offsets (handle, A);
+  Impl::diagonal_inverse (handle, A, inv_diag, inv_sqrt_diag);
+  Impl::symmetric_scale (A, inv_sqrt_diag);
+}
+
+}
+
+#endif
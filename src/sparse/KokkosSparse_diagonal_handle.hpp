@@ -0,0 +1,128 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <Kokkos_Core.hpp>
+
+#ifndef _KOKKOSSPARSE_DIAGONAL_HANDLE_HPP
+#define _KOKKOSSPARSE_DIAGONAL_HANDLE_HPP
+
+namespace KokkosSparse{
+
+/**
+ * \brief Offsets of the diagonal entries of a matrix within their rows,
+ * found the first time the handle is used with the matrix and reused by the
+ * following diagonal extractions and scalings. Rows without a stored
+ * diagonal entry get KokkosSparse::OrdinalTraits<size_t>::invalid(). The
+ * offsets can also be passed to KokkosSparse::getDiagCopy.
+ * The offsets are found again if the handle is called with another matrix,
+ * or after reset_plan(), e.g. when the pattern of the matrix changes in place.
+ */
+template <class lno_t_, class size_type_, class ExecutionSpace>
+class DiagonalHandle{
+public:
+  typedef lno_t_ nnz_lno_t;
+  typedef size_type_ size_type;
+  typedef ExecutionSpace execution_space;
+
+  typedef Kokkos::View<size_t *, execution_space> offsets_view_t;
+
+private:
+  bool sorted_columns;
+
+  bool is_inspected;
+  //the matrix of the plan.
+  const void *plan_row_map;
+  nnz_lno_t plan_num_rows;
+  size_type plan_nnz;
+
+  offsets_view_t diagonal_offsets;
+
+public:
+  /**
+   * \brief constructor.
+   * \param sorted_columns_: if true, the columns of each row are sorted and
+   * the diagonal entries are found with a binary search; otherwise with a
+   * linear one.
+   */
+  DiagonalHandle(bool sorted_columns_ = false):
+    sorted_columns(sorted_columns_),
+    is_inspected(false), plan_row_map(NULL), plan_num_rows(0), plan_nnz(0),
+    diagonal_offsets(){}
+
+  bool get_sorted_columns() const {return this->sorted_columns;}
+
+  /**
+   * \brief invalidates the plan, so that the next call finds the offsets again.
+   */
+  void reset_plan(){
+    this->is_inspected = false;
+    this->plan_row_map = NULL;
+    this->diagonal_offsets = offsets_view_t();
+  }
+
+  /**
+   * \brief returns true if the offsets were found for a matrix with this row
+   * map and sizes.
+   */
+  bool is_plan_for(const void *row_map_, nnz_lno_t num_rows_, size_type nnz_) const {
+    return this->is_inspected && this->plan_row_map == row_map_ &&
+        this->plan_num_rows == num_rows_ && this->plan_nnz == nnz_;
+  }
+
+  /**
+   * \brief stores the offsets of the diagonal entries.
+   */
+  void set_plan(const void *row_map_, nnz_lno_t num_rows_, size_type nnz_,
+      offsets_view_t diagonal_offsets_){
+    this->plan_row_map = row_map_;
+    this->plan_num_rows = num_rows_;
+    this->plan_nnz = nnz_;
+    this->diagonal_offsets = diagonal_offsets_;
+    this->is_inspected = true;
+  }
+
+  offsets_view_t get_diagonal_offsets() const {return this->diagonal_offsets;}
+};
+
+}
+
+#endif
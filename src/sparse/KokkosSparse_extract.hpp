@@ -0,0 +1,183 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_extract.hpp
+/// \brief Extraction of submatrices and dense diagonal blocks of a
+///   CrsMatrix on its device, for domain decomposition and block
+///   preconditioners.
+
+#ifndef KOKKOSSPARSE_EXTRACT_HPP_
+#define KOKKOSSPARSE_EXTRACT_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosSparse_extract_impl.hpp"
+
+namespace KokkosSparse {
+
+//! The type of a submatrix of AMatrix.
+template<class AMatrix>
+struct SubmatrixType {
+  typedef CrsMatrix<typename AMatrix::non_const_value_type,
+                    typename AMatrix::non_const_ordinal_type,
+                    typename AMatrix::device_type, void,
+                    typename AMatrix::non_const_size_type> type;
+};
+
+/// \brief Returns the submatrix A(rows, cols).
+///
+/// Row i of the result is row rows(i) of A, restricted to the columns in
+/// cols, and its column indices are the positions of the columns in cols.
+/// The entries of each row stay in the order of A. The inverse of cols is
+/// built on the device of A, as are the counts, the row map and the
+/// entries, so nothing goes through the host besides the number of
+/// entries.
+///
+/// \param A [in] The sparse matrix.
+/// \param rows [in] The rows of A to extract, in [0, A.numRows()); a row
+///   may appear more than once.
+/// \param cols [in] The distinct columns of A to extract, in
+///   [0, A.numCols()).
+template<class AMatrix, class RowsView, class ColsView>
+typename SubmatrixType<AMatrix>::type
+extract_submatrix (const AMatrix& A, const RowsView& rows, const ColsView& cols)
+{
+  typedef typename SubmatrixType<AMatrix>::type matrix_type;
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename matrix_type::non_const_ordinal_type ordinal_type;
+  typedef typename matrix_type::non_const_size_type size_type;
+  typedef typename matrix_type::row_map_type::non_const_type row_map_type;
+  typedef typename matrix_type::index_type::non_const_type entries_type;
+  typedef typename matrix_type::values_type::non_const_type values_type;
+  typedef Kokkos::View<ordinal_type*, typename AMatrix::device_type> col_map_type;
+  typedef Impl::Extract_Column_Map_Functor<ColsView, col_map_type> col_map_functor_type;
+  typedef Impl::Extract_Submatrix_Functor<AMatrix, RowsView, col_map_type, row_map_type,
+                                          entries_type, values_type> functor_type;
+
+  const ordinal_type numRows = rows.extent(0);
+  const ordinal_type numCols = cols.extent(0);
+  col_map_type col_map (Kokkos::ViewAllocateWithoutInitializing ("extract col_map"), A.numCols ());
+  Kokkos::deep_copy (col_map, ordinal_type(-1));
+  size_t num_duplicates = 0;
+  Kokkos::parallel_reduce ("KokkosSparse::extract_submatrix::col_map",
+      Kokkos::RangePolicy<execution_space> (0, numCols),
+      col_map_functor_type (cols, col_map), num_duplicates);
+  if (num_duplicates != 0) {
+    std::ostringstream os;
+    os << "KokkosSparse::extract_submatrix: " << num_duplicates
+       << " of the columns appear more than once in cols.";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  row_map_type row_map ("extract row_map", numRows + 1);
+  functor_type func (A, rows, col_map, row_map, entries_type (), values_type ());
+  Kokkos::parallel_for ("KokkosSparse::extract_submatrix::count",
+      Kokkos::RangePolicy<typename functor_type::CountTag, execution_space> (0, numRows), func);
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<row_map_type, execution_space> (numRows + 1, row_map);
+  size_type nnz = 0;
+  Kokkos::deep_copy (nnz, Kokkos::subview (row_map, numRows));
+
+  func.entries = entries_type (Kokkos::ViewAllocateWithoutInitializing ("extract entries"), nnz);
+  func.values = values_type (Kokkos::ViewAllocateWithoutInitializing ("extract values"), nnz);
+  Kokkos::parallel_for ("KokkosSparse::extract_submatrix::fill",
+      Kokkos::RangePolicy<typename functor_type::FillTag, execution_space> (0, numRows), func);
+  return matrix_type ("submatrix", numRows, numCols, nnz, func.values, row_map, func.entries);
+}
+
+//! The number of diagonal blocks of size block_size of A.
+template<class AMatrix>
+typename AMatrix::non_const_ordinal_type
+num_diagonal_blocks (const AMatrix& A, const typename AMatrix::non_const_ordinal_type block_size)
+{
+  return (A.numRows () + block_size - 1) / block_size;
+}
+
+/// \brief Copies the diagonal blocks of A into the dense batch blocks,
+///   for example for the batched LU factorization of a block Jacobi
+///   preconditioner.
+///
+/// blocks(b, i, j) = A(b * block_size + i, b * block_size + j). If the
+/// number of rows of A is not a multiple of block_size, the last block is
+/// completed with the identity so that it stays nonsingular.
+///
+/// \param A [in] The square sparse matrix.
+/// \param block_size [in] The size of the blocks.
+/// \param blocks [out] A rank 3 View on the device of A, of dimensions
+///   num_diagonal_blocks(A, block_size) x block_size x block_size.
+template<class AMatrix, class BlocksView>
+void
+extract_diagonal_blocks (const AMatrix& A,
+                         const typename AMatrix::non_const_ordinal_type block_size,
+                         const BlocksView& blocks)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type ordinal_type;
+  static_assert (static_cast<int> (BlocksView::rank) == 3,
+                 "KokkosSparse::extract_diagonal_blocks: blocks must have rank 3.");
+
+  if (block_size <= 0 || A.numRows () != A.numCols ()) {
+    std::ostringstream os;
+    os << "KokkosSparse::extract_diagonal_blocks: A must be square and block_size positive, but A is "
+       << A.numRows () << " x " << A.numCols () << " and block_size is " << block_size << ".";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  const ordinal_type numBlocks = num_diagonal_blocks (A, block_size);
+  if (static_cast<ordinal_type> (blocks.extent(0)) != numBlocks ||
+      static_cast<ordinal_type> (blocks.extent(1)) != block_size ||
+      static_cast<ordinal_type> (blocks.extent(2)) != block_size) {
+    std::ostringstream os;
+    os << "KokkosSparse::extract_diagonal_blocks: blocks must be " << numBlocks << " x "
+       << block_size << " x " << block_size << ", but is " << blocks.extent(0) << " x "
+       << blocks.extent(1) << " x " << blocks.extent(2) << ".";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  Kokkos::parallel_for ("KokkosSparse::extract_diagonal_blocks",
+      Kokkos::RangePolicy<execution_space> (0, numBlocks * block_size),
+      Impl::Extract_Diagonal_Blocks_Functor<AMatrix, BlocksView> (A, blocks, block_size));
+}
+
+}
+
+#endif
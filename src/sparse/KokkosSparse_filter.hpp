@@ -0,0 +1,123 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_filter.hpp
+/// \brief Dropping of the weak entries of a CrsMatrix, for cheaper
+///   preconditioners and AMG strength-of-connection graphs.
+
+#ifndef KOKKOSSPARSE_FILTER_HPP_
+#define KOKKOSSPARSE_FILTER_HPP_
+
+#include "Kokkos_Core.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_filter_impl.hpp"
+
+namespace KokkosSparse {
+
+//! The type of a filtered AMatrix.
+template<class AMatrix>
+struct FilterMatrixType {
+  typedef CrsMatrix<typename AMatrix::non_const_value_type,
+                    typename AMatrix::non_const_ordinal_type,
+                    typename AMatrix::device_type, void,
+                    typename AMatrix::non_const_size_type> type;
+};
+
+/// \brief Returns the matrix of the entries of A kept by criterion with
+///   the threshold theta, values included.
+///
+/// The entries kept in each row are counted, the counts summed into the
+/// row map and the kept entries filled, all on the device of A. The
+/// entries of each row stay in the order of A.
+///
+/// \param A [in] The sparse matrix.
+/// \param criterion [in] See SparseFilterCriterion.
+/// \param theta [in] The threshold.
+/// \param keep_diagonal [in] If true, the diagonal entries are always kept;
+///   otherwise they are always dropped.
+template<class AMatrix>
+typename FilterMatrixType<AMatrix>::type
+filter_matrix (const AMatrix& A, const SparseFilterCriterion criterion,
+               const typename Kokkos::Details::ArithTraits<typename AMatrix::non_const_value_type>::mag_type theta,
+               const bool keep_diagonal = true)
+{
+  typedef typename FilterMatrixType<AMatrix>::type matrix_type;
+  typedef typename matrix_type::row_map_type::non_const_type row_map_type;
+  typedef typename matrix_type::index_type::non_const_type entries_type;
+  typedef typename matrix_type::values_type::non_const_type values_type;
+
+  row_map_type row_map;
+  entries_type entries;
+  values_type values;
+  Impl::filter (A, criterion, theta, keep_diagonal, true, row_map, entries, values);
+  return matrix_type ("filtered", A.numRows (), A.numCols (), entries.extent(0),
+                      values, row_map, entries);
+}
+
+/// \brief Returns the graph of the entries of A kept by criterion with
+///   the threshold theta, for example the strength-of-connection graph
+///   of an AMG coarsening.
+///
+/// As filter_matrix, but the values are not copied.
+template<class AMatrix>
+typename FilterMatrixType<AMatrix>::type::staticcrsgraph_type
+filter_graph (const AMatrix& A, const SparseFilterCriterion criterion,
+              const typename Kokkos::Details::ArithTraits<typename AMatrix::non_const_value_type>::mag_type theta,
+              const bool keep_diagonal = true)
+{
+  typedef typename FilterMatrixType<AMatrix>::type matrix_type;
+  typedef typename matrix_type::staticcrsgraph_type graph_type;
+  typedef typename matrix_type::row_map_type::non_const_type row_map_type;
+  typedef typename matrix_type::index_type::non_const_type entries_type;
+  typedef typename matrix_type::values_type::non_const_type values_type;
+
+  row_map_type row_map;
+  entries_type entries;
+  values_type values;
+  Impl::filter (A, criterion, theta, keep_diagonal, false, row_map, entries, values);
+  return graph_type (entries, row_map);
+}
+
+}
+
+#endif
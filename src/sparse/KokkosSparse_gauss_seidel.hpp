@@ -44,11 +44,70 @@
 #define _KOKKOS_GAUSSSEIDEL_HPP
 
 #include "KokkosSparse_gauss_seidel_spec.hpp"
+#include "KokkosSparse_gauss_seidel_impl.hpp"
 #include "KokkosKernels_Handle.hpp"
 #include "KokkosKernels_helpers.hpp"
+#include "KokkosKernels_Profiling.hpp"
+#include "KokkosKernels_Prefetch.hpp"
 
 namespace KokkosSparse{
 
+namespace Impl{
+
+  /// \brief Bytes moved by one Gauss-Seidel sweep when the matrix and y are
+  ///   read once and x is read and written once.
+  template <typename row_view_t, typename nnz_view_t, typename scalar_view_t,
+    typename x_view_t, typename y_view_t>
+  double gauss_seidel_sweep_bytes(row_view_t row_map, nnz_view_t entries, scalar_view_t values,
+      x_view_t x, y_view_t y){
+	  return row_map.extent(0) * double(sizeof(typename row_view_t::non_const_value_type)) +
+			  entries.extent(0) * double(sizeof(typename nnz_view_t::non_const_value_type)) +
+			  values.extent(0) * double(sizeof(typename scalar_view_t::non_const_value_type)) +
+			  2.0 * x.extent(0) * x.extent(1) * sizeof(typename x_view_t::non_const_value_type) +
+			  y.extent(0) * y.extent(1) * double(sizeof(typename y_view_t::non_const_value_type));
+  }
+
+  /// \brief The applies of rank 1 vectors go through GAUSS_SEIDEL_APPLY.
+  template <typename KernelHandle, typename row_view_t, typename nnz_view_t, typename scalar_view_t,
+    typename x_view_t, typename y_view_t>
+  bool gauss_seidel_mv_apply(KernelHandle *, typename KernelHandle::const_nnz_lno_t, typename KernelHandle::const_nnz_lno_t,
+      row_view_t, nnz_view_t, scalar_view_t, x_view_t, y_view_t,
+      bool, bool, int, bool, bool, std::integral_constant<int, 1>){
+	  return false;
+  }
+
+  /// \brief Sweeps all the columns of x and y together when they have more
+  ///   than one, for the point algorithms that permute the matrix. Returns
+  ///   false, for the caller to apply the first column, otherwise.
+  template <typename KernelHandle, typename row_view_t, typename nnz_view_t, typename scalar_view_t,
+    typename x_view_t, typename y_view_t>
+  bool gauss_seidel_mv_apply(KernelHandle *handle,
+      typename KernelHandle::const_nnz_lno_t num_rows,
+      typename KernelHandle::const_nnz_lno_t num_cols,
+      row_view_t row_map, nnz_view_t entries, scalar_view_t values,
+      x_view_t x_lhs_output_vec, y_view_t y_rhs_input_vec,
+      bool init_zero_x_vector, bool update_y_vector, int numIter,
+      bool apply_forward, bool apply_backward, std::integral_constant<int, 2>){
+	  typename KernelHandle::GaussSeidelHandleType *gsHandler = handle->get_gs_handle();
+	  if (x_lhs_output_vec.extent(1) < 2 || gsHandler->get_block_size() != 1 ||
+			  gsHandler->is_in_place() || gsHandler->get_algorithm_type() == GS_TWOSTAGE ||
+			  gsHandler->get_algorithm_type() == GS_HYBRID){
+		  return false;
+	  }
+	  if (x_lhs_output_vec.extent(1) != y_rhs_input_vec.extent(1)){
+		  std::ostringstream os;
+		  os << "KokkosSparse::gauss_seidel_apply: x has " << x_lhs_output_vec.extent(1)
+		     << " columns but y has " << y_rhs_input_vec.extent(1);
+		  Kokkos::Impl::throw_runtime_exception(os.str());
+	  }
+	  GaussSeidel<KernelHandle, row_view_t, nnz_view_t, scalar_view_t> sgs(
+			  handle, num_rows, num_cols, row_map, entries, values);
+	  sgs.mv_apply(x_lhs_output_vec, y_rhs_input_vec, init_zero_x_vector, numIter,
+			  apply_forward, apply_backward, update_y_vector);
+	  return true;
+  }
+}
+
 namespace Experimental{
 
   template <typename KernelHandle, typename lno_row_view_t_, typename lno_nnz_view_t_>
@@ -59,6 +118,7 @@ namespace Experimental{
       lno_row_view_t_ row_map,
       lno_nnz_view_t_ entries,
 	  bool is_graph_symmetric = true){
+	  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::gauss_seidel_symbolic");
 
 
 
@@ -101,11 +161,25 @@ namespace Experimental{
           Internal_alno_row_view_t_ const_a_r (row_map.data(), row_map.extent(0));
           Internal_alno_nnz_view_t_ const_a_l (entries.data(), entries.extent(0));
 
+	  //the coloring and the permutation only depend on the pattern, so the
+	  //symbolic phase is skipped if it was called before for the same one.
+	  typename KernelHandle::GaussSeidelHandleType *gsHandle = handle->get_gs_handle();
+	  uint64_t pattern_hash = KokkosKernels::Impl::kk_hash_graph
+	      <Internal_alno_row_view_t_, Internal_alno_nnz_view_t_, c_exec_t>
+	      (num_rows, num_cols, const_a_r, const_a_l,
+	       KokkosKernels::Impl::kk_hash_mix(
+	           uint64_t(is_graph_symmetric) + 2 * uint64_t(gsHandle->get_block_size()) +
+	           (uint64_t(gsHandle->get_algorithm_type()) << 48)));
+	  if (gsHandle->is_symbolic_called_for(pattern_hash)){
+	    return;
+	  }
+
 	  using namespace KokkosSparse::Impl;
 
 	  GAUSS_SEIDEL_SYMBOLIC<const_handle_type, Internal_alno_row_view_t_, Internal_alno_nnz_view_t_>::gauss_seidel_symbolic
 	  (&tmp_handle, num_rows, num_cols, const_a_r, const_a_l, is_graph_symmetric);
 
+	  gsHandle->set_symbolic_pattern_hash(pattern_hash);
   }
 
   template <typename KernelHandle, typename lno_row_view_t_, typename lno_nnz_view_t_>
@@ -117,6 +191,7 @@ namespace Experimental{
       lno_row_view_t_ row_map,
       lno_nnz_view_t_ entries,
 	  bool is_graph_symmetric = true){
+	  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::block_gauss_seidel_symbolic");
 
 
 	  handle->get_gs_handle()->set_block_size(block_size);
@@ -140,6 +215,7 @@ namespace Experimental{
       scalar_nnz_view_t_ values,
       bool is_graph_symmetric = true
       ){
+	  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::gauss_seidel_numeric");
 
 	  static_assert (std::is_same<typename KernelHandle::const_size_type,
 			  typename lno_row_view_t_::const_value_type>::value,
@@ -188,6 +264,16 @@ namespace Experimental{
 	  Internal_alno_nnz_view_t_ const_a_l (entries.data(), entries.extent(0));
 	  Internal_ascalar_nnz_view_t_ const_a_v (values.data(), values.extent(0));
 
+	  if (handle->get_prefetch_before_numeric()){
+		  const c_exec_t exec;
+		  KokkosKernels::Impl::kk_prefetch_view(row_map, exec, true);
+		  KokkosKernels::Impl::kk_prefetch_view(entries, exec, true);
+		  KokkosKernels::Impl::kk_prefetch_view(values, exec);
+		  handle->get_gs_handle()->prefetch(exec);
+	  }
+
+	  //the values are only known by their version through gauss_seidel_update_values.
+	  handle->get_gs_handle()->set_numeric_values(NULL, 0);
 
 	  using namespace KokkosSparse::Impl;
 
@@ -209,6 +295,7 @@ namespace Experimental{
       scalar_nnz_view_t_ values,
       bool is_graph_symmetric = true
       ){
+	  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::block_gauss_seidel_numeric");
 	  handle->get_gs_handle()->set_block_size(block_size);
 
 	  gauss_seidel_numeric(handle,
@@ -218,6 +305,30 @@ namespace Experimental{
 	        );
   }
 
+  /// \brief Numeric phase for a CrsMatrix whose values changed in place, e.g.
+  /// through the value updates of KokkosSparse_crs_value_update.hpp. It is
+  /// skipped if it was called by this function for the same values at the
+  /// same values version (see CrsMatrix::valuesVersion()), and the symbolic
+  /// phase is only called if it was not called before: the pattern of A
+  /// must be the one of the last symbolic phase.
+  template <typename KernelHandle, typename CrsMatrixType>
+  void gauss_seidel_update_values(KernelHandle *handle,
+      const CrsMatrixType &A,
+      bool is_graph_symmetric = true){
+	  typename KernelHandle::GaussSeidelHandleType *gsHandle = handle->get_gs_handle();
+	  if (gsHandle->is_numeric_called_for(A.values.data(), A.valuesVersion())){
+	    return;
+	  }
+	  if (!gsHandle->is_symbolic_called()){
+	    gauss_seidel_symbolic(handle, A.numRows(), A.numCols(), A.graph.row_map, A.graph.entries, is_graph_symmetric);
+	  }
+	  gauss_seidel_numeric(handle, A.numRows(), A.numCols(), A.graph.row_map, A.graph.entries, A.values, is_graph_symmetric);
+	  gsHandle->set_numeric_values(A.values.data(), A.valuesVersion());
+  }
+
+  //the apply does not fence and does not allocate once gauss_seidel_numeric
+  //is called, so that its sweeps can be recorded by GraphCapture; fence
+  //before reading x_lhs_output_vec on the host.
   template <typename KernelHandle,
     typename lno_row_view_t_,
     typename lno_nnz_view_t_,
@@ -235,6 +346,7 @@ namespace Experimental{
       bool init_zero_x_vector = false,
       bool update_y_vector = true,
       int numIter = 1){
+	  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::symmetric_gauss_seidel_apply");
 
 	  static_assert (std::is_same<typename KernelHandle::const_size_type,
 			  typename lno_row_view_t_::const_value_type>::value,
@@ -318,8 +430,19 @@ namespace Experimental{
           Internal_xscalar_nnz_view_t_ nonconst_x_v (x_lhs_output_vec.data(), x_lhs_output_vec.extent(0));
           Internal_yscalar_nnz_view_t_ const_y_v (y_rhs_input_vec.data(), y_rhs_input_vec.extent(0));
 
+	  KOKKOSKERNELS_KERNEL_COUNTS("KokkosSparse::symmetric_gauss_seidel_apply",
+			  4.0 * numIter * values.extent(0) * x_lhs_output_vec.extent(1),
+			  2.0 * numIter * KokkosSparse::Impl::gauss_seidel_sweep_bytes(row_map, entries, values, x_lhs_output_vec, y_rhs_input_vec));
 	  using namespace KokkosSparse::Impl;
 
+	  if (gauss_seidel_mv_apply(&tmp_handle, num_rows, num_cols,
+			  const_a_r, const_a_l, const_a_v,
+			  x_lhs_output_vec, y_rhs_input_vec,
+			  init_zero_x_vector, update_y_vector, numIter, true, true,
+			  std::integral_constant<int, x_scalar_view_t::rank == 1 ? 1 : 2>())){
+		  return;
+	  }
+
 	  GAUSS_SEIDEL_APPLY<const_handle_type,
 	  Internal_alno_row_view_t_, Internal_alno_nnz_view_t_, Internal_ascalar_nnz_view_t_,
 	  Internal_xscalar_nnz_view_t_, Internal_yscalar_nnz_view_t_>::gauss_seidel_apply (
@@ -352,6 +475,7 @@ namespace Experimental{
       bool init_zero_x_vector = false,
       bool update_y_vector = true,
       int numIter = 1){
+	  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::symmetric_block_gauss_seidel_apply");
 	  handle->get_gs_handle()->set_block_size(block_size);
 	  symmetric_gauss_seidel_apply(handle,num_rows,num_cols,
 			  row_map,
@@ -380,6 +504,7 @@ namespace Experimental{
       bool init_zero_x_vector = false,
       bool update_y_vector = true,
       int numIter = 1){
+	  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::forward_sweep_gauss_seidel_apply");
 
 	  static_assert (std::is_same<typename KernelHandle::const_size_type,
 			  typename lno_row_view_t_::const_value_type>::value,
@@ -464,8 +589,19 @@ namespace Experimental{
 
 
 
+	  KOKKOSKERNELS_KERNEL_COUNTS("KokkosSparse::forward_sweep_gauss_seidel_apply",
+			  2.0 * numIter * values.extent(0) * x_lhs_output_vec.extent(1),
+			  numIter * KokkosSparse::Impl::gauss_seidel_sweep_bytes(row_map, entries, values, x_lhs_output_vec, y_rhs_input_vec));
 	  using namespace KokkosSparse::Impl;
 
+	  if (gauss_seidel_mv_apply(&tmp_handle, num_rows, num_cols,
+			  const_a_r, const_a_l, const_a_v,
+			  x_lhs_output_vec, y_rhs_input_vec,
+			  init_zero_x_vector, update_y_vector, numIter, true, false,
+			  std::integral_constant<int, x_scalar_view_t::rank == 1 ? 1 : 2>())){
+		  return;
+	  }
+
 	  GAUSS_SEIDEL_APPLY<const_handle_type,
 	  Internal_alno_row_view_t_, Internal_alno_nnz_view_t_, Internal_ascalar_nnz_view_t_,
 	  Internal_xscalar_nnz_view_t_, Internal_yscalar_nnz_view_t_>::gauss_seidel_apply(
@@ -499,6 +635,7 @@ namespace Experimental{
       bool init_zero_x_vector = false,
       bool update_y_vector = true,
       int numIter = 1){
+	  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::forward_sweep_block_gauss_seidel_apply");
 	  handle->get_gs_handle()->set_block_size(block_size);
 	  forward_sweep_gauss_seidel_apply(handle,num_rows,num_cols,
 			  row_map,
@@ -527,6 +664,7 @@ namespace Experimental{
       bool init_zero_x_vector = false,
       bool update_y_vector = true,
       int numIter = 1){
+	  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::backward_sweep_gauss_seidel_apply");
 
 	  static_assert (std::is_same<typename KernelHandle::const_size_type,
 			  typename lno_row_view_t_::const_value_type>::value,
@@ -609,8 +747,19 @@ namespace Experimental{
           Internal_yscalar_nnz_view_t_ const_y_v (y_rhs_input_vec.data(), y_rhs_input_vec.extent(0));
 
 
+	  KOKKOSKERNELS_KERNEL_COUNTS("KokkosSparse::backward_sweep_gauss_seidel_apply",
+			  2.0 * numIter * values.extent(0) * x_lhs_output_vec.extent(1),
+			  numIter * KokkosSparse::Impl::gauss_seidel_sweep_bytes(row_map, entries, values, x_lhs_output_vec, y_rhs_input_vec));
 	  using namespace KokkosSparse::Impl;
 
+	  if (gauss_seidel_mv_apply(&tmp_handle, num_rows, num_cols,
+			  const_a_r, const_a_l, const_a_v,
+			  x_lhs_output_vec, y_rhs_input_vec,
+			  init_zero_x_vector, update_y_vector, numIter, false, true,
+			  std::integral_constant<int, x_scalar_view_t::rank == 1 ? 1 : 2>())){
+		  return;
+	  }
+
 	  GAUSS_SEIDEL_APPLY<const_handle_type,
 	  Internal_alno_row_view_t_, Internal_alno_nnz_view_t_, Internal_ascalar_nnz_view_t_,
 	  Internal_xscalar_nnz_view_t_, Internal_yscalar_nnz_view_t_>::gauss_seidel_apply (
@@ -643,6 +792,7 @@ namespace Experimental{
       bool init_zero_x_vector = false,
       bool update_y_vector = true,
       int numIter = 1){
+	  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::backward_sweep_block_gauss_seidel_apply");
 	  handle->get_gs_handle()->set_block_size(block_size);
 	  backward_sweep_gauss_seidel_apply(handle,num_rows,num_cols,
 			  row_map,
@@ -0,0 +1,126 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_gauss_seidel_dia.hpp
+/// \brief Multicolor Gauss-Seidel for KokkosSparse::Experimental::DiaMatrix
+///
+/// The rows are colored by i % A.numColors(): no diagonal offset but 0 is a
+/// multiple of the number of colors, so the rows of a color are relaxed in
+/// parallel, with offset arithmetic instead of column indices. The coloring
+/// is a property of the matrix, and no handle is needed. The forward sweep
+/// relaxes the colors in increasing order, the backward sweep in decreasing
+/// order. omega is the SOR damping factor.
+
+#ifndef KOKKOSSPARSE_GAUSS_SEIDEL_DIA_HPP_
+#define KOKKOSSPARSE_GAUSS_SEIDEL_DIA_HPP_
+
+#include <sstream>
+#include "KokkosSparse_DiaMatrix.hpp"
+#include "KokkosSparse_gauss_seidel_dia_impl.hpp"
+
+namespace KokkosSparse{
+namespace Experimental{
+
+namespace Impl{
+  template <typename DiaMatrixType, typename x_scalar_view_t, typename y_scalar_view_t>
+  void apply_dia_gauss_seidel(
+      const DiaMatrixType &A,
+      x_scalar_view_t x, y_scalar_view_t y,
+      bool init_zero_x_vector, int numIter,
+      bool apply_forward, bool apply_backward,
+      typename x_scalar_view_t::const_value_type omega, const char *name){
+    static_assert (x_scalar_view_t::rank == 1 && y_scalar_view_t::rank == 1,
+        "KokkosSparse::dia_gauss_seidel_apply: x and y must have rank 1.");
+    if (A.numRows() != A.numCols() || x.extent(0) != size_t(A.numRows()) || y.extent(0) != size_t(A.numRows())){
+      std::ostringstream os;
+      os << "KokkosSparse::" << name << ": Dimensions do not match: "
+         << ", A: " << A.numRows() << " x " << A.numCols()
+         << ", x: " << x.extent(0)
+         << ", y: " << y.extent(0);
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+    if (A.numRows() > 0 && A.diagonalIndex() < 0){
+      std::ostringstream os;
+      os << "KokkosSparse::" << name << ": the matrix has no stored main diagonal";
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+    dia_gauss_seidel_apply(A, x, y, init_zero_x_vector, numIter, apply_forward, apply_backward, omega);
+  }
+}
+
+  /// \brief numIter symmetric (forward then backward) multicolor
+  /// Gauss-Seidel sweeps for A x = y.
+  template <typename DiaMatrixType, typename x_scalar_view_t, typename y_scalar_view_t>
+  void symmetric_dia_gauss_seidel_apply(
+      const DiaMatrixType &A,
+      x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+      bool init_zero_x_vector = false, int numIter = 1,
+      typename x_scalar_view_t::const_value_type omega = Kokkos::Details::ArithTraits<typename x_scalar_view_t::non_const_value_type>::one()){
+    Impl::apply_dia_gauss_seidel(A, x_lhs_output_vec, y_rhs_input_vec,
+        init_zero_x_vector, numIter, true, true, omega, "symmetric_dia_gauss_seidel_apply");
+  }
+
+  template <typename DiaMatrixType, typename x_scalar_view_t, typename y_scalar_view_t>
+  void forward_sweep_dia_gauss_seidel_apply(
+      const DiaMatrixType &A,
+      x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+      bool init_zero_x_vector = false, int numIter = 1,
+      typename x_scalar_view_t::const_value_type omega = Kokkos::Details::ArithTraits<typename x_scalar_view_t::non_const_value_type>::one()){
+    Impl::apply_dia_gauss_seidel(A, x_lhs_output_vec, y_rhs_input_vec,
+        init_zero_x_vector, numIter, true, false, omega, "forward_sweep_dia_gauss_seidel_apply");
+  }
+
+  template <typename DiaMatrixType, typename x_scalar_view_t, typename y_scalar_view_t>
+  void backward_sweep_dia_gauss_seidel_apply(
+      const DiaMatrixType &A,
+      x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+      bool init_zero_x_vector = false, int numIter = 1,
+      typename x_scalar_view_t::const_value_type omega = Kokkos::Details::ArithTraits<typename x_scalar_view_t::non_const_value_type>::one()){
+    Impl::apply_dia_gauss_seidel(A, x_lhs_output_vec, y_rhs_input_vec,
+        init_zero_x_vector, numIter, false, true, omega, "backward_sweep_dia_gauss_seidel_apply");
+  }
+
+}
+}
+
+#endif
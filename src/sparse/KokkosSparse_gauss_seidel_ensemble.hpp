@@ -0,0 +1,174 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_gauss_seidel_ensemble.hpp
+/// \brief Multicolor Gauss-Seidel apply for ensemble matrices, whose values
+///   are KokkosBatched SIMD vectors with one entry per ensemble member.
+///
+/// The members share the graph, so the coloring computed by
+/// gauss_seidel_symbolic on the graph is reused: call it with a handle of the
+/// member scalar type (for example double), then sweep all the members at
+/// once with the ensemble values. The forward sweep relaxes the colors in
+/// increasing order, the backward sweep in decreasing order. omega is the
+/// SOR damping factor.
+
+#ifndef KOKKOSSPARSE_GAUSS_SEIDEL_ENSEMBLE_HPP_
+#define KOKKOSSPARSE_GAUSS_SEIDEL_ENSEMBLE_HPP_
+
+#include <sstream>
+#include <type_traits>
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_gauss_seidel_ensemble_impl.hpp"
+
+namespace KokkosSparse{
+namespace Experimental{
+
+namespace Impl{
+  template <typename KernelHandle,
+            typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_nnz_view_t_,
+            typename x_scalar_view_t, typename y_scalar_view_t>
+  void apply_ensemble_gauss_seidel(
+      KernelHandle *handle,
+      typename KernelHandle::const_nnz_lno_t num_rows,
+      typename KernelHandle::const_nnz_lno_t num_cols,
+      lno_row_view_t_ row_map, lno_nnz_view_t_ entries, scalar_nnz_view_t_ values,
+      x_scalar_view_t x, y_scalar_view_t y,
+      bool init_zero_x_vector, int numIter,
+      bool apply_forward, bool apply_backward,
+      typename x_scalar_view_t::const_value_type omega, const char *name){
+    static_assert (std::is_same<typename KernelHandle::const_size_type,
+        typename lno_row_view_t_::const_value_type>::value,
+        "KokkosSparse::ensemble_gauss_seidel_apply: Size type of the matrix should be same as kernelHandle sizetype.");
+    static_assert (std::is_same<typename KernelHandle::const_nnz_lno_t,
+        typename lno_nnz_view_t_::const_value_type>::value,
+        "KokkosSparse::ensemble_gauss_seidel_apply: lno type of the matrix should be same as kernelHandle lno_t.");
+    static_assert (KokkosBatched::Experimental::is_vector<typename scalar_nnz_view_t_::non_const_value_type>::value,
+        "KokkosSparse::ensemble_gauss_seidel_apply: the matrix values must be KokkosBatched SIMD vectors.");
+    static_assert (std::is_same<typename scalar_nnz_view_t_::non_const_value_type,
+        typename x_scalar_view_t::value_type>::value &&
+        std::is_same<typename scalar_nnz_view_t_::non_const_value_type,
+        typename y_scalar_view_t::non_const_value_type>::value,
+        "KokkosSparse::ensemble_gauss_seidel_apply: x and y must have the ensemble scalar type of the matrix.");
+    static_assert (x_scalar_view_t::rank == 1 && y_scalar_view_t::rank == 1,
+        "KokkosSparse::ensemble_gauss_seidel_apply: x and y must have rank 1.");
+
+    if (num_rows != num_cols || x.extent(0) != size_t(num_rows) || y.extent(0) != size_t(num_rows)){
+      std::ostringstream os;
+      os << "KokkosSparse::" << name << ": Dimensions do not match: "
+         << ", A: " << num_rows << " x " << num_cols
+         << ", x: " << x.extent(0)
+         << ", y: " << y.extent(0);
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+    auto gsHandle = handle->get_gs_handle();
+    if (gsHandle == NULL || !gsHandle->is_symbolic_called()){
+      std::ostringstream os;
+      os << "KokkosSparse::" << name << ": call gauss_seidel_symbolic on the graph first";
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+    if (gsHandle->get_block_size() > 1){
+      std::ostringstream os;
+      os << "KokkosSparse::" << name << ": the handle was set up for block Gauss-Seidel";
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+    KokkosSparse::Impl::ensemble_gauss_seidel_apply(
+        gsHandle->get_color_xadj(), gsHandle->get_color_adj(), gsHandle->get_num_colors(),
+        row_map, entries, values, x, y,
+        init_zero_x_vector, numIter, apply_forward, apply_backward, omega);
+  }
+}
+
+  /// \brief numIter symmetric (forward then backward) multicolor
+  /// Gauss-Seidel sweeps for A x = y, for all ensemble members at once.
+  template <typename KernelHandle,
+            typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_nnz_view_t_,
+            typename x_scalar_view_t, typename y_scalar_view_t>
+  void ensemble_symmetric_gauss_seidel_apply(
+      KernelHandle *handle,
+      typename KernelHandle::const_nnz_lno_t num_rows,
+      typename KernelHandle::const_nnz_lno_t num_cols,
+      lno_row_view_t_ row_map, lno_nnz_view_t_ entries, scalar_nnz_view_t_ values,
+      x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+      bool init_zero_x_vector = false, int numIter = 1,
+      typename x_scalar_view_t::const_value_type omega = Kokkos::Details::ArithTraits<typename x_scalar_view_t::non_const_value_type>::one()){
+    Impl::apply_ensemble_gauss_seidel(handle, num_rows, num_cols, row_map, entries, values,
+        x_lhs_output_vec, y_rhs_input_vec, init_zero_x_vector, numIter, true, true, omega,
+        "ensemble_symmetric_gauss_seidel_apply");
+  }
+
+  template <typename KernelHandle,
+            typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_nnz_view_t_,
+            typename x_scalar_view_t, typename y_scalar_view_t>
+  void ensemble_forward_sweep_gauss_seidel_apply(
+      KernelHandle *handle,
+      typename KernelHandle::const_nnz_lno_t num_rows,
+      typename KernelHandle::const_nnz_lno_t num_cols,
+      lno_row_view_t_ row_map, lno_nnz_view_t_ entries, scalar_nnz_view_t_ values,
+      x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+      bool init_zero_x_vector = false, int numIter = 1,
+      typename x_scalar_view_t::const_value_type omega = Kokkos::Details::ArithTraits<typename x_scalar_view_t::non_const_value_type>::one()){
+    Impl::apply_ensemble_gauss_seidel(handle, num_rows, num_cols, row_map, entries, values,
+        x_lhs_output_vec, y_rhs_input_vec, init_zero_x_vector, numIter, true, false, omega,
+        "ensemble_forward_sweep_gauss_seidel_apply");
+  }
+
+  template <typename KernelHandle,
+            typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_nnz_view_t_,
+            typename x_scalar_view_t, typename y_scalar_view_t>
+  void ensemble_backward_sweep_gauss_seidel_apply(
+      KernelHandle *handle,
+      typename KernelHandle::const_nnz_lno_t num_rows,
+      typename KernelHandle::const_nnz_lno_t num_cols,
+      lno_row_view_t_ row_map, lno_nnz_view_t_ entries, scalar_nnz_view_t_ values,
+      x_scalar_view_t x_lhs_output_vec, y_scalar_view_t y_rhs_input_vec,
+      bool init_zero_x_vector = false, int numIter = 1,
+      typename x_scalar_view_t::const_value_type omega = Kokkos::Details::ArithTraits<typename x_scalar_view_t::non_const_value_type>::one()){
+    Impl::apply_ensemble_gauss_seidel(handle, num_rows, num_cols, row_map, entries, values,
+        x_lhs_output_vec, y_rhs_input_vec, init_zero_x_vector, numIter, false, true, omega,
+        "ensemble_backward_sweep_gauss_seidel_apply");
+  }
+
+}
+}
+
+#endif
@@ -44,13 +44,20 @@
 #include <Kokkos_MemoryTraits.hpp>
 #include <Kokkos_Core.hpp>
 #include <KokkosKernels_Utils.hpp>
+#include <KokkosKernels_MemoryFootprint.hpp>
+#include <KokkosKernels_Prefetch.hpp>
 #ifndef _GAUSSSEIDELHANDLE_HPP
 #define _GAUSSSEIDELHANDLE_HPP
 //#define VERBOSE
 
 namespace KokkosSparse{
 
-enum GSAlgorithm{GS_DEFAULT, GS_PERMUTED, GS_TEAM};
+//GS_TWOSTAGE needs no coloring: the triangular solves of the sweeps are
+//replaced with a few Jacobi sweeps on the triangular part.
+//GS_HYBRID needs no coloring either: each thread sweeps a contiguous block
+//of rows sequentially, with the values of the other blocks from the
+//previous sweep, and the sweeps are damped (SOR/SSOR).
+enum GSAlgorithm{GS_DEFAULT, GS_PERMUTED, GS_TEAM, GS_TWOSTAGE, GS_HYBRID};
 
 template <class size_type_, class lno_t_, class scalar_t_,
           class ExecutionSpace,
@@ -79,6 +86,8 @@ public:
   typedef typename Kokkos::View<nnz_scalar_t *, HandleTempMemorySpace> scalar_temp_work_view_t;
   typedef typename Kokkos::View<nnz_scalar_t *, HandlePersistentMemorySpace> scalar_persistent_work_view_t;
   typedef typename scalar_persistent_work_view_t::HostMirror scalar_persistent_work_host_view_t; //Host view type
+  //row major, so that the right hand sides of a row are contiguous for the multivector sweeps.
+  typedef typename Kokkos::View<nnz_scalar_t **, Kokkos::LayoutRight, HandlePersistentMemorySpace> scalar_persistent_work_mv_view_t;
 
   typedef typename Kokkos::View<nnz_lno_t *, HandleTempMemorySpace> nnz_lno_temp_work_view_t;
   typedef typename Kokkos::View<nnz_lno_t *, HandlePersistentMemorySpace> nnz_lno_persistent_work_view_t;
@@ -97,13 +106,25 @@ private:
   nnz_lno_persistent_work_view_t permuted_adj;
   scalar_persistent_work_view_t permuted_adj_vals;
   nnz_lno_persistent_work_view_t old_to_new_map;
+  //end of the entries with a column before the row in each permuted row,
+  //which are stored first. Empty if the rows keep the input order.
+  row_lno_persistent_work_view_t permuted_lower_end;
 
   bool called_symbolic;
   bool called_numeric;
+  //fingerprint of the pattern the symbolic phase was called for.
+  uint64_t symbolic_pattern_hash;
+  //values, and their version, the numeric phase of gauss_seidel_update_values
+  //was called for.
+  const void *numeric_values;
+  size_t numeric_values_version;
 
 
   scalar_persistent_work_view_t permuted_y_vector;
   scalar_persistent_work_view_t permuted_x_vector;
+  //permuted multivectors of the applies with more than one right hand side.
+  scalar_persistent_work_mv_view_t permuted_y_multivector;
+  scalar_persistent_work_mv_view_t permuted_x_multivector;
 
   int suggested_vector_size;
   int suggested_team_size;
@@ -113,6 +134,42 @@ private:
 
   nnz_lno_t max_nnz_input_row, num_values_in_l1, num_values_in_l2, num_big_rows;
   size_t level_1_mem, level_2_mem;
+
+  //consecutive colors with at most this many rows are swept in one launch; 0 launches each color.
+  nnz_lno_t fused_color_size;
+  //device copy of color_set_xadj, for the fused sweeps.
+  nnz_lno_persistent_work_view_t device_color_set_xadj;
+  //number of kernels launched by the sweeps of the applies.
+  size_t num_apply_launches;
+
+  //number of inner Jacobi sweeps of GS_TWOSTAGE, and its inverse diagonal and work vector.
+  int num_inner_sweeps;
+  scalar_persistent_work_view_t inverse_diagonals;
+  scalar_persistent_work_view_t inner_sweep_vector;
+
+  //SOR damping factor of GS_HYBRID, the number of its row blocks (0 for the
+  //concurrency of the execution space) and the first row of each block.
+  nnz_scalar_t damping_factor;
+  nnz_lno_t num_hybrid_blocks;
+  nnz_lno_persistent_work_view_t hybrid_block_rows;
+
+  //LU factors of the diagonal blocks of a BlockCrsMatrix, block_size x block_size
+  //row major each, for the block-row Gauss-Seidel.
+  scalar_persistent_work_view_t factored_block_diagonals;
+
+  //if true, the sweeps read the input matrix through the color sets instead of a permuted copy.
+  bool in_place;
+
+  //rows with more nonzeros than this are swept by a whole team each; 0 disables it.
+  nnz_lno_t long_row_threshold;
+  //number of long rows at the beginning of each color set.
+  nnz_lno_persistent_work_host_view_t color_set_long_rows;
+
+  //rows in the order the color sets are sorted by, empty to keep the coloring order.
+  nnz_lno_persistent_work_view_t row_order;
+
+  //bytes the handle may hold, 0 for no limit.
+  size_t memory_budget;
   public:
 
   /**
@@ -122,10 +179,18 @@ private:
     owner_of_coloring(false),
     algorithm_type(gs),
     color_set_xadj(), color_sets(), numColors(0),
-    permuted_xadj(),  permuted_adj(), permuted_adj_vals(), old_to_new_map(),
-    called_symbolic(false), called_numeric(false), permuted_y_vector(), permuted_x_vector(),
+    permuted_xadj(),  permuted_adj(), permuted_adj_vals(), old_to_new_map(), permuted_lower_end(),
+    called_symbolic(false), called_numeric(false), symbolic_pattern_hash(0),
+    numeric_values(NULL), numeric_values_version(0), permuted_y_vector(), permuted_x_vector(),
+    permuted_y_multivector(), permuted_x_multivector(),
     suggested_vector_size(0), suggested_team_size(0), permuted_diagonals(), block_size(1), max_nnz_input_row(-1),
-	num_values_in_l1(-1), num_values_in_l2(-1),num_big_rows(0), level_1_mem(0), level_2_mem(0)
+	num_values_in_l1(-1), num_values_in_l2(-1),num_big_rows(0), level_1_mem(0), level_2_mem(0),
+    fused_color_size(0), device_color_set_xadj(), num_apply_launches(0),
+    num_inner_sweeps(1), inverse_diagonals(), inner_sweep_vector(),
+    damping_factor(Kokkos::Details::ArithTraits<nnz_scalar_t>::one()), num_hybrid_blocks(0), hybrid_block_rows(),
+    factored_block_diagonals(), in_place(false),
+    long_row_threshold(0), color_set_long_rows(), row_order(),
+    memory_budget(0)
     {
     if (gs == GS_DEFAULT){
       this->choose_default_algorithm();
@@ -214,20 +279,171 @@ private:
   nnz_lno_persistent_work_view_t get_old_to_new_map() {
     return this->old_to_new_map;
   }
+  row_lno_persistent_work_view_t get_permuted_lower_end() {
+    return this->permuted_lower_end;
+  }
 
   bool is_symbolic_called(){return this->called_symbolic;}
+  /**
+   * \brief True if the symbolic phase was called for a pattern with the
+   * given fingerprint (see KokkosKernels::Impl::kk_hash_graph).
+   */
+  bool is_symbolic_called_for(uint64_t pattern_hash){
+    return this->called_symbolic && this->symbolic_pattern_hash == pattern_hash;
+  }
+  uint64_t get_symbolic_pattern_hash(){return this->symbolic_pattern_hash;}
   bool is_numeric_called(){return this->called_numeric;}
+  /**
+   * \brief True if the numeric phase was called for these values at this
+   * values version (see KokkosSparse::CrsMatrix::valuesVersion()).
+   */
+  bool is_numeric_called_for(const void *values_, size_t values_version_){
+    return this->called_numeric && this->numeric_values != NULL &&
+        this->numeric_values == values_ && this->numeric_values_version == values_version_;
+  }
 
   //setters
   void set_algorithm_type(const GSAlgorithm &sgs_algo){this->algorithm_type = sgs_algo;}
   void set_owner_of_coloring(bool owner = true){this->owner_of_coloring = owner;}
 
   void set_call_symbolic(bool call = true){this->called_symbolic = call;}
+  void set_symbolic_pattern_hash(uint64_t pattern_hash){this->symbolic_pattern_hash = pattern_hash;}
   void set_call_numeric(bool call = true){this->called_numeric = call;}
+  void set_numeric_values(const void *values_, size_t values_version_){
+    this->numeric_values = values_;
+    this->numeric_values_version = values_version_;
+  }
 
   void set_color_set_xadj(const nnz_lno_persistent_work_host_view_t &color_set_xadj_) {
     this->color_set_xadj = color_set_xadj_;
   }
+  void set_device_color_set_xadj(const nnz_lno_persistent_work_view_t &color_set_xadj_) {
+    this->device_color_set_xadj = color_set_xadj_;
+  }
+  nnz_lno_persistent_work_view_t get_device_color_xadj() {
+    return this->device_color_set_xadj;
+  }
+
+  /**
+   * \brief sets the number of rows up to which consecutive colors are swept
+   * in a single launch: one team runs the colors one after the other, with a
+   * barrier in between. This saves the launches of the small colors, at the
+   * price of running them on one team. 0, the default, launches each color.
+   * Only used with block size 1.
+   */
+  void set_fused_color_size(nnz_lno_t fused_color_size_){this->fused_color_size = fused_color_size_;}
+  nnz_lno_t get_fused_color_size() const {return this->fused_color_size;}
+
+  /**
+   * \brief sets the in place mode. The symbolic phase then keeps only the
+   * color sets, and the sweeps read the rows of the matrix given to the
+   * numeric phase and the applies through them, in the order of the input
+   * vectors. No permuted copy of the matrix or of the vectors is stored, at
+   * the price of indirect accesses in the sweeps. The matrix must not change
+   * between the numeric phase and the applies. Only used with block size 1.
+   */
+  void set_in_place(bool in_place_ = true){this->in_place = in_place_;}
+  bool is_in_place() const {return this->in_place;}
+
+  /**
+   * \brief sets the row length above which the team sweeps give a whole team
+   * to a row, with a vector reduction over its nonzeros. The symbolic phase
+   * moves these rows to the beginning of their color, and the other rows are
+   * still packed one per thread. 0, the default, disables it.
+   * Only used with block size 1 and the team algorithm.
+   */
+  void set_long_row_threshold(nnz_lno_t long_row_threshold_){this->long_row_threshold = long_row_threshold_;}
+  nnz_lno_t get_long_row_threshold() const {return this->long_row_threshold;}
+
+  void set_color_set_long_rows(const nnz_lno_persistent_work_host_view_t &color_set_long_rows_){
+    this->color_set_long_rows = color_set_long_rows_;
+  }
+  nnz_lno_persistent_work_host_view_t get_color_set_long_rows() const {return this->color_set_long_rows;}
+
+  /**
+   * \brief sets an order of the rows, row_order_(k) being the k-th row, e.g.
+   * the order of KokkosGraph::graph_row_cluster_order. The symbolic phase sorts
+   * the rows of each color by their position in it, so that the rows swept
+   * together, and the rows of the permuted matrix, are close in the graph.
+   * An empty view, the default, keeps the order of the coloring.
+   */
+  void set_row_order(const nnz_lno_persistent_work_view_t &row_order_){this->row_order = row_order_;}
+  nnz_lno_persistent_work_view_t get_row_order() const {return this->row_order;}
+
+  size_t get_num_apply_launches() const {return this->num_apply_launches;}
+
+  /**
+   * \brief sets the bytes the handle may hold, 0 (the default) for no limit.
+   * If the permuted copy of the matrix and of the vectors made by the
+   * symbolic phase would not fit, the handle switches to the in place mode.
+   */
+  void set_memory_budget(size_t memory_budget_){this->memory_budget = memory_budget_;}
+  size_t get_memory_budget() const {return this->memory_budget;}
+
+  /**
+   * \brief calls visitor.add_persistent for each view the handle keeps: the
+   * coloring, the permuted matrix, diagonals and vectors.
+   */
+  template <typename visitor_t>
+  void visit_views(visitor_t &visitor) const {
+    visitor.add_persistent(this->color_set_xadj);
+    visitor.add_persistent(this->color_sets);
+    visitor.add_persistent(this->permuted_xadj);
+    visitor.add_persistent(this->permuted_adj);
+    visitor.add_persistent(this->permuted_adj_vals);
+    visitor.add_persistent(this->old_to_new_map);
+    visitor.add_persistent(this->permuted_lower_end);
+    visitor.add_persistent(this->permuted_y_vector);
+    visitor.add_persistent(this->permuted_x_vector);
+    visitor.add_persistent(this->permuted_y_multivector);
+    visitor.add_persistent(this->permuted_x_multivector);
+    visitor.add_persistent(this->permuted_diagonals);
+    visitor.add_persistent(this->device_color_set_xadj);
+    visitor.add_persistent(this->inverse_diagonals);
+    visitor.add_persistent(this->inner_sweep_vector);
+    visitor.add_persistent(this->hybrid_block_rows);
+    visitor.add_persistent(this->factored_block_diagonals);
+    visitor.add_persistent(this->color_set_long_rows);
+    visitor.add_persistent(this->row_order);
+  }
+
+  /**
+   * \brief returns the bytes of the views the handle keeps: the coloring, the
+   * permuted matrix, diagonals and vectors.
+   */
+  KokkosKernels::MemoryFootprint get_memory_footprint() const {
+    KokkosKernels::MemoryFootprint footprint;
+    this->visit_views(footprint);
+    return footprint;
+  }
+
+  /**
+   * \brief prefetches the views kept by the handle to the device of exec, when
+   * they are in unified memory.
+   */
+  template <typename exec_space>
+  void prefetch(const exec_space &exec) const {
+    KokkosKernels::Impl::MemoryPrefetch<exec_space> prefetcher(exec);
+    this->visit_views(prefetcher);
+  }
+
+  /**
+   * \brief switches to the in place mode if the permuted copy of a
+   * num_rows x num_cols matrix with nnz entries, and of the vectors,
+   * does not fit into the memory budget. Only used with block size 1.
+   */
+  void fit_into_memory_budget(nnz_lno_t num_rows, nnz_lno_t num_cols, size_type nnz){
+    if (this->in_place || this->block_size != 1) return;
+    const size_t copy_bytes =
+        (num_rows + 1) * sizeof(size_type) + nnz * (sizeof(nnz_lno_t) + sizeof(nnz_scalar_t)) +
+        num_rows * sizeof(nnz_lno_t) + (num_rows + num_cols) * sizeof(nnz_scalar_t);
+    if (!KokkosKernels::Impl::kk_fits_memory_budget(this->memory_budget, this->get_memory_footprint(), copy_bytes)){
+      this->in_place = true;
+    }
+  }
+  void add_num_apply_launches(size_t launches){this->num_apply_launches += launches;}
+  void reset_num_apply_launches(){this->num_apply_launches = 0;}
+
   void set_color_set_adj(const nnz_lno_persistent_work_view_t &color_sets_) {
     this->color_sets = color_sets_;
   }
@@ -247,6 +463,9 @@ private:
   void set_old_to_new_map(const nnz_lno_persistent_work_view_t &old_to_new_map_) {
     this->old_to_new_map = old_to_new_map_;
   }
+  void set_permuted_lower_end(const row_lno_persistent_work_view_t &permuted_lower_end_) {
+    this->permuted_lower_end = permuted_lower_end_;
+  }
   void set_permuted_diagonals (const scalar_persistent_work_view_t permuted_diagonals_){
     this->permuted_diagonals = permuted_diagonals_;
   }
@@ -311,8 +530,68 @@ private:
     }
   }
 
+  void allocate_x_y_multivectors(nnz_lno_t num_rows, nnz_lno_t num_cols, nnz_lno_t num_vectors){
+    if(permuted_y_multivector.extent(0) != size_t(num_rows) || permuted_y_multivector.extent(1) != size_t(num_vectors)){
+      permuted_y_multivector = scalar_persistent_work_mv_view_t("PERMUTED Y MULTIVECTOR", num_rows, num_vectors);
+    }
+    if(permuted_x_multivector.extent(0) != size_t(num_cols) || permuted_x_multivector.extent(1) != size_t(num_vectors)){
+      permuted_x_multivector = scalar_persistent_work_mv_view_t("PERMUTED X MULTIVECTOR", num_cols, num_vectors);
+    }
+  }
+
+  void allocate_inner_sweep_vector(nnz_lno_t num_rows){
+    if(inner_sweep_vector.extent(0) != size_t(num_rows)){
+      inner_sweep_vector = scalar_persistent_work_view_t("INNER SWEEP VECTOR", num_rows);
+    }
+  }
+
+  /**
+   * \brief sets the number of Jacobi sweeps that approximate each
+   * triangular solve of GS_TWOSTAGE. 0 makes the sweeps Jacobi sweeps.
+   */
+  void set_num_inner_sweeps(int num_inner_sweeps_){this->num_inner_sweeps = num_inner_sweeps_;}
+  int get_num_inner_sweeps() const {return this->num_inner_sweeps;}
+
+  /**
+   * \brief sets the damping factor omega of the GS_HYBRID sweeps,
+   * x_i = (1 - omega) x_i + omega x_i^{GS}. 1 is Gauss-Seidel, and the
+   * symmetric applies are SSOR.
+   */
+  void set_damping_factor(nnz_scalar_t damping_factor_){this->damping_factor = damping_factor_;}
+  nnz_scalar_t get_damping_factor() const {return this->damping_factor;}
+
+  /**
+   * \brief sets the number of contiguous row blocks GS_HYBRID sweeps in
+   * parallel, 0 for the concurrency of the execution space. More blocks
+   * read more values from the previous sweep. Resets the symbolic phase.
+   */
+  void set_num_hybrid_blocks(nnz_lno_t num_hybrid_blocks_){
+    this->num_hybrid_blocks = num_hybrid_blocks_;
+    this->called_symbolic = false;
+    this->called_numeric = false;
+  }
+  nnz_lno_t get_num_hybrid_blocks() const {return this->num_hybrid_blocks;}
+
+  void set_hybrid_block_rows(const nnz_lno_persistent_work_view_t hybrid_block_rows_){
+    this->hybrid_block_rows = hybrid_block_rows_;
+  }
+  nnz_lno_persistent_work_view_t get_hybrid_block_rows(){return this->hybrid_block_rows;}
+
+  void set_inverse_diagonals(const scalar_persistent_work_view_t inverse_diagonals_){
+    this->inverse_diagonals = inverse_diagonals_;
+  }
+  scalar_persistent_work_view_t get_inverse_diagonals (){return this->inverse_diagonals;}
+
+  void set_factored_block_diagonals(const scalar_persistent_work_view_t factored_block_diagonals_){
+    this->factored_block_diagonals = factored_block_diagonals_;
+  }
+  scalar_persistent_work_view_t get_factored_block_diagonals(){return this->factored_block_diagonals;}
+  scalar_persistent_work_view_t get_inner_sweep_vector (){return this->inner_sweep_vector;}
+
   scalar_persistent_work_view_t get_permuted_y_vector (){return this->permuted_y_vector;}
   scalar_persistent_work_view_t get_permuted_x_vector (){return this->permuted_x_vector;}
+  scalar_persistent_work_mv_view_t get_permuted_y_multivector (){return this->permuted_y_multivector;}
+  scalar_persistent_work_mv_view_t get_permuted_x_multivector (){return this->permuted_x_multivector;}
   void vector_team_size(
       int max_allowed_team_size,
       int &suggested_vector_size_,
@@ -0,0 +1,135 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_jacobi.hpp
+/// \brief Damped and l1 Jacobi smoothers for a CrsMatrix.
+
+#ifndef KOKKOSSPARSE_JACOBI_HPP_
+#define KOKKOSSPARSE_JACOBI_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_diagonal.hpp"
+#include "KokkosSparse_getDiagCopy.hpp"
+#include "KokkosSparse_jacobi_handle.hpp"
+#include "KokkosSparse_jacobi_impl.hpp"
+
+namespace KokkosSparse {
+
+/// \brief Prepares handle to smooth with A: copies the diagonal of A
+///   through the diagonal offsets kept in the handle, adds the row sums
+///   of the off-diagonal magnitudes for JACOBI_L1, and keeps its inverse.
+///
+/// Call it again when the values of A change; the offsets are reused
+/// as long as the pattern of A is the same.
+///
+/// \param handle [in/out] The handle; its ordinal, size and scalar types
+///   must be those of A.
+/// \param A [in] The square sparse matrix.
+template<class HandleType, class AMatrix>
+void
+jacobi_setup (HandleType& handle, const AMatrix& A)
+{
+  static_assert (std::is_same<typename AMatrix::non_const_size_type, typename HandleType::size_type>::value &&
+                 std::is_same<typename AMatrix::non_const_ordinal_type, typename HandleType::nnz_lno_t>::value &&
+                 std::is_same<typename AMatrix::non_const_value_type, typename HandleType::nnz_scalar_t>::value,
+                 "KokkosSparse::jacobi_setup: The handle and the matrix must have the same ordinal, size and scalar types.");
+  typedef typename HandleType::scalar_view_t scalar_view_t;
+
+  if (A.numRows () != A.numCols ()) {
+    std::ostringstream os;
+    os << "KokkosSparse::jacobi_setup: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols ();
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  scalar_view_t inv_diag (Kokkos::ViewAllocateWithoutInitializing ("Jacobi inverse diagonal"), A.numRows ());
+  scalar_view_t work_x (Kokkos::ViewAllocateWithoutInitializing ("Jacobi iterate"), A.numRows ());
+  getDiagCopy (inv_diag, get_diagonal_offsets (handle.get_diagonal_handle (), A), A);
+  Impl::jacobi_inverse_diagonal (A, inv_diag, handle.get_algorithm_type () == JACOBI_L1);
+  handle.set_work_views (inv_diag, work_x);
+  handle.set_call_setup ();
+}
+
+/// \brief Smooths x for A x = b with num_sweeps Jacobi sweeps
+///   x += omega D^{-1} (b - A x).
+///
+/// Each sweep is a single pass over the rows of A, which computes the
+/// residual of a row and updates its entry of x together, with no
+/// separate spmv and vector update.
+///
+/// \param handle [in] The handle, set up with jacobi_setup for A.
+/// \param A [in] The sparse matrix.
+/// \param x [in/out] 1-D view, the approximate solution.
+/// \param b [in] 1-D view, the right hand side.
+/// \param num_sweeps [in] The number of sweeps.
+/// \param zero_initial_guess [in] If true, x is taken as zero on input,
+///   and the first sweep does not read A.
+template<class HandleType, class AMatrix, class XVector, class BVector>
+void
+jacobi_apply (const HandleType& handle, const AMatrix& A,
+              const XVector& x, const BVector& b,
+              const int num_sweeps = 1,
+              const bool zero_initial_guess = false)
+{
+  static_assert (static_cast<int> (XVector::rank) == 1 && static_cast<int> (BVector::rank) == 1,
+                 "KokkosSparse::jacobi_apply: x and b must be 1-D Kokkos::Views.");
+  if (!handle.is_setup_called () ||
+      static_cast<size_t> (handle.get_inv_diag ().extent (0)) != static_cast<size_t> (A.numRows ()) ||
+      static_cast<size_t> (x.extent (0)) != static_cast<size_t> (A.numCols ()) ||
+      static_cast<size_t> (b.extent (0)) != static_cast<size_t> (A.numRows ())) {
+    std::ostringstream os;
+    os << "KokkosSparse::jacobi_apply: Dimensions do not match, or the handle is not set up: "
+       << ", A: " << A.numRows () << " x " << A.numCols ()
+       << ", x: " << x.extent (0)
+       << ", b: " << b.extent (0)
+       << ", handle: " << handle.get_inv_diag ().extent (0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  Impl::jacobi_apply (handle, A, x, b, num_sweeps, zero_initial_guess);
+}
+
+}
+
+#endif
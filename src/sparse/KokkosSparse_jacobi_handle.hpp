@@ -0,0 +1,113 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosSparse_diagonal_handle.hpp"
+
+#ifndef _KOKKOSSPARSE_JACOBI_HANDLE_HPP
+#define _KOKKOSSPARSE_JACOBI_HANDLE_HPP
+
+namespace KokkosSparse{
+
+enum JacobiAlgorithm {JACOBI_DAMPED, JACOBI_L1};
+
+/**
+ * \brief Parameters and state of a Jacobi smoother x += omega D^{-1} (b - A x).
+ * With JACOBI_DAMPED, D is the diagonal of A; with JACOBI_L1, each entry of
+ * D also adds the magnitudes of the off-diagonal entries of its row, which
+ * makes the sweeps convergent for symmetric positive definite matrices with
+ * omega = 1. jacobi_setup keeps the inverse of D, found through the
+ * diagonal offsets of A, and the work vector of the sweeps.
+ */
+template <class lno_t_, class size_type_, class scalar_t_, class ExecutionSpace>
+class JacobiHandle{
+public:
+  typedef lno_t_ nnz_lno_t;
+  typedef size_type_ size_type;
+  typedef scalar_t_ nnz_scalar_t;
+  typedef ExecutionSpace execution_space;
+
+  typedef Kokkos::View<nnz_scalar_t *, execution_space> scalar_view_t;
+  typedef DiagonalHandle<nnz_lno_t, size_type, execution_space> diagonal_handle_t;
+
+private:
+  JacobiAlgorithm algorithm_type;
+  nnz_scalar_t damping_factor;
+  bool called_setup;
+
+  diagonal_handle_t diagonal_handle;
+  scalar_view_t inv_diag;
+  //the other iterate of the sweeps.
+  scalar_view_t work_x;
+
+public:
+  /**
+   * \brief constructor.
+   * \param algorithm_: JACOBI_DAMPED, with omega = 2/3 by default, or
+   * JACOBI_L1, with omega = 1.
+   */
+  JacobiHandle(JacobiAlgorithm algorithm_ = JACOBI_DAMPED):
+    algorithm_type(algorithm_),
+    damping_factor(algorithm_ == JACOBI_L1 ? nnz_scalar_t(1) : nnz_scalar_t(2) / nnz_scalar_t(3)),
+    called_setup(false), diagonal_handle(), inv_diag(), work_x(){}
+
+  JacobiAlgorithm get_algorithm_type() const {return this->algorithm_type;}
+  nnz_scalar_t get_damping_factor() const {return this->damping_factor;}
+  bool is_setup_called() const {return this->called_setup;}
+
+  void set_damping_factor(nnz_scalar_t damping_factor_){this->damping_factor = damping_factor_;}
+  void set_call_setup(bool call = true){this->called_setup = call;}
+
+  diagonal_handle_t &get_diagonal_handle(){return this->diagonal_handle;}
+
+  void set_work_views(scalar_view_t inv_diag_, scalar_view_t work_x_){
+    this->inv_diag = inv_diag_;
+    this->work_x = work_x_;
+  }
+  scalar_view_t get_inv_diag() const {return this->inv_diag;}
+  scalar_view_t get_work_x() const {return this->work_x;}
+};
+
+}
+
+#endif
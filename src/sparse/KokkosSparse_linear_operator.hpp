@@ -0,0 +1,206 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_linear_operator.hpp
+/// \brief Linear operators: a CrsMatrix or a matrix-free operator, as
+///   accepted by the Chebyshev smoother and the CG solvers.
+///
+/// A matrix-free operator is any class with
+///
+///   typedef ... execution_space, non_const_value_type,
+///               non_const_ordinal_type, non_const_size_type;
+///   non_const_ordinal_type numRows () const;
+///   non_const_ordinal_type numCols () const;
+///   // y = A x, y with numRows() and x with at least numCols() entries
+///   template<class XVector, class YVector>
+///   void apply (const XVector& x, const YVector& y) const;
+///   // d = diag(A), d with numRows() entries
+///   template<class DVector>
+///   void diagonal (const DVector& d) const;
+///
+/// and optionally, for block preconditioners,
+///
+///   int block_size () const;
+///   // D(k,i,j) = A(k*bs+i, k*bs+j), D with numRows()/bs blocks
+///   template<class DView>
+///   void block_diagonal (const DView& D) const;
+///
+/// The functions below call spmv and the diagonal handle for a CrsMatrix,
+/// and apply or diagonal followed by vector updates for an operator, so
+/// that algorithms written with them take either.
+
+#ifndef KOKKOSSPARSE_LINEAR_OPERATOR_HPP_
+#define KOKKOSSPARSE_LINEAR_OPERATOR_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <type_traits>
+#include "KokkosBlas1_axpby.hpp"
+#include "KokkosBlas1_dot.hpp"
+#include "KokkosBlas1_reciprocal.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_diagonal.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosSparse_spmv_dot.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \brief True if AMatrix is a KokkosSparse::CrsMatrix, false for a
+///   matrix-free operator.
+template<class AMatrix>
+struct is_crs_matrix : public std::false_type {};
+
+template<class ScalarType, class OrdinalType, class Device, class MemoryTraits, class SizeType>
+struct is_crs_matrix<CrsMatrix<ScalarType, OrdinalType, Device, MemoryTraits, SizeType> > : public std::true_type {};
+
+template<class AMatrix>
+struct is_crs_matrix<const AMatrix> : public is_crs_matrix<AMatrix> {};
+
+namespace Impl {
+
+template<class AMatrix, class XVector, class YVector>
+void operator_apply (const AMatrix& A, const XVector& x, const YVector& y, std::true_type)
+{
+  typedef typename AMatrix::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  KokkosSparse::spmv ("N", ATS::one (), A, x, ATS::zero (), y);
+}
+
+template<class AMatrix, class XVector, class YVector>
+void operator_apply (const AMatrix& A, const XVector& x, const YVector& y, std::false_type)
+{
+  A.apply (x, y);
+}
+
+template<class AMatrix, class XVector, class BVector, class RVector>
+void operator_residual (const AMatrix& A, const XVector& x, const BVector& b, const RVector& r, std::true_type)
+{
+  typedef typename AMatrix::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  Kokkos::deep_copy (r, b);
+  KokkosSparse::spmv ("N", -ATS::one (), A, x, ATS::one (), r);
+}
+
+template<class AMatrix, class XVector, class BVector, class RVector>
+void operator_residual (const AMatrix& A, const XVector& x, const BVector& b, const RVector& r, std::false_type)
+{
+  typedef typename AMatrix::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  A.apply (x, r);
+  KokkosBlas::axpby (ATS::one (), b, -ATS::one (), r);
+}
+
+template<class AMatrix, class XVector, class YVector, class WVector>
+typename Kokkos::Details::InnerProductSpaceTraits<typename WVector::non_const_value_type>::dot_type
+operator_apply_dot (const AMatrix& A, const XVector& x, const YVector& y, const WVector& w, std::true_type)
+{
+  typedef typename AMatrix::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  return KokkosSparse::Experimental::spmv_axpby_dot ("N", ATS::one (), A, x, ATS::zero (), y, w);
+}
+
+template<class AMatrix, class XVector, class YVector, class WVector>
+typename Kokkos::Details::InnerProductSpaceTraits<typename WVector::non_const_value_type>::dot_type
+operator_apply_dot (const AMatrix& A, const XVector& x, const YVector& y, const WVector& w, std::false_type)
+{
+  A.apply (x, y);
+  return KokkosBlas::dot (w, y);
+}
+
+template<class HandleType, class AMatrix, class DiagType>
+void operator_inverse_diagonal (HandleType& handle, const AMatrix& A, const DiagType& inv_diag, std::true_type)
+{
+  KokkosSparse::get_inverse_diagonal (handle, A, inv_diag);
+}
+
+template<class HandleType, class AMatrix, class DiagType>
+void operator_inverse_diagonal (HandleType& /* handle */, const AMatrix& A, const DiagType& inv_diag, std::false_type)
+{
+  A.diagonal (inv_diag);
+  KokkosBlas::reciprocal (inv_diag, inv_diag);
+}
+
+}
+
+/// \brief y = A x for a CrsMatrix or a matrix-free operator A.
+template<class AMatrix, class XVector, class YVector>
+void
+operator_apply (const AMatrix& A, const XVector& x, const YVector& y)
+{
+  Impl::operator_apply (A, x, y, is_crs_matrix<AMatrix> ());
+}
+
+/// \brief r = b - A x; one spmv with beta = 1 for a CrsMatrix, an apply
+///   and an axpby for an operator.
+template<class AMatrix, class XVector, class BVector, class RVector>
+void
+operator_residual (const AMatrix& A, const XVector& x, const BVector& b, const RVector& r)
+{
+  Impl::operator_residual (A, x, b, r, is_crs_matrix<AMatrix> ());
+}
+
+/// \brief y = A x and returns dot(w, y); fused with spmv_axpby_dot for a
+///   CrsMatrix, an apply and a dot for an operator.
+template<class AMatrix, class XVector, class YVector, class WVector>
+typename Kokkos::Details::InnerProductSpaceTraits<typename WVector::non_const_value_type>::dot_type
+operator_apply_dot (const AMatrix& A, const XVector& x, const YVector& y, const WVector& w)
+{
+  return Impl::operator_apply_dot (A, x, y, w, is_crs_matrix<AMatrix> ());
+}
+
+/// \brief inv_diag = 1 / diag(A). For a CrsMatrix the diagonal offsets
+///   are kept in handle, a KokkosSparse::DiagonalHandle, as in
+///   get_inverse_diagonal; an operator computes its diagonal itself and
+///   the handle is not used. The diagonal of an operator must not have
+///   zeros.
+template<class HandleType, class AMatrix, class DiagType>
+void
+operator_inverse_diagonal (HandleType& handle, const AMatrix& A, const DiagType& inv_diag)
+{
+  Impl::operator_inverse_diagonal (handle, A, inv_diag, is_crs_matrix<AMatrix> ());
+}
+
+}
+}
+
+#endif
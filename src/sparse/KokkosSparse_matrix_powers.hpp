@@ -0,0 +1,150 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_matrix_powers.hpp
+/// \brief Matrix powers kernel for s-step Krylov methods
+///
+/// Computes the Krylov basis V = [v_0, v_1, ..., v_s] of a square CrsMatrix A
+/// and a vector x, with v_0 = x and one of the recurrences
+///   monomial:  v_k = A v_{k-1}
+///   Newton:    v_k = (A - theta_k I) v_{k-1}
+///   Chebyshev: v_k = 2 (A - c I) v_{k-1} / h - v_{k-2}, v_1 = (A - c I) v_0 / h
+/// in the columns 0..s of the rank 2 View V. When a block of rows with its
+/// 2 s bandwidth ghost rows fits the team scratch, each team computes all
+/// the levels of its block while the rows stay in cache, so that A is read
+/// from memory about once instead of s times; otherwise each level is a spmv.
+/// The bandwidth max |j - i| of A is computed on each call unless it is
+/// given, see matrix_bandwidth.
+
+#ifndef KOKKOSSPARSE_MATRIX_POWERS_HPP_
+#define KOKKOSSPARSE_MATRIX_POWERS_HPP_
+
+#include <sstream>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_matrix_powers_impl.hpp"
+
+namespace KokkosSparse{
+
+namespace Impl{
+  template <typename AMatrix, typename XVector, typename VMatrix, typename HostCoefficientView>
+  void apply_matrix_powers(const AMatrix &A, const XVector &x, const VMatrix &V,
+      const HostCoefficientView &alpha, const HostCoefficientView &theta, const HostCoefficientView &beta,
+      typename AMatrix::non_const_ordinal_type bandwidth){
+    static_assert (XVector::rank == 1 && VMatrix::rank == 2,
+        "KokkosSparse::matrix_powers: x must have rank 1 and V rank 2.");
+    if (A.numRows() != A.numCols() || x.extent(0) != size_t(A.numRows()) ||
+        V.extent(0) != size_t(A.numRows()) || V.extent(1) < 1){
+      std::ostringstream os;
+      os << "KokkosSparse::matrix_powers: Dimensions do not match: "
+         << ", A: " << A.numRows() << " x " << A.numCols()
+         << ", x: " << x.extent(0)
+         << ", V: " << V.extent(0) << " x " << V.extent(1);
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+    Impl::matrix_powers(A, x, V, static_cast<int>(V.extent(1)) - 1, alpha, theta, beta, bandwidth);
+  }
+
+  template <typename VMatrix>
+  struct MatrixPowersCoefficients{
+    typedef typename VMatrix::non_const_value_type v_value_type;
+    typedef Kokkos::View<v_value_type*, Kokkos::HostSpace> host_view_t;
+    host_view_t alpha, theta, beta;
+
+    MatrixPowersCoefficients(const VMatrix &V):
+      alpha("matrix_powers alpha", V.extent(1)), theta("matrix_powers theta", V.extent(1)),
+      beta("matrix_powers beta", V.extent(1)){
+      Kokkos::deep_copy(alpha, Kokkos::Details::ArithTraits<v_value_type>::one());
+    }
+  };
+}
+
+  /// \brief max |j - i| over the entries (i, j) of A, for the bandwidth
+  /// argument of the matrix powers kernels when A is reused.
+  template <typename AMatrix>
+  typename AMatrix::non_const_ordinal_type matrix_bandwidth(const AMatrix &A){
+    return Impl::matrix_bandwidth(A);
+  }
+
+  /// \brief The monomial basis [x, A x, ..., A^s x], with s = V.extent(1) - 1.
+  template <typename AMatrix, typename XVector, typename VMatrix>
+  void matrix_powers(const AMatrix &A, const XVector &x, const VMatrix &V,
+      typename AMatrix::non_const_ordinal_type bandwidth = -1){
+    Impl::MatrixPowersCoefficients<VMatrix> c(V);
+    Impl::apply_matrix_powers(A, x, V, c.alpha, c.theta, c.beta, bandwidth);
+  }
+
+  /// \brief The Newton basis, with v_k = (A - shifts(k-1) I) v_{k-1}. The
+  /// shifts are usually Leja ordered Ritz values of A. shifts is a rank 1
+  /// View with at least s = V.extent(1) - 1 entries, in any memory space.
+  template <typename AMatrix, typename XVector, typename VMatrix, typename ShiftView>
+  void matrix_powers_newton(const AMatrix &A, const XVector &x, const VMatrix &V,
+      const ShiftView &shifts, typename AMatrix::non_const_ordinal_type bandwidth = -1){
+    const size_t s = V.extent(1) > 0 ? V.extent(1) - 1 : 0;
+    if (shifts.extent(0) < s){
+      std::ostringstream os;
+      os << "KokkosSparse::matrix_powers_newton: " << s << " shifts are needed, "
+         << shifts.extent(0) << " are given";
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+    Impl::MatrixPowersCoefficients<VMatrix> c(V);
+    typename ShiftView::HostMirror h_shifts = Kokkos::create_mirror_view(shifts);
+    Kokkos::deep_copy(h_shifts, shifts);
+    for (size_t k = 1; k <= s; ++k) c.theta(k) = h_shifts(k - 1);
+    Impl::apply_matrix_powers(A, x, V, c.alpha, c.theta, c.beta, bandwidth);
+  }
+
+  /// \brief The Chebyshev basis of the interval [center - half_width,
+  /// center + half_width], which should contain the spectrum of A.
+  template <typename AMatrix, typename XVector, typename VMatrix>
+  void matrix_powers_chebyshev(const AMatrix &A, const XVector &x, const VMatrix &V,
+      typename VMatrix::const_value_type center, typename VMatrix::const_value_type half_width,
+      typename AMatrix::non_const_ordinal_type bandwidth = -1){
+    Impl::MatrixPowersCoefficients<VMatrix> c(V);
+    Impl::matrix_powers_chebyshev_coefficients(c.alpha, c.theta, c.beta,
+        static_cast<int>(V.extent(1)) - 1, center, half_width);
+    Impl::apply_matrix_powers(A, x, V, c.alpha, c.theta, c.beta, bandwidth);
+  }
+
+}
+
+#endif
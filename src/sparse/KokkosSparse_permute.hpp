@@ -0,0 +1,272 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_permute.hpp
+/// \brief Symmetric permutation of a CrsMatrix and permutation of vectors,
+///   to apply an ordering such as KokkosGraph::Experimental::graph_rcm.
+
+#ifndef KOKKOS_SPARSE_PERMUTE_HPP_
+#define KOKKOS_SPARSE_PERMUTE_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+
+namespace KokkosSparse {
+
+namespace Experimental {
+
+namespace Impl {
+
+// Length of each row of the permuted matrix, at the row after it.
+template<class CrsMatrixType, class PermViewType>
+struct PermuteCrsCountFunctor {
+  typedef typename CrsMatrixType::ordinal_type ordinal_type;
+
+  CrsMatrixType A;
+  PermViewType old_to_new;
+  typename CrsMatrixType::row_map_type::non_const_type row_map;
+
+  PermuteCrsCountFunctor (const CrsMatrixType& A_, const PermViewType& old_to_new_,
+                          const typename CrsMatrixType::row_map_type::non_const_type& row_map_) :
+    A (A_), old_to_new (old_to_new_), row_map (row_map_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    row_map(old_to_new(i)) = A.graph.row_map(i + 1) - A.graph.row_map(i);
+  }
+};
+
+// Entries of each permuted row, sorted by permuted column.
+template<class CrsMatrixType, class PermViewType>
+struct PermuteCrsFillFunctor {
+  typedef typename CrsMatrixType::ordinal_type ordinal_type;
+  typedef typename CrsMatrixType::size_type size_type;
+  typedef typename CrsMatrixType::non_const_value_type value_type;
+
+  CrsMatrixType A;
+  PermViewType old_to_new;
+  typename CrsMatrixType::row_map_type::non_const_type row_map;
+  typename CrsMatrixType::index_type::non_const_type entries;
+  typename CrsMatrixType::values_type::non_const_type values;
+
+  PermuteCrsFillFunctor (const CrsMatrixType& A_, const PermViewType& old_to_new_,
+                         const typename CrsMatrixType::row_map_type::non_const_type& row_map_,
+                         const typename CrsMatrixType::index_type::non_const_type& entries_,
+                         const typename CrsMatrixType::values_type::non_const_type& values_) :
+    A (A_), old_to_new (old_to_new_), row_map (row_map_), entries (entries_), values (values_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    const size_type first = row_map(old_to_new(i));
+    size_type write = first;
+    for (size_type k = A.graph.row_map(i); k < A.graph.row_map(i + 1); ++k, ++write) {
+      const ordinal_type col = old_to_new(A.graph.entries(k));
+      const value_type val = A.values(k);
+      size_type w = write;
+      while (w > first && entries(w - 1) > col) {
+        entries(w) = entries(w - 1);
+        values(w) = values(w - 1);
+        --w;
+      }
+      entries(w) = col;
+      values(w) = val;
+    }
+  }
+};
+
+template<class XVector, class YVector, class PermViewType, bool inverse,
+         int rank = XVector::rank>
+struct PermuteVectorFunctor {
+  typedef typename PermViewType::non_const_value_type ordinal_type;
+
+  XVector x;
+  YVector y;
+  PermViewType old_to_new;
+
+  PermuteVectorFunctor (const XVector& x_, const YVector& y_, const PermViewType& old_to_new_) :
+    x (x_), y (y_), old_to_new (old_to_new_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    if (inverse) y(i) = x(old_to_new(i));
+    else y(old_to_new(i)) = x(i);
+  }
+};
+
+template<class XVector, class YVector, class PermViewType, bool inverse>
+struct PermuteVectorFunctor<XVector, YVector, PermViewType, inverse, 2> {
+  typedef typename PermViewType::non_const_value_type ordinal_type;
+
+  XVector x;
+  YVector y;
+  PermViewType old_to_new;
+
+  PermuteVectorFunctor (const XVector& x_, const YVector& y_, const PermViewType& old_to_new_) :
+    x (x_), y (y_), old_to_new (old_to_new_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    const ordinal_type j = old_to_new(i);
+    for (size_t k = 0; k < x.extent(1); ++k) {
+      if (inverse) y(i, k) = x(j, k);
+      else y(j, k) = x(i, k);
+    }
+  }
+};
+
+template<class PermViewType, class XVector, class YVector>
+void permute_vector_check (const char name[], const PermViewType& old_to_new,
+                           const XVector& x, const YVector& y)
+{
+  static_assert (int (XVector::rank) == int (YVector::rank),
+                 "KokkosSparse::Experimental::permute_vector: x and y must have the same rank.");
+  if (x.extent(0) != old_to_new.extent(0) || y.extent(0) != old_to_new.extent(0) ||
+      x.extent(1) != y.extent(1)) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::" << name << ": Dimensions do not match: "
+       << ", old_to_new: " << old_to_new.extent(0)
+       << ", x: " << x.extent(0) << " x " << x.extent(1)
+       << ", y: " << y.extent(0) << " x " << y.extent(1);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+}
+
+}
+
+/// \brief Symmetric permutation B = P A P^T of a square CrsMatrix.
+///
+/// Entry (i, j) of A is entry (old_to_new(i), old_to_new(j)) of B. The
+/// entries of each row of B are sorted by column.
+///
+/// \param A [in] The square sparse matrix.
+/// \param old_to_new [in] The new index of each row, e.g. from
+///   KokkosGraph::Experimental::graph_rcm.
+template<class CrsMatrixType, class PermViewType>
+CrsMatrix<typename CrsMatrixType::non_const_value_type,
+          typename CrsMatrixType::non_const_ordinal_type,
+          typename CrsMatrixType::device_type, void,
+          typename CrsMatrixType::non_const_size_type>
+permute_crs_matrix (const CrsMatrixType& A, const PermViewType& old_to_new)
+{
+  typedef typename CrsMatrixType::execution_space execution_space;
+  typedef typename CrsMatrixType::ordinal_type ordinal_type;
+  typedef typename CrsMatrixType::size_type size_type;
+  typedef CrsMatrix<typename CrsMatrixType::non_const_value_type,
+                    typename CrsMatrixType::non_const_ordinal_type,
+                    typename CrsMatrixType::device_type, void,
+                    typename CrsMatrixType::non_const_size_type> matrix_type;
+  typedef typename CrsMatrixType::row_map_type::non_const_type row_map_type;
+  typedef typename CrsMatrixType::index_type::non_const_type index_type;
+  typedef typename CrsMatrixType::values_type::non_const_type values_type;
+
+  const ordinal_type numRows = A.numRows ();
+  if (A.numCols () != numRows || old_to_new.extent(0) != size_t (numRows)) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::permute_crs_matrix: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols ()
+       << ", old_to_new: " << old_to_new.extent(0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  const size_type nnz = A.nnz ();
+  row_map_type row_map ("Permuted row_map", numRows + 1);
+  index_type entries (Kokkos::ViewAllocateWithoutInitializing ("Permuted entries"), nnz);
+  values_type values (Kokkos::ViewAllocateWithoutInitializing ("Permuted values"), nnz);
+  if (numRows > 0) {
+    Kokkos::parallel_for ("KokkosSparse::permute_crs_matrix::count",
+        Kokkos::RangePolicy<execution_space> (0, numRows),
+        Impl::PermuteCrsCountFunctor<CrsMatrixType, PermViewType> (A, old_to_new, row_map));
+    KokkosKernels::Impl::exclusive_parallel_prefix_sum<row_map_type, execution_space> (numRows + 1, row_map);
+    Kokkos::parallel_for ("KokkosSparse::permute_crs_matrix::fill",
+        Kokkos::RangePolicy<execution_space> (0, numRows),
+        Impl::PermuteCrsFillFunctor<CrsMatrixType, PermViewType> (A, old_to_new, row_map, entries, values));
+  }
+  return matrix_type ("Permuted", numRows, numRows, nnz, values, row_map, entries);
+}
+
+/// \brief y(old_to_new(i), :) = x(i, :), e.g. to order the right hand side
+///   like a matrix permuted by permute_crs_matrix.
+///
+/// \param old_to_new [in] The new index of each row.
+/// \param x [in] The vector or multivector in the original order.
+/// \param y [out] The vector or multivector in the new order; must not
+///   alias x.
+template<class PermViewType, class XVector, class YVector>
+void
+permute_vector (const PermViewType& old_to_new, const XVector& x, const YVector& y)
+{
+  typedef typename YVector::execution_space execution_space;
+  Impl::permute_vector_check ("permute_vector", old_to_new, x, y);
+  Kokkos::parallel_for ("KokkosSparse::permute_vector",
+      Kokkos::RangePolicy<execution_space> (0, old_to_new.extent(0)),
+      Impl::PermuteVectorFunctor<XVector, YVector, PermViewType, false> (x, y, old_to_new));
+}
+
+/// \brief y(i, :) = x(old_to_new(i), :), e.g. to bring back the solution of
+///   a system permuted by permute_crs_matrix to the original order.
+///
+/// \param old_to_new [in] The new index of each row.
+/// \param x [in] The vector or multivector in the new order.
+/// \param y [out] The vector or multivector in the original order; must
+///   not alias x.
+template<class PermViewType, class XVector, class YVector>
+void
+inverse_permute_vector (const PermViewType& old_to_new, const XVector& x, const YVector& y)
+{
+  typedef typename YVector::execution_space execution_space;
+  Impl::permute_vector_check ("inverse_permute_vector", old_to_new, x, y);
+  Kokkos::parallel_for ("KokkosSparse::inverse_permute_vector",
+      Kokkos::RangePolicy<execution_space> (0, old_to_new.extent(0)),
+      Impl::PermuteVectorFunctor<XVector, YVector, PermViewType, true> (x, y, old_to_new));
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_prefetch.hpp
+/// \brief Prefetch hints for matrices in unified memory.
+
+#ifndef KOKKOSSPARSE_PREFETCH_HPP_
+#define KOKKOSSPARSE_PREFETCH_HPP_
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_Prefetch.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_BlockCrsMatrix.hpp"
+
+namespace KokkosSparse {
+
+/// \brief Prefetch the row map, entries and values of A to the device of
+///   exec, asynchronously on its stream.
+///
+/// This only does something when A is in CudaUVMSpace and exec is Cuda;
+/// the pages of A otherwise migrate on the first touch of the kernels that
+/// read them, one page fault at a time. The graph is also advised to be
+/// read mostly, so that reading it back on the host does not migrate it.
+template <typename ScalarType, typename OrdinalType, class Device,
+          class MemoryTraits, typename SizeType, class ExecSpace>
+void prefetch (const CrsMatrix<ScalarType, OrdinalType, Device, MemoryTraits, SizeType>& A,
+               const ExecSpace& exec)
+{
+  KokkosKernels::Impl::kk_prefetch_view (A.graph.row_map, exec, true);
+  KokkosKernels::Impl::kk_prefetch_view (A.graph.entries, exec, true);
+  KokkosKernels::Impl::kk_prefetch_view (A.values, exec);
+}
+
+/// \brief Prefetch a CrsMatrix on an instance of its execution space.
+template <typename ScalarType, typename OrdinalType, class Device,
+          class MemoryTraits, typename SizeType>
+void prefetch (const CrsMatrix<ScalarType, OrdinalType, Device, MemoryTraits, SizeType>& A)
+{
+  prefetch (A, typename Device::execution_space ());
+}
+
+namespace Experimental {
+
+/// \brief Prefetch the block graph and the values of A to the device of
+///   exec, see the CrsMatrix version.
+template <typename ScalarType, typename OrdinalType, class Device,
+          class MemoryTraits, typename SizeType, class ExecSpace>
+void prefetch (const BlockCrsMatrix<ScalarType, OrdinalType, Device, MemoryTraits, SizeType>& A,
+               const ExecSpace& exec)
+{
+  KokkosKernels::Impl::kk_prefetch_view (A.graph.row_map, exec, true);
+  KokkosKernels::Impl::kk_prefetch_view (A.graph.entries, exec, true);
+  KokkosKernels::Impl::kk_prefetch_view (A.values, exec);
+}
+
+/// \brief Prefetch a BlockCrsMatrix on an instance of its execution space.
+template <typename ScalarType, typename OrdinalType, class Device,
+          class MemoryTraits, typename SizeType>
+void prefetch (const BlockCrsMatrix<ScalarType, OrdinalType, Device, MemoryTraits, SizeType>& A)
+{
+  prefetch (A, typename Device::execution_space ());
+}
+
+} // namespace Experimental
+} // namespace KokkosSparse
+
+#endif // KOKKOSSPARSE_PREFETCH_HPP_
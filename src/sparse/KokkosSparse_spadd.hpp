@@ -45,6 +45,10 @@
 #define _KOKKOS_SPADD_HPP
 
 #include "KokkosKernels_Handle.hpp"
+#include "KokkosKernels_HashmapAccumulator.hpp"
+#include "KokkosKernels_Profiling.hpp"
+#include <stdexcept>
+#include <vector>
 
 namespace KokkosSparse {
 namespace Experimental {
@@ -59,6 +63,9 @@ namespace Experimental {
     -Apos/Bpos are saved in the handle
   -Apos and Bpos each contain the final index within C row where the A/B entry belongs
   -See UnsortedNumericSumFunctor below for the usage of Apos/Bpos
+  -By default the unsorted merge uses a hashmap per row (UnsortedHashedMergeFunctor), in team scratch
+    memory if the row fits, so Apos/Bpos are the insertion order of the columns and no sort is needed.
+    The sort based merge is used if the handle asks for sorted output.
   */
 
 //Helper macro to check that two types are the same (ignoring const)
@@ -111,6 +118,52 @@ namespace Experimental {
     CRowPtrsT Crowcounts;
   };
 
+  //get Apos/Bpos for sorted input, the position of each A/B entry within its C row
+  template<typename size_type, typename ordinal_type, typename ARowPtrsT, typename BRowPtrsT, typename AColIndsT, typename BColIndsT, typename CColIndsT>
+  struct SortedEntryPositions
+  {
+    SortedEntryPositions(
+        const typename ARowPtrsT::const_type Arowptrs_,
+        const AColIndsT Acolinds_,
+        const typename BRowPtrsT::const_type Browptrs_,
+        const BColIndsT Bcolinds_,
+        CColIndsT Apos_, CColIndsT Bpos_) :
+      Arowptrs(Arowptrs_), Acolinds(Acolinds_),
+      Browptrs(Browptrs_), Bcolinds(Bcolinds_),
+      Apos(Apos_), Bpos(Bpos_) {}
+    KOKKOS_INLINE_FUNCTION void operator()(const size_type i) const
+    {
+      //same merge as SortedCountEntries, recording the C index of each entry
+      ordinal_type ci = 0;
+      size_type ai = 0;
+      size_type bi = 0;
+      size_type Arowstart = Arowptrs(i);
+      size_type Arowlen = Arowptrs(i + 1) - Arowstart;
+      size_type Browstart = Browptrs(i);
+      size_type Browlen = Browptrs(i + 1) - Browstart;
+      while (ai < Arowlen && bi < Browlen)
+      {
+        ordinal_type Acol = Acolinds(Arowstart + ai);
+        ordinal_type Bcol = Bcolinds(Browstart + bi);
+        if(Acol <= Bcol)
+          Apos(Arowstart + ai++) = ci;
+        if(Acol >= Bcol)
+          Bpos(Browstart + bi++) = ci;
+        ci++;
+      }
+      while (ai < Arowlen)
+        Apos(Arowstart + ai++) = ci++;
+      while (bi < Browlen)
+        Bpos(Browstart + bi++) = ci++;
+    }
+    const typename ARowPtrsT::const_type Arowptrs;
+    const AColIndsT Acolinds;
+    const typename BRowPtrsT::const_type Browptrs;
+    const BColIndsT Bcolinds;
+    CColIndsT Apos;
+    CColIndsT Bpos;
+  };
+
   //get upper bound for C entries per row (assumes worst case, that entries in A and B on each row are disjoint)
   template<typename size_type, typename ARowPtrsT, typename BRowPtrsT, typename CRowPtrsT>
   struct UnsortedEntriesUpperBound
@@ -367,6 +420,225 @@ namespace Experimental {
     CcolindsT Bpos;
   };
 
+  //Unsorted symbolic with hashing: each thread merges a row with its vector lanes,
+  //inserting the A and then the B columns into a hashmap. The hashmap is in the team scratch
+  //memory of the thread if the upper bound of the row fits, and otherwise in the begins/nexts
+  //views, which have the upper bound layout of C. The keys are held in Ccolinds (upper bound layout).
+  //The index of a column in the hashmap is its position in the C row, written to Apos/Bpos,
+  //and the number of distinct columns is written to Crowcounts.
+  template<typename size_type, typename ordinal_type,
+           typename ArowptrsT, typename BrowptrsT, typename CrowptrsT,
+           typename AcolindsT, typename BcolindsT, typename CcolindsT, typename team_member_t>
+  struct UnsortedHashedMergeFunctor
+  {
+    UnsortedHashedMergeFunctor(const ordinal_type nrows_,
+                               const ArowptrsT Arowptrs_, const AcolindsT Acolinds_,
+                               const BrowptrsT Browptrs_, const BcolindsT Bcolinds_,
+                               const CrowptrsT Crowptrs_, CrowptrsT Crowcounts_, CcolindsT Ccolinds_,
+                               CcolindsT begins_, CcolindsT nexts_, CcolindsT Apos_, CcolindsT Bpos_,
+                               const int vector_size_, const ordinal_type thread_shmem_units_,
+                               const ordinal_type thread_shmem_hash_size_, const ordinal_type thread_shmem_key_size_) :
+      nrows(nrows_),
+      Arowptrs(Arowptrs_), Acolinds(Acolinds_),
+      Browptrs(Browptrs_), Bcolinds(Bcolinds_),
+      Crowptrs(Crowptrs_), Crowcounts(Crowcounts_), Ccolinds(Ccolinds_),
+      begins(begins_), nexts(nexts_), Apos(Apos_), Bpos(Bpos_),
+      vector_size(vector_size_), thread_shmem_units(thread_shmem_units_),
+      thread_shmem_hash_size(thread_shmem_hash_size_), thread_shmem_key_size(thread_shmem_key_size_),
+      shared_memory_size(0)
+    {}
+    KOKKOS_INLINE_FUNCTION void operator()(const team_member_t & teamMember) const
+    {
+      ordinal_type *all_shared_memory = (ordinal_type *) (teamMember.team_shmem().get_shmem(shared_memory_size));
+      all_shared_memory += thread_shmem_units * teamMember.team_rank();
+      const ordinal_type i = teamMember.league_rank() * teamMember.team_size() + teamMember.team_rank();
+      if (i >= nrows) return;
+
+      const size_type CrowStart = Crowptrs(i);
+      const ordinal_type CrowLen = Crowptrs(i + 1) - CrowStart;
+      const size_type ArowStart = Arowptrs(i);
+      const ordinal_type ArowLen = Arowptrs(i + 1) - ArowStart;
+      const size_type BrowStart = Browptrs(i);
+      const ordinal_type BrowLen = Browptrs(i + 1) - BrowStart;
+
+      volatile ordinal_type *used_size = (volatile ordinal_type *) all_shared_memory;
+      ordinal_type *hash_begins = all_shared_memory + 2;
+      ordinal_type *hash_nexts = hash_begins + thread_shmem_hash_size;
+      ordinal_type hash_size = thread_shmem_hash_size;
+      if (CrowLen > thread_shmem_key_size){
+        hash_begins = begins.data() + CrowStart;
+        hash_nexts = nexts.data() + CrowStart;
+        hash_size = CrowLen;
+      }
+      KokkosKernels::Experimental::HashmapAccumulator<ordinal_type, ordinal_type, ordinal_type>
+        hm(hash_size, CrowLen, hash_begins, hash_nexts, Ccolinds.data() + CrowStart, NULL);
+
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, hash_size), [&] (ordinal_type j) {
+        hash_begins[j] = -1; });
+      Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+        used_size[0] = 0;
+      });
+      //columns are unique within the rows of A and B, so the lanes never insert the same key at once.
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, ArowLen), [&] (ordinal_type j) {
+        const ordinal_type col = Acolinds(ArowStart + j);
+        const ordinal_type hash = col % hash_size;
+        hm.vector_atomic_insert_into_hash(teamMember, vector_size, hash, col, used_size, CrowLen);
+      });
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, BrowLen), [&] (ordinal_type j) {
+        const ordinal_type col = Bcolinds(BrowStart + j);
+        const ordinal_type hash = col % hash_size;
+        hm.vector_atomic_insert_into_hash(teamMember, vector_size, hash, col, used_size, CrowLen);
+      });
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, ArowLen), [&] (ordinal_type j) {
+        const ordinal_type col = Acolinds(ArowStart + j);
+        Apos(ArowStart + j) = hm.sequential_find_index(col % hash_size, col);
+      });
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, BrowLen), [&] (ordinal_type j) {
+        const ordinal_type col = Bcolinds(BrowStart + j);
+        Bpos(BrowStart + j) = hm.sequential_find_index(col % hash_size, col);
+      });
+      Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+        Crowcounts(i) = used_size[0];
+      });
+    }
+
+    size_t team_shmem_size (int team_size) const {
+      return shared_memory_size;
+    }
+
+    const ordinal_type nrows;
+    const ArowptrsT Arowptrs;
+    const AcolindsT Acolinds;
+    const BrowptrsT Browptrs;
+    const BcolindsT Bcolinds;
+    const CrowptrsT Crowptrs;
+    CrowptrsT Crowcounts;
+    CcolindsT Ccolinds;
+    CcolindsT begins;
+    CcolindsT nexts;
+    CcolindsT Apos;
+    CcolindsT Bpos;
+    const int vector_size;
+    const ordinal_type thread_shmem_units;
+    const ordinal_type thread_shmem_hash_size;
+    const ordinal_type thread_shmem_key_size;
+    size_t shared_memory_size;
+  };
+
+  //maximum number of matrices summed by the multi-operand spadd_symbolic/spadd_numeric
+  enum { SPADD_MAX_OPERANDS = 16 };
+
+  //get upper bound for C entries per row of the sum of num_operands matrices
+  template<typename size_type, typename RowptrsT, typename CrowptrsT>
+  struct MultiEntriesUpperBound
+  {
+    MultiEntriesUpperBound(const int num_operands_, CrowptrsT Crowcounts_) :
+      num_operands(num_operands_), Crowcounts(Crowcounts_)
+    {}
+    KOKKOS_INLINE_FUNCTION void operator()(const size_type i) const
+    {
+      size_type count = 0;
+      for(int op = 0; op < num_operands; op++)
+      {
+        count += Rowptrs[op](i + 1) - Rowptrs[op](i);
+      }
+      Crowcounts(i) = count;
+    }
+    const int num_operands;
+    RowptrsT Rowptrs[SPADD_MAX_OPERANDS];
+    CrowptrsT Crowcounts;
+  };
+
+  //k-way version of UnsortedHashedMergeFunctor: the columns of the rows of all operands are
+  //inserted into the hashmap of the row, and Pos[op] gets the position in C of each entry of operand op.
+  template<typename size_type, typename ordinal_type,
+           typename RowptrsT, typename ColindsT, typename CrowptrsT, typename CcolindsT, typename team_member_t>
+  struct MultiHashedMergeFunctor
+  {
+    MultiHashedMergeFunctor(const ordinal_type nrows_, const int num_operands_,
+                            const CrowptrsT Crowptrs_, CrowptrsT Crowcounts_, CcolindsT Ccolinds_,
+                            CcolindsT begins_, CcolindsT nexts_,
+                            const int vector_size_, const ordinal_type thread_shmem_units_,
+                            const ordinal_type thread_shmem_hash_size_, const ordinal_type thread_shmem_key_size_) :
+      nrows(nrows_), num_operands(num_operands_),
+      Crowptrs(Crowptrs_), Crowcounts(Crowcounts_), Ccolinds(Ccolinds_),
+      begins(begins_), nexts(nexts_),
+      vector_size(vector_size_), thread_shmem_units(thread_shmem_units_),
+      thread_shmem_hash_size(thread_shmem_hash_size_), thread_shmem_key_size(thread_shmem_key_size_),
+      shared_memory_size(0)
+    {}
+    KOKKOS_INLINE_FUNCTION void operator()(const team_member_t & teamMember) const
+    {
+      ordinal_type *all_shared_memory = (ordinal_type *) (teamMember.team_shmem().get_shmem(shared_memory_size));
+      all_shared_memory += thread_shmem_units * teamMember.team_rank();
+      const ordinal_type i = teamMember.league_rank() * teamMember.team_size() + teamMember.team_rank();
+      if (i >= nrows) return;
+
+      const size_type CrowStart = Crowptrs(i);
+      const ordinal_type CrowLen = Crowptrs(i + 1) - CrowStart;
+
+      volatile ordinal_type *used_size = (volatile ordinal_type *) all_shared_memory;
+      ordinal_type *hash_begins = all_shared_memory + 2;
+      ordinal_type *hash_nexts = hash_begins + thread_shmem_hash_size;
+      ordinal_type hash_size = thread_shmem_hash_size;
+      if (CrowLen > thread_shmem_key_size){
+        hash_begins = begins.data() + CrowStart;
+        hash_nexts = nexts.data() + CrowStart;
+        hash_size = CrowLen;
+      }
+      KokkosKernels::Experimental::HashmapAccumulator<ordinal_type, ordinal_type, ordinal_type>
+        hm(hash_size, CrowLen, hash_begins, hash_nexts, Ccolinds.data() + CrowStart, NULL);
+
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, hash_size), [&] (ordinal_type j) {
+        hash_begins[j] = -1; });
+      Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+        used_size[0] = 0;
+      });
+      for(int op = 0; op < num_operands; op++)
+      {
+        const size_type rowStart = Rowptrs[op](i);
+        const ordinal_type rowLen = Rowptrs[op](i + 1) - rowStart;
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, rowLen), [&] (ordinal_type j) {
+          const ordinal_type col = Colinds[op](rowStart + j);
+          const ordinal_type hash = col % hash_size;
+          hm.vector_atomic_insert_into_hash(teamMember, vector_size, hash, col, used_size, CrowLen);
+        });
+      }
+      for(int op = 0; op < num_operands; op++)
+      {
+        const size_type rowStart = Rowptrs[op](i);
+        const ordinal_type rowLen = Rowptrs[op](i + 1) - rowStart;
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, rowLen), [&] (ordinal_type j) {
+          const ordinal_type col = Colinds[op](rowStart + j);
+          Pos[op](rowStart + j) = hm.sequential_find_index(col % hash_size, col);
+        });
+      }
+      Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+        Crowcounts(i) = used_size[0];
+      });
+    }
+
+    size_t team_shmem_size (int team_size) const {
+      return shared_memory_size;
+    }
+
+    const ordinal_type nrows;
+    const int num_operands;
+    RowptrsT Rowptrs[SPADD_MAX_OPERANDS];
+    ColindsT Colinds[SPADD_MAX_OPERANDS];
+    CcolindsT Pos[SPADD_MAX_OPERANDS];
+    const CrowptrsT Crowptrs;
+    CrowptrsT Crowcounts;
+    CcolindsT Ccolinds;
+    CcolindsT begins;
+    CcolindsT nexts;
+    const int vector_size;
+    const ordinal_type thread_shmem_units;
+    const ordinal_type thread_shmem_hash_size;
+    const ordinal_type thread_shmem_key_size;
+    size_t shared_memory_size;
+  };
+
   //from tpetra
   template <typename size_type, typename view_type>
   struct parallel_prefix_sum{
@@ -404,6 +676,7 @@ namespace Experimental {
       const blno_nnz_view_t_ b_entries,
       clno_row_view_t_ c_rowmap)    //c_rowmap must already be allocated (doesn't need to be initialized)
   {
+    KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spadd_symbolic");
     typedef typename KernelHandle::SPADDHandleType::execution_space execution_space;
     typedef typename KernelHandle::size_type size_type;
     typedef typename KernelHandle::nnz_lno_t ordinal_type;
@@ -429,18 +702,103 @@ namespace Experimental {
     auto addHandle = handle->get_spadd_handle();
     auto nrows = a_rowmap.extent(0) - 1;
     typedef Kokkos::RangePolicy<execution_space, ordinal_type> range_type;
+    //c_rowmap and the entry positions only depend on the patterns of A and B.
+    //If the symbolic phase was called before for the same ones, c_rowmap is
+    //restored from the handle.
+    typedef typename KernelHandle::SPADDHandleType::nnz_row_view_t c_rowmap_cache_t;
+    uint64_t pattern_hash = KokkosKernels::Impl::kk_hash_graph
+      <alno_row_view_t_, alno_nnz_view_t_, execution_space>
+      (nrows, 0, a_rowmap, a_entries,
+       KokkosKernels::Impl::kk_hash_mix(
+         uint64_t(addHandle->is_input_sorted()) + 2 * uint64_t(addHandle->get_sorted_output()) +
+         4 * uint64_t(addHandle->get_use_position_map())));
+    pattern_hash = KokkosKernels::Impl::kk_hash_graph
+      <blno_row_view_t_, blno_nnz_view_t_, execution_space>
+      (nrows, 0, b_rowmap, b_entries, pattern_hash);
+    if(addHandle->is_symbolic_called_for(pattern_hash) &&
+       addHandle->get_symbolic_c_row_map().extent(0) == c_rowmap.extent(0))
+    {
+      Kokkos::deep_copy(c_rowmap, addHandle->get_symbolic_c_row_map());
+      addHandle->set_call_numeric(false);
+      return;
+    }
     if(addHandle->is_input_sorted())
     {
       clno_row_view_t_ c_rowcounts("C row counts", nrows);
       //call entry count functor to get entry counts per row
       SortedCountEntries<size_type, ordinal_type, alno_row_view_t_, blno_row_view_t_, alno_nnz_view_t_, blno_nnz_view_t_, clno_row_view_t_>
         countEntries(a_rowmap, a_entries, b_rowmap, b_entries, c_rowcounts);
-      Kokkos::parallel_for(range_type(0, nrows), countEntries);
+      Kokkos::parallel_for("KokkosSparse::spadd_symbolic::CountEntries", range_type(0, nrows), countEntries);
       execution_space::fence();
       //get c_rowmap as cumulative sum
       parallel_prefix_sum<size_type, clno_row_view_t_> prefix(c_rowcounts, c_rowmap);
-      Kokkos::parallel_scan(range_type(0, nrows + 1), prefix);
+      Kokkos::parallel_scan("KokkosSparse::spadd_symbolic::PrefixSum", range_type(0, nrows + 1), prefix);
       execution_space::fence();
+      if(addHandle->get_use_position_map())
+      {
+        clno_nnz_view_t_ a_pos(Kokkos::ViewAllocateWithoutInitializing("A entry positions"), a_entries.extent(0));
+        clno_nnz_view_t_ b_pos(Kokkos::ViewAllocateWithoutInitializing("B entry positions"), b_entries.extent(0));
+        SortedEntryPositions<size_type, ordinal_type, alno_row_view_t_, blno_row_view_t_, alno_nnz_view_t_, blno_nnz_view_t_, clno_nnz_view_t_>
+          entryPositions(a_rowmap, a_entries, b_rowmap, b_entries, a_pos, b_pos);
+        Kokkos::parallel_for("KokkosSparse::spadd_symbolic::EntryPositions", range_type(0, nrows), entryPositions);
+        execution_space::fence();
+        addHandle->set_a_b_pos(a_pos, b_pos);
+      }
+    }
+    else if(!addHandle->get_sorted_output())
+    {
+      typedef typename Kokkos::TeamPolicy<execution_space>::member_type team_member_t;
+      typedef Kokkos::TeamPolicy<execution_space> team_policy_t;
+      clno_row_view_t_ c_rowmap_upperbound("C row counts upper bound", nrows + 1);
+      size_t c_nnz_upperbound = 0;
+      {
+        clno_row_view_t_ c_rowcounts_upperbound("C row counts upper bound", nrows);
+        UnsortedEntriesUpperBound<size_type, alno_row_view_t_, blno_row_view_t_, clno_row_view_t_>
+          countEntries(a_rowmap, b_rowmap, c_rowcounts_upperbound);
+        Kokkos::parallel_for("KokkosSparse::spadd_symbolic::CountEntries", range_type(0, nrows), countEntries);
+        execution_space::fence();
+        parallel_prefix_sum<size_type, clno_row_view_t_> prefix(c_rowcounts_upperbound, c_rowmap_upperbound);
+        Kokkos::parallel_scan("KokkosSparse::spadd_symbolic::PrefixSum", range_type(0, nrows + 1), prefix);
+        execution_space::fence();
+
+        auto d_c_nnz_size = Kokkos::subview(c_rowmap_upperbound, nrows);
+        auto h_c_nnz_size = Kokkos::create_mirror_view (d_c_nnz_size);
+        Kokkos::deep_copy (h_c_nnz_size, d_c_nnz_size);
+        execution_space::fence();
+        c_nnz_upperbound = h_c_nnz_size();
+      }
+      const int vector_size = handle->get_suggested_vector_size(nrows, c_nnz_upperbound);
+      const int team_size = handle->get_suggested_team_size(vector_size);
+      //scratch of a thread: 2 units for the used size, the begins and nexts of the hashmap.
+      const ordinal_type thread_shmem_units = (handle->get_shmem_size() / team_size) / sizeof(ordinal_type);
+      ordinal_type thread_shmem_hash_size = 1;
+      while (thread_shmem_hash_size * 4 <= thread_shmem_units - 2){
+        thread_shmem_hash_size *= 2;
+      }
+      ordinal_type thread_shmem_key_size = thread_shmem_units - 2 - thread_shmem_hash_size;
+      if (thread_shmem_key_size < 0) thread_shmem_key_size = 0;
+
+      //keys of the hashmaps, and begins/nexts of the rows that do not fit in scratch.
+      clno_nnz_view_t_ c_entries_uncompressed(Kokkos::ViewAllocateWithoutInitializing("C entries uncompressed"), c_nnz_upperbound);
+      clno_nnz_view_t_ hash_begins(Kokkos::ViewAllocateWithoutInitializing("C hash begins"), c_nnz_upperbound);
+      clno_nnz_view_t_ hash_nexts(Kokkos::ViewAllocateWithoutInitializing("C hash nexts"), c_nnz_upperbound);
+      clno_nnz_view_t_ a_pos(Kokkos::ViewAllocateWithoutInitializing("A entry positions"), a_entries.extent(0));
+      clno_nnz_view_t_ b_pos(Kokkos::ViewAllocateWithoutInitializing("B entry positions"), b_entries.extent(0));
+      clno_row_view_t_ c_rowcounts("C row counts", nrows);
+      UnsortedHashedMergeFunctor<size_type, ordinal_type, alno_row_view_t_, blno_row_view_t_, clno_row_view_t_,
+                                 alno_nnz_view_t_, blno_nnz_view_t_, clno_nnz_view_t_, team_member_t>
+        hashedMerge(nrows, a_rowmap, a_entries, b_rowmap, b_entries,
+                    c_rowmap_upperbound, c_rowcounts, c_entries_uncompressed,
+                    hash_begins, hash_nexts, a_pos, b_pos,
+                    vector_size, thread_shmem_units, thread_shmem_hash_size, thread_shmem_key_size);
+      hashedMerge.shared_memory_size = size_t (thread_shmem_units) * team_size * sizeof(ordinal_type);
+      Kokkos::parallel_for("KokkosSparse::spadd_symbolic::HashedMerge",
+          team_policy_t(nrows / team_size + 1, team_size, vector_size), hashedMerge);
+      execution_space::fence();
+      parallel_prefix_sum<size_type, clno_row_view_t_> prefix(c_rowcounts, c_rowmap);
+      Kokkos::parallel_scan("KokkosSparse::spadd_symbolic::PrefixSum", range_type(0, nrows + 1), prefix);
+      execution_space::fence();
+      addHandle->set_a_b_pos(a_pos, b_pos);
     }
     else
     {
@@ -452,11 +810,11 @@ namespace Experimental {
         clno_row_view_t_ c_rowcounts_upperbound("C row counts upper bound", nrows);
         UnsortedEntriesUpperBound<size_type, alno_row_view_t_, blno_row_view_t_, clno_row_view_t_>
           countEntries(a_rowmap, b_rowmap, c_rowcounts_upperbound);
-        Kokkos::parallel_for(range_type(0, nrows), countEntries);
+        Kokkos::parallel_for("KokkosSparse::spadd_symbolic::CountEntries", range_type(0, nrows), countEntries);
         execution_space::fence();
         //get (temporary) c_rowmap as cumulative sum
         parallel_prefix_sum<size_type, clno_row_view_t_> prefix(c_rowcounts_upperbound, c_rowmap_upperbound);
-        Kokkos::parallel_scan(range_type(0, nrows + 1), prefix);
+        Kokkos::parallel_scan("KokkosSparse::spadd_symbolic::PrefixSum", range_type(0, nrows + 1), prefix);
         //compute uncompressed entries of C (just indices, no scalars)
         execution_space::fence();
 
@@ -472,12 +830,12 @@ namespace Experimental {
       UnmergedSumFunctor<size_type, ordinal_type, alno_row_view_t_, blno_row_view_t_, clno_row_view_t_,
                          alno_nnz_view_t_, blno_nnz_view_t_, clno_nnz_view_t_> unmergedSum(
                          a_rowmap, a_entries, b_rowmap, b_entries, c_rowmap_upperbound, c_entries_uncompressed, ab_perm);
-      Kokkos::parallel_for(range_type(0, nrows), unmergedSum);
+      Kokkos::parallel_for("KokkosSparse::spadd_symbolic::UnmergedSum", range_type(0, nrows), unmergedSum);
       execution_space::fence();
       //sort the unmerged sum
       SortEntriesFunctor<size_type, clno_row_view_t_, clno_nnz_view_t_>
         sortEntries(c_rowmap_upperbound, c_entries_uncompressed, ab_perm);
-      Kokkos::parallel_for(range_type(0, nrows), sortEntries);
+      Kokkos::parallel_for("KokkosSparse::spadd_symbolic::SortEntries", range_type(0, nrows), sortEntries);
       execution_space::fence();
       clno_nnz_view_t_ a_pos("A entry positions", a_entries.extent(0));
       clno_nnz_view_t_ b_pos("B entry positions", b_entries.extent(0));
@@ -486,11 +844,11 @@ namespace Experimental {
         clno_row_view_t_ c_rowcounts("C row counts", nrows);
         MergeEntriesFunctor<size_type, ordinal_type, alno_row_view_t_, blno_row_view_t_, clno_row_view_t_, clno_nnz_view_t_>
           mergeEntries(a_rowmap, b_rowmap, c_rowmap_upperbound, c_rowcounts, c_entries_uncompressed, ab_perm, a_pos, b_pos);
-        Kokkos::parallel_for(range_type(0, nrows), mergeEntries);
+        Kokkos::parallel_for("KokkosSparse::spadd_symbolic::MergeEntries", range_type(0, nrows), mergeEntries);
         execution_space::fence();
         //compute actual c_rowmap
         parallel_prefix_sum<size_type, clno_row_view_t_> prefix(c_rowcounts, c_rowmap);
-        Kokkos::parallel_scan(range_type(0, nrows + 1), prefix);
+        Kokkos::parallel_scan("KokkosSparse::spadd_symbolic::PrefixSum", range_type(0, nrows + 1), prefix);
         execution_space::fence();
       }
       addHandle->set_a_b_pos(a_pos, b_pos);
@@ -505,6 +863,9 @@ namespace Experimental {
     size_type cmax = h_c_nnz_size();
     addHandle->set_max_result_nnz(cmax);
 
+    c_rowmap_cache_t c_rowmap_cache(Kokkos::ViewAllocateWithoutInitializing("C row map of the symbolic phase"), c_rowmap.extent(0));
+    Kokkos::deep_copy(c_rowmap_cache, c_rowmap);
+    addHandle->set_symbolic_pattern(pattern_hash, c_rowmap_cache);
 
     addHandle->set_call_symbolic();
     addHandle->set_call_numeric(false);
@@ -550,16 +911,24 @@ namespace Experimental {
       {
         ordinal_type Acol = Acolinds(ArowStart + ai);
         ordinal_type Bcol = Bcolinds(BrowStart + bi);
-        if(Acol <= Bcol)
+        //C values are assigned, so C does not need to be zero when numeric is called again
+        if(Acol < Bcol)
         {
           Ccolinds(CrowStart + ci) = Acol;
-          Cvalues(CrowStart + ci) += alpha * Avalues(ArowStart + ai);
+          Cvalues(CrowStart + ci) = alpha * Avalues(ArowStart + ai);
           ai++;
         }
-        if(Acol >= Bcol)
+        else if(Acol > Bcol)
         {
           Ccolinds(CrowStart + ci) = Bcol;
-          Cvalues(CrowStart + ci) += beta * Bvalues(BrowStart + bi);
+          Cvalues(CrowStart + ci) = beta * Bvalues(BrowStart + bi);
+          bi++;
+        }
+        else
+        {
+          Ccolinds(CrowStart + ci) = Acol;
+          Cvalues(CrowStart + ci) = alpha * Avalues(ArowStart + ai) + beta * Bvalues(BrowStart + bi);
+          ai++;
           bi++;
         }
         ci++;
@@ -627,6 +996,11 @@ namespace Experimental {
       size_type ArowEnd = Arowptrs(i + 1);
       size_type BrowStart = Browptrs(i);
       size_type BrowEnd = Browptrs(i + 1);
+      //clear the row, so that repeated numeric calls with the same C only scatter
+      for(size_type j = CrowStart; j < Crowptrs(i + 1); j++)
+      {
+        Cvalues(j) = 0;
+      }
       //add in A entries, while setting C colinds
       for(size_type j = ArowStart; j < ArowEnd; j++)
       {
@@ -655,6 +1029,42 @@ namespace Experimental {
     const CcolindsT Bpos;
   };
 
+  //k-way version of UnsortedNumericSumFunctor, scatters coefs[op] * values of each operand with Pos[op]
+  template<typename size_type,
+           typename RowptrsT, typename ColindsT, typename ValuesT, typename CrowptrsT,
+           typename CcolindsT, typename CvaluesT, typename scalar_t>
+  struct MultiNumericSumFunctor
+  {
+    MultiNumericSumFunctor(const int num_operands_, const CrowptrsT Crowptrs_, CcolindsT Ccolinds_, CvaluesT Cvalues_) :
+      num_operands(num_operands_), Crowptrs(Crowptrs_), Ccolinds(Ccolinds_), Cvalues(Cvalues_)
+    {}
+    KOKKOS_INLINE_FUNCTION void operator()(const size_type i) const
+    {
+      size_type CrowStart = Crowptrs(i);
+      for(size_type j = CrowStart; j < Crowptrs(i + 1); j++)
+      {
+        Cvalues(j) = 0;
+      }
+      for(int op = 0; op < num_operands; op++)
+      {
+        for(size_type j = Rowptrs[op](i); j < Rowptrs[op](i + 1); j++)
+        {
+          Cvalues(CrowStart + Pos[op](j)) += coefs[op] * Values[op](j);
+          Ccolinds(CrowStart + Pos[op](j)) = Colinds[op](j);
+        }
+      }
+    }
+    const int num_operands;
+    RowptrsT Rowptrs[SPADD_MAX_OPERANDS];
+    ColindsT Colinds[SPADD_MAX_OPERANDS];
+    ValuesT Values[SPADD_MAX_OPERANDS];
+    CcolindsT Pos[SPADD_MAX_OPERANDS];
+    scalar_t coefs[SPADD_MAX_OPERANDS];
+    const CrowptrsT Crowptrs;
+    CcolindsT Ccolinds;
+    CvaluesT Cvalues;
+  };
+
   template <typename KernelHandle,
             typename alno_row_view_t_,
             typename alno_nnz_view_t_,
@@ -681,6 +1091,7 @@ namespace Experimental {
       clno_nnz_view_t_ c_entries,
       cscalar_nnz_view_t_ c_values)
   {
+    KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spadd_numeric");
     typedef typename KernelHandle::size_type size_type;
     typedef typename KernelHandle::nnz_lno_t ordinal_type;
     typedef typename KernelHandle::nnz_scalar_t scalar_type;
@@ -715,14 +1126,14 @@ namespace Experimental {
     typedef Kokkos::RangePolicy<execution_space, size_type> range_type;
     auto addHandle = kernel_handle->get_spadd_handle();
     auto nrows = a_rowmap.extent(0) - 1;
-    if(addHandle->is_input_sorted())
+    if(addHandle->is_input_sorted() && !addHandle->get_use_position_map())
     {
       SortedNumericSumFunctor<size_type, ordinal_type, alno_row_view_t_, blno_row_view_t_, clno_row_view_t_,
                                            alno_nnz_view_t_, blno_nnz_view_t_, clno_nnz_view_t_,
                                            ascalar_nnz_view_t_, bscalar_nnz_view_t_, cscalar_nnz_view_t_,
                                            ascalar_t_, bscalar_t_>
         sortedNumeric(a_rowmap, b_rowmap, c_rowmap, a_entries, b_entries, c_entries, a_values, b_values, c_values, alpha, beta);
-      Kokkos::parallel_for(range_type(0, nrows), sortedNumeric);
+      Kokkos::parallel_for("KokkosSparse::spadd_numeric::Sorted", range_type(0, nrows), sortedNumeric);
       execution_space::fence();
     }
     else
@@ -733,11 +1144,178 @@ namespace Experimental {
                                            ascalar_nnz_view_t_, bscalar_nnz_view_t_, cscalar_nnz_view_t_,
                                            ascalar_t_, bscalar_t_>
         unsortedNumeric(a_rowmap, b_rowmap, c_rowmap, a_entries, b_entries, c_entries, a_values, b_values, c_values, alpha, beta, addHandle->get_a_pos(), addHandle->get_b_pos());
-      Kokkos::parallel_for(range_type(0, nrows), unsortedNumeric);
+      Kokkos::parallel_for("KokkosSparse::spadd_numeric::Unsorted", range_type(0, nrows), unsortedNumeric);
       execution_space::fence();
     }
     addHandle->set_call_numeric();
   }
+
+  /**
+   * \brief Symbolic phase of C = sum of coefs[op] * A_op for num_operands = rowmaps.size()
+   * matrices with the same number of rows, in a single k-way merge per row instead of
+   * k - 1 pairwise additions. The rows of the operands are merged with a hashmap
+   * as in the unsorted spadd_symbolic, whether they are sorted or not, and the
+   * rows of C are not sorted. The positions of the entries of each operand in C are
+   * stored in the spadd handle for the multi-operand spadd_numeric.
+   * c_rowmap must already be allocated (doesn't need to be initialized).
+   */
+  template <typename KernelHandle,
+            typename lno_row_view_t_,
+            typename lno_nnz_view_t_,
+            typename clno_row_view_t_,
+            typename clno_nnz_view_t_>
+  void spadd_symbolic(
+      KernelHandle* handle,
+      const std::vector<lno_row_view_t_> &rowmaps,
+      const std::vector<lno_nnz_view_t_> &entries,
+      clno_row_view_t_ c_rowmap)
+  {
+    KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spadd_symbolic");
+    typedef typename KernelHandle::SPADDHandleType::execution_space execution_space;
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+    typedef typename Kokkos::TeamPolicy<execution_space>::member_type team_member_t;
+    typedef Kokkos::TeamPolicy<execution_space> team_policy_t;
+    static_assert(SAME_TYPE(typename lno_row_view_t_::non_const_value_type, size_type),
+        "add_symbolic: operand size_type must match KernelHandle size_type (const doesn't matter)");
+    static_assert(SAME_TYPE(typename clno_row_view_t_::non_const_value_type, size_type),
+        "add_symbolic: C size_type must match KernelHandle size_type)");
+    static_assert(SAME_TYPE(typename lno_nnz_view_t_::non_const_value_type, ordinal_type),
+        "add_symbolic: operand entry type must match KernelHandle entry type (aka nnz_lno_t, and const doesn't matter)");
+    static_assert(SAME_TYPE(typename clno_nnz_view_t_::non_const_value_type, ordinal_type),
+        "add_symbolic: C entry type must match KernelHandle entry type (aka nnz_lno_t)");
+    const int num_operands = rowmaps.size();
+    if(num_operands == 0 || num_operands > SPADD_MAX_OPERANDS || entries.size() != rowmaps.size())
+    {
+      throw std::runtime_error("spadd_symbolic: the number of operands must be between 1 and SPADD_MAX_OPERANDS, with a rowmap and entries for each");
+    }
+    auto addHandle = handle->get_spadd_handle();
+    auto nrows = rowmaps[0].extent(0) - 1;
+    typedef Kokkos::RangePolicy<execution_space, ordinal_type> range_type;
+
+    clno_row_view_t_ c_rowmap_upperbound("C row counts upper bound", nrows + 1);
+    size_t c_nnz_upperbound = 0;
+    {
+      clno_row_view_t_ c_rowcounts_upperbound("C row counts upper bound", nrows);
+      MultiEntriesUpperBound<size_type, lno_row_view_t_, clno_row_view_t_>
+        countEntries(num_operands, c_rowcounts_upperbound);
+      for(int op = 0; op < num_operands; op++)
+        countEntries.Rowptrs[op] = rowmaps[op];
+      Kokkos::parallel_for("KokkosSparse::spadd_symbolic::CountEntries", range_type(0, nrows), countEntries);
+      execution_space::fence();
+      parallel_prefix_sum<size_type, clno_row_view_t_> prefix(c_rowcounts_upperbound, c_rowmap_upperbound);
+      Kokkos::parallel_scan("KokkosSparse::spadd_symbolic::PrefixSum", range_type(0, nrows + 1), prefix);
+      execution_space::fence();
+
+      auto d_c_nnz_size = Kokkos::subview(c_rowmap_upperbound, nrows);
+      auto h_c_nnz_size = Kokkos::create_mirror_view (d_c_nnz_size);
+      Kokkos::deep_copy (h_c_nnz_size, d_c_nnz_size);
+      execution_space::fence();
+      c_nnz_upperbound = h_c_nnz_size();
+    }
+    const int vector_size = handle->get_suggested_vector_size(nrows, c_nnz_upperbound);
+    const int team_size = handle->get_suggested_team_size(vector_size);
+    const ordinal_type thread_shmem_units = (handle->get_shmem_size() / team_size) / sizeof(ordinal_type);
+    ordinal_type thread_shmem_hash_size = 1;
+    while (thread_shmem_hash_size * 4 <= thread_shmem_units - 2){
+      thread_shmem_hash_size *= 2;
+    }
+    ordinal_type thread_shmem_key_size = thread_shmem_units - 2 - thread_shmem_hash_size;
+    if (thread_shmem_key_size < 0) thread_shmem_key_size = 0;
+
+    clno_nnz_view_t_ c_entries_uncompressed(Kokkos::ViewAllocateWithoutInitializing("C entries uncompressed"), c_nnz_upperbound);
+    clno_nnz_view_t_ hash_begins(Kokkos::ViewAllocateWithoutInitializing("C hash begins"), c_nnz_upperbound);
+    clno_nnz_view_t_ hash_nexts(Kokkos::ViewAllocateWithoutInitializing("C hash nexts"), c_nnz_upperbound);
+    clno_row_view_t_ c_rowcounts("C row counts", nrows);
+    MultiHashedMergeFunctor<size_type, ordinal_type, lno_row_view_t_, lno_nnz_view_t_,
+                            clno_row_view_t_, clno_nnz_view_t_, team_member_t>
+      hashedMerge(nrows, num_operands, c_rowmap_upperbound, c_rowcounts, c_entries_uncompressed,
+                  hash_begins, hash_nexts,
+                  vector_size, thread_shmem_units, thread_shmem_hash_size, thread_shmem_key_size);
+    std::vector<typename KernelHandle::SPADDHandleType::nnz_lno_view_t> operand_pos(num_operands);
+    for(int op = 0; op < num_operands; op++)
+    {
+      hashedMerge.Rowptrs[op] = rowmaps[op];
+      hashedMerge.Colinds[op] = entries[op];
+      hashedMerge.Pos[op] = clno_nnz_view_t_(Kokkos::ViewAllocateWithoutInitializing("operand entry positions"), entries[op].extent(0));
+      operand_pos[op] = hashedMerge.Pos[op];
+    }
+    hashedMerge.shared_memory_size = size_t (thread_shmem_units) * team_size * sizeof(ordinal_type);
+    Kokkos::parallel_for("KokkosSparse::spadd_symbolic::MultiHashedMerge",
+        team_policy_t(nrows / team_size + 1, team_size, vector_size), hashedMerge);
+    execution_space::fence();
+    parallel_prefix_sum<size_type, clno_row_view_t_> prefix(c_rowcounts, c_rowmap);
+    Kokkos::parallel_scan("KokkosSparse::spadd_symbolic::PrefixSum", range_type(0, nrows + 1), prefix);
+    execution_space::fence();
+    addHandle->set_operand_pos(operand_pos);
+
+    auto d_c_nnz_size = Kokkos::subview(c_rowmap, nrows);
+    auto h_c_nnz_size = Kokkos::create_mirror_view (d_c_nnz_size);
+    Kokkos::deep_copy (h_c_nnz_size, d_c_nnz_size);
+    execution_space::fence();
+    addHandle->set_max_result_nnz(h_c_nnz_size());
+
+    addHandle->set_call_symbolic();
+    addHandle->set_call_numeric(false);
+  }
+
+  /**
+   * \brief Numeric phase of C = sum of coefs[op] * A_op, see the multi-operand spadd_symbolic,
+   * which must have been called with the same rowmaps and entries. The values are
+   * scattered to C with the positions stored in the handle, so it can be called
+   * again with new values of the operands and reuse C.
+   */
+  template <typename KernelHandle,
+            typename lno_row_view_t_,
+            typename lno_nnz_view_t_,
+            typename scalar_nnz_view_t_,
+            typename scalar_t_,
+            typename clno_row_view_t_,
+            typename clno_nnz_view_t_,
+            typename cscalar_nnz_view_t_>
+  void spadd_numeric(
+      KernelHandle* kernel_handle,
+      const std::vector<lno_row_view_t_> &rowmaps,
+      const std::vector<lno_nnz_view_t_> &entries,
+      const std::vector<scalar_nnz_view_t_> &values,
+      const std::vector<scalar_t_> &coefs,
+      const clno_row_view_t_ c_rowmap,
+      clno_nnz_view_t_ c_entries,
+      cscalar_nnz_view_t_ c_values)
+  {
+    KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spadd_numeric");
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_scalar_t scalar_type;
+    typedef typename KernelHandle::SPADDHandleType::execution_space execution_space;
+    static_assert(SAME_TYPE(scalar_t_, scalar_type), "coefficient scalar type must match handle scalar type");
+    static_assert(SAME_TYPE(typename scalar_nnz_view_t_::value_type, scalar_type),
+        "add_numeric: operand scalar type must match KernelHandle scalar type (const doesn't matter)");
+    static_assert(std::is_same<typename cscalar_nnz_view_t_::non_const_value_type, typename cscalar_nnz_view_t_::value_type>::value,
+        "add_numeric: C scalar type must not be const");
+    auto addHandle = kernel_handle->get_spadd_handle();
+    const int num_operands = rowmaps.size();
+    if(!addHandle->is_symbolic_called() || addHandle->get_operand_pos().size() != rowmaps.size() ||
+       entries.size() != rowmaps.size() || values.size() != rowmaps.size() || coefs.size() != rowmaps.size())
+    {
+      throw std::runtime_error("spadd_numeric: call the multi-operand spadd_symbolic first, with a rowmap, entries, values and coefficient for each operand");
+    }
+    auto nrows = rowmaps[0].extent(0) - 1;
+    typedef Kokkos::RangePolicy<execution_space, size_type> range_type;
+    MultiNumericSumFunctor<size_type, lno_row_view_t_, lno_nnz_view_t_, scalar_nnz_view_t_,
+                           clno_row_view_t_, clno_nnz_view_t_, cscalar_nnz_view_t_, scalar_type>
+      multiNumeric(num_operands, c_rowmap, c_entries, c_values);
+    for(int op = 0; op < num_operands; op++)
+    {
+      multiNumeric.Rowptrs[op] = rowmaps[op];
+      multiNumeric.Colinds[op] = entries[op];
+      multiNumeric.Values[op] = values[op];
+      multiNumeric.Pos[op] = addHandle->get_operand_pos()[op];
+      multiNumeric.coefs[op] = coefs[op];
+    }
+    Kokkos::parallel_for("KokkosSparse::spadd_numeric::Multi", range_type(0, nrows), multiNumeric);
+    execution_space::fence();
+    addHandle->set_call_numeric();
+  }
 }
 }
 
@@ -45,6 +45,8 @@
 #include <Kokkos_Core.hpp>
 #include <iostream>
 #include <string>
+#include <stdint.h>
+#include <vector>
 
 #ifndef _SPADDHANDLE_HPP
 #define _SPADDHANDLE_HPP
@@ -69,6 +71,10 @@ private:
 
   bool called_symbolic;
   bool called_numeric;
+  //fingerprint of the patterns the symbolic phase was called for, and the
+  //row map of C it computed.
+  uint64_t symbolic_pattern_hash;
+  nnz_row_view_t symbolic_c_row_map;
 
   int suggested_vector_size;
   int suggested_team_size;
@@ -79,6 +85,14 @@ private:
   nnz_lno_view_t a_pos;
   nnz_lno_view_t b_pos;
 
+  //operand_pos are the a_pos/b_pos of the multi-operand add, one view per operand
+  std::vector<nnz_lno_view_t> operand_pos;
+
+  //unsorted inputs are merged with sorting instead of hashing, so the rows of C are sorted.
+  bool sorted_output;
+  //sorted inputs also compute a_pos and b_pos, so that numeric only scatters the values.
+  bool use_position_map;
+
 public:
   /**
    * \brief sets the result nnz size.
@@ -101,6 +115,16 @@ public:
     return b_pos;
   }
 
+  void set_operand_pos(const std::vector<nnz_lno_view_t> &operand_pos_in)
+  {
+    operand_pos = operand_pos_in;
+  }
+
+  const std::vector<nnz_lno_view_t> &get_operand_pos() const
+  {
+    return operand_pos;
+  }
+
   /**
    * \brief sets the result nnz size.
    * \param result_nnz_size: size of the output matrix.
@@ -130,13 +154,24 @@ public:
   SPADDHandle(bool input_is_sorted) :
     input_sorted(input_is_sorted), result_nnz_size(0),
     called_symbolic(false), called_numeric(false),
-    suggested_vector_size(0), suggested_team_size(0), max_nnz_inresult(0)
+    symbolic_pattern_hash(0), symbolic_c_row_map(),
+    suggested_vector_size(0), suggested_team_size(0), max_nnz_inresult(0),
+    sorted_output(false), use_position_map(false)
     {}
 
   virtual ~SPADDHandle() {};
 
   bool is_symbolic_called(){return this->called_symbolic;}
   bool is_numeric_called(){return this->called_numeric;}
+  /**
+   * \brief True if the symbolic phase was called for patterns with the
+   * given fingerprint (see KokkosKernels::Impl::kk_hash_graph).
+   */
+  bool is_symbolic_called_for(uint64_t pattern_hash){
+    return this->called_symbolic && this->symbolic_pattern_hash == pattern_hash;
+  }
+  uint64_t get_symbolic_pattern_hash(){return this->symbolic_pattern_hash;}
+  nnz_row_view_t get_symbolic_c_row_map(){return this->symbolic_c_row_map;}
 
   size_type get_max_result_nnz() const{
     return this->max_nnz_inresult ;
@@ -144,6 +179,10 @@ public:
 
   //setters
   void set_call_symbolic(bool call = true){this->called_symbolic = call;}
+  void set_symbolic_pattern(uint64_t pattern_hash, nnz_row_view_t c_row_map){
+    this->symbolic_pattern_hash = pattern_hash;
+    this->symbolic_c_row_map = c_row_map;
+  }
   void set_call_numeric(bool call = true){this->called_numeric = call;}
 
   void set_max_result_nnz(size_type num_result_nnz_){
@@ -227,6 +266,25 @@ public:
     return input_sorted;
   }
 
+  /**
+   * \brief Unsorted inputs are merged by default with a hashmap per row, and
+   * the rows of C keep the order of the hashmap. When set, the unsorted
+   * symbolic sorts the merged entries instead, so the rows of C are sorted.
+   * \param sorted_output_: whether the rows of C are sorted for unsorted inputs.
+   */
+  void set_sorted_output(bool sorted_output_){this->sorted_output = sorted_output_;}
+  bool get_sorted_output() const {return this->sorted_output;}
+
+  /**
+   * \brief When set, the symbolic phase of sorted inputs also stores the position
+   * in C of each entry of A and B, as it does for unsorted inputs. The numeric
+   * phase is then a scatter of the values, which pays off when C = alpha*A + beta*B
+   * is recomputed for A and B with the same patterns.
+   * \param use_position_map_: whether to store the positions for sorted inputs.
+   */
+  void set_use_position_map(bool use_position_map_){this->use_position_map = use_position_map_;}
+  bool get_use_position_map() const {return this->use_position_map;}
+
 };
 
 }
@@ -0,0 +1,203 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_spchol.hpp
+/// \brief Parallel supernodal sparse Cholesky factorization
+///
+/// This file provides KokkosSparse::Experimental::spchol_symbolic,
+/// KokkosSparse::Experimental::spchol_numeric and
+/// KokkosSparse::Experimental::spchol_solve for real symmetric positive
+/// definite matrices, A = U^T U with U = L^T. The symbolic phase computes
+/// the elimination tree, the structure of L and its supernodes on the
+/// host, and stores them in the spchol handle of the kernel handle; the
+/// numeric phase can then be called many times for matrices with the same
+/// sparsity pattern, and the solve many times for each factor.
+///
+/// The numeric phase and the solve run on the device, level by level over
+/// the supernodal elimination tree, one team per supernode: the dense
+/// diagonal block of a supernode is factored with the batched team
+/// Cholesky, its rows below with the batched team trsm, and the update of
+/// its ancestors is a batched team gemm. The solve applies the same dense
+/// blocks with the batched team trsv and gemv. Only the lower triangle of
+/// A (column <= row) is read.
+
+#ifndef KOKKOSSPARSE_SPCHOL_HPP_
+#define KOKKOSSPARSE_SPCHOL_HPP_
+
+#include <type_traits>
+#include <stdexcept>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_spchol_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+#define KOKKOSKERNELS_SPCHOL_SAME_TYPE(A, B) std::is_same<typename std::remove_const<A>::type, typename std::remove_const<B>::type>::value
+
+  /// \brief Symbolic phase of the Cholesky factorization. Computes the
+  /// supernodes of L and the level schedule of the numeric phase. The
+  /// spchol handle must have been created with
+  /// handle->create_spchol_handle(nrows). A must be square with a
+  /// symmetric pattern.
+  template <typename KernelHandle,
+            typename lno_row_view_t_,
+            typename lno_nnz_view_t_>
+  void spchol_symbolic(
+      KernelHandle *handle,
+      lno_row_view_t_ rowmap,
+      lno_nnz_view_t_ entries)
+  {
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+
+    static_assert(KOKKOSKERNELS_SPCHOL_SAME_TYPE(typename lno_row_view_t_::non_const_value_type, size_type),
+        "spchol_symbolic: A size_type must match KernelHandle size_type (const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPCHOL_SAME_TYPE(typename lno_nnz_view_t_::non_const_value_type, ordinal_type),
+        "spchol_symbolic: A entry type must match KernelHandle entry type (aka nnz_lno_t, and const doesn't matter)");
+
+    typedef typename KernelHandle::SPCHOLHandleType spcholHandleType;
+    spcholHandleType *sh = handle->get_spchol_handle();
+    if (sh == NULL){
+      throw std::runtime_error("spchol_symbolic: the spchol handle has not been created, call create_spchol_handle first");
+    }
+    if (static_cast<size_t>(sh->get_nrows()) + 1 != rowmap.extent(0)){
+      throw std::runtime_error("spchol_symbolic: the number of rows of A must match the spchol handle");
+    }
+
+    Impl::chol_symbolic(*sh, rowmap, entries);
+  }
+
+  /// \brief Numeric phase of the Cholesky factorization: computes the
+  /// supernodal blocks of U for the structure of the symbolic phase. If the
+  /// symbolic phase has not been run yet, it is run first. Throws if A is
+  /// not positive definite; the factor is then undefined and spchol_solve
+  /// throws until spchol_numeric succeeds on the same handle.
+  ///
+  /// \param handle [in/out] kernel handle with the spchol handle created.
+  /// \param rowmap [in] row map of A.
+  /// \param entries [in] column indices of A; duplicates are summed.
+  /// \param values [in] values of A.
+  template <typename KernelHandle,
+            typename lno_row_view_t_,
+            typename lno_nnz_view_t_,
+            typename scalar_nnz_view_t_>
+  void spchol_numeric(
+      KernelHandle *handle,
+      lno_row_view_t_ rowmap,
+      lno_nnz_view_t_ entries,
+      scalar_nnz_view_t_ values)
+  {
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+    typedef typename KernelHandle::nnz_scalar_t scalar_type;
+
+    static_assert(KOKKOSKERNELS_SPCHOL_SAME_TYPE(typename lno_row_view_t_::non_const_value_type, size_type),
+        "spchol_numeric: A size_type must match KernelHandle size_type (const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPCHOL_SAME_TYPE(typename lno_nnz_view_t_::non_const_value_type, ordinal_type),
+        "spchol_numeric: A entry type must match KernelHandle entry type (aka nnz_lno_t, and const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPCHOL_SAME_TYPE(typename scalar_nnz_view_t_::value_type, scalar_type),
+        "spchol_numeric: A scalar type must match KernelHandle entry type (aka nnz_scalar_t, and const doesn't matter)");
+    static_assert(!Kokkos::Details::ArithTraits<scalar_type>::is_complex,
+        "spchol_numeric: only real scalar types are supported");
+
+    typedef typename KernelHandle::SPCHOLHandleType spcholHandleType;
+    spcholHandleType *sh = handle->get_spchol_handle();
+    if (sh == NULL){
+      throw std::runtime_error("spchol_numeric: the spchol handle has not been created, call create_spchol_handle first");
+    }
+    if (!sh->is_symbolic_complete()){
+      spchol_symbolic(handle, rowmap, entries);
+    }
+    if (sh->get_nnz_block_offsets().extent(0) != entries.extent(0)){
+      throw std::runtime_error("spchol_numeric: the number of entries of A must match the symbolic phase");
+    }
+
+    Impl::chol_numeric(handle, rowmap, entries, values);
+  }
+
+  /// \brief Solves A x = b with the factor of spchol_numeric.
+  ///
+  /// \param handle [in] kernel handle with the spchol handle factored.
+  /// \param b [in] right hand side, rank-1 view.
+  /// \param x [out] solution, rank-1 view.
+  template <typename KernelHandle,
+            class BType,
+            class XType>
+  void spchol_solve(
+      KernelHandle *handle,
+      BType b,
+      XType x)
+  {
+    static_assert(Kokkos::Impl::is_view<BType>::value,
+        "spchol_solve: b is not a Kokkos::View.");
+    static_assert(Kokkos::Impl::is_view<XType>::value,
+        "spchol_solve: x is not a Kokkos::View.");
+    static_assert(BType::rank == 1 && XType::rank == 1,
+        "spchol_solve: b and x must have rank 1.");
+    static_assert(std::is_same<typename XType::value_type,
+        typename XType::non_const_value_type>::value,
+        "spchol_solve: The output x must be nonconst.");
+
+    typedef typename KernelHandle::SPCHOLHandleType spcholHandleType;
+    spcholHandleType *sh = handle->get_spchol_handle();
+    if (sh == NULL){
+      throw std::runtime_error("spchol_solve: the spchol handle has not been created, call create_spchol_handle first");
+    }
+    if (!sh->is_numeric_complete()){
+      throw std::runtime_error("spchol_solve: the matrix has not been factored, call spchol_numeric first");
+    }
+    if (static_cast<size_t>(sh->get_nrows()) != b.extent(0) ||
+        static_cast<size_t>(sh->get_nrows()) != x.extent(0)){
+      throw std::runtime_error("spchol_solve: the lengths of b and x must match the number of rows of A");
+    }
+
+    Impl::chol_solve(handle, b, x);
+  }
+
+#undef KOKKOSKERNELS_SPCHOL_SAME_TYPE
+
+} // namespace Experimental
+} // namespace KokkosSparse
+
+#endif // KOKKOSSPARSE_SPCHOL_HPP_
@@ -0,0 +1,247 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_MemoryTraits.hpp>
+#include <Kokkos_Core.hpp>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "KokkosKernels_Utils.hpp"
+
+#ifndef _SPCHOLHANDLE_HPP
+#define _SPCHOLHANDLE_HPP
+
+namespace KokkosSparse{
+
+template <class size_type_, class lno_t_, class scalar_t_,
+          class ExecutionSpace,
+          class TemporaryMemorySpace,
+          class PersistentMemorySpace>
+class SPCHOLHandle{
+public:
+  typedef ExecutionSpace HandleExecSpace;
+  typedef TemporaryMemorySpace HandleTempMemorySpace;
+  typedef PersistentMemorySpace HandlePersistentMemorySpace;
+
+  typedef typename std::remove_const<size_type_>::type  size_type;
+  typedef const size_type const_size_type;
+
+  typedef typename std::remove_const<lno_t_>::type  nnz_lno_t;
+  typedef const nnz_lno_t const_nnz_lno_t;
+
+  typedef typename std::remove_const<scalar_t_>::type  nnz_scalar_t;
+  typedef const nnz_scalar_t const_nnz_scalar_t;
+
+  typedef typename Kokkos::View<size_type *, HandlePersistentMemorySpace> nnz_row_view_t;
+  typedef typename nnz_row_view_t::HostMirror nnz_row_view_host_t;
+
+  typedef typename Kokkos::View<nnz_lno_t *, HandlePersistentMemorySpace> nnz_lno_view_t;
+  typedef typename nnz_lno_view_t::HostMirror nnz_lno_view_host_t;
+
+  typedef typename Kokkos::View<nnz_scalar_t *, HandlePersistentMemorySpace> nnz_scalar_view_t;
+
+private:
+  //the factor is A = U^T U, with U = L^T. Supernode k holds the columns
+  //[supernode_ptr(k), supernode_ptr(k+1)) of L, which are the rows of a
+  //dense row major block of U of (width x (width + nrows)), where nrows
+  //are the rows of L below the supernode,
+  //supernode_rows[supernode_rows_ptr(k), supernode_rows_ptr(k+1)),
+  //in ascending order. The first width columns of a block are its upper
+  //triangular diagonal block. row_supernode is the supernode of each row.
+  nnz_lno_view_host_t h_supernode_ptr;
+  nnz_lno_t nsupernodes;
+  nnz_lno_view_t supernode_ptr;
+  nnz_row_view_t supernode_rows_ptr;
+  nnz_lno_view_t supernode_rows;
+  nnz_row_view_t supernode_block_ptr;
+  nnz_lno_view_t row_supernode;
+  nnz_scalar_view_t supernode_block_values;
+
+  //position of each entry of the lower triangle of A in the blocks,
+  //supernode_block_ptr(nsupernodes) for the entries above the diagonal.
+  nnz_row_view_t nnz_block_offsets;
+
+  //elimination tree of A, parent -1 for the roots.
+  nnz_lno_view_host_t etree;
+
+  //level schedule of the supernodes over the supernodal elimination tree:
+  //a supernode is factored after its children. supernode_level_ptr is kept
+  //on the host, as the numeric phase and the solve loop over the levels
+  //on the host. The update of each supernode to its ancestors is computed
+  //into update_work at supernode_update_ptr(i) - supernode_update_ptr of
+  //the first supernode of its level, i in the level order.
+  nnz_lno_view_t supernodes_grouped_by_level;
+  nnz_lno_view_host_t supernode_level_ptr;
+  nnz_lno_t nsupernode_levels;
+  nnz_row_view_t supernode_update_ptr;
+  nnz_scalar_view_t update_work;
+  nnz_scalar_view_t solve_work;
+
+  //supernodes are not grown past this many columns, 0 for no limit.
+  nnz_lno_t max_supernode_size;
+
+  nnz_lno_t nrows;
+  size_type nnzL;
+
+  bool symbolic_complete;
+  bool numeric_complete;
+
+public:
+
+  /**
+   * \brief Default constructor.
+   * \param nrows_: number of rows of the symmetric positive definite matrix to factor.
+   */
+  SPCHOLHandle(nnz_lno_t nrows_):
+    h_supernode_ptr(), nsupernodes(0), supernode_ptr(),
+    supernode_rows_ptr(), supernode_rows(), supernode_block_ptr(),
+    row_supernode(), supernode_block_values(), nnz_block_offsets(), etree(),
+    supernodes_grouped_by_level(), supernode_level_ptr(), nsupernode_levels(0),
+    supernode_update_ptr(), update_work(), solve_work(),
+    max_supernode_size(0), nrows(nrows_), nnzL(0),
+    symbolic_complete(false), numeric_complete(false)
+  {}
+
+  virtual ~SPCHOLHandle(){};
+
+  //getters
+  nnz_lno_t get_nrows() const { return this->nrows; }
+  size_type get_nnzL() const { return this->nnzL; }
+  nnz_lno_t get_max_supernode_size() const { return this->max_supernode_size; }
+
+  nnz_lno_t get_num_supernodes() const { return this->nsupernodes; }
+  nnz_lno_view_host_t get_host_supernode_ptr() const { return this->h_supernode_ptr; }
+  nnz_lno_view_t get_supernode_ptr() const { return this->supernode_ptr; }
+  nnz_row_view_t get_supernode_rows_ptr() const { return this->supernode_rows_ptr; }
+  nnz_lno_view_t get_supernode_rows() const { return this->supernode_rows; }
+  nnz_row_view_t get_supernode_block_ptr() const { return this->supernode_block_ptr; }
+  nnz_lno_view_t get_row_supernode() const { return this->row_supernode; }
+  nnz_scalar_view_t get_supernode_block_values() const { return this->supernode_block_values; }
+  nnz_row_view_t get_nnz_block_offsets() const { return this->nnz_block_offsets; }
+  nnz_lno_view_host_t get_etree() const { return this->etree; }
+
+  nnz_lno_view_t get_supernodes_grouped_by_level() const { return this->supernodes_grouped_by_level; }
+  nnz_lno_view_host_t get_supernode_level_ptr() const { return this->supernode_level_ptr; }
+  nnz_lno_t get_num_supernode_levels() const { return this->nsupernode_levels; }
+  nnz_row_view_t get_supernode_update_ptr() const { return this->supernode_update_ptr; }
+  nnz_scalar_view_t get_update_work() const { return this->update_work; }
+  nnz_scalar_view_t get_solve_work() const { return this->solve_work; }
+
+  bool is_symbolic_complete() const { return this->symbolic_complete; }
+  bool is_numeric_complete() const { return this->numeric_complete; }
+
+  //setters
+  /**
+   * \brief Limits the number of columns of a supernode. Smaller supernodes
+   * give more supernodes per level, larger ones larger dense blocks.
+   * 0 (the default) merges all the columns of a chain with the same
+   * structure.
+   */
+  void set_max_supernode_size(nnz_lno_t max_supernode_size_){
+    if (max_supernode_size_ < 0){
+      throw std::runtime_error("set_max_supernode_size: the size must not be negative");
+    }
+    this->max_supernode_size = max_supernode_size_;
+    this->symbolic_complete = false;
+    this->numeric_complete = false;
+  }
+
+  void set_etree(const nnz_lno_view_host_t &etree_){ this->etree = etree_; }
+
+  void set_supernode_structure(
+      nnz_lno_t nsupernodes_, size_type nnzL_,
+      const nnz_lno_view_host_t &h_supernode_ptr_,
+      const nnz_lno_view_t &supernode_ptr_,
+      const nnz_row_view_t &supernode_rows_ptr_,
+      const nnz_lno_view_t &supernode_rows_,
+      const nnz_row_view_t &supernode_block_ptr_,
+      const nnz_lno_view_t &row_supernode_,
+      const nnz_row_view_t &nnz_block_offsets_,
+      const nnz_scalar_view_t &supernode_block_values_,
+      const nnz_scalar_view_t &solve_work_){
+    this->nsupernodes = nsupernodes_;
+    this->nnzL = nnzL_;
+    this->h_supernode_ptr = h_supernode_ptr_;
+    this->supernode_ptr = supernode_ptr_;
+    this->supernode_rows_ptr = supernode_rows_ptr_;
+    this->supernode_rows = supernode_rows_;
+    this->supernode_block_ptr = supernode_block_ptr_;
+    this->row_supernode = row_supernode_;
+    this->nnz_block_offsets = nnz_block_offsets_;
+    this->supernode_block_values = supernode_block_values_;
+    this->solve_work = solve_work_;
+  }
+
+  void set_supernode_levels(
+      nnz_lno_t nsupernode_levels_,
+      const nnz_lno_view_t &supernodes_grouped_by_level_,
+      const nnz_lno_view_host_t &supernode_level_ptr_,
+      const nnz_row_view_t &supernode_update_ptr_,
+      const nnz_scalar_view_t &update_work_){
+    this->nsupernode_levels = nsupernode_levels_;
+    this->supernodes_grouped_by_level = supernodes_grouped_by_level_;
+    this->supernode_level_ptr = supernode_level_ptr_;
+    this->supernode_update_ptr = supernode_update_ptr_;
+    this->update_work = update_work_;
+  }
+
+  void set_nrows(nnz_lno_t nrows_){ this->nrows = nrows_; }
+  void set_symbolic_complete(bool complete = true){ this->symbolic_complete = complete; }
+  void set_numeric_complete(bool complete = true){ this->numeric_complete = complete; }
+  void reset_symbolic(){ this->symbolic_complete = false; this->numeric_complete = false; }
+
+  void print_algorithm(){
+    nnz_lno_t max_width = 0;
+    for (nnz_lno_t k = 0; k < this->nsupernodes; ++k){
+      if (max_width < this->h_supernode_ptr(k + 1) - this->h_supernode_ptr(k))
+        max_width = this->h_supernode_ptr(k + 1) - this->h_supernode_ptr(k);
+    }
+    std::cout << "SPCHOL, " << this->nnzL << " nonzeros in L, "
+              << this->nsupernodes << " supernodes, max supernode size " << max_width << ", "
+              << this->nsupernode_levels << " levels" << std::endl;
+  }
+};
+
+}
+
+#endif
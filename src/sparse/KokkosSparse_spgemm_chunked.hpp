@@ -0,0 +1,228 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_spgemm_chunked.hpp
+/// \brief Sparse matrix-matrix multiply C = A*B computed by row blocks
+///
+/// This file provides KokkosSparse::Experimental::spgemm_chunked and
+/// KokkosSparse::Experimental::spgemm_chunked_to_host. The rows of A are
+/// split into blocks so that the entries and values of a block of C fit into
+/// SPGEMMHandle::get_chunk_memory_budget() bytes, and C is computed block by
+/// block with spgemm_symbolic and spgemm_numeric. Only one block of C is in
+/// the memory of the execution space at a time, so C may be larger than the
+/// device memory.
+
+#ifndef KOKKOSSPARSE_SPGEMM_CHUNKED_HPP_
+#define KOKKOSSPARSE_SPGEMM_CHUNKED_HPP_
+
+#include <type_traits>
+#include <stdexcept>
+#include <limits>
+#include <vector>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_spgemm_symbolic.hpp"
+#include "KokkosSparse_spgemm_numeric.hpp"
+#include "KokkosSparse_spgemm_chunked_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+  /// \brief Computes C = A*B by blocks of rows of A, and calls
+  /// block_callback(row_begin, row_end, row_mapC, entriesC, valuesC) for
+  /// each block once it is computed. row_mapC has row_end - row_begin + 1
+  /// entries and starts from 0, entriesC and valuesC have the nonzeroes of
+  /// the block. The views live in the temporary memory space of the handle
+  /// and are overwritten by the next block, so the callback has to copy them.
+  ///
+  /// \param handle [in/out] kernel handle with the spgemm handle created.
+  /// \param m [in] number of rows of A and C.
+  /// \param n [in] number of columns of A, rows of B.
+  /// \param k [in] number of columns of B and C.
+  /// \param block_callback [in] called for each block, in the order of the rows.
+  template <typename KernelHandle,
+            typename a_row_view_t_, typename a_nnz_view_t_, typename a_scalar_view_t_,
+            typename b_row_view_t_, typename b_nnz_view_t_, typename b_scalar_view_t_,
+            typename block_callback_t>
+  void spgemm_chunked(
+      KernelHandle *handle,
+      typename KernelHandle::const_nnz_lno_t m,
+      typename KernelHandle::const_nnz_lno_t n,
+      typename KernelHandle::const_nnz_lno_t k,
+      a_row_view_t_ row_mapA, a_nnz_view_t_ entriesA, a_scalar_view_t_ valuesA,
+      b_row_view_t_ row_mapB, b_nnz_view_t_ entriesB, b_scalar_view_t_ valuesB,
+      const block_callback_t &block_callback)
+  {
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+    typedef typename KernelHandle::nnz_scalar_t scalar_t;
+    typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+    typedef typename KernelHandle::row_lno_temp_work_view_t row_view_t;
+    typedef typename KernelHandle::nnz_lno_temp_work_view_t nnz_view_t;
+    typedef typename KernelHandle::scalar_temp_work_view_t scalar_view_t;
+    typedef Kokkos::RangePolicy<MyExecSpace> range_policy_t;
+
+    if (handle->get_spgemm_handle() == NULL){
+      throw std::runtime_error("spgemm_chunked: the spgemm handle has not been created, call create_spgemm_handle first");
+    }
+    if (row_mapA.extent(0) != size_t (m + 1) || row_mapB.extent(0) != size_t (n + 1)){
+      throw std::runtime_error("spgemm_chunked: the row maps of A and B do not match m and n");
+    }
+    if (m == 0) return;
+
+    typename KernelHandle::SPGEMMHandleType *sh = handle->get_spgemm_handle();
+
+    size_t budget = sh->get_chunk_memory_budget();
+#if defined( KOKKOS_ENABLE_CUDA )
+    if (budget == 0 && handle->get_handle_exec_space() == KokkosKernels::Impl::Exec_CUDA){
+      size_t free_byte ;
+      size_t total_byte ;
+      cudaMemGetInfo( &free_byte, &total_byte ) ;
+      budget = free_byte / 2;
+    }
+#endif
+    size_type max_block_nnz = budget / (sizeof(nnz_lno_t) + sizeof(scalar_t));
+    if (budget == 0) max_block_nnz = std::numeric_limits<size_type>::max();
+    if (max_block_nnz == 0) max_block_nnz = 1;
+
+    std::vector<nnz_lno_t> block_begins;
+    const size_type max_block_flops = Impl::spgemm_chunked_row_blocks<KernelHandle>(
+        m, row_mapA, entriesA, row_mapB, max_block_nnz, block_begins);
+
+    //the contribution map of a block is not valid for the next one.
+    const bool reuse_contribution_map = sh->get_reuse_contribution_map();
+    sh->set_reuse_contribution_map(false);
+
+    //the multiplications of a block bound its nonzeroes, so the buffers are allocated once.
+    nnz_view_t entriesC_buffer(Kokkos::ViewAllocateWithoutInitializing("chunked entriesC"), max_block_flops);
+    scalar_view_t valuesC_buffer(Kokkos::ViewAllocateWithoutInitializing("chunked valuesC"), max_block_flops);
+
+    Kokkos::View<size_type *, typename a_row_view_t_::array_layout, Kokkos::HostSpace>
+      h_row_mapA(Kokkos::ViewAllocateWithoutInitializing("h_row_mapA"), m + 1);
+    Kokkos::deep_copy(h_row_mapA, row_mapA);
+
+    if (handle->get_verbose()){
+      std::cout << "\tspgemm_chunked num_blocks:" << block_begins.size() - 1
+                << " max_block_nnz:" << max_block_nnz
+                << " max_block_flops:" << max_block_flops << std::endl;
+    }
+
+    for (size_t b = 0; b + 1 < block_begins.size(); ++b){
+      const nnz_lno_t row_begin = block_begins[b];
+      const nnz_lno_t row_end = block_begins[b + 1];
+      const nnz_lno_t block_m = row_end - row_begin;
+
+      row_view_t block_row_mapA(Kokkos::ViewAllocateWithoutInitializing("chunked row_mapA"), block_m + 1);
+      Kokkos::parallel_for("KokkosSparse::spgemm_chunked::ShiftRowMap",
+          range_policy_t(0, block_m + 1),
+          Impl::SpgemmShiftRowMapFunctor<size_type, nnz_lno_t, a_row_view_t_, row_view_t>(
+              row_mapA, block_row_mapA, row_begin));
+      const std::pair<size_t, size_t> a_range(h_row_mapA(row_begin), h_row_mapA(row_end));
+      auto block_entriesA = Kokkos::subview(entriesA, a_range);
+      auto block_valuesA = Kokkos::subview(valuesA, a_range);
+
+      row_view_t block_row_mapC(Kokkos::ViewAllocateWithoutInitializing("chunked row_mapC"), block_m + 1);
+      spgemm_symbolic(
+          handle, block_m, n, k,
+          block_row_mapA, block_entriesA, false,
+          row_mapB, entriesB, false,
+          block_row_mapC);
+
+      const size_t block_nnz = sh->get_c_nnz();
+      nnz_view_t block_entriesC = Kokkos::subview(entriesC_buffer, std::make_pair(size_t (0), block_nnz));
+      scalar_view_t block_valuesC = Kokkos::subview(valuesC_buffer, std::make_pair(size_t (0), block_nnz));
+      spgemm_numeric(
+          handle, block_m, n, k,
+          block_row_mapA, block_entriesA, block_valuesA, false,
+          row_mapB, entriesB, valuesB, false,
+          block_row_mapC, block_entriesC, block_valuesC);
+      MyExecSpace::fence();
+
+      block_callback(row_begin, row_end, block_row_mapC, block_entriesC, block_valuesC);
+    }
+
+    sh->set_reuse_contribution_map(reuse_contribution_map);
+  }
+
+  /// \brief Computes C = A*B by blocks of rows of A as spgemm_chunked, and
+  /// gathers C in host memory. h_row_mapC, h_entriesC and h_valuesC are
+  /// allocated by the function.
+  template <typename KernelHandle,
+            typename a_row_view_t_, typename a_nnz_view_t_, typename a_scalar_view_t_,
+            typename b_row_view_t_, typename b_nnz_view_t_, typename b_scalar_view_t_,
+            typename h_row_view_t_, typename h_nnz_view_t_, typename h_scalar_view_t_>
+  void spgemm_chunked_to_host(
+      KernelHandle *handle,
+      typename KernelHandle::const_nnz_lno_t m,
+      typename KernelHandle::const_nnz_lno_t n,
+      typename KernelHandle::const_nnz_lno_t k,
+      a_row_view_t_ row_mapA, a_nnz_view_t_ entriesA, a_scalar_view_t_ valuesA,
+      b_row_view_t_ row_mapB, b_nnz_view_t_ entriesB, b_scalar_view_t_ valuesB,
+      h_row_view_t_ &h_row_mapC, h_nnz_view_t_ &h_entriesC, h_scalar_view_t_ &h_valuesC)
+  {
+    static_assert (std::is_same<typename h_row_view_t_::memory_space, Kokkos::HostSpace>::value &&
+        std::is_same<typename h_nnz_view_t_::memory_space, Kokkos::HostSpace>::value &&
+        std::is_same<typename h_scalar_view_t_::memory_space, Kokkos::HostSpace>::value,
+        "spgemm_chunked_to_host: output views must be in HostSpace.");
+
+    h_row_mapC = h_row_view_t_("h_row_mapC", m + 1);
+    h_entriesC = h_nnz_view_t_(Kokkos::ViewAllocateWithoutInitializing("h_entriesC"), entriesA.extent(0));
+    h_valuesC = h_scalar_view_t_(Kokkos::ViewAllocateWithoutInitializing("h_valuesC"), entriesA.extent(0));
+
+    Impl::SpgemmChunkedHostCopy<h_row_view_t_, h_nnz_view_t_, h_scalar_view_t_>
+      host_copy(h_row_mapC, h_entriesC, h_valuesC);
+    spgemm_chunked(
+        handle, m, n, k,
+        row_mapA, entriesA, valuesA,
+        row_mapB, entriesB, valuesB,
+        host_copy);
+
+    const size_t c_nnz = h_row_mapC(m);
+    Kokkos::resize(h_entriesC, c_nnz);
+    Kokkos::resize(h_valuesC, c_nnz);
+  }
+
+} // namespace Experimental
+} // namespace KokkosSparse
+
+#endif
@@ -45,6 +45,9 @@
 #include <Kokkos_Core.hpp>
 #include <iostream>
 #include <string>
+#include <stdint.h>
+#include "KokkosKernels_MemoryFootprint.hpp"
+#include "KokkosKernels_Prefetch.hpp"
 
 //#define KOKKOSKERNELS_ENABLE_TPL_CUSPARSE
 
@@ -87,11 +90,70 @@ enum SPGEMMAlgorithm{
 		SPGEMM_KK_COLOR,
 		SPGEMM_KK_MULTICOLOR,
 		SPGEMM_KK_MULTICOLOR2,
-		SPGEMM_KK_MEMSPEED};
+		SPGEMM_KK_MEMSPEED,
+		SPGEMM_KK_AUTO //CHOOSES KK_MEMORY, KK_SPEED OR KK_DENSE FROM MATRIX STATISTICS
+};
 
 enum SPGEMMAccumulator{
   SPGEMM_ACC_DEFAULT, SPGEMM_ACC_DENSE, SPGEMM_ACC_SPARSE,
 };
+
+/**
+ * \brief Timings (in seconds) and memory pool statistics of the last spgemm calls.
+ * Filled only if SPGEMMHandle::set_collect_stats(true) was called. A symbolic call
+ * resets the symbolic entries, a numeric call the numeric entries.
+ */
+struct SPGEMMStats{
+  //symbolic phase
+  double symbolic_time;
+  double compression_time;
+  double symbolic_pool_alloc_time;
+  double symbolic_hash_time;
+  size_t symbolic_pool_chunks;
+  size_t symbolic_pool_bytes;
+
+  //numeric phase
+  double numeric_time;
+  double numeric_pool_alloc_time;
+  double numeric_kernel_time;
+  size_t numeric_pool_chunks;
+  size_t numeric_pool_bytes;
+
+  //algorithm and accumulator used by the last call.
+  SPGEMMAlgorithm algorithm;
+  SPGEMMAccumulator accumulator;
+
+  SPGEMMStats(): algorithm(SPGEMM_DEFAULT), accumulator(SPGEMM_ACC_DEFAULT){
+    this->reset_symbolic();
+    this->reset_numeric();
+  }
+
+  void reset_symbolic(){
+    symbolic_time = compression_time = symbolic_pool_alloc_time = symbolic_hash_time = 0;
+    symbolic_pool_chunks = symbolic_pool_bytes = 0;
+  }
+
+  void reset_numeric(){
+    numeric_time = numeric_pool_alloc_time = numeric_kernel_time = 0;
+    numeric_pool_chunks = numeric_pool_bytes = 0;
+  }
+
+  void print(std::ostream &os) const {
+    os << "symbolic_time:" << symbolic_time
+       << " compression_time:" << compression_time
+       << " symbolic_pool_alloc_time:" << symbolic_pool_alloc_time
+       << " symbolic_hash_time:" << symbolic_hash_time
+       << " symbolic_pool_chunks:" << symbolic_pool_chunks
+       << " symbolic_pool_bytes:" << symbolic_pool_bytes << std::endl;
+    os << "numeric_time:" << numeric_time
+       << " numeric_pool_alloc_time:" << numeric_pool_alloc_time
+       << " numeric_kernel_time:" << numeric_kernel_time
+       << " numeric_pool_chunks:" << numeric_pool_chunks
+       << " numeric_pool_bytes:" << numeric_pool_bytes
+       << " algorithm:" << algorithm
+       << " accumulator:" << accumulator << std::endl;
+  }
+};
 template <class size_type_, class lno_t_, class scalar_t_,
           class ExecutionSpace,
           class TemporaryMemorySpace,
@@ -125,6 +187,8 @@ public:
   typedef typename Kokkos::View<nnz_lno_t *, HandlePersistentMemorySpace> nnz_lno_persistent_work_view_t;
   typedef typename nnz_lno_persistent_work_view_t::HostMirror nnz_lno_persistent_work_host_view_t; //Host view type
 
+  typedef typename Kokkos::View<unsigned int *, HandleTempMemorySpace> offset32_temp_work_view_t;
+
 
 
 
@@ -200,6 +264,17 @@ private:
 
   bool called_symbolic;
   bool called_numeric;
+  //fingerprint of the patterns the symbolic phase was called for, and the
+  //row map of C it computed.
+  uint64_t symbolic_pattern_hash;
+  row_lno_persistent_work_view_t symbolic_c_row_map;
+  //values of A, B and C, and the versions of A and B, the numeric phase of
+  //spgemm_update_values was called for.
+  const void *numeric_a_values;
+  const void *numeric_b_values;
+  const void *numeric_c_values;
+  size_t numeric_a_values_version;
+  size_t numeric_b_values_version;
 
   int suggested_vector_size;
   int suggested_team_size;
@@ -295,6 +370,66 @@ private:
   bool mkl_convert_to_1base;
   bool is_compression_single_step;
 
+  //statistics of the sampling pass used by SPGEMM_KK_AUTO.
+  bool auto_select_algorithm;
+  bool auto_apply_compression;
+  size_t auto_a_max_row_nnz, auto_max_row_flops;
+  double auto_a_avg_row_nnz, auto_avg_row_flops, auto_compression_ratio;
+  size_t auto_b_col_cnt;
+
+  //contribution map for the reuse of the numeric phase.
+  //for each multiplication of row i of A, the position of its result in entries of C.
+  bool reuse_contribution_map;
+  bool is_contribution_map_built;
+  row_lno_persistent_work_view_t contribution_map_row_ptr;
+  row_lno_persistent_work_view_t contribution_map;
+
+  //compressed B kept across the symbolic calls, keyed by the fingerprint of
+  //the pattern of B, see set_reuse_compressed_b.
+  bool reuse_compressed_b;
+  bool is_compressed_b_cached;
+  uint64_t compressed_b_cache_hash;
+  row_lno_temp_work_view_t compressed_b_cache_rowmap;
+  nnz_lno_temp_work_view_t compressed_b_cache_set_indices, compressed_b_cache_sets;
+
+  //32-bit copies of the row maps of A, B and C built by the symbolic phase
+  //of KKMEM for 64-bit size_type, see set_offsets32.
+  bool is_offsets32_cached;
+  offset32_temp_work_view_t row_mapA_offsets32, row_mapB_offsets32, row_mapC_offsets32;
+
+  //numeric phase of kk algorithms on rows binned by their work.
+  bool use_row_binning;
+
+  //timings of the calls, filled only if collect_stats is set.
+  bool collect_stats;
+  SPGEMMStats stats;
+
+  //bytes of C computed at once by spgemm_chunked, 0 to choose from free memory.
+  size_t chunk_memory_budget;
+
+  //bytes of the bounded rows of C allowed in spgemm_one_phase, 0 for no limit.
+  size_t one_phase_memory_budget;
+
+  //numeric phase writes the rows of C sorted by column.
+  bool sort_output_rows;
+
+  //numeric phase accumulates the products of single precision values in double.
+  bool high_precision_accumulation;
+
+  //hashmaps of the binned numeric phase use linear probing instead of chaining.
+  bool linear_probing_accumulator;
+
+  //triangle_generic relabels the vertices by degree before orienting the edges.
+  bool relabel_by_degree;
+  nnz_lno_persistent_work_view_t degree_relabel_permutation;
+  //seconds spent by triangle_generic before its counting kernel.
+  double triangle_preprocess_time;
+
+  //bytes the handle may hold and a call may allocate, 0 for no limit.
+  size_t memory_budget;
+  //largest scratch memory allocated by a call.
+  size_t temporary_peak_bytes;
+
   void set_mkl_sort_option(int mkl_sort_option_){
     this->mkl_sort_option = mkl_sort_option_;
   }
@@ -447,6 +582,9 @@ private:
   SPGEMMHandle(SPGEMMAlgorithm gs = SPGEMM_DEFAULT):
     algorithm_type(gs), accumulator_type(SPGEMM_ACC_DEFAULT), result_nnz_size(0),
     called_symbolic(false), called_numeric(false),
+    symbolic_pattern_hash(0), symbolic_c_row_map(),
+    numeric_a_values(NULL), numeric_b_values(NULL), numeric_c_values(NULL),
+    numeric_a_values_version(0), numeric_b_values_version(0),
     suggested_vector_size(0), suggested_team_size(0), max_nnz_inresult(0),
     c_column_indices(),
     tranpose_a_xadj(), tranpose_b_xadj(), tranpose_c_xadj(),
@@ -471,7 +609,27 @@ private:
 	original_max_row_flops(std::numeric_limits<size_t>::max()), original_overall_flops(std::numeric_limits<size_t>::max()),
     persistent_a_xadj(), persistent_b_xadj(), persistent_a_adj(), persistent_b_adj(), MaxColDenseAcc(250001),
     mkl_keep_output(true),
-    mkl_convert_to_1base(true), is_compression_single_step(false)
+    mkl_convert_to_1base(true), is_compression_single_step(false),
+    auto_select_algorithm(false), auto_apply_compression(true),
+    auto_a_max_row_nnz(0), auto_max_row_flops(0),
+    auto_a_avg_row_nnz(0), auto_avg_row_flops(0), auto_compression_ratio(1),
+    auto_b_col_cnt(0),
+    reuse_contribution_map(false), is_contribution_map_built(false),
+    contribution_map_row_ptr(), contribution_map(),
+    reuse_compressed_b(false), is_compressed_b_cached(false), compressed_b_cache_hash(0),
+    compressed_b_cache_rowmap(), compressed_b_cache_set_indices(), compressed_b_cache_sets(),
+    is_offsets32_cached(false), row_mapA_offsets32(), row_mapB_offsets32(), row_mapC_offsets32(),
+    use_row_binning(false),
+    collect_stats(false), stats(),
+    chunk_memory_budget(0),
+    one_phase_memory_budget(0),
+    sort_output_rows(false),
+    high_precision_accumulation(false),
+    linear_probing_accumulator(false),
+    relabel_by_degree(false),
+    degree_relabel_permutation(),
+    triangle_preprocess_time(0),
+    memory_budget(0), temporary_peak_bytes(0)
 #ifdef KOKKOSKERNELS_ENABLE_TPL_CUSPARSE
   ,cuSPARSEHandle(NULL)
 #endif
@@ -479,6 +637,9 @@ private:
     if (gs == SPGEMM_DEFAULT){
       this->choose_default_algorithm();
     }
+    else if (gs == SPGEMM_KK_AUTO){
+      this->set_algorithm_type(gs);
+    }
   }
 
 
@@ -505,32 +666,34 @@ private:
     return this->cuSPARSEHandle;
   }
 #endif
-    /** \brief Chooses best algorithm based on the execution space. COLORING_EB if cuda, COLORING_VB otherwise.
+    /** \brief Chooses best algorithm based on the execution space. SPGEMM_CUSPARSE if cuda,
+   * otherwise SPGEMM_KK_AUTO, which picks the multithreaded dense or hash accumulator
+   * variant from the row statistics of A and B in the symbolic phase.
    */
   void choose_default_algorithm(){
 #if defined( KOKKOS_ENABLE_SERIAL )
     if (Kokkos::Impl::is_same< Kokkos::Serial , ExecutionSpace >::value){
-      this->algorithm_type = SPGEMM_SERIAL;
+      this->set_algorithm_type(SPGEMM_KK_AUTO);
 #ifdef VERBOSE
-      std::cout << "Serial Execution Space, Default Algorithm: SPGEMM_SERIAL" << std::endl;
+      std::cout << "Serial Execution Space, Default Algorithm: SPGEMM_KK_AUTO" << std::endl;
 #endif
     }
 #endif
 
 #if defined( KOKKOS_ENABLE_THREADS )
     if (Kokkos::Impl::is_same< Kokkos::Threads , ExecutionSpace >::value){
-      this->algorithm_type = SPGEMM_SERIAL;
+      this->set_algorithm_type(SPGEMM_KK_AUTO);
 #ifdef VERBOSE
-      std::cout << "THREADS Execution Space, Default Algorithm: SPGEMM_SERIAL" << std::endl;
+      std::cout << "THREADS Execution Space, Default Algorithm: SPGEMM_KK_AUTO" << std::endl;
 #endif
     }
 #endif
 
 #if defined( KOKKOS_ENABLE_OPENMP )
     if (Kokkos::Impl::is_same< Kokkos::OpenMP, ExecutionSpace >::value){
-      this->algorithm_type = SPGEMM_SERIAL;
+      this->set_algorithm_type(SPGEMM_KK_AUTO);
 #ifdef VERBOSE
-      std::cout << "OpenMP Execution Space, Default Algorithm: SPGEMM_SERIAL" << std::endl;
+      std::cout << "OpenMP Execution Space, Default Algorithm: SPGEMM_KK_AUTO" << std::endl;
 #endif
     }
 #endif
@@ -546,9 +709,9 @@ private:
 
 #if defined( KOKKOS_ENABLE_QTHREAD)
     if (Kokkos::Impl::is_same< Kokkos::Qthread, ExecutionSpace >::value){
-      this->algorithm_type = SPGEMM_SERIAL;
+      this->set_algorithm_type(SPGEMM_KK_AUTO);
 #ifdef VERBOSE
-      std::cout << "Qthread Execution Space, Default Algorithm: SPGEMM_SERIAL" << std::endl;
+      std::cout << "Qthread Execution Space, Default Algorithm: SPGEMM_KK_AUTO" << std::endl;
 #endif
     }
 #endif
@@ -572,6 +735,27 @@ private:
 
   bool is_symbolic_called(){return this->called_symbolic;}
   bool is_numeric_called(){return this->called_numeric;}
+  /**
+   * \brief True if the symbolic phase was called for patterns with the
+   * given fingerprint (see KokkosKernels::Impl::kk_hash_graph).
+   */
+  bool is_symbolic_called_for(uint64_t pattern_hash){
+    return this->called_symbolic && this->symbolic_pattern_hash == pattern_hash;
+  }
+  uint64_t get_symbolic_pattern_hash(){return this->symbolic_pattern_hash;}
+  row_lno_persistent_work_view_t get_symbolic_c_row_map(){return this->symbolic_c_row_map;}
+  /**
+   * \brief True if the numeric phase was called for these values of A, B and
+   * C at these values versions of A and B (see
+   * KokkosSparse::CrsMatrix::valuesVersion()).
+   */
+  bool is_numeric_called_for(const void *a_values, size_t a_values_version,
+      const void *b_values, size_t b_values_version, const void *c_values){
+    return this->numeric_c_values != NULL &&
+        this->numeric_a_values == a_values && this->numeric_a_values_version == a_values_version &&
+        this->numeric_b_values == b_values && this->numeric_b_values_version == b_values_version &&
+        this->numeric_c_values == c_values;
+  }
 
 
   nnz_lno_t get_max_result_nnz() const{
@@ -584,9 +768,403 @@ private:
 
 
   //setters
-  void set_algorithm_type(const SPGEMMAlgorithm &sgs_algo){this->algorithm_type = sgs_algo;}
+  void set_algorithm_type(const SPGEMMAlgorithm &sgs_algo){
+    //SPGEMM_KK_AUTO is a selection mode, the actual algorithm is chosen
+    //by the symbolic phase. Until then run as SPGEMM_KK.
+    this->auto_select_algorithm = (sgs_algo == SPGEMM_KK_AUTO);
+    this->algorithm_type = this->auto_select_algorithm ? SPGEMM_KK : sgs_algo;
+  }
+
+  /**
+   * \brief returns true if the algorithm is chosen by the symbolic phase (SPGEMM_KK_AUTO).
+   */
+  bool is_auto_select_algorithm() const {return this->auto_select_algorithm;}
+
+  /**
+   * \brief records the decision of the automatic selection. The algorithm and
+   * accumulator are reused by numeric, and by later symbolic calls until the
+   * statistics are collected again.
+   * \param algo: the selected kkmem/speed/dense algorithm.
+   * \param acc: the accumulator type of the selection.
+   * \param apply_compression: whether compressing B is expected to pay off.
+   */
+  void set_auto_selected_algorithm(
+      const SPGEMMAlgorithm &algo, const SPGEMMAccumulator &acc, bool apply_compression){
+    this->algorithm_type = algo;
+    this->accumulator_type = acc;
+    this->auto_apply_compression = apply_compression;
+  }
+
+  bool get_auto_apply_compression() const {return this->auto_apply_compression;}
+
+  /**
+   * \brief When set, the first numeric call of the kk algorithms stores for each
+   * multiplication of A*B the position of its result in C. The later numeric calls
+   * with the same pattern only gather, multiply and scatter, without hashing.
+   * The map needs one size_type per multiplication.
+   * \param reuse_: whether to build and use the contribution map.
+   */
+  void set_reuse_contribution_map(bool reuse_){
+    this->reuse_contribution_map = reuse_;
+    if (!reuse_) this->reset_contribution_map();
+  }
+  bool get_reuse_contribution_map() const {return this->reuse_contribution_map;}
+
+  bool get_contribution_map_built() const {return this->is_contribution_map_built;}
+
+  /**
+   * \brief When set, the symbolic phases of the kk and triangle algorithms keep
+   * the compressed B, and later calls with the same pattern of B skip the
+   * compression. Only the flop reduction, which depends on A, is checked again.
+   * \param reuse_: whether to keep and use the compressed B.
+   */
+  void set_reuse_compressed_b(bool reuse_){
+    this->reuse_compressed_b = reuse_;
+    if (!reuse_) this->reset_compressed_b_cache();
+  }
+  bool get_reuse_compressed_b() const {return this->reuse_compressed_b;}
+
+  /**
+   * \brief Keeps the compressed B of a B with the given fingerprint. The row map
+   * is copied, as the symbolic phase takes it from the workspace.
+   */
+  void set_compressed_b_cache(
+      uint64_t b_pattern_hash,
+      row_lno_temp_work_view_t compressed_b_rowmap_,
+      nnz_lno_temp_work_view_t compressed_b_set_indices_,
+      nnz_lno_temp_work_view_t compressed_b_sets_){
+    this->is_compressed_b_cached = true;
+    this->compressed_b_cache_hash = b_pattern_hash;
+    this->compressed_b_cache_rowmap = row_lno_temp_work_view_t(
+        Kokkos::ViewAllocateWithoutInitializing("compressed B row map"), compressed_b_rowmap_.extent(0));
+    Kokkos::deep_copy(this->compressed_b_cache_rowmap, compressed_b_rowmap_);
+    this->compressed_b_cache_set_indices = compressed_b_set_indices_;
+    this->compressed_b_cache_sets = compressed_b_sets_;
+  }
+
+  /**
+   * \brief The compressed B kept for a B with the given fingerprint (see
+   * KokkosKernels::Impl::kk_hash_graph), false if there is none.
+   */
+  bool get_compressed_b_cache(
+      uint64_t b_pattern_hash,
+      row_lno_temp_work_view_t &compressed_b_rowmap_,
+      nnz_lno_temp_work_view_t &compressed_b_set_indices_,
+      nnz_lno_temp_work_view_t &compressed_b_sets_) const {
+    if (!this->is_compressed_b_cached || this->compressed_b_cache_hash != b_pattern_hash) return false;
+    compressed_b_rowmap_ = this->compressed_b_cache_rowmap;
+    compressed_b_set_indices_ = this->compressed_b_cache_set_indices;
+    compressed_b_sets_ = this->compressed_b_cache_sets;
+    return true;
+  }
+
+  void reset_compressed_b_cache(){
+    this->is_compressed_b_cached = false;
+    this->compressed_b_cache_hash = 0;
+    this->compressed_b_cache_rowmap = row_lno_temp_work_view_t();
+    this->compressed_b_cache_set_indices = nnz_lno_temp_work_view_t();
+    this->compressed_b_cache_sets = nnz_lno_temp_work_view_t();
+  }
+
+  /**
+   * \brief Keeps the 32-bit copies of the row maps of A, B and C, so that
+   * every numeric call after the symbolic one reads them without copying.
+   */
+  void set_offsets32(
+      offset32_temp_work_view_t row_mapA_offsets32_,
+      offset32_temp_work_view_t row_mapB_offsets32_,
+      offset32_temp_work_view_t row_mapC_offsets32_){
+    this->is_offsets32_cached = true;
+    this->row_mapA_offsets32 = row_mapA_offsets32_;
+    this->row_mapB_offsets32 = row_mapB_offsets32_;
+    this->row_mapC_offsets32 = row_mapC_offsets32_;
+  }
+
+  /**
+   * \brief The 32-bit copies of the row maps kept by set_offsets32, false if
+   * there are none.
+   */
+  bool get_offsets32(
+      offset32_temp_work_view_t &row_mapA_offsets32_,
+      offset32_temp_work_view_t &row_mapB_offsets32_,
+      offset32_temp_work_view_t &row_mapC_offsets32_) const {
+    if (!this->is_offsets32_cached) return false;
+    row_mapA_offsets32_ = this->row_mapA_offsets32;
+    row_mapB_offsets32_ = this->row_mapB_offsets32;
+    row_mapC_offsets32_ = this->row_mapC_offsets32;
+    return true;
+  }
+
+  void reset_offsets32(){
+    this->is_offsets32_cached = false;
+    this->row_mapA_offsets32 = offset32_temp_work_view_t();
+    this->row_mapB_offsets32 = offset32_temp_work_view_t();
+    this->row_mapC_offsets32 = offset32_temp_work_view_t();
+  }
+
+  /**
+   * \brief The graph of A^T built by the symbolic phase of spgemm_normal,
+   * used again by its numeric phase. Values of A^T are never stored.
+   */
+  void set_transpose_a_graph(row_lno_temp_work_view_t xadj, nnz_lno_temp_work_view_t adj){
+    this->tranpose_a_xadj = xadj;
+    this->tranpose_a_adj = adj;
+  }
+  row_lno_temp_work_view_t get_transpose_a_xadj() const {return this->tranpose_a_xadj;}
+  nnz_lno_temp_work_view_t get_transpose_a_adj() const {return this->tranpose_a_adj;}
+
+  /**
+   * \brief Uses the compressed B kept by other, e.g. the handle of an earlier
+   * product of an AMG hierarchy with the same B, and sets reuse_compressed_b.
+   * The views are shared, not copied.
+   */
+  void share_compressed_b(const SPGEMMHandle &other){
+    this->reuse_compressed_b = true;
+    this->is_compressed_b_cached = other.is_compressed_b_cached;
+    this->compressed_b_cache_hash = other.compressed_b_cache_hash;
+    this->compressed_b_cache_rowmap = other.compressed_b_cache_rowmap;
+    this->compressed_b_cache_set_indices = other.compressed_b_cache_set_indices;
+    this->compressed_b_cache_sets = other.compressed_b_cache_sets;
+  }
+
+  void set_contribution_map(
+      row_lno_persistent_work_view_t contribution_map_row_ptr_,
+      row_lno_persistent_work_view_t contribution_map_){
+    this->contribution_map_row_ptr = contribution_map_row_ptr_;
+    this->contribution_map = contribution_map_;
+    this->is_contribution_map_built = true;
+  }
+
+  row_lno_persistent_work_view_t get_contribution_map_row_ptr() {return this->contribution_map_row_ptr;}
+  row_lno_persistent_work_view_t get_contribution_map() {return this->contribution_map;}
+
+  /**
+   * \brief releases the contribution map. Called by symbolic as the pattern of C may change.
+   */
+  void reset_contribution_map(){
+    this->contribution_map_row_ptr = row_lno_persistent_work_view_t();
+    this->contribution_map = row_lno_persistent_work_view_t();
+    this->is_contribution_map_built = false;
+  }
+
+  /**
+   * \brief When set, the numeric phase of SPGEMM_KK and SPGEMM_KK_MEMORY assigns
+   * the rows of C to bins by their work and runs a kernel per bin: rows with a few
+   * multiplications are computed by a thread, rows that fit into shared memory with
+   * a hashmap of a thread, and the rest with a dense accumulator from the memory pool.
+   * \param use_row_binning_: whether to bin the rows in numeric phase.
+   */
+  void set_row_binning(bool use_row_binning_){this->use_row_binning = use_row_binning_;}
+  bool get_row_binning() const {return this->use_row_binning;}
+
+  /**
+   * \brief When set, the spgemm calls record their timings and memory pool
+   * statistics, which can be queried with get_stats() after each call.
+   * \param collect_stats_: whether to fill the statistics.
+   */
+  void set_collect_stats(bool collect_stats_){this->collect_stats = collect_stats_;}
+  bool get_collect_stats() const {return this->collect_stats;}
+  const SPGEMMStats &get_stats() const {return this->stats;}
+
+  /**
+   * \brief Bytes of entries and values of C that spgemm_chunked computes at once.
+   * The rows of A are split into blocks whose multiplications fit into the budget.
+   * If 0, the budget is half of the free memory on GPUs, and C is computed
+   * in a single block otherwise.
+   */
+  void set_chunk_memory_budget(size_t chunk_memory_budget_){this->chunk_memory_budget = chunk_memory_budget_;}
+  size_t get_chunk_memory_budget() const {return this->chunk_memory_budget;}
+
+  /**
+   * \brief Bytes of entries and values that spgemm_one_phase may allocate for the
+   * rows of C bounded by their multiplications. If the bound needs more,
+   * spgemm_one_phase runs the symbolic and numeric phases instead. 0 for no limit.
+   */
+  void set_one_phase_memory_budget(size_t one_phase_memory_budget_){this->one_phase_memory_budget = one_phase_memory_budget_;}
+  size_t get_one_phase_memory_budget() const {return this->one_phase_memory_budget;}
+
+  /**
+   * \brief When set, the numeric phase of the kk algorithms writes each row of C
+   * with increasing column indices, so C needs no sort afterwards.
+   * The rows are sorted by the binned numeric kernels while they are computed.
+   * \param sort_output_rows_: whether to sort the rows of C.
+   */
+  void set_sort_output_rows(bool sort_output_rows_){this->sort_output_rows = sort_output_rows_;}
+  bool get_sort_output_rows() const {return this->sort_output_rows;}
+
+  /**
+   * \brief When set, the numeric phase of the kk algorithms sums the products of
+   * float (or complex float) values in double, and rounds each value of C once.
+   * A, B and C keep their single precision storage, the kernels run on the binned
+   * path with the accumulators in shared memory or in the memory pool.
+   * \param high_precision_accumulation_: whether to accumulate in double.
+   */
+  void set_high_precision_accumulation(bool high_precision_accumulation_){
+    this->high_precision_accumulation = high_precision_accumulation_;
+  }
+  bool get_high_precision_accumulation() const {return this->high_precision_accumulation;}
+
+  /**
+   * \brief When set, the numeric phase of the kk algorithms runs on the binned
+   * path, and the hashmaps of its medium and huge rows use open addressing with
+   * linear probing, so that the vector lanes probe contiguous slots instead of
+   * following linked lists.
+   * \param linear_probing_accumulator_: whether to use linear probing hashmaps.
+   */
+  void set_linear_probing_accumulator(bool linear_probing_accumulator_){
+    this->linear_probing_accumulator = linear_probing_accumulator_;
+  }
+  bool get_linear_probing_accumulator() const {return this->linear_probing_accumulator;}
+
+  /**
+   * \brief When set, triangle_generic renumbers the vertices of the graph by degree
+   * in parallel (the order follows sort_option as for sort_lower_triangular), builds
+   * the permuted graph, and extracts its lower triangle without further permutation,
+   * so edges are oriented by degree and rows of similar degree are close in memory.
+   * The rows given to the visitor are then the new labels; get_degree_relabel_permutation
+   * maps the original vertices to them.
+   * \param relabel_by_degree_: whether to relabel the graph.
+   */
+  void set_relabel_by_degree(bool relabel_by_degree_){
+    this->relabel_by_degree = relabel_by_degree_;
+  }
+  bool get_relabel_by_degree() const {return this->relabel_by_degree;}
+
+  void set_degree_relabel_permutation(nnz_lno_persistent_work_view_t degree_relabel_permutation_){
+    this->degree_relabel_permutation = degree_relabel_permutation_;
+  }
+  /**
+   * \brief The new label of each original vertex, after a triangle_generic call with
+   * relabel_by_degree set.
+   */
+  nnz_lno_persistent_work_view_t get_degree_relabel_permutation() const {return this->degree_relabel_permutation;}
+
+  void set_triangle_preprocess_time(double triangle_preprocess_time_){
+    this->triangle_preprocess_time = triangle_preprocess_time_;
+  }
+  /**
+   * \brief Seconds spent by the last triangle_generic call on relabeling, sorting,
+   * and building the lower triangular and incidence matrices.
+   */
+  double get_triangle_preprocess_time() const {return this->triangle_preprocess_time;}
+
+  /**
+   * \brief Bytes the handle may hold between calls plus the scratch memory of
+   * a call, 0 (the default) for no limit. Within a budget, the kk algorithms
+   * use the hashmap accumulators of SPGEMM_KK_MEMORY instead of the dense
+   * accumulators of SPGEMM_KK_SPEED and SPGEMM_KK_DENSE when one dense
+   * accumulator per thread does not fit.
+   */
+  void set_memory_budget(size_t memory_budget_){this->memory_budget = memory_budget_;}
+  size_t get_memory_budget() const {return this->memory_budget;}
+
+  /**
+   * \brief Calls visitor.add_persistent and visitor.add_temporary for the
+   * views kept by the handle in each memory space.
+   */
+  template <typename visitor_t>
+  void visit_views(visitor_t &visitor) const {
+    visitor.add_persistent(this->symbolic_c_row_map);
+    visitor.add_persistent(this->color_adj);
+    visitor.add_persistent(this->vertex_colors);
+    visitor.add_persistent(this->min_result_row_for_each_row);
+    visitor.add_persistent(this->lower_triangular_permutation);
+    visitor.add_persistent(this->lower_triangular_matrix_rowmap);
+    visitor.add_persistent(this->lower_triangular_matrix_entries);
+    visitor.add_persistent(this->incidence_matrix_row_map);
+    visitor.add_persistent(this->incidence_matrix_entries);
+    visitor.add_persistent(this->row_flops);
+    visitor.add_persistent(this->persistent_c_xadj);
+    visitor.add_persistent(this->persistent_a_xadj);
+    visitor.add_persistent(this->persistent_b_xadj);
+    visitor.add_persistent(this->persistent_a_adj);
+    visitor.add_persistent(this->persistent_b_adj);
+    visitor.add_persistent(this->contribution_map_row_ptr);
+    visitor.add_persistent(this->contribution_map);
+    visitor.add_persistent(this->degree_relabel_permutation);
+    visitor.add_persistent(this->compressed_b_cache_rowmap);
+    visitor.add_persistent(this->compressed_b_cache_set_indices);
+    visitor.add_persistent(this->compressed_b_cache_sets);
+    visitor.add_persistent(this->row_mapA_offsets32);
+    visitor.add_persistent(this->row_mapB_offsets32);
+    visitor.add_persistent(this->row_mapC_offsets32);
+    visitor.add_temporary(this->compressed_b_rowmap);
+    visitor.add_temporary(this->compressed_b_set_indices);
+    visitor.add_temporary(this->compressed_b_sets);
+    visitor.add_temporary(this->compressed_c_rowmap);
+    visitor.add_temporary(this->c_column_indices);
+    visitor.add_temporary(this->tranpose_a_xadj);
+    visitor.add_temporary(this->tranpose_b_xadj);
+    visitor.add_temporary(this->tranpose_c_xadj);
+    visitor.add_temporary(this->tranpose_a_adj);
+    visitor.add_temporary(this->tranpose_b_adj);
+    visitor.add_temporary(this->tranpose_c_adj);
+  }
+
+  /**
+   * \brief The bytes of the views kept by the handle, and the largest memory
+   * pool allocated by a symbolic or numeric call.
+   */
+  KokkosKernels::MemoryFootprint get_memory_footprint() const {
+    KokkosKernels::MemoryFootprint footprint;
+    this->visit_views(footprint);
+    footprint.temporary_peak_bytes = this->temporary_peak_bytes;
+    return footprint;
+  }
+
+  /**
+   * \brief Prefetches the views kept by the handle to the device of exec, when
+   * they are in unified memory.
+   */
+  template <typename exec_space>
+  void prefetch(const exec_space &exec) const {
+    KokkosKernels::Impl::MemoryPrefetch<exec_space> prefetcher(exec);
+    this->visit_views(prefetcher);
+  }
+
+  void record_temporary_bytes(size_t bytes){
+    if (bytes > this->temporary_peak_bytes) this->temporary_peak_bytes = bytes;
+  }
+
+  /**
+   * \brief True if a dense accumulator over num_cols columns for each of
+   * concurrency threads fits into the memory budget.
+   */
+  bool dense_accumulator_fits(size_t num_cols, size_t concurrency) const {
+    return KokkosKernels::Impl::kk_fits_memory_budget(
+        this->memory_budget, this->get_memory_footprint(),
+        concurrency * num_cols * (sizeof(nnz_scalar_t) + sizeof(nnz_lno_t)));
+  }
+
+  void record_pool_stats(bool numeric_phase, double alloc_time, size_t num_chunks, size_t pool_bytes){
+    this->record_temporary_bytes(pool_bytes);
+    if (!this->collect_stats) return;
+    if (numeric_phase){
+      this->stats.numeric_pool_alloc_time += alloc_time;
+      this->stats.numeric_pool_chunks += num_chunks;
+      this->stats.numeric_pool_bytes += pool_bytes;
+    }
+    else {
+      this->stats.symbolic_pool_alloc_time += alloc_time;
+      this->stats.symbolic_pool_chunks += num_chunks;
+      this->stats.symbolic_pool_bytes += pool_bytes;
+    }
+  }
+
   void set_call_symbolic(bool call = true){this->called_symbolic = call;}
+  void set_symbolic_pattern(uint64_t pattern_hash, row_lno_persistent_work_view_t c_row_map){
+    this->symbolic_pattern_hash = pattern_hash;
+    this->symbolic_c_row_map = c_row_map;
+  }
   void set_call_numeric(bool call = true){this->called_numeric = call;}
+  void set_numeric_values(const void *a_values, size_t a_values_version,
+      const void *b_values, size_t b_values_version, const void *c_values){
+    this->numeric_a_values = a_values;
+    this->numeric_a_values_version = a_values_version;
+    this->numeric_b_values = b_values;
+    this->numeric_b_values_version = b_values_version;
+    this->numeric_c_values = c_values;
+  }
 
   void set_max_result_nnz(nnz_lno_t num_result_nnz_){
     this->max_nnz_inresult = num_result_nnz_;
@@ -693,6 +1271,7 @@ private:
     else if(name=="SPGEMM_KK_DENSE")       return SPGEMM_KK_DENSE;
     else if(name=="SPGEMM_KK_LP")  		   return SPGEMM_KK_LP;
     else if(name=="SPGEMM_KK_MEMSPEED")    return SPGEMM_KK;
+    else if(name=="SPGEMM_KK_AUTO")        return SPGEMM_KK_AUTO;
 
     else if(name=="SPGEMM_DEBUG")          return SPGEMM_SERIAL;
     else if(name=="SPGEMM_SERIAL")         return SPGEMM_SERIAL;
@@ -0,0 +1,172 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_spgemm_normal.hpp
+/// \brief Sparse products C = A*A^T and C = A^T*A without transposing A
+///
+/// This file provides KokkosSparse::Experimental::spgemm_normal_symbolic and
+/// KokkosSparse::Experimental::spgemm_normal_numeric. Only the graph of A^T
+/// is built, in the symbolic phase, and kept in the spgemm handle; the
+/// values of A^T are never formed. A*A^T computes each entry as the
+/// intersection of two sorted rows of A, A^T*A sums the rows of A scaled by
+/// the entries of a column of A. The entries of each row of A must be
+/// sorted and unique.
+
+#ifndef KOKKOSSPARSE_SPGEMM_NORMAL_HPP_
+#define KOKKOSSPARSE_SPGEMM_NORMAL_HPP_
+
+#include <type_traits>
+#include <stdexcept>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_spgemm_normal_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+enum SpgemmNormalProduct{
+  SPGEMM_A_AT, //C = A*A^T, m x m
+  SPGEMM_AT_A  //C = A^T*A, n x n
+};
+
+#define KOKKOSKERNELS_SPGEMM_NORMAL_SAME_TYPE(A, B) std::is_same<typename std::remove_const<A>::type, typename std::remove_const<B>::type>::value
+
+  /// \brief Symbolic phase of C = A*A^T or C = A^T*A. Computes the row map
+  /// of C, and the number of nonzeroes of C, returned by
+  /// handle->get_spgemm_handle()->get_c_nnz().
+  ///
+  /// \param handle [in/out] kernel handle with the spgemm handle created.
+  /// \param product [in] SPGEMM_A_AT or SPGEMM_AT_A.
+  /// \param m [in] number of rows of A.
+  /// \param n [in] number of columns of A.
+  /// \param row_mapC [out] row map of C, of size m + 1 for A*A^T and
+  /// n + 1 for A^T*A.
+  template <typename KernelHandle,
+            typename a_row_view_t_, typename a_nnz_view_t_,
+            typename c_row_view_t_>
+  void spgemm_normal_symbolic(
+      KernelHandle *handle,
+      SpgemmNormalProduct product,
+      typename KernelHandle::const_nnz_lno_t m,
+      typename KernelHandle::const_nnz_lno_t n,
+      a_row_view_t_ row_mapA, a_nnz_view_t_ entriesA,
+      c_row_view_t_ row_mapC)
+  {
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+
+    static_assert (std::is_same<typename c_row_view_t_::value_type,
+        typename c_row_view_t_::non_const_value_type>::value,
+        "spgemm_normal_symbolic: Output matrix rowmap must be non-const.");
+    static_assert(KOKKOSKERNELS_SPGEMM_NORMAL_SAME_TYPE(typename a_row_view_t_::non_const_value_type, size_type) &&
+                  KOKKOSKERNELS_SPGEMM_NORMAL_SAME_TYPE(typename c_row_view_t_::non_const_value_type, size_type),
+        "spgemm_normal_symbolic: size_type of A and C must match KernelHandle size_type (const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPGEMM_NORMAL_SAME_TYPE(typename a_nnz_view_t_::non_const_value_type, ordinal_type),
+        "spgemm_normal_symbolic: entry type of A must match KernelHandle entry type (aka nnz_lno_t, and const doesn't matter)");
+
+    const bool a_at = product == SPGEMM_A_AT;
+    if (handle->get_spgemm_handle() == NULL){
+      throw std::runtime_error("spgemm_normal_symbolic: the spgemm handle has not been created, call create_spgemm_handle first");
+    }
+    if (row_mapA.extent(0) != size_t (m + 1) || row_mapC.extent(0) != size_t ((a_at ? m : n) + 1)){
+      throw std::runtime_error("spgemm_normal_symbolic: the row maps of A and C do not match m and n");
+    }
+
+    Impl::spgemm_normal_symbolic_impl(
+        handle, a_at, m, n,
+        row_mapA, entriesA,
+        row_mapC);
+  }
+
+  /// \brief Numeric phase of C = A*A^T or C = A^T*A. spgemm_normal_symbolic
+  /// must have been called with the same pattern of A and the same product.
+  /// entriesC and valuesC must have get_c_nnz() entries. The entries of a
+  /// row of C are not sorted.
+  template <typename KernelHandle,
+            typename a_row_view_t_, typename a_nnz_view_t_, typename a_scalar_view_t_,
+            typename c_row_view_t_, typename c_nnz_view_t_, typename c_scalar_view_t_>
+  void spgemm_normal_numeric(
+      KernelHandle *handle,
+      SpgemmNormalProduct product,
+      typename KernelHandle::const_nnz_lno_t m,
+      typename KernelHandle::const_nnz_lno_t n,
+      a_row_view_t_ row_mapA, a_nnz_view_t_ entriesA, a_scalar_view_t_ valuesA,
+      c_row_view_t_ row_mapC, c_nnz_view_t_ entriesC, c_scalar_view_t_ valuesC)
+  {
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+    typedef typename KernelHandle::nnz_scalar_t scalar_type;
+
+    static_assert (std::is_same<typename c_nnz_view_t_::value_type,
+        typename c_nnz_view_t_::non_const_value_type>::value &&
+        std::is_same<typename c_scalar_view_t_::value_type,
+        typename c_scalar_view_t_::non_const_value_type>::value,
+        "spgemm_normal_numeric: Output matrix entries and values must be non-const.");
+    static_assert(KOKKOSKERNELS_SPGEMM_NORMAL_SAME_TYPE(typename c_nnz_view_t_::value_type, ordinal_type),
+        "spgemm_normal_numeric: entry type of C must match KernelHandle entry type (aka nnz_lno_t)");
+    static_assert(KOKKOSKERNELS_SPGEMM_NORMAL_SAME_TYPE(typename a_scalar_view_t_::value_type, scalar_type) &&
+                  KOKKOSKERNELS_SPGEMM_NORMAL_SAME_TYPE(typename c_scalar_view_t_::value_type, scalar_type),
+        "spgemm_normal_numeric: scalar type of A and C must match KernelHandle scalar type (const doesn't matter)");
+
+    if (handle->get_spgemm_handle() == NULL || !handle->get_spgemm_handle()->is_symbolic_called()){
+      throw std::runtime_error("spgemm_normal_numeric: call spgemm_normal_symbolic before spgemm_normal_numeric");
+    }
+    if (handle->get_spgemm_handle()->get_transpose_a_xadj().extent(0) != size_t (n + 1)){
+      throw std::runtime_error("spgemm_normal_numeric: the symbolic phase was called with a different A");
+    }
+    if (entriesC.extent(0) < size_t (handle->get_spgemm_handle()->get_c_nnz()) ||
+        valuesC.extent(0) < size_t (handle->get_spgemm_handle()->get_c_nnz())){
+      throw std::runtime_error("spgemm_normal_numeric: entriesC and valuesC are smaller than the nnz of the symbolic phase");
+    }
+
+    Impl::spgemm_normal_numeric_impl(
+        handle, product == SPGEMM_A_AT, m, n,
+        row_mapA, entriesA, valuesA,
+        row_mapC, entriesC, valuesC);
+  }
+
+#undef KOKKOSKERNELS_SPGEMM_NORMAL_SAME_TYPE
+
+} // namespace Experimental
+} // namespace KokkosSparse
+
+#endif
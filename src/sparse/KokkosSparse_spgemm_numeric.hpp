@@ -54,6 +54,9 @@
 #include "KokkosKernels_Handle.hpp"
 */
 #include "KokkosKernels_helpers.hpp"
+#include "KokkosKernels_Profiling.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+#include "KokkosKernels_Prefetch.hpp"
 #include "KokkosSparse_spgemm_numeric_spec.hpp"
 
 
@@ -90,6 +93,7 @@ void spgemm_numeric(
     clno_nnz_view_t_ &entriesC,
     cscalar_nnz_view_t_ &valuesC
 ){
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spgemm_numeric");
 
 
 
@@ -164,6 +168,20 @@ void spgemm_numeric(
 //  /const_handle_type tmp_handle = *handle;
   const_handle_type tmp_handle (*handle);
 
+  if (handle->get_prefetch_before_numeric()){
+    const c_exec_t exec;
+    KokkosKernels::Impl::kk_prefetch_view(row_mapA, exec, true);
+    KokkosKernels::Impl::kk_prefetch_view(entriesA, exec, true);
+    KokkosKernels::Impl::kk_prefetch_view(valuesA, exec);
+    KokkosKernels::Impl::kk_prefetch_view(row_mapB, exec, true);
+    KokkosKernels::Impl::kk_prefetch_view(entriesB, exec, true);
+    KokkosKernels::Impl::kk_prefetch_view(valuesB, exec);
+    KokkosKernels::Impl::kk_prefetch_view(row_mapC, exec);
+    KokkosKernels::Impl::kk_prefetch_view(entriesC, exec);
+    KokkosKernels::Impl::kk_prefetch_view(valuesC, exec);
+    handle->get_spgemm_handle()->prefetch(exec);
+  }
+
   typedef Kokkos::View<
       typename alno_row_view_t_::const_value_type*,
       typename KokkosKernels::Impl::GetUnifiedLayout<alno_row_view_t_>::array_layout,
@@ -245,6 +263,17 @@ void spgemm_numeric(
   Internal_clno_nnz_view_t_ nonconst_c_l  ( entriesC.data(), entriesC.extent(0));
   Internal_cscalar_nnz_view_t_ nonconst_c_s ( valuesC.data(), valuesC.extent(0));
 
+  //the multiplication count takes a pass over A, only made when the counts are reported.
+  KOKKOSKERNELS_KERNEL_COUNTS("KokkosSparse::spgemm_numeric",
+      (KokkosKernels::get_kernel_counts_callback() ?
+       2.0 * KokkosKernels::Impl::kk_get_spgemm_multiplication_count
+         <Internal_alno_row_view_t_, Internal_alno_nnz_view_t_, Internal_blno_row_view_t_, c_exec_t>
+         (m, const_a_r, const_a_l, const_b_r) : 0.0),
+      (double(sizeof(c_size_t)) * (row_mapA.extent(0) + row_mapB.extent(0) + row_mapC.extent(0)) +
+       double(sizeof(c_lno_t) + sizeof(c_scalar_t)) * (entriesA.extent(0) + entriesB.extent(0) + entriesC.extent(0))));
+
+  //the values are only known by their versions through spgemm_update_values.
+  handle->get_spgemm_handle()->set_numeric_values(NULL, 0, NULL, 0, NULL);
 
   KokkosSparse::Impl::SPGEMM_NUMERIC<
   const_handle_type, //KernelHandle,
@@ -269,6 +298,43 @@ void spgemm_numeric(
       nonconst_c_s);
 }
 
+/// \brief Numeric phase of C = A B for CrsMatrix A and B whose values changed
+/// in place, e.g. through the value updates of KokkosSparse_crs_value_update.hpp.
+/// The symbolic phase must have been called for the patterns of A and B,
+/// and entriesC and valuesC allocated with its result size. The numeric
+/// phase is skipped if it was called by this function for the same values
+/// of A, B and C at the same values versions of A and B (see
+/// CrsMatrix::valuesVersion()).
+template <typename KernelHandle,
+typename AMatrix,
+typename BMatrix,
+typename clno_row_view_t_,
+typename clno_nnz_view_t_,
+typename cscalar_nnz_view_t_>
+void spgemm_update_values(
+    KernelHandle *handle,
+    const AMatrix &A,
+    bool transposeA,
+    const BMatrix &B,
+    bool transposeB,
+    clno_row_view_t_ row_mapC,
+    clno_nnz_view_t_ &entriesC,
+    cscalar_nnz_view_t_ &valuesC
+){
+  typename KernelHandle::SPGEMMHandleType *sh = handle->get_spgemm_handle();
+  if (!sh->is_symbolic_called()){
+    throw std::runtime_error ("KokkosSparse::spgemm_update_values: the symbolic phase has not been called.");
+  }
+  if (sh->is_numeric_called_for(A.values.data(), A.valuesVersion(), B.values.data(), B.valuesVersion(), valuesC.data())){
+    return;
+  }
+  spgemm_numeric(handle, A.numRows(), A.numCols(), B.numCols(),
+      A.graph.row_map, A.graph.entries, A.values, transposeA,
+      B.graph.row_map, B.graph.entries, B.values, transposeB,
+      row_mapC, entriesC, valuesC);
+  sh->set_numeric_values(A.values.data(), A.valuesVersion(), B.values.data(), B.valuesVersion(), valuesC.data());
+}
+
 
 }
 }
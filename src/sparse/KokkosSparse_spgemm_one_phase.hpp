@@ -0,0 +1,157 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_spgemm_one_phase.hpp
+/// \brief Sparse matrix-matrix multiply C = A*B without a symbolic phase
+///
+/// This file provides KokkosSparse::Experimental::spgemm_one_phase. Instead
+/// of counting the nonzeroes of C with a hash based symbolic phase, the rows
+/// of C are allocated with the number of multiplications of the rows, which
+/// bounds their nonzeroes. The numeric phase computes the rows into these
+/// bounds, and the rows are compacted in parallel. When the rows of A*B have
+/// few repeated columns the bound is tight, and the symbolic phase is saved.
+
+#ifndef KOKKOSSPARSE_SPGEMM_ONE_PHASE_HPP_
+#define KOKKOSSPARSE_SPGEMM_ONE_PHASE_HPP_
+
+#include <type_traits>
+#include <stdexcept>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_spgemm_symbolic.hpp"
+#include "KokkosSparse_spgemm_numeric.hpp"
+#include "KokkosSparse_spgemm_one_phase_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+#define KOKKOSKERNELS_SPGEMM_ONE_PHASE_SAME_TYPE(A, B) std::is_same<typename std::remove_const<A>::type, typename std::remove_const<B>::type>::value
+
+  /// \brief Computes C = A*B in a single call, allocating entriesC and valuesC.
+  /// If the bounded rows need more than
+  /// handle->get_spgemm_handle()->get_one_phase_memory_budget() bytes,
+  /// spgemm_symbolic and spgemm_numeric are called instead.
+  /// The number of nonzeroes of C is returned by
+  /// handle->get_spgemm_handle()->get_c_nnz().
+  ///
+  /// \param handle [in/out] kernel handle with the spgemm handle created.
+  /// \param m [in] number of rows of A and C.
+  /// \param n [in] number of columns of A, rows of B.
+  /// \param k [in] number of columns of B and C.
+  /// \param row_mapC [out] row map of C, of size m + 1.
+  /// \param entriesC [out] column indices of C, allocated by the function.
+  /// \param valuesC [out] values of C, allocated by the function.
+  template <typename KernelHandle,
+            typename a_row_view_t_, typename a_nnz_view_t_, typename a_scalar_view_t_,
+            typename b_row_view_t_, typename b_nnz_view_t_, typename b_scalar_view_t_,
+            typename c_row_view_t_, typename c_nnz_view_t_, typename c_scalar_view_t_>
+  void spgemm_one_phase(
+      KernelHandle *handle,
+      typename KernelHandle::const_nnz_lno_t m,
+      typename KernelHandle::const_nnz_lno_t n,
+      typename KernelHandle::const_nnz_lno_t k,
+      a_row_view_t_ row_mapA, a_nnz_view_t_ entriesA, a_scalar_view_t_ valuesA,
+      b_row_view_t_ row_mapB, b_nnz_view_t_ entriesB, b_scalar_view_t_ valuesB,
+      c_row_view_t_ row_mapC, c_nnz_view_t_ &entriesC, c_scalar_view_t_ &valuesC)
+  {
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+    typedef typename KernelHandle::nnz_scalar_t scalar_type;
+
+    static_assert (std::is_same<typename c_row_view_t_::value_type,
+        typename c_row_view_t_::non_const_value_type>::value &&
+        std::is_same<typename c_nnz_view_t_::value_type,
+        typename c_nnz_view_t_::non_const_value_type>::value &&
+        std::is_same<typename c_scalar_view_t_::value_type,
+        typename c_scalar_view_t_::non_const_value_type>::value,
+        "spgemm_one_phase: Output matrix must be non-const.");
+    static_assert(KOKKOSKERNELS_SPGEMM_ONE_PHASE_SAME_TYPE(typename a_row_view_t_::non_const_value_type, size_type) &&
+                  KOKKOSKERNELS_SPGEMM_ONE_PHASE_SAME_TYPE(typename b_row_view_t_::non_const_value_type, size_type) &&
+                  KOKKOSKERNELS_SPGEMM_ONE_PHASE_SAME_TYPE(typename c_row_view_t_::non_const_value_type, size_type),
+        "spgemm_one_phase: size_type of A, B and C must match KernelHandle size_type (const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPGEMM_ONE_PHASE_SAME_TYPE(typename a_nnz_view_t_::non_const_value_type, ordinal_type) &&
+                  KOKKOSKERNELS_SPGEMM_ONE_PHASE_SAME_TYPE(typename b_nnz_view_t_::non_const_value_type, ordinal_type) &&
+                  KOKKOSKERNELS_SPGEMM_ONE_PHASE_SAME_TYPE(typename c_nnz_view_t_::non_const_value_type, ordinal_type),
+        "spgemm_one_phase: entry type of A, B and C must match KernelHandle entry type (aka nnz_lno_t, and const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPGEMM_ONE_PHASE_SAME_TYPE(typename a_scalar_view_t_::value_type, scalar_type) &&
+                  KOKKOSKERNELS_SPGEMM_ONE_PHASE_SAME_TYPE(typename b_scalar_view_t_::value_type, scalar_type) &&
+                  KOKKOSKERNELS_SPGEMM_ONE_PHASE_SAME_TYPE(typename c_scalar_view_t_::value_type, scalar_type),
+        "spgemm_one_phase: scalar type of A, B and C must match KernelHandle scalar type (const doesn't matter)");
+
+    if (handle->get_spgemm_handle() == NULL){
+      throw std::runtime_error("spgemm_one_phase: the spgemm handle has not been created, call create_spgemm_handle first");
+    }
+    if (row_mapA.extent(0) != size_t (m + 1) || row_mapB.extent(0) != size_t (n + 1) ||
+        row_mapC.extent(0) != size_t (m + 1)){
+      throw std::runtime_error("spgemm_one_phase: the row maps of A, B and C do not match m and n");
+    }
+
+    if (Impl::spgemm_one_phase_impl(
+        handle, m, n, k,
+        row_mapA, entriesA, valuesA,
+        row_mapB, entriesB, valuesB,
+        row_mapC, entriesC, valuesC)){
+      return;
+    }
+
+    spgemm_symbolic(
+        handle, m, n, k,
+        row_mapA, entriesA, false,
+        row_mapB, entriesB, false,
+        row_mapC);
+    const size_t c_nnz = handle->get_spgemm_handle()->get_c_nnz();
+    entriesC = c_nnz_view_t_(Kokkos::ViewAllocateWithoutInitializing("entriesC"), c_nnz);
+    valuesC = c_scalar_view_t_(Kokkos::ViewAllocateWithoutInitializing("valuesC"), c_nnz);
+    spgemm_numeric(
+        handle, m, n, k,
+        row_mapA, entriesA, valuesA, false,
+        row_mapB, entriesB, valuesB, false,
+        row_mapC, entriesC, valuesC);
+  }
+
+#undef KOKKOSKERNELS_SPGEMM_ONE_PHASE_SAME_TYPE
+
+} // namespace Experimental
+} // namespace KokkosSparse
+
+#endif
@@ -0,0 +1,169 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+/// \file KokkosSparse_spgemm_partitioned.hpp
+/// \brief Sparse matrix-matrix multiply C = A*B with a
+///   RowPartitionedCrsMatrix A, one kernel handle per part.
+
+#ifndef KOKKOSSPARSE_SPGEMM_PARTITIONED_HPP_
+#define KOKKOSSPARSE_SPGEMM_PARTITIONED_HPP_
+
+#include <sstream>
+#include <vector>
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosKernels_Profiling.hpp"
+#include "KokkosSparse_spgemm_symbolic.hpp"
+#include "KokkosSparse_spgemm_numeric.hpp"
+#include "KokkosSparse_RowPartitionedCrsMatrix.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+template<class KernelHandle, class AMatrix, class BMatrix>
+void
+check_partitioned_spgemm (const char *label, const std::vector<KernelHandle *>& handles,
+                          const AMatrix& A, const BMatrix& B)
+{
+  if (A.numCols () != B.numRows ()) {
+    std::ostringstream os;
+    os << label << ": Dimensions do not match: "
+       << "A: " << A.numRows () << " x " << A.numCols ()
+       << ", B: " << B.numRows () << " x " << B.numCols ();
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  if (handles.size () != size_t (A.numParts ())) {
+    std::ostringstream os;
+    os << label << ": " << handles.size () << " kernel handles for " << A.numParts () << " parts.";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  for (size_t p = 0; p < handles.size (); ++p) {
+    if (handles[p] == NULL || handles[p]->get_spgemm_handle () == NULL) {
+      std::ostringstream os;
+      os << label << ": the spgemm handle of part " << p << " has not been created, call create_spgemm_handle first.";
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+  }
+}
+
+/// \brief Symbolic phase of C = A*B with A partitioned by rows. Part p
+///   of C is the product of part p of A with B, computed with
+///   handles[p], so each part keeps its own symbolic data, memory pool and
+///   workspace, and may be shared by a later numeric phase. B is read by
+///   every part.
+///
+/// \param handles [in/out] One kernel handle per part of A, with the
+///   spgemm handle created.
+/// \param A [in] The left matrix, partitioned by rows.
+/// \param B [in] The right CrsMatrix.
+/// \param C [out] The product, with the rows partitioned as A. Call
+///   C.gather() for a single CrsMatrix.
+template<class KernelHandle, class ScalarType, class OrdinalType, class Device, class SizeType, class BMatrix>
+void
+partitioned_spgemm_symbolic (const std::vector<KernelHandle *>& handles,
+                             const RowPartitionedCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& A,
+                             const BMatrix& B,
+                             RowPartitionedCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& C)
+{
+  typedef RowPartitionedCrsMatrix<ScalarType, OrdinalType, Device, SizeType> partitioned_t;
+  typedef typename partitioned_t::matrix_type matrix_type;
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::partitioned_spgemm_symbolic");
+  check_partitioned_spgemm ("KokkosSparse::partitioned_spgemm_symbolic", handles, A, B);
+
+  std::vector<matrix_type> parts (A.numParts ());
+  for (int p = 0; p < A.numParts (); ++p) {
+    const matrix_type& A_p = A.part (p);
+    typename partitioned_t::row_map_type row_mapC (
+        Kokkos::ViewAllocateWithoutInitializing ("partitioned spgemm row_mapC"), A_p.numRows () + 1);
+    spgemm_symbolic (
+        handles[p], A_p.numRows (), B.numRows (), B.numCols (),
+        A_p.graph.row_map, A_p.graph.entries, false,
+        B.graph.row_map, B.graph.entries, false,
+        row_mapC);
+    const size_t c_nnz = handles[p]->get_spgemm_handle ()->get_c_nnz ();
+    typename partitioned_t::index_type entriesC (
+        Kokkos::ViewAllocateWithoutInitializing ("partitioned spgemm entriesC"), c_nnz);
+    typename partitioned_t::values_type valuesC ("partitioned spgemm valuesC", c_nnz);
+    parts[p] = matrix_type ("partitioned spgemm C", A_p.numRows (), B.numCols (), c_nnz,
+                            valuesC, row_mapC, entriesC);
+  }
+  C = partitioned_t (B.numCols (), parts);
+}
+
+/// \brief Numeric phase of C = A*B with A partitioned by rows, with the
+///   handles and C of partitioned_spgemm_symbolic. Call again for new
+///   values of A and B with the same patterns.
+template<class KernelHandle, class ScalarType, class OrdinalType, class Device, class SizeType, class BMatrix>
+void
+partitioned_spgemm_numeric (const std::vector<KernelHandle *>& handles,
+                            const RowPartitionedCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& A,
+                            const BMatrix& B,
+                            const RowPartitionedCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& C)
+{
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::partitioned_spgemm_numeric");
+  check_partitioned_spgemm ("KokkosSparse::partitioned_spgemm_numeric", handles, A, B);
+  if (C.numParts () != A.numParts () || C.numCols () != B.numCols ()) {
+    std::ostringstream os;
+    os << "KokkosSparse::partitioned_spgemm_numeric: C has " << C.numParts () << " parts and "
+       << C.numCols () << " columns instead of " << A.numParts () << " parts and " << B.numCols () << " columns.";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  typedef Kokkos::View<SizeType*, typename RowPartitionedCrsMatrix<ScalarType, OrdinalType, Device, SizeType>::device_type,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged> > c_row_map_type;
+  for (int p = 0; p < A.numParts (); ++p) {
+    const auto& A_p = A.part (p);
+    const auto& C_p = C.part (p);
+    // The row map of C was written by the symbolic phase; spgemm_numeric
+    // only reads it, but takes it as non-const.
+    const c_row_map_type row_mapC (const_cast<SizeType *> (C_p.graph.row_map.data ()),
+                                   C_p.graph.row_map.extent (0));
+    spgemm_numeric (
+        handles[p], A_p.numRows (), B.numRows (), B.numCols (),
+        A_p.graph.row_map, A_p.graph.entries, A_p.values, false,
+        B.graph.row_map, B.graph.entries, B.values, false,
+        row_mapC, C_p.graph.entries, C_p.values);
+  }
+}
+
+}
+}
+
+#endif
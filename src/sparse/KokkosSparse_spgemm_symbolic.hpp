@@ -54,6 +54,7 @@
 #include "KokkosKernels_Handle.hpp"
 */
 #include "KokkosKernels_helpers.hpp"
+#include "KokkosKernels_Profiling.hpp"
 
 #include "KokkosSparse_spgemm_symbolic_spec.hpp"
 
@@ -80,6 +81,7 @@ void spgemm_symbolic(
     blno_nnz_view_t_ entriesB,
     bool transposeB,
     clno_row_view_t_ row_mapC){
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spgemm_symbolic");
 
 
   static_assert (std::is_same<typename clno_row_view_t_::value_type,
@@ -175,6 +177,23 @@ void spgemm_symbolic(
   Internal_blno_nnz_view_t_ const_b_l  (entriesB.data(), entriesB.extent(0));
   Internal_clno_row_view_t_ const_c_r  ( row_mapC.data(), row_mapC.extent(0));
 
+  //the symbolic phase only depends on the patterns of A and B. If it was
+  //called before for the same ones, the row map of C is restored from the handle.
+  typedef typename KernelHandle::SPGEMMHandleType::row_lno_persistent_work_view_t c_row_map_cache_t;
+  typename KernelHandle::SPGEMMHandleType *sh = handle->get_spgemm_handle();
+  uint64_t pattern_hash = KokkosKernels::Impl::kk_hash_graph
+      <Internal_alno_row_view_t_, Internal_alno_nnz_view_t_, c_exec_t>
+      (m, n, const_a_r, const_a_l,
+       KokkosKernels::Impl::kk_hash_mix(uint64_t(sh->get_algorithm_type())));
+  pattern_hash = KokkosKernels::Impl::kk_hash_graph
+      <Internal_blno_row_view_t_, Internal_blno_nnz_view_t_, c_exec_t>
+      (n, k, const_b_r, const_b_l, pattern_hash);
+  if (sh->is_symbolic_called_for(pattern_hash) &&
+      sh->get_symbolic_c_row_map().extent(0) == const_c_r.extent(0)){
+    Kokkos::deep_copy(const_c_r, sh->get_symbolic_c_row_map());
+    return;
+  }
+
   using namespace KokkosSparse::Impl;
   SPGEMM_SYMBOLIC<
   	  const_handle_type, //KernelHandle,
@@ -193,6 +212,11 @@ void spgemm_symbolic(
           transposeB,
           const_c_r);
 
+  c_row_map_cache_t c_row_map_cache(
+      Kokkos::ViewAllocateWithoutInitializing("SpGEMM symbolic row map of C"), const_c_r.extent(0));
+  Kokkos::deep_copy(c_row_map_cache, const_c_r);
+  sh->set_symbolic_pattern(pattern_hash, c_row_map_cache);
+
 
 }
 
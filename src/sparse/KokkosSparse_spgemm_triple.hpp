@@ -0,0 +1,183 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_spgemm_triple.hpp
+/// \brief Fused triple product C = R*A*P
+///
+/// This file provides KokkosSparse::Experimental::spgemm_triple_symbolic and
+/// KokkosSparse::Experimental::spgemm_triple_numeric, which compute the
+/// Galerkin product of algebraic multigrid in a single pass over the rows
+/// of R. Each row of R*A is accumulated in a per-thread hashmap and
+/// immediately multiplied with P, so neither R*A nor A*P is allocated.
+/// The spgemm handle of the kernel handle stores the size of C between
+/// the symbolic and the numeric phase.
+
+#ifndef KOKKOSSPARSE_SPGEMM_TRIPLE_HPP_
+#define KOKKOSSPARSE_SPGEMM_TRIPLE_HPP_
+
+#include <type_traits>
+#include <stdexcept>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_spgemm_triple_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+#define KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(A, B) std::is_same<typename std::remove_const<A>::type, typename std::remove_const<B>::type>::value
+
+  /// \brief Symbolic phase of C = R*A*P. Computes the row map of C, and
+  /// the number of nonzeroes of C, returned by
+  /// handle->get_spgemm_handle()->get_c_nnz().
+  ///
+  /// \param handle [in/out] kernel handle with the spgemm handle created.
+  /// \param m [in] number of rows of R and C.
+  /// \param n [in] number of columns of R, rows of A.
+  /// \param k [in] number of columns of A, rows of P.
+  /// \param l [in] number of columns of P and C.
+  /// \param row_mapC [out] row map of C, of size m + 1.
+  template <typename KernelHandle,
+            typename r_row_view_t_, typename r_nnz_view_t_,
+            typename a_row_view_t_, typename a_nnz_view_t_,
+            typename p_row_view_t_, typename p_nnz_view_t_,
+            typename c_row_view_t_>
+  void spgemm_triple_symbolic(
+      KernelHandle *handle,
+      typename KernelHandle::const_nnz_lno_t m,
+      typename KernelHandle::const_nnz_lno_t n,
+      typename KernelHandle::const_nnz_lno_t k,
+      typename KernelHandle::const_nnz_lno_t l,
+      r_row_view_t_ row_mapR, r_nnz_view_t_ entriesR,
+      a_row_view_t_ row_mapA, a_nnz_view_t_ entriesA,
+      p_row_view_t_ row_mapP, p_nnz_view_t_ entriesP,
+      c_row_view_t_ row_mapC)
+  {
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+
+    static_assert (std::is_same<typename c_row_view_t_::value_type,
+        typename c_row_view_t_::non_const_value_type>::value,
+        "spgemm_triple_symbolic: Output matrix rowmap must be non-const.");
+    static_assert(KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename r_row_view_t_::non_const_value_type, size_type) &&
+                  KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename a_row_view_t_::non_const_value_type, size_type) &&
+                  KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename p_row_view_t_::non_const_value_type, size_type) &&
+                  KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename c_row_view_t_::non_const_value_type, size_type),
+        "spgemm_triple_symbolic: size_type of R, A, P and C must match KernelHandle size_type (const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename r_nnz_view_t_::non_const_value_type, ordinal_type) &&
+                  KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename a_nnz_view_t_::non_const_value_type, ordinal_type) &&
+                  KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename p_nnz_view_t_::non_const_value_type, ordinal_type),
+        "spgemm_triple_symbolic: entry type of R, A and P must match KernelHandle entry type (aka nnz_lno_t, and const doesn't matter)");
+
+    if (handle->get_spgemm_handle() == NULL){
+      throw std::runtime_error("spgemm_triple_symbolic: the spgemm handle has not been created, call create_spgemm_handle first");
+    }
+    if (row_mapR.extent(0) != size_t (m + 1) || row_mapA.extent(0) != size_t (n + 1) ||
+        row_mapP.extent(0) != size_t (k + 1) || row_mapC.extent(0) != size_t (m + 1)){
+      throw std::runtime_error("spgemm_triple_symbolic: the row maps of R, A, P and C do not match m, n and k");
+    }
+
+    Impl::spgemm_triple_symbolic_impl(
+        handle, m, n, k, l,
+        row_mapR, entriesR,
+        row_mapA, entriesA,
+        row_mapP, entriesP,
+        row_mapC);
+  }
+
+  /// \brief Numeric phase of C = R*A*P. spgemm_triple_symbolic must have
+  /// been called with the same R, A and P patterns. entriesC and valuesC
+  /// must have get_c_nnz() entries.
+  template <typename KernelHandle,
+            typename r_row_view_t_, typename r_nnz_view_t_, typename r_scalar_view_t_,
+            typename a_row_view_t_, typename a_nnz_view_t_, typename a_scalar_view_t_,
+            typename p_row_view_t_, typename p_nnz_view_t_, typename p_scalar_view_t_,
+            typename c_row_view_t_, typename c_nnz_view_t_, typename c_scalar_view_t_>
+  void spgemm_triple_numeric(
+      KernelHandle *handle,
+      typename KernelHandle::const_nnz_lno_t m,
+      typename KernelHandle::const_nnz_lno_t n,
+      typename KernelHandle::const_nnz_lno_t k,
+      typename KernelHandle::const_nnz_lno_t l,
+      r_row_view_t_ row_mapR, r_nnz_view_t_ entriesR, r_scalar_view_t_ valuesR,
+      a_row_view_t_ row_mapA, a_nnz_view_t_ entriesA, a_scalar_view_t_ valuesA,
+      p_row_view_t_ row_mapP, p_nnz_view_t_ entriesP, p_scalar_view_t_ valuesP,
+      c_row_view_t_ row_mapC, c_nnz_view_t_ entriesC, c_scalar_view_t_ valuesC)
+  {
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+    typedef typename KernelHandle::nnz_scalar_t scalar_type;
+
+    static_assert (std::is_same<typename c_nnz_view_t_::value_type,
+        typename c_nnz_view_t_::non_const_value_type>::value &&
+        std::is_same<typename c_scalar_view_t_::value_type,
+        typename c_scalar_view_t_::non_const_value_type>::value,
+        "spgemm_triple_numeric: Output matrix entries and values must be non-const.");
+    static_assert(KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename c_nnz_view_t_::value_type, ordinal_type),
+        "spgemm_triple_numeric: entry type of C must match KernelHandle entry type (aka nnz_lno_t)");
+    static_assert(KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename r_scalar_view_t_::value_type, scalar_type) &&
+                  KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename a_scalar_view_t_::value_type, scalar_type) &&
+                  KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename p_scalar_view_t_::value_type, scalar_type) &&
+                  KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE(typename c_scalar_view_t_::value_type, scalar_type),
+        "spgemm_triple_numeric: scalar type of R, A, P and C must match KernelHandle scalar type (const doesn't matter)");
+
+    if (handle->get_spgemm_handle() == NULL || !handle->get_spgemm_handle()->is_symbolic_called()){
+      throw std::runtime_error("spgemm_triple_numeric: call spgemm_triple_symbolic before spgemm_triple_numeric");
+    }
+    if (entriesC.extent(0) < size_t (handle->get_spgemm_handle()->get_c_nnz()) ||
+        valuesC.extent(0) < size_t (handle->get_spgemm_handle()->get_c_nnz())){
+      throw std::runtime_error("spgemm_triple_numeric: entriesC and valuesC are smaller than the nnz of the symbolic phase");
+    }
+
+    Impl::spgemm_triple_numeric_impl(
+        handle, m, n, k, l,
+        row_mapR, entriesR, valuesR,
+        row_mapA, entriesA, valuesA,
+        row_mapP, entriesP, valuesP,
+        row_mapC, entriesC, valuesC);
+  }
+
+#undef KOKKOSKERNELS_SPGEMM_TRIPLE_SAME_TYPE
+
+} // namespace Experimental
+} // namespace KokkosSparse
+
+#endif
@@ -0,0 +1,193 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_spiluk.hpp
+/// \brief Parallel incomplete LU factorization ILU(k)
+///
+/// This file provides KokkosSparse::Experimental::spiluk_symbolic and
+/// KokkosSparse::Experimental::spiluk_numeric. The symbolic phase computes
+/// the patterns of the factors L and U for the level of fill k of the
+/// spiluk handle, and the level schedule of the rows, and stores them in
+/// the spiluk handle of the kernel handle; the numeric phase can then be
+/// called many times for matrices with the same sparsity pattern.
+///
+/// L is unit lower triangular with its diagonal stored, and U is upper
+/// triangular, both with sorted rows, so that they can be given to
+/// sptrsv_symbolic and sptrsv_solve. The rows of a level are factored in
+/// parallel: one thread per row with SPILUK_LVLSCHD_RP, one team per row
+/// with SPILUK_LVLSCHD_TP1. SPILUK_TASK instead spawns one Kokkos task per
+/// block of rows (SPILUKHandle::set_task_block_size) that starts as soon as
+/// the blocks its L part depends on are factored; it needs
+/// KOKKOS_ENABLE_TASKDAG, and is level scheduled otherwise.
+
+#ifndef KOKKOSSPARSE_SPILUK_HPP_
+#define KOKKOSSPARSE_SPILUK_HPP_
+
+#include <type_traits>
+#include <stdexcept>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_spiluk_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+#define KOKKOSKERNELS_SPILUK_SAME_TYPE(A, B) std::is_same<typename std::remove_const<A>::type, typename std::remove_const<B>::type>::value
+
+  /// \brief Symbolic phase of ILU(k). Computes the patterns of L and U,
+  /// available from handle->get_spiluk_handle() afterwards, and the level
+  /// schedule of the numeric phase. The spiluk handle must have been created
+  /// with handle->create_spiluk_handle(nrows, fill_level). A must be square.
+  template <typename KernelHandle,
+            typename lno_row_view_t_,
+            typename lno_nnz_view_t_>
+  void spiluk_symbolic(
+      KernelHandle *handle,
+      lno_row_view_t_ rowmap,
+      lno_nnz_view_t_ entries)
+  {
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+
+    static_assert(KOKKOSKERNELS_SPILUK_SAME_TYPE(typename lno_row_view_t_::non_const_value_type, size_type),
+        "spiluk_symbolic: A size_type must match KernelHandle size_type (const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPILUK_SAME_TYPE(typename lno_nnz_view_t_::non_const_value_type, ordinal_type),
+        "spiluk_symbolic: A entry type must match KernelHandle entry type (aka nnz_lno_t, and const doesn't matter)");
+
+    typedef typename KernelHandle::SPILUKHandleType spilukHandleType;
+    spilukHandleType *sh = handle->get_spiluk_handle();
+    if (sh == NULL){
+      throw std::runtime_error("spiluk_symbolic: the spiluk handle has not been created, call create_spiluk_handle first");
+    }
+
+    Impl::iluk_symbolic(*sh, rowmap, entries);
+  }
+
+  /// \brief Numeric phase of ILU(k): computes the values of L and U for
+  /// the patterns of the symbolic phase. If the symbolic phase has not been
+  /// run yet, it is run first.
+  ///
+  /// \param handle [in/out] kernel handle with the spiluk handle created.
+  /// \param rowmap [in] row map of A.
+  /// \param entries [in] column indices of A, without duplicates.
+  /// \param values [in] values of A.
+  /// \param L_values [out] values of L, of length get_nnzL() of the spiluk handle.
+  /// \param U_values [out] values of U, of length get_nnzU() of the spiluk handle.
+  template <typename KernelHandle,
+            typename lno_row_view_t_,
+            typename lno_nnz_view_t_,
+            typename scalar_nnz_view_t_,
+            typename lu_scalar_view_t_>
+  void spiluk_numeric(
+      KernelHandle *handle,
+      lno_row_view_t_ rowmap,
+      lno_nnz_view_t_ entries,
+      scalar_nnz_view_t_ values,
+      lu_scalar_view_t_ L_values,
+      lu_scalar_view_t_ U_values)
+  {
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+    typedef typename KernelHandle::nnz_scalar_t scalar_type;
+
+    static_assert(KOKKOSKERNELS_SPILUK_SAME_TYPE(typename lno_row_view_t_::non_const_value_type, size_type),
+        "spiluk_numeric: A size_type must match KernelHandle size_type (const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPILUK_SAME_TYPE(typename lno_nnz_view_t_::non_const_value_type, ordinal_type),
+        "spiluk_numeric: A entry type must match KernelHandle entry type (aka nnz_lno_t, and const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPILUK_SAME_TYPE(typename scalar_nnz_view_t_::value_type, scalar_type),
+        "spiluk_numeric: A scalar type must match KernelHandle entry type (aka nnz_scalar_t, and const doesn't matter)");
+    static_assert(std::is_same<typename lu_scalar_view_t_::value_type,
+        typename lu_scalar_view_t_::non_const_value_type>::value,
+        "spiluk_numeric: The outputs L_values and U_values must be nonconst.");
+
+    typedef typename KernelHandle::SPILUKHandleType spilukHandleType;
+    spilukHandleType *sh = handle->get_spiluk_handle();
+    if (sh == NULL){
+      throw std::runtime_error("spiluk_numeric: the spiluk handle has not been created, call create_spiluk_handle first");
+    }
+    if (!sh->is_symbolic_complete()){
+      Impl::iluk_symbolic(*sh, rowmap, entries);
+    }
+    if (static_cast<size_t>(sh->get_nnzL()) != L_values.extent(0) ||
+        static_cast<size_t>(sh->get_nnzU()) != U_values.extent(0)){
+      throw std::runtime_error("spiluk_numeric: the lengths of L_values and U_values must match the nonzeros of L and U of the symbolic phase");
+    }
+
+    Impl::iluk_numeric(handle, rowmap, entries, values, L_values, U_values);
+  }
+
+  /// \brief Numeric phase of ILU(k) for a CrsMatrix A. Allocates the values
+  /// of the factors and returns them as the CrsMatrices L and U, which share
+  /// their patterns with the spiluk handle.
+  template <typename KernelHandle, typename crsMat_t>
+  void spiluk_numeric(
+      KernelHandle *handle,
+      const crsMat_t &A,
+      crsMat_t &L,
+      crsMat_t &U)
+  {
+    typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+    typedef typename KernelHandle::SPILUKHandleType spilukHandleType;
+
+    spilukHandleType *sh = handle->get_spiluk_handle();
+    if (sh == NULL){
+      throw std::runtime_error("spiluk_numeric: the spiluk handle has not been created, call create_spiluk_handle first");
+    }
+    if (!sh->is_symbolic_complete()){
+      Impl::iluk_symbolic(*sh, A.graph.row_map, A.graph.entries);
+    }
+
+    scalar_view_t L_values(Kokkos::ViewAllocateWithoutInitializing("L_values"), sh->get_nnzL());
+    scalar_view_t U_values(Kokkos::ViewAllocateWithoutInitializing("U_values"), sh->get_nnzU());
+    spiluk_numeric(handle, A.graph.row_map, A.graph.entries, A.values, L_values, U_values);
+
+    L = crsMat_t("L", A.numRows(), A.numRows(), sh->get_nnzL(), L_values, sh->get_L_row_map(), sh->get_L_entries());
+    U = crsMat_t("U", A.numRows(), A.numRows(), sh->get_nnzU(), U_values, sh->get_U_row_map(), sh->get_U_entries());
+  }
+
+#undef KOKKOSKERNELS_SPILUK_SAME_TYPE
+
+} // namespace Experimental
+} // namespace KokkosSparse
+
+#endif // KOKKOSSPARSE_SPILUK_HPP_
@@ -0,0 +1,306 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_MemoryTraits.hpp>
+#include <Kokkos_Core.hpp>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "KokkosKernels_Utils.hpp"
+
+#ifndef _SPILUKHANDLE_HPP
+#define _SPILUKHANDLE_HPP
+
+namespace KokkosSparse{
+
+enum SPILUKAlgorithm{SPILUK_DEFAULT, SPILUK_LVLSCHD_RP, SPILUK_LVLSCHD_TP1, SPILUK_TASK};
+
+inline SPILUKAlgorithm StringToSPILUKAlgorithm(const std::string &name) {
+  if(name=="SPILUK_DEFAULT")              return SPILUK_DEFAULT;
+  else if(name=="SPILUK_LVLSCHD_RP")      return SPILUK_LVLSCHD_RP;
+  else if(name=="SPILUK_LVLSCHD_TP1")     return SPILUK_LVLSCHD_TP1;
+  else if(name=="SPILUK_TASK")            return SPILUK_TASK;
+  else
+    throw std::runtime_error("Invalid SPILUKAlgorithm name");
+}
+
+template <class size_type_, class lno_t_, class scalar_t_,
+          class ExecutionSpace,
+          class TemporaryMemorySpace,
+          class PersistentMemorySpace>
+class SPILUKHandle{
+public:
+  typedef ExecutionSpace HandleExecSpace;
+  typedef TemporaryMemorySpace HandleTempMemorySpace;
+  typedef PersistentMemorySpace HandlePersistentMemorySpace;
+
+  typedef typename std::remove_const<size_type_>::type  size_type;
+  typedef const size_type const_size_type;
+
+  typedef typename std::remove_const<lno_t_>::type  nnz_lno_t;
+  typedef const nnz_lno_t const_nnz_lno_t;
+
+  typedef typename std::remove_const<scalar_t_>::type  nnz_scalar_t;
+  typedef const nnz_scalar_t const_nnz_scalar_t;
+
+  typedef typename Kokkos::View<size_type *, HandlePersistentMemorySpace> nnz_row_view_t;
+  typedef typename nnz_row_view_t::HostMirror nnz_row_view_host_t;
+
+  typedef typename Kokkos::View<nnz_lno_t *, HandlePersistentMemorySpace> nnz_lno_view_t;
+  typedef typename nnz_lno_view_t::HostMirror nnz_lno_view_host_t;
+
+  typedef typename Kokkos::View<nnz_scalar_t *, HandlePersistentMemorySpace> nnz_scalar_view_t;
+
+private:
+  SPILUKAlgorithm algorithm_type;
+
+  //level of fill k of ILU(k).
+  nnz_lno_t fill_level;
+
+  //patterns of the factors, computed by the symbolic phase. The rows of
+  //both are sorted; L has a unit diagonal as the last entry of each row,
+  //U has the pivot as the first entry of each row.
+  nnz_row_view_t L_row_map;
+  nnz_lno_view_t L_entries;
+  nnz_row_view_t U_row_map;
+  nnz_lno_view_t U_entries;
+
+  //level schedule of the factorization: a row is factored after the
+  //rows of its L part. level_ptr is kept on the host, as the numeric
+  //phase loops over the levels on the host.
+  nnz_lno_view_t level_list;
+  nnz_lno_view_t nodes_grouped_by_level;
+  nnz_lno_view_host_t level_ptr;
+
+  //block DAG of the task based factorization. The rows are split into
+  //blocks of task_block_size consecutive rows, block b waits for the blocks
+  //task_deps[task_dep_ptr(b), task_dep_ptr(b+1)) that hold its L columns.
+  nnz_lno_t task_block_size;
+  nnz_lno_t ntask_blocks;
+  nnz_row_view_host_t task_dep_ptr;
+  nnz_lno_view_host_t task_deps;
+
+  nnz_lno_t nrows;
+  nnz_lno_t nlevels;
+  nnz_lno_t max_level_size;
+
+  bool symbolic_complete;
+  bool numeric_complete;
+
+  int suggested_vector_size;
+  int suggested_team_size;
+
+public:
+
+  /**
+   * \brief Default constructor.
+   * \param nrows_: number of rows of the matrix to factor.
+   * \param fill_level_: level of fill k of ILU(k); 0 keeps the pattern of A.
+   */
+  SPILUKHandle(SPILUKAlgorithm choice, nnz_lno_t nrows_, nnz_lno_t fill_level_ = 0):
+    algorithm_type(choice), fill_level(fill_level_),
+    L_row_map(), L_entries(), U_row_map(), U_entries(),
+    level_list(), nodes_grouped_by_level(), level_ptr(),
+    task_block_size(32), ntask_blocks(0), task_dep_ptr(), task_deps(),
+    nrows(nrows_), nlevels(0), max_level_size(0),
+    symbolic_complete(false), numeric_complete(false),
+    suggested_vector_size(0), suggested_team_size(0)
+  {
+    if (choice == SPILUK_DEFAULT){
+      this->choose_default_algorithm();
+    }
+  }
+
+  /** \brief Chooses best algorithm based on the execution space. Level
+   * scheduled factorization with teams on GPUs, and with range policies on CPUs.
+   */
+  void choose_default_algorithm(){
+    this->algorithm_type = SPILUK_LVLSCHD_RP;
+#if defined( KOKKOS_ENABLE_CUDA )
+    if (Kokkos::Impl::is_same<Kokkos::Cuda, ExecutionSpace >::value){
+      this->algorithm_type = SPILUK_LVLSCHD_TP1;
+#ifdef VERBOSE
+      std::cout << "Cuda Execution Space, Default Algorithm: SPILUK_LVLSCHD_TP1" << std::endl;
+#endif
+    }
+#endif
+  }
+
+  SPILUKAlgorithm get_algorithm_type() const { return this->algorithm_type; }
+  void set_algorithm_type(SPILUKAlgorithm algo){
+    this->algorithm_type = algo;
+    if (algo == SPILUK_DEFAULT){
+      this->choose_default_algorithm();
+    }
+  }
+
+  virtual ~SPILUKHandle(){};
+
+  /**
+   * \brief Allocates the persistent level set arrays for nrows_ rows.
+   * Called by the symbolic phase.
+   */
+  void new_init_handle(nnz_lno_t nrows_){
+    this->nrows = nrows_;
+    this->nlevels = 0;
+    this->max_level_size = 0;
+    this->ntask_blocks = 0;
+    this->level_list = nnz_lno_view_t("level_list", nrows_);
+    this->nodes_grouped_by_level = nnz_lno_view_t("nodes_grouped_by_level", nrows_);
+    this->symbolic_complete = false;
+    this->numeric_complete = false;
+  }
+
+  //getters
+  nnz_lno_t get_fill_level() const { return this->fill_level; }
+
+  nnz_row_view_t get_L_row_map() const { return this->L_row_map; }
+  nnz_lno_view_t get_L_entries() const { return this->L_entries; }
+  nnz_row_view_t get_U_row_map() const { return this->U_row_map; }
+  nnz_lno_view_t get_U_entries() const { return this->U_entries; }
+  size_type get_nnzL() const { return this->L_entries.extent(0); }
+  size_type get_nnzU() const { return this->U_entries.extent(0); }
+
+  nnz_lno_view_t get_level_list() const { return this->level_list; }
+  nnz_lno_view_t get_nodes_grouped_by_level() const { return this->nodes_grouped_by_level; }
+  nnz_lno_view_host_t get_level_ptr() const { return this->level_ptr; }
+
+  nnz_lno_t get_nrows() const { return this->nrows; }
+  nnz_lno_t get_num_levels() const { return this->nlevels; }
+  nnz_lno_t get_max_level_size() const { return this->max_level_size; }
+
+  nnz_lno_t get_task_block_size() const { return this->task_block_size; }
+  nnz_lno_t get_num_task_blocks() const { return this->ntask_blocks; }
+  nnz_row_view_host_t get_task_dep_ptr() const { return this->task_dep_ptr; }
+  nnz_lno_view_host_t get_task_deps() const { return this->task_deps; }
+
+  bool is_symbolic_complete() const { return this->symbolic_complete; }
+  bool is_numeric_complete() const { return this->numeric_complete; }
+
+  //setters
+  void set_fill_level(nnz_lno_t fill_level_){
+    this->fill_level = fill_level_;
+    this->symbolic_complete = false;
+    this->numeric_complete = false;
+  }
+
+  void set_factor_patterns(
+      const nnz_row_view_t &L_row_map_, const nnz_lno_view_t &L_entries_,
+      const nnz_row_view_t &U_row_map_, const nnz_lno_view_t &U_entries_){
+    this->L_row_map = L_row_map_;
+    this->L_entries = L_entries_;
+    this->U_row_map = U_row_map_;
+    this->U_entries = U_entries_;
+  }
+
+  /**
+   * \brief Sets the number of consecutive rows factored by one task of
+   * SPILUK_TASK. Smaller blocks expose more parallelism, larger blocks
+   * have less tasking overhead.
+   */
+  void set_task_block_size(nnz_lno_t task_block_size_){
+    if (task_block_size_ < 1){
+      throw std::runtime_error("set_task_block_size: the block size must be positive");
+    }
+    this->task_block_size = task_block_size_;
+    this->symbolic_complete = false;
+    this->numeric_complete = false;
+  }
+
+  void set_task_dag(
+      nnz_lno_t ntask_blocks_,
+      const nnz_row_view_host_t &task_dep_ptr_,
+      const nnz_lno_view_host_t &task_deps_){
+    this->ntask_blocks = ntask_blocks_;
+    this->task_dep_ptr = task_dep_ptr_;
+    this->task_deps = task_deps_;
+  }
+
+  void set_level_ptr(const nnz_lno_view_host_t &level_ptr_){ this->level_ptr = level_ptr_; }
+  void set_num_levels(nnz_lno_t nlevels_){ this->nlevels = nlevels_; }
+  void set_max_level_size(nnz_lno_t max_level_size_){ this->max_level_size = max_level_size_; }
+
+  void set_symbolic_complete(bool complete = true){ this->symbolic_complete = complete; }
+  void set_numeric_complete(bool complete = true){ this->numeric_complete = complete; }
+  void reset_symbolic(){ this->symbolic_complete = false; this->numeric_complete = false; }
+
+  /**
+   * \brief Returns the vector and team size used by the team based level
+   * factorization, either set by the user, or calculated from the average row size.
+   */
+  void vector_team_size(
+      int max_allowed_team_size,
+      int &suggested_vector_size_,
+      int &suggested_team_size_,
+      size_type nr, size_type nnz){
+    if (this->suggested_team_size && this->suggested_vector_size) {
+      suggested_vector_size_ = this->suggested_vector_size;
+      suggested_team_size_ = this->suggested_team_size;
+      return;
+    }
+    else {
+      KokkosKernels::Impl::get_suggested_vector_team_size<size_type, ExecutionSpace>(
+          max_allowed_team_size, suggested_vector_size_, suggested_team_size_, nr, nnz);
+    }
+  }
+
+  void set_suggested_vector_size(int vector_size_){ this->suggested_vector_size = vector_size_; }
+  void set_suggested_team_size(int team_size_){ this->suggested_team_size = team_size_; }
+
+  void print_algorithm(){
+    switch (this->algorithm_type){
+    case SPILUK_LVLSCHD_RP: std::cout << "SPILUK_LVLSCHD_RP, "; break;
+    case SPILUK_LVLSCHD_TP1: std::cout << "SPILUK_LVLSCHD_TP1, "; break;
+    case SPILUK_TASK: std::cout << "SPILUK_TASK (" << this->ntask_blocks << " blocks of " << this->task_block_size << " rows, " << this->task_deps.extent(0) << " dependencies), "; break;
+    default: break;
+    }
+    std::cout << "ILU(" << this->fill_level << "), "
+              << this->get_nnzL() << " nonzeros in L, " << this->get_nnzU() << " in U, "
+              << this->nlevels << " levels, max level size " << this->max_level_size
+              << std::endl;
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSSPARSE_SPMM_DENSE_HPP_
+#define KOKKOSSPARSE_SPMM_DENSE_HPP_
+
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmv_handle.hpp"
+#include "KokkosSparse_spmm_dense_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \brief Dense times sparse multiply with the transpose of A cached in handle.
+///
+/// Compute Y = beta*Y + alpha*X*A, where X is p x m, A is m x n and Y is
+/// p x n, e.g. X = V^T for a tall and skinny V. If beta == 0, ignore and
+/// overwrite the initial entries of Y. Each column of Y is a row of A^T
+/// times X, so the rows of A^T are gathered without atomics. The transpose
+/// pattern is built in the handle the first time, as for the cache_transpose
+/// control of spmv; call handle.values_updated() after changing the values
+/// of A in place. The p vectors are processed in register tiles of 8 to 64,
+/// so a LayoutLeft X reads consecutive entries for each entry of A.
+template <class lno_t, class size_type, class ExecutionSpace,
+          class AlphaType, class XMatrix, class AMatrix, class BetaType, class YMatrix>
+void
+dense_spmm (SPMVHandle<lno_t, size_type, ExecutionSpace>& handle,
+            const AlphaType& alpha,
+            const XMatrix& X,
+            const AMatrix& A,
+            const BetaType& beta,
+            const YMatrix& Y)
+{
+  static_assert ((int) XMatrix::rank == 2 && (int) YMatrix::rank == 2,
+                 "KokkosSparse::Experimental::dense_spmm: X and Y must have rank 2.");
+  static_assert (std::is_same<typename YMatrix::value_type,
+                   typename YMatrix::non_const_value_type>::value,
+                 "KokkosSparse::Experimental::dense_spmm: Output matrix must be non-const.");
+
+  if ((static_cast<size_t> (A.numRows ()) != static_cast<size_t> (X.extent(1))) ||
+      (static_cast<size_t> (A.numCols ()) != static_cast<size_t> (Y.extent(1))) ||
+      (X.extent(0) != Y.extent(0))) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::dense_spmm: Dimensions do not match: "
+       << ", X: " << X.extent(0) << " x " << X.extent(1)
+       << ", A: " << A.numRows () << " x " << A.numCols()
+       << ", Y: " << Y.extent(0) << " x " << Y.extent(1)
+       ;
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  typedef typename KokkosSparse::Impl::SPMV_Cached_Transpose<AMatrix>::matrix_type transpose_matrix_t;
+  const transpose_matrix_t At = KokkosSparse::Impl::spmv_cached_transpose (handle, A);
+  const lno_t num_vectors = X.extent(0);
+  if (beta != Kokkos::Details::ArithTraits<BetaType>::zero ()) {
+    Impl::spmm_dense_beta<transpose_matrix_t, XMatrix, YMatrix, 1, true> (alpha, At, X, beta, Y, num_vectors);
+  }
+  else {
+    Impl::spmm_dense_beta<transpose_matrix_t, XMatrix, YMatrix, 0, true> (alpha, At, X, beta, Y, num_vectors);
+  }
+}
+
+/// \brief Transpose sparse times dense multiply with the transpose of A
+///   cached in handle.
+///
+/// Compute Y = beta*Y + alpha*A^T*X, where A is m x n, X is m x p and Y is
+/// n x p. If beta == 0, ignore and overwrite the initial entries of Y. As
+/// in dense_spmm, the rows of the cached A^T are gathered without atomics
+/// in register tiles of 8 to 64 vectors, which suits a LayoutRight X.
+template <class lno_t, class size_type, class ExecutionSpace,
+          class AlphaType, class AMatrix, class XMatrix, class BetaType, class YMatrix>
+void
+spmm_transpose (SPMVHandle<lno_t, size_type, ExecutionSpace>& handle,
+                const AlphaType& alpha,
+                const AMatrix& A,
+                const XMatrix& X,
+                const BetaType& beta,
+                const YMatrix& Y)
+{
+  static_assert ((int) XMatrix::rank == 2 && (int) YMatrix::rank == 2,
+                 "KokkosSparse::Experimental::spmm_transpose: X and Y must have rank 2.");
+  static_assert (std::is_same<typename YMatrix::value_type,
+                   typename YMatrix::non_const_value_type>::value,
+                 "KokkosSparse::Experimental::spmm_transpose: Output matrix must be non-const.");
+
+  if ((static_cast<size_t> (A.numRows ()) != static_cast<size_t> (X.extent(0))) ||
+      (static_cast<size_t> (A.numCols ()) != static_cast<size_t> (Y.extent(0))) ||
+      (X.extent(1) != Y.extent(1))) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmm_transpose: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols()
+       << ", X: " << X.extent(0) << " x " << X.extent(1)
+       << ", Y: " << Y.extent(0) << " x " << Y.extent(1)
+       ;
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  typedef typename KokkosSparse::Impl::SPMV_Cached_Transpose<AMatrix>::matrix_type transpose_matrix_t;
+  const transpose_matrix_t At = KokkosSparse::Impl::spmv_cached_transpose (handle, A);
+  const lno_t num_vectors = X.extent(1);
+  if (beta != Kokkos::Details::ArithTraits<BetaType>::zero ()) {
+    Impl::spmm_dense_beta<transpose_matrix_t, XMatrix, YMatrix, 1, false> (alpha, At, X, beta, Y, num_vectors);
+  }
+  else {
+    Impl::spmm_dense_beta<transpose_matrix_t, XMatrix, YMatrix, 0, false> (alpha, At, X, beta, Y, num_vectors);
+  }
+}
+
+}
+}
+
+#endif
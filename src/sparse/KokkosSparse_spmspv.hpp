@@ -0,0 +1,144 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_spmspv.hpp
+/// \brief Product of a CrsMatrix and a sparse vector.
+
+#ifndef KOKKOSSPARSE_SPMSPV_HPP_
+#define KOKKOSSPARSE_SPMSPV_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include <type_traits>
+#include "KokkosKernels_Profiling.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmspv_handle.hpp"
+#include "KokkosSparse_spmspv_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \brief y = A*x, where x and y are sparse vectors given by the indices and
+///   values of their nonzeroes, e.g. the frontier of a graph traversal.
+///
+/// The push kernel reads the columns of A of the nonzeroes of x, in the
+/// transpose of A kept in the handle, and merges the products by buckets of
+/// rows; the work is proportional to the number of products, and the
+/// indices of y are not sorted. The pull kernel reads all the rows of A
+/// against a dense copy of x and returns sorted indices. SPMSPV_AUTO
+/// pushes when the number of products is less than the push ratio of the
+/// handle times the number of entries of A.
+///
+/// \param handle [in/out] The handle, used with a single matrix.
+/// \param A [in] The sparse matrix.
+/// \param x_indices [in] The distinct column indices of the nonzeroes of x.
+/// \param x_values [in] The values of the nonzeroes of x.
+/// \param y_indices [in/out] The row indices of the nonzeroes of y;
+///   reallocated if too short.
+/// \param y_values [in/out] The values of the nonzeroes of y; reallocated
+///   if too short.
+///
+/// \return The number of nonzeroes of y, written at the front of y_indices
+///   and y_values.
+template<class HandleType, class AMatrix, class XIndexView, class XValueView,
+         class YIndexView, class YValueView>
+typename AMatrix::non_const_ordinal_type
+spmspv (HandleType& handle, const AMatrix& A,
+        const XIndexView& x_indices, const XValueView& x_values,
+        YIndexView& y_indices, YValueView& y_values)
+{
+  typedef typename AMatrix::non_const_size_type size_type;
+  typedef typename HandleType::size_type_view_t offsets_type;
+  typedef typename HandleType::execution_space execution_space;
+  typedef typename KokkosSparse::TransposeMatrixType<AMatrix>::type transpose_type;
+
+  static_assert (std::is_same<typename AMatrix::non_const_size_type, typename HandleType::size_type>::value &&
+                 std::is_same<typename AMatrix::non_const_ordinal_type, typename HandleType::nnz_lno_t>::value,
+                 "KokkosSparse::spmspv: The handle and the matrix must have the same ordinal and size types.");
+  static_assert (std::is_same<typename YIndexView::value_type, typename YIndexView::non_const_value_type>::value &&
+                 std::is_same<typename YValueView::value_type, typename YValueView::non_const_value_type>::value,
+                 "KokkosSparse::spmspv: The output views must be non-const.");
+
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spmspv");
+
+  if (x_indices.extent (0) != x_values.extent (0)) {
+    std::ostringstream os;
+    os << "KokkosSparse::spmspv: Dimensions do not match: "
+       << "x_indices: " << x_indices.extent (0)
+       << ", x_values: " << x_values.extent (0);
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  handle.allocate_work_arrays (A.numRows (), A.numCols ());
+  if (x_indices.extent (0) == 0 || A.nnz () == 0) {
+    handle.set_last_algorithm (handle.get_algorithm () == SPMSPV_PULL ? SPMSPV_PULL : SPMSPV_PUSH);
+    return 0;
+  }
+
+  if (handle.get_algorithm () != SPMSPV_PULL) {
+    const transpose_type AT = Impl::spmspv_transpose (handle, A);
+
+    //the products of each nonzero of x, and their number.
+    const size_type nx = x_indices.extent (0);
+    offsets_type offsets (Kokkos::ViewAllocateWithoutInitializing ("spmspv offsets"), nx + 1);
+    Kokkos::parallel_for ("KokkosSparse::spmspv::push::columns", Kokkos::RangePolicy<execution_space> (0, nx + 1),
+        Impl::SpMSpV_Column_Lengths_Functor<typename transpose_type::row_map_type, XIndexView, offsets_type>
+          (AT.graph.row_map, x_indices, offsets));
+    KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<offsets_type, execution_space> (nx + 1, offsets);
+    size_type num_products = 0;
+    Kokkos::deep_copy (num_products, Kokkos::subview (offsets, nx));
+
+    if (handle.get_algorithm () == SPMSPV_PUSH ||
+        double (num_products) < handle.get_push_ratio () * double (A.nnz ())) {
+      handle.set_last_algorithm (SPMSPV_PUSH);
+      return Impl::spmspv_push (handle, AT, x_indices, x_values, offsets, num_products, y_indices, y_values);
+    }
+  }
+  handle.set_last_algorithm (SPMSPV_PULL);
+  return Impl::spmspv_pull (handle, A, x_indices, x_values, y_indices, y_values);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,195 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <Kokkos_Core.hpp>
+#include "KokkosSparse_transpose_handle.hpp"
+
+#ifndef _KOKKOSSPARSE_SPMSPV_HANDLE_HPP
+#define _KOKKOSSPARSE_SPMSPV_HANDLE_HPP
+
+namespace KokkosSparse{
+namespace Experimental{
+
+enum SpMSpVAlgorithm{
+  SPMSPV_AUTO, //push for sparse frontiers, pull otherwise
+  SPMSPV_PUSH, //scatter the columns of the nonzeroes of x, merged by row buckets
+  SPMSPV_PULL  //read all the rows of A against a dense copy of x
+};
+
+/**
+ * \brief State of the sparse matrix times sparse vector product.
+ *
+ * The push kernel reads the columns of A of the nonzeroes of x, so it keeps
+ * the transpose of A, computed the first time the handle is used with the
+ * matrix. Call values_updated() after changing the values of A in place,
+ * and reset_plan() after changing its pattern.
+ *
+ * The dense work arrays, a row of A or a column of x each, are allocated on
+ * first use and are zero between the calls; the buffers of the push kernel
+ * grow to the largest frontier.
+ */
+template <class lno_t_, class size_type_, class scalar_t_, class ExecutionSpace>
+class SpMSpVHandle{
+public:
+  typedef lno_t_ nnz_lno_t;
+  typedef size_type_ size_type;
+  typedef scalar_t_ nnz_scalar_t;
+  typedef ExecutionSpace execution_space;
+
+  typedef TransposeHandle<nnz_lno_t, size_type, execution_space> transpose_handle_t;
+  typedef Kokkos::View<nnz_lno_t *, execution_space> nnz_lno_view_t;
+  typedef Kokkos::View<size_type *, execution_space> size_type_view_t;
+  typedef Kokkos::View<nnz_scalar_t *, execution_space> scalar_view_t;
+
+private:
+  SpMSpVAlgorithm algorithm;
+  //push is used while the entries of the frontier columns are fewer than
+  //push_ratio times the entries of A.
+  double push_ratio;
+  SpMSpVAlgorithm last_algorithm;
+
+  transpose_handle_t transpose_handle;
+  scalar_view_t transpose_values;
+  bool are_transpose_values_current;
+
+  //one per row of A.
+  scalar_view_t row_accumulator;
+  nnz_lno_view_t row_marker;
+  //one per column of A.
+  scalar_view_t dense_x;
+  nnz_lno_view_t x_marker;
+  //one per product of the push kernel.
+  nnz_lno_view_t push_rows;
+  scalar_view_t push_values;
+
+public:
+  /**
+   * \brief constructor.
+   * \param algorithm_: the kernel, or SPMSPV_AUTO to choose it at each call
+   * from the density of the frontier.
+   */
+  SpMSpVHandle(SpMSpVAlgorithm algorithm_ = SPMSPV_AUTO):
+    algorithm(algorithm_), push_ratio(0.1), last_algorithm(SPMSPV_AUTO),
+    transpose_handle(), transpose_values(), are_transpose_values_current(false),
+    row_accumulator(), row_marker(), dense_x(), x_marker(), push_rows(), push_values(){}
+
+  SpMSpVAlgorithm get_algorithm() const {return this->algorithm;}
+  void set_algorithm(SpMSpVAlgorithm algorithm_){this->algorithm = algorithm_;}
+
+  double get_push_ratio() const {return this->push_ratio;}
+  /**
+   * \brief sets the fraction of the entries of A below which the entries of
+   * the frontier columns are pushed rather than all the rows pulled.
+   */
+  void set_push_ratio(double push_ratio_){this->push_ratio = push_ratio_;}
+
+  /**
+   * \brief the kernel used by the last call, SPMSPV_PUSH or SPMSPV_PULL.
+   */
+  SpMSpVAlgorithm get_last_algorithm() const {return this->last_algorithm;}
+  void set_last_algorithm(SpMSpVAlgorithm last_algorithm_){this->last_algorithm = last_algorithm_;}
+
+  /**
+   * \brief invalidates the transpose, so that the next call computes it again.
+   */
+  void reset_plan(){
+    this->transpose_handle.reset_plan();
+    this->transpose_values = scalar_view_t();
+    this->are_transpose_values_current = false;
+  }
+
+  /**
+   * \brief marks the values of the transpose as stale after the values of A
+   * changed in place. This is not needed after the value updates that bump
+   * the values version of A (see CrsMatrix::valuesVersion()).
+   */
+  void values_updated(){
+    this->are_transpose_values_current = false;
+    this->transpose_handle.reset_values();
+  }
+
+  transpose_handle_t &get_transpose_handle(){return this->transpose_handle;}
+  scalar_view_t get_transpose_values() const {return this->transpose_values;}
+  bool get_are_transpose_values_current() const {return this->are_transpose_values_current;}
+  void set_transpose_values(scalar_view_t transpose_values_){
+    this->transpose_values = transpose_values_;
+    this->are_transpose_values_current = true;
+  }
+
+  /**
+   * \brief allocates the zeroed work arrays of a matrix with num_rows rows
+   * and num_cols columns, if they are not large enough.
+   */
+  void allocate_work_arrays(nnz_lno_t num_rows, nnz_lno_t num_cols){
+    if (this->row_marker.extent(0) < size_t(num_rows)){
+      this->row_accumulator = scalar_view_t("spmspv row_accumulator", num_rows);
+      this->row_marker = nnz_lno_view_t("spmspv row_marker", num_rows);
+    }
+    if (this->x_marker.extent(0) < size_t(num_cols)){
+      this->dense_x = scalar_view_t("spmspv dense_x", num_cols);
+      this->x_marker = nnz_lno_view_t("spmspv x_marker", num_cols);
+    }
+  }
+
+  /**
+   * \brief allocates the buffers of num_products products of the push
+   * kernel, if they are not large enough.
+   */
+  void allocate_push_buffers(size_type num_products){
+    if (this->push_rows.extent(0) < size_t(num_products)){
+      this->push_rows = nnz_lno_view_t(Kokkos::ViewAllocateWithoutInitializing("spmspv push_rows"), num_products);
+      this->push_values = scalar_view_t(Kokkos::ViewAllocateWithoutInitializing("spmspv push_values"), num_products);
+    }
+  }
+
+  scalar_view_t get_row_accumulator() const {return this->row_accumulator;}
+  nnz_lno_view_t get_row_marker() const {return this->row_marker;}
+  scalar_view_t get_dense_x() const {return this->dense_x;}
+  nnz_lno_view_t get_x_marker() const {return this->x_marker;}
+  nnz_lno_view_t get_push_rows() const {return this->push_rows;}
+  scalar_view_t get_push_values() const {return this->push_values;}
+};
+
+}
+}
+
+#endif
@@ -48,9 +48,15 @@
 #define KOKKOSSPARSE_SPMV_HPP_
 
 #include "KokkosKernels_helpers.hpp"
+#include "KokkosKernels_Profiling.hpp"
 #include "KokkosSparse_spmv_spec.hpp"
 #include <type_traits>
 #include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmv_controls.hpp"
+#include "KokkosSparse_spmv_merge_impl.hpp"
+#include "KokkosSparse_spmv_handle.hpp"
+#include "KokkosSparse_spmv_handle_impl.hpp"
+#include "KokkosSparse_spmv_ensemble_impl.hpp"
 
 
 namespace KokkosSparse {
@@ -60,9 +66,25 @@ namespace {
   struct RANK_TWO{};
 }
 
+namespace Impl {
+/// \brief Bytes moved by y = beta*y + alpha*op(A)*x when A, x and y are
+///   each accessed once; y is also read when beta is nonzero.
+template <class AMatrix, class XVector, class YVector, class BetaType>
+double spmv_bytes (const AMatrix& A, const XVector& x, const YVector& y, const BetaType& beta) {
+  const double nvec = x.extent(1);
+  const double y_bytes = y.extent(0) * nvec * sizeof(typename YVector::non_const_value_type);
+  return A.nnz() * (double(sizeof(typename AMatrix::non_const_value_type)) +
+                    double(sizeof(typename AMatrix::non_const_ordinal_type))) +
+         (A.numRows() + 1) * double(sizeof(typename AMatrix::non_const_size_type)) +
+         x.extent(0) * nvec * sizeof(typename XVector::non_const_value_type) +
+         (beta == BetaType(0) ? y_bytes : 2 * y_bytes);
+}
+}
+
 template <class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
 void
-spmv (const char mode[],
+spmv (const typename AMatrix::execution_space& space,
+      const char mode[],
       const AlphaType& alpha,
       const AMatrix& A,
       const XVector& x,
@@ -70,6 +92,7 @@ spmv (const char mode[],
       const YVector& y,
       const RANK_ONE)
 {
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spmv");
   // Make sure that both x and y have the same rank.
   static_assert ((int) XVector::rank == (int) YVector::rank,
                  "KokkosSparse::spmv: Vector ranks do not match.");
@@ -113,6 +136,8 @@ spmv (const char mode[],
   }
 
 
+  KOKKOSKERNELS_KERNEL_COUNTS("KokkosSparse::spmv", 2.0 * A.nnz() * x.extent(1), Impl::spmv_bytes (A, x, y, beta));
+
   typedef KokkosSparse::CrsMatrix<
               typename AMatrix::const_value_type,
               typename AMatrix::const_ordinal_type,
@@ -149,14 +174,111 @@ spmv (const char mode[],
               typename YVector_Internal::value_type*,
               typename YVector_Internal::array_layout,
               typename YVector_Internal::device_type,
-              typename YVector_Internal::memory_traits>::spmv (mode, alpha, A_i, x_i, beta, y_i);
+              typename YVector_Internal::memory_traits>::spmv (space, mode, alpha, A_i, x_i, beta, y_i);
+}
+
+/// \brief y = beta*y + alpha*op(A)*x for an ensemble matrix, whose values
+///   are KokkosBatched SIMD vectors holding one entry per ensemble member.
+///
+/// All members share the graph of A, so each column index is loaded once
+/// for the l members. x, y, alpha and beta have the same ensemble scalar
+/// type as A. Only the "N" and "C" modes are supported.
+template <class AlphaType, class T, int l, class OrdinalType, class Device,
+          class MemoryTraits, class SizeType, class XVector, class BetaType, class YVector>
+void
+spmv (const typename Device::execution_space& space,
+      const char mode[],
+      const AlphaType& alpha,
+      const CrsMatrix<KokkosBatched::Experimental::Vector<KokkosBatched::Experimental::SIMD<T>,l>,
+                      OrdinalType, Device, MemoryTraits, SizeType>& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y,
+      const RANK_ONE)
+{
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spmv<Ensemble>");
+  typedef CrsMatrix<KokkosBatched::Experimental::Vector<KokkosBatched::Experimental::SIMD<T>,l>,
+                    OrdinalType, Device, MemoryTraits, SizeType> AMatrix;
+  static_assert ((int) XVector::rank == 1 && (int) YVector::rank == 1,
+                 "KokkosSparse::spmv: Both Vector inputs must have rank 1 in "
+                 "order to call this specialization of spmv.");
+  static_assert (std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+                 "KokkosSparse::spmv: Output Vector must be non-const.");
+  static_assert (std::is_same<typename AMatrix::non_const_value_type,
+                   typename YVector::non_const_value_type>::value &&
+                 std::is_same<typename AMatrix::non_const_value_type,
+                   typename XVector::non_const_value_type>::value,
+                 "KokkosSparse::spmv: x and y must have the ensemble scalar type of A.");
+
+  if ((mode[0] != NoTranspose[0]) && (mode[0] != Conjugate[0])) {
+    std::ostringstream os;
+    os << "KokkosSparse::spmv: ensemble matrices support only the \"N\" and \"C\" modes, not \""
+       << mode << "\"";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  if ((static_cast<size_t> (A.numCols ()) > static_cast<size_t> (x.extent(0))) ||
+      (static_cast<size_t> (A.numRows ()) > static_cast<size_t> (y.extent(0)))) {
+    std::ostringstream os;
+    os << "KokkosSparse::spmv: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols()
+       << ", x: " << x.extent(0)
+       << ", y: " << y.extent(0)
+       ;
+
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  KOKKOSKERNELS_KERNEL_COUNTS("KokkosSparse::spmv<Ensemble>", 2.0 * l * A.nnz(),
+      A.nnz() * (double(sizeof(typename AMatrix::non_const_value_type)) + double(sizeof(OrdinalType))) +
+      (A.numRows() + 1) * double(sizeof(SizeType)) +
+      (x.extent(0) + 2.0 * y.extent(0)) * sizeof(typename YVector::non_const_value_type));
+
+  typedef Kokkos::View<
+            typename XVector::const_value_type*,
+            typename KokkosKernels::Impl::GetUnifiedLayout<XVector>::array_layout,
+            typename XVector::device_type,
+            Kokkos::MemoryTraits<Kokkos::Unmanaged|Kokkos::RandomAccess> > XVector_Internal;
+
+  typedef Kokkos::View<
+            typename YVector::non_const_value_type*,
+            typename KokkosKernels::Impl::GetUnifiedLayout<YVector>::array_layout,
+            typename YVector::device_type,
+            Kokkos::MemoryTraits<Kokkos::Unmanaged> > YVector_Internal;
+
+  XVector_Internal x_i = x;
+  YVector_Internal y_i = y;
+  const typename YVector::non_const_value_type alpha_e = alpha;
+  const typename YVector::non_const_value_type beta_e = beta;
+
+  if (mode[0] == Conjugate[0]) {
+    Impl::spmv_ensemble_beta_no_transpose<AMatrix, XVector_Internal, YVector_Internal, true>
+      (space, alpha_e, A, x_i, beta_e, y_i);
+  } else {
+    Impl::spmv_ensemble_beta_no_transpose<AMatrix, XVector_Internal, YVector_Internal, false>
+      (space, alpha_e, A, x_i, beta_e, y_i);
+  }
+}
+
+template <class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
+void
+spmv (const char mode[],
+      const AlphaType& alpha,
+      const AMatrix& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y,
+      const RANK_ONE)
+{
+  spmv (typename AMatrix::execution_space (), mode, alpha, A, x, beta, y, RANK_ONE ());
 }
 
 
 template<class AlphaType, class AMatrix, class XVector, class BetaType, class YVector ,
          class XLayout = typename XVector::array_layout>
 struct SPMV2D1D{
-  static bool spmv2d1d (const char mode[],
+  static bool spmv2d1d (const typename AMatrix::execution_space& space,
+        const char mode[],
         const AlphaType& alpha,
         const AMatrix& A,
         const XVector& x,
@@ -167,14 +289,15 @@ struct SPMV2D1D{
 
 template<class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
 struct SPMV2D1D<AlphaType, AMatrix, XVector, BetaType, YVector, Kokkos::LayoutStride>{
-  static bool spmv2d1d (const char mode[],
+  static bool spmv2d1d (const typename AMatrix::execution_space& space,
+        const char mode[],
         const AlphaType& alpha,
         const AMatrix& A,
         const XVector& x,
         const BetaType& beta,
         const YVector& y){
 #if defined (KOKKOSKERNELS_INST_LAYOUTSTRIDE) || !defined(KOKKOSKERNELS_ETI_ONLY)
-    spmv (mode, alpha, A, x, beta, y);
+    spmv (space, mode, alpha, A, x, beta, y);
     return true;
 #else
     return false;
@@ -184,14 +307,15 @@ struct SPMV2D1D<AlphaType, AMatrix, XVector, BetaType, YVector, Kokkos::LayoutSt
 
 template<class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
 struct SPMV2D1D<AlphaType, AMatrix, XVector, BetaType, YVector, Kokkos::LayoutLeft>{
-  static bool spmv2d1d (const char mode[],
+  static bool spmv2d1d (const typename AMatrix::execution_space& space,
+        const char mode[],
         const AlphaType& alpha,
         const AMatrix& A,
         const XVector& x,
         const BetaType& beta,
         const YVector& y){
 #if defined (KOKKOSKERNELS_INST_LAYOUTLEFT) || !defined(KOKKOSKERNELS_ETI_ONLY)
-    spmv (mode, alpha, A, x, beta, y);
+    spmv (space, mode, alpha, A, x, beta, y);
     return true;
 #else
     return false;
@@ -202,14 +326,15 @@ struct SPMV2D1D<AlphaType, AMatrix, XVector, BetaType, YVector, Kokkos::LayoutLe
 
 template<class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
 struct SPMV2D1D<AlphaType, AMatrix, XVector, BetaType, YVector, Kokkos::LayoutRight>{
-  static bool spmv2d1d (const char mode[],
+  static bool spmv2d1d (const typename AMatrix::execution_space& space,
+        const char mode[],
         const AlphaType& alpha,
         const AMatrix& A,
         const XVector& x,
         const BetaType& beta,
         const YVector& y){
 #if defined (KOKKOSKERNELS_INST_LAYOUTLEFT) || !defined(KOKKOSKERNELS_ETI_ONLY)
-    spmv (mode, alpha, A, x, beta, y);
+    spmv (space, mode, alpha, A, x, beta, y);
     return true;
 #else
     return false;
@@ -219,7 +344,8 @@ struct SPMV2D1D<AlphaType, AMatrix, XVector, BetaType, YVector, Kokkos::LayoutRi
 
 template<class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
 void
-spmv (const char mode[],
+spmv (const typename AMatrix::execution_space& space,
+      const char mode[],
       const AlphaType& alpha,
       const AMatrix& A,
       const XVector& x,
@@ -227,6 +353,7 @@ spmv (const char mode[],
       const YVector& y,
       const RANK_TWO)
 {
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spmv_mv");
   // Make sure that both x and y have the same rank.
   static_assert (XVector::rank == YVector::rank,
                  "KokkosBlas::spmv: Vector ranks do not match.");
@@ -260,6 +387,8 @@ spmv (const char mode[],
     }
   }
 
+  KOKKOSKERNELS_KERNEL_COUNTS("KokkosSparse::spmv_mv", 2.0 * A.nnz() * x.extent(1), Impl::spmv_bytes (A, x, y, beta));
+
   typedef KokkosSparse::CrsMatrix<
         typename AMatrix::const_value_type,
         typename AMatrix::const_ordinal_type,
@@ -289,7 +418,7 @@ spmv (const char mode[],
 
     //spmv (mode, alpha, A, x_i, beta, y_i);
     if (SPMV2D1D  <AlphaType, AMatrix_Internal, XVector_SubInternal,
-                    BetaType, YVector_SubInternal, typename XVector_SubInternal::array_layout>::spmv2d1d(mode, alpha, A, x_i, beta, y_i)){
+                    BetaType, YVector_SubInternal, typename XVector_SubInternal::array_layout>::spmv2d1d(space, mode, alpha, A, x_i, beta, y_i)){
       return;
     }
   }
@@ -321,10 +450,23 @@ spmv (const char mode[],
                          typename YVector_Internal::value_type**,
                          typename YVector_Internal::array_layout,
                          typename YVector_Internal::device_type,
-                         typename YVector_Internal::memory_traits>::spmv_mv (mode, alpha, A_i, x_i, beta, y_i);
+                         typename YVector_Internal::memory_traits>::spmv_mv (space, mode, alpha, A_i, x_i, beta, y_i);
   }
 }
 
+template<class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
+void
+spmv (const char mode[],
+      const AlphaType& alpha,
+      const AMatrix& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y,
+      const RANK_TWO)
+{
+  spmv (typename AMatrix::execution_space (), mode, alpha, A, x, beta, y, RANK_TWO ());
+}
+
 /// \brief Public interface to local sparse matrix-vector multiply.
 ///
 /// Compute y = beta*y + alpha*Op(A)*x, where x and y are either both
@@ -333,6 +475,10 @@ spmv (const char mode[],
 /// by \c mode.  If beta == 0, ignore and overwrite the initial
 /// entries of y; if alpha == 0, ignore the entries of A and x.
 ///
+/// The entries of A may have a different type than those of x and y,
+/// e.g. a float matrix with double vectors; the products are then
+/// accumulated in the type of y.
+///
 /// \param mode [in] "N" for no transpose, "T" for transpose, or "C"
 ///   for conjugate transpose.
 /// \param alpha [in] Scalar multiplier for the matrix A.
@@ -355,9 +501,255 @@ spmv(const char mode[],
   spmv (mode, alpha, A, x, beta, y, RANK_SPECIALISE ());
 }
 
+/// \brief Local sparse matrix-vector multiply on a given execution
+///   space instance.
+///
+/// Same as above, but every kernel (including the scaling of y by
+/// beta) is launched on \c space.  On Cuda this is the stream the
+/// instance wraps, so independent spmv calls on different instances
+/// may overlap.  The call does not fence; synchronize with
+/// <tt>space.fence()</tt> before reading y on the host.
+template <class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
+void
+spmv(const typename AMatrix::execution_space& space,
+     const char mode[],
+     const AlphaType& alpha,
+     const AMatrix& A,
+     const XVector& x,
+     const BetaType& beta,
+     const YVector& y) {
+  typedef typename Kokkos::Impl::if_c<XVector::rank == 2, RANK_TWO, RANK_ONE>::type RANK_SPECIALISE;
+  spmv (space, mode, alpha, A, x, beta, y, RANK_SPECIALISE ());
+}
 
+namespace {
+  template <class AMatrix, class XVector, class YVector>
+  void
+  spmv_check_no_transpose_dimensions (const AMatrix& A, const XVector& x, const YVector& y)
+  {
+    if ((x.extent(1) != y.extent(1)) ||
+        (static_cast<size_t> (A.numCols ()) > static_cast<size_t> (x.extent(0))) ||
+        (static_cast<size_t> (A.numRows ()) > static_cast<size_t> (y.extent(0)))) {
+      std::ostringstream os;
+      os << "KokkosSparse::spmv: Dimensions do not match: "
+         << ", A: " << A.numRows () << " x " << A.numCols()
+         << ", x: " << x.extent(0) << " x " << x.extent(1)
+         << ", y: " << y.extent(0) << " x " << y.extent(1)
+         ;
 
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+  }
 }
 
-#endif
+template <class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
+void
+spmv (const SPMVControls& controls,
+      const char mode[],
+      const AlphaType& alpha,
+      const AMatrix& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y,
+      const RANK_ONE)
+{
+  if (controls.get_algorithm () != SPMV_MERGE_PATH ||
+      ((mode[0] != NoTranspose[0]) && (mode[0] != Conjugate[0]))) {
+    spmv (mode, alpha, A, x, beta, y, RANK_ONE ());
+    return;
+  }
+  static_assert ((int) XVector::rank == (int) YVector::rank,
+                 "KokkosSparse::spmv: Vector ranks do not match.");
+  static_assert (std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+                 "KokkosSparse::spmv: Output Vector must be non-const.");
+  spmv_check_no_transpose_dimensions (A, x, y);
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spmv[MergePath]");
+  KOKKOSKERNELS_KERNEL_COUNTS("KokkosSparse::spmv[MergePath]", 2.0 * A.nnz() * x.extent(1), Impl::spmv_bytes (A, x, y, beta));
+
+  if (mode[0] == Conjugate[0]) {
+    Impl::spmv_merge_path<AMatrix, XVector, YVector, true>
+      (alpha, A, x, beta, y, controls.get_merge_path_items_per_thread ());
+  }
+  else {
+    Impl::spmv_merge_path<AMatrix, XVector, YVector, false>
+      (alpha, A, x, beta, y, controls.get_merge_path_items_per_thread ());
+  }
+}
+
+template <class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
+void
+spmv (const SPMVControls& controls,
+      const char mode[],
+      const AlphaType& alpha,
+      const AMatrix& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y,
+      const RANK_TWO)
+{
+  //the merge path walks each column, which is only contiguous for LayoutLeft.
+  const bool layout_left =
+    std::is_same<typename XVector::array_layout, Kokkos::LayoutLeft>::value &&
+    std::is_same<typename YVector::array_layout, Kokkos::LayoutLeft>::value;
+  if (controls.get_algorithm () != SPMV_MERGE_PATH || !layout_left ||
+      ((mode[0] != NoTranspose[0]) && (mode[0] != Conjugate[0]))) {
+    spmv (mode, alpha, A, x, beta, y, RANK_TWO ());
+    return;
+  }
+  static_assert ((int) XVector::rank == (int) YVector::rank,
+                 "KokkosSparse::spmv: Vector ranks do not match.");
+  static_assert (std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+                 "KokkosSparse::spmv: Output Vector must be non-const.");
+  spmv_check_no_transpose_dimensions (A, x, y);
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spmv_mv[MergePath]");
+  KOKKOSKERNELS_KERNEL_COUNTS("KokkosSparse::spmv_mv[MergePath]", 2.0 * A.nnz() * x.extent(1), Impl::spmv_bytes (A, x, y, beta));
 
+  if (mode[0] == Conjugate[0]) {
+    Impl::spmv_merge_path_mv<AMatrix, XVector, YVector, true>
+      (alpha, A, x, beta, y, controls.get_merge_path_items_per_thread ());
+  }
+  else {
+    Impl::spmv_merge_path_mv<AMatrix, XVector, YVector, false>
+      (alpha, A, x, beta, y, controls.get_merge_path_items_per_thread ());
+  }
+}
+
+/// \brief Sparse matrix-vector multiply with the algorithm of \c controls.
+///
+/// Same as spmv(mode, alpha, A, x, beta, y). With SPMV_MERGE_PATH, the
+/// non transpose and conjugate modes split rows and nonzeroes of A
+/// evenly among the threads, which balances matrices with a few dense
+/// rows; the transpose modes and non LayoutLeft multivectors use the
+/// default kernels. The merge path kernels are instantiated in the
+/// caller and do not go through the ETI or the TPLs.
+template <class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
+void
+spmv(const SPMVControls& controls,
+     const char mode[],
+     const AlphaType& alpha,
+     const AMatrix& A,
+     const XVector& x,
+     const BetaType& beta,
+     const YVector& y) {
+  typedef typename Kokkos::Impl::if_c<XVector::rank == 2, RANK_TWO, RANK_ONE>::type RANK_SPECIALISE;
+  spmv (controls, mode, alpha, A, x, beta, y, RANK_SPECIALISE ());
+}
+
+template <class lno_t, class size_type, class ExecutionSpace,
+          class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
+void
+spmv (SPMVHandle<lno_t, size_type, ExecutionSpace>& handle,
+      const char mode[],
+      const AlphaType& alpha,
+      const AMatrix& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y,
+      const RANK_ONE)
+{
+  if ((mode[0] != NoTranspose[0]) && (mode[0] != Conjugate[0])) {
+    if (handle.get_controls ().get_cache_transpose () &&
+        ((mode[0] == Transpose[0]) || (mode[0] == ConjugateTranspose[0]))) {
+      spmv (mode[0] == Transpose[0] ? NoTranspose : Conjugate,
+            alpha, Impl::spmv_cached_transpose (handle, A), x, beta, y, RANK_ONE ());
+    }
+    else {
+      spmv (mode, alpha, A, x, beta, y, RANK_ONE ());
+    }
+    return;
+  }
+  static_assert ((int) XVector::rank == (int) YVector::rank,
+                 "KokkosSparse::spmv: Vector ranks do not match.");
+  static_assert (std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+                 "KokkosSparse::spmv: Output Vector must be non-const.");
+  spmv_check_no_transpose_dimensions (A, x, y);
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::spmv[Handle]");
+  KOKKOSKERNELS_KERNEL_COUNTS("KokkosSparse::spmv[Handle]", 2.0 * A.nnz() * x.extent(1), Impl::spmv_bytes (A, x, y, beta));
+
+  if (mode[0] == Conjugate[0]) {
+    Impl::spmv_handle<SPMVHandle<lno_t, size_type, ExecutionSpace>, AMatrix, XVector, YVector, true>
+      (handle, alpha, A, x, beta, y);
+  }
+  else {
+    Impl::spmv_handle<SPMVHandle<lno_t, size_type, ExecutionSpace>, AMatrix, XVector, YVector, false>
+      (handle, alpha, A, x, beta, y);
+  }
+}
+
+template <class lno_t, class size_type, class ExecutionSpace,
+          class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
+void
+spmv (SPMVHandle<lno_t, size_type, ExecutionSpace>& handle,
+      const char mode[],
+      const AlphaType& alpha,
+      const AMatrix& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y,
+      const RANK_TWO)
+{
+  if (handle.get_controls ().get_cache_transpose () &&
+      ((mode[0] == Transpose[0]) || (mode[0] == ConjugateTranspose[0]))) {
+    spmv (mode[0] == Transpose[0] ? NoTranspose : Conjugate,
+          alpha, Impl::spmv_cached_transpose (handle, A), x, beta, y, RANK_TWO ());
+    return;
+  }
+  //the multivector kernels partition the rows themselves, so the plan only
+  //tells whether to use the merge path kernel.
+  if ((mode[0] == NoTranspose[0]) || (mode[0] == Conjugate[0])) {
+    Impl::spmv_inspect_if_needed (handle, A);
+  }
+  if (handle.get_kernel () == SPMV_KERNEL_MERGE_PATH) {
+    SPMVControls controls (SPMV_MERGE_PATH);
+    controls.set_merge_path_items_per_thread (handle.get_merge_path_items_per_thread ());
+    spmv (controls, mode, alpha, A, x, beta, y, RANK_TWO ());
+  }
+  else {
+    spmv (mode, alpha, A, x, beta, y, RANK_TWO ());
+  }
+}
+
+/// \brief Sparse matrix-vector multiply reusing the plan of \c handle.
+///
+/// Same as spmv(mode, alpha, A, x, beta, y). The first call with a
+/// matrix inspects it and stores the plan in the handle: an nnz
+/// balanced partition of the rows with the team and vector sizes, or
+/// the merge path kernel for matrices with a few very dense rows. The
+/// following calls with the same matrix only run the chosen kernel.
+/// The plan is also used for LayoutLeft multivectors with the merge
+/// path kernel; the transpose modes use the default kernels. Call
+/// handle.reset_plan() if the pattern of A changes in place.
+///
+/// With the SPMV_BANDED control, the plan also keeps the range of the
+/// columns of each partition of the rows. For rank 1 vectors, the teams
+/// whose range fits in team scratch copy that window of x there, so
+/// that the rows of a banded or stencil matrix read each entry of x
+/// from global memory once per team.
+///
+/// If the controls of the handle have cache_transpose set, the
+/// transpose modes instead build an explicit transpose of A in the
+/// handle once, and run the non transpose kernels on it, which avoids
+/// the atomic updates of y of the transpose kernels. Call
+/// handle.values_updated() after changing the values of A in place.
+template <class lno_t, class size_type, class ExecutionSpace,
+          class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
+void
+spmv(SPMVHandle<lno_t, size_type, ExecutionSpace>& handle,
+     const char mode[],
+     const AlphaType& alpha,
+     const AMatrix& A,
+     const XVector& x,
+     const BetaType& beta,
+     const YVector& y) {
+  static_assert (std::is_same<typename AMatrix::non_const_ordinal_type, lno_t>::value,
+                 "KokkosSparse::spmv: The handle and the matrix must have the same ordinal type.");
+  typedef typename Kokkos::Impl::if_c<XVector::rank == 2, RANK_TWO, RANK_ONE>::type RANK_SPECIALISE;
+  spmv (handle, mode, alpha, A, x, beta, y, RANK_SPECIALISE ());
+}
+
+}
+
+#endif
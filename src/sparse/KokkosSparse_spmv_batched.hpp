@@ -0,0 +1,107 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#ifndef KOKKOSSPARSE_SPMV_BATCHED_HPP_
+#define KOKKOSSPARSE_SPMV_BATCHED_HPP_
+
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_BatchedCrsMatrix.hpp"
+#include "KokkosSparse_batched_solvers_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \brief Sparse matrix-vector multiply with every matrix of a batch.
+///
+/// Compute Y(b,:) = beta*Y(b,:) + alpha*Op(A_b)*X(b,:) for every matrix
+/// A_b of the batch, where X and Y are rank 2 Kokkos::View instances with
+/// one row per matrix and Op(A_b) is A_b ("N") or conj(A_b) ("C"). If
+/// beta == 0, ignore and overwrite the initial entries of Y. Each matrix
+/// is multiplied by one team, with the team threads over the rows.
+template <class AlphaType, class ScalarType, class OrdinalType, class Device, class SizeType,
+          class XMV, class BetaType, class YMV>
+void
+spmv (const char mode[],
+      const AlphaType& alpha,
+      const BatchedCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& A,
+      const XMV& X,
+      const BetaType& beta,
+      const YMV& Y)
+{
+  typedef BatchedCrsMatrix<ScalarType, OrdinalType, Device, SizeType> AMatrix;
+  static_assert ((int) XMV::rank == 2 && (int) YMV::rank == 2,
+                 "KokkosSparse::Experimental::spmv: X and Y must have rank 2, one row per matrix of the batch.");
+  static_assert (std::is_same<typename YMV::value_type,
+                   typename YMV::non_const_value_type>::value,
+                 "KokkosSparse::Experimental::spmv: Output Vector must be non-const.");
+
+  if ((mode[0] != NoTranspose[0]) && (mode[0] != Conjugate[0])) {
+    Kokkos::Impl::throw_runtime_exception ("KokkosSparse::Experimental::spmv: BatchedCrsMatrix only supports the modes N and C.");
+  }
+  if ((static_cast<size_t> (A.numMatrices ()) != static_cast<size_t> (X.extent(0))) ||
+      (static_cast<size_t> (A.numMatrices ()) != static_cast<size_t> (Y.extent(0))) ||
+      (static_cast<size_t> (A.numCols ()) > static_cast<size_t> (X.extent(1))) ||
+      (static_cast<size_t> (A.numRows ()) > static_cast<size_t> (Y.extent(1)))) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmv: Dimensions do not match: "
+       << "A: " << A.numMatrices () << " matrices of " << A.numRows () << " x " << A.numCols ()
+       << ", X: " << X.extent(0) << " x " << X.extent(1)
+       << ", Y: " << Y.extent(0) << " x " << Y.extent(1)
+       ;
+
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  if (mode[0] == Conjugate[0]) {
+    Impl::spmv_batched<AMatrix, XMV, YMV, true> (alpha, A, X, beta, Y);
+  }
+  else {
+    Impl::spmv_batched<AMatrix, XMV, YMV, false> (alpha, A, X, beta, Y);
+  }
+}
+
+}
+}
+
+#endif
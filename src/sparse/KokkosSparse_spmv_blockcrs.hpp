@@ -0,0 +1,114 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSSPARSE_SPMV_BLOCKCRS_HPP_
+#define KOKKOSSPARSE_SPMV_BLOCKCRS_HPP_
+
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_BlockCrsMatrix.hpp"
+#include "KokkosSparse_spmv_blockcrs_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \brief Local sparse matrix-vector multiply with a BlockCrsMatrix.
+///
+/// Compute y = beta*y + alpha*A*x, where x and y are either both rank 1
+/// or both rank 2 Kokkos::View instances over the point rows and
+/// columns of A, i.e. A.numRows()*A.blockDim() entries of y and
+/// A.numCols()*A.blockDim() of x. The block sizes 2 to 8 use kernels
+/// with the block size as a compile time constant; the other sizes use
+/// a runtime block size kernel. If beta == 0, ignore and overwrite the
+/// initial entries of y.
+///
+/// \param mode [in] "N" for no transpose; the only supported mode.
+template <class AlphaType, class ScalarType, class OrdinalType, class Device, class MemoryTraits, class SizeType,
+          class XVector, class BetaType, class YVector>
+void
+spmv (const char mode[],
+      const AlphaType& alpha,
+      const BlockCrsMatrix<ScalarType, OrdinalType, Device, MemoryTraits, SizeType>& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y)
+{
+  typedef BlockCrsMatrix<ScalarType, OrdinalType, Device, MemoryTraits, SizeType> AMatrix;
+  static_assert ((int) XVector::rank == (int) YVector::rank,
+                 "KokkosSparse::Experimental::spmv: Vector ranks do not match.");
+  static_assert ((int) XVector::rank == 1 || (int) XVector::rank == 2,
+                 "KokkosSparse::Experimental::spmv: x and y must have rank 1 or 2.");
+  static_assert (std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+                 "KokkosSparse::Experimental::spmv: Output Vector must be non-const.");
+
+  if (mode[0] != NoTranspose[0]) {
+    Kokkos::Impl::throw_runtime_exception ("KokkosSparse::Experimental::spmv: BlockCrsMatrix only supports the mode N.");
+  }
+  const size_t block_size = A.blockDim ();
+  if ((x.extent(1) != y.extent(1)) ||
+      (static_cast<size_t> (A.numCols ()) * block_size > static_cast<size_t> (x.extent(0))) ||
+      (static_cast<size_t> (A.numRows ()) * block_size > static_cast<size_t> (y.extent(0)))) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmv: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols() << " blocks of size " << block_size
+       << ", x: " << x.extent(0) << " x " << x.extent(1)
+       << ", y: " << y.extent(0) << " x " << y.extent(1)
+       ;
+
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  if (beta == Kokkos::Details::ArithTraits<BetaType>::zero ()) {
+    Impl::spmv_blockcrs_beta<AMatrix, XVector, YVector, 0> (alpha, A, x, beta, y);
+  }
+  else {
+    Impl::spmv_blockcrs_beta<AMatrix, XVector, YVector, 1> (alpha, A, x, beta, y);
+  }
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSSPARSE_SPMV_CONTROLS_HPP
+#define _KOKKOSSPARSE_SPMV_CONTROLS_HPP
+
+#include <cstdint>
+
+namespace KokkosSparse{
+
+enum SPMVAlgorithm{SPMV_DEFAULT, SPMV_MERGE_PATH, SPMV_BANDED};
+
+/**
+ * \brief Options of the spmv overloads taking controls as first argument.
+ * SPMV_DEFAULT runs the same kernels as spmv without controls.
+ * SPMV_MERGE_PATH splits the merged list of row ends and nonzeroes evenly among
+ * the threads, so that a few very dense rows do not load imbalance the kernel.
+ * It is used for the non transpose modes with rank 1 vectors and LayoutLeft
+ * multivectors; the other cases run the default kernels.
+ * SPMV_BANDED is for the banded and stencil matrices: the spmv overloads taking
+ * a SPMVHandle find the range of columns of each workset of rows, and the teams
+ * whose range fits in team scratch copy that window of x there before reading
+ * it. It is used for the non transpose modes with rank 1 vectors; without a
+ * handle, or in the other cases, it runs the default kernels.
+ * With cache_transpose, the spmv overloads taking a SPMVHandle run the
+ * transpose modes as the non transpose kernel on an explicit transpose of the
+ * matrix, stored in the handle, instead of atomically adding into y.
+ */
+class SPMVControls{
+  SPMVAlgorithm algorithm;
+  //merge path items (row ends and nonzeroes) of a thread, 0 to choose from the concurrency.
+  int64_t merge_path_items_per_thread;
+  //whether the handle keeps an explicit transpose for the transpose modes.
+  bool cache_transpose;
+public:
+  SPMVControls(SPMVAlgorithm algorithm_ = SPMV_DEFAULT):
+    algorithm(algorithm_), merge_path_items_per_thread(0), cache_transpose(false){}
+
+  /**
+   * \brief sets the spmv algorithm.
+   * \param algorithm_: SPMV_DEFAULT, SPMV_MERGE_PATH or SPMV_BANDED.
+   */
+  void set_algorithm(SPMVAlgorithm algorithm_){this->algorithm = algorithm_;}
+  SPMVAlgorithm get_algorithm() const {return this->algorithm;}
+
+  /**
+   * \brief sets the number of row ends and nonzeroes handled by a thread in the
+   * merge path algorithm.
+   * \param merge_path_items_per_thread_: the items of a thread, 0 to choose it
+   * from the concurrency of the execution space.
+   */
+  void set_merge_path_items_per_thread(int64_t merge_path_items_per_thread_){
+    this->merge_path_items_per_thread = merge_path_items_per_thread_;
+  }
+  int64_t get_merge_path_items_per_thread() const {return this->merge_path_items_per_thread;}
+
+  /**
+   * \brief sets whether the transpose modes use a transpose of the matrix
+   * cached in the SPMVHandle.
+   * \param cache_transpose_: if true, the first transpose spmv with a handle
+   * builds the transpose, and the following ones reuse it. It costs the memory
+   * of a second copy of the matrix.
+   */
+  void set_cache_transpose(bool cache_transpose_){this->cache_transpose = cache_transpose_;}
+  bool get_cache_transpose() const {return this->cache_transpose;}
+};
+
+}
+
+#endif
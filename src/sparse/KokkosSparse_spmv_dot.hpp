@@ -0,0 +1,139 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSSPARSE_SPMV_DOT_HPP_
+#define KOKKOSSPARSE_SPMV_DOT_HPP_
+
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmv_dot_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \brief Fused y = beta*y + alpha*Op(A)*x and dot(w, y).
+///
+/// Returns dot(w, y) of the updated y, computed in the same kernel as
+/// the product, which saves the separate sweep over y and w of a dot
+/// in a Krylov solver (for CG, w is the p of Ap = A*p).
+///
+/// \param mode [in] "N" for no transpose or "C" for conjugate.
+/// \param alpha [in] Scalar multiplier for the matrix A.
+/// \param A [in] The sparse matrix; KokkosSparse::CrsMatrix instance.
+/// \param x [in] Rank 1 Kokkos::View, with at least A.numCols() entries.
+/// \param beta [in] Scalar multiplier for y. If 0, y is overwritten.
+/// \param y [in/out] Rank 1 Kokkos::View, with A.numRows() entries.
+/// \param w [in] Rank 1 Kokkos::View, with A.numRows() entries.
+template <class AlphaType, class AMatrix, class XVector, class BetaType, class YVector, class WVector>
+typename Kokkos::Details::InnerProductSpaceTraits<typename WVector::non_const_value_type>::dot_type
+spmv_axpby_dot (const char mode[],
+                const AlphaType& alpha,
+                const AMatrix& A,
+                const XVector& x,
+                const BetaType& beta,
+                const YVector& y,
+                const WVector& w)
+{
+  static_assert ((int) XVector::rank == 1 && (int) YVector::rank == 1 && (int) WVector::rank == 1,
+                 "KokkosSparse::Experimental::spmv_axpby_dot: x, y and w must have rank 1.");
+  static_assert (std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+                 "KokkosSparse::Experimental::spmv_axpby_dot: Output Vector must be non-const.");
+
+  if ((mode[0] != NoTranspose[0]) && (mode[0] != Conjugate[0])) {
+    Kokkos::Impl::throw_runtime_exception ("KokkosSparse::Experimental::spmv_axpby_dot: only the modes N and C are supported.");
+  }
+  if ((static_cast<size_t> (A.numCols ()) > static_cast<size_t> (x.extent(0))) ||
+      (static_cast<size_t> (A.numRows ()) != static_cast<size_t> (y.extent(0))) ||
+      (static_cast<size_t> (A.numRows ()) != static_cast<size_t> (w.extent(0)))) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmv_axpby_dot: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols()
+       << ", x: " << x.extent(0)
+       << ", y: " << y.extent(0)
+       << ", w: " << w.extent(0)
+       ;
+
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  const bool dobeta = beta != Kokkos::Details::ArithTraits<BetaType>::zero ();
+  if (mode[0] == Conjugate[0]) {
+    if (dobeta) return Impl::spmv_dot_beta<AMatrix, XVector, YVector, WVector, 1, true> (alpha, A, x, beta, y, w);
+    else return Impl::spmv_dot_beta<AMatrix, XVector, YVector, WVector, 0, true> (alpha, A, x, beta, y, w);
+  }
+  else {
+    if (dobeta) return Impl::spmv_dot_beta<AMatrix, XVector, YVector, WVector, 1, false> (alpha, A, x, beta, y, w);
+    else return Impl::spmv_dot_beta<AMatrix, XVector, YVector, WVector, 0, false> (alpha, A, x, beta, y, w);
+  }
+}
+
+/// \brief Fused y = beta*y + alpha*Op(A)*x and dot(x, y), over the first
+///   A.numRows() entries of x.
+///
+/// x may have more entries than rows of A, e.g. the owned and received
+/// entries of a distributed vector; the dot only uses the owned ones.
+template <class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
+typename Kokkos::Details::InnerProductSpaceTraits<typename XVector::non_const_value_type>::dot_type
+spmv_dot (const char mode[],
+          const AlphaType& alpha,
+          const AMatrix& A,
+          const XVector& x,
+          const BetaType& beta,
+          const YVector& y)
+{
+  if (static_cast<size_t> (A.numRows ()) > static_cast<size_t> (x.extent(0))) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmv_dot: x has " << x.extent(0)
+       << " entries, fewer than the " << A.numRows () << " rows of A.";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  auto x_owned = Kokkos::subview (x, std::pair<size_t, size_t> (0, A.numRows ()));
+  return spmv_axpby_dot (mode, alpha, A, x, beta, y, x_owned);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_SPMV_DYNAMICCRS_HPP_
+#define KOKKOSSPARSE_SPMV_DYNAMICCRS_HPP_
+
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_DynamicCrsMatrix.hpp"
+#include "KokkosSparse_spmv_dynamiccrs_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \brief Local sparse matrix-vector multiply with a DynamicCrsMatrix.
+///
+/// Compute y = beta*y + alpha*Op(A)*x, where x and y are rank 1
+/// Kokkos::View instances and Op(A) is A ("N") or conj(A) ("C"). If
+/// beta == 0, ignore and overwrite the initial entries of y. Only the
+/// filled slots of each row are read, so the matrix does not need to
+/// be compacted after entries were inserted. Must not run concurrently
+/// with sumIntoOrInsert on A.
+template <class AlphaType, class ScalarType, class OrdinalType, class Device, class SizeType,
+          class XVector, class BetaType, class YVector>
+void
+spmv (const char mode[],
+      const AlphaType& alpha,
+      const DynamicCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y)
+{
+  typedef DynamicCrsMatrix<ScalarType, OrdinalType, Device, SizeType> AMatrix;
+  static_assert ((int) XVector::rank == 1 && (int) YVector::rank == 1,
+                 "KokkosSparse::Experimental::spmv: x and y must have rank 1.");
+  static_assert (std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+                 "KokkosSparse::Experimental::spmv: Output Vector must be non-const.");
+
+  if ((mode[0] != NoTranspose[0]) && (mode[0] != Conjugate[0])) {
+    Kokkos::Impl::throw_runtime_exception ("KokkosSparse::Experimental::spmv: DynamicCrsMatrix only supports the modes N and C.");
+  }
+  if ((static_cast<size_t> (A.numCols ()) > static_cast<size_t> (x.extent(0))) ||
+      (static_cast<size_t> (A.numRows ()) > static_cast<size_t> (y.extent(0)))) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmv: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols()
+       << ", x: " << x.extent(0)
+       << ", y: " << y.extent(0)
+       ;
+
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  const bool dobeta = beta != Kokkos::Details::ArithTraits<BetaType>::zero ();
+  if (mode[0] == Conjugate[0]) {
+    if (dobeta) Impl::spmv_dynamiccrs_beta<AMatrix, XVector, YVector, 1, true> (alpha, A, x, beta, y);
+    else Impl::spmv_dynamiccrs_beta<AMatrix, XVector, YVector, 0, true> (alpha, A, x, beta, y);
+  }
+  else {
+    if (dobeta) Impl::spmv_dynamiccrs_beta<AMatrix, XVector, YVector, 1, false> (alpha, A, x, beta, y);
+    else Impl::spmv_dynamiccrs_beta<AMatrix, XVector, YVector, 0, false> (alpha, A, x, beta, y);
+  }
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,343 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_Core.hpp>
+#include "KokkosSparse_spmv_controls.hpp"
+#include "KokkosSparse_analysis.hpp"
+
+#ifndef _KOKKOSSPARSE_SPMV_HANDLE_HPP
+#define _KOKKOSSPARSE_SPMV_HANDLE_HPP
+
+namespace KokkosSparse{
+
+//the kernel chosen by the inspection of a matrix.
+enum SPMVHandleKernel{SPMV_KERNEL_BALANCED_ROWS, SPMV_KERNEL_MERGE_PATH, SPMV_KERNEL_BANDED};
+
+/**
+ * \brief Plan of spmv for a matrix, computed by an inspection the first time
+ * the handle is used with the matrix and reused by the following spmv calls.
+ * The inspection splits the rows into worksets of about the same number of
+ * nonzeroes, chooses the team and vector sizes, and chooses the merge path
+ * kernel instead when a few rows are too dense for a row partition.
+ * The plan is recomputed if the handle is called with another matrix, or after
+ * reset_plan(), e.g. when the pattern of the matrix changes in place.
+ * With the cache_transpose control, the handle also keeps an explicit transpose
+ * of the matrix for the transpose modes. Its pattern is kept with the plan, and
+ * its values are copied again after values_updated(), when only the values of
+ * the matrix change.
+ * With set_row_order(), e.g. the order of KokkosGraph::graph_row_cluster_order,
+ * the worksets are consecutive rows of that order instead of consecutive rows
+ * of the matrix, so that the rows of a team share their columns.
+ * With the SPMV_BANDED control, the plan also keeps the range of the columns
+ * of each workset, so that the teams can stage that window of x in scratch.
+ * With set_analysis(), the inspection reads the longest row from the analysis
+ * of the matrix, from KokkosSparse::analyze, instead of reducing the row map.
+ */
+template <class lno_t_, class size_type_, class ExecutionSpace>
+class SPMVHandle{
+public:
+  typedef lno_t_ nnz_lno_t;
+  typedef size_type_ size_type;
+  typedef ExecutionSpace execution_space;
+  typedef Kokkos::View<nnz_lno_t *, execution_space> nnz_lno_view_t;
+  typedef Kokkos::View<nnz_lno_t *, Kokkos::HostSpace> nnz_lno_host_view_t;
+  typedef Kokkos::View<size_type *, execution_space> size_type_view_t;
+  typedef Kokkos::View<char *, execution_space> byte_view_t;
+private:
+  SPMVControls controls;
+  //rows in the order of the worksets, empty for the order of the matrix.
+  nnz_lno_view_t row_order;
+
+  bool is_inspected;
+  //the matrix of the plan.
+  const void *plan_row_map;
+  nnz_lno_t plan_num_rows;
+  size_type plan_nnz;
+
+  SPMVHandleKernel kernel;
+  //first row of each workset, num_worksets + 1 entries.
+  nnz_lno_view_t workset_offsets;
+  int team_size;
+  int vector_length;
+  //items of a thread for the merge path kernel.
+  int64_t merge_path_items_per_thread;
+  //first column and number of columns of the window of x read by each
+  //workset, and the widest window, for the banded kernel.
+  nnz_lno_view_t workset_col_begin;
+  nnz_lno_view_t workset_col_length;
+  nnz_lno_t max_workset_window;
+
+  //plan of the symmetric spmv: the rows grouped by color, so that the rows of
+  //a color do not scatter into the same entries of y.
+  bool is_symmetric_inspected;
+  const void *symmetric_plan_row_map;
+  nnz_lno_t symmetric_plan_num_rows;
+  size_type symmetric_plan_nnz;
+  //rows of color c are color_rows(color_xadj(c):color_xadj(c+1)).
+  nnz_lno_host_view_t symmetric_color_xadj;
+  nnz_lno_view_t symmetric_color_rows;
+
+  //explicit transpose of the matrix, for the transpose modes.
+  bool is_transpose_inspected;
+  const void *transpose_plan_row_map;
+  nnz_lno_t transpose_plan_num_rows;
+  size_type transpose_plan_nnz;
+  size_type_view_t transpose_row_map;
+  nnz_lno_view_t transpose_entries;
+  //entry of the matrix for each entry of the transpose.
+  size_type_view_t transpose_permutation;
+  //the handle does not know the scalar type, the values are kept as bytes.
+  byte_view_t transpose_values;
+  bool are_transpose_values_current;
+
+  //analysis of the matrix, from KokkosSparse::analyze.
+  MatrixAnalysis analysis;
+public:
+  /**
+   * \brief constructor.
+   * \param controls_: SPMV_DEFAULT lets the inspection choose the kernel,
+   * SPMV_MERGE_PATH always uses the merge path kernel.
+   */
+  SPMVHandle(const SPMVControls &controls_ = SPMVControls()):
+    controls(controls_), row_order(),
+    is_inspected(false), plan_row_map(NULL), plan_num_rows(0), plan_nnz(0),
+    kernel(SPMV_KERNEL_BALANCED_ROWS), workset_offsets(),
+    team_size(-1), vector_length(-1), merge_path_items_per_thread(0),
+    workset_col_begin(), workset_col_length(), max_workset_window(0),
+    is_symmetric_inspected(false), symmetric_plan_row_map(NULL),
+    symmetric_plan_num_rows(0), symmetric_plan_nnz(0),
+    symmetric_color_xadj(), symmetric_color_rows(),
+    is_transpose_inspected(false), transpose_plan_row_map(NULL),
+    transpose_plan_num_rows(0), transpose_plan_nnz(0),
+    transpose_row_map(), transpose_entries(), transpose_permutation(),
+    transpose_values(), are_transpose_values_current(false), analysis(){}
+
+  const SPMVControls &get_controls() const {return this->controls;}
+
+  /**
+   * \brief sets the controls, and invalidates the plan.
+   */
+  void set_controls(const SPMVControls &controls_){
+    this->controls = controls_;
+    this->reset_plan();
+  }
+
+  /**
+   * \brief sets the order of the rows in the worksets, row_order_(k) being the
+   * k-th row, and invalidates the plan. An empty view restores the order of
+   * the matrix. The order is only used by the balanced rows kernel.
+   */
+  void set_row_order(const nnz_lno_view_t &row_order_){
+    this->row_order = row_order_;
+    this->reset_plan();
+  }
+  nnz_lno_view_t get_row_order() const {return this->row_order;}
+
+  /**
+   * \brief invalidates the plan, so that the next spmv inspects the matrix again.
+   */
+  void reset_plan(){
+    this->is_inspected = false;
+    this->plan_row_map = NULL;
+    this->workset_offsets = nnz_lno_view_t();
+    this->workset_col_begin = nnz_lno_view_t();
+    this->workset_col_length = nnz_lno_view_t();
+    this->max_workset_window = 0;
+    this->is_symmetric_inspected = false;
+    this->symmetric_plan_row_map = NULL;
+    this->symmetric_color_xadj = nnz_lno_host_view_t();
+    this->symmetric_color_rows = nnz_lno_view_t();
+    this->is_transpose_inspected = false;
+    this->transpose_plan_row_map = NULL;
+    this->transpose_row_map = size_type_view_t();
+    this->transpose_entries = nnz_lno_view_t();
+    this->transpose_permutation = size_type_view_t();
+    this->transpose_values = byte_view_t();
+    this->are_transpose_values_current = false;
+  }
+
+  /**
+   * \brief marks the values of the matrix as changed, so that the next
+   * transpose spmv copies them into the cached transpose. The pattern of the
+   * transpose is kept.
+   */
+  void values_updated(){
+    this->are_transpose_values_current = false;
+  }
+
+  /**
+   * \brief returns true if the plan was computed for a matrix with this row map
+   * and sizes.
+   */
+  bool is_plan_for(const void *row_map_, nnz_lno_t num_rows_, size_type nnz_) const {
+    return this->is_inspected && this->plan_row_map == row_map_ &&
+        this->plan_num_rows == num_rows_ && this->plan_nnz == nnz_;
+  }
+
+  /**
+   * \brief stores the plan computed by the inspection.
+   */
+  void set_plan(const void *row_map_, nnz_lno_t num_rows_, size_type nnz_,
+      SPMVHandleKernel kernel_, nnz_lno_view_t workset_offsets_,
+      int team_size_, int vector_length_, int64_t merge_path_items_per_thread_){
+    this->plan_row_map = row_map_;
+    this->plan_num_rows = num_rows_;
+    this->plan_nnz = nnz_;
+    this->kernel = kernel_;
+    this->workset_offsets = workset_offsets_;
+    this->team_size = team_size_;
+    this->vector_length = vector_length_;
+    this->merge_path_items_per_thread = merge_path_items_per_thread_;
+    this->workset_col_begin = nnz_lno_view_t();
+    this->workset_col_length = nnz_lno_view_t();
+    this->max_workset_window = 0;
+    this->is_inspected = true;
+  }
+
+  /**
+   * \brief stores the column windows of the worksets of the banded kernel,
+   * after set_plan.
+   */
+  void set_workset_windows(nnz_lno_view_t workset_col_begin_, nnz_lno_view_t workset_col_length_,
+      nnz_lno_t max_workset_window_){
+    this->workset_col_begin = workset_col_begin_;
+    this->workset_col_length = workset_col_length_;
+    this->max_workset_window = max_workset_window_;
+  }
+
+  /**
+   * \brief returns true if the symmetric plan was computed for a matrix with
+   * this row map and sizes.
+   */
+  bool is_symmetric_plan_for(const void *row_map_, nnz_lno_t num_rows_, size_type nnz_) const {
+    return this->is_symmetric_inspected && this->symmetric_plan_row_map == row_map_ &&
+        this->symmetric_plan_num_rows == num_rows_ && this->symmetric_plan_nnz == nnz_;
+  }
+
+  /**
+   * \brief stores the row coloring of the symmetric spmv.
+   */
+  void set_symmetric_plan(const void *row_map_, nnz_lno_t num_rows_, size_type nnz_,
+      nnz_lno_host_view_t color_xadj_, nnz_lno_view_t color_rows_){
+    this->symmetric_plan_row_map = row_map_;
+    this->symmetric_plan_num_rows = num_rows_;
+    this->symmetric_plan_nnz = nnz_;
+    this->symmetric_color_xadj = color_xadj_;
+    this->symmetric_color_rows = color_rows_;
+    this->is_symmetric_inspected = true;
+  }
+
+  /**
+   * \brief returns true if the cached transpose is of a matrix with this row
+   * map and sizes.
+   */
+  bool is_transpose_plan_for(const void *row_map_, nnz_lno_t num_rows_, size_type nnz_) const {
+    return this->is_transpose_inspected && this->transpose_plan_row_map == row_map_ &&
+        this->transpose_plan_num_rows == num_rows_ && this->transpose_plan_nnz == nnz_;
+  }
+
+  /**
+   * \brief stores the pattern of the transpose, and the entry of the matrix
+   * of each of its entries. The values are copied by set_transpose_values.
+   */
+  void set_transpose_plan(const void *row_map_, nnz_lno_t num_rows_, size_type nnz_,
+      size_type_view_t transpose_row_map_, nnz_lno_view_t transpose_entries_,
+      size_type_view_t transpose_permutation_){
+    this->transpose_plan_row_map = row_map_;
+    this->transpose_plan_num_rows = num_rows_;
+    this->transpose_plan_nnz = nnz_;
+    this->transpose_row_map = transpose_row_map_;
+    this->transpose_entries = transpose_entries_;
+    this->transpose_permutation = transpose_permutation_;
+    this->transpose_values = byte_view_t();
+    this->are_transpose_values_current = false;
+    this->is_transpose_inspected = true;
+  }
+
+  /**
+   * \brief stores the values of the transpose.
+   */
+  void set_transpose_values(byte_view_t transpose_values_){
+    this->transpose_values = transpose_values_;
+    this->are_transpose_values_current = true;
+  }
+
+  /**
+   * \brief attaches the analysis of the matrix, used by the inspection if it
+   * is of the matrix of the spmv call. It is kept by reset_plan(); attach the
+   * new analysis, or call reset_analysis(), if the pattern changes in place.
+   */
+  void set_analysis(const MatrixAnalysis &analysis_){
+    this->analysis = analysis_;
+  }
+  void reset_analysis(){
+    this->analysis = MatrixAnalysis();
+  }
+  bool has_analysis_for(const void *row_map_, nnz_lno_t num_rows_, size_type nnz_) const {
+    return this->analysis.is_for(row_map_, int64_t(num_rows_), size_t(nnz_));
+  }
+  const MatrixAnalysis &get_analysis() const {return this->analysis;}
+
+  bool get_is_inspected() const {return this->is_inspected;}
+  SPMVHandleKernel get_kernel() const {return this->kernel;}
+  nnz_lno_view_t get_workset_offsets() const {return this->workset_offsets;}
+  int get_team_size() const {return this->team_size;}
+  int get_vector_length() const {return this->vector_length;}
+  int64_t get_merge_path_items_per_thread() const {return this->merge_path_items_per_thread;}
+  nnz_lno_view_t get_workset_col_begin() const {return this->workset_col_begin;}
+  nnz_lno_view_t get_workset_col_length() const {return this->workset_col_length;}
+  nnz_lno_t get_max_workset_window() const {return this->max_workset_window;}
+  bool get_is_symmetric_inspected() const {return this->is_symmetric_inspected;}
+  nnz_lno_host_view_t get_symmetric_color_xadj() const {return this->symmetric_color_xadj;}
+  nnz_lno_view_t get_symmetric_color_rows() const {return this->symmetric_color_rows;}
+  bool get_is_transpose_inspected() const {return this->is_transpose_inspected;}
+  bool get_are_transpose_values_current() const {return this->are_transpose_values_current;}
+  size_type_view_t get_transpose_row_map() const {return this->transpose_row_map;}
+  nnz_lno_view_t get_transpose_entries() const {return this->transpose_entries;}
+  size_type_view_t get_transpose_permutation() const {return this->transpose_permutation;}
+  byte_view_t get_transpose_values() const {return this->transpose_values;}
+};
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+/// \file KokkosSparse_spmv_partitioned.hpp
+/// \brief Sparse matrix-vector multiply with a RowPartitionedCrsMatrix,
+///   one part per execution space instance.
+
+#ifndef KOKKOSSPARSE_SPMV_PARTITIONED_HPP_
+#define KOKKOSSPARSE_SPMV_PARTITIONED_HPP_
+
+#include <sstream>
+#include <vector>
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosSparse_spmv_split.hpp"
+#include "KokkosSparse_RowPartitionedCrsMatrix.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \brief Sparse matrix-vector multiply with a RowPartitionedCrsMatrix.
+///
+/// Compute y = beta*y + alpha*Op(A)*x, where Op(A) is A ("N") or conj(A)
+/// ("C"). The product of part p with the whole x is written to its rows
+/// of y, and is launched on spaces[p] without waiting for the others, so
+/// on Cuda the parts run concurrently on the streams of their instances.
+/// x must be readable by all of them. Call fence() on each instance
+/// before reading y. x and y are both rank 1 or both rank 2.
+///
+/// \param spaces [in] One instance per part, or a single instance for all.
+template <class AlphaType, class ScalarType, class OrdinalType, class Device, class SizeType,
+          class XVector, class BetaType, class YVector>
+void
+spmv (const std::vector<typename Device::execution_space>& spaces,
+      const char mode[],
+      const AlphaType& alpha,
+      const RowPartitionedCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y)
+{
+  Impl::spmv_split_check (mode, A, x, y);
+  if (spaces.size () != 1 && spaces.size () != size_t (A.numParts ())) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmv: " << spaces.size ()
+       << " execution space instances for " << A.numParts () << " parts.";
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  for (int p = 0; p < A.numParts (); ++p) {
+    if (A.part (p).numRows () == 0) {
+      continue;
+    }
+    const auto y_part = Impl::SplitRows<YVector>::get (y, A.rowBegin (p), A.rowBegin (p + 1));
+    KokkosSparse::spmv (spaces[spaces.size () == 1 ? 0 : p], mode, alpha, A.part (p), x, beta, y_part);
+  }
+}
+
+template <class AlphaType, class ScalarType, class OrdinalType, class Device, class SizeType,
+          class XVector, class BetaType, class YVector>
+void
+spmv (const char mode[],
+      const AlphaType& alpha,
+      const RowPartitionedCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y)
+{
+  const std::vector<typename Device::execution_space> spaces (1);
+  spmv (spaces, mode, alpha, A, x, beta, y);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,189 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+/// \file KokkosSparse_spmv_split.hpp
+/// \brief Sparse matrix-vector multiply with a SplitCrsMatrix, in an owned
+///   and a ghost phase that can bracket a halo exchange.
+
+#ifndef KOKKOSSPARSE_SPMV_SPLIT_HPP_
+#define KOKKOSSPARSE_SPMV_SPLIT_HPP_
+
+#include <sstream>
+#include <utility>
+#include "Kokkos_ArithTraits.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosSparse_SplitCrsMatrix.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+namespace Impl {
+
+// The rows [begin, end) of a single vector or multivector.
+template<class XVector, int rank = XVector::rank>
+struct SplitRows {
+  static auto get (const XVector& x, const size_t begin, const size_t end)
+    -> decltype (Kokkos::subview (x, std::make_pair (begin, end)))
+  {
+    return Kokkos::subview (x, std::make_pair (begin, end));
+  }
+};
+
+template<class XVector>
+struct SplitRows<XVector, 2> {
+  static auto get (const XVector& x, const size_t begin, const size_t end)
+    -> decltype (Kokkos::subview (x, std::make_pair (begin, end), Kokkos::ALL ()))
+  {
+    return Kokkos::subview (x, std::make_pair (begin, end), Kokkos::ALL ());
+  }
+};
+
+template <class AMatrix, class XVector, class YVector>
+void
+spmv_split_check (const char mode[], const AMatrix& A, const XVector& x, const YVector& y)
+{
+  static_assert ((int) XVector::rank == (int) YVector::rank,
+                 "KokkosSparse::Experimental::spmv: Vector ranks do not match.");
+  static_assert (std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+                 "KokkosSparse::Experimental::spmv: Output Vector must be non-const.");
+
+  if ((mode[0] != NoTranspose[0]) && (mode[0] != Conjugate[0])) {
+    Kokkos::Impl::throw_runtime_exception ("KokkosSparse::Experimental::spmv: SplitCrsMatrix and RowPartitionedCrsMatrix only support the modes N and C.");
+  }
+  if ((x.extent(1) != y.extent(1)) ||
+      (static_cast<size_t> (A.numCols ()) > static_cast<size_t> (x.extent(0))) ||
+      (static_cast<size_t> (A.numRows ()) > static_cast<size_t> (y.extent(0)))) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmv: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols()
+       << ", x: " << x.extent(0) << " x " << x.extent(1)
+       << ", y: " << y.extent(0) << " x " << y.extent(1)
+       ;
+
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+}
+
+}
+
+/// \brief Owned phase of y = beta*y + alpha*Op(A)*x with a SplitCrsMatrix.
+///
+/// Compute y = beta*y + alpha*Op(A.owned)*x, reading only the owned
+/// entries x(0:A.columnThreshold()) of x, so it can be launched on
+/// \c space before the ghost entries of x have been received. Op(A) is
+/// A ("N") or conj(A) ("C"); x and y are both rank 1 or both rank 2.
+template <class AlphaType, class ScalarType, class OrdinalType, class Device, class SizeType,
+          class XVector, class BetaType, class YVector>
+void
+spmv_owned (const typename Device::execution_space& space,
+            const char mode[],
+            const AlphaType& alpha,
+            const SplitCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& A,
+            const XVector& x,
+            const BetaType& beta,
+            const YVector& y)
+{
+  Impl::spmv_split_check (mode, A, x, y);
+  const auto x_owned = Impl::SplitRows<XVector>::get (x, 0, A.columnThreshold ());
+  KokkosSparse::spmv (space, mode, alpha, A.owned, x_owned, beta, y);
+}
+
+/// \brief Ghost phase of y = beta*y + alpha*Op(A)*x with a SplitCrsMatrix.
+///
+/// Compute y = y + alpha*Op(A.ghost)*x(A.columnThreshold():A.numCols()),
+/// after spmv_owned and once the ghost entries of x have been received.
+template <class AlphaType, class ScalarType, class OrdinalType, class Device, class SizeType,
+          class XVector, class YVector>
+void
+spmv_ghost (const typename Device::execution_space& space,
+            const char mode[],
+            const AlphaType& alpha,
+            const SplitCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& A,
+            const XVector& x,
+            const YVector& y)
+{
+  Impl::spmv_split_check (mode, A, x, y);
+  if (A.ghost.nnz () == 0) {
+    return;
+  }
+  typedef Kokkos::Details::ArithTraits<typename YVector::non_const_value_type> KAT;
+  const auto x_ghost = Impl::SplitRows<XVector>::get (x, A.columnThreshold (), A.numCols ());
+  KokkosSparse::spmv (space, mode, alpha, A.ghost, x_ghost, KAT::one (), y);
+}
+
+/// \brief Local sparse matrix-vector multiply with a SplitCrsMatrix.
+///
+/// Compute y = beta*y + alpha*Op(A)*x, as spmv_owned followed by
+/// spmv_ghost on the same execution space instance.
+template <class AlphaType, class ScalarType, class OrdinalType, class Device, class SizeType,
+          class XVector, class BetaType, class YVector>
+void
+spmv (const typename Device::execution_space& space,
+      const char mode[],
+      const AlphaType& alpha,
+      const SplitCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y)
+{
+  spmv_owned (space, mode, alpha, A, x, beta, y);
+  spmv_ghost (space, mode, alpha, A, x, y);
+}
+
+template <class AlphaType, class ScalarType, class OrdinalType, class Device, class SizeType,
+          class XVector, class BetaType, class YVector>
+void
+spmv (const char mode[],
+      const AlphaType& alpha,
+      const SplitCrsMatrix<ScalarType, OrdinalType, Device, SizeType>& A,
+      const XVector& x,
+      const BetaType& beta,
+      const YVector& y)
+{
+  spmv (typename Device::execution_space (), mode, alpha, A, x, beta, y);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,125 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_SPMV_SYMMETRIC_HPP_
+#define KOKKOSSPARSE_SPMV_SYMMETRIC_HPP_
+
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmv_handle.hpp"
+#include "KokkosSparse_spmv_symmetric_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+/// \brief y = beta*y + alpha*A*x, for a symmetric A of which only one
+///   triangle is stored.
+///
+/// Each stored off diagonal entry a_ij stands for both a_ij and a_ji, so A
+/// may hold the upper or the lower triangle (with the diagonal), or any
+/// mix of the two as long as no pair is stored twice. The product reads
+/// each entry once and scatters its transposed contribution into y without
+/// atomics: the rows are colored once, so that rows of the same color share
+/// no column, and the colors run one after the other. The coloring is
+/// stored in the handle and reused while A keeps its row_map.
+///
+/// \param handle [in/out] Holds the row coloring of A.
+/// \param mode [in] "N" or "T"; with A symmetric, both give the same product.
+/// \param alpha [in] Scalar multiplier for the matrix A.
+/// \param A [in] One triangle of a square symmetric KokkosSparse::CrsMatrix.
+/// \param x [in] Rank 1 Kokkos::View, with A.numRows() entries.
+/// \param beta [in] Scalar multiplier for y. If 0, y is overwritten.
+/// \param y [in/out] Rank 1 Kokkos::View, with A.numRows() entries.
+template <class lno_t, class size_type, class ExecutionSpace,
+          class AlphaType, class AMatrix, class XVector, class BetaType, class YVector>
+void
+spmv_symmetric (SPMVHandle<lno_t, size_type, ExecutionSpace>& handle,
+                const char mode[],
+                const AlphaType& alpha,
+                const AMatrix& A,
+                const XVector& x,
+                const BetaType& beta,
+                const YVector& y)
+{
+  static_assert ((int) XVector::rank == 1 && (int) YVector::rank == 1,
+                 "KokkosSparse::Experimental::spmv_symmetric: x and y must have rank 1.");
+  static_assert (std::is_same<typename YVector::value_type,
+                   typename YVector::non_const_value_type>::value,
+                 "KokkosSparse::Experimental::spmv_symmetric: Output Vector must be non-const.");
+
+  if ((mode[0] != NoTranspose[0]) && (mode[0] != Transpose[0])) {
+    Kokkos::Impl::throw_runtime_exception ("KokkosSparse::Experimental::spmv_symmetric: only the modes N and T are supported.");
+  }
+  if ((A.numRows () != A.numCols ()) ||
+      (static_cast<size_t> (A.numCols ()) > static_cast<size_t> (x.extent(0))) ||
+      (static_cast<size_t> (A.numRows ()) != static_cast<size_t> (y.extent(0)))) {
+    std::ostringstream os;
+    os << "KokkosSparse::Experimental::spmv_symmetric: Dimensions do not match: "
+       << ", A: " << A.numRows () << " x " << A.numCols()
+       << ", x: " << x.extent(0)
+       << ", y: " << y.extent(0)
+       ;
+
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+
+  typedef Kokkos::View<
+    typename XVector::const_value_type*,
+    typename XVector::array_layout,
+    typename XVector::device_type,
+    Kokkos::MemoryTraits<Kokkos::Unmanaged|Kokkos::RandomAccess> > XVector_Internal;
+  typedef Kokkos::View<
+    typename YVector::non_const_value_type*,
+    typename YVector::array_layout,
+    typename YVector::device_type,
+    Kokkos::MemoryTraits<Kokkos::Unmanaged> > YVector_Internal;
+
+  XVector_Internal x_i = x;
+  YVector_Internal y_i = y;
+  Impl::spmv_symmetric (handle, alpha, A, x_i, beta, y_i);
+}
+
+}
+}
+
+#endif
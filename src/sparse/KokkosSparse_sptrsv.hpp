@@ -0,0 +1,184 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_sptrsv.hpp
+/// \brief Parallel sparse triangular solve
+///
+/// This file provides KokkosSparse::Experimental::sptrsv_symbolic and
+/// KokkosSparse::Experimental::sptrsv_solve. The symbolic phase computes
+/// the level sets of the triangular matrix once, and stores them in the
+/// sptrsv handle of the kernel handle; the solve phase can then be called
+/// many times with the same sparsity pattern.
+///
+/// The algorithm is chosen when the sptrsv handle is created:
+/// SPTRSV_SEQUENTIAL solves with a single thread, SPTRSV_LVLSCHD_RP and
+/// SPTRSV_LVLSCHD_TP1 launch one kernel per level (range and team policy),
+/// SPTRSV_LVLSCHD_CHAIN solves consecutive small levels in a single
+/// kernel launch, and SPTRSV_SUPERNODAL solves dense supernodal blocks
+/// (detected, or set with SPTRSVHandle::set_supernodes) with batched team
+/// gemv and trsv. SPTRSV_TASK spawns one Kokkos task per block of rows
+/// (SPTRSVHandle::set_task_block_size) that starts as soon as the blocks
+/// it depends on are solved; it needs KOKKOS_ENABLE_TASKDAG, and is level
+/// scheduled otherwise.
+
+#ifndef KOKKOSSPARSE_SPTRSV_HPP_
+#define KOKKOSSPARSE_SPTRSV_HPP_
+
+#include <type_traits>
+#include <stdexcept>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_sptrsv_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+
+#define KOKKOSKERNELS_SPTRSV_SAME_TYPE(A, B) std::is_same<typename std::remove_const<A>::type, typename std::remove_const<B>::type>::value
+
+  /// \brief Symbolic phase of the triangular solve. Computes the level
+  /// sets of the lower (or upper) triangular matrix given in crs format.
+  /// The sptrsv handle must have been created with
+  /// handle->create_sptrsv_handle(nrows, lower_tri).
+  template <typename KernelHandle,
+            typename lno_row_view_t_,
+            typename lno_nnz_view_t_>
+  void sptrsv_symbolic(
+      KernelHandle *handle,
+      lno_row_view_t_ rowmap,
+      lno_nnz_view_t_ entries)
+  {
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+
+    static_assert(KOKKOSKERNELS_SPTRSV_SAME_TYPE(typename lno_row_view_t_::non_const_value_type, size_type),
+        "sptrsv_symbolic: A size_type must match KernelHandle size_type (const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPTRSV_SAME_TYPE(typename lno_nnz_view_t_::non_const_value_type, ordinal_type),
+        "sptrsv_symbolic: A entry type must match KernelHandle entry type (aka nnz_lno_t, and const doesn't matter)");
+
+    typedef typename KernelHandle::SPTRSVHandleType sptrsvHandleType;
+    sptrsvHandleType *sh = handle->get_sptrsv_handle();
+    if (sh == NULL){
+      throw std::runtime_error("sptrsv_symbolic: the sptrsv handle has not been created, call create_sptrsv_handle first");
+    }
+
+    Impl::tri_solve_symbolic(*sh, rowmap, entries);
+  }
+
+  /// \brief Solves Ax = b, where A is the triangular matrix given to
+  /// sptrsv_symbolic. If the symbolic phase has not been run yet, it is
+  /// run first.
+  ///
+  /// \param handle [in/out] kernel handle with the sptrsv handle created.
+  /// \param rowmap [in] row map of A.
+  /// \param entries [in] column indices of A.
+  /// \param values [in] values of A.
+  /// \param b [in] right hand side, rank-1 view, or rank-2 view with
+  ///   one right hand side per column.
+  /// \param x [out] solution, same rank as b.
+  ///
+  /// Rank-2 b and x are solved by the level scheduled multiple right hand
+  /// side kernel, which reads each matrix entry once for all columns.
+  template <typename KernelHandle,
+            typename lno_row_view_t_,
+            typename lno_nnz_view_t_,
+            typename scalar_nnz_view_t_,
+            class BType,
+            class XType>
+  void sptrsv_solve(
+      KernelHandle *handle,
+      lno_row_view_t_ rowmap,
+      lno_nnz_view_t_ entries,
+      scalar_nnz_view_t_ values,
+      BType b,
+      XType x)
+  {
+    typedef typename KernelHandle::size_type size_type;
+    typedef typename KernelHandle::nnz_lno_t ordinal_type;
+    typedef typename KernelHandle::nnz_scalar_t scalar_type;
+
+    static_assert(KOKKOSKERNELS_SPTRSV_SAME_TYPE(typename lno_row_view_t_::non_const_value_type, size_type),
+        "sptrsv_solve: A size_type must match KernelHandle size_type (const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPTRSV_SAME_TYPE(typename lno_nnz_view_t_::non_const_value_type, ordinal_type),
+        "sptrsv_solve: A entry type must match KernelHandle entry type (aka nnz_lno_t, and const doesn't matter)");
+    static_assert(KOKKOSKERNELS_SPTRSV_SAME_TYPE(typename scalar_nnz_view_t_::value_type, scalar_type),
+        "sptrsv_solve: A scalar type must match KernelHandle entry type (aka nnz_scalar_t, and const doesn't matter)");
+
+    static_assert(Kokkos::Impl::is_view<BType>::value,
+        "sptrsv_solve: b is not a Kokkos::View.");
+    static_assert(Kokkos::Impl::is_view<XType>::value,
+        "sptrsv_solve: x is not a Kokkos::View.");
+    static_assert((int) BType::rank == (int) XType::rank,
+        "sptrsv_solve: The ranks of b and x do not match.");
+    static_assert(BType::rank == 1 || BType::rank == 2,
+        "sptrsv_solve: b and x must both either have rank 1 or rank 2.");
+    static_assert(std::is_same<typename XType::value_type,
+        typename XType::non_const_value_type>::value,
+        "sptrsv_solve: The output x must be nonconst.");
+
+    typedef typename KernelHandle::SPTRSVHandleType sptrsvHandleType;
+    sptrsvHandleType *sh = handle->get_sptrsv_handle();
+    if (sh == NULL){
+      throw std::runtime_error("sptrsv_solve: the sptrsv handle has not been created, call create_sptrsv_handle first");
+    }
+    if (static_cast<size_t>(sh->get_nrows()) != b.extent(0) ||
+        static_cast<size_t>(sh->get_nrows()) != x.extent(0)){
+      throw std::runtime_error("sptrsv_solve: the lengths of b and x must match the number of rows of A");
+    }
+    if (b.extent(1) != x.extent(1)){
+      throw std::runtime_error("sptrsv_solve: b and x must have the same number of columns");
+    }
+
+    if (!sh->is_symbolic_complete()){
+      Impl::tri_solve_symbolic(*sh, rowmap, entries);
+    }
+
+    Impl::SptrsvSolve<KernelHandle, lno_row_view_t_, lno_nnz_view_t_, scalar_nnz_view_t_, BType, XType>::
+      sptrsv_solve(handle, rowmap, entries, values, b, x);
+  }
+
+#undef KOKKOSKERNELS_SPTRSV_SAME_TYPE
+
+} // namespace Experimental
+} // namespace KokkosSparse
+
+#endif // KOKKOSSPARSE_SPTRSV_HPP_
@@ -0,0 +1,383 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_MemoryTraits.hpp>
+#include <Kokkos_Core.hpp>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "KokkosKernels_Utils.hpp"
+
+#ifndef _SPTRSVHANDLE_HPP
+#define _SPTRSVHANDLE_HPP
+
+namespace KokkosSparse{
+
+enum SPTRSVAlgorithm{SPTRSV_DEFAULT, SPTRSV_SEQUENTIAL, SPTRSV_LVLSCHD_RP, SPTRSV_LVLSCHD_TP1, SPTRSV_LVLSCHD_CHAIN, SPTRSV_SUPERNODAL, SPTRSV_TASK};
+
+inline SPTRSVAlgorithm StringToSPTRSVAlgorithm(const std::string &name) {
+  if(name=="SPTRSV_DEFAULT")              return SPTRSV_DEFAULT;
+  else if(name=="SPTRSV_SEQUENTIAL")      return SPTRSV_SEQUENTIAL;
+  else if(name=="SPTRSV_LVLSCHD_RP")      return SPTRSV_LVLSCHD_RP;
+  else if(name=="SPTRSV_LVLSCHD_TP1")     return SPTRSV_LVLSCHD_TP1;
+  else if(name=="SPTRSV_LVLSCHD_CHAIN")   return SPTRSV_LVLSCHD_CHAIN;
+  else if(name=="SPTRSV_SUPERNODAL")      return SPTRSV_SUPERNODAL;
+  else if(name=="SPTRSV_TASK")            return SPTRSV_TASK;
+  else
+    throw std::runtime_error("Invalid SPTRSVAlgorithm name");
+}
+
+template <class size_type_, class lno_t_, class scalar_t_,
+          class ExecutionSpace,
+          class TemporaryMemorySpace,
+          class PersistentMemorySpace>
+class SPTRSVHandle{
+public:
+  typedef ExecutionSpace HandleExecSpace;
+  typedef TemporaryMemorySpace HandleTempMemorySpace;
+  typedef PersistentMemorySpace HandlePersistentMemorySpace;
+
+  typedef typename std::remove_const<size_type_>::type  size_type;
+  typedef const size_type const_size_type;
+
+  typedef typename std::remove_const<lno_t_>::type  nnz_lno_t;
+  typedef const nnz_lno_t const_nnz_lno_t;
+
+  typedef typename std::remove_const<scalar_t_>::type  nnz_scalar_t;
+  typedef const nnz_scalar_t const_nnz_scalar_t;
+
+  typedef typename Kokkos::View<size_type *, HandlePersistentMemorySpace> nnz_row_view_t;
+  typedef typename nnz_row_view_t::HostMirror nnz_row_view_host_t;
+
+  typedef typename Kokkos::View<nnz_lno_t *, HandlePersistentMemorySpace> nnz_lno_view_t;
+  typedef typename nnz_lno_view_t::HostMirror nnz_lno_view_host_t;
+
+  typedef typename Kokkos::View<nnz_scalar_t *, HandlePersistentMemorySpace> nnz_scalar_view_t;
+
+private:
+  SPTRSVAlgorithm algorithm_type;
+
+  //level of each row, rows grouped (and sorted) by level and the
+  //level pointers into nodes_grouped_by_level. nodes_grouped_by_level
+  //is the level order permutation of the rows. level_ptr is kept on the
+  //host, as the solve loops over the levels on the host, and on the
+  //device for the chain kernels that loop over levels inside a kernel.
+  nnz_lno_view_t level_list;
+  nnz_lno_view_t nodes_grouped_by_level;
+  nnz_lno_view_host_t level_ptr;
+  nnz_lno_view_t dlevel_ptr;
+
+  //chains of consecutive small levels that are solved by a single
+  //kernel launch. chain_ptr holds the first level of each chain.
+  nnz_lno_view_host_t chain_ptr;
+  nnz_lno_t nchains;
+  nnz_lno_t chain_threshold;
+
+  //offset of the diagonal entry of each row, so that the numeric
+  //phase does not need to search for it.
+  nnz_row_view_t diagonal_offsets;
+
+  nnz_lno_t nrows;
+  nnz_lno_t nlevels;
+  nnz_lno_t max_level_size;
+
+  bool lower_tri;
+  bool symbolic_complete;
+
+  int suggested_vector_size;
+  int suggested_team_size;
+
+  //supernodal solve. Supernode k holds the rows [supernode_ptr(k),
+  //supernode_ptr(k+1)). Its rows are stored as a dense row major block
+  //of (width x (ncols + width)), where ncols are the off-diagonal block
+  //columns supernode_cols[supernode_cols_ptr(k), supernode_cols_ptr(k+1)).
+  //nnz_block_offsets maps each entry of the matrix to its position in
+  //supernode_block_values. The levels are computed over the supernodes.
+  nnz_lno_view_host_t user_supernode_ptr;
+  nnz_lno_t nsupernodes;
+  nnz_lno_view_t supernode_ptr;
+  nnz_row_view_t supernode_cols_ptr;
+  nnz_lno_view_t supernode_cols;
+  nnz_row_view_t supernode_block_ptr;
+  nnz_row_view_t nnz_block_offsets;
+  nnz_scalar_view_t supernode_block_values;
+  nnz_scalar_view_t supernode_work;
+  nnz_lno_view_t supernodes_grouped_by_level;
+  nnz_lno_view_host_t supernode_level_ptr;
+  nnz_lno_t nsupernode_levels;
+
+  //block DAG of the task based solve. The rows are split into blocks of
+  //task_block_size consecutive rows, block b waits for the blocks
+  //task_deps[task_dep_ptr(b), task_dep_ptr(b+1)) that hold its columns.
+  nnz_lno_t task_block_size;
+  nnz_lno_t ntask_blocks;
+  nnz_row_view_host_t task_dep_ptr;
+  nnz_lno_view_host_t task_deps;
+
+public:
+
+  /**
+   * \brief Default constructor.
+   * \param nrows_: number of rows of the triangular matrix.
+   * \param lower_tri_: true if the matrix is lower triangular, false if upper.
+   */
+  SPTRSVHandle(SPTRSVAlgorithm choice, nnz_lno_t nrows_, bool lower_tri_ = true):
+    algorithm_type(choice),
+    level_list(), nodes_grouped_by_level(), level_ptr(), dlevel_ptr(),
+    chain_ptr(), nchains(0), chain_threshold(32),
+    diagonal_offsets(),
+    nrows(nrows_), nlevels(0), max_level_size(0),
+    lower_tri(lower_tri_), symbolic_complete(false),
+    suggested_vector_size(0), suggested_team_size(0),
+    user_supernode_ptr(), nsupernodes(0), supernode_ptr(),
+    supernode_cols_ptr(), supernode_cols(), supernode_block_ptr(),
+    nnz_block_offsets(), supernode_block_values(), supernode_work(),
+    supernodes_grouped_by_level(), supernode_level_ptr(), nsupernode_levels(0),
+    task_block_size(32), ntask_blocks(0), task_dep_ptr(), task_deps()
+  {
+    if (choice == SPTRSV_DEFAULT){
+      this->choose_default_algorithm();
+    }
+  }
+
+  /** \brief Chooses best algorithm based on the execution space. Level
+   * scheduled solves with teams on GPUs, and with range policies on CPUs.
+   */
+  void choose_default_algorithm(){
+    this->algorithm_type = SPTRSV_LVLSCHD_RP;
+#if defined( KOKKOS_ENABLE_CUDA )
+    if (Kokkos::Impl::is_same<Kokkos::Cuda, ExecutionSpace >::value){
+      this->algorithm_type = SPTRSV_LVLSCHD_TP1;
+#ifdef VERBOSE
+      std::cout << "Cuda Execution Space, Default Algorithm: SPTRSV_LVLSCHD_TP1" << std::endl;
+#endif
+    }
+#endif
+  }
+
+  SPTRSVAlgorithm get_algorithm_type() const { return this->algorithm_type; }
+  void set_algorithm_type(SPTRSVAlgorithm algo){
+    this->algorithm_type = algo;
+    if (algo == SPTRSV_DEFAULT){
+      this->choose_default_algorithm();
+    }
+    this->symbolic_complete = false;
+  }
+
+  virtual ~SPTRSVHandle(){};
+
+  /**
+   * \brief Allocates the persistent level set arrays for nrows_ rows.
+   * Called by the symbolic phase.
+   */
+  void new_init_handle(nnz_lno_t nrows_){
+    this->nrows = nrows_;
+    this->nlevels = 0;
+    this->max_level_size = 0;
+    this->nchains = 0;
+    this->nsupernodes = 0;
+    this->nsupernode_levels = 0;
+    this->ntask_blocks = 0;
+    this->level_list = nnz_lno_view_t("level_list", nrows_);
+    this->nodes_grouped_by_level = nnz_lno_view_t("nodes_grouped_by_level", nrows_);
+    this->diagonal_offsets = nnz_row_view_t("diagonal_offsets", nrows_);
+    this->symbolic_complete = false;
+  }
+
+  //getters
+  nnz_lno_view_t get_level_list() const { return this->level_list; }
+  nnz_lno_view_t get_nodes_grouped_by_level() const { return this->nodes_grouped_by_level; }
+  nnz_lno_view_host_t get_level_ptr() const { return this->level_ptr; }
+  nnz_lno_view_t get_level_ptr_device() const { return this->dlevel_ptr; }
+  nnz_lno_view_host_t get_chain_ptr() const { return this->chain_ptr; }
+  nnz_row_view_t get_diagonal_offsets() const { return this->diagonal_offsets; }
+
+  nnz_lno_t get_nrows() const { return this->nrows; }
+  nnz_lno_t get_num_levels() const { return this->nlevels; }
+  nnz_lno_t get_max_level_size() const { return this->max_level_size; }
+  nnz_lno_t get_num_chains() const { return this->nchains; }
+  nnz_lno_t get_chain_threshold() const { return this->chain_threshold; }
+
+  bool is_lower_tri() const { return this->lower_tri; }
+  bool is_upper_tri() const { return !this->lower_tri; }
+  bool is_symbolic_complete() const { return this->symbolic_complete; }
+
+  nnz_lno_view_host_t get_user_supernode_ptr() const { return this->user_supernode_ptr; }
+  nnz_lno_t get_num_supernodes() const { return this->nsupernodes; }
+  nnz_lno_view_t get_supernode_ptr() const { return this->supernode_ptr; }
+  nnz_row_view_t get_supernode_cols_ptr() const { return this->supernode_cols_ptr; }
+  nnz_lno_view_t get_supernode_cols() const { return this->supernode_cols; }
+  nnz_row_view_t get_supernode_block_ptr() const { return this->supernode_block_ptr; }
+  nnz_row_view_t get_nnz_block_offsets() const { return this->nnz_block_offsets; }
+  nnz_scalar_view_t get_supernode_block_values() const { return this->supernode_block_values; }
+  nnz_scalar_view_t get_supernode_work() const { return this->supernode_work; }
+  nnz_lno_view_t get_supernodes_grouped_by_level() const { return this->supernodes_grouped_by_level; }
+  nnz_lno_view_host_t get_supernode_level_ptr() const { return this->supernode_level_ptr; }
+  nnz_lno_t get_num_supernode_levels() const { return this->nsupernode_levels; }
+
+  nnz_lno_t get_task_block_size() const { return this->task_block_size; }
+  nnz_lno_t get_num_task_blocks() const { return this->ntask_blocks; }
+  nnz_row_view_host_t get_task_dep_ptr() const { return this->task_dep_ptr; }
+  nnz_lno_view_host_t get_task_deps() const { return this->task_deps; }
+
+  //setters
+  /**
+   * \brief Sets the supernode partition used by SPTRSV_SUPERNODAL, e.g. the
+   * one computed by the sparse direct solver that produced the factor.
+   * supernode_ptr_ has nsupernodes + 1 entries, (0, ..., nrows).
+   * If not set, the supernodes are detected in the symbolic phase.
+   */
+  void set_supernodes(const nnz_lno_view_host_t &supernode_ptr_){
+    this->user_supernode_ptr = supernode_ptr_;
+    this->symbolic_complete = false;
+  }
+
+  void set_supernode_structure(
+      nnz_lno_t nsupernodes_,
+      const nnz_lno_view_t &supernode_ptr_,
+      const nnz_row_view_t &supernode_cols_ptr_,
+      const nnz_lno_view_t &supernode_cols_,
+      const nnz_row_view_t &supernode_block_ptr_,
+      const nnz_row_view_t &nnz_block_offsets_,
+      const nnz_scalar_view_t &supernode_block_values_,
+      const nnz_scalar_view_t &supernode_work_){
+    this->nsupernodes = nsupernodes_;
+    this->supernode_ptr = supernode_ptr_;
+    this->supernode_cols_ptr = supernode_cols_ptr_;
+    this->supernode_cols = supernode_cols_;
+    this->supernode_block_ptr = supernode_block_ptr_;
+    this->nnz_block_offsets = nnz_block_offsets_;
+    this->supernode_block_values = supernode_block_values_;
+    this->supernode_work = supernode_work_;
+  }
+
+  void set_supernode_levels(
+      nnz_lno_t nsupernode_levels_,
+      const nnz_lno_view_t &supernodes_grouped_by_level_,
+      const nnz_lno_view_host_t &supernode_level_ptr_){
+    this->nsupernode_levels = nsupernode_levels_;
+    this->supernodes_grouped_by_level = supernodes_grouped_by_level_;
+    this->supernode_level_ptr = supernode_level_ptr_;
+  }
+
+  /**
+   * \brief Sets the number of consecutive rows solved by one task of
+   * SPTRSV_TASK. Smaller blocks expose more parallelism, larger blocks
+   * have less tasking overhead.
+   */
+  void set_task_block_size(nnz_lno_t task_block_size_){
+    if (task_block_size_ < 1){
+      throw std::runtime_error("set_task_block_size: the block size must be positive");
+    }
+    this->task_block_size = task_block_size_;
+    this->symbolic_complete = false;
+  }
+
+  void set_task_dag(
+      nnz_lno_t ntask_blocks_,
+      const nnz_row_view_host_t &task_dep_ptr_,
+      const nnz_lno_view_host_t &task_deps_){
+    this->ntask_blocks = ntask_blocks_;
+    this->task_dep_ptr = task_dep_ptr_;
+    this->task_deps = task_deps_;
+  }
+
+  void set_level_ptr(const nnz_lno_view_host_t &level_ptr_){ this->level_ptr = level_ptr_; }
+  void set_level_ptr_device(const nnz_lno_view_t &dlevel_ptr_){ this->dlevel_ptr = dlevel_ptr_; }
+  void set_chain_ptr(const nnz_lno_view_host_t &chain_ptr_){ this->chain_ptr = chain_ptr_; }
+  void set_num_chains(nnz_lno_t nchains_){ this->nchains = nchains_; }
+  //levels with at most chain_threshold rows are merged into chains.
+  void set_chain_threshold(nnz_lno_t chain_threshold_){
+    this->chain_threshold = chain_threshold_;
+    this->symbolic_complete = false;
+  }
+  void set_num_levels(nnz_lno_t nlevels_){ this->nlevels = nlevels_; }
+  void set_max_level_size(nnz_lno_t max_level_size_){ this->max_level_size = max_level_size_; }
+
+  void set_lower_tri(bool lower_tri_){ this->lower_tri = lower_tri_; this->symbolic_complete = false; }
+  void set_symbolic_complete(bool complete = true){ this->symbolic_complete = complete; }
+  void reset_symbolic(){ this->symbolic_complete = false; }
+
+  /**
+   * \brief Returns the vector and team size used by the team based level
+   * solves, either set by the user, or calculated from the average row size.
+   */
+  void vector_team_size(
+      int max_allowed_team_size,
+      int &suggested_vector_size_,
+      int &suggested_team_size_,
+      size_type nr, size_type nnz){
+    if (this->suggested_team_size && this->suggested_vector_size) {
+      suggested_vector_size_ = this->suggested_vector_size;
+      suggested_team_size_ = this->suggested_team_size;
+      return;
+    }
+    else {
+      KokkosKernels::Impl::get_suggested_vector_team_size<size_type, ExecutionSpace>(
+          max_allowed_team_size, suggested_vector_size_, suggested_team_size_, nr, nnz);
+    }
+  }
+
+  void set_suggested_vector_size(int vector_size_){ this->suggested_vector_size = vector_size_; }
+  void set_suggested_team_size(int team_size_){ this->suggested_team_size = team_size_; }
+
+  void print_algorithm(){
+    switch (this->algorithm_type){
+    case SPTRSV_SEQUENTIAL: std::cout << "SPTRSV_SEQUENTIAL, "; break;
+    case SPTRSV_LVLSCHD_RP: std::cout << "SPTRSV_LVLSCHD_RP, "; break;
+    case SPTRSV_LVLSCHD_TP1: std::cout << "SPTRSV_LVLSCHD_TP1, "; break;
+    case SPTRSV_LVLSCHD_CHAIN: std::cout << "SPTRSV_LVLSCHD_CHAIN (" << this->nchains << " chains), "; break;
+    case SPTRSV_SUPERNODAL: std::cout << "SPTRSV_SUPERNODAL (" << this->nsupernodes << " supernodes, " << this->nsupernode_levels << " supernode levels), "; break;
+    case SPTRSV_TASK: std::cout << "SPTRSV_TASK (" << this->ntask_blocks << " blocks of " << this->task_block_size << " rows, " << this->task_deps.extent(0) << " dependencies), "; break;
+    default: break;
+    }
+    std::cout << "Level scheduled sptrsv, "
+              << (this->lower_tri ? "lower" : "upper") << " triangular, "
+              << this->nlevels << " levels, max level size " << this->max_level_size
+              << std::endl;
+  }
+};
+
+}
+
+#endif
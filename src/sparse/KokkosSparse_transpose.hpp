@@ -0,0 +1,165 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file KokkosSparse_transpose.hpp
+/// \brief Transpose of a CrsMatrix, values included.
+
+#ifndef KOKKOSSPARSE_TRANSPOSE_HPP_
+#define KOKKOSSPARSE_TRANSPOSE_HPP_
+
+#include "Kokkos_Core.hpp"
+#include <sstream>
+#include <type_traits>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_transpose_handle.hpp"
+#include "KokkosSparse_transpose_impl.hpp"
+
+namespace KokkosSparse {
+
+//! The type of the transpose of AMatrix.
+template<class AMatrix>
+struct TransposeMatrixType {
+  typedef CrsMatrix<typename AMatrix::non_const_value_type,
+                    typename AMatrix::non_const_ordinal_type,
+                    typename AMatrix::device_type, void,
+                    typename AMatrix::non_const_size_type> type;
+};
+
+/// \brief Returns the transpose of A, values included.
+///
+/// The entries of each row are counted and filled by teams with atomics,
+/// as in KokkosKernels::Impl::kk_transpose_matrix, so their order within
+/// a row of the transpose depends on the scheduling of the threads.
+///
+/// \param A [in] The sparse matrix.
+/// \param sort_rows [in] If true, the entries of each row of the
+///   transpose are sorted, which makes the result deterministic.
+template<class AMatrix>
+typename TransposeMatrixType<AMatrix>::type
+transpose (const AMatrix& A, const bool sort_rows = false)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename TransposeMatrixType<AMatrix>::type matrix_type;
+  typedef typename matrix_type::row_map_type::non_const_type row_map_type;
+  typedef typename matrix_type::index_type::non_const_type index_type;
+  typedef typename matrix_type::values_type::non_const_type values_type;
+
+  const typename AMatrix::non_const_size_type nnz = A.nnz ();
+  row_map_type t_row_map ("transpose row_map", A.numCols () + 1);
+  index_type t_entries (Kokkos::ViewAllocateWithoutInitializing ("transpose entries"), nnz);
+  values_type t_values (Kokkos::ViewAllocateWithoutInitializing ("transpose values"), nnz);
+  if (A.numRows () > 0) {
+    KokkosKernels::Impl::kk_transpose_matrix
+      <typename AMatrix::row_map_type, typename AMatrix::index_type, typename AMatrix::values_type,
+       row_map_type, index_type, values_type, row_map_type, execution_space>
+      (A.numRows (), A.numCols (), A.graph.row_map, A.graph.entries, A.values,
+       t_row_map, t_entries, t_values);
+    if (sort_rows) {
+      KokkosKernels::Impl::kk_sort_crs_rows<row_map_type, index_type, values_type, execution_space>
+        (t_row_map, t_entries, t_values);
+    }
+  }
+  return matrix_type ("transpose", A.numCols (), A.numRows (), nnz, t_values, t_row_map, t_entries);
+}
+
+/// \brief Returns the transpose of A, reusing the pattern kept in handle.
+///
+/// The first call with a matrix computes the pattern of the transpose
+/// and a permutation of the entries of A; the following calls only
+/// gather the values of A. The sort_rows option of the handle decides
+/// whether the rows of the transpose are sorted. The graph of the
+/// returned matrix is shared with the handle.
+///
+/// \param handle [in/out] The handle; its ordinal and size types must be
+///   those of A.
+/// \param A [in] The sparse matrix.
+template<class HandleType, class AMatrix>
+typename TransposeMatrixType<AMatrix>::type
+transpose (HandleType& handle, const AMatrix& A)
+{
+  typedef typename TransposeMatrixType<AMatrix>::type matrix_type;
+  typedef typename matrix_type::values_type::non_const_type values_type;
+  static_assert (std::is_same<typename AMatrix::non_const_size_type, typename HandleType::size_type>::value &&
+                 std::is_same<typename AMatrix::non_const_ordinal_type, typename HandleType::nnz_lno_t>::value,
+                 "KokkosSparse::transpose: The handle and the matrix must have the same ordinal and size types.");
+
+  if (!handle.is_plan_for (A.graph.row_map.data (), A.numRows (), A.numCols (), A.nnz ())) {
+    Impl::transpose_symbolic (handle, A);
+  }
+  const typename AMatrix::non_const_size_type nnz = A.nnz ();
+  values_type t_values (Kokkos::ViewAllocateWithoutInitializing ("transpose values"), nnz);
+  Impl::transpose_numeric (handle, A, t_values);
+  handle.set_values_current (A.values.data (), A.valuesVersion (), t_values.data ());
+  return matrix_type ("transpose", A.numCols (), A.numRows (), nnz, t_values,
+                      handle.get_transpose_row_map (), handle.get_transpose_entries ());
+}
+
+/// \brief Copies the values of A into AT, a transpose of A returned by
+///   transpose(handle, A), after the values of A changed.
+///
+/// The handle records the values version of A (see
+/// CrsMatrix::valuesVersion()), by which the callers that keep AT can
+/// skip the copy with handle.are_values_current().
+///
+/// \param handle [in/out] The handle AT was computed with.
+/// \param A [in] The sparse matrix, with the same pattern as before.
+/// \param AT [in/out] The transpose of A; its values are overwritten.
+template<class HandleType, class AMatrix, class ATMatrix>
+void
+transpose_values (HandleType& handle, const AMatrix& A, const ATMatrix& AT)
+{
+  if (!handle.is_plan_for (A.graph.row_map.data (), A.numRows (), A.numCols (), A.nnz ()) ||
+      AT.graph.entries.data () != handle.get_transpose_entries ().data ()) {
+    std::ostringstream os;
+    os << "KokkosSparse::transpose_values: The handle was not used to transpose this matrix, "
+       << "A: " << A.numRows () << " x " << A.numCols ()
+       << ", AT: " << AT.numRows () << " x " << AT.numCols ();
+    Kokkos::Impl::throw_runtime_exception (os.str ());
+  }
+  Impl::transpose_numeric (handle, A, AT.values);
+  handle.set_values_current (A.values.data (), A.valuesVersion (), AT.values.data ());
+}
+
+}
+
+#endif
@@ -0,0 +1,180 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <Kokkos_Core.hpp>
+
+#ifndef _KOKKOSSPARSE_TRANSPOSE_HANDLE_HPP
+#define _KOKKOSSPARSE_TRANSPOSE_HANDLE_HPP
+
+namespace KokkosSparse{
+
+/**
+ * \brief Pattern of the transpose of a matrix, computed the first time the
+ * handle is used with the matrix and reused by the following transposes, which
+ * then only gather the values. This is meant for repeated transposes of a
+ * matrix whose values change but whose pattern does not, e.g. R = P^T in AMG.
+ * The pattern is recomputed if the handle is called with another matrix, or
+ * after reset_plan(), e.g. when the pattern of the matrix changes in place.
+ * The handle also keeps the values version (CrsMatrix::valuesVersion()) of
+ * the matrix at the last gather, so that the callers that keep the transpose
+ * can skip transpose_values when the values did not change.
+ */
+template <class lno_t_, class size_type_, class ExecutionSpace>
+class TransposeHandle{
+public:
+  typedef lno_t_ nnz_lno_t;
+  typedef size_type_ size_type;
+  typedef ExecutionSpace execution_space;
+
+  typedef Kokkos::View<nnz_lno_t *, execution_space> nnz_lno_view_t;
+  typedef Kokkos::View<size_type *, execution_space> size_type_view_t;
+
+private:
+  bool sort_rows;
+
+  bool is_inspected;
+  //the matrix of the plan.
+  const void *plan_row_map;
+  nnz_lno_t plan_num_rows;
+  nnz_lno_t plan_num_cols;
+  size_type plan_nnz;
+
+  size_type_view_t transpose_row_map;
+  nnz_lno_view_t transpose_entries;
+  //entry of the matrix for each entry of the transpose.
+  size_type_view_t transpose_permutation;
+
+public:
+  /**
+   * \brief constructor.
+   * \param sort_rows_: if true, the entries of each row of the transpose are
+   * sorted; otherwise their order depends on the scheduling of the threads.
+   */
+  TransposeHandle(bool sort_rows_ = false):
+    sort_rows(sort_rows_),
+    is_inspected(false), plan_row_map(NULL), plan_num_rows(0), plan_num_cols(0), plan_nnz(0),
+    transpose_row_map(), transpose_entries(), transpose_permutation(),
+    gathered_values(NULL), gathered_transpose_values(NULL), gathered_values_version(0){}
+
+  bool get_sort_rows() const {return this->sort_rows;}
+
+  /**
+   * \brief sets whether the rows of the transpose are sorted, and invalidates
+   * the plan.
+   */
+  void set_sort_rows(bool sort_rows_){
+    this->sort_rows = sort_rows_;
+    this->reset_plan();
+  }
+
+  /**
+   * \brief invalidates the plan, so that the next transpose computes the
+   * pattern again.
+   */
+  void reset_plan(){
+    this->is_inspected = false;
+    this->plan_row_map = NULL;
+    this->transpose_row_map = size_type_view_t();
+    this->transpose_entries = nnz_lno_view_t();
+    this->transpose_permutation = size_type_view_t();
+    this->reset_values();
+  }
+
+  /**
+   * \brief forgets the last gather, so that the next transpose_values gathers
+   * the values again.
+   */
+  void reset_values(){
+    this->gathered_values = NULL;
+    this->gathered_transpose_values = NULL;
+    this->gathered_values_version = 0;
+  }
+
+  /**
+   * \brief returns true if the values transpose_values_ were gathered from the
+   * values values_ at version values_version_.
+   */
+  bool are_values_current(const void *values_, size_t values_version_, const void *transpose_values_) const {
+    return this->gathered_values != NULL && this->gathered_values == values_ &&
+        this->gathered_transpose_values == transpose_values_ &&
+        this->gathered_values_version == values_version_;
+  }
+
+  void set_values_current(const void *values_, size_t values_version_, const void *transpose_values_){
+    this->gathered_values = values_;
+    this->gathered_transpose_values = transpose_values_;
+    this->gathered_values_version = values_version_;
+  }
+
+  /**
+   * \brief returns true if the plan was computed for a matrix with this row map
+   * and sizes.
+   */
+  bool is_plan_for(const void *row_map_, nnz_lno_t num_rows_, nnz_lno_t num_cols_, size_type nnz_) const {
+    return this->is_inspected && this->plan_row_map == row_map_ &&
+        this->plan_num_rows == num_rows_ && this->plan_num_cols == num_cols_ && this->plan_nnz == nnz_;
+  }
+
+  /**
+   * \brief stores the pattern of the transpose.
+   */
+  void set_plan(const void *row_map_, nnz_lno_t num_rows_, nnz_lno_t num_cols_, size_type nnz_,
+      size_type_view_t transpose_row_map_, nnz_lno_view_t transpose_entries_,
+      size_type_view_t transpose_permutation_){
+    this->plan_row_map = row_map_;
+    this->plan_num_rows = num_rows_;
+    this->plan_num_cols = num_cols_;
+    this->plan_nnz = nnz_;
+    this->transpose_row_map = transpose_row_map_;
+    this->transpose_entries = transpose_entries_;
+    this->transpose_permutation = transpose_permutation_;
+    this->is_inspected = true;
+  }
+
+  size_type_view_t get_transpose_row_map() const {return this->transpose_row_map;}
+  nnz_lno_view_t get_transpose_entries() const {return this->transpose_entries;}
+  size_type_view_t get_transpose_permutation() const {return this->transpose_permutation;}
+};
+
+}
+
+#endif
@@ -53,6 +53,7 @@
 
 #include <type_traits>
 
+#include "KokkosKernels_Profiling.hpp"
 #include "KokkosSparse_trsv_spec.hpp"
 
 namespace KokkosSparse {
@@ -82,6 +83,7 @@ trsv (const char uplo[],
       const BMV& b,
       const XMV& x)
 {
+  KOKKOSKERNELS_PROFILING_REGION("KokkosSparse::trsv");
   // FIXME (mfh 23 Apr 2015) Need to implement rank-1 version of this function.
   static_assert (BMV::rank == 2, "KokkosBlas::trsv: Rank-1 version of this "
                  "function has not yet been implemented.");
@@ -0,0 +1,358 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSSPARSE_ANALYZE_IMPL_HPP
+#define _KOKKOSSPARSE_ANALYZE_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+#include "KokkosKernels_ExecSpaceUtils.hpp"
+#include "KokkosSparse_analysis.hpp"
+
+namespace KokkosSparse{
+namespace Impl{
+
+//candidate sizes of the dense blocks of a CrsMatrix: 2, 3, 4, 5, 6 and 8.
+#define KOKKOSSPARSE_ANALYZE_BLOCK_CANDIDATES 6
+
+KOKKOS_INLINE_FUNCTION
+int analyze_block_candidate(const int b){
+  return b < KOKKOSSPARSE_ANALYZE_BLOCK_CANDIDATES - 1 ? b + 2 : 8;
+}
+
+/**
+ * \brief Statistics of the rows gathered by the single pass of
+ * Analyze_Functor.
+ */
+struct Analyze_Statistics{
+  size_t min_row_length;
+  size_t max_row_length;
+  double sum_row_length;
+  double sum_row_length_squares;
+  int64_t lower_bandwidth;
+  int64_t upper_bandwidth;
+  size_t num_unsorted_rows;
+  size_t num_rows_with_diagonal;
+  size_t num_diagonally_dominant_rows;
+  size_t num_strictly_diagonally_dominant_rows;
+  //bit b is set if the rows are made of aligned dense blocks of analyze_block_candidate(b).
+  unsigned block_mask;
+  KokkosKernels::Impl::kk_row_length_histogram row_length_histogram;
+};
+
+/**
+ * \brief One pass over the rows of a CrsMatrix, or over the block rows of a
+ * BlockCrsMatrix with block_dim > 1: row lengths and their histogram,
+ * bandwidth, sortedness, diagonal dominance of the point rows, and for
+ * block_dim == 1 whether the pattern is made of aligned dense blocks.
+ * A candidate block size is not checked again by a thread once one of its
+ * rows failed.
+ */
+template <class RowMapType, class EntriesType, class ValuesType>
+struct Analyze_Functor{
+  typedef Analyze_Statistics value_type;
+  typedef typename EntriesType::non_const_value_type lno_t;
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef typename ValuesType::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ats;
+  typedef typename ats::mag_type mag_t;
+
+  RowMapType row_map;
+  EntriesType entries;
+  ValuesType values;
+  lno_t block_dim;
+
+  Analyze_Functor(const RowMapType row_map_, const EntriesType entries_,
+                  const ValuesType values_, const lno_t block_dim_):
+    row_map(row_map_), entries(entries_), values(values_), block_dim(block_dim_){}
+
+  //whether the entries of row i are groups of bs consecutive columns, the
+  //first one a multiple of bs, and those of the first row of its block row.
+  KOKKOS_INLINE_FUNCTION
+  bool is_dense_block_row(const lno_t &i, const size_type begin, const size_type end, const lno_t bs) const {
+    const size_type length = end - begin;
+    if (length % bs != 0) return false;
+    for (size_type k = 0; k < length; ++k){
+      const lno_t first = entries(begin + k - k % bs);
+      if (first % bs != 0 || entries(begin + k) != first + lno_t(k % bs)) return false;
+    }
+    const lno_t f = i - i % bs;
+    if (f == i) return true;
+    const size_type f_begin = row_map(f);
+    if (row_map(f + 1) - f_begin != length) return false;
+    for (size_type k = 0; k < length; ++k){
+      if (entries(f_begin + k) != entries(begin + k)) return false;
+    }
+    return true;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t &i, value_type &s) const {
+    const size_type begin = row_map(i);
+    const size_type end = row_map(i + 1);
+    const size_t length = end - begin;
+    if (length < s.min_row_length) s.min_row_length = length;
+    if (length > s.max_row_length) s.max_row_length = length;
+    s.sum_row_length += double(length);
+    s.sum_row_length_squares += double(length) * double(length);
+    ++s.row_length_histogram.counts[KokkosKernels::Impl::kk_row_length_histogram::bin(length)];
+
+    bool sorted = true;
+    for (size_type j = begin; j < end; ++j){
+      const lno_t col = entries(j);
+      if (j > begin && col < entries(j - 1)) sorted = false;
+      const int64_t d = int64_t(i) - int64_t(col);
+      if (d > s.lower_bandwidth) s.lower_bandwidth = d;
+      if (-d > s.upper_bandwidth) s.upper_bandwidth = -d;
+    }
+    if (!sorted) ++s.num_unsorted_rows;
+
+    //point row p of the block row: the entry (p, q) of its k-th block is
+    //values((begin * bs + p * length) * bs + k * bs + q).
+    const lno_t bs = block_dim;
+    for (lno_t p = 0; p < bs; ++p){
+      const size_type row_offset = (begin * bs + p * length) * bs;
+      mag_t diagonal = 0, off_diagonal = 0;
+      bool has_diagonal = false;
+      for (size_type k = 0; k < length; ++k){
+        const bool is_diagonal_block = entries(begin + k) == i;
+        for (lno_t q = 0; q < bs; ++q){
+          const mag_t v = ats::abs(values(row_offset + k * bs + q));
+          if (is_diagonal_block && q == p){
+            diagonal += v;
+            has_diagonal = true;
+          }
+          else {
+            off_diagonal += v;
+          }
+        }
+      }
+      if (has_diagonal){
+        ++s.num_rows_with_diagonal;
+        if (diagonal >= off_diagonal) ++s.num_diagonally_dominant_rows;
+        if (diagonal > off_diagonal) ++s.num_strictly_diagonally_dominant_rows;
+      }
+    }
+
+    if (bs == 1){
+      for (int b = 0; b < KOKKOSSPARSE_ANALYZE_BLOCK_CANDIDATES; ++b){
+        const unsigned bit = 1u << b;
+        if ((s.block_mask & bit) && !is_dense_block_row(i, begin, end, analyze_block_candidate(b)))
+          s.block_mask &= ~bit;
+      }
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init(value_type &s) const {
+    s.min_row_length = ~size_t(0);
+    s.max_row_length = 0;
+    s.sum_row_length = 0;
+    s.sum_row_length_squares = 0;
+    s.lower_bandwidth = 0;
+    s.upper_bandwidth = 0;
+    s.num_unsorted_rows = 0;
+    s.num_rows_with_diagonal = 0;
+    s.num_diagonally_dominant_rows = 0;
+    s.num_strictly_diagonally_dominant_rows = 0;
+    s.block_mask = (1u << KOKKOSSPARSE_ANALYZE_BLOCK_CANDIDATES) - 1;
+    for (int b = 0; b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS; ++b) s.row_length_histogram.counts[b] = 0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join(volatile value_type &dst, const volatile value_type &src) const {
+    if (src.min_row_length < dst.min_row_length) dst.min_row_length = src.min_row_length;
+    if (src.max_row_length > dst.max_row_length) dst.max_row_length = src.max_row_length;
+    dst.sum_row_length += src.sum_row_length;
+    dst.sum_row_length_squares += src.sum_row_length_squares;
+    if (src.lower_bandwidth > dst.lower_bandwidth) dst.lower_bandwidth = src.lower_bandwidth;
+    if (src.upper_bandwidth > dst.upper_bandwidth) dst.upper_bandwidth = src.upper_bandwidth;
+    dst.num_unsorted_rows += src.num_unsorted_rows;
+    dst.num_rows_with_diagonal += src.num_rows_with_diagonal;
+    dst.num_diagonally_dominant_rows += src.num_diagonally_dominant_rows;
+    dst.num_strictly_diagonally_dominant_rows += src.num_strictly_diagonally_dominant_rows;
+    dst.block_mask &= src.block_mask;
+    for (int b = 0; b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS; ++b)
+      dst.row_length_histogram.counts[b] += src.row_length_histogram.counts[b];
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join(value_type &dst, const value_type &src) const {
+    if (src.min_row_length < dst.min_row_length) dst.min_row_length = src.min_row_length;
+    if (src.max_row_length > dst.max_row_length) dst.max_row_length = src.max_row_length;
+    dst.sum_row_length += src.sum_row_length;
+    dst.sum_row_length_squares += src.sum_row_length_squares;
+    if (src.lower_bandwidth > dst.lower_bandwidth) dst.lower_bandwidth = src.lower_bandwidth;
+    if (src.upper_bandwidth > dst.upper_bandwidth) dst.upper_bandwidth = src.upper_bandwidth;
+    dst.num_unsorted_rows += src.num_unsorted_rows;
+    dst.num_rows_with_diagonal += src.num_rows_with_diagonal;
+    dst.num_diagonally_dominant_rows += src.num_diagonally_dominant_rows;
+    dst.num_strictly_diagonally_dominant_rows += src.num_strictly_diagonally_dominant_rows;
+    dst.block_mask &= src.block_mask;
+    for (int b = 0; b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS; ++b)
+      dst.row_length_histogram.counts[b] += src.row_length_histogram.counts[b];
+  }
+};
+
+/**
+ * \brief Counts the entries (i, j) of a square pattern without an entry
+ * (j, i), with a binary search of row j if all rows are sorted.
+ */
+template <class RowMapType, class EntriesType>
+struct Analyze_Symmetry_Functor{
+  typedef size_t value_type;
+  typedef typename EntriesType::non_const_value_type lno_t;
+  typedef typename RowMapType::non_const_value_type size_type;
+
+  RowMapType row_map;
+  EntriesType entries;
+  lno_t num_rows;
+  bool is_sorted;
+
+  Analyze_Symmetry_Functor(const RowMapType row_map_, const EntriesType entries_,
+                           const lno_t num_rows_, const bool is_sorted_):
+    row_map(row_map_), entries(entries_), num_rows(num_rows_), is_sorted(is_sorted_){}
+
+  KOKKOS_INLINE_FUNCTION
+  bool has_entry(const lno_t &row, const lno_t &col) const {
+    size_type lo = row_map(row), hi = row_map(row + 1);
+    if (is_sorted){
+      while (lo < hi){
+        const size_type mid = lo + (hi - lo) / 2;
+        if (entries(mid) < col) lo = mid + 1;
+        else hi = mid;
+      }
+      return lo < row_map(row + 1) && entries(lo) == col;
+    }
+    for (; lo < hi; ++lo){
+      if (entries(lo) == col) return true;
+    }
+    return false;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t &i, value_type &num_asymmetric) const {
+    const size_type end = row_map(i + 1);
+    for (size_type j = row_map(i); j < end; ++j){
+      const lno_t col = entries(j);
+      if (col == i) continue;
+      if (col < 0 || col >= num_rows || !has_entry(col, i)) ++num_asymmetric;
+    }
+  }
+};
+
+/**
+ * \brief Computes the analysis of the num_rows (block) rows of row_map and
+ * entries, with num_cols (block) columns and the values in the layout of a
+ * CrsMatrix for block_dim == 1 or of a BlockCrsMatrix otherwise.
+ */
+template <class ExecutionSpace, class RowMapType, class EntriesType, class ValuesType>
+MatrixAnalysis analyze_matrix(const typename EntriesType::non_const_value_type num_rows,
+                              const typename EntriesType::non_const_value_type num_cols,
+                              const RowMapType &row_map, const EntriesType &entries,
+                              const ValuesType &values,
+                              const typename EntriesType::non_const_value_type block_dim,
+                              const bool is_block_matrix){
+  typedef typename EntriesType::non_const_value_type lno_t;
+  typedef Kokkos::RangePolicy<ExecutionSpace> range_policy_t;
+  typedef Analyze_Functor<RowMapType, EntriesType, ValuesType> functor_t;
+
+  MatrixAnalysis a;
+  a.row_map = row_map.data();
+  a.num_rows = num_rows;
+  a.num_cols = num_cols;
+  a.nnz = entries.extent(0);
+  a.is_block_matrix = is_block_matrix;
+  a.block_size = block_dim;
+  if (num_rows <= 0){
+    a.num_asymmetric_entries = num_rows == num_cols ? 0 : a.nnz;
+    a.is_analyzed = true;
+    return a;
+  }
+
+  const functor_t functor(row_map, entries, values, block_dim);
+  Analyze_Statistics s;
+  Kokkos::parallel_reduce("KokkosSparse::analyze", range_policy_t(0, num_rows), functor, s);
+
+  a.min_row_length = s.min_row_length;
+  a.max_row_length = s.max_row_length;
+  a.mean_row_length = s.sum_row_length / double(num_rows);
+  a.row_length_variance = s.sum_row_length_squares / double(num_rows) - a.mean_row_length * a.mean_row_length;
+  if (a.row_length_variance < 0) a.row_length_variance = 0;
+  a.row_length_histogram = s.row_length_histogram;
+  a.lower_bandwidth = s.lower_bandwidth;
+  a.upper_bandwidth = s.upper_bandwidth;
+  a.num_unsorted_rows = s.num_unsorted_rows;
+  a.num_rows_with_diagonal = s.num_rows_with_diagonal;
+  a.num_diagonally_dominant_rows = s.num_diagonally_dominant_rows;
+  a.num_strictly_diagonally_dominant_rows = s.num_strictly_diagonally_dominant_rows;
+
+  if (!is_block_matrix && a.nnz > 0){
+    for (int b = KOKKOSSPARSE_ANALYZE_BLOCK_CANDIDATES - 1; b >= 0; --b){
+      const lno_t bs = analyze_block_candidate(b);
+      if ((s.block_mask & (1u << b)) && num_rows % bs == 0 && num_cols % bs == 0){
+        a.block_size = bs;
+        break;
+      }
+    }
+  }
+
+  if (num_rows == num_cols){
+    size_t num_asymmetric = 0;
+    Kokkos::parallel_reduce("KokkosSparse::analyze::Symmetry", range_policy_t(0, num_rows),
+        Analyze_Symmetry_Functor<RowMapType, EntriesType>(row_map, entries, num_rows, a.are_rows_sorted()),
+        num_asymmetric);
+    a.num_asymmetric_entries = num_asymmetric;
+  }
+  else {
+    a.num_asymmetric_entries = a.nnz;
+  }
+  a.is_analyzed = true;
+  return a;
+}
+
+#undef KOKKOSSPARSE_ANALYZE_BLOCK_CANDIDATES
+
+}
+}
+
+#endif
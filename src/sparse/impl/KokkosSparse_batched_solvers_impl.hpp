@@ -0,0 +1,546 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef KOKKOSSPARSE_IMPL_BATCHED_SOLVERS_HPP_
+#define KOKKOSSPARSE_IMPL_BATCHED_SOLVERS_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosBlas1_team_dot.hpp"
+#include "KokkosBlas1_team_nrm2.hpp"
+#include "KokkosBlas1_team_axpby.hpp"
+#include "KokkosBlas1_team_update.hpp"
+#include "KokkosBlas1_team_scal.hpp"
+#include "KokkosSparse_BatchedCrsMatrix.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+namespace Impl {
+
+// Largest team scratch of a batched solver kept in level 0; larger work
+// spaces go to level 1 (global memory on Cuda).
+static constexpr size_t batched_solver_max_level0_scratch = 32768;
+
+// y = beta*y + alpha*Op(A)*x for one matrix of a batch, with the team
+// threads over the rows and the vector lanes over the entries of a row.
+// If beta == 0, the initial entries of y are ignored. No barrier at the end.
+template<bool conjugate, class TeamType, class RowMapType, class EntriesType, class ValuesType,
+         class XVector, class YVector>
+KOKKOS_INLINE_FUNCTION void
+team_batched_spmv (const TeamType& team, const int nrows,
+                   const typename YVector::non_const_value_type& alpha,
+                   const RowMapType& row_map, const EntriesType& entries, const ValuesType& values,
+                   const XVector& x,
+                   const typename YVector::non_const_value_type& beta,
+                   const YVector& y)
+{
+  typedef typename YVector::non_const_value_type value_type;
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef Kokkos::Details::ArithTraits<typename ValuesType::non_const_value_type> ATV;
+  typedef Kokkos::Details::ArithTraits<value_type> ATY;
+
+  Kokkos::parallel_for (Kokkos::TeamThreadRange (team, nrows), [&] (const int& i) {
+    const size_type begin = row_map(i);
+    const int length = static_cast<int> (row_map(i + 1) - begin);
+    value_type sum = ATY::zero ();
+    Kokkos::parallel_reduce (Kokkos::ThreadVectorRange (team, length), [&] (const int& k, value_type& lsum) {
+      const size_type jk = begin + k;
+      lsum += (conjugate ? ATV::conj (values(jk)) : values(jk)) * x(entries(jk));
+    }, sum);
+    Kokkos::single (Kokkos::PerThread (team), [&] () {
+      y(i) = beta == ATY::zero () ? alpha * sum : beta * y(i) + alpha * sum;
+    });
+  });
+}
+
+// y = x over the team, without a barrier.
+template<class TeamType, class XVector, class YVector>
+KOKKOS_INLINE_FUNCTION void
+team_batched_copy (const TeamType& team, const XVector& x, const YVector& y)
+{
+  const int n = y.extent(0);
+  Kokkos::parallel_for (Kokkos::TeamThreadRange (team, n), [&] (const int& i) {
+    y(i) = x(i);
+  });
+}
+
+// y = val over the team, without a barrier.
+template<class TeamType, class YVector>
+KOKKOS_INLINE_FUNCTION void
+team_batched_fill (const TeamType& team, const typename YVector::non_const_value_type& val, const YVector& y)
+{
+  const int n = y.extent(0);
+  Kokkos::parallel_for (Kokkos::TeamThreadRange (team, n), [&] (const int& i) {
+    y(i) = val;
+  });
+}
+
+// Y(b,:) = beta*Y(b,:) + alpha*Op(A_b)*X(b,:), one team per matrix.
+template<class AMatrix, class XMV, class YMV, bool conjugate>
+struct BatchedSpmvFunctor {
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename Kokkos::TeamPolicy<execution_space>::member_type team_member_t;
+  typedef typename YMV::non_const_value_type value_type;
+
+  const value_type alpha;
+  AMatrix A;
+  XMV X;
+  const value_type beta;
+  YMV Y;
+
+  BatchedSpmvFunctor (const value_type alpha_, const AMatrix& A_, const XMV& X_,
+                      const value_type beta_, const YMV& Y_) :
+    alpha (alpha_), A (A_), X (X_), beta (beta_), Y (Y_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const team_member_t& team) const
+  {
+    const int b = team.league_rank ();
+    team_batched_spmv<conjugate> (team, A.numRows (), alpha,
+                                  A.graph.row_map, A.graph.entries, Kokkos::subview (A.values, b, Kokkos::ALL ()),
+                                  Kokkos::subview (X, b, Kokkos::ALL ()), beta,
+                                  Kokkos::subview (Y, b, Kokkos::ALL ()));
+  }
+};
+
+template<class AMatrix, class XMV, class YMV, bool conjugate>
+void spmv_batched (const typename YMV::non_const_value_type& alpha, const AMatrix& A, const XMV& X,
+                   const typename YMV::non_const_value_type& beta, const YMV& Y)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  if (A.numMatrices () == 0) return;
+  Kokkos::parallel_for ("KokkosSparse::Experimental::spmv<BatchedCrsMatrix>",
+                        Kokkos::TeamPolicy<execution_space> (A.numMatrices (), Kokkos::AUTO),
+                        BatchedSpmvFunctor<AMatrix, XMV, YMV, conjugate> (alpha, A, X, beta, Y));
+}
+
+// Members and bookkeeping common to the batched solvers: matrix b of the
+// batch is solved by team b, from the initial guess X(b,:), until
+// ||B(b,:) - A_b X(b,:)|| <= tolerance*||B(b,:)|| or max_iters iterations.
+// The reduction counts the systems that did not converge.
+template<class AMatrix, class BMV, class XMV, class ItersView, class NormsView>
+struct BatchedSolverBase {
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename Kokkos::TeamPolicy<execution_space>::member_type team_member_t;
+  typedef typename XMV::non_const_value_type scalar_type;
+  //! The reduction: the number of systems that did not converge.
+  typedef int value_type;
+  typedef Kokkos::Details::ArithTraits<scalar_type> ATV;
+  typedef typename ATV::mag_type mag_type;
+  typedef Kokkos::Details::ArithTraits<mag_type> ATM;
+  typedef Kokkos::View<scalar_type**, Kokkos::LayoutRight, typename execution_space::scratch_memory_space,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged> > scratch_vectors_type;
+  typedef Kokkos::View<scalar_type*, typename execution_space::scratch_memory_space,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged> > scratch_vector_type;
+
+  AMatrix A;
+  BMV B;
+  XMV X;
+  ItersView num_iters;
+  NormsView residual_norms;
+  const mag_type tolerance;
+  const int max_iters;
+  int scratch_level;
+
+  BatchedSolverBase (const AMatrix& A_, const BMV& B_, const XMV& X_,
+                     const mag_type tolerance_, const int max_iters_,
+                     const ItersView& num_iters_, const NormsView& residual_norms_) :
+    A (A_), B (B_), X (X_), num_iters (num_iters_), residual_norms (residual_norms_),
+    tolerance (tolerance_), max_iters (max_iters_), scratch_level (0) {}
+
+  // Sets x = 0 if ||b|| == 0; returns ||b||, or 1 in that case, so that the
+  // tolerance is always relative to a nonzero norm.
+  template<class BVector, class XVector>
+  KOKKOS_INLINE_FUNCTION
+  mag_type rhs_norm (const team_member_t& team, const BVector& b, const XVector& x) const
+  {
+    const mag_type bnorm = KokkosBlas::Experimental::nrm2 (team, b);
+    if (bnorm == ATM::zero ()) {
+      team_batched_fill (team, ATV::zero (), x);
+      team.team_barrier ();
+      return ATM::one ();
+    }
+    return bnorm;
+  }
+
+  // r = b - A x, with a barrier at the end.
+  template<class BVector, class XVector, class RVector>
+  KOKKOS_INLINE_FUNCTION
+  void residual (const team_member_t& team, const int b, const BVector& rhs, const XVector& x, const RVector& r) const
+  {
+    team_batched_copy (team, rhs, r);
+    team.team_barrier ();
+    team_batched_spmv<false> (team, A.numRows (), -ATV::one (),
+                              A.graph.row_map, A.graph.entries, Kokkos::subview (A.values, b, Kokkos::ALL ()),
+                              x, ATV::one (), r);
+    team.team_barrier ();
+  }
+
+  // y = A x, with a barrier at the end.
+  template<class XVector, class YVector>
+  KOKKOS_INLINE_FUNCTION
+  void apply (const team_member_t& team, const int b, const XVector& x, const YVector& y) const
+  {
+    team_batched_spmv<false> (team, A.numRows (), ATV::one (),
+                              A.graph.row_map, A.graph.entries, Kokkos::subview (A.values, b, Kokkos::ALL ()),
+                              x, ATV::zero (), y);
+    team.team_barrier ();
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void finish (const team_member_t& team, const int b, const int iters, const mag_type relres, int& nfailed) const
+  {
+    const bool converged = relres <= tolerance;
+    Kokkos::single (Kokkos::PerTeam (team), [&] () {
+      if (num_iters.extent(0) > 0) num_iters(b) = iters;
+      if (residual_norms.extent(0) > 0) residual_norms(b) = relres;
+      if (!converged) ++nfailed;
+    });
+  }
+};
+
+// Conjugate gradient, for Hermitian positive definite matrices.
+template<class AMatrix, class BMV, class XMV, class ItersView, class NormsView>
+struct BatchedCGFunctor : public BatchedSolverBase<AMatrix, BMV, XMV, ItersView, NormsView> {
+  typedef BatchedSolverBase<AMatrix, BMV, XMV, ItersView, NormsView> base_type;
+  typedef typename base_type::team_member_t team_member_t;
+  typedef typename base_type::scalar_type scalar_type;
+  typedef typename base_type::mag_type mag_type;
+  typedef typename base_type::ATV ATV;
+  typedef typename base_type::ATM ATM;
+  typedef typename base_type::scratch_vectors_type scratch_vectors_type;
+
+  BatchedCGFunctor (const AMatrix& A_, const BMV& B_, const XMV& X_,
+                    const mag_type tolerance_, const int max_iters_,
+                    const ItersView& num_iters_, const NormsView& residual_norms_) :
+    base_type (A_, B_, X_, tolerance_, max_iters_, num_iters_, residual_norms_) {}
+
+  // r, p and A p.
+  static size_t team_scratch_size (const int n) {
+    return scratch_vectors_type::shmem_size (3, n);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const team_member_t& team, int& nfailed) const
+  {
+    const int b = team.league_rank ();
+    const int n = this->A.numRows ();
+    const auto rhs = Kokkos::subview (this->B, b, Kokkos::ALL ());
+    const auto x = Kokkos::subview (this->X, b, Kokkos::ALL ());
+    scratch_vectors_type work (team.team_scratch (this->scratch_level), 3, n);
+    const auto r = Kokkos::subview (work, 0, Kokkos::ALL ());
+    const auto p = Kokkos::subview (work, 1, Kokkos::ALL ());
+    const auto Ap = Kokkos::subview (work, 2, Kokkos::ALL ());
+
+    const mag_type bnorm = this->rhs_norm (team, rhs, x);
+    this->residual (team, b, rhs, x, r);
+    team_batched_copy (team, r, p);
+    scalar_type rr = KokkosBlas::Experimental::dot (team, r, r);
+    mag_type relres = ATM::sqrt (ATV::abs (rr)) / bnorm;
+    team.team_barrier ();
+
+    int iter = 0;
+    while (relres > this->tolerance && iter < this->max_iters) {
+      this->apply (team, b, p, Ap);
+      const scalar_type pAp = KokkosBlas::Experimental::dot (team, p, Ap);
+      if (pAp == ATV::zero ()) break;
+      const scalar_type alpha = rr / pAp;
+      KokkosBlas::Experimental::axpby (team, alpha, p, ATV::one (), x);
+      KokkosBlas::Experimental::axpby (team, -alpha, Ap, ATV::one (), r);
+      team.team_barrier ();
+      const scalar_type rr_new = KokkosBlas::Experimental::dot (team, r, r);
+      relres = ATM::sqrt (ATV::abs (rr_new)) / bnorm;
+      ++iter;
+      const scalar_type beta = rr_new / rr;
+      rr = rr_new;
+      KokkosBlas::Experimental::axpby (team, ATV::one (), r, beta, p);
+      team.team_barrier ();
+    }
+    this->finish (team, b, iter, relres, nfailed);
+  }
+};
+
+// BiCGStab, for general matrices. The vector s shares the storage of r.
+template<class AMatrix, class BMV, class XMV, class ItersView, class NormsView>
+struct BatchedBiCGStabFunctor : public BatchedSolverBase<AMatrix, BMV, XMV, ItersView, NormsView> {
+  typedef BatchedSolverBase<AMatrix, BMV, XMV, ItersView, NormsView> base_type;
+  typedef typename base_type::team_member_t team_member_t;
+  typedef typename base_type::scalar_type scalar_type;
+  typedef typename base_type::mag_type mag_type;
+  typedef typename base_type::ATV ATV;
+  typedef typename base_type::ATM ATM;
+  typedef typename base_type::scratch_vectors_type scratch_vectors_type;
+
+  BatchedBiCGStabFunctor (const AMatrix& A_, const BMV& B_, const XMV& X_,
+                          const mag_type tolerance_, const int max_iters_,
+                          const ItersView& num_iters_, const NormsView& residual_norms_) :
+    base_type (A_, B_, X_, tolerance_, max_iters_, num_iters_, residual_norms_) {}
+
+  // r (and s), the shadow residual, p, v = A p and t = A s.
+  static size_t team_scratch_size (const int n) {
+    return scratch_vectors_type::shmem_size (5, n);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const team_member_t& team, int& nfailed) const
+  {
+    using KokkosBlas::Experimental::axpby;
+    using KokkosBlas::Experimental::dot;
+    using KokkosBlas::Experimental::nrm2;
+
+    const int b = team.league_rank ();
+    const int n = this->A.numRows ();
+    const auto rhs = Kokkos::subview (this->B, b, Kokkos::ALL ());
+    const auto x = Kokkos::subview (this->X, b, Kokkos::ALL ());
+    scratch_vectors_type work (team.team_scratch (this->scratch_level), 5, n);
+    const auto r = Kokkos::subview (work, 0, Kokkos::ALL ());
+    const auto rhat = Kokkos::subview (work, 1, Kokkos::ALL ());
+    const auto p = Kokkos::subview (work, 2, Kokkos::ALL ());
+    const auto v = Kokkos::subview (work, 3, Kokkos::ALL ());
+    const auto t = Kokkos::subview (work, 4, Kokkos::ALL ());
+
+    const mag_type bnorm = this->rhs_norm (team, rhs, x);
+    this->residual (team, b, rhs, x, r);
+    team_batched_copy (team, r, rhat);
+    team_batched_fill (team, ATV::zero (), p);
+    team_batched_fill (team, ATV::zero (), v);
+    mag_type relres = nrm2 (team, r) / bnorm;
+    team.team_barrier ();
+
+    scalar_type rho = ATV::one (), alpha = ATV::one (), omega = ATV::one ();
+    int iter = 0;
+    while (relres > this->tolerance && iter < this->max_iters) {
+      const scalar_type rho_new = dot (team, rhat, r);
+      if (rho_new == ATV::zero ()) break;
+      const scalar_type beta = (rho_new / rho) * (alpha / omega);
+      // p = r + beta*(p - omega*v)
+      KokkosBlas::Experimental::update (team, ATV::one (), r, -beta * omega, v, beta, p);
+      team.team_barrier ();
+      this->apply (team, b, p, v);
+      const scalar_type rv = dot (team, rhat, v);
+      if (rv == ATV::zero ()) break;
+      alpha = rho_new / rv;
+      rho = rho_new;
+      // s = r - alpha*v
+      axpby (team, -alpha, v, ATV::one (), r);
+      team.team_barrier ();
+      ++iter;
+      relres = nrm2 (team, r) / bnorm;
+      if (relres <= this->tolerance) {
+        axpby (team, alpha, p, ATV::one (), x);
+        team.team_barrier ();
+        break;
+      }
+      this->apply (team, b, r, t);
+      const scalar_type tt = dot (team, t, t);
+      omega = tt == ATV::zero () ? ATV::zero () : dot (team, t, r) / tt;
+      // x = x + alpha*p + omega*s, then r = s - omega*t
+      KokkosBlas::Experimental::update (team, alpha, p, omega, r, ATV::one (), x);
+      team.team_barrier ();
+      axpby (team, -omega, t, ATV::one (), r);
+      team.team_barrier ();
+      relres = nrm2 (team, r) / bnorm;
+      if (omega == ATV::zero ()) break;
+    }
+    this->finish (team, b, iter, relres, nfailed);
+  }
+};
+
+// Restarted GMRES(m) with modified Gram-Schmidt and Givens rotations, for
+// general matrices. The residual is recomputed at every restart, so the
+// reported norm is the one of the final iterate.
+template<class AMatrix, class BMV, class XMV, class ItersView, class NormsView>
+struct BatchedGMRESFunctor : public BatchedSolverBase<AMatrix, BMV, XMV, ItersView, NormsView> {
+  typedef BatchedSolverBase<AMatrix, BMV, XMV, ItersView, NormsView> base_type;
+  typedef typename base_type::team_member_t team_member_t;
+  typedef typename base_type::scalar_type scalar_type;
+  typedef typename base_type::mag_type mag_type;
+  typedef typename base_type::ATV ATV;
+  typedef typename base_type::ATM ATM;
+  typedef typename base_type::scratch_vectors_type scratch_vectors_type;
+  typedef typename base_type::scratch_vector_type scratch_vector_type;
+
+  const int restart;
+
+  BatchedGMRESFunctor (const AMatrix& A_, const BMV& B_, const XMV& X_,
+                       const mag_type tolerance_, const int max_iters_, const int restart_,
+                       const ItersView& num_iters_, const NormsView& residual_norms_) :
+    base_type (A_, B_, X_, tolerance_, max_iters_, num_iters_, residual_norms_), restart (restart_) {}
+
+  // The Krylov basis V, the Hessenberg matrix H, the rotations (c, s), the
+  // rotated right hand side g and the solution y of the least squares problem.
+  static size_t team_scratch_size (const int n, const int m) {
+    return scratch_vectors_type::shmem_size (m + 1, n) + scratch_vectors_type::shmem_size (m + 1, m)
+      + 3 * scratch_vector_type::shmem_size (m) + scratch_vector_type::shmem_size (m + 1);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const team_member_t& team, int& nfailed) const
+  {
+    using KokkosBlas::Experimental::axpby;
+    using KokkosBlas::Experimental::dot;
+    using KokkosBlas::Experimental::nrm2;
+
+    const int b = team.league_rank ();
+    const int n = this->A.numRows ();
+    const int m = restart;
+    const auto rhs = Kokkos::subview (this->B, b, Kokkos::ALL ());
+    const auto x = Kokkos::subview (this->X, b, Kokkos::ALL ());
+    scratch_vectors_type V (team.team_scratch (this->scratch_level), m + 1, n);
+    scratch_vectors_type H (team.team_scratch (this->scratch_level), m + 1, m);
+    scratch_vector_type c (team.team_scratch (this->scratch_level), m);
+    scratch_vector_type s (team.team_scratch (this->scratch_level), m);
+    scratch_vector_type y (team.team_scratch (this->scratch_level), m);
+    scratch_vector_type g (team.team_scratch (this->scratch_level), m + 1);
+
+    const mag_type bnorm = this->rhs_norm (team, rhs, x);
+    mag_type relres = ATM::zero ();
+    int iter = 0;
+    while (true) {
+      const auto v0 = Kokkos::subview (V, 0, Kokkos::ALL ());
+      this->residual (team, b, rhs, x, v0);
+      const mag_type beta = nrm2 (team, v0);
+      relres = beta / bnorm;
+      if (relres <= this->tolerance || iter >= this->max_iters) break;
+      KokkosBlas::Experimental::scal (team, v0, scalar_type (ATM::one () / beta), v0);
+      Kokkos::single (Kokkos::PerTeam (team), [&] () {
+        g(0) = beta;
+      });
+      team.team_barrier ();
+
+      int k = 0;
+      while (k < m && iter < this->max_iters) {
+        const auto vk = Kokkos::subview (V, k, Kokkos::ALL ());
+        const auto w = Kokkos::subview (V, k + 1, Kokkos::ALL ());
+        this->apply (team, b, vk, w);
+        for (int i = 0; i <= k; ++i) {
+          const auto vi = Kokkos::subview (V, i, Kokkos::ALL ());
+          const scalar_type h = dot (team, vi, w);
+          axpby (team, -h, vi, ATV::one (), w);
+          team.team_barrier ();
+          Kokkos::single (Kokkos::PerTeam (team), [&] () {
+            H(i, k) = h;
+          });
+        }
+        const mag_type hnorm = nrm2 (team, w);
+        if (hnorm != ATM::zero ()) {
+          KokkosBlas::Experimental::scal (team, w, scalar_type (ATM::one () / hnorm), w);
+        }
+        // Applies the previous rotations to the new column of H, then the
+        // rotation that zeroes H(k+1,k), to the column and to g.
+        mag_type estimate = ATM::zero ();
+        Kokkos::single (Kokkos::PerTeam (team), [&] (mag_type& res) {
+          H(k + 1, k) = hnorm;
+          for (int i = 0; i < k; ++i) {
+            const scalar_type tmp = c(i) * H(i, k) + s(i) * H(i + 1, k);
+            H(i + 1, k) = -ATV::conj (s(i)) * H(i, k) + c(i) * H(i + 1, k);
+            H(i, k) = tmp;
+          }
+          const scalar_type hkk = H(k, k);
+          const mag_type habs = ATV::abs (hkk);
+          if (habs == ATM::zero ()) {
+            c(k) = ATV::zero ();
+            s(k) = ATV::one ();
+            H(k, k) = hnorm;
+          } else {
+            const mag_type nrm = ATM::sqrt (habs * habs + hnorm * hnorm);
+            const scalar_type phase = hkk / habs;
+            c(k) = habs / nrm;
+            s(k) = phase * hnorm / nrm;
+            H(k, k) = phase * nrm;
+          }
+          H(k + 1, k) = ATV::zero ();
+          g(k + 1) = -ATV::conj (s(k)) * g(k);
+          g(k) = c(k) * g(k);
+          res = ATV::abs (g(k + 1));
+        }, estimate);
+        team.team_barrier ();
+        ++k;
+        ++iter;
+        if (estimate <= this->tolerance * bnorm || hnorm == ATM::zero ()) break;
+      }
+
+      // x += V(0:k,:)^T y, with H(0:k,0:k) y = g(0:k).
+      Kokkos::single (Kokkos::PerTeam (team), [&] () {
+        for (int i = k - 1; i >= 0; --i) {
+          scalar_type sum = g(i);
+          for (int j = i + 1; j < k; ++j) {
+            sum -= H(i, j) * y(j);
+          }
+          y(i) = sum / H(i, i);
+        }
+      });
+      team.team_barrier ();
+      Kokkos::parallel_for (Kokkos::TeamThreadRange (team, n), [&] (const int& row) {
+        scalar_type sum = ATV::zero ();
+        for (int i = 0; i < k; ++i) {
+          sum += y(i) * V(i, row);
+        }
+        x(row) += sum;
+      });
+      team.team_barrier ();
+    }
+    this->finish (team, b, iter, relres, nfailed);
+  }
+};
+
+// Runs a batched solver functor with its scratch in level 0 if it fits,
+// in level 1 otherwise; returns the number of systems that did not converge.
+template<class SolverFunctor>
+int run_batched_solver (const char label[], SolverFunctor functor, const int num_matrices,
+                        const size_t team_scratch_size)
+{
+  typedef typename SolverFunctor::execution_space execution_space;
+  int nfailed = 0;
+  if (num_matrices == 0) return nfailed;
+  functor.scratch_level = team_scratch_size <= batched_solver_max_level0_scratch ? 0 : 1;
+  Kokkos::TeamPolicy<execution_space> policy (num_matrices, Kokkos::AUTO);
+  Kokkos::parallel_reduce (label,
+                           policy.set_scratch_size (functor.scratch_level, Kokkos::PerTeam (team_scratch_size)),
+                           functor, nfailed);
+  return nfailed;
+}
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,204 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+
+#ifndef KOKKOSSPARSE_IMPL_BLOCK_DAG_HPP_
+#define KOKKOSSPARSE_IMPL_BLOCK_DAG_HPP_
+
+/// \file KokkosSparse_block_dag_impl.hpp
+/// \brief Task DAG over blocks of consecutive rows, shared by the task
+///   based triangular solve and incomplete LU factorization.
+
+#include <KokkosKernels_config.h>
+#include <Kokkos_Core.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+namespace KokkosSparse {
+namespace Impl {
+
+/**
+ * \brief Splits the nrows rows into blocks of block_size consecutive rows,
+ * and computes on the host the blocks each block depends on: the blocks
+ * that hold the columns of its rows, other than itself. The dependencies
+ * of block b are deps[dep_ptr(b), dep_ptr(b+1)). Returns the number of
+ * blocks.
+ */
+template <class RowMapHostType, class EntriesHostType, class PtrHostType, class LnoHostType>
+typename LnoHostType::non_const_value_type
+build_block_dag(
+    const typename LnoHostType::non_const_value_type nrows,
+    const typename LnoHostType::non_const_value_type block_size,
+    const RowMapHostType &row_map, const EntriesHostType &entries,
+    PtrHostType &dep_ptr, LnoHostType &deps)
+{
+  typedef typename PtrHostType::non_const_value_type size_type;
+  typedef typename LnoHostType::non_const_value_type lno_t;
+
+  const lno_t nblocks = (nrows + block_size - 1) / block_size;
+  dep_ptr = PtrHostType("task_dep_ptr", nblocks + 1);
+
+  std::vector<lno_t> dep_list;
+  std::vector<lno_t> marker(nblocks, -1);
+  for (lno_t b = 0; b < nblocks; ++b){
+    const lno_t row_end = std::min(nrows, (b + 1) * block_size);
+    for (lno_t rowid = b * block_size; rowid < row_end; ++rowid){
+      for (size_type k = row_map(rowid); k < size_type(row_map(rowid + 1)); ++k){
+        const lno_t colid = entries(k);
+        if (colid < 0 || colid >= nrows) continue;
+        const lno_t cb = colid / block_size;
+        if (cb != b && marker[cb] != b){
+          marker[cb] = b;
+          dep_list.push_back(cb);
+        }
+      }
+    }
+    dep_ptr(b + 1) = dep_list.size();
+  }
+
+  deps = LnoHostType("task_deps", dep_list.size());
+  for (size_t k = 0; k < dep_list.size(); ++k) deps(k) = dep_list[k];
+  return nblocks;
+}
+
+/**
+ * \brief Task of a block of rows [row_begin, row_end). The rows are
+ * processed one after another by a single thread with
+ * RowFunctor::apply_row, in decreasing order if reverse is set.
+ */
+template <class RowFunctor, class lno_t>
+struct BlockDAGTaskFunctor
+{
+  typedef void value_type;
+
+  RowFunctor row_functor;
+  lno_t row_begin;
+  lno_t row_end;
+  bool reverse;
+
+  BlockDAGTaskFunctor(const RowFunctor &row_functor_, lno_t row_begin_, lno_t row_end_, bool reverse_):
+    row_functor(row_functor_), row_begin(row_begin_), row_end(row_end_), reverse(reverse_) {}
+
+  template <class MemberType>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(MemberType &member) const {
+    Kokkos::single(Kokkos::PerThread(member), [&] () {
+      for (lno_t i = row_begin; i < row_end; ++i){
+        row_functor.apply_row(reverse ? row_end - 1 - (i - row_begin) : i);
+      }
+    });
+  }
+};
+
+#if defined(KOKKOS_ENABLE_TASKDAG)
+/**
+ * \brief Spawns one task per block of the block DAG, each waiting only
+ * for the blocks it depends on, so that a block starts as soon as its
+ * dependencies are done instead of waiting for a whole level. The blocks
+ * are spawned in a topological order: increasing for lower triangular
+ * dependencies, decreasing (reverse) for upper triangular ones. Returns
+ * when all the tasks are done.
+ */
+template <class ExecutionSpace, class RowFunctor, class PtrHostType, class LnoHostType>
+void run_block_dag(
+    const RowFunctor &row_functor,
+    const typename LnoHostType::non_const_value_type nrows,
+    const typename LnoHostType::non_const_value_type block_size,
+    const PtrHostType &dep_ptr, const LnoHostType &deps, const bool reverse)
+{
+  typedef typename LnoHostType::non_const_value_type lno_t;
+  typedef Kokkos::TaskScheduler<ExecutionSpace> sched_type;
+  typedef typename sched_type::memory_space memory_space;
+  typedef Kokkos::Future<void, ExecutionSpace> future_type;
+  typedef BlockDAGTaskFunctor<RowFunctor, lno_t> task_type;
+
+  const lno_t nblocks = dep_ptr.extent(0) ? dep_ptr.extent(0) - 1 : 0;
+  if (nblocks == 0) return;
+
+  //each block allocates its task and, with two or more dependencies, a
+  //when_all aggregate of their futures. The pool blocks must fit both.
+  size_t max_deps = 0;
+  for (lno_t b = 0; b < nblocks; ++b){
+    max_deps = std::max(max_deps, size_t(dep_ptr(b + 1) - dep_ptr(b)));
+  }
+  const size_t task_bytes = sizeof(task_type) + 256;
+  const size_t when_all_bytes = 256 + max_deps * sizeof(void *);
+  unsigned max_block_size = 64;
+  while (max_block_size < task_bytes || max_block_size < when_all_bytes) max_block_size *= 2;
+  const unsigned superblock_size = std::max(4096u, max_block_size);
+  const size_t capacity = 2 * size_t(nblocks) * max_block_size + 4 * size_t(superblock_size);
+
+  sched_type sched(memory_space(), capacity, 64, max_block_size, superblock_size);
+
+  std::vector<future_type> futures(nblocks);
+  std::vector<future_type> dep_futures;
+  for (lno_t i = 0; i < nblocks; ++i){
+    const lno_t b = reverse ? nblocks - 1 - i : i;
+    dep_futures.clear();
+    for (size_t k = dep_ptr(b); k < size_t(dep_ptr(b + 1)); ++k){
+      //entries outside of the triangle have no earlier task to wait for.
+      if (!futures[deps(k)].is_null()) dep_futures.push_back(futures[deps(k)]);
+    }
+    future_type dep;
+    if (dep_futures.size() == 1){
+      dep = dep_futures[0];
+    }
+    else if (dep_futures.size() > 1){
+      dep = sched.when_all(dep_futures.data(), int(dep_futures.size()));
+    }
+    futures[b] = Kokkos::host_spawn(Kokkos::TaskSingle(sched, dep),
+        task_type(row_functor, b * block_size, std::min(nrows, (b + 1) * block_size), reverse));
+    if (futures[b].is_null()){
+      throw std::runtime_error("run_block_dag: the task scheduler ran out of memory");
+    }
+  }
+  Kokkos::wait(sched);
+}
+#endif
+
+} // namespace Impl
+} // namespace KokkosSparse
+
+#endif // KOKKOSSPARSE_IMPL_BLOCK_DAG_HPP_
@@ -0,0 +1,246 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSSPARSE_BLOCK_JACOBI_IMPL_HPP
+#define _KOKKOSSPARSE_BLOCK_JACOBI_IMPL_HPP
+
+#include <vector>
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_LU_Decl.hpp"
+#include "KokkosBatched_LU_Serial_Impl.hpp"
+#include "KokkosBatched_Trsv_Decl.hpp"
+#include "KokkosBatched_Trsv_Serial_Impl.hpp"
+
+namespace KokkosSparse{
+namespace Impl{
+
+/**
+ * \brief Splits the rows of A into blocks of at most block_size rows, on the
+ * host, and stores the blocks in the handle. The contiguous partition takes
+ * consecutive rows; the graph partition grows each block by breadth first
+ * search from the first row that is not in a block yet, so that the blocks
+ * follow the couplings of the matrix.
+ */
+template <class HandleType, class AMatrix>
+void block_jacobi_symbolic(HandleType &handle, const AMatrix &A){
+  typedef typename HandleType::nnz_lno_t nnz_lno_t;
+  typedef typename HandleType::lno_view_t lno_view_t;
+  typedef typename AMatrix::row_map_type::non_const_type::HostMirror host_row_map_t;
+  typedef typename AMatrix::index_type::non_const_type::HostMirror host_entries_t;
+
+  const nnz_lno_t num_rows = A.numRows();
+  const nnz_lno_t block_size = handle.get_block_size();
+
+  std::vector<nnz_lno_t> block_ptr(1, 0);
+  std::vector<nnz_lno_t> block_rows;
+  block_rows.reserve(num_rows);
+
+  if (handle.get_partition() == BLOCK_JACOBI_GRAPH){
+    host_row_map_t h_row_map("h_row_map", num_rows + 1);
+    host_entries_t h_entries("h_entries", A.nnz());
+    Kokkos::deep_copy(h_row_map, A.graph.row_map);
+    Kokkos::deep_copy(h_entries, A.graph.entries);
+
+    std::vector<bool> in_block(num_rows, false);
+    for (nnz_lno_t seed = 0; seed < num_rows; ++seed){
+      if (in_block[seed]) continue;
+      //the rows of the block are also the queue of the search.
+      const size_t first = block_rows.size();
+      block_rows.push_back(seed);
+      in_block[seed] = true;
+      for (size_t q = first; q < block_rows.size() && nnz_lno_t(block_rows.size() - first) < block_size; ++q){
+        const nnz_lno_t row = block_rows[q];
+        for (size_t k = h_row_map(row); k < size_t(h_row_map(row + 1)); ++k){
+          const nnz_lno_t col = h_entries(k);
+          if (col >= num_rows || in_block[col]) continue;
+          block_rows.push_back(col);
+          in_block[col] = true;
+          if (nnz_lno_t(block_rows.size() - first) == block_size) break;
+        }
+      }
+      block_ptr.push_back(block_rows.size());
+    }
+  }
+  else {
+    for (nnz_lno_t row = 0; row < num_rows; ++row){
+      block_rows.push_back(row);
+      if ((row + 1) % block_size == 0 || row + 1 == num_rows) block_ptr.push_back(row + 1);
+    }
+  }
+
+  const nnz_lno_t num_blocks = block_ptr.size() - 1;
+  lno_view_t d_block_ptr("block_ptr", num_blocks + 1);
+  lno_view_t d_block_rows("block_rows", num_rows);
+  lno_view_t d_row_block("row_block", num_rows);
+  lno_view_t d_row_position("row_position", num_rows);
+  typename lno_view_t::HostMirror h_block_ptr = Kokkos::create_mirror_view(d_block_ptr);
+  typename lno_view_t::HostMirror h_block_rows = Kokkos::create_mirror_view(d_block_rows);
+  typename lno_view_t::HostMirror h_row_block = Kokkos::create_mirror_view(d_row_block);
+  typename lno_view_t::HostMirror h_row_position = Kokkos::create_mirror_view(d_row_position);
+  for (nnz_lno_t b = 0; b <= num_blocks; ++b) h_block_ptr(b) = block_ptr[b];
+  for (nnz_lno_t b = 0; b < num_blocks; ++b){
+    for (nnz_lno_t k = block_ptr[b]; k < block_ptr[b + 1]; ++k){
+      h_block_rows(k) = block_rows[k];
+      h_row_block(block_rows[k]) = b;
+      h_row_position(block_rows[k]) = k;
+    }
+  }
+  Kokkos::deep_copy(d_block_ptr, h_block_ptr);
+  Kokkos::deep_copy(d_block_rows, h_block_rows);
+  Kokkos::deep_copy(d_row_block, h_row_block);
+  Kokkos::deep_copy(d_row_position, h_row_position);
+  handle.set_blocks(num_blocks, d_block_ptr, d_block_rows, d_row_block, d_row_position);
+}
+
+//copies the diagonal block of a block, padded with the identity, and LU factors it.
+template <class HandleType, class AMatrix>
+struct BlockJacobi_Factor_Functor{
+  typedef typename HandleType::nnz_lno_t nnz_lno_t;
+  typedef typename HandleType::nnz_scalar_t nnz_scalar_t;
+  typedef typename HandleType::lno_view_t lno_view_t;
+  typedef typename HandleType::block_view_t block_view_t;
+  typedef typename AMatrix::size_type size_type;
+
+  AMatrix A;
+  lno_view_t block_ptr, block_rows, row_block, row_position;
+  block_view_t blocks;
+  nnz_lno_t block_size;
+
+  BlockJacobi_Factor_Functor(const AMatrix &A_, const HandleType &handle, block_view_t blocks_):
+    A(A_), block_ptr(handle.get_block_ptr()), block_rows(handle.get_block_rows()),
+    row_block(handle.get_row_block()), row_position(handle.get_row_position()),
+    blocks(blocks_), block_size(handle.get_block_size()){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const nnz_lno_t b) const {
+    typedef Kokkos::Details::ArithTraits<nnz_scalar_t> KAT;
+    auto D = Kokkos::subview(blocks, b, Kokkos::ALL(), Kokkos::ALL());
+    const nnz_lno_t begin = block_ptr(b);
+    const nnz_lno_t size = block_ptr(b + 1) - begin;
+    for (nnz_lno_t i = 0; i < block_size; ++i)
+      for (nnz_lno_t j = 0; j < block_size; ++j)
+        D(i, j) = (i == j && i >= size) ? KAT::one() : KAT::zero();
+    for (nnz_lno_t i = 0; i < size; ++i){
+      const nnz_lno_t row = block_rows(begin + i);
+      for (size_type k = A.graph.row_map(row); k < A.graph.row_map(row + 1); ++k){
+        const nnz_lno_t col = A.graph.entries(k);
+        if (col < A.numRows() && row_block(col) == b)
+          D(i, row_position(col) - begin) += A.values(k);
+      }
+    }
+    KokkosBatched::Experimental::SerialLU<KokkosBatched::Experimental::Algo::LU::Unblocked>::invoke(D);
+  }
+};
+
+/**
+ * \brief LU factors the diagonal blocks of A for the partition of the handle,
+ * one block per thread.
+ */
+template <class HandleType, class AMatrix>
+void block_jacobi_numeric(HandleType &handle, const AMatrix &A){
+  typedef typename HandleType::execution_space execution_space;
+  typedef typename HandleType::block_view_t block_view_t;
+  typedef typename HandleType::block_vector_view_t block_vector_view_t;
+
+  const typename HandleType::nnz_lno_t num_blocks = handle.get_num_blocks();
+  const typename HandleType::nnz_lno_t block_size = handle.get_block_size();
+  block_view_t blocks(Kokkos::ViewAllocateWithoutInitializing("block Jacobi factors"), num_blocks, block_size, block_size);
+  block_vector_view_t work(Kokkos::ViewAllocateWithoutInitializing("block Jacobi work"), num_blocks, block_size);
+  Kokkos::parallel_for("KokkosSparse::block_jacobi_numeric",
+      Kokkos::RangePolicy<execution_space>(0, num_blocks),
+      BlockJacobi_Factor_Functor<HandleType, AMatrix>(A, handle, blocks));
+  execution_space::fence();
+  handle.set_factored_blocks(blocks, work);
+}
+
+//z = D^{-1} r on the rows of a block, with the LU factors of its diagonal block D.
+template <class HandleType, class RVector, class ZVector>
+struct BlockJacobi_Apply_Functor{
+  typedef typename HandleType::nnz_lno_t nnz_lno_t;
+  typedef typename HandleType::nnz_scalar_t nnz_scalar_t;
+  typedef typename HandleType::lno_view_t lno_view_t;
+  typedef typename HandleType::block_view_t block_view_t;
+  typedef typename HandleType::block_vector_view_t block_vector_view_t;
+
+  lno_view_t block_ptr, block_rows;
+  block_view_t blocks;
+  block_vector_view_t work;
+  nnz_lno_t block_size;
+  RVector r;
+  ZVector z;
+
+  BlockJacobi_Apply_Functor(const HandleType &handle, const RVector &r_, const ZVector &z_):
+    block_ptr(handle.get_block_ptr()), block_rows(handle.get_block_rows()),
+    blocks(handle.get_factored_blocks()), work(handle.get_work()),
+    block_size(handle.get_block_size()), r(r_), z(z_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const nnz_lno_t b) const {
+    using namespace KokkosBatched::Experimental;
+    typedef Kokkos::Details::ArithTraits<nnz_scalar_t> KAT;
+    auto D = Kokkos::subview(blocks, b, Kokkos::ALL(), Kokkos::ALL());
+    auto w = Kokkos::subview(work, b, Kokkos::ALL());
+    const nnz_lno_t begin = block_ptr(b);
+    const nnz_lno_t size = block_ptr(b + 1) - begin;
+    for (nnz_lno_t i = 0; i < block_size; ++i)
+      w(i) = i < size ? nnz_scalar_t(r(block_rows(begin + i))) : KAT::zero();
+    SerialTrsv<Uplo::Lower, Trans::NoTranspose, Diag::Unit, Algo::Trsv::Unblocked>::invoke(KAT::one(), D, w);
+    SerialTrsv<Uplo::Upper, Trans::NoTranspose, Diag::NonUnit, Algo::Trsv::Unblocked>::invoke(KAT::one(), D, w);
+    for (nnz_lno_t i = 0; i < size; ++i)
+      z(block_rows(begin + i)) = w(i);
+  }
+};
+
+template <class HandleType, class RVector, class ZVector>
+void block_jacobi_apply(const HandleType &handle, const RVector &r, const ZVector &z){
+  typedef typename HandleType::execution_space execution_space;
+  Kokkos::parallel_for("KokkosSparse::block_jacobi_apply",
+      Kokkos::RangePolicy<execution_space>(0, handle.get_num_blocks()),
+      BlockJacobi_Apply_Functor<HandleType, RVector, ZVector>(handle, r, z));
+  execution_space::fence();
+}
+
+}
+}
+#endif
@@ -0,0 +1,162 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSSPARSE_BLOCK_SPGEMM_IMPL_HPP
+#define _KOKKOSSPARSE_BLOCK_SPGEMM_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+#include "KokkosSparse_findRelOffset.hpp"
+#include "KokkosSparse_spgemm_symbolic.hpp"
+#include "KokkosSparse_spgemm_numeric.hpp"
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Gemm_Decl.hpp"
+#include "KokkosBatched_Gemm_Serial_Impl.hpp"
+
+namespace KokkosSparse{
+namespace Experimental{
+namespace Impl{
+
+/**
+ * \brief Computes the block graph of C = A*B with the spgemm of the kernel
+ * handle on the block graphs of A and B, so that its hash keys are the block
+ * column ids, and sorts the rows of C so that the numeric phase finds its
+ * blocks by binary search. C gets zero values.
+ */
+template <typename KernelHandle, typename AMatrix, typename BMatrix, typename CMatrix>
+void block_spgemm_symbolic(KernelHandle *handle, const AMatrix &A, const BMatrix &B, CMatrix &C){
+  typedef typename KernelHandle::HandleExecSpace execution_space;
+  typedef typename CMatrix::row_map_type::non_const_type c_row_map_t;
+  typedef typename CMatrix::index_type::non_const_type c_entries_t;
+  typedef typename CMatrix::values_type::non_const_type c_values_t;
+  typedef typename KernelHandle::nnz_scalar_t scalar_t;
+  typedef Kokkos::View<scalar_t *, execution_space> graph_values_t;
+
+  const typename CMatrix::non_const_ordinal_type block_dim = A.blockDim();
+  const size_t m = A.numRows(), n = A.numCols(), k = B.numCols();
+
+  c_row_map_t row_mapC("block spgemm row_mapC", m + 1);
+  spgemm_symbolic(handle, m, n, k,
+      A.graph.row_map, A.graph.entries, false,
+      B.graph.row_map, B.graph.entries, false,
+      row_mapC);
+
+  //the values of the graph product are not used.
+  const size_t c_nnz = handle->get_spgemm_handle()->get_c_nnz();
+  c_entries_t entriesC(Kokkos::ViewAllocateWithoutInitializing("block spgemm entriesC"), c_nnz);
+  graph_values_t graph_valuesA("block spgemm graph valuesA", A.graph.entries.extent(0));
+  graph_values_t graph_valuesB("block spgemm graph valuesB", B.graph.entries.extent(0));
+  graph_values_t graph_valuesC(Kokkos::ViewAllocateWithoutInitializing("block spgemm graph valuesC"), c_nnz);
+  spgemm_numeric(handle, m, n, k,
+      A.graph.row_map, A.graph.entries, graph_valuesA, false,
+      B.graph.row_map, B.graph.entries, graph_valuesB, false,
+      row_mapC, entriesC, graph_valuesC);
+  KokkosKernels::Impl::kk_sort_crs_rows<c_row_map_t, c_entries_t, graph_values_t, execution_space>
+      (row_mapC, entriesC, graph_values_t());
+
+  c_values_t valuesC("block spgemm valuesC", c_nnz * block_dim * block_dim);
+  C = CMatrix("C", m, k, c_nnz * block_dim * block_dim, valuesC, row_mapC, entriesC, block_dim);
+}
+
+//C(i,:) = sum_k A(i,k) B(k,:), one block row of C per thread; each product
+//of blocks is a small dense gemm into the block of C found in its sorted row.
+template <typename AMatrix, typename BMatrix, typename CMatrix>
+struct BlockSpGEMM_Numeric_Functor{
+  typedef typename CMatrix::non_const_ordinal_type nnz_lno_t;
+  typedef typename CMatrix::non_const_size_type size_type;
+  typedef typename CMatrix::non_const_value_type scalar_t;
+  typedef KokkosBatched::Experimental::SerialGemm
+      <KokkosBatched::Experimental::Trans::NoTranspose,
+       KokkosBatched::Experimental::Trans::NoTranspose,
+       KokkosBatched::Experimental::Algo::Gemm::Unblocked> gemm_t;
+
+  AMatrix A;
+  BMatrix B;
+  CMatrix C;
+
+  BlockSpGEMM_Numeric_Functor(const AMatrix &A_, const BMatrix &B_, const CMatrix &C_):
+    A(A_), B(B_), C(C_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const nnz_lno_t &i) const {
+    const auto a_row = A.block_row_Const(i);
+    const auto c_row = C.block_row(i);
+    const size_type a_begin = A.graph.row_map(i);
+    const size_type c_begin = C.graph.row_map(i);
+    const nnz_lno_t *c_cols = C.graph.entries.data() + c_begin;
+
+    for (nnz_lno_t ka = 0; ka < a_row.length; ++ka){
+      const nnz_lno_t k = A.graph.entries(a_begin + ka);
+      const auto b_row = B.block_row_Const(k);
+      const size_type b_begin = B.graph.row_map(k);
+      nnz_lno_t hint = 0;
+      for (nnz_lno_t kb = 0; kb < b_row.length; ++kb){
+        const nnz_lno_t j = B.graph.entries(b_begin + kb);
+        const nnz_lno_t kc = KokkosSparse::findRelOffset(c_cols, c_row.length, j, hint, true);
+        hint = kc + 1;
+        gemm_t::invoke(scalar_t(1), a_row.block(ka), b_row.block(kb), scalar_t(1), c_row.block(kc));
+      }
+    }
+  }
+};
+
+template <typename KernelHandle, typename AMatrix, typename BMatrix, typename CMatrix>
+void block_spgemm_numeric(KernelHandle *handle, const AMatrix &A, const BMatrix &B, const CMatrix &C){
+  typedef typename KernelHandle::HandleExecSpace execution_space;
+  typedef BlockSpGEMM_Numeric_Functor<AMatrix, BMatrix, CMatrix> functor_t;
+
+  Kokkos::deep_copy(C.values, typename CMatrix::non_const_value_type());
+  if (handle->is_dynamic_scheduling()){
+    Kokkos::parallel_for("KokkosSparse::block_spgemm_numeric",
+        Kokkos::RangePolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic> >(0, A.numRows()), functor_t(A, B, C));
+  }
+  else {
+    Kokkos::parallel_for("KokkosSparse::block_spgemm_numeric",
+        Kokkos::RangePolicy<execution_space>(0, A.numRows()), functor_t(A, B, C));
+  }
+}
+
+}
+}
+}
+
+#endif
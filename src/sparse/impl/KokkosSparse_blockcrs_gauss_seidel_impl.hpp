@@ -0,0 +1,264 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSSPARSE_BLOCKCRS_GAUSS_SEIDEL_IMPL_HPP
+#define _KOKKOSSPARSE_BLOCKCRS_GAUSS_SEIDEL_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosGraph_graph_color.hpp"
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_LU_Serial_Internal.hpp"
+#include "KokkosBatched_Trsv_Serial_Internal.hpp"
+#include "KokkosBatched_Gemv_Serial_Internal.hpp"
+
+namespace KokkosSparse{
+namespace Impl{
+
+/**
+ * \brief Colors the block graph of A (symmetrized if needed), so that the
+ * block rows of a color can be relaxed in parallel, and stores the color
+ * sets in the gs handle.
+ */
+template <class HandleType, class BlockCrsMatrixType>
+void blockcrs_gauss_seidel_symbolic(HandleType *handle, const BlockCrsMatrixType &A, bool is_symmetric){
+  typedef typename HandleType::HandleExecSpace MyExecSpace;
+  typedef typename HandleType::row_lno_temp_work_view_t row_lno_temp_work_view_t;
+  typedef typename HandleType::nnz_lno_temp_work_view_t nnz_lno_temp_work_view_t;
+  typedef typename HandleType::nnz_lno_persistent_work_view_t nnz_lno_persistent_work_view_t;
+  typedef typename HandleType::nnz_lno_persistent_work_host_view_t nnz_lno_persistent_work_host_view_t;
+  typedef typename BlockCrsMatrixType::row_map_type::const_type const_lno_row_view_t;
+  typedef typename BlockCrsMatrixType::index_type::const_type const_lno_nnz_view_t;
+  typedef typename HandleType::nnz_lno_t nnz_lno_t;
+
+  typename HandleType::GraphColoringHandleType *gchandle = handle->get_graph_coloring_handle();
+  if (gchandle == NULL){
+    handle->create_graph_coloring_handle();
+    handle->get_gs_handle()->set_owner_of_coloring();
+    gchandle = handle->get_graph_coloring_handle();
+  }
+
+  const nnz_lno_t num_rows = A.numRows();
+  const_lno_row_view_t xadj = A.graph.row_map;
+  const_lno_nnz_view_t adj = A.graph.entries;
+  if (!is_symmetric){
+    if (gchandle->get_coloring_algo_type() == KokkosGraph::COLORING_EB){
+      gchandle->symmetrize_and_calculate_lower_diagonal_edge_list(num_rows, xadj, adj);
+      KokkosGraph::Experimental::graph_color_symbolic <HandleType, const_lno_row_view_t, const_lno_nnz_view_t>
+          (handle, num_rows, num_rows, xadj , adj);
+    }
+    else {
+      row_lno_temp_work_view_t tmp_xadj;
+      nnz_lno_temp_work_view_t tmp_adj;
+      KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap
+      < const_lno_row_view_t, const_lno_nnz_view_t,
+      row_lno_temp_work_view_t, nnz_lno_temp_work_view_t,
+      MyExecSpace>
+      (num_rows, xadj, adj, tmp_xadj, tmp_adj );
+      KokkosGraph::Experimental::graph_color_symbolic <HandleType, row_lno_temp_work_view_t, nnz_lno_temp_work_view_t>
+          (handle, num_rows, num_rows, tmp_xadj , tmp_adj);
+    }
+  }
+  else {
+    KokkosGraph::Experimental::graph_color_symbolic <HandleType, const_lno_row_view_t, const_lno_nnz_view_t>
+        (handle, num_rows, num_rows, xadj , adj);
+  }
+
+  const nnz_lno_t numColors = gchandle->get_num_colors();
+  nnz_lno_persistent_work_view_t color_xadj = gchandle->get_color_set_xadj();
+  nnz_lno_persistent_work_host_view_t h_color_xadj = gchandle->get_host_color_set_xadj();
+  nnz_lno_persistent_work_view_t color_adj = gchandle->get_color_set_adj();
+
+  handle->get_gs_handle()->set_block_size(A.blockDim());
+  handle->get_gs_handle()->set_color_set_xadj(h_color_xadj);
+  handle->get_gs_handle()->set_device_color_set_xadj(color_xadj);
+  handle->get_gs_handle()->set_color_set_adj(color_adj);
+  handle->get_gs_handle()->set_num_colors(numColors);
+  handle->get_gs_handle()->set_call_symbolic(true);
+  handle->get_gs_handle()->set_call_numeric(false);
+}
+
+//copies the diagonal block of each block row, row major, and factors it
+//in place with the unpivoted batched LU. A missing diagonal block is
+//replaced by the identity.
+template <class BlockCrsMatrixType, class ScalarView>
+struct BlockCrs_GS_Factor_Diagonal_Functor{
+  typedef typename BlockCrsMatrixType::non_const_ordinal_type ordinal_type;
+  typedef typename BlockCrsMatrixType::non_const_size_type size_type;
+  typedef typename ScalarView::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> STS;
+
+  BlockCrsMatrixType A;
+  ScalarView diagonals;
+
+  BlockCrs_GS_Factor_Diagonal_Functor(const BlockCrsMatrixType &A_, const ScalarView diagonals_):
+    A(A_), diagonals(diagonals_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const ordinal_type &block_row) const {
+    const ordinal_type bs = A.blockDim();
+    const size_type begin = A.graph.row_map(block_row);
+    const ordinal_type length = static_cast<ordinal_type> (A.graph.row_map(block_row + 1) - begin);
+    const ordinal_type as0 = length * bs;
+    scalar_t *D = diagonals.data() + size_type(block_row) * bs * bs;
+
+    ordinal_type K = 0;
+    while (K < length && A.graph.entries(begin + K) != block_row) ++K;
+    const scalar_t *row_values = A.values.data() + begin * bs * bs + K * bs;
+    for (ordinal_type i = 0; i < bs; ++i){
+      for (ordinal_type j = 0; j < bs; ++j){
+        D[i * bs + j] = K < length ? row_values[i * as0 + j] : (i == j ? STS::one() : STS::zero());
+      }
+    }
+    KokkosBatched::Experimental::SerialLU_Internal<KokkosBatched::Experimental::Algo::LU::Unblocked>
+      ::invoke(bs, bs, D, bs, 1, 0);
+  }
+};
+
+//relaxes the block rows of a color: x_r = D_r^{-1} (y_r - sum_{c != r} A_rc x_c),
+//with the off-diagonal products by block gemv and D_r^{-1} by the triangular
+//solves with its LU factors.
+template <class BlockCrsMatrixType, class ScalarView, class LnoView, class XView, class YView>
+struct BlockCrs_GS_Sweep_Functor{
+  typedef typename BlockCrsMatrixType::non_const_ordinal_type ordinal_type;
+  typedef typename BlockCrsMatrixType::non_const_size_type size_type;
+  typedef typename ScalarView::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> STS;
+
+  BlockCrsMatrixType A;
+  ScalarView diagonals;
+  LnoView color_adj;
+  XView x;
+  YView y;
+
+  BlockCrs_GS_Sweep_Functor(const BlockCrsMatrixType &A_, const ScalarView diagonals_,
+      const LnoView color_adj_, const XView x_, const YView y_):
+    A(A_), diagonals(diagonals_), color_adj(color_adj_), x(x_), y(y_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const ordinal_type &ii) const {
+    const ordinal_type block_row = color_adj(ii);
+    const ordinal_type bs = A.blockDim();
+    const size_type begin = A.graph.row_map(block_row);
+    const ordinal_type length = static_cast<ordinal_type> (A.graph.row_map(block_row + 1) - begin);
+    const ordinal_type as0 = length * bs;
+    const scalar_t *row_values = A.values.data() + begin * bs * bs;
+    const scalar_t *D = diagonals.data() + size_type(block_row) * bs * bs;
+    scalar_t *x_r = &x(block_row * bs);
+
+    for (ordinal_type i = 0; i < bs; ++i) x_r[i * x.stride(0)] = y(block_row * bs + i);
+    for (ordinal_type K = 0; K < length; ++K){
+      const ordinal_type col = A.graph.entries(begin + K);
+      if (col == block_row) continue;
+      KokkosBatched::Experimental::SerialGemvInternal<KokkosBatched::Experimental::Algo::Gemv::Unblocked>
+        ::invoke(bs, bs, -STS::one(), row_values + K * bs, as0, 1, &x(col * bs), x.stride(0), STS::one(), x_r, x.stride(0));
+    }
+    KokkosBatched::Experimental::SerialTrsvInternalLower<KokkosBatched::Experimental::Algo::Trsv::Unblocked>
+      ::invoke(true, bs, STS::one(), D, bs, 1, x_r, x.stride(0));
+    KokkosBatched::Experimental::SerialTrsvInternalUpper<KokkosBatched::Experimental::Algo::Trsv::Unblocked>
+      ::invoke(false, bs, STS::one(), D, bs, 1, x_r, x.stride(0));
+  }
+};
+
+template <class HandleType, class BlockCrsMatrixType>
+void blockcrs_gauss_seidel_numeric(HandleType *handle, const BlockCrsMatrixType &A){
+  typedef typename HandleType::HandleExecSpace MyExecSpace;
+  typedef typename HandleType::scalar_persistent_work_view_t scalar_persistent_work_view_t;
+  typedef typename HandleType::nnz_lno_t nnz_lno_t;
+
+  const nnz_lno_t num_rows = A.numRows();
+  const nnz_lno_t bs = A.blockDim();
+  scalar_persistent_work_view_t diagonals = handle->get_gs_handle()->get_factored_block_diagonals();
+  if (diagonals.extent(0) != size_t(num_rows) * bs * bs){
+    diagonals = scalar_persistent_work_view_t(Kokkos::ViewAllocateWithoutInitializing("factored block diagonals"), size_t(num_rows) * bs * bs);
+  }
+  Kokkos::parallel_for("KokkosSparse::BlockCrsGaussSeidel::factor_diagonals",
+      Kokkos::RangePolicy<MyExecSpace>(0, num_rows),
+      BlockCrs_GS_Factor_Diagonal_Functor<BlockCrsMatrixType, scalar_persistent_work_view_t>(A, diagonals));
+  MyExecSpace::fence();
+  handle->get_gs_handle()->set_factored_block_diagonals(diagonals);
+  handle->get_gs_handle()->set_call_numeric(true);
+}
+
+template <class HandleType, class BlockCrsMatrixType, class XView, class YView>
+void blockcrs_gauss_seidel_apply(HandleType *handle, const BlockCrsMatrixType &A,
+    XView x, YView y, bool init_zero_x_vector, int numIter,
+    bool apply_forward, bool apply_backward){
+  typedef typename HandleType::HandleExecSpace MyExecSpace;
+  typedef typename HandleType::scalar_persistent_work_view_t scalar_persistent_work_view_t;
+  typedef typename HandleType::nnz_lno_persistent_work_view_t nnz_lno_persistent_work_view_t;
+  typedef typename HandleType::nnz_lno_persistent_work_host_view_t nnz_lno_persistent_work_host_view_t;
+  typedef typename HandleType::nnz_lno_t nnz_lno_t;
+  typedef typename HandleType::nnz_scalar_t nnz_scalar_t;
+
+  if (init_zero_x_vector){
+    Kokkos::deep_copy(x, Kokkos::Details::ArithTraits<nnz_scalar_t>::zero());
+  }
+
+  const nnz_lno_t numColors = handle->get_gs_handle()->get_num_colors();
+  nnz_lno_persistent_work_host_view_t h_color_xadj = handle->get_gs_handle()->get_color_xadj();
+  nnz_lno_persistent_work_view_t color_adj = handle->get_gs_handle()->get_color_adj();
+  BlockCrs_GS_Sweep_Functor<BlockCrsMatrixType, scalar_persistent_work_view_t, nnz_lno_persistent_work_view_t, XView, YView>
+    gs(A, handle->get_gs_handle()->get_factored_block_diagonals(), color_adj, x, y);
+
+  for (int iter = 0; iter < numIter; ++iter){
+    if (apply_forward){
+      for (nnz_lno_t i = 0; i < numColors; ++i){
+        Kokkos::parallel_for("KokkosSparse::BlockCrsGaussSeidel::forward",
+            Kokkos::RangePolicy<MyExecSpace>(h_color_xadj(i), h_color_xadj(i + 1)), gs);
+        MyExecSpace::fence();
+      }
+    }
+    if (apply_backward){
+      for (nnz_lno_t i = numColors; i-- > 0; ){
+        Kokkos::parallel_for("KokkosSparse::BlockCrsGaussSeidel::backward",
+            Kokkos::RangePolicy<MyExecSpace>(h_color_xadj(i), h_color_xadj(i + 1)), gs);
+        MyExecSpace::fence();
+      }
+    }
+  }
+}
+
+}
+}
+#endif
@@ -0,0 +1,153 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSSPARSE_CHEBYSHEV_IMPL_HPP
+#define _KOKKOSSPARSE_CHEBYSHEV_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+#include "KokkosBlas1_axpby.hpp"
+#include "KokkosBlas1_mult.hpp"
+#include "KokkosBlas1_nrm2.hpp"
+#include "KokkosBlas1_scal.hpp"
+#include "KokkosSparse_linear_operator.hpp"
+
+namespace KokkosSparse{
+namespace Impl{
+
+//a deterministic vector with entries in [1/2, 3/2), the start of the power iterations.
+template<class VectorType>
+struct Chebyshev_Start_Vector_Functor {
+  typedef typename VectorType::non_const_value_type scalar_t;
+  typedef typename Kokkos::Details::ArithTraits<scalar_t>::mag_type mag_t;
+
+  VectorType v;
+
+  Chebyshev_Start_Vector_Functor (const VectorType v_) : v (v_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& i) const
+  {
+    const size_t h = (i * 2654435761UL + 12345) % 1024;
+    v(i) = scalar_t (mag_t (0.5) + mag_t (h) / mag_t (1024));
+  }
+};
+
+/// \brief Largest eigenvalue of D^{-1} A estimated with power iterations,
+///   using the work vectors of the handle.
+template<class HandleType, class AMatrix>
+typename HandleType::mag_t
+chebyshev_power_iterations (HandleType& handle, const AMatrix& A)
+{
+  typedef typename HandleType::nnz_scalar_t scalar_t;
+  typedef typename HandleType::mag_t mag_t;
+  typedef typename HandleType::execution_space execution_space;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  typedef typename HandleType::scalar_view_t scalar_view_t;
+
+  scalar_view_t inv_diag = handle.get_inv_diag ();
+  scalar_view_t y = handle.get_work_r ();
+  scalar_view_t v = handle.get_work_d ();
+
+  Kokkos::parallel_for ("KokkosSparse::ChebyshevStartVector",
+      Kokkos::RangePolicy<execution_space> (0, v.extent (0)),
+      Chebyshev_Start_Vector_Functor<scalar_view_t> (v));
+  mag_t lambda = KokkosBlas::nrm2 (v);
+  for (int k = 0; k < handle.get_num_power_iterations () && lambda > 0; ++k) {
+    KokkosBlas::scal (v, scalar_t (ATS::one () / lambda), v);
+    KokkosSparse::Experimental::operator_apply (A, v, y);
+    KokkosBlas::mult (ATS::zero (), v, ATS::one (), inv_diag, y);
+    lambda = KokkosBlas::nrm2 (v);
+  }
+  return lambda;
+}
+
+/// \brief Applies handle.get_degree() steps of the Chebyshev iteration
+///   for D^{-1} A x = D^{-1} b to x.
+template<class HandleType, class AMatrix, class XVector, class BVector>
+void chebyshev_apply (const HandleType& handle, const AMatrix& A,
+                      const XVector& x, const BVector& b, const bool zero_initial_guess)
+{
+  typedef typename HandleType::nnz_scalar_t scalar_t;
+  typedef typename HandleType::mag_t mag_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  typedef typename HandleType::scalar_view_t scalar_view_t;
+
+  scalar_view_t inv_diag = handle.get_inv_diag ();
+  scalar_view_t r = handle.get_work_r ();
+  scalar_view_t d = handle.get_work_d ();
+
+  const mag_t lambda_max = handle.get_lambda_max ();
+  const mag_t lambda_min = handle.get_lambda_min ();
+  const mag_t theta = (lambda_max + lambda_min) / 2;
+  const mag_t delta = (lambda_max - lambda_min) / 2;
+  const mag_t sigma = theta / delta;
+  mag_t rho = 1 / sigma;
+
+  //r = b - A x
+  if (zero_initial_guess) {
+    Kokkos::deep_copy (r, b);
+  }
+  else {
+    KokkosSparse::Experimental::operator_residual (A, x, b, r);
+  }
+  KokkosBlas::mult (ATS::zero (), d, scalar_t (1 / theta), inv_diag, r);
+  if (zero_initial_guess) {
+    Kokkos::deep_copy (x, d);
+  }
+  else {
+    KokkosBlas::axpy (ATS::one (), d, x);
+  }
+  for (int k = 1; k < handle.get_degree (); ++k) {
+    const mag_t rho_new = 1 / (2 * sigma - rho);
+    KokkosSparse::Experimental::operator_residual (A, x, b, r);
+    //d = rho_new * rho * d + 2 rho_new / delta * D^{-1} r
+    KokkosBlas::mult (scalar_t (rho_new * rho), d, scalar_t (2 * rho_new / delta), inv_diag, r);
+    KokkosBlas::axpy (ATS::one (), d, x);
+    rho = rho_new;
+  }
+}
+
+}
+}
+
+#endif
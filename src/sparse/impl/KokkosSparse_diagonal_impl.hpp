@@ -0,0 +1,197 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSSPARSE_DIAGONAL_IMPL_HPP
+#define _KOKKOSSPARSE_DIAGONAL_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+#include "KokkosSparse_findRelOffset.hpp"
+#include "KokkosSparse_OrdinalTraits.hpp"
+
+namespace KokkosSparse{
+namespace Impl{
+
+template<class RowMapType, class EntriesType, class OffsetsType>
+struct Diagonal_Offsets_Functor {
+  typedef typename EntriesType::non_const_value_type lno_t;
+  typedef typename RowMapType::non_const_value_type size_type;
+
+  RowMapType row_map;
+  EntriesType entries;
+  OffsetsType offsets;
+  bool is_sorted;
+
+  Diagonal_Offsets_Functor (const RowMapType row_map_, const EntriesType entries_,
+                            const OffsetsType offsets_, const bool is_sorted_) :
+    row_map (row_map_), entries (entries_), offsets (offsets_), is_sorted (is_sorted_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const lno_t& i) const
+  {
+    const size_type row_begin = row_map(i);
+    const size_type row_length = row_map(i + 1) - row_begin;
+    if (row_length == 0) {
+      offsets(i) = KokkosSparse::OrdinalTraits<size_t>::invalid ();
+      return;
+    }
+    const size_type offset = KokkosSparse::findRelOffset<size_type>
+      (&entries(row_begin), row_length, i, 0, is_sorted);
+    offsets(i) = offset < row_length ? size_t (offset) :
+      KokkosSparse::OrdinalTraits<size_t>::invalid ();
+  }
+};
+
+//inverse and inverse square root of the magnitude of the diagonal of each row.
+//Rows without a stored or with a zero diagonal entry get 1.
+template<class RowMapType, class ValuesType, class OffsetsType, class DiagType>
+struct Diagonal_Inverse_Functor {
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef typename ValuesType::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  typedef typename ATS::mag_type mag_t;
+  typedef Kokkos::Details::ArithTraits<mag_t> ATM;
+
+  RowMapType row_map;
+  ValuesType values;
+  OffsetsType offsets;
+  DiagType inv_diag;
+  DiagType inv_sqrt_diag;
+  bool fill_inv_diag;
+  bool fill_inv_sqrt_diag;
+
+  Diagonal_Inverse_Functor (const RowMapType row_map_, const ValuesType values_, const OffsetsType offsets_,
+                            const DiagType inv_diag_, const DiagType inv_sqrt_diag_) :
+    row_map (row_map_), values (values_), offsets (offsets_),
+    inv_diag (inv_diag_), inv_sqrt_diag (inv_sqrt_diag_),
+    fill_inv_diag (inv_diag_.extent(0) > 0), fill_inv_sqrt_diag (inv_sqrt_diag_.extent(0) > 0) {}
+
+  template <typename lno_t>
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const lno_t& i) const
+  {
+    scalar_t d = ATS::zero ();
+    if (offsets(i) != KokkosSparse::OrdinalTraits<size_t>::invalid ()) {
+      d = values(row_map(i) + offsets(i));
+    }
+    const bool is_zero = d == ATS::zero ();
+    if (fill_inv_diag) {
+      inv_diag(i) = is_zero ? ATS::one () : ATS::one () / d;
+    }
+    if (fill_inv_sqrt_diag) {
+      inv_sqrt_diag(i) = is_zero ? ATS::one () : scalar_t (ATM::one () / ATM::sqrt (ATS::abs (d)));
+    }
+  }
+};
+
+//A(i, j) *= s(i) * s(j), one row per thread.
+template<class RowMapType, class EntriesType, class ValuesType, class DiagType>
+struct Symmetric_Scale_Functor {
+  typedef typename RowMapType::non_const_value_type size_type;
+
+  RowMapType row_map;
+  EntriesType entries;
+  ValuesType values;
+  DiagType scale;
+
+  Symmetric_Scale_Functor (const RowMapType row_map_, const EntriesType entries_,
+                           const ValuesType values_, const DiagType scale_) :
+    row_map (row_map_), entries (entries_), values (values_), scale (scale_) {}
+
+  template <typename lno_t>
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const lno_t& i) const
+  {
+    const typename DiagType::non_const_value_type si = scale(i);
+    const size_type row_end = row_map(i + 1);
+    for (size_type k = row_map(i); k < row_end; ++k) {
+      values(k) = si * values(k) * scale(entries(k));
+    }
+  }
+};
+
+template<class HandleType, class AMatrix>
+void diagonal_offsets_symbolic (HandleType& handle, const AMatrix& A)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type lno_t;
+  typedef typename HandleType::offsets_view_t offsets_view_t;
+
+  offsets_view_t offsets (Kokkos::ViewAllocateWithoutInitializing ("diagonal offsets"), A.numRows ());
+  Kokkos::parallel_for ("KokkosSparse::DiagonalOffsets",
+      Kokkos::RangePolicy<execution_space, lno_t> (0, A.numRows ()),
+      Diagonal_Offsets_Functor<typename AMatrix::row_map_type, typename AMatrix::index_type, offsets_view_t>
+        (A.graph.row_map, A.graph.entries, offsets, handle.get_sorted_columns ()));
+  handle.set_plan (A.graph.row_map.data (), A.numRows (), A.nnz (), offsets);
+}
+
+template<class HandleType, class AMatrix, class DiagType>
+void diagonal_inverse (const HandleType& handle, const AMatrix& A,
+                       const DiagType& inv_diag, const DiagType& inv_sqrt_diag)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type lno_t;
+
+  Kokkos::parallel_for ("KokkosSparse::DiagonalInverse",
+      Kokkos::RangePolicy<execution_space, lno_t> (0, A.numRows ()),
+      Diagonal_Inverse_Functor<typename AMatrix::row_map_type, typename AMatrix::values_type,
+                               typename HandleType::offsets_view_t, DiagType>
+        (A.graph.row_map, A.values, handle.get_diagonal_offsets (), inv_diag, inv_sqrt_diag));
+}
+
+template<class AMatrix, class DiagType>
+void symmetric_scale (const AMatrix& A, const DiagType& scale)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type lno_t;
+
+  Kokkos::parallel_for ("KokkosSparse::SymmetricDiagonalScale",
+      Kokkos::RangePolicy<execution_space, lno_t> (0, A.numRows ()),
+      Symmetric_Scale_Functor<typename AMatrix::row_map_type, typename AMatrix::index_type,
+                              typename AMatrix::values_type, DiagType>
+        (A.graph.row_map, A.graph.entries, A.values, scale));
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,162 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef _KOKKOSSPARSE_EXTRACT_IMPL_HPP
+#define _KOKKOSSPARSE_EXTRACT_IMPL_HPP
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+
+namespace KokkosSparse{
+namespace Impl{
+
+//col_map(J(k)) = k; counts the columns that appear more than once in J.
+template<class ColsView, class ColMapView>
+struct Extract_Column_Map_Functor {
+  typedef typename ColMapView::non_const_value_type ordinal_type;
+  typedef size_t value_type;
+
+  ColsView cols;
+  ColMapView col_map;
+
+  Extract_Column_Map_Functor (const ColsView cols_, const ColMapView col_map_) :
+    cols (cols_), col_map (col_map_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& k, value_type& num_duplicates) const
+  {
+    const ordinal_type old = Kokkos::atomic_compare_exchange
+      (&col_map(cols(k)), ordinal_type(-1), ordinal_type(k));
+    if (old != ordinal_type(-1)) ++num_duplicates;
+  }
+};
+
+template<class AMatrix, class RowsView, class ColMapView, class RowMapView, class EntriesView, class ValuesView>
+struct Extract_Submatrix_Functor {
+  typedef typename AMatrix::non_const_ordinal_type ordinal_type;
+  typedef typename AMatrix::non_const_size_type size_type;
+
+  struct CountTag{};
+  struct FillTag{};
+
+  AMatrix A;
+  RowsView rows;
+  ColMapView col_map;
+  RowMapView row_map;
+  EntriesView entries;
+  ValuesView values;
+
+  Extract_Submatrix_Functor (const AMatrix A_, const RowsView rows_, const ColMapView col_map_,
+                             const RowMapView row_map_, const EntriesView entries_, const ValuesView values_) :
+    A (A_), rows (rows_), col_map (col_map_), row_map (row_map_), entries (entries_), values (values_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const CountTag&, const ordinal_type& i) const
+  {
+    const ordinal_type row = rows(i);
+    const size_type row_end = A.graph.row_map(row + 1);
+    size_type count = 0;
+    for (size_type k = A.graph.row_map(row); k < row_end; ++k) {
+      if (col_map(A.graph.entries(k)) >= 0) ++count;
+    }
+    row_map(i) = count;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const FillTag&, const ordinal_type& i) const
+  {
+    const ordinal_type row = rows(i);
+    const size_type row_end = A.graph.row_map(row + 1);
+    size_type pos = row_map(i);
+    for (size_type k = A.graph.row_map(row); k < row_end; ++k) {
+      const ordinal_type col = col_map(A.graph.entries(k));
+      if (col >= 0) {
+        entries(pos) = col;
+        values(pos) = A.values(k);
+        ++pos;
+      }
+    }
+  }
+};
+
+//Fills row i % block_size of the block i / block_size of blocks; the rows
+//past the last row of A are rows of the identity.
+template<class AMatrix, class BlocksView>
+struct Extract_Diagonal_Blocks_Functor {
+  typedef typename AMatrix::non_const_ordinal_type ordinal_type;
+  typedef typename AMatrix::non_const_size_type size_type;
+  typedef typename BlocksView::non_const_value_type value_type;
+  typedef Kokkos::Details::ArithTraits<value_type> ATV;
+
+  AMatrix A;
+  BlocksView blocks;
+  const ordinal_type block_size;
+
+  Extract_Diagonal_Blocks_Functor (const AMatrix A_, const BlocksView blocks_, const ordinal_type block_size_) :
+    A (A_), blocks (blocks_), block_size (block_size_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    const ordinal_type b = i / block_size;
+    const ordinal_type li = i - b * block_size;
+    const ordinal_type first = b * block_size;
+    for (ordinal_type lj = 0; lj < block_size; ++lj) {
+      blocks(b, li, lj) = ATV::zero ();
+    }
+    if (i >= A.numRows ()) {
+      blocks(b, li, li) = ATV::one ();
+      return;
+    }
+    const size_type row_end = A.graph.row_map(i + 1);
+    for (size_type k = A.graph.row_map(i); k < row_end; ++k) {
+      const ordinal_type lj = A.graph.entries(k) - first;
+      if (lj >= 0 && lj < block_size) blocks(b, li, lj) += A.values(k);
+    }
+  }
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,204 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef _KOKKOSSPARSE_FILTER_IMPL_HPP
+#define _KOKKOSSPARSE_FILTER_IMPL_HPP
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_SimpleUtils.hpp"
+
+namespace KokkosSparse{
+
+/// \brief The criterion by which filter_matrix and filter_graph keep an
+///   off-diagonal entry a_ij of a matrix, with the threshold theta.
+///
+/// FILTER_ABSOLUTE: |a_ij| >= theta.
+/// FILTER_SYMMETRIC: |a_ij| >= theta * sqrt(|a_ii a_jj|), the strength of
+///   connection of smoothed aggregation.
+/// FILTER_CLASSICAL: -Re(a_ij) >= theta * max_{k != i} -Re(a_ik), the
+///   strength of connection of classical (Ruge-Stueben) AMG; no entry of a
+///   row without negative off-diagonal entries is kept.
+enum SparseFilterCriterion {FILTER_ABSOLUTE, FILTER_SYMMETRIC, FILTER_CLASSICAL};
+
+namespace Impl{
+
+template<class AMatrix, class ScaleView, class RowMapView, class EntriesView, class ValuesView>
+struct Filter_Functor {
+  typedef typename AMatrix::non_const_ordinal_type ordinal_type;
+  typedef typename AMatrix::non_const_size_type size_type;
+  typedef typename AMatrix::non_const_value_type value_type;
+  typedef Kokkos::Details::ArithTraits<value_type> ATV;
+  typedef typename ATV::mag_type mag_type;
+  typedef Kokkos::Details::ArithTraits<mag_type> ATM;
+
+  struct ScaleTag{};
+  struct CountTag{};
+  struct FillTag{};
+
+  AMatrix A;
+  const SparseFilterCriterion criterion;
+  const mag_type theta;
+  const bool keep_diagonal;
+  ScaleView scale;
+  RowMapView row_map;
+  EntriesView entries;
+  ValuesView values;
+  const bool fill_values;
+
+  Filter_Functor (const AMatrix A_, const SparseFilterCriterion criterion_, const mag_type theta_,
+                  const bool keep_diagonal_, const ScaleView scale_, const RowMapView row_map_,
+                  const EntriesView entries_, const ValuesView values_, const bool fill_values_) :
+    A (A_), criterion (criterion_), theta (theta_), keep_diagonal (keep_diagonal_), scale (scale_),
+    row_map (row_map_), entries (entries_), values (values_), fill_values (fill_values_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  bool keep (const ordinal_type i, const size_type k) const
+  {
+    const ordinal_type j = A.graph.entries(k);
+    if (j == i) {
+      return keep_diagonal;
+    }
+    const value_type a = A.values(k);
+    switch (criterion) {
+    case FILTER_SYMMETRIC:
+      return ATV::abs (a) >= theta * scale(i) * (j < A.numRows () ? scale(j) : ATM::zero ());
+    case FILTER_CLASSICAL:
+      return scale(i) > ATM::zero () && -ATV::real (a) >= theta * scale(i);
+    default:
+      return ATV::abs (a) >= theta;
+    }
+  }
+
+  //sqrt(|a_ii|) for FILTER_SYMMETRIC, max_{k != i} -Re(a_ik) for FILTER_CLASSICAL.
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ScaleTag&, const ordinal_type& i) const
+  {
+    const size_type row_end = A.graph.row_map(i + 1);
+    if (criterion == FILTER_SYMMETRIC) {
+      value_type diag = ATV::zero ();
+      for (size_type k = A.graph.row_map(i); k < row_end; ++k) {
+        if (A.graph.entries(k) == i) diag += A.values(k);
+      }
+      scale(i) = ATM::sqrt (ATV::abs (diag));
+    } else {
+      mag_type max_negative = ATM::zero ();
+      for (size_type k = A.graph.row_map(i); k < row_end; ++k) {
+        const mag_type negative = -ATV::real (A.values(k));
+        if (A.graph.entries(k) != i && negative > max_negative) max_negative = negative;
+      }
+      scale(i) = max_negative;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const CountTag&, const ordinal_type& i) const
+  {
+    size_type count = 0;
+    const size_type row_end = A.graph.row_map(i + 1);
+    for (size_type k = A.graph.row_map(i); k < row_end; ++k) {
+      if (keep (i, k)) ++count;
+    }
+    row_map(i) = count;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const FillTag&, const ordinal_type& i) const
+  {
+    size_type pos = row_map(i);
+    const size_type row_end = A.graph.row_map(i + 1);
+    for (size_type k = A.graph.row_map(i); k < row_end; ++k) {
+      if (keep (i, k)) {
+        entries(pos) = A.graph.entries(k);
+        if (fill_values) values(pos) = A.values(k);
+        ++pos;
+      }
+    }
+  }
+};
+
+//Counts the entries kept in each row, sums the counts and fills the kept
+//entries, and their values if fill_values.
+template<class AMatrix, class RowMapView, class EntriesView, class ValuesView>
+void filter (const AMatrix& A, const SparseFilterCriterion criterion,
+             const typename Kokkos::Details::ArithTraits<typename AMatrix::non_const_value_type>::mag_type theta,
+             const bool keep_diagonal, const bool fill_values,
+             RowMapView& row_map, EntriesView& entries, ValuesView& values)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_size_type size_type;
+  typedef typename Kokkos::Details::ArithTraits<typename AMatrix::non_const_value_type>::mag_type mag_type;
+  typedef Kokkos::View<mag_type*, typename AMatrix::device_type> scale_view_t;
+  typedef Filter_Functor<AMatrix, scale_view_t, RowMapView, EntriesView, ValuesView> functor_type;
+
+  const typename AMatrix::non_const_ordinal_type numRows = A.numRows ();
+  row_map = RowMapView ("filter row_map", numRows + 1);
+  scale_view_t scale;
+  if (criterion != FILTER_ABSOLUTE) {
+    scale = scale_view_t (Kokkos::ViewAllocateWithoutInitializing ("filter scale"), numRows);
+  }
+  functor_type func (A, criterion, theta, keep_diagonal, scale, row_map, entries, values, fill_values);
+  if (criterion != FILTER_ABSOLUTE) {
+    Kokkos::parallel_for ("KokkosSparse::filter::scale",
+        Kokkos::RangePolicy<typename functor_type::ScaleTag, execution_space> (0, numRows), func);
+  }
+  Kokkos::parallel_for ("KokkosSparse::filter::count",
+      Kokkos::RangePolicy<typename functor_type::CountTag, execution_space> (0, numRows), func);
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<RowMapView, execution_space> (numRows + 1, row_map);
+  size_type nnz = 0;
+  Kokkos::deep_copy (nnz, Kokkos::subview (row_map, numRows));
+
+  entries = EntriesView (Kokkos::ViewAllocateWithoutInitializing ("filter entries"), nnz);
+  if (fill_values) {
+    values = ValuesView (Kokkos::ViewAllocateWithoutInitializing ("filter values"), nnz);
+  }
+  func.entries = entries;
+  func.values = values;
+  Kokkos::parallel_for ("KokkosSparse::filter::fill",
+      Kokkos::RangePolicy<typename functor_type::FillTag, execution_space> (0, numRows), func);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,141 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSSPARSE_IMPL_GAUSS_SEIDEL_DIA_HPP_
+#define KOKKOSSPARSE_IMPL_GAUSS_SEIDEL_DIA_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosSparse_DiaMatrix.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+namespace Impl {
+
+// Relaxes the rows i = color + m * numColors of one color. No diagonal offset
+// but 0 is a multiple of numColors, so the rows of a color are not coupled and
+// are relaxed in parallel.
+template<class AMatrix,
+         class XVector,
+         class BVector>
+struct Dia_GS_Color_Functor {
+  typedef typename AMatrix::ordinal_type               ordinal_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename XVector::non_const_value_type       x_value_type;
+
+  AMatrix m_A;
+  XVector m_x;
+  BVector m_b;
+  const ordinal_type color;
+  const x_value_type omega;
+
+  Dia_GS_Color_Functor (const AMatrix m_A_,
+                        const XVector m_x_,
+                        const BVector m_b_,
+                        const ordinal_type color_,
+                        const x_value_type omega_) :
+    m_A (m_A_), m_x (m_x_), m_b (m_b_), color (color_), omega (omega_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& m) const
+  {
+    const ordinal_type i = color + m * m_A.numColors ();
+    const ordinal_type diag = m_A.diagonalIndex ();
+    const ordinal_type numDiagonals = m_A.numDiagonals ();
+    x_value_type sum = m_b(i);
+    for (ordinal_type k = 0; k < numDiagonals; ++k) {
+      const ordinal_type j = i + m_A.offsets(k);
+      if (k != diag && j >= 0 && j < m_A.numCols ()) {
+        sum -= m_A.values(i, k) * m_x(j);
+      }
+    }
+    m_x(i) += omega * (sum / m_A.values(i, diag) - m_x(i));
+  }
+};
+
+template<class AMatrix,
+         class XVector,
+         class BVector>
+void
+dia_gauss_seidel_apply (const AMatrix& A,
+                        const XVector& x,
+                        const BVector& b,
+                        bool init_zero_x_vector,
+                        int numIter,
+                        bool apply_forward,
+                        bool apply_backward,
+                        typename XVector::const_value_type& omega)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::ordinal_type ordinal_type;
+  typedef typename XVector::non_const_value_type x_value_type;
+  typedef Dia_GS_Color_Functor<AMatrix, XVector, BVector> functor_t;
+
+  if (init_zero_x_vector) {
+    Kokkos::deep_copy (x, Kokkos::Details::ArithTraits<x_value_type>::zero ());
+  }
+  const ordinal_type numRows = A.numRows ();
+  const ordinal_type numColors = A.numColors ();
+  for (int iter = 0; iter < numIter; ++iter) {
+    if (apply_forward) {
+      for (ordinal_type color = 0; color < numColors && color < numRows; ++color) {
+        Kokkos::parallel_for ("KokkosSparse::gauss_seidel<Dia>",
+            Kokkos::RangePolicy<execution_space> (0, (numRows - color + numColors - 1) / numColors),
+            functor_t (A, x, b, color, omega));
+      }
+    }
+    if (apply_backward) {
+      for (ordinal_type color = (numColors < numRows ? numColors : numRows) - 1; color >= 0; --color) {
+        Kokkos::parallel_for ("KokkosSparse::gauss_seidel<Dia>",
+            Kokkos::RangePolicy<execution_space> (0, (numRows - color + numColors - 1) / numColors),
+            functor_t (A, x, b, color, omega));
+      }
+    }
+  }
+}
+
+}
+}
+}
+
+#endif
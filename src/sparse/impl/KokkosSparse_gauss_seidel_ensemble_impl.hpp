@@ -0,0 +1,160 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSSPARSE_IMPL_GAUSS_SEIDEL_ENSEMBLE_HPP_
+#define KOKKOSSPARSE_IMPL_GAUSS_SEIDEL_ENSEMBLE_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosBatched_Vector.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+// Relaxes the rows color_adj(color_begin + m) of one color. The rows of a
+// color are not coupled, so they are relaxed in parallel; the ensemble
+// members of a row are relaxed together with SIMD arithmetic.
+template<class RowMap,
+         class Entries,
+         class Values,
+         class ColorAdj,
+         class XVector,
+         class BVector>
+struct Ensemble_GS_Color_Functor {
+  typedef typename Entries::non_const_value_type       ordinal_type;
+  typedef typename RowMap::non_const_value_type        size_type;
+  typedef typename XVector::non_const_value_type       x_value_type;
+
+  RowMap row_map;
+  Entries entries;
+  Values values;
+  ColorAdj color_adj;
+  XVector m_x;
+  BVector m_b;
+  const ordinal_type color_begin;
+  const x_value_type omega;
+
+  Ensemble_GS_Color_Functor (const RowMap row_map_,
+                             const Entries entries_,
+                             const Values values_,
+                             const ColorAdj color_adj_,
+                             const XVector m_x_,
+                             const BVector m_b_,
+                             const ordinal_type color_begin_,
+                             const x_value_type omega_) :
+    row_map (row_map_), entries (entries_), values (values_), color_adj (color_adj_),
+    m_x (m_x_), m_b (m_b_), color_begin (color_begin_), omega (omega_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& m) const
+  {
+    const ordinal_type i = color_adj(color_begin + m);
+    x_value_type sum = m_b(i);
+    x_value_type diag = Kokkos::Details::ArithTraits<x_value_type>::one ();
+    for (size_type k = row_map(i); k < row_map(i + 1); ++k) {
+      const ordinal_type j = entries(k);
+      if (j == i) {
+        diag = values(k);
+      } else {
+        sum -= values(k) * m_x(j);
+      }
+    }
+    m_x(i) += omega * (sum / diag - m_x(i));
+  }
+};
+
+template<class ColorXadj,
+         class ColorAdj,
+         class RowMap,
+         class Entries,
+         class Values,
+         class XVector,
+         class BVector>
+void
+ensemble_gauss_seidel_apply (const ColorXadj& color_xadj,
+                             const ColorAdj& color_adj,
+                             const typename Entries::non_const_value_type numColors,
+                             const RowMap& row_map,
+                             const Entries& entries,
+                             const Values& values,
+                             const XVector& x,
+                             const BVector& b,
+                             bool init_zero_x_vector,
+                             int numIter,
+                             bool apply_forward,
+                             bool apply_backward,
+                             typename XVector::const_value_type& omega)
+{
+  typedef typename XVector::execution_space execution_space;
+  typedef typename Entries::non_const_value_type ordinal_type;
+  typedef typename XVector::non_const_value_type x_value_type;
+  typedef Ensemble_GS_Color_Functor<RowMap, Entries, Values, ColorAdj, XVector, BVector> functor_t;
+
+  if (init_zero_x_vector) {
+    Kokkos::deep_copy (x, Kokkos::Details::ArithTraits<x_value_type>::zero ());
+  }
+  for (int iter = 0; iter < numIter; ++iter) {
+    if (apply_forward) {
+      for (ordinal_type color = 0; color < numColors; ++color) {
+        const ordinal_type begin = color_xadj(color);
+        Kokkos::parallel_for ("KokkosSparse::gauss_seidel<Ensemble>",
+            Kokkos::RangePolicy<execution_space> (0, color_xadj(color + 1) - begin),
+            functor_t (row_map, entries, values, color_adj, x, b, begin, omega));
+      }
+    }
+    if (apply_backward) {
+      for (ordinal_type c = numColors; c > 0; --c) {
+        const ordinal_type color = c - 1;
+        const ordinal_type begin = color_xadj(color);
+        Kokkos::parallel_for ("KokkosSparse::gauss_seidel<Ensemble>",
+            Kokkos::RangePolicy<execution_space> (0, color_xadj(color + 1) - begin),
+            functor_t (row_map, entries, values, color_adj, x, b, begin, omega));
+      }
+    }
+  }
+}
+
+}
+}
+
+#endif
@@ -47,6 +47,9 @@
 #include <impl/Kokkos_Timer.hpp>
 #include <Kokkos_Sort.hpp>
 #include <Kokkos_MemoryTraits.hpp>
+#include <vector>
+#include <algorithm>
+#include <sstream>
 #include "KokkosGraph_graph_color.hpp"
 #include "KokkosKernels_Uniform_Initialized_MemoryPool.hpp"
 #ifndef _KOKKOSGSIMP_HPP
@@ -104,6 +107,7 @@ public:
 
   typedef typename HandleType::scalar_temp_work_view_t scalar_temp_work_view_t;
   typedef typename HandleType::scalar_persistent_work_view_t scalar_persistent_work_view_t;
+  typedef typename HandleType::GaussSeidelHandleType::scalar_persistent_work_mv_view_t scalar_persistent_work_mv_view_t;
 
   typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
   typedef nnz_lno_t color_t;
@@ -114,9 +118,11 @@ public:
 
   struct BlockTag{};
   struct BigBlockTag{};
+  struct LongRowTag{};
 
   typedef Kokkos::TeamPolicy<BlockTag, MyExecSpace> block_team_fill_policy_t ;
   typedef Kokkos::TeamPolicy<BigBlockTag, MyExecSpace> bigblock_team_fill_policy_t ;
+  typedef Kokkos::TeamPolicy<LongRowTag, MyExecSpace> long_row_team_policy_t ;
   typedef KokkosKernels::Impl::UniformMemoryPool< MyTempMemorySpace, nnz_scalar_t> pool_memory_space;
 
 private:
@@ -139,6 +145,11 @@ public:
 
     scalar_persistent_work_view_t _permuted_diagonals;
 
+    //end of the entries of each row with a column before the row, and the
+    //first sweep from a zero x: 1 forward, 2 backward, 0 for the other sweeps.
+    row_lno_persistent_work_view_t _lower_end;
+    int _zero_x_sweep;
+
     PSGS(row_lno_persistent_work_view_t xadj_, nnz_lno_persistent_work_view_t adj_, scalar_persistent_work_view_t adj_vals_,
         scalar_persistent_work_view_t Xvector_, scalar_persistent_work_view_t Yvector_, nnz_lno_persistent_work_view_t color_adj_,
         scalar_persistent_work_view_t permuted_diagonals_):
@@ -146,13 +157,17 @@ public:
           _adj( adj_),
           _adj_vals( adj_vals_),
           _Xvector( Xvector_),
-          _Yvector( Yvector_), _permuted_diagonals(permuted_diagonals_){}
+          _Yvector( Yvector_), _permuted_diagonals(permuted_diagonals_),
+          _lower_end(), _zero_x_sweep(0){}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const nnz_lno_t &ii) const {
 
       size_type row_begin = _xadj[ii];
       size_type row_end = _xadj[ii + 1];
+      //x is still zero in the rows the sweep has not reached yet.
+      if (_zero_x_sweep == 1) row_end = _lower_end[ii];
+      else if (_zero_x_sweep == 2) row_begin = _lower_end[ii];
 
       nnz_scalar_t sum = _Yvector[ii];
 
@@ -166,6 +181,167 @@ public:
     }
   };
 
+  //in place version of PSGS: ii indexes the color sets, and the row color_adj(ii)
+  //is read from the input matrix and updated in the input vectors.
+  template <typename x_view_t, typename y_view_t>
+  struct InPlace_PSGS{
+    const_lno_row_view_t _xadj;
+    const_lno_nnz_view_t _adj;
+    const_scalar_nnz_view_t _adj_vals;
+
+    x_view_t _Xvector /*output*/;
+    y_view_t _Yvector;
+
+    nnz_lno_persistent_work_view_t _color_adj;
+    scalar_persistent_work_view_t _diagonals;
+
+    InPlace_PSGS(const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_, const_scalar_nnz_view_t adj_vals_,
+        x_view_t Xvector_, y_view_t Yvector_, nnz_lno_persistent_work_view_t color_adj_,
+        scalar_persistent_work_view_t diagonals_):
+          _xadj( xadj_),
+          _adj( adj_),
+          _adj_vals( adj_vals_),
+          _Xvector( Xvector_),
+          _Yvector( Yvector_), _color_adj(color_adj_), _diagonals(diagonals_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &ii) const {
+      const nnz_lno_t row = _color_adj[ii];
+      size_type row_begin = _xadj[row];
+      size_type row_end = _xadj[row + 1];
+
+      nnz_scalar_t sum = _Yvector[row];
+
+      for (size_type adjind = row_begin; adjind < row_end; ++adjind){
+        nnz_lno_t colIndex = _adj[adjind];
+        nnz_scalar_t val = _adj_vals[adjind];
+        sum -= val * _Xvector[colIndex];
+      }
+      nnz_scalar_t diagonalVal = _diagonals[row];
+      _Xvector[row] = (sum + diagonalVal * _Xvector[row])/ diagonalVal;
+    }
+  };
+
+  //sweeps the consecutive colors [color_begin, color_end) in one launch: a
+  //single team runs the rows of a color, and waits at a barrier before the next.
+  template <typename point_gs_t>
+  struct Fused_PSGS{
+    point_gs_t _gs;
+    nnz_lno_persistent_work_view_t _color_xadj;
+    color_t _color_begin;
+    color_t _color_end;
+    bool _is_backward;
+
+    Fused_PSGS(const point_gs_t &gs_, nnz_lno_persistent_work_view_t color_xadj_,
+        color_t color_begin_, color_t color_end_, bool is_backward_):
+          _gs(gs_), _color_xadj(color_xadj_),
+          _color_begin(color_begin_), _color_end(color_end_), _is_backward(is_backward_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const team_member_t &teamMember) const {
+      for (color_t c = 0; c < _color_end - _color_begin; ++c){
+        const color_t color = _is_backward ? _color_end - 1 - c : _color_begin + c;
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, _color_xadj(color), _color_xadj(color + 1)),
+            [&] (const nnz_lno_t &ii) {
+          _gs(ii);
+        });
+        teamMember.team_barrier();
+      }
+    }
+  };
+
+  //PSGS for multivectors: a thread per row, and each vector lane of the row
+  //updates TILE right hand sides, vector_length apart, in registers. A row of
+  //the matrix is then read once for vector_length * TILE right hand sides
+  //instead of once for each of them.
+  template <int TILE>
+  struct MV_PSGS{
+    row_lno_persistent_work_view_t _xadj;
+    nnz_lno_persistent_work_view_t _adj; // CSR storage of the graph.
+    scalar_persistent_work_view_t _adj_vals; // CSR storage of the graph.
+
+    scalar_persistent_work_mv_view_t _Xvector /*output*/;
+    scalar_persistent_work_mv_view_t _Yvector;
+
+    scalar_persistent_work_view_t _permuted_diagonals;
+    nnz_lno_t _color_set_begin;
+    nnz_lno_t _color_set_end;
+    nnz_lno_t rows_per_team;
+    nnz_lno_t vector_length;
+    nnz_lno_t num_vectors;
+
+    MV_PSGS(row_lno_persistent_work_view_t xadj_, nnz_lno_persistent_work_view_t adj_, scalar_persistent_work_view_t adj_vals_,
+        scalar_persistent_work_mv_view_t Xvector_, scalar_persistent_work_mv_view_t Yvector_,
+        scalar_persistent_work_view_t permuted_diagonals_, nnz_lno_t vector_length_):
+          _xadj( xadj_),
+          _adj( adj_),
+          _adj_vals( adj_vals_),
+          _Xvector( Xvector_),
+          _Yvector( Yvector_), _permuted_diagonals(permuted_diagonals_),
+          _color_set_begin(0), _color_set_end(0), rows_per_team(1),
+          vector_length(vector_length_), num_vectors(Xvector_.extent(1)){}
+
+    //right hand sides k0 + t * stride of row ii, t < TILE; guarded when some
+    //of them are past the last one.
+    template <bool guarded>
+    KOKKOS_INLINE_FUNCTION
+    void tile(const nnz_lno_t ii, const nnz_lno_t k0, const nnz_lno_t stride) const {
+      nnz_scalar_t sum[TILE];
+#ifdef KOKKOS_ENABLE_PRAGMA_UNROLL
+#pragma unroll
+#endif
+      for (int t = 0; t < TILE; ++t){
+        sum[t] = (!guarded || k0 + t * stride < num_vectors) ? _Yvector(ii, k0 + t * stride) : nnz_scalar_t();
+      }
+
+      size_type row_begin = _xadj[ii];
+      size_type row_end = _xadj[ii + 1];
+      for (size_type adjind = row_begin; adjind < row_end; ++adjind){
+        nnz_lno_t colIndex = _adj[adjind];
+        nnz_scalar_t val = _adj_vals[adjind];
+#ifdef KOKKOS_ENABLE_PRAGMA_IVDEP
+#pragma ivdep
+#endif
+#ifdef KOKKOS_ENABLE_PRAGMA_UNROLL
+#pragma unroll
+#endif
+        for (int t = 0; t < TILE; ++t){
+          if (!guarded || k0 + t * stride < num_vectors){
+            sum[t] -= val * _Xvector(colIndex, k0 + t * stride);
+          }
+        }
+      }
+
+      nnz_scalar_t diagonalVal = _permuted_diagonals[ii];
+#ifdef KOKKOS_ENABLE_PRAGMA_UNROLL
+#pragma unroll
+#endif
+      for (int t = 0; t < TILE; ++t){
+        const nnz_lno_t k = k0 + t * stride;
+        if (guarded && k >= num_vectors) continue;
+        _Xvector(ii, k) = (sum[t] + diagonalVal * _Xvector(ii, k))/ diagonalVal;
+      }
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const team_member_t &teamMember) const {
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, rows_per_team), [&] (const nnz_lno_t &loop) {
+        const nnz_lno_t ii = _color_set_begin + teamMember.league_rank() * rows_per_team + loop;
+        if (ii >= _color_set_end) return;
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, vector_length), [&] (const nnz_lno_t &lane) {
+          const nnz_lno_t pass = vector_length * TILE;
+          nnz_lno_t kk = 0;
+          for (; kk + pass <= num_vectors; kk += pass){
+            tile<false>(ii, kk + lane, vector_length);
+          }
+          if (kk < num_vectors){
+            tile<true>(ii, kk + lane, vector_length);
+          }
+        });
+      });
+    }
+  };
+
   struct Team_PSGS{
 
     row_lno_persistent_work_view_t _xadj;
@@ -188,6 +364,9 @@ public:
 	const pool_memory_space pool;
 	const nnz_lno_t num_max_vals_in_l1, num_max_vals_in_l2;
     bool is_backward;
+    //as in PSGS, for the point sweeps.
+    row_lno_persistent_work_view_t _lower_end;
+    int _zero_x_sweep;
 
 
     Team_PSGS(row_lno_persistent_work_view_t xadj_, nnz_lno_persistent_work_view_t adj_, scalar_persistent_work_view_t adj_vals_,
@@ -216,7 +395,8 @@ public:
 		  suggested_team_size(suggested_team_size_),
 		  thread_shared_memory_scalar_size(((shared_memory_size / suggested_team_size / 8) * 8 ) / sizeof(nnz_scalar_t) ),
 		  vector_size(vector_size_), pool (pms), num_max_vals_in_l1(_num_max_vals_in_l1),
-		  num_max_vals_in_l2(_num_max_vals_in_l2), is_backward(false){}
+		  num_max_vals_in_l2(_num_max_vals_in_l2), is_backward(false),
+		  _lower_end(), _zero_x_sweep(0){}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const team_member_t & teamMember) const {
@@ -229,6 +409,8 @@ public:
 
       size_type row_begin = _xadj[ii];
       size_type row_end = _xadj[ii + 1];
+      if (_zero_x_sweep == 1) row_end = _lower_end[ii];
+      else if (_zero_x_sweep == 2) row_begin = _lower_end[ii];
 
       nnz_scalar_t product = 0 ;
       Kokkos::parallel_reduce(
@@ -247,6 +429,44 @@ public:
       });
      }
 
+    //a whole team per row: the threads take chunks of vector_size nonzeros,
+    //and the vector lanes reduce each chunk.
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const LongRowTag&, const team_member_t & teamMember) const {
+
+      nnz_lno_t ii = teamMember.league_rank() + _color_set_begin;
+      if (ii >= _color_set_end)
+        return;
+
+      const size_type row_begin = _zero_x_sweep == 2 ? _lower_end[ii] : _xadj[ii];
+      const size_type row_end = _zero_x_sweep == 1 ? _lower_end[ii] : _xadj[ii + 1];
+      const size_type chunk_size = vector_size;
+      const size_type num_chunks = (row_end - row_begin + chunk_size - 1) / chunk_size;
+
+      nnz_scalar_t product = 0 ;
+      Kokkos::parallel_reduce(
+          Kokkos::TeamThreadRange(teamMember, num_chunks),
+          [&] (size_type chunk, nnz_scalar_t & teamValueToUpdate) {
+        const size_type chunk_begin = row_begin + chunk * chunk_size;
+        const size_type chunk_end = KOKKOSKERNELS_MACRO_MIN(chunk_begin + chunk_size, row_end);
+        nnz_scalar_t chunk_product = 0;
+        Kokkos::parallel_reduce(
+            Kokkos::ThreadVectorRange(teamMember, chunk_end - chunk_begin),
+            [&] (size_type i, nnz_scalar_t & valueToUpdate) {
+          size_type adjind = i + chunk_begin;
+          valueToUpdate += _adj_vals[adjind] * _Xvector[_adj[adjind]];
+        },
+        chunk_product);
+        teamValueToUpdate += chunk_product;
+      },
+      product);
+
+      Kokkos::single(Kokkos::PerTeam(teamMember),[=] () {
+        nnz_scalar_t diagonalVal = _permuted_diagonals[ii];
+        _Xvector[ii] = (_Yvector[ii] - product + diagonalVal * _Xvector[ii])/ diagonalVal;
+      });
+     }
+
     KOKKOS_INLINE_FUNCTION
     void operator()(const BigBlockTag&, const team_member_t & teamMember) const {
 
@@ -556,6 +776,76 @@ public:
 
 
 
+  //sorts the rows of each color set by their position in the row order of the
+  //handle, if it has one, so that consecutive rows of a color are close in the graph.
+  void sort_color_sets_by_row_order(color_t numColors,
+      nnz_lno_persistent_work_host_view_t h_color_xadj,
+      nnz_lno_persistent_work_view_t color_adj){
+    typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    nnz_lno_persistent_work_view_t row_order = gsHandler->get_row_order();
+    if (row_order.extent(0) == 0) return;
+    if (nnz_lno_t(row_order.extent(0)) != num_rows){
+      std::ostringstream os;
+      os << "KokkosSparse::gauss_seidel_symbolic: Dimensions do not match: "
+         << "row_order: " << row_order.extent(0) << ", num_rows: " << num_rows;
+      Kokkos::Impl::throw_runtime_exception(os.str());
+    }
+    nnz_lno_persistent_work_host_view_t h_row_order = Kokkos::create_mirror_view (row_order);
+    Kokkos::deep_copy (h_row_order, row_order);
+    nnz_lno_persistent_work_host_view_t h_color_adj = Kokkos::create_mirror_view (color_adj);
+    Kokkos::deep_copy (h_color_adj, color_adj);
+
+    std::vector<nnz_lno_t> position(num_rows);
+    for (nnz_lno_t k = 0; k < num_rows; ++k){
+      position[h_row_order(k)] = k;
+    }
+    for (color_t i = 0; i < numColors; ++i){
+      std::sort(h_color_adj.data() + h_color_xadj(i), h_color_adj.data() + h_color_xadj(i + 1),
+          [&position] (const nnz_lno_t a, const nnz_lno_t b) {return position[a] < position[b];});
+    }
+    Kokkos::deep_copy (color_adj, h_color_adj);
+    MyExecSpace::fence();
+  }
+
+  //moves the rows longer than the long row threshold to the beginning of each
+  //color set, keeping the order within the long and the short rows, and stores
+  //the number of long rows of each color in the handle.
+  void partition_long_rows(color_t numColors,
+      nnz_lno_persistent_work_host_view_t h_color_xadj,
+      nnz_lno_persistent_work_view_t color_adj){
+    typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    const nnz_lno_t long_row_threshold = gsHandler->get_long_row_threshold();
+    if (long_row_threshold <= 0 || gsHandler->get_block_size() != 1){
+      gsHandler->set_color_set_long_rows(nnz_lno_persistent_work_host_view_t());
+      return;
+    }
+    Kokkos::View<row_lno_t *, typename const_lno_row_view_t::array_layout, Kokkos::HostSpace>
+      h_xadj (Kokkos::ViewAllocateWithoutInitializing("h_xadj"), num_rows + 1);
+    Kokkos::deep_copy (h_xadj, this->row_map);
+    nnz_lno_persistent_work_host_view_t h_color_adj = Kokkos::create_mirror_view (color_adj);
+    Kokkos::deep_copy (h_color_adj, color_adj);
+    nnz_lno_persistent_work_host_view_t h_long_rows ("color_set_long_rows", numColors);
+
+    std::vector<nnz_lno_t> short_rows;
+    for (color_t i = 0; i < numColors; ++i){
+      nnz_lno_t num_long = h_color_xadj(i);
+      short_rows.clear();
+      for (nnz_lno_t ii = h_color_xadj(i); ii < h_color_xadj(i + 1); ++ii){
+        const nnz_lno_t row = h_color_adj(ii);
+        if (nnz_lno_t(h_xadj(row + 1) - h_xadj(row)) > long_row_threshold)
+          h_color_adj(num_long++) = row;
+        else
+          short_rows.push_back(row);
+      }
+      h_long_rows(i) = num_long - h_color_xadj(i);
+      for (size_t k = 0; k < short_rows.size(); ++k)
+        h_color_adj(num_long + k) = short_rows[k];
+    }
+    Kokkos::deep_copy (color_adj, h_color_adj);
+    MyExecSpace::fence();
+    gsHandler->set_color_set_long_rows(h_long_rows);
+  }
+
   void initialize_symbolic(){
     typename HandleType::GraphColoringHandleType *gchandle = this->handle->get_graph_coloring_handle();
 
@@ -617,65 +907,60 @@ public:
 	h_colors(i) = i + 1;
     }
     Kokkos::deep_copy(colors, h_colors);
+    gchandle->set_vertex_colors(colors);
 #endif
-    nnz_lno_persistent_work_view_t color_xadj;
-
-    nnz_lno_persistent_work_view_t color_adj;
-
 
 #ifdef KOKKOSSPARSE_IMPL_TIME_REVERSE
     timer.reset();
 #endif
 
-    KokkosKernels::Impl::create_reverse_map
-      <typename HandleType::GraphColoringHandleType::color_view_t,
-        nnz_lno_persistent_work_view_t, MyExecSpace>
-        (num_rows, numColors, colors, color_xadj, color_adj);
-    MyExecSpace::fence();
-
-
-#ifdef KOKKOSSPARSE_IMPL_TIME_REVERSE
-    std::cout << "CREATE_REVERSE_MAP:" << timer.seconds() << std::endl;
-    timer.reset();
-#endif
-
-    nnz_lno_persistent_work_host_view_t  h_color_xadj = Kokkos::create_mirror_view (color_xadj);
-    Kokkos::deep_copy (h_color_xadj , color_xadj);
+    //the color sets of the coloring handle are already grouped by color and
+    //sorted within a color, they are shared with the other users of the
+    //coloring, so they are copied if the row order or the long rows reorder them.
+    nnz_lno_persistent_work_view_t color_xadj = gchandle->get_color_set_xadj();
+    nnz_lno_persistent_work_host_view_t h_color_xadj = gchandle->get_host_color_set_xadj();
+    nnz_lno_persistent_work_view_t color_adj = gchandle->get_color_set_adj();
+    {
+      typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+      if (gsHandler->get_row_order().extent(0) > 0 ||
+          (gsHandler->get_long_row_threshold() > 0 && gsHandler->get_block_size() == 1)){
+        nnz_lno_persistent_work_view_t color_adj_copy
+          (Kokkos::ViewAllocateWithoutInitializing("color_adj"), color_adj.extent(0));
+        Kokkos::deep_copy (color_adj_copy, color_adj);
+        color_adj = color_adj_copy;
+      }
+    }
     MyExecSpace::fence();
 
-
 #ifdef KOKKOSSPARSE_IMPL_TIME_REVERSE
-    std::cout << "DEEP_COPY:" << timer.seconds() << std::endl;
+    std::cout << "COLOR_SETS:" << timer.seconds() << std::endl;
     timer.reset();
 #endif
 
+    this->sort_color_sets_by_row_order(numColors, h_color_xadj, color_adj);
+    this->partition_long_rows(numColors, h_color_xadj, color_adj);
 
-#if defined( KOKKOS_ENABLE_CUDA )
-    if (Kokkos::Impl::is_same<Kokkos::Cuda, MyExecSpace >::value){
-      for (nnz_lno_t i = 0; i < numColors; ++i){
-        nnz_lno_t color_index_begin = h_color_xadj(i);
-        nnz_lno_t color_index_end = h_color_xadj(i + 1);
-
-        if (color_index_begin + 1 >= color_index_end ) continue;
-        auto colorsubset =
-            subview(color_adj, Kokkos::pair<row_lno_t, row_lno_t> (color_index_begin, color_index_end));
-        MyExecSpace::fence();
-        Kokkos::sort (colorsubset);
-        //TODO: MD 08/2017: If I remove the below fence, code fails on cuda.
-        //I do not see any reason yet it to fail.
-        MyExecSpace::fence();
+    this->handle->get_gs_handle()->fit_into_memory_budget(num_rows, num_cols, this->entries.extent(0));
+    if (this->handle->get_gs_handle()->is_in_place() &&
+        this->handle->get_gs_handle()->get_block_size() == 1){
+      //in place mode: the color sets are the only permutation kept,
+      //the sweeps read the input matrix and vectors through them.
+      typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+      gsHandler->set_color_set_xadj(h_color_xadj);
+      gsHandler->set_device_color_set_xadj(color_xadj);
+      gsHandler->set_color_set_adj(color_adj);
+      gsHandler->set_num_colors(numColors);
+      gsHandler->set_new_xadj(row_lno_persistent_work_view_t());
+      gsHandler->set_new_adj(nnz_lno_persistent_work_view_t());
+      gsHandler->set_old_to_new_map(nnz_lno_persistent_work_view_t());
+      gsHandler->set_permuted_lower_end(row_lno_persistent_work_view_t());
+      if (gsHandler->is_owner_of_coloring()){
+        this->handle->destroy_graph_coloring_handle();
+        gsHandler->set_owner_of_coloring(false);
       }
+      gsHandler->set_call_symbolic(true);
+      return;
     }
-#endif
-
-
-
-    MyExecSpace::fence();
-#ifdef KOKKOSSPARSE_IMPL_TIME_REVERSE
-    std::cout << "SORT_TIME:" << timer.seconds() << std::endl;
-    timer.reset();
-    //std::cout << "sort" << std::endl;
-#endif
 
     row_lno_persistent_work_view_t permuted_xadj ("new xadj", num_rows + 1);
     nnz_lno_persistent_work_view_t old_to_new_map ("old_to_new_index_", num_rows );
@@ -708,6 +993,13 @@ public:
 #endif
 
 
+    //with point rows, the entries of each permuted row with a column before the row are put
+    //first, so that the first sweep from a zero initial vector reads only those.
+    row_lno_persistent_work_view_t permuted_lower_end;
+    if (this->handle->get_gs_handle()->get_block_size() == 1){
+      permuted_lower_end = row_lno_persistent_work_view_t(
+          Kokkos::ViewAllocateWithoutInitializing("permuted_lower_end"), num_rows);
+    }
     Kokkos::parallel_for( "KokkosSparse::GaussSeidel::fill_matrix_symbolic",my_exec_space(0,num_rows),
         fill_matrix_symbolic(
             num_rows,
@@ -718,7 +1010,8 @@ public:
             permuted_xadj,
             permuted_adj,
             //newvals_,
-            old_to_new_map));
+            old_to_new_map,
+            permuted_lower_end));
     MyExecSpace::fence();
 
 #ifdef KOKKOSSPARSE_IMPL_TIME_REVERSE
@@ -835,12 +1128,14 @@ public:
 
 
     gsHandler->set_color_set_xadj(h_color_xadj);
+    gsHandler->set_device_color_set_xadj(color_xadj);
     gsHandler->set_color_set_adj(color_adj);
     gsHandler->set_num_colors(numColors);
     gsHandler->set_new_xadj(permuted_xadj);
     gsHandler->set_new_adj(permuted_adj);
     //gsHandler->set_new_adj_val(newvals_);
     gsHandler->set_old_to_new_map(old_to_new_map);
+    gsHandler->set_permuted_lower_end(permuted_lower_end);
     if (this->handle->get_gs_handle()->is_owner_of_coloring()){
       this->handle->destroy_graph_coloring_handle();
       this->handle->get_gs_handle()->set_owner_of_coloring(false);
@@ -886,6 +1181,9 @@ public:
     nnz_lno_persistent_work_view_t newadj;
     //value_persistent_work_array_type newadjvals;
     nnz_lno_persistent_work_view_t old_to_new_index;
+    //if not empty, the entries of each row with a column before the row are
+    //put first, in their order, and newlowerend is the end of them.
+    row_lno_persistent_work_view_t newlowerend;
     fill_matrix_symbolic(
         nnz_lno_t num_rows_,
         nnz_lno_persistent_work_view_t color_adj_,
@@ -895,11 +1193,12 @@ public:
         row_lno_persistent_work_view_t newxadj_,
         nnz_lno_persistent_work_view_t newadj_,
         //value_persistent_work_array_type newadjvals_,
-        nnz_lno_persistent_work_view_t old_to_new_index_):
+        nnz_lno_persistent_work_view_t old_to_new_index_,
+        row_lno_persistent_work_view_t newlowerend_ = row_lno_persistent_work_view_t()):
           num_rows(num_rows_),
           color_adj(color_adj_), oldxadj(oldxadj_), oldadj(oldadj_), //oldadjvals(oldadjvals_),
           newxadj(newxadj_), newadj(newadj_), //newadjvals(newadjvals_),
-          old_to_new_index(old_to_new_index_){}
+          old_to_new_index(old_to_new_index_), newlowerend(newlowerend_){}
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const nnz_lno_t &i) const{
@@ -907,6 +1206,21 @@ public:
       size_type xadj_begin = newxadj(i);
 
       size_type old_xadj_end = oldxadj[index + 1];
+      if (newlowerend.extent(0) > 0){
+        size_type lower_end = xadj_begin;
+        for (size_type j = oldxadj[index]; j < old_xadj_end; ++j){
+          nnz_lno_t neighbor = oldadj[j];
+          if(neighbor < num_rows && old_to_new_index[neighbor] < i) ++lower_end;
+        }
+        newlowerend(i) = lower_end;
+        size_type upper_begin = lower_end;
+        for (size_type j = oldxadj[index]; j < old_xadj_end; ++j){
+          nnz_lno_t neighbor = oldadj[j];
+          if(neighbor < num_rows) neighbor = old_to_new_index[neighbor];
+          newadj[neighbor < i ? xadj_begin++ : upper_begin++] = neighbor;
+        }
+        return;
+      }
       for (size_type j = oldxadj[index]; j < old_xadj_end; ++j){
         nnz_lno_t neighbor = oldadj[j];
         if(neighbor < num_rows) neighbor = old_to_new_index[neighbor];
@@ -927,6 +1241,11 @@ public:
     nnz_lno_t num_total_rows;
     nnz_lno_t rows_per_team;
     nnz_lno_t block_matrix_size;
+
+    //to reproduce the lower entries first order of fill_matrix_symbolic.
+    const_lno_nnz_view_t oldadj;
+    nnz_lno_persistent_work_view_t old_to_new_index;
+    row_lno_persistent_work_view_t newlowerend;
     fill_matrix_numeric(
         nnz_lno_persistent_work_view_t color_adj_,
         const_lno_row_view_t oldxadj_,
@@ -934,13 +1253,34 @@ public:
         row_lno_persistent_work_view_t newxadj_,
         scalar_persistent_work_view_t newadjvals_,
 		nnz_lno_t num_total_rows_,
-		nnz_lno_t rows_per_team_ , nnz_lno_t block_matrix_size_):
+		nnz_lno_t rows_per_team_ , nnz_lno_t block_matrix_size_,
+        const_lno_nnz_view_t oldadj_ = const_lno_nnz_view_t(),
+        nnz_lno_persistent_work_view_t old_to_new_index_ = nnz_lno_persistent_work_view_t(),
+        row_lno_persistent_work_view_t newlowerend_ = row_lno_persistent_work_view_t()):
           color_adj(color_adj_), oldxadj(oldxadj_),  oldadjvals(oldadjvals_),
           newxadj(newxadj_), newadjvals(newadjvals_),
-		  num_total_rows(num_total_rows_), rows_per_team(rows_per_team_), block_matrix_size(block_matrix_size_){}
+		  num_total_rows(num_total_rows_), rows_per_team(rows_per_team_), block_matrix_size(block_matrix_size_),
+          oldadj(oldadj_), old_to_new_index(old_to_new_index_), newlowerend(newlowerend_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void fill_lower_first(const nnz_lno_t &i) const{
+      nnz_lno_t index = color_adj(i);
+      size_type xadj_begin = newxadj(i);
+      size_type upper_begin = newlowerend(i);
+      size_type old_xadj_end = oldxadj[index + 1];
+      for (size_type j = oldxadj[index]; j < old_xadj_end; ++j){
+        nnz_lno_t neighbor = oldadj[j];
+        if(neighbor < num_total_rows) neighbor = old_to_new_index[neighbor];
+        newadjvals[neighbor < i ? xadj_begin++ : upper_begin++] = oldadjvals[j];
+      }
+    }
 
     KOKKOS_INLINE_FUNCTION
     void operator()(const nnz_lno_t &i) const{
+      if (newlowerend.extent(0) > 0){
+        fill_lower_first(i);
+        return;
+      }
       nnz_lno_t index = color_adj(i);
       size_type xadj_begin = newxadj(i) * block_matrix_size;
       size_type old_xadj_end = oldxadj[index + 1] * block_matrix_size;
@@ -956,6 +1296,12 @@ public:
     	const nnz_lno_t i_begin = team.league_rank() * rows_per_team;
     	const nnz_lno_t i_end = i_begin + rows_per_team <= num_total_rows ? i_begin + rows_per_team : num_total_rows;
     	Kokkos::parallel_for(Kokkos::TeamThreadRange(team,i_begin,i_end), [&] (const nnz_lno_t& i) {
+    		if (newlowerend.extent(0) > 0){
+    			Kokkos::single(Kokkos::PerThread(team),[&] () {
+    				fill_lower_first(i);
+    			});
+    			return;
+    		}
     		nnz_lno_t index = color_adj(i);
 			size_type xadj_begin = newxadj(i) * block_matrix_size;
 
@@ -1045,11 +1391,51 @@ public:
     }
   };
 
+  //diagonal of the input matrix in the original row order, for the in place mode.
+  struct Get_InPlace_Diagonals{
+    const_lno_row_view_t _xadj;
+    const_lno_nnz_view_t _adj;
+    const_scalar_nnz_view_t _adj_vals;
+    scalar_persistent_work_view_t _diagonals;
+
+    Get_InPlace_Diagonals(
+        const_lno_row_view_t xadj_,
+        const_lno_nnz_view_t adj_,
+        const_scalar_nnz_view_t adj_vals_,
+        scalar_persistent_work_view_t diagonals_):
+          _xadj( xadj_), _adj( adj_), _adj_vals( adj_vals_), _diagonals(diagonals_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t & row_id) const {
+      nnz_scalar_t diagonal = Kokkos::Details::ArithTraits<nnz_scalar_t>::zero();
+      for (size_type adjind = _xadj[row_id]; adjind < _xadj[row_id + 1]; ++adjind){
+        if (_adj[adjind] == row_id){
+          diagonal = _adj_vals[adjind];
+          break;
+        }
+      }
+      _diagonals[row_id] = diagonal;
+    }
+  };
+
   void initialize_numeric(){
 
     if (this->handle->get_gs_handle()->is_symbolic_called() == false){
       this->initialize_symbolic();
     }
+    if (this->handle->get_gs_handle()->is_in_place() &&
+        this->handle->get_gs_handle()->get_block_size() == 1){
+      //in place mode: only the diagonal is kept, the values are read from the input matrix.
+      scalar_persistent_work_view_t diagonals (Kokkos::ViewAllocateWithoutInitializing("permuted_diagonals"), num_rows);
+      Kokkos::parallel_for("KokkosSparse::GaussSeidel::get_in_place_diagonals",
+          my_exec_space(0,num_rows),
+          Get_InPlace_Diagonals(this->row_map, this->entries, this->values, diagonals));
+      MyExecSpace::fence();
+      this->handle->get_gs_handle()->set_new_adj_val(scalar_persistent_work_view_t());
+      this->handle->get_gs_handle()->set_permuted_diagonals(diagonals);
+      this->handle->get_gs_handle()->set_call_numeric(true);
+      return;
+    }
     //else
 #ifdef KOKKOSSPARSE_IMPL_TIME_REVERSE
     Kokkos::Impl::Timer timer;
@@ -1072,10 +1458,11 @@ public:
       nnz_lno_persistent_work_view_t newadj_ = gsHandler->get_new_adj();
 
       nnz_lno_persistent_work_view_t color_adj = gsHandler->get_color_adj();
+      row_lno_persistent_work_view_t permuted_lower_end = gsHandler->get_permuted_lower_end();
       scalar_persistent_work_view_t permuted_adj_vals (Kokkos::ViewAllocateWithoutInitializing("newvals_"), nnz );
 
 
-      int suggested_vector_size = this->handle->get_suggested_vector_size(num_rows, nnz);
+      int suggested_vector_size = this->handle->get_suggested_vector_size(num_rows, nnz, newxadj_);
       int suggested_team_size = this->handle->get_suggested_team_size(suggested_vector_size);
       nnz_lno_t rows_per_team = this->handle->get_team_work_size(suggested_team_size,MyExecSpace::concurrency(), num_rows);
 
@@ -1110,7 +1497,10 @@ public:
 						  //,old_to_new_map
 						  this->num_rows,
 						  rows_per_team,
-						  block_matrix_size
+						  block_matrix_size,
+						  adj,
+						  old_to_new_map,
+						  permuted_lower_end
     			  ));
       }
       else {
@@ -1126,7 +1516,10 @@ public:
 						  //,old_to_new_map
 						  this->num_rows,
 						  rows_per_team,
-						  block_matrix_size
+						  block_matrix_size,
+						  adj,
+						  old_to_new_map,
+						  permuted_lower_end
     			  ));
       }
       MyExecSpace::fence();
@@ -1211,7 +1604,6 @@ public:
           Permuted_Yvector
       );
     }
-    MyExecSpace::fence();
     if(init_zero_x_vector){
       KokkosKernels::Impl::zero_vector<scalar_persistent_work_view_t, MyExecSpace>(num_cols * block_size, Permuted_Xvector);
     }
@@ -1224,7 +1616,6 @@ public:
           Permuted_Xvector
           );
     }
-    MyExecSpace::fence();
 
 
 
@@ -1254,7 +1645,7 @@ public:
     nnz_lno_t brows = permuted_xadj.extent(0) - 1;
     size_type bnnz =  permuted_adj_vals.extent(0);
 
-    int suggested_vector_size = this->handle->get_suggested_vector_size(brows, bnnz);
+    int suggested_vector_size = this->handle->get_suggested_vector_size(brows, bnnz, permuted_xadj);
     int suggested_team_size = this->handle->get_suggested_team_size(suggested_vector_size);
     nnz_lno_t team_row_chunk_size = this->handle->get_team_work_size(suggested_team_size,MyExecSpace::concurrency(), brows);
 
@@ -1300,7 +1691,6 @@ public:
         Permuted_Xvector,
         x_lhs_output_vec
         );
-    MyExecSpace::fence();
 
 #if KOKKOSSPARSE_IMPL_PRINTDEBUG
     std::cout << "After X:";
@@ -1325,6 +1715,11 @@ public:
       bool update_y_vector = true){
 
     typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    if (gsHandler->is_in_place()){
+      this->in_place_apply(x_lhs_output_vec, y_rhs_input_vec,
+          init_zero_x_vector, numIter, apply_forward, apply_backward);
+      return;
+    }
     scalar_persistent_work_view_t Permuted_Yvector = gsHandler->get_permuted_y_vector();
     scalar_persistent_work_view_t Permuted_Xvector = gsHandler->get_permuted_x_vector();
 
@@ -1349,7 +1744,6 @@ public:
           Permuted_Yvector
       );
     }
-    MyExecSpace::fence();
     if(init_zero_x_vector){
       KokkosKernels::Impl::zero_vector<scalar_persistent_work_view_t, MyExecSpace>(num_cols, Permuted_Xvector);
     }
@@ -1362,7 +1756,6 @@ public:
           Permuted_Xvector
           );
     }
-    MyExecSpace::fence();
 
     row_lno_persistent_work_view_t permuted_xadj = gsHandler->get_new_xadj();
     nnz_lno_persistent_work_view_t permuted_adj = gsHandler->get_new_adj();
@@ -1370,6 +1763,8 @@ public:
     scalar_persistent_work_view_t permuted_diagonals = gsHandler->get_permuted_diagonals();
 
     nnz_lno_persistent_work_host_view_t h_color_xadj = gsHandler->get_color_xadj();
+    row_lno_persistent_work_view_t permuted_lower_end = gsHandler->get_permuted_lower_end();
+    const bool zero_x_first_sweep = init_zero_x_vector && permuted_lower_end.extent(0) > 0;
 
 
 
@@ -1377,6 +1772,10 @@ public:
       PSGS gs(permuted_xadj, permuted_adj, permuted_adj_vals,
           Permuted_Xvector, Permuted_Yvector, color_adj, permuted_diagonals);
 
+      if (zero_x_first_sweep && numIter > 0){
+        this->ZeroXDoPSGS(gs, permuted_lower_end, numColors, h_color_xadj, apply_forward, apply_backward);
+        --numIter;
+      }
       this->IterativePSGS(
           gs,
           numColors,
@@ -1392,6 +1791,10 @@ public:
       Team_PSGS gs(permuted_xadj, permuted_adj, permuted_adj_vals,
           Permuted_Xvector, Permuted_Yvector,0,0, permuted_diagonals, m_space);
 
+      if (zero_x_first_sweep && numIter > 0){
+        this->ZeroXDoPSGS(gs, permuted_lower_end, numColors, h_color_xadj, apply_forward, apply_backward);
+        --numIter;
+      }
       this->IterativePSGS(
           gs,
           numColors,
@@ -1411,7 +1814,6 @@ public:
         Permuted_Xvector,
         x_lhs_output_vec
         );
-    MyExecSpace::fence();
 #if KOKKOSSPARSE_IMPL_PRINTDEBUG
     std::cout << "--point After X:";
     KokkosKernels::Impl::print_1Dview(Permuted_Xvector);
@@ -1421,6 +1823,35 @@ public:
 
   }
 
+  //sweeps the input matrix and vectors in place, through the color sets.
+  template <typename x_value_array_type, typename y_value_array_type>
+  void in_place_apply(
+      x_value_array_type x_lhs_output_vec,
+      y_value_array_type y_rhs_input_vec,
+      bool init_zero_x_vector,
+      int numIter,
+      bool apply_forward,
+      bool apply_backward){
+
+    typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    if(init_zero_x_vector){
+      KokkosKernels::Impl::zero_vector<x_value_array_type, MyExecSpace>(num_cols, x_lhs_output_vec);
+    }
+
+    InPlace_PSGS<x_value_array_type, y_value_array_type> gs(
+        this->row_map, this->entries, this->values,
+        x_lhs_output_vec, y_rhs_input_vec,
+        gsHandler->get_color_adj(), gsHandler->get_permuted_diagonals());
+
+    this->IterativePSGS(
+        gs,
+        gsHandler->get_num_colors(),
+        gsHandler->get_color_xadj(),
+        numIter,
+        apply_forward,
+        apply_backward);
+  }
+
   template <typename x_value_array_type, typename y_value_array_type>
   void apply(
       x_value_array_type x_lhs_output_vec,
@@ -1450,6 +1881,164 @@ public:
     }
   }
 
+  //point apply for x and y with several columns, sweeping all the right hand
+  //sides of a row together with MV_PSGS. the multivectors are permuted into
+  //the row major multivectors of the handle.
+  template <typename x_value_array_type, typename y_value_array_type>
+  void mv_apply(
+      x_value_array_type x_lhs_output_vec,
+      y_value_array_type y_rhs_input_vec,
+      bool init_zero_x_vector = false,
+      int numIter = 1,
+      bool apply_forward = true,
+      bool apply_backward = true,
+      bool update_y_vector = true){
+    if (this->handle->get_gs_handle()->is_numeric_called() == false){
+      this->initialize_numeric();
+    }
+    typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    const nnz_lno_t num_vectors = x_lhs_output_vec.extent(1);
+    gsHandler->allocate_x_y_multivectors(num_rows, num_cols, num_vectors);
+    scalar_persistent_work_mv_view_t Permuted_Yvector = gsHandler->get_permuted_y_multivector();
+    scalar_persistent_work_mv_view_t Permuted_Xvector = gsHandler->get_permuted_x_multivector();
+    nnz_lno_persistent_work_view_t old_to_new_map = gsHandler->get_old_to_new_map();
+    nnz_lno_persistent_work_view_t color_adj = gsHandler->get_color_adj();
+
+    if (update_y_vector){
+      KokkosKernels::Impl::permute_multivector
+        <y_value_array_type, scalar_persistent_work_mv_view_t, nnz_lno_persistent_work_view_t, MyExecSpace>(
+          num_rows,
+          old_to_new_map,
+          y_rhs_input_vec,
+          Permuted_Yvector
+      );
+    }
+    if(init_zero_x_vector){
+      KokkosKernels::Impl::zero_vector<scalar_persistent_work_mv_view_t, MyExecSpace>(num_cols, Permuted_Xvector);
+    }
+    else{
+      KokkosKernels::Impl::permute_multivector
+        <x_value_array_type, scalar_persistent_work_mv_view_t, nnz_lno_persistent_work_view_t, MyExecSpace>(
+          num_cols,
+          old_to_new_map,
+          x_lhs_output_vec,
+          Permuted_Xvector
+          );
+    }
+
+#if defined( KOKKOS_ENABLE_CUDA )
+    if (Kokkos::Impl::is_same<Kokkos::Cuda, MyExecSpace >::value){
+      //consecutive lanes take consecutive right hand sides, two each.
+      nnz_lno_t vector_length = 1;
+      while (vector_length < 32 && 2 * vector_length < num_vectors) vector_length *= 2;
+      this->mv_sweeps<2>(Permuted_Xvector, Permuted_Yvector, vector_length, numIter, apply_forward, apply_backward);
+    }
+    else
+#endif
+    if (num_vectors <= 8){
+      this->mv_sweeps<8>(Permuted_Xvector, Permuted_Yvector, 1, numIter, apply_forward, apply_backward);
+    }
+    else {
+      this->mv_sweeps<16>(Permuted_Xvector, Permuted_Yvector, 1, numIter, apply_forward, apply_backward);
+    }
+
+    KokkosKernels::Impl::permute_multivector
+    <scalar_persistent_work_mv_view_t, x_value_array_type, nnz_lno_persistent_work_view_t, MyExecSpace>(
+        num_cols,
+        color_adj,
+        Permuted_Xvector,
+        x_lhs_output_vec
+        );
+  }
+
+  template <int TILE>
+  void mv_sweeps(
+      scalar_persistent_work_mv_view_t Permuted_Xvector,
+      scalar_persistent_work_mv_view_t Permuted_Yvector,
+      nnz_lno_t vector_length,
+      int numIter,
+      bool apply_forward,
+      bool apply_backward){
+    typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    color_t numColors = gsHandler->get_num_colors();
+    nnz_lno_persistent_work_host_view_t h_color_xadj = gsHandler->get_color_xadj();
+
+    MV_PSGS<TILE> gs(gsHandler->get_new_xadj(), gsHandler->get_new_adj(), gsHandler->get_new_adj_val(),
+        Permuted_Xvector, Permuted_Yvector, gsHandler->get_permuted_diagonals(), vector_length);
+    const int team_size = team_policy_t::team_size_recommended(gs, vector_length);
+    gs.rows_per_team = team_size;
+
+    for (int iter = 0; iter < numIter; ++iter){
+      for (int direction = 0; direction < 2; ++direction){
+        const bool is_backward = direction == 1;
+        if (is_backward ? !apply_backward : !apply_forward) continue;
+        for (color_t c = 0; c < numColors; ++c){
+          const color_t color = is_backward ? numColors - 1 - c : c;
+          gs._color_set_begin = h_color_xadj(color);
+          gs._color_set_end = h_color_xadj(color + 1);
+          const nnz_lno_t overall_work = gs._color_set_end - gs._color_set_begin;
+          if (overall_work == 0) continue;
+          Kokkos::parallel_for(is_backward ? "KokkosSparse::GaussSeidel::MV_PSGS::backward" : "KokkosSparse::GaussSeidel::MV_PSGS::forward",
+              team_policy_t((overall_work + gs.rows_per_team - 1) / gs.rows_per_team, team_size, vector_length),
+              gs);
+          gsHandler->add_num_apply_launches(1);
+        }
+      }
+    }
+  }
+
+  //groups the colors that a sweep launches together: group g is the colors
+  //[group_xadj[g], group_xadj[g + 1]), either one color or consecutive colors
+  //of at most fused_color_size rows.
+  void color_groups(color_t numColors, nnz_lno_persistent_work_host_view_t h_color_xadj,
+      std::vector<color_t> &group_xadj){
+    const nnz_lno_t fused_color_size = this->handle->get_gs_handle()->get_fused_color_size();
+    group_xadj.clear();
+    group_xadj.push_back(0);
+    for (color_t i = 0; i < numColors; ){
+      color_t j = i + 1;
+      if (h_color_xadj(i + 1) - h_color_xadj(i) <= fused_color_size){
+        while (j < numColors && h_color_xadj(j + 1) - h_color_xadj(j) <= fused_color_size) ++j;
+      }
+      group_xadj.push_back(j);
+      i = j;
+    }
+  }
+
+  template <typename point_gs_t>
+  void fused_sweep(point_gs_t &gs, color_t color_begin, color_t color_end, bool is_backward){
+    Kokkos::parallel_for ("KokkosSparse::GaussSeidel::Fused_PSGS",
+        team_policy_t (1, Kokkos::AUTO),
+        Fused_PSGS<point_gs_t>(gs, this->handle->get_gs_handle()->get_device_color_xadj(),
+            color_begin, color_end, is_backward));
+    this->handle->get_gs_handle()->add_num_apply_launches(1);
+  }
+
+  //sweeps one color with the point Team_PSGS: the long rows at the beginning
+  //of the color get a team each, then the other rows get a thread each.
+  void team_point_sweep(Team_PSGS &gs, color_t color, nnz_lno_persistent_work_host_view_t h_color_xadj){
+    nnz_lno_persistent_work_host_view_t h_long_rows = this->handle->get_gs_handle()->get_color_set_long_rows();
+    nnz_lno_t color_index_begin = h_color_xadj(color);
+    nnz_lno_t color_index_end = h_color_xadj(color + 1);
+    if (h_long_rows.extent(0) > size_t(color) && h_long_rows(color) > 0){
+      gs._color_set_begin = color_index_begin;
+      gs._color_set_end = color_index_begin + h_long_rows(color);
+      Kokkos::parallel_for("KokkosSparse::GaussSeidel::Team_PSGS::long_rows",
+          long_row_team_policy_t(h_long_rows(color), gs.suggested_team_size, gs.vector_size),
+          gs );
+      this->handle->get_gs_handle()->add_num_apply_launches(1);
+      color_index_begin += h_long_rows(color);
+    }
+    if (color_index_begin == color_index_end) return;
+    int overall_work = color_index_end - color_index_begin;
+    gs._color_set_begin = color_index_begin;
+    gs._color_set_end = color_index_end;
+    Kokkos::parallel_for("KokkosSparse::GaussSeidel::Team_PSGS::sweep",
+        team_policy_t(overall_work / gs.team_work_size + 1 , gs.suggested_team_size, gs.vector_size),
+        gs );
+    this->handle->get_gs_handle()->add_num_apply_launches(1);
+  }
+
   void IterativePSGS(
       Team_PSGS &gs,
       color_t numColors,
@@ -1472,6 +2061,30 @@ public:
 	  int vector_size = gs.vector_size;
 	  nnz_lno_t block_size = this->handle->get_gs_handle()->get_block_size();
 
+	  if (block_size == 1 && this->handle->get_gs_handle()->get_fused_color_size() > 0){
+		  PSGS point_gs(gs._xadj, gs._adj, gs._adj_vals, gs._Xvector, gs._Yvector,
+				  nnz_lno_persistent_work_view_t(), gs._permuted_diagonals);
+		  point_gs._lower_end = gs._lower_end;
+		  point_gs._zero_x_sweep = gs._zero_x_sweep;
+		  std::vector<color_t> group_xadj;
+		  this->color_groups(numColors, h_color_xadj, group_xadj);
+		  const size_t num_groups = group_xadj.size() - 1;
+		  for (int direction = 0; direction < 2; ++direction){
+			  const bool is_backward = direction == 1;
+			  if (is_backward ? !apply_backward : !apply_forward) continue;
+			  gs.is_backward = is_backward;
+			  for (size_t k = 0; k < num_groups; ++k){
+				  const size_t g = is_backward ? num_groups - 1 - k : k;
+				  if (group_xadj[g + 1] - group_xadj[g] > 1){
+					  this->fused_sweep(point_gs, group_xadj[g], group_xadj[g + 1], is_backward);
+					  continue;
+				  }
+				  this->team_point_sweep(gs, group_xadj[g], h_color_xadj);
+			  }
+		  }
+		  return;
+	  }
+
 	  /*
     size_type nnz = this->values.extent(0);
     int suggested_vector_size = this->handle->get_suggested_vector_size(num_rows, nnz);
@@ -1492,9 +2105,8 @@ public:
 			  gs._color_set_end = color_index_end;
 
 			  if (block_size == 1){
-			  Kokkos::parallel_for("KokkosSparse::GaussSeidel::Team_PSGS::forward",
-					  team_policy_t(overall_work / team_row_chunk_size + 1 , suggested_team_size, vector_size),
-					  gs );
+				  this->team_point_sweep(gs, i, h_color_xadj);
+				  continue;
 			  } else if (gs.num_max_vals_in_l2 == 0){
 				  //if (i == 0)std::cout << "block_team" << std::endl;
 			  Kokkos::parallel_for("KokkosSparse::GaussSeidel::BLOCK_Team_PSGS::forward",
@@ -1509,7 +2121,7 @@ public:
 				  					  gs );
 			  }
 
-			  MyExecSpace::fence();
+			  this->handle->get_gs_handle()->add_num_apply_launches(1);
 		  }
 	  }
 	  if (apply_backward){
@@ -1522,10 +2134,11 @@ public:
 				  gs._color_set_begin = color_index_begin;
 				  gs._color_set_end = color_index_end;
 				  if (block_size == 1){
-
-					  Kokkos::parallel_for("KokkosSparse::GaussSeidel::Team_PSGS::backward",
-							  team_policy_t(numberOfTeams / team_row_chunk_size + 1 , suggested_team_size, vector_size),
-							  gs );
+					  this->team_point_sweep(gs, i, h_color_xadj);
+					  if (i == 0){
+						  break;
+					  }
+					  continue;
 				  }
 				  else if ( gs.num_max_vals_in_l2 == 0){
 					//if (i == 0) std::cout << "block_team backward" << std::endl;
@@ -1541,7 +2154,7 @@ public:
 					  							  bigblock_team_fill_policy_t(numberOfTeams / team_row_chunk_size + 1 , suggested_team_size, vector_size),
 					  							  gs );
 				  }
-				  MyExecSpace::fence();
+				  this->handle->get_gs_handle()->add_num_apply_launches(1);
 				  if (i == 0){
 					  break;
 				  }
@@ -1549,8 +2162,30 @@ public:
 	  }
   }
 
+  //one iteration from a zero x. The first sweep skips the entries of the rows it has not
+  //reached yet, which multiply zeros: the upper entries going forward, the lower backward.
+  template <typename gs_t>
+  void ZeroXDoPSGS(
+      gs_t &gs,
+      row_lno_persistent_work_view_t lower_end,
+      color_t numColors,
+      nnz_lno_persistent_work_host_view_t h_color_xadj,
+      bool apply_forward,
+      bool apply_backward){
+
+    if (!(apply_forward || apply_backward)) return;
+    gs._lower_end = lower_end;
+    gs._zero_x_sweep = apply_forward ? 1 : 2;
+    this->DoPSGS(gs, numColors, h_color_xadj, apply_forward, !apply_forward);
+    gs._zero_x_sweep = 0;
+    if (apply_forward && apply_backward){
+      this->DoPSGS(gs, numColors, h_color_xadj, false, true);
+    }
+  }
+
+  template <typename point_gs_t>
   void IterativePSGS(
-      PSGS &gs,
+      point_gs_t &gs,
       color_t numColors,
       nnz_lno_persistent_work_host_view_t h_color_xadj,
       int num_iteration,
@@ -1565,30 +2200,39 @@ public:
 
 
 
-  void DoPSGS(PSGS &gs, color_t numColors, nnz_lno_persistent_work_host_view_t h_color_xadj,
+  template <typename point_gs_t>
+  void DoPSGS(point_gs_t &gs, color_t numColors, nnz_lno_persistent_work_host_view_t h_color_xadj,
       bool apply_forward,
       bool apply_backward){
+    std::vector<color_t> group_xadj;
+    this->color_groups(numColors, h_color_xadj, group_xadj);
+    const size_t num_groups = group_xadj.size() - 1;
     if (apply_forward){
     	//std::cout <<  "numColors:" << numColors << std::endl;
-      for (color_t i = 0; i < numColors; ++i){
-        nnz_lno_t color_index_begin = h_color_xadj(i);
-        nnz_lno_t color_index_end = h_color_xadj(i + 1);
+      for (size_t g = 0; g < num_groups; ++g){
+        if (group_xadj[g + 1] - group_xadj[g] > 1){
+          this->fused_sweep(gs, group_xadj[g], group_xadj[g + 1], false);
+          continue;
+        }
+        nnz_lno_t color_index_begin = h_color_xadj(group_xadj[g]);
+        nnz_lno_t color_index_end = h_color_xadj(group_xadj[g] + 1);
         //std::cout <<  "i:" << i << " color_index_begin:" << color_index_begin << " color_index_end:" << color_index_end << std::endl;
         Kokkos::parallel_for ("KokkosSparse::GaussSeidel::PSGS::forward",
             my_exec_space (color_index_begin, color_index_end) , gs);
-        MyExecSpace::fence();
+        this->handle->get_gs_handle()->add_num_apply_launches(1);
       }
     }
-    if (apply_backward && numColors){
-      for (size_type i = numColors - 1; ; --i){
-        nnz_lno_t color_index_begin = h_color_xadj(i);
-        nnz_lno_t color_index_end = h_color_xadj(i + 1);
+    if (apply_backward){
+      for (size_t g = num_groups; g-- > 0; ){
+        if (group_xadj[g + 1] - group_xadj[g] > 1){
+          this->fused_sweep(gs, group_xadj[g], group_xadj[g + 1], true);
+          continue;
+        }
+        nnz_lno_t color_index_begin = h_color_xadj(group_xadj[g]);
+        nnz_lno_t color_index_end = h_color_xadj(group_xadj[g] + 1);
         Kokkos::parallel_for ("KokkosSparse::GaussSeidel::PSGS::backward",
             my_exec_space (color_index_begin, color_index_end) , gs);
-        MyExecSpace::fence();
-        if (i == 0){
-          break;
-        }
+        this->handle->get_gs_handle()->add_num_apply_launches(1);
       }
     }
   }
@@ -51,6 +51,8 @@
 // Include the actual functors
 #if !defined(KOKKOSKERNELS_ETI_ONLY) || KOKKOSKERNELS_IMPL_COMPILE_LIBRARY
 #include "KokkosSparse_gauss_seidel_impl.hpp"
+#include "KokkosSparse_twostage_gauss_seidel_impl.hpp"
+#include "KokkosSparse_hybrid_gauss_seidel_impl.hpp"
 #endif
 
 namespace KokkosSparse {
@@ -225,6 +227,20 @@ struct GAUSS_SEIDEL_SYMBOLIC<KernelHandle,
       a_lno_view_t entries,
       bool is_graph_symmetric){
 
+      if (handle->get_gs_handle()->get_algorithm_type() == GS_TWOSTAGE){
+        typedef typename Impl::TwoStageGaussSeidel<KernelHandle, a_size_view_t_,
+            a_lno_view_t, typename KernelHandle::in_scalar_nnz_view_t> TSGS;
+        TSGS tsgs(handle, num_rows, num_cols, row_map, entries);
+        tsgs.initialize_symbolic();
+        return;
+      }
+      if (handle->get_gs_handle()->get_algorithm_type() == GS_HYBRID){
+        typedef typename Impl::HybridGaussSeidel<KernelHandle, a_size_view_t_,
+            a_lno_view_t, typename KernelHandle::in_scalar_nnz_view_t> HGS;
+        HGS hgs(handle, num_rows, num_cols, row_map, entries);
+        hgs.initialize_symbolic();
+        return;
+      }
       typedef typename Impl::GaussSeidel<KernelHandle, a_size_view_t_,
           a_lno_view_t, typename KernelHandle::in_scalar_nnz_view_t> SGS;
       SGS sgs(handle,num_rows, num_cols, row_map, entries, is_graph_symmetric);
@@ -246,6 +262,22 @@ struct GAUSS_SEIDEL_NUMERIC<KernelHandle,
       a_scalar_view_t values,
       bool is_graph_symmetric
       ){
+    if (handle->get_gs_handle()->get_algorithm_type() == GS_TWOSTAGE){
+      typedef typename Impl::TwoStageGaussSeidel
+          <KernelHandle,a_size_view_t_,
+          a_lno_view_t,a_scalar_view_t> TSGS;
+      TSGS tsgs(handle, num_rows, num_cols, row_map, entries, values);
+      tsgs.initialize_numeric();
+      return;
+    }
+    if (handle->get_gs_handle()->get_algorithm_type() == GS_HYBRID){
+      typedef typename Impl::HybridGaussSeidel
+          <KernelHandle,a_size_view_t_,
+          a_lno_view_t,a_scalar_view_t> HGS;
+      HGS hgs(handle, num_rows, num_cols, row_map, entries, values);
+      hgs.initialize_numeric();
+      return;
+    }
     typedef typename Impl::GaussSeidel
         <KernelHandle,a_size_view_t_,
         a_lno_view_t,a_scalar_view_t> SGS;
@@ -273,6 +305,32 @@ struct GAUSS_SEIDEL_APPLY<KernelHandle,
     bool update_y_vector,
     int numIter, bool apply_forward, bool apply_backward){
 
+    if (handle->get_gs_handle()->get_algorithm_type() == GS_TWOSTAGE){
+      typedef typename Impl::TwoStageGaussSeidel <KernelHandle,
+              a_size_view_t_, a_lno_view_t,a_scalar_view_t > TSGS;
+      TSGS tsgs(handle, num_rows, num_cols, row_map, entries, values);
+      tsgs.apply(
+          x_lhs_output_vec,
+          y_rhs_input_vec,
+          init_zero_x_vector,
+          numIter,
+          apply_forward,
+          apply_backward, update_y_vector);
+      return;
+    }
+    if (handle->get_gs_handle()->get_algorithm_type() == GS_HYBRID){
+      typedef typename Impl::HybridGaussSeidel <KernelHandle,
+              a_size_view_t_, a_lno_view_t,a_scalar_view_t > HGS;
+      HGS hgs(handle, num_rows, num_cols, row_map, entries, values);
+      hgs.apply(
+          x_lhs_output_vec,
+          y_rhs_input_vec,
+          init_zero_x_vector,
+          numIter,
+          apply_forward,
+          apply_backward, update_y_vector);
+      return;
+    }
     typedef typename Impl::GaussSeidel <KernelHandle,
             a_size_view_t_, a_lno_view_t,a_scalar_view_t > SGS;
     SGS sgs(handle, num_rows, num_cols, row_map, entries, values);
@@ -156,7 +156,7 @@ struct CrsMatrixGetDiagCopyWithOffsets {
     CrsMatrixGetDiagCopyWithOffsetsFunctor<diag_type, offsets_type,
       crs_matrix_type> functor (D, offsets, A);
     typedef Kokkos::RangePolicy<execution_space, ordinal_type> policy_type;
-    Kokkos::parallel_for (policy_type (0, numRows), functor);
+    Kokkos::parallel_for ("KokkosSparse::getDiagCopyWithOffsets", policy_type (0, numRows), functor);
   }
 };
 
@@ -0,0 +1,299 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#ifndef _KOKKOSHYBRIDGSIMP_HPP
+#define _KOKKOSHYBRIDGSIMP_HPP
+
+#include "KokkosKernels_Utils.hpp"
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include <algorithm>
+#include <sstream>
+
+namespace KokkosSparse{
+namespace Impl{
+
+/**
+ * \brief Hybrid Gauss-Seidel: the rows are split into contiguous blocks with
+ * about the same number of entries, and each block is swept sequentially by
+ * one thread, x_i = (1 - omega) x_i + omega D_i^{-1} (y_i - sum_{j != i} a_ij x_j).
+ * The columns of the other blocks read the values of x from before the
+ * sweep, so the iterates do not depend on the timing of the threads. It is
+ * Gauss-Seidel inside the blocks and Jacobi across them; with one block, it
+ * is sequential SOR. No coloring, and the blocks stream through contiguous
+ * rows of the matrix.
+ */
+template <typename HandleType, typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_nnz_view_t_>
+class HybridGaussSeidel{
+
+public:
+
+  typedef typename HandleType::HandleExecSpace MyExecSpace;
+
+  typedef typename HandleType::size_type size_type;
+  typedef typename HandleType::nnz_lno_t nnz_lno_t;
+  typedef typename HandleType::nnz_scalar_t nnz_scalar_t;
+
+  typedef typename lno_row_view_t_::const_type const_lno_row_view_t;
+  typedef typename lno_nnz_view_t_::const_type const_lno_nnz_view_t;
+  typedef typename scalar_nnz_view_t_::const_type const_scalar_nnz_view_t;
+
+  typedef typename HandleType::scalar_persistent_work_view_t scalar_persistent_work_view_t;
+  typedef typename HandleType::nnz_lno_persistent_work_view_t nnz_lno_persistent_work_view_t;
+
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef Kokkos::Details::ArithTraits<nnz_scalar_t> ATS;
+
+  struct ForwardTag{};
+  struct BackwardTag{};
+
+private:
+  HandleType *handle;
+  nnz_lno_t num_rows, num_cols;
+
+  const_lno_row_view_t row_map;
+  const_lno_nnz_view_t entries;
+  const_scalar_nnz_view_t values;
+
+public:
+
+  //inverse of the diagonal entry of each row; 0 for rows without one.
+  struct Hybrid_Inverse_Diagonal{
+    const_lno_row_view_t _xadj;
+    const_lno_nnz_view_t _adj;
+    const_scalar_nnz_view_t _adj_vals;
+    scalar_persistent_work_view_t _inverse_diagonals;
+
+    Hybrid_Inverse_Diagonal(const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_, const_scalar_nnz_view_t adj_vals_,
+        scalar_persistent_work_view_t inverse_diagonals_):
+      _xadj(xadj_), _adj(adj_), _adj_vals(adj_vals_), _inverse_diagonals(inverse_diagonals_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &ii) const {
+      nnz_scalar_t diagonalVal = ATS::zero();
+      for (size_type adjind = _xadj[ii]; adjind < _xadj[ii + 1]; ++adjind){
+        if (_adj[adjind] == ii) diagonalVal += _adj_vals[adjind];
+      }
+      _inverse_diagonals[ii] = diagonalVal == ATS::zero() ? ATS::zero() : ATS::one() / diagonalVal;
+    }
+  };
+
+  //x_old = x, the values the blocks read from each other during a sweep.
+  template <typename x_value_array_type>
+  struct Hybrid_Copy{
+    x_value_array_type _Xvector;
+    scalar_persistent_work_view_t _Xold_vector;
+
+    Hybrid_Copy(x_value_array_type Xvector_, scalar_persistent_work_view_t Xold_vector_):
+      _Xvector(Xvector_), _Xold_vector(Xold_vector_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &ii) const {
+      _Xold_vector[ii] = _Xvector[ii];
+    }
+  };
+
+  //the sequential forward or backward sweep of a block.
+  template <typename x_value_array_type, typename y_value_array_type>
+  struct Hybrid_Block_Sweep{
+    const_lno_row_view_t _xadj;
+    const_lno_nnz_view_t _adj;
+    const_scalar_nnz_view_t _adj_vals;
+    nnz_lno_persistent_work_view_t _block_rows;
+    x_value_array_type _Xvector;
+    scalar_persistent_work_view_t _Xold_vector;
+    y_value_array_type _Yvector;
+    scalar_persistent_work_view_t _inverse_diagonals;
+    nnz_scalar_t _omega;
+
+    Hybrid_Block_Sweep(const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_, const_scalar_nnz_view_t adj_vals_,
+        nnz_lno_persistent_work_view_t block_rows_, x_value_array_type Xvector_,
+        scalar_persistent_work_view_t Xold_vector_, y_value_array_type Yvector_,
+        scalar_persistent_work_view_t inverse_diagonals_, nnz_scalar_t omega_):
+      _xadj(xadj_), _adj(adj_), _adj_vals(adj_vals_), _block_rows(block_rows_), _Xvector(Xvector_),
+      _Xold_vector(Xold_vector_), _Yvector(Yvector_), _inverse_diagonals(inverse_diagonals_), _omega(omega_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void relax(const nnz_lno_t &ii, const nnz_lno_t &begin, const nnz_lno_t &end) const {
+      nnz_scalar_t sum = _Yvector[ii];
+      for (size_type adjind = _xadj[ii]; adjind < _xadj[ii + 1]; ++adjind){
+        const nnz_lno_t colIndex = _adj[adjind];
+        if (colIndex == ii) continue;
+        const nnz_scalar_t x_j = (colIndex >= begin && colIndex < end) ? nnz_scalar_t(_Xvector[colIndex]) : _Xold_vector[colIndex];
+        sum -= _adj_vals[adjind] * x_j;
+      }
+      _Xvector[ii] = (ATS::one() - _omega) * _Xvector[ii] + _omega * _inverse_diagonals[ii] * sum;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const ForwardTag&, const nnz_lno_t &block) const {
+      const nnz_lno_t begin = _block_rows[block], end = _block_rows[block + 1];
+      for (nnz_lno_t ii = begin; ii < end; ++ii){
+        relax(ii, begin, end);
+      }
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const BackwardTag&, const nnz_lno_t &block) const {
+      const nnz_lno_t begin = _block_rows[block], end = _block_rows[block + 1];
+      for (nnz_lno_t ii = end; ii > begin; --ii){
+        relax(ii - 1, begin, end);
+      }
+    }
+  };
+
+  HybridGaussSeidel(HandleType *handle_,
+      nnz_lno_t num_rows_,
+      nnz_lno_t num_cols_,
+      const_lno_row_view_t row_map_,
+      const_lno_nnz_view_t entries_):
+        handle(handle_), num_rows(num_rows_), num_cols(num_cols_),
+        row_map(row_map_), entries(entries_), values(){}
+
+  HybridGaussSeidel(HandleType *handle_,
+      nnz_lno_t num_rows_,
+      nnz_lno_t num_cols_,
+      const_lno_row_view_t row_map_,
+      const_lno_nnz_view_t entries_,
+      const_scalar_nnz_view_t values_):
+        handle(handle_), num_rows(num_rows_), num_cols(num_cols_),
+        row_map(row_map_), entries(entries_), values(values_){}
+
+  //splits the rows into the blocks, with about the same number of entries each.
+  void initialize_symbolic(){
+    typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    if (gsHandler->get_block_size() != 1 || this->num_rows != this->num_cols){
+      std::ostringstream os;
+      os << "KokkosSparse::gauss_seidel: GS_HYBRID needs a square point matrix, "
+         << "A: " << this->num_rows << " x " << this->num_cols
+         << ", block size: " << gsHandler->get_block_size();
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+    nnz_lno_t num_blocks = gsHandler->get_num_hybrid_blocks();
+    if (num_blocks <= 0){
+      num_blocks = MyExecSpace::concurrency();
+    }
+    num_blocks = std::max(nnz_lno_t(1), std::min(num_blocks, this->num_rows));
+
+    typename const_lno_row_view_t::HostMirror h_row_map = Kokkos::create_mirror_view(this->row_map);
+    Kokkos::deep_copy(h_row_map, this->row_map);
+    const size_type nnz = this->num_rows > 0 ? h_row_map(this->num_rows) : 0;
+
+    nnz_lno_persistent_work_view_t block_rows (Kokkos::ViewAllocateWithoutInitializing("hybrid_block_rows"), num_blocks + 1);
+    typename nnz_lno_persistent_work_view_t::HostMirror h_block_rows = Kokkos::create_mirror_view(block_rows);
+    h_block_rows(0) = 0;
+    for (nnz_lno_t block = 1; block < num_blocks; ++block){
+      const size_type target = size_type((double (nnz) * block) / num_blocks);
+      const auto first = h_row_map.data();
+      const nnz_lno_t row = std::lower_bound(first, first + this->num_rows, target) - first;
+      h_block_rows(block) = std::max(h_block_rows(block - 1), row);
+    }
+    h_block_rows(num_blocks) = this->num_rows;
+    Kokkos::deep_copy(block_rows, h_block_rows);
+    gsHandler->set_hybrid_block_rows(block_rows);
+
+    gsHandler->allocate_x_y_vectors(this->num_rows, this->num_cols);
+    gsHandler->set_call_symbolic(true);
+  }
+
+  void initialize_numeric(){
+    typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    if (gsHandler->is_symbolic_called() == false){
+      this->initialize_symbolic();
+    }
+    scalar_persistent_work_view_t inverse_diagonals (Kokkos::ViewAllocateWithoutInitializing("inverse_diagonals"), num_rows);
+    Kokkos::parallel_for("KokkosSparse::HybridGaussSeidel::inverse_diagonals", my_exec_space(0, num_rows),
+        Hybrid_Inverse_Diagonal(this->row_map, this->entries, this->values, inverse_diagonals));
+    MyExecSpace::fence();
+    gsHandler->set_inverse_diagonals(inverse_diagonals);
+    gsHandler->set_call_numeric(true);
+  }
+
+  template <typename x_value_array_type, typename y_value_array_type>
+  void apply(
+      x_value_array_type x_lhs_output_vec,
+      y_value_array_type y_rhs_input_vec,
+      bool init_zero_x_vector = false,
+      int numIter = 1,
+      bool apply_forward = true,
+      bool apply_backward = true,
+      bool /*update_y_vector*/ = true){
+    typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    if (gsHandler->is_numeric_called() == false){
+      this->initialize_numeric();
+    }
+    scalar_persistent_work_view_t x_old = gsHandler->get_permuted_x_vector();
+    scalar_persistent_work_view_t inverse_diagonals = gsHandler->get_inverse_diagonals();
+    nnz_lno_persistent_work_view_t block_rows = gsHandler->get_hybrid_block_rows();
+    const nnz_lno_t num_blocks = block_rows.extent(0) - 1;
+
+    if (init_zero_x_vector){
+      KokkosKernels::Impl::zero_vector<x_value_array_type, MyExecSpace>(num_cols, x_lhs_output_vec);
+    }
+    Hybrid_Block_Sweep<x_value_array_type, y_value_array_type> sweep(
+        this->row_map, this->entries, this->values, block_rows, x_lhs_output_vec, x_old, y_rhs_input_vec,
+        inverse_diagonals, gsHandler->get_damping_factor());
+    for (int iter = 0; iter < numIter; ++iter){
+      for (int direction = 0; direction < 2; ++direction){
+        const bool forward = direction == 0;
+        if (forward ? !apply_forward : !apply_backward) continue;
+
+        if (num_blocks > 1){
+          Kokkos::parallel_for("KokkosSparse::HybridGaussSeidel::copy", my_exec_space(0, num_cols),
+              Hybrid_Copy<x_value_array_type>(x_lhs_output_vec, x_old));
+        }
+        if (forward){
+          Kokkos::parallel_for("KokkosSparse::HybridGaussSeidel::forward_sweep",
+              Kokkos::RangePolicy<ForwardTag, MyExecSpace>(0, num_blocks), sweep);
+        }
+        else {
+          Kokkos::parallel_for("KokkosSparse::HybridGaussSeidel::backward_sweep",
+              Kokkos::RangePolicy<BackwardTag, MyExecSpace>(0, num_blocks), sweep);
+        }
+      }
+    }
+    MyExecSpace::fence();
+  }
+};
+
+}
+}
+#endif
@@ -0,0 +1,185 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSSPARSE_JACOBI_IMPL_HPP
+#define _KOKKOSSPARSE_JACOBI_IMPL_HPP
+
+#include "Kokkos_Core.hpp"
+#include "Kokkos_ArithTraits.hpp"
+
+namespace KokkosSparse{
+namespace Impl{
+
+//inverts in place the diagonal copied from A, after adding the magnitudes of
+//the off-diagonal entries of the row for l1-Jacobi. Zero entries get 1.
+template<class RowMapType, class EntriesType, class ValuesType, class DiagType>
+struct Jacobi_Inverse_Diagonal_Functor {
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef typename ValuesType::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+
+  RowMapType row_map;
+  EntriesType entries;
+  ValuesType values;
+  DiagType diag;
+  bool is_l1;
+
+  Jacobi_Inverse_Diagonal_Functor (const RowMapType row_map_, const EntriesType entries_, const ValuesType values_,
+                                   const DiagType diag_, const bool is_l1_) :
+    row_map (row_map_), entries (entries_), values (values_), diag (diag_), is_l1 (is_l1_) {}
+
+  template <typename lno_t>
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const lno_t& i) const
+  {
+    scalar_t d = diag(i);
+    if (is_l1) {
+      const size_type row_end = row_map(i + 1);
+      for (size_type k = row_map(i); k < row_end; ++k) {
+        if (entries(k) != i) d += ATS::abs (values(k));
+      }
+    }
+    diag(i) = d == ATS::zero () ? ATS::one () : ATS::one () / d;
+  }
+};
+
+//x_out = x_in + omega D^{-1} (b - A x_in), the residual of each row summed
+//as it is used. With a zero x_in, x_out = omega D^{-1} b without reading A.
+template<class RowMapType, class EntriesType, class ValuesType,
+         class XInVector, class XOutVector, class BVector, class DiagType>
+struct Jacobi_Sweep_Functor {
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef typename ValuesType::non_const_value_type scalar_t;
+
+  RowMapType row_map;
+  EntriesType entries;
+  ValuesType values;
+  XInVector x_in;
+  XOutVector x_out;
+  BVector b;
+  DiagType inv_diag;
+  scalar_t omega;
+  bool zero_x_in;
+
+  Jacobi_Sweep_Functor (const RowMapType row_map_, const EntriesType entries_, const ValuesType values_,
+                        const XInVector x_in_, const XOutVector x_out_, const BVector b_,
+                        const DiagType inv_diag_, const scalar_t omega_, const bool zero_x_in_) :
+    row_map (row_map_), entries (entries_), values (values_),
+    x_in (x_in_), x_out (x_out_), b (b_), inv_diag (inv_diag_),
+    omega (omega_), zero_x_in (zero_x_in_) {}
+
+  template <typename lno_t>
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const lno_t& i) const
+  {
+    if (zero_x_in) {
+      x_out(i) = omega * inv_diag(i) * b(i);
+      return;
+    }
+    scalar_t r = b(i);
+    const size_type row_end = row_map(i + 1);
+    for (size_type k = row_map(i); k < row_end; ++k) {
+      r -= values(k) * x_in(entries(k));
+    }
+    x_out(i) = x_in(i) + omega * inv_diag(i) * r;
+  }
+};
+
+template<class AMatrix, class DiagType>
+void jacobi_inverse_diagonal (const AMatrix& A, const DiagType& diag, const bool is_l1)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type lno_t;
+
+  Kokkos::parallel_for ("KokkosSparse::JacobiInverseDiagonal",
+      Kokkos::RangePolicy<execution_space, lno_t> (0, A.numRows ()),
+      Jacobi_Inverse_Diagonal_Functor<typename AMatrix::row_map_type, typename AMatrix::index_type,
+                                      typename AMatrix::values_type, DiagType>
+        (A.graph.row_map, A.graph.entries, A.values, diag, is_l1));
+}
+
+template<class AMatrix, class XInVector, class XOutVector, class BVector, class DiagType>
+void jacobi_sweep (const AMatrix& A, const XInVector& x_in, const XOutVector& x_out,
+                   const BVector& b, const DiagType& inv_diag,
+                   const typename AMatrix::non_const_value_type omega, const bool zero_x_in)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type lno_t;
+
+  Kokkos::parallel_for ("KokkosSparse::JacobiSweep",
+      Kokkos::RangePolicy<execution_space, lno_t> (0, A.numRows ()),
+      Jacobi_Sweep_Functor<typename AMatrix::row_map_type, typename AMatrix::index_type,
+                           typename AMatrix::values_type, XInVector, XOutVector, BVector, DiagType>
+        (A.graph.row_map, A.graph.entries, A.values, x_in, x_out, b, inv_diag, omega, zero_x_in));
+}
+
+/// \brief Applies num_sweeps Jacobi sweeps to x, alternating between x and
+///   the work vector of the handle.
+template<class HandleType, class AMatrix, class XVector, class BVector>
+void jacobi_apply (const HandleType& handle, const AMatrix& A,
+                   const XVector& x, const BVector& b,
+                   const int num_sweeps, const bool zero_initial_guess)
+{
+  typedef typename HandleType::scalar_view_t scalar_view_t;
+
+  scalar_view_t inv_diag = handle.get_inv_diag ();
+  scalar_view_t work_x = handle.get_work_x ();
+  const typename HandleType::nnz_scalar_t omega = handle.get_damping_factor ();
+
+  for (int k = 0; k < num_sweeps; ++k) {
+    const bool zero_x_in = zero_initial_guess && k == 0;
+    if (k % 2 == 0) {
+      jacobi_sweep (A, x, work_x, b, inv_diag, omega, zero_x_in);
+    }
+    else {
+      jacobi_sweep (A, work_x, x, b, inv_diag, omega, zero_x_in);
+    }
+  }
+  if (num_sweeps % 2 == 1) {
+    Kokkos::deep_copy (x, work_x);
+  }
+}
+
+}
+}
+
+#endif
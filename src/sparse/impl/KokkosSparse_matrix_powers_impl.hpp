@@ -0,0 +1,316 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSSPARSE_IMPL_MATRIX_POWERS_HPP_
+#define KOKKOSSPARSE_IMPL_MATRIX_POWERS_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosBlas1_update.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+// max |j - i| over the entries (i, j) of A.
+template<class RowMapType, class EntriesType>
+struct Matrix_Bandwidth_Functor {
+  typedef typename EntriesType::non_const_value_type ordinal_type;
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef ordinal_type value_type;
+
+  RowMapType row_map;
+  EntriesType entries;
+
+  Matrix_Bandwidth_Functor (const RowMapType row_map_, const EntriesType entries_) :
+    row_map (row_map_), entries (entries_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i, value_type& bandwidth) const
+  {
+    for (size_type j = row_map(i); j < row_map(i + 1); ++j) {
+      const ordinal_type d = entries(j) > i ? entries(j) - i : i - entries(j);
+      if (d > bandwidth) bandwidth = d;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join (volatile value_type& dst, const volatile value_type& src) const {
+    if (src > dst) dst = src;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init (value_type& dst) const {
+    dst = 0;
+  }
+};
+
+template<class AMatrix>
+typename AMatrix::non_const_ordinal_type
+matrix_bandwidth (const AMatrix& A)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef Matrix_Bandwidth_Functor<typename AMatrix::row_map_type, typename AMatrix::index_type> functor_type;
+  typename AMatrix::non_const_ordinal_type bandwidth = 0;
+  Kokkos::parallel_reduce ("KokkosSparse::matrix_bandwidth",
+      Kokkos::RangePolicy<execution_space> (0, A.numRows ()),
+      functor_type (A.graph.row_map, A.graph.entries), bandwidth);
+  return bandwidth;
+}
+
+// One block of rows [r0, r1) per team. The team computes the vectors of
+// levels 0..s on the rows it owns plus (s - k) * bandwidth ghost rows on each
+// side for level k, in scratch buffers that stay in cache between the levels,
+// so that the rows of A and the entries of x are read from memory once for
+// all the levels. The ghost rows are computed redundantly by the neighbouring
+// teams. Level k is
+//   v_k = alpha_k (A v_{k-1} - theta_k v_{k-1}) - beta_k v_{k-2},
+// and the owned rows of each level are written to column k of V.
+template<class AMatrix,
+         class XVector,
+         class VMatrix,
+         class CoefficientView>
+struct Matrix_Powers_Blocked_Functor {
+  typedef typename AMatrix::execution_space            execution_space;
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::non_const_size_type        size_type;
+  typedef typename VMatrix::non_const_value_type       v_value_type;
+  typedef typename Kokkos::TeamPolicy<execution_space> team_policy;
+  typedef typename team_policy::member_type            team_member;
+  typedef Kokkos::View<v_value_type*, typename execution_space::scratch_memory_space,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged> > scratch_v_type;
+
+  AMatrix m_A;
+  XVector m_x;
+  VMatrix m_V;
+  CoefficientView m_alpha;
+  CoefficientView m_theta;
+  CoefficientView m_beta;
+  const int s;
+  const ordinal_type block_rows;
+  const ordinal_type bandwidth;
+  const ordinal_type buffer_length;
+  const int num_buffers;
+
+  Matrix_Powers_Blocked_Functor (const AMatrix m_A_,
+                                 const XVector m_x_,
+                                 const VMatrix m_V_,
+                                 const CoefficientView m_alpha_,
+                                 const CoefficientView m_theta_,
+                                 const CoefficientView m_beta_,
+                                 const int s_,
+                                 const ordinal_type block_rows_,
+                                 const ordinal_type bandwidth_,
+                                 const int num_buffers_) :
+    m_A (m_A_), m_x (m_x_), m_V (m_V_),
+    m_alpha (m_alpha_), m_theta (m_theta_), m_beta (m_beta_),
+    s (s_), block_rows (block_rows_), bandwidth (bandwidth_),
+    buffer_length (block_rows_ + 2 * s_ * bandwidth_), num_buffers (num_buffers_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const team_member& dev) const
+  {
+    const ordinal_type numRows = m_A.numRows ();
+    const ordinal_type r0 = static_cast<ordinal_type> (dev.league_rank ()) * block_rows;
+    const ordinal_type r1 = r0 + block_rows < numRows ? r0 + block_rows : numRows;
+    //row i of a level is entry i - base of its buffer.
+    const ordinal_type base = r0 - s * bandwidth;
+
+    scratch_v_type buffers[3];
+    for (int b = 0; b < num_buffers; ++b) {
+      buffers[b] = scratch_v_type (dev.team_scratch (0), buffer_length);
+    }
+
+    {
+      const ordinal_type lo = base > 0 ? base : 0;
+      const ordinal_type hi = r1 + s * bandwidth < numRows ? r1 + s * bandwidth : numRows;
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(dev,lo,hi), [&] (const ordinal_type& i) {
+        Kokkos::single(Kokkos::PerThread(dev), [&] () {
+          const v_value_type xi = m_x(i);
+          buffers[0](i - base) = xi;
+          if (i >= r0 && i < r1) m_V(i, 0) = xi;
+        });
+      });
+      dev.team_barrier ();
+    }
+
+    for (int k = 1; k <= s; ++k) {
+      const ordinal_type ghost = (s - k) * bandwidth;
+      const ordinal_type lo = r0 - ghost > 0 ? r0 - ghost : 0;
+      const ordinal_type hi = r1 + ghost < numRows ? r1 + ghost : numRows;
+      const scratch_v_type cur = buffers[k % num_buffers];
+      const scratch_v_type prev = buffers[(k - 1) % num_buffers];
+      const scratch_v_type prev2 = buffers[(k + num_buffers - 2) % num_buffers];
+      const v_value_type alpha = m_alpha(k), theta = m_theta(k), beta = m_beta(k);
+      const bool use_prev2 = k > 1 && beta != Kokkos::Details::ArithTraits<v_value_type>::zero ();
+
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(dev,lo,hi), [&] (const ordinal_type& i) {
+        const size_type row_begin = m_A.graph.row_map(i);
+        const ordinal_type row_length = static_cast<ordinal_type> (m_A.graph.row_map(i + 1) - row_begin);
+        v_value_type sum = 0;
+        Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(dev,row_length), [&] (const ordinal_type& iEntry, v_value_type& lsum) {
+          const size_type j = row_begin + iEntry;
+          lsum += m_A.values(j) * prev(m_A.graph.entries(j) - base);
+        },sum);
+
+        Kokkos::single(Kokkos::PerThread(dev), [&] () {
+          v_value_type vi = alpha * (sum - theta * prev(i - base));
+          if (use_prev2) vi -= beta * prev2(i - base);
+          cur(i - base) = vi;
+          if (i >= r0 && i < r1) m_V(i, k) = vi;
+        });
+      });
+      dev.team_barrier ();
+    }
+  }
+};
+
+// Fills the recurrence coefficients of levels 1..s on the host. The monomial
+// basis has alpha = 1, theta = beta = 0; the Newton basis has the shifts as
+// theta. The Chebyshev basis of the interval [center - half_width,
+// center + half_width] is v_1 = (A - center) v_0 / half_width and
+// v_k = 2 (A - center) v_{k-1} / half_width - v_{k-2}.
+template<class HostCoefficientView>
+void
+matrix_powers_chebyshev_coefficients (const HostCoefficientView& alpha,
+                                      const HostCoefficientView& theta,
+                                      const HostCoefficientView& beta,
+                                      const int s,
+                                      typename HostCoefficientView::const_value_type& center,
+                                      typename HostCoefficientView::const_value_type& half_width)
+{
+  typedef typename HostCoefficientView::non_const_value_type v_value_type;
+  typedef Kokkos::Details::ArithTraits<v_value_type> ATV;
+  for (int k = 1; k <= s; ++k) {
+    alpha(k) = (k == 1 ? ATV::one () : ATV::one () + ATV::one ()) / half_width;
+    theta(k) = center;
+    beta(k) = k == 1 ? ATV::zero () : ATV::one ();
+  }
+}
+
+// Computes the columns 0..s of V, with the cache-blocked kernel if a block of
+// rows with its ghost rows fits the team scratch, and with one spmv per level
+// otherwise.
+template<class AMatrix,
+         class XVector,
+         class VMatrix,
+         class HostCoefficientView>
+void
+matrix_powers (const AMatrix& A,
+               const XVector& x,
+               const VMatrix& V,
+               const int s,
+               const HostCoefficientView& h_alpha,
+               const HostCoefficientView& h_theta,
+               const HostCoefficientView& h_beta,
+               typename AMatrix::non_const_ordinal_type bandwidth)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type ordinal_type;
+  typedef typename VMatrix::non_const_value_type v_value_type;
+  typedef Kokkos::Details::ArithTraits<v_value_type> ATV;
+  typedef Kokkos::View<v_value_type*, typename VMatrix::device_type> coefficient_view_t;
+  typedef Matrix_Powers_Blocked_Functor<AMatrix, XVector, VMatrix, coefficient_view_t> functor_type;
+
+  const ordinal_type numRows = A.numRows ();
+  if (numRows <= 0) {
+    return;
+  }
+  if (bandwidth < 0) {
+    bandwidth = matrix_bandwidth (A);
+  }
+  bool has_beta = false;
+  for (int k = 2; k <= s; ++k) {
+    if (h_beta(k) != ATV::zero ()) has_beta = true;
+  }
+  const int num_buffers = has_beta ? 3 : 2;
+
+  //the buffers of a team stay in level 0 scratch, the shared memory of a Cuda
+  //block; on the host they stay in the cache of the core with the rows of A.
+  size_t max_scratch_bytes = 131072;
+#ifdef KOKKOS_ENABLE_CUDA
+  if (std::is_same<execution_space, Kokkos::Cuda>::value) {
+    max_scratch_bytes = 32768;
+  }
+#endif
+  const ordinal_type max_buffer_length = static_cast<ordinal_type> (
+      max_scratch_bytes / (num_buffers * sizeof (v_value_type)));
+  const ordinal_type ghost_rows = 2 * s * bandwidth;
+  ordinal_type block_rows = max_buffer_length - ghost_rows;
+  if (block_rows > numRows) block_rows = numRows;
+
+  //the ghost rows are recomputed by the neighbouring teams; more ghost rows
+  //than owned rows costs more than the passes over A it saves.
+  if (s > 1 && block_rows >= 32 && block_rows >= ghost_rows) {
+    coefficient_view_t alpha ("matrix_powers alpha", s + 1), theta ("matrix_powers theta", s + 1), beta ("matrix_powers beta", s + 1);
+    Kokkos::deep_copy (alpha, h_alpha);
+    Kokkos::deep_copy (theta, h_theta);
+    Kokkos::deep_copy (beta, h_beta);
+
+    const int num_blocks = static_cast<int> ((numRows + block_rows - 1) / block_rows);
+    const int vector_length = KokkosKernels::Impl::kk_get_suggested_vector_size (
+        numRows, A.nnz (), KokkosKernels::Impl::kk_get_exec_space_type<execution_space> ());
+    const size_t scratch_bytes = num_buffers * functor_type::scratch_v_type::shmem_size (block_rows + ghost_rows);
+    functor_type func (A, x, V, alpha, theta, beta, s, block_rows, bandwidth, num_buffers);
+    Kokkos::TeamPolicy<execution_space> policy (num_blocks, Kokkos::AUTO, vector_length);
+    Kokkos::parallel_for ("KokkosSparse::matrix_powers<Blocked>",
+                          policy.set_scratch_size (0, Kokkos::PerTeam (scratch_bytes)), func);
+    return;
+  }
+
+  Kokkos::deep_copy (Kokkos::subview (V, Kokkos::ALL (), 0), x);
+  for (int k = 1; k <= s; ++k) {
+    const auto prev = Kokkos::subview (V, Kokkos::ALL (), k - 1);
+    const auto prev2 = Kokkos::subview (V, Kokkos::ALL (), k > 1 ? k - 2 : 0);
+    const auto cur = Kokkos::subview (V, Kokkos::ALL (), k);
+    KokkosSparse::spmv ("N", h_alpha(k), A, prev, ATV::zero (), cur);
+    KokkosBlas::update (-h_alpha(k) * h_theta(k), prev, k > 1 ? -h_beta(k) : ATV::zero (), prev2, ATV::one (), cur);
+  }
+}
+
+}
+}
+
+#endif
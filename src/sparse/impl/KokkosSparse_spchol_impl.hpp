@@ -0,0 +1,666 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSSPARSE_IMPL_SPCHOL_HPP_
+#define KOKKOSSPARSE_IMPL_SPCHOL_HPP_
+
+/// \file KokkosSparse_spchol_impl.hpp
+/// \brief Implementation of the supernodal sparse Cholesky factorization.
+
+#include <KokkosKernels_config.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosSparse_spchol_handle.hpp"
+#include "KokkosBatched_Cholesky_Team_Internal.hpp"
+#include "KokkosBatched_Trsm_Team_Internal.hpp"
+#include "KokkosBatched_Gemm_Team_Internal.hpp"
+#include "KokkosBatched_Gemv_Team_Internal.hpp"
+#include "KokkosBatched_Trsv_Team_Internal.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace KokkosSparse {
+namespace Impl {
+
+/**
+ * \brief Symbolic phase of the supernodal Cholesky factorization, on the
+ * host. Computes the elimination tree of A from its lower triangle, the
+ * column structures of L by walking the row subtrees, merges the chains
+ * of columns with the same structure into supernodes and computes the dense
+ * block layout of each supernode, the position of each entry of A in the
+ * blocks and the level sets of the supernodal elimination tree.
+ */
+template <class CholHandle, class RowMapType, class EntriesType>
+void chol_symbolic(CholHandle &chandle, const RowMapType drow_map, const EntriesType dentries)
+{
+  typedef typename CholHandle::size_type size_type;
+  typedef typename CholHandle::nnz_lno_t nnz_lno_t;
+  typedef typename CholHandle::nnz_lno_view_t nnz_lno_view_t;
+  typedef typename CholHandle::nnz_lno_view_host_t nnz_lno_view_host_t;
+  typedef typename CholHandle::nnz_row_view_t nnz_row_view_t;
+  typedef typename CholHandle::nnz_row_view_host_t nnz_row_view_host_t;
+  typedef typename CholHandle::nnz_scalar_view_t nnz_scalar_view_t;
+
+  const nnz_lno_t nrows = drow_map.extent(0) ? drow_map.extent(0) - 1 : 0;
+  chandle.set_nrows(nrows);
+  chandle.reset_symbolic();
+
+  typename RowMapType::HostMirror row_map = Kokkos::create_mirror_view(drow_map);
+  Kokkos::deep_copy(row_map, drow_map);
+  typename EntriesType::HostMirror entries = Kokkos::create_mirror_view(dentries);
+  Kokkos::deep_copy(entries, dentries);
+  const size_type nnz = nrows > 0 ? size_type(row_map(nrows)) : 0;
+
+  //elimination tree, with path compression through the ancestors.
+  nnz_lno_view_host_t parent("etree", nrows);
+  {
+    std::vector<nnz_lno_t> ancestor(nrows, -1);
+    for (nnz_lno_t i = 0; i < nrows; ++i){
+      parent(i) = -1;
+      for (size_type k = row_map(i); k < row_map(i + 1); ++k){
+        nnz_lno_t r = entries(k);
+        while (r != -1 && r < i){
+          const nnz_lno_t next = ancestor[r];
+          ancestor[r] = i;
+          if (next == -1) parent(r) = i;
+          r = next;
+        }
+      }
+    }
+  }
+
+  //the columns of row i of L are the nodes of the row subtree of i, the
+  //paths from the columns of row i of A up to i. Counted first, then filled
+  //in ascending row order, so that the rows of each column are sorted.
+  std::vector<size_type> col_ptr(nrows + 1, 0);
+  std::vector<nnz_lno_t> col_rows;
+  {
+    std::vector<nnz_lno_t> mark(nrows, -1);
+    for (int pass = 0; pass < 2; ++pass){
+      std::vector<size_type> col_fill(col_ptr);
+      std::fill(mark.begin(), mark.end(), -1);
+      for (nnz_lno_t i = 0; i < nrows; ++i){
+        mark[i] = i;
+        for (size_type k = row_map(i); k < row_map(i + 1); ++k){
+          for (nnz_lno_t r = entries(k); r < i && mark[r] != i; r = parent(r)){
+            mark[r] = i;
+            if (pass == 0) ++col_ptr[r + 1];
+            else col_rows[col_fill[r]++] = i;
+          }
+        }
+      }
+      if (pass == 0){
+        for (nnz_lno_t j = 0; j < nrows; ++j) col_ptr[j + 1] += col_ptr[j];
+        col_rows.resize(col_ptr[nrows]);
+      }
+    }
+  }
+
+  //supernode partition: column j joins the supernode of column j - 1 if
+  //it is its parent and has the same structure below it.
+  const nnz_lno_t max_supernode_size = chandle.get_max_supernode_size();
+  std::vector<nnz_lno_t> sptr(1, 0);
+  for (nnz_lno_t j = 1; j < nrows; ++j){
+    const nnz_lno_t width = j - sptr.back();
+    const bool merge = parent(j - 1) == j &&
+        col_ptr[j] - col_ptr[j - 1] == col_ptr[j + 1] - col_ptr[j] + 1 &&
+        (max_supernode_size == 0 || width < max_supernode_size);
+    if (!merge) sptr.push_back(j);
+  }
+  if (nrows > 0) sptr.push_back(nrows);
+  const nnz_lno_t nsupernodes = sptr.size() - 1;
+
+  //rows below each supernode, the structure of its last column, and the
+  //block layout.
+  std::vector<nnz_lno_t> row_supernode(nrows);
+  std::vector<size_type> rows_ptr(nsupernodes + 1, 0);
+  std::vector<size_type> block_ptr(nsupernodes + 1, 0);
+  for (nnz_lno_t k = 0; k < nsupernodes; ++k){
+    const nnz_lno_t last = sptr[k + 1] - 1;
+    const size_type width = sptr[k + 1] - sptr[k];
+    for (nnz_lno_t r = sptr[k]; r <= last; ++r) row_supernode[r] = k;
+    rows_ptr[k + 1] = rows_ptr[k] + (col_ptr[last + 1] - col_ptr[last]);
+    block_ptr[k + 1] = block_ptr[k] + width * (width + rows_ptr[k + 1] - rows_ptr[k]);
+  }
+
+  //position of each entry of A in the blocks: A(i, j), j <= i, is U(j, i).
+  nnz_row_view_t dnnz_block_offsets("nnz_block_offsets", nnz);
+  nnz_row_view_host_t nnz_block_offsets = Kokkos::create_mirror_view(dnnz_block_offsets);
+  for (nnz_lno_t i = 0; i < nrows; ++i){
+    for (size_type k = row_map(i); k < row_map(i + 1); ++k){
+      const nnz_lno_t j = entries(k);
+      if (j > i){
+        nnz_block_offsets(k) = block_ptr[nsupernodes];
+        continue;
+      }
+      const nnz_lno_t s = row_supernode[j];
+      const nnz_lno_t width = sptr[s + 1] - sptr[s];
+      const size_type ld = width + rows_ptr[s + 1] - rows_ptr[s];
+      const size_type row_base = block_ptr[s] + (j - sptr[s]) * ld;
+      if (i < sptr[s + 1]){
+        nnz_block_offsets(k) = row_base + (i - sptr[s]);
+      }
+      else {
+        const typename std::vector<nnz_lno_t>::const_iterator first = col_rows.begin() + col_ptr[sptr[s + 1] - 1];
+        const size_type pos = std::lower_bound(first, first + (rows_ptr[s + 1] - rows_ptr[s]), i) - first;
+        nnz_block_offsets(k) = row_base + width + pos;
+      }
+    }
+  }
+
+  //level sets of the supernodal elimination tree: the children of a
+  //supernode have smaller indices, so a single ascending pass suffices.
+  std::vector<nnz_lno_t> slevel(nsupernodes, 0);
+  nnz_lno_t nslevels = 0;
+  for (nnz_lno_t k = 0; k < nsupernodes; ++k){
+    if (nslevels <= slevel[k]) nslevels = slevel[k] + 1;
+    const nnz_lno_t p = parent(sptr[k + 1] - 1);
+    if (p != -1){
+      const nnz_lno_t sp = row_supernode[p];
+      if (slevel[sp] <= slevel[k]) slevel[sp] = slevel[k] + 1;
+    }
+  }
+  nnz_lno_view_host_t slevel_ptr("supernode_level_ptr", nslevels + 1);
+  for (nnz_lno_t k = 0; k < nsupernodes; ++k) ++slevel_ptr(slevel[k] + 1);
+  for (nnz_lno_t l = 0; l < nslevels; ++l) slevel_ptr(l + 1) += slevel_ptr(l);
+  nnz_lno_view_t dsgbl("supernodes_grouped_by_level", nsupernodes);
+  nnz_lno_view_host_t sgbl = Kokkos::create_mirror_view(dsgbl);
+  {
+    std::vector<nnz_lno_t> level_fill(slevel_ptr.data(), slevel_ptr.data() + nslevels);
+    for (nnz_lno_t k = 0; k < nsupernodes; ++k) sgbl(level_fill[slevel[k]]++) = k;
+  }
+
+  //the update of a supernode is the dense square of its rows below,
+  //the work holds the updates of the largest level.
+  nnz_row_view_t dupdate_ptr("supernode_update_ptr", nsupernodes + 1);
+  nnz_row_view_host_t update_ptr = Kokkos::create_mirror_view(dupdate_ptr);
+  size_type max_level_update = 0;
+  update_ptr(0) = 0;
+  for (nnz_lno_t i = 0; i < nsupernodes; ++i){
+    const size_type n = rows_ptr[sgbl(i) + 1] - rows_ptr[sgbl(i)];
+    update_ptr(i + 1) = update_ptr(i) + n * n;
+  }
+  for (nnz_lno_t l = 0; l < nslevels; ++l){
+    const size_type level_update = update_ptr(slevel_ptr(l + 1)) - update_ptr(slevel_ptr(l));
+    if (max_level_update < level_update) max_level_update = level_update;
+  }
+
+  nnz_lno_view_host_t hsupernode_ptr("host_supernode_ptr", nsupernodes + 1);
+  nnz_lno_view_t dsupernode_ptr("supernode_ptr", nsupernodes + 1);
+  nnz_row_view_t drows_ptr("supernode_rows_ptr", nsupernodes + 1);
+  nnz_lno_view_t drows("supernode_rows", rows_ptr[nsupernodes]);
+  nnz_row_view_t dblock_ptr("supernode_block_ptr", nsupernodes + 1);
+  nnz_lno_view_t drow_supernode("row_supernode", nrows);
+  {
+    nnz_row_view_host_t hrows_ptr = Kokkos::create_mirror_view(drows_ptr);
+    nnz_lno_view_host_t hrows = Kokkos::create_mirror_view(drows);
+    nnz_row_view_host_t hblock_ptr = Kokkos::create_mirror_view(dblock_ptr);
+    nnz_lno_view_host_t hrow_supernode = Kokkos::create_mirror_view(drow_supernode);
+    for (nnz_lno_t k = 0; k <= nsupernodes; ++k){
+      hsupernode_ptr(k) = sptr[k];
+      hrows_ptr(k) = rows_ptr[k];
+      hblock_ptr(k) = block_ptr[k];
+    }
+    for (nnz_lno_t k = 0; k < nsupernodes; ++k){
+      const nnz_lno_t last = sptr[k + 1] - 1;
+      for (size_type j = 0; j < rows_ptr[k + 1] - rows_ptr[k]; ++j)
+        hrows(rows_ptr[k] + j) = col_rows[col_ptr[last] + j];
+    }
+    for (nnz_lno_t i = 0; i < nrows; ++i) hrow_supernode(i) = row_supernode[i];
+    Kokkos::deep_copy(dsupernode_ptr, hsupernode_ptr);
+    Kokkos::deep_copy(drows_ptr, hrows_ptr);
+    Kokkos::deep_copy(drows, hrows);
+    Kokkos::deep_copy(dblock_ptr, hblock_ptr);
+    Kokkos::deep_copy(drow_supernode, hrow_supernode);
+  }
+  Kokkos::deep_copy(dnnz_block_offsets, nnz_block_offsets);
+  Kokkos::deep_copy(dsgbl, sgbl);
+  Kokkos::deep_copy(dupdate_ptr, update_ptr);
+
+  chandle.set_etree(parent);
+  chandle.set_supernode_structure(nsupernodes, size_type(nrows) + col_ptr[nrows],
+      hsupernode_ptr, dsupernode_ptr, drows_ptr, drows, dblock_ptr, drow_supernode, dnnz_block_offsets,
+      nnz_scalar_view_t("supernode_block_values", block_ptr[nsupernodes]),
+      nnz_scalar_view_t("spchol_solve_work", rows_ptr[nsupernodes]));
+  chandle.set_supernode_levels(nslevels, dsgbl, slevel_ptr, dupdate_ptr,
+      nnz_scalar_view_t(Kokkos::ViewAllocateWithoutInitializing("spchol_update_work"), max_level_update));
+  chandle.set_symbolic_complete();
+}
+
+/**
+ * \brief Adds the entries of the lower triangle of A into the dense
+ * supernodal blocks. Duplicate entries are summed.
+ */
+template <class RowMapType, class ValuesType, class OffsetsType, class BlockValuesType>
+struct CholSupernodalPackFunctor
+{
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef typename OffsetsType::non_const_value_type offset_type;
+
+  RowMapType row_map;
+  ValuesType values;
+  OffsetsType nnz_block_offsets;
+  BlockValuesType block_values;
+  offset_type skip;
+
+  CholSupernodalPackFunctor(
+      const RowMapType &row_map_, const ValuesType &values_,
+      const OffsetsType &nnz_block_offsets_, const BlockValuesType &block_values_, offset_type skip_):
+    row_map(row_map_), values(values_), nnz_block_offsets(nnz_block_offsets_),
+    block_values(block_values_), skip(skip_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_type row) const {
+    for (size_type ptr = row_map(row); ptr < row_map(row + 1); ++ptr){
+      const offset_type offset = nnz_block_offsets(ptr);
+      if (offset != skip) Kokkos::atomic_add(&block_values(offset), values(ptr));
+    }
+  }
+};
+
+/**
+ * \brief Factors the supernodes of a single level, one team per supernode.
+ * The diagonal block is factored by a dense team Cholesky, the rows below
+ * by a team trsm with its transpose, and the update U_o^T U_o of the
+ * ancestors is computed by a team gemm into the level work and then
+ * subtracted from the ancestor blocks. Supernodes of a level may update
+ * the same ancestor, so the subtraction is atomic.
+ *
+ * A supernode whose pivot is not positive records it in info and does not
+ * update its ancestors, and once info is set the supernodes of the later
+ * levels return without any work; the blocks are then left partially
+ * factored.
+ */
+template <class TeamPolicy, class LnoViewType, class SizeViewType, class BlockValuesType, class InfoViewType>
+struct CholSupernodalFactorFunctor
+{
+  typedef typename TeamPolicy::member_type team_member_t;
+  typedef typename SizeViewType::non_const_value_type size_type;
+  typedef typename LnoViewType::non_const_value_type lno_t;
+  typedef typename BlockValuesType::non_const_value_type scalar_t;
+
+  LnoViewType supernode_ptr;
+  SizeViewType supernode_rows_ptr;
+  LnoViewType supernode_rows;
+  SizeViewType supernode_block_ptr;
+  LnoViewType row_supernode;
+  BlockValuesType block_values;
+  BlockValuesType update_work;
+  LnoViewType supernodes_grouped_by_level;
+  SizeViewType supernode_update_ptr;
+  InfoViewType info;
+  lno_t node_begin;
+
+  CholSupernodalFactorFunctor(
+      const LnoViewType &supernode_ptr_, const SizeViewType &supernode_rows_ptr_,
+      const LnoViewType &supernode_rows_, const SizeViewType &supernode_block_ptr_,
+      const LnoViewType &row_supernode_, const BlockValuesType &block_values_,
+      const BlockValuesType &update_work_, const LnoViewType &supernodes_grouped_by_level_,
+      const SizeViewType &supernode_update_ptr_, const InfoViewType &info_, lno_t node_begin_):
+    supernode_ptr(supernode_ptr_), supernode_rows_ptr(supernode_rows_ptr_),
+    supernode_rows(supernode_rows_), supernode_block_ptr(supernode_block_ptr_),
+    row_supernode(row_supernode_), block_values(block_values_), update_work(update_work_),
+    supernodes_grouped_by_level(supernodes_grouped_by_level_),
+    supernode_update_ptr(supernode_update_ptr_), info(info_), node_begin(node_begin_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const team_member_t &teamMember) const {
+    typedef Kokkos::Details::ArithTraits<scalar_t> STS;
+
+    //a pivot of an earlier level failed, the team reads info once so that
+    //all of its threads return together.
+    lno_t failed_pivot = 0;
+    Kokkos::single(Kokkos::PerTeam(teamMember), [&] (lno_t &pivot) {
+      pivot = *((volatile lno_t *) info.data());
+    }, failed_pivot);
+    if (failed_pivot != 0) return;
+
+    const lno_t lvl_pos = node_begin + teamMember.league_rank();
+    const lno_t snode = supernodes_grouped_by_level(lvl_pos);
+    const lno_t col_begin = supernode_ptr(snode);
+    const int width = supernode_ptr(snode + 1) - col_begin;
+    const size_type rbegin = supernode_rows_ptr(snode);
+    const int nrows = supernode_rows_ptr(snode + 1) - rbegin;
+    const int ld = width + nrows;
+    scalar_t *block = block_values.data() + supernode_block_ptr(snode);
+
+    const int r_val = KokkosBatched::Experimental::TeamCholeskyInternal<KokkosBatched::Experimental::Algo::Cholesky::Unblocked>::invoke(
+        teamMember, width, block, ld, 1);
+    if (r_val != 0 && teamMember.team_rank() == 0){
+      Kokkos::atomic_compare_exchange(&info(), lno_t(0), lno_t(col_begin + r_val));
+    }
+    teamMember.team_barrier();
+    //every thread of the team checks the same pivots, so r_val is uniform.
+    if (r_val != 0 || nrows == 0) return;
+
+    //U_o = U_d^-T A_o, U_d^T is read from the upper block with swapped strides.
+    KokkosBatched::Experimental::TeamTrsmInternalLeftLower<KokkosBatched::Experimental::Algo::Trsm::Unblocked>::invoke(
+        teamMember, false, width, nrows, STS::one(), block, 1, ld, block + width, ld, 1);
+    teamMember.team_barrier();
+
+    scalar_t *update = update_work.data() + (supernode_update_ptr(lvl_pos) - supernode_update_ptr(node_begin));
+    KokkosBatched::Experimental::TeamGemmInternal<KokkosBatched::Experimental::Algo::Gemm::Unblocked>::invoke(
+        teamMember, nrows, nrows, width, STS::one(), block + width, 1, ld, block + width, ld, 1,
+        STS::zero(), update, nrows, 1);
+    teamMember.team_barrier();
+
+    //row i of the update goes to the row of supernode_rows(i) in its
+    //supernode, the columns are found by merging with the rows of that
+    //supernode, both being sorted.
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, nrows), [&] (const int i) {
+      const lno_t row = supernode_rows(rbegin + i);
+      const lno_t target = row_supernode(row);
+      const lno_t tbegin = supernode_ptr(target);
+      const lno_t tend = supernode_ptr(target + 1);
+      const size_type trbegin = supernode_rows_ptr(target);
+      const size_type tld = (tend - tbegin) + (supernode_rows_ptr(target + 1) - trbegin);
+      const size_type row_base = supernode_block_ptr(target) + (row - tbegin) * tld;
+      size_type tpos = trbegin;
+      for (int j = i; j < nrows; ++j){
+        const lno_t col = supernode_rows(rbegin + j);
+        size_type offset;
+        if (col < tend){
+          offset = col - tbegin;
+        }
+        else {
+          while (supernode_rows(tpos) < col) ++tpos;
+          offset = (tend - tbegin) + (tpos - trbegin);
+        }
+        Kokkos::atomic_add(&block_values(row_base + offset), -update[i * nrows + j]);
+      }
+    });
+  }
+};
+
+/**
+ * \brief Forward solve U^T y = b of the supernodes of a single level, one
+ * team per supernode: a team trsv with the transpose of the diagonal
+ * block, then the rows below are updated with a team gemv, atomically as
+ * sibling supernodes update the same rows.
+ */
+template <class TeamPolicy, class LHSType, class LnoViewType, class SizeViewType, class BlockValuesType>
+struct CholSupernodalForwardFunctor
+{
+  typedef typename TeamPolicy::member_type team_member_t;
+  typedef typename SizeViewType::non_const_value_type size_type;
+  typedef typename LnoViewType::non_const_value_type lno_t;
+  typedef typename BlockValuesType::non_const_value_type scalar_t;
+
+  LHSType lhs;
+  LnoViewType supernode_ptr;
+  SizeViewType supernode_rows_ptr;
+  LnoViewType supernode_rows;
+  SizeViewType supernode_block_ptr;
+  BlockValuesType block_values;
+  BlockValuesType work;
+  LnoViewType supernodes_grouped_by_level;
+  lno_t node_begin;
+
+  CholSupernodalForwardFunctor(
+      const LHSType &lhs_, const LnoViewType &supernode_ptr_, const SizeViewType &supernode_rows_ptr_,
+      const LnoViewType &supernode_rows_, const SizeViewType &supernode_block_ptr_,
+      const BlockValuesType &block_values_, const BlockValuesType &work_,
+      const LnoViewType &supernodes_grouped_by_level_, lno_t node_begin_):
+    lhs(lhs_), supernode_ptr(supernode_ptr_), supernode_rows_ptr(supernode_rows_ptr_),
+    supernode_rows(supernode_rows_), supernode_block_ptr(supernode_block_ptr_),
+    block_values(block_values_), work(work_),
+    supernodes_grouped_by_level(supernodes_grouped_by_level_), node_begin(node_begin_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const team_member_t &teamMember) const {
+    typedef Kokkos::Details::ArithTraits<scalar_t> STS;
+
+    const lno_t snode = supernodes_grouped_by_level(node_begin + teamMember.league_rank());
+    const lno_t col_begin = supernode_ptr(snode);
+    const int width = supernode_ptr(snode + 1) - col_begin;
+    const size_type rbegin = supernode_rows_ptr(snode);
+    const int nrows = supernode_rows_ptr(snode + 1) - rbegin;
+    const int ld = width + nrows;
+    const int xs0 = lhs.stride_0();
+
+    scalar_t *xblock = lhs.data() + col_begin * xs0;
+    scalar_t *xupdate = work.data() + rbegin;
+    const scalar_t *block = block_values.data() + supernode_block_ptr(snode);
+
+    KokkosBatched::Experimental::TeamTrsvInternalLower<KokkosBatched::Experimental::Algo::Trsv::Unblocked>::invoke(
+        teamMember, false, width, STS::one(), block, 1, ld, xblock, xs0);
+    teamMember.team_barrier();
+    //every thread of the team checks the same pivots, so r_val is uniform.
+    if (r_val != 0 || nrows == 0) return;
+
+    KokkosBatched::Experimental::TeamGemvInternal<KokkosBatched::Experimental::Algo::Gemv::Unblocked>::invoke(
+        teamMember, nrows, width, STS::one(), block + width, 1, ld, xblock, xs0, STS::zero(), xupdate, 1);
+    teamMember.team_barrier();
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, nrows), [&] (const int i) {
+      Kokkos::atomic_add(&lhs(supernode_rows(rbegin + i)), -xupdate[i]);
+    });
+  }
+};
+
+/**
+ * \brief Backward solve U x = y of the supernodes of a single level, one
+ * team per supernode: the solution of the rows below is gathered, the
+ * off-diagonal block is applied with a team gemv and the diagonal block
+ * is solved with a team trsv.
+ */
+template <class TeamPolicy, class LHSType, class LnoViewType, class SizeViewType, class BlockValuesType>
+struct CholSupernodalBackwardFunctor
+{
+  typedef typename TeamPolicy::member_type team_member_t;
+  typedef typename SizeViewType::non_const_value_type size_type;
+  typedef typename LnoViewType::non_const_value_type lno_t;
+  typedef typename BlockValuesType::non_const_value_type scalar_t;
+
+  LHSType lhs;
+  LnoViewType supernode_ptr;
+  SizeViewType supernode_rows_ptr;
+  LnoViewType supernode_rows;
+  SizeViewType supernode_block_ptr;
+  BlockValuesType block_values;
+  BlockValuesType work;
+  LnoViewType supernodes_grouped_by_level;
+  lno_t node_begin;
+
+  CholSupernodalBackwardFunctor(
+      const LHSType &lhs_, const LnoViewType &supernode_ptr_, const SizeViewType &supernode_rows_ptr_,
+      const LnoViewType &supernode_rows_, const SizeViewType &supernode_block_ptr_,
+      const BlockValuesType &block_values_, const BlockValuesType &work_,
+      const LnoViewType &supernodes_grouped_by_level_, lno_t node_begin_):
+    lhs(lhs_), supernode_ptr(supernode_ptr_), supernode_rows_ptr(supernode_rows_ptr_),
+    supernode_rows(supernode_rows_), supernode_block_ptr(supernode_block_ptr_),
+    block_values(block_values_), work(work_),
+    supernodes_grouped_by_level(supernodes_grouped_by_level_), node_begin(node_begin_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const team_member_t &teamMember) const {
+    typedef Kokkos::Details::ArithTraits<scalar_t> STS;
+
+    const lno_t snode = supernodes_grouped_by_level(node_begin + teamMember.league_rank());
+    const lno_t col_begin = supernode_ptr(snode);
+    const int width = supernode_ptr(snode + 1) - col_begin;
+    const size_type rbegin = supernode_rows_ptr(snode);
+    const int nrows = supernode_rows_ptr(snode + 1) - rbegin;
+    const int ld = width + nrows;
+    const int xs0 = lhs.stride_0();
+
+    scalar_t *xblock = lhs.data() + col_begin * xs0;
+    scalar_t *xgather = work.data() + rbegin;
+    const scalar_t *block = block_values.data() + supernode_block_ptr(snode);
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, nrows), [&] (const int i) {
+      xgather[i] = lhs(supernode_rows(rbegin + i));
+    });
+    teamMember.team_barrier();
+    KokkosBatched::Experimental::TeamGemvInternal<KokkosBatched::Experimental::Algo::Gemv::Unblocked>::invoke(
+        teamMember, width, nrows, -STS::one(), block + width, ld, 1, xgather, 1, STS::one(), xblock, xs0);
+    teamMember.team_barrier();
+    KokkosBatched::Experimental::TeamTrsvInternalUpper<KokkosBatched::Experimental::Algo::Trsv::Unblocked>::invoke(
+        teamMember, false, width, STS::one(), block, ld, 1, xblock, xs0);
+  }
+};
+
+/**
+ * \brief Numeric phase of the supernodal Cholesky factorization. The
+ * values of A are packed into the dense supernodal blocks in a single
+ * fully parallel kernel, then the supernode levels are factored one after
+ * another, from the leaves of the supernodal elimination tree to its roots.
+ * If a pivot is not positive, the factor is left undefined and the handle
+ * is not marked numeric complete, but keeps its symbolic phase for another
+ * chol_numeric call.
+ */
+template <class KernelHandle, class RowMapType, class EntriesType, class ValuesType>
+void chol_numeric(
+    KernelHandle *handle,
+    const RowMapType row_map, const EntriesType entries, const ValuesType values)
+{
+  typedef typename KernelHandle::HandleExecSpace execution_space;
+  typedef typename KernelHandle::SPCHOLHandleType CholHandle;
+  typedef typename CholHandle::nnz_lno_t lno_t;
+  typedef typename CholHandle::size_type size_type;
+  typedef typename CholHandle::nnz_lno_view_t LnoViewType;
+  typedef typename CholHandle::nnz_row_view_t SizeViewType;
+  typedef typename CholHandle::nnz_scalar_view_t BlockValuesType;
+  typedef Kokkos::View<lno_t, typename CholHandle::HandlePersistentMemorySpace> InfoViewType;
+
+  typedef Kokkos::TeamPolicy<execution_space> team_policy_t;
+
+  CholHandle *chandle = handle->get_spchol_handle();
+  const lno_t nrows = chandle->get_nrows();
+  BlockValuesType block_values = chandle->get_supernode_block_values();
+  //the previous factor is overwritten, and is lost if this one fails.
+  chandle->set_numeric_complete(false);
+
+  Kokkos::deep_copy(block_values, Kokkos::Details::ArithTraits<typename BlockValuesType::non_const_value_type>::zero());
+  CholSupernodalPackFunctor<RowMapType, ValuesType, SizeViewType, BlockValuesType>
+    pack(row_map, values, chandle->get_nnz_block_offsets(), block_values, size_type(block_values.extent(0)));
+  Kokkos::parallel_for("KokkosSparse::spchol::supernodal_pack",
+      Kokkos::RangePolicy<execution_space>(0, nrows), pack);
+
+  InfoViewType info("spchol_info");
+  const lno_t nslevels = chandle->get_num_supernode_levels();
+  typename CholHandle::nnz_lno_view_host_t slevel_ptr = chandle->get_supernode_level_ptr();
+  const int suggested_team_size = handle->get_suggested_team_size(1);
+
+  for (lno_t lvl = 0; lvl < nslevels; ++lvl){
+    const lno_t node_begin = slevel_ptr(lvl);
+    const lno_t lvl_nodes = slevel_ptr(lvl + 1) - node_begin;
+
+    CholSupernodalFactorFunctor<team_policy_t, LnoViewType, SizeViewType, BlockValuesType, InfoViewType>
+      tcf(chandle->get_supernode_ptr(), chandle->get_supernode_rows_ptr(),
+          chandle->get_supernode_rows(), chandle->get_supernode_block_ptr(),
+          chandle->get_row_supernode(), block_values, chandle->get_update_work(),
+          chandle->get_supernodes_grouped_by_level(), chandle->get_supernode_update_ptr(), info, node_begin);
+    Kokkos::parallel_for("KokkosSparse::spchol::supernodal_factor",
+        team_policy_t(lvl_nodes, suggested_team_size, 1), tcf);
+  }
+
+  lno_t h_info = 0;
+  Kokkos::deep_copy(h_info, info);
+  if (h_info != 0){
+    std::ostringstream os;
+    os << "spchol_numeric: the matrix is not positive definite, the pivot of row "
+       << h_info - 1 << " is not positive";
+    Kokkos::Impl::throw_runtime_exception(os.str());
+  }
+  chandle->set_numeric_complete();
+}
+
+/**
+ * \brief Solves A x = b with the factor of chol_numeric: U^T y = b over
+ * the supernode levels from the leaves to the roots, then U x = y from the
+ * roots to the leaves, in place in x.
+ */
+template <class KernelHandle, class RHSType, class LHSType>
+void chol_solve(KernelHandle *handle, const RHSType &rhs, const LHSType &lhs)
+{
+  typedef typename KernelHandle::HandleExecSpace execution_space;
+  typedef typename KernelHandle::SPCHOLHandleType CholHandle;
+  typedef typename CholHandle::nnz_lno_t lno_t;
+  typedef typename CholHandle::nnz_lno_view_t LnoViewType;
+  typedef typename CholHandle::nnz_row_view_t SizeViewType;
+  typedef typename CholHandle::nnz_scalar_view_t BlockValuesType;
+
+  typedef Kokkos::TeamPolicy<execution_space> team_policy_t;
+
+  static_assert(std::is_same<typename LHSType::non_const_value_type,
+      typename BlockValuesType::non_const_value_type>::value,
+      "spchol_solve: the scalar type of x must match the scalar type of A");
+
+  CholHandle *chandle = handle->get_spchol_handle();
+  Kokkos::deep_copy(lhs, rhs);
+
+  const lno_t nslevels = chandle->get_num_supernode_levels();
+  typename CholHandle::nnz_lno_view_host_t slevel_ptr = chandle->get_supernode_level_ptr();
+  const int suggested_team_size = handle->get_suggested_team_size(1);
+
+  for (lno_t lvl = 0; lvl < nslevels; ++lvl){
+    const lno_t node_begin = slevel_ptr(lvl);
+    const lno_t lvl_nodes = slevel_ptr(lvl + 1) - node_begin;
+    CholSupernodalForwardFunctor<team_policy_t, LHSType, LnoViewType, SizeViewType, BlockValuesType>
+      tff(lhs, chandle->get_supernode_ptr(), chandle->get_supernode_rows_ptr(),
+          chandle->get_supernode_rows(), chandle->get_supernode_block_ptr(),
+          chandle->get_supernode_block_values(), chandle->get_solve_work(),
+          chandle->get_supernodes_grouped_by_level(), node_begin);
+    Kokkos::parallel_for("KokkosSparse::spchol::supernodal_forward",
+        team_policy_t(lvl_nodes, suggested_team_size, 1), tff);
+  }
+  for (lno_t lvl = nslevels; lvl > 0; --lvl){
+    const lno_t node_begin = slevel_ptr(lvl - 1);
+    const lno_t lvl_nodes = slevel_ptr(lvl) - node_begin;
+    CholSupernodalBackwardFunctor<team_policy_t, LHSType, LnoViewType, SizeViewType, BlockValuesType>
+      tbf(lhs, chandle->get_supernode_ptr(), chandle->get_supernode_rows_ptr(),
+          chandle->get_supernode_rows(), chandle->get_supernode_block_ptr(),
+          chandle->get_supernode_block_values(), chandle->get_solve_work(),
+          chandle->get_supernodes_grouped_by_level(), node_begin);
+    Kokkos::parallel_for("KokkosSparse::spchol::supernodal_backward",
+        team_policy_t(lvl_nodes, suggested_team_size, 1), tbf);
+  }
+}
+
+} // namespace Impl
+} // namespace KokkosSparse
+
+#endif // KOKKOSSPARSE_IMPL_SPCHOL_HPP_
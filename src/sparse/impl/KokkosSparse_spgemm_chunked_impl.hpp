@@ -0,0 +1,167 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_SPGEMM_CHUNKED_IMPL_HPP_
+#define KOKKOSSPARSE_SPGEMM_CHUNKED_IMPL_HPP_
+#include <vector>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosSparse_spgemm_impl_reuse.hpp"
+
+namespace KokkosSparse{
+
+namespace Impl{
+
+/**
+ * \brief Writes the row map of rows [row_begin, row_begin + num_rows) of A,
+ * shifted to start from 0.
+ */
+template <typename size_type, typename lno_t,
+          typename in_row_view_t, typename out_row_view_t>
+struct SpgemmShiftRowMapFunctor{
+  in_row_view_t row_map;
+  out_row_view_t block_row_map;
+  const lno_t row_begin;
+
+  SpgemmShiftRowMapFunctor(in_row_view_t row_map_, out_row_view_t block_row_map_, lno_t row_begin_):
+    row_map(row_map_), block_row_map(block_row_map_), row_begin(row_begin_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t &i) const {
+    block_row_map(i) = row_map(row_begin + i) - row_map(row_begin);
+  }
+};
+
+/**
+ * \brief Splits the rows of A into blocks, so that the number of multiplications
+ * of a block, which bounds its nonzeroes in C, is at most max_block_nnz.
+ * A row with more multiplications than max_block_nnz forms a block by itself.
+ * \param block_begins [out]: the first row of each block, followed by m.
+ * \return the maximum number of multiplications of a block.
+ */
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t,
+          typename b_row_view_t>
+typename KernelHandle::size_type spgemm_chunked_row_blocks(
+    typename KernelHandle::nnz_lno_t m,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA,
+    b_row_view_t row_mapB,
+    typename KernelHandle::size_type max_block_nnz,
+    std::vector<typename KernelHandle::nnz_lno_t> &block_begins){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::row_lno_temp_work_view_t row_view_t;
+  typedef Kokkos::RangePolicy<MyExecSpace> range_policy_t;
+
+  row_view_t row_flops(Kokkos::ViewAllocateWithoutInitializing("chunked row flops"), m + 1);
+  Kokkos::parallel_for("KokkosSparse::spgemm_chunked::RowFlops",
+      range_policy_t(0, m + 1),
+      SpgemmRowMultiplicationCountFunctor<size_type, nnz_lno_t, a_row_view_t, a_nnz_view_t, b_row_view_t, row_view_t>(
+          m, row_mapA, entriesA, row_mapB, row_flops));
+  KokkosKernels::Impl::exclusive_parallel_prefix_sum<row_view_t, MyExecSpace>(m + 1, row_flops);
+  MyExecSpace::fence();
+
+  typename row_view_t::HostMirror h_row_flops = Kokkos::create_mirror_view(row_flops);
+  Kokkos::deep_copy(h_row_flops, row_flops);
+
+  block_begins.clear();
+  size_type max_flops = 0;
+  nnz_lno_t row_begin = 0;
+  while (row_begin < m){
+    nnz_lno_t row_end = row_begin + 1;
+    while (row_end < m && h_row_flops(row_end + 1) - h_row_flops(row_begin) <= max_block_nnz){
+      ++row_end;
+    }
+    const size_type block_flops = h_row_flops(row_end) - h_row_flops(row_begin);
+    if (block_flops > max_flops) max_flops = block_flops;
+    block_begins.push_back(row_begin);
+    row_begin = row_end;
+  }
+  block_begins.push_back(m);
+  return max_flops;
+}
+
+/**
+ * \brief Block callback of spgemm_chunked_to_host. Copies each block of C to
+ * the host arrays, growing the entries and values geometrically.
+ */
+template <typename h_row_view_t, typename h_nnz_view_t, typename h_scalar_view_t>
+struct SpgemmChunkedHostCopy{
+  typedef typename h_row_view_t::non_const_value_type size_type;
+
+  h_row_view_t &h_row_mapC;
+  h_nnz_view_t &h_entriesC;
+  h_scalar_view_t &h_valuesC;
+
+  SpgemmChunkedHostCopy(h_row_view_t &h_row_mapC_, h_nnz_view_t &h_entriesC_, h_scalar_view_t &h_valuesC_):
+    h_row_mapC(h_row_mapC_), h_entriesC(h_entriesC_), h_valuesC(h_valuesC_){}
+
+  template <typename lno_t, typename row_view_t, typename nnz_view_t, typename scalar_view_t>
+  void operator()(lno_t row_begin, lno_t row_end,
+                  row_view_t row_mapC, nnz_view_t entriesC, scalar_view_t valuesC) const {
+    const size_type offset = h_row_mapC(row_begin);
+    const size_type block_nnz = entriesC.extent(0);
+
+    if (offset + block_nnz > h_entriesC.extent(0)){
+      size_t new_size = h_entriesC.extent(0) * 2;
+      if (new_size < offset + block_nnz) new_size = offset + block_nnz;
+      Kokkos::resize(h_entriesC, new_size);
+      Kokkos::resize(h_valuesC, new_size);
+    }
+
+    typename row_view_t::HostMirror h_block_row_map = Kokkos::create_mirror_view(row_mapC);
+    Kokkos::deep_copy(h_block_row_map, row_mapC);
+    for (lno_t i = row_begin; i < row_end; ++i){
+      h_row_mapC(i + 1) = offset + h_block_row_map(i - row_begin + 1);
+    }
+
+    auto h_entries_block = Kokkos::subview(h_entriesC, std::make_pair(size_t (offset), size_t (offset + block_nnz)));
+    auto h_values_block = Kokkos::subview(h_valuesC, std::make_pair(size_t (offset), size_t (offset + block_nnz)));
+    Kokkos::deep_copy(h_entries_block, entriesC);
+    Kokkos::deep_copy(h_values_block, valuesC);
+  }
+};
+
+}
+}
+#endif
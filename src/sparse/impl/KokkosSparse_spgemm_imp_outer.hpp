@@ -641,7 +641,7 @@ void KokkosSPGEMM
   row_lno_temp_work_view_t,
   const_b_lno_row_view_t,
   size_t_view_t> fpr(b_row_cnt, transpose_col_xadj, row_mapB, flop_per_row);
-  Kokkos::parallel_for(Kokkos::RangePolicy<MyExecSpace> (0,b_row_cnt), fpr);
+  Kokkos::parallel_for("KokkosSparse::spgemm_outer::FlopsPerRow", Kokkos::RangePolicy<MyExecSpace> (0,b_row_cnt), fpr);
   MyExecSpace::fence();
 
   KokkosKernels::Impl::
@@ -740,9 +740,9 @@ void KokkosSPGEMM
         fast_memory_triplets);
 
     if(this->use_dynamic_schedule)
-      Kokkos::parallel_for( dynamic_team_policy_t(b_row_cnt / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), outer_product);
+      Kokkos::parallel_for( "KokkosSparse::spgemm_outer::OuterProduct", dynamic_team_policy_t(b_row_cnt / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), outer_product);
     else
-      Kokkos::parallel_for( team_policy_t(b_row_cnt / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), outer_product);
+      Kokkos::parallel_for( "KokkosSparse::spgemm_outer::OuterProduct", team_policy_t(b_row_cnt / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), outer_product);
 
 
 
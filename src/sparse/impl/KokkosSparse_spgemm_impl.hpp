@@ -57,11 +57,13 @@
 #include <KokkosKernels_SparseUtils.hpp>
 #include <KokkosKernels_VectorUtils.hpp>
 #include <fstream>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include "KokkosKernels_HashmapAccumulator.hpp"
+#include "KokkosKernels_BitmapAccumulator.hpp"
 #include "KokkosKernels_Uniform_Initialized_MemoryPool.hpp"
 #include "KokkosSparse_spgemm_handle.hpp"
 #include "KokkosGraph_graph_color.hpp"
@@ -291,6 +293,16 @@ private:
       out_nnz_view_t &out_nnz_sets,
       bool singleStep);
 
+  /**
+   * \brief Computes the max and overall row flops of A times the compressed B
+   * given by its row begins and ends, records them in the spgemm handle, and
+   * returns whether the compression reduces the flops below the cut off.
+   */
+  template <typename b_row_begin_view_t, typename b_row_end_view_t>
+  bool compression_reduces_flops(
+      b_row_begin_view_t compressed_row_begins_B,
+      b_row_end_view_t compressed_row_ends_B);
+
 public:
   /**
    *\brief Functor to zip the B matrix.
@@ -449,6 +461,19 @@ private:
         c_lno_nnz_view_t entriesC_,
         c_scalar_nnz_view_t valuesC_,
         KokkosKernels::Impl::ExecSpaceType my_exec_space);
+
+  //keeps 32-bit copies of the row maps in the handle if the nonzeros of A, B and C fit.
+  template <typename c_row_view_t>
+  bool KokkosSPGEMM_cache_offsets32(c_row_view_t rowmapC_);
+
+  template <typename numeric_functor_t>
+  double KokkosSPGEMM_numeric_hash_run(
+        const numeric_functor_t &sc,
+        KokkosSparse::SPGEMMAlgorithm algorithm_to_run,
+        KokkosKernels::Impl::ExecSpaceType my_exec_space,
+        nnz_lno_t team_row_chunk_size,
+        int suggested_team_size,
+        int suggested_vector_size);
 #if defined( KOKKOS_ENABLE_OPENMP )
 #ifdef KOKKOSKERNELS_HAVE_OUTER
 public:
@@ -0,0 +1,304 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_SPGEMM_IMPL_AUTOSELECT_HPP_
+#define KOKKOSSPARSE_SPGEMM_IMPL_AUTOSELECT_HPP_
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosSparse_spgemm_handle.hpp"
+#include "KokkosSparse_analysis.hpp"
+
+namespace KokkosSparse{
+
+namespace Impl{
+
+//rows of B sampled to estimate the compression ratio.
+#define KOKKOSKERNELS_SPGEMM_AUTO_SAMPLE_ROWS 1024
+//entries of a sampled row of B that are inspected.
+#define KOKKOSKERNELS_SPGEMM_AUTO_SAMPLE_ROW_LENGTH 128
+
+/**
+ * \brief Statistics of A*B gathered by a single pass over the rows of A.
+ */
+struct SpgemmRowStats{
+  size_t a_max_row_nnz;
+  size_t max_row_flops;
+  size_t overall_flops;
+};
+
+template <typename size_type, typename lno_t,
+          typename a_row_view_t, typename a_nnz_view_t,
+          typename b_row_view_t>
+struct SpgemmRowStatsFunctor{
+  typedef SpgemmRowStats value_type;
+
+  a_row_view_t row_mapA;
+  a_nnz_view_t entriesA;
+  b_row_view_t row_mapB;
+
+  SpgemmRowStatsFunctor(a_row_view_t row_mapA_, a_nnz_view_t entriesA_, b_row_view_t row_mapB_):
+    row_mapA(row_mapA_), entriesA(entriesA_), row_mapB(row_mapB_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t &i, value_type &stats) const {
+    const size_type a_row_begin = row_mapA(i);
+    const size_type a_row_end = row_mapA(i + 1);
+    size_t row_flops = 0;
+    for (size_type j = a_row_begin; j < a_row_end; ++j){
+      const lno_t col = entriesA(j);
+      row_flops += row_mapB(col + 1) - row_mapB(col);
+    }
+    const size_t a_row_nnz = a_row_end - a_row_begin;
+    if (a_row_nnz > stats.a_max_row_nnz) stats.a_max_row_nnz = a_row_nnz;
+    if (row_flops > stats.max_row_flops) stats.max_row_flops = row_flops;
+    stats.overall_flops += row_flops;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init(value_type &stats) const {
+    stats.a_max_row_nnz = 0;
+    stats.max_row_flops = 0;
+    stats.overall_flops = 0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join(volatile value_type &dst, const volatile value_type &src) const {
+    if (src.a_max_row_nnz > dst.a_max_row_nnz) dst.a_max_row_nnz = src.a_max_row_nnz;
+    if (src.max_row_flops > dst.max_row_flops) dst.max_row_flops = src.max_row_flops;
+    dst.overall_flops += src.overall_flops;
+  }
+};
+
+/**
+ * \brief Number of inspected entries and of distinct compression sets
+ * in the sampled rows of B.
+ */
+struct SpgemmCompressionSample{
+  size_t sampled_nnz;
+  size_t sampled_sets;
+};
+
+/**
+ * \brief Estimates the compression ratio of B on a strided sample of its rows.
+ * A column c is stored in the set c / (bits in nnz_lno_t) by the compression
+ * in KokkosSparse_spgemm_impl_compression.hpp, so the compressed size of a row
+ * is its number of distinct sets.
+ */
+template <typename size_type, typename lno_t,
+          typename b_row_view_t, typename b_nnz_view_t>
+struct SpgemmCompressionSampleFunctor{
+  typedef SpgemmCompressionSample value_type;
+
+  b_row_view_t row_mapB;
+  b_nnz_view_t entriesB;
+  lno_t stride;
+  int set_shift;
+
+  SpgemmCompressionSampleFunctor(b_row_view_t row_mapB_, b_nnz_view_t entriesB_, lno_t stride_):
+    row_mapB(row_mapB_), entriesB(entriesB_), stride(stride_), set_shift(0){
+    size_t bits = sizeof(lno_t) * 8;
+    while (bits > 1) { bits = bits >> 1; ++set_shift; }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t &i, value_type &sample) const {
+    const lno_t row = i * stride;
+    const size_type row_begin = row_mapB(row);
+    size_type row_end = row_mapB(row + 1);
+    if (row_end - row_begin > KOKKOSKERNELS_SPGEMM_AUTO_SAMPLE_ROW_LENGTH){
+      row_end = row_begin + KOKKOSKERNELS_SPGEMM_AUTO_SAMPLE_ROW_LENGTH;
+    }
+    for (size_type j = row_begin; j < row_end; ++j){
+      const lno_t set = entriesB(j) >> set_shift;
+      bool new_set = true;
+      for (size_type z = row_begin; z < j; ++z){
+        if ((entriesB(z) >> set_shift) == set) { new_set = false; break; }
+      }
+      if (new_set) ++sample.sampled_sets;
+    }
+    sample.sampled_nnz += row_end - row_begin;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init(value_type &sample) const {
+    sample.sampled_nnz = 0;
+    sample.sampled_sets = 0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join(volatile value_type &dst, const volatile value_type &src) const {
+    dst.sampled_nnz += src.sampled_nnz;
+    dst.sampled_sets += src.sampled_sets;
+  }
+};
+
+/**
+ * \brief Chooses the kkmem, speed or dense algorithm and the accumulator for
+ * SPGEMM_KK_AUTO from cheap statistics of A and B, and records the decision
+ * and the statistics in the spgemm handle.
+ *
+ * On GPUs KK_MEMORY is chosen, as the symbolic phase does for SPGEMM_KK.
+ * On multicore architectures a dense accumulator is used when the columns of
+ * B are below MaxColDenseAcc (KK_DENSE), or when the estimated hashmap chunk
+ * of the densest row is at least half of a dense accumulator (KK_SPEED);
+ * that row is also bounded by the bandwidths of A and B when their analyses
+ * are attached to the handle, see KokkosSparse::analyze.
+ * Otherwise, or when a dense accumulator per thread does not fit into the
+ * memory budget of the handle, KK_MEMORY is used. Compression of B is
+ * skipped when the estimated compression ratio is above the compression
+ * cut off.
+ */
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t,
+          typename b_row_view_t, typename b_nnz_view_t>
+void spgemm_auto_select_algorithm(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t n,
+    typename KernelHandle::nnz_lno_t k,
+    a_row_view_t row_mapA,
+    a_nnz_view_t entriesA,
+    b_row_view_t row_mapB,
+    b_nnz_view_t entriesB){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef Kokkos::RangePolicy<MyExecSpace> range_policy_t;
+  typedef typename KernelHandle::SPGEMMHandleType spgemmHandleType;
+
+  spgemmHandleType *sh = handle->get_spgemm_handle();
+
+  SpgemmRowStats row_stats;
+  row_stats.a_max_row_nnz = row_stats.max_row_flops = row_stats.overall_flops = 0;
+  if (m > 0){
+    Kokkos::parallel_reduce("KokkosSparse::spgemm_auto_select::RowStats",
+        range_policy_t(0, m),
+        SpgemmRowStatsFunctor<size_type, nnz_lno_t, a_row_view_t, a_nnz_view_t, b_row_view_t>(
+            row_mapA, entriesA, row_mapB),
+        row_stats);
+  }
+
+  SpgemmCompressionSample sample;
+  sample.sampled_nnz = sample.sampled_sets = 0;
+  if (n > 0){
+    nnz_lno_t stride = n / KOKKOSKERNELS_SPGEMM_AUTO_SAMPLE_ROWS + 1;
+    nnz_lno_t num_samples = (n - 1) / stride + 1;
+    Kokkos::parallel_reduce("KokkosSparse::spgemm_auto_select::CompressionSample",
+        range_policy_t(0, num_samples),
+        SpgemmCompressionSampleFunctor<size_type, nnz_lno_t, b_row_view_t, b_nnz_view_t>(
+            row_mapB, entriesB, stride),
+        sample);
+  }
+  MyExecSpace::fence();
+
+  double compression_ratio = 1;
+  if (sample.sampled_nnz) compression_ratio = sample.sampled_sets / double (sample.sampled_nnz);
+
+  sh->auto_a_max_row_nnz = row_stats.a_max_row_nnz;
+  sh->auto_a_avg_row_nnz = m ? entriesA.extent(0) / double (m) : 0;
+  sh->auto_max_row_flops = row_stats.max_row_flops;
+  sh->auto_avg_row_flops = m ? row_stats.overall_flops / double (m) : 0;
+  sh->auto_compression_ratio = compression_ratio;
+  sh->auto_b_col_cnt = k;
+
+  bool apply_compression = compression_ratio <= sh->get_compression_cut_off();
+
+  SPGEMMAlgorithm algo = SPGEMM_KK_MEMORY;
+  SPGEMMAccumulator acc = SPGEMM_ACC_SPARSE;
+  //dense accumulators are not used if they do not fit into the memory budget.
+  bool dense_fits = sh->dense_accumulator_fits(k, MyExecSpace::concurrency());
+  if (handle->get_handle_exec_space() != KokkosKernels::Impl::Exec_CUDA && dense_fits){
+    if (size_t (k) < sh->MaxColDenseAcc){
+      algo = SPGEMM_KK_DENSE;
+      acc = SPGEMM_ACC_DENSE;
+    }
+    else {
+      //the estimated max row size of C, as the symbolic phase bounds it.
+      size_t max_row_nnz = row_stats.max_row_flops;
+      if (apply_compression) max_row_nnz = max_row_nnz * compression_ratio + 1;
+      if (max_row_nnz > size_t (k)) max_row_nnz = k;
+      //with the analyses of A and B attached to the handle, the columns of a
+      //row i of C are within [i - lower(A) - lower(B), i + upper(A) + upper(B)],
+      //a much tighter bound for banded and stencil matrices.
+      const KokkosSparse::MatrixAnalysis *analysis_a =
+          handle->get_matrix_analysis(row_mapA.data(), m, entriesA.extent(0));
+      const KokkosSparse::MatrixAnalysis *analysis_b =
+          handle->get_matrix_analysis(row_mapB.data(), n, entriesB.extent(0));
+      if (analysis_a != NULL && analysis_b != NULL){
+        const size_t band_row_nnz = analysis_a->lower_bandwidth + analysis_a->upper_bandwidth +
+            analysis_b->lower_bandwidth + analysis_b->upper_bandwidth + 1;
+        if (band_row_nnz < max_row_nnz) max_row_nnz = band_row_nnz;
+      }
+
+      size_t min_hash_size = 1;
+      while (max_row_nnz > min_hash_size){
+        min_hash_size *= 2;
+      }
+      size_t kkmem_chunksize = 2 * min_hash_size + 2 * max_row_nnz;
+      size_t dense_chunksize = k + max_row_nnz;
+      if (kkmem_chunksize >= dense_chunksize * 0.5){
+        algo = SPGEMM_KK_SPEED;
+        acc = SPGEMM_ACC_DENSE;
+      }
+    }
+  }
+  sh->set_auto_selected_algorithm(algo, acc, apply_compression);
+
+  if (handle->get_verbose()){
+    std::cout << "\tSPGEMM_KK_AUTO a_max_row_nnz:" << sh->auto_a_max_row_nnz
+              << " a_avg_row_nnz:" << sh->auto_a_avg_row_nnz
+              << " max_row_flops:" << sh->auto_max_row_flops
+              << " avg_row_flops:" << sh->auto_avg_row_flops
+              << " compression_ratio:" << compression_ratio
+              << " b_col_cnt:" << k
+              << " selected:" << (algo == SPGEMM_KK_DENSE ? "SPGEMM_KK_DENSE" :
+                                  (algo == SPGEMM_KK_SPEED ? "SPGEMM_KK_SPEED" : "SPGEMM_KK_MEMORY"))
+              << " compression:" << apply_compression << std::endl;
+  }
+}
+
+#undef KOKKOSKERNELS_SPGEMM_AUTO_SAMPLE_ROWS
+#undef KOKKOSKERNELS_SPGEMM_AUTO_SAMPLE_ROW_LENGTH
+
+}
+}
+#endif
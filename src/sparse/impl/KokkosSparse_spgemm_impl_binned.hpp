@@ -0,0 +1,695 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_SPGEMM_IMPL_BINNED_HPP_
+#define KOKKOSSPARSE_SPGEMM_IMPL_BINNED_HPP_
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_HashmapAccumulator.hpp"
+#include "KokkosKernels_MultiSize_MemoryPool.hpp"
+
+namespace KokkosSparse{
+
+namespace Impl{
+
+//bins of the rows of C in the binned numeric phase.
+enum SpgemmRowBin{ SPGEMM_BIN_TINY = 0, SPGEMM_BIN_MEDIUM = 1, SPGEMM_BIN_HUGE = 2, SPGEMM_NUM_BINS = 3};
+
+//rows with at most this many multiplications are tiny, they are not worth
+//the hashmap initialization.
+enum { SPGEMM_TINY_ROW_FLOPS = 16 };
+
+//scalar type of the accumulators when the products are accumulated in higher precision.
+template <typename scalar_t>
+struct SpgemmHighPrecisionScalar{ typedef scalar_t type; };
+template <>
+struct SpgemmHighPrecisionScalar<float>{ typedef double type; };
+template <>
+struct SpgemmHighPrecisionScalar<Kokkos::complex<float> >{ typedef Kokkos::complex<double> type; };
+
+//moves keys[root] down the max heap keys[0, n), together with its value.
+template <typename lno_t, typename key_t, typename value_t>
+KOKKOS_INLINE_FUNCTION
+void spgemm_heap_sift_down(key_t *keys, value_t *values, lno_t root, lno_t n){
+  while (2 * root + 1 < n){
+    lno_t child = 2 * root + 1;
+    if (child + 1 < n && keys[child] < keys[child + 1]) ++child;
+    if (!(keys[root] < keys[child])) return;
+    const key_t k = keys[root]; keys[root] = keys[child]; keys[child] = k;
+    const value_t v = values[root]; values[root] = values[child]; values[child] = v;
+    root = child;
+  }
+}
+
+/**
+ * \brief Sorts the first n keys in increasing order together with their
+ * values, with a heap sort that needs no extra memory. Called by one thread.
+ */
+template <typename lno_t, typename key_t, typename value_t>
+KOKKOS_INLINE_FUNCTION
+void spgemm_heap_sort_row(key_t *keys, value_t *values, lno_t n){
+  for (lno_t root = n / 2; root-- > 0;){
+    spgemm_heap_sift_down(keys, values, root, n);
+  }
+  for (lno_t end = n - 1; end > 0; --end){
+    const key_t k = keys[0]; keys[0] = keys[end]; keys[end] = k;
+    const value_t v = values[0]; values[0] = values[end]; values[end] = v;
+    spgemm_heap_sift_down(keys, values, lno_t (0), end);
+  }
+}
+
+/**
+ * \brief Assigns the rows of C to bins. A row is tiny if it has at most
+ * tiny_row_flops multiplications, medium if its nonzeroes fit into the shared
+ * memory hashmap of a thread, and huge otherwise.
+ * With CountTag the rows of each bin are counted, with FillTag the rows are
+ * written to bin_rows, starting from the offsets of the bins in bin_offsets.
+ */
+template <typename size_type, typename lno_t,
+          typename a_row_view_t, typename a_nnz_view_t,
+          typename b_row_view_t, typename c_row_view_t,
+          typename bin_view_t>
+struct SpgemmRowBinFunctor{
+  struct CountTag{};
+  struct FillTag{};
+
+  a_row_view_t row_mapA;
+  a_nnz_view_t entriesA;
+  b_row_view_t row_mapB;
+  c_row_view_t row_mapC;
+  bin_view_t bin_offsets;
+  bin_view_t bin_rows;
+  const size_type tiny_row_flops;
+  const size_type medium_row_nnz;
+
+  SpgemmRowBinFunctor(
+      a_row_view_t row_mapA_, a_nnz_view_t entriesA_,
+      b_row_view_t row_mapB_, c_row_view_t row_mapC_,
+      bin_view_t bin_offsets_, bin_view_t bin_rows_,
+      size_type tiny_row_flops_, size_type medium_row_nnz_):
+    row_mapA(row_mapA_), entriesA(entriesA_),
+    row_mapB(row_mapB_), row_mapC(row_mapC_),
+    bin_offsets(bin_offsets_), bin_rows(bin_rows_),
+    tiny_row_flops(tiny_row_flops_), medium_row_nnz(medium_row_nnz_){}
+
+  KOKKOS_INLINE_FUNCTION
+  int get_bin(const lno_t &i) const {
+    size_type row_flops = 0;
+    for (size_type j = row_mapA(i); j < row_mapA(i + 1) && row_flops <= tiny_row_flops; ++j){
+      const lno_t col = entriesA(j);
+      row_flops += row_mapB(col + 1) - row_mapB(col);
+    }
+    if (row_flops <= tiny_row_flops) return SPGEMM_BIN_TINY;
+    if (size_type (row_mapC(i + 1) - row_mapC(i)) <= medium_row_nnz) return SPGEMM_BIN_MEDIUM;
+    return SPGEMM_BIN_HUGE;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const CountTag&, const lno_t &i) const {
+    Kokkos::atomic_fetch_add(&(bin_offsets(get_bin(i))), lno_t(1));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const FillTag&, const lno_t &i) const {
+    const lno_t pos = Kokkos::atomic_fetch_add(&(bin_offsets(get_bin(i))), lno_t(1));
+    bin_rows(pos) = i;
+  }
+};
+
+/**
+ * \brief Numeric phase of the rows of the bins.
+ * Tiny rows are computed by a single thread, accumulating with a linear
+ * search in the row of C.
+ * Medium rows are computed by the vector lanes of a thread, with a hashmap
+ * in the shared memory of the thread whose keys and values are the row of C.
+ * Huge rows are computed the same way with a hashmap in a chunk of the
+ * multi-size memory pool, whose size is proportional to the size of the row.
+ * HugeClassTag counts the huge rows of each size class of the pool.
+ * If row_nnz is not empty, row_mapC only bounds the rows of C, and the number
+ * of nonzeroes written to each row is stored in row_nnz.
+ * With sort_rows, tiny rows are kept sorted while inserting, and the other
+ * rows accumulate their keys and values in the memory of the hashmap and are
+ * sorted there before they are written to C.
+ * The products are accumulated in accum_t. If it differs from scalar_t, tiny
+ * rows accumulate in registers and the other rows in the memory of the hashmap,
+ * and the sums are converted when written to C.
+ * With linear_probing, the hashmaps use open addressing with linear probing
+ * and have no nexts, their slots are kept at most half full.
+ */
+template <typename size_type, typename lno_t, typename scalar_t, typename accum_t, bool linear_probing,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename b_row_view_t, typename b_nnz_view_t, typename b_scalar_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t,
+          typename bin_view_t, typename pool_memory_space, typename team_member_t>
+struct SpgemmBinnedNumericFunctor{
+  struct TinyTag{};
+  struct MediumTag{};
+  struct HugeClassTag{};
+  struct HugeTag{};
+
+  typedef typename std::conditional<linear_probing,
+      KokkosKernels::Experimental::LinearProbingHashmapAccumulator<lno_t,lno_t,accum_t>,
+      KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,accum_t> >::type hashmap_t;
+
+  a_row_view_t row_mapA;
+  a_nnz_view_t entriesA;
+  a_scalar_view_t valuesA;
+  b_row_view_t row_mapB;
+  b_nnz_view_t entriesB;
+  b_scalar_view_t valuesB;
+  c_row_view_t row_mapC;
+  c_nnz_view_t entriesC;
+  c_scalar_view_t valuesC;
+  bin_view_t bin_rows;
+  bin_view_t row_nnz;
+  bin_view_t huge_class_counts;
+  pool_memory_space memory_space;
+
+  lno_t bin_begin, bin_size;
+  size_t huge_min_chunk_size;
+  const lno_t num_cols;
+  const int vector_size;
+  const lno_t thread_shmem_units;
+  const lno_t thread_shmem_hash_size;
+  const lno_t thread_shmem_key_size;
+  //the values of a row are held with its hashmap if values_in_memory is set.
+  const lno_t scalar_units;
+  const bool values_in_memory;
+  const size_t shared_memory_size;
+  const bool sort_rows;
+
+  SpgemmBinnedNumericFunctor(
+      a_row_view_t row_mapA_, a_nnz_view_t entriesA_, a_scalar_view_t valuesA_,
+      b_row_view_t row_mapB_, b_nnz_view_t entriesB_, b_scalar_view_t valuesB_,
+      c_row_view_t row_mapC_, c_nnz_view_t entriesC_, c_scalar_view_t valuesC_,
+      bin_view_t bin_rows_, bin_view_t row_nnz_, lno_t num_cols_,
+      int vector_size_, lno_t thread_shmem_units_, lno_t thread_shmem_hash_size_,
+      lno_t thread_shmem_key_size_, lno_t scalar_units_, bool values_in_memory_,
+      size_t shared_memory_size_, bool sort_rows_):
+    row_mapA(row_mapA_), entriesA(entriesA_), valuesA(valuesA_),
+    row_mapB(row_mapB_), entriesB(entriesB_), valuesB(valuesB_),
+    row_mapC(row_mapC_), entriesC(entriesC_), valuesC(valuesC_),
+    bin_rows(bin_rows_), row_nnz(row_nnz_), huge_class_counts(), memory_space(),
+    bin_begin(0), bin_size(0), huge_min_chunk_size(1),
+    num_cols(num_cols_), vector_size(vector_size_),
+    thread_shmem_units(thread_shmem_units_), thread_shmem_hash_size(thread_shmem_hash_size_),
+    thread_shmem_key_size(thread_shmem_key_size_),
+    scalar_units(scalar_units_), values_in_memory(values_in_memory_),
+    shared_memory_size(shared_memory_size_), sort_rows(sort_rows_){}
+
+  //units of lno_t of the memory of a hashmap with hash_size and key_size.
+  KOKKOS_INLINE_FUNCTION
+  size_t row_memory_units(const lno_t hash_size, const lno_t key_size) const {
+    return size_t (values_in_memory ? key_size * scalar_units : 0) + 2 + hash_size +
+        (linear_probing ? 0 : key_size) + (sort_rows ? key_size : 0);
+  }
+
+  //keys of the hashmap of a huge row, at most the columns of C if row_mapC only bounds the row.
+  KOKKOS_INLINE_FUNCTION
+  lno_t huge_key_size(const lno_t c_row_size) const {
+    return c_row_size < num_cols ? c_row_size : num_cols;
+  }
+
+  //hash size of a huge row, the power of 2 not smaller than its keys,
+  //or than twice its keys with linear probing.
+  KOKKOS_INLINE_FUNCTION
+  static lno_t huge_hash_size(const lno_t key_size){
+    lno_t hash_size = 1;
+    while (hash_size < (linear_probing ? 2 * key_size : key_size)) hash_size *= 2;
+    return hash_size;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TinyTag&, const lno_t &ii) const {
+    const lno_t row_index = bin_rows(bin_begin + ii);
+    const size_type c_row_begin = row_mapC(row_index);
+    //a tiny row has at most SPGEMM_TINY_ROW_FLOPS nonzeroes.
+    accum_t row_values[SPGEMM_TINY_ROW_FLOPS];
+    lno_t row_size = 0;
+    for (size_type j = row_mapA(row_index); j < row_mapA(row_index + 1); ++j){
+      const lno_t rowB = entriesA(j);
+      const accum_t valA = accum_t (valuesA(j));
+      for (size_type z = row_mapB(rowB); z < row_mapB(rowB + 1); ++z){
+        const lno_t b_col = entriesB(z);
+        lno_t pos = 0;
+        if (sort_rows){
+          while (pos < row_size && entriesC(c_row_begin + pos) < b_col) ++pos;
+        }
+        else {
+          while (pos < row_size && entriesC(c_row_begin + pos) != b_col) ++pos;
+        }
+        if (pos < row_size && entriesC(c_row_begin + pos) == b_col){
+          row_values[pos] += valA * accum_t (valuesB(z));
+        }
+        else {
+          //shift the larger columns to keep the row sorted.
+          for (lno_t z2 = row_size; z2 > pos; --z2){
+            entriesC(c_row_begin + z2) = entriesC(c_row_begin + z2 - 1);
+            row_values[z2] = row_values[z2 - 1];
+          }
+          entriesC(c_row_begin + pos) = b_col;
+          row_values[pos] = valA * accum_t (valuesB(z));
+          ++row_size;
+        }
+      }
+    }
+    for (lno_t i = 0; i < row_size; ++i){
+      valuesC(c_row_begin + i) = scalar_t (row_values[i]);
+    }
+    if (row_nnz.extent(0)) row_nnz(row_index) = row_size;
+  }
+
+  /**
+   * \brief Computes a row of C by the vector lanes of a thread with a hashmap in memory:
+   * values of the row if values_in_memory is set, used size, begins and nexts of
+   * the hashmap, and keys of the row if sort_rows is set.
+   */
+  KOKKOS_INLINE_FUNCTION
+  void hash_row(const team_member_t & teamMember, const lno_t row_index,
+                lno_t *memory, const lno_t hash_size, const lno_t key_size) const {
+    const size_type c_row_begin = row_mapC(row_index);
+    const lno_t c_row_size = row_mapC(row_index + 1) - c_row_begin;
+    const lno_t max_row_keys = c_row_size < key_size ? c_row_size : key_size;
+
+    accum_t *row_values = (accum_t *) memory;
+    if (values_in_memory) memory += key_size * scalar_units;
+    volatile lno_t *used_size = (volatile lno_t *) memory;
+    lno_t *begins = memory + 2;
+    lno_t *nexts = begins + hash_size;
+    lno_t *row_keys = linear_probing ? nexts : nexts + key_size;
+    const lno_t hash_func = hash_size - 1;
+
+    //without values_in_memory accum_t is scalar_t, and the values accumulate in C.
+    hashmap_t hm(
+        hash_size, max_row_keys, begins, nexts,
+        sort_rows ? row_keys : entriesC.data() + c_row_begin,
+        values_in_memory ? row_values : (accum_t *) (valuesC.data() + c_row_begin));
+
+    Kokkos::parallel_for( Kokkos::ThreadVectorRange(teamMember, hash_size), [&] (lno_t i) {
+      begins[i] = -1; });
+    Kokkos::single(Kokkos::PerThread(teamMember),[&] () {
+      used_size[0] = 0;
+    });
+
+    for (size_type j = row_mapA(row_index); j < row_mapA(row_index + 1); ++j){
+      const lno_t rowB = entriesA(j);
+      const accum_t valA = accum_t (valuesA(j));
+      const size_type rowBegin = row_mapB(rowB);
+      const lno_t left_work = row_mapB(rowB + 1) - rowBegin;
+      Kokkos::parallel_for( Kokkos::ThreadVectorRange(teamMember, left_work), [&] (lno_t i) {
+        const size_type adjind = i + rowBegin;
+        const lno_t b_col = entriesB[adjind];
+        lno_t hash = b_col & hash_func;
+        //the row of C has room for the distinct columns, the insertion cannot fail.
+        hm.vector_atomic_insert_into_hash_mergeAdd(
+            teamMember, vector_size,
+            hash, b_col, accum_t (valuesB[adjind]) * valA,
+            used_size, max_row_keys);
+      });
+    }
+    const lno_t num_used = used_size[0];
+    if (sort_rows){
+      Kokkos::single(Kokkos::PerThread(teamMember),[&] () {
+        spgemm_heap_sort_row(row_keys, row_values, num_used);
+      });
+      Kokkos::parallel_for( Kokkos::ThreadVectorRange(teamMember, num_used), [&] (lno_t i) {
+        entriesC(c_row_begin + i) = row_keys[i];
+        valuesC(c_row_begin + i) = scalar_t (row_values[i]);
+      });
+    }
+    else if (values_in_memory){
+      Kokkos::parallel_for( Kokkos::ThreadVectorRange(teamMember, num_used), [&] (lno_t i) {
+        valuesC(c_row_begin + i) = scalar_t (row_values[i]);
+      });
+    }
+    if (row_nnz.extent(0)){
+      Kokkos::single(Kokkos::PerThread(teamMember),[&] () {
+        row_nnz(row_index) = num_used;
+      });
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const MediumTag&, const team_member_t & teamMember) const {
+    lno_t *all_shared_memory = (lno_t *) (teamMember.team_shmem().get_shmem(shared_memory_size));
+    all_shared_memory += thread_shmem_units * teamMember.team_rank();
+
+    const lno_t ii = teamMember.league_rank() * teamMember.team_size() + teamMember.team_rank();
+    if (ii >= bin_size) return;
+    const lno_t row_index = bin_rows(bin_begin + ii);
+    hash_row(teamMember, row_index, all_shared_memory, thread_shmem_hash_size, thread_shmem_key_size);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const HugeClassTag&, const lno_t &ii) const {
+    const lno_t row_index = bin_rows(bin_begin + ii);
+    const lno_t key_size = huge_key_size(row_mapC(row_index + 1) - row_mapC(row_index));
+    const int size_class = pool_memory_space::get_size_class(
+        row_memory_units(huge_hash_size(key_size), key_size), huge_min_chunk_size);
+    Kokkos::atomic_fetch_add(&(huge_class_counts(size_class)), lno_t(1));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const HugeTag&, const team_member_t & teamMember) const {
+    const lno_t ii = teamMember.league_rank() * teamMember.team_size() + teamMember.team_rank();
+    if (ii >= bin_size) return;
+    const lno_t row_index = bin_rows(bin_begin + ii);
+    const lno_t key_size = huge_key_size(row_mapC(row_index + 1) - row_mapC(row_index));
+    const lno_t hash_size = huge_hash_size(key_size);
+    const size_t chunk_units = row_memory_units(hash_size, key_size);
+
+    volatile lno_t * tmp = NULL;
+    while (tmp == NULL){
+      Kokkos::single(Kokkos::PerThread(teamMember),[&] (volatile lno_t * &memptr) {
+        memptr = (volatile lno_t * )( memory_space.allocate_chunk(chunk_units));
+      }, tmp);
+    }
+    hash_row(teamMember, row_index, (lno_t *) tmp, hash_size, key_size);
+    Kokkos::single(Kokkos::PerThread(teamMember),[&] () {
+      memory_space.release_chunk((lno_t *) tmp);
+    });
+  }
+
+  size_t team_shmem_size (int team_size) const {
+    return shared_memory_size;
+  }
+};
+
+/**
+ * \brief Numeric phase of C = A*B with the rows binned by their work.
+ * The pattern sizes of C must be known from a symbolic call, unless row_nnz
+ * is given: then row_mapC only needs to bound the rows of C, e.g. by the
+ * multiplications of the rows, and the row sizes are written to row_nnz.
+ * The rows are first assigned to the tiny, medium and huge bins, and each bin
+ * is computed by its own kernel, so that a few long rows do not determine the
+ * resources of all rows as in the single kernel of kkmem.
+ * The products are summed in accum_t, see spgemm_numeric_binned.
+ */
+template <typename accum_t, bool linear_probing, typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename b_row_view_t, typename b_nnz_view_t, typename b_scalar_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t>
+void spgemm_numeric_binned_accumulate(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t n,
+    typename KernelHandle::nnz_lno_t k,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA, a_scalar_view_t valuesA,
+    b_row_view_t row_mapB, b_nnz_view_t entriesB, b_scalar_view_t valuesB,
+    c_row_view_t row_mapC, c_nnz_view_t entriesC, c_scalar_view_t valuesC,
+    typename KernelHandle::nnz_lno_temp_work_view_t row_nnz){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::nnz_scalar_t scalar_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::HandleTempMemorySpace MyTempMemorySpace;
+  typedef typename KernelHandle::nnz_lno_temp_work_view_t bin_view_t;
+  typedef typename Kokkos::TeamPolicy<MyExecSpace>::member_type team_member_t;
+  typedef KokkosKernels::Impl::MultiSizeMemoryPool<MyTempMemorySpace, nnz_lno_t> pool_memory_space;
+
+  typedef SpgemmRowBinFunctor<size_type, nnz_lno_t,
+      a_row_view_t, a_nnz_view_t, b_row_view_t, c_row_view_t, bin_view_t> bin_functor_t;
+  typedef SpgemmBinnedNumericFunctor<size_type, nnz_lno_t, scalar_t, accum_t, linear_probing,
+      a_row_view_t, a_nnz_view_t, a_scalar_view_t,
+      b_row_view_t, b_nnz_view_t, b_scalar_view_t,
+      c_row_view_t, c_nnz_view_t, c_scalar_view_t,
+      bin_view_t, pool_memory_space, team_member_t> numeric_functor_t;
+
+  typedef Kokkos::RangePolicy<typename bin_functor_t::CountTag, MyExecSpace> count_policy_t;
+  typedef Kokkos::RangePolicy<typename bin_functor_t::FillTag, MyExecSpace> fill_policy_t;
+  typedef Kokkos::RangePolicy<typename numeric_functor_t::TinyTag, MyExecSpace> tiny_policy_t;
+  typedef Kokkos::TeamPolicy<typename numeric_functor_t::MediumTag, MyExecSpace> medium_policy_t;
+  typedef Kokkos::RangePolicy<typename numeric_functor_t::HugeClassTag, MyExecSpace> huge_class_policy_t;
+  typedef Kokkos::TeamPolicy<typename numeric_functor_t::HugeTag, MyExecSpace> huge_policy_t;
+
+  if (m == 0) return;
+  Kokkos::Impl::Timer timer1;
+
+  const size_type brows = row_mapB.extent(0) - 1;
+  const size_type bnnz = entriesB.extent(0);
+  const int suggested_vector_size = handle->get_suggested_vector_size(brows, bnnz);
+  const int suggested_team_size = handle->get_suggested_team_size(suggested_vector_size);
+
+  //shared memory of a thread: 2 units for the used size, begins and nexts of the hashmap.
+  //To sort the rows, the values and keys of the row are held in shared memory as well,
+  //the values first so that they stay aligned. The values are also held in shared
+  //memory if they are accumulated in a different type than the values of C.
+  const bool sort_rows = handle->get_spgemm_handle()->get_sort_output_rows();
+  const bool accumulate_in_c = std::is_same<accum_t, scalar_t>::value;
+  const bool values_in_shmem = sort_rows || !accumulate_in_c;
+  const nnz_lno_t scalar_units = (sizeof(accum_t) + sizeof(nnz_lno_t) - 1) / sizeof(nnz_lno_t);
+  nnz_lno_t thread_shmem_units = (handle->get_shmem_size() / suggested_team_size) / sizeof(nnz_lno_t);
+  thread_shmem_units = (thread_shmem_units / scalar_units) * scalar_units;
+  //with linear probing there are no nexts, and the hash size is twice the keys.
+  const nnz_lno_t units_per_key = (linear_probing ? 0 : 1) + (sort_rows ? 1 : 0) +
+      (values_in_shmem ? scalar_units : 0);
+  nnz_lno_t thread_shmem_hash_size = 1;
+  nnz_lno_t medium_row_nnz = 0;
+  if (linear_probing){
+    while (thread_shmem_hash_size * (2 + units_per_key) <= thread_shmem_units - 2){
+      thread_shmem_hash_size *= 2;
+    }
+    medium_row_nnz = thread_shmem_hash_size / 2;
+  }
+  else {
+    while (thread_shmem_hash_size * 4 * units_per_key <= thread_shmem_units - 2){
+      thread_shmem_hash_size *= 2;
+    }
+    medium_row_nnz = (thread_shmem_units - 2 - thread_shmem_hash_size) / units_per_key;
+  }
+  if (medium_row_nnz < 0) medium_row_nnz = 0;
+  const size_t shared_memory_size = size_t (thread_shmem_units) * suggested_team_size * sizeof(nnz_lno_t);
+  const size_type tiny_row_flops = SPGEMM_TINY_ROW_FLOPS;
+
+  bin_view_t bin_offsets("spgemm bin offsets", SPGEMM_NUM_BINS);
+  bin_view_t bin_rows(Kokkos::ViewAllocateWithoutInitializing("spgemm bin rows"), m);
+  bin_functor_t bf(row_mapA, entriesA, row_mapB, row_mapC, bin_offsets, bin_rows,
+      tiny_row_flops, medium_row_nnz);
+
+  Kokkos::parallel_for("KokkosSparse::spgemm_binned::CountBins", count_policy_t(0, m), bf);
+  MyExecSpace::fence();
+
+  typename bin_view_t::HostMirror h_bin_offsets = Kokkos::create_mirror_view(bin_offsets);
+  Kokkos::deep_copy(h_bin_offsets, bin_offsets);
+  nnz_lno_t bin_sizes[SPGEMM_NUM_BINS], bin_begins[SPGEMM_NUM_BINS];
+  nnz_lno_t bin_begin = 0;
+  for (int i = 0; i < SPGEMM_NUM_BINS; ++i){
+    bin_sizes[i] = h_bin_offsets(i);
+    bin_begins[i] = bin_begin;
+    h_bin_offsets(i) = bin_begin;
+    bin_begin += bin_sizes[i];
+  }
+  Kokkos::deep_copy(bin_offsets, h_bin_offsets);
+  Kokkos::parallel_for("KokkosSparse::spgemm_binned::FillBins", fill_policy_t(0, m), bf);
+  MyExecSpace::fence();
+
+  numeric_functor_t nf(
+      row_mapA, entriesA, valuesA,
+      row_mapB, entriesB, valuesB,
+      row_mapC, entriesC, valuesC,
+      bin_rows, row_nnz, k,
+      suggested_vector_size, thread_shmem_units, thread_shmem_hash_size,
+      medium_row_nnz, scalar_units, values_in_shmem,
+      shared_memory_size, sort_rows);
+
+  //the huge rows get a chunk of the size class of their hashmap, the pool has as many
+  //chunks of a class as the rows needing it, up to the rows computed at once.
+  if (bin_sizes[SPGEMM_BIN_HUGE] > 0){
+    Kokkos::Impl::Timer timer2;
+    //chunks are multiples of the units of accum_t to keep the values aligned.
+    size_t huge_min_chunk_size = nf.row_memory_units(
+        numeric_functor_t::huge_hash_size(medium_row_nnz + 1), medium_row_nnz + 1);
+    huge_min_chunk_size = ((huge_min_chunk_size + scalar_units - 1) / scalar_units) * scalar_units;
+    const int num_classes = pool_memory_space::get_size_class(
+        nf.row_memory_units(numeric_functor_t::huge_hash_size(k), k), huge_min_chunk_size) + 1;
+
+    nf.huge_min_chunk_size = huge_min_chunk_size;
+    nf.bin_begin = bin_begins[SPGEMM_BIN_HUGE];
+    nf.huge_class_counts = bin_view_t("spgemm huge class counts", num_classes);
+    Kokkos::parallel_for("KokkosSparse::spgemm_binned::HugeClasses",
+        huge_class_policy_t(0, bin_sizes[SPGEMM_BIN_HUGE]), nf);
+    typename bin_view_t::HostMirror h_class_counts = Kokkos::create_mirror_view(nf.huge_class_counts);
+    Kokkos::deep_copy(h_class_counts, nf.huge_class_counts);
+
+    size_t max_concurrent_rows = MyExecSpace::concurrency() / suggested_vector_size;
+    if (max_concurrent_rows == 0) max_concurrent_rows = 1;
+    std::vector<size_t> num_class_chunks(num_classes);
+    size_t pool_bytes = 0;
+    for (int c = 0; c < num_classes; ++c){
+      num_class_chunks[c] = KOKKOSKERNELS_MACRO_MIN(max_concurrent_rows, size_t (h_class_counts(c)));
+      pool_bytes += num_class_chunks[c] * (huge_min_chunk_size << c) * sizeof(nnz_lno_t);
+    }
+#if defined( KOKKOS_ENABLE_CUDA )
+    if (handle->get_handle_exec_space() == KokkosKernels::Impl::Exec_CUDA) {
+      size_t free_byte ;
+      size_t total_byte ;
+      cudaMemGetInfo( &free_byte, &total_byte ) ;
+      //keep a chunk of each needed class, rows of a class can use larger chunks.
+      bool reduced = true;
+      while (pool_bytes > free_byte / 2 && reduced){
+        reduced = false;
+        pool_bytes = 0;
+        for (int c = 0; c < num_classes; ++c){
+          if (num_class_chunks[c] > 1){
+            num_class_chunks[c] /= 2;
+            reduced = true;
+          }
+          pool_bytes += num_class_chunks[c] * (huge_min_chunk_size << c) * sizeof(nnz_lno_t);
+        }
+      }
+    }
+#endif
+    nf.memory_space = pool_memory_space(huge_min_chunk_size, num_class_chunks, -1);
+    MyExecSpace::fence();
+    handle->get_spgemm_handle()->record_pool_stats(
+        true, timer2.seconds(), nf.memory_space.get_num_chunks(), pool_bytes);
+    if (handle->get_verbose()){
+      std::cout << "\tspgemm_binned huge pool classes:" << num_classes
+                << " min_chunk_size:" << huge_min_chunk_size
+                << " pool size(MB):" << pool_bytes / 1024. / 1024. << std::endl;
+    }
+  }
+
+  if (handle->get_verbose()){
+    std::cout << "\tspgemm_binned tiny rows:" << bin_sizes[SPGEMM_BIN_TINY]
+              << " medium rows:" << bin_sizes[SPGEMM_BIN_MEDIUM]
+              << " huge rows:" << bin_sizes[SPGEMM_BIN_HUGE]
+              << " medium_row_nnz:" << medium_row_nnz
+              << " vector_size:" << suggested_vector_size
+              << " team_size:" << suggested_team_size
+              << " binning time:" << timer1.seconds() << std::endl;
+  }
+
+  Kokkos::Impl::Timer timer3;
+  if (bin_sizes[SPGEMM_BIN_TINY] > 0){
+    nf.bin_begin = bin_begins[SPGEMM_BIN_TINY];
+    nf.bin_size = bin_sizes[SPGEMM_BIN_TINY];
+    Kokkos::parallel_for("KokkosSparse::spgemm_binned::Tiny",
+        tiny_policy_t(0, bin_sizes[SPGEMM_BIN_TINY]), nf);
+  }
+  if (bin_sizes[SPGEMM_BIN_MEDIUM] > 0){
+    nf.bin_begin = bin_begins[SPGEMM_BIN_MEDIUM];
+    nf.bin_size = bin_sizes[SPGEMM_BIN_MEDIUM];
+    Kokkos::parallel_for("KokkosSparse::spgemm_binned::Medium",
+        medium_policy_t(bin_sizes[SPGEMM_BIN_MEDIUM] / suggested_team_size + 1,
+            suggested_team_size, suggested_vector_size), nf);
+  }
+  if (bin_sizes[SPGEMM_BIN_HUGE] > 0){
+    nf.bin_begin = bin_begins[SPGEMM_BIN_HUGE];
+    nf.bin_size = bin_sizes[SPGEMM_BIN_HUGE];
+    Kokkos::parallel_for("KokkosSparse::spgemm_binned::Huge",
+        huge_policy_t(bin_sizes[SPGEMM_BIN_HUGE] / suggested_team_size + 1,
+            suggested_team_size, suggested_vector_size), nf);
+  }
+  MyExecSpace::fence();
+
+  if (handle->get_spgemm_handle()->get_collect_stats()){
+    handle->get_spgemm_handle()->stats.numeric_kernel_time += timer3.seconds();
+  }
+  if (handle->get_verbose()){
+    std::cout << "\tspgemm_binned numeric time:" << timer1.seconds() << std::endl;
+  }
+}
+
+/**
+ * \brief Numeric phase of C = A*B with the rows binned by their work,
+ * see spgemm_numeric_binned_accumulate.
+ * If the handle asks for high precision accumulation, the products of float
+ * values are summed in double, and the sums are rounded when C is written,
+ * so that the values of A, B and C can be stored in single precision.
+ * If the handle asks for the linear probing accumulator, the hashmaps of the
+ * medium and huge rows use open addressing.
+ */
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename b_row_view_t, typename b_nnz_view_t, typename b_scalar_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t>
+void spgemm_numeric_binned(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t n,
+    typename KernelHandle::nnz_lno_t k,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA, a_scalar_view_t valuesA,
+    b_row_view_t row_mapB, b_nnz_view_t entriesB, b_scalar_view_t valuesB,
+    c_row_view_t row_mapC, c_nnz_view_t entriesC, c_scalar_view_t valuesC,
+    typename KernelHandle::nnz_lno_temp_work_view_t row_nnz =
+        typename KernelHandle::nnz_lno_temp_work_view_t()){
+  typedef typename KernelHandle::nnz_scalar_t scalar_t;
+  typedef typename SpgemmHighPrecisionScalar<scalar_t>::type high_precision_t;
+
+  const bool high_precision = handle->get_spgemm_handle()->get_high_precision_accumulation();
+  const bool linear_probing = handle->get_spgemm_handle()->get_linear_probing_accumulator();
+
+  if (high_precision && linear_probing){
+    spgemm_numeric_binned_accumulate<high_precision_t, true>(
+        handle, m, n, k,
+        row_mapA, entriesA, valuesA,
+        row_mapB, entriesB, valuesB,
+        row_mapC, entriesC, valuesC, row_nnz);
+  }
+  else if (high_precision){
+    spgemm_numeric_binned_accumulate<high_precision_t, false>(
+        handle, m, n, k,
+        row_mapA, entriesA, valuesA,
+        row_mapB, entriesB, valuesB,
+        row_mapC, entriesC, valuesC, row_nnz);
+  }
+  else if (linear_probing){
+    spgemm_numeric_binned_accumulate<scalar_t, true>(
+        handle, m, n, k,
+        row_mapA, entriesA, valuesA,
+        row_mapB, entriesB, valuesB,
+        row_mapC, entriesC, valuesC, row_nnz);
+  }
+  else {
+    spgemm_numeric_binned_accumulate<scalar_t, false>(
+        handle, m, n, k,
+        row_mapA, entriesA, valuesA,
+        row_mapB, entriesB, valuesB,
+        row_mapC, entriesC, valuesC, row_nnz);
+  }
+}
+
+}
+}
+#endif
@@ -399,15 +399,15 @@ void
       switch (spgemm_algorithm_){
       default:
       case SPGEMM_KK_COLOR:
-        Kokkos::parallel_for( dynamic_team_numeric1_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
+        Kokkos::parallel_for( "KokkosSparse::spgemm_color::Numeric1", dynamic_team_numeric1_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
             suggested_team_size, suggested_vector_size), sc);
         break;
       case SPGEMM_KK_MULTICOLOR2:
-        Kokkos::parallel_for( dynamic_team_numeric2_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
+        Kokkos::parallel_for( "KokkosSparse::spgemm_color::Numeric2", dynamic_team_numeric2_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
             suggested_team_size, suggested_vector_size), sc);
         break;
       case SPGEMM_KK_MULTICOLOR:
-        Kokkos::parallel_for( dynamic_team_numeric3_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
+        Kokkos::parallel_for( "KokkosSparse::spgemm_color::Numeric3", dynamic_team_numeric3_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
             suggested_team_size, suggested_vector_size), sc);
         break;
       }
@@ -416,15 +416,15 @@ void
       switch (spgemm_algorithm_){
       default:
       case SPGEMM_KK_COLOR:
-        Kokkos::parallel_for( team_numeric1_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
+        Kokkos::parallel_for( "KokkosSparse::spgemm_color::Numeric1", team_numeric1_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
             suggested_team_size, suggested_vector_size), sc);
         break;
       case SPGEMM_KK_MULTICOLOR2:
-        Kokkos::parallel_for( team_numeric2_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
+        Kokkos::parallel_for( "KokkosSparse::spgemm_color::Numeric2", team_numeric2_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
             suggested_team_size, suggested_vector_size), sc);
         break;
       case SPGEMM_KK_MULTICOLOR:
-        Kokkos::parallel_for( team_numeric3_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
+        Kokkos::parallel_for( "KokkosSparse::spgemm_color::Numeric3", team_numeric3_policy_t((color_end - color_begin) / team_row_chunk_size + 1 ,
             suggested_team_size, suggested_vector_size), sc);
         break;
       }
@@ -491,7 +491,8 @@ void
       suggested_vector_size,
       suggested_team_size,
       team_row_chunk_size,
-      use_dynamic_schedule);
+      use_dynamic_schedule,
+      this->handle->get_workspace());
 
     MyExecSpace::fence();
   }
@@ -747,6 +747,40 @@ struct KokkosSPGEMM
 
   };
 
+template <typename HandleType,
+typename a_row_view_t_, typename a_lno_nnz_view_t_, typename a_scalar_nnz_view_t_,
+typename b_lno_row_view_t_, typename b_lno_nnz_view_t_, typename b_scalar_nnz_view_t_  >
+template <typename b_row_begin_view_t, typename b_row_end_view_t>
+bool KokkosSPGEMM
+  <HandleType, a_row_view_t_, a_lno_nnz_view_t_, a_scalar_nnz_view_t_,
+    b_lno_row_view_t_, b_lno_nnz_view_t_, b_scalar_nnz_view_t_>::
+    compression_reduces_flops(
+    b_row_begin_view_t new_row_mapB_begin,
+    b_row_end_view_t new_row_mapB_end){
+  double min_reduction = this->handle->get_spgemm_handle()->get_compression_cut_off();
+  size_t OriginaltotalFlops = this->handle->get_spgemm_handle()->original_overall_flops;
+
+  nnz_lno_t compressed_maxNumRoughZeros = 0;
+  size_t compressedoverall_flops = 0;
+  Kokkos::Impl::Timer timer1_t;
+  KokkosKernels::Impl::WorkspaceScope<typename HandleType::WorkspaceType> workspace_scope(this->handle->get_workspace());
+  row_lno_temp_work_view_t compressed_flops_per_row =
+      this->handle->template get_workspace_view<row_lno_temp_work_view_t>("origianal row flops", a_row_cnt);
+
+  compressed_maxNumRoughZeros = this->getMaxRoughRowNNZ(a_row_cnt, row_mapA, entriesA, new_row_mapB_begin, new_row_mapB_end, compressed_flops_per_row.data());
+  KokkosKernels::Impl::kk_reduce_view2<row_lno_temp_work_view_t, MyExecSpace>(a_row_cnt, compressed_flops_per_row, compressedoverall_flops);
+  if (KOKKOSKERNELS_VERBOSE){
+    std::cout << "\t\tCompressed Max Row Flops:" << compressed_maxNumRoughZeros  << std::endl;
+    std::cout << "\t\tCompressed Overall Row Flops:" << compressedoverall_flops  << std::endl;
+    std::cout << "\t\tCompressed Flops ratio:" << compressedoverall_flops / ((double) (OriginaltotalFlops)) <<  " min_reduction:" << min_reduction  << std::endl;
+    std::cout << "\t\tCompressed Max Row Flop Calc Time:" << timer1_t.seconds()  << std::endl;
+  }
+
+  this->handle->get_spgemm_handle()->compressed_max_row_flops = compressed_maxNumRoughZeros;
+  this->handle->get_spgemm_handle()->compressed_overall_flops = compressedoverall_flops;
+  return compressedoverall_flops / ((double) (OriginaltotalFlops)) <= min_reduction;
+}
+
 template <typename HandleType,
 typename a_row_view_t_, typename a_lno_nnz_view_t_, typename a_scalar_nnz_view_t_,
 typename b_lno_row_view_t_, typename b_lno_nnz_view_t_, typename b_scalar_nnz_view_t_  >
@@ -765,6 +799,35 @@ bool KokkosSPGEMM
     bool compress_in_single_step){
   //get the execution space type.
   KokkosKernels::Impl::ExecSpaceType my_exec_space = this->handle->get_handle_exec_space();
+
+  //the compression only depends on the pattern of B. If the handle keeps the
+  //compressed B of the same pattern, only the flop reduction is checked.
+  //cuda always compresses in a single step.
+  const bool single_step_layout = compress_in_single_step || my_exec_space == KokkosKernels::Impl::Exec_CUDA;
+  const bool reuse_compressed_b = this->handle->get_spgemm_handle()->get_reuse_compressed_b();
+  uint64_t b_pattern_hash = 0;
+  if (reuse_compressed_b){
+    b_pattern_hash = KokkosKernels::Impl::kk_hash_graph<in_row_view_t, in_nnz_view_t, MyExecSpace>
+        (n, this->b_col_cnt, in_row_map, in_entries, KokkosKernels::Impl::kk_hash_mix(uint64_t(single_step_layout)));
+    row_lno_temp_work_view_t cached_row_map;
+    nnz_lno_temp_work_view_t cached_set_indices, cached_sets;
+    if (this->handle->get_spgemm_handle()->get_compressed_b_cache(
+            b_pattern_hash, cached_row_map, cached_set_indices, cached_sets) &&
+        cached_row_map.extent(0) == out_row_map.extent(0)){
+      if (KOKKOSKERNELS_VERBOSE){
+        std::cout << "\t\tReusing the compressed B of the handle" << std::endl;
+      }
+      Kokkos::deep_copy(out_row_map, cached_row_map);
+      out_nnz_indices = cached_set_indices;
+      out_nnz_sets = cached_sets;
+      if (single_step_layout){
+        return this->compression_reduces_flops(in_row_map, out_row_map);
+      }
+      return this->compression_reduces_flops(
+          Kokkos::subview (out_row_map, std::make_pair (nnz_lno_t(0), n)),
+          Kokkos::subview (out_row_map, std::make_pair (nnz_lno_t(1), n + 1)));
+    }
+  }
   //get the suggested vectorlane size based on the execution space, and average number of nnzs per row.
   int suggested_vector_size = this->handle->get_suggested_vector_size(n, nnz);
   //get the suggested team size.
@@ -833,9 +896,6 @@ bool KokkosSPGEMM
       ,suggested_team_size, KOKKOSKERNELS_VERBOSE,
       my_exec_space
   );
-  double min_reduction = this->handle->get_spgemm_handle()->get_compression_cut_off();
-  size_t OriginaltotalFlops = this->handle->get_spgemm_handle()->original_overall_flops;
-
   timer1.reset();
   //bool compression_applied = false;
   if (my_exec_space == KokkosKernels::Impl::Exec_CUDA){
@@ -945,33 +1005,12 @@ bool KokkosSPGEMM
       }
       KokkosKernels::Impl::exclusive_parallel_prefix_sum<out_rowmap_view_t, MyExecSpace> (n + 1, out_row_map);
 
-      {
-
-    	nnz_lno_t compressed_maxNumRoughZeros = 0;
-    	size_t compressedoverall_flops = 0;
-  		Kokkos::Impl::Timer timer1_t;
-  		auto new_row_mapB_begin = Kokkos::subview (out_row_map, std::make_pair (nnz_lno_t(0), b_row_cnt));
-  		auto new_row_mapB_end = Kokkos::subview (out_row_map, std::make_pair (nnz_lno_t(1), b_row_cnt + 1));
-  		row_lno_persistent_work_view_t compressed_flops_per_row(Kokkos::ViewAllocateWithoutInitializing("origianal row flops"), a_row_cnt);
-
-  		compressed_maxNumRoughZeros = this->getMaxRoughRowNNZ(a_row_cnt, row_mapA, entriesA, new_row_mapB_begin, new_row_mapB_end, compressed_flops_per_row.data());
-  		KokkosKernels::Impl::kk_reduce_view2<row_lno_persistent_work_view_t, MyExecSpace>(a_row_cnt, compressed_flops_per_row, compressedoverall_flops);
-  		if (KOKKOSKERNELS_VERBOSE){
-  			std::cout << "\t\tCompressed Max Row Flops:" << compressed_maxNumRoughZeros  << std::endl;
-  			std::cout << "\t\tCompressed Overall Row Flops:" << compressedoverall_flops  << std::endl;
-			std::cout << "\t\tCompressed Flops ratio:" << compressedoverall_flops / ((double) (OriginaltotalFlops)) <<  " min_reduction:" << min_reduction  << std::endl;
-  			std::cout << "\t\tCompressed Max Row Flop Calc Time:" << timer1_t.seconds()  << std::endl;
-  		}
-
-		this->handle->get_spgemm_handle()->compressed_max_row_flops = compressed_maxNumRoughZeros;
-		this->handle->get_spgemm_handle()->compressed_overall_flops = compressedoverall_flops;
-    	if (compressedoverall_flops / ((double) (OriginaltotalFlops)) > min_reduction) {
-    		return false;
-    	}
+      if (!this->compression_reduces_flops(
+              Kokkos::subview (out_row_map, std::make_pair (nnz_lno_t(0), b_row_cnt)),
+              Kokkos::subview (out_row_map, std::make_pair (nnz_lno_t(1), b_row_cnt + 1)))){
+        return false;
       }
 
-
-
       auto d_c_nnz_size = Kokkos::subview(out_row_map, n);
       auto h_c_nnz_size = Kokkos::create_mirror_view (d_c_nnz_size);
       Kokkos::deep_copy (h_c_nnz_size, d_c_nnz_size);
@@ -991,6 +1030,10 @@ bool KokkosSPGEMM
         Kokkos::parallel_for(  "KokkosSparse::TwoStepZipMatrix::fill::use_unordered_compress", team_fill2_policy_t(n / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sszm_compressMatrix);
       else
         Kokkos::parallel_for(  "KokkosSparse::TwoStepZipMatrix::fill::use_unordered_compress", team_fill_policy_t(n / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sszm_compressMatrix);
+      if (reuse_compressed_b){
+        this->handle->get_spgemm_handle()->set_compressed_b_cache(
+            b_pattern_hash, out_row_map, out_nnz_indices, out_nnz_sets);
+      }
       return true;
     }
     else {
@@ -1003,32 +1046,12 @@ bool KokkosSPGEMM
   if (KOKKOSKERNELS_VERBOSE){
     std::cout << "\t\tCompression Kernel time:" <<  timer1.seconds() << std::endl;
   }
-  {
-	  nnz_lno_t compressed_maxNumRoughZeros = 0;
-	  size_t compressedoverall_flops = 0;
-	  Kokkos::Impl::Timer timer1_t;
-	  auto new_row_mapB_begin = in_row_map;
-	  auto new_row_mapB_end = out_row_map;
-	  row_lno_persistent_work_view_t compressed_flops_per_row(Kokkos::ViewAllocateWithoutInitializing("origianal row flops"), a_row_cnt);
-
-	  compressed_maxNumRoughZeros = this->getMaxRoughRowNNZ(a_row_cnt, row_mapA, entriesA, new_row_mapB_begin, new_row_mapB_end, compressed_flops_per_row.data());
-	  KokkosKernels::Impl::kk_reduce_view2<row_lno_persistent_work_view_t, MyExecSpace>(a_row_cnt, compressed_flops_per_row, compressedoverall_flops);
-	  if (KOKKOSKERNELS_VERBOSE){
-		  std::cout << "\t\tCompressed Max Row Flops:" << compressed_maxNumRoughZeros  << std::endl;
-		  std::cout << "\t\tCompressed Overall Row Flops:" << compressedoverall_flops  << std::endl;
-		  std::cout << "\t\tCompressed Flops ratio:" << compressedoverall_flops / ((double) (OriginaltotalFlops)) <<  " min_reduction:" << min_reduction  << std::endl;
-
-
-		  std::cout << "\t\tCompressed Max Row Flop Calc Time:" << timer1_t.seconds()  << std::endl;
-	  }
-
-	  this->handle->get_spgemm_handle()->compressed_max_row_flops = compressed_maxNumRoughZeros;
-	  this->handle->get_spgemm_handle()->compressed_overall_flops = compressedoverall_flops;
-	  if (compressedoverall_flops / ((double) (OriginaltotalFlops)) > min_reduction) {
-		  return false;
-	  }
+  //the compressed B is kept even if it does not pay off for this A.
+  if (reuse_compressed_b){
+    this->handle->get_spgemm_handle()->set_compressed_b_cache(
+        b_pattern_hash, out_row_map, out_nnz_indices, out_nnz_sets);
   }
-  return true;
+  return this->compression_reduces_flops(in_row_map, out_row_map);
 
 }
 
@@ -129,7 +129,11 @@ void KokkosSPGEMM
     }
 
     //compressed B fields.
-    row_lno_temp_work_view_t new_row_mapB(Kokkos::ViewAllocateWithoutInitializing("new row map"), n+1);
+    //the row map of compressed B is only needed in this function,
+    //so it is taken from the workspace of the handle if it is created.
+    KokkosKernels::Impl::WorkspaceScope<typename HandleType::WorkspaceType> workspace_scope(this->handle->get_workspace());
+    row_lno_temp_work_view_t new_row_mapB =
+        this->handle->template get_workspace_view<row_lno_temp_work_view_t>("new row map", n+1);
     row_lno_temp_work_view_t new_row_mapB_begins;
 
     nnz_lno_temp_work_view_t set_index_entries; //will be output of compress matrix.
@@ -144,14 +148,22 @@ void KokkosSPGEMM
 
     //call compression.
     //it might not go through to the end if ratio is not high.
-    bool compression_applied = this->compressMatrix(n, nnz, this->row_mapB, this->entriesB,
+    //SPGEMM_KK_AUTO skips the compression if the sampled ratio is too low.
+    bool compression_applied = false;
+    if (!this->handle->get_spgemm_handle()->is_auto_select_algorithm() ||
+        this->handle->get_spgemm_handle()->get_auto_apply_compression()){
+      compression_applied = this->compressMatrix(n, nnz, this->row_mapB, this->entriesB,
     												new_row_mapB, set_index_entries, set_entries,
 													compress_in_single_step);
+    }
 
 
     if (KOKKOSKERNELS_VERBOSE){
       std::cout << "\t\tCOMPRESS MATRIX-B overall time:" << timer1.seconds() << std::endl << std::endl;
     }
+    if (this->handle->get_spgemm_handle()->get_collect_stats()){
+      this->handle->get_spgemm_handle()->stats.compression_time = timer1.seconds();
+    }
 
     timer1.reset();
 
@@ -199,6 +211,14 @@ void KokkosSPGEMM
 				rowmapC_, maxNumRoughZeros);
 
     }
+
+    //the numeric phase of KKMEM reads 32-bit copies of the row maps, built once here.
+    if (this->spgemm_algorithm == SPGEMM_KK_SPEED || this->spgemm_algorithm == SPGEMM_KK_DENSE){
+      this->handle->get_spgemm_handle()->reset_offsets32();
+    }
+    else {
+      this->KokkosSPGEMM_cache_offsets32(rowmapC_);
+    }
 #ifdef KOKKOSKERNELS_ANALYZE_MEMORYACCESS
     double read_write_cost = this->handle->get_spgemm_handle()->get_read_write_cost_calc();
     if (read_write_cost){
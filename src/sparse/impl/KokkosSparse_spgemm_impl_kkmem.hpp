@@ -739,7 +739,7 @@ struct KokkosSPGEMM
 			  nnz_lno_t search_end = team_cuckoo_key_size; //KOKKOSKERNELS_MACRO_MIN(team_cuckoo_key_size, hash + max_tries);
 			  for (nnz_lno_t trial = hash; trial < search_end; ){
 				  if (keys[trial] == my_b_col){
-					  Kokkos::atomic_add(vals + trial, my_b_val);
+					  KokkosKernels::Impl::kk_atomic_add(vals + trial, my_b_val);
 					  fail = 0;
 					  break;
 				  }
@@ -749,7 +749,7 @@ struct KokkosSPGEMM
 						  break;
 					  }
 					  else if (Kokkos::atomic_compare_exchange_strong(keys + trial, init_value, my_b_col)){
-						  Kokkos::atomic_add(vals + trial, my_b_val);
+						  KokkosKernels::Impl::kk_atomic_add(vals + trial, my_b_val);
 						  Kokkos::atomic_increment(used_hash_sizes);
 						  if (used_hash_sizes[0] > max_first_level_hash_size)  insert_is_on = false;
 						  fail = 0;
@@ -765,7 +765,7 @@ struct KokkosSPGEMM
 
 				  for (nnz_lno_t trial = 0; try_to_insert && trial < search_end; ){
 					  if (keys[trial] == my_b_col){
-						  Kokkos::atomic_add(vals + trial, my_b_val);
+						  KokkosKernels::Impl::kk_atomic_add(vals + trial, my_b_val);
 						  fail = 0;
 						  break;
 					  }
@@ -774,7 +774,7 @@ struct KokkosSPGEMM
 							  break;
 						  }
 						  else if (Kokkos::atomic_compare_exchange_strong(keys + trial, init_value, my_b_col)){
-							  Kokkos::atomic_add(vals + trial, my_b_val);
+							  KokkosKernels::Impl::kk_atomic_add(vals + trial, my_b_val);
 							  Kokkos::atomic_increment(used_hash_sizes);
 							  if (used_hash_sizes[0] > max_first_level_hash_size)  insert_is_on = false;
 							  fail = 0;
@@ -792,7 +792,7 @@ struct KokkosSPGEMM
 
 					  for (nnz_lno_t trial = new_hash; trial < pow2_hash_size; ){
 						  if (global_acc_row_keys[trial] == my_b_col){
-							  Kokkos::atomic_add(global_acc_row_vals + trial , my_b_val);
+							  KokkosKernels::Impl::kk_atomic_add(global_acc_row_vals + trial , my_b_val);
 
 							  //c_row_vals[trial] += my_b_val;
 							  fail = 0;
@@ -800,7 +800,7 @@ struct KokkosSPGEMM
 						  }
 						  else if (global_acc_row_keys[trial ] == init_value){
 							  if (Kokkos::atomic_compare_exchange_strong(global_acc_row_keys + trial , init_value, my_b_col)){
-								  Kokkos::atomic_add(global_acc_row_vals + trial , my_b_val);
+								  KokkosKernels::Impl::kk_atomic_add(global_acc_row_vals + trial , my_b_val);
 								  //Kokkos::atomic_increment(used_hash_sizes + 1);
 								  //c_row_vals[trial] = my_b_val;
 								  fail = 0;
@@ -815,14 +815,14 @@ struct KokkosSPGEMM
 						  for (nnz_lno_t trial = 0; trial < new_hash; ){
 							  if (global_acc_row_keys[trial ] == my_b_col){
 								  //c_row_vals[trial] += my_b_val;
-								  Kokkos::atomic_add(global_acc_row_vals + trial , my_b_val);
+								  KokkosKernels::Impl::kk_atomic_add(global_acc_row_vals + trial , my_b_val);
 
 								  break;
 							  }
 							  else if (global_acc_row_keys[trial ] == init_value){
 								  if (Kokkos::atomic_compare_exchange_strong(global_acc_row_keys + trial , init_value, my_b_col)){
 									  //Kokkos::atomic_increment(used_hash_sizes + 1);
-									  Kokkos::atomic_add(global_acc_row_vals + trial , my_b_val);
+									  KokkosKernels::Impl::kk_atomic_add(global_acc_row_vals + trial , my_b_val);
 									  //c_row_vals[trial] = my_b_val;
 									  break;
 								  }
@@ -1050,13 +1050,13 @@ struct KokkosSPGEMM
 			  for (nnz_lno_t trial = hash; trial < team_cuckoo_key_size; ){
 
 				  if (keys[trial] == my_b_col){
-					  Kokkos::atomic_add(vals + trial, my_b_val);
+					  KokkosKernels::Impl::kk_atomic_add(vals + trial, my_b_val);
 					  fail = 0;
 					  break;
 				  }
 				  else if (keys[trial] == init_value){
 					  if (Kokkos::atomic_compare_exchange_strong(keys + trial, init_value, my_b_col)){
-						  Kokkos::atomic_add(vals + trial, my_b_val);
+						  KokkosKernels::Impl::kk_atomic_add(vals + trial, my_b_val);
 						  fail = 0;
 						  break;
 					  }
@@ -1069,13 +1069,13 @@ struct KokkosSPGEMM
 				  for (nnz_lno_t trial = 0; trial < hash; ){
 
 					  if (keys[trial] == my_b_col){
-						  Kokkos::atomic_add(vals + trial, my_b_val);
+						  KokkosKernels::Impl::kk_atomic_add(vals + trial, my_b_val);
 						  fail = 0;
 						  break;
 					  }
 					  else if (keys[trial] == init_value){
 						  if (Kokkos::atomic_compare_exchange_strong(keys + trial, init_value, my_b_col)){
-							  Kokkos::atomic_add(vals + trial, my_b_val);
+							  KokkosKernels::Impl::kk_atomic_add(vals + trial, my_b_val);
 							  fail = 0;
 							  break;
 						  }
@@ -1131,7 +1131,7 @@ void
   nnz_lno_t brows = row_mapB.extent(0) - 1;
   size_type bnnz =  valsB.extent(0);
 
-  int suggested_vector_size = this->handle->get_suggested_vector_size(brows, bnnz);
+  int suggested_vector_size = this->handle->get_suggested_vector_size(brows, bnnz, row_mapB);
   int suggested_team_size = this->handle->get_suggested_team_size(suggested_vector_size);
   size_t shmem_size_to_use = shmem_size;
 
@@ -1260,7 +1260,9 @@ void
 		  bool run_dense = false;
 		  nnz_lno_t max_column_cut_off = this->handle->get_spgemm_handle()->MaxColDenseAcc;
 		  nnz_lno_t col_size = this->b_col_cnt;
-		  if (col_size < max_column_cut_off){
+		  //dense accumulators are not used if they do not fit into the memory budget.
+		  bool dense_fits = this->handle->get_spgemm_handle()->dense_accumulator_fits(col_size, this->concurrency);
+		  if (col_size < max_column_cut_off && dense_fits){
 			  run_dense = true;
 			  if (KOKKOSKERNELS_VERBOSE){
 				  std::cout << "\t\t\tRunning SPGEMM_KK_DENSE col_size:" << col_size << " max_column_cut_off:" << max_column_cut_off << std::endl;
@@ -1277,10 +1279,11 @@ void
 			  kkmem_chunksize += tmp_min_hash_size ; //this is for the hash begins
 			  kkmem_chunksize += max_nnz ; //this is for hash nexts
 			  kkmem_chunksize = kkmem_chunksize * sizeof (nnz_lno_t);
-			  size_t dense_chunksize = (col_size + col_size / sizeof(scalar_t) + 1) * sizeof(scalar_t);
+			  size_t dense_chunksize = KokkosKernels::Experimental::BitmapAccumulator
+			      <nnz_lno_t, nnz_lno_t, scalar_t>::get_memory_size(col_size) * sizeof(scalar_t);
 
 
-			  if (kkmem_chunksize >= dense_chunksize * 0.5){
+			  if (kkmem_chunksize >= dense_chunksize * 0.5 && dense_fits){
 				  run_dense = true;
 				  if (KOKKOSKERNELS_VERBOSE){
 					  std::cout << "\t\t\tRunning SPGEMM_KK_SPEED kkmem_chunksize:" << kkmem_chunksize << " dense_chunksize:" << dense_chunksize << std::endl;
@@ -1395,7 +1398,10 @@ void
   }
 
   Kokkos::Impl::Timer timer1;
-  pool_memory_space m_space(num_chunks, chunksize, -1,  my_pool_type);
+  //the hash begins of a chunk are at the offset given by the hash size and the algorithm.
+  pool_memory_space m_space = this->handle->get_memory_pool(
+      "KokkosSPGEMM_numeric_kkmem", size_t (min_hash_size) * 64 + algorithm_to_run,
+      num_chunks, chunksize, -1, my_pool_type);
   MyExecSpace::fence();
 
   if (KOKKOSKERNELS_VERBOSE){
@@ -1403,42 +1409,118 @@ void
     std::cout << "\t\tPool Size(MB):" <<
         sizeof (nnz_lno_t) * (num_chunks * chunksize) / 1024. / 1024.  << std::endl;
   }
+  this->handle->get_spgemm_handle()->record_pool_stats(
+      true, timer1.seconds(), num_chunks, sizeof (nnz_lno_t) * (num_chunks * chunksize));
 
-  PortableNumericCHASH<
-    const_a_lno_row_view_t, const_a_lno_nnz_view_t, const_a_scalar_nnz_view_t,
-    const_b_lno_row_view_t, const_b_lno_nnz_view_t, const_b_scalar_nnz_view_t,
-    c_row_view_t, c_lno_nnz_view_t, c_scalar_nnz_view_t,
-    pool_memory_space>
-  sc(
-      a_row_cnt,
-      row_mapA,
-      entriesA,
-      valsA,
-
-      row_mapB,
-      entriesB,
-      valsB,
-
-      rowmapC_,
-      entriesC_,
-      valuesC_,
-      shmem_size_to_use,
-      suggested_vector_size,
-      m_space,
-      min_hash_size, max_nnz,
-      suggested_team_size,
+  if (KOKKOSKERNELS_VERBOSE){
+    std::cout << "\t\tvector_size:" << suggested_vector_size  << " chunk_size:" << team_row_chunk_size << " suggested_team_size:" << suggested_team_size<< std::endl;
+  }
 
-      my_exec_space,
-      team_row_chunk_size,
-	  first_level_cut_off, flops_per_row,
-	  KOKKOSKERNELS_VERBOSE);
+  //64-bit offsets are read from 32-bit copies of the row maps when the nonzeros of A, B and C fit,
+  //which halves the offset traffic of every row of B visited. The accumulators already use nnz_lno_t.
+  //The copies are built by the symbolic phase and kept in the handle for every numeric call.
+  double numeric_time = 0;
+  typedef typename HandleType::SPGEMMHandleType::offset32_temp_work_view_t offset32_view_t;
+  typedef typename offset32_view_t::const_type const_offset32_view_t;
+  offset32_view_t row_mapA32, row_mapB32, rowmapC32;
+  if (this->handle->get_spgemm_handle()->get_offsets32(row_mapA32, row_mapB32, rowmapC32) ||
+      (this->KokkosSPGEMM_cache_offsets32(rowmapC_) &&
+       this->handle->get_spgemm_handle()->get_offsets32(row_mapA32, row_mapB32, rowmapC32))){
+    if (KOKKOSKERNELS_VERBOSE){
+      std::cout << "\t\tNumeric with 32-bit offsets" << std::endl;
+    }
 
+    PortableNumericCHASH<
+      const_offset32_view_t, const_a_lno_nnz_view_t, const_a_scalar_nnz_view_t,
+      const_offset32_view_t, const_b_lno_nnz_view_t, const_b_scalar_nnz_view_t,
+      const_offset32_view_t, c_lno_nnz_view_t, c_scalar_nnz_view_t,
+      pool_memory_space>
+    sc(
+        a_row_cnt,
+        row_mapA32,
+        entriesA,
+        valsA,
+
+        row_mapB32,
+        entriesB,
+        valsB,
+
+        rowmapC32,
+        entriesC_,
+        valuesC_,
+        shmem_size_to_use,
+        suggested_vector_size,
+        m_space,
+        min_hash_size, max_nnz,
+        suggested_team_size,
+
+        my_exec_space,
+        team_row_chunk_size,
+        first_level_cut_off, flops_per_row,
+        KOKKOSKERNELS_VERBOSE);
+    numeric_time = this->KokkosSPGEMM_numeric_hash_run(sc, algorithm_to_run, my_exec_space,
+        team_row_chunk_size, suggested_team_size, suggested_vector_size);
+  }
+  else {
+    PortableNumericCHASH<
+      const_a_lno_row_view_t, const_a_lno_nnz_view_t, const_a_scalar_nnz_view_t,
+      const_b_lno_row_view_t, const_b_lno_nnz_view_t, const_b_scalar_nnz_view_t,
+      c_row_view_t, c_lno_nnz_view_t, c_scalar_nnz_view_t,
+      pool_memory_space>
+    sc(
+        a_row_cnt,
+        row_mapA,
+        entriesA,
+        valsA,
+
+        row_mapB,
+        entriesB,
+        valsB,
+
+        rowmapC_,
+        entriesC_,
+        valuesC_,
+        shmem_size_to_use,
+        suggested_vector_size,
+        m_space,
+        min_hash_size, max_nnz,
+        suggested_team_size,
+
+        my_exec_space,
+        team_row_chunk_size,
+        first_level_cut_off, flops_per_row,
+        KOKKOSKERNELS_VERBOSE);
+    numeric_time = this->KokkosSPGEMM_numeric_hash_run(sc, algorithm_to_run, my_exec_space,
+        team_row_chunk_size, suggested_team_size, suggested_vector_size);
+  }
 
   if (KOKKOSKERNELS_VERBOSE){
-    std::cout << "\t\tvector_size:" << suggested_vector_size  << " chunk_size:" << team_row_chunk_size << " suggested_team_size:" << suggested_team_size<< std::endl;
+    std::cout << "\t\tNumeric TIME:" << numeric_time << std::endl;
+  }
+  if (this->handle->get_spgemm_handle()->get_collect_stats()){
+    this->handle->get_spgemm_handle()->stats.numeric_kernel_time += numeric_time;
   }
-  timer1.reset();
 
+}
+
+//launches the numeric functor of KokkosSPGEMM_numeric_hash, and returns the time of the kernel.
+template <typename HandleType,
+typename a_row_view_t_, typename a_lno_nnz_view_t_, typename a_scalar_nnz_view_t_,
+typename b_lno_row_view_t_, typename b_lno_nnz_view_t_, typename b_scalar_nnz_view_t_  >
+template <typename numeric_functor_t>
+double
+  KokkosSPGEMM
+  <HandleType, a_row_view_t_, a_lno_nnz_view_t_, a_scalar_nnz_view_t_,
+    b_lno_row_view_t_, b_lno_nnz_view_t_, b_scalar_nnz_view_t_>::
+    KokkosSPGEMM_numeric_hash_run(
+      const numeric_functor_t &sc,
+      KokkosSparse::SPGEMMAlgorithm algorithm_to_run,
+      KokkosKernels::Impl::ExecSpaceType my_exec_space,
+      nnz_lno_t team_row_chunk_size,
+      int suggested_team_size,
+      int suggested_vector_size){
+
+  Kokkos::Impl::Timer timer1;
   if (my_exec_space == KokkosKernels::Impl::Exec_CUDA){
 	  if (algorithm_to_run == SPGEMM_KK_MEMORY_SPREADTEAM){
 		  Kokkos::parallel_for("KOKKOSPARSE::SPGEMM::SPGEMM_KK_MEMORY_SPREADTEAM", gpu_team_policy4_t(a_row_cnt / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
@@ -1476,11 +1558,42 @@ void
 	  }
 	  MyExecSpace::fence();
   }
+  return timer1.seconds();
+}
 
-  if (KOKKOSKERNELS_VERBOSE){
-    std::cout << "\t\tNumeric TIME:" << timer1.seconds() << std::endl;
+//copies the row maps of A, B and C to 32-bit offsets kept in the handle when size_type is
+//64 bits and the nonzeros of A, B and C fit, returns false if they are not kept.
+template <typename HandleType,
+typename a_row_view_t_, typename a_lno_nnz_view_t_, typename a_scalar_nnz_view_t_,
+typename b_lno_row_view_t_, typename b_lno_nnz_view_t_, typename b_scalar_nnz_view_t_  >
+template <typename c_row_view_t>
+bool
+  KokkosSPGEMM
+  <HandleType, a_row_view_t_, a_lno_nnz_view_t_, a_scalar_nnz_view_t_,
+    b_lno_row_view_t_, b_lno_nnz_view_t_, b_scalar_nnz_view_t_>::
+    KokkosSPGEMM_cache_offsets32(c_row_view_t rowmapC_){
+
+  typedef typename HandleType::SPGEMMHandleType::offset32_temp_work_view_t offset32_view_t;
+  this->handle->get_spgemm_handle()->reset_offsets32();
+
+  nnz_lno_t brows = row_mapB.extent(0) - 1;
+  size_type bnnz = entriesB.extent(0);
+  size_type overall_nnz = this->handle->get_spgemm_handle()->get_c_nnz();
+  const size_t max_offset32 = std::numeric_limits<unsigned int>::max();
+  if (sizeof(size_type) <= sizeof(unsigned int) || size_t(entriesA.extent(0)) > max_offset32 ||
+      size_t(bnnz) > max_offset32 || size_t(overall_nnz) > max_offset32){
+    return false;
   }
 
+  offset32_view_t row_mapA32(Kokkos::ViewAllocateWithoutInitializing("row_mapA offsets"), a_row_cnt + 1);
+  offset32_view_t row_mapB32(Kokkos::ViewAllocateWithoutInitializing("row_mapB offsets"), brows + 1);
+  offset32_view_t rowmapC32(Kokkos::ViewAllocateWithoutInitializing("rowmapC offsets"), a_row_cnt + 1);
+  KokkosKernels::Impl::kk_copy_vector<const_a_lno_row_view_t, offset32_view_t, MyExecSpace>(a_row_cnt + 1, row_mapA, row_mapA32);
+  KokkosKernels::Impl::kk_copy_vector<const_b_lno_row_view_t, offset32_view_t, MyExecSpace>(brows + 1, row_mapB, row_mapB32);
+  KokkosKernels::Impl::kk_copy_vector<c_row_view_t, offset32_view_t, MyExecSpace>(a_row_cnt + 1, rowmapC_, rowmapC32);
+  MyExecSpace::fence();
+  this->handle->get_spgemm_handle()->set_offsets32(row_mapA32, row_mapB32, rowmapC32);
+  return true;
 }
 
 
@@ -1506,7 +1619,7 @@ void
   nnz_lno_t brows = row_mapB.extent(0) - 1;
   size_type bnnz =  valsB.extent(0);
 
-  int suggested_vector_size = this->handle->get_suggested_vector_size(brows, bnnz);
+  int suggested_vector_size = this->handle->get_suggested_vector_size(brows, bnnz, row_mapB);
   int suggested_team_size = this->handle->get_suggested_team_size(suggested_vector_size);
   nnz_lno_t team_row_chunk_size = this->handle->get_team_work_size(suggested_team_size,concurrency, a_row_cnt);
 
@@ -1539,7 +1652,9 @@ void
   }
 
   Kokkos::Impl::Timer timer1;
-  pool_memory_space m_space(num_chunks, chunksize, -1,  my_pool_type);
+  pool_memory_space m_space = this->handle->get_memory_pool(
+      "KokkosSPGEMM_numeric_hash2", min_hash_size,
+      num_chunks, chunksize, -1, my_pool_type);
   MyExecSpace::fence();
 
   if (KOKKOSKERNELS_VERBOSE){
@@ -1547,6 +1662,8 @@ void
     std::cout << "\t\tPool Size(MB):" <<
         sizeof (nnz_lno_t) * (num_chunks * chunksize) / 1024. / 1024.  << std::endl;
   }
+  this->handle->get_spgemm_handle()->record_pool_stats(
+      true, timer1.seconds(), num_chunks, sizeof (nnz_lno_t) * (num_chunks * chunksize));
   double first_level_cut_off  = this->handle->get_spgemm_handle()->get_first_level_hash_cut_off();
 
   PortableNumericCHASH<
@@ -1603,6 +1720,9 @@ void
   if (KOKKOSKERNELS_VERBOSE){
     std::cout << "\t\tNumeric TIME:" << timer1.seconds() << std::endl;
   }
+  if (this->handle->get_spgemm_handle()->get_collect_stats()){
+    this->handle->get_spgemm_handle()->stats.numeric_kernel_time += timer1.seconds();
+  }
 
 }
 
@@ -253,7 +253,7 @@ void KokkosSPGEMM
       team_row_chunk_size );
 
   //calculate how many flops per row is performed
-  Kokkos::parallel_reduce( team_count_policy_t(a_row_cnt / team_row_chunk_size  + 1 , suggested_team_size, suggested_vector_size), pcnnnz, overall_flops);
+  Kokkos::parallel_reduce( "KokkosSparse::spgemm_memaccess::Count", team_count_policy_t(a_row_cnt / team_row_chunk_size  + 1 , suggested_team_size, suggested_vector_size), pcnnnz, overall_flops);
   MyExecSpace::fence();
 
   //do a parallel prefix sum
@@ -276,7 +276,7 @@ void KokkosSPGEMM
 
   //fill the hypergraph values.
   //indices of nnzs for a and b nets, for c nets, the row and column index.
-  Kokkos::parallel_for( team_fill_policy_t(a_row_cnt / team_row_chunk_size  + 1 , suggested_team_size, suggested_vector_size), pcnnnz);
+  Kokkos::parallel_for( "KokkosSparse::spgemm_memaccess::Fill", team_fill_policy_t(a_row_cnt / team_row_chunk_size  + 1 , suggested_team_size, suggested_vector_size), pcnnnz);
   MyExecSpace::fence();
 }
 
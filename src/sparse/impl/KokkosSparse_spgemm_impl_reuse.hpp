@@ -0,0 +1,281 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_SPGEMM_IMPL_REUSE_HPP_
+#define KOKKOSSPARSE_SPGEMM_IMPL_REUSE_HPP_
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_Utils.hpp"
+
+namespace KokkosSparse{
+
+namespace Impl{
+
+/**
+ * \brief Writes the number of multiplications of each row of A*B to row_ptr.
+ * row_ptr(m) is set to 0 so that an exclusive prefix sum gives the offsets.
+ */
+template <typename size_type, typename lno_t,
+          typename a_row_view_t, typename a_nnz_view_t,
+          typename b_row_view_t, typename out_row_view_t>
+struct SpgemmRowMultiplicationCountFunctor{
+  lno_t m;
+  a_row_view_t row_mapA;
+  a_nnz_view_t entriesA;
+  b_row_view_t row_mapB;
+  out_row_view_t row_ptr;
+
+  SpgemmRowMultiplicationCountFunctor(
+      lno_t m_, a_row_view_t row_mapA_, a_nnz_view_t entriesA_,
+      b_row_view_t row_mapB_, out_row_view_t row_ptr_):
+    m(m_), row_mapA(row_mapA_), entriesA(entriesA_), row_mapB(row_mapB_), row_ptr(row_ptr_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t &i) const {
+    if (i == m) {
+      row_ptr(m) = 0;
+      return;
+    }
+    size_type row_flops = 0;
+    for (size_type j = row_mapA(i); j < row_mapA(i + 1); ++j){
+      const lno_t col = entriesA(j);
+      row_flops += row_mapB(col + 1) - row_mapB(col);
+    }
+    row_ptr(i) = row_flops;
+  }
+};
+
+/**
+ * \brief For each multiplication A(i,a)*B(a,b), finds the position of column b
+ * in row i of C. The multiplications of a row are enumerated in the order of
+ * the entries of A and B, which SpgemmContributionMapNumericFunctor repeats.
+ */
+template <typename size_type, typename lno_t,
+          typename a_row_view_t, typename a_nnz_view_t,
+          typename b_row_view_t, typename b_nnz_view_t,
+          typename c_row_view_t, typename c_nnz_view_t,
+          typename map_view_t>
+struct SpgemmContributionMapFunctor{
+  a_row_view_t row_mapA;
+  a_nnz_view_t entriesA;
+  b_row_view_t row_mapB;
+  b_nnz_view_t entriesB;
+  c_row_view_t row_mapC;
+  c_nnz_view_t entriesC;
+  map_view_t map_row_ptr;
+  map_view_t contribution_map;
+
+  SpgemmContributionMapFunctor(
+      a_row_view_t row_mapA_, a_nnz_view_t entriesA_,
+      b_row_view_t row_mapB_, b_nnz_view_t entriesB_,
+      c_row_view_t row_mapC_, c_nnz_view_t entriesC_,
+      map_view_t map_row_ptr_, map_view_t contribution_map_):
+    row_mapA(row_mapA_), entriesA(entriesA_),
+    row_mapB(row_mapB_), entriesB(entriesB_),
+    row_mapC(row_mapC_), entriesC(entriesC_),
+    map_row_ptr(map_row_ptr_), contribution_map(contribution_map_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t &i) const {
+    const size_type c_row_begin = row_mapC(i);
+    const size_type c_row_end = row_mapC(i + 1);
+    size_type f = map_row_ptr(i);
+    for (size_type j = row_mapA(i); j < row_mapA(i + 1); ++j){
+      const lno_t col = entriesA(j);
+      for (size_type z = row_mapB(col); z < row_mapB(col + 1); ++z){
+        const lno_t b_col = entriesB(z);
+        size_type pos = c_row_begin;
+        while (pos < c_row_end && entriesC(pos) != b_col) ++pos;
+        contribution_map(f++) = pos;
+      }
+    }
+  }
+};
+
+/**
+ * \brief Numeric phase with a contribution map: zeroes row i of C, then
+ * scatters the products of row i to the stored positions.
+ */
+template <typename size_type, typename lno_t,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename b_row_view_t, typename b_scalar_view_t,
+          typename c_row_view_t, typename c_scalar_view_t,
+          typename map_view_t>
+struct SpgemmContributionMapNumericFunctor{
+  typedef typename c_scalar_view_t::non_const_value_type scalar_t;
+
+  a_row_view_t row_mapA;
+  a_nnz_view_t entriesA;
+  a_scalar_view_t valuesA;
+  b_row_view_t row_mapB;
+  b_scalar_view_t valuesB;
+  c_row_view_t row_mapC;
+  c_scalar_view_t valuesC;
+  map_view_t map_row_ptr;
+  map_view_t contribution_map;
+
+  SpgemmContributionMapNumericFunctor(
+      a_row_view_t row_mapA_, a_nnz_view_t entriesA_, a_scalar_view_t valuesA_,
+      b_row_view_t row_mapB_, b_scalar_view_t valuesB_,
+      c_row_view_t row_mapC_, c_scalar_view_t valuesC_,
+      map_view_t map_row_ptr_, map_view_t contribution_map_):
+    row_mapA(row_mapA_), entriesA(entriesA_), valuesA(valuesA_),
+    row_mapB(row_mapB_), valuesB(valuesB_),
+    row_mapC(row_mapC_), valuesC(valuesC_),
+    map_row_ptr(map_row_ptr_), contribution_map(contribution_map_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t &i) const {
+    for (size_type pos = row_mapC(i); pos < row_mapC(i + 1); ++pos){
+      valuesC(pos) = Kokkos::Details::ArithTraits<scalar_t>::zero();
+    }
+    size_type f = map_row_ptr(i);
+    for (size_type j = row_mapA(i); j < row_mapA(i + 1); ++j){
+      const lno_t col = entriesA(j);
+      const scalar_t a_val = valuesA(j);
+      for (size_type z = row_mapB(col); z < row_mapB(col + 1); ++z){
+        valuesC(contribution_map(f++)) += a_val * valuesB(z);
+      }
+    }
+  }
+};
+
+/**
+ * \brief Builds the contribution map of C = A*B from the pattern of C computed
+ * by a numeric call, and stores it in the spgemm handle.
+ */
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t,
+          typename b_row_view_t, typename b_nnz_view_t,
+          typename c_row_view_t, typename c_nnz_view_t>
+void spgemm_build_contribution_map(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    a_row_view_t row_mapA,
+    a_nnz_view_t entriesA,
+    b_row_view_t row_mapB,
+    b_nnz_view_t entriesB,
+    c_row_view_t row_mapC,
+    c_nnz_view_t entriesC){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef Kokkos::RangePolicy<MyExecSpace> range_policy_t;
+  typedef typename KernelHandle::SPGEMMHandleType spgemmHandleType;
+  typedef typename spgemmHandleType::row_lno_persistent_work_view_t map_view_t;
+
+  spgemmHandleType *sh = handle->get_spgemm_handle();
+  Kokkos::Impl::Timer timer1;
+
+  map_view_t map_row_ptr(Kokkos::ViewAllocateWithoutInitializing("contribution map row ptr"), m + 1);
+  Kokkos::parallel_for("KokkosSparse::spgemm_contribution_map::RowCount",
+      range_policy_t(0, m + 1),
+      SpgemmRowMultiplicationCountFunctor<size_type, nnz_lno_t, a_row_view_t, a_nnz_view_t, b_row_view_t, map_view_t>(
+          m, row_mapA, entriesA, row_mapB, map_row_ptr));
+  KokkosKernels::Impl::exclusive_parallel_prefix_sum<map_view_t, MyExecSpace>(m + 1, map_row_ptr);
+  MyExecSpace::fence();
+
+  size_type num_multiplications = 0;
+  auto d_num_multiplications = Kokkos::subview(map_row_ptr, m);
+  auto h_num_multiplications = Kokkos::create_mirror_view(d_num_multiplications);
+  Kokkos::deep_copy(h_num_multiplications, d_num_multiplications);
+  num_multiplications = h_num_multiplications();
+
+  map_view_t contribution_map(Kokkos::ViewAllocateWithoutInitializing("contribution map"), num_multiplications);
+  Kokkos::parallel_for("KokkosSparse::spgemm_contribution_map::Fill",
+      range_policy_t(0, m),
+      SpgemmContributionMapFunctor<size_type, nnz_lno_t,
+        a_row_view_t, a_nnz_view_t, b_row_view_t, b_nnz_view_t,
+        c_row_view_t, c_nnz_view_t, map_view_t>(
+          row_mapA, entriesA, row_mapB, entriesB, row_mapC, entriesC,
+          map_row_ptr, contribution_map));
+  MyExecSpace::fence();
+
+  sh->set_contribution_map(map_row_ptr, contribution_map);
+  if (handle->get_verbose()){
+    std::cout << "\tContribution map size:" << num_multiplications
+              << " build time:" << timer1.seconds() << std::endl;
+  }
+}
+
+/**
+ * \brief Numeric phase of C = A*B using the contribution map stored in the
+ * spgemm handle. The pattern of A, B and C must be the one the map was built for.
+ */
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename b_row_view_t, typename b_scalar_view_t,
+          typename c_row_view_t, typename c_scalar_view_t>
+void spgemm_numeric_contribution_map(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    a_row_view_t row_mapA,
+    a_nnz_view_t entriesA,
+    a_scalar_view_t valuesA,
+    b_row_view_t row_mapB,
+    b_scalar_view_t valuesB,
+    c_row_view_t row_mapC,
+    c_scalar_view_t valuesC){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef Kokkos::RangePolicy<MyExecSpace> range_policy_t;
+  typedef typename KernelHandle::SPGEMMHandleType spgemmHandleType;
+  typedef typename spgemmHandleType::row_lno_persistent_work_view_t map_view_t;
+
+  spgemmHandleType *sh = handle->get_spgemm_handle();
+
+  Kokkos::parallel_for("KokkosSparse::spgemm_contribution_map::Numeric",
+      range_policy_t(0, m),
+      SpgemmContributionMapNumericFunctor<size_type, nnz_lno_t,
+        a_row_view_t, a_nnz_view_t, a_scalar_view_t,
+        b_row_view_t, b_scalar_view_t,
+        c_row_view_t, c_scalar_view_t, map_view_t>(
+          row_mapA, entriesA, valuesA, row_mapB, valuesB, row_mapC, valuesC,
+          sh->get_contribution_map_row_ptr(), sh->get_contribution_map()));
+  MyExecSpace::fence();
+}
+
+}
+}
+#endif
@@ -77,6 +77,7 @@ struct KokkosSPGEMM
   const KokkosKernels::Impl::ExecSpaceType my_exec_space;
   const nnz_lno_t team_work_size;
 
+  typedef KokkosKernels::Experimental::BitmapAccumulator<nnz_lno_t, nnz_lno_t, scalar_t> bitmap_accumulator_t;
 
   NumericCMEM_CPU(
       nnz_lno_t m_,
@@ -162,7 +163,8 @@ struct KokkosSPGEMM
     while (dense_accum == NULL){
       dense_accum = (scalar_t * )( memory_space.allocate_chunk(tid));
     }
-    char *marker = (char *) (dense_accum + numcols);
+    //the occupied columns are tracked by a bitmap after the dense values.
+    bitmap_accumulator_t accumulator(numcols, dense_accum, (unsigned *) (dense_accum + numcols));
 
     Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, team_row_begin, team_row_end), [&] (const nnz_lno_t& row_index) {
 
@@ -170,7 +172,6 @@ struct KokkosSPGEMM
       nnz_lno_t *myentries = pEntriesC + c_row_begin;
       scalar_t *myvals = pVals + c_row_begin;
 
-      nnz_lno_t current_col_index = 0;
       const size_type col_begin = row_mapA[row_index];
       const nnz_lno_t nnza = nnz_lno_t(row_mapA[row_index + 1] - col_begin);
 
@@ -185,19 +186,11 @@ struct KokkosSPGEMM
           const size_type adjind = i + rowBegin;
           nnz_lno_t b_col_ind = entriesB[adjind];
           scalar_t b_val = valuesB[adjind] * valA;
-          if (marker[b_col_ind] == 0){
-            marker[b_col_ind] = 1;
-            myentries[current_col_index++] = b_col_ind;
-          }
-          dense_accum[b_col_ind] += b_val;
+          accumulator.sequential_insert_mergeAdd(b_col_ind, b_val);
         }
       }
-      for (nnz_lno_t i = 0; i < current_col_index; ++i){
-        nnz_lno_t ind = myentries[i];
-        myvals[i] = dense_accum[ind];
-        dense_accum[ind] = 0;
-        marker [ind] = 0;
-      }
+      //only the set bits are visited, the row is written sorted.
+      accumulator.sequential_export_and_clear(myentries, myvals);
     });
 
   }
@@ -551,6 +544,9 @@ void
             sc);
     MyExecSpace::fence();
 
+    if (this->handle->get_spgemm_handle()->get_collect_stats()){
+      this->handle->get_spgemm_handle()->stats.numeric_kernel_time += timer1.seconds();
+    }
     if (KOKKOSKERNELS_VERBOSE){
       std::cout << "\t\tNumeric TIME:" << timer1.seconds() << std::endl;
     }
@@ -565,19 +561,24 @@ void
     KokkosKernels::Impl::PoolType my_pool_type =
         KokkosKernels::Impl::OneThread2OneChunk;
     int num_chunks = concurrency;
+    //dense values and the bitmap of the occupied columns, see BitmapAccumulator.
+    const size_t dense_chunk_size = KokkosKernels::Experimental::BitmapAccumulator
+        <nnz_lno_t, nnz_lno_t, scalar_t>::get_memory_size(this->b_col_cnt);
 
     Kokkos::Impl::Timer timer1;
     pool_memory_space m_space
-    (num_chunks, this->b_col_cnt + (this->b_col_cnt) / sizeof(scalar_t) + 1, 0,  my_pool_type);
+    (num_chunks, dense_chunk_size, 0,  my_pool_type);
     MyExecSpace::fence();
 
     if (KOKKOSKERNELS_VERBOSE){
       std::cout << "\t\tPool Alloc Time:" << timer1.seconds() << std::endl;
       std::cout << "\tPool Size(MB):" <<
-          sizeof(scalar_t) * (num_chunks *
-              (this->b_col_cnt + (this->b_col_cnt) / sizeof(scalar_t) + 1))
+          sizeof(scalar_t) * (num_chunks * dense_chunk_size)
               / 1024. / 1024.  << std::endl;
     }
+    this->handle->get_spgemm_handle()->record_pool_stats(
+        true, timer1.seconds(), num_chunks,
+        sizeof(scalar_t) * (num_chunks * dense_chunk_size));
 
     NumericCMEM_CPU<
     const_a_lno_row_view_t, const_a_lno_nnz_view_t, const_a_scalar_nnz_view_t,
@@ -620,6 +621,9 @@ void
 
     MyExecSpace::fence();
 
+    if (this->handle->get_spgemm_handle()->get_collect_stats()){
+      this->handle->get_spgemm_handle()->stats.numeric_kernel_time += timer1.seconds();
+    }
     if (KOKKOSKERNELS_VERBOSE){
       std::cout << "\t\tNumeric TIME:" << timer1.seconds() << std::endl;
       std::cout << "\t\tNumeric SPEED TIME:" << numeric_speed_timer.seconds() << std::endl;
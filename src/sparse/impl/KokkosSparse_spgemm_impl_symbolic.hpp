@@ -1582,7 +1582,9 @@ void KokkosSPGEMM
 			  nnz_lno_t max_column_cut_off = nnz_lno_t (this->handle->get_spgemm_handle()->MaxColDenseAcc);
 
 			  nnz_lno_t col_size = this->b_col_cnt;
-			  if (col_size < max_column_cut_off){
+			  //dense accumulators are not used if they do not fit into the memory budget.
+			  bool dense_fits = this->handle->get_spgemm_handle()->dense_accumulator_fits(col_size, this->concurrency);
+			  if (col_size < max_column_cut_off && dense_fits){
 				  current_spgemm_algorithm = SPGEMM_KK_DENSE;
 				  if (KOKKOSKERNELS_VERBOSE){
 					  std::cout << "\t\t\tRunning SPGEMM_KK_SPEED col_size:" << col_size << " max_column_cut_off:" << max_column_cut_off << std::endl;
@@ -1603,7 +1605,7 @@ void KokkosSPGEMM
 				  size_t dense_chunksize = col_size + maxNumRoughNonzeros;
 
 
-				  if (kkmem_chunksize >= dense_chunksize * 0.5){
+				  if (kkmem_chunksize >= dense_chunksize * 0.5 && dense_fits){
 					  current_spgemm_algorithm = SPGEMM_KK_DENSE;
 					  if (KOKKOSKERNELS_VERBOSE){
 						  std::cout << "\t\t\tRunning SPGEMM_KK_SPEED kkmem_chunksize:" << kkmem_chunksize << " dense_chunksize:" << dense_chunksize << std::endl;
@@ -1688,12 +1690,16 @@ void KokkosSPGEMM
 		std::cout << "\tPool Size (MB):" << (num_chunks * chunksize * sizeof(nnz_lno_t)) / 1024. / 1024. << " num_chunks:" << num_chunks << " chunksize:" << chunksize << std::endl;
 	}
 	Kokkos::Impl::Timer timer1;
-	pool_memory_space m_space(num_chunks, chunksize, pool_init_val,  my_pool_type);
+	pool_memory_space m_space = this->handle->get_memory_pool(
+			"KokkosSPGEMM_symbolic_structureC", size_t (min_hash_size) * 64 + current_spgemm_algorithm,
+			num_chunks, chunksize, pool_init_val, my_pool_type);
 	MyExecSpace::fence();
 
 	if (KOKKOSKERNELS_VERBOSE){
 		std::cout << "\tPool Alloc Time:" << timer1.seconds() << std::endl;
 	}
+	this->handle->get_spgemm_handle()->record_pool_stats(
+			false, timer1.seconds(), num_chunks, num_chunks * chunksize * sizeof(nnz_lno_t));
 
 	StructureC_NC
 	<a_r_view_t, a_nnz_view_t,
@@ -1761,6 +1767,9 @@ void KokkosSPGEMM
 	if (KOKKOSKERNELS_VERBOSE){
 		std::cout << "\tStructureC Kernel time:" << timer1.seconds() << std::endl<< std::endl;
 	}
+	if (this->handle->get_spgemm_handle()->get_collect_stats()){
+		this->handle->get_spgemm_handle()->stats.symbolic_hash_time += timer1.seconds();
+	}
 	// we need to find the max nnz in a row.
 	{
 		Kokkos::Impl::Timer timer1_;
@@ -1899,7 +1908,9 @@ void KokkosSPGEMM
 	  else {
 		  nnz_lno_t max_column_cut_off = nnz_lno_t(this->handle->get_spgemm_handle()->MaxColDenseAcc);
 		  nnz_lno_t col_size = this->b_col_cnt / (sizeof (nnz_lno_t) * 8)+ 1;
-		  if (col_size < max_column_cut_off){
+		  //dense accumulators are not used if they do not fit into the memory budget.
+		  bool dense_fits = this->handle->get_spgemm_handle()->dense_accumulator_fits(col_size, this->concurrency);
+		  if (col_size < max_column_cut_off && dense_fits){
 			  current_spgemm_algorithm = SPGEMM_KK_DENSE;
 			  if (KOKKOSKERNELS_VERBOSE){
 				  std::cout << "\t\t\tRunning SPGEMM_KK_SPEED col_size:" << col_size << " max_column_cut_off:" << max_column_cut_off << std::endl;
@@ -1920,7 +1931,7 @@ void KokkosSPGEMM
 			  size_t dense_chunksize = col_size + maxNumRoughNonzeros;
 
 
-			  if (kkmem_chunksize >= dense_chunksize * 0.5){
+			  if (kkmem_chunksize >= dense_chunksize * 0.5 && dense_fits){
 				  current_spgemm_algorithm = SPGEMM_KK_DENSE;
 				  if (KOKKOSKERNELS_VERBOSE){
 					  std::cout << "\t\t\tRunning SPGEMM_KK_SPEED kkmem_chunksize:" << kkmem_chunksize << " dense_chunksize:" << dense_chunksize << std::endl;
@@ -2015,12 +2026,16 @@ void KokkosSPGEMM
     std::cout << "\tPool Size (MB):" << (num_chunks * chunksize * sizeof(nnz_lno_t)) / 1024. / 1024. << " num_chunks:" << num_chunks << " chunksize:" << chunksize << std::endl;
   }
   Kokkos::Impl::Timer timer1;
-  pool_memory_space m_space(num_chunks, chunksize, pool_init_val,  my_pool_type);
+  pool_memory_space m_space = this->handle->get_memory_pool(
+      "KokkosSPGEMM_symbolic_structureC_hash", size_t (min_hash_size) * 64 + current_spgemm_algorithm,
+      num_chunks, chunksize, pool_init_val, my_pool_type);
   MyExecSpace::fence();
 
   if (KOKKOSKERNELS_VERBOSE){
     std::cout << "\tPool Alloc Time:" << timer1.seconds() << std::endl;
   }
+  this->handle->get_spgemm_handle()->record_pool_stats(
+      false, timer1.seconds(), num_chunks, num_chunks * chunksize * sizeof(nnz_lno_t));
 
   StructureC<a_r_view_t, a_nnz_view_t,
   b_original_row_view_t, b_compressed_row_view_t, b_nnz_view_t,
@@ -2088,6 +2103,9 @@ void KokkosSPGEMM
   if (KOKKOSKERNELS_VERBOSE){
     std::cout << "\tStructureC Kernel time:" << timer1.seconds() << std::endl<< std::endl;
   }
+  if (this->handle->get_spgemm_handle()->get_collect_stats()){
+    this->handle->get_spgemm_handle()->stats.symbolic_hash_time += timer1.seconds();
+  }
 
 
 #if 0
@@ -1469,7 +1469,9 @@ void KokkosSPGEMM
   }
 
   Kokkos::Impl::Timer timer1;
-  pool_memory_space m_space(num_chunks, accumulator_chunksize, pool_init_val,  my_pool_type);
+  pool_memory_space m_space = this->handle->get_memory_pool(
+      "KokkosSPGEMM_triangle", size_t (min_hash_size) * 2 + use_dense_accumulator,
+      num_chunks, accumulator_chunksize, pool_init_val, my_pool_type);
   MyExecSpace::fence();
   if (KOKKOSKERNELS_VERBOSE){
     std::cout << "\tPool Alloc Time:" << timer1.seconds() << std::endl;
@@ -1513,7 +1515,7 @@ void KokkosSPGEMM
 
   //nnz_lno_t runcuda = atoi(getenv("runcuda"));
   if (/*runcuda ||*/ MyEnumExecSpace == KokkosKernels::Impl::Exec_CUDA) {
-    Kokkos::parallel_for( gpu_team_policy_t(m / suggested_team_size + 1 , suggested_team_size, suggested_vector_size), sc);
+    Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::Cuda", gpu_team_policy_t(m / suggested_team_size + 1 , suggested_team_size, suggested_vector_size), sc);
   }
   else {
     if (!apply_compression){
@@ -1521,30 +1523,30 @@ void KokkosSPGEMM
       if (spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_AI ||
           spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_IA_UNION){
         if (use_dynamic_schedule){
-          Kokkos::parallel_for( nc_dynamic_multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::AI_NC", nc_dynamic_multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
 
         }
         else {
-          Kokkos::parallel_for( nc_multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::AI_NC", nc_multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
 
         }
       }
       else if (spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_IA){
         if (use_dynamic_schedule){
-          Kokkos::parallel_for( nc_dynamic_multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::IA_NC", nc_dynamic_multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
 
         }
         else {
-          Kokkos::parallel_for( nc_multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::IA_NC", nc_multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
       }
       else if (spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_LL || spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_LU){
         if (use_dynamic_schedule){
-          Kokkos::parallel_for( nc_dynamic_multicore_dense_team3_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::LL_NC", nc_dynamic_multicore_dense_team3_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
 
         }
         else {
-          Kokkos::parallel_for( nc_multicore_dense_team3_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::LL_NC", nc_multicore_dense_team3_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
       }
 
@@ -1555,30 +1557,30 @@ void KokkosSPGEMM
       if (spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_AI ||
           spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_IA_UNION){
         if (use_dynamic_schedule){
-          Kokkos::parallel_for( dynamic_multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::AI_Dense", dynamic_multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
 
         }
         else {
-          Kokkos::parallel_for( multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::AI_Dense", multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
 
         }
       }
       else if (spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_IA){
         if (use_dynamic_schedule){
-          Kokkos::parallel_for( dynamic_multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::IA_Dense", dynamic_multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
 
         }
         else {
-          Kokkos::parallel_for( multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::IA_Dense", multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
       }
       else if (spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_LL || spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_LU){
         if (use_dynamic_schedule){
-          Kokkos::parallel_for( dynamic_multicore_dense_team3_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::LL_Dense", dynamic_multicore_dense_team3_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
 
         }
         else {
-          Kokkos::parallel_for( multicore_dense_team3_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::LL_Dense", multicore_dense_team3_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
       }
 
@@ -1588,25 +1590,25 @@ void KokkosSPGEMM
       if (spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_AI ||
           spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_IA_UNION){
         if (use_dynamic_schedule){
-            Kokkos::parallel_for( dynamic_multicore_team_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+            Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::AI", dynamic_multicore_team_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
           }
           else {
-            Kokkos::parallel_for( multicore_team_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+            Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::AI", multicore_team_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
           }}
       else if (spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_IA){
         if (use_dynamic_schedule){
-          Kokkos::parallel_for( dynamic_multicore_team_policy2_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::IA", dynamic_multicore_team_policy2_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
         else {
-          Kokkos::parallel_for( multicore_team_policy2_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::IA", multicore_team_policy2_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
       }
       else if (spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_LL || spgemm_algorithm ==  SPGEMM_KK_TRIANGLE_LU){
         if (use_dynamic_schedule){
-          Kokkos::parallel_for( dynamic_multicore_team_policy3_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::LL", dynamic_multicore_team_policy3_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
         else {
-          Kokkos::parallel_for( multicore_team_policy3_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle::LL", multicore_team_policy3_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
       }
 
@@ -1007,7 +1007,9 @@ void KokkosSPGEMM
   }
 
   Kokkos::Impl::Timer timer1;
-  pool_memory_space m_space(num_chunks, accumulator_chunksize, pool_init_val,  my_pool_type);
+  pool_memory_space m_space = this->handle->get_memory_pool(
+      "KokkosSPGEMM_triangle_no_compression", size_t (min_hash_size) * 2 + use_dense_accumulator,
+      num_chunks, accumulator_chunksize, pool_init_val, my_pool_type);
   MyExecSpace::fence();
   if (KOKKOSKERNELS_VERBOSE){
     std::cout << "\tPool Alloc Time:" << timer1.seconds() << std::endl;
@@ -1052,7 +1054,7 @@ void KokkosSPGEMM
   //nnz_lno_t runcuda = atoi(getenv("runcuda"));
 
   if (/*runcuda ||*/ MyEnumExecSpace == KokkosKernels::Impl::Exec_CUDA) {
-    Kokkos::parallel_for( gpu_team_policy_t(m / suggested_team_size + 1 , suggested_team_size, suggested_vector_size), sc);
+    Kokkos::parallel_for( "KokkosSparse::spgemm_triangle_no_compression::Cuda", gpu_team_policy_t(m / suggested_team_size + 1 , suggested_team_size, suggested_vector_size), sc);
   }
   else {
     if (use_dense_accumulator){
@@ -1060,19 +1062,19 @@ void KokkosSPGEMM
           spgemm_algorithm == SPGEMM_KK_TRIANGLE_DENSE ||
           spgemm_algorithm == SPGEMM_KK_TRIANGLE_MEM){
         if (use_dynamic_schedule){
-          Kokkos::parallel_for( dynamic_multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle_no_compression::Dense", dynamic_multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
         else {
-          Kokkos::parallel_for( multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle_no_compression::Dense", multicore_dense_team_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
       }
       else {
         if (use_dynamic_schedule){
-          Kokkos::parallel_for( dynamic_multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle_no_compression::Dense2", dynamic_multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
 
         }
         else {
-          Kokkos::parallel_for( multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle_no_compression::Dense2", multicore_dense_team2_count_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
       }
     }
@@ -1083,17 +1085,17 @@ void KokkosSPGEMM
           spgemm_algorithm == SPGEMM_KK_TRIANGLE_DENSE ||
           spgemm_algorithm == SPGEMM_KK_TRIANGLE_MEM){
         if (use_dynamic_schedule){
-            Kokkos::parallel_for( dynamic_multicore_team_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+            Kokkos::parallel_for( "KokkosSparse::spgemm_triangle_no_compression::Hash", dynamic_multicore_team_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
           }
           else {
-            Kokkos::parallel_for( multicore_team_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+            Kokkos::parallel_for( "KokkosSparse::spgemm_triangle_no_compression::Hash", multicore_team_policy_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
           }}
       else {
         if (use_dynamic_schedule){
-          Kokkos::parallel_for( dynamic_multicore_team_policy2_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle_no_compression::Hash2", dynamic_multicore_team_policy2_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
         else {
-          Kokkos::parallel_for( multicore_team_policy2_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
+          Kokkos::parallel_for( "KokkosSparse::spgemm_triangle_no_compression::Hash2", multicore_team_policy2_t(m / team_row_chunk_size + 1 , suggested_team_size, suggested_vector_size), sc);
         }
       }
 
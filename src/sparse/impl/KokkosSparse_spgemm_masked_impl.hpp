@@ -0,0 +1,483 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_SPGEMM_MASKED_IMPL_HPP_
+#define KOKKOSSPARSE_SPGEMM_MASKED_IMPL_HPP_
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_HashmapAccumulator.hpp"
+#include "KokkosKernels_Uniform_Initialized_MemoryPool.hpp"
+#include "KokkosSparse_spgemm_triple_impl.hpp"
+
+namespace KokkosSparse{
+
+namespace Impl{
+
+/**
+ * \brief Computes C<M> = A*B, or C<!M> = A*B if complement is set.
+ * As in the triangle counting kernels, row i of the mask is inserted into a
+ * hashmap first, and the multiplications of row i of A*B are filtered with it.
+ * With the mask, only the columns of the mask row are accumulated, in the
+ * values of the mask hashmap. With the complement, the columns found in the
+ * mask row are skipped, and the others are accumulated in a second hashmap.
+ *
+ * The chunk of a thread holds, in nnz_lno_t units:
+ *   values of the mask hashmap (numeric with mask only), hit flags, used
+ *   hashes, begins, nexts and keys of the mask hashmap, and for the
+ *   complement used hashes, begins and nexts of the second hashmap and its
+ *   keys (symbolic only). In numeric the second hashmap writes to C.
+ */
+template <typename size_type, typename lno_t, typename scalar_t,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename b_row_view_t, typename b_nnz_view_t, typename b_scalar_view_t,
+          typename m_row_view_t, typename m_nnz_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t,
+          typename pool_memory_space, typename team_member_t>
+struct SpgemmMaskedFunctor{
+  struct SymbolicTag{};
+  struct NumericTag{};
+
+  lno_t m;
+  a_row_view_t row_mapA;
+  a_nnz_view_t entriesA;
+  a_scalar_view_t valuesA;
+  b_row_view_t row_mapB;
+  b_nnz_view_t entriesB;
+  b_scalar_view_t valuesB;
+  m_row_view_t row_mapM;
+  m_nnz_view_t entriesM;
+  c_row_view_t rowmapC;
+  c_nnz_view_t entriesC;
+  c_scalar_view_t valuesC;
+
+  pool_memory_space memory_space;
+  const bool complement;
+  const lno_t max_nnz_m, pow2_hash_size_m;
+  const lno_t max_nnz_c, pow2_hash_size_c;
+  const lno_t value_block_size;
+  const lno_t team_work_size;
+
+  SpgemmMaskedFunctor(
+      lno_t m_,
+      a_row_view_t row_mapA_, a_nnz_view_t entriesA_, a_scalar_view_t valuesA_,
+      b_row_view_t row_mapB_, b_nnz_view_t entriesB_, b_scalar_view_t valuesB_,
+      m_row_view_t row_mapM_, m_nnz_view_t entriesM_,
+      c_row_view_t rowmapC_, c_nnz_view_t entriesC_, c_scalar_view_t valuesC_,
+      pool_memory_space memory_space_, bool complement_,
+      lno_t max_nnz_m_, lno_t pow2_hash_size_m_,
+      lno_t max_nnz_c_, lno_t pow2_hash_size_c_,
+      lno_t value_block_size_, lno_t team_work_size_):
+    m(m_),
+    row_mapA(row_mapA_), entriesA(entriesA_), valuesA(valuesA_),
+    row_mapB(row_mapB_), entriesB(entriesB_), valuesB(valuesB_),
+    row_mapM(row_mapM_), entriesM(entriesM_),
+    rowmapC(rowmapC_), entriesC(entriesC_), valuesC(valuesC_),
+    memory_space(memory_space_), complement(complement_),
+    max_nnz_m(max_nnz_m_), pow2_hash_size_m(pow2_hash_size_m_),
+    max_nnz_c(max_nnz_c_), pow2_hash_size_c(pow2_hash_size_c_),
+    value_block_size(value_block_size_), team_work_size(team_work_size_){}
+
+  //inserts row i of the mask into hm_m.
+  KOKKOS_INLINE_FUNCTION
+  void insert_mask_row(
+      const lno_t &row_index,
+      KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t> &hm_m,
+      lno_t *used_size_m, lno_t *used_hash_count_m, lno_t *used_hashes_m) const {
+    const lno_t hash_func_m = pow2_hash_size_m - 1;
+    for (size_type z = row_mapM(row_index); z < row_mapM(row_index + 1); ++z){
+      const lno_t key = entriesM(z);
+      hm_m.sequential_insert_into_hash_TrackHashes(
+          key & hash_func_m, key,
+          used_size_m, max_nnz_m,
+          used_hash_count_m, used_hashes_m);
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const SymbolicTag&, const team_member_t & teamMember) const {
+    const lno_t team_row_begin = teamMember.league_rank() * team_work_size;
+    const lno_t team_row_end = KOKKOSKERNELS_MACRO_MIN(team_row_begin + team_work_size, m);
+
+    volatile lno_t * tmp = NULL;
+    size_t tid = team_row_begin + teamMember.team_rank();
+    while (tmp == NULL){
+      tmp = (volatile lno_t * )( memory_space.allocate_chunk(tid));
+    }
+    lno_t *chunk = (lno_t *) tmp;
+    lno_t *ptr = chunk;
+
+    KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t>
+    hm_m(pow2_hash_size_m, max_nnz_m, NULL, NULL, NULL, NULL);
+    KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t>
+    hm_c(pow2_hash_size_c, max_nnz_c, NULL, NULL, NULL, NULL);
+
+    lno_t *hits = ptr; ptr += max_nnz_m;
+    lno_t *used_hashes_m = ptr; ptr += pow2_hash_size_m;
+    hm_m.hash_begins = ptr; ptr += pow2_hash_size_m;
+    hm_m.hash_nexts = ptr; ptr += max_nnz_m;
+    hm_m.keys = ptr; ptr += max_nnz_m;
+    lno_t *used_hashes_c = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_begins = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_nexts = ptr; ptr += max_nnz_c;
+    hm_c.keys = ptr;
+
+    const lno_t hash_func_m = pow2_hash_size_m - 1;
+    const lno_t hash_func_c = pow2_hash_size_c - 1;
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, team_row_begin, team_row_end), [&] (const lno_t& row_index) {
+      lno_t used_size_m = 0, used_hash_count_m = 0;
+      lno_t used_size_c = 0, used_hash_count_c = 0;
+      lno_t row_nnz = 0;
+
+      this->insert_mask_row(row_index, hm_m, &used_size_m, &used_hash_count_m, used_hashes_m);
+      for (lno_t t = 0; t < used_size_m; ++t) hits[t] = 0;
+
+      for (size_type a = row_mapA(row_index); a < row_mapA(row_index + 1); ++a){
+        const lno_t rowB = entriesA(a);
+        for (size_type b = row_mapB(rowB); b < row_mapB(rowB + 1); ++b){
+          const lno_t key = entriesB(b);
+          const lno_t mask_index = hm_m.sequential_find_index(key & hash_func_m, key);
+          if (complement){
+            if (mask_index != -1) continue;
+            hm_c.sequential_insert_into_hash_TrackHashes(
+                key & hash_func_c, key,
+                &used_size_c, max_nnz_c,
+                &used_hash_count_c, used_hashes_c);
+          }
+          else if (mask_index != -1 && !hits[mask_index]){
+            hits[mask_index] = 1;
+            ++row_nnz;
+          }
+        }
+      }
+      if (complement) row_nnz = used_size_c;
+
+      for (lno_t i = 0; i < used_hash_count_m; ++i){
+        hm_m.hash_begins[used_hashes_m[i]] = -1;
+      }
+      for (lno_t i = 0; i < used_hash_count_c; ++i){
+        hm_c.hash_begins[used_hashes_c[i]] = -1;
+      }
+      rowmapC(row_index) = row_nnz;
+    });
+    memory_space.release_chunk(chunk);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const NumericTag&, const team_member_t & teamMember) const {
+    const lno_t team_row_begin = teamMember.league_rank() * team_work_size;
+    const lno_t team_row_end = KOKKOSKERNELS_MACRO_MIN(team_row_begin + team_work_size, m);
+
+    volatile lno_t * tmp = NULL;
+    size_t tid = team_row_begin + teamMember.team_rank();
+    while (tmp == NULL){
+      tmp = (volatile lno_t * )( memory_space.allocate_chunk(tid));
+    }
+    lno_t *chunk = (lno_t *) tmp;
+    lno_t *ptr = chunk;
+
+    KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t>
+    hm_m(pow2_hash_size_m, max_nnz_m, NULL, NULL, NULL, NULL);
+    KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t>
+    hm_c(pow2_hash_size_c, max_nnz_c, NULL, NULL, NULL, NULL);
+
+    hm_m.values = (scalar_t *) ptr; ptr += value_block_size;
+    lno_t *hits = ptr; ptr += max_nnz_m;
+    lno_t *used_hashes_m = ptr; ptr += pow2_hash_size_m;
+    hm_m.hash_begins = ptr; ptr += pow2_hash_size_m;
+    hm_m.hash_nexts = ptr; ptr += max_nnz_m;
+    hm_m.keys = ptr; ptr += max_nnz_m;
+    lno_t *used_hashes_c = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_begins = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_nexts = ptr;
+
+    const lno_t hash_func_m = pow2_hash_size_m - 1;
+    const lno_t hash_func_c = pow2_hash_size_c - 1;
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, team_row_begin, team_row_end), [&] (const lno_t& row_index) {
+      lno_t used_size_m = 0, used_hash_count_m = 0;
+      lno_t used_size_c = 0, used_hash_count_c = 0;
+
+      const size_type c_row_begin = rowmapC(row_index);
+      hm_c.max_value_size = rowmapC(row_index + 1) - c_row_begin;
+      hm_c.keys = entriesC.data() + c_row_begin;
+      hm_c.values = valuesC.data() + c_row_begin;
+
+      this->insert_mask_row(row_index, hm_m, &used_size_m, &used_hash_count_m, used_hashes_m);
+      for (lno_t t = 0; t < used_size_m; ++t) hits[t] = 0;
+
+      for (size_type a = row_mapA(row_index); a < row_mapA(row_index + 1); ++a){
+        const lno_t rowB = entriesA(a);
+        const scalar_t valA = valuesA(a);
+        for (size_type b = row_mapB(rowB); b < row_mapB(rowB + 1); ++b){
+          const lno_t key = entriesB(b);
+          const lno_t mask_index = hm_m.sequential_find_index(key & hash_func_m, key);
+          if (complement){
+            if (mask_index != -1) continue;
+            hm_c.sequential_insert_into_hash_mergeAdd_TrackHashes(
+                key & hash_func_c, key, valA * valuesB(b),
+                &used_size_c, hm_c.max_value_size,
+                &used_hash_count_c, used_hashes_c);
+          }
+          else if (mask_index != -1){
+            if (hits[mask_index]){
+              hm_m.values[mask_index] += valA * valuesB(b);
+            }
+            else {
+              hits[mask_index] = 1;
+              hm_m.values[mask_index] = valA * valuesB(b);
+            }
+          }
+        }
+      }
+      if (!complement){
+        //entries of C are written in the order of the mask row.
+        size_type c_pos = c_row_begin;
+        for (lno_t t = 0; t < used_size_m; ++t){
+          if (hits[t]){
+            entriesC(c_pos) = hm_m.keys[t];
+            valuesC(c_pos++) = hm_m.values[t];
+          }
+        }
+      }
+
+      for (lno_t i = 0; i < used_hash_count_m; ++i){
+        hm_m.hash_begins[used_hashes_m[i]] = -1;
+      }
+      for (lno_t i = 0; i < used_hash_count_c; ++i){
+        hm_c.hash_begins[used_hashes_c[i]] = -1;
+      }
+    });
+    memory_space.release_chunk(chunk);
+  }
+};
+
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename b_row_view_t, typename b_nnz_view_t, typename b_scalar_view_t,
+          typename m_row_view_t, typename m_nnz_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t>
+void spgemm_masked_run(
+    KernelHandle *handle,
+    bool numeric,
+    bool complement,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t max_nnz_m,
+    typename KernelHandle::nnz_lno_t max_nnz_c,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA, a_scalar_view_t valuesA,
+    b_row_view_t row_mapB, b_nnz_view_t entriesB, b_scalar_view_t valuesB,
+    m_row_view_t row_mapM, m_nnz_view_t entriesM,
+    c_row_view_t row_mapC, c_nnz_view_t entriesC, c_scalar_view_t valuesC){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::nnz_scalar_t scalar_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::HandleTempMemorySpace MyTempMemorySpace;
+  typedef typename Kokkos::TeamPolicy<MyExecSpace>::member_type team_member_t;
+  typedef KokkosKernels::Impl::UniformMemoryPool<MyTempMemorySpace, nnz_lno_t> pool_memory_space;
+
+  typedef SpgemmMaskedFunctor<size_type, nnz_lno_t, scalar_t,
+      a_row_view_t, a_nnz_view_t, a_scalar_view_t,
+      b_row_view_t, b_nnz_view_t, b_scalar_view_t,
+      m_row_view_t, m_nnz_view_t,
+      c_row_view_t, c_nnz_view_t, c_scalar_view_t,
+      pool_memory_space, team_member_t> masked_functor_t;
+  typedef Kokkos::TeamPolicy<typename masked_functor_t::SymbolicTag, MyExecSpace> symbolic_team_policy_t;
+  typedef Kokkos::TeamPolicy<typename masked_functor_t::NumericTag, MyExecSpace> numeric_team_policy_t;
+
+  if (m == 0) return;
+
+  //the second hashmap is only used for the complement.
+  if (!complement) max_nnz_c = 0;
+  nnz_lno_t pow2_hash_size_m = spgemm_pow2_hash_size<nnz_lno_t>(max_nnz_m);
+  nnz_lno_t pow2_hash_size_c = complement ? spgemm_pow2_hash_size<nnz_lno_t>(max_nnz_c) : 0;
+
+  //values of the mask go first in the chunk, chunks are kept aligned for scalar_t.
+  const size_t scalar_units = (sizeof(scalar_t) + sizeof(nnz_lno_t) - 1) / sizeof(nnz_lno_t);
+  nnz_lno_t value_block_size = (numeric && !complement) ? nnz_lno_t (max_nnz_m * scalar_units) : 0;
+  size_t chunksize = value_block_size;
+  chunksize += 2 * pow2_hash_size_m + 3 * max_nnz_m; //hits, used hashes, begins, nexts and keys of the mask
+  chunksize += 2 * pow2_hash_size_c + max_nnz_c; //used hashes, begins and nexts of C
+  if (!numeric) chunksize += max_nnz_c; //keys of C
+  chunksize = ((chunksize + 2 * scalar_units - 1) / (2 * scalar_units)) * (2 * scalar_units);
+
+  const int suggested_vector_size = 1;
+  const int suggested_team_size = handle->get_suggested_team_size(suggested_vector_size);
+  const int concurrency = MyExecSpace::concurrency();
+  const nnz_lno_t team_row_chunk_size = handle->get_team_work_size(suggested_team_size, concurrency, m);
+
+  size_t num_chunks = KOKKOSKERNELS_MACRO_MIN(size_t (concurrency), size_t (m));
+  pool_memory_space m_space(num_chunks, chunksize, -1, KokkosKernels::Impl::ManyThread2OneChunk);
+
+  if (handle->get_verbose()){
+    std::cout << "\tspgemm_masked " << (numeric ? "numeric" : "symbolic")
+              << (complement ? " complement" : "")
+              << " max_nnz_m:" << max_nnz_m << " max_nnz_c:" << max_nnz_c
+              << " chunk_size:" << chunksize << " num_chunks:" << num_chunks
+              << " team_size:" << suggested_team_size << std::endl;
+  }
+
+  masked_functor_t mf(
+      m,
+      row_mapA, entriesA, valuesA,
+      row_mapB, entriesB, valuesB,
+      row_mapM, entriesM,
+      row_mapC, entriesC, valuesC,
+      m_space, complement,
+      max_nnz_m, pow2_hash_size_m,
+      max_nnz_c, pow2_hash_size_c,
+      value_block_size, team_row_chunk_size);
+
+  if (numeric){
+    Kokkos::parallel_for("KokkosSparse::spgemm_masked::Numeric",
+        numeric_team_policy_t(m / team_row_chunk_size + 1, suggested_team_size, suggested_vector_size), mf);
+  }
+  else {
+    Kokkos::parallel_for("KokkosSparse::spgemm_masked::Symbolic",
+        symbolic_team_policy_t(m / team_row_chunk_size + 1, suggested_team_size, suggested_vector_size), mf);
+  }
+  MyExecSpace::fence();
+}
+
+template <typename KernelHandle,
+          typename m_row_view_t>
+typename KernelHandle::nnz_lno_t spgemm_masked_max_mask_row_nnz(
+    typename KernelHandle::nnz_lno_t m,
+    m_row_view_t row_mapM){
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+
+  size_type max_m_row_nnz = 0;
+  if (m > 0){
+    KokkosKernels::Impl::view_reduce_maxsizerow<m_row_view_t, MyExecSpace>(m, row_mapM, max_m_row_nnz);
+    MyExecSpace::fence();
+  }
+  return max_m_row_nnz;
+}
+
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t,
+          typename b_row_view_t, typename b_nnz_view_t,
+          typename m_row_view_t, typename m_nnz_view_t,
+          typename c_row_view_t>
+void spgemm_masked_symbolic_impl(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t n,
+    typename KernelHandle::nnz_lno_t k,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA,
+    b_row_view_t row_mapB, b_nnz_view_t entriesB,
+    m_row_view_t row_mapM, m_nnz_view_t entriesM,
+    bool complement,
+    c_row_view_t row_mapC){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::scalar_temp_work_view_t scalar_view_t;
+  typedef typename KernelHandle::nnz_lno_temp_work_view_t nnz_view_t;
+  typedef typename KernelHandle::SPGEMMHandleType spgemmHandleType;
+
+  spgemmHandleType *sh = handle->get_spgemm_handle();
+
+  nnz_lno_t max_nnz_m = spgemm_masked_max_mask_row_nnz<KernelHandle>(m, row_mapM);
+  nnz_lno_t max_nnz_c = max_nnz_m;
+  if (complement){
+    max_nnz_c = spgemm_max_row_flops_bound<KernelHandle>(m, k, row_mapA, entriesA, row_mapB);
+  }
+
+  Kokkos::deep_copy(Kokkos::subview(row_mapC, m), 0);
+  spgemm_masked_run(
+      handle, false, complement, m, max_nnz_m, max_nnz_c,
+      row_mapA, entriesA, scalar_view_t(),
+      row_mapB, entriesB, scalar_view_t(),
+      row_mapM, entriesM,
+      row_mapC, nnz_view_t(), scalar_view_t());
+
+  size_type max_c_row_nnz = 0;
+  if (m > 0){
+    KokkosKernels::Impl::view_reduce_max<c_row_view_t, MyExecSpace>(m, row_mapC, max_c_row_nnz);
+  }
+  KokkosKernels::Impl::exclusive_parallel_prefix_sum<c_row_view_t, MyExecSpace>(m + 1, row_mapC);
+  MyExecSpace::fence();
+
+  auto d_c_nnz_size = Kokkos::subview(row_mapC, m);
+  auto h_c_nnz_size = Kokkos::create_mirror_view(d_c_nnz_size);
+  Kokkos::deep_copy(h_c_nnz_size, d_c_nnz_size);
+
+  sh->set_c_nnz(h_c_nnz_size());
+  sh->set_max_result_nnz(max_c_row_nnz);
+  sh->set_call_symbolic();
+}
+
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename b_row_view_t, typename b_nnz_view_t, typename b_scalar_view_t,
+          typename m_row_view_t, typename m_nnz_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t>
+void spgemm_masked_numeric_impl(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t n,
+    typename KernelHandle::nnz_lno_t k,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA, a_scalar_view_t valuesA,
+    b_row_view_t row_mapB, b_nnz_view_t entriesB, b_scalar_view_t valuesB,
+    m_row_view_t row_mapM, m_nnz_view_t entriesM,
+    bool complement,
+    c_row_view_t row_mapC, c_nnz_view_t entriesC, c_scalar_view_t valuesC){
+
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+
+  nnz_lno_t max_nnz_m = spgemm_masked_max_mask_row_nnz<KernelHandle>(m, row_mapM);
+  nnz_lno_t max_nnz_c = handle->get_spgemm_handle()->get_max_result_nnz();
+
+  spgemm_masked_run(
+      handle, true, complement, m, max_nnz_m, max_nnz_c,
+      row_mapA, entriesA, valuesA,
+      row_mapB, entriesB, valuesB,
+      row_mapM, entriesM,
+      row_mapC, entriesC, valuesC);
+}
+
+}
+}
+#endif
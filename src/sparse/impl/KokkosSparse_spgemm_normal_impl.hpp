@@ -0,0 +1,426 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_SPGEMM_NORMAL_IMPL_HPP_
+#define KOKKOSSPARSE_SPGEMM_NORMAL_IMPL_HPP_
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+#include "KokkosKernels_HashmapAccumulator.hpp"
+#include "KokkosKernels_Uniform_Initialized_MemoryPool.hpp"
+#include "KokkosSparse_spgemm_triple_impl.hpp"
+
+namespace KokkosSparse{
+
+namespace Impl{
+
+/**
+ * \brief Computes C = A*A^T or C = A^T*A with the graph of A^T, but without
+ * the values of A^T. T is the transposed graph of A, the values of A are
+ * read through A.
+ * For A*A^T, row i of C gathers the columns T(k) of the columns k of row i
+ * of A, and in numeric each entry C(i,j) is the intersection of the sorted
+ * rows i and j of A.
+ * For A^T*A, row i of C is the sum of the rows r of A in T(i), scaled by
+ * A(r,i), which is found by a binary search in the sorted row r.
+ *
+ * The chunk of a thread holds, in nnz_lno_t units: used hashes, begins,
+ * nexts and, in symbolic, the keys of the hashmap of a row of C. In numeric
+ * the hashmap writes to C.
+ */
+template <typename size_type, typename lno_t, typename scalar_t,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename t_row_view_t, typename t_nnz_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t,
+          typename pool_memory_space, typename team_member_t>
+struct SpgemmNormalFunctor{
+  struct SymbolicTag{};
+  struct NumericTag{};
+
+  lno_t c_rows;
+  a_row_view_t row_mapA;
+  a_nnz_view_t entriesA;
+  a_scalar_view_t valuesA;
+  t_row_view_t row_mapT;
+  t_nnz_view_t entriesT;
+  c_row_view_t rowmapC;
+  c_nnz_view_t entriesC;
+  c_scalar_view_t valuesC;
+
+  pool_memory_space memory_space;
+  const bool a_at;
+  const lno_t max_nnz_c, pow2_hash_size_c;
+  const lno_t team_work_size;
+
+  SpgemmNormalFunctor(
+      lno_t c_rows_,
+      a_row_view_t row_mapA_, a_nnz_view_t entriesA_, a_scalar_view_t valuesA_,
+      t_row_view_t row_mapT_, t_nnz_view_t entriesT_,
+      c_row_view_t rowmapC_, c_nnz_view_t entriesC_, c_scalar_view_t valuesC_,
+      pool_memory_space memory_space_, bool a_at_,
+      lno_t max_nnz_c_, lno_t pow2_hash_size_c_,
+      lno_t team_work_size_):
+    c_rows(c_rows_),
+    row_mapA(row_mapA_), entriesA(entriesA_), valuesA(valuesA_),
+    row_mapT(row_mapT_), entriesT(entriesT_),
+    rowmapC(rowmapC_), entriesC(entriesC_), valuesC(valuesC_),
+    memory_space(memory_space_), a_at(a_at_),
+    max_nnz_c(max_nnz_c_), pow2_hash_size_c(pow2_hash_size_c_),
+    team_work_size(team_work_size_){}
+
+  //position of column col in the sorted row of A, col must be in the row.
+  KOKKOS_INLINE_FUNCTION
+  size_type find_in_row(const lno_t &row, const lno_t &col) const {
+    size_type lo = row_mapA(row), hi = row_mapA(row + 1);
+    while (lo < hi){
+      const size_type mid = lo + (hi - lo) / 2;
+      if (entriesA(mid) < col) lo = mid + 1;
+      else hi = mid;
+    }
+    return lo;
+  }
+
+  //inner product of the sorted rows i and j of A.
+  KOKKOS_INLINE_FUNCTION
+  scalar_t sorted_row_dot(const lno_t &i, const lno_t &j) const {
+    size_type a = row_mapA(i), b = row_mapA(j);
+    const size_type a_end = row_mapA(i + 1), b_end = row_mapA(j + 1);
+    scalar_t sum = scalar_t();
+    while (a < a_end && b < b_end){
+      const lno_t col_a = entriesA(a), col_b = entriesA(b);
+      if (col_a < col_b) ++a;
+      else if (col_b < col_a) ++b;
+      else {
+        sum += valuesA(a++) * valuesA(b++);
+      }
+    }
+    return sum;
+  }
+
+  //inserts the columns of row i of C into hm_c.
+  KOKKOS_INLINE_FUNCTION
+  void insert_row_pattern(
+      const lno_t &row_index,
+      KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t> &hm_c,
+      lno_t *used_size_c, lno_t *used_hash_count_c, lno_t *used_hashes_c) const {
+    const lno_t hash_func_c = pow2_hash_size_c - 1;
+    if (a_at){
+      for (size_type a = row_mapA(row_index); a < row_mapA(row_index + 1); ++a){
+        const lno_t col = entriesA(a);
+        for (size_type t = row_mapT(col); t < row_mapT(col + 1); ++t){
+          const lno_t key = entriesT(t);
+          hm_c.sequential_insert_into_hash_TrackHashes(
+              key & hash_func_c, key,
+              used_size_c, hm_c.max_value_size,
+              used_hash_count_c, used_hashes_c);
+        }
+      }
+    }
+    else {
+      for (size_type t = row_mapT(row_index); t < row_mapT(row_index + 1); ++t){
+        const lno_t row = entriesT(t);
+        for (size_type a = row_mapA(row); a < row_mapA(row + 1); ++a){
+          const lno_t key = entriesA(a);
+          hm_c.sequential_insert_into_hash_TrackHashes(
+              key & hash_func_c, key,
+              used_size_c, hm_c.max_value_size,
+              used_hash_count_c, used_hashes_c);
+        }
+      }
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const SymbolicTag&, const team_member_t & teamMember) const {
+    const lno_t team_row_begin = teamMember.league_rank() * team_work_size;
+    const lno_t team_row_end = KOKKOSKERNELS_MACRO_MIN(team_row_begin + team_work_size, c_rows);
+
+    volatile lno_t * tmp = NULL;
+    size_t tid = team_row_begin + teamMember.team_rank();
+    while (tmp == NULL){
+      tmp = (volatile lno_t * )( memory_space.allocate_chunk(tid));
+    }
+    lno_t *chunk = (lno_t *) tmp;
+    lno_t *ptr = chunk;
+
+    KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t>
+    hm_c(pow2_hash_size_c, max_nnz_c, NULL, NULL, NULL, NULL);
+
+    lno_t *used_hashes_c = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_begins = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_nexts = ptr; ptr += max_nnz_c;
+    hm_c.keys = ptr;
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, team_row_begin, team_row_end), [&] (const lno_t& row_index) {
+      lno_t used_size_c = 0, used_hash_count_c = 0;
+
+      this->insert_row_pattern(row_index, hm_c, &used_size_c, &used_hash_count_c, used_hashes_c);
+
+      for (lno_t i = 0; i < used_hash_count_c; ++i){
+        hm_c.hash_begins[used_hashes_c[i]] = -1;
+      }
+      rowmapC(row_index) = used_size_c;
+    });
+    memory_space.release_chunk(chunk);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const NumericTag&, const team_member_t & teamMember) const {
+    const lno_t team_row_begin = teamMember.league_rank() * team_work_size;
+    const lno_t team_row_end = KOKKOSKERNELS_MACRO_MIN(team_row_begin + team_work_size, c_rows);
+
+    volatile lno_t * tmp = NULL;
+    size_t tid = team_row_begin + teamMember.team_rank();
+    while (tmp == NULL){
+      tmp = (volatile lno_t * )( memory_space.allocate_chunk(tid));
+    }
+    lno_t *chunk = (lno_t *) tmp;
+    lno_t *ptr = chunk;
+
+    KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t>
+    hm_c(pow2_hash_size_c, max_nnz_c, NULL, NULL, NULL, NULL);
+
+    lno_t *used_hashes_c = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_begins = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_nexts = ptr;
+
+    const lno_t hash_func_c = pow2_hash_size_c - 1;
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, team_row_begin, team_row_end), [&] (const lno_t& row_index) {
+      lno_t used_size_c = 0, used_hash_count_c = 0;
+
+      const size_type c_row_begin = rowmapC(row_index);
+      hm_c.max_value_size = rowmapC(row_index + 1) - c_row_begin;
+      hm_c.keys = entriesC.data() + c_row_begin;
+      hm_c.values = valuesC.data() + c_row_begin;
+
+      if (a_at){
+        //the pattern first, then one intersection per entry of C.
+        this->insert_row_pattern(row_index, hm_c, &used_size_c, &used_hash_count_c, used_hashes_c);
+        for (lno_t z = 0; z < used_size_c; ++z){
+          hm_c.values[z] = this->sorted_row_dot(row_index, hm_c.keys[z]);
+        }
+      }
+      else {
+        for (size_type t = row_mapT(row_index); t < row_mapT(row_index + 1); ++t){
+          const lno_t row = entriesT(t);
+          const scalar_t val_ri = valuesA(this->find_in_row(row, row_index));
+          for (size_type a = row_mapA(row); a < row_mapA(row + 1); ++a){
+            const lno_t key = entriesA(a);
+            hm_c.sequential_insert_into_hash_mergeAdd_TrackHashes(
+                key & hash_func_c, key, val_ri * valuesA(a),
+                &used_size_c, hm_c.max_value_size,
+                &used_hash_count_c, used_hashes_c);
+          }
+        }
+      }
+
+      for (lno_t i = 0; i < used_hash_count_c; ++i){
+        hm_c.hash_begins[used_hashes_c[i]] = -1;
+      }
+    });
+    memory_space.release_chunk(chunk);
+  }
+};
+
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename t_row_view_t, typename t_nnz_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t>
+void spgemm_normal_run(
+    KernelHandle *handle,
+    bool numeric,
+    bool a_at,
+    typename KernelHandle::nnz_lno_t c_rows,
+    typename KernelHandle::nnz_lno_t max_nnz_c,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA, a_scalar_view_t valuesA,
+    t_row_view_t row_mapT, t_nnz_view_t entriesT,
+    c_row_view_t row_mapC, c_nnz_view_t entriesC, c_scalar_view_t valuesC){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::nnz_scalar_t scalar_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::HandleTempMemorySpace MyTempMemorySpace;
+  typedef typename Kokkos::TeamPolicy<MyExecSpace>::member_type team_member_t;
+  typedef KokkosKernels::Impl::UniformMemoryPool<MyTempMemorySpace, nnz_lno_t> pool_memory_space;
+
+  typedef SpgemmNormalFunctor<size_type, nnz_lno_t, scalar_t,
+      a_row_view_t, a_nnz_view_t, a_scalar_view_t,
+      t_row_view_t, t_nnz_view_t,
+      c_row_view_t, c_nnz_view_t, c_scalar_view_t,
+      pool_memory_space, team_member_t> normal_functor_t;
+  typedef Kokkos::TeamPolicy<typename normal_functor_t::SymbolicTag, MyExecSpace> symbolic_team_policy_t;
+  typedef Kokkos::TeamPolicy<typename normal_functor_t::NumericTag, MyExecSpace> numeric_team_policy_t;
+
+  if (c_rows == 0) return;
+
+  nnz_lno_t pow2_hash_size_c = spgemm_pow2_hash_size<nnz_lno_t>(max_nnz_c);
+  size_t chunksize = 2 * pow2_hash_size_c + max_nnz_c; //used hashes, begins and nexts of C
+  if (!numeric) chunksize += max_nnz_c; //keys of C
+
+  const int suggested_vector_size = 1;
+  const int suggested_team_size = handle->get_suggested_team_size(suggested_vector_size);
+  const int concurrency = MyExecSpace::concurrency();
+  const nnz_lno_t team_row_chunk_size = handle->get_team_work_size(suggested_team_size, concurrency, c_rows);
+
+  size_t num_chunks = KOKKOSKERNELS_MACRO_MIN(size_t (concurrency), size_t (c_rows));
+  pool_memory_space m_space(num_chunks, chunksize, -1, KokkosKernels::Impl::ManyThread2OneChunk);
+
+  if (handle->get_verbose()){
+    std::cout << "\tspgemm_normal " << (a_at ? "A*A^T " : "A^T*A ") << (numeric ? "numeric" : "symbolic")
+              << " max_nnz_c:" << max_nnz_c
+              << " chunk_size:" << chunksize << " num_chunks:" << num_chunks
+              << " team_size:" << suggested_team_size << std::endl;
+  }
+
+  normal_functor_t nf(
+      c_rows,
+      row_mapA, entriesA, valuesA,
+      row_mapT, entriesT,
+      row_mapC, entriesC, valuesC,
+      m_space, a_at,
+      max_nnz_c, pow2_hash_size_c,
+      team_row_chunk_size);
+
+  if (numeric){
+    Kokkos::parallel_for("KokkosSparse::spgemm_normal::Numeric",
+        numeric_team_policy_t(c_rows / team_row_chunk_size + 1, suggested_team_size, suggested_vector_size), nf);
+  }
+  else {
+    Kokkos::parallel_for("KokkosSparse::spgemm_normal::Symbolic",
+        symbolic_team_policy_t(c_rows / team_row_chunk_size + 1, suggested_team_size, suggested_vector_size), nf);
+  }
+  MyExecSpace::fence();
+}
+
+/**
+ * \brief Symbolic phase of A*A^T (a_at) or A^T*A. A is m x n. Builds the
+ * transposed graph of A, kept in the spgemm handle for the numeric phase.
+ */
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t,
+          typename c_row_view_t>
+void spgemm_normal_symbolic_impl(
+    KernelHandle *handle,
+    bool a_at,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t n,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA,
+    c_row_view_t row_mapC){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::scalar_temp_work_view_t scalar_view_t;
+  typedef typename KernelHandle::nnz_lno_temp_work_view_t nnz_view_t;
+  typedef typename KernelHandle::row_lno_temp_work_view_t row_view_t;
+  typedef typename KernelHandle::SPGEMMHandleType spgemmHandleType;
+
+  spgemmHandleType *sh = handle->get_spgemm_handle();
+
+  //the graph of A^T, without values.
+  row_view_t row_mapT("spgemm_normal_transpose_xadj", n + 1);
+  nnz_view_t entriesT(Kokkos::ViewAllocateWithoutInitializing("spgemm_normal_transpose_adj"), entriesA.extent(0));
+  KokkosKernels::Impl::kk_transpose_graph<
+      a_row_view_t, a_nnz_view_t,
+      row_view_t, nnz_view_t, row_view_t,
+      MyExecSpace>
+    (m, n, row_mapA, entriesA, row_mapT, entriesT,
+     -1, -1, -1, true, handle->get_workspace());
+  MyExecSpace::fence();
+  sh->set_transpose_a_graph(row_mapT, entriesT);
+
+  const nnz_lno_t c_rows = a_at ? m : n;
+  const nnz_lno_t max_nnz_c = a_at ?
+      spgemm_max_row_flops_bound<KernelHandle>(m, m, row_mapA, entriesA, row_mapT) :
+      spgemm_max_row_flops_bound<KernelHandle>(n, n, row_mapT, entriesT, row_mapA);
+
+  Kokkos::deep_copy(Kokkos::subview(row_mapC, c_rows), 0);
+  spgemm_normal_run(
+      handle, false, a_at, c_rows, max_nnz_c,
+      row_mapA, entriesA, scalar_view_t(),
+      row_mapT, entriesT,
+      row_mapC, nnz_view_t(), scalar_view_t());
+
+  size_type max_c_row_nnz = 0;
+  if (c_rows > 0){
+    KokkosKernels::Impl::view_reduce_max<c_row_view_t, MyExecSpace>(c_rows, row_mapC, max_c_row_nnz);
+  }
+  KokkosKernels::Impl::exclusive_parallel_prefix_sum<c_row_view_t, MyExecSpace>(c_rows + 1, row_mapC);
+  MyExecSpace::fence();
+
+  auto d_c_nnz_size = Kokkos::subview(row_mapC, c_rows);
+  auto h_c_nnz_size = Kokkos::create_mirror_view(d_c_nnz_size);
+  Kokkos::deep_copy(h_c_nnz_size, d_c_nnz_size);
+
+  sh->set_c_nnz(h_c_nnz_size());
+  sh->set_max_result_nnz(max_c_row_nnz);
+  sh->set_call_symbolic();
+}
+
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t>
+void spgemm_normal_numeric_impl(
+    KernelHandle *handle,
+    bool a_at,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t n,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA, a_scalar_view_t valuesA,
+    c_row_view_t row_mapC, c_nnz_view_t entriesC, c_scalar_view_t valuesC){
+
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::SPGEMMHandleType spgemmHandleType;
+
+  spgemmHandleType *sh = handle->get_spgemm_handle();
+  const nnz_lno_t c_rows = a_at ? m : n;
+
+  spgemm_normal_run(
+      handle, true, a_at, c_rows, sh->get_max_result_nnz(),
+      row_mapA, entriesA, valuesA,
+      sh->get_transpose_a_xadj(), sh->get_transpose_a_adj(),
+      row_mapC, entriesC, valuesC);
+}
+
+}
+}
+#endif
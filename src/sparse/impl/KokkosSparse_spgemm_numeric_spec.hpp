@@ -55,6 +55,8 @@
 #include "KokkosSparse_spgemm_CUSP_impl.hpp"
 #include "KokkosSparse_spgemm_impl.hpp"
 #include "KokkosSparse_spgemm_impl_seq.hpp"
+#include "KokkosSparse_spgemm_impl_reuse.hpp"
+#include "KokkosSparse_spgemm_impl_binned.hpp"
 #include "KokkosSparse_spgemm_mkl_impl.hpp"
 #include "KokkosSparse_spgemm_mkl2phase_impl.hpp"
 #include "KokkosSparse_spgemm_viennaCL_impl.hpp"
@@ -222,6 +224,8 @@ struct SPGEMM_NUMERIC<KernelHandle,
       */
     }
 
+    Kokkos::Impl::Timer timer1;
+    if (sh->get_collect_stats()) sh->stats.reset_numeric();
 
     switch (sh->get_algorithm_type()){
     case SPGEMM_CUSPARSE:
@@ -278,12 +282,39 @@ struct SPGEMM_NUMERIC<KernelHandle,
     default:
 
     {
-      KokkosSPGEMM
-      <KernelHandle,
-      a_size_view_t_, a_lno_view_t, a_scalar_view_t,
-      b_size_view_t_, b_lno_view_t,  b_scalar_view_t>
-      kspgemm (handle,m,n,k,row_mapA, entriesA, valuesA, transposeA, row_mapB, entriesB, valuesB, transposeB);
-      kspgemm.KokkosSPGEMM_numeric(row_mapC, entriesC, valuesC);
+      //the pattern of C is known from the previous call, so only scatter the products.
+      if (sh->get_reuse_contribution_map() && sh->get_contribution_map_built()){
+        spgemm_numeric_contribution_map(
+            handle, m,
+            row_mapA, entriesA, valuesA,
+            row_mapB, valuesB,
+            row_mapC, valuesC);
+        break;
+      }
+      if (sh->get_sort_output_rows() || sh->get_high_precision_accumulation() ||
+          sh->get_linear_probing_accumulator() || (sh->get_row_binning() &&
+          (sh->get_algorithm_type() == SPGEMM_KK || sh->get_algorithm_type() == SPGEMM_KK_MEMORY))){
+        spgemm_numeric_binned(
+            handle, m, n, k,
+            row_mapA, entriesA, valuesA,
+            row_mapB, entriesB, valuesB,
+            row_mapC, entriesC, valuesC);
+      }
+      else {
+        KokkosSPGEMM
+        <KernelHandle,
+        a_size_view_t_, a_lno_view_t, a_scalar_view_t,
+        b_size_view_t_, b_lno_view_t,  b_scalar_view_t>
+        kspgemm (handle,m,n,k,row_mapA, entriesA, valuesA, transposeA, row_mapB, entriesB, valuesB, transposeB);
+        kspgemm.KokkosSPGEMM_numeric(row_mapC, entriesC, valuesC);
+      }
+      if (sh->get_reuse_contribution_map()){
+        spgemm_build_contribution_map(
+            handle, m,
+            row_mapA, entriesA,
+            row_mapB, entriesB,
+            row_mapC, entriesC);
+      }
     }
     break;
     case SPGEMM_SERIAL:
@@ -308,6 +339,11 @@ struct SPGEMM_NUMERIC<KernelHandle,
           );
       break;
     }
+    if (sh->get_collect_stats()){
+      sh->stats.numeric_time = timer1.seconds();
+      sh->stats.algorithm = sh->get_algorithm_type();
+      sh->stats.accumulator = sh->get_accumulator_type();
+    }
 }
 };
 
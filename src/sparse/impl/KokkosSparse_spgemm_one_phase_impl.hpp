@@ -0,0 +1,210 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_SPGEMM_ONE_PHASE_IMPL_HPP_
+#define KOKKOSSPARSE_SPGEMM_ONE_PHASE_IMPL_HPP_
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosSparse_spgemm_impl_reuse.hpp"
+#include "KokkosSparse_spgemm_impl_binned.hpp"
+
+namespace KokkosSparse{
+
+namespace Impl{
+
+/**
+ * \brief Writes the row sizes of C to row_mapC, row_mapC(m) is set to 0 so
+ * that an exclusive prefix sum gives the row map.
+ */
+template <typename lno_t, typename nnz_view_t, typename c_row_view_t>
+struct SpgemmRowSizeFunctor{
+  lno_t m;
+  nnz_view_t row_nnz;
+  c_row_view_t row_mapC;
+
+  SpgemmRowSizeFunctor(lno_t m_, nnz_view_t row_nnz_, c_row_view_t row_mapC_):
+    m(m_), row_nnz(row_nnz_), row_mapC(row_mapC_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t &i) const {
+    row_mapC(i) = i == m ? 0 : row_nnz(i);
+  }
+};
+
+/**
+ * \brief Copies the rows of C computed into the bounded rows to the compacted rows.
+ */
+template <typename size_type, typename lno_t,
+          typename bound_row_view_t, typename bound_nnz_view_t, typename bound_scalar_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t>
+struct SpgemmCompactRowsFunctor{
+  bound_row_view_t bound_row_map;
+  bound_nnz_view_t bound_entries;
+  bound_scalar_view_t bound_values;
+  c_row_view_t row_mapC;
+  c_nnz_view_t entriesC;
+  c_scalar_view_t valuesC;
+
+  SpgemmCompactRowsFunctor(
+      bound_row_view_t bound_row_map_, bound_nnz_view_t bound_entries_, bound_scalar_view_t bound_values_,
+      c_row_view_t row_mapC_, c_nnz_view_t entriesC_, c_scalar_view_t valuesC_):
+    bound_row_map(bound_row_map_), bound_entries(bound_entries_), bound_values(bound_values_),
+    row_mapC(row_mapC_), entriesC(entriesC_), valuesC(valuesC_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t &i) const {
+    const size_type bound_begin = bound_row_map(i);
+    const size_type c_row_begin = row_mapC(i);
+    const size_type c_row_size = row_mapC(i + 1) - c_row_begin;
+    for (size_type j = 0; j < c_row_size; ++j){
+      entriesC(c_row_begin + j) = bound_entries(bound_begin + j);
+      valuesC(c_row_begin + j) = bound_values(bound_begin + j);
+    }
+  }
+};
+
+/**
+ * \brief C = A*B without an exact symbolic phase. The rows of C are allocated
+ * with the number of multiplications of the rows, the binned numeric phase
+ * computes the rows into these bounds, and the rows are compacted.
+ * \return false without computing C if the bounded rows need more than the
+ * one phase memory budget of the handle. Otherwise allocates entriesC and
+ * valuesC, and fills row_mapC, entriesC and valuesC.
+ */
+template <typename KernelHandle,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename b_row_view_t, typename b_nnz_view_t, typename b_scalar_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t>
+bool spgemm_one_phase_impl(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t n,
+    typename KernelHandle::nnz_lno_t k,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA, a_scalar_view_t valuesA,
+    b_row_view_t row_mapB, b_nnz_view_t entriesB, b_scalar_view_t valuesB,
+    c_row_view_t row_mapC, c_nnz_view_t &entriesC, c_scalar_view_t &valuesC){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::nnz_scalar_t scalar_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::row_lno_temp_work_view_t bound_row_view_t;
+  typedef typename KernelHandle::nnz_lno_temp_work_view_t bound_nnz_view_t;
+  typedef typename KernelHandle::scalar_temp_work_view_t bound_scalar_view_t;
+  typedef Kokkos::RangePolicy<MyExecSpace> range_policy_t;
+  typedef typename KernelHandle::SPGEMMHandleType spgemmHandleType;
+
+  spgemmHandleType *sh = handle->get_spgemm_handle();
+  Kokkos::Impl::Timer timer1;
+
+  bound_row_view_t bound_row_map(Kokkos::ViewAllocateWithoutInitializing("one phase bound row map"), m + 1);
+  Kokkos::parallel_for("KokkosSparse::spgemm_one_phase::RowBounds",
+      range_policy_t(0, m + 1),
+      SpgemmRowMultiplicationCountFunctor<size_type, nnz_lno_t, a_row_view_t, a_nnz_view_t, b_row_view_t, bound_row_view_t>(
+          m, row_mapA, entriesA, row_mapB, bound_row_map));
+  KokkosKernels::Impl::exclusive_parallel_prefix_sum<bound_row_view_t, MyExecSpace>(m + 1, bound_row_map);
+  MyExecSpace::fence();
+
+  auto d_bound_nnz = Kokkos::subview(bound_row_map, m);
+  auto h_bound_nnz = Kokkos::create_mirror_view(d_bound_nnz);
+  Kokkos::deep_copy(h_bound_nnz, d_bound_nnz);
+  const size_t bound_nnz = h_bound_nnz();
+
+  const size_t budget = sh->get_one_phase_memory_budget();
+  if (budget && bound_nnz * (sizeof(nnz_lno_t) + sizeof(scalar_t)) > budget){
+    if (handle->get_verbose()){
+      std::cout << "\tspgemm_one_phase bound nnz:" << bound_nnz
+                << " exceeds the memory budget:" << budget << std::endl;
+    }
+    return false;
+  }
+
+  bound_nnz_view_t bound_entries(Kokkos::ViewAllocateWithoutInitializing("one phase bound entries"), bound_nnz);
+  bound_scalar_view_t bound_values(Kokkos::ViewAllocateWithoutInitializing("one phase bound values"), bound_nnz);
+  bound_nnz_view_t row_nnz(Kokkos::ViewAllocateWithoutInitializing("one phase row nnz"), m);
+
+  spgemm_numeric_binned(
+      handle, m, n, k,
+      row_mapA, entriesA, valuesA,
+      row_mapB, entriesB, valuesB,
+      bound_row_map, bound_entries, bound_values,
+      row_nnz);
+
+  Kokkos::parallel_for("KokkosSparse::spgemm_one_phase::RowSizes",
+      range_policy_t(0, m + 1),
+      SpgemmRowSizeFunctor<nnz_lno_t, bound_nnz_view_t, c_row_view_t>(m, row_nnz, row_mapC));
+  size_type max_c_row_nnz = 0;
+  if (m > 0){
+    KokkosKernels::Impl::view_reduce_max<c_row_view_t, MyExecSpace>(m, row_mapC, max_c_row_nnz);
+  }
+  KokkosKernels::Impl::exclusive_parallel_prefix_sum<c_row_view_t, MyExecSpace>(m + 1, row_mapC);
+  MyExecSpace::fence();
+
+  auto d_c_nnz = Kokkos::subview(row_mapC, m);
+  auto h_c_nnz = Kokkos::create_mirror_view(d_c_nnz);
+  Kokkos::deep_copy(h_c_nnz, d_c_nnz);
+  const size_t c_nnz = h_c_nnz();
+
+  entriesC = c_nnz_view_t(Kokkos::ViewAllocateWithoutInitializing("entriesC"), c_nnz);
+  valuesC = c_scalar_view_t(Kokkos::ViewAllocateWithoutInitializing("valuesC"), c_nnz);
+  Kokkos::parallel_for("KokkosSparse::spgemm_one_phase::Compact",
+      range_policy_t(0, m),
+      SpgemmCompactRowsFunctor<size_type, nnz_lno_t,
+        bound_row_view_t, bound_nnz_view_t, bound_scalar_view_t,
+        c_row_view_t, c_nnz_view_t, c_scalar_view_t>(
+          bound_row_map, bound_entries, bound_values,
+          row_mapC, entriesC, valuesC));
+  MyExecSpace::fence();
+
+  sh->set_c_nnz(c_nnz);
+  sh->set_max_result_nnz(max_c_row_nnz);
+
+  if (handle->get_verbose()){
+    std::cout << "\tspgemm_one_phase bound nnz:" << bound_nnz
+              << " c nnz:" << c_nnz
+              << " time:" << timer1.seconds() << std::endl;
+  }
+  return true;
+}
+
+}
+}
+#endif
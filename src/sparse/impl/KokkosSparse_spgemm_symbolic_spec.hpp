@@ -54,6 +54,7 @@
 #include "KokkosSparse_spgemm_CUSP_impl.hpp"
 #include "KokkosSparse_spgemm_impl.hpp"
 #include "KokkosSparse_spgemm_impl_seq.hpp"
+#include "KokkosSparse_spgemm_impl_autoselect.hpp"
 #include "KokkosSparse_spgemm_mkl_impl.hpp"
 #include "KokkosSparse_spgemm_mkl2phase_impl.hpp"
 #include "KokkosSparse_spgemm_viennaCL_impl.hpp"
@@ -174,6 +175,14 @@ struct SPGEMM_SYMBOLIC < KernelHandle,
 
     typedef typename KernelHandle::SPGEMMHandleType spgemmHandleType;
     spgemmHandleType *sh = handle->get_spgemm_handle();
+    Kokkos::Impl::Timer timer1;
+    if (sh->get_collect_stats()) sh->stats.reset_symbolic();
+    if (sh->is_auto_select_algorithm()){
+      spgemm_auto_select_algorithm(
+          handle, m, n, k,
+          row_mapA, entriesA,
+          row_mapB, entriesB);
+    }
     switch (sh->get_algorithm_type()){
 
     case SPGEMM_CUSPARSE:
@@ -238,6 +247,13 @@ struct SPGEMM_SYMBOLIC < KernelHandle,
                   row_mapC, handle->get_verbose());
       break;
     }
+    if (sh->get_collect_stats()){
+      sh->stats.symbolic_time = timer1.seconds();
+      sh->stats.algorithm = sh->get_algorithm_type();
+      sh->stats.accumulator = sh->get_accumulator_type();
+    }
+    //a new symbolic phase may change the pattern of C.
+    sh->reset_contribution_map();
     sh->set_call_symbolic();
 
 }
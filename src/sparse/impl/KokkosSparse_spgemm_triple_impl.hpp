@@ -0,0 +1,469 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_SPGEMM_TRIPLE_IMPL_HPP_
+#define KOKKOSSPARSE_SPGEMM_TRIPLE_IMPL_HPP_
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_HashmapAccumulator.hpp"
+#include "KokkosKernels_Uniform_Initialized_MemoryPool.hpp"
+#include "KokkosSparse_spgemm_impl_autoselect.hpp"
+
+namespace KokkosSparse{
+
+namespace Impl{
+
+/**
+ * \brief Computes the rows of C = R*A*P in one pass. Each thread keeps two
+ * hashmaps in a chunk of the memory pool: the first accumulates row i of R*A,
+ * which is then multiplied with P into the second. Neither R*A nor A*P is
+ * materialized.
+ *
+ * The chunk of a thread holds, in nnz_lno_t units:
+ *   values of the first hashmap (numeric only), used hashes, begins, nexts
+ *   and keys of the first hashmap, used hashes, begins and nexts of the second
+ *   hashmap, and the keys of the second hashmap (symbolic only). In numeric the
+ *   second hashmap writes its keys and values directly to C.
+ */
+template <typename size_type, typename lno_t, typename scalar_t,
+          typename r_row_view_t, typename r_nnz_view_t, typename r_scalar_view_t,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename p_row_view_t, typename p_nnz_view_t, typename p_scalar_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t,
+          typename pool_memory_space, typename team_member_t>
+struct SpgemmTripleFunctor{
+  struct SymbolicTag{};
+  struct NumericTag{};
+
+  lno_t m;
+  r_row_view_t row_mapR;
+  r_nnz_view_t entriesR;
+  r_scalar_view_t valuesR;
+  a_row_view_t row_mapA;
+  a_nnz_view_t entriesA;
+  a_scalar_view_t valuesA;
+  p_row_view_t row_mapP;
+  p_nnz_view_t entriesP;
+  p_scalar_view_t valuesP;
+  c_row_view_t rowmapC;
+  c_nnz_view_t entriesC;
+  c_scalar_view_t valuesC;
+
+  pool_memory_space memory_space;
+  const lno_t max_nnz_ra, pow2_hash_size_ra;
+  const lno_t max_nnz_c, pow2_hash_size_c;
+  const lno_t value_block_size;
+  const lno_t team_work_size;
+
+  SpgemmTripleFunctor(
+      lno_t m_,
+      r_row_view_t row_mapR_, r_nnz_view_t entriesR_, r_scalar_view_t valuesR_,
+      a_row_view_t row_mapA_, a_nnz_view_t entriesA_, a_scalar_view_t valuesA_,
+      p_row_view_t row_mapP_, p_nnz_view_t entriesP_, p_scalar_view_t valuesP_,
+      c_row_view_t rowmapC_, c_nnz_view_t entriesC_, c_scalar_view_t valuesC_,
+      pool_memory_space memory_space_,
+      lno_t max_nnz_ra_, lno_t pow2_hash_size_ra_,
+      lno_t max_nnz_c_, lno_t pow2_hash_size_c_,
+      lno_t value_block_size_, lno_t team_work_size_):
+    m(m_),
+    row_mapR(row_mapR_), entriesR(entriesR_), valuesR(valuesR_),
+    row_mapA(row_mapA_), entriesA(entriesA_), valuesA(valuesA_),
+    row_mapP(row_mapP_), entriesP(entriesP_), valuesP(valuesP_),
+    rowmapC(rowmapC_), entriesC(entriesC_), valuesC(valuesC_),
+    memory_space(memory_space_),
+    max_nnz_ra(max_nnz_ra_), pow2_hash_size_ra(pow2_hash_size_ra_),
+    max_nnz_c(max_nnz_c_), pow2_hash_size_c(pow2_hash_size_c_),
+    value_block_size(value_block_size_), team_work_size(team_work_size_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const SymbolicTag&, const team_member_t & teamMember) const {
+    const lno_t team_row_begin = teamMember.league_rank() * team_work_size;
+    const lno_t team_row_end = KOKKOSKERNELS_MACRO_MIN(team_row_begin + team_work_size, m);
+
+    volatile lno_t * tmp = NULL;
+    size_t tid = team_row_begin + teamMember.team_rank();
+    while (tmp == NULL){
+      tmp = (volatile lno_t * )( memory_space.allocate_chunk(tid));
+    }
+    lno_t *chunk = (lno_t *) tmp;
+    lno_t *ptr = chunk;
+
+    KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t>
+    hm_ra(pow2_hash_size_ra, max_nnz_ra, NULL, NULL, NULL, NULL);
+    KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t>
+    hm_c(pow2_hash_size_c, max_nnz_c, NULL, NULL, NULL, NULL);
+
+    lno_t *used_hashes_ra = ptr; ptr += pow2_hash_size_ra;
+    hm_ra.hash_begins = ptr; ptr += pow2_hash_size_ra;
+    hm_ra.hash_nexts = ptr; ptr += max_nnz_ra;
+    hm_ra.keys = ptr; ptr += max_nnz_ra;
+    lno_t *used_hashes_c = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_begins = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_nexts = ptr; ptr += max_nnz_c;
+    hm_c.keys = ptr;
+
+    const lno_t hash_func_ra = pow2_hash_size_ra - 1;
+    const lno_t hash_func_c = pow2_hash_size_c - 1;
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, team_row_begin, team_row_end), [&] (const lno_t& row_index) {
+      lno_t used_size_ra = 0, used_hash_count_ra = 0;
+      lno_t used_size_c = 0, used_hash_count_c = 0;
+
+      for (size_type r = row_mapR(row_index); r < row_mapR(row_index + 1); ++r){
+        const lno_t rowA = entriesR(r);
+        for (size_type a = row_mapA(rowA); a < row_mapA(rowA + 1); ++a){
+          const lno_t key = entriesA(a);
+          hm_ra.sequential_insert_into_hash_TrackHashes(
+              key & hash_func_ra, key,
+              &used_size_ra, max_nnz_ra,
+              &used_hash_count_ra, used_hashes_ra);
+        }
+      }
+      for (lno_t t = 0; t < used_size_ra; ++t){
+        const lno_t rowP = hm_ra.keys[t];
+        for (size_type p = row_mapP(rowP); p < row_mapP(rowP + 1); ++p){
+          const lno_t key = entriesP(p);
+          hm_c.sequential_insert_into_hash_TrackHashes(
+              key & hash_func_c, key,
+              &used_size_c, max_nnz_c,
+              &used_hash_count_c, used_hashes_c);
+        }
+      }
+      for (lno_t i = 0; i < used_hash_count_ra; ++i){
+        hm_ra.hash_begins[used_hashes_ra[i]] = -1;
+      }
+      for (lno_t i = 0; i < used_hash_count_c; ++i){
+        hm_c.hash_begins[used_hashes_c[i]] = -1;
+      }
+      rowmapC(row_index) = used_size_c;
+    });
+    memory_space.release_chunk(chunk);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const NumericTag&, const team_member_t & teamMember) const {
+    const lno_t team_row_begin = teamMember.league_rank() * team_work_size;
+    const lno_t team_row_end = KOKKOSKERNELS_MACRO_MIN(team_row_begin + team_work_size, m);
+
+    volatile lno_t * tmp = NULL;
+    size_t tid = team_row_begin + teamMember.team_rank();
+    while (tmp == NULL){
+      tmp = (volatile lno_t * )( memory_space.allocate_chunk(tid));
+    }
+    lno_t *chunk = (lno_t *) tmp;
+    lno_t *ptr = chunk;
+
+    KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t>
+    hm_ra(pow2_hash_size_ra, max_nnz_ra, NULL, NULL, NULL, NULL);
+    KokkosKernels::Experimental::HashmapAccumulator<lno_t,lno_t,scalar_t>
+    hm_c(pow2_hash_size_c, max_nnz_c, NULL, NULL, NULL, NULL);
+
+    hm_ra.values = (scalar_t *) ptr; ptr += value_block_size;
+    lno_t *used_hashes_ra = ptr; ptr += pow2_hash_size_ra;
+    hm_ra.hash_begins = ptr; ptr += pow2_hash_size_ra;
+    hm_ra.hash_nexts = ptr; ptr += max_nnz_ra;
+    hm_ra.keys = ptr; ptr += max_nnz_ra;
+    lno_t *used_hashes_c = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_begins = ptr; ptr += pow2_hash_size_c;
+    hm_c.hash_nexts = ptr;
+
+    const lno_t hash_func_ra = pow2_hash_size_ra - 1;
+    const lno_t hash_func_c = pow2_hash_size_c - 1;
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, team_row_begin, team_row_end), [&] (const lno_t& row_index) {
+      lno_t used_size_ra = 0, used_hash_count_ra = 0;
+      lno_t used_size_c = 0, used_hash_count_c = 0;
+
+      const size_type c_row_begin = rowmapC(row_index);
+      hm_c.max_value_size = rowmapC(row_index + 1) - c_row_begin;
+      hm_c.keys = entriesC.data() + c_row_begin;
+      hm_c.values = valuesC.data() + c_row_begin;
+
+      for (size_type r = row_mapR(row_index); r < row_mapR(row_index + 1); ++r){
+        const lno_t rowA = entriesR(r);
+        const scalar_t valR = valuesR(r);
+        for (size_type a = row_mapA(rowA); a < row_mapA(rowA + 1); ++a){
+          const lno_t key = entriesA(a);
+          hm_ra.sequential_insert_into_hash_mergeAdd_TrackHashes(
+              key & hash_func_ra, key, valR * valuesA(a),
+              &used_size_ra, max_nnz_ra,
+              &used_hash_count_ra, used_hashes_ra);
+        }
+      }
+      for (lno_t t = 0; t < used_size_ra; ++t){
+        const lno_t rowP = hm_ra.keys[t];
+        const scalar_t valRA = hm_ra.values[t];
+        for (size_type p = row_mapP(rowP); p < row_mapP(rowP + 1); ++p){
+          const lno_t key = entriesP(p);
+          hm_c.sequential_insert_into_hash_mergeAdd_TrackHashes(
+              key & hash_func_c, key, valRA * valuesP(p),
+              &used_size_c, hm_c.max_value_size,
+              &used_hash_count_c, used_hashes_c);
+        }
+      }
+      for (lno_t i = 0; i < used_hash_count_ra; ++i){
+        hm_ra.hash_begins[used_hashes_ra[i]] = -1;
+      }
+      for (lno_t i = 0; i < used_hash_count_c; ++i){
+        hm_c.hash_begins[used_hashes_c[i]] = -1;
+      }
+    });
+    memory_space.release_chunk(chunk);
+  }
+};
+
+/**
+ * \brief Upper bound for the row sizes of R*A: the max flops of a row,
+ * capped by the number of columns k of A.
+ */
+template <typename KernelHandle,
+          typename r_row_view_t, typename r_nnz_view_t,
+          typename a_row_view_t>
+typename KernelHandle::nnz_lno_t spgemm_max_row_flops_bound(
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t k,
+    r_row_view_t row_mapR,
+    r_nnz_view_t entriesR,
+    a_row_view_t row_mapA){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+
+  //the flops of R*A bound the row sizes of R*A.
+  SpgemmRowStats row_stats;
+  row_stats.a_max_row_nnz = row_stats.max_row_flops = row_stats.overall_flops = 0;
+  if (m > 0){
+    Kokkos::parallel_reduce("KokkosSparse::spgemm_triple::RowFlopsRA",
+        Kokkos::RangePolicy<MyExecSpace>(0, m),
+        SpgemmRowStatsFunctor<size_type, nnz_lno_t, r_row_view_t, r_nnz_view_t, a_row_view_t>(
+            row_mapR, entriesR, row_mapA),
+        row_stats);
+    MyExecSpace::fence();
+  }
+  return nnz_lno_t (KOKKOSKERNELS_MACRO_MIN(row_stats.max_row_flops, size_t (k)));
+}
+
+//smallest power of 2 not below max_nnz.
+template <typename lno_t>
+lno_t spgemm_pow2_hash_size(lno_t max_nnz){
+  lno_t pow2_hash_size = 1;
+  while (pow2_hash_size < max_nnz){
+    pow2_hash_size *= 2;
+  }
+  return pow2_hash_size;
+}
+
+template <typename KernelHandle,
+          typename r_row_view_t, typename r_nnz_view_t, typename r_scalar_view_t,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename p_row_view_t, typename p_nnz_view_t, typename p_scalar_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t>
+void spgemm_triple_run(
+    KernelHandle *handle,
+    bool numeric,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t max_nnz_ra,
+    typename KernelHandle::nnz_lno_t max_nnz_c,
+    r_row_view_t row_mapR, r_nnz_view_t entriesR, r_scalar_view_t valuesR,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA, a_scalar_view_t valuesA,
+    p_row_view_t row_mapP, p_nnz_view_t entriesP, p_scalar_view_t valuesP,
+    c_row_view_t row_mapC, c_nnz_view_t entriesC, c_scalar_view_t valuesC){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::nnz_scalar_t scalar_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::HandleTempMemorySpace MyTempMemorySpace;
+  typedef typename Kokkos::TeamPolicy<MyExecSpace>::member_type team_member_t;
+  typedef KokkosKernels::Impl::UniformMemoryPool<MyTempMemorySpace, nnz_lno_t> pool_memory_space;
+
+  typedef SpgemmTripleFunctor<size_type, nnz_lno_t, scalar_t,
+      r_row_view_t, r_nnz_view_t, r_scalar_view_t,
+      a_row_view_t, a_nnz_view_t, a_scalar_view_t,
+      p_row_view_t, p_nnz_view_t, p_scalar_view_t,
+      c_row_view_t, c_nnz_view_t, c_scalar_view_t,
+      pool_memory_space, team_member_t> triple_functor_t;
+  typedef Kokkos::TeamPolicy<typename triple_functor_t::SymbolicTag, MyExecSpace> symbolic_team_policy_t;
+  typedef Kokkos::TeamPolicy<typename triple_functor_t::NumericTag, MyExecSpace> numeric_team_policy_t;
+
+  if (m == 0) return;
+
+  nnz_lno_t pow2_hash_size_ra = spgemm_pow2_hash_size<nnz_lno_t>(max_nnz_ra);
+  nnz_lno_t pow2_hash_size_c = spgemm_pow2_hash_size<nnz_lno_t>(max_nnz_c);
+
+  //values of R*A go first in the chunk, chunks are kept aligned for scalar_t.
+  const size_t scalar_units = (sizeof(scalar_t) + sizeof(nnz_lno_t) - 1) / sizeof(nnz_lno_t);
+  nnz_lno_t value_block_size = numeric ? nnz_lno_t (max_nnz_ra * scalar_units) : 0;
+  size_t chunksize = value_block_size;
+  chunksize += 2 * pow2_hash_size_ra + 2 * max_nnz_ra; //used hashes, begins, nexts and keys of R*A
+  chunksize += 2 * pow2_hash_size_c + max_nnz_c; //used hashes, begins and nexts of C
+  if (!numeric) chunksize += max_nnz_c; //keys of C
+  chunksize = ((chunksize + 2 * scalar_units - 1) / (2 * scalar_units)) * (2 * scalar_units);
+
+  const int suggested_vector_size = 1;
+  const int suggested_team_size = handle->get_suggested_team_size(suggested_vector_size);
+  const int concurrency = MyExecSpace::concurrency();
+  const nnz_lno_t team_row_chunk_size = handle->get_team_work_size(suggested_team_size, concurrency, m);
+
+  size_t num_chunks = KOKKOSKERNELS_MACRO_MIN(size_t (concurrency), size_t (m));
+  pool_memory_space m_space(num_chunks, chunksize, -1, KokkosKernels::Impl::ManyThread2OneChunk);
+
+  if (handle->get_verbose()){
+    std::cout << "\tspgemm_triple " << (numeric ? "numeric" : "symbolic")
+              << " max_nnz_ra:" << max_nnz_ra << " max_nnz_c:" << max_nnz_c
+              << " chunk_size:" << chunksize << " num_chunks:" << num_chunks
+              << " team_size:" << suggested_team_size << std::endl;
+  }
+
+  triple_functor_t tf(
+      m,
+      row_mapR, entriesR, valuesR,
+      row_mapA, entriesA, valuesA,
+      row_mapP, entriesP, valuesP,
+      row_mapC, entriesC, valuesC,
+      m_space,
+      max_nnz_ra, pow2_hash_size_ra,
+      max_nnz_c, pow2_hash_size_c,
+      value_block_size, team_row_chunk_size);
+
+  if (numeric){
+    Kokkos::parallel_for("KokkosSparse::spgemm_triple::Numeric",
+        numeric_team_policy_t(m / team_row_chunk_size + 1, suggested_team_size, suggested_vector_size), tf);
+  }
+  else {
+    Kokkos::parallel_for("KokkosSparse::spgemm_triple::Symbolic",
+        symbolic_team_policy_t(m / team_row_chunk_size + 1, suggested_team_size, suggested_vector_size), tf);
+  }
+  MyExecSpace::fence();
+}
+
+template <typename KernelHandle,
+          typename r_row_view_t, typename r_nnz_view_t,
+          typename a_row_view_t, typename a_nnz_view_t,
+          typename p_row_view_t, typename p_nnz_view_t,
+          typename c_row_view_t>
+void spgemm_triple_symbolic_impl(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t n,
+    typename KernelHandle::nnz_lno_t k,
+    typename KernelHandle::nnz_lno_t l,
+    r_row_view_t row_mapR, r_nnz_view_t entriesR,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA,
+    p_row_view_t row_mapP, p_nnz_view_t entriesP,
+    c_row_view_t row_mapC){
+
+  typedef typename KernelHandle::size_type size_type;
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+  typedef typename KernelHandle::HandleExecSpace MyExecSpace;
+  typedef typename KernelHandle::scalar_temp_work_view_t scalar_view_t;
+  typedef typename KernelHandle::nnz_lno_temp_work_view_t nnz_view_t;
+  typedef typename KernelHandle::SPGEMMHandleType spgemmHandleType;
+
+  spgemmHandleType *sh = handle->get_spgemm_handle();
+
+  nnz_lno_t max_nnz_ra = spgemm_max_row_flops_bound<KernelHandle>(m, k, row_mapR, entriesR, row_mapA);
+
+  //each row of R*A adds at most max row size of P entries to a row of C.
+  size_type max_p_row_nnz = 0;
+  if (k > 0){
+    KokkosKernels::Impl::view_reduce_maxsizerow<p_row_view_t, MyExecSpace>(k, row_mapP, max_p_row_nnz);
+    MyExecSpace::fence();
+  }
+  nnz_lno_t max_nnz_c = nnz_lno_t (KOKKOSKERNELS_MACRO_MIN(size_t (max_nnz_ra) * size_t (max_p_row_nnz), size_t (l)));
+
+  Kokkos::deep_copy(Kokkos::subview(row_mapC, m), 0);
+  spgemm_triple_run(
+      handle, false, m, max_nnz_ra, max_nnz_c,
+      row_mapR, entriesR, scalar_view_t(),
+      row_mapA, entriesA, scalar_view_t(),
+      row_mapP, entriesP, scalar_view_t(),
+      row_mapC, nnz_view_t(), scalar_view_t());
+
+  size_type max_c_row_nnz = 0;
+  if (m > 0){
+    KokkosKernels::Impl::view_reduce_max<c_row_view_t, MyExecSpace>(m, row_mapC, max_c_row_nnz);
+  }
+  KokkosKernels::Impl::exclusive_parallel_prefix_sum<c_row_view_t, MyExecSpace>(m + 1, row_mapC);
+  MyExecSpace::fence();
+
+  auto d_c_nnz_size = Kokkos::subview(row_mapC, m);
+  auto h_c_nnz_size = Kokkos::create_mirror_view(d_c_nnz_size);
+  Kokkos::deep_copy(h_c_nnz_size, d_c_nnz_size);
+
+  sh->set_c_nnz(h_c_nnz_size());
+  sh->set_max_result_nnz(max_c_row_nnz);
+  sh->set_call_symbolic();
+}
+
+template <typename KernelHandle,
+          typename r_row_view_t, typename r_nnz_view_t, typename r_scalar_view_t,
+          typename a_row_view_t, typename a_nnz_view_t, typename a_scalar_view_t,
+          typename p_row_view_t, typename p_nnz_view_t, typename p_scalar_view_t,
+          typename c_row_view_t, typename c_nnz_view_t, typename c_scalar_view_t>
+void spgemm_triple_numeric_impl(
+    KernelHandle *handle,
+    typename KernelHandle::nnz_lno_t m,
+    typename KernelHandle::nnz_lno_t n,
+    typename KernelHandle::nnz_lno_t k,
+    typename KernelHandle::nnz_lno_t l,
+    r_row_view_t row_mapR, r_nnz_view_t entriesR, r_scalar_view_t valuesR,
+    a_row_view_t row_mapA, a_nnz_view_t entriesA, a_scalar_view_t valuesA,
+    p_row_view_t row_mapP, p_nnz_view_t entriesP, p_scalar_view_t valuesP,
+    c_row_view_t row_mapC, c_nnz_view_t entriesC, c_scalar_view_t valuesC){
+
+  typedef typename KernelHandle::nnz_lno_t nnz_lno_t;
+
+  nnz_lno_t max_nnz_ra = spgemm_max_row_flops_bound<KernelHandle>(m, k, row_mapR, entriesR, row_mapA);
+  nnz_lno_t max_nnz_c = handle->get_spgemm_handle()->get_max_result_nnz();
+
+  spgemm_triple_run(
+      handle, true, m, max_nnz_ra, max_nnz_c,
+      row_mapR, entriesR, valuesR,
+      row_mapA, entriesA, valuesA,
+      row_mapP, entriesP, valuesP,
+      row_mapC, entriesC, valuesC);
+}
+
+}
+}
+#endif
@@ -0,0 +1,456 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSSPARSE_IMPL_SPILUK_HPP_
+#define KOKKOSSPARSE_IMPL_SPILUK_HPP_
+
+/// \file KokkosSparse_spiluk_impl.hpp
+/// \brief Implementation(s) of the level scheduled incomplete LU factorization.
+
+#include <KokkosKernels_config.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosSparse_findRelOffset.hpp"
+#include "KokkosSparse_spiluk_handle.hpp"
+#include "KokkosSparse_block_dag_impl.hpp"
+
+#include <vector>
+#include <map>
+#include <stdexcept>
+
+namespace KokkosSparse {
+namespace Impl {
+
+/**
+ * \brief Symbolic phase of ILU(k). Computes the patterns of L and U row by
+ * row on the host: an entry (i, j) is kept if its level of fill is at most
+ * k, where the entries of A have level 0, and eliminating (i, m) with row m
+ * of U gives (i, j) the level lev(i, m) + lev(m, j) + 1. The diagonal is
+ * always added to the pattern. Then computes the level schedule of the rows:
+ * row i is factored in the level after the last row of its L part.
+ */
+template <class ILUKHandle, class RowMapType, class EntriesType>
+void iluk_symbolic(ILUKHandle &thandle, const RowMapType drow_map, const EntriesType dentries)
+{
+  typedef typename ILUKHandle::size_type size_type;
+  typedef typename ILUKHandle::nnz_lno_t nnz_lno_t;
+  typedef typename ILUKHandle::nnz_lno_view_t nnz_lno_view_t;
+  typedef typename ILUKHandle::nnz_lno_view_host_t nnz_lno_view_host_t;
+  typedef typename ILUKHandle::nnz_row_view_t nnz_row_view_t;
+  typedef typename ILUKHandle::nnz_row_view_host_t nnz_row_view_host_t;
+
+  const nnz_lno_t nrows = drow_map.extent(0) ? drow_map.extent(0) - 1 : 0;
+  const nnz_lno_t fill_level = thandle.get_fill_level();
+  thandle.new_init_handle(nrows);
+
+  typename RowMapType::HostMirror row_map = Kokkos::create_mirror_view(drow_map);
+  Kokkos::deep_copy(row_map, drow_map);
+  typename EntriesType::HostMirror entries = Kokkos::create_mirror_view(dentries);
+  Kokkos::deep_copy(entries, dentries);
+
+  nnz_lno_view_t dlevel_list = thandle.get_level_list();
+  nnz_lno_view_host_t level_list = Kokkos::create_mirror_view(dlevel_list);
+  nnz_lno_view_t dnodes_grouped_by_level = thandle.get_nodes_grouped_by_level();
+  nnz_lno_view_host_t nodes_grouped_by_level = Kokkos::create_mirror_view(dnodes_grouped_by_level);
+
+  std::vector<size_type> L_ptr(nrows + 1, 0), U_ptr(nrows + 1, 0);
+  std::vector<nnz_lno_t> L_cols, U_cols, U_levels;
+  nnz_lno_t nlevels = 0;
+  for (nnz_lno_t i = 0; i < nrows; ++i){
+    //column -> level of fill of row i, in increasing column order, so
+    //that the fill entries inserted by an elimination are visited later.
+    std::map<nnz_lno_t, nnz_lno_t> row;
+    for (size_type k = row_map(i); k < row_map(i + 1); ++k){
+      const nnz_lno_t colid = entries(k);
+      if (colid < 0 || colid >= nrows){
+        throw std::runtime_error("spiluk_symbolic: column index out of range, the matrix must be square");
+      }
+      row[colid] = 0;
+    }
+    row[i] = 0;
+
+    nnz_lno_t level = 0;
+    for (typename std::map<nnz_lno_t, nnz_lno_t>::iterator it = row.begin(); it != row.end() && it->first < i; ++it){
+      const nnz_lno_t m = it->first;
+      const nnz_lno_t lev_im = it->second;
+      if (level <= level_list(m)) level = level_list(m) + 1;
+      //skip the pivot of row m of U
+      for (size_type q = U_ptr[m] + 1; q < U_ptr[m + 1]; ++q){
+        const nnz_lno_t lev = lev_im + U_levels[q] + 1;
+        if (lev > fill_level) continue;
+        typename std::map<nnz_lno_t, nnz_lno_t>::iterator f = row.find(U_cols[q]);
+        if (f == row.end()){
+          row[U_cols[q]] = lev;
+        }
+        else if (lev < f->second){
+          f->second = lev;
+        }
+      }
+    }
+    level_list(i) = level;
+    if (nlevels <= level) nlevels = level + 1;
+
+    //L gets the unit diagonal last, U the pivot first.
+    for (typename std::map<nnz_lno_t, nnz_lno_t>::iterator it = row.begin(); it != row.end(); ++it){
+      if (it->first < i){
+        L_cols.push_back(it->first);
+      }
+      else {
+        U_cols.push_back(it->first);
+        U_levels.push_back(it->second);
+      }
+    }
+    L_cols.push_back(i);
+    L_ptr[i + 1] = L_cols.size();
+    U_ptr[i + 1] = U_cols.size();
+  }
+
+  nnz_row_view_t dL_row_map("L_row_map", nrows + 1);
+  nnz_lno_view_t dL_entries("L_entries", L_cols.size());
+  nnz_row_view_t dU_row_map("U_row_map", nrows + 1);
+  nnz_lno_view_t dU_entries("U_entries", U_cols.size());
+  {
+    nnz_row_view_host_t hL_row_map = Kokkos::create_mirror_view(dL_row_map);
+    nnz_lno_view_host_t hL_entries = Kokkos::create_mirror_view(dL_entries);
+    nnz_row_view_host_t hU_row_map = Kokkos::create_mirror_view(dU_row_map);
+    nnz_lno_view_host_t hU_entries = Kokkos::create_mirror_view(dU_entries);
+    for (nnz_lno_t i = 0; i <= nrows; ++i){
+      hL_row_map(i) = L_ptr[i];
+      hU_row_map(i) = U_ptr[i];
+    }
+    for (size_t k = 0; k < L_cols.size(); ++k) hL_entries(k) = L_cols[k];
+    for (size_t k = 0; k < U_cols.size(); ++k) hU_entries(k) = U_cols[k];
+    Kokkos::deep_copy(dL_row_map, hL_row_map);
+    Kokkos::deep_copy(dL_entries, hL_entries);
+    Kokkos::deep_copy(dU_row_map, hU_row_map);
+    Kokkos::deep_copy(dU_entries, hU_entries);
+
+    //block DAG of the task based factorization: row i is factored with
+    //the rows of U given by the pattern of row i of L.
+    if (thandle.get_algorithm_type() == SPILUK_TASK){
+      nnz_row_view_host_t task_dep_ptr;
+      nnz_lno_view_host_t task_deps;
+      const nnz_lno_t ntask_blocks = build_block_dag(nrows, thandle.get_task_block_size(),
+          hL_row_map, hL_entries, task_dep_ptr, task_deps);
+      thandle.set_task_dag(ntask_blocks, task_dep_ptr, task_deps);
+    }
+  }
+  thandle.set_factor_patterns(dL_row_map, dL_entries, dU_row_map, dU_entries);
+
+  //group the rows by level with a counting sort.
+  nnz_lno_view_host_t level_ptr("level_ptr", nlevels + 1);
+  for (nnz_lno_t i = 0; i < nrows; ++i){
+    ++level_ptr(level_list(i) + 1);
+  }
+  nnz_lno_t max_level_size = 0;
+  for (nnz_lno_t l = 0; l < nlevels; ++l){
+    if (max_level_size < level_ptr(l + 1)) max_level_size = level_ptr(l + 1);
+    level_ptr(l + 1) += level_ptr(l);
+  }
+  {
+    std::vector<nnz_lno_t> level_fill(level_ptr.data(), level_ptr.data() + nlevels);
+    for (nnz_lno_t i = 0; i < nrows; ++i){
+      nodes_grouped_by_level(level_fill[level_list(i)]++) = i;
+    }
+  }
+  Kokkos::deep_copy(dlevel_list, level_list);
+  Kokkos::deep_copy(dnodes_grouped_by_level, nodes_grouped_by_level);
+
+  thandle.set_level_ptr(level_ptr);
+  thandle.set_num_levels(nlevels);
+  thandle.set_max_level_size(max_level_size);
+  thandle.set_symbolic_complete();
+}
+
+/**
+ * \brief Factors the rows of a single level, one thread per row. The row of
+ * A is copied into the patterns of L and U, then the entries of L are
+ * eliminated in increasing column order with the rows of U of the previous
+ * levels; updates outside the pattern are dropped. A must not have
+ * duplicate entries.
+ */
+template <class ARowMapType, class AEntriesType, class AValuesType,
+          class LURowMapType, class LUEntriesType, class LUValuesType, class NGBLType>
+struct ILUKLvlSchedRPNumericFunctor
+{
+  typedef typename LURowMapType::non_const_value_type size_type;
+  typedef typename LUEntriesType::non_const_value_type lno_t;
+  typedef typename LUValuesType::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> STS;
+
+  ARowMapType A_row_map;
+  AEntriesType A_entries;
+  AValuesType A_values;
+  LURowMapType L_row_map;
+  LUEntriesType L_entries;
+  LUValuesType L_values;
+  LURowMapType U_row_map;
+  LUEntriesType U_entries;
+  LUValuesType U_values;
+  NGBLType nodes_grouped_by_level;
+
+  ILUKLvlSchedRPNumericFunctor(
+      const ARowMapType &A_row_map_, const AEntriesType &A_entries_, const AValuesType &A_values_,
+      const LURowMapType &L_row_map_, const LUEntriesType &L_entries_, const LUValuesType &L_values_,
+      const LURowMapType &U_row_map_, const LUEntriesType &U_entries_, const LUValuesType &U_values_,
+      const NGBLType &nodes_grouped_by_level_):
+    A_row_map(A_row_map_), A_entries(A_entries_), A_values(A_values_),
+    L_row_map(L_row_map_), L_entries(L_entries_), L_values(L_values_),
+    U_row_map(U_row_map_), U_entries(U_entries_), U_values(U_values_),
+    nodes_grouped_by_level(nodes_grouped_by_level_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t i) const {
+    apply_row(nodes_grouped_by_level(i));
+  }
+
+  //factors row rowid, once the rows of its L part are factored.
+  KOKKOS_INLINE_FUNCTION
+  void apply_row(const lno_t rowid) const {
+    const size_type l_begin = L_row_map(rowid);
+    const size_type l_diag = L_row_map(rowid + 1) - 1;
+    const size_type u_begin = U_row_map(rowid);
+    const size_type u_end = U_row_map(rowid + 1);
+
+    for (size_type p = l_begin; p < l_diag; ++p) L_values(p) = STS::zero();
+    L_values(l_diag) = STS::one();
+    for (size_type p = u_begin; p < u_end; ++p) U_values(p) = STS::zero();
+    for (size_type k = A_row_map(rowid); k < A_row_map(rowid + 1); ++k){
+      const lno_t colid = A_entries(k);
+      if (colid < rowid){
+        const size_type off = findRelOffset(L_entries.data() + l_begin, l_diag - l_begin, colid, size_type(0), true);
+        L_values(l_begin + off) = A_values(k);
+      }
+      else {
+        const size_type off = findRelOffset(U_entries.data() + u_begin, u_end - u_begin, colid, size_type(0), true);
+        U_values(u_begin + off) = A_values(k);
+      }
+    }
+
+    for (size_type p = l_begin; p < l_diag; ++p){
+      const lno_t m = L_entries(p);
+      const scalar_t l_im = L_values(p) / U_values(U_row_map(m));
+      L_values(p) = l_im;
+      for (size_type q = U_row_map(m) + 1; q < U_row_map(m + 1); ++q){
+        const lno_t colid = U_entries(q);
+        if (colid < rowid){
+          const size_type off = findRelOffset(L_entries.data() + p + 1, l_diag - p - 1, colid, size_type(0), true);
+          if (off < l_diag - p - 1) L_values(p + 1 + off) -= l_im * U_values(q);
+        }
+        else {
+          const size_type off = findRelOffset(U_entries.data() + u_begin, u_end - u_begin, colid, size_type(0), true);
+          if (off < u_end - u_begin) U_values(u_begin + off) -= l_im * U_values(q);
+        }
+      }
+    }
+  }
+};
+
+/**
+ * \brief Factors the rows of a single level, one team per row. The threads
+ * of the team share the copy of the row of A and the update of the row with
+ * each row of U, and synchronize between the eliminations.
+ */
+template <class TeamPolicy, class ARowMapType, class AEntriesType, class AValuesType,
+          class LURowMapType, class LUEntriesType, class LUValuesType, class NGBLType>
+struct ILUKLvlSchedTP1NumericFunctor
+{
+  typedef typename TeamPolicy::member_type team_member_t;
+  typedef typename LURowMapType::non_const_value_type size_type;
+  typedef typename LUEntriesType::non_const_value_type lno_t;
+  typedef typename LUValuesType::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> STS;
+
+  ARowMapType A_row_map;
+  AEntriesType A_entries;
+  AValuesType A_values;
+  LURowMapType L_row_map;
+  LUEntriesType L_entries;
+  LUValuesType L_values;
+  LURowMapType U_row_map;
+  LUEntriesType U_entries;
+  LUValuesType U_values;
+  NGBLType nodes_grouped_by_level;
+  lno_t node_begin;
+
+  ILUKLvlSchedTP1NumericFunctor(
+      const ARowMapType &A_row_map_, const AEntriesType &A_entries_, const AValuesType &A_values_,
+      const LURowMapType &L_row_map_, const LUEntriesType &L_entries_, const LUValuesType &L_values_,
+      const LURowMapType &U_row_map_, const LUEntriesType &U_entries_, const LUValuesType &U_values_,
+      const NGBLType &nodes_grouped_by_level_, lno_t node_begin_):
+    A_row_map(A_row_map_), A_entries(A_entries_), A_values(A_values_),
+    L_row_map(L_row_map_), L_entries(L_entries_), L_values(L_values_),
+    U_row_map(U_row_map_), U_entries(U_entries_), U_values(U_values_),
+    nodes_grouped_by_level(nodes_grouped_by_level_), node_begin(node_begin_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const team_member_t &teamMember) const {
+    const lno_t rowid = nodes_grouped_by_level(node_begin + teamMember.league_rank());
+    const size_type l_begin = L_row_map(rowid);
+    const size_type l_diag = L_row_map(rowid + 1) - 1;
+    const size_type u_begin = U_row_map(rowid);
+    const size_type u_end = U_row_map(rowid + 1);
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, l_begin, l_diag + 1), [&] (const size_type p) {
+      L_values(p) = p == l_diag ? STS::one() : STS::zero();
+    });
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, u_begin, u_end), [&] (const size_type p) {
+      U_values(p) = STS::zero();
+    });
+    teamMember.team_barrier();
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, A_row_map(rowid), A_row_map(rowid + 1)), [&] (const size_type k) {
+      const lno_t colid = A_entries(k);
+      if (colid < rowid){
+        const size_type off = findRelOffset(L_entries.data() + l_begin, l_diag - l_begin, colid, size_type(0), true);
+        L_values(l_begin + off) = A_values(k);
+      }
+      else {
+        const size_type off = findRelOffset(U_entries.data() + u_begin, u_end - u_begin, colid, size_type(0), true);
+        U_values(u_begin + off) = A_values(k);
+      }
+    });
+    teamMember.team_barrier();
+
+    for (size_type p = l_begin; p < l_diag; ++p){
+      const lno_t m = L_entries(p);
+      const scalar_t l_im = L_values(p) / U_values(U_row_map(m));
+      //all threads read L_values(p) before it is overwritten.
+      teamMember.team_barrier();
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, U_row_map(m) + 1, U_row_map(m + 1)), [&] (const size_type q) {
+        const lno_t colid = U_entries(q);
+        if (colid < rowid){
+          const size_type off = findRelOffset(L_entries.data() + p + 1, l_diag - p - 1, colid, size_type(0), true);
+          if (off < l_diag - p - 1) L_values(p + 1 + off) -= l_im * U_values(q);
+        }
+        else {
+          const size_type off = findRelOffset(U_entries.data() + u_begin, u_end - u_begin, colid, size_type(0), true);
+          if (off < u_end - u_begin) U_values(u_begin + off) -= l_im * U_values(q);
+        }
+      });
+      Kokkos::single(Kokkos::PerTeam(teamMember), [&] () {
+        L_values(p) = l_im;
+      });
+      teamMember.team_barrier();
+    }
+  }
+};
+
+/**
+ * \brief Numeric phase of ILU(k): factors the levels one after the other,
+ * the rows of a level in parallel. SPILUK_TASK factors the blocks of rows
+ * of the block DAG as Kokkos tasks when KOKKOS_ENABLE_TASKDAG is defined,
+ * and by levels otherwise.
+ */
+template <class KernelHandle, class ARowMapType, class AEntriesType, class AValuesType,
+          class LUValuesType>
+void iluk_numeric(
+    KernelHandle *handle,
+    const ARowMapType A_row_map, const AEntriesType A_entries, const AValuesType A_values,
+    LUValuesType L_values, LUValuesType U_values)
+{
+  typedef typename KernelHandle::HandleExecSpace execution_space;
+  typedef typename KernelHandle::SPILUKHandleType ILUKHandle;
+  typedef typename ILUKHandle::nnz_lno_t lno_t;
+  typedef typename ILUKHandle::nnz_row_view_t LURowMapType;
+  typedef typename ILUKHandle::nnz_lno_view_t LUEntriesType;
+  typedef typename ILUKHandle::nnz_lno_view_t NGBLType;
+
+  typedef Kokkos::RangePolicy<execution_space> range_policy_t;
+  typedef Kokkos::TeamPolicy<execution_space> team_policy_t;
+
+  ILUKHandle *thandle = handle->get_spiluk_handle();
+  const lno_t nlevels = thandle->get_num_levels();
+  NGBLType nodes_grouped_by_level = thandle->get_nodes_grouped_by_level();
+  typename ILUKHandle::nnz_lno_view_host_t level_ptr = thandle->get_level_ptr();
+  LURowMapType L_row_map = thandle->get_L_row_map();
+  LUEntriesType L_entries = thandle->get_L_entries();
+  LURowMapType U_row_map = thandle->get_U_row_map();
+  LUEntriesType U_entries = thandle->get_U_entries();
+
+  const bool use_teams = thandle->get_algorithm_type() == SPILUK_LVLSCHD_TP1;
+
+#if defined(KOKKOS_ENABLE_TASKDAG)
+  //one task per block of rows, started when the blocks of its L part are
+  //factored, instead of one kernel per level.
+  if (thandle->get_algorithm_type() == SPILUK_TASK){
+    ILUKLvlSchedRPNumericFunctor<ARowMapType, AEntriesType, AValuesType,
+        LURowMapType, LUEntriesType, LUValuesType, NGBLType>
+      tstf(A_row_map, A_entries, A_values, L_row_map, L_entries, L_values,
+           U_row_map, U_entries, U_values, nodes_grouped_by_level);
+    run_block_dag<execution_space>(tstf, thandle->get_nrows(), thandle->get_task_block_size(),
+        thandle->get_task_dep_ptr(), thandle->get_task_deps(), false);
+    execution_space::fence();
+    thandle->set_numeric_complete();
+    return;
+  }
+#endif
+
+  for (lno_t lvl = 0; lvl < nlevels; ++lvl){
+    const lno_t node_begin = level_ptr(lvl);
+    const lno_t node_end = level_ptr(lvl + 1);
+
+    if (use_teams){
+      ILUKLvlSchedTP1NumericFunctor<team_policy_t, ARowMapType, AEntriesType, AValuesType,
+          LURowMapType, LUEntriesType, LUValuesType, NGBLType>
+        tstf(A_row_map, A_entries, A_values, L_row_map, L_entries, L_values,
+             U_row_map, U_entries, U_values, nodes_grouped_by_level, node_begin);
+      Kokkos::parallel_for("KokkosSparse::spiluk::lvl_sched_team",
+          team_policy_t(node_end - node_begin, Kokkos::AUTO), tstf);
+    }
+    else {
+      ILUKLvlSchedRPNumericFunctor<ARowMapType, AEntriesType, AValuesType,
+          LURowMapType, LUEntriesType, LUValuesType, NGBLType>
+        tstf(A_row_map, A_entries, A_values, L_row_map, L_entries, L_values,
+             U_row_map, U_entries, U_values, nodes_grouped_by_level);
+      Kokkos::parallel_for("KokkosSparse::spiluk::lvl_sched_range",
+          range_policy_t(node_begin, node_end), tstf);
+    }
+  }
+  execution_space::fence();
+  thandle->set_numeric_complete();
+}
+
+} // namespace Impl
+} // namespace KokkosSparse
+
+#endif // KOKKOSSPARSE_IMPL_SPILUK_HPP_
@@ -0,0 +1,194 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_IMPL_SPMM_DENSE_HPP_
+#define KOKKOSSPARSE_IMPL_SPMM_DENSE_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmv_handle.hpp"
+#include "KokkosSparse_spmv_handle_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+namespace Impl {
+
+// One iteration per row j of A^T and block of TILE vectors. The TILE sums of
+// the block stay in registers, and each entry of the row updates all of them,
+// so that y is written once and without atomics.
+// With dense_left, computes Y = beta*Y + alpha*X*A and the vectors are the
+// rows of X (p x m) and Y (p x n), otherwise Y = beta*Y + alpha*A^T*X and the
+// vectors are the columns of X (m x p) and Y (n x p).
+template<class TMatrix,
+         class XView,
+         class YView,
+         int dobeta,
+         int TILE,
+         bool dense_left>
+struct SPMM_Dense_Tile_Functor {
+  typedef typename TMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename TMatrix::non_const_value_type       value_type;
+  typedef typename YView::non_const_value_type         y_value_type;
+
+  const y_value_type alpha;
+  TMatrix m_At;
+  XView m_x;
+  const y_value_type beta;
+  YView m_y;
+  const ordinal_type num_vectors;
+  const ordinal_type num_blocks;
+
+  SPMM_Dense_Tile_Functor (const y_value_type alpha_,
+                           const TMatrix m_At_,
+                           const XView m_x_,
+                           const y_value_type beta_,
+                           const YView m_y_,
+                           const ordinal_type num_vectors_) :
+    alpha (alpha_), m_At (m_At_), m_x (m_x_),
+    beta (beta_), m_y (m_y_), num_vectors (num_vectors_),
+    num_blocks ((num_vectors_ + TILE - 1) / TILE) {}
+
+  KOKKOS_INLINE_FUNCTION
+  typename XView::const_value_type x_at (const ordinal_type& row, const ordinal_type& k) const {
+    return dense_left ? m_x(k, row) : m_x(row, k);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  typename YView::reference_type y_at (const ordinal_type& row, const ordinal_type& k) const {
+    return dense_left ? m_y(k, row) : m_y(row, k);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& iter) const
+  {
+    const ordinal_type row = iter / num_blocks;
+    const ordinal_type k0 = (iter % num_blocks) * TILE;
+    const ordinal_type width = num_vectors - k0 < TILE ? num_vectors - k0 : TILE;
+
+    y_value_type sum[TILE];
+#ifdef KOKKOS_ENABLE_PRAGMA_UNROLL
+#pragma unroll
+#endif
+    for (int k = 0; k < TILE; ++k) {
+      sum[k] = Kokkos::Details::ArithTraits<y_value_type>::zero ();
+    }
+
+    const auto t_row = m_At.rowConst (row);
+    if (width == TILE) {
+      for (ordinal_type iEntry = 0; iEntry < t_row.length; ++iEntry) {
+        const value_type val = t_row.value(iEntry);
+        const ordinal_type ind = t_row.colidx(iEntry);
+#ifdef KOKKOS_ENABLE_PRAGMA_UNROLL
+#pragma unroll
+#endif
+        for (int k = 0; k < TILE; ++k) {
+          sum[k] += val * x_at (ind, k0 + k);
+        }
+      }
+    }
+    else {
+      for (ordinal_type iEntry = 0; iEntry < t_row.length; ++iEntry) {
+        const value_type val = t_row.value(iEntry);
+        const ordinal_type ind = t_row.colidx(iEntry);
+        for (ordinal_type k = 0; k < width; ++k) {
+          sum[k] += val * x_at (ind, k0 + k);
+        }
+      }
+    }
+
+    for (ordinal_type k = 0; k < width; ++k) {
+      if (dobeta == 0) {
+        y_at (row, k0 + k) = alpha * sum[k];
+      } else {
+        y_at (row, k0 + k) = beta * y_at (row, k0 + k) + alpha * sum[k];
+      }
+    }
+  }
+};
+
+template<class TMatrix, class XView, class YView, int dobeta, int TILE, bool dense_left>
+void spmm_dense_tile (typename YView::const_value_type& alpha, const TMatrix& At, const XView& X,
+                      typename YView::const_value_type& beta, const YView& Y,
+                      typename TMatrix::non_const_ordinal_type num_vectors)
+{
+  typedef typename TMatrix::execution_space execution_space;
+  typedef typename TMatrix::non_const_ordinal_type ordinal_type;
+  SPMM_Dense_Tile_Functor<TMatrix,XView,YView,dobeta,TILE,dense_left> func (alpha,At,X,beta,Y,num_vectors);
+  const ordinal_type num_iters = At.numRows () * func.num_blocks;
+  Kokkos::parallel_for (dense_left ? "KokkosSparse::dense_spmm" : "KokkosSparse::spmm_transpose",
+      Kokkos::RangePolicy<execution_space> (0, num_iters), func);
+}
+
+// The smallest tile of 8, 16, 32 or 64 vectors that holds all the vectors,
+// 64 for more. On Cuda the tile is at most 16, to keep the sums in registers.
+template<class TMatrix, class XView, class YView, int dobeta, bool dense_left>
+void spmm_dense_beta (typename YView::const_value_type& alpha, const TMatrix& At, const XView& X,
+                      typename YView::const_value_type& beta, const YView& Y,
+                      typename TMatrix::non_const_ordinal_type num_vectors)
+{
+  if (num_vectors == 0 || At.numRows () == 0) {
+    return;
+  }
+  bool is_cuda = false;
+#ifdef KOKKOS_ENABLE_CUDA
+  is_cuda = std::is_same<typename TMatrix::execution_space, Kokkos::Cuda>::value;
+#endif
+  if (num_vectors <= 8) {
+    spmm_dense_tile<TMatrix, XView, YView, dobeta, 8, dense_left> (alpha, At, X, beta, Y, num_vectors);
+  }
+  else if (num_vectors <= 16 || is_cuda) {
+    spmm_dense_tile<TMatrix, XView, YView, dobeta, 16, dense_left> (alpha, At, X, beta, Y, num_vectors);
+  }
+  else if (num_vectors <= 32) {
+    spmm_dense_tile<TMatrix, XView, YView, dobeta, 32, dense_left> (alpha, At, X, beta, Y, num_vectors);
+  }
+  else {
+    spmm_dense_tile<TMatrix, XView, YView, dobeta, 64, dense_left> (alpha, At, X, beta, Y, num_vectors);
+  }
+}
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,253 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_IMPL_SPMM_HPP_
+#define KOKKOSSPARSE_IMPL_SPMM_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosSparse_CrsMatrix.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+// Sparse matrix times a dense multivector with many columns. Each vector
+// lane of a row accumulates TILE columns, vector_length apart, in registers,
+// so an entry of A is loaded once per vector_length * TILE columns. On the
+// host vector_length is 1 and a lane owns TILE consecutive columns, which are
+// contiguous in x and y for LayoutRight. On Cuda the lanes of a row read
+// consecutive columns, which coalesces for LayoutRight, and a row of A is
+// broadcast to the lanes instead of being reduced over them.
+//! Multivectors with more columns than this use the tiled kernel.
+enum : size_t { spmm_min_num_columns = 4 };
+
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int doalpha,
+         int dobeta,
+         bool conjugate,
+         int TILE>
+struct SPMM_Tiled_Functor {
+  typedef typename AMatrix::execution_space            execution_space;
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::non_const_value_type       A_value_type;
+  typedef typename YVector::non_const_value_type       y_value_type;
+  typedef typename Kokkos::TeamPolicy<execution_space> team_policy;
+  typedef typename team_policy::member_type            team_member;
+  typedef Kokkos::Details::ArithTraits<A_value_type>   ATV;
+
+  const y_value_type alpha;
+  AMatrix m_A;
+  XVector m_x;
+  const y_value_type beta;
+  YVector m_y;
+  //! The number of columns in the input and output MultiVectors.
+  ordinal_type n;
+  ordinal_type rows_per_team;
+  ordinal_type vector_length;
+
+  SPMM_Tiled_Functor (const y_value_type& alpha_,
+                      const AMatrix& m_A_,
+                      const XVector& m_x_,
+                      const y_value_type& beta_,
+                      const YVector& m_y_,
+                      const ordinal_type rows_per_team_,
+                      const ordinal_type vector_length_) :
+    alpha (alpha_), m_A (m_A_), m_x (m_x_), beta (beta_), m_y (m_y_),
+    n (m_x_.extent(1)), rows_per_team (rows_per_team_), vector_length (vector_length_)
+  {}
+
+  // Columns k0 + t * stride of row iRow, t < TILE; guarded when some of
+  // them are past the last column.
+  template<bool guarded>
+  KOKKOS_INLINE_FUNCTION void
+  tile (const ordinal_type iRow, const ordinal_type k0, const ordinal_type stride) const
+  {
+    y_value_type sum[TILE];
+#ifdef KOKKOS_ENABLE_PRAGMA_UNROLL
+#pragma unroll
+#endif
+    for (int t = 0; t < TILE; ++t) {
+      sum[t] = Kokkos::Details::ArithTraits<y_value_type>::zero ();
+    }
+
+    const auto row = m_A.rowConst (iRow);
+    for (ordinal_type iEntry = 0; iEntry < row.length; ++iEntry) {
+      const A_value_type val = conjugate ? ATV::conj (row.value(iEntry)) : row.value(iEntry);
+      const ordinal_type ind = row.colidx(iEntry);
+#ifdef KOKKOS_ENABLE_PRAGMA_IVDEP
+#pragma ivdep
+#endif
+#ifdef KOKKOS_ENABLE_PRAGMA_UNROLL
+#pragma unroll
+#endif
+      for (int t = 0; t < TILE; ++t) {
+        if (!guarded || k0 + t * stride < n) {
+          sum[t] += val * m_x(ind, k0 + t * stride);
+        }
+      }
+    }
+
+#ifdef KOKKOS_ENABLE_PRAGMA_UNROLL
+#pragma unroll
+#endif
+    for (int t = 0; t < TILE; ++t) {
+      const ordinal_type k = k0 + t * stride;
+      if (guarded && k >= n) {
+        continue;
+      }
+      y_value_type s = sum[t];
+      if (doalpha == -1) {
+        s = -s;
+      } else if (doalpha * doalpha != 1) {
+        s *= alpha;
+      }
+
+      if (dobeta == 0) {
+        m_y(iRow, k) = s;
+      } else if (dobeta == 1) {
+        m_y(iRow, k) += s;
+      } else if (dobeta == -1) {
+        m_y(iRow, k) = -m_y(iRow, k) + s;
+      } else {
+        m_y(iRow, k) = beta * m_y(iRow, k) + s;
+      }
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION void
+  operator() (const team_member& dev) const
+  {
+    Kokkos::parallel_for (Kokkos::TeamThreadRange (dev, rows_per_team), [&] (const ordinal_type& loop) {
+      const ordinal_type iRow = dev.league_rank () * rows_per_team + loop;
+      if (iRow >= m_A.numRows ()) {
+        return;
+      }
+      Kokkos::parallel_for (Kokkos::ThreadVectorRange (dev, vector_length), [&] (const ordinal_type& lane) {
+        const ordinal_type pass = vector_length * TILE;
+        ordinal_type kk = 0;
+        for (; kk + pass <= n; kk += pass) {
+          tile<false> (iRow, kk + lane, vector_length);
+        }
+        if (kk < n) {
+          tile<true> (iRow, kk + lane, vector_length);
+        }
+      });
+    });
+  }
+};
+
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int doalpha,
+         int dobeta,
+         bool conjugate,
+         int TILE>
+static void
+spmm_tiled_launch (const typename AMatrix::execution_space& space,
+                   const typename YVector::non_const_value_type& alpha,
+                   const AMatrix& A,
+                   const XVector& x,
+                   const typename YVector::non_const_value_type& beta,
+                   const YVector& y,
+                   const int vector_length)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type ordinal_type;
+  typedef SPMM_Tiled_Functor<AMatrix, XVector, YVector, doalpha, dobeta, conjugate, TILE> OpType;
+
+  const ordinal_type nrow = A.numRows ();
+  const ordinal_type NNZPerRow = static_cast<ordinal_type> (A.nnz () / nrow);
+  const int rows_per_thread = RowsPerThread<execution_space> (NNZPerRow * static_cast<ordinal_type> (x.extent(1)) / TILE);
+
+  OpType op (alpha, A, x, beta, y, 1, vector_length);
+  const int team_size = Kokkos::TeamPolicy<execution_space>::team_size_recommended (op, vector_length);
+  op.rows_per_team = rows_per_thread * team_size;
+  const ordinal_type nteams = (nrow + op.rows_per_team - 1) / op.rows_per_team;
+  Kokkos::parallel_for ("KokkosSparse::spmm<Tiled,NoTranspose>",
+                        Kokkos::TeamPolicy<execution_space> (space, nteams, team_size, vector_length), op);
+}
+
+/// \brief y = beta*y + alpha*A*x for multivectors with more than a few
+///   columns, a row of A is read once for each tile of columns.
+///
+/// On Cuda the columns are mapped to up to 32 vector lanes with 2 columns
+/// per lane; on the host a thread owns 8 or 16 consecutive columns.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int doalpha,
+         int dobeta,
+         bool conjugate>
+static void
+spmm_no_transpose (const typename AMatrix::execution_space& space,
+                   const typename YVector::non_const_value_type& alpha,
+                   const AMatrix& A,
+                   const XVector& x,
+                   const typename YVector::non_const_value_type& beta,
+                   const YVector& y)
+{
+  if (A.numRows () <= 0) {
+    return;
+  }
+  const int n = static_cast<int> (x.extent(1));
+#ifdef KOKKOS_ENABLE_CUDA
+  if (std::is_same<typename AMatrix::execution_space, Kokkos::Cuda>::value) {
+    int vector_length = 1;
+    while (vector_length < 32 && 2 * vector_length < n) vector_length *= 2;
+    spmm_tiled_launch<AMatrix, XVector, YVector, doalpha, dobeta, conjugate, 2> (space, alpha, A, x, beta, y, vector_length);
+    return;
+  }
+#endif
+  if (n <= 8) {
+    spmm_tiled_launch<AMatrix, XVector, YVector, doalpha, dobeta, conjugate, 8> (space, alpha, A, x, beta, y, 1);
+  } else {
+    spmm_tiled_launch<AMatrix, XVector, YVector, doalpha, dobeta, conjugate, 16> (space, alpha, A, x, beta, y, 1);
+  }
+}
+
+}
+}
+
+#endif
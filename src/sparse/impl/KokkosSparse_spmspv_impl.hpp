@@ -0,0 +1,428 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSSPARSE_SPMSPV_IMPL_HPP
+#define _KOKKOSSPARSE_SPMSPV_IMPL_HPP
+
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosSparse_transpose.hpp"
+
+namespace KokkosSparse{
+namespace Experimental{
+namespace Impl{
+
+//Number of entries of the column of the transpose of each nonzero of x.
+template<class RowMapType, class XIndexType, class OffsetsType>
+struct SpMSpV_Column_Lengths_Functor {
+  typedef typename OffsetsType::non_const_value_type size_type;
+
+  RowMapType t_row_map;
+  XIndexType x_indices;
+  OffsetsType offsets;
+
+  SpMSpV_Column_Lengths_Functor (const RowMapType t_row_map_, const XIndexType x_indices_, const OffsetsType offsets_) :
+    t_row_map (t_row_map_), x_indices (x_indices_), offsets (offsets_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& k) const
+  {
+    if (k < size_type (x_indices.extent (0))) {
+      const size_type j = x_indices(k);
+      offsets(k) = t_row_map(j + 1) - t_row_map(j);
+    }
+    else {
+      offsets(k) = 0;
+    }
+  }
+};
+
+//Products of the push kernel, one per iteration so that long columns are
+//split among the threads: the nonzero of x of each product is found with a
+//binary search in the offsets of the columns. CountTag counts the products
+//of each bucket of rows, FillTag moves them to their bucket.
+template<class RowMapType, class EntriesType, class ValuesType,
+         class XIndexType, class XValueType, class OffsetsType,
+         class RowsType, class ProductsType>
+struct SpMSpV_Push_Functor {
+  typedef typename OffsetsType::non_const_value_type size_type;
+  typedef typename EntriesType::non_const_value_type lno_t;
+  typedef typename ProductsType::non_const_value_type scalar_t;
+
+  struct CountTag{};
+  struct FillTag{};
+
+  RowMapType t_row_map;
+  EntriesType t_entries;
+  ValuesType t_values;
+  XIndexType x_indices;
+  XValueType x_values;
+  OffsetsType offsets;
+  size_type nx;
+  lno_t rows_per_bucket;
+  OffsetsType bucket_cursor;
+  RowsType rows;
+  ProductsType products;
+
+  SpMSpV_Push_Functor (const RowMapType t_row_map_, const EntriesType t_entries_, const ValuesType t_values_,
+                       const XIndexType x_indices_, const XValueType x_values_, const OffsetsType offsets_,
+                       const lno_t rows_per_bucket_, const OffsetsType bucket_cursor_,
+                       const RowsType rows_, const ProductsType products_) :
+    t_row_map (t_row_map_), t_entries (t_entries_), t_values (t_values_),
+    x_indices (x_indices_), x_values (x_values_), offsets (offsets_), nx (x_indices_.extent (0)),
+    rows_per_bucket (rows_per_bucket_), bucket_cursor (bucket_cursor_),
+    rows (rows_), products (products_) {}
+
+  //the position in the transpose of product p, and the nonzero of x.
+  KOKKOS_INLINE_FUNCTION
+  size_type find (const size_type p, size_type &k) const
+  {
+    size_type lo = 0, hi = nx;
+    while (hi - lo > 1) {
+      const size_type mid = (lo + hi) / 2;
+      if (offsets(mid) <= p) lo = mid;
+      else hi = mid;
+    }
+    k = lo;
+    return t_row_map(x_indices(lo)) + (p - offsets(lo));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const CountTag&, const size_type& p) const
+  {
+    size_type k;
+    const lno_t i = t_entries(find (p, k));
+    Kokkos::atomic_fetch_add (&bucket_cursor(i / rows_per_bucket), size_type (1));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const FillTag&, const size_type& p) const
+  {
+    size_type k;
+    const size_type pos = find (p, k);
+    const lno_t i = t_entries(pos);
+    const size_type slot = Kokkos::atomic_fetch_add (&bucket_cursor(i / rows_per_bucket), size_type (1));
+    rows(slot) = i;
+    products(slot) = scalar_t (t_values(pos)) * scalar_t (x_values(k));
+  }
+};
+
+//Merges the products of each bucket of rows with the dense accumulator.
+//MergeTag sums them and moves the distinct rows to the front of the bucket,
+//WriteTag writes them to y and zeroes the accumulator again.
+template<class OffsetsType, class RowsType, class ProductsType,
+         class AccumulatorType, class MarkerType, class YIndexType, class YValueType>
+struct SpMSpV_Push_Merge_Functor {
+  typedef typename OffsetsType::non_const_value_type size_type;
+  typedef typename RowsType::non_const_value_type lno_t;
+  typedef typename AccumulatorType::non_const_value_type scalar_t;
+
+  struct MergeTag{};
+  struct WriteTag{};
+
+  OffsetsType bucket_offsets;
+  OffsetsType y_offsets;
+  RowsType rows;
+  ProductsType products;
+  AccumulatorType accumulator;
+  MarkerType marker;
+  YIndexType y_indices;
+  YValueType y_values;
+
+  SpMSpV_Push_Merge_Functor (const OffsetsType bucket_offsets_, const OffsetsType y_offsets_,
+                             const RowsType rows_, const ProductsType products_,
+                             const AccumulatorType accumulator_, const MarkerType marker_,
+                             const YIndexType y_indices_, const YValueType y_values_) :
+    bucket_offsets (bucket_offsets_), y_offsets (y_offsets_), rows (rows_), products (products_),
+    accumulator (accumulator_), marker (marker_), y_indices (y_indices_), y_values (y_values_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const MergeTag&, const size_type& b) const
+  {
+    const size_type begin = bucket_offsets(b);
+    size_type count = 0;
+    for (size_type pos = begin; pos < bucket_offsets(b + 1); ++pos) {
+      const lno_t i = rows(pos);
+      if (marker(i) == 0) {
+        marker(i) = 1;
+        rows(begin + count++) = i;
+      }
+      accumulator(i) += products(pos);
+    }
+    y_offsets(b) = count;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const WriteTag&, const size_type& b) const
+  {
+    const size_type begin = bucket_offsets(b);
+    const size_type y_begin = y_offsets(b);
+    const size_type count = y_offsets(b + 1) - y_begin;
+    for (size_type t = 0; t < count; ++t) {
+      const lno_t i = rows(begin + t);
+      y_indices(y_begin + t) = i;
+      y_values(y_begin + t) = accumulator(i);
+      accumulator(i) = scalar_t ();
+      marker(i) = 0;
+    }
+  }
+};
+
+//Scatters x to its dense copy, or zeroes the copy again.
+template<class XIndexType, class XValueType, class DenseType, class MarkerType>
+struct SpMSpV_Scatter_Functor {
+  typedef typename DenseType::non_const_value_type scalar_t;
+
+  XIndexType x_indices;
+  XValueType x_values;
+  DenseType dense_x;
+  MarkerType marker;
+  bool reset;
+
+  SpMSpV_Scatter_Functor (const XIndexType x_indices_, const XValueType x_values_,
+                          const DenseType dense_x_, const MarkerType marker_, const bool reset_) :
+    x_indices (x_indices_), x_values (x_values_), dense_x (dense_x_), marker (marker_), reset (reset_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_t& k) const
+  {
+    const typename XIndexType::non_const_value_type j = x_indices(k);
+    dense_x(j) = reset ? scalar_t () : scalar_t (x_values(k));
+    marker(j) = reset ? 0 : 1;
+  }
+};
+
+//Pull kernel: each row of A against the dense copy of x. The rows with an
+//entry in a nonzero column of x are counted, and written to y by a scan.
+template<class AMatrix, class DenseType, class MarkerType, class YIndexType, class YValueType>
+struct SpMSpV_Pull_Functor {
+  typedef typename AMatrix::non_const_ordinal_type lno_t;
+  typedef typename AMatrix::non_const_size_type size_type;
+  typedef typename DenseType::non_const_value_type scalar_t;
+
+  struct RowsTag{};
+  struct WriteTag{};
+
+  AMatrix A;
+  DenseType dense_x;
+  MarkerType x_marker;
+  DenseType accumulator;
+  MarkerType row_marker;
+  YIndexType y_indices;
+  YValueType y_values;
+
+  SpMSpV_Pull_Functor (const AMatrix A_, const DenseType dense_x_, const MarkerType x_marker_,
+                       const DenseType accumulator_, const MarkerType row_marker_,
+                       const YIndexType y_indices_, const YValueType y_values_) :
+    A (A_), dense_x (dense_x_), x_marker (x_marker_), accumulator (accumulator_), row_marker (row_marker_),
+    y_indices (y_indices_), y_values (y_values_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const RowsTag&, const lno_t& i, lno_t &num_rows) const
+  {
+    scalar_t sum = scalar_t ();
+    bool hit = false;
+    for (size_type k = A.graph.row_map(i); k < A.graph.row_map(i + 1); ++k) {
+      const lno_t j = A.graph.entries(k);
+      if (x_marker(j)) {
+        sum += scalar_t (A.values(k)) * dense_x(j);
+        hit = true;
+      }
+    }
+    if (hit) {
+      accumulator(i) = sum;
+      row_marker(i) = 1;
+      ++num_rows;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const WriteTag&, const lno_t& i, lno_t &update, const bool final) const
+  {
+    if (row_marker(i)) {
+      if (final) {
+        y_indices(update) = i;
+        y_values(update) = accumulator(i);
+        accumulator(i) = scalar_t ();
+        row_marker(i) = 0;
+      }
+      ++update;
+    }
+  }
+};
+
+//Returns the transpose of A kept in the handle, computed if needed.
+template<class HandleType, class AMatrix>
+typename KokkosSparse::TransposeMatrixType<AMatrix>::type
+spmspv_transpose (HandleType& handle, const AMatrix& A)
+{
+  typedef typename KokkosSparse::TransposeMatrixType<AMatrix>::type matrix_type;
+  typename HandleType::transpose_handle_t &th = handle.get_transpose_handle ();
+  if (!th.is_plan_for (A.graph.row_map.data (), A.numRows (), A.numCols (), A.nnz ())) {
+    matrix_type AT = KokkosSparse::transpose (th, A);
+    handle.set_transpose_values (AT.values);
+    return AT;
+  }
+  matrix_type AT ("transpose", A.numCols (), A.numRows (), A.nnz (), handle.get_transpose_values (),
+                  th.get_transpose_row_map (), th.get_transpose_entries ());
+  if (!handle.get_are_transpose_values_current () ||
+      !th.are_values_current (A.values.data (), A.valuesVersion (), AT.values.data ())) {
+    KokkosSparse::transpose_values (th, A, AT);
+    handle.set_transpose_values (AT.values);
+  }
+  return AT;
+}
+
+template<class YIndexType, class YValueType>
+void
+spmspv_allocate_y (const size_t nnz_y, YIndexType& y_indices, YValueType& y_values)
+{
+  if (y_indices.extent (0) < nnz_y) {
+    y_indices = YIndexType (Kokkos::ViewAllocateWithoutInitializing ("y_indices"), nnz_y);
+  }
+  if (y_values.extent (0) < nnz_y) {
+    y_values = YValueType (Kokkos::ViewAllocateWithoutInitializing ("y_values"), nnz_y);
+  }
+}
+
+template<class HandleType, class ATMatrix, class XIndexType, class XValueType, class OffsetsType,
+         class YIndexType, class YValueType>
+typename ATMatrix::non_const_ordinal_type
+spmspv_push (HandleType& handle, const ATMatrix& AT,
+             const XIndexType& x_indices, const XValueType& x_values,
+             const OffsetsType& offsets, const typename OffsetsType::non_const_value_type num_products,
+             YIndexType& y_indices, YValueType& y_values)
+{
+  typedef typename HandleType::execution_space execution_space;
+  typedef typename ATMatrix::non_const_ordinal_type lno_t;
+  typedef typename OffsetsType::non_const_value_type size_type;
+  typedef typename HandleType::nnz_lno_view_t rows_t;
+  typedef typename HandleType::scalar_view_t products_t;
+  typedef SpMSpV_Push_Functor<typename ATMatrix::row_map_type, typename ATMatrix::index_type,
+                              typename ATMatrix::values_type, XIndexType, XValueType, OffsetsType,
+                              rows_t, products_t> push_t;
+  typedef SpMSpV_Push_Merge_Functor<OffsetsType, rows_t, products_t, products_t, rows_t,
+                                    YIndexType, YValueType> merge_t;
+
+  const lno_t nrows = AT.numCols ();
+  if (num_products == 0) {
+    return 0;
+  }
+
+  //buckets of consecutive rows, a few per thread, so that they are merged
+  //in parallel without atomics.
+  const size_type concurrency = execution_space::concurrency ();
+  const size_type num_buckets = KOKKOSKERNELS_MACRO_MAX (size_type (1),
+      KOKKOSKERNELS_MACRO_MIN (size_type (nrows), 4 * concurrency));
+  const lno_t rows_per_bucket = (nrows + num_buckets - 1) / num_buckets;
+
+  handle.allocate_push_buffers (num_products);
+  OffsetsType bucket_offsets ("spmspv bucket_offsets", num_buckets + 1);
+  const push_t push (AT.graph.row_map, AT.graph.entries, AT.values, x_indices, x_values, offsets,
+                     rows_per_bucket, bucket_offsets, handle.get_push_rows (), handle.get_push_values ());
+  Kokkos::parallel_for ("KokkosSparse::spmspv::push::count",
+      Kokkos::RangePolicy<typename push_t::CountTag, execution_space> (0, num_products), push);
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<OffsetsType, execution_space> (num_buckets + 1, bucket_offsets);
+
+  OffsetsType bucket_cursor (Kokkos::ViewAllocateWithoutInitializing ("spmspv bucket_cursor"), num_buckets + 1);
+  Kokkos::deep_copy (bucket_cursor, bucket_offsets);
+  push_t fill (push);
+  fill.bucket_cursor = bucket_cursor;
+  Kokkos::parallel_for ("KokkosSparse::spmspv::push::fill",
+      Kokkos::RangePolicy<typename push_t::FillTag, execution_space> (0, num_products), fill);
+
+  OffsetsType y_offsets ("spmspv y_offsets", num_buckets + 1);
+  merge_t merge (bucket_offsets, y_offsets, handle.get_push_rows (), handle.get_push_values (),
+                 handle.get_row_accumulator (), handle.get_row_marker (), y_indices, y_values);
+  Kokkos::parallel_for ("KokkosSparse::spmspv::push::merge",
+      Kokkos::RangePolicy<typename merge_t::MergeTag, execution_space> (0, num_buckets), merge);
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<OffsetsType, execution_space> (num_buckets + 1, y_offsets);
+  size_type nnz_y = 0;
+  Kokkos::deep_copy (nnz_y, Kokkos::subview (y_offsets, num_buckets));
+
+  spmspv_allocate_y (nnz_y, y_indices, y_values);
+  merge.y_indices = y_indices;
+  merge.y_values = y_values;
+  Kokkos::parallel_for ("KokkosSparse::spmspv::push::write",
+      Kokkos::RangePolicy<typename merge_t::WriteTag, execution_space> (0, num_buckets), merge);
+  return lno_t (nnz_y);
+}
+
+template<class HandleType, class AMatrix, class XIndexType, class XValueType,
+         class YIndexType, class YValueType>
+typename AMatrix::non_const_ordinal_type
+spmspv_pull (HandleType& handle, const AMatrix& A,
+             const XIndexType& x_indices, const XValueType& x_values,
+             YIndexType& y_indices, YValueType& y_values)
+{
+  typedef typename HandleType::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type lno_t;
+  typedef typename HandleType::nnz_lno_view_t marker_t;
+  typedef typename HandleType::scalar_view_t dense_t;
+  typedef SpMSpV_Scatter_Functor<XIndexType, XValueType, dense_t, marker_t> scatter_t;
+  typedef SpMSpV_Pull_Functor<AMatrix, dense_t, marker_t, YIndexType, YValueType> pull_t;
+
+  const size_t nx = x_indices.extent (0);
+  Kokkos::parallel_for ("KokkosSparse::spmspv::pull::scatter", Kokkos::RangePolicy<execution_space> (0, nx),
+      scatter_t (x_indices, x_values, handle.get_dense_x (), handle.get_x_marker (), false));
+
+  pull_t pull (A, handle.get_dense_x (), handle.get_x_marker (),
+               handle.get_row_accumulator (), handle.get_row_marker (), y_indices, y_values);
+  lno_t nnz_y = 0;
+  Kokkos::parallel_reduce ("KokkosSparse::spmspv::pull::rows",
+      Kokkos::RangePolicy<typename pull_t::RowsTag, execution_space> (0, A.numRows ()), pull, nnz_y);
+
+  spmspv_allocate_y (nnz_y, y_indices, y_values);
+  pull.y_indices = y_indices;
+  pull.y_values = y_values;
+  Kokkos::parallel_scan ("KokkosSparse::spmspv::pull::write",
+      Kokkos::RangePolicy<typename pull_t::WriteTag, execution_space> (0, A.numRows ()), pull);
+
+  Kokkos::parallel_for ("KokkosSparse::spmspv::pull::reset", Kokkos::RangePolicy<execution_space> (0, nx),
+      scatter_t (x_indices, x_values, handle.get_dense_x (), handle.get_x_marker (), true));
+  return nnz_y;
+}
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,278 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_IMPL_SPMV_BLOCKCRS_HPP_
+#define KOKKOSSPARSE_IMPL_SPMV_BLOCKCRS_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosBatched_Util.hpp"
+#include "KokkosBatched_Gemv_Serial_Internal.hpp"
+#include "KokkosSparse_BlockCrsMatrix.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+namespace Impl {
+
+// y_block += block * x_block for a BlockSize x BlockSize block with row stride
+// as0 and unit column stride. The bounds are compile time constants, so the
+// loops unroll.
+template<int BlockSize, class AValue, class XValue, class YValue>
+KOKKOS_INLINE_FUNCTION
+void spmv_block_gemv (const AValue* A, const int as0,
+                      const XValue* x, const int xs0,
+                      YValue* y)
+{
+  for (int i = 0; i < BlockSize; ++i) {
+    YValue t = 0;
+#if defined(KOKKOS_ENABLE_PRAGMA_UNROLL)
+#pragma unroll
+#endif
+    for (int j = 0; j < BlockSize; ++j) {
+      t += A[i*as0 + j] * x[j*xs0];
+    }
+    y[i] += t;
+  }
+}
+
+// Same value type for the matrix and the vectors: the batched serial gemv.
+template<int BlockSize, class Value>
+KOKKOS_INLINE_FUNCTION
+void spmv_block_gemv (const Value* A, const int as0,
+                      const Value* x, const int xs0,
+                      Value* y)
+{
+  KokkosBatched::Experimental::SerialGemvInternal<KokkosBatched::Experimental::Algo::Gemv::Unblocked>
+    ::invoke (BlockSize, BlockSize, Value(1), A, as0, 1, x, xs0, Value(1), y, 1);
+}
+
+// Entry i of column k of a vector or multivector.
+template<class ViewType>
+KOKKOS_INLINE_FUNCTION
+typename std::enable_if<ViewType::rank == 1, typename ViewType::reference_type>::type
+spmv_blockcrs_entry (const ViewType& v, const int64_t i, const int64_t k)
+{
+  return v(i);
+}
+
+template<class ViewType>
+KOKKOS_INLINE_FUNCTION
+typename std::enable_if<ViewType::rank == 2, typename ViewType::reference_type>::type
+spmv_blockcrs_entry (const ViewType& v, const int64_t i, const int64_t k)
+{
+  return v(i, k);
+}
+
+// One block row per thread. The BlockSize results of the block row are kept
+// in registers; BlockSize == 0 is the runtime block size version, which
+// accumulates each point row separately.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         int BlockSize>
+struct SPMV_BlockCrs_Functor {
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::non_const_size_type        size_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       y_value_type;
+
+  const y_value_type alpha;
+  AMatrix  m_A;
+  XVector m_x;
+  const y_value_type beta;
+  YVector m_y;
+
+  SPMV_BlockCrs_Functor (const y_value_type alpha_,
+                         const AMatrix m_A_,
+                         const XVector m_x_,
+                         const y_value_type beta_,
+                         const YVector m_y_) :
+     alpha (alpha_), m_A (m_A_), m_x (m_x_),
+     beta (beta_), m_y (m_y_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void update (const ordinal_type point_row, const ordinal_type k, const y_value_type sum) const
+  {
+    if (dobeta == 0) {
+      spmv_blockcrs_entry (m_y, point_row, k) = alpha * sum;
+    } else {
+      spmv_blockcrs_entry (m_y, point_row, k) = beta * spmv_blockcrs_entry (m_y, point_row, k) + alpha * sum;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& block_row) const
+  {
+    const size_type begin = m_A.graph.row_map(block_row);
+    const ordinal_type length = static_cast<ordinal_type> (m_A.graph.row_map(block_row + 1) - begin);
+    const value_type* row_values = m_A.values.data () + begin * BlockSize * BlockSize;
+    const int as0 = length * BlockSize;
+    const int xs0 = m_x.stride(0);
+    const ordinal_type numVecs = m_x.extent(1);
+
+    for (ordinal_type k = 0; k < numVecs; ++k) {
+      y_value_type sum[BlockSize];
+      for (int i = 0; i < BlockSize; ++i) sum[i] = 0;
+      for (ordinal_type K = 0; K < length; ++K) {
+        const ordinal_type col = m_A.graph.entries(begin + K);
+        spmv_block_gemv<BlockSize> (row_values + K * BlockSize, as0, &spmv_blockcrs_entry (m_x, col * BlockSize, k), xs0, sum);
+      }
+      for (int i = 0; i < BlockSize; ++i) {
+        update (block_row * BlockSize + i, k, sum[i]);
+      }
+    }
+  }
+};
+
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta>
+struct SPMV_BlockCrs_Functor<AMatrix, XVector, YVector, dobeta, 0> {
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::non_const_size_type        size_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       y_value_type;
+
+  const y_value_type alpha;
+  AMatrix  m_A;
+  XVector m_x;
+  const y_value_type beta;
+  YVector m_y;
+
+  SPMV_BlockCrs_Functor (const y_value_type alpha_,
+                         const AMatrix m_A_,
+                         const XVector m_x_,
+                         const y_value_type beta_,
+                         const YVector m_y_) :
+     alpha (alpha_), m_A (m_A_), m_x (m_x_),
+     beta (beta_), m_y (m_y_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& block_row) const
+  {
+    const ordinal_type block_size = m_A.blockDim ();
+    const size_type begin = m_A.graph.row_map(block_row);
+    const ordinal_type length = static_cast<ordinal_type> (m_A.graph.row_map(block_row + 1) - begin);
+    const value_type* row_values = m_A.values.data () + begin * block_size * block_size;
+    const ordinal_type numVecs = m_x.extent(1);
+
+    for (ordinal_type k = 0; k < numVecs; ++k) {
+      for (ordinal_type i = 0; i < block_size; ++i) {
+        //the point row i of the block row is contiguous over all the blocks.
+        const value_type* point_row_values = row_values + i * length * block_size;
+        y_value_type sum = 0;
+        for (ordinal_type K = 0; K < length; ++K) {
+          const ordinal_type col = m_A.graph.entries(begin + K) * block_size;
+          for (ordinal_type j = 0; j < block_size; ++j) {
+            sum += point_row_values[K * block_size + j] * spmv_blockcrs_entry (m_x, col + j, k);
+          }
+        }
+        const ordinal_type point_row = block_row * block_size + i;
+        if (dobeta == 0) {
+          spmv_blockcrs_entry (m_y, point_row, k) = alpha * sum;
+        } else {
+          spmv_blockcrs_entry (m_y, point_row, k) = beta * spmv_blockcrs_entry (m_y, point_row, k) + alpha * sum;
+        }
+      }
+    }
+  }
+};
+
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         int BlockSize>
+static void
+spmv_blockcrs_launch (typename YVector::const_value_type& alpha,
+                      const AMatrix& A,
+                      const XVector& x,
+                      typename YVector::const_value_type& beta,
+                      const YVector& y)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  SPMV_BlockCrs_Functor<AMatrix,XVector,YVector,dobeta,BlockSize> func (alpha,A,x,beta,y);
+  Kokkos::parallel_for ("KokkosSparse::spmv<BlockCrs>",
+      Kokkos::RangePolicy<execution_space> (0, A.numRows ()), func);
+}
+
+/// \brief y = beta*y + alpha*A*x for a BlockCrsMatrix, with the kernel of the
+///   block size of A: unrolled for 2 to 8, runtime otherwise.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta>
+static void
+spmv_blockcrs_beta (typename YVector::const_value_type& alpha,
+                    const AMatrix& A,
+                    const XVector& x,
+                    typename YVector::const_value_type& beta,
+                    const YVector& y)
+{
+  typedef typename AMatrix::ordinal_type ordinal_type;
+
+  if (A.numRows () <= static_cast<ordinal_type> (0) || A.nnz () == 0) {
+    if (A.numRows () > static_cast<ordinal_type> (0)) {
+      //no blocks: y = beta*y.
+      spmv_blockcrs_launch<AMatrix,XVector,YVector,dobeta,0> (alpha, A, x, beta, y);
+    }
+    return;
+  }
+  switch (A.blockDim ()) {
+  case 2: spmv_blockcrs_launch<AMatrix,XVector,YVector,dobeta,2> (alpha, A, x, beta, y); break;
+  case 3: spmv_blockcrs_launch<AMatrix,XVector,YVector,dobeta,3> (alpha, A, x, beta, y); break;
+  case 4: spmv_blockcrs_launch<AMatrix,XVector,YVector,dobeta,4> (alpha, A, x, beta, y); break;
+  case 5: spmv_blockcrs_launch<AMatrix,XVector,YVector,dobeta,5> (alpha, A, x, beta, y); break;
+  case 6: spmv_blockcrs_launch<AMatrix,XVector,YVector,dobeta,6> (alpha, A, x, beta, y); break;
+  case 7: spmv_blockcrs_launch<AMatrix,XVector,YVector,dobeta,7> (alpha, A, x, beta, y); break;
+  case 8: spmv_blockcrs_launch<AMatrix,XVector,YVector,dobeta,8> (alpha, A, x, beta, y); break;
+  default: spmv_blockcrs_launch<AMatrix,XVector,YVector,dobeta,0> (alpha, A, x, beta, y); break;
+  }
+}
+
+}
+}
+}
+
+#endif
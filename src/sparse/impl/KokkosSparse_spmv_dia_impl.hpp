@@ -0,0 +1,156 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSSPARSE_IMPL_SPMV_DIA_HPP_
+#define KOKKOSSPARSE_IMPL_SPMV_DIA_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosSparse_DiaMatrix.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+namespace Impl {
+
+// One block of consecutive rows per iteration. For each diagonal the rows of
+// the block whose column is in range are a contiguous loop, with unit stride
+// loads of values, x and y and no column indices, which the compiler
+// vectorizes on the host. The blocks are single rows on Cuda.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         bool conjugate>
+struct SPMV_Dia_Functor {
+  typedef typename AMatrix::ordinal_type               ordinal_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       y_value_type;
+  typedef Kokkos::Details::ArithTraits<value_type>     ATV;
+
+  const y_value_type alpha;
+  AMatrix m_A;
+  XVector m_x;
+  const y_value_type beta;
+  YVector m_y;
+  const ordinal_type rows_per_block;
+
+  SPMV_Dia_Functor (const y_value_type alpha_,
+                    const AMatrix m_A_,
+                    const XVector m_x_,
+                    const y_value_type beta_,
+                    const YVector m_y_,
+                    const ordinal_type rows_per_block_) :
+    alpha (alpha_), m_A (m_A_), m_x (m_x_),
+    beta (beta_), m_y (m_y_), rows_per_block (rows_per_block_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& block) const
+  {
+    const ordinal_type row_begin = block * rows_per_block;
+    const ordinal_type row_end = row_begin + rows_per_block < m_A.numRows () ?
+                                 row_begin + rows_per_block : m_A.numRows ();
+
+#ifdef KOKKOS_ENABLE_PRAGMA_IVDEP
+#pragma ivdep
+#endif
+    for (ordinal_type i = row_begin; i < row_end; ++i) {
+      if (dobeta == 0) {
+        m_y(i) = Kokkos::Details::ArithTraits<y_value_type>::zero ();
+      } else {
+        m_y(i) = beta * m_y(i);
+      }
+    }
+
+    const ordinal_type numDiagonals = m_A.numDiagonals ();
+    for (ordinal_type k = 0; k < numDiagonals; ++k) {
+      const ordinal_type d = m_A.offsets(k);
+      //the rows with 0 <= i + d < numCols.
+      const ordinal_type begin = row_begin > -d ? row_begin : -d;
+      const ordinal_type end = row_end < m_A.numCols () - d ? row_end : m_A.numCols () - d;
+#ifdef KOKKOS_ENABLE_PRAGMA_IVDEP
+#pragma ivdep
+#endif
+      for (ordinal_type i = begin; i < end; ++i) {
+        const value_type val = conjugate ? ATV::conj (m_A.values(i, k)) : m_A.values(i, k);
+        m_y(i) += alpha * (val * m_x(i + d));
+      }
+    }
+  }
+};
+
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         bool conjugate>
+static void
+spmv_dia_beta (typename YVector::const_value_type& alpha,
+               const AMatrix& A,
+               const XVector& x,
+               typename YVector::const_value_type& beta,
+               const YVector& y)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::ordinal_type ordinal_type;
+
+  if (A.numRows () <= static_cast<ordinal_type> (0)) {
+    return;
+  }
+
+  ordinal_type rows_per_block = 128;
+#ifdef KOKKOS_ENABLE_CUDA
+  if (std::is_same<execution_space, Kokkos::Cuda>::value) {
+    rows_per_block = 1;
+  }
+#endif
+  const ordinal_type num_blocks = (A.numRows () + rows_per_block - 1) / rows_per_block;
+  SPMV_Dia_Functor<AMatrix,XVector,YVector,dobeta,conjugate> func (alpha,A,x,beta,y,rows_per_block);
+  Kokkos::parallel_for ("KokkosSparse::spmv<Dia>",
+      Kokkos::RangePolicy<execution_space> (0, num_blocks), func);
+}
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,184 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_IMPL_SPMV_DOT_HPP_
+#define KOKKOSSPARSE_IMPL_SPMV_DOT_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include <Kokkos_InnerProductSpaceTraits.hpp>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmv_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+namespace Impl {
+
+// SPMV_Functor that also reduces dot(w, y) over the rows it writes, so that y
+// is not read again by a separate dot.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         class WVector,
+         int dobeta,
+         bool conjugate>
+struct SPMV_Dot_Functor {
+  typedef typename AMatrix::execution_space            execution_space;
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::non_const_value_type       scalar_type;
+  typedef typename YVector::non_const_value_type       y_value_type;
+  typedef Kokkos::Details::InnerProductSpaceTraits<typename WVector::non_const_value_type> IPT;
+  typedef typename IPT::dot_type                       dot_type;
+  //the reduction type.
+  typedef dot_type                                     value_type;
+  typedef typename Kokkos::TeamPolicy<execution_space> team_policy;
+  typedef typename team_policy::member_type            team_member;
+  typedef Kokkos::Details::ArithTraits<scalar_type>    ATV;
+
+  const y_value_type alpha;
+  AMatrix  m_A;
+  XVector m_x;
+  const y_value_type beta;
+  YVector m_y;
+  WVector m_w;
+
+  const ordinal_type rows_per_team;
+
+  SPMV_Dot_Functor (const y_value_type alpha_,
+                    const AMatrix m_A_,
+                    const XVector m_x_,
+                    const y_value_type beta_,
+                    const YVector m_y_,
+                    const WVector m_w_,
+                    const int rows_per_team_) :
+     alpha (alpha_), m_A (m_A_), m_x (m_x_),
+     beta (beta_), m_y (m_y_), m_w (m_w_),
+     rows_per_team (rows_per_team_)
+  {
+    static_assert (static_cast<int> (XVector::rank) == 1,
+                   "XVector must be a rank 1 View.");
+    static_assert (static_cast<int> (YVector::rank) == 1,
+                   "YVector must be a rank 1 View.");
+    static_assert (static_cast<int> (WVector::rank) == 1,
+                   "WVector must be a rank 1 View.");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const team_member& dev, dot_type& result) const
+  {
+    const ordinal_type team_row_begin = static_cast<ordinal_type> (dev.league_rank ()) * rows_per_team;
+    const ordinal_type team_row_end = team_row_begin + rows_per_team < m_A.numRows () ?
+        team_row_begin + rows_per_team : m_A.numRows ();
+
+    dot_type team_result = Kokkos::Details::ArithTraits<dot_type>::zero ();
+    Kokkos::parallel_reduce(Kokkos::TeamThreadRange(dev,team_row_begin,team_row_end), [&] (const ordinal_type& iRow, dot_type& lresult) {
+
+      const KokkosSparse::SparseRowViewConst<AMatrix> row = m_A.rowConst(iRow);
+      const ordinal_type row_length = static_cast<ordinal_type> (row.length);
+      y_value_type sum = 0;
+
+      Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(dev,row_length), [&] (const ordinal_type& iEntry, y_value_type& lsum) {
+        const scalar_type val = conjugate ?
+                ATV::conj (row.value(iEntry)) :
+                row.value(iEntry);
+        lsum += val * m_x(row.colidx(iEntry));
+      },sum);
+
+      //lane 0 updates y, and broadcasts the new value to the other lanes.
+      y_value_type y_new = 0;
+      Kokkos::single(Kokkos::PerThread(dev), [&] (y_value_type& y_row) {
+        y_row = dobeta == 0 ? alpha * sum : beta * m_y(iRow) + alpha * sum;
+        m_y(iRow) = y_row;
+      }, y_new);
+      lresult += IPT::dot (m_w(iRow), y_new);
+    }, team_result);
+    result += team_result;
+  }
+};
+
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         class WVector,
+         int dobeta,
+         bool conjugate>
+typename Kokkos::Details::InnerProductSpaceTraits<typename WVector::non_const_value_type>::dot_type
+spmv_dot_beta (typename YVector::const_value_type& alpha,
+               const AMatrix& A,
+               const XVector& x,
+               typename YVector::const_value_type& beta,
+               const YVector& y,
+               const WVector& w)
+{
+  typedef typename AMatrix::ordinal_type ordinal_type;
+  typedef typename AMatrix::execution_space execution_space;
+  typedef SPMV_Dot_Functor<AMatrix,XVector,YVector,WVector,dobeta,conjugate> functor_type;
+  typedef typename functor_type::dot_type dot_type;
+
+  dot_type result = Kokkos::Details::ArithTraits<dot_type>::zero ();
+  if (A.numRows () <= static_cast<ordinal_type> (0)) {
+    return result;
+  }
+
+  int team_size = -1;
+  int vector_length = -1;
+  int64_t rows_per_thread = -1;
+
+  int64_t rows_per_team = KokkosSparse::Impl::spmv_launch_parameters<execution_space>(A.numRows(),A.nnz(),rows_per_thread,team_size,vector_length);
+  int64_t worksets = (A.numRows()+rows_per_team-1)/rows_per_team;
+
+  functor_type func (alpha,A,x,beta,y,w,rows_per_team);
+
+  Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> > policy(1,1);
+  if(team_size<0)
+    policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> >(worksets,Kokkos::AUTO,vector_length);
+  else
+    policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> >(worksets,team_size,vector_length);
+  Kokkos::parallel_reduce("KokkosSparse::spmv_dot<NoTranspose>",policy,func,result);
+  return result;
+}
+
+}
+}
+}
+
+#endif
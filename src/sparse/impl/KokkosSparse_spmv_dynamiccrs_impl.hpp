@@ -0,0 +1,170 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_IMPL_SPMV_DYNAMICCRS_HPP_
+#define KOKKOSSPARSE_IMPL_SPMV_DYNAMICCRS_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosSparse_DynamicCrsMatrix.hpp"
+#include "KokkosSparse_spmv_impl.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+namespace Impl {
+
+// Same as SPMV_Functor, reading the filled slots of each row only.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         bool conjugate>
+struct SPMV_DynamicCrs_Functor {
+  typedef typename AMatrix::execution_space            execution_space;
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::size_type                  size_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       coefficient_type;
+  typedef typename Kokkos::TeamPolicy<execution_space> team_policy;
+  typedef typename team_policy::member_type            team_member;
+  typedef Kokkos::Details::ArithTraits<value_type>     ATV;
+
+  const coefficient_type alpha;
+  AMatrix  m_A;
+  XVector m_x;
+  const coefficient_type beta;
+  YVector m_y;
+
+  const ordinal_type rows_per_team;
+
+  SPMV_DynamicCrs_Functor (const coefficient_type alpha_,
+                           const AMatrix m_A_,
+                           const XVector m_x_,
+                           const coefficient_type beta_,
+                           const YVector m_y_,
+                           const int rows_per_team_) :
+     alpha (alpha_), m_A (m_A_), m_x (m_x_),
+     beta (beta_), m_y (m_y_),
+     rows_per_team (rows_per_team_)
+  {
+    static_assert (static_cast<int> (XVector::rank) == 1,
+                   "XVector must be a rank 1 View.");
+    static_assert (static_cast<int> (YVector::rank) == 1,
+                   "YVector must be a rank 1 View.");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const team_member& dev) const
+  {
+    typedef typename YVector::non_const_value_type y_value_type;
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(dev,0,rows_per_team), [&] (const ordinal_type& loop) {
+
+      const ordinal_type iRow = static_cast<ordinal_type> ( dev.league_rank() ) * rows_per_team + loop;
+      if (iRow >= m_A.numRows ()) {
+        return;
+      }
+      const size_type row_begin = m_A.row_map(iRow);
+      const ordinal_type row_length = static_cast<ordinal_type> (m_A.rowLength (iRow));
+      y_value_type sum = 0;
+
+      Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(dev,row_length), [&] (const ordinal_type& iEntry, y_value_type& lsum) {
+        const value_type val = conjugate ?
+                ATV::conj (m_A.values(row_begin + iEntry)) :
+                m_A.values(row_begin + iEntry);
+        lsum += val * m_x(m_A.entries(row_begin + iEntry));
+      },sum);
+
+      Kokkos::single(Kokkos::PerThread(dev), [&] () {
+        sum *= alpha;
+
+        if (dobeta == 0) {
+          m_y(iRow) = sum ;
+        } else {
+          m_y(iRow) = beta * m_y(iRow) + sum;
+        }
+      });
+    });
+  }
+};
+
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         bool conjugate>
+static void
+spmv_dynamiccrs_beta (typename YVector::const_value_type& alpha,
+                      const AMatrix& A,
+                      const XVector& x,
+                      typename YVector::const_value_type& beta,
+                      const YVector& y)
+{
+  typedef typename AMatrix::ordinal_type ordinal_type;
+  typedef typename AMatrix::execution_space execution_space;
+
+  if (A.numRows () <= static_cast<ordinal_type> (0)) {
+    return;
+  }
+
+  int team_size = -1;
+  int vector_length = -1;
+  int64_t rows_per_thread = -1;
+
+  int64_t rows_per_team = KokkosSparse::Impl::spmv_launch_parameters<execution_space>(A.numRows(),A.capacity(),rows_per_thread,team_size,vector_length);
+  int64_t worksets = (A.numRows()+rows_per_team-1)/rows_per_team;
+
+  SPMV_DynamicCrs_Functor<AMatrix,XVector,YVector,dobeta,conjugate> func (alpha,A,x,beta,y,rows_per_team);
+
+  Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic> > policy(1,1);
+  if(team_size<0)
+    policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic> >(worksets,Kokkos::AUTO,vector_length);
+  else
+    policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic> >(worksets,team_size,vector_length);
+  Kokkos::parallel_for("KokkosSparse::spmv<DynamicCrs>",policy,func);
+}
+
+}
+}
+}
+
+#endif
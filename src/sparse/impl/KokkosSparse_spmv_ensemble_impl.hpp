@@ -0,0 +1,148 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_IMPL_SPMV_ENSEMBLE_HPP_
+#define KOKKOSSPARSE_IMPL_SPMV_ENSEMBLE_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosBatched_Vector.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+// True when every lane of the ensemble value a equals s. Ensemble
+// comparisons return a lane mask, so the scalar fast paths on alpha and beta
+// are selected lane by lane.
+template<class T, int l>
+bool ensemble_all_equal (const KokkosBatched::Experimental::Vector<KokkosBatched::Experimental::SIMD<T>,l>& a,
+                         const T& s)
+{
+  for (int i = 0; i < l; ++i) {
+    if (! (a[i] == s)) return false;
+  }
+  return true;
+}
+
+// One row per thread for a matrix whose values are ensemble (SIMD) scalars.
+// The row's column indices are loaded once and reused by all the ensemble
+// members, which are updated together with SIMD arithmetic.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         bool conjugate>
+struct SPMV_Ensemble_Functor {
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::non_const_size_type        size_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       y_value_type;
+  typedef Kokkos::Details::ArithTraits<value_type>     ATV;
+
+  const y_value_type alpha;
+  AMatrix m_A;
+  XVector m_x;
+  const y_value_type beta;
+  YVector m_y;
+
+  SPMV_Ensemble_Functor (const y_value_type alpha_,
+                         const AMatrix m_A_,
+                         const XVector m_x_,
+                         const y_value_type beta_,
+                         const YVector m_y_) :
+    alpha (alpha_), m_A (m_A_), m_x (m_x_), beta (beta_), m_y (m_y_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    const size_type begin = m_A.graph.row_map(i);
+    const size_type end = m_A.graph.row_map(i + 1);
+    y_value_type sum = ATV::zero ();
+    for (size_type k = begin; k < end; ++k) {
+      const value_type val = conjugate ? ATV::conj (m_A.values(k)) : value_type (m_A.values(k));
+      sum += val * m_x(m_A.graph.entries(k));
+    }
+    if (dobeta == 0) {
+      m_y(i) = alpha * sum;
+    } else if (dobeta == 1) {
+      m_y(i) += alpha * sum;
+    } else {
+      m_y(i) = beta * m_y(i) + alpha * sum;
+    }
+  }
+};
+
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         bool conjugate>
+void
+spmv_ensemble_beta_no_transpose (const typename AMatrix::execution_space& space,
+                                 typename YVector::const_value_type& alpha,
+                                 const AMatrix& A,
+                                 const XVector& x,
+                                 typename YVector::const_value_type& beta,
+                                 const YVector& y)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type ordinal_type;
+  typedef typename YVector::non_const_value_type y_value_type;
+  typedef typename y_value_type::value_type lane_type;
+  typedef Kokkos::Details::ArithTraits<lane_type> ATL;
+
+  Kokkos::RangePolicy<execution_space, ordinal_type> policy (space, 0, A.numRows ());
+  if (ensemble_all_equal (beta, ATL::zero ())) {
+    Kokkos::parallel_for ("KokkosSparse::spmv<Ensemble>", policy,
+        SPMV_Ensemble_Functor<AMatrix, XVector, YVector, 0, conjugate> (alpha, A, x, beta, y));
+  } else if (ensemble_all_equal (beta, ATL::one ())) {
+    Kokkos::parallel_for ("KokkosSparse::spmv<Ensemble>", policy,
+        SPMV_Ensemble_Functor<AMatrix, XVector, YVector, 1, conjugate> (alpha, A, x, beta, y));
+  } else {
+    Kokkos::parallel_for ("KokkosSparse::spmv<Ensemble>", policy,
+        SPMV_Ensemble_Functor<AMatrix, XVector, YVector, 2, conjugate> (alpha, A, x, beta, y));
+  }
+}
+
+}
+}
+
+#endif
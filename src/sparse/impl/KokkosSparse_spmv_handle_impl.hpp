@@ -0,0 +1,711 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_IMPL_SPMV_HANDLE_HPP_
+#define KOKKOSSPARSE_IMPL_SPMV_HANDLE_HPP_
+
+#include <sstream>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmv_handle.hpp"
+#include "KokkosSparse_spmv_impl.hpp"
+#include "KokkosSparse_spmv_merge_impl.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+// First row of each workset: the smallest row whose begin offset is at least
+// workset * nnz_per_workset, so that the worksets have about the same number of
+// nonzeroes. A row longer than nnz_per_workset leaves the next worksets empty.
+template<class RowMapType, class OffsetsType>
+struct SPMV_Workset_Offsets_Functor {
+  typedef typename OffsetsType::non_const_value_type ordinal_type;
+  typedef typename RowMapType::non_const_value_type size_type;
+
+  RowMapType row_map;
+  OffsetsType workset_offsets;
+  const ordinal_type numRows;
+  const size_type nnz_per_workset;
+  const ordinal_type num_worksets;
+
+  SPMV_Workset_Offsets_Functor (const RowMapType row_map_,
+                                const OffsetsType workset_offsets_,
+                                const ordinal_type numRows_,
+                                const size_type nnz_per_workset_,
+                                const ordinal_type num_worksets_) :
+    row_map (row_map_), workset_offsets (workset_offsets_),
+    numRows (numRows_), nnz_per_workset (nnz_per_workset_),
+    num_worksets (num_worksets_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& workset) const
+  {
+    if (workset == num_worksets) {
+      workset_offsets(workset) = numRows;
+      return;
+    }
+    const size_type target = static_cast<size_type> (workset) * nnz_per_workset;
+    ordinal_type lo = 0, hi = numRows;
+    while (lo < hi) {
+      const ordinal_type mid = lo + (hi - lo) / 2;
+      if (row_map(mid) < target) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    workset_offsets(workset) = lo;
+  }
+};
+
+// Lengths of the rows in the order of the handle, prefix summed afterwards into
+// the row map of the reordered matrix for SPMV_Workset_Offsets_Functor.
+template<class RowMapType, class OrderType, class LengthsType>
+struct SPMV_Ordered_Row_Lengths_Functor {
+  typedef typename OrderType::non_const_value_type ordinal_type;
+
+  RowMapType row_map;
+  OrderType row_order;
+  LengthsType lengths;
+
+  SPMV_Ordered_Row_Lengths_Functor (const RowMapType row_map_,
+                                    const OrderType row_order_,
+                                    const LengthsType lengths_) :
+    row_map (row_map_), row_order (row_order_), lengths (lengths_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& k) const
+  {
+    const ordinal_type row = row_order(k);
+    lengths(k) = row_map(row + 1) - row_map(row);
+  }
+};
+
+// Same as SPMV_Functor, with the rows of a team given by the workset offsets
+// of the plan instead of a fixed number of rows per team. With a row order,
+// the worksets are ranges of the order instead of ranges of rows.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         class OffsetsType,
+         int dobeta,
+         bool conjugate>
+struct SPMV_Workset_Functor {
+  typedef typename AMatrix::execution_space            execution_space;
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       coefficient_type;
+  typedef typename Kokkos::TeamPolicy<execution_space> team_policy;
+  typedef typename team_policy::member_type            team_member;
+  typedef Kokkos::Details::ArithTraits<value_type>     ATV;
+
+  const coefficient_type alpha;
+  AMatrix  m_A;
+  XVector m_x;
+  OffsetsType m_workset_offsets;
+  OffsetsType m_row_order;
+  const bool has_row_order;
+  const coefficient_type beta;
+  YVector m_y;
+
+  SPMV_Workset_Functor (const coefficient_type alpha_,
+                        const AMatrix m_A_,
+                        const XVector m_x_,
+                        const OffsetsType m_workset_offsets_,
+                        const OffsetsType m_row_order_,
+                        const coefficient_type beta_,
+                        const YVector m_y_) :
+    alpha (alpha_), m_A (m_A_), m_x (m_x_),
+    m_workset_offsets (m_workset_offsets_), m_row_order (m_row_order_),
+    has_row_order (m_row_order_.extent (0) > 0),
+    beta (beta_), m_y (m_y_)
+  {
+    static_assert (static_cast<int> (XVector::rank) == 1,
+                   "XVector must be a rank 1 View.");
+    static_assert (static_cast<int> (YVector::rank) == 1,
+                   "YVector must be a rank 1 View.");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const team_member& dev) const
+  {
+    typedef typename YVector::non_const_value_type y_value_type;
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(dev,m_workset_offsets(dev.league_rank()),
+        m_workset_offsets(dev.league_rank()+1)), [&] (const ordinal_type& k) {
+
+      const ordinal_type iRow = has_row_order ? m_row_order(k) : k;
+      const KokkosSparse::SparseRowViewConst<AMatrix> row = m_A.rowConst(iRow);
+      const ordinal_type row_length = static_cast<ordinal_type> (row.length);
+      y_value_type sum = 0;
+
+      Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(dev,row_length), [&] (const ordinal_type& iEntry, y_value_type& lsum) {
+        const value_type val = conjugate ?
+                ATV::conj (row.value(iEntry)) :
+                row.value(iEntry);
+        lsum += val * m_x(row.colidx(iEntry));
+      },sum);
+
+      Kokkos::single(Kokkos::PerThread(dev), [&] () {
+        sum *= alpha;
+
+        if (dobeta == 0) {
+          m_y(iRow) = sum ;
+        } else {
+          m_y(iRow) = beta * m_y(iRow) + sum;
+        }
+      });
+    });
+  }
+};
+
+// Range of the columns of the rows of each workset, and the widest range.
+// An empty workset has an empty window.
+template<class RowMapType, class EntriesType, class OffsetsType>
+struct SPMV_Workset_Window_Functor {
+  typedef typename OffsetsType::non_const_value_type ordinal_type;
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef ordinal_type value_type;
+
+  RowMapType row_map;
+  EntriesType entries;
+  OffsetsType workset_offsets;
+  OffsetsType row_order;
+  const bool has_row_order;
+  OffsetsType col_begin;
+  OffsetsType col_length;
+
+  SPMV_Workset_Window_Functor (const RowMapType row_map_,
+                               const EntriesType entries_,
+                               const OffsetsType workset_offsets_,
+                               const OffsetsType row_order_,
+                               const OffsetsType col_begin_,
+                               const OffsetsType col_length_) :
+    row_map (row_map_), entries (entries_), workset_offsets (workset_offsets_),
+    row_order (row_order_), has_row_order (row_order_.extent (0) > 0),
+    col_begin (col_begin_), col_length (col_length_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& workset, value_type& max_window) const
+  {
+    ordinal_type lo = 0, hi = -1;
+    for (ordinal_type k = workset_offsets(workset); k < workset_offsets(workset + 1); ++k) {
+      const ordinal_type row = has_row_order ? row_order(k) : k;
+      for (size_type j = row_map(row); j < row_map(row + 1); ++j) {
+        const ordinal_type col = entries(j);
+        if (hi < lo) {
+          lo = col;
+          hi = col;
+        }
+        if (col < lo) lo = col;
+        if (col > hi) hi = col;
+      }
+    }
+    const ordinal_type window = hi < lo ? 0 : hi - lo + 1;
+    col_begin(workset) = window == 0 ? 0 : lo;
+    col_length(workset) = window;
+    if (window > max_window) max_window = window;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join (volatile value_type& dst, const volatile value_type& src) const {
+    if (src > dst) dst = src;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init (value_type& dst) const {
+    dst = 0;
+  }
+};
+
+// Same as SPMV_Workset_Functor, except that the teams whose window of columns
+// has at most window_capacity entries first copy it from x into team scratch,
+// and read x there. The other teams read x in place.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         class OffsetsType,
+         int dobeta,
+         bool conjugate>
+struct SPMV_Banded_Workset_Functor {
+  typedef typename AMatrix::execution_space            execution_space;
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename XVector::non_const_value_type       x_value_type;
+  typedef typename YVector::non_const_value_type       coefficient_type;
+  typedef typename Kokkos::TeamPolicy<execution_space> team_policy;
+  typedef typename team_policy::member_type            team_member;
+  typedef Kokkos::Details::ArithTraits<value_type>     ATV;
+  typedef Kokkos::View<x_value_type*, typename execution_space::scratch_memory_space,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged> > scratch_x_type;
+
+  const coefficient_type alpha;
+  AMatrix  m_A;
+  XVector m_x;
+  OffsetsType m_workset_offsets;
+  OffsetsType m_row_order;
+  const bool has_row_order;
+  OffsetsType m_col_begin;
+  OffsetsType m_col_length;
+  const ordinal_type window_capacity;
+  const coefficient_type beta;
+  YVector m_y;
+
+  SPMV_Banded_Workset_Functor (const coefficient_type alpha_,
+                               const AMatrix m_A_,
+                               const XVector m_x_,
+                               const OffsetsType m_workset_offsets_,
+                               const OffsetsType m_row_order_,
+                               const OffsetsType m_col_begin_,
+                               const OffsetsType m_col_length_,
+                               const ordinal_type window_capacity_,
+                               const coefficient_type beta_,
+                               const YVector m_y_) :
+    alpha (alpha_), m_A (m_A_), m_x (m_x_),
+    m_workset_offsets (m_workset_offsets_), m_row_order (m_row_order_),
+    has_row_order (m_row_order_.extent (0) > 0),
+    m_col_begin (m_col_begin_), m_col_length (m_col_length_),
+    window_capacity (window_capacity_),
+    beta (beta_), m_y (m_y_)
+  {
+    static_assert (static_cast<int> (XVector::rank) == 1,
+                   "XVector must be a rank 1 View.");
+    static_assert (static_cast<int> (YVector::rank) == 1,
+                   "YVector must be a rank 1 View.");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const team_member& dev) const
+  {
+    typedef typename YVector::non_const_value_type y_value_type;
+
+    const ordinal_type workset = static_cast<ordinal_type> (dev.league_rank ());
+    const ordinal_type col_begin = m_col_begin(workset);
+    const ordinal_type col_length = m_col_length(workset);
+    const bool staged = col_length <= window_capacity;
+    scratch_x_type s_x (dev.team_scratch (0), window_capacity);
+    if (staged) {
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(dev,col_length), [&] (const ordinal_type& j) {
+        Kokkos::single(Kokkos::PerThread(dev), [&] () {
+          s_x(j) = m_x(col_begin + j);
+        });
+      });
+      dev.team_barrier ();
+    }
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(dev,m_workset_offsets(workset),
+        m_workset_offsets(workset+1)), [&] (const ordinal_type& k) {
+
+      const ordinal_type iRow = has_row_order ? m_row_order(k) : k;
+      const KokkosSparse::SparseRowViewConst<AMatrix> row = m_A.rowConst(iRow);
+      const ordinal_type row_length = static_cast<ordinal_type> (row.length);
+      y_value_type sum = 0;
+
+      Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(dev,row_length), [&] (const ordinal_type& iEntry, y_value_type& lsum) {
+        const value_type val = conjugate ?
+                ATV::conj (row.value(iEntry)) :
+                row.value(iEntry);
+        const ordinal_type col = row.colidx(iEntry);
+        lsum += val * (staged ? s_x(col - col_begin) : m_x(col));
+      },sum);
+
+      Kokkos::single(Kokkos::PerThread(dev), [&] () {
+        sum *= alpha;
+
+        if (dobeta == 0) {
+          m_y(iRow) = sum ;
+        } else {
+          m_y(iRow) = beta * m_y(iRow) + sum;
+        }
+      });
+    });
+  }
+};
+
+/// \brief Computes the plan of handle for A: nnz balanced worksets with the
+///   team and vector sizes of spmv_launch_parameters, or the merge path kernel
+///   if the longest row is much longer than a workset. The worksets follow the
+///   row order of the handle if it has one.
+template<class HandleType, class AMatrix>
+void
+spmv_inspect (HandleType& handle, const AMatrix& A)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_size_type size_type;
+  typedef typename HandleType::nnz_lno_t ordinal_type;
+  typedef typename HandleType::nnz_lno_view_t offsets_view_t;
+
+  const ordinal_type numRows = A.numRows ();
+  const size_type nnz = A.nnz ();
+  if (numRows <= 0) {
+    handle.set_plan (A.graph.row_map.data (), numRows, nnz, SPMV_KERNEL_BALANCED_ROWS,
+                     offsets_view_t (), -1, -1, 0);
+    return;
+  }
+
+  int team_size = -1;
+  int vector_length = -1;
+  int64_t rows_per_thread = -1;
+  int64_t rows_per_team = spmv_launch_parameters<execution_space> (numRows, nnz, rows_per_thread, team_size, vector_length);
+  int64_t nnz_per_row = nnz / numRows;
+  if (nnz_per_row < 1) nnz_per_row = 1;
+  int64_t nnz_per_workset = rows_per_team * nnz_per_row;
+  if (nnz_per_workset < 1) nnz_per_workset = 1;
+
+  size_type max_row_length = 0;
+  if (handle.has_analysis_for (A.graph.row_map.data (), numRows, nnz)) {
+    max_row_length = static_cast<size_type> (handle.get_analysis ().max_row_length);
+  }
+  else {
+    KokkosKernels::Impl::kk_view_reduce_max_row_size<size_type, execution_space>
+      (numRows, A.graph.row_map.data (), A.graph.row_map.data () + 1, max_row_length);
+  }
+
+  //a row of several worksets keeps a single team busy while the others finish.
+  const bool use_merge_path = handle.get_controls ().get_algorithm () == SPMV_MERGE_PATH ||
+      static_cast<int64_t> (max_row_length) > 4 * nnz_per_workset;
+  if (use_merge_path) {
+    const int64_t items = spmv_merge_path_items_per_thread<execution_space>
+      (static_cast<int64_t> (numRows) + nnz, handle.get_controls ().get_merge_path_items_per_thread ());
+    handle.set_plan (A.graph.row_map.data (), numRows, nnz, SPMV_KERNEL_MERGE_PATH,
+                     offsets_view_t (), team_size, vector_length, items);
+    return;
+  }
+
+  const int64_t num_worksets = (static_cast<int64_t> (nnz) + nnz_per_workset - 1) / nnz_per_workset;
+  const ordinal_type worksets = num_worksets < 1 ? 1 : static_cast<ordinal_type> (num_worksets);
+  offsets_view_t workset_offsets (Kokkos::ViewAllocateWithoutInitializing ("spmv workset offsets"), worksets + 1);
+  const offsets_view_t row_order = handle.get_row_order ();
+  if (row_order.extent (0) > 0) {
+    if (static_cast<ordinal_type> (row_order.extent (0)) != numRows) {
+      std::ostringstream os;
+      os << "KokkosSparse::spmv: Dimensions do not match: "
+         << "row_order: " << row_order.extent (0)
+         << ", A: " << numRows << " x " << A.numCols ();
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+    typedef Kokkos::View<size_type*, typename AMatrix::device_type> ordered_row_map_t;
+    ordered_row_map_t ordered_row_map ("spmv ordered row_map", numRows + 1);
+    Kokkos::parallel_for ("KokkosSparse::spmv_inspect::OrderedRowLengths",
+        Kokkos::RangePolicy<execution_space> (0, numRows),
+        SPMV_Ordered_Row_Lengths_Functor<typename AMatrix::row_map_type, offsets_view_t, ordered_row_map_t>
+          (A.graph.row_map, row_order, ordered_row_map));
+    KokkosKernels::Impl::exclusive_parallel_prefix_sum<ordered_row_map_t, execution_space>
+      (numRows + 1, ordered_row_map);
+    Kokkos::parallel_for ("KokkosSparse::spmv_inspect",
+        Kokkos::RangePolicy<execution_space> (0, worksets + 1),
+        SPMV_Workset_Offsets_Functor<ordered_row_map_t, offsets_view_t>
+          (ordered_row_map, workset_offsets, numRows, nnz_per_workset, worksets));
+  } else {
+    Kokkos::parallel_for ("KokkosSparse::spmv_inspect",
+        Kokkos::RangePolicy<execution_space> (0, worksets + 1),
+        SPMV_Workset_Offsets_Functor<typename AMatrix::row_map_type, offsets_view_t>
+          (A.graph.row_map, workset_offsets, numRows, nnz_per_workset, worksets));
+  }
+  if (handle.get_controls ().get_algorithm () != SPMV_BANDED) {
+    handle.set_plan (A.graph.row_map.data (), numRows, nnz, SPMV_KERNEL_BALANCED_ROWS,
+                     workset_offsets, team_size, vector_length, 0);
+    return;
+  }
+  offsets_view_t col_begin (Kokkos::ViewAllocateWithoutInitializing ("spmv workset col begin"), worksets);
+  offsets_view_t col_length (Kokkos::ViewAllocateWithoutInitializing ("spmv workset col length"), worksets);
+  ordinal_type max_window = 0;
+  Kokkos::parallel_reduce ("KokkosSparse::spmv_inspect::WorksetWindows",
+      Kokkos::RangePolicy<execution_space> (0, worksets),
+      SPMV_Workset_Window_Functor<typename AMatrix::row_map_type, typename AMatrix::index_type, offsets_view_t>
+        (A.graph.row_map, A.graph.entries, workset_offsets, row_order, col_begin, col_length),
+      max_window);
+  handle.set_plan (A.graph.row_map.data (), numRows, nnz, SPMV_KERNEL_BANDED,
+                   workset_offsets, team_size, vector_length, 0);
+  handle.set_workset_windows (col_begin, col_length, max_window);
+}
+
+template<class HandleType, class AMatrix>
+void
+spmv_inspect_if_needed (HandleType& handle, const AMatrix& A)
+{
+  if (!handle.is_plan_for (A.graph.row_map.data (), A.numRows (), A.nnz ())) {
+    spmv_inspect (handle, A);
+  }
+}
+
+template<class HandleType,
+         class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         bool conjugate>
+static void
+spmv_handle_balanced_rows (const HandleType& handle,
+                           typename YVector::const_value_type& alpha,
+                           const AMatrix& A,
+                           const XVector& x,
+                           typename YVector::const_value_type& beta,
+                           const YVector& y)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename HandleType::nnz_lno_view_t offsets_view_t;
+
+  const offsets_view_t workset_offsets = handle.get_workset_offsets ();
+  const int worksets = static_cast<int> (workset_offsets.extent (0)) - 1;
+  const int team_size = handle.get_team_size ();
+  const int vector_length = handle.get_vector_length ();
+
+  SPMV_Workset_Functor<AMatrix,XVector,YVector,offsets_view_t,dobeta,conjugate> func (alpha,A,x,workset_offsets,handle.get_row_order (),beta,y);
+
+  //the worksets are balanced, so the static schedule is enough.
+  Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> > policy(1,1);
+  if(team_size<0)
+    policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> >(worksets,Kokkos::AUTO,vector_length);
+  else
+    policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> >(worksets,team_size,vector_length);
+  Kokkos::parallel_for("KokkosSparse::spmv<NoTranspose,Handle>",policy,func);
+}
+
+template<class HandleType,
+         class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         bool conjugate>
+static void
+spmv_handle_banded (const HandleType& handle,
+                    typename YVector::const_value_type& alpha,
+                    const AMatrix& A,
+                    const XVector& x,
+                    typename YVector::const_value_type& beta,
+                    const YVector& y)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type ordinal_type;
+  typedef typename HandleType::nnz_lno_view_t offsets_view_t;
+  typedef SPMV_Banded_Workset_Functor<AMatrix,XVector,YVector,offsets_view_t,dobeta,conjugate> functor_type;
+
+  const offsets_view_t workset_offsets = handle.get_workset_offsets ();
+  const int worksets = static_cast<int> (workset_offsets.extent (0)) - 1;
+  const int team_size = handle.get_team_size ();
+  const int vector_length = handle.get_vector_length ();
+
+  //the window of a team stays in level 0 scratch, the shared memory of a
+  //Cuda block; the wider windows are read from x in place.
+  const size_t max_scratch_bytes = 16384;
+  ordinal_type window_capacity = static_cast<ordinal_type> (handle.get_max_workset_window ());
+  const ordinal_type max_capacity = static_cast<ordinal_type> (
+      max_scratch_bytes / sizeof (typename XVector::non_const_value_type));
+  if (window_capacity > max_capacity) window_capacity = max_capacity;
+  const size_t scratch_bytes = functor_type::scratch_x_type::shmem_size (window_capacity);
+
+  functor_type func (alpha,A,x,workset_offsets,handle.get_row_order (),
+                     handle.get_workset_col_begin (),handle.get_workset_col_length (),window_capacity,beta,y);
+
+  Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> > policy(1,1);
+  if(team_size<0)
+    policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> >(worksets,Kokkos::AUTO,vector_length);
+  else
+    policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> >(worksets,team_size,vector_length);
+  Kokkos::parallel_for("KokkosSparse::spmv<NoTranspose,Banded>",
+                       policy.set_scratch_size (0, Kokkos::PerTeam (scratch_bytes)),func);
+}
+
+/// \brief y = beta*y + alpha*A*x (or conj(A)*x) with the plan of handle,
+///   inspecting A first if the plan is not for A.
+template<class HandleType,
+         class AMatrix,
+         class XVector,
+         class YVector,
+         bool conjugate>
+static void
+spmv_handle (HandleType& handle,
+             typename YVector::const_value_type& alpha,
+             const AMatrix& A,
+             const XVector& x,
+             typename YVector::const_value_type& beta,
+             const YVector& y)
+{
+  typedef typename AMatrix::ordinal_type ordinal_type;
+
+  spmv_inspect_if_needed (handle, A);
+  if (A.numRows () <= static_cast<ordinal_type> (0)) {
+    return;
+  }
+  if (handle.get_kernel () == SPMV_KERNEL_MERGE_PATH) {
+    spmv_merge_path<AMatrix,XVector,YVector,conjugate> (alpha, A, x, beta, y, handle.get_merge_path_items_per_thread ());
+    return;
+  }
+  if (handle.get_kernel () == SPMV_KERNEL_BANDED) {
+    if (beta == Kokkos::Details::ArithTraits<typename YVector::non_const_value_type>::zero ()) {
+      spmv_handle_banded<HandleType,AMatrix,XVector,YVector,0,conjugate> (handle, alpha, A, x, beta, y);
+    } else {
+      spmv_handle_banded<HandleType,AMatrix,XVector,YVector,1,conjugate> (handle, alpha, A, x, beta, y);
+    }
+    return;
+  }
+  if (beta == Kokkos::Details::ArithTraits<typename YVector::non_const_value_type>::zero ()) {
+    spmv_handle_balanced_rows<HandleType,AMatrix,XVector,YVector,0,conjugate> (handle, alpha, A, x, beta, y);
+  } else {
+    spmv_handle_balanced_rows<HandleType,AMatrix,XVector,YVector,1,conjugate> (handle, alpha, A, x, beta, y);
+  }
+}
+
+// The sequence 0, 1, ..., transposed along with the pattern of the matrix to
+// give the entry of the matrix of each entry of the transpose.
+template<class SequenceType>
+struct SPMV_Sequence_Functor {
+  typedef typename SequenceType::non_const_value_type size_type;
+
+  SequenceType sequence;
+
+  SPMV_Sequence_Functor (const SequenceType sequence_) : sequence (sequence_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& k) const
+  {
+    sequence(k) = k;
+  }
+};
+
+template<class ValuesType, class TransposeValuesType, class PermutationType>
+struct SPMV_Transpose_Values_Functor {
+  typedef typename PermutationType::non_const_value_type size_type;
+
+  ValuesType values;
+  TransposeValuesType transpose_values;
+  PermutationType permutation;
+
+  SPMV_Transpose_Values_Functor (const ValuesType values_,
+                                 const TransposeValuesType transpose_values_,
+                                 const PermutationType permutation_) :
+    values (values_), transpose_values (transpose_values_), permutation (permutation_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& k) const
+  {
+    transpose_values(k) = values(permutation(k));
+  }
+};
+
+// The explicit transpose of AMatrix, on the views stored in the handle.
+template<class AMatrix>
+struct SPMV_Cached_Transpose {
+  typedef KokkosSparse::CrsMatrix<
+              typename AMatrix::const_value_type,
+              typename AMatrix::const_ordinal_type,
+              typename AMatrix::device_type,
+              Kokkos::MemoryTraits<Kokkos::Unmanaged>,
+              typename AMatrix::const_size_type> matrix_type;
+};
+
+/// \brief Computes the pattern of the transpose of A and the entry of A of
+///   each of its entries, and stores them in handle.
+template<class HandleType, class AMatrix>
+void
+spmv_transpose_inspect (HandleType& handle, const AMatrix& A)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename HandleType::size_type_view_t size_type_view_t;
+  typedef typename HandleType::nnz_lno_view_t entries_view_t;
+
+  const typename HandleType::nnz_lno_t numRows = A.numRows ();
+  const typename HandleType::nnz_lno_t numCols = A.numCols ();
+  const typename HandleType::size_type nnz = A.nnz ();
+
+  size_type_view_t t_row_map ("spmv transpose row_map", numCols + 1);
+  entries_view_t t_entries (Kokkos::ViewAllocateWithoutInitializing ("spmv transpose entries"), nnz);
+  size_type_view_t permutation (Kokkos::ViewAllocateWithoutInitializing ("spmv transpose permutation"), nnz);
+  if (numRows > 0) {
+    size_type_view_t sequence (Kokkos::ViewAllocateWithoutInitializing ("spmv transpose sequence"), nnz);
+    Kokkos::parallel_for ("KokkosSparse::spmv_transpose_inspect",
+        Kokkos::RangePolicy<execution_space> (0, nnz),
+        SPMV_Sequence_Functor<size_type_view_t> (sequence));
+    KokkosKernels::Impl::kk_transpose_matrix
+      <typename AMatrix::row_map_type, typename AMatrix::index_type, size_type_view_t,
+       size_type_view_t, entries_view_t, size_type_view_t, size_type_view_t, execution_space>
+      (numRows, numCols, A.graph.row_map, A.graph.entries, sequence, t_row_map, t_entries, permutation);
+  }
+  handle.set_transpose_plan (A.graph.row_map.data (), numRows, nnz, t_row_map, t_entries, permutation);
+}
+
+/// \brief Returns the transpose of A cached in handle, building its pattern
+///   the first time and copying the values of A after handle.values_updated().
+template<class HandleType, class AMatrix>
+typename SPMV_Cached_Transpose<AMatrix>::matrix_type
+spmv_cached_transpose (HandleType& handle, const AMatrix& A)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_value_type value_type;
+  typedef typename SPMV_Cached_Transpose<AMatrix>::matrix_type transpose_matrix_t;
+  typedef Kokkos::View<value_type*, Kokkos::LayoutRight, typename AMatrix::device_type,
+      Kokkos::MemoryTraits<Kokkos::Unmanaged> > transpose_values_t;
+  static_assert (std::is_same<typename AMatrix::non_const_size_type, typename HandleType::size_type>::value,
+                 "KokkosSparse::spmv: The handle and the matrix must have the same size type to cache the transpose.");
+
+  if (!handle.is_transpose_plan_for (A.graph.row_map.data (), A.numRows (), A.nnz ())) {
+    spmv_transpose_inspect (handle, A);
+  }
+  const typename HandleType::size_type nnz = A.nnz ();
+  if (!handle.get_are_transpose_values_current ()) {
+    typename HandleType::byte_view_t bytes = handle.get_transpose_values ();
+    if (bytes.extent (0) != nnz * sizeof (value_type)) {
+      bytes = typename HandleType::byte_view_t
+        (Kokkos::ViewAllocateWithoutInitializing ("spmv transpose values"), nnz * sizeof (value_type));
+    }
+    transpose_values_t t_values (reinterpret_cast<value_type*> (bytes.data ()), nnz);
+    Kokkos::parallel_for ("KokkosSparse::spmv_transpose_values",
+        Kokkos::RangePolicy<execution_space> (0, nnz),
+        SPMV_Transpose_Values_Functor<typename AMatrix::values_type, transpose_values_t,
+          typename HandleType::size_type_view_t> (A.values, t_values, handle.get_transpose_permutation ()));
+    handle.set_transpose_values (bytes);
+  }
+
+  return transpose_matrix_t ("spmv transpose", A.numCols (), A.numRows (), nnz,
+      typename transpose_matrix_t::values_type (reinterpret_cast<const value_type*> (handle.get_transpose_values ().data ()), nnz),
+      typename transpose_matrix_t::row_map_type (handle.get_transpose_row_map ().data (), A.numCols () + 1),
+      typename transpose_matrix_t::index_type (handle.get_transpose_entries ().data (), nnz));
+}
+
+}
+}
+
+#endif
@@ -46,8 +46,10 @@
 
 #include "Kokkos_InnerProductSpaceTraits.hpp"
 #include "KokkosBlas1_scal.hpp"
+#include "KokkosKernels_SimpleUtils.hpp"
 #include "KokkosSparse_CrsMatrix.hpp"
 #include "KokkosSparse_spmv_impl_omp.hpp"
+#include "KokkosSparse_spmm_impl.hpp"
 
 namespace KokkosSparse {
 namespace Impl {
@@ -139,7 +141,7 @@ struct SPMV_Transpose_Functor {
           row.value(iEntry);
         const ordinal_type ind = row.colidx(iEntry);
 
-        Kokkos::atomic_add (&m_y(ind), static_cast<y_value_type> (alpha * val * m_x(iRow)));
+        KokkosKernels::Impl::kk_atomic_add (&m_y(ind), static_cast<y_value_type> (alpha * val * m_x(iRow)));
       }
     }
   }
@@ -154,22 +156,23 @@ struct SPMV_Functor {
   typedef typename AMatrix::execution_space            execution_space;
   typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
   typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       coefficient_type;
   typedef typename Kokkos::TeamPolicy<execution_space> team_policy;
   typedef typename team_policy::member_type            team_member;
   typedef Kokkos::Details::ArithTraits<value_type>     ATV;
 
-  const value_type alpha;
+  const coefficient_type alpha;
   AMatrix  m_A;
   XVector m_x;
-  const value_type beta;
+  const coefficient_type beta;
   YVector m_y;
 
   const ordinal_type rows_per_team;
 
-  SPMV_Functor (const value_type alpha_,
+  SPMV_Functor (const coefficient_type alpha_,
                 const AMatrix m_A_,
                 const XVector m_x_,
-                const value_type beta_,
+                const coefficient_type beta_,
                 const YVector m_y_,
                 const int rows_per_team_) :
      alpha (alpha_), m_A (m_A_), m_x (m_x_),
@@ -269,7 +272,8 @@ template<class AMatrix,
          int dobeta,
          bool conjugate>
 static void
-spmv_beta_no_transpose (typename YVector::const_value_type& alpha,
+spmv_beta_no_transpose (const typename AMatrix::execution_space& space,
+                              typename YVector::const_value_type& alpha,
                               const AMatrix& A,
                               const XVector& x,
                               typename YVector::const_value_type& beta,
@@ -306,16 +310,16 @@ spmv_beta_no_transpose (typename YVector::const_value_type& alpha,
   if(A.nnz()>10000000) {
     Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic> > policy(1,1);
     if(team_size<0)
-      policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic> >(worksets,Kokkos::AUTO,vector_length);
+      policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic> >(space,worksets,Kokkos::AUTO,vector_length);
     else
-      policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic> >(worksets,team_size,vector_length);
+      policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Dynamic> >(space,worksets,team_size,vector_length);
     Kokkos::parallel_for("KokkosSparse::spmv<NoTranspose,Dynamic>",policy,func);
   } else {
     Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> > policy(1,1);
     if(team_size<0)
-      policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> >(worksets,Kokkos::AUTO,vector_length);
+      policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> >(space,worksets,Kokkos::AUTO,vector_length);
     else
-      policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> >(worksets,team_size,vector_length);
+      policy = Kokkos::TeamPolicy<execution_space, Kokkos::Schedule<Kokkos::Static> >(space,worksets,team_size,vector_length);
     Kokkos::parallel_for("KokkosSparse::spmv<NoTranspose,Static>",policy,func);
   }
 }
@@ -326,7 +330,8 @@ template<class AMatrix,
          int dobeta,
          bool conjugate>
 static void
-spmv_beta_transpose (typename YVector::const_value_type& alpha,
+spmv_beta_transpose (const typename AMatrix::execution_space& space,
+                           typename YVector::const_value_type& alpha,
                            const AMatrix& A,
                            const XVector& x,
                            typename YVector::const_value_type& beta,
@@ -341,7 +346,7 @@ spmv_beta_transpose (typename YVector::const_value_type& alpha,
   // We need to scale y first ("scaling" by zero just means filling
   // with zeros), since the functor works by atomic-adding into y.
   if (dobeta != 1) {
-    KokkosBlas::scal (y, beta, y);
+    KokkosBlas::scal (space, y, beta, y);
   }
 
   typedef typename AMatrix::size_type size_type;
@@ -365,7 +370,7 @@ spmv_beta_transpose (typename YVector::const_value_type& alpha,
   const int rows_per_team = rows_per_thread * team_size;
   const size_type nteams = (nrow+rows_per_team-1)/rows_per_team;
   Kokkos::parallel_for("KokkosSparse::spmv<Transpose>", Kokkos::TeamPolicy< typename AMatrix::execution_space >
-     ( nteams , team_size , vector_length ) , op );
+     ( space, nteams , team_size , vector_length ) , op );
 
 }
 
@@ -374,7 +379,8 @@ template<class AMatrix,
          class YVector,
          int dobeta>
 static void
-spmv_beta (const char mode[],
+spmv_beta (const typename AMatrix::execution_space& space,
+                 const char mode[],
                  typename YVector::const_value_type& alpha,
                  const AMatrix& A,
                  const XVector& x,
@@ -383,19 +389,19 @@ spmv_beta (const char mode[],
 {
   if (mode[0] == NoTranspose[0]) {
     spmv_beta_no_transpose<AMatrix,XVector,YVector,dobeta,false>
-      (alpha,A,x,beta,y);
+      (space,alpha,A,x,beta,y);
   }
   else if (mode[0] == Conjugate[0]) {
     spmv_beta_no_transpose<AMatrix,XVector,YVector,dobeta,true>
-      (alpha,A,x,beta,y);
+      (space,alpha,A,x,beta,y);
   }
   else if (mode[0]==Transpose[0]) {
     spmv_beta_transpose<AMatrix,XVector,YVector,dobeta,false>
-      (alpha,A,x,beta,y);
+      (space,alpha,A,x,beta,y);
   }
   else if(mode[0]==ConjugateTranspose[0]) {
     spmv_beta_transpose<AMatrix,XVector,YVector,dobeta,true>
-      (alpha,A,x,beta,y);
+      (space,alpha,A,x,beta,y);
   }
   else {
     Kokkos::Impl::throw_runtime_exception("Invalid Transpose Mode for KokkosSparse::spmv()");
@@ -477,16 +483,16 @@ struct SPMV_MV_Transpose_Functor {
           #pragma unroll
           #endif
           for (ordinal_type k = 0; k < n; ++k) {
-            Kokkos::atomic_add (&m_y(ind,k),
-                                static_cast<y_value_type> (alpha * val * m_x(iRow, k)));
+            KokkosKernels::Impl::kk_atomic_add (&m_y(ind,k),
+                                                 static_cast<y_value_type> (alpha * val * m_x(iRow, k)));
           }
         } else {
           #ifdef KOKKOS_ENABLE_PRAGMA_UNROLL
           #pragma unroll
           #endif
           for (ordinal_type k = 0; k < n; ++k) {
-            Kokkos::atomic_add (&m_y(ind,k),
-                                static_cast<y_value_type> (val * m_x(iRow, k)));
+            KokkosKernels::Impl::kk_atomic_add (&m_y(ind,k),
+                                                 static_cast<y_value_type> (val * m_x(iRow, k)));
           }
         }
       }
@@ -877,7 +883,8 @@ template<class AMatrix,
          int dobeta,
          bool conjugate>
 static void
-spmv_alpha_beta_mv_no_transpose (const typename YVector::non_const_value_type& alpha,
+spmv_alpha_beta_mv_no_transpose (const typename AMatrix::execution_space& space,
+                                 const typename YVector::non_const_value_type& alpha,
                                  const AMatrix& A,
                                  const XVector& x,
                                  const typename YVector::non_const_value_type& beta,
@@ -890,13 +897,24 @@ spmv_alpha_beta_mv_no_transpose (const typename YVector::non_const_value_type& a
   }
   if (doalpha == 0) {
     if (dobeta != 1) {
-      KokkosBlas::scal (y, beta, y);
+      KokkosBlas::scal (space, y, beta, y);
     }
     return;
   }
   else {
     typedef typename AMatrix::size_type size_type;
 
+    // With more than a few columns, tile the columns in registers so
+    // that each entry of A is read once per tile.
+    if (x.extent(1) > spmm_min_num_columns) {
+#ifndef KOKKOS_FAST_COMPILE
+      spmm_no_transpose<AMatrix, XVector, YVector, doalpha, dobeta, conjugate> (space, alpha, A, x, beta, y);
+#else
+      spmm_no_transpose<AMatrix, XVector, YVector, 2, 2, conjugate> (space, alpha, A, x, beta, y);
+#endif
+      return;
+    }
+
     // Assuming that no row contains duplicate entries, NNZPerRow
     // cannot be more than the number of columns of the matrix.  Thus,
     // the appropriate type is ordinal_type.
@@ -923,7 +941,7 @@ spmv_alpha_beta_mv_no_transpose (const typename YVector::non_const_value_type& a
     const int rows_per_team = rows_per_thread * team_size;
     const size_type nteams = (nrow+rows_per_team-1)/rows_per_team;
     Kokkos::parallel_for("KokkosSparse::spmv<MV,NoTranspose>", Kokkos::TeamPolicy< typename AMatrix::execution_space >
-       ( nteams , team_size , vector_length ) , op );
+       ( space, nteams , team_size , vector_length ) , op );
 
 #else // KOKKOS_FAST_COMPILE this will only instantiate one Kernel for alpha/beta
 
@@ -944,7 +962,7 @@ spmv_alpha_beta_mv_no_transpose (const typename YVector::non_const_value_type& a
     const int rows_per_team = rows_per_thread * team_size;
     const size_type nteams = (nrow+rows_per_team-1)/rows_per_team;
     Kokkos::parallel_for("KokkosSparse::spmv<MV,NoTranspose>",  Kokkos::TeamPolicy< typename AMatrix::execution_space >
-       ( nteams , team_size , vector_length ) , op );
+       ( space, nteams , team_size , vector_length ) , op );
 
 #endif // KOKKOS_FAST_COMPILE
   }
@@ -957,7 +975,8 @@ template<class AMatrix,
          int dobeta,
          bool conjugate>
 static void
-spmv_alpha_beta_mv_transpose (const typename YVector::non_const_value_type& alpha,
+spmv_alpha_beta_mv_transpose (const typename AMatrix::execution_space& space,
+                              const typename YVector::non_const_value_type& alpha,
                               const AMatrix& A,
                               const XVector& x,
                               const typename YVector::non_const_value_type& beta,
@@ -972,7 +991,7 @@ spmv_alpha_beta_mv_transpose (const typename YVector::non_const_value_type& alph
   // We need to scale y first ("scaling" by zero just means filling
   // with zeros), since the functor works by atomic-adding into y.
   if (dobeta != 1) {
-    KokkosBlas::scal (y, beta, y);
+    KokkosBlas::scal (space, y, beta, y);
   }
 
   if (doalpha != 0) {
@@ -1004,7 +1023,7 @@ spmv_alpha_beta_mv_transpose (const typename YVector::non_const_value_type& alph
     const int rows_per_team = rows_per_thread * team_size;
     const size_type nteams = (nrow+rows_per_team-1)/rows_per_team;
     Kokkos::parallel_for ("KokkosSparse::spmv<MV,Transpose>",  Kokkos::TeamPolicy< typename AMatrix::execution_space >
-       ( nteams , team_size , vector_length ) , op );
+       ( space, nteams , team_size , vector_length ) , op );
 
 #else // KOKKOS_FAST_COMPILE this will only instantiate one Kernel for alpha/beta
 
@@ -1025,7 +1044,7 @@ spmv_alpha_beta_mv_transpose (const typename YVector::non_const_value_type& alph
     const int rows_per_team = rows_per_thread * team_size;
     const size_type nteams = (nrow+rows_per_team-1)/rows_per_team;
     Kokkos::parallel_for("KokkosSparse::spmv<MV,Transpose>",  Kokkos::TeamPolicy< typename AMatrix::execution_space >
-       ( nteams , team_size , vector_length ) , op );
+       ( space, nteams , team_size , vector_length ) , op );
 
 #endif // KOKKOS_FAST_COMPILE
   }
@@ -1037,7 +1056,8 @@ template<class AMatrix,
          int doalpha,
          int dobeta>
 static void
-spmv_alpha_beta_mv (const char mode[],
+spmv_alpha_beta_mv (const typename AMatrix::execution_space& space,
+                    const char mode[],
                     const typename YVector::non_const_value_type& alpha,
                     const AMatrix& A,
                     const XVector& x,
@@ -1045,16 +1065,16 @@ spmv_alpha_beta_mv (const char mode[],
                     const YVector& y)
 {
   if (mode[0] == NoTranspose[0]) {
-    spmv_alpha_beta_mv_no_transpose<AMatrix, XVector, YVector, doalpha, dobeta, false> (alpha, A, x, beta, y);
+    spmv_alpha_beta_mv_no_transpose<AMatrix, XVector, YVector, doalpha, dobeta, false> (space, alpha, A, x, beta, y);
   }
   else if (mode[0] == Conjugate[0]) {
-    spmv_alpha_beta_mv_no_transpose<AMatrix, XVector, YVector, doalpha, dobeta, true> (alpha, A, x, beta, y);
+    spmv_alpha_beta_mv_no_transpose<AMatrix, XVector, YVector, doalpha, dobeta, true> (space, alpha, A, x, beta, y);
   }
   else if (mode[0] == Transpose[0]) {
-    spmv_alpha_beta_mv_transpose<AMatrix, XVector, YVector, doalpha, dobeta, false> (alpha, A, x, beta, y);
+    spmv_alpha_beta_mv_transpose<AMatrix, XVector, YVector, doalpha, dobeta, false> (space, alpha, A, x, beta, y);
   }
   else if (mode[0] == ConjugateTranspose[0]) {
-    spmv_alpha_beta_mv_transpose<AMatrix, XVector, YVector, doalpha, dobeta, true> (alpha, A, x, beta, y);
+    spmv_alpha_beta_mv_transpose<AMatrix, XVector, YVector, doalpha, dobeta, true> (space, alpha, A, x, beta, y);
   }
   else {
     Kokkos::Impl::throw_runtime_exception ("Invalid Transpose Mode for KokkosSparse::spmv()");
@@ -1066,7 +1086,8 @@ template<class AMatrix,
          class YVector,
          int doalpha>
 void
-spmv_alpha_mv (const char mode[],
+spmv_alpha_mv (const typename AMatrix::execution_space& space,
+               const char mode[],
                const typename YVector::non_const_value_type& alpha,
                const AMatrix& A,
                const XVector& x,
@@ -1077,16 +1098,16 @@ spmv_alpha_mv (const char mode[],
   typedef Kokkos::Details::ArithTraits<coefficient_type> KAT;
 
   if (beta == KAT::zero ()) {
-    spmv_alpha_beta_mv<AMatrix, XVector, YVector, doalpha, 0> (mode, alpha, A, x, beta, y);
+    spmv_alpha_beta_mv<AMatrix, XVector, YVector, doalpha, 0> (space, mode, alpha, A, x, beta, y);
   }
   else if (beta == KAT::one ()) {
-    spmv_alpha_beta_mv<AMatrix, XVector, YVector, doalpha, 1> (mode, alpha, A, x, beta, y);
+    spmv_alpha_beta_mv<AMatrix, XVector, YVector, doalpha, 1> (space, mode, alpha, A, x, beta, y);
   }
   else if (beta == -KAT::one ()) {
-    spmv_alpha_beta_mv<AMatrix, XVector, YVector, doalpha, -1> (mode, alpha, A, x, beta, y);
+    spmv_alpha_beta_mv<AMatrix, XVector, YVector, doalpha, -1> (space, mode, alpha, A, x, beta, y);
   }
   else {
-    spmv_alpha_beta_mv<AMatrix, XVector, YVector, doalpha, 2> (mode, alpha, A, x, beta, y);
+    spmv_alpha_beta_mv<AMatrix, XVector, YVector, doalpha, 2> (space, mode, alpha, A, x, beta, y);
   }
 }
 
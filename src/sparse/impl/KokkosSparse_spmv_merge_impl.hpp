@@ -0,0 +1,353 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_IMPL_SPMV_MERGE_HPP_
+#define KOKKOSSPARSE_IMPL_SPMV_MERGE_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_SimpleUtils.hpp"
+
+namespace KokkosSparse {
+namespace Impl {
+
+// Merge path of y = A*x: the row ends row_map(1:numRows) are merged with the
+// indices 0:nnz-1 of the nonzeroes, and the numRows + nnz items are split evenly
+// among the threads. A thread finds its start on the path with a binary search
+// along its diagonal, and walks it: a nonzero item accumulates a product, and a
+// row end item writes the sum of the row. The sum of the row left open at the
+// end of a thread is a carry, added to y after the kernel.
+template<class RowMapType, class ordinal_type, class size_type>
+KOKKOS_INLINE_FUNCTION void
+spmv_merge_path_search (const RowMapType& row_map, const ordinal_type numRows,
+                        const size_type nnz, const size_type diagonal,
+                        ordinal_type& row, size_type& nz)
+{
+  ordinal_type x_min = diagonal > nnz ? static_cast<ordinal_type> (diagonal - nnz) : 0;
+  ordinal_type x_max = diagonal < static_cast<size_type> (numRows) ? static_cast<ordinal_type> (diagonal) : numRows;
+  while (x_min < x_max) {
+    const ordinal_type pivot = x_min + (x_max - x_min) / 2;
+    if (static_cast<size_type> (row_map(pivot + 1)) <= diagonal - pivot - 1) {
+      x_min = pivot + 1;
+    } else {
+      x_max = pivot;
+    }
+  }
+  row = x_min;
+  nz = diagonal - x_min;
+}
+
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         bool conjugate>
+struct SPMV_MergePath_Functor {
+  typedef typename AMatrix::execution_space            execution_space;
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::non_const_size_type        size_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       y_value_type;
+  typedef Kokkos::Details::ArithTraits<value_type>     ATV;
+  typedef Kokkos::View<ordinal_type*, execution_space> carry_row_view;
+  typedef Kokkos::View<y_value_type*, execution_space> carry_value_view;
+
+  struct WalkTag{};
+  struct CarryTag{};
+
+  const y_value_type alpha;
+  AMatrix  m_A;
+  XVector m_x;
+  const y_value_type beta;
+  YVector m_y;
+  const size_type items_per_thread;
+  carry_row_view carry_rows;
+  carry_value_view carry_values;
+
+  SPMV_MergePath_Functor (const y_value_type alpha_,
+                          const AMatrix m_A_,
+                          const XVector m_x_,
+                          const y_value_type beta_,
+                          const YVector m_y_,
+                          const size_type items_per_thread_,
+                          const size_type num_threads_) :
+     alpha (alpha_), m_A (m_A_), m_x (m_x_),
+     beta (beta_), m_y (m_y_),
+     items_per_thread (items_per_thread_),
+     carry_rows (Kokkos::ViewAllocateWithoutInitializing ("spmv merge path carry rows"), num_threads_),
+     carry_values (Kokkos::ViewAllocateWithoutInitializing ("spmv merge path carry values"), num_threads_)
+  {
+    static_assert (static_cast<int> (XVector::rank) == 1,
+                   "XVector must be a rank 1 View.");
+    static_assert (static_cast<int> (YVector::rank) == 1,
+                   "YVector must be a rank 1 View.");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const WalkTag&, const size_type& thread) const
+  {
+    const ordinal_type numRows = m_A.numRows ();
+    const size_type nnz = m_A.nnz ();
+    const size_type num_items = numRows + nnz;
+    const size_type begin = thread * items_per_thread < num_items ? thread * items_per_thread : num_items;
+    const size_type end = begin + items_per_thread < num_items ? begin + items_per_thread : num_items;
+
+    ordinal_type row, row_end;
+    size_type nz, nz_end;
+    spmv_merge_path_search (m_A.graph.row_map, numRows, nnz, begin, row, nz);
+    spmv_merge_path_search (m_A.graph.row_map, numRows, nnz, end, row_end, nz_end);
+
+    const bool dobeta = beta != Kokkos::Details::ArithTraits<y_value_type>::zero ();
+    y_value_type sum = Kokkos::Details::ArithTraits<y_value_type>::zero ();
+    for (; row < row_end; ++row) {
+      const size_type row_end_offset = m_A.graph.row_map(row + 1);
+      for (; nz < row_end_offset; ++nz) {
+        const value_type val = conjugate ? ATV::conj (m_A.values(nz)) : m_A.values(nz);
+        sum += val * m_x(m_A.graph.entries(nz));
+      }
+      m_y(row) = dobeta ? beta * m_y(row) + alpha * sum : alpha * sum;
+      sum = Kokkos::Details::ArithTraits<y_value_type>::zero ();
+    }
+    for (; nz < nz_end; ++nz) {
+      const value_type val = conjugate ? ATV::conj (m_A.values(nz)) : m_A.values(nz);
+      sum += val * m_x(m_A.graph.entries(nz));
+    }
+    carry_rows(thread) = row_end;
+    carry_values(thread) = sum;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const CarryTag&, const size_type& thread) const
+  {
+    //the row of the carry is written by a later thread in the walk.
+    if (carry_rows(thread) < m_A.numRows ()) {
+      KokkosKernels::Impl::kk_atomic_add (&m_y(carry_rows(thread)), alpha * carry_values(thread));
+    }
+  }
+};
+
+// Merge path for LayoutLeft multivectors: a thread walks its part of the path
+// once per column, with a carry per column.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         bool conjugate>
+struct SPMV_MV_MergePath_Functor {
+  typedef typename AMatrix::execution_space            execution_space;
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::non_const_size_type        size_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       y_value_type;
+  typedef Kokkos::Details::ArithTraits<value_type>     ATV;
+  typedef Kokkos::View<ordinal_type*, execution_space> carry_row_view;
+  typedef Kokkos::View<y_value_type**, Kokkos::LayoutLeft, execution_space> carry_value_view;
+
+  struct WalkTag{};
+  struct CarryTag{};
+
+  const y_value_type alpha;
+  AMatrix  m_A;
+  XVector m_x;
+  const y_value_type beta;
+  YVector m_y;
+  const size_type items_per_thread;
+  carry_row_view carry_rows;
+  carry_value_view carry_values;
+
+  SPMV_MV_MergePath_Functor (const y_value_type alpha_,
+                             const AMatrix m_A_,
+                             const XVector m_x_,
+                             const y_value_type beta_,
+                             const YVector m_y_,
+                             const size_type items_per_thread_,
+                             const size_type num_threads_) :
+     alpha (alpha_), m_A (m_A_), m_x (m_x_),
+     beta (beta_), m_y (m_y_),
+     items_per_thread (items_per_thread_),
+     carry_rows (Kokkos::ViewAllocateWithoutInitializing ("spmv merge path carry rows"), num_threads_),
+     carry_values (Kokkos::ViewAllocateWithoutInitializing ("spmv merge path carry values"), num_threads_, m_x_.extent(1))
+  {
+    static_assert (static_cast<int> (XVector::rank) == 2,
+                   "XVector must be a rank 2 View.");
+    static_assert (static_cast<int> (YVector::rank) == 2,
+                   "YVector must be a rank 2 View.");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const WalkTag&, const size_type& thread) const
+  {
+    const ordinal_type numRows = m_A.numRows ();
+    const size_type nnz = m_A.nnz ();
+    const size_type num_items = numRows + nnz;
+    const size_type begin = thread * items_per_thread < num_items ? thread * items_per_thread : num_items;
+    const size_type end = begin + items_per_thread < num_items ? begin + items_per_thread : num_items;
+
+    ordinal_type row_begin, row_end;
+    size_type nz_begin, nz_end;
+    spmv_merge_path_search (m_A.graph.row_map, numRows, nnz, begin, row_begin, nz_begin);
+    spmv_merge_path_search (m_A.graph.row_map, numRows, nnz, end, row_end, nz_end);
+
+    const bool dobeta = beta != Kokkos::Details::ArithTraits<y_value_type>::zero ();
+    const ordinal_type numVecs = m_x.extent(1);
+    for (ordinal_type k = 0; k < numVecs; ++k) {
+      ordinal_type row = row_begin;
+      size_type nz = nz_begin;
+      y_value_type sum = Kokkos::Details::ArithTraits<y_value_type>::zero ();
+      for (; row < row_end; ++row) {
+        const size_type row_end_offset = m_A.graph.row_map(row + 1);
+        for (; nz < row_end_offset; ++nz) {
+          const value_type val = conjugate ? ATV::conj (m_A.values(nz)) : m_A.values(nz);
+          sum += val * m_x(m_A.graph.entries(nz), k);
+        }
+        m_y(row, k) = dobeta ? beta * m_y(row, k) + alpha * sum : alpha * sum;
+        sum = Kokkos::Details::ArithTraits<y_value_type>::zero ();
+      }
+      for (; nz < nz_end; ++nz) {
+        const value_type val = conjugate ? ATV::conj (m_A.values(nz)) : m_A.values(nz);
+        sum += val * m_x(m_A.graph.entries(nz), k);
+      }
+      carry_values(thread, k) = sum;
+    }
+    carry_rows(thread) = row_end;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const CarryTag&, const size_type& thread) const
+  {
+    if (carry_rows(thread) < m_A.numRows ()) {
+      const ordinal_type numVecs = m_x.extent(1);
+      for (ordinal_type k = 0; k < numVecs; ++k) {
+        KokkosKernels::Impl::kk_atomic_add (&m_y(carry_rows(thread), k), alpha * carry_values(thread, k));
+      }
+    }
+  }
+};
+
+// Merge path items of a thread, from the controls or from the concurrency.
+template<class execution_space>
+int64_t spmv_merge_path_items_per_thread (const int64_t num_items, const int64_t items_per_thread)
+{
+  if (items_per_thread > 0) {
+    return items_per_thread;
+  }
+  const int64_t conc = execution_space::concurrency ();
+  //a few threads per core on the host keep the walk balanced, and enough items
+  //amortize the two searches of a thread.
+  int64_t items = (num_items + 4 * conc - 1) / (4 * conc);
+  if (items < 64) items = 64;
+  return items;
+}
+
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         class FunctorType>
+static void
+spmv_merge_path_run (FunctorType& func, const int64_t num_threads, const char label[])
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_size_type size_type;
+  typedef typename FunctorType::WalkTag WalkTag;
+  typedef typename FunctorType::CarryTag CarryTag;
+  Kokkos::parallel_for (label, Kokkos::RangePolicy<execution_space, WalkTag, Kokkos::IndexType<size_type> > (0, num_threads), func);
+  Kokkos::parallel_for (label, Kokkos::RangePolicy<execution_space, CarryTag, Kokkos::IndexType<size_type> > (0, num_threads), func);
+}
+
+/// \brief y = beta*y + alpha*A*x (or conj(A)*x) with the merge path
+///   partition of the rows and nonzeroes of A, for rank 1 x and y.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         bool conjugate>
+static void
+spmv_merge_path (typename YVector::const_value_type& alpha,
+                 const AMatrix& A,
+                 const XVector& x,
+                 typename YVector::const_value_type& beta,
+                 const YVector& y,
+                 const int64_t items_per_thread = 0)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::ordinal_type ordinal_type;
+
+  if (A.numRows () <= static_cast<ordinal_type> (0)) {
+    return;
+  }
+  const int64_t num_items = static_cast<int64_t> (A.numRows ()) + A.nnz ();
+  const int64_t items = spmv_merge_path_items_per_thread<execution_space> (num_items, items_per_thread);
+  const int64_t num_threads = (num_items + items - 1) / items;
+
+  SPMV_MergePath_Functor<AMatrix,XVector,YVector,conjugate> func (alpha,A,x,beta,y,items,num_threads);
+  spmv_merge_path_run<AMatrix,XVector,YVector> (func, num_threads, "KokkosSparse::spmv<NoTranspose,MergePath>");
+}
+
+/// \brief Same as spmv_merge_path for LayoutLeft rank 2 x and y.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         bool conjugate>
+static void
+spmv_merge_path_mv (typename YVector::const_value_type& alpha,
+                    const AMatrix& A,
+                    const XVector& x,
+                    typename YVector::const_value_type& beta,
+                    const YVector& y,
+                    const int64_t items_per_thread = 0)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::ordinal_type ordinal_type;
+
+  if (A.numRows () <= static_cast<ordinal_type> (0)) {
+    return;
+  }
+  const int64_t num_items = static_cast<int64_t> (A.numRows ()) + A.nnz ();
+  const int64_t items = spmv_merge_path_items_per_thread<execution_space> (num_items, items_per_thread);
+  const int64_t num_threads = (num_items + items - 1) / items;
+
+  SPMV_MV_MergePath_Functor<AMatrix,XVector,YVector,conjugate> func (alpha,A,x,beta,y,items,num_threads);
+  spmv_merge_path_run<AMatrix,XVector,YVector> (func, num_threads, "KokkosSparse::spmv<MV,NoTranspose,MergePath>");
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,239 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_IMPL_SPMV_SELL_HPP_
+#define KOKKOSSPARSE_IMPL_SPMV_SELL_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosBatched_Vector.hpp"
+#include "KokkosSparse_SellMatrix.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+namespace Impl {
+
+// One lane per row of a chunk. The lanes of a chunk read consecutive entries,
+// which coalesces the loads on Cuda when the chunk size is a multiple of the
+// warp size.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         bool conjugate>
+struct SPMV_Sell_Lane_Functor {
+  typedef typename AMatrix::ordinal_type               ordinal_type;
+  typedef typename AMatrix::size_type                  size_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       y_value_type;
+  typedef Kokkos::Details::ArithTraits<value_type>     ATV;
+
+  const y_value_type alpha;
+  AMatrix m_A;
+  XVector m_x;
+  const y_value_type beta;
+  YVector m_y;
+
+  SPMV_Sell_Lane_Functor (const y_value_type alpha_,
+                          const AMatrix m_A_,
+                          const XVector m_x_,
+                          const y_value_type beta_,
+                          const YVector m_y_) :
+    alpha (alpha_), m_A (m_A_), m_x (m_x_),
+    beta (beta_), m_y (m_y_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& lane_index) const
+  {
+    if (lane_index >= m_A.numRows ()) {
+      return;
+    }
+    const ordinal_type chunk_size = m_A.chunkSize ();
+    const ordinal_type chunk = lane_index / chunk_size;
+    const ordinal_type lane = lane_index % chunk_size;
+    const size_type begin = m_A.chunk_offsets(chunk) + lane;
+    const size_type end = m_A.chunk_offsets(chunk + 1);
+
+    y_value_type sum = Kokkos::Details::ArithTraits<y_value_type>::zero ();
+    for (size_type pos = begin; pos < end; pos += chunk_size) {
+      const value_type val = conjugate ? ATV::conj (m_A.values(pos)) : m_A.values(pos);
+      sum += val * m_x(m_A.entries(pos));
+    }
+    const ordinal_type row = m_A.row_perm(lane_index);
+    if (dobeta == 0) {
+      m_y(row) = alpha * sum;
+    } else {
+      m_y(row) = beta * m_y(row) + alpha * sum;
+    }
+  }
+};
+
+// One chunk per iteration, with the chunk size equal to the SIMD width: a
+// column of the chunk is a contiguous SIMD load of values, times a gather of x.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         int vector_length>
+struct SPMV_Sell_SIMD_Functor {
+  typedef typename AMatrix::ordinal_type               ordinal_type;
+  typedef typename AMatrix::size_type                  size_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       y_value_type;
+  typedef KokkosBatched::Experimental::Vector<KokkosBatched::Experimental::SIMD<value_type>,vector_length> simd_type;
+
+  const y_value_type alpha;
+  AMatrix m_A;
+  XVector m_x;
+  const y_value_type beta;
+  YVector m_y;
+
+  SPMV_Sell_SIMD_Functor (const y_value_type alpha_,
+                          const AMatrix m_A_,
+                          const XVector m_x_,
+                          const y_value_type beta_,
+                          const YVector m_y_) :
+    alpha (alpha_), m_A (m_A_), m_x (m_x_),
+    beta (beta_), m_y (m_y_)
+  {
+    static_assert (std::is_same<value_type, y_value_type>::value,
+                   "The SIMD kernel needs the same value type for A and y.");
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& chunk) const
+  {
+    const size_type begin = m_A.chunk_offsets(chunk);
+    const size_type end = m_A.chunk_offsets(chunk + 1);
+
+    simd_type sum (Kokkos::Details::ArithTraits<value_type>::zero ()), vals, xs;
+    for (size_type pos = begin; pos < end; pos += vector_length) {
+      vals.loadUnaligned (&m_A.values(pos));
+      for (int l = 0; l < vector_length; ++l) {
+        xs[l] = m_x(m_A.entries(pos + l));
+      }
+      sum += vals * xs;
+    }
+
+    const ordinal_type first_row = chunk * vector_length;
+    const ordinal_type num_lanes = m_A.numRows () - first_row < vector_length ? m_A.numRows () - first_row : vector_length;
+    for (ordinal_type l = 0; l < num_lanes; ++l) {
+      const ordinal_type row = m_A.row_perm(first_row + l);
+      if (dobeta == 0) {
+        m_y(row) = alpha * sum[l];
+      } else {
+        m_y(row) = beta * m_y(row) + alpha * sum[l];
+      }
+    }
+  }
+};
+
+// Launches the SIMD kernel when A and y have the same value type, and returns
+// false otherwise.
+template<bool simd_capable>
+struct SPMV_Sell_SIMD_Launch {
+  template<class AMatrix, class XVector, class YVector, int dobeta, int vector_length>
+  static bool run (typename YVector::const_value_type& alpha, const AMatrix& A, const XVector& x,
+                   typename YVector::const_value_type& beta, const YVector& y)
+  {
+    return false;
+  }
+};
+
+template<>
+struct SPMV_Sell_SIMD_Launch<true> {
+  template<class AMatrix, class XVector, class YVector, int dobeta, int vector_length>
+  static bool run (typename YVector::const_value_type& alpha, const AMatrix& A, const XVector& x,
+                   typename YVector::const_value_type& beta, const YVector& y)
+  {
+    typedef typename AMatrix::execution_space execution_space;
+    SPMV_Sell_SIMD_Functor<AMatrix,XVector,YVector,dobeta,vector_length> func (alpha,A,x,beta,y);
+    Kokkos::parallel_for ("KokkosSparse::spmv<Sell,SIMD>",
+        Kokkos::RangePolicy<execution_space> (0, A.numChunks ()), func);
+    return true;
+  }
+};
+
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         int dobeta,
+         bool conjugate>
+static void
+spmv_sell_beta (typename YVector::const_value_type& alpha,
+                const AMatrix& A,
+                const XVector& x,
+                typename YVector::const_value_type& beta,
+                const YVector& y)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::ordinal_type ordinal_type;
+  typedef typename AMatrix::non_const_value_type value_type;
+  enum : int { simd_length = KokkosBatched::Experimental::DefaultVectorLength<value_type, Kokkos::HostSpace>::value };
+  enum : bool { simd_capable = !conjugate && simd_length > 1 &&
+      std::is_same<value_type, typename YVector::non_const_value_type>::value };
+
+  if (A.numRows () <= static_cast<ordinal_type> (0)) {
+    return;
+  }
+
+  //the SIMD kernel is for the host; on Cuda the lanes of a chunk are threads.
+  bool use_simd = A.chunkSize () == simd_length;
+#ifdef KOKKOS_ENABLE_CUDA
+  if (std::is_same<execution_space, Kokkos::Cuda>::value) {
+    use_simd = false;
+  }
+#endif
+  if (use_simd &&
+      SPMV_Sell_SIMD_Launch<simd_capable>::template run<AMatrix,XVector,YVector,dobeta,simd_length> (alpha,A,x,beta,y)) {
+    return;
+  }
+  SPMV_Sell_Lane_Functor<AMatrix,XVector,YVector,dobeta,conjugate> func (alpha,A,x,beta,y);
+  Kokkos::parallel_for ("KokkosSparse::spmv<Sell>",
+      Kokkos::RangePolicy<execution_space> (0, A.numChunks () * A.chunkSize ()), func);
+}
+
+}
+}
+}
+
+#endif
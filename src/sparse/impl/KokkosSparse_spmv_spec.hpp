@@ -111,10 +111,49 @@ struct spmv_mv_eti_spec_avail {
       { enum : bool { value = true }; };
 
 
+// Specializations with float matrix values and double vectors, e.g. for a
+// preconditioner stored in lower precision.
+#define KOKKOSSPARSE_SPMV_MIXED_ETI_SPEC_AVAIL( MATRIX_SCALAR_TYPE, VECTOR_SCALAR_TYPE, ORDINAL_TYPE, OFFSET_TYPE, LAYOUT_TYPE, EXEC_SPACE_TYPE, MEM_SPACE_TYPE) \
+    template<> \
+    struct spmv_eti_spec_avail<const MATRIX_SCALAR_TYPE, \
+                  const ORDINAL_TYPE, \
+                  Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+                  Kokkos::MemoryTraits<Kokkos::Unmanaged>, \
+                  const OFFSET_TYPE, \
+                  VECTOR_SCALAR_TYPE const*, \
+                  LAYOUT_TYPE, \
+                  Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+                  Kokkos::MemoryTraits<Kokkos::Unmanaged|Kokkos::RandomAccess>, \
+                  VECTOR_SCALAR_TYPE*, \
+                  LAYOUT_TYPE, \
+                  Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+                  Kokkos::MemoryTraits<Kokkos::Unmanaged> > \
+    { enum : bool { value = true }; };
+
+
+#define KOKKOSSPARSE_SPMV_MV_MIXED_ETI_SPEC_AVAIL( MATRIX_SCALAR_TYPE, VECTOR_SCALAR_TYPE, ORDINAL_TYPE, OFFSET_TYPE, LAYOUT_TYPE, EXEC_SPACE_TYPE, MEM_SPACE_TYPE ) \
+    template<> \
+    struct spmv_mv_eti_spec_avail <const MATRIX_SCALAR_TYPE, \
+                                       const ORDINAL_TYPE, \
+                                       Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+                                       Kokkos::MemoryTraits<Kokkos::Unmanaged>, \
+                                       const OFFSET_TYPE, \
+                                       VECTOR_SCALAR_TYPE const**, \
+                                       LAYOUT_TYPE, \
+                                       Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+                                       Kokkos::MemoryTraits<Kokkos::Unmanaged|Kokkos::RandomAccess>, \
+                                       VECTOR_SCALAR_TYPE**, \
+                                       LAYOUT_TYPE, \
+                                       Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+                                       Kokkos::MemoryTraits<Kokkos::Unmanaged> > \
+      { enum : bool { value = true }; };
+
 // Include the actual specialization declarations
 #include<KokkosSparse_spmv_tpl_spec_avail.hpp>
 #include<generated_specializations_hpp/KokkosSparse_spmv_eti_spec_avail.hpp>
 #include<generated_specializations_hpp/KokkosSparse_spmv_mv_eti_spec_avail.hpp>
+#include<generated_specializations_hpp/KokkosSparse_spmv_mixed_eti_spec_avail.hpp>
+#include<generated_specializations_hpp/KokkosSparse_spmv_mv_mixed_eti_spec_avail.hpp>
 
 namespace KokkosSparse {
 namespace Impl {
@@ -154,7 +193,8 @@ struct SPMV{
 
   typedef typename YVector::non_const_value_type coefficient_type;
 
-  static void spmv (const char mode[],
+  static void spmv (const typename AMatrix::execution_space& space,
+      const char mode[],
       const coefficient_type& alpha,
       const AMatrix& A,
       const XVector& x,
@@ -220,7 +260,8 @@ struct SPMV_MV{
   typedef typename YVector::non_const_value_type coefficient_type;
 
   static void
-  spmv_mv (const char mode[],
+  spmv_mv (const typename AMatrix::execution_space& space,
+           const char mode[],
            const coefficient_type& alpha,
            const AMatrix& A,
            const XVector& x,
@@ -244,7 +285,8 @@ struct SPMV < AT, AO, AD, AM, AS,
   typedef typename YVector::non_const_value_type coefficient_type;
 
   static void
-  spmv (const char mode[],
+  spmv (const typename AMatrix::execution_space& space,
+      const char mode[],
       const coefficient_type& alpha,
       const AMatrix& A,
       const XVector& x,
@@ -257,22 +299,22 @@ struct SPMV < AT, AO, AD, AM, AS,
 
     if (alpha == KAT::zero ()) {
       if (beta != KAT::one ()) {
-        KokkosBlas::scal (y, beta, y);
+        KokkosBlas::scal (space, y, beta, y);
       }
       return;
     }
 
     if (beta == KAT::zero ()) {
-      spmv_beta<AMatrix, XVector, YVector, 0> (mode, alpha, A, x, beta, y);
+      spmv_beta<AMatrix, XVector, YVector, 0> (space, mode, alpha, A, x, beta, y);
     }
     else if (beta == KAT::one ()) {
-      spmv_beta<AMatrix, XVector, YVector, 1> (mode, alpha, A, x, beta, y);
+      spmv_beta<AMatrix, XVector, YVector, 1> (space, mode, alpha, A, x, beta, y);
     }
     else if (beta == -KAT::one ()) {
-      spmv_beta<AMatrix, XVector, YVector, -1> (mode, alpha, A, x, beta, y);
+      spmv_beta<AMatrix, XVector, YVector, -1> (space, mode, alpha, A, x, beta, y);
     }
     else {
-      spmv_beta<AMatrix, XVector, YVector, 2> (mode, alpha, A, x, beta, y);
+      spmv_beta<AMatrix, XVector, YVector, 2> (space, mode, alpha, A, x, beta, y);
     }
   }
 };
@@ -293,7 +335,8 @@ struct SPMV_MV<AT, AO, AD, AM, AS,
   typedef typename YVector::non_const_value_type coefficient_type;
 
   static void
-  spmv_mv (const char mode[],
+  spmv_mv (const typename AMatrix::execution_space& space,
+           const char mode[],
            const coefficient_type& alpha,
            const AMatrix& A,
            const XVector& x,
@@ -303,16 +346,16 @@ struct SPMV_MV<AT, AO, AD, AM, AS,
     typedef Kokkos::Details::ArithTraits<coefficient_type> KAT;
 
     if (alpha == KAT::zero ()) {
-      spmv_alpha_mv<AMatrix, XVector, YVector, 0> (mode, alpha, A, x, beta, y);
+      spmv_alpha_mv<AMatrix, XVector, YVector, 0> (space, mode, alpha, A, x, beta, y);
     }
     else if (alpha == KAT::one ()) {
-      spmv_alpha_mv<AMatrix, XVector, YVector, 1> (mode, alpha, A, x, beta, y);
+      spmv_alpha_mv<AMatrix, XVector, YVector, 1> (space, mode, alpha, A, x, beta, y);
     }
     else if (alpha == -KAT::one ()) {
-      spmv_alpha_mv<AMatrix, XVector, YVector, -1> (mode, alpha, A, x, beta, y);
+      spmv_alpha_mv<AMatrix, XVector, YVector, -1> (space, mode, alpha, A, x, beta, y);
     }
     else {
-      spmv_alpha_mv<AMatrix, XVector, YVector, 2> (mode, alpha, A, x, beta, y);
+      spmv_alpha_mv<AMatrix, XVector, YVector, 2> (space, mode, alpha, A, x, beta, y);
     }
   }
 };
@@ -331,7 +374,8 @@ struct SPMV_MV<AT, AO, AD, AM, AS,
   typedef typename YVector::non_const_value_type coefficient_type;
 
   static void
-  spmv_mv (const char mode[],
+  spmv_mv (const typename AMatrix::execution_space& space,
+           const char mode[],
            const coefficient_type& alpha,
            const AMatrix& A,
            const XVector& x,
@@ -346,7 +390,7 @@ struct SPMV_MV<AT, AO, AD, AM, AS,
     for (typename AMatrix::non_const_size_type j = 0; j < x.extent(1); ++j) {
       auto x_j = Kokkos::subview (x, Kokkos::ALL (), j);
       auto y_j = Kokkos::subview (y, Kokkos::ALL (), j);
-      impl_type::spmv (mode, alpha, A, x_j, beta, y_j);
+      impl_type::spmv (space, mode, alpha, A, x_j, beta, y_j);
     }
   }
 };
@@ -430,8 +474,77 @@ struct SPMV_MV<AT, AO, AD, AM, AS,
          Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
          Kokkos::MemoryTraits<Kokkos::Unmanaged>, std::is_integral<typename std::decay<SCALAR_TYPE>::type>::value, false, true >;
 
+#define KOKKOSSPARSE_SPMV_MIXED_ETI_SPEC_DECL( MATRIX_SCALAR_TYPE, VECTOR_SCALAR_TYPE, ORDINAL_TYPE, OFFSET_TYPE, LAYOUT_TYPE, EXEC_SPACE_TYPE, MEM_SPACE_TYPE ) \
+    extern template struct  \
+    SPMV<const MATRIX_SCALAR_TYPE, \
+         const ORDINAL_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged>, \
+         const OFFSET_TYPE, \
+         VECTOR_SCALAR_TYPE const*, \
+         LAYOUT_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged|Kokkos::RandomAccess>, \
+         VECTOR_SCALAR_TYPE*, \
+         LAYOUT_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged>, false, true >;
+
+
+#define KOKKOSSPARSE_SPMV_MIXED_ETI_SPEC_INST( MATRIX_SCALAR_TYPE, VECTOR_SCALAR_TYPE, ORDINAL_TYPE, OFFSET_TYPE, LAYOUT_TYPE, EXEC_SPACE_TYPE, MEM_SPACE_TYPE ) \
+    template struct  \
+    SPMV<const MATRIX_SCALAR_TYPE, \
+         const ORDINAL_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged>, \
+         const OFFSET_TYPE, \
+         VECTOR_SCALAR_TYPE const*, \
+         LAYOUT_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged|Kokkos::RandomAccess>, \
+         VECTOR_SCALAR_TYPE*, \
+         LAYOUT_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged>, false, true >;
+
+#define KOKKOSSPARSE_SPMV_MV_MIXED_ETI_SPEC_DECL( MATRIX_SCALAR_TYPE, VECTOR_SCALAR_TYPE, ORDINAL_TYPE, OFFSET_TYPE, LAYOUT_TYPE, EXEC_SPACE_TYPE, MEM_SPACE_TYPE ) \
+    extern template struct  \
+    SPMV_MV<const MATRIX_SCALAR_TYPE, \
+         const ORDINAL_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged>, \
+         const OFFSET_TYPE, \
+         VECTOR_SCALAR_TYPE const**, \
+         LAYOUT_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged|Kokkos::RandomAccess>, \
+         VECTOR_SCALAR_TYPE**, \
+         LAYOUT_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged>, std::is_integral<typename std::decay<MATRIX_SCALAR_TYPE>::type>::value, false, true >;
+
+
+#define KOKKOSSPARSE_SPMV_MV_MIXED_ETI_SPEC_INST( MATRIX_SCALAR_TYPE, VECTOR_SCALAR_TYPE, ORDINAL_TYPE, OFFSET_TYPE, LAYOUT_TYPE, EXEC_SPACE_TYPE, MEM_SPACE_TYPE ) \
+    template struct  \
+    SPMV_MV<const MATRIX_SCALAR_TYPE, \
+         const ORDINAL_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged>, \
+         const OFFSET_TYPE, \
+         VECTOR_SCALAR_TYPE const**, \
+         LAYOUT_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged|Kokkos::RandomAccess>, \
+         VECTOR_SCALAR_TYPE**, \
+         LAYOUT_TYPE, \
+         Kokkos::Device<EXEC_SPACE_TYPE, MEM_SPACE_TYPE>, \
+         Kokkos::MemoryTraits<Kokkos::Unmanaged>, std::is_integral<typename std::decay<MATRIX_SCALAR_TYPE>::type>::value, false, true >;
+
+
 #include<KokkosSparse_spmv_tpl_spec_decl.hpp>
 #include<generated_specializations_hpp/KokkosSparse_spmv_eti_spec_decl.hpp>
 #include<generated_specializations_hpp/KokkosSparse_spmv_mv_eti_spec_decl.hpp>
+#include<generated_specializations_hpp/KokkosSparse_spmv_mixed_eti_spec_decl.hpp>
+#include<generated_specializations_hpp/KokkosSparse_spmv_mv_mixed_eti_spec_decl.hpp>
 
 #endif // KOKKOS_BLAS1_MV_IMPL_DOT_HPP_
@@ -0,0 +1,263 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef KOKKOSSPARSE_IMPL_SPMV_SYMMETRIC_HPP_
+#define KOKKOSSPARSE_IMPL_SPMV_SYMMETRIC_HPP_
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosBlas1_scal.hpp"
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosKernels_Utils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+#include "KokkosGraph_graph_color_d2.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmv_handle.hpp"
+
+namespace KokkosSparse {
+namespace Experimental {
+namespace Impl {
+
+// Row sizes of the pattern of A with the diagonal added where it is missing.
+template<class RowMapType, class EntriesType, class OutRowMapType>
+struct SymmetricDiagonalCountFunctor {
+  typedef typename EntriesType::non_const_value_type ordinal_type;
+  typedef typename RowMapType::non_const_value_type size_type;
+
+  RowMapType row_map;
+  EntriesType entries;
+  OutRowMapType out_row_map;
+
+  SymmetricDiagonalCountFunctor (const RowMapType row_map_, const EntriesType entries_, const OutRowMapType out_row_map_) :
+    row_map (row_map_), entries (entries_), out_row_map (out_row_map_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    bool has_diagonal = false;
+    for (size_type k = row_map(i); k < row_map(i + 1); ++k) {
+      if (entries(k) == i) has_diagonal = true;
+    }
+    out_row_map(i) = row_map(i + 1) - row_map(i) + (has_diagonal ? 0 : 1);
+  }
+};
+
+template<class RowMapType, class EntriesType, class OutRowMapType, class OutEntriesType>
+struct SymmetricDiagonalFillFunctor {
+  typedef typename EntriesType::non_const_value_type ordinal_type;
+  typedef typename RowMapType::non_const_value_type size_type;
+
+  RowMapType row_map;
+  EntriesType entries;
+  OutRowMapType out_row_map;
+  OutEntriesType out_entries;
+
+  SymmetricDiagonalFillFunctor (const RowMapType row_map_, const EntriesType entries_,
+                                const OutRowMapType out_row_map_, const OutEntriesType out_entries_) :
+    row_map (row_map_), entries (entries_), out_row_map (out_row_map_), out_entries (out_entries_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& i) const
+  {
+    typename OutRowMapType::non_const_value_type pos = out_row_map(i);
+    bool has_diagonal = false;
+    for (size_type k = row_map(i); k < row_map(i + 1); ++k) {
+      if (entries(k) == i) has_diagonal = true;
+      out_entries(pos++) = entries(k);
+    }
+    if (!has_diagonal) out_entries(pos) = i;
+  }
+};
+
+// y(i) += alpha * (row i of A) * x, and y(j) += alpha * a_ij * x(i) for the
+// off diagonal entries j of row i. The rows of a color share no column with
+// each other, including their diagonals, so the scatter needs no atomics.
+template<class AMatrix,
+         class XVector,
+         class YVector,
+         class RowsType>
+struct SPMV_Symmetric_Color_Functor {
+  typedef typename AMatrix::non_const_ordinal_type     ordinal_type;
+  typedef typename AMatrix::non_const_size_type        size_type;
+  typedef typename AMatrix::non_const_value_type       value_type;
+  typedef typename YVector::non_const_value_type       y_value_type;
+
+  const y_value_type alpha;
+  AMatrix  m_A;
+  XVector m_x;
+  YVector m_y;
+  RowsType m_rows;
+  const ordinal_type color_begin;
+
+  SPMV_Symmetric_Color_Functor (const y_value_type alpha_,
+                                const AMatrix m_A_,
+                                const XVector m_x_,
+                                const YVector m_y_,
+                                const RowsType m_rows_,
+                                const ordinal_type color_begin_) :
+    alpha (alpha_), m_A (m_A_), m_x (m_x_), m_y (m_y_),
+    m_rows (m_rows_), color_begin (color_begin_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const ordinal_type& ii) const
+  {
+    const ordinal_type i = m_rows(color_begin + ii);
+    const y_value_type alpha_xi = alpha * m_x(i);
+    y_value_type sum = Kokkos::Details::ArithTraits<y_value_type>::zero ();
+    for (size_type k = m_A.graph.row_map(i); k < m_A.graph.row_map(i + 1); ++k) {
+      const ordinal_type j = m_A.graph.entries(k);
+      const value_type val = m_A.values(k);
+      sum += val * m_x(j);
+      if (j != i) {
+        m_y(j) += val * alpha_xi;
+      }
+    }
+    m_y(i) += alpha * sum;
+  }
+};
+
+/// \brief Colors the rows of A so that two rows of a color share no column:
+///   a distance 2 coloring of the pattern of A plus its diagonal, through the
+///   distance 1 coloring of its product with its transpose.
+template<class HandleType, class AMatrix>
+void
+spmv_symmetric_inspect (HandleType& handle, const AMatrix& A)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename execution_space::memory_space memory_space;
+  typedef typename AMatrix::non_const_size_type size_type;
+  typedef typename AMatrix::non_const_ordinal_type ordinal_type;
+  typedef typename AMatrix::non_const_value_type scalar_type;
+  typedef typename HandleType::nnz_lno_view_t rows_view_t;
+  typedef typename HandleType::nnz_lno_host_view_t rows_host_view_t;
+  typedef Kokkos::View<size_type *, execution_space> row_map_view_t;
+  typedef Kokkos::View<ordinal_type *, execution_space> entries_view_t;
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, ordinal_type, scalar_type, execution_space, memory_space, memory_space> kernel_handle_t;
+
+  const ordinal_type numRows = A.numRows ();
+  if (numRows <= 0) {
+    handle.set_symmetric_plan (A.graph.row_map.data (), numRows, A.nnz (), rows_host_view_t ("color_xadj", 1), rows_view_t ());
+    return;
+  }
+
+  row_map_view_t g_row_map ("symmetric spmv graph row_map", numRows + 1);
+  Kokkos::parallel_for ("KokkosSparse::spmv_symmetric_inspect::count",
+      Kokkos::RangePolicy<execution_space> (0, numRows),
+      SymmetricDiagonalCountFunctor<typename AMatrix::row_map_type, typename AMatrix::index_type, row_map_view_t>
+        (A.graph.row_map, A.graph.entries, g_row_map));
+  KokkosKernels::Impl::exclusive_parallel_prefix_sum<row_map_view_t, execution_space> (numRows + 1, g_row_map);
+  size_type g_nnz = 0;
+  Kokkos::deep_copy (g_nnz, Kokkos::subview (g_row_map, numRows));
+  entries_view_t g_entries (Kokkos::ViewAllocateWithoutInitializing ("symmetric spmv graph entries"), g_nnz);
+  Kokkos::parallel_for ("KokkosSparse::spmv_symmetric_inspect::fill",
+      Kokkos::RangePolicy<execution_space> (0, numRows),
+      SymmetricDiagonalFillFunctor<typename AMatrix::row_map_type, typename AMatrix::index_type, row_map_view_t, entries_view_t>
+        (A.graph.row_map, A.graph.entries, g_row_map, g_entries));
+
+  row_map_view_t gt_row_map ("symmetric spmv graph transpose row_map", numRows + 1);
+  entries_view_t gt_entries (Kokkos::ViewAllocateWithoutInitializing ("symmetric spmv graph transpose entries"), g_nnz);
+  KokkosKernels::Impl::kk_transpose_graph
+    <row_map_view_t, entries_view_t, row_map_view_t, entries_view_t, row_map_view_t, execution_space>
+    (numRows, numRows, g_row_map, g_entries, gt_row_map, gt_entries);
+
+  kernel_handle_t kh;
+  kh.create_graph_coloring_handle (KokkosGraph::COLORING_D2_MATRIX_SQUARED);
+  KokkosGraph::Experimental::graph_color_d2 (&kh, numRows, numRows, g_row_map, g_entries, gt_row_map, gt_entries);
+  rows_view_t color_rows = kh.get_graph_coloring_handle ()->get_color_set_adj ();
+  rows_host_view_t h_color_xadj = kh.get_graph_coloring_handle ()->get_host_color_set_xadj ();
+  kh.destroy_graph_coloring_handle ();
+  handle.set_symmetric_plan (A.graph.row_map.data (), numRows, A.nnz (), h_color_xadj, color_rows);
+}
+
+/// \brief y = beta*y + alpha*A*x, where A stores each off diagonal pair of a
+///   symmetric matrix once, with the row coloring of handle.
+template<class HandleType,
+         class AMatrix,
+         class XVector,
+         class YVector>
+void
+spmv_symmetric (HandleType& handle,
+                typename YVector::const_value_type& alpha,
+                const AMatrix& A,
+                const XVector& x,
+                typename YVector::const_value_type& beta,
+                const YVector& y)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename AMatrix::non_const_ordinal_type ordinal_type;
+  typedef typename YVector::non_const_value_type y_value_type;
+  typedef Kokkos::Details::ArithTraits<y_value_type> ATY;
+  typedef typename HandleType::nnz_lno_view_t rows_view_t;
+
+  if (!handle.is_symmetric_plan_for (A.graph.row_map.data (), A.numRows (), A.nnz ())) {
+    spmv_symmetric_inspect (handle, A);
+  }
+
+  if (beta == ATY::zero ()) {
+    Kokkos::deep_copy (y, ATY::zero ());
+  } else if (beta != ATY::one ()) {
+    KokkosBlas::scal (y, beta, y);
+  }
+  if (alpha == ATY::zero () || A.numRows () <= 0) {
+    return;
+  }
+
+  const typename HandleType::nnz_lno_host_view_t color_xadj = handle.get_symmetric_color_xadj ();
+  const rows_view_t color_rows = handle.get_symmetric_color_rows ();
+  const ordinal_type numColors = static_cast<ordinal_type> (color_xadj.extent (0)) - 1;
+  for (ordinal_type c = 0; c < numColors; ++c) {
+    const ordinal_type color_begin = color_xadj(c);
+    const ordinal_type color_end = color_xadj(c + 1);
+    if (color_begin == color_end) continue;
+    Kokkos::parallel_for ("KokkosSparse::spmv<Symmetric>",
+        Kokkos::RangePolicy<execution_space> (0, color_end - color_begin),
+        SPMV_Symmetric_Color_Functor<AMatrix,XVector,YVector,rows_view_t>
+          (alpha, A, x, y, color_rows, color_begin));
+  }
+}
+
+}
+}
+}
+
+#endif
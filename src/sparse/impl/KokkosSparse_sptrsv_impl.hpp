@@ -0,0 +1,1063 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSSPARSE_IMPL_SPTRSV_HPP_
+#define KOKKOSSPARSE_IMPL_SPTRSV_HPP_
+
+/// \file KokkosSparse_sptrsv_impl.hpp
+/// \brief Implementation(s) of the level scheduled sparse triangular solve.
+
+#include <KokkosKernels_config.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include "KokkosKernels_SimpleUtils.hpp"
+#include "KokkosKernels_ExecSpaceUtils.hpp"
+#include "KokkosSparse_sptrsv_handle.hpp"
+#include "KokkosSparse_block_dag_impl.hpp"
+#include "KokkosBatched_Gemv_Team_Internal.hpp"
+#include "KokkosBatched_Trsv_Team_Internal.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+namespace KokkosSparse {
+namespace Impl {
+
+/**
+ * \brief Symbolic phase of the supernodal triangular solve. Uses the
+ * supernode partition given by the user, or detects the supernodes as the
+ * runs of consecutive rows with nested sparsity patterns (row r+1 is row r
+ * plus the diagonal for lower, row r is row r+1 plus the diagonal for
+ * upper triangular matrices, which requires sorted rows). Then computes
+ * the dense block layout of each supernode, the position of each matrix
+ * entry in the blocks, and the level sets of the supernodes.
+ */
+template <class TriSolveHandle, class HostRowMapType, class HostEntriesType>
+void tri_solve_supernodal_symbolic(
+    TriSolveHandle &thandle,
+    const HostRowMapType &row_map, const HostEntriesType &entries)
+{
+  typedef typename TriSolveHandle::size_type size_type;
+  typedef typename TriSolveHandle::nnz_lno_t nnz_lno_t;
+  typedef typename TriSolveHandle::nnz_lno_view_t nnz_lno_view_t;
+  typedef typename TriSolveHandle::nnz_lno_view_host_t nnz_lno_view_host_t;
+  typedef typename TriSolveHandle::nnz_row_view_t nnz_row_view_t;
+  typedef typename TriSolveHandle::nnz_row_view_host_t nnz_row_view_host_t;
+  typedef typename TriSolveHandle::nnz_scalar_view_t nnz_scalar_view_t;
+
+  const nnz_lno_t nrows = thandle.get_nrows();
+  const bool lower_tri = thandle.is_lower_tri();
+  const size_type nnz = nrows > 0 ? size_type(row_map(nrows)) : 0;
+
+  //supernode partition
+  std::vector<nnz_lno_t> sptr(1, 0);
+  nnz_lno_view_host_t user_supernode_ptr = thandle.get_user_supernode_ptr();
+  if (user_supernode_ptr.extent(0) > 1){
+    for (size_t k = 1; k < user_supernode_ptr.extent(0); ++k){
+      if (user_supernode_ptr(k) <= user_supernode_ptr(k - 1)){
+        throw std::runtime_error("sptrsv: supernode partition must be strictly increasing");
+      }
+      sptr.push_back(user_supernode_ptr(k));
+    }
+    if (user_supernode_ptr(0) != 0 || sptr.back() != nrows){
+      throw std::runtime_error("sptrsv: supernode partition must start at 0 and end at nrows");
+    }
+  }
+  else {
+    for (nnz_lno_t r = 0; r + 1 < nrows; ++r){
+      const size_type rbegin = row_map(r), rlen = row_map(r + 1) - rbegin;
+      const size_type nbegin = row_map(r + 1), nlen = row_map(r + 2) - nbegin;
+      bool nested = false;
+      if (lower_tri){
+        nested = nlen == rlen + 1 && rlen > 0 &&
+            entries(rbegin + rlen - 1) == r && entries(nbegin + nlen - 1) == r + 1;
+        for (size_type j = 0; nested && j < rlen; ++j){
+          nested = entries(rbegin + j) == entries(nbegin + j);
+        }
+      }
+      else {
+        nested = rlen == nlen + 1 && nlen > 0 &&
+            entries(rbegin) == r && entries(nbegin) == r + 1;
+        for (size_type j = 0; nested && j < nlen; ++j){
+          nested = entries(rbegin + 1 + j) == entries(nbegin + j);
+        }
+      }
+      if (!nested) sptr.push_back(r + 1);
+    }
+    if (nrows > 0) sptr.push_back(nrows);
+  }
+  const nnz_lno_t nsupernodes = sptr.size() - 1;
+
+  //off-diagonal block columns of each supernode and its block layout.
+  std::vector<nnz_lno_t> row_supernode(nrows);
+  std::vector<size_type> cols_ptr(nsupernodes + 1, 0);
+  std::vector<size_type> block_ptr(nsupernodes + 1, 0);
+  std::vector<nnz_lno_t> cols;
+  for (nnz_lno_t k = 0; k < nsupernodes; ++k){
+    const nnz_lno_t sbegin = sptr[k], send = sptr[k + 1];
+    const size_type cbegin = cols.size();
+    for (nnz_lno_t r = sbegin; r < send; ++r){
+      row_supernode[r] = k;
+      for (size_type j = row_map(r); j < row_map(r + 1); ++j){
+        if (entries(j) < sbegin || entries(j) >= send) cols.push_back(entries(j));
+      }
+    }
+    std::sort(cols.begin() + cbegin, cols.end());
+    cols.erase(std::unique(cols.begin() + cbegin, cols.end()), cols.end());
+    cols_ptr[k + 1] = cols.size();
+    const size_type width = send - sbegin;
+    block_ptr[k + 1] = block_ptr[k] + width * (width + cols_ptr[k + 1] - cols_ptr[k]);
+  }
+
+  //position of each entry in the blocks. The last nrows entries hold
+  //the position of the diagonal of each row, which is set to one for
+  //rows without a diagonal entry.
+  nnz_row_view_t dnnz_block_offsets("nnz_block_offsets", nnz + nrows);
+  nnz_row_view_host_t nnz_block_offsets = Kokkos::create_mirror_view(dnnz_block_offsets);
+  for (nnz_lno_t k = 0; k < nsupernodes; ++k){
+    const nnz_lno_t sbegin = sptr[k], send = sptr[k + 1];
+    const nnz_lno_t width = send - sbegin;
+    const nnz_lno_t ncols = cols_ptr[k + 1] - cols_ptr[k];
+    const size_type ld = width + ncols;
+    //lower blocks are stored as [offdiag | diag], upper as [diag | offdiag]
+    const size_type diag_shift = lower_tri ? ncols : 0;
+    const size_type offdiag_shift = lower_tri ? 0 : width;
+    for (nnz_lno_t r = sbegin; r < send; ++r){
+      const size_type row_base = block_ptr[k] + (r - sbegin) * ld;
+      for (size_type j = row_map(r); j < row_map(r + 1); ++j){
+        const nnz_lno_t c = entries(j);
+        if (c >= sbegin && c < send){
+          nnz_block_offsets(j) = row_base + diag_shift + (c - sbegin);
+        }
+        else {
+          const size_type pos = std::lower_bound(cols.begin() + cols_ptr[k], cols.begin() + cols_ptr[k + 1], c) - (cols.begin() + cols_ptr[k]);
+          nnz_block_offsets(j) = row_base + offdiag_shift + pos;
+        }
+      }
+      nnz_block_offsets(nnz + r) = row_base + diag_shift + (r - sbegin);
+    }
+  }
+
+  //level sets of the supernodes.
+  std::vector<nnz_lno_t> slevel(nsupernodes, 0);
+  nnz_lno_t nslevels = 0;
+  for (nnz_lno_t kk = 0; kk < nsupernodes; ++kk){
+    const nnz_lno_t k = lower_tri ? kk : nsupernodes - 1 - kk;
+    nnz_lno_t level = 0;
+    for (size_type j = cols_ptr[k]; j < cols_ptr[k + 1]; ++j){
+      const nnz_lno_t dep = row_supernode[cols[j]];
+      if (level <= slevel[dep]) level = slevel[dep] + 1;
+    }
+    slevel[k] = level;
+    if (nslevels <= level) nslevels = level + 1;
+  }
+  nnz_lno_view_host_t slevel_ptr("supernode_level_ptr", nslevels + 1);
+  for (nnz_lno_t k = 0; k < nsupernodes; ++k) ++slevel_ptr(slevel[k] + 1);
+  for (nnz_lno_t l = 0; l < nslevels; ++l) slevel_ptr(l + 1) += slevel_ptr(l);
+  nnz_lno_view_t dsgbl("supernodes_grouped_by_level", nsupernodes);
+  nnz_lno_view_host_t sgbl = Kokkos::create_mirror_view(dsgbl);
+  {
+    std::vector<nnz_lno_t> level_fill(slevel_ptr.data(), slevel_ptr.data() + nslevels);
+    for (nnz_lno_t k = 0; k < nsupernodes; ++k) sgbl(level_fill[slevel[k]]++) = k;
+  }
+
+  nnz_lno_view_t dsupernode_ptr("supernode_ptr", nsupernodes + 1);
+  nnz_row_view_t dcols_ptr("supernode_cols_ptr", nsupernodes + 1);
+  nnz_lno_view_t dcols("supernode_cols", cols.size());
+  nnz_row_view_t dblock_ptr("supernode_block_ptr", nsupernodes + 1);
+  {
+    nnz_lno_view_host_t hsupernode_ptr = Kokkos::create_mirror_view(dsupernode_ptr);
+    nnz_row_view_host_t hcols_ptr = Kokkos::create_mirror_view(dcols_ptr);
+    nnz_lno_view_host_t hcols = Kokkos::create_mirror_view(dcols);
+    nnz_row_view_host_t hblock_ptr = Kokkos::create_mirror_view(dblock_ptr);
+    for (nnz_lno_t k = 0; k <= nsupernodes; ++k){
+      hsupernode_ptr(k) = sptr[k];
+      hcols_ptr(k) = cols_ptr[k];
+      hblock_ptr(k) = block_ptr[k];
+    }
+    for (size_t j = 0; j < cols.size(); ++j) hcols(j) = cols[j];
+    Kokkos::deep_copy(dsupernode_ptr, hsupernode_ptr);
+    Kokkos::deep_copy(dcols_ptr, hcols_ptr);
+    Kokkos::deep_copy(dcols, hcols);
+    Kokkos::deep_copy(dblock_ptr, hblock_ptr);
+  }
+  Kokkos::deep_copy(dnnz_block_offsets, nnz_block_offsets);
+  Kokkos::deep_copy(dsgbl, sgbl);
+
+  thandle.set_supernode_structure(nsupernodes, dsupernode_ptr, dcols_ptr, dcols, dblock_ptr, dnnz_block_offsets,
+      nnz_scalar_view_t("supernode_block_values", block_ptr[nsupernodes]),
+      nnz_scalar_view_t("supernode_work", cols.size()));
+  thandle.set_supernode_levels(nslevels, dsgbl, slevel_ptr);
+}
+
+/**
+ * \brief Symbolic phase of the level scheduled triangular solve. Computes
+ * the level (depth in the dependency DAG) of each row, groups the rows by
+ * level and finds the diagonal offset of each row. The level sets are
+ * computed sequentially on the host, since it is a single pass over the
+ * graph and it is amortized over many solves.
+ * Rows without a diagonal entry are treated as having a unit diagonal.
+ */
+template <class TriSolveHandle, class RowMapType, class EntriesType>
+void tri_solve_symbolic(TriSolveHandle &thandle, const RowMapType drow_map, const EntriesType dentries)
+{
+  typedef typename TriSolveHandle::size_type size_type;
+  typedef typename TriSolveHandle::nnz_lno_t nnz_lno_t;
+  typedef typename TriSolveHandle::nnz_lno_view_t nnz_lno_view_t;
+  typedef typename TriSolveHandle::nnz_lno_view_host_t nnz_lno_view_host_t;
+  typedef typename TriSolveHandle::nnz_row_view_t nnz_row_view_t;
+
+  const nnz_lno_t nrows = drow_map.extent(0) ? drow_map.extent(0) - 1 : 0;
+  thandle.new_init_handle(nrows);
+
+  typename RowMapType::HostMirror row_map = Kokkos::create_mirror_view(drow_map);
+  Kokkos::deep_copy(row_map, drow_map);
+  typename EntriesType::HostMirror entries = Kokkos::create_mirror_view(dentries);
+  Kokkos::deep_copy(entries, dentries);
+
+  nnz_lno_view_t dlevel_list = thandle.get_level_list();
+  nnz_lno_view_host_t level_list = Kokkos::create_mirror_view(dlevel_list);
+  nnz_lno_view_t dnodes_grouped_by_level = thandle.get_nodes_grouped_by_level();
+  nnz_lno_view_host_t nodes_grouped_by_level = Kokkos::create_mirror_view(dnodes_grouped_by_level);
+  nnz_row_view_t ddiagonal_offsets = thandle.get_diagonal_offsets();
+  typename nnz_row_view_t::HostMirror diagonal_offsets = Kokkos::create_mirror_view(ddiagonal_offsets);
+
+  const bool lower_tri = thandle.is_lower_tri();
+  nnz_lno_t nlevels = 0;
+  for (nnz_lno_t ii = 0; ii < nrows; ++ii){
+    //lower triangular rows depend on the rows before them,
+    //upper triangular rows on the rows after them.
+    const nnz_lno_t rowid = lower_tri ? ii : nrows - 1 - ii;
+    const size_type row_begin = row_map(rowid);
+    const size_type row_end = row_map(rowid + 1);
+    nnz_lno_t level = 0;
+    diagonal_offsets(rowid) = row_end;
+    for (size_type k = row_begin; k < row_end; ++k){
+      const nnz_lno_t colid = entries(k);
+      if (colid == rowid){
+        diagonal_offsets(rowid) = k;
+      }
+      else if (level <= level_list(colid)){
+        level = level_list(colid) + 1;
+      }
+    }
+    level_list(rowid) = level;
+    if (nlevels <= level) nlevels = level + 1;
+  }
+
+  //group the rows by level with a counting sort.
+  nnz_lno_view_host_t level_ptr("level_ptr", nlevels + 1);
+  for (nnz_lno_t i = 0; i < nrows; ++i){
+    ++level_ptr(level_list(i) + 1);
+  }
+  nnz_lno_t max_level_size = 0;
+  for (nnz_lno_t l = 0; l < nlevels; ++l){
+    if (max_level_size < level_ptr(l + 1)) max_level_size = level_ptr(l + 1);
+    level_ptr(l + 1) += level_ptr(l);
+  }
+  {
+    nnz_lno_view_host_t level_fill("level_fill", nlevels);
+    for (nnz_lno_t l = 0; l < nlevels; ++l) level_fill(l) = level_ptr(l);
+    for (nnz_lno_t i = 0; i < nrows; ++i){
+      nodes_grouped_by_level(level_fill(level_list(i))++) = i;
+    }
+  }
+
+  Kokkos::deep_copy(dlevel_list, level_list);
+  Kokkos::deep_copy(dnodes_grouped_by_level, nodes_grouped_by_level);
+  Kokkos::deep_copy(ddiagonal_offsets, diagonal_offsets);
+
+  nnz_lno_view_t dlevel_ptr("dlevel_ptr", nlevels + 1);
+  Kokkos::deep_copy(dlevel_ptr, level_ptr);
+
+  //merge runs of consecutive levels with at most chain_threshold rows
+  //into chains, so that they can be solved by a single kernel launch.
+  //Larger levels form a chain of their own.
+  if (thandle.get_algorithm_type() == SPTRSV_LVLSCHD_CHAIN){
+    const nnz_lno_t chain_threshold = thandle.get_chain_threshold();
+    nnz_lno_view_host_t chain_ptr("chain_ptr", nlevels + 1);
+    nnz_lno_t nchains = 0;
+    nnz_lno_t lvl = 0;
+    while (lvl < nlevels){
+      chain_ptr(nchains++) = lvl;
+      if (level_ptr(lvl + 1) - level_ptr(lvl) > chain_threshold){
+        ++lvl;
+      }
+      else {
+        while (lvl < nlevels && level_ptr(lvl + 1) - level_ptr(lvl) <= chain_threshold) ++lvl;
+      }
+    }
+    chain_ptr(nchains) = nlevels;
+    thandle.set_chain_ptr(chain_ptr);
+    thandle.set_num_chains(nchains);
+  }
+
+  if (thandle.get_algorithm_type() == SPTRSV_SUPERNODAL){
+    tri_solve_supernodal_symbolic(thandle, row_map, entries);
+  }
+
+  //block DAG of the task based solve, from the pattern of the rows.
+  if (thandle.get_algorithm_type() == SPTRSV_TASK){
+    typename TriSolveHandle::nnz_row_view_host_t task_dep_ptr;
+    nnz_lno_view_host_t task_deps;
+    const nnz_lno_t ntask_blocks = build_block_dag(nrows, thandle.get_task_block_size(),
+        row_map, entries, task_dep_ptr, task_deps);
+    thandle.set_task_dag(ntask_blocks, task_dep_ptr, task_deps);
+  }
+
+  thandle.set_level_ptr(level_ptr);
+  thandle.set_level_ptr_device(dlevel_ptr);
+  thandle.set_num_levels(nlevels);
+  thandle.set_max_level_size(max_level_size);
+  thandle.set_symbolic_complete();
+}
+
+/**
+ * \brief Solves the rows of a single level, one thread per row.
+ */
+template <class RowMapType, class EntriesType, class ValuesType,
+          class LHSType, class RHSType, class NGBLType, class DiagType>
+struct TriLvlSchedRPSolverFunctor
+{
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef typename EntriesType::non_const_value_type lno_t;
+  typedef typename ValuesType::non_const_value_type scalar_t;
+
+  RowMapType row_map;
+  EntriesType entries;
+  ValuesType values;
+  LHSType lhs;
+  RHSType rhs;
+  NGBLType nodes_grouped_by_level;
+  DiagType diagonal_offsets;
+
+  TriLvlSchedRPSolverFunctor(
+      const RowMapType &row_map_, const EntriesType &entries_, const ValuesType &values_,
+      LHSType &lhs_, const RHSType &rhs_,
+      const NGBLType &nodes_grouped_by_level_, const DiagType &diagonal_offsets_):
+    row_map(row_map_), entries(entries_), values(values_), lhs(lhs_), rhs(rhs_),
+    nodes_grouped_by_level(nodes_grouped_by_level_), diagonal_offsets(diagonal_offsets_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t i) const {
+    const lno_t rowid = nodes_grouped_by_level(i);
+    const size_type soffset = row_map(rowid);
+    const size_type eoffset = row_map(rowid + 1);
+    const size_type doffset = diagonal_offsets(rowid);
+
+    scalar_t diff = rhs(rowid);
+    for (size_type ptr = soffset; ptr < eoffset; ++ptr){
+      if (ptr != doffset){
+        diff -= values(ptr) * lhs(entries(ptr));
+      }
+    }
+    lhs(rowid) = (doffset == eoffset) ? diff : diff / values(doffset);
+  }
+};
+
+/**
+ * \brief Solves the rows of a single level, team_work_size rows per team,
+ * and the vector lanes of a thread work on a single row.
+ */
+template <class TeamPolicy, class RowMapType, class EntriesType, class ValuesType,
+          class LHSType, class RHSType, class NGBLType, class DiagType>
+struct TriLvlSchedTPSolverFunctor
+{
+  typedef typename TeamPolicy::member_type team_member_t;
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef typename EntriesType::non_const_value_type lno_t;
+  typedef typename ValuesType::non_const_value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> STS;
+
+  RowMapType row_map;
+  EntriesType entries;
+  ValuesType values;
+  LHSType lhs;
+  RHSType rhs;
+  NGBLType nodes_grouped_by_level;
+  DiagType diagonal_offsets;
+  lno_t node_begin, node_end, team_work_size;
+
+  TriLvlSchedTPSolverFunctor(
+      const RowMapType &row_map_, const EntriesType &entries_, const ValuesType &values_,
+      LHSType &lhs_, const RHSType &rhs_,
+      const NGBLType &nodes_grouped_by_level_, const DiagType &diagonal_offsets_,
+      lno_t node_begin_, lno_t node_end_, lno_t team_work_size_):
+    row_map(row_map_), entries(entries_), values(values_), lhs(lhs_), rhs(rhs_),
+    nodes_grouped_by_level(nodes_grouped_by_level_), diagonal_offsets(diagonal_offsets_),
+    node_begin(node_begin_), node_end(node_end_), team_work_size(team_work_size_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const team_member_t &teamMember) const {
+    const lno_t team_node_begin = node_begin + teamMember.league_rank() * team_work_size;
+    const lno_t team_node_end = KOKKOSKERNELS_MACRO_MIN(team_node_begin + team_work_size, node_end);
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, team_node_begin, team_node_end), [&] (const lno_t i) {
+      const lno_t rowid = nodes_grouped_by_level(i);
+      const size_type soffset = row_map(rowid);
+      const size_type eoffset = row_map(rowid + 1);
+      const size_type doffset = diagonal_offsets(rowid);
+
+      scalar_t diff = STS::zero();
+      Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(teamMember, eoffset - soffset), [&] (const size_type k, scalar_t &tdiff) {
+        const size_type ptr = soffset + k;
+        if (ptr != doffset){
+          tdiff += values(ptr) * lhs(entries(ptr));
+        }
+      }, diff);
+
+      Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+        lhs(rowid) = (doffset == eoffset) ? rhs(rowid) - diff : (rhs(rowid) - diff) / values(doffset);
+      });
+    });
+  }
+};
+
+/**
+ * \brief Solves all rows in order with a single thread. Used when the
+ * dependency DAG has (nearly) as many levels as rows, and for debugging.
+ */
+template <class RowMapType, class EntriesType, class ValuesType,
+          class LHSType, class RHSType, class DiagType>
+struct TriSequentialSolverFunctor
+{
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef typename EntriesType::non_const_value_type lno_t;
+  typedef typename ValuesType::non_const_value_type scalar_t;
+
+  RowMapType row_map;
+  EntriesType entries;
+  ValuesType values;
+  LHSType lhs;
+  RHSType rhs;
+  DiagType diagonal_offsets;
+  lno_t nrows;
+  bool lower_tri;
+
+  TriSequentialSolverFunctor(
+      const RowMapType &row_map_, const EntriesType &entries_, const ValuesType &values_,
+      LHSType &lhs_, const RHSType &rhs_, const DiagType &diagonal_offsets_,
+      lno_t nrows_, bool lower_tri_):
+    row_map(row_map_), entries(entries_), values(values_), lhs(lhs_), rhs(rhs_),
+    diagonal_offsets(diagonal_offsets_), nrows(nrows_), lower_tri(lower_tri_) {}
+
+  //solves row rowid, once the rows it depends on are solved.
+  KOKKOS_INLINE_FUNCTION
+  void apply_row(const lno_t rowid) const {
+    const size_type soffset = row_map(rowid);
+    const size_type eoffset = row_map(rowid + 1);
+    const size_type doffset = diagonal_offsets(rowid);
+
+    scalar_t diff = rhs(rowid);
+    for (size_type ptr = soffset; ptr < eoffset; ++ptr){
+      if (ptr != doffset){
+        diff -= values(ptr) * lhs(entries(ptr));
+      }
+    }
+    lhs(rowid) = (doffset == eoffset) ? diff : diff / values(doffset);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t) const {
+    for (lno_t i = 0; i < nrows; ++i){
+      apply_row(lower_tri ? i : nrows - 1 - i);
+    }
+  }
+};
+
+/**
+ * \brief Solves a chain of consecutive levels [lvl_begin, lvl_end) with a
+ * single team, with a team barrier between the levels.
+ */
+template <class TeamPolicy, class RowMapType, class EntriesType, class ValuesType,
+          class LHSType, class RHSType, class NGBLType, class DiagType>
+struct TriLvlSchedTPChainSolverFunctor
+{
+  typedef typename TeamPolicy::member_type team_member_t;
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef typename EntriesType::non_const_value_type lno_t;
+  typedef typename ValuesType::non_const_value_type scalar_t;
+
+  RowMapType row_map;
+  EntriesType entries;
+  ValuesType values;
+  LHSType lhs;
+  RHSType rhs;
+  NGBLType nodes_grouped_by_level;
+  NGBLType level_ptr;
+  DiagType diagonal_offsets;
+  lno_t lvl_begin, lvl_end;
+
+  TriLvlSchedTPChainSolverFunctor(
+      const RowMapType &row_map_, const EntriesType &entries_, const ValuesType &values_,
+      LHSType &lhs_, const RHSType &rhs_,
+      const NGBLType &nodes_grouped_by_level_, const NGBLType &level_ptr_,
+      const DiagType &diagonal_offsets_, lno_t lvl_begin_, lno_t lvl_end_):
+    row_map(row_map_), entries(entries_), values(values_), lhs(lhs_), rhs(rhs_),
+    nodes_grouped_by_level(nodes_grouped_by_level_), level_ptr(level_ptr_),
+    diagonal_offsets(diagonal_offsets_), lvl_begin(lvl_begin_), lvl_end(lvl_end_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const team_member_t &teamMember) const {
+    for (lno_t lvl = lvl_begin; lvl < lvl_end; ++lvl){
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, level_ptr(lvl), level_ptr(lvl + 1)), [&] (const lno_t i) {
+        const lno_t rowid = nodes_grouped_by_level(i);
+        const size_type soffset = row_map(rowid);
+        const size_type eoffset = row_map(rowid + 1);
+        const size_type doffset = diagonal_offsets(rowid);
+
+        scalar_t diff = Kokkos::Details::ArithTraits<scalar_t>::zero();
+        Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(teamMember, eoffset - soffset), [&] (const size_type k, scalar_t &tdiff) {
+          const size_type ptr = soffset + k;
+          if (ptr != doffset){
+            tdiff += values(ptr) * lhs(entries(ptr));
+          }
+        }, diff);
+
+        Kokkos::single(Kokkos::PerThread(teamMember), [&] () {
+          lhs(rowid) = (doffset == eoffset) ? rhs(rowid) - diff : (rhs(rowid) - diff) / values(doffset);
+        });
+      });
+      teamMember.team_barrier();
+    }
+  }
+};
+
+/**
+ * \brief Copies the values of the matrix into the dense supernodal blocks.
+ */
+template <class RowMapType, class ValuesType, class DiagType, class BlockValuesType>
+struct TriSupernodalPackFunctor
+{
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef typename BlockValuesType::non_const_value_type scalar_t;
+
+  RowMapType row_map;
+  ValuesType values;
+  DiagType diagonal_offsets;
+  DiagType nnz_block_offsets;
+  BlockValuesType block_values;
+  size_type nnz;
+
+  TriSupernodalPackFunctor(
+      const RowMapType &row_map_, const ValuesType &values_, const DiagType &diagonal_offsets_,
+      const DiagType &nnz_block_offsets_, const BlockValuesType &block_values_, size_type nnz_):
+    row_map(row_map_), values(values_), diagonal_offsets(diagonal_offsets_),
+    nnz_block_offsets(nnz_block_offsets_), block_values(block_values_), nnz(nnz_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_type row) const {
+    const size_type eoffset = row_map(row + 1);
+    for (size_type ptr = row_map(row); ptr < eoffset; ++ptr){
+      block_values(nnz_block_offsets(ptr)) = values(ptr);
+    }
+    if (diagonal_offsets(row) == eoffset){
+      block_values(nnz_block_offsets(nnz + row)) = Kokkos::Details::ArithTraits<scalar_t>::one();
+    }
+  }
+};
+
+/**
+ * \brief Solves the supernodes of a single level, one team per supernode.
+ * The off-diagonal block update is a dense team gemv with the gathered
+ * solution entries, followed by a dense team trsv with the diagonal block.
+ */
+template <class TeamPolicy, class LHSType, class RHSType, class LnoViewType, class SizeViewType, class BlockValuesType>
+struct TriSupernodalSolverFunctor
+{
+  typedef typename TeamPolicy::member_type team_member_t;
+  typedef typename SizeViewType::non_const_value_type size_type;
+  typedef typename LnoViewType::non_const_value_type lno_t;
+  typedef typename BlockValuesType::non_const_value_type scalar_t;
+
+  static_assert(std::is_same<typename LHSType::non_const_value_type, scalar_t>::value,
+      "sptrsv: SPTRSV_SUPERNODAL requires the scalar type of x to match the scalar type of A");
+
+  LHSType lhs;
+  RHSType rhs;
+  LnoViewType supernode_ptr;
+  SizeViewType supernode_cols_ptr;
+  LnoViewType supernode_cols;
+  SizeViewType supernode_block_ptr;
+  BlockValuesType block_values;
+  BlockValuesType work;
+  LnoViewType supernodes_grouped_by_level;
+  lno_t node_begin;
+  bool lower_tri;
+
+  TriSupernodalSolverFunctor(
+      LHSType &lhs_, const RHSType &rhs_,
+      const LnoViewType &supernode_ptr_, const SizeViewType &supernode_cols_ptr_,
+      const LnoViewType &supernode_cols_, const SizeViewType &supernode_block_ptr_,
+      const BlockValuesType &block_values_, const BlockValuesType &work_,
+      const LnoViewType &supernodes_grouped_by_level_, lno_t node_begin_, bool lower_tri_):
+    lhs(lhs_), rhs(rhs_), supernode_ptr(supernode_ptr_), supernode_cols_ptr(supernode_cols_ptr_),
+    supernode_cols(supernode_cols_), supernode_block_ptr(supernode_block_ptr_),
+    block_values(block_values_), work(work_),
+    supernodes_grouped_by_level(supernodes_grouped_by_level_), node_begin(node_begin_), lower_tri(lower_tri_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const team_member_t &teamMember) const {
+    typedef Kokkos::Details::ArithTraits<scalar_t> STS;
+
+    const lno_t snode = supernodes_grouped_by_level(node_begin + teamMember.league_rank());
+    const lno_t row_begin = supernode_ptr(snode);
+    const int width = supernode_ptr(snode + 1) - row_begin;
+    const size_type cbegin = supernode_cols_ptr(snode);
+    const int ncols = supernode_cols_ptr(snode + 1) - cbegin;
+    const int ld = width + ncols;
+    const int xs0 = lhs.stride_0();
+
+    scalar_t *xgather = work.data() + cbegin;
+    scalar_t *xblock = lhs.data() + row_begin * xs0;
+    const scalar_t *block = block_values.data() + supernode_block_ptr(snode);
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, ncols), [&] (const int j) {
+      xgather[j] = lhs(supernode_cols(cbegin + j));
+    });
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, width), [&] (const int j) {
+      lhs(row_begin + j) = rhs(row_begin + j);
+    });
+    teamMember.team_barrier();
+
+    if (lower_tri){
+      KokkosBatched::Experimental::TeamGemvInternal<KokkosBatched::Experimental::Algo::Gemv::Unblocked>::invoke(
+          teamMember, width, ncols, -STS::one(), block, ld, 1, xgather, 1, STS::one(), xblock, xs0);
+      teamMember.team_barrier();
+      KokkosBatched::Experimental::TeamTrsvInternalLower<KokkosBatched::Experimental::Algo::Trsv::Unblocked>::invoke(
+          teamMember, false, width, STS::one(), block + ncols, ld, 1, xblock, xs0);
+    }
+    else {
+      KokkosBatched::Experimental::TeamGemvInternal<KokkosBatched::Experimental::Algo::Gemv::Unblocked>::invoke(
+          teamMember, width, ncols, -STS::one(), block + width, ld, 1, xgather, 1, STS::one(), xblock, xs0);
+      teamMember.team_barrier();
+      KokkosBatched::Experimental::TeamTrsvInternalUpper<KokkosBatched::Experimental::Algo::Trsv::Unblocked>::invoke(
+          teamMember, false, width, STS::one(), block, ld, 1, xblock, xs0);
+    }
+  }
+};
+
+/**
+ * \brief Solves the rows of a single level for multiple right hand sides,
+ * team_work_size rows per team. The vector lanes of a thread work on the
+ * columns of a single row, so that each matrix entry is read once for
+ * all right hand sides.
+ */
+template <class TeamPolicy, class RowMapType, class EntriesType, class ValuesType,
+          class LHSType, class RHSType, class NGBLType, class DiagType>
+struct TriLvlSchedTPMVSolverFunctor
+{
+  typedef typename TeamPolicy::member_type team_member_t;
+  typedef typename RowMapType::non_const_value_type size_type;
+  typedef typename EntriesType::non_const_value_type lno_t;
+  typedef typename LHSType::non_const_value_type scalar_t;
+
+  RowMapType row_map;
+  EntriesType entries;
+  ValuesType values;
+  LHSType lhs;
+  RHSType rhs;
+  NGBLType nodes_grouped_by_level;
+  DiagType diagonal_offsets;
+  lno_t node_begin, node_end, team_work_size;
+
+  TriLvlSchedTPMVSolverFunctor(
+      const RowMapType &row_map_, const EntriesType &entries_, const ValuesType &values_,
+      LHSType &lhs_, const RHSType &rhs_,
+      const NGBLType &nodes_grouped_by_level_, const DiagType &diagonal_offsets_,
+      lno_t node_begin_, lno_t node_end_, lno_t team_work_size_):
+    row_map(row_map_), entries(entries_), values(values_), lhs(lhs_), rhs(rhs_),
+    nodes_grouped_by_level(nodes_grouped_by_level_), diagonal_offsets(diagonal_offsets_),
+    node_begin(node_begin_), node_end(node_end_), team_work_size(team_work_size_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const team_member_t &teamMember) const {
+    const lno_t team_node_begin = node_begin + teamMember.league_rank() * team_work_size;
+    const lno_t team_node_end = KOKKOSKERNELS_MACRO_MIN(team_node_begin + team_work_size, node_end);
+    const lno_t num_vecs = lhs.extent(1);
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(teamMember, team_node_begin, team_node_end), [&] (const lno_t i) {
+      const lno_t rowid = nodes_grouped_by_level(i);
+      const size_type soffset = row_map(rowid);
+      const size_type eoffset = row_map(rowid + 1);
+      const size_type doffset = diagonal_offsets(rowid);
+
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(teamMember, num_vecs), [&] (const lno_t j) {
+        scalar_t diff = rhs(rowid, j);
+        for (size_type ptr = soffset; ptr < eoffset; ++ptr){
+          if (ptr != doffset){
+            diff -= values(ptr) * lhs(entries(ptr), j);
+          }
+        }
+        lhs(rowid, j) = (doffset == eoffset) ? diff : diff / values(doffset);
+      });
+    });
+  }
+};
+
+/**
+ * \brief Numeric phase of the level scheduled triangular solve. The levels
+ * are solved one after another, the rows within a level in parallel.
+ * SPTRSV_LVLSCHD_TP1 uses a team policy with vector lanes over the row
+ * entries, SPTRSV_LVLSCHD_RP a range policy over the rows.
+ */
+template <class KernelHandle, class RowMapType, class EntriesType, class ValuesType,
+          class RHSType, class LHSType>
+void tri_solve_lvl_sched(
+    KernelHandle *handle,
+    const RowMapType row_map, const EntriesType entries, const ValuesType values,
+    const RHSType &rhs, LHSType &lhs)
+{
+  typedef typename KernelHandle::HandleExecSpace execution_space;
+  typedef typename KernelHandle::SPTRSVHandleType TriSolveHandle;
+  typedef typename TriSolveHandle::nnz_lno_t lno_t;
+  typedef typename TriSolveHandle::nnz_lno_view_t NGBLType;
+  typedef typename TriSolveHandle::nnz_row_view_t DiagType;
+
+  typedef Kokkos::RangePolicy<execution_space> range_policy_t;
+  typedef Kokkos::TeamPolicy<execution_space> team_policy_t;
+
+  TriSolveHandle *thandle = handle->get_sptrsv_handle();
+  const lno_t nrows = thandle->get_nrows();
+  const lno_t nlevels = thandle->get_num_levels();
+  NGBLType nodes_grouped_by_level = thandle->get_nodes_grouped_by_level();
+  DiagType diagonal_offsets = thandle->get_diagonal_offsets();
+  typename TriSolveHandle::nnz_lno_view_host_t level_ptr = thandle->get_level_ptr();
+
+  const bool use_teams = thandle->get_algorithm_type() == SPTRSV_LVLSCHD_TP1;
+  const int suggested_vector_size = handle->get_suggested_vector_size(nrows, entries.extent(0));
+  const int suggested_team_size = handle->get_suggested_team_size(suggested_vector_size);
+
+  for (lno_t lvl = 0; lvl < nlevels; ++lvl){
+    const lno_t node_begin = level_ptr(lvl);
+    const lno_t node_end = level_ptr(lvl + 1);
+    const lno_t lvl_nodes = node_end - node_begin;
+
+    if (use_teams){
+      TriLvlSchedTPSolverFunctor<team_policy_t, RowMapType, EntriesType, ValuesType, LHSType, RHSType, NGBLType, DiagType>
+        tstf(row_map, entries, values, lhs, rhs, nodes_grouped_by_level, diagonal_offsets,
+             node_begin, node_end, suggested_team_size);
+      Kokkos::parallel_for("KokkosSparse::sptrsv::lvl_sched_team",
+          team_policy_t((lvl_nodes + suggested_team_size - 1) / suggested_team_size,
+                        suggested_team_size, suggested_vector_size), tstf);
+    }
+    else {
+      TriLvlSchedRPSolverFunctor<RowMapType, EntriesType, ValuesType, LHSType, RHSType, NGBLType, DiagType>
+        tstf(row_map, entries, values, lhs, rhs, nodes_grouped_by_level, diagonal_offsets);
+      Kokkos::parallel_for("KokkosSparse::sptrsv::lvl_sched_range",
+          range_policy_t(node_begin, node_end), tstf);
+    }
+  }
+}
+
+/**
+ * \brief Solves the matrix sequentially with a single device thread.
+ */
+template <class KernelHandle, class RowMapType, class EntriesType, class ValuesType,
+          class RHSType, class LHSType>
+void tri_solve_sequential(
+    KernelHandle *handle,
+    const RowMapType row_map, const EntriesType entries, const ValuesType values,
+    const RHSType &rhs, LHSType &lhs)
+{
+  typedef typename KernelHandle::HandleExecSpace execution_space;
+  typedef typename KernelHandle::SPTRSVHandleType TriSolveHandle;
+  typedef typename TriSolveHandle::nnz_row_view_t DiagType;
+
+  TriSolveHandle *thandle = handle->get_sptrsv_handle();
+  TriSequentialSolverFunctor<RowMapType, EntriesType, ValuesType, LHSType, RHSType, DiagType>
+    tstf(row_map, entries, values, lhs, rhs, thandle->get_diagonal_offsets(),
+         thandle->get_nrows(), thandle->is_lower_tri());
+  Kokkos::parallel_for("KokkosSparse::sptrsv::sequential",
+      Kokkos::RangePolicy<execution_space>(0, 1), tstf);
+}
+
+/**
+ * \brief Numeric phase of the task based triangular solve. Each block of
+ * the block DAG of the symbolic phase is a task, solved by a single thread
+ * as soon as the blocks it depends on are solved. Without Kokkos tasking
+ * (KOKKOS_ENABLE_TASKDAG), falls back to the level scheduled solve.
+ */
+template <class KernelHandle, class RowMapType, class EntriesType, class ValuesType,
+          class RHSType, class LHSType>
+void tri_solve_task(
+    KernelHandle *handle,
+    const RowMapType row_map, const EntriesType entries, const ValuesType values,
+    const RHSType &rhs, LHSType &lhs)
+{
+#if defined(KOKKOS_ENABLE_TASKDAG)
+  typedef typename KernelHandle::HandleExecSpace execution_space;
+  typedef typename KernelHandle::SPTRSVHandleType TriSolveHandle;
+  typedef typename TriSolveHandle::nnz_row_view_t DiagType;
+
+  TriSolveHandle *thandle = handle->get_sptrsv_handle();
+  TriSequentialSolverFunctor<RowMapType, EntriesType, ValuesType, LHSType, RHSType, DiagType>
+    tstf(row_map, entries, values, lhs, rhs, thandle->get_diagonal_offsets(),
+         thandle->get_nrows(), thandle->is_lower_tri());
+  run_block_dag<execution_space>(tstf, thandle->get_nrows(), thandle->get_task_block_size(),
+      thandle->get_task_dep_ptr(), thandle->get_task_deps(), thandle->is_upper_tri());
+#else
+  tri_solve_lvl_sched(handle, row_map, entries, values, rhs, lhs);
+#endif
+}
+
+/**
+ * \brief Numeric phase of the chain merged level scheduled triangular
+ * solve. Each chain of small levels is solved by a single team in a
+ * single kernel launch, the large levels with one team policy kernel per
+ * level as in SPTRSV_LVLSCHD_TP1.
+ */
+template <class KernelHandle, class RowMapType, class EntriesType, class ValuesType,
+          class RHSType, class LHSType>
+void tri_solve_chain(
+    KernelHandle *handle,
+    const RowMapType row_map, const EntriesType entries, const ValuesType values,
+    const RHSType &rhs, LHSType &lhs)
+{
+  typedef typename KernelHandle::HandleExecSpace execution_space;
+  typedef typename KernelHandle::SPTRSVHandleType TriSolveHandle;
+  typedef typename TriSolveHandle::nnz_lno_t lno_t;
+  typedef typename TriSolveHandle::nnz_lno_view_t NGBLType;
+  typedef typename TriSolveHandle::nnz_row_view_t DiagType;
+
+  typedef Kokkos::TeamPolicy<execution_space> team_policy_t;
+
+  TriSolveHandle *thandle = handle->get_sptrsv_handle();
+  const lno_t nrows = thandle->get_nrows();
+  const lno_t nchains = thandle->get_num_chains();
+  NGBLType nodes_grouped_by_level = thandle->get_nodes_grouped_by_level();
+  NGBLType dlevel_ptr = thandle->get_level_ptr_device();
+  DiagType diagonal_offsets = thandle->get_diagonal_offsets();
+  typename TriSolveHandle::nnz_lno_view_host_t level_ptr = thandle->get_level_ptr();
+  typename TriSolveHandle::nnz_lno_view_host_t chain_ptr = thandle->get_chain_ptr();
+
+  const int suggested_vector_size = handle->get_suggested_vector_size(nrows, entries.extent(0));
+  const int suggested_team_size = handle->get_suggested_team_size(suggested_vector_size);
+
+  for (lno_t chain = 0; chain < nchains; ++chain){
+    const lno_t lvl_begin = chain_ptr(chain);
+    const lno_t lvl_end = chain_ptr(chain + 1);
+    const lno_t node_begin = level_ptr(lvl_begin);
+    const lno_t node_end = level_ptr(lvl_end);
+
+    if (lvl_end - lvl_begin == 1 && node_end - node_begin > thandle->get_chain_threshold()){
+      TriLvlSchedTPSolverFunctor<team_policy_t, RowMapType, EntriesType, ValuesType, LHSType, RHSType, NGBLType, DiagType>
+        tstf(row_map, entries, values, lhs, rhs, nodes_grouped_by_level, diagonal_offsets,
+             node_begin, node_end, suggested_team_size);
+      Kokkos::parallel_for("KokkosSparse::sptrsv::lvl_sched_team",
+          team_policy_t((node_end - node_begin + suggested_team_size - 1) / suggested_team_size,
+                        suggested_team_size, suggested_vector_size), tstf);
+    }
+    else {
+      TriLvlSchedTPChainSolverFunctor<team_policy_t, RowMapType, EntriesType, ValuesType, LHSType, RHSType, NGBLType, DiagType>
+        tstf(row_map, entries, values, lhs, rhs, nodes_grouped_by_level, dlevel_ptr, diagonal_offsets,
+             lvl_begin, lvl_end);
+      Kokkos::parallel_for("KokkosSparse::sptrsv::lvl_sched_chain",
+          team_policy_t(1, suggested_team_size, suggested_vector_size), tstf);
+    }
+  }
+}
+
+/**
+ * \brief Numeric phase of the supernodal triangular solve. The values are
+ * packed into the dense supernodal blocks in a single fully parallel
+ * kernel, then the supernode levels are solved one after another, one
+ * team per supernode.
+ */
+template <class KernelHandle, class RowMapType, class EntriesType, class ValuesType,
+          class RHSType, class LHSType>
+void tri_solve_supernodal(
+    KernelHandle *handle,
+    const RowMapType row_map, const EntriesType entries, const ValuesType values,
+    const RHSType &rhs, LHSType &lhs)
+{
+  typedef typename KernelHandle::HandleExecSpace execution_space;
+  typedef typename KernelHandle::SPTRSVHandleType TriSolveHandle;
+  typedef typename TriSolveHandle::nnz_lno_t lno_t;
+  typedef typename TriSolveHandle::nnz_lno_view_t LnoViewType;
+  typedef typename TriSolveHandle::nnz_row_view_t SizeViewType;
+  typedef typename TriSolveHandle::nnz_scalar_view_t BlockValuesType;
+
+  typedef Kokkos::TeamPolicy<execution_space> team_policy_t;
+
+  TriSolveHandle *thandle = handle->get_sptrsv_handle();
+  const lno_t nrows = thandle->get_nrows();
+  BlockValuesType block_values = thandle->get_supernode_block_values();
+
+  Kokkos::deep_copy(block_values, Kokkos::Details::ArithTraits<typename BlockValuesType::non_const_value_type>::zero());
+  TriSupernodalPackFunctor<RowMapType, ValuesType, SizeViewType, BlockValuesType>
+    pack(row_map, values, thandle->get_diagonal_offsets(), thandle->get_nnz_block_offsets(),
+         block_values, entries.extent(0));
+  Kokkos::parallel_for("KokkosSparse::sptrsv::supernodal_pack",
+      Kokkos::RangePolicy<execution_space>(0, nrows), pack);
+
+  const lno_t nslevels = thandle->get_num_supernode_levels();
+  typename TriSolveHandle::nnz_lno_view_host_t slevel_ptr = thandle->get_supernode_level_ptr();
+  const int suggested_team_size = handle->get_suggested_team_size(1);
+
+  for (lno_t lvl = 0; lvl < nslevels; ++lvl){
+    const lno_t node_begin = slevel_ptr(lvl);
+    const lno_t lvl_nodes = slevel_ptr(lvl + 1) - node_begin;
+
+    TriSupernodalSolverFunctor<team_policy_t, LHSType, RHSType, LnoViewType, SizeViewType, BlockValuesType>
+      tstf(lhs, rhs, thandle->get_supernode_ptr(), thandle->get_supernode_cols_ptr(),
+           thandle->get_supernode_cols(), thandle->get_supernode_block_ptr(),
+           block_values, thandle->get_supernode_work(),
+           thandle->get_supernodes_grouped_by_level(), node_begin, thandle->is_lower_tri());
+    Kokkos::parallel_for("KokkosSparse::sptrsv::supernodal",
+        team_policy_t(lvl_nodes, suggested_team_size, 1), tstf);
+  }
+}
+
+/**
+ * \brief Level scheduled triangular solve for multiple right hand sides
+ * stored in the columns of rank-2 views. The vector length is chosen from
+ * the number of columns.
+ */
+template <class KernelHandle, class RowMapType, class EntriesType, class ValuesType,
+          class RHSType, class LHSType>
+void tri_solve_lvl_sched_mv(
+    KernelHandle *handle,
+    const RowMapType row_map, const EntriesType entries, const ValuesType values,
+    const RHSType &rhs, LHSType &lhs)
+{
+  typedef typename KernelHandle::HandleExecSpace execution_space;
+  typedef typename KernelHandle::SPTRSVHandleType TriSolveHandle;
+  typedef typename TriSolveHandle::nnz_lno_t lno_t;
+  typedef typename TriSolveHandle::nnz_lno_view_t NGBLType;
+  typedef typename TriSolveHandle::nnz_row_view_t DiagType;
+
+  typedef Kokkos::TeamPolicy<execution_space> team_policy_t;
+
+  TriSolveHandle *thandle = handle->get_sptrsv_handle();
+  const lno_t nlevels = thandle->get_num_levels();
+  NGBLType nodes_grouped_by_level = thandle->get_nodes_grouped_by_level();
+  DiagType diagonal_offsets = thandle->get_diagonal_offsets();
+  typename TriSolveHandle::nnz_lno_view_host_t level_ptr = thandle->get_level_ptr();
+
+  //one vector lane per column, up to the warp size on GPUs.
+  int suggested_vector_size = 1;
+  if (handle->get_handle_exec_space() == KokkosKernels::Impl::Exec_CUDA){
+    const int num_vecs = lhs.extent(1);
+    while (suggested_vector_size < num_vecs && suggested_vector_size < 32) suggested_vector_size *= 2;
+  }
+  const int suggested_team_size = handle->get_suggested_team_size(suggested_vector_size);
+
+  for (lno_t lvl = 0; lvl < nlevels; ++lvl){
+    const lno_t node_begin = level_ptr(lvl);
+    const lno_t node_end = level_ptr(lvl + 1);
+
+    TriLvlSchedTPMVSolverFunctor<team_policy_t, RowMapType, EntriesType, ValuesType, LHSType, RHSType, NGBLType, DiagType>
+      tstf(row_map, entries, values, lhs, rhs, nodes_grouped_by_level, diagonal_offsets,
+           node_begin, node_end, suggested_team_size);
+    Kokkos::parallel_for("KokkosSparse::sptrsv::lvl_sched_team_mv",
+        team_policy_t((node_end - node_begin + suggested_team_size - 1) / suggested_team_size,
+                      suggested_team_size, suggested_vector_size), tstf);
+  }
+}
+
+/// \brief Selects the numeric phase of sptrsv_solve from the algorithm
+///   of the handle and the rank of the right hand side.
+template <class KernelHandle, class RowMapType, class EntriesType, class ValuesType,
+          class RHSType, class LHSType, int rank = LHSType::rank>
+struct SptrsvSolve;
+
+template <class KernelHandle, class RowMapType, class EntriesType, class ValuesType,
+          class RHSType, class LHSType>
+struct SptrsvSolve<KernelHandle, RowMapType, EntriesType, ValuesType, RHSType, LHSType, 1>
+{
+  static void sptrsv_solve(
+      KernelHandle *handle,
+      const RowMapType row_map, const EntriesType entries, const ValuesType values,
+      const RHSType &rhs, LHSType &lhs)
+  {
+    switch (handle->get_sptrsv_handle()->get_algorithm_type()){
+    case SPTRSV_SEQUENTIAL:
+      tri_solve_sequential(handle, row_map, entries, values, rhs, lhs);
+      break;
+    case SPTRSV_LVLSCHD_CHAIN:
+      tri_solve_chain(handle, row_map, entries, values, rhs, lhs);
+      break;
+    case SPTRSV_SUPERNODAL:
+      tri_solve_supernodal(handle, row_map, entries, values, rhs, lhs);
+      break;
+    case SPTRSV_TASK:
+      tri_solve_task(handle, row_map, entries, values, rhs, lhs);
+      break;
+    case SPTRSV_LVLSCHD_RP:
+    case SPTRSV_LVLSCHD_TP1:
+    default:
+      tri_solve_lvl_sched(handle, row_map, entries, values, rhs, lhs);
+      break;
+    }
+  }
+};
+
+template <class KernelHandle, class RowMapType, class EntriesType, class ValuesType,
+          class RHSType, class LHSType>
+struct SptrsvSolve<KernelHandle, RowMapType, EntriesType, ValuesType, RHSType, LHSType, 2>
+{
+  static void sptrsv_solve(
+      KernelHandle *handle,
+      const RowMapType row_map, const EntriesType entries, const ValuesType values,
+      const RHSType &rhs, LHSType &lhs)
+  {
+    if (handle->get_sptrsv_handle()->get_algorithm_type() == SPTRSV_SUPERNODAL){
+      //the supernodal blocks are solved one column at a time.
+      for (size_t j = 0; j < lhs.extent(1); ++j){
+        auto rhs_j = Kokkos::subview(rhs, Kokkos::ALL(), j);
+        auto lhs_j = Kokkos::subview(lhs, Kokkos::ALL(), j);
+        tri_solve_supernodal(handle, row_map, entries, values, rhs_j, lhs_j);
+      }
+    }
+    else {
+      tri_solve_lvl_sched_mv(handle, row_map, entries, values, rhs, lhs);
+    }
+  }
+};
+
+} // namespace Impl
+} // namespace KokkosSparse
+
+#endif
@@ -0,0 +1,140 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSSPARSE_TRANSPOSE_IMPL_HPP
+#define _KOKKOSSPARSE_TRANSPOSE_IMPL_HPP
+
+#include "KokkosKernels_SparseUtils.hpp"
+
+namespace KokkosSparse{
+namespace Impl{
+
+template<class SequenceType>
+struct Transpose_Sequence_Functor {
+  typedef typename SequenceType::non_const_value_type size_type;
+
+  SequenceType sequence;
+
+  Transpose_Sequence_Functor (const SequenceType sequence_) : sequence (sequence_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& k) const
+  {
+    sequence(k) = k;
+  }
+};
+
+template<class ValuesType, class TransposeValuesType, class PermutationType>
+struct Transpose_Values_Functor {
+  typedef typename PermutationType::non_const_value_type size_type;
+
+  ValuesType values;
+  TransposeValuesType transpose_values;
+  PermutationType permutation;
+
+  Transpose_Values_Functor (const ValuesType values_,
+                            const TransposeValuesType transpose_values_,
+                            const PermutationType permutation_) :
+    values (values_), transpose_values (transpose_values_), permutation (permutation_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const size_type& k) const
+  {
+    transpose_values(k) = values(permutation(k));
+  }
+};
+
+/// \brief Computes the pattern of the transpose of A and, for each of its
+///   entries, the entry of A it comes from, and stores them in handle.
+///
+/// The team-based count and fill of kk_transpose_matrix transpose the
+/// sequence 0, ..., nnz-1 as values, which gives the permutation. With
+/// sorted rows, the permutation is sorted with the entries.
+template<class HandleType, class AMatrix>
+void
+transpose_symbolic (HandleType& handle, const AMatrix& A)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  typedef typename HandleType::size_type_view_t size_type_view_t;
+  typedef typename HandleType::nnz_lno_view_t entries_view_t;
+
+  const typename HandleType::nnz_lno_t numRows = A.numRows ();
+  const typename HandleType::nnz_lno_t numCols = A.numCols ();
+  const typename HandleType::size_type nnz = A.nnz ();
+
+  size_type_view_t t_row_map ("transpose row_map", numCols + 1);
+  entries_view_t t_entries (Kokkos::ViewAllocateWithoutInitializing ("transpose entries"), nnz);
+  size_type_view_t permutation (Kokkos::ViewAllocateWithoutInitializing ("transpose permutation"), nnz);
+  if (numRows > 0) {
+    size_type_view_t sequence (Kokkos::ViewAllocateWithoutInitializing ("transpose sequence"), nnz);
+    Kokkos::parallel_for ("KokkosSparse::transpose_sequence",
+        Kokkos::RangePolicy<execution_space> (0, nnz),
+        Transpose_Sequence_Functor<size_type_view_t> (sequence));
+    KokkosKernels::Impl::kk_transpose_matrix
+      <typename AMatrix::row_map_type, typename AMatrix::index_type, size_type_view_t,
+       size_type_view_t, entries_view_t, size_type_view_t, size_type_view_t, execution_space>
+      (numRows, numCols, A.graph.row_map, A.graph.entries, sequence, t_row_map, t_entries, permutation);
+    if (handle.get_sort_rows ()) {
+      KokkosKernels::Impl::kk_sort_crs_rows
+        <size_type_view_t, entries_view_t, size_type_view_t, execution_space>
+        (t_row_map, t_entries, permutation);
+    }
+  }
+  handle.set_plan (A.graph.row_map.data (), numRows, numCols, nnz, t_row_map, t_entries, permutation);
+}
+
+/// \brief Gathers the values of A into the values of its transpose.
+template<class HandleType, class AMatrix, class TransposeValuesType>
+void
+transpose_numeric (const HandleType& handle, const AMatrix& A, const TransposeValuesType& t_values)
+{
+  typedef typename AMatrix::execution_space execution_space;
+  Kokkos::parallel_for ("KokkosSparse::transpose_values",
+      Kokkos::RangePolicy<execution_space> (0, A.nnz ()),
+      Transpose_Values_Functor<typename AMatrix::values_type, TransposeValuesType,
+        typename HandleType::size_type_view_t> (A.values, t_values, handle.get_transpose_permutation ()));
+}
+
+}
+}
+
+#endif
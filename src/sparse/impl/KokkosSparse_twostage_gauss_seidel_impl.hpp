@@ -0,0 +1,313 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#ifndef _KOKKOSTWOSTAGEGSIMP_HPP
+#define _KOKKOSTWOSTAGEGSIMP_HPP
+
+#include "KokkosKernels_Utils.hpp"
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ArithTraits.hpp>
+#include <sstream>
+#include <utility>
+
+namespace KokkosSparse{
+namespace Impl{
+
+/**
+ * \brief Two-stage Gauss-Seidel: each forward sweep x += (D + L)^{-1} (y - A x)
+ * applies the inverse of the lower triangle with num_inner_sweeps Jacobi
+ * sweeps, d_{k+1} = D^{-1} (r - L d_k) with d_0 = D^{-1} r, and the backward
+ * sweeps the same with the upper triangle. All the kernels are parallel over
+ * the rows, so there is no coloring and one launch per inner sweep.
+ */
+template <typename HandleType, typename lno_row_view_t_, typename lno_nnz_view_t_, typename scalar_nnz_view_t_>
+class TwoStageGaussSeidel{
+
+public:
+
+  typedef typename HandleType::HandleExecSpace MyExecSpace;
+
+  typedef typename HandleType::size_type size_type;
+  typedef typename HandleType::nnz_lno_t nnz_lno_t;
+  typedef typename HandleType::nnz_scalar_t nnz_scalar_t;
+
+  typedef typename lno_row_view_t_::const_type const_lno_row_view_t;
+  typedef typename lno_nnz_view_t_::const_type const_lno_nnz_view_t;
+  typedef typename scalar_nnz_view_t_::const_type const_scalar_nnz_view_t;
+
+  typedef typename HandleType::scalar_persistent_work_view_t scalar_persistent_work_view_t;
+
+  typedef Kokkos::RangePolicy<MyExecSpace> my_exec_space;
+  typedef Kokkos::Details::ArithTraits<nnz_scalar_t> ATS;
+
+  struct LowerTag{};
+  struct UpperTag{};
+
+private:
+  HandleType *handle;
+  nnz_lno_t num_rows, num_cols;
+
+  const_lno_row_view_t row_map;
+  const_lno_nnz_view_t entries;
+  const_scalar_nnz_view_t values;
+
+public:
+
+  //inverse of the diagonal entry of each row; 0 for rows without one.
+  struct TwoStage_Inverse_Diagonal{
+    const_lno_row_view_t _xadj;
+    const_lno_nnz_view_t _adj;
+    const_scalar_nnz_view_t _adj_vals;
+    scalar_persistent_work_view_t _inverse_diagonals;
+
+    TwoStage_Inverse_Diagonal(const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_, const_scalar_nnz_view_t adj_vals_,
+        scalar_persistent_work_view_t inverse_diagonals_):
+      _xadj(xadj_), _adj(adj_), _adj_vals(adj_vals_), _inverse_diagonals(inverse_diagonals_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &ii) const {
+      nnz_scalar_t diagonalVal = ATS::zero();
+      for (size_type adjind = _xadj[ii]; adjind < _xadj[ii + 1]; ++adjind){
+        if (_adj[adjind] == ii) diagonalVal += _adj_vals[adjind];
+      }
+      _inverse_diagonals[ii] = diagonalVal == ATS::zero() ? ATS::zero() : ATS::one() / diagonalVal;
+    }
+  };
+
+  //r = y - A x and d = D^{-1} r.
+  template <typename x_value_array_type, typename y_value_array_type>
+  struct TwoStage_Residual{
+    const_lno_row_view_t _xadj;
+    const_lno_nnz_view_t _adj;
+    const_scalar_nnz_view_t _adj_vals;
+    x_value_array_type _Xvector;
+    y_value_array_type _Yvector;
+    scalar_persistent_work_view_t _Rvector;
+    scalar_persistent_work_view_t _Dvector;
+    scalar_persistent_work_view_t _inverse_diagonals;
+
+    TwoStage_Residual(const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_, const_scalar_nnz_view_t adj_vals_,
+        x_value_array_type Xvector_, y_value_array_type Yvector_,
+        scalar_persistent_work_view_t Rvector_, scalar_persistent_work_view_t Dvector_,
+        scalar_persistent_work_view_t inverse_diagonals_):
+      _xadj(xadj_), _adj(adj_), _adj_vals(adj_vals_), _Xvector(Xvector_), _Yvector(Yvector_),
+      _Rvector(Rvector_), _Dvector(Dvector_), _inverse_diagonals(inverse_diagonals_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &ii) const {
+      nnz_scalar_t sum = _Yvector[ii];
+      for (size_type adjind = _xadj[ii]; adjind < _xadj[ii + 1]; ++adjind){
+        sum -= _adj_vals[adjind] * _Xvector[_adj[adjind]];
+      }
+      _Rvector[ii] = sum;
+      _Dvector[ii] = _inverse_diagonals[ii] * sum;
+    }
+  };
+
+  //one Jacobi sweep on the lower or the upper triangle, d_new = D^{-1} (r - L d).
+  //The last sweep adds d_new to x instead of storing it.
+  template <typename x_value_array_type>
+  struct TwoStage_Inner_Sweep{
+    const_lno_row_view_t _xadj;
+    const_lno_nnz_view_t _adj;
+    const_scalar_nnz_view_t _adj_vals;
+    scalar_persistent_work_view_t _Rvector;
+    scalar_persistent_work_view_t _Dvector;
+    scalar_persistent_work_view_t _Dnew_vector;
+    x_value_array_type _Xvector;
+    scalar_persistent_work_view_t _inverse_diagonals;
+    bool _update_x;
+
+    TwoStage_Inner_Sweep(const_lno_row_view_t xadj_, const_lno_nnz_view_t adj_, const_scalar_nnz_view_t adj_vals_,
+        scalar_persistent_work_view_t Rvector_, scalar_persistent_work_view_t Dvector_,
+        scalar_persistent_work_view_t Dnew_vector_, x_value_array_type Xvector_,
+        scalar_persistent_work_view_t inverse_diagonals_, bool update_x_):
+      _xadj(xadj_), _adj(adj_), _adj_vals(adj_vals_), _Rvector(Rvector_), _Dvector(Dvector_),
+      _Dnew_vector(Dnew_vector_), _Xvector(Xvector_), _inverse_diagonals(inverse_diagonals_), _update_x(update_x_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void sweep(const nnz_lno_t &ii, const bool lower) const {
+      nnz_scalar_t sum = _Rvector[ii];
+      for (size_type adjind = _xadj[ii]; adjind < _xadj[ii + 1]; ++adjind){
+        const nnz_lno_t colIndex = _adj[adjind];
+        if (lower ? colIndex < ii : colIndex > ii){
+          sum -= _adj_vals[adjind] * _Dvector[colIndex];
+        }
+      }
+      sum *= _inverse_diagonals[ii];
+      if (_update_x){
+        _Xvector[ii] += sum;
+      }
+      else {
+        _Dnew_vector[ii] = sum;
+      }
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const LowerTag&, const nnz_lno_t &ii) const {
+      sweep(ii, true);
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const UpperTag&, const nnz_lno_t &ii) const {
+      sweep(ii, false);
+    }
+  };
+
+  //x += d, the sweep without inner sweeps.
+  template <typename x_value_array_type>
+  struct TwoStage_Update{
+    scalar_persistent_work_view_t _Dvector;
+    x_value_array_type _Xvector;
+
+    TwoStage_Update(scalar_persistent_work_view_t Dvector_, x_value_array_type Xvector_):
+      _Dvector(Dvector_), _Xvector(Xvector_){}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const nnz_lno_t &ii) const {
+      _Xvector[ii] += _Dvector[ii];
+    }
+  };
+
+  TwoStageGaussSeidel(HandleType *handle_,
+      nnz_lno_t num_rows_,
+      nnz_lno_t num_cols_,
+      const_lno_row_view_t row_map_,
+      const_lno_nnz_view_t entries_):
+        handle(handle_), num_rows(num_rows_), num_cols(num_cols_),
+        row_map(row_map_), entries(entries_), values(){}
+
+  TwoStageGaussSeidel(HandleType *handle_,
+      nnz_lno_t num_rows_,
+      nnz_lno_t num_cols_,
+      const_lno_row_view_t row_map_,
+      const_lno_nnz_view_t entries_,
+      const_scalar_nnz_view_t values_):
+        handle(handle_), num_rows(num_rows_), num_cols(num_cols_),
+        row_map(row_map_), entries(entries_), values(values_){}
+
+  void initialize_symbolic(){
+    typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    if (gsHandler->get_block_size() != 1 || this->num_rows != this->num_cols){
+      std::ostringstream os;
+      os << "KokkosSparse::gauss_seidel: GS_TWOSTAGE needs a square point matrix, "
+         << "A: " << this->num_rows << " x " << this->num_cols
+         << ", block size: " << gsHandler->get_block_size();
+      Kokkos::Impl::throw_runtime_exception (os.str ());
+    }
+    //the residual, the first inner vector and the second one.
+    gsHandler->allocate_x_y_vectors(this->num_rows, this->num_cols);
+    gsHandler->allocate_inner_sweep_vector(this->num_rows);
+    gsHandler->set_call_symbolic(true);
+  }
+
+  void initialize_numeric(){
+    typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    if (gsHandler->is_symbolic_called() == false){
+      this->initialize_symbolic();
+    }
+    scalar_persistent_work_view_t inverse_diagonals (Kokkos::ViewAllocateWithoutInitializing("inverse_diagonals"), num_rows);
+    Kokkos::parallel_for("KokkosSparse::TwoStageGaussSeidel::inverse_diagonals", my_exec_space(0, num_rows),
+        TwoStage_Inverse_Diagonal(this->row_map, this->entries, this->values, inverse_diagonals));
+    MyExecSpace::fence();
+    gsHandler->set_inverse_diagonals(inverse_diagonals);
+    gsHandler->set_call_numeric(true);
+  }
+
+  template <typename x_value_array_type, typename y_value_array_type>
+  void apply(
+      x_value_array_type x_lhs_output_vec,
+      y_value_array_type y_rhs_input_vec,
+      bool init_zero_x_vector = false,
+      int numIter = 1,
+      bool apply_forward = true,
+      bool apply_backward = true,
+      bool /*update_y_vector*/ = true){
+    typename HandleType::GaussSeidelHandleType *gsHandler = this->handle->get_gs_handle();
+    if (gsHandler->is_numeric_called() == false){
+      this->initialize_numeric();
+    }
+    scalar_persistent_work_view_t r = gsHandler->get_permuted_y_vector();
+    scalar_persistent_work_view_t d = gsHandler->get_permuted_x_vector();
+    scalar_persistent_work_view_t d_new = gsHandler->get_inner_sweep_vector();
+    scalar_persistent_work_view_t inverse_diagonals = gsHandler->get_inverse_diagonals();
+    const int num_inner_sweeps = gsHandler->get_num_inner_sweeps();
+
+    if (init_zero_x_vector){
+      KokkosKernels::Impl::zero_vector<x_value_array_type, MyExecSpace>(num_cols, x_lhs_output_vec);
+    }
+    for (int iter = 0; iter < numIter; ++iter){
+      for (int direction = 0; direction < 2; ++direction){
+        const bool lower = direction == 0;
+        if (lower ? !apply_forward : !apply_backward) continue;
+
+        Kokkos::parallel_for("KokkosSparse::TwoStageGaussSeidel::residual", my_exec_space(0, num_rows),
+            TwoStage_Residual<x_value_array_type, y_value_array_type>(
+                this->row_map, this->entries, this->values, x_lhs_output_vec, y_rhs_input_vec,
+                r, d, inverse_diagonals));
+        if (num_inner_sweeps == 0){
+          Kokkos::parallel_for("KokkosSparse::TwoStageGaussSeidel::update", my_exec_space(0, num_rows),
+              TwoStage_Update<x_value_array_type>(d, x_lhs_output_vec));
+        }
+        for (int sweep = 1; sweep <= num_inner_sweeps; ++sweep){
+          TwoStage_Inner_Sweep<x_value_array_type> inner(
+              this->row_map, this->entries, this->values, r, d, d_new, x_lhs_output_vec,
+              inverse_diagonals, sweep == num_inner_sweeps);
+          if (lower){
+            Kokkos::parallel_for("KokkosSparse::TwoStageGaussSeidel::lower_sweep",
+                Kokkos::RangePolicy<LowerTag, MyExecSpace>(0, num_rows), inner);
+          }
+          else {
+            Kokkos::parallel_for("KokkosSparse::TwoStageGaussSeidel::upper_sweep",
+                Kokkos::RangePolicy<UpperTag, MyExecSpace>(0, num_rows), inner);
+          }
+          std::swap(d, d_new);
+        }
+      }
+    }
+    MyExecSpace::fence();
+  }
+};
+
+}
+}
+#endif
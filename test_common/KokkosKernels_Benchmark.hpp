@@ -0,0 +1,366 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOSKERNELS_BENCHMARK_HPP
+#define KOKKOSKERNELS_BENCHMARK_HPP
+
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <strings.h>
+
+#include "Kokkos_Core.hpp"
+#include "impl/Kokkos_Timer.hpp"
+
+/// Shared driver support for the perf tests: the common command line
+/// options (backend, repeat, warmup, output), timing statistics and a
+/// report written as text, JSON or CSV so that results can be compared
+/// across builds and releases.
+
+namespace KokkosKernels{
+
+namespace Experiment{
+
+enum BenchmarkFormat { BENCHMARK_TEXT, BENCHMARK_JSON, BENCHMARK_CSV };
+
+struct BenchmarkOptions{
+  int repeat;           // number of timed runs
+  int warmup;           // number of untimed runs before the timed ones
+  int use_threads;
+  int use_openmp;
+  int use_cuda;         // cuda device index + 1, 0 if not used
+  int use_serial;
+  BenchmarkFormat format;
+  const char *output_file; // NULL writes the report to std::cout
+
+  BenchmarkOptions(){
+    repeat = 6;
+    warmup = 0;
+    use_threads = 0;
+    use_openmp = 0;
+    use_cuda = 0;
+    use_serial = 0;
+    format = BENCHMARK_TEXT;
+    output_file = NULL;
+  }
+};
+
+inline void print_benchmark_options(std::ostream &os){
+  os << "\tBACKEND: '--threads [numThreads]' | '--openmp [numThreads]' | '--cuda [cudaDeviceIndex]' | '--serial'" << std::endl;
+  os << "\t'--repeat [N]': number of timed runs, '--warmup [N]': number of untimed runs before them" << std::endl;
+  os << "\t'--format [text|json|csv]': format of the report, '--output [file]': write the report to file instead of stdout" << std::endl;
+}
+
+namespace Impl{
+/// an optional integer argument following argv[i]
+inline bool next_is_integer(int argc, char **argv, int i){
+  if (i + 1 >= argc) return false;
+  const char *s = argv[i+1];
+  if (*s == '-' || *s == '+') ++s;
+  if (*s == '\0') return false;
+  for (; *s; ++s) if (*s < '0' || *s > '9') return false;
+  return true;
+}
+}
+
+/// Parses the option at argv[i] if it is one of the common options and
+/// advances i past its arguments. Returns false if argv[i] is not a
+/// common option so that the driver can try its own options.
+inline bool parse_benchmark_option(BenchmarkOptions &opts, int argc, char **argv, int &i){
+  if ( 0 == strcasecmp( argv[i] , "--threads" ) && i + 1 < argc ) {
+    opts.use_threads = atoi( argv[++i] );
+  }
+  else if ( 0 == strcasecmp( argv[i] , "--openmp" ) && i + 1 < argc ) {
+    opts.use_openmp = atoi( argv[++i] );
+  }
+  else if ( 0 == strcasecmp( argv[i] , "--cuda" ) ) {
+    opts.use_cuda = (Impl::next_is_integer(argc, argv, i) ? atoi( argv[++i] ) : 0) + 1;
+  }
+  else if ( 0 == strcasecmp( argv[i] , "--serial" ) ) {
+    opts.use_serial = (Impl::next_is_integer(argc, argv, i) ? atoi( argv[++i] ) : 1);
+  }
+  else if ( 0 == strcasecmp( argv[i] , "--repeat" ) && i + 1 < argc ) {
+    opts.repeat = atoi( argv[++i] );
+  }
+  else if ( 0 == strcasecmp( argv[i] , "--warmup" ) && i + 1 < argc ) {
+    opts.warmup = atoi( argv[++i] );
+  }
+  else if ( 0 == strcasecmp( argv[i] , "--format" ) && i + 1 < argc ) {
+    ++i;
+    if      ( 0 == strcasecmp( argv[i] , "json" ) ) opts.format = BENCHMARK_JSON;
+    else if ( 0 == strcasecmp( argv[i] , "csv" ) )  opts.format = BENCHMARK_CSV;
+    else                                            opts.format = BENCHMARK_TEXT;
+  }
+  else if ( 0 == strcasecmp( argv[i] , "--output" ) && i + 1 < argc ) {
+    opts.output_file = argv[++i];
+  }
+  else {
+    return false;
+  }
+  return true;
+}
+
+/// Kokkos initialization arguments for the selected backend.
+inline Kokkos::InitArguments get_benchmark_init_arguments(const BenchmarkOptions &opts){
+  const int num_threads = opts.use_openmp ? opts.use_openmp : (opts.use_threads ? opts.use_threads : -1);
+  const int device_id = opts.use_cuda - 1;
+  return Kokkos::InitArguments( num_threads, -1, device_id );
+}
+
+struct BenchmarkStats{
+  int count;
+  double min, max, mean, median, stddev;
+
+  BenchmarkStats() : count(0), min(0), max(0), mean(0), median(0), stddev(0) {}
+};
+
+inline BenchmarkStats compute_benchmark_stats(std::vector<double> samples){
+  BenchmarkStats s;
+  s.count = samples.size();
+  if (s.count == 0) return s;
+
+  std::sort(samples.begin(), samples.end());
+  s.min = samples.front();
+  s.max = samples.back();
+  s.median = (s.count % 2) ? samples[s.count/2] : 0.5*(samples[s.count/2-1] + samples[s.count/2]);
+
+  double sum = 0;
+  for (int i = 0; i < s.count; ++i) sum += samples[i];
+  s.mean = sum/s.count;
+
+  double var = 0;
+  for (int i = 0; i < s.count; ++i) var += (samples[i] - s.mean)*(samples[i] - s.mean);
+  s.stddev = s.count > 1 ? std::sqrt(var/(s.count - 1)) : 0;
+  return s;
+}
+
+/// Timings of one benchmark case. flops and bytes are per run and give
+/// the achieved GFLOP/s and GB/s at the median time; 0 when unknown.
+struct BenchmarkResult{
+  std::string name;
+  std::vector<std::pair<std::string,std::string> > params;
+  std::vector<double> samples;
+  double flops;
+  double bytes;
+
+  BenchmarkResult(const std::string &name_ = std::string())
+    : name(name_), flops(0), bytes(0) {}
+
+  template <typename value_type>
+  BenchmarkResult &add_param(const std::string &key, const value_type &value){
+    std::ostringstream os;
+    os << value;
+    params.push_back(std::make_pair(key, os.str()));
+    return *this;
+  }
+
+  void record(const double seconds){ samples.push_back(seconds); }
+
+  BenchmarkStats stats() const { return compute_benchmark_stats(samples); }
+
+  double gflops() const {
+    const double t = stats().median;
+    return (t > 0 && flops > 0) ? flops/t/1e9 : 0;
+  }
+  double gbytes() const {
+    const double t = stats().median;
+    return (t > 0 && bytes > 0) ? bytes/t/1e9 : 0;
+  }
+};
+
+/// Runs f opts.warmup times untimed and then opts.repeat times timed, fencing
+/// ExecSpace around every run. setup, e.g. a cache flush or the
+/// reinitialization of the output, is called before every run and not timed.
+template <typename ExecSpace, typename Setup, typename Functor>
+void run_benchmark(const BenchmarkOptions &opts, BenchmarkResult &result, const Setup &setup, const Functor &f){
+  Kokkos::Impl::Timer timer;
+  for (int i = -opts.warmup; i < opts.repeat; ++i){
+    setup();
+    ExecSpace::fence();
+    timer.reset();
+    f();
+    ExecSpace::fence();
+    const double t = timer.seconds();
+    if (i >= 0) result.record(t);
+  }
+}
+
+template <typename ExecSpace, typename Functor>
+void run_benchmark(const BenchmarkOptions &opts, BenchmarkResult &result, const Functor &f){
+  run_benchmark<ExecSpace>(opts, result, [](){}, f);
+}
+
+/// Collects the results of a driver and writes them in the requested format.
+class BenchmarkReport{
+  BenchmarkOptions _opts;
+  std::vector<BenchmarkResult> _results;
+
+  static std::string json_string(const std::string &s){
+    std::string r("\"");
+    for (size_t i = 0; i < s.size(); ++i){
+      if (s[i] == '"' || s[i] == '\\') r += '\\';
+      r += s[i];
+    }
+    return r + "\"";
+  }
+
+  static std::string csv_string(const std::string &s){
+    if (s.find_first_of(",\"\n") == std::string::npos) return s;
+    std::string r("\"");
+    for (size_t i = 0; i < s.size(); ++i){
+      if (s[i] == '"') r += '"';
+      r += s[i];
+    }
+    return r + "\"";
+  }
+
+  void write_text(std::ostream &os) const {
+    for (size_t r = 0; r < _results.size(); ++r){
+      const BenchmarkResult &res = _results[r];
+      const BenchmarkStats s = res.stats();
+      os << res.name;
+      for (size_t p = 0; p < res.params.size(); ++p)
+        os << " " << res.params[p].first << ":" << res.params[p].second;
+      os << std::scientific << std::setprecision(4)
+         << " runs:" << s.count
+         << " min_time:" << s.min
+         << " median_time:" << s.median
+         << " mean_time:" << s.mean
+         << " stddev:" << s.stddev;
+      if (res.flops > 0) os << " GFLOP/s:" << std::fixed << std::setprecision(3) << res.gflops();
+      if (res.bytes > 0) os << " GB/s:" << std::fixed << std::setprecision(3) << res.gbytes();
+      os.unsetf(std::ios_base::floatfield);
+      os << std::endl;
+    }
+  }
+
+  void write_json(std::ostream &os) const {
+    os << "{\n  \"results\": [";
+    for (size_t r = 0; r < _results.size(); ++r){
+      const BenchmarkResult &res = _results[r];
+      const BenchmarkStats s = res.stats();
+      os << (r ? ",\n" : "\n") << "    { \"name\": " << json_string(res.name) << ", \"params\": {";
+      for (size_t p = 0; p < res.params.size(); ++p)
+        os << (p ? ", " : " ") << json_string(res.params[p].first) << ": " << json_string(res.params[p].second);
+      os << (res.params.size() ? " }" : "}")
+         << std::setprecision(9)
+         << ", \"runs\": " << s.count
+         << ", \"min\": " << s.min
+         << ", \"median\": " << s.median
+         << ", \"mean\": " << s.mean
+         << ", \"max\": " << s.max
+         << ", \"stddev\": " << s.stddev
+         << ", \"flops\": " << res.flops
+         << ", \"bytes\": " << res.bytes
+         << ", \"gflops\": " << res.gflops()
+         << ", \"gbytes\": " << res.gbytes()
+         << " }";
+    }
+    os << "\n  ]\n}" << std::endl;
+  }
+
+  void write_csv(std::ostream &os) const {
+    os << "name,params,runs,min,median,mean,max,stddev,flops,bytes,gflops,gbytes" << std::endl;
+    for (size_t r = 0; r < _results.size(); ++r){
+      const BenchmarkResult &res = _results[r];
+      const BenchmarkStats s = res.stats();
+      std::string params;
+      for (size_t p = 0; p < res.params.size(); ++p)
+        params += (p ? ";" : "") + res.params[p].first + "=" + res.params[p].second;
+      os << std::setprecision(9)
+         << csv_string(res.name) << "," << csv_string(params) << ","
+         << s.count << "," << s.min << "," << s.median << "," << s.mean << ","
+         << s.max << "," << s.stddev << ","
+         << res.flops << "," << res.bytes << "," << res.gflops() << "," << res.gbytes() << std::endl;
+    }
+  }
+
+public:
+  BenchmarkReport(const BenchmarkOptions &opts) : _opts(opts) {}
+
+  const BenchmarkOptions &options() const { return _opts; }
+
+  void add(const BenchmarkResult &result){ _results.push_back(result); }
+
+  const std::vector<BenchmarkResult> &results() const { return _results; }
+
+  void write(std::ostream &os) const {
+    const std::ios_base::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    switch (_opts.format){
+    case BENCHMARK_JSON: write_json(os); break;
+    case BENCHMARK_CSV:  write_csv(os);  break;
+    default:             write_text(os);
+    }
+    os.flags(flags);
+    os.precision(precision);
+  }
+
+  /// writes to opts.output_file if given, otherwise to std::cout
+  void write() const {
+    if (_opts.output_file){
+      std::ofstream os(_opts.output_file);
+      if (!os){
+        std::cerr << "Cannot open benchmark output file " << _opts.output_file << std::endl;
+        write(std::cout);
+        return;
+      }
+      write(os);
+    }
+    else {
+      write(std::cout);
+    }
+  }
+};
+
+}
+}
+
+#endif
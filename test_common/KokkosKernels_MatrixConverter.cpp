@@ -43,11 +43,52 @@
 #include <cstdlib>
 #include <iostream>
 #include "KokkosKernels_IOUtils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
 #include "KokkosKernels_Utils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
 
 #include <string.h>
 #include "KokkosKernels_MyCRSMatrix.hpp"
 
+//Writes a matrix from the parallel generators, given as
+//  random:N[:NNZ_PER_ROW]      banded random rows, as the spmv perf test -s N
+//  laplacian:NX[:NY[:NZ]]      the 5 (2D) or 7 (3D) point Laplacian of a grid
+//  rmat:SCALE[:EDGE_FACTOR]    the undirected R-MAT graph of 2^SCALE vertices
+template <typename crsMat_t>
+int write_generated_matrix(const char *spec, const char *out_mtx){
+  typedef typename crsMat_t::non_const_ordinal_type lno_t;
+  typedef typename crsMat_t::non_const_size_type size_type;
+
+  const std::string s(spec);
+  const std::string kind = s.substr(0, s.find(':'));
+  long p[3] = {0, 0, 0};
+  int np = 0;
+  for (size_t pos = s.find(':'); pos != std::string::npos && np < 3; pos = s.find(':', pos + 1))
+    p[np++] = atol(s.c_str() + pos + 1);
+
+  crsMat_t a_crsmat;
+  if (kind == "random" && np >= 1){
+    const lno_t n = p[0];
+    size_type nnz = size_type(n) * (np >= 2 ? p[1] : 10);
+    a_crsmat = KokkosKernels::Impl::kk_generate_sparse_matrix_parallel<crsMat_t>(
+        n, n, nnz, lno_t(nnz / n * 0.2), lno_t(n * 0.01));
+  }
+  else if (kind == "laplacian" && np >= 1){
+    a_crsmat = KokkosKernels::Impl::kk_generate_laplacian_matrix<crsMat_t>(
+        p[0], np >= 2 ? p[1] : 1, np >= 3 ? p[2] : 1);
+  }
+  else if (kind == "rmat" && np >= 1){
+    a_crsmat = KokkosKernels::Impl::kk_generate_rmat_matrix<crsMat_t>(p[0], np >= 2 ? p[1] : 16);
+  }
+  else {
+    std::cerr << "Unknown generator " << spec << ", expected random:N[:NNZ_PER_ROW], laplacian:NX[:NY[:NZ]] or rmat:SCALE[:EDGE_FACTOR]" << std::endl;
+    return 1;
+  }
+  std::cout << "numrows :" << a_crsmat.numRows() << " nnz:" << a_crsmat.nnz() << std::endl;
+  KokkosKernels::Impl::write_kokkos_crst_matrix (a_crsmat, out_mtx);
+  return 0;
+}
+
 int main (int argc, char* argv[]){
   typedef int size_type;
   typedef int idx;
@@ -56,7 +97,7 @@ int main (int argc, char* argv[]){
   Kokkos::initialize(argc,argv);
   
   bool symmetrize = false, remove_diagonal = false, transpose = false;
-  char *in_mtx = NULL, *out_bin = NULL;
+  char *in_mtx = NULL, *out_bin = NULL, *generate = NULL;
   //bool create_incidence = false;
   for ( int i = 1 ; i < argc ; ++i ) {
     if ( 0 == strcasecmp( argv[i] , "--symmetrize" ) ) {
@@ -74,15 +115,25 @@ int main (int argc, char* argv[]){
     else if ( 0 == strcasecmp( argv[i] , "--out_mtx" ) ) {
       out_bin = argv[++i];
     }
+    else if ( 0 == strcasecmp( argv[i] , "--generate" ) ) {
+      generate = argv[++i];
+    }
     else {
       std::cerr << "Usage:" << argv[0]
                 << " --in_mtx matrixfile --out_mtx output_file [--symmetrize] [--remove_diagonal] [--transpose]" << std::endl;
+      std::cerr << "   or:" << argv[0] << " --generate [random:N[:NNZ_PER_ROW]|laplacian:NX[:NY[:NZ]]|rmat:SCALE[:EDGE_FACTOR]] --out_mtx output_file" << std::endl;
     std::cerr << "Input format .mtx for matrix market, .bin for binary, .crs for crs format" << std::endl;
     std::cerr << "Output format .mtx for matrix market, .bin for binary, .crs for crs format, .ligra for ligra output format" << std::endl;
 
       exit(1);
     }
   }
+  if (generate != NULL && out_bin != NULL){
+    typedef KokkosSparse::CrsMatrix<wt, idx, Kokkos::DefaultHostExecutionSpace, void, size_type> generated_crsmat_t;
+    const int ret = write_generated_matrix<generated_crsmat_t>(generate, out_bin);
+    Kokkos::finalize();
+    return ret;
+  }
   if (in_mtx == NULL || out_bin == NULL){
     std::cerr << "Usage:" << argv[0]
               << " --in_mtx matrixfile --out_mtx output_file [--symmetrize] [--remove_diagonal] [--transpose]" << std::endl;
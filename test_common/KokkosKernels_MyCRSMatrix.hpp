@@ -202,42 +202,51 @@ crsMat_t get_crsmat(
 
 template <typename myExecSpace, typename in_crsMat_t, typename out_crsMat_t>
 out_crsMat_t copy_crsmat(in_crsMat_t inputMat){
-/*
+
     typedef typename out_crsMat_t::StaticCrsGraphType graph_t;
     typedef typename out_crsMat_t::row_map_type::non_const_type row_map_view_t;
     typedef typename out_crsMat_t::index_type::non_const_type   cols_view_t;
     typedef typename out_crsMat_t::values_type::non_const_type values_view_t;
 
+    const size_t nv1 = inputMat.graph.row_map.extent(0);
+    const size_t ne = inputMat.graph.entries.extent(0);
 
-    typedef typename in_crsMat_t::StaticCrsGraphType in_graph_t;
-    typedef typename in_crsMat_t::row_map_type::const_type in_row_map_view_t;
-    typedef typename in_crsMat_t::index_type::const_type   in_cols_view_t;
-    typedef typename in_crsMat_t::values_type::const_type in_values_view_t;
-
-    typedef typename row_map_view_t::value_type size_type;
-    typedef typename cols_view_t::value_type   lno_t;
-    typedef typename values_view_t::value_type scalar_t;
+    row_map_view_t rowmap_view(Kokkos::ViewAllocateWithoutInitializing("rowmap_view"), nv1);
+    cols_view_t columns_view(Kokkos::ViewAllocateWithoutInitializing("colsmap_view"), ne);
+    values_view_t values_view(Kokkos::ViewAllocateWithoutInitializing("values_view"), ne);
 
+    Kokkos::deep_copy(rowmap_view, inputMat.graph.row_map);
+    Kokkos::deep_copy(columns_view, inputMat.graph.entries);
+    Kokkos::deep_copy(values_view, inputMat.values);
+    myExecSpace().fence();
 
-
-    const size_type nv = inputMat.numRows();
-    const size_type ne = inputMat.graph.entries.extent(0);
-
-    row_map_view_t rowmap_view("rowmap_view", nv+1);
-    cols_view_t columns_view("colsmap_view", ne);
-    values_view_t values_view("values_view", ne);
-
-    KokkosKernels::Impl::copy_vector<in_values_view_t , values_view_t, myExecSpace>(ne, inputMat.values, values_view);
-    KokkosKernels::Impl::copy_vector<in_cols_view_t , cols_view_t, myExecSpace>(ne, inputMat.graph.entries, columns_view);
-    KokkosKernels::Impl::copy_vector<in_row_map_view_t , row_map_view_t, myExecSpace>(nv+1, inputMat.graph.row_map, rowmap_view);
-
-    size_type ncols = 0;
-    KokkosKernels::Impl::view_reduce_max<cols_view_t, myExecSpace>(ne, columns_view, ncols);
-    ncols += 1;
-
-    graph_t static_graph (columns_view, rowmap_view);
-    out_crsMat_t crsmat("CrsMatrix", ncols, values_view, static_graph);
+    graph_t static_graph (columns_view, rowmap_view, inputMat.numCols());
+    out_crsMat_t crsmat("CrsMatrix", inputMat.numCols(), values_view, static_graph);
     return crsmat;
-    */
+}
+
+//multiplications of A x B, and the largest number of them in a row, computed on the host.
+template <typename a_crsMat_t, typename b_crsMat_t>
+void get_spgemm_flops(a_crsMat_t a_mat, b_crsMat_t b_mat, size_t &flops, size_t &max_row_flops){
+
+    auto a_row_map = Kokkos::create_mirror_view(a_mat.graph.row_map);
+    auto a_entries = Kokkos::create_mirror_view(a_mat.graph.entries);
+    auto b_row_map = Kokkos::create_mirror_view(b_mat.graph.row_map);
+    Kokkos::deep_copy(a_row_map, a_mat.graph.row_map);
+    Kokkos::deep_copy(a_entries, a_mat.graph.entries);
+    Kokkos::deep_copy(b_row_map, b_mat.graph.row_map);
+
+    flops = 0;
+    max_row_flops = 0;
+    const size_t nv = a_mat.numRows();
+    for (size_t i = 0; i < nv; ++i){
+      size_t row_flops = 0;
+      for (size_t j = a_row_map(i); j < size_t(a_row_map(i + 1)); ++j){
+        const size_t col = a_entries(j);
+        row_flops += b_row_map(col + 1) - b_row_map(col);
+      }
+      flops += row_flops;
+      if (row_flops > max_row_flops) max_row_flops = row_flops;
+    }
 }
 }
@@ -41,13 +41,15 @@
 //@HEADER
 */
 
+#include "KokkosKernels_Benchmark.hpp"
+
 namespace KokkosKernels{
 
 namespace Experiment{
-struct Parameters{
+// repeat, warmup, the backend and the report format come from BenchmarkOptions
+struct Parameters : public BenchmarkOptions{
   int algorithm;
   int accumulator;
-  int repeat;
   int chunk_size;
   int multi_color_scale;
   int shmemsize;
@@ -60,24 +62,32 @@ struct Parameters{
   int mkl_sort_option;
   int mkl_keep_output;
   int calculate_read_write_cost;
+  int use_complex;
+  int use_prefetch;
   char *coloring_input_file;
   char *coloring_output_file;
 
   int minhashscale;
-  int use_threads;
-  int use_openmp;
-  int use_cuda;
-  int use_serial;
   int a_mem_space, b_mem_space, c_mem_space, work_mem_space;
+  //bytes of the fast memory, if not 0 the placement policy sets the mem_spaces.
+  size_t fast_memory_size;
 
 
 
   char *a_mtx_bin_file, *b_mtx_bin_file, *c_mtx_bin_file;
+  //the tuning database the runs are recorded in, see KokkosKernels::Impl::TuningDatabase.
+  char *tuning_file;
+  //the algorithm spgemm is compared against, e.g. SPGEMM_MKL, -1 for none.
+  int compare_algorithm;
   bool compression2step;
   int left_lower_triangle, right_lower_triangle;
   int left_sort, right_sort;
+  int relabel_by_degree;
+  int symmetrize;
 
   int triangle_options;
+  int coloring_ordering; // the ColoringOrdering of the coloring, -1 for all of them.
+  int coloring_deterministic; // whether the coloring must not depend on the execution space.
   bool apply_compression;
   int sort_option;
   // 0 - triangle_count
@@ -107,22 +117,27 @@ struct Parameters{
     mkl_sort_option = 7;
     mkl_keep_output = 1;
     calculate_read_write_cost = 0;
+    use_complex = 0;
+    use_prefetch = 0;
     coloring_input_file = NULL;
     coloring_output_file = NULL;
     minhashscale = 1;
-    use_threads = 0;
-    use_openmp = 0;
-    use_cuda = 0;
-    use_serial = 0;
     a_mem_space = b_mem_space = c_mem_space = work_mem_space = 1;
+    fast_memory_size = 0;
     a_mtx_bin_file = b_mtx_bin_file = c_mtx_bin_file = NULL;
+    tuning_file = NULL;
+    compare_algorithm = -1;
     compression2step = true;
 
     left_lower_triangle = 0;
     right_lower_triangle = 0;
     left_sort = 0;
     right_sort = 2; //algorithm decides
+    relabel_by_degree = 0;
+    symmetrize = 0;
     triangle_options=0;
+    coloring_ordering = 0;
+    coloring_deterministic = 0;
     apply_compression = true;
     sort_option = -1;
     cache_flush = 1;
@@ -0,0 +1,156 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include "KokkosKernels_Profiling.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosBlas3_gemm.hpp"
+#include <string>
+#include <vector>
+
+namespace Test {
+
+struct KernelCountsRecord{
+  std::string name;
+  double flops, bytes, seconds;
+};
+
+inline std::vector<KernelCountsRecord> &kernel_counts_records(){
+  static std::vector<KernelCountsRecord> records;
+  return records;
+}
+
+inline void record_kernel_counts(const char *name, double flops, double bytes, double seconds){
+  KernelCountsRecord record;
+  record.name = name;
+  record.flops = flops;
+  record.bytes = bytes;
+  record.seconds = seconds;
+  kernel_counts_records().push_back(record);
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void run_kernel_counts_kernels(
+    const KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> &A,
+    lno_t m, lno_t n, lno_t k){
+  typedef Kokkos::View<scalar_t*, device> vector_t;
+  typedef Kokkos::View<scalar_t**, Kokkos::LayoutLeft, device> matrix_t;
+
+  vector_t x("x", A.numCols());
+  vector_t y("y", A.numRows());
+  Kokkos::deep_copy(x, scalar_t(1));
+  KokkosSparse::spmv("N", scalar_t(1), A, x, scalar_t(0), y);
+  KokkosSparse::spmv("N", scalar_t(1), A, x, scalar_t(1), y);
+
+  matrix_t a("a", m, k);
+  matrix_t b("b", k, n);
+  matrix_t c("c", m, n);
+  Kokkos::deep_copy(a, scalar_t(1));
+  Kokkos::deep_copy(b, scalar_t(1));
+  KokkosBlas::gemm("N", "N", scalar_t(1), a, b, scalar_t(0), c);
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_kernel_counts(lno_t numRows, size_type nnz, lno_t m, lno_t n, lno_t k){
+  typedef KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, 5, numRows / 4);
+
+  //without a callback nothing is reported, and the kernels are not fenced to be timed.
+  ASSERT_TRUE(KokkosKernels::get_kernel_counts_callback() == NULL);
+  kernel_counts_records().clear();
+  const size_t num_fences = KokkosKernels::Impl::kernel_counts_num_fences();
+  run_kernel_counts_kernels<scalar_t, lno_t, size_type, device>(A, m, n, k);
+  EXPECT_EQ(kernel_counts_records().size(), size_t(0));
+  EXPECT_EQ(KokkosKernels::Impl::kernel_counts_num_fences(), num_fences);
+
+  KokkosKernels::set_kernel_counts_callback(record_kernel_counts);
+  EXPECT_TRUE(KokkosKernels::get_kernel_counts_callback() == record_kernel_counts);
+  run_kernel_counts_kernels<scalar_t, lno_t, size_type, device>(A, m, n, k);
+  KokkosKernels::set_kernel_counts_callback(NULL);
+  EXPECT_TRUE(KokkosKernels::get_kernel_counts_callback() == NULL);
+
+  const std::vector<KernelCountsRecord> &records = kernel_counts_records();
+  ASSERT_EQ(records.size(), size_t(3));
+
+  //spmv reads A, its row map and x once, and y once more if beta != 0.
+  const double spmv_flops = 2.0 * A.nnz();
+  const double y_bytes = double(numRows) * sizeof(scalar_t);
+  const double spmv_bytes = A.nnz() * double(sizeof(scalar_t) + sizeof(lno_t)) +
+                            (numRows + 1) * double(sizeof(size_type)) +
+                            double(numRows) * sizeof(scalar_t);
+  for (int i = 0; i < 2; ++i){
+    EXPECT_EQ(records[i].name, std::string("KokkosSparse::spmv"));
+    EXPECT_EQ(records[i].flops, spmv_flops);
+    EXPECT_GE(records[i].seconds, 0.0);
+  }
+  EXPECT_EQ(records[0].bytes, spmv_bytes + y_bytes);
+  EXPECT_EQ(records[1].bytes, spmv_bytes + 2 * y_bytes);
+
+  //gemm reads A and B once, and reads and writes C.
+  EXPECT_EQ(records[2].name, std::string("KokkosBlas::gemm"));
+  EXPECT_EQ(records[2].flops, 2.0 * m * n * k);
+  EXPECT_EQ(records[2].bytes, (double(m) * k + double(k) * n + 2.0 * m * n) * sizeof(scalar_t));
+  EXPECT_GE(records[2].seconds, 0.0);
+
+  //once removed, the callback is not called any more.
+  kernel_counts_records().clear();
+  run_kernel_counts_kernels<scalar_t, lno_t, size_type, device>(A, m, n, k);
+  EXPECT_EQ(kernel_counts_records().size(), size_t(0));
+}
+
+}
+
+#if !defined(KOKKOSKERNELS_DISABLE_PROFILING_REGIONS)
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_LAYOUTLEFT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, common_kernel_counts ) {
+  Test::test_kernel_counts<double, int, int, TestExecSpace>(1000, 1000 * 10, 30, 20, 10);
+}
+#endif
+#endif
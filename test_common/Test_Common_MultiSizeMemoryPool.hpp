@@ -0,0 +1,253 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include "KokkosKernels_MultiSize_MemoryPool.hpp"
+#include <vector>
+
+namespace Test {
+
+//allocates and releases chunks of a pool with classes of 1, 2 and 1 chunks of
+//4, 8 and 16 entries in a fixed order, on a single thread.
+template <typename pool_t, typename error_view_t>
+struct MultiSizePoolSequential{
+  pool_t pool;
+  error_view_t errors;
+  MultiSizePoolSequential(pool_t pool_, error_view_t errors_): pool(pool_), errors(errors_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void check(const bool ok) const {
+    if (!ok) ++errors(0);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int) const {
+    int *a = pool.allocate_chunk(1);
+    check(a != NULL && pool.get_chunk_size(a) == 4);
+    //class 0 is exhausted, so the next ones fall back to class 1.
+    int *b = pool.allocate_chunk(1);
+    check(b != NULL && pool.get_chunk_size(b) == 8);
+    int *c = pool.allocate_chunk(3);
+    check(c != NULL && pool.get_chunk_size(c) == 8);
+    int *d = pool.allocate_chunk(1);
+    check(d != NULL && pool.get_chunk_size(d) == 16);
+    //all chunks are in use, and no class holds 17 entries.
+    check(pool.allocate_chunk(1) == NULL);
+    check(pool.allocate_chunk(17) == NULL);
+
+    //the fallback chunk goes back to class 1, not to class 0.
+    pool.release_chunk(b);
+    int *e = pool.allocate_chunk(5);
+    check(e == b && pool.get_chunk_size(e) == 8);
+    check(pool.allocate_chunk(1) == NULL);
+
+    pool.release_chunk(a);
+    pool.release_chunk(c);
+    pool.release_chunk(d);
+    pool.release_chunk(e);
+    int *f = pool.allocate_chunk(9);
+    check(f == d);
+    int *g = pool.allocate_chunk(1);
+    check(g == a);
+    pool.release_chunk(f);
+    pool.release_chunk(g);
+  }
+};
+
+//each iteration allocates a chunk, marks it as taken in its first entry,
+//fills the rest with its own id and checks that no other iteration wrote to it.
+template <typename pool_t, typename error_view_t>
+struct MultiSizePoolConcurrent{
+  pool_t pool;
+  error_view_t errors;
+  error_view_t num_allocated;
+  size_t min_chunk_size, max_chunk_size;
+  MultiSizePoolConcurrent(pool_t pool_, error_view_t errors_, error_view_t num_allocated_,
+                          size_t min_chunk_size_, size_t max_chunk_size_):
+    pool(pool_), errors(errors_), num_allocated(num_allocated_),
+    min_chunk_size(min_chunk_size_), max_chunk_size(max_chunk_size_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int i) const {
+    //most requests fit class 0, which has too few chunks, so they fall back.
+    const size_t size = (i % 8 == 0) ? 1 + (i / 8) % max_chunk_size : 1 + i % min_chunk_size;
+    int *chunk = pool.allocate_chunk(size);
+    if (chunk == NULL) return;
+    Kokkos::atomic_fetch_add(&(num_allocated(0)), 1);
+
+    const size_t chunk_size = pool.get_chunk_size(chunk);
+    if (chunk_size < size) Kokkos::atomic_fetch_add(&(errors(0)), 1);
+    if (Kokkos::atomic_fetch_add(chunk, 1) != 0) Kokkos::atomic_fetch_add(&(errors(0)), 1);
+
+    volatile int *entries = chunk;
+    for (size_t j = 1; j < chunk_size; ++j) entries[j] = i + 1;
+    for (size_t j = 1; j < chunk_size; ++j){
+      if (entries[j] != i + 1) Kokkos::atomic_fetch_add(&(errors(0)), 1);
+    }
+    for (size_t j = 1; j < chunk_size; ++j) entries[j] = 0;
+    Kokkos::atomic_fetch_add(chunk, -1);
+    pool.release_chunk(chunk);
+  }
+};
+
+//takes every chunk once, from the largest class down so that nothing falls back,
+//and checks that each class stack holds exactly its own free chunks.
+template <typename pool_t, typename error_view_t, typename count_view_t>
+struct MultiSizePoolSweep{
+  pool_t pool;
+  error_view_t errors;
+  count_view_t num_class_chunks;
+  MultiSizePoolSweep(pool_t pool_, error_view_t errors_, count_view_t num_class_chunks_):
+    pool(pool_), errors(errors_), num_class_chunks(num_class_chunks_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int) const {
+    for (int c = pool.get_num_classes() - 1; c >= 0; --c){
+      const size_t chunk_size = pool.get_class_chunk_size(c);
+      for (size_t k = 0; k < num_class_chunks(c); ++k){
+        int *chunk = pool.allocate_chunk(chunk_size);
+        if (chunk == NULL || pool.get_chunk_size(chunk) != chunk_size || chunk[0] != 0){
+          ++errors(0);
+          continue;
+        }
+        chunk[0] = 1;
+      }
+    }
+    if (pool.allocate_chunk(1) != NULL) ++errors(0);
+  }
+};
+
+}
+
+template <typename device>
+void test_multisize_memory_pool_sequential() {
+  typedef KokkosKernels::Impl::MultiSizeMemoryPool<device, int> pool_t;
+  typedef Kokkos::View<int *, device> error_view_t;
+  typedef Kokkos::RangePolicy<typename device::execution_space> range_policy_t;
+
+  std::vector<size_t> num_class_chunks;
+  num_class_chunks.push_back(1);
+  num_class_chunks.push_back(2);
+  num_class_chunks.push_back(1);
+  pool_t pool(4, num_class_chunks);
+  EXPECT_EQ(pool.get_num_chunks(), size_t(4));
+  EXPECT_EQ(pool.get_overall_size(), size_t(4 + 2 * 8 + 16));
+
+  error_view_t errors("errors", 1);
+  Kokkos::parallel_for("MultiSizePoolSequential", range_policy_t(0, 1),
+                       Test::MultiSizePoolSequential<pool_t, error_view_t>(pool, errors));
+  typename error_view_t::HostMirror h_errors = Kokkos::create_mirror_view(errors);
+  Kokkos::deep_copy(h_errors, errors);
+  EXPECT_EQ(h_errors(0), 0);
+}
+
+template <typename device>
+void test_multisize_memory_pool_concurrent(int num_iterations, int num_rounds) {
+  typedef KokkosKernels::Impl::MultiSizeMemoryPool<device, int> pool_t;
+  typedef Kokkos::View<int *, device> error_view_t;
+  typedef Kokkos::View<size_t *, device> count_view_t;
+  typedef Kokkos::RangePolicy<typename device::execution_space> range_policy_t;
+
+  const size_t min_chunk_size = 4;
+  const size_t chunk_counts[] = {2, 16, 16, 8, 8, 4};
+  const int num_classes = sizeof(chunk_counts) / sizeof(chunk_counts[0]);
+  std::vector<size_t> num_class_chunks(chunk_counts, chunk_counts + num_classes);
+  pool_t pool(min_chunk_size, num_class_chunks);
+  const size_t max_chunk_size = pool.get_class_chunk_size(num_classes - 1);
+
+  error_view_t errors("errors", 1);
+  error_view_t num_allocated("num_allocated", 1);
+  typename error_view_t::HostMirror h_errors = Kokkos::create_mirror_view(errors);
+  typename error_view_t::HostMirror h_num_allocated = Kokkos::create_mirror_view(num_allocated);
+
+  //the chunks are released and allocated again many times in each round,
+  //which corrupts the class stacks if a stale head wins a compare-exchange.
+  for (int round = 0; round < num_rounds; ++round){
+    Kokkos::parallel_for("MultiSizePoolConcurrent", range_policy_t(0, num_iterations),
+                         Test::MultiSizePoolConcurrent<pool_t, error_view_t>(
+                           pool, errors, num_allocated, min_chunk_size, max_chunk_size));
+    Kokkos::fence();
+  }
+  Kokkos::deep_copy(h_errors, errors);
+  Kokkos::deep_copy(h_num_allocated, num_allocated);
+  EXPECT_EQ(h_errors(0), 0);
+  EXPECT_GT(h_num_allocated(0), 0);
+
+  count_view_t d_num_class_chunks("num_class_chunks", num_classes);
+  typename count_view_t::HostMirror h_num_class_chunks = Kokkos::create_mirror_view(d_num_class_chunks);
+  for (int c = 0; c < num_classes; ++c) h_num_class_chunks(c) = num_class_chunks[c];
+  Kokkos::deep_copy(d_num_class_chunks, h_num_class_chunks);
+
+  Kokkos::parallel_for("MultiSizePoolSweep", range_policy_t(0, 1),
+                       Test::MultiSizePoolSweep<pool_t, error_view_t, count_view_t>(pool, errors, d_num_class_chunks));
+  Kokkos::deep_copy(h_errors, errors);
+  EXPECT_EQ(h_errors(0), 0);
+}
+
+template <typename device>
+void test_multisize_memory_pool_head_tags() {
+  typedef KokkosKernels::Impl::MultiSizeMemoryPool<device, int> pool_t;
+  typedef typename pool_t::head_type head_type;
+  typedef typename pool_t::chunk_index_type chunk_index_type;
+
+  //the counter wraps around to 0 without touching the chunk index.
+  const head_type last_tag = head_type(0xffffffff) << 32;
+  EXPECT_EQ(pool_t::get_next_head(last_tag | head_type(3), 5), head_type(5));
+  EXPECT_EQ(pool_t::get_head_chunk(pool_t::get_next_head(last_tag, 0xffffffff)), chunk_index_type(0xffffffff));
+
+  //chunk 7 popped and pushed back gives the same top chunk, but a different
+  //head, so a thread still holding the first head fails its compare-exchange.
+  const head_type h0 = pool_t::get_next_head(head_type(41) << 32, 7);
+  const head_type h1 = pool_t::get_next_head(h0, 9);
+  const head_type h2 = pool_t::get_next_head(h1, 7);
+  EXPECT_EQ(pool_t::get_head_chunk(h2), chunk_index_type(7));
+  EXPECT_NE(h2, h0);
+}
+
+TEST_F( TestCategory, common_multisize_memory_pool ) {
+  test_multisize_memory_pool_head_tags<TestExecSpace>();
+  test_multisize_memory_pool_sequential<TestExecSpace>();
+  test_multisize_memory_pool_concurrent<TestExecSpace>(100000, 4);
+}
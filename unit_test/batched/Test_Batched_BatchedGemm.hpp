@@ -0,0 +1,141 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_Gemm_Decl.hpp"
+#include "KokkosBatched_Gemm_Serial_Impl.hpp"
+#include "KokkosBatched_Gemm_Batched_Decl.hpp"
+#include "KokkosBatched_Gemm_Batched_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename TA, typename TB>
+  struct ParamTag {
+    typedef TA transA;
+    typedef TB transB;
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename ScalarType,
+           typename ParamTagType>
+  struct Functor_TestBatchedBatchedGemm {
+    ViewType _a, _b, _c;
+
+    ScalarType _alpha, _beta;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedBatchedGemm(const ScalarType alpha, const ViewType &a, const ViewType &b, const ScalarType beta, const ViewType &c)
+      : _a(a), _b(b), _c(c), _alpha(alpha), _beta(beta) {}
+
+    /// reference; one matrix per index
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const int k) const {
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      auto bb = Kokkos::subview(_b, k, Kokkos::ALL(), Kokkos::ALL());
+      auto cc = Kokkos::subview(_c, k, Kokkos::ALL(), Kokkos::ALL());
+
+      SerialGemm<typename ParamTagType::transA,
+          typename ParamTagType::transB,
+          Algo::Gemm::Unblocked>::
+          invoke(_alpha, aa, bb, _beta, cc);
+    }
+
+    inline
+    void run() {
+      Kokkos::RangePolicy<DeviceType> policy(0, _c.extent(0));
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename ScalarType,
+           typename ParamTagType>
+  void impl_test_batched_batched_gemm(const int N, const int BlkSize) {
+    typedef typename ViewType::value_type value_type;
+    typedef Kokkos::Details::ArithTraits<value_type> ats;
+
+    /// randomized input testing views
+    ScalarType alpha = 1.5, beta = 3.0;
+
+    ViewType
+      a0("a0", N, BlkSize, BlkSize),
+      b0("b0", N, BlkSize, BlkSize),
+      c0("c0", N, BlkSize, BlkSize), c1("c1", N, BlkSize, BlkSize);
+
+    Kokkos::Random_XorShift64_Pool<typename DeviceType::execution_space> random(13718);
+    Kokkos::fill_random(a0, random, value_type(1.0));
+    Kokkos::fill_random(b0, random, value_type(1.0));
+    Kokkos::fill_random(c0, random, value_type(1.0));
+
+    Kokkos::fence();
+
+    Kokkos::deep_copy(c1, c0);
+
+    /// serial unblocked is the reference
+    Functor_TestBatchedBatchedGemm<DeviceType,ViewType,ScalarType,ParamTagType>(alpha, a0, b0, beta, c0).run();
+    BatchedGemm<typename ParamTagType::transA,
+                typename ParamTagType::transB>::invoke(alpha, a0, b0, beta, c1);
+
+    Kokkos::fence();
+
+    /// for comparison send it to host
+    typename ViewType::HostMirror c0_host = Kokkos::create_mirror_view(c0);
+    typename ViewType::HostMirror c1_host = Kokkos::create_mirror_view(c1);
+
+    Kokkos::deep_copy(c0_host, c0);
+    Kokkos::deep_copy(c1_host, c1);
+
+    /// check c0 = c1 ; this eps is about 10^-14
+    typedef typename ats::mag_type mag_type;
+    mag_type sum(1), diff(0);
+    const mag_type eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k)
+      for (int i=0;i<BlkSize;++i)
+        for (int j=0;j<BlkSize;++j) {
+          sum  += ats::abs(c0_host(k,i,j));
+          diff += ats::abs(c0_host(k,i,j)-c1_host(k,i,j));
+        }
+    EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+}
+
+
+template<typename DeviceType,
+         typename ValueType,
+         typename ScalarType,
+         typename ParamTagType>
+int test_batched_batched_gemm() {
+  /// sizes covering the serial, team vector and team kernels
+  const int BlkSizes[] = { 1, 3, 4, 5, 8, 9, 16, 32, 40 };
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutLeft,DeviceType> ViewType;
+    Test::impl_test_batched_batched_gemm<DeviceType,ViewType,ScalarType,ParamTagType>(     0, 10);
+    for (int i=0;i<9;++i) {
+      Test::impl_test_batched_batched_gemm<DeviceType,ViewType,ScalarType,ParamTagType>( 217, BlkSizes[i]);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutRight,DeviceType> ViewType;
+    Test::impl_test_batched_batched_gemm<DeviceType,ViewType,ScalarType,ParamTagType>(     0, 10);
+    for (int i=0;i<9;++i) {
+      Test::impl_test_batched_batched_gemm<DeviceType,ViewType,ScalarType,ParamTagType>( 217, BlkSizes[i]);
+    }
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_BlockTridiag_Decl.hpp"
+#include "KokkosBatched_BlockTridiag_Serial_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  // scalar access into (possibly packed) leading dimension
+  template<typename ScalarType, typename ViewType>
+  typename std::enable_if<std::is_same<typename ViewType::value_type,ScalarType>::value,ScalarType&>::type
+  btd_val(const ViewType &A, const int t, const int i, const int j, const int k) {
+    return A(t, i, j, k);
+  }
+
+  template<typename ScalarType, typename ViewType>
+  typename std::enable_if<!std::is_same<typename ViewType::value_type,ScalarType>::value,ScalarType&>::type
+  btd_val(const ViewType &A, const int t, const int i, const int j, const int k) {
+    typedef typename ViewType::value_type value_type;
+    return A(t/value_type::vector_length, i, j, k)[t%value_type::vector_length];
+  }
+
+  template<typename DeviceType,
+           typename ScalarType,
+           typename ValueType,
+           typename ArrayLayout>
+  void impl_test_batched_block_tridiag(const int N, const int nrows, const int blksize, const int nvectors) {
+    typedef Kokkos::Details::ArithTraits<ScalarType> ats;
+    typedef typename ats::mag_type mag_type;
+    typedef BlockTridiagMatrices<DeviceType,ValueType,ArrayLayout> tridiag_type;
+    typedef PartitionedBlockMultiVector<DeviceType,ValueType,ArrayLayout> multivector_type;
+    typedef Kokkos::DefaultHostExecutionSpace host_space;
+
+    tridiag_type T = create_block_tridiag_matrices<DeviceType,ValueType,ArrayLayout>(N, nrows, blksize);
+    multivector_type 
+      x = create_partitioned_block_multi_vector<DeviceType,ValueType,ArrayLayout>(N, nvectors, nrows, blksize),
+      b = create_partitioned_block_multi_vector<DeviceType,ValueType,ArrayLayout>(N, nvectors, nrows, blksize);
+
+    auto T0 = create_mirror<host_space>(T);
+    auto x_host = create_mirror<host_space>(x);
+    auto b_host = create_mirror<host_space>(b);
+
+    /// diagonally dominant pseudo random input
+    auto A = T0.A(), B = T0.B(), C = T0.C(), bv = b_host.Values();
+    for (int t=0;t<N;++t) {
+      for (int i=0;i<nrows;++i)
+        for (int ii=0;ii<blksize;++ii) {
+          for (int jj=0;jj<blksize;++jj) {
+            const ScalarType v = ScalarType((t+3*i+5*ii+7*jj)%11)/11.0 - 0.5;
+            btd_val<ScalarType>(A, t, i, ii, jj) = (ii == jj ? ScalarType(4*blksize) + v : v);
+            if (i < (nrows-1)) {
+              btd_val<ScalarType>(B, t, i, ii, jj) = ScalarType(0.5)*v;
+              btd_val<ScalarType>(C, t, i, ii, jj) = ScalarType(0.25)*v + ScalarType(0.1);
+            }
+          }
+          for (int j=0;j<nvectors;++j) 
+            btd_val<ScalarType>(bv, t, j, i, ii) = ScalarType((t+i+ii+2*j)%7) - 3.0;
+        }
+    }
+    deep_copy(T, T0);
+    deep_copy(b, b_host);
+
+    /// keep a copy of the un-factored blocks for the residual
+    auto T1 = create_block_tridiag_matrices<host_space,ValueType,ArrayLayout>(N, nrows, blksize);
+    deep_copy(T1, T0);
+
+    BlockTridiagFactorize<Algo::LU::Blocked,Algo::Trsm::Blocked,Algo::Gemm::Blocked>::invoke(T);
+    BlockTridiagSolve<Algo::Trsv::Blocked,Algo::Gemv::Unblocked>::invoke(T, x, b);
+
+    /// in place solve with x == b
+    BlockTridiagSolve<Algo::Trsv::Blocked,Algo::Gemv::Unblocked>::invoke(T, b, b);
+    
+    Kokkos::fence();
+
+    deep_copy(x_host, x);
+    auto xv = x_host.Values();
+    auto bin = create_mirror<host_space>(b);
+    deep_copy(bin, b);
+    auto xi = bin.Values();
+
+    /// residual r = T x - b computed on host
+    A = T1.A(); B = T1.B(); C = T1.C();
+    mag_type sum(1), diff(0), diff_inplace(0);
+    const mag_type eps = 1.0e3 * ats::epsilon();
+    for (int t=0;t<N;++t)
+      for (int j=0;j<nvectors;++j)
+        for (int i=0;i<nrows;++i)
+          for (int ii=0;ii<blksize;++ii) {
+            ScalarType r = -btd_val<ScalarType>(bv, t, j, i, ii);
+            for (int jj=0;jj<blksize;++jj) {
+              r += btd_val<ScalarType>(A, t, i, ii, jj)*btd_val<ScalarType>(xv, t, j, i, jj);
+              if (i < (nrows-1)) 
+                r += btd_val<ScalarType>(B, t, i, ii, jj)*btd_val<ScalarType>(xv, t, j, i+1, jj);
+              if (i > 0)
+                r += btd_val<ScalarType>(C, t, i-1, ii, jj)*btd_val<ScalarType>(xv, t, j, i-1, jj);
+            }
+            sum  += ats::abs(btd_val<ScalarType>(bv, t, j, i, ii));
+            diff += ats::abs(r);
+            diff_inplace += ats::abs(btd_val<ScalarType>(xv, t, j, i, ii) - btd_val<ScalarType>(xi, t, j, i, ii));
+          }
+    EXPECT_NEAR_KK( diff/sum, 0, eps);
+    EXPECT_NEAR_KK( diff_inplace/sum, 0, eps);
+  }
+}
+
+template<typename DeviceType,
+         typename ScalarType,
+         typename ValueType>
+int test_batched_block_tridiag() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::LayoutLeft layout_type;
+    Test::impl_test_batched_block_tridiag<DeviceType,ScalarType,ValueType,layout_type>( 0, 4, 3, 1);
+    for (int bs=1;bs<6;++bs) 
+      Test::impl_test_batched_block_tridiag<DeviceType,ScalarType,ValueType,layout_type>(37, 5, bs, 2);
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::LayoutRight layout_type;
+    Test::impl_test_batched_block_tridiag<DeviceType,ScalarType,ValueType,layout_type>( 0, 4, 3, 1);
+    for (int bs=1;bs<6;++bs) 
+      Test::impl_test_batched_block_tridiag<DeviceType,ScalarType,ValueType,layout_type>(37, 5, bs, 2);
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,16 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_scalar_block_tridiag_float ) {
+  test_batched_block_tridiag<TestExecSpace,float,float>();
+}
+#endif
+
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_scalar_block_tridiag_double ) {
+  test_batched_block_tridiag<TestExecSpace,double,double>();
+}
+TEST_F( TestCategory, batched_vector_block_tridiag_double ) {
+  typedef Vector<SIMD<double>,4> vector_type;
+  test_batched_block_tridiag<TestExecSpace,double,vector_type>();
+}
+#endif
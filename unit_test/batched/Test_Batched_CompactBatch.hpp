@@ -0,0 +1,95 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_CompactBatch_Decl.hpp"
+#include "KokkosBatched_CompactBatch_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename DeviceType,
+           typename ScalarType,
+           typename VectorType,
+           typename ArrayLayout>
+  void impl_test_batched_compact_batch(const int N, const int m, const int n) {
+    typedef Kokkos::View<ScalarType***,ArrayLayout,DeviceType> ViewType;
+    typedef CompactBatch<DeviceType,VectorType> compact_batch_type;
+    enum : int { vector_length = VectorType::vector_length };
+
+    ViewType a("a", N, m, n), b("b", N, m, n);
+    Kokkos::Random_XorShift64_Pool<typename DeviceType::execution_space> random(13718);
+    Kokkos::fill_random(a, random, ScalarType(1.0));
+
+    compact_batch_type c = create_compact_batch<DeviceType,VectorType>(N, m, n);
+    EXPECT_EQ( c.NumPacks(), N/vector_length + (N%vector_length > 0));
+
+    pack_compact_batch(c, a);
+    unpack_compact_batch(b, c);
+
+    Kokkos::fence();
+
+    typename ViewType::HostMirror a_host = Kokkos::create_mirror_view(a);
+    typename ViewType::HostMirror b_host = Kokkos::create_mirror_view(b);
+    Kokkos::deep_copy(a_host, a);
+    Kokkos::deep_copy(b_host, b);
+
+    auto c_host = create_mirror<Kokkos::DefaultHostExecutionSpace>(c);
+    deep_copy(c_host, c);
+    auto cv = c_host.Values();
+
+    /// round trip and interleaving
+    int diff = 0;
+    for (int k=0;k<N;++k)
+      for (int i=0;i<m;++i)
+        for (int j=0;j<n;++j) {
+          diff += (a_host(k,i,j) != b_host(k,i,j));
+          diff += (a_host(k,i,j) != cv(k/vector_length,i,j)[k%vector_length]);
+        }
+    EXPECT_EQ( diff, 0);
+
+    /// padding lanes of the last pack hold the identity
+    int npad = 0;
+    if (c.NumPacks() > 0) {
+      const int p = c.NumPacks()-1;
+      for (int l=c.NumLanes(p);l<vector_length;++l)
+        for (int i=0;i<m;++i)
+          for (int j=0;j<n;++j)
+            npad += (cv(p,i,j)[l] != ScalarType(i == j ? 1 : 0));
+    }
+    EXPECT_EQ( npad, 0);
+  }
+}
+
+template<typename DeviceType,
+         typename ScalarType,
+         typename VectorType>
+int test_batched_compact_batch() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::LayoutLeft layout_type;
+    Test::impl_test_batched_compact_batch<DeviceType,ScalarType,VectorType,layout_type>( 0, 3, 3);
+    Test::impl_test_batched_compact_batch<DeviceType,ScalarType,VectorType,layout_type>( 1, 3, 3);
+    for (int i=1;i<10;++i)
+      Test::impl_test_batched_compact_batch<DeviceType,ScalarType,VectorType,layout_type>(37, i, i+1);
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::LayoutRight layout_type;
+    Test::impl_test_batched_compact_batch<DeviceType,ScalarType,VectorType,layout_type>( 0, 3, 3);
+    Test::impl_test_batched_compact_batch<DeviceType,ScalarType,VectorType,layout_type>( 1, 3, 3);
+    for (int i=1;i<10;++i)
+      Test::impl_test_batched_compact_batch<DeviceType,ScalarType,VectorType,layout_type>(37, i, i+1);
+  }
+#endif
+
+  return 0;
+}
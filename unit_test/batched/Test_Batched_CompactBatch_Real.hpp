@@ -0,0 +1,18 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_vector_compact_batch_float ) {
+  typedef Vector<SIMD<float>,8> vector_type;
+  test_batched_compact_batch<TestExecSpace,float,vector_type>();
+}
+#endif
+
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_vector_compact_batch_double ) {
+  typedef Vector<SIMD<double>,4> vector_type;
+  test_batched_compact_batch<TestExecSpace,double,vector_type>();
+}
+TEST_F( TestCategory, batched_vector_compact_batch_double_default_length ) {
+  typedef Vector<SIMD<double>,DefaultVectorLength<double,TestExecSpace::memory_space>::value> vector_type;
+  test_batched_compact_batch<TestExecSpace,double,vector_type>();
+}
+#endif
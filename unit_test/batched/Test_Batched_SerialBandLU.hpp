@@ -0,0 +1,141 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_BandLU_Decl.hpp"
+#include "KokkosBatched_BandLU_Serial_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename DeviceType,
+           typename ABViewType,
+           typename BViewType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedSerialBandLU {
+    ABViewType _ab;
+    BViewType _b;
+    int _kl, _ku;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedSerialBandLU(const ABViewType &ab, const int kl, const int ku, const BViewType &b)
+      : _ab(ab), _b(b), _kl(kl), _ku(ku) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const int k) const {
+      auto ab = Kokkos::subview(_ab, k, Kokkos::ALL(), Kokkos::ALL());
+      auto b  = Kokkos::subview(_b,  k, Kokkos::ALL());
+
+      SerialBandLU<AlgoTagType>::invoke(ab, _kl, _ku);
+      SerialBandLUSolve<AlgoTagType>::invoke(ab, _kl, _ku, b);
+    }
+
+    inline
+    void run() {
+      Kokkos::RangePolicy<DeviceType> policy(0, _ab.extent(0));
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename ABViewType,
+           typename BViewType,
+           typename AlgoTagType>
+  void impl_test_batched_band_lu(const int N, const int BlkSize, const int kl, const int ku) {
+    typedef typename ABViewType::value_type value_type;
+    typedef VectorLane<value_type> lane_type;
+    typedef typename lane_type::value_type scalar_type;
+    typedef Kokkos::Details::ArithTraits<scalar_type> ats;
+
+    const int vl = lane_type::vector_length;
+
+    ABViewType ab0("ab0", N, kl+ku+1, BlkSize), ab1("ab1", N, kl+ku+1, BlkSize);
+    BViewType b0("b0", N, BlkSize), x1("x1", N, BlkSize);
+
+    /// diagonally dominant band input; entries outside of the band are zero
+    typename ABViewType::HostMirror ab0_host = Kokkos::create_mirror_view(ab0);
+    typename BViewType::HostMirror b0_host = Kokkos::create_mirror_view(b0);
+
+    Kokkos::Random_XorShift64_Pool<Kokkos::DefaultHostExecutionSpace> random(13718);
+    auto gen = random.get_state();
+    for (int k=0;k<N;++k)
+      for (int l=0;l<vl;++l) 
+        for (int j=0;j<BlkSize;++j) {
+          for (int i=(j-ku > 0 ? j-ku : 0);i<=(j+kl < BlkSize-1 ? j+kl : BlkSize-1);++i)
+            lane_type::get(ab0_host(k,ku+i-j,j), l) = (i == j ? gen.drand(kl+ku+1.0, kl+ku+2.0) : gen.drand(-1.0, 1.0));
+          lane_type::get(b0_host(k,j), l) = gen.drand(-1.0, 1.0);
+        }
+    random.free_state(gen);
+
+    Kokkos::deep_copy(ab0, ab0_host);
+    Kokkos::deep_copy(b0,  b0_host);
+    Kokkos::deep_copy(ab1, ab0);
+    Kokkos::deep_copy(x1,  b0);
+
+    Functor_TestBatchedSerialBandLU<DeviceType,ABViewType,BViewType,AlgoTagType>(ab1, kl, ku, x1).run();
+
+    Kokkos::fence();
+
+    typename BViewType::HostMirror x1_host = Kokkos::create_mirror_view(x1);
+    Kokkos::deep_copy(x1_host, x1);
+
+    /// normwise backward error |A x - b| / (|A| |x| + |b|)
+    typedef typename ats::mag_type mag_type;
+    mag_type sum(0), diff(0);
+    const mag_type eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k)
+      for (int l=0;l<vl;++l)
+        for (int i=0;i<BlkSize;++i) {
+          scalar_type r = -lane_type::get(b0_host(k,i), l);
+          sum += ats::abs(lane_type::get(b0_host(k,i), l));
+          for (int j=(i-kl > 0 ? i-kl : 0);j<=(i+ku < BlkSize-1 ? i+ku : BlkSize-1);++j) {
+            const scalar_type 
+              aij = lane_type::get(ab0_host(k,ku+i-j,j), l),
+              xj = lane_type::get(x1_host(k,j), l);
+            r += aij*xj;
+            sum += ats::abs(aij)*ats::abs(xj);
+          }
+          diff += ats::abs(r);
+        }
+    if (sum > 0) EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+}
+
+
+template<typename DeviceType,
+         typename ValueType,
+         typename AlgoTagType>
+int test_batched_band_lu() {
+  /// (kl,ku) pairs including diagonal, bidiagonal and wide bands
+  const int Bands[][2] = { {0,0}, {1,0}, {0,1}, {1,1}, {2,3}, {4,4}, {8,8} };
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutLeft,DeviceType> ABViewType;
+    typedef Kokkos::View<ValueType**,Kokkos::LayoutLeft,DeviceType> BViewType;
+    Test::impl_test_batched_band_lu<DeviceType,ABViewType,BViewType,AlgoTagType>(     0, 10, 1, 1);
+    for (int b=0;b<7;++b)
+      for (int i=0;i<20;i+=3) 
+        Test::impl_test_batched_band_lu<DeviceType,ABViewType,BViewType,AlgoTagType>(1024, i, Bands[b][0], Bands[b][1]);
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutRight,DeviceType> ABViewType;
+    typedef Kokkos::View<ValueType**,Kokkos::LayoutRight,DeviceType> BViewType;
+    Test::impl_test_batched_band_lu<DeviceType,ABViewType,BViewType,AlgoTagType>(     0, 10, 1, 1);
+    for (int b=0;b<7;++b)
+      for (int i=0;i<20;i+=3) 
+        Test::impl_test_batched_band_lu<DeviceType,ABViewType,BViewType,AlgoTagType>(1024, i, Bands[b][0], Bands[b][1]);
+  }
+#endif
+
+  return 0;
+}
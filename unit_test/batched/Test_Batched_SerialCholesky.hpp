@@ -0,0 +1,149 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_Cholesky_Decl.hpp"
+#include "KokkosBatched_Cholesky_Serial_Impl.hpp"
+#include "KokkosBatched_Trsm_Decl.hpp"
+#include "KokkosBatched_Trsm_Serial_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedSerialCholesky {
+    ViewType _a, _b;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedSerialCholesky(const ViewType &a, const ViewType &b) 
+      : _a(a), _b(b) {} 
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const int k) const {
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      auto bb = Kokkos::subview(_b, k, Kokkos::ALL(), Kokkos::ALL());
+
+      SerialCholesky<AlgoTagType>::invoke(aa);
+      SerialTrsm<Side::Left,Uplo::Upper,Trans::Transpose,  Diag::NonUnit,AlgoTagType>::invoke(1.0, aa, bb);
+      SerialTrsm<Side::Left,Uplo::Upper,Trans::NoTranspose,Diag::NonUnit,AlgoTagType>::invoke(1.0, aa, bb);
+    }
+
+    inline
+    void run() {
+      Kokkos::RangePolicy<DeviceType> policy(0, _a.extent(0));
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  void impl_test_batched_cholesky(const int N, const int BlkSize, const int NumVecs) {
+    typedef typename ViewType::value_type value_type;
+    typedef VectorLane<value_type> lane_type;
+    typedef typename lane_type::value_type scalar_type;
+    typedef Kokkos::Details::ArithTraits<scalar_type> ats;
+
+    const int vl = lane_type::vector_length;
+
+    ViewType 
+      a0("a0", N, BlkSize, BlkSize), a1("a1", N, BlkSize, BlkSize),
+      b0("b0", N, BlkSize, NumVecs), x1("x1", N, BlkSize, NumVecs);
+
+    typename ViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+    typename ViewType::HostMirror b0_host = Kokkos::create_mirror_view(b0);
+
+    /// spd input a = m^T m + I with random m
+    Kokkos::Random_XorShift64_Pool<Kokkos::DefaultHostExecutionSpace> random(13718);
+    auto gen = random.get_state();
+    std::vector<scalar_type> m(BlkSize*BlkSize);
+    for (int k=0;k<N;++k)
+      for (int l=0;l<vl;++l) {
+        for (int ij=0;ij<BlkSize*BlkSize;++ij) 
+          m[ij] = gen.drand(-1.0, 1.0);
+        for (int i=0;i<BlkSize;++i) {
+          for (int j=0;j<BlkSize;++j) {
+            scalar_type v = (i == j);
+            for (int p=0;p<BlkSize;++p) 
+              v += m[p*BlkSize+i]*m[p*BlkSize+j];
+            lane_type::get(a0_host(k,i,j), l) = v;
+          }
+          for (int j=0;j<NumVecs;++j)
+            lane_type::get(b0_host(k,i,j), l) = gen.drand(-1.0, 1.0);
+        }
+      }
+    random.free_state(gen);
+
+    Kokkos::deep_copy(a0, a0_host);
+    Kokkos::deep_copy(b0, b0_host);
+    Kokkos::deep_copy(a1, a0);
+    Kokkos::deep_copy(x1, b0);
+
+    Functor_TestBatchedSerialCholesky<DeviceType,ViewType,AlgoTagType>(a1, x1).run();
+
+    Kokkos::fence();
+
+    typename ViewType::HostMirror x1_host = Kokkos::create_mirror_view(x1);
+    Kokkos::deep_copy(x1_host, x1);
+
+    /// normwise backward error |A x - b| / (|A| |x| + |b|)
+    typedef typename ats::mag_type mag_type;
+    mag_type sum(0), diff(0);
+    const mag_type eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k)
+      for (int l=0;l<vl;++l)
+        for (int c=0;c<NumVecs;++c)
+          for (int i=0;i<BlkSize;++i) {
+            scalar_type r = -lane_type::get(b0_host(k,i,c), l);
+            sum += ats::abs(lane_type::get(b0_host(k,i,c), l));
+            for (int j=0;j<BlkSize;++j) {
+              const scalar_type 
+                aij = lane_type::get(a0_host(k,i,j), l), 
+                xj = lane_type::get(x1_host(k,j,c), l);
+              r += aij*xj;
+              sum += ats::abs(aij)*ats::abs(xj);
+            }
+            diff += ats::abs(r);
+          }
+    if (sum > 0) EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+}
+
+
+template<typename DeviceType,
+         typename ValueType,
+         typename AlgoTagType>
+int test_batched_cholesky() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutLeft,DeviceType> ViewType;
+    Test::impl_test_batched_cholesky<DeviceType,ViewType,AlgoTagType>(     0, 10, 1);
+    for (int i=0;i<10;++i) {                                                                                        
+      Test::impl_test_batched_cholesky<DeviceType,ViewType,AlgoTagType>(1024,  i, 2);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutRight,DeviceType> ViewType;
+    Test::impl_test_batched_cholesky<DeviceType,ViewType,AlgoTagType>(     0, 10, 1);
+    for (int i=0;i<10;++i) {                                                                                        
+      Test::impl_test_batched_cholesky<DeviceType,ViewType,AlgoTagType>(1024,  i, 2);
+    }
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,175 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_EigenSymmetric_Decl.hpp"
+#include "KokkosBatched_EigenSymmetric_Serial_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename EViewType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedSerialEigenSymmetric {
+    ViewType _a, _v;
+    EViewType _e;
+    bool _compute_vectors;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedSerialEigenSymmetric(const ViewType &a, const EViewType &e, const ViewType &v, 
+                                            const bool compute_vectors) 
+      : _a(a), _v(v), _e(e), _compute_vectors(compute_vectors) {} 
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const int k) const {
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      auto ee = Kokkos::subview(_e, k, Kokkos::ALL());
+      auto vv = Kokkos::subview(_v, k, Kokkos::ALL(), Kokkos::ALL());
+
+      if (_compute_vectors) 
+        SerialEigenSymmetric<AlgoTagType>::invoke(aa, ee, vv);
+      else 
+        SerialEigenSymmetric<AlgoTagType>::invoke(aa, ee);
+    }
+
+    inline
+    void run() {
+      Kokkos::RangePolicy<DeviceType> policy(0, _a.extent(0));
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  void impl_test_batched_eigen_symmetric(const int N, const int BlkSize) {
+    typedef typename ViewType::value_type value_type;
+    typedef VectorLane<value_type> lane_type;
+    typedef typename lane_type::value_type scalar_type;
+    typedef Kokkos::Details::ArithTraits<scalar_type> ats;
+    typedef Kokkos::View<value_type**,typename ViewType::array_layout,DeviceType> EViewType;
+
+    const int vl = lane_type::vector_length;
+
+    ViewType 
+      a0("a0", N, BlkSize, BlkSize), 
+      a1("a1", N, BlkSize, BlkSize), v1("v1", N, BlkSize, BlkSize),
+      a2("a2", N, BlkSize, BlkSize), v2("v2", N, BlkSize, BlkSize);
+    EViewType e1("e1", N, BlkSize), e2("e2", N, BlkSize);
+
+    /// random symmetric input
+    typename ViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+
+    Kokkos::Random_XorShift64_Pool<Kokkos::DefaultHostExecutionSpace> random(13718);
+    auto gen = random.get_state();
+    for (int k=0;k<N;++k)
+      for (int l=0;l<vl;++l) 
+        for (int i=0;i<BlkSize;++i) 
+          for (int j=i;j<BlkSize;++j) {
+            const scalar_type v = gen.drand(-1.0, 1.0);
+            lane_type::get(a0_host(k,i,j), l) = v;
+            lane_type::get(a0_host(k,j,i), l) = v;
+          }
+    random.free_state(gen);
+
+    Kokkos::deep_copy(a0, a0_host);
+    Kokkos::deep_copy(a1, a0);
+    Kokkos::deep_copy(a2, a0);
+
+    /// reference eigenpairs from Jacobi
+    Functor_TestBatchedSerialEigenSymmetric
+      <DeviceType,ViewType,EViewType,Algo::EigenSymmetric::Jacobi>(a1, e1, v1, true).run();
+    /// eigenvalues from the algorithm under test
+    Functor_TestBatchedSerialEigenSymmetric
+      <DeviceType,ViewType,EViewType,AlgoTagType>(a2, e2, v2, false).run();
+
+    Kokkos::fence();
+
+    typename ViewType::HostMirror v1_host = Kokkos::create_mirror_view(v1);
+    typename EViewType::HostMirror 
+      e1_host = Kokkos::create_mirror_view(e1),
+      e2_host = Kokkos::create_mirror_view(e2);
+    Kokkos::deep_copy(v1_host, v1);
+    Kokkos::deep_copy(e1_host, e1);
+    Kokkos::deep_copy(e2_host, e2);
+
+    typedef typename ats::mag_type mag_type;
+    const mag_type eps = 1.0e3 * ats::epsilon();
+
+    /// residual |A V - V diag(e)| / (|A| |V|), orthogonality |V^T V - I| 
+    {
+      mag_type sum(0), diff(0), ortho(0);
+      for (int k=0;k<N;++k)
+        for (int l=0;l<vl;++l)
+          for (int i=0;i<BlkSize;++i) 
+            for (int j=0;j<BlkSize;++j) {
+              scalar_type r = -lane_type::get(v1_host(k,i,j), l)*lane_type::get(e1_host(k,j), l);
+              scalar_type o = -scalar_type(i == j);
+              for (int p=0;p<BlkSize;++p) {
+                const scalar_type 
+                  aip = lane_type::get(a0_host(k,i,p), l), 
+                  vpj = lane_type::get(v1_host(k,p,j), l);
+                r += aip*vpj;
+                o += lane_type::get(v1_host(k,p,i), l)*vpj;
+                sum += ats::abs(aip)*ats::abs(vpj);
+              }
+              diff  += ats::abs(r);
+              ortho += ats::abs(o);
+            }
+      if (sum > 0) EXPECT_NEAR_KK( diff/sum, 0, eps);
+      if (N*BlkSize > 0) EXPECT_NEAR_KK( ortho/(N*vl*BlkSize), 0, eps);
+    }
+
+    /// ascending order and agreement of eigenvalues
+    {
+      mag_type sum(0), diff(0);
+      for (int k=0;k<N;++k)
+        for (int l=0;l<vl;++l)
+          for (int i=0;i<BlkSize;++i) {
+            const scalar_type 
+              ei1 = lane_type::get(e1_host(k,i), l),
+              ei2 = lane_type::get(e2_host(k,i), l);
+            if (i > 0) EXPECT_TRUE( lane_type::get(e1_host(k,i-1), l) <= ei1 );
+            sum  += ats::abs(ei1);
+            diff += ats::abs(ei1 - ei2);
+          }
+      if (sum > 0) EXPECT_NEAR_KK( diff/sum, 0, eps);
+    }
+  }
+}
+
+
+template<typename DeviceType,
+         typename ValueType,
+         typename AlgoTagType>
+int test_batched_eigen_symmetric(const int BlkSizeBegin, const int BlkSizeEnd) {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutLeft,DeviceType> ViewType;
+    Test::impl_test_batched_eigen_symmetric<DeviceType,ViewType,AlgoTagType>(     0, BlkSizeBegin);
+    for (int i=BlkSizeBegin;i<BlkSizeEnd;++i) {                                                                                        
+      Test::impl_test_batched_eigen_symmetric<DeviceType,ViewType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutRight,DeviceType> ViewType;
+    Test::impl_test_batched_eigen_symmetric<DeviceType,ViewType,AlgoTagType>(     0, BlkSizeBegin);
+    for (int i=BlkSizeBegin;i<BlkSizeEnd;++i) {                                                                                        
+      Test::impl_test_batched_eigen_symmetric<DeviceType,ViewType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+
+  return 0;
+}
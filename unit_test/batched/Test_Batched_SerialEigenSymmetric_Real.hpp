@@ -0,0 +1,30 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_scalar_serial_eigen_symmetric_jacobi_float ) {
+  typedef Algo::EigenSymmetric::Jacobi algo_tag_type;
+  test_batched_eigen_symmetric<TestExecSpace,float,algo_tag_type>(0, 10);
+}
+TEST_F( TestCategory, batched_scalar_serial_eigen_symmetric_analytic_float ) {
+  typedef Algo::EigenSymmetric::Analytic algo_tag_type;
+  test_batched_eigen_symmetric<TestExecSpace,float,algo_tag_type>(3, 4);
+}
+#endif
+
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_scalar_serial_eigen_symmetric_jacobi_double ) {
+  typedef Algo::EigenSymmetric::Jacobi algo_tag_type;
+  test_batched_eigen_symmetric<TestExecSpace,double,algo_tag_type>(0, 10);
+}
+TEST_F( TestCategory, batched_scalar_serial_eigen_symmetric_analytic_double ) {
+  typedef Algo::EigenSymmetric::Analytic algo_tag_type;
+  test_batched_eigen_symmetric<TestExecSpace,double,algo_tag_type>(3, 4);
+}
+TEST_F( TestCategory, batched_vector_serial_eigen_symmetric_jacobi_double ) {
+  typedef Algo::EigenSymmetric::Jacobi algo_tag_type;
+  test_batched_eigen_symmetric<TestExecSpace,Vector<SIMD<double>,4>,algo_tag_type>(0, 10);
+}
+TEST_F( TestCategory, batched_vector_serial_eigen_symmetric_analytic_double ) {
+  typedef Algo::EigenSymmetric::Analytic algo_tag_type;
+  test_batched_eigen_symmetric<TestExecSpace,Vector<SIMD<double>,4>,algo_tag_type>(3, 4);
+}
+#endif
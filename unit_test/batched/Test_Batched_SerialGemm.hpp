@@ -21,6 +21,30 @@ namespace Test {
     typedef TB transB;
   };
  
+  /// compile-time sized Gemm falling back to the blocked algorithm
+  template<int Size>
+  struct FixedSizeTag {};
+
+  template<typename TA, typename TB, typename AlgoTagType>
+  struct SerialGemmInvoke {
+    template<typename ScalarType, typename AViewType, typename BViewType, typename CViewType>
+    KOKKOS_INLINE_FUNCTION
+    static int invoke(const ScalarType alpha, const AViewType &A, const BViewType &B, 
+                      const ScalarType beta, const CViewType &C) {
+      return SerialGemm<TA,TB,AlgoTagType>::invoke(alpha, A, B, beta, C);
+    }
+  };
+
+  template<typename TA, typename TB, int Size>
+  struct SerialGemmInvoke<TA,TB,FixedSizeTag<Size> > {
+    template<typename ScalarType, typename AViewType, typename BViewType, typename CViewType>
+    KOKKOS_INLINE_FUNCTION
+    static int invoke(const ScalarType alpha, const AViewType &A, const BViewType &B, 
+                      const ScalarType beta, const CViewType &C) {
+      return SerialGemmFixedSize<TA,TB,Algo::Gemm::Blocked,Size,Size,Size>::invoke(alpha, A, B, beta, C);
+    }
+  };
+ 
   template<typename DeviceType,
            typename ViewType,
            typename ScalarType,
@@ -45,7 +69,7 @@ namespace Test {
       auto bb = Kokkos::subview(_b, k, Kokkos::ALL(), Kokkos::ALL());
       auto cc = Kokkos::subview(_c, k, Kokkos::ALL(), Kokkos::ALL());
       
-      SerialGemm<typename ParamTagType::transA,
+      SerialGemmInvoke<typename ParamTagType::transA,
         typename ParamTagType::transB,
         AlgoTagType>::
         invoke(_alpha, aa, bb, _beta, cc);
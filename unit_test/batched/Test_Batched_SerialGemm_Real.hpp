@@ -42,6 +42,36 @@ TEST_F( TestCategory, batched_scalar_serial_gemm_t_t_double_double ) {
   typedef Algo::Gemm::Blocked algo_tag_type;
   test_batched_gemm<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
 }
+TEST_F( TestCategory, batched_scalar_serial_gemm_fixed_3_nt_nt_double_double ) {
+  typedef ::Test::ParamTag<Trans::NoTranspose,Trans::NoTranspose> param_tag_type;
+  typedef ::Test::FixedSizeTag<3> algo_tag_type;
+  test_batched_gemm<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_gemm_fixed_5_nt_nt_double_double ) {
+  typedef ::Test::ParamTag<Trans::NoTranspose,Trans::NoTranspose> param_tag_type;
+  typedef ::Test::FixedSizeTag<5> algo_tag_type;
+  test_batched_gemm<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_gemm_fixed_8_nt_nt_double_double ) {
+  typedef ::Test::ParamTag<Trans::NoTranspose,Trans::NoTranspose> param_tag_type;
+  typedef ::Test::FixedSizeTag<8> algo_tag_type;
+  test_batched_gemm<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_gemm_fixed_3_t_t_double_double ) {
+  typedef ::Test::ParamTag<Trans::Transpose,Trans::Transpose> param_tag_type;
+  typedef ::Test::FixedSizeTag<3> algo_tag_type;
+  test_batched_gemm<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_gemm_fixed_5_t_t_double_double ) {
+  typedef ::Test::ParamTag<Trans::Transpose,Trans::Transpose> param_tag_type;
+  typedef ::Test::FixedSizeTag<5> algo_tag_type;
+  test_batched_gemm<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_gemm_fixed_8_t_t_double_double ) {
+  typedef ::Test::ParamTag<Trans::Transpose,Trans::Transpose> param_tag_type;
+  typedef ::Test::FixedSizeTag<8> algo_tag_type;
+  test_batched_gemm<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
 #endif
 
 
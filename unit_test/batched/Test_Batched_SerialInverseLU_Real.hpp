@@ -0,0 +1,14 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_scalar_serial_inverselu_float ) {
+  typedef Algo::LU::Blocked algo_tag_type;
+  test_batched_inverselu<TestExecSpace,float,algo_tag_type>();
+}
+#endif
+
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_scalar_serial_inverselu_double ) {
+  typedef Algo::LU::Blocked algo_tag_type;
+  test_batched_inverselu<TestExecSpace,double,algo_tag_type>();
+}
+#endif
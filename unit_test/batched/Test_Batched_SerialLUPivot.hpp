@@ -0,0 +1,228 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_LU_Decl.hpp"
+#include "KokkosBatched_LU_Serial_Impl.hpp"
+#include "KokkosBatched_ApplyPivot_Decl.hpp"
+#include "KokkosBatched_ApplyPivot_Impl.hpp"
+#include "KokkosBatched_Trsv_Decl.hpp"
+#include "KokkosBatched_Trsv_Serial_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename PivViewType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedSerialLUPivot {
+    ViewType _a, _b;
+    PivViewType _ipiv;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedSerialLUPivot(const ViewType &a, const ViewType &b, const PivViewType &ipiv) 
+      : _a(a), _b(b), _ipiv(ipiv) {} 
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const int k) const {
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      auto bb = Kokkos::subview(_b, k, Kokkos::ALL(), 0);
+      auto pp = Kokkos::subview(_ipiv, k, Kokkos::ALL(), Kokkos::ALL());
+
+      SerialLUPivot<AlgoTagType>::invoke(aa, pp);
+      SerialApplyPivot::invoke(pp, bb);
+      SerialTrsv<Uplo::Lower,Trans::NoTranspose,Diag::Unit,Algo::Trsv::Unblocked>::invoke(1.0, aa, bb);
+      SerialTrsv<Uplo::Upper,Trans::NoTranspose,Diag::NonUnit,Algo::Trsv::Unblocked>::invoke(1.0, aa, bb);
+    }
+
+    inline
+    void run() {
+      Kokkos::RangePolicy<DeviceType> policy(0, _a.extent(0));
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  void impl_test_batched_lu_pivot(const int N, const int BlkSize) {
+    typedef typename ViewType::value_type value_type;
+    typedef VectorLane<value_type> lane_type;
+    typedef typename lane_type::value_type scalar_type;
+    typedef Kokkos::Details::ArithTraits<scalar_type> ats;
+    typedef Kokkos::View<int***,DeviceType> piv_view_type;
+
+    const int vl = lane_type::vector_length;
+
+    /// a column of b is kept as a rank 2 view to share the layout of a
+    ViewType 
+      a0("a0", N, BlkSize, BlkSize), a1("a1", N, BlkSize, BlkSize),
+      b0("b0", N, BlkSize, 1), x1("x1", N, BlkSize, 1);
+    piv_view_type ipiv("ipiv", N, BlkSize, vl);
+
+    typename ViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+    typename ViewType::HostMirror b0_host = Kokkos::create_mirror_view(b0);
+
+    /// random matrices with small diagonal so that pivoting is required
+    Kokkos::Random_XorShift64_Pool<Kokkos::DefaultHostExecutionSpace> random(13718);
+    auto gen = random.get_state();
+    for (int k=0;k<N;++k)
+      for (int l=0;l<vl;++l)
+        for (int i=0;i<BlkSize;++i) {
+          for (int j=0;j<BlkSize;++j) {
+            const scalar_type v = gen.drand(-1.0, 1.0);
+            lane_type::get(a0_host(k,i,j), l) = (i == j ? scalar_type(1.0e-3)*v : v);
+          }
+          lane_type::get(b0_host(k,i,0), l) = gen.drand(-1.0, 1.0);
+        }
+    random.free_state(gen);
+
+    Kokkos::deep_copy(a0, a0_host);
+    Kokkos::deep_copy(b0, b0_host);
+    Kokkos::deep_copy(a1, a0);
+    Kokkos::deep_copy(x1, b0);
+
+    Functor_TestBatchedSerialLUPivot<DeviceType,ViewType,piv_view_type,AlgoTagType>(a1, x1, ipiv).run();
+
+    Kokkos::fence();
+
+    typename ViewType::HostMirror x1_host = Kokkos::create_mirror_view(x1);
+    Kokkos::deep_copy(x1_host, x1);
+
+    /// normwise backward error |A x - b| / (|A| |x| + |b|)
+    typedef typename ats::mag_type mag_type;
+    mag_type sum(0), diff(0);
+    const mag_type eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k)
+      for (int l=0;l<vl;++l)
+        for (int i=0;i<BlkSize;++i) {
+          scalar_type r = -lane_type::get(b0_host(k,i,0), l);
+          sum += ats::abs(lane_type::get(b0_host(k,i,0), l));
+          for (int j=0;j<BlkSize;++j) {
+            const scalar_type 
+              aij = lane_type::get(a0_host(k,i,j), l), 
+              xj = lane_type::get(x1_host(k,j,0), l);
+            r += aij*xj;
+            sum += ats::abs(aij)*ats::abs(xj);
+          }
+          diff += ats::abs(r);
+        }
+    if (sum > 0) EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename PivViewType,
+           typename InfoViewType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedSerialLUPivotInfo {
+    ViewType _a;
+    PivViewType _ipiv;
+    InfoViewType _info;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedSerialLUPivotInfo(const ViewType &a, const PivViewType &ipiv, const InfoViewType &info) 
+      : _a(a), _ipiv(ipiv), _info(info) {} 
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const int k) const {
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      auto pp = Kokkos::subview(_ipiv, k, Kokkos::ALL(), Kokkos::ALL());
+
+      _info(k) = SerialLUPivot<AlgoTagType>::invoke(aa, pp);
+    }
+
+    inline
+    void run() {
+      Kokkos::RangePolicy<DeviceType> policy(0, _a.extent(0));
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  /// a zero first column is reported in info and leaves the factors finite, as in getf2
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  void impl_test_batched_lu_pivot_singular(const int N, const int BlkSize) {
+    typedef typename ViewType::value_type value_type;
+    typedef VectorLane<value_type> lane_type;
+    typedef typename lane_type::value_type scalar_type;
+    typedef Kokkos::View<int***,DeviceType> piv_view_type;
+    typedef Kokkos::View<int*,DeviceType> info_view_type;
+
+    const int vl = lane_type::vector_length;
+
+    ViewType a1("a1", N, BlkSize, BlkSize);
+    piv_view_type ipiv("ipiv", N, BlkSize, vl);
+    info_view_type info("info", N);
+
+    typename ViewType::HostMirror a1_host = Kokkos::create_mirror_view(a1);
+
+    Kokkos::Random_XorShift64_Pool<Kokkos::DefaultHostExecutionSpace> random(13718);
+    auto gen = random.get_state();
+    for (int k=0;k<N;++k)
+      for (int l=0;l<vl;++l)
+        for (int i=0;i<BlkSize;++i)
+          for (int j=0;j<BlkSize;++j)
+            lane_type::get(a1_host(k,i,j), l) = (j == 0 ? scalar_type(0) : scalar_type(gen.drand(-1.0, 1.0)));
+    random.free_state(gen);
+
+    Kokkos::deep_copy(a1, a1_host);
+
+    Functor_TestBatchedSerialLUPivotInfo<DeviceType,ViewType,piv_view_type,info_view_type,AlgoTagType>(a1, ipiv, info).run();
+
+    Kokkos::fence();
+
+    typename info_view_type::HostMirror info_host = Kokkos::create_mirror_view(info);
+    Kokkos::deep_copy(info_host, info);
+    Kokkos::deep_copy(a1_host, a1);
+
+    for (int k=0;k<N;++k) {
+      EXPECT_EQ(info_host(k), 1);
+      for (int l=0;l<vl;++l)
+        for (int i=0;i<BlkSize;++i)
+          for (int j=0;j<BlkSize;++j) {
+            const scalar_type aij = lane_type::get(a1_host(k,i,j), l);
+            EXPECT_TRUE(aij == aij);
+          }
+    }
+  }
+}
+
+
+template<typename DeviceType,
+         typename ValueType,
+         typename AlgoTagType>
+int test_batched_lu_pivot() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutLeft,DeviceType> ViewType;
+    Test::impl_test_batched_lu_pivot<DeviceType,ViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {                                                                                        
+      Test::impl_test_batched_lu_pivot<DeviceType,ViewType,AlgoTagType>(1024,  i);
+    }
+    Test::impl_test_batched_lu_pivot_singular<DeviceType,ViewType,AlgoTagType>(16, 5);
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutRight,DeviceType> ViewType;
+    Test::impl_test_batched_lu_pivot<DeviceType,ViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {                                                                                        
+      Test::impl_test_batched_lu_pivot<DeviceType,ViewType,AlgoTagType>(1024,  i);
+    }
+    Test::impl_test_batched_lu_pivot_singular<DeviceType,ViewType,AlgoTagType>(16, 5);
+  }
+#endif
+
+  return 0;
+}
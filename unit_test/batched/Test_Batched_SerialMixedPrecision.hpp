@@ -0,0 +1,273 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+//#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_Gemm_Decl.hpp"
+#include "KokkosBatched_Gemm_Serial_Impl.hpp"
+#include "KokkosBatched_LU_Decl.hpp"
+#include "KokkosBatched_LU_Serial_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename TA, typename TB>
+  struct ParamTag { 
+    typedef TA transA;
+    typedef TB transB;
+  };
+
+  struct ReferenceTag {};
+  struct MixedTag {};
+
+  /// copy a low precision view into a high precision view of the same shape
+  template<typename HighViewType, typename LowViewType>
+  void widen_copy(const HighViewType &dst, const LowViewType &src) {
+    typename LowViewType::HostMirror src_host = Kokkos::create_mirror_view(src);
+    typename HighViewType::HostMirror dst_host = Kokkos::create_mirror_view(dst);
+    Kokkos::deep_copy(src_host, src);
+    for (int k=0;k<int(src.extent(0));++k)
+      for (int i=0;i<int(src.extent(1));++i)
+        for (int j=0;j<int(src.extent(2));++j)
+          dst_host(k,i,j) = src_host(k,i,j);
+    Kokkos::deep_copy(dst, dst_host);
+  }
+
+  template<typename DeviceType,
+           typename ABViewType,
+           typename CViewType,
+           typename ParamTagType, 
+           typename AlgoTagType>
+  struct Functor_TestBatchedSerialGemmMixed {
+    ABViewType _a, _b;
+    CViewType _c;
+    
+    double _alpha, _beta;
+    
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedSerialGemmMixed(const double alpha, 
+            const ABViewType &a,
+            const ABViewType &b,
+            const double beta,
+            const CViewType &c)
+      : _a(a), _b(b), _c(c), _alpha(alpha), _beta(beta) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const ParamTagType &, const int k) const {
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      auto bb = Kokkos::subview(_b, k, Kokkos::ALL(), Kokkos::ALL());
+      auto cc = Kokkos::subview(_c, k, Kokkos::ALL(), Kokkos::ALL());
+      
+      SerialGemm<typename ParamTagType::transA,
+        typename ParamTagType::transB,
+        AlgoTagType>::
+        invoke(_alpha, aa, bb, _beta, cc);
+    }
+    
+    inline
+    void run() {
+      Kokkos::RangePolicy<DeviceType,ParamTagType> policy(0, _c.extent(0));
+      Kokkos::parallel_for(policy, *this);            
+    }
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedSerialLUMixed {
+    ViewType _a;
+    
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedSerialLUMixed(const ViewType &a) 
+      : _a(a) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const ReferenceTag &, const int k) const {
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      SerialLU<Algo::LU::Unblocked>::invoke(aa);
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const MixedTag &, const int k) const {
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      SerialLUMixed<AlgoTagType>::invoke(aa);
+    }
+
+    template<typename TagType>
+    inline
+    void run() {
+      Kokkos::RangePolicy<DeviceType,TagType> policy(0, _a.extent(0));
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename LowViewType,
+           typename HighViewType,
+           typename ParamTagType, 
+           typename AlgoTagType>
+  void impl_test_batched_mixed_gemm(const int N, const int BlkSize) {
+    typedef Kokkos::Details::ArithTraits<double> ats;
+
+    /// randomized input testing views; a and b are exactly representable in both
+    const double alpha = 1.5, beta = 3.0;
+
+    LowViewType
+      a0("a0", N, BlkSize,BlkSize), 
+      b0("b0", N, BlkSize,BlkSize);
+    HighViewType
+      a1("a1", N, BlkSize,BlkSize), 
+      b1("b1", N, BlkSize,BlkSize),
+      c0("c0", N, BlkSize,BlkSize), c1("c1", N, BlkSize, BlkSize);
+
+    Kokkos::Random_XorShift64_Pool<typename DeviceType::execution_space> random(13718);
+    Kokkos::fill_random(a0, random, float(1.0));
+    Kokkos::fill_random(b0, random, float(1.0));
+    Kokkos::fill_random(c0, random, double(1.0));
+
+    Kokkos::fence();
+
+    widen_copy(a1, a0);
+    widen_copy(b1, b0);
+    Kokkos::deep_copy(c1, c0);
+
+    /// double precision reference
+    Functor_TestBatchedSerialGemmMixed<DeviceType,HighViewType,HighViewType,
+      ParamTagType,Algo::Gemm::Unblocked>(alpha, a1, b1, beta, c1).run();
+    Functor_TestBatchedSerialGemmMixed<DeviceType,LowViewType,HighViewType,
+      ParamTagType,AlgoTagType>(alpha, a0, b0, beta, c0).run();
+
+    Kokkos::fence();
+
+    /// for comparison send it to host
+    typename HighViewType::HostMirror c0_host = Kokkos::create_mirror_view(c0);
+    typename HighViewType::HostMirror c1_host = Kokkos::create_mirror_view(c1);
+
+    Kokkos::deep_copy(c0_host, c0);
+    Kokkos::deep_copy(c1_host, c1);
+
+    /// check c0 = c1 in double precision ; this eps is about 10^-13
+    double sum(1), diff(0);
+    const double eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k) 
+      for (int i=0;i<BlkSize;++i) 
+        for (int j=0;j<BlkSize;++j) {
+          sum  += ats::abs(c0_host(k,i,j));
+          diff += ats::abs(c0_host(k,i,j)-c1_host(k,i,j));
+        }
+    EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+
+  template<typename DeviceType,
+           typename LowViewType,
+           typename HighViewType,
+           typename AlgoTagType>
+  void impl_test_batched_mixed_lu(const int N, const int BlkSize) {
+    typedef Kokkos::Details::ArithTraits<float> ats;
+
+    /// randomized input testing views; diagonally dominant
+    LowViewType a0("a0", N, BlkSize,BlkSize);
+    HighViewType a1("a1", N, BlkSize,BlkSize);
+
+    Kokkos::Random_XorShift64_Pool<typename DeviceType::execution_space> random(13718);
+    Kokkos::fill_random(a0, random, float(1.0));
+
+    Kokkos::fence();
+    {
+      typename LowViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+      Kokkos::deep_copy(a0_host, a0);
+      for (int k=0;k<N;++k)
+        for (int i=0;i<BlkSize;++i)
+          a0_host(k,i,i) += 10.0;
+      Kokkos::deep_copy(a0, a0_host);
+    }
+    widen_copy(a1, a0);
+
+    /// double precision reference
+    Functor_TestBatchedSerialLUMixed<DeviceType,HighViewType,AlgoTagType>(a1).template run<ReferenceTag>();
+    Functor_TestBatchedSerialLUMixed<DeviceType,LowViewType,AlgoTagType>(a0).template run<MixedTag>();
+
+    Kokkos::fence();
+
+    /// for comparison send it to host
+    typename LowViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+    typename HighViewType::HostMirror a1_host = Kokkos::create_mirror_view(a1);
+
+    Kokkos::deep_copy(a0_host, a0);
+    Kokkos::deep_copy(a1_host, a1);
+
+    /// check a0 = a1 in single precision ; this eps is about 10^-4
+    double sum(1), diff(0);
+    const double eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k) 
+      for (int i=0;i<BlkSize;++i) 
+        for (int j=0;j<BlkSize;++j) {
+          sum  += std::abs(a1_host(k,i,j));
+          diff += std::abs(double(a0_host(k,i,j))-a1_host(k,i,j));
+        }
+    EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+}
+
+template<typename DeviceType, 
+         typename ParamTagType,
+         typename AlgoTagType>
+int test_batched_mixed_gemm() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) 
+  {
+    typedef Kokkos::View<float***,Kokkos::LayoutLeft,DeviceType> LowViewType;
+    typedef Kokkos::View<double***,Kokkos::LayoutLeft,DeviceType> HighViewType;
+    Test::impl_test_batched_mixed_gemm<DeviceType,LowViewType,HighViewType,ParamTagType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_mixed_gemm<DeviceType,LowViewType,HighViewType,ParamTagType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) 
+  {
+    typedef Kokkos::View<float***,Kokkos::LayoutRight,DeviceType> LowViewType;
+    typedef Kokkos::View<double***,Kokkos::LayoutRight,DeviceType> HighViewType;
+    Test::impl_test_batched_mixed_gemm<DeviceType,LowViewType,HighViewType,ParamTagType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_mixed_gemm<DeviceType,LowViewType,HighViewType,ParamTagType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+  
+  return 0;
+}
+
+template<typename DeviceType, 
+         typename AlgoTagType>
+int test_batched_mixed_lu() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) 
+  {
+    typedef Kokkos::View<float***,Kokkos::LayoutLeft,DeviceType> LowViewType;
+    typedef Kokkos::View<double***,Kokkos::LayoutLeft,DeviceType> HighViewType;
+    Test::impl_test_batched_mixed_lu<DeviceType,LowViewType,HighViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_mixed_lu<DeviceType,LowViewType,HighViewType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) 
+  {
+    typedef Kokkos::View<float***,Kokkos::LayoutRight,DeviceType> LowViewType;
+    typedef Kokkos::View<double***,Kokkos::LayoutRight,DeviceType> HighViewType;
+    Test::impl_test_batched_mixed_lu<DeviceType,LowViewType,HighViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_mixed_lu<DeviceType,LowViewType,HighViewType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+  
+  return 0;
+}
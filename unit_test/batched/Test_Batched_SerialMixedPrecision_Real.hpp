@@ -0,0 +1,46 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT) && defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_scalar_serial_mixed_gemm_unblocked_nt_nt_float_double ) {
+  typedef ::Test::ParamTag<Trans::NoTranspose,Trans::NoTranspose> param_tag_type;
+  typedef Algo::Gemm::Unblocked algo_tag_type;
+  test_batched_mixed_gemm<TestExecSpace,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_mixed_gemm_unblocked_t_nt_float_double ) {
+  typedef ::Test::ParamTag<Trans::Transpose,Trans::NoTranspose> param_tag_type;
+  typedef Algo::Gemm::Unblocked algo_tag_type;
+  test_batched_mixed_gemm<TestExecSpace,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_mixed_gemm_unblocked_nt_t_float_double ) {
+  typedef ::Test::ParamTag<Trans::NoTranspose,Trans::Transpose> param_tag_type;
+  typedef Algo::Gemm::Unblocked algo_tag_type;
+  test_batched_mixed_gemm<TestExecSpace,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_mixed_gemm_unblocked_t_t_float_double ) {
+  typedef ::Test::ParamTag<Trans::Transpose,Trans::Transpose> param_tag_type;
+  typedef Algo::Gemm::Unblocked algo_tag_type;
+  test_batched_mixed_gemm<TestExecSpace,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_mixed_gemm_blocked_nt_nt_float_double ) {
+  typedef ::Test::ParamTag<Trans::NoTranspose,Trans::NoTranspose> param_tag_type;
+  typedef Algo::Gemm::Blocked algo_tag_type;
+  test_batched_mixed_gemm<TestExecSpace,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_mixed_gemm_blocked_t_nt_float_double ) {
+  typedef ::Test::ParamTag<Trans::Transpose,Trans::NoTranspose> param_tag_type;
+  typedef Algo::Gemm::Blocked algo_tag_type;
+  test_batched_mixed_gemm<TestExecSpace,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_mixed_gemm_blocked_nt_t_float_double ) {
+  typedef ::Test::ParamTag<Trans::NoTranspose,Trans::Transpose> param_tag_type;
+  typedef Algo::Gemm::Blocked algo_tag_type;
+  test_batched_mixed_gemm<TestExecSpace,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_mixed_gemm_blocked_t_t_float_double ) {
+  typedef ::Test::ParamTag<Trans::Transpose,Trans::Transpose> param_tag_type;
+  typedef Algo::Gemm::Blocked algo_tag_type;
+  test_batched_mixed_gemm<TestExecSpace,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_serial_mixed_lu_float_double ) {
+  typedef Algo::LU::Unblocked algo_tag_type;
+  test_batched_mixed_lu<TestExecSpace,algo_tag_type>();
+}
+#endif
@@ -0,0 +1,180 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_QR_Decl.hpp"
+#include "KokkosBatched_QR_Serial_Impl.hpp"
+#include "KokkosBatched_ApplyQ_Decl.hpp"
+#include "KokkosBatched_ApplyQ_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename tViewType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedSerialQR {
+    ViewType _a, _b, _c;
+    tViewType _t;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedSerialQR(const ViewType &a, const tViewType &t, const ViewType &b, const ViewType &c) 
+      : _a(a), _b(b), _c(c), _t(t) {} 
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const int k) const {
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      auto bb = Kokkos::subview(_b, k, Kokkos::ALL(), Kokkos::ALL());
+      auto cc = Kokkos::subview(_c, k, Kokkos::ALL(), Kokkos::ALL());
+      auto tt = Kokkos::subview(_t, k, Kokkos::ALL());
+
+      SerialQR<AlgoTagType>::invoke(aa, tt);
+
+      // c := Q Q^T c
+      SerialApplyQ<Side::Left,Trans::Transpose,  AlgoTagType>::invoke(aa, tt, cc);
+      SerialApplyQ<Side::Left,Trans::NoTranspose,AlgoTagType>::invoke(aa, tt, cc);
+
+      SerialSolveLeastSquares<AlgoTagType>::invoke(aa, tt, bb);
+    }
+
+    inline
+    void run() {
+      Kokkos::RangePolicy<DeviceType> policy(0, _a.extent(0));
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  void impl_test_batched_qr(const int N, const int m, const int n, const int NumVecs) {
+    typedef typename ViewType::value_type value_type;
+    typedef VectorLane<value_type> lane_type;
+    typedef typename lane_type::value_type scalar_type;
+    typedef Kokkos::Details::ArithTraits<scalar_type> ats;
+    typedef Kokkos::View<value_type**,DeviceType> tViewType;
+
+    const int vl = lane_type::vector_length;
+
+    ViewType 
+      a0("a0", N, m, n), a1("a1", N, m, n),
+      b0("b0", N, m, NumVecs), x1("x1", N, m, NumVecs), c1("c1", N, m, NumVecs);
+    tViewType t("t", N, n);
+
+    typename ViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+    typename ViewType::HostMirror b0_host = Kokkos::create_mirror_view(b0);
+
+    Kokkos::Random_XorShift64_Pool<Kokkos::DefaultHostExecutionSpace> random(13718);
+    auto gen = random.get_state();
+    for (int k=0;k<N;++k)
+      for (int l=0;l<vl;++l) 
+        for (int i=0;i<m;++i) {
+          for (int j=0;j<n;++j)
+            lane_type::get(a0_host(k,i,j), l) = gen.drand(-1.0, 1.0) + (i == j);
+          for (int j=0;j<NumVecs;++j)
+            lane_type::get(b0_host(k,i,j), l) = gen.drand(-1.0, 1.0);
+        }
+    random.free_state(gen);
+
+    Kokkos::deep_copy(a0, a0_host);
+    Kokkos::deep_copy(b0, b0_host);
+    Kokkos::deep_copy(a1, a0);
+    Kokkos::deep_copy(x1, b0);
+    Kokkos::deep_copy(c1, b0);
+
+    Functor_TestBatchedSerialQR<DeviceType,ViewType,tViewType,AlgoTagType>(a1, t, x1, c1).run();
+
+    Kokkos::fence();
+
+    typename ViewType::HostMirror x1_host = Kokkos::create_mirror_view(x1);
+    typename ViewType::HostMirror c1_host = Kokkos::create_mirror_view(c1);
+    Kokkos::deep_copy(x1_host, x1);
+    Kokkos::deep_copy(c1_host, c1);
+
+    typedef typename ats::mag_type mag_type;
+    const mag_type eps = 1.0e3 * ats::epsilon();
+
+    /// Q is orthogonal; Q Q^T b = b
+    {
+      mag_type sum(0), diff(0);
+      for (int k=0;k<N;++k)
+        for (int l=0;l<vl;++l)
+          for (int i=0;i<m;++i)
+            for (int j=0;j<NumVecs;++j) {
+              sum  += ats::abs(lane_type::get(b0_host(k,i,j), l));
+              diff += ats::abs(lane_type::get(b0_host(k,i,j), l) - lane_type::get(c1_host(k,i,j), l));
+            }
+      if (sum > 0) EXPECT_NEAR_KK( diff/sum, 0, eps);
+    }
+
+    /// normal equations A^T (A x - b) = 0
+    {
+      mag_type sum(0), diff(0);
+      std::vector<scalar_type> r(m), rabs(m);
+      for (int k=0;k<N;++k)
+        for (int l=0;l<vl;++l)
+          for (int c=0;c<NumVecs;++c) {
+            for (int i=0;i<m;++i) {
+              r[i] = -lane_type::get(b0_host(k,i,c), l);
+              rabs[i] = ats::abs(r[i]);
+              for (int j=0;j<n;++j) {
+                const scalar_type 
+                  aij = lane_type::get(a0_host(k,i,j), l), 
+                  xj = lane_type::get(x1_host(k,j,c), l);
+                r[i] += aij*xj;
+                rabs[i] += ats::abs(aij)*ats::abs(xj);
+              }
+            }
+            for (int j=0;j<n;++j) {
+              scalar_type s(0);
+              for (int i=0;i<m;++i) {
+                const scalar_type aij = lane_type::get(a0_host(k,i,j), l);
+                s += aij*r[i];
+                sum += ats::abs(aij)*rabs[i];
+              }
+              diff += ats::abs(s);
+            }
+          }
+      if (sum > 0) EXPECT_NEAR_KK( diff/sum, 0, eps);
+    }
+  }
+}
+
+
+template<typename DeviceType,
+         typename ValueType,
+         typename AlgoTagType>
+int test_batched_qr() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutLeft,DeviceType> ViewType;
+    Test::impl_test_batched_qr<DeviceType,ViewType,AlgoTagType>(     0, 10, 6, 1);
+    for (int i=1;i<8;++i) {                                                                                        
+      Test::impl_test_batched_qr<DeviceType,ViewType,AlgoTagType>(1024, i,   i, 1);
+      Test::impl_test_batched_qr<DeviceType,ViewType,AlgoTagType>(1024, 3*i, i, 2);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutRight,DeviceType> ViewType;
+    Test::impl_test_batched_qr<DeviceType,ViewType,AlgoTagType>(     0, 10, 6, 1);
+    for (int i=1;i<8;++i) {                                                                                        
+      Test::impl_test_batched_qr<DeviceType,ViewType,AlgoTagType>(1024, i,   i, 1);
+      Test::impl_test_batched_qr<DeviceType,ViewType,AlgoTagType>(1024, 3*i, i, 2);
+    }
+  }
+#endif
+
+  return 0;
+}
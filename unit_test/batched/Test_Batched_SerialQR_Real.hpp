@@ -0,0 +1,18 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_scalar_serial_qr_float ) {
+  typedef Algo::QR::Unblocked algo_tag_type;
+  test_batched_qr<TestExecSpace,float,algo_tag_type>();
+}
+#endif
+
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_scalar_serial_qr_double ) {
+  typedef Algo::QR::Unblocked algo_tag_type;
+  test_batched_qr<TestExecSpace,double,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_vector_serial_qr_double ) {
+  typedef Algo::QR::Unblocked algo_tag_type;
+  test_batched_qr<TestExecSpace,Vector<SIMD<double>,4>,algo_tag_type>();
+}
+#endif
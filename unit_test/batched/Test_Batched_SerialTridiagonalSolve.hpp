@@ -0,0 +1,159 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_Tridiagonal_Decl.hpp"
+#include "KokkosBatched_Tridiagonal_Serial_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedSerialTridiagonalSolve {
+    ViewType _dl, _d, _du, _b;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedSerialTridiagonalSolve(const ViewType &dl, const ViewType &d, const ViewType &du, const ViewType &b)
+      : _dl(dl), _d(d), _du(du), _b(b) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const int k) const {
+      auto dl = Kokkos::subview(_dl, k, Kokkos::ALL());
+      auto d  = Kokkos::subview(_d,  k, Kokkos::ALL());
+      auto du = Kokkos::subview(_du, k, Kokkos::ALL());
+      auto b  = Kokkos::subview(_b,  k, Kokkos::ALL());
+
+      SerialTridiagonalSolve<AlgoTagType>::invoke(dl, d, du, b);
+    }
+
+    inline
+    void run() {
+      Kokkos::RangePolicy<DeviceType> policy(0, _d.extent(0));
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  void impl_test_batched_tridiagonal_solve(const int N, const int BlkSize) {
+    typedef typename ViewType::value_type value_type;
+    typedef VectorLane<value_type> lane_type;
+    typedef typename lane_type::value_type scalar_type;
+    typedef Kokkos::Details::ArithTraits<scalar_type> ats;
+
+    const int vl = lane_type::vector_length, BlkSizeOff = (BlkSize > 0 ? BlkSize-1 : 0);
+
+    ViewType
+      dl0("dl0", N, BlkSizeOff), d0("d0", N, BlkSize), du0("du0", N, BlkSizeOff), b0("b0", N, BlkSize),
+      dl1("dl1", N, BlkSizeOff), d1("d1", N, BlkSize), du1("du1", N, BlkSizeOff), x1("x1", N, BlkSize);
+
+    /// diagonally dominant input
+    typename ViewType::HostMirror 
+      dl0_host = Kokkos::create_mirror_view(dl0), 
+      d0_host  = Kokkos::create_mirror_view(d0), 
+      du0_host = Kokkos::create_mirror_view(du0),
+      b0_host  = Kokkos::create_mirror_view(b0);
+
+    Kokkos::Random_XorShift64_Pool<Kokkos::DefaultHostExecutionSpace> random(13718);
+    auto gen = random.get_state();
+    for (int k=0;k<N;++k)
+      for (int l=0;l<vl;++l) 
+        for (int i=0;i<BlkSize;++i) {
+          lane_type::get(d0_host(k,i), l) = gen.drand(2.0, 3.0);
+          lane_type::get(b0_host(k,i), l) = gen.drand(-1.0, 1.0);
+          if (i < BlkSizeOff) {
+            lane_type::get(dl0_host(k,i), l) = gen.drand(-1.0, 1.0);
+            lane_type::get(du0_host(k,i), l) = gen.drand(-1.0, 1.0);
+          }
+        }
+    random.free_state(gen);
+
+    Kokkos::deep_copy(dl0, dl0_host);
+    Kokkos::deep_copy(d0,  d0_host);
+    Kokkos::deep_copy(du0, du0_host);
+    Kokkos::deep_copy(b0,  b0_host);
+
+    Kokkos::deep_copy(dl1, dl0);
+    Kokkos::deep_copy(d1,  d0);
+    Kokkos::deep_copy(du1, du0);
+    Kokkos::deep_copy(x1,  b0);
+
+    Functor_TestBatchedSerialTridiagonalSolve<DeviceType,ViewType,AlgoTagType>(dl1, d1, du1, x1).run();
+
+    Kokkos::fence();
+
+    typename ViewType::HostMirror x1_host = Kokkos::create_mirror_view(x1);
+    Kokkos::deep_copy(x1_host, x1);
+
+    /// normwise backward error |A x - b| / (|A| |x| + |b|)
+    typedef typename ats::mag_type mag_type;
+    mag_type sum(0), diff(0);
+    const mag_type eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k)
+      for (int l=0;l<vl;++l)
+        for (int i=0;i<BlkSize;++i) {
+          const scalar_type 
+            bi = lane_type::get(b0_host(k,i), l),
+            di = lane_type::get(d0_host(k,i), l),
+            xi = lane_type::get(x1_host(k,i), l);
+          scalar_type r = di*xi - bi;
+          sum += ats::abs(bi) + ats::abs(di)*ats::abs(xi);
+          if (i > 0) {
+            const scalar_type 
+              ai = lane_type::get(dl0_host(k,i-1), l),
+              xj = lane_type::get(x1_host(k,i-1), l);
+            r += ai*xj;
+            sum += ats::abs(ai)*ats::abs(xj);
+          }
+          if (i < (BlkSize-1)) {
+            const scalar_type 
+              ci = lane_type::get(du0_host(k,i), l),
+              xj = lane_type::get(x1_host(k,i+1), l);
+            r += ci*xj;
+            sum += ats::abs(ci)*ats::abs(xj);
+          }
+          diff += ats::abs(r);
+        }
+    if (sum > 0) EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+}
+
+
+template<typename DeviceType,
+         typename ValueType,
+         typename AlgoTagType>
+int test_batched_serial_tridiagonal_solve() {
+  /// short and long systems
+  const int BlkSizes[] = { 0, 1, 2, 3, 7, 8, 9, 31, 64, 100 };
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::View<ValueType**,Kokkos::LayoutLeft,DeviceType> ViewType;
+    Test::impl_test_batched_tridiagonal_solve<DeviceType,ViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_tridiagonal_solve<DeviceType,ViewType,AlgoTagType>(1024, BlkSizes[i]);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::View<ValueType**,Kokkos::LayoutRight,DeviceType> ViewType;
+    Test::impl_test_batched_tridiagonal_solve<DeviceType,ViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_tridiagonal_solve<DeviceType,ViewType,AlgoTagType>(1024, BlkSizes[i]);
+    }
+  }
+#endif
+
+  return 0;
+}
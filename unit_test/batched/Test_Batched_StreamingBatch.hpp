@@ -0,0 +1,94 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_StreamingBatch_Decl.hpp"
+#include "KokkosBatched_StreamingBatch_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename DeviceType,
+           typename ScalarType,
+           typename VectorType,
+           typename ArrayLayout>
+  void impl_test_batched_streaming_lu_solve(const int N, const int m, const int nrhs, const int chunk_size) {
+    typedef Kokkos::View<ScalarType***,ArrayLayout,Kokkos::HostSpace> ViewType;
+    typedef Kokkos::DefaultHostExecutionSpace host_space;
+    typedef Kokkos::Details::ArithTraits<ScalarType> ats;
+
+    /// the batch lives on the host, whatever the device
+    ViewType a0("a0", N, m, m), b0("b0", N, m, nrhs);
+    Kokkos::Random_XorShift64_Pool<host_space> random(13718);
+    Kokkos::fill_random(a0, random, ScalarType(1.0));
+    Kokkos::fill_random(b0, random, ScalarType(1.0));
+    for (int k=0;k<N;++k)
+      for (int i=0;i<m;++i)
+        a0(k,i,i) += ScalarType(m);
+
+    ViewType a("a", N, m, m), x("x", N, m, nrhs);
+    Kokkos::deep_copy(a, a0);
+    Kokkos::deep_copy(x, b0);
+
+    streaming_batched_lu_solve<DeviceType,VectorType>(a, x, chunk_size);
+
+    /// residual of every matrix, A0 X = B0
+    const typename ats::mag_type eps = 1.0e3 * ats::epsilon();
+    int nfail = 0;
+    for (int k=0;k<N;++k)
+      for (int i=0;i<m;++i)
+        for (int r=0;r<nrhs;++r) {
+          ScalarType ax = 0;
+          for (int j=0;j<m;++j)
+            ax += a0(k,i,j)*x(k,j,r);
+          nfail += (ats::abs(ax - b0(k,i,r)) > eps*m);
+        }
+    EXPECT_EQ( nfail, 0);
+  }
+}
+
+template<typename DeviceType,
+         typename ScalarType,
+         typename VectorType>
+int test_batched_streaming_batch() {
+  enum : int { vector_length = VectorType::vector_length };
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::LayoutLeft layout_type;
+    Test::impl_test_batched_streaming_lu_solve<DeviceType,ScalarType,VectorType,layout_type>( 0, 3, 2, 4);
+    Test::impl_test_batched_streaming_lu_solve<DeviceType,ScalarType,VectorType,layout_type>( 1, 3, 2, 4);
+    for (int i=1;i<8;++i) {
+      Test::impl_test_batched_streaming_lu_solve<DeviceType,ScalarType,VectorType,layout_type>(37, i, 2, 1);
+      Test::impl_test_batched_streaming_lu_solve<DeviceType,ScalarType,VectorType,layout_type>(37, i, 2, 3*vector_length);
+      Test::impl_test_batched_streaming_lu_solve<DeviceType,ScalarType,VectorType,layout_type>(37, i, 2, 37);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::LayoutRight layout_type;
+    Test::impl_test_batched_streaming_lu_solve<DeviceType,ScalarType,VectorType,layout_type>( 0, 3, 2, 4);
+    Test::impl_test_batched_streaming_lu_solve<DeviceType,ScalarType,VectorType,layout_type>( 1, 3, 2, 4);
+    for (int i=1;i<8;++i) {
+      Test::impl_test_batched_streaming_lu_solve<DeviceType,ScalarType,VectorType,layout_type>(37, i, 1, 1);
+      Test::impl_test_batched_streaming_lu_solve<DeviceType,ScalarType,VectorType,layout_type>(37, i, 1, 2*vector_length+1);
+      Test::impl_test_batched_streaming_lu_solve<DeviceType,ScalarType,VectorType,layout_type>(37, i, 1, 100);
+    }
+  }
+#endif
+  {
+    typedef Kokkos::View<ScalarType***,Kokkos::LayoutRight,Kokkos::HostSpace> view_type;
+    view_type a("a", 4, 3, 3), b("b", 4, 3, 1), c("c", 4, 2, 1);
+    EXPECT_THROW((streaming_batched_lu_solve<DeviceType,VectorType>(a, b, 0)), std::runtime_error);
+    EXPECT_THROW((streaming_batched_lu_solve<DeviceType,VectorType>(a, c, 4)), std::runtime_error);
+  }
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_vector_streaming_batch_float ) {
+  typedef Vector<SIMD<float>,DefaultVectorLength<float,TestExecSpace::memory_space>::value> vector_type;
+  test_batched_streaming_batch<TestExecSpace,float,vector_type>();
+}
+#endif
+
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_vector_streaming_batch_double ) {
+  typedef Vector<SIMD<double>,DefaultVectorLength<double,TestExecSpace::memory_space>::value> vector_type;
+  test_batched_streaming_batch<TestExecSpace,double,vector_type>();
+}
+#endif
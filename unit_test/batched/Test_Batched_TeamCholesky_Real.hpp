@@ -0,0 +1,22 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_scalar_team_cholesky_float ) {
+  typedef Algo::Cholesky::Blocked algo_tag_type;
+  test_batched_cholesky<TestExecSpace,float,algo_tag_type>();
+}
+#endif
+
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_scalar_team_cholesky_double ) {
+  typedef Algo::Cholesky::Blocked algo_tag_type;
+  test_batched_cholesky<TestExecSpace,double,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_team_cholesky_unblocked_double ) {
+  typedef Algo::Cholesky::Unblocked algo_tag_type;
+  test_batched_cholesky<TestExecSpace,double,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_vector_team_cholesky_double ) {
+  typedef Algo::Cholesky::Blocked algo_tag_type;
+  test_batched_cholesky<TestExecSpace,Vector<SIMD<double>,4>,algo_tag_type>();
+}
+#endif
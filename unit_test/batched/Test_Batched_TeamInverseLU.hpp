@@ -0,0 +1,150 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+//#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_LU_Decl.hpp"
+#include "KokkosBatched_LU_Team_Impl.hpp"
+#include "KokkosBatched_InverseLU_Decl.hpp"
+#include "KokkosBatched_InverseLU_Team_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename VectorViewType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedTeamInverseLU {
+    ViewType _a, _w;
+    VectorViewType _b, _x;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedTeamInverseLU(const ViewType &a, const ViewType &w,
+                                     const VectorViewType &b, const VectorViewType &x)
+      : _a(a), _w(w), _b(b), _x(x) {}
+
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const MemberType &member) const {
+      const int k = member.league_rank();
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      auto ww = Kokkos::subview(_w, k, Kokkos::ALL(), Kokkos::ALL());
+      auto bb = Kokkos::subview(_b, k, Kokkos::ALL());
+      auto xx = Kokkos::subview(_x, k, Kokkos::ALL());
+
+      TeamLU<MemberType,AlgoTagType>::invoke(member, aa);
+      member.team_barrier();
+      TeamInverseLU<MemberType,AlgoTagType>::invoke(member, aa, ww);
+      TeamApplyInverse<MemberType,Trans::NoTranspose,Algo::Gemv::Blocked>::invoke(member, aa, bb, xx);
+    }
+
+    inline
+    void run() {
+      const int league_size = _a.extent(0);
+      Kokkos::TeamPolicy<DeviceType> policy(league_size, Kokkos::AUTO);
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename VectorViewType,
+           typename AlgoTagType>
+  void impl_test_batched_inverselu(const int N, const int BlkSize) {
+    typedef typename ViewType::value_type value_type;
+    typedef Kokkos::Details::ArithTraits<value_type> ats;
+
+    /// randomized input testing views; diagonally dominant for no piv LU
+    ViewType
+      a0("a0", N, BlkSize, BlkSize), a1("a1", N, BlkSize, BlkSize),
+      w("w", N, BlkSize, BlkSize);
+    VectorViewType
+      b("b", N, BlkSize), x("x", N, BlkSize);
+
+    Kokkos::Random_XorShift64_Pool<typename DeviceType::execution_space> random(13718);
+    Kokkos::fill_random(a0, random, value_type(1.0));
+    Kokkos::fill_random(b,  random, value_type(1.0));
+
+    Kokkos::fence();
+
+    typename ViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+    Kokkos::deep_copy(a0_host, a0);
+    for (int k=0;k<N;++k)
+      for (int i=0;i<BlkSize;++i)
+        a0_host(k,i,i) += 10.0;
+    Kokkos::deep_copy(a0, a0_host);
+    Kokkos::deep_copy(a1, a0);
+
+    Functor_TestBatchedTeamInverseLU<DeviceType,ViewType,VectorViewType,AlgoTagType>(a1, w, b, x).run();
+
+    Kokkos::fence();
+
+    /// for comparison send it to host
+    typename ViewType::HostMirror a1_host = Kokkos::create_mirror_view(a1);
+    typename VectorViewType::HostMirror b_host = Kokkos::create_mirror_view(b);
+    typename VectorViewType::HostMirror x_host = Kokkos::create_mirror_view(x);
+
+    Kokkos::deep_copy(a1_host, a1);
+    Kokkos::deep_copy(b_host, b);
+    Kokkos::deep_copy(x_host, x);
+
+    /// check A inv(A) = I and A x = b ; this eps is about 10^-14
+    typedef typename ats::mag_type mag_type;
+    mag_type sum(1), diff(0), sum_x(1), diff_x(0);
+    const mag_type eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k)
+      for (int i=0;i<BlkSize;++i) {
+        for (int j=0;j<BlkSize;++j) {
+          value_type c(0);
+          for (int p=0;p<BlkSize;++p)
+            c += a0_host(k,i,p)*a1_host(k,p,j);
+          sum  += 1.0*(i == j);
+          diff += ats::abs(c - value_type(1.0*(i == j)));
+        }
+        value_type r(0);
+        for (int p=0;p<BlkSize;++p)
+          r += a0_host(k,i,p)*x_host(k,p);
+        sum_x  += ats::abs(b_host(k,i));
+        diff_x += ats::abs(r - b_host(k,i));
+      }
+    EXPECT_NEAR_KK( diff/sum, 0, eps);
+    EXPECT_NEAR_KK( diff_x/sum_x, 0, eps);
+  }
+}
+
+
+template<typename DeviceType,
+         typename ValueType,
+         typename AlgoTagType>
+int test_batched_inverselu() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutLeft,DeviceType> ViewType;
+    typedef Kokkos::View<ValueType**,Kokkos::LayoutLeft,DeviceType> VectorViewType;
+    Test::impl_test_batched_inverselu<DeviceType,ViewType,VectorViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_inverselu<DeviceType,ViewType,VectorViewType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutRight,DeviceType> ViewType;
+    typedef Kokkos::View<ValueType**,Kokkos::LayoutRight,DeviceType> VectorViewType;
+    Test::impl_test_batched_inverselu<DeviceType,ViewType,VectorViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_inverselu<DeviceType,ViewType,VectorViewType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,18 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_scalar_team_lu_pivot_float ) {
+  typedef Algo::LU::Unblocked algo_tag_type;
+  test_batched_lu_pivot<TestExecSpace,float,algo_tag_type>();
+}
+#endif
+
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_scalar_team_lu_pivot_double ) {
+  typedef Algo::LU::Unblocked algo_tag_type;
+  test_batched_lu_pivot<TestExecSpace,double,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_vector_team_lu_pivot_double ) {
+  typedef Algo::LU::Unblocked algo_tag_type;
+  test_batched_lu_pivot<TestExecSpace,Vector<SIMD<double>,4>,algo_tag_type>();
+}
+#endif
@@ -0,0 +1,281 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+//#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_Gemm_Decl.hpp"
+#include "KokkosBatched_Gemm_Team_Impl.hpp"
+#include "KokkosBatched_LU_Decl.hpp"
+#include "KokkosBatched_LU_Team_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename TA, typename TB>
+  struct ParamTag { 
+    typedef TA transA;
+    typedef TB transB;
+  };
+
+  struct ReferenceTag {};
+  struct MixedTag {};
+
+  /// copy a low precision view into a high precision view of the same shape
+  template<typename HighViewType, typename LowViewType>
+  void widen_copy(const HighViewType &dst, const LowViewType &src) {
+    typename LowViewType::HostMirror src_host = Kokkos::create_mirror_view(src);
+    typename HighViewType::HostMirror dst_host = Kokkos::create_mirror_view(dst);
+    Kokkos::deep_copy(src_host, src);
+    for (int k=0;k<int(src.extent(0));++k)
+      for (int i=0;i<int(src.extent(1));++i)
+        for (int j=0;j<int(src.extent(2));++j)
+          dst_host(k,i,j) = src_host(k,i,j);
+    Kokkos::deep_copy(dst, dst_host);
+  }
+
+  template<typename DeviceType,
+           typename ABViewType,
+           typename CViewType,
+           typename ParamTagType, 
+           typename AlgoTagType>
+  struct Functor_TestBatchedTeamGemmMixed {
+    ABViewType _a, _b;
+    CViewType _c;
+    
+    double _alpha, _beta;
+    
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedTeamGemmMixed(const double alpha, 
+            const ABViewType &a,
+            const ABViewType &b,
+            const double beta,
+            const CViewType &c)
+      : _a(a), _b(b), _c(c), _alpha(alpha), _beta(beta) {}
+
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const ParamTagType &, const MemberType &member) const {
+      const int k = member.league_rank();
+
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      auto bb = Kokkos::subview(_b, k, Kokkos::ALL(), Kokkos::ALL());
+      auto cc = Kokkos::subview(_c, k, Kokkos::ALL(), Kokkos::ALL());
+      
+      TeamGemm<MemberType,
+        typename ParamTagType::transA,
+        typename ParamTagType::transB,
+        AlgoTagType>::
+        invoke(member, _alpha, aa, bb, _beta, cc);
+    }
+    
+    inline
+    void run() {
+      const int league_size = _c.extent(0);
+      Kokkos::TeamPolicy<DeviceType,ParamTagType> policy(league_size, Kokkos::AUTO);
+      Kokkos::parallel_for(policy, *this);            
+    }
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedTeamLUMixed {
+    ViewType _a;
+    
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedTeamLUMixed(const ViewType &a) 
+      : _a(a) {}
+
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const ReferenceTag &, const MemberType &member) const {
+      auto aa = Kokkos::subview(_a, member.league_rank(), Kokkos::ALL(), Kokkos::ALL());
+      TeamLU<MemberType,Algo::LU::Unblocked>::invoke(member, aa);
+    }
+
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const MixedTag &, const MemberType &member) const {
+      auto aa = Kokkos::subview(_a, member.league_rank(), Kokkos::ALL(), Kokkos::ALL());
+      TeamLUMixed<MemberType,AlgoTagType>::invoke(member, aa);
+    }
+
+    template<typename TagType>
+    inline
+    void run() {
+      const int league_size = _a.extent(0);
+      Kokkos::TeamPolicy<DeviceType,TagType> policy(league_size, Kokkos::AUTO);
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename LowViewType,
+           typename HighViewType,
+           typename ParamTagType, 
+           typename AlgoTagType>
+  void impl_test_batched_mixed_gemm(const int N, const int BlkSize) {
+    typedef Kokkos::Details::ArithTraits<double> ats;
+
+    /// randomized input testing views; a and b are exactly representable in both
+    const double alpha = 1.5, beta = 3.0;
+
+    LowViewType
+      a0("a0", N, BlkSize,BlkSize), 
+      b0("b0", N, BlkSize,BlkSize);
+    HighViewType
+      a1("a1", N, BlkSize,BlkSize), 
+      b1("b1", N, BlkSize,BlkSize),
+      c0("c0", N, BlkSize,BlkSize), c1("c1", N, BlkSize, BlkSize);
+
+    Kokkos::Random_XorShift64_Pool<typename DeviceType::execution_space> random(13718);
+    Kokkos::fill_random(a0, random, float(1.0));
+    Kokkos::fill_random(b0, random, float(1.0));
+    Kokkos::fill_random(c0, random, double(1.0));
+
+    Kokkos::fence();
+
+    widen_copy(a1, a0);
+    widen_copy(b1, b0);
+    Kokkos::deep_copy(c1, c0);
+
+    /// double precision reference
+    Functor_TestBatchedTeamGemmMixed<DeviceType,HighViewType,HighViewType,
+      ParamTagType,Algo::Gemm::Unblocked>(alpha, a1, b1, beta, c1).run();
+    Functor_TestBatchedTeamGemmMixed<DeviceType,LowViewType,HighViewType,
+      ParamTagType,AlgoTagType>(alpha, a0, b0, beta, c0).run();
+
+    Kokkos::fence();
+
+    /// for comparison send it to host
+    typename HighViewType::HostMirror c0_host = Kokkos::create_mirror_view(c0);
+    typename HighViewType::HostMirror c1_host = Kokkos::create_mirror_view(c1);
+
+    Kokkos::deep_copy(c0_host, c0);
+    Kokkos::deep_copy(c1_host, c1);
+
+    /// check c0 = c1 in double precision ; this eps is about 10^-13
+    double sum(1), diff(0);
+    const double eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k) 
+      for (int i=0;i<BlkSize;++i) 
+        for (int j=0;j<BlkSize;++j) {
+          sum  += ats::abs(c0_host(k,i,j));
+          diff += ats::abs(c0_host(k,i,j)-c1_host(k,i,j));
+        }
+    EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+
+  template<typename DeviceType,
+           typename LowViewType,
+           typename HighViewType,
+           typename AlgoTagType>
+  void impl_test_batched_mixed_lu(const int N, const int BlkSize) {
+    typedef Kokkos::Details::ArithTraits<float> ats;
+
+    /// randomized input testing views; diagonally dominant
+    LowViewType a0("a0", N, BlkSize,BlkSize);
+    HighViewType a1("a1", N, BlkSize,BlkSize);
+
+    Kokkos::Random_XorShift64_Pool<typename DeviceType::execution_space> random(13718);
+    Kokkos::fill_random(a0, random, float(1.0));
+
+    Kokkos::fence();
+    {
+      typename LowViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+      Kokkos::deep_copy(a0_host, a0);
+      for (int k=0;k<N;++k)
+        for (int i=0;i<BlkSize;++i)
+          a0_host(k,i,i) += 10.0;
+      Kokkos::deep_copy(a0, a0_host);
+    }
+    widen_copy(a1, a0);
+
+    /// double precision reference
+    Functor_TestBatchedTeamLUMixed<DeviceType,HighViewType,AlgoTagType>(a1).template run<ReferenceTag>();
+    Functor_TestBatchedTeamLUMixed<DeviceType,LowViewType,AlgoTagType>(a0).template run<MixedTag>();
+
+    Kokkos::fence();
+
+    /// for comparison send it to host
+    typename LowViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+    typename HighViewType::HostMirror a1_host = Kokkos::create_mirror_view(a1);
+
+    Kokkos::deep_copy(a0_host, a0);
+    Kokkos::deep_copy(a1_host, a1);
+
+    /// check a0 = a1 in single precision ; this eps is about 10^-4
+    double sum(1), diff(0);
+    const double eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k) 
+      for (int i=0;i<BlkSize;++i) 
+        for (int j=0;j<BlkSize;++j) {
+          sum  += std::abs(a1_host(k,i,j));
+          diff += std::abs(double(a0_host(k,i,j))-a1_host(k,i,j));
+        }
+    EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+}
+
+template<typename DeviceType, 
+         typename ParamTagType,
+         typename AlgoTagType>
+int test_batched_mixed_gemm() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) 
+  {
+    typedef Kokkos::View<float***,Kokkos::LayoutLeft,DeviceType> LowViewType;
+    typedef Kokkos::View<double***,Kokkos::LayoutLeft,DeviceType> HighViewType;
+    Test::impl_test_batched_mixed_gemm<DeviceType,LowViewType,HighViewType,ParamTagType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_mixed_gemm<DeviceType,LowViewType,HighViewType,ParamTagType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) 
+  {
+    typedef Kokkos::View<float***,Kokkos::LayoutRight,DeviceType> LowViewType;
+    typedef Kokkos::View<double***,Kokkos::LayoutRight,DeviceType> HighViewType;
+    Test::impl_test_batched_mixed_gemm<DeviceType,LowViewType,HighViewType,ParamTagType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_mixed_gemm<DeviceType,LowViewType,HighViewType,ParamTagType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+  
+  return 0;
+}
+
+template<typename DeviceType, 
+         typename AlgoTagType>
+int test_batched_mixed_lu() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) 
+  {
+    typedef Kokkos::View<float***,Kokkos::LayoutLeft,DeviceType> LowViewType;
+    typedef Kokkos::View<double***,Kokkos::LayoutLeft,DeviceType> HighViewType;
+    Test::impl_test_batched_mixed_lu<DeviceType,LowViewType,HighViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_mixed_lu<DeviceType,LowViewType,HighViewType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) 
+  {
+    typedef Kokkos::View<float***,Kokkos::LayoutRight,DeviceType> LowViewType;
+    typedef Kokkos::View<double***,Kokkos::LayoutRight,DeviceType> HighViewType;
+    Test::impl_test_batched_mixed_lu<DeviceType,LowViewType,HighViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_mixed_lu<DeviceType,LowViewType,HighViewType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+  
+  return 0;
+}
@@ -0,0 +1,18 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_scalar_team_tridiagonal_solve_float ) {
+  typedef Algo::Tridiagonal::CyclicReduction algo_tag_type;
+  test_batched_team_tridiagonal_solve<TestExecSpace,float,algo_tag_type>();
+}
+#endif
+
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_scalar_team_tridiagonal_solve_double ) {
+  typedef Algo::Tridiagonal::CyclicReduction algo_tag_type;
+  test_batched_team_tridiagonal_solve<TestExecSpace,double,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_vector_team_tridiagonal_solve_double ) {
+  typedef Algo::Tridiagonal::CyclicReduction algo_tag_type;
+  test_batched_team_tridiagonal_solve<TestExecSpace,Vector<SIMD<double>,4>,algo_tag_type>();
+}
+#endif
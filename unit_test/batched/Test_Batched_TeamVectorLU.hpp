@@ -0,0 +1,153 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+//#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_LU_Decl.hpp"
+#include "KokkosBatched_LU_Serial_Impl.hpp"
+#include "KokkosBatched_LU_TeamVector_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  struct ParamTag {};
+
+  struct SerialRefTag {};
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedTeamVectorLU {
+    ViewType _a;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedTeamVectorLU(const ViewType &a)
+      : _a(a) {}
+
+    /// reference; one matrix per index
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const SerialRefTag &, const int k) const {
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+
+      SerialLU<Algo::LU::Unblocked>::
+          invoke(aa);
+    }
+
+    /// one matrix per thread, its entries over the vector lanes
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const ParamTag &, const MemberType &member) const {
+      const int k = member.league_rank()*member.team_size() + member.team_rank();
+      if (k < int(_a.extent(0))) {
+        auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+
+        TeamVectorLU<MemberType,AlgoTagType>::
+            invoke(member, aa);
+      }
+    }
+
+    inline
+    void run_reference() {
+      Kokkos::RangePolicy<DeviceType,SerialRefTag> policy(0, _a.extent(0));
+      Kokkos::parallel_for(policy, *this);
+    }
+
+    inline
+    void run() {
+      typedef Kokkos::TeamPolicy<DeviceType,ParamTag> policy_type;
+      const int vector_size = 4;
+      const int team_size = std::min(4, policy_type::team_size_recommended(*this, vector_size));
+      const int league_size = _a.extent(0)/team_size + (_a.extent(0)%team_size > 0);
+      policy_type policy(league_size, team_size, vector_size);
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename AlgoTagType>
+  void impl_test_batched_teamvector_lu(const int N, const int BlkSize) {
+    typedef typename ViewType::value_type value_type;
+    typedef Kokkos::Details::ArithTraits<value_type> ats;
+
+    /// randomized input testing views
+    ViewType
+      a0("a0", N, BlkSize, BlkSize), a1("a1", N, BlkSize, BlkSize);
+
+    Kokkos::Random_XorShift64_Pool<typename DeviceType::execution_space> random(13718);
+    Kokkos::fill_random(a0, random, value_type(1.0));
+
+    Kokkos::fence();
+
+    /// diagonally dominant a so that the solutions stay well scaled
+    {
+      typename ViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+      Kokkos::deep_copy(a0_host, a0);
+      for (int k=0;k<N;++k)
+        for (int i=0;i<BlkSize;++i)
+          a0_host(k,i,i) += 10.0;
+      Kokkos::deep_copy(a0, a0_host);
+    }
+
+    Kokkos::deep_copy(a1, a0);
+
+    /// serial unblocked is the reference
+    Functor_TestBatchedTeamVectorLU<DeviceType,ViewType,AlgoTagType>(a0).run_reference();
+    Functor_TestBatchedTeamVectorLU<DeviceType,ViewType,AlgoTagType>(a1).run();
+
+    Kokkos::fence();
+
+    /// for comparison send it to host
+    typename ViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+    typename ViewType::HostMirror a1_host = Kokkos::create_mirror_view(a1);
+
+    Kokkos::deep_copy(a0_host, a0);
+    Kokkos::deep_copy(a1_host, a1);
+
+    /// check a0 = a1 ; this eps is about 10^-14
+    typedef typename ats::mag_type mag_type;
+    mag_type sum(1), diff(0);
+    const mag_type eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k)
+      for (int i=0;i<BlkSize;++i)
+        for (int j=0;j<BlkSize;++j) {
+          sum  += ats::abs(a0_host(k,i,j));
+          diff += ats::abs(a0_host(k,i,j)-a1_host(k,i,j));
+        }
+    EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+}
+
+
+template<typename DeviceType,
+         typename ValueType,
+         typename AlgoTagType>
+int test_batched_teamvector_lu() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutLeft,DeviceType> ViewType;
+    Test::impl_test_batched_teamvector_lu<DeviceType,ViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_teamvector_lu<DeviceType,ViewType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutRight,DeviceType> ViewType;
+    Test::impl_test_batched_teamvector_lu<DeviceType,ViewType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_teamvector_lu<DeviceType,ViewType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_scalar_teamvector_lu_float ) {
+  typedef Algo::LU::Unblocked algo_tag_type;
+  test_batched_teamvector_lu<TestExecSpace,float,algo_tag_type>();
+}
+#endif
+
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_scalar_teamvector_lu_double ) {
+  typedef Algo::LU::Unblocked algo_tag_type;
+  test_batched_teamvector_lu<TestExecSpace,double,algo_tag_type>();
+}
+#endif
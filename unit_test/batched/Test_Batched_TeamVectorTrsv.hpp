@@ -0,0 +1,180 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+//#include "KokkosBatched_Vector.hpp"
+
+#include "KokkosBatched_Trsv_Decl.hpp"
+#include "KokkosBatched_Trsv_Serial_Impl.hpp"
+#include "KokkosBatched_Trsv_TeamVector_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename U, typename T, typename D>
+  struct ParamTag {
+    typedef U uplo;
+    typedef T trans;
+    typedef D diag;
+  };
+
+  struct SerialRefTag {};
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename ScalarType,
+           typename ParamTagType,
+           typename AlgoTagType>
+  struct Functor_TestBatchedTeamVectorTrsv {
+    ViewType _a, _b;
+
+    ScalarType _alpha;
+
+    KOKKOS_INLINE_FUNCTION
+    Functor_TestBatchedTeamVectorTrsv(const ScalarType alpha, const ViewType &a, const ViewType &b)
+      : _a(a), _b(b), _alpha(alpha) {}
+
+    /// reference; one matrix per index
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const SerialRefTag &, const int k) const {
+      auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+      auto bb = Kokkos::subview(_b, k, Kokkos::ALL(), 0);
+
+      SerialTrsv<typename ParamTagType::uplo,
+          typename ParamTagType::trans,
+          typename ParamTagType::diag,
+          Algo::Trsv::Unblocked>::
+          invoke(_alpha, aa, bb);
+    }
+
+    /// one matrix per thread, its entries over the vector lanes
+    template<typename MemberType>
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const ParamTagType &, const MemberType &member) const {
+      const int k = member.league_rank()*member.team_size() + member.team_rank();
+      if (k < int(_b.extent(0))) {
+        auto aa = Kokkos::subview(_a, k, Kokkos::ALL(), Kokkos::ALL());
+        auto bb = Kokkos::subview(_b, k, Kokkos::ALL(), 0);
+
+        TeamVectorTrsv<MemberType,
+            typename ParamTagType::uplo,
+            typename ParamTagType::trans,
+            typename ParamTagType::diag,
+            AlgoTagType>::
+            invoke(member, _alpha, aa, bb);
+      }
+    }
+
+    inline
+    void run_reference() {
+      Kokkos::RangePolicy<DeviceType,SerialRefTag> policy(0, _b.extent(0));
+      Kokkos::parallel_for(policy, *this);
+    }
+
+    inline
+    void run() {
+      typedef Kokkos::TeamPolicy<DeviceType,ParamTagType> policy_type;
+      const int vector_size = 4;
+      const int team_size = std::min(4, policy_type::team_size_recommended(*this, vector_size));
+      const int league_size = _b.extent(0)/team_size + (_b.extent(0)%team_size > 0);
+      policy_type policy(league_size, team_size, vector_size);
+      Kokkos::parallel_for(policy, *this);
+    }
+  };
+
+  template<typename DeviceType,
+           typename ViewType,
+           typename ScalarType,
+           typename ParamTagType,
+           typename AlgoTagType>
+  void impl_test_batched_teamvector_trsv(const int N, const int BlkSize) {
+    typedef typename ViewType::value_type value_type;
+    typedef Kokkos::Details::ArithTraits<value_type> ats;
+
+    /// randomized input testing views
+    ScalarType alpha(1.5);
+
+    ViewType
+      a0("a0", N, BlkSize, BlkSize), a1("a1", N, BlkSize, BlkSize),
+      b0("b0", N, BlkSize, 1), b1("b1", N, BlkSize, 1);
+
+    Kokkos::Random_XorShift64_Pool<typename DeviceType::execution_space> random(13718);
+    Kokkos::fill_random(a0, random, value_type(1.0));
+    Kokkos::fill_random(b0, random, value_type(1.0));
+
+    Kokkos::fence();
+
+    /// diagonally dominant a so that the solutions stay well scaled
+    {
+      typename ViewType::HostMirror a0_host = Kokkos::create_mirror_view(a0);
+      Kokkos::deep_copy(a0_host, a0);
+      for (int k=0;k<N;++k)
+        for (int i=0;i<BlkSize;++i)
+          a0_host(k,i,i) += 10.0;
+      Kokkos::deep_copy(a0, a0_host);
+    }
+
+    Kokkos::deep_copy(a1, a0);
+    Kokkos::deep_copy(b1, b0);
+
+    /// serial unblocked is the reference
+    Functor_TestBatchedTeamVectorTrsv<DeviceType,ViewType,ScalarType,ParamTagType,AlgoTagType>(alpha, a0, b0).run_reference();
+    Functor_TestBatchedTeamVectorTrsv<DeviceType,ViewType,ScalarType,ParamTagType,AlgoTagType>(alpha, a1, b1).run();
+
+    Kokkos::fence();
+
+    /// for comparison send it to host
+    typename ViewType::HostMirror b0_host = Kokkos::create_mirror_view(b0);
+    typename ViewType::HostMirror b1_host = Kokkos::create_mirror_view(b1);
+
+    Kokkos::deep_copy(b0_host, b0);
+    Kokkos::deep_copy(b1_host, b1);
+
+    /// check b0 = b1 ; this eps is about 10^-14
+    typedef typename ats::mag_type mag_type;
+    mag_type sum(1), diff(0);
+    const mag_type eps = 1.0e3 * ats::epsilon();
+
+    for (int k=0;k<N;++k)
+      for (int i=0;i<BlkSize;++i)
+        for (int j=0;j<1;++j) {
+          sum  += ats::abs(b0_host(k,i,j));
+          diff += ats::abs(b0_host(k,i,j)-b1_host(k,i,j));
+        }
+    EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+}
+
+
+template<typename DeviceType,
+         typename ValueType,
+         typename ScalarType,
+         typename ParamTagType,
+         typename AlgoTagType>
+int test_batched_teamvector_trsv() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutLeft,DeviceType> ViewType;
+    Test::impl_test_batched_teamvector_trsv<DeviceType,ViewType,ScalarType,ParamTagType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_teamvector_trsv<DeviceType,ViewType,ScalarType,ParamTagType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT)
+  {
+    typedef Kokkos::View<ValueType***,Kokkos::LayoutRight,DeviceType> ViewType;
+    Test::impl_test_batched_teamvector_trsv<DeviceType,ViewType,ScalarType,ParamTagType,AlgoTagType>(     0, 10);
+    for (int i=0;i<10;++i) {
+      Test::impl_test_batched_teamvector_trsv<DeviceType,ViewType,ScalarType,ParamTagType,AlgoTagType>(1024,  i);
+    }
+  }
+#endif
+
+  return 0;
+}
@@ -0,0 +1,66 @@
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_l_nt_u_float_float ) {
+  typedef ::Test::ParamTag<Uplo::Lower,Trans::NoTranspose,Diag::Unit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,float,float,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_l_nt_n_float_float ) {
+  typedef ::Test::ParamTag<Uplo::Lower,Trans::NoTranspose,Diag::NonUnit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,float,float,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_u_nt_u_float_float ) {
+  typedef ::Test::ParamTag<Uplo::Upper,Trans::NoTranspose,Diag::Unit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,float,float,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_u_nt_n_float_float ) {
+  typedef ::Test::ParamTag<Uplo::Upper,Trans::NoTranspose,Diag::NonUnit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,float,float,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_l_t_n_float_float ) {
+  typedef ::Test::ParamTag<Uplo::Lower,Trans::Transpose,Diag::NonUnit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,float,float,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_u_t_n_float_float ) {
+  typedef ::Test::ParamTag<Uplo::Upper,Trans::Transpose,Diag::NonUnit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,float,float,param_tag_type,algo_tag_type>();
+}
+#endif
+
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE)
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_l_nt_u_double_double ) {
+  typedef ::Test::ParamTag<Uplo::Lower,Trans::NoTranspose,Diag::Unit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_l_nt_n_double_double ) {
+  typedef ::Test::ParamTag<Uplo::Lower,Trans::NoTranspose,Diag::NonUnit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_u_nt_u_double_double ) {
+  typedef ::Test::ParamTag<Uplo::Upper,Trans::NoTranspose,Diag::Unit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_u_nt_n_double_double ) {
+  typedef ::Test::ParamTag<Uplo::Upper,Trans::NoTranspose,Diag::NonUnit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_l_t_n_double_double ) {
+  typedef ::Test::ParamTag<Uplo::Lower,Trans::Transpose,Diag::NonUnit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
+TEST_F( TestCategory, batched_scalar_teamvector_trsv_u_t_n_double_double ) {
+  typedef ::Test::ParamTag<Uplo::Upper,Trans::Transpose,Diag::NonUnit> param_tag_type;
+  typedef Algo::Trsv::Unblocked algo_tag_type;
+  test_batched_teamvector_trsv<TestExecSpace,double,double,param_tag_type,algo_tag_type>();
+}
+#endif
@@ -0,0 +1,123 @@
+/// \author Kyungjoo Kim (kyukim@sandia.gov)
+
+#include "gtest/gtest.h"
+#include "Kokkos_Core.hpp"
+#include "Kokkos_Random.hpp"
+
+#include "KokkosBatched_Gemm_VBatched_Decl.hpp"
+#include "KokkosBatched_Gemm_VBatched_Impl.hpp"
+
+#include "KokkosKernels_TestUtils.hpp"
+
+using namespace KokkosBatched::Experimental;
+
+namespace Test {
+
+  template<typename TA, typename TB>
+  struct ParamTag { 
+    typedef TA transA;
+    typedef TB transB;
+  };
+
+  template<typename DeviceType,
+           typename ValueType,
+           typename ParamTagType>
+  void impl_test_batched_vbatched_gemm(const int N, const int maxsize) {
+    typedef typename ParamTagType::transA transA;
+    typedef typename ParamTagType::transB transB;
+    typedef Kokkos::Details::ArithTraits<ValueType> ats;
+    typedef typename ats::mag_type mag_type;
+
+    typedef Kokkos::View<int*,DeviceType> size_view_type;
+    typedef Kokkos::View<size_t*,DeviceType> offset_view_type;
+    typedef Kokkos::View<ValueType*,DeviceType> value_view_type;
+
+    size_view_type m("m", N), n("n", N), k("k", N);
+    offset_view_type a_offset("a_offset", N), b_offset("b_offset", N), c_offset("c_offset", N);
+
+    auto m_host = Kokkos::create_mirror_view(m);
+    auto n_host = Kokkos::create_mirror_view(n);
+    auto k_host = Kokkos::create_mirror_view(k);
+    auto a_offset_host = Kokkos::create_mirror_view(a_offset);
+    auto b_offset_host = Kokkos::create_mirror_view(b_offset);
+    auto c_offset_host = Kokkos::create_mirror_view(c_offset);
+
+    /// sizes span all bins including zero sized matrices
+    size_t asize(0), bsize(0), csize(0);
+    for (int i=0;i<N;++i) {
+      m_host(i) = (7*i+1)%(maxsize+1);
+      n_host(i) = (5*i+3)%(maxsize+1);
+      k_host(i) = (3*i+2)%(maxsize+1);
+      a_offset_host(i) = asize; asize += m_host(i)*k_host(i);
+      b_offset_host(i) = bsize; bsize += k_host(i)*n_host(i);
+      c_offset_host(i) = csize; csize += m_host(i)*n_host(i);
+    }
+
+    value_view_type A("A", asize), B("B", bsize), C("C", csize);
+    Kokkos::Random_XorShift64_Pool<DeviceType> random(13718);
+    Kokkos::fill_random(A, random, ValueType(1.0));
+    Kokkos::fill_random(B, random, ValueType(1.0));
+    Kokkos::fill_random(C, random, ValueType(1.0));
+
+    auto A_host = Kokkos::create_mirror_view(A);
+    auto B_host = Kokkos::create_mirror_view(B);
+    auto C_host = Kokkos::create_mirror_view(C);
+    Kokkos::deep_copy(A_host, A);
+    Kokkos::deep_copy(B_host, B);
+    Kokkos::deep_copy(C_host, C);
+
+    Kokkos::deep_copy(m, m_host);
+    Kokkos::deep_copy(n, n_host);
+    Kokkos::deep_copy(k, k_host);
+    Kokkos::deep_copy(a_offset, a_offset_host);
+    Kokkos::deep_copy(b_offset, b_offset_host);
+    Kokkos::deep_copy(c_offset, c_offset_host);
+
+    const ValueType alpha = 1.5, beta = 3.0;
+    VBatchedGemm<transA,transB>::invoke(alpha, m, n, k, 
+                                        A, a_offset, B, b_offset, 
+                                        beta, C, c_offset);
+    Kokkos::fence();
+
+    auto R_host = Kokkos::create_mirror_view(C);
+    Kokkos::deep_copy(R_host, C);
+
+    /// reference on host
+    const bool is_trans_a = std::is_same<transA,Trans::Transpose>::value;
+    const bool is_trans_b = std::is_same<transB,Trans::Transpose>::value;
+
+    mag_type sum(1), diff(0);
+    const mag_type eps = 1.0e3 * ats::epsilon();
+    for (int l=0;l<N;++l) {
+      const int mm = m_host(l), nn = n_host(l), kk = k_host(l);
+      const ValueType 
+        *a = &A_host(0) + a_offset_host(l), 
+        *b = &B_host(0) + b_offset_host(l), 
+        *c = &C_host(0) + c_offset_host(l),
+        *r = &R_host(0) + c_offset_host(l);
+      for (int i=0;i<mm;++i)
+        for (int j=0;j<nn;++j) {
+          ValueType tmp(0);
+          for (int p=0;p<kk;++p) 
+            tmp += ((is_trans_a ? a[p*mm+i] : a[i*kk+p])*
+                    (is_trans_b ? b[j*kk+p] : b[p*nn+j]));
+          const ValueType ref = beta*c[i*nn+j] + alpha*tmp;
+          sum  += ats::abs(ref);
+          diff += ats::abs(ref - r[i*nn+j]);
+        }
+    }
+    EXPECT_NEAR_KK( diff/sum, 0, eps);
+  }
+}
+
+template<typename DeviceType,
+         typename ValueType,
+         typename ParamTagType>
+int test_batched_vbatched_gemm() {
+  Test::impl_test_batched_vbatched_gemm<DeviceType,ValueType,ParamTagType>(  0, 10);
+  Test::impl_test_batched_vbatched_gemm<DeviceType,ValueType,ParamTagType>(  1, 10);
+  Test::impl_test_batched_vbatched_gemm<DeviceType,ValueType,ParamTagType>(197,  4);
+  Test::impl_test_batched_vbatched_gemm<DeviceType,ValueType,ParamTagType>(197, 40);
+  Test::impl_test_batched_vbatched_gemm<DeviceType,ValueType,ParamTagType>( 53, 64);
+  return 0;
+}
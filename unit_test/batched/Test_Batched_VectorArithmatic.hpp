@@ -246,6 +246,27 @@ TEST_F( TestCategory, batched_vector_arithmatic_simd_double8 ) {
 }
 #endif
 
+/// avx 512 specializations on __m512
+#if defined(__AVX512F__)
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+static_assert(std::is_convertible<Vector<SIMD<float>,16>,__m512>::value,
+              "Vector<SIMD<float>,16> is not the __m512 specialization");
+TEST_F( TestCategory, batched_vector_arithmatic_avx512_float16 ) {
+  test_batched_vector_arithmatic<TestExecSpace,SIMD<float>,16>();
+}
+#endif
+#if defined(KOKKOSKERNELS_INST_COMPLEX_FLOAT)
+static_assert(std::is_convertible<Vector<SIMD<Kokkos::complex<float> >,8>,__m512>::value,
+              "Vector<SIMD<Kokkos::complex<float> >,8> is not the __m512 specialization");
+TEST_F( TestCategory, batched_vector_arithmatic_avx512_scomplex8 ) {
+  test_batched_vector_arithmatic<TestExecSpace,SIMD<Kokkos::complex<float> >,8>();
+}
+TEST_F( TestCategory, batched_vector_scomplex_real_imag_value8 ) {
+  test_batched_complex_real_imag_value<TestExecSpace,SIMD<Kokkos::complex<float> >,8>();
+}
+#endif
+#endif
+
 #define __DO_NOT_TEST__ 
 #if defined(KOKKOSKERNELS_INST_COMPLEX_FLOAT)
 TEST_F( TestCategory, batched_vector_arithmatic_simd_scomplex3 ) {
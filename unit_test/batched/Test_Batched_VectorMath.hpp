@@ -4,6 +4,9 @@
 #include "Kokkos_Core.hpp"
 #include "Kokkos_Random.hpp"
 
+#include <cmath>
+#include <limits>
+
 #include "KokkosBatched_Vector.hpp"
 
 #include "KokkosKernels_TestUtils.hpp"
@@ -95,6 +98,96 @@ namespace Test {
       } // end test body
     } // end for
   } // impl
+
+  /// wide argument ranges of the vectorized double precision functions;
+  /// the tolerances are a few ulp, see KokkosBatched_Vector_SIMD_Math_AVX.hpp
+  template<typename VectorTagType,int VectorLength>
+  void impl_test_batched_vector_math_range() {
+    typedef Vector<VectorTagType,VectorLength> vector_type;
+    typedef typename vector_type::value_type value_type;
+    const int vector_length = vector_type::vector_length;
+
+    typedef Kokkos::Details::ArithTraits<value_type> ats;
+    const value_type eps = 4 * ats::epsilon();
+
+    vector_type a, x;
+    Random<value_type> random;
+    for (int iter=0;iter<1000;++iter) {
+      for (int k=0;k<vector_length;++k)
+        x[k] = 700.0*random.value();
+      a = exp(x);
+      for (int i=0;i<vector_length;++i)
+        EXPECT_NEAR_KK( a[i], std::exp(x[i]), eps*std::exp(x[i]) );
+
+      for (int k=0;k<vector_length;++k)
+        x[k] = std::exp(x[k]);
+      a = log(x);
+      for (int i=0;i<vector_length;++i)
+        EXPECT_NEAR_KK( a[i], std::log(x[i]), eps*std::abs(std::log(x[i])) );
+
+      for (int k=0;k<vector_length;++k)
+        x[k] = 1.0e4*random.value();
+      a = sin(x);
+      for (int i=0;i<vector_length;++i)
+        EXPECT_NEAR_KK( a[i], std::sin(x[i]), eps );
+      a = cos(x);
+      for (int i=0;i<vector_length;++i)
+        EXPECT_NEAR_KK( a[i], std::cos(x[i]), eps );
+    }
+
+    /// special values
+    const value_type inf = std::numeric_limits<value_type>::infinity();
+    for (int k=0;k<vector_length;++k)
+      x[k] = k%2 ? -inf : inf;
+    a = exp(x);
+    for (int i=0;i<vector_length;++i)
+      EXPECT_EQ( a[i], std::exp(x[i]) );
+    for (int k=0;k<vector_length;++k)
+      x[k] = k%2 ? 0.0 : inf;
+    a = log(x);
+    for (int i=0;i<vector_length;++i)
+      EXPECT_EQ( a[i], std::log(x[i]) );
+    for (int k=0;k<vector_length;++k)
+      x[k] = k%2 ? -1.0 : 1.0e10;
+    /// pow(a,b) = exp(b log a) rounds b log a, so its relative error grows with |b log a|
+    const value_type b = 2.0;
+    a = pow(x, b);
+    for (int i=0;i<vector_length;++i) {
+      const value_type tol = (2 + std::abs(b*std::log(std::abs(x[i]))))*ats::epsilon();
+      EXPECT_NEAR_KK( a[i], std::pow(x[i], b), tol*std::pow(x[i], b) );
+    }
+  }
+
+  /// complex vectors only have sqrt; its square goes through the vector
+  /// multiply and the quotient through the vector divide
+  template<typename VectorTagType,int VectorLength>
+  void impl_test_batched_vector_math_complex() {
+    typedef Vector<VectorTagType,VectorLength> vector_type;
+    typedef typename vector_type::value_type value_type;
+    const int vector_length = vector_type::vector_length;
+
+    typedef Kokkos::Details::ArithTraits<value_type> ats;
+    typedef typename ats::mag_type mag_type;
+
+    vector_type a, r, c;
+    const mag_type eps = 1.0e3 * ats::epsilon();
+
+    Random<value_type> random;
+    for (int iter=0;iter<100;++iter) {
+      for (int k=0;k<vector_length;++k)
+        a[k] = random.value() + value_type(1.0, 0.0);
+
+      r = sqrt(a);
+      for (int i=0;i<vector_length;++i)
+        EXPECT_NEAR_KK( r[i], ats::sqrt(a[i]), eps*ats::abs(r[i]) );
+      c = r*r;
+      for (int i=0;i<vector_length;++i)
+        EXPECT_NEAR_KK( c[i], a[i], eps*ats::abs(a[i]) );
+      c = a/r;
+      for (int i=0;i<vector_length;++i)
+        EXPECT_NEAR_KK( c[i], r[i], eps*ats::abs(r[i]) );
+    }
+  }
 } // namespace
 
 template<typename DeviceType,typename VectorTagType,int VectorLength>
@@ -106,6 +199,24 @@ int test_batched_vector_math() {
   return 0;
 }
 
+template<typename DeviceType,typename VectorTagType,int VectorLength>
+int test_batched_vector_math_range() {
+  static_assert(Kokkos::Impl::SpaceAccessibility<DeviceType,Kokkos::HostSpace >::accessible,
+                "vector datatype is only tested on host space");
+  Test::impl_test_batched_vector_math_range<VectorTagType,VectorLength>();
+
+  return 0;
+}
+
+template<typename DeviceType,typename VectorTagType,int VectorLength>
+int test_batched_vector_math_complex() {
+  static_assert(Kokkos::Impl::SpaceAccessibility<DeviceType,Kokkos::HostSpace >::accessible,
+                "vector datatype is only tested on host space");
+  Test::impl_test_batched_vector_math_complex<VectorTagType,VectorLength>();
+
+  return 0;
+}
+
 // template<typename ValueType>
 // int test_complex_pow() {
 //   typedef Kokkos::Details::ArithTraits<Kokkos::complex<ValueType> > ats;
@@ -143,8 +254,30 @@ TEST_F( TestCategory, batched_vector_math_simd_double3 ) {
 TEST_F( TestCategory, batched_vector_math_simd_double4 ) {
   test_batched_vector_math<TestExecSpace,SIMD<double>,4>();
 }
+TEST_F( TestCategory, batched_vector_math_simd_double8 ) {
+  test_batched_vector_math<TestExecSpace,SIMD<double>,8>();
+}
+TEST_F( TestCategory, batched_vector_math_range_simd_double4 ) {
+  test_batched_vector_math_range<TestExecSpace,SIMD<double>,4>();
+}
+TEST_F( TestCategory, batched_vector_math_range_simd_double8 ) {
+  test_batched_vector_math_range<TestExecSpace,SIMD<double>,8>();
+}
 #endif
 
+/// avx 512 specializations on __m512
+#if defined(__AVX512F__)
+#if defined(KOKKOSKERNELS_INST_FLOAT)
+TEST_F( TestCategory, batched_vector_math_avx512_float16 ) {
+  test_batched_vector_math<TestExecSpace,SIMD<float>,16>();
+}
+#endif
+#if defined(KOKKOSKERNELS_INST_COMPLEX_FLOAT)
+TEST_F( TestCategory, batched_vector_math_avx512_scomplex8 ) {
+  test_batched_vector_math_complex<TestExecSpace,SIMD<Kokkos::complex<float> >,8>();
+}
+#endif
+#endif
 
 // using namespace Test;
 
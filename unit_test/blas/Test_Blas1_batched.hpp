@@ -0,0 +1,116 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+#include<Kokkos_Random.hpp>
+#include<KokkosBlas1_batched.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+namespace Test {
+  // Checks batched_dot, batched_nrm2 and batched_axpby on nvec vectors
+  // of length len against the results computed column by column on the
+  // host.  Lengths below and above BatchedTeamPerVectorLength exercise
+  // both the thread-per-vector and the team-per-vector mapping.
+  template<class ViewTypeMV, class Device>
+  void impl_test_batched_blas1(int len, int nvec) {
+
+    typedef typename ViewTypeMV::value_type Scalar;
+    typedef Kokkos::Details::ArithTraits<Scalar> AT;
+    typedef typename AT::mag_type mag_type;
+    typedef Kokkos::Details::ArithTraits<mag_type> MAT;
+    typedef Kokkos::View<Scalar*, Device> ViewType;
+    typedef Kokkos::View<mag_type*, Device> MagViewType;
+
+    ViewTypeMV x("X",len,nvec), y("Y",len,nvec), org_y("Org_Y",len,nvec);
+    ViewType r("R",nvec), a("A",nvec);
+    MagViewType n("N",nvec);
+
+    Kokkos::Random_XorShift64_Pool<typename Device::execution_space> rand_pool(13718);
+    Kokkos::fill_random(x,rand_pool,Scalar(10));
+    Kokkos::fill_random(y,rand_pool,Scalar(10));
+    Kokkos::fill_random(a,rand_pool,Scalar(10));
+    Kokkos::deep_copy(org_y,y);
+
+    typename ViewTypeMV::HostMirror h_x = Kokkos::create_mirror_view(x);
+    typename ViewTypeMV::HostMirror h_y = Kokkos::create_mirror_view(y);
+    typename ViewType::HostMirror h_r = Kokkos::create_mirror_view(r);
+    typename ViewType::HostMirror h_a = Kokkos::create_mirror_view(a);
+    typename MagViewType::HostMirror h_n = Kokkos::create_mirror_view(n);
+    Kokkos::deep_copy(h_x,x);
+    Kokkos::deep_copy(h_y,y);
+    Kokkos::deep_copy(h_a,a);
+
+    const mag_type eps = sizeof(mag_type) <= 4 ? 1e-4 : 1e-7;
+
+    typename ViewTypeMV::const_type c_x = x;
+
+    KokkosBlas::Experimental::batched_dot(r,c_x,y);
+    Kokkos::deep_copy(h_r,r);
+    for(int k=0; k<nvec; k++) {
+      Scalar expected = AT::zero();
+      for(int i=0; i<len; i++)
+        expected += AT::conj(h_x(i,k))*h_y(i,k);
+      EXPECT_NEAR_KK( h_r(k), expected, eps*AT::abs(expected) + eps );
+    }
+
+    KokkosBlas::Experimental::batched_nrm2(n,c_x);
+    Kokkos::deep_copy(h_n,n);
+    for(int k=0; k<nvec; k++) {
+      mag_type expected = MAT::zero();
+      for(int i=0; i<len; i++)
+        expected += AT::abs(h_x(i,k))*AT::abs(h_x(i,k));
+      expected = MAT::sqrt(expected);
+      EXPECT_NEAR_KK( h_n(k), expected, eps*expected + eps );
+    }
+
+    const Scalar b = 3;
+    KokkosBlas::Experimental::batched_axpby(a,c_x,b,y);
+    typename ViewTypeMV::HostMirror h_org_y = Kokkos::create_mirror_view(org_y);
+    Kokkos::deep_copy(h_org_y,org_y);
+    Kokkos::deep_copy(h_y,y);
+    for(int k=0; k<nvec; k++)
+      for(int i=0; i<len; i++) {
+        const Scalar expected = h_a(k)*h_x(i,k) + b*h_org_y(i,k);
+        EXPECT_NEAR_KK( h_y(i,k), expected, eps*AT::abs(expected) + eps );
+      }
+  }
+}
+
+template<class ScalarA, class Device>
+int test_batched_blas1() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<ScalarA**, Kokkos::LayoutLeft, Device> view_type_ll;
+  Test::impl_test_batched_blas1<view_type_ll, Device>(0,0);
+  Test::impl_test_batched_blas1<view_type_ll, Device>(0,5);
+  Test::impl_test_batched_blas1<view_type_ll, Device>(5,1000);
+  Test::impl_test_batched_blas1<view_type_ll, Device>(50,1037);
+  Test::impl_test_batched_blas1<view_type_ll, Device>(300,17);
+#endif
+
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<ScalarA**, Kokkos::LayoutRight, Device> view_type_lr;
+  Test::impl_test_batched_blas1<view_type_lr, Device>(0,0);
+  Test::impl_test_batched_blas1<view_type_lr, Device>(0,5);
+  Test::impl_test_batched_blas1<view_type_lr, Device>(5,1000);
+  Test::impl_test_batched_blas1<view_type_lr, Device>(50,1037);
+  Test::impl_test_batched_blas1<view_type_lr, Device>(300,17);
+#endif
+
+  return 1;
+}
+
+#if defined(KOKKOSKERNELS_INST_FLOAT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, batched_blas1_float ) {
+    test_batched_blas1<float,TestExecSpace> ();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, batched_blas1_double ) {
+    test_batched_blas1<double,TestExecSpace> ();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_COMPLEX_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, batched_blas1_complex_double ) {
+    test_batched_blas1<Kokkos::complex<double>,TestExecSpace> ();
+}
+#endif
@@ -0,0 +1,77 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+#include<Kokkos_Random.hpp>
+#include<KokkosBlas1_block_dot.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+namespace Test {
+  template<class ViewTypeX, class ViewTypeR, class Device>
+  void impl_test_block_dot(int N, int M, int K) {
+
+    typedef typename ViewTypeX::value_type Scalar;
+    typedef Kokkos::Details::ArithTraits<Scalar> AT;
+
+    ViewTypeX X("X",N,M);
+    ViewTypeX Y("Y",N,K);
+    ViewTypeR R("R",M,K);
+
+    Kokkos::Random_XorShift64_Pool<typename Device::execution_space> rand_pool(13718);
+    Kokkos::fill_random(X,rand_pool,Scalar(1));
+    Kokkos::fill_random(Y,rand_pool,Scalar(1));
+    Kokkos::deep_copy(R,Scalar(-1));
+    Kokkos::fence();
+
+    KokkosBlas::Experimental::block_dot(R,X,Y);
+
+    typename ViewTypeX::HostMirror h_X = Kokkos::create_mirror_view(X);
+    typename ViewTypeX::HostMirror h_Y = Kokkos::create_mirror_view(Y);
+    typename ViewTypeR::HostMirror h_R = Kokkos::create_mirror_view(R);
+    Kokkos::deep_copy(h_X,X);
+    Kokkos::deep_copy(h_Y,Y);
+    Kokkos::deep_copy(h_R,R);
+
+    const double eps = 1e-13*(N > 0 ? N : 1);
+    for(int i=0;i<M;i++)
+      for(int j=0;j<K;j++) {
+        Scalar expected = AT::zero();
+        for(int l=0;l<N;l++)
+          expected += AT::conj(h_X(l,i))*h_Y(l,j);
+        EXPECT_NEAR_KK( AT::abs(h_R(i,j)-expected), 0, eps);
+      }
+  }
+}
+
+template<class Scalar, class Device>
+int test_block_dot() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar**, Kokkos::LayoutLeft, Device> view_type_ll;
+  Test::impl_test_block_dot<view_type_ll, view_type_ll, Device>(0,4,5);
+  Test::impl_test_block_dot<view_type_ll, view_type_ll, Device>(13,1,1);
+  Test::impl_test_block_dot<view_type_ll, view_type_ll, Device>(1024,10,11);
+  Test::impl_test_block_dot<view_type_ll, view_type_ll, Device>(132231,30,31);
+  Test::impl_test_block_dot<view_type_ll, view_type_ll, Device>(513,80,70);
+#endif
+
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar**, Kokkos::LayoutRight, Device> view_type_lr;
+  Test::impl_test_block_dot<view_type_lr, view_type_lr, Device>(0,4,5);
+  Test::impl_test_block_dot<view_type_lr, view_type_lr, Device>(13,1,1);
+  Test::impl_test_block_dot<view_type_lr, view_type_lr, Device>(1024,10,11);
+  Test::impl_test_block_dot<view_type_lr, view_type_lr, Device>(132231,30,31);
+  Test::impl_test_block_dot<view_type_lr, view_type_lr, Device>(513,80,70);
+#endif
+
+  return 1;
+}
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, block_dot_double ) {
+    test_block_dot<double,TestExecSpace> ();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_COMPLEX_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, block_dot_complex_double ) {
+    test_block_dot<Kokkos::complex<double>,TestExecSpace> ();
+}
+#endif
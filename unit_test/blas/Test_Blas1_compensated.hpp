@@ -0,0 +1,87 @@
+#include<gtest/gtest.h>
+#include<cmath>
+#include<Kokkos_Core.hpp>
+#include<Kokkos_Random.hpp>
+#include<KokkosBlas1_compensated.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+namespace Test {
+  // Compares the compensated reductions with references accumulated in
+  // long double on the host.  The results must be as accurate as if
+  // computed in twice the working precision, i.e., within a rounding
+  // of the exact value plus a term of order eps^2 * sum |x_i*y_i|.
+  template<class ViewType, class Device>
+  void impl_test_compensated(int N) {
+
+    typedef typename ViewType::value_type Scalar;
+    typedef Kokkos::Details::ArithTraits<Scalar> AT;
+
+    const long double eps = AT::epsilon();
+
+    ViewType x("X",N), y("Y",N);
+
+    Kokkos::Random_XorShift64_Pool<typename Device::execution_space> rand_pool(13718);
+    Kokkos::fill_random(x,rand_pool,Scalar(10));
+    Kokkos::fill_random(y,rand_pool,Scalar(10));
+    Kokkos::fence();
+
+    typename ViewType::HostMirror h_x = Kokkos::create_mirror_view(x);
+    typename ViewType::HostMirror h_y = Kokkos::create_mirror_view(y);
+    Kokkos::deep_copy(h_x,x);
+    Kokkos::deep_copy(h_y,y);
+
+    long double dot = 0, abs_dot = 0, sum = 0, abs_sum = 0, sq = 0;
+    for(int i=0; i<N; i++) {
+      const long double xi = h_x(i), yi = h_y(i);
+      dot += xi*yi;
+      abs_dot += std::fabs(xi*yi);
+      sum += xi;
+      abs_sum += std::fabs(xi);
+      sq += xi*xi;
+    }
+
+    typename ViewType::const_type c_x = x;
+
+    const long double result_dot = KokkosBlas::Experimental::compensated_dot(c_x,y);
+    EXPECT_LE( std::fabs(result_dot - dot), eps*std::fabs(dot) + 4*N*N*eps*eps*abs_dot );
+
+    const long double result_sum = KokkosBlas::Experimental::compensated_sum(c_x);
+    EXPECT_LE( std::fabs(result_sum - sum), eps*std::fabs(sum) + 4*N*N*eps*eps*abs_sum );
+
+    const long double result_nrm2 = KokkosBlas::Experimental::compensated_nrm2(c_x);
+    EXPECT_LE( std::fabs(result_nrm2 - std::sqrt(sq)), 2*eps*std::sqrt(sq) );
+  }
+}
+
+template<class Scalar, class Device>
+int test_compensated() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar*, Kokkos::LayoutLeft, Device> view_type_ll;
+  Test::impl_test_compensated<view_type_ll, Device>(0);
+  Test::impl_test_compensated<view_type_ll, Device>(13);
+  Test::impl_test_compensated<view_type_ll, Device>(1024);
+  Test::impl_test_compensated<view_type_ll, Device>(132231);
+#endif
+
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar*, Kokkos::LayoutRight, Device> view_type_lr;
+  Test::impl_test_compensated<view_type_lr, Device>(0);
+  Test::impl_test_compensated<view_type_lr, Device>(13);
+  Test::impl_test_compensated<view_type_lr, Device>(1024);
+  Test::impl_test_compensated<view_type_lr, Device>(132231);
+#endif
+
+  return 1;
+}
+
+#if defined(KOKKOSKERNELS_INST_FLOAT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, compensated_float ) {
+    test_compensated<float,TestExecSpace> ();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, compensated_double ) {
+    test_compensated<double,TestExecSpace> ();
+}
+#endif
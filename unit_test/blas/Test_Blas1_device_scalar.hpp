@@ -0,0 +1,109 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+#include<Kokkos_Random.hpp>
+#include<KokkosBlas1_dot.hpp>
+#include<KokkosBlas1_nrm2.hpp>
+#include<KokkosBlas1_axpby.hpp>
+#include<KokkosBlas1_scal.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+namespace Test {
+  // One orthogonalization step of GMRES with all coefficients kept on
+  // the device: h = dot(v,w), w = -h*v + 1*w, n = nrm2(w), w = w/n,
+  // compared with the same sequence on the host.
+  template<class ViewTypeA, class Device>
+  void impl_test_device_scalar(int N) {
+
+    typedef typename ViewTypeA::value_type Scalar;
+    typedef Kokkos::Details::ArithTraits<Scalar> AT;
+    typedef typename AT::mag_type mag_type;
+    typedef Kokkos::View<Scalar,Device> scalar_view_type;
+    typedef Kokkos::View<mag_type,Device> mag_view_type;
+
+    ViewTypeA v("V",N), w("W",N);
+
+    Kokkos::Random_XorShift64_Pool<typename Device::execution_space> rand_pool(13718);
+    Kokkos::fill_random(v,rand_pool,Scalar(10));
+    Kokkos::fill_random(w,rand_pool,Scalar(10));
+
+    typename ViewTypeA::HostMirror h_v = Kokkos::create_mirror_view(v);
+    typename ViewTypeA::HostMirror h_w = Kokkos::create_mirror_view(w);
+    Kokkos::deep_copy(h_v,v);
+    Kokkos::deep_copy(h_w,w);
+
+    Scalar h = AT::zero();
+    for(int i=0;i<N;i++)
+      h += AT::conj(h_v(i))*h_w(i);
+    std::vector<Scalar> expected(N);
+    mag_type n = 0;
+    for(int i=0;i<N;i++) {
+      expected[i] = h_w(i) - h*h_v(i);
+      n += AT::abs(expected[i])*AT::abs(expected[i]);
+    }
+    n = Kokkos::Details::ArithTraits<mag_type>::sqrt(n);
+    for(int i=0;i<N;i++)
+      expected[i] = expected[i]/n;
+
+    scalar_view_type d_h("h"), d_minus_h("-h"), d_one("1"), d_inv_n("1/n");
+    mag_view_type d_n("n");
+    Kokkos::deep_copy(d_one,AT::one());
+
+    KokkosBlas::dot(d_h,v,w);
+    Kokkos::parallel_for("KokkosBlas::Test::device_scalar::negate",
+                         Kokkos::RangePolicy<typename Device::execution_space>(0,1),
+                         KOKKOS_LAMBDA(const int) { d_minus_h() = -d_h(); });
+    KokkosBlas::axpby(d_minus_h,v,d_one,w);
+    KokkosBlas::nrm2(d_n,w);
+    Kokkos::parallel_for("KokkosBlas::Test::device_scalar::invert",
+                         Kokkos::RangePolicy<typename Device::execution_space>(0,1),
+                         KOKKOS_LAMBDA(const int) { d_inv_n() = AT::one()/d_n(); });
+    KokkosBlas::scal(w,d_inv_n,w);
+
+    const double eps = std::is_same<mag_type,float>::value?2*1e-4:1e-7;
+
+    typename scalar_view_type::HostMirror h_h = Kokkos::create_mirror_view(d_h);
+    Kokkos::deep_copy(h_h,d_h);
+    EXPECT_NEAR_KK( AT::abs(h_h()), AT::abs(h), eps*AT::abs(h) );
+
+    Kokkos::deep_copy(h_w,w);
+    for(int i=0;i<N;i++)
+      EXPECT_NEAR_KK( AT::abs(h_w(i)), AT::abs(expected[i]), eps );
+  }
+}
+
+template<class Scalar, class Device>
+int test_device_scalar() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar*, Kokkos::LayoutLeft, Device> view_type_a_ll;
+  Test::impl_test_device_scalar<view_type_a_ll, Device>(0);
+  Test::impl_test_device_scalar<view_type_a_ll, Device>(13);
+  Test::impl_test_device_scalar<view_type_a_ll, Device>(1024);
+  Test::impl_test_device_scalar<view_type_a_ll, Device>(132231);
+#endif
+
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar*, Kokkos::LayoutRight, Device> view_type_a_lr;
+  Test::impl_test_device_scalar<view_type_a_lr, Device>(13);
+  Test::impl_test_device_scalar<view_type_a_lr, Device>(1024);
+#endif
+
+  return 1;
+}
+
+#if defined(KOKKOSKERNELS_INST_FLOAT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, device_scalar_float ) {
+    test_device_scalar<float,TestExecSpace> ();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, device_scalar_double ) {
+    test_device_scalar<double,TestExecSpace> ();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, device_scalar_complex_double ) {
+    test_device_scalar<Kokkos::complex<double>,TestExecSpace> ();
+}
+#endif
@@ -0,0 +1,132 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+#include<Kokkos_Random.hpp>
+#include<KokkosBlas1_fused.hpp>
+#include<KokkosBlas1_axpby.hpp>
+#include<KokkosBlas1_update.hpp>
+#include<KokkosBlas1_dot.hpp>
+#include<KokkosBlas1_nrm2.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+namespace Test {
+  // Compares each fused operation with the sequence of separate
+  // KokkosBlas calls it replaces.
+  template<class ViewType, class Device>
+  void impl_test_fused(int N) {
+
+    typedef typename ViewType::value_type Scalar;
+    typedef Kokkos::Details::ArithTraits<Scalar> AT;
+    typedef typename AT::mag_type mag_type;
+
+    const Scalar a = 3, b = 5, c = -2, d = 0.5;
+    const double eps = 1e-12;
+
+    ViewType x("X",N), y("Y",N), u("U",N), v("V",N), w("W",N);
+    ViewType y_ref("Y_ref",N), v_ref("V_ref",N);
+
+    Kokkos::Random_XorShift64_Pool<typename Device::execution_space> rand_pool(13718);
+    Kokkos::fill_random(x,rand_pool,Scalar(10));
+    Kokkos::fill_random(y,rand_pool,Scalar(10));
+    Kokkos::fill_random(u,rand_pool,Scalar(10));
+    Kokkos::fill_random(v,rand_pool,Scalar(10));
+    Kokkos::fill_random(w,rand_pool,Scalar(10));
+    Kokkos::fence();
+
+    ViewType y_org("Y_org",N), v_org("V_org",N);
+    Kokkos::deep_copy(y_org,y);
+    Kokkos::deep_copy(v_org,v);
+
+    typename ViewType::const_type c_x = x;
+
+    // axpby_dot with a separate w and with w == y
+    {
+      Kokkos::deep_copy(y_ref,y_org);
+      KokkosBlas::axpby(a,x,b,y_ref);
+      const Scalar expected = KokkosBlas::dot(w,y_ref);
+      const Scalar expected_yy = KokkosBlas::dot(y_ref,y_ref);
+
+      Kokkos::deep_copy(y,y_org);
+      const Scalar result = KokkosBlas::Experimental::axpby_dot(a,c_x,b,y,w);
+      EXPECT_NEAR_KK( result, expected, eps*AT::abs(expected));
+      EXPECT_NEAR_KK( KokkosBlas::nrm2(y), KokkosBlas::nrm2(y_ref), eps*KokkosBlas::nrm2(y_ref));
+
+      Kokkos::deep_copy(y,y_org);
+      const Scalar result_yy = KokkosBlas::Experimental::axpby_dot(a,x,b,y,y);
+      EXPECT_NEAR_KK( result_yy, expected_yy, eps*AT::abs(expected_yy));
+
+      // b = 0 overwrites y
+      KokkosBlas::axpby(a,x,AT::zero(),y_ref);
+      const Scalar expected_b0 = KokkosBlas::dot(w,y_ref);
+      const Scalar result_b0 = KokkosBlas::Experimental::axpby_dot(a,x,AT::zero(),y,w);
+      EXPECT_NEAR_KK( result_b0, expected_b0, eps*AT::abs(expected_b0));
+    }
+
+    // axpby2_dot as in CG: y := a*x + y; v := c*u + v; dot(v, v)
+    {
+      Kokkos::deep_copy(y_ref,y_org);
+      Kokkos::deep_copy(v_ref,v_org);
+      KokkosBlas::axpby(a,x,AT::one(),y_ref);
+      KokkosBlas::axpby(c,u,AT::one(),v_ref);
+      const Scalar expected = KokkosBlas::dot(v_ref,v_ref);
+
+      Kokkos::deep_copy(y,y_org);
+      Kokkos::deep_copy(v,v_org);
+      const Scalar result = KokkosBlas::Experimental::axpby2_dot(a,x,AT::one(),y,c,u,AT::one(),v,v);
+      EXPECT_NEAR_KK( result, expected, eps*AT::abs(expected));
+      EXPECT_NEAR_KK( KokkosBlas::nrm2(y), KokkosBlas::nrm2(y_ref), eps*KokkosBlas::nrm2(y_ref));
+    }
+
+    // update_nrm2: v := d*v + a*x + b*y
+    {
+      Kokkos::deep_copy(v_ref,v_org);
+      KokkosBlas::update(a,x,b,y_org,d,v_ref);
+      const mag_type expected = KokkosBlas::nrm2(v_ref);
+
+      Kokkos::deep_copy(v,v_org);
+      const mag_type result = KokkosBlas::Experimental::update_nrm2(a,x,b,y_org,d,v);
+      EXPECT_NEAR_KK( result, expected, eps*expected);
+    }
+
+    // dot2
+    {
+      const Scalar expected0 = KokkosBlas::dot(x,y_org);
+      const Scalar expected1 = KokkosBlas::dot(u,w);
+      const auto result = KokkosBlas::Experimental::dot2(x,y_org,u,w);
+      EXPECT_NEAR_KK( result.first, expected0, eps*AT::abs(expected0));
+      EXPECT_NEAR_KK( result.second, expected1, eps*AT::abs(expected1));
+    }
+  }
+}
+
+template<class Scalar, class Device>
+int test_fused() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar*, Kokkos::LayoutLeft, Device> view_type_ll;
+  Test::impl_test_fused<view_type_ll, Device>(0);
+  Test::impl_test_fused<view_type_ll, Device>(13);
+  Test::impl_test_fused<view_type_ll, Device>(1024);
+  Test::impl_test_fused<view_type_ll, Device>(132231);
+#endif
+
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar*, Kokkos::LayoutRight, Device> view_type_lr;
+  Test::impl_test_fused<view_type_lr, Device>(0);
+  Test::impl_test_fused<view_type_lr, Device>(13);
+  Test::impl_test_fused<view_type_lr, Device>(1024);
+  Test::impl_test_fused<view_type_lr, Device>(132231);
+#endif
+
+  return 1;
+}
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, fused_double ) {
+    test_fused<double,TestExecSpace> ();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_COMPLEX_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, fused_complex_double ) {
+    test_fused<Kokkos::complex<double>,TestExecSpace> ();
+}
+#endif
@@ -0,0 +1,63 @@
+// Requests the header-only path for dot alone; this must come before any
+// KokkosKernels header that includes KokkosKernels_Macros.hpp.
+#define KOKKOSKERNELS_INLINE_DOT
+
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+#include<KokkosBlas1_dot.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+namespace Test {
+
+  static_assert (KOKKOSKERNELS_BLAS1_INLINE(DOT),
+                 "KOKKOSKERNELS_INLINE_DOT does not select the header-only dot");
+  static_assert (!KOKKOSKERNELS_BLAS1_INLINE(AXPBY) && !KOKKOSKERNELS_BLAS1_INLINE(SCAL),
+                 "KOKKOSKERNELS_INLINE_DOT leaks into other kernels");
+
+  template<class Scalar, class Device>
+  void impl_test_dot_inline(int N) {
+    typedef Kokkos::View<Scalar*, Kokkos::LayoutLeft, Device> ViewType;
+    typedef Kokkos::View<Scalar, Kokkos::LayoutLeft, Kokkos::HostSpace,
+                         Kokkos::MemoryTraits<Kokkos::Unmanaged> > ResultType;
+    typedef Kokkos::View<const Scalar*, Kokkos::LayoutLeft, Device,
+                         Kokkos::MemoryTraits<Kokkos::Unmanaged> > InputType;
+    typedef KokkosBlas::Impl::Dot<ResultType, InputType, InputType> dot_type;
+    typedef KokkosBlas::Impl::Dot<ResultType, InputType, InputType, 1, 1,
+      KokkosBlas::Impl::dot_tpl_spec_avail<ResultType, InputType, InputType>::value,
+      false> header_only_dot_type;
+    static_assert (std::is_same<dot_type, header_only_dot_type>::value,
+                   "KokkosBlas::dot does not take the header-only specialization");
+
+    ViewType a("A", N);
+    ViewType b("B", N);
+    typename ViewType::HostMirror h_a = Kokkos::create_mirror_view(a);
+    typename ViewType::HostMirror h_b = Kokkos::create_mirror_view(b);
+
+    Scalar expected_result = 0;
+    for(int i = 0; i < N; i++) {
+      h_a(i) = Scalar(i % 7);
+      h_b(i) = Scalar(3 - i % 5);
+      expected_result += h_a(i)*h_b(i);
+    }
+    Kokkos::deep_copy(a, h_a);
+    Kokkos::deep_copy(b, h_b);
+
+    // Scalar is not among the ETI types, so under KOKKOSKERNELS_ETI_ONLY this
+    // only compiles and links through the header-only path.
+    Scalar result = KokkosBlas::dot(a, b);
+    EXPECT_EQ(result, expected_result);
+  }
+}
+
+template<class Device>
+int test_dot_inline() {
+  Test::impl_test_dot_inline<long, Device>(0);
+  Test::impl_test_dot_inline<long, Device>(13);
+  Test::impl_test_dot_inline<long, Device>(1024);
+  Test::impl_test_dot_inline<long, Device>(132231);
+  return 1;
+}
+
+TEST_F( TestCategory, dot_inline_long ) {
+  test_dot_inline<TestExecSpace> ();
+}
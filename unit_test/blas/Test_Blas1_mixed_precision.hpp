@@ -0,0 +1,98 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+#include<Kokkos_Random.hpp>
+#include<KokkosBlas1_axpby.hpp>
+#include<KokkosBlas1_update.hpp>
+#include<KokkosBlas1_dot.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+namespace Test {
+  // Checks axpby, update and dot on float and double single vectors
+  // against the same operations with every vector stored in double.
+  // The float vectors hold values that are exact in float, so that the
+  // only difference is the rounding of the double coefficients, which
+  // must not be lost.
+  template<class Layout, class Device>
+  void impl_test_mixed_precision(int N) {
+
+    typedef Kokkos::View<float*, Layout, Device> float_view_type;
+    typedef Kokkos::View<double*, Layout, Device> double_view_type;
+
+    const double alpha = 1.0/3.0, beta = -2.0/7.0, gamma = 0.1;
+    const double eps = 1e-13;
+
+    float_view_type xf("XF",N);
+    double_view_type x("X",N), y("Y",N), z("Z",N);
+    double_view_type y_ref("Y_ref",N), z_ref("Z_ref",N);
+
+    Kokkos::Random_XorShift64_Pool<typename Device::execution_space> rand_pool(13718);
+    Kokkos::fill_random(xf,rand_pool,10.0f);
+    Kokkos::fill_random(y,rand_pool,10.0);
+    Kokkos::fill_random(z,rand_pool,10.0);
+    Kokkos::fence();
+
+    typename float_view_type::HostMirror h_xf = Kokkos::create_mirror_view(xf);
+    typename double_view_type::HostMirror h_x = Kokkos::create_mirror_view(x);
+    Kokkos::deep_copy(h_xf,xf);
+    for(int i=0; i<N; i++)
+      h_x(i) = h_xf(i);
+    Kokkos::deep_copy(x,h_x);
+
+    typename float_view_type::const_type c_xf = xf;
+
+    // dot(float, double) and dot(double, float) return double
+    {
+      const double expected = KokkosBlas::dot(x,y);
+      const double result_xy = KokkosBlas::dot(c_xf,y);
+      const double result_yx = KokkosBlas::dot(y,xf);
+      EXPECT_NEAR_KK( result_xy, expected, eps*N*std::abs(expected) + eps);
+      EXPECT_NEAR_KK( result_yx, expected, eps*N*std::abs(expected) + eps);
+    }
+
+    // y(double) := alpha*x(float) + beta*y(double)
+    {
+      Kokkos::deep_copy(y_ref,y);
+      KokkosBlas::axpby(alpha,x,beta,y_ref);
+      KokkosBlas::axpby(alpha,c_xf,beta,y);
+      const double nrm = KokkosBlas::dot(y_ref,y_ref);
+      KokkosBlas::axpby(1.0,y_ref,-1.0,y);
+      EXPECT_NEAR_KK( KokkosBlas::dot(y,y), 0.0, eps*eps*nrm);
+      Kokkos::deep_copy(y,y_ref);
+    }
+
+    // z(double) := alpha*x(float) + beta*y(double) + gamma*z(double)
+    {
+      Kokkos::deep_copy(z_ref,z);
+      KokkosBlas::update(alpha,x,beta,y,gamma,z_ref);
+      KokkosBlas::update(alpha,c_xf,beta,y,gamma,z);
+      const double nrm = KokkosBlas::dot(z_ref,z_ref);
+      KokkosBlas::axpby(1.0,z_ref,-1.0,z);
+      EXPECT_NEAR_KK( KokkosBlas::dot(z,z), 0.0, eps*eps*nrm);
+    }
+  }
+}
+
+template<class Device>
+int test_mixed_precision() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  Test::impl_test_mixed_precision<Kokkos::LayoutLeft, Device>(0);
+  Test::impl_test_mixed_precision<Kokkos::LayoutLeft, Device>(13);
+  Test::impl_test_mixed_precision<Kokkos::LayoutLeft, Device>(1024);
+  Test::impl_test_mixed_precision<Kokkos::LayoutLeft, Device>(132231);
+#endif
+
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  Test::impl_test_mixed_precision<Kokkos::LayoutRight, Device>(0);
+  Test::impl_test_mixed_precision<Kokkos::LayoutRight, Device>(13);
+  Test::impl_test_mixed_precision<Kokkos::LayoutRight, Device>(1024);
+  Test::impl_test_mixed_precision<Kokkos::LayoutRight, Device>(132231);
+#endif
+
+  return 1;
+}
+
+#if (defined(KOKKOSKERNELS_INST_FLOAT) && defined(KOKKOSKERNELS_INST_DOUBLE)) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, mixed_precision_float_double ) {
+    test_mixed_precision<TestExecSpace> ();
+}
+#endif
@@ -0,0 +1,103 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+#include<vector>
+#include<Kokkos_Random.hpp>
+#include<KokkosBlas1_reproducible.hpp>
+#include<KokkosBlas1_dot.hpp>
+#include<KokkosBlas1_nrm2.hpp>
+#include<KokkosBlas1_sum.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+namespace Test {
+  // Sum of the entries of h_x in the order used by
+  // KokkosBlas::Experimental::Impl::reproducible_reduce.
+  template<class Scalar, class HostViewType>
+  Scalar fixed_order_sum(const HostViewType& h_x) {
+    const size_t bs = KokkosBlas::Experimental::Impl::ReproducibleBlockSize;
+    std::vector<Scalar> level(h_x.extent(0));
+    for(size_t i=0; i<level.size(); i++)
+      level[i] = h_x(i);
+    if(level.size() == 0) return Kokkos::Details::ArithTraits<Scalar>::zero();
+    do {
+      std::vector<Scalar> next((level.size()+bs-1)/bs, Kokkos::Details::ArithTraits<Scalar>::zero());
+      for(size_t i=0; i<level.size(); i++)
+        next[i/bs] += level[i];
+      level.swap(next);
+    } while(level.size() > 1);
+    return level[0];
+  }
+
+  template<class ViewType, class Device>
+  void impl_test_reproducible(int N) {
+
+    typedef typename ViewType::value_type Scalar;
+    typedef Kokkos::Details::ArithTraits<Scalar> AT;
+    typedef typename AT::mag_type mag_type;
+
+    const double eps = 1e-12;
+
+    ViewType x("X",N), y("Y",N);
+
+    Kokkos::Random_XorShift64_Pool<typename Device::execution_space> rand_pool(13718);
+    Kokkos::fill_random(x,rand_pool,Scalar(10));
+    Kokkos::fill_random(y,rand_pool,Scalar(10));
+    Kokkos::fence();
+
+    typename ViewType::const_type c_x = x;
+
+    const Scalar expected_dot = KokkosBlas::dot(x,y);
+    const Scalar result_dot = KokkosBlas::Experimental::reproducible_dot(c_x,y);
+    EXPECT_NEAR_KK( result_dot, expected_dot, eps*N*AT::abs(expected_dot));
+
+    const mag_type expected_nrm2 = KokkosBlas::nrm2(x);
+    const mag_type result_nrm2 = KokkosBlas::Experimental::reproducible_nrm2(c_x);
+    EXPECT_NEAR_KK( result_nrm2, expected_nrm2, eps*expected_nrm2);
+
+    // The summation order does not depend on the execution space, so the
+    // sum matches the host reference bit for bit.
+    typename ViewType::HostMirror h_x = Kokkos::create_mirror_view(x);
+    Kokkos::deep_copy(h_x,x);
+    const Scalar expected_sum = fixed_order_sum<Scalar>(h_x);
+    const Scalar result_sum = KokkosBlas::Experimental::reproducible_sum(c_x);
+    EXPECT_TRUE( result_sum == expected_sum );
+    const Scalar default_sum = KokkosBlas::sum(x);
+    EXPECT_NEAR_KK( result_sum, default_sum, eps*N*AT::abs(default_sum));
+
+    // Repeated calls return the same bits.
+    EXPECT_TRUE( KokkosBlas::Experimental::reproducible_dot(x,y) == result_dot );
+    EXPECT_TRUE( KokkosBlas::Experimental::reproducible_nrm2(x) == result_nrm2 );
+  }
+}
+
+template<class Scalar, class Device>
+int test_reproducible() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar*, Kokkos::LayoutLeft, Device> view_type_ll;
+  Test::impl_test_reproducible<view_type_ll, Device>(0);
+  Test::impl_test_reproducible<view_type_ll, Device>(13);
+  Test::impl_test_reproducible<view_type_ll, Device>(1024);
+  Test::impl_test_reproducible<view_type_ll, Device>(132231);
+#endif
+
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar*, Kokkos::LayoutRight, Device> view_type_lr;
+  Test::impl_test_reproducible<view_type_lr, Device>(0);
+  Test::impl_test_reproducible<view_type_lr, Device>(13);
+  Test::impl_test_reproducible<view_type_lr, Device>(1024);
+  Test::impl_test_reproducible<view_type_lr, Device>(132231);
+#endif
+
+  return 1;
+}
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, reproducible_double ) {
+    test_reproducible<double,TestExecSpace> ();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_COMPLEX_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, reproducible_complex_double ) {
+    test_reproducible<Kokkos::complex<double>,TestExecSpace> ();
+}
+#endif
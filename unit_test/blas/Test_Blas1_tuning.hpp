@@ -0,0 +1,115 @@
+#include<gtest/gtest.h>
+#include<cstdio>
+#include<Kokkos_Core.hpp>
+#include<Kokkos_Random.hpp>
+#include<KokkosBlas1_tuning.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+namespace Test {
+  // Forces each variant of the multivector axpby and dot through the
+  // tuning table and compares with a host reference, then checks that
+  // calibration records an entry and that the table survives a save
+  // and load.
+  template<class ViewTypeMV, class Device>
+  void impl_test_tuning(int N, int K, int kernel_axpby, int kernel_dot) {
+
+    typedef typename ViewTypeMV::value_type Scalar;
+    typedef typename Device::execution_space execution_space;
+    typedef Kokkos::Details::ArithTraits<Scalar> AT;
+    typedef KokkosBlas::Impl::Blas1TuningTable table_type;
+
+    ViewTypeMV x("X",N,K), y("Y",N,K), org_y("Org_Y",N,K);
+    Kokkos::View<Scalar*,Device> r("R",K);
+
+    Kokkos::Random_XorShift64_Pool<execution_space> rand_pool(13718);
+    Kokkos::fill_random(x,rand_pool,Scalar(10));
+    Kokkos::fill_random(y,rand_pool,Scalar(10));
+    Kokkos::deep_copy(org_y,y);
+
+    typename ViewTypeMV::HostMirror h_x = Kokkos::create_mirror_view(x);
+    typename ViewTypeMV::HostMirror h_y = Kokkos::create_mirror_view(y);
+    typename Kokkos::View<Scalar*,Device>::HostMirror h_r = Kokkos::create_mirror_view(r);
+    Kokkos::deep_copy(h_x,x);
+    Kokkos::deep_copy(h_y,y);
+
+    const Scalar a = 3, b = 5;
+    std::vector<Scalar> expected(K);
+    for(int j=0;j<K;j++) {
+      expected[j] = AT::zero();
+      for(int i=0;i<N;i++) {
+        const Scalar z = a*h_x(i,j) + b*h_y(i,j);
+        expected[j] += AT::conj(z)*z;
+      }
+    }
+
+    const double eps = std::is_same<Scalar,float>::value?2*1e-5:1e-7;
+
+    table_type& table = KokkosBlas::Impl::blas1_tuning_table();
+    const int variants[3] = { KokkosBlas::Impl::Blas1Variant_Default,
+                              KokkosBlas::Impl::Blas1Variant_Unrolled,
+                              KokkosBlas::Impl::Blas1Variant_Generic };
+    for(int v=0;v<3;v++) {
+      table.set(kernel_axpby, execution_space::name(), N, K, variants[v]);
+      table.set(kernel_dot, execution_space::name(), N, K, variants[v]);
+      EXPECT_EQ( table.get(kernel_dot, execution_space::name(), N, K), variants[v] );
+
+      Kokkos::deep_copy(y,org_y);
+      KokkosBlas::axpby(a,x,b,y);
+      KokkosBlas::dot(r,y,y);
+      Kokkos::deep_copy(h_r,r);
+      for(int k=0;k<K;k++)
+        EXPECT_NEAR_KK( AT::abs(h_r(k)), AT::abs(expected[k]), AT::abs(eps*expected[k]) );
+    }
+
+    KokkosBlas::Experimental::clear_blas1_tuning();
+    EXPECT_TRUE( table.empty() );
+
+    KokkosBlas::Experimental::calibrate_blas1<execution_space,Scalar>
+      (std::vector<size_t>(1,N), std::vector<size_t>(1,K), 2);
+    const int calibrated = table.get(kernel_dot, execution_space::name(), N, K);
+    EXPECT_TRUE( calibrated == KokkosBlas::Impl::Blas1Variant_Unrolled ||
+                 calibrated == KokkosBlas::Impl::Blas1Variant_Generic );
+
+    const std::string filename("KokkosBlas1_tuning_test.txt");
+    KokkosBlas::Experimental::save_blas1_tuning(filename);
+    KokkosBlas::Experimental::clear_blas1_tuning();
+    KokkosBlas::Experimental::load_blas1_tuning(filename);
+    EXPECT_EQ( table.get(kernel_dot, execution_space::name(), N, K), calibrated );
+    std::remove(filename.c_str());
+
+    KokkosBlas::Experimental::clear_blas1_tuning();
+  }
+}
+
+template<class Scalar, class Device>
+int test_tuning() {
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar**, Kokkos::LayoutLeft, Device> view_type_ll;
+  Test::impl_test_tuning<view_type_ll, Device>(132231,5,
+    KokkosBlas::Impl::Blas1Tuned_Axpby_MV_Left, KokkosBlas::Impl::Blas1Tuned_Dot_MV_Left);
+  Test::impl_test_tuning<view_type_ll, Device>(1024,13,
+    KokkosBlas::Impl::Blas1Tuned_Axpby_MV_Left, KokkosBlas::Impl::Blas1Tuned_Dot_MV_Left);
+#endif
+
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<Scalar**, Kokkos::LayoutRight, Device> view_type_lr;
+  Test::impl_test_tuning<view_type_lr, Device>(132231,5,
+    KokkosBlas::Impl::Blas1Tuned_Axpby_MV_Left, KokkosBlas::Impl::Blas1Tuned_Dot_MV_Right);
+  Test::impl_test_tuning<view_type_lr, Device>(1024,13,
+    KokkosBlas::Impl::Blas1Tuned_Axpby_MV_Left, KokkosBlas::Impl::Blas1Tuned_Dot_MV_Right);
+#endif
+
+  return 1;
+}
+
+#if defined(KOKKOSKERNELS_INST_FLOAT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, tuning_float ) {
+    test_tuning<float,TestExecSpace> ();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, tuning_double ) {
+    test_tuning<double,TestExecSpace> ();
+}
+#endif
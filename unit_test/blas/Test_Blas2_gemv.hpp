@@ -28,10 +28,14 @@ namespace Test {
     ScalarX b = 5;
     double eps = std::is_same<ScalarY,float>::value?2*1e-5:1e-7;
 
+    // A is N x M; op(A) is M x N in the transpose modes
+    const bool trans = mode[0]!='N';
+    const int lenX = trans?N:M, lenY = trans?M:N;
+
     typename vfA_type::BaseType b_A("A",N,M);
-    BaseTypeX b_x("X",M);
-    BaseTypeY b_y("Y",N);
-    BaseTypeY b_org_y("Org_Y",N);
+    BaseTypeX b_x("X",lenX);
+    BaseTypeY b_y("Y",lenY);
+    BaseTypeY b_org_y("Org_Y",lenY);
     
 
     ViewTypeA A = vfA_type::view(b_A);
@@ -75,6 +79,16 @@ namespace Test {
         expected_result += (b*h_y(i) + a * y_i) * (b*h_y(i) + a * y_i) ;
       }
     }
+    else {
+      typedef Kokkos::Details::ArithTraits<ScalarA> KAT;
+      for(int i=0;i<M;i++) {
+        ScalarY y_i = ScalarY();
+        for(int j=0; j<N; j++) {
+           y_i += (mode[0]=='C' ? KAT::conj(h_A(j,i)) : h_A(j,i))*h_x(j);
+        }
+        expected_result += (b*h_y(i) + a * y_i) * (b*h_y(i) + a * y_i) ;
+      }
+    }
 
     KokkosBlas::gemv(mode,a,A,x,b,y);
     ScalarY nonconst_nonconst_result = KokkosBlas::dot(y,y);
@@ -105,6 +119,7 @@ int test_gemv(const char* mode) {
   Test::impl_test_gemv<view_type_a_ll, view_type_b_ll, view_type_c_ll, Device>(mode,13,1024);
   Test::impl_test_gemv<view_type_a_ll, view_type_b_ll, view_type_c_ll, Device>(mode,1024,1024);
   Test::impl_test_gemv<view_type_a_ll, view_type_b_ll, view_type_c_ll, Device>(mode,132231,1024);
+  Test::impl_test_gemv<view_type_a_ll, view_type_b_ll, view_type_c_ll, Device>(mode,132231,13);
 #endif
 
 #if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
@@ -115,6 +130,7 @@ int test_gemv(const char* mode) {
   Test::impl_test_gemv<view_type_a_lr, view_type_b_lr, view_type_c_lr, Device>(mode,13,1024);
   Test::impl_test_gemv<view_type_a_lr, view_type_b_lr, view_type_c_lr, Device>(mode,1024,1024);
   Test::impl_test_gemv<view_type_a_lr, view_type_b_lr, view_type_c_lr, Device>(mode,132231,1024);
+  Test::impl_test_gemv<view_type_a_lr, view_type_b_lr, view_type_c_lr, Device>(mode,132231,13);
 #endif
 
 #if defined(KOKKOSKERNELS_INST_LAYOUTSTRIDE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
@@ -125,6 +141,7 @@ int test_gemv(const char* mode) {
   Test::impl_test_gemv<view_type_a_ls, view_type_b_ls, view_type_c_ls, Device>(mode,13,1024);
   Test::impl_test_gemv<view_type_a_ls, view_type_b_ls, view_type_c_ls, Device>(mode,1024,1024);
   Test::impl_test_gemv<view_type_a_ls, view_type_b_ls, view_type_c_ls, Device>(mode,132231,1024);
+  Test::impl_test_gemv<view_type_a_ls, view_type_b_ls, view_type_c_ls, Device>(mode,132231,13);
 #endif
 
 #if !defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS)
@@ -145,12 +162,18 @@ TEST_F( TestCategory, gemv_float ) {
 TEST_F( TestCategory, gemv_double ) {
     test_gemv<double,double,double,TestExecSpace> ("N");
 }
+TEST_F( TestCategory, gemv_trans_double ) {
+    test_gemv<double,double,double,TestExecSpace> ("T");
+}
 #endif
 
 #if defined(KOKKOSKERNELS_INST_COMPLEX_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
 TEST_F( TestCategory, gemv_complex_double ) {
     test_gemv<Kokkos::complex<double>,Kokkos::complex<double>,Kokkos::complex<double>,TestExecSpace> ("N");
 }
+TEST_F( TestCategory, gemv_conj_trans_complex_double ) {
+    test_gemv<Kokkos::complex<double>,Kokkos::complex<double>,Kokkos::complex<double>,TestExecSpace> ("C");
+}
 #endif
 
 #if defined(KOKKOSKERNELS_INST_INT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
@@ -0,0 +1,162 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+#include<Kokkos_Random.hpp>
+#include<KokkosBlas3_trsm.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+namespace Test {
+
+  template<class ViewTypeA, class ViewTypeB, class Device>
+  void impl_test_trsm(const char* side, const char* uplo, const char* trans, const char* diag,
+                      int M, int N,
+                      typename ViewTypeB::value_type alpha) {
+
+    bool is_left  = (side[0]=='L') || (side[0]=='l');
+    bool is_lower = (uplo[0]=='L') || (uplo[0]=='l');
+    bool is_unit  = (diag[0]=='U') || (diag[0]=='u');
+    bool A_t = (trans[0]!='N') && (trans[0]!='n');
+    bool A_c = (trans[0]=='C') || (trans[0]=='c');
+    typedef typename ViewTypeA::device_type::execution_space execution_space;
+    typedef typename ViewTypeA::value_type ScalarA;
+    typedef typename ViewTypeB::value_type ScalarB;
+    typedef Kokkos::Details::ArithTraits<ScalarB> APT;
+    typedef typename APT::mag_type mag_type;
+
+    double machine_eps = APT::epsilon();
+
+    const int K = is_left ? M : N;
+    ViewTypeA A("A",K,K);
+    ViewTypeB B("B",M,N);
+    ViewTypeB X("X",M,N);
+
+    uint64_t seed = Kokkos::Impl::clock_tic();
+    Kokkos::Random_XorShift64_Pool<execution_space> rand_pool(seed);
+
+    Kokkos::fill_random(A,rand_pool,ScalarA(1));
+    Kokkos::fill_random(B,rand_pool,ScalarB(10));
+
+    // Keep op(A) well conditioned: small off-diagonal entries and a dominant diagonal
+    typename ViewTypeA::HostMirror h_A = Kokkos::create_mirror_view(A);
+    Kokkos::deep_copy(h_A,A);
+    for(int i=0; i<K; i++)
+      for(int j=0; j<K; j++)
+        h_A(i,j) = (i == j ? h_A(i,j) + ScalarA(2) : h_A(i,j)/ScalarA(K));
+    Kokkos::deep_copy(A,h_A);
+    Kokkos::deep_copy(X,B);
+
+    Kokkos::fence();
+
+    KokkosBlas::trsm(side,uplo,trans,diag,alpha,A,X);
+
+    Kokkos::fence();
+
+    typename ViewTypeB::HostMirror h_B = Kokkos::create_mirror_view(B);
+    typename ViewTypeB::HostMirror h_X = Kokkos::create_mirror_view(X);
+    Kokkos::deep_copy(h_B,B);
+    Kokkos::deep_copy(h_X,X);
+
+    // op(A) with the triangle and diagonal that trsm references
+    auto opA = [&] (const int i, const int j) -> ScalarA {
+      const int r = A_t ? j : i, c = A_t ? i : j;
+      if(r == c && is_unit) return ScalarA(1);
+      if(r != c && (r > c) != is_lower) return ScalarA(0);
+      return A_c ? Kokkos::Details::ArithTraits<ScalarA>::conj(h_A(r,c)) : h_A(r,c);
+    };
+
+    // residual of op(A)*X = alpha*B or X*op(A) = alpha*B
+    mag_type diff = 0, norm = 0;
+    for(int i=0; i<M; i++)
+      for(int j=0; j<N; j++) {
+        ScalarB s = 0;
+        for(int l=0; l<K; l++)
+          s += is_left ? opA(i,l)*h_X(l,j) : h_X(i,l)*opA(l,j);
+        diff += APT::abs(s - alpha*h_B(i,j));
+        norm += APT::abs(alpha*h_B(i,j));
+      }
+
+    if( N!=0 && M!=0 && norm != 0 ) {
+      // Expected Result: the backward error of the substitution grows with the order of A
+      double diff_expected = 1.0*K*75*machine_eps;
+      EXPECT_TRUE( (diff/norm < diff_expected) );
+    }
+  }
+}
+
+
+
+template<class ScalarA, class ScalarB, class Device>
+int test_trsm(const char* mode, ScalarB alpha) {
+
+#if defined(KOKKOSKERNELS_INST_LAYOUTLEFT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<ScalarA**, Kokkos::LayoutLeft, Device> view_type_a_ll;
+  typedef Kokkos::View<ScalarB**, Kokkos::LayoutLeft, Device> view_type_b_ll;
+  Test::impl_test_trsm<view_type_a_ll, view_type_b_ll, Device>(&mode[0],&mode[1],&mode[2],&mode[3],0,0,alpha);
+  Test::impl_test_trsm<view_type_a_ll, view_type_b_ll, Device>(&mode[0],&mode[1],&mode[2],&mode[3],13,15,alpha);
+  Test::impl_test_trsm<view_type_a_ll, view_type_b_ll, Device>(&mode[0],&mode[1],&mode[2],&mode[3],179,15,alpha);
+  Test::impl_test_trsm<view_type_a_ll, view_type_b_ll, Device>(&mode[0],&mode[1],&mode[2],&mode[3],12,211,alpha);
+#endif
+
+#if defined(KOKKOSKERNELS_INST_LAYOUTRIGHT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+  typedef Kokkos::View<ScalarA**, Kokkos::LayoutRight, Device> view_type_a_lr;
+  typedef Kokkos::View<ScalarB**, Kokkos::LayoutRight, Device> view_type_b_lr;
+  Test::impl_test_trsm<view_type_a_lr, view_type_b_lr, Device>(&mode[0],&mode[1],&mode[2],&mode[3],0,0,alpha);
+  Test::impl_test_trsm<view_type_a_lr, view_type_b_lr, Device>(&mode[0],&mode[1],&mode[2],&mode[3],13,15,alpha);
+  Test::impl_test_trsm<view_type_a_lr, view_type_b_lr, Device>(&mode[0],&mode[1],&mode[2],&mode[3],179,15,alpha);
+  Test::impl_test_trsm<view_type_a_lr, view_type_b_lr, Device>(&mode[0],&mode[1],&mode[2],&mode[3],12,211,alpha);
+#endif
+
+  return 1;
+}
+
+// mode = side, uplo, trans, diag
+template<class Scalar, class Device>
+void test_trsm_modes(const char trans, Scalar alpha) {
+  const char sides[] = "LR", uplos[] = "LU", diags[] = "NU";
+  for(int s=0; s<2; s++)
+    for(int u=0; u<2; u++)
+      for(int d=0; d<2; d++) {
+        const char mode[] = { sides[s], uplos[u], trans, diags[d], '\0' };
+        test_trsm<Scalar,Scalar,Device> (mode,alpha);
+      }
+}
+
+#if defined(KOKKOSKERNELS_INST_FLOAT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, trsm_float ) {
+  Kokkos::Profiling::pushRegion("KokkosBlas::Test::trsm_float");
+    test_trsm_modes<float,TestExecSpace> ('N',1.0f);
+    test_trsm_modes<float,TestExecSpace> ('T',1.0f);
+    test_trsm_modes<float,TestExecSpace> ('N',4.5f);
+  Kokkos::Profiling::popRegion();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, trsm_double ) {
+  Kokkos::Profiling::pushRegion("KokkosBlas::Test::trsm_double");
+    test_trsm_modes<double,TestExecSpace> ('N',1.0);
+    test_trsm_modes<double,TestExecSpace> ('T',1.0);
+    test_trsm_modes<double,TestExecSpace> ('N',4.5);
+    test_trsm_modes<double,TestExecSpace> ('T',4.5);
+  Kokkos::Profiling::popRegion();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_COMPLEX_DOUBLE) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, trsm_complex_double ) {
+  Kokkos::Profiling::pushRegion("KokkosBlas::Test::trsm_complex_double");
+    test_trsm_modes<Kokkos::complex<double>,TestExecSpace> ('N',Kokkos::complex<double>(1.0,0.0));
+    test_trsm_modes<Kokkos::complex<double>,TestExecSpace> ('T',Kokkos::complex<double>(1.0,0.0));
+    test_trsm_modes<Kokkos::complex<double>,TestExecSpace> ('C',Kokkos::complex<double>(1.0,0.0));
+    test_trsm_modes<Kokkos::complex<double>,TestExecSpace> ('C',Kokkos::complex<double>(4.5,-1.0));
+  Kokkos::Profiling::popRegion();
+}
+#endif
+
+#if defined(KOKKOSKERNELS_INST_COMPLEX_FLOAT) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+TEST_F( TestCategory, trsm_complex_float ) {
+  Kokkos::Profiling::pushRegion("KokkosBlas::Test::trsm_complex_float");
+    test_trsm_modes<Kokkos::complex<float>,TestExecSpace> ('N',Kokkos::complex<float>(1.0f,0.0f));
+    test_trsm_modes<Kokkos::complex<float>,TestExecSpace> ('C',Kokkos::complex<float>(4.5f,-1.0f));
+  Kokkos::Profiling::popRegion();
+}
+#endif
@@ -0,0 +1,3 @@
+#include "Test_Cuda.hpp"
+#include "Test_Batched_CompactBatch.hpp"
+#include "Test_Batched_CompactBatch_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Cuda.hpp"
+#include "Test_Batched_SerialBandLU.hpp"
+#include "Test_Batched_SerialBandLU_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Cuda.hpp"
+#include "Test_Batched_SerialInverseLU.hpp"
+#include "Test_Batched_SerialInverseLU_Real.hpp"
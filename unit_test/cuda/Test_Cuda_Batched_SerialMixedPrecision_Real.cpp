@@ -0,0 +1,3 @@
+#include "Test_Cuda.hpp"
+#include "Test_Batched_SerialMixedPrecision.hpp"
+#include "Test_Batched_SerialMixedPrecision_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Cuda.hpp"
+#include "Test_Batched_SerialTridiagonalSolve.hpp"
+#include "Test_Batched_SerialTridiagonalSolve_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Cuda.hpp"
+#include "Test_Batched_StreamingBatch.hpp"
+#include "Test_Batched_StreamingBatch_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Cuda.hpp"
+#include "Test_Batched_TeamInverseLU.hpp"
+#include "Test_Batched_TeamInverseLU_Real.hpp"
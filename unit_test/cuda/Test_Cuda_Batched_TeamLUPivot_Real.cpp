@@ -0,0 +1,3 @@
+#include "Test_Cuda.hpp"
+#include "Test_Batched_TeamLUPivot.hpp"
+#include "Test_Batched_TeamLUPivot_Real.hpp"
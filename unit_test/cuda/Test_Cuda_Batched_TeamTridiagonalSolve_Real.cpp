@@ -0,0 +1,3 @@
+#include "Test_Cuda.hpp"
+#include "Test_Batched_TeamTridiagonalSolve.hpp"
+#include "Test_Batched_TeamTridiagonalSolve_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Cuda.hpp"
+#include "Test_Batched_TeamVectorGemm.hpp"
+#include "Test_Batched_TeamVectorGemm_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Cuda.hpp"
+#include "Test_Batched_TeamVectorLU.hpp"
+#include "Test_Batched_TeamVectorLU_Real.hpp"
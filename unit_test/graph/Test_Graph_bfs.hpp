@@ -0,0 +1,135 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <queue>
+#include <vector>
+
+#include "KokkosGraph_BFS.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_bfs(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  using namespace KokkosGraph::Experimental;
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type lno_view_t;
+  typedef typename graph_t::entries_type lno_nnz_view_t;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  typename lno_view_t::non_const_type sym_xadj;
+  typename lno_nnz_view_t::non_const_type sym_adj;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<lno_view_t, lno_nnz_view_t,
+      typename lno_view_t::non_const_type, typename lno_nnz_view_t::non_const_type, device>
+    (numRows, input_mat.graph.row_map, input_mat.graph.entries, sym_xadj, sym_adj);
+
+  typename lno_view_t::non_const_type::HostMirror hrm = Kokkos::create_mirror_view(sym_xadj);
+  typename lno_nnz_view_t::non_const_type::HostMirror hentries = Kokkos::create_mirror_view(sym_adj);
+  Kokkos::deep_copy(hrm, sym_xadj);
+  Kokkos::deep_copy(hentries, sym_adj);
+
+  const BFSDirection directions[] = {BFS_DIRECTION_OPTIMIZING, BFS_TOP_DOWN, BFS_BOTTOM_UP};
+  const lno_t roots[] = {0, numRows / 2, numRows - 1};
+  for (int r = 0; r < 3; ++r){
+    const lno_t root = roots[r];
+    std::vector<lno_t> expected(numRows, -1);
+    std::queue<lno_t> q;
+    expected[root] = 0;
+    q.push(root);
+    while (!q.empty()){
+      const lno_t v = q.front();
+      q.pop();
+      for (size_type e = hrm(v); e < hrm(v + 1); ++e){
+        const lno_t n = hentries(e);
+        if (expected[n] == -1){
+          expected[n] = expected[v] + 1;
+          q.push(n);
+        }
+      }
+    }
+
+    for (int d = 0; d < 3; ++d){
+      auto levels = graph_bfs(numRows, sym_xadj, sym_adj, root, directions[d]);
+      auto h_levels = Kokkos::create_mirror_view(levels);
+      Kokkos::deep_copy(h_levels, levels);
+      lno_t num_errors = 0;
+      for (lno_t i = 0; i < numRows; ++i){
+        if (h_levels(i) != expected[i]) ++num_errors;
+      }
+      EXPECT_TRUE(num_errors == 0) << "root " << root << " direction " << d;
+    }
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, graph ## _ ## bfs ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_bfs<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 20, 5000, 10); \
+  test_bfs<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 4, 20, 2); \
+  test_bfs<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000 * 2, 1000, 1); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
@@ -0,0 +1,188 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "KokkosGraph_Coarsen.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+#include "KokkosKernels_Handle.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_coarsen(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  using namespace KokkosGraph::Experimental;
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type lno_view_t;
+  typedef typename graph_t::entries_type lno_nnz_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef Kokkos::View<lno_t *, device> lno_work_view_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  typename lno_view_t::non_const_type sym_xadj;
+  typename lno_nnz_view_t::non_const_type sym_adj;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<lno_view_t, lno_nnz_view_t,
+      typename lno_view_t::non_const_type, typename lno_nnz_view_t::non_const_type, device>
+    (numRows, input_mat.graph.row_map, input_mat.graph.entries, sym_xadj, sym_adj);
+
+  typename lno_view_t::non_const_type::HostMirror hrm = Kokkos::create_mirror_view(sym_xadj);
+  typename lno_nnz_view_t::non_const_type::HostMirror hentries = Kokkos::create_mirror_view(sym_adj);
+  Kokkos::deep_copy(hrm, sym_xadj);
+  Kokkos::deep_copy(hentries, sym_adj);
+
+  //symmetric weights with many ties.
+  scalar_view_t weights("weights", sym_adj.extent(0));
+  typename scalar_view_t::HostMirror hweights = Kokkos::create_mirror_view(weights);
+  for (lno_t i = 0; i < numRows; ++i){
+    for (size_type e = hrm(i); e < hrm(i + 1); ++e){
+      const lno_t j = hentries(e);
+      const lno_t lo = i < j ? i : j, hi = i < j ? j : i;
+      hweights(e) = scalar_t(1 + (lo * 7 + hi * 13) % 4);
+    }
+  }
+  Kokkos::deep_copy(weights, hweights);
+
+  lno_work_view_t match = graph_heavy_edge_matching(numRows, sym_xadj, sym_adj, weights);
+  lno_work_view_t match2 = graph_heavy_edge_matching(numRows, sym_xadj, sym_adj, weights);
+  typename lno_work_view_t::HostMirror h_match = Kokkos::create_mirror_view(match);
+  typename lno_work_view_t::HostMirror h_match2 = Kokkos::create_mirror_view(match2);
+  Kokkos::deep_copy(h_match, match);
+  Kokkos::deep_copy(h_match2, match2);
+
+  //a matching of edges, maximal, and the same on every call.
+  lno_t num_errors = 0;
+  for (lno_t i = 0; i < numRows; ++i){
+    const lno_t m = h_match(i);
+    if (m != h_match2(i)) ++num_errors;
+    if (m < 0 || m >= numRows || h_match(m) != i){
+      ++num_errors;
+      continue;
+    }
+    bool is_edge = m == i;
+    for (size_type e = hrm(i); e < hrm(i + 1); ++e){
+      const lno_t j = hentries(e);
+      if (j == m) is_edge = true;
+      if (m == i && j != i && h_match(j) == j) ++num_errors;
+    }
+    if (!is_edge) ++num_errors;
+  }
+  EXPECT_TRUE(num_errors == 0);
+
+  KernelHandle kh;
+  kh.create_spgemm_handle();
+  lno_work_view_t labels("labels", numRows);
+  typename lno_view_t::non_const_type coarse_xadj;
+  typename lno_nnz_view_t::non_const_type coarse_adj;
+  scalar_view_t coarse_weights;
+  lno_t num_coarse = graph_coarsen(&kh, numRows, sym_xadj, sym_adj, weights, match, labels,
+      coarse_xadj, coarse_adj, coarse_weights);
+  kh.destroy_spgemm_handle();
+
+  typename lno_work_view_t::HostMirror h_labels = Kokkos::create_mirror_view(labels);
+  Kokkos::deep_copy(h_labels, labels);
+  std::vector<std::map<lno_t, scalar_t> > expected(num_coarse);
+  lno_t next_label = 0;
+  num_errors = 0;
+  for (lno_t i = 0; i < numRows; ++i){
+    const lno_t leader = h_match(i) < i ? h_match(i) : i;
+    if (leader == i && h_labels(i) != next_label++) ++num_errors;
+    if (h_labels(i) != h_labels(leader)) ++num_errors;
+    for (size_type e = hrm(i); e < hrm(i + 1); ++e){
+      expected[h_labels(i)][h_labels(hentries(e))] += hweights(e);
+    }
+  }
+  EXPECT_EQ(num_coarse, next_label);
+
+  typename lno_view_t::non_const_type::HostMirror h_cxadj = Kokkos::create_mirror_view(coarse_xadj);
+  typename lno_nnz_view_t::non_const_type::HostMirror h_cadj = Kokkos::create_mirror_view(coarse_adj);
+  typename scalar_view_t::HostMirror h_cweights = Kokkos::create_mirror_view(coarse_weights);
+  Kokkos::deep_copy(h_cxadj, coarse_xadj);
+  Kokkos::deep_copy(h_cadj, coarse_adj);
+  Kokkos::deep_copy(h_cweights, coarse_weights);
+  for (lno_t c = 0; c < num_coarse; ++c){
+    if (h_cxadj(c + 1) - h_cxadj(c) != size_type(expected[c].size())) ++num_errors;
+    for (size_type e = h_cxadj(c); e < h_cxadj(c + 1); ++e){
+      typename std::map<lno_t, scalar_t>::const_iterator it = expected[c].find(h_cadj(e));
+      if (it == expected[c].end() || std::abs(it->second - h_cweights(e)) > 1e-10) ++num_errors;
+    }
+  }
+  EXPECT_TRUE(num_errors == 0);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, graph ## _ ## coarsen ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_coarsen<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 10, 200, 5); \
+  test_coarsen<SCALAR,ORDINAL,OFFSET,DEVICE>(2000, 2000 * 2, 2000, 1); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
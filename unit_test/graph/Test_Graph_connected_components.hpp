@@ -0,0 +1,174 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "KokkosGraph_ConnectedComponents.hpp"
+
+// Random symmetric graph of one large block, num_small blocks of small_size
+// vertices and num_isolated isolated vertices, randomly renumbered. Returns
+// the block of each vertex.
+template <typename row_map_t, typename entries_t>
+std::vector<int> random_block_graph(
+    typename entries_t::non_const_value_type large_size,
+    typename entries_t::non_const_value_type num_small,
+    typename entries_t::non_const_value_type small_size,
+    typename entries_t::non_const_value_type num_isolated,
+    row_map_t &row_map, entries_t &entries){
+  typedef typename entries_t::non_const_value_type lno_t;
+  typedef typename row_map_t::non_const_value_type size_type;
+
+  const lno_t n = large_size + num_small * small_size + num_isolated;
+  std::vector<lno_t> label(n);
+  for (lno_t i = 0; i < n; ++i) label[i] = i;
+  std::mt19937 gen(1949);
+  std::shuffle(label.begin(), label.end(), gen);
+
+  std::vector<int> block(n, -1);
+  std::vector<std::vector<lno_t> > adj(n);
+  lno_t first = 0;
+  for (lno_t b = 0; b <= num_small; ++b){
+    const lno_t size = b == 0 ? large_size : small_size;
+    //a path keeps the block connected, random chords add cycles.
+    for (lno_t i = 0; i < size; ++i){
+      block[label[first + i]] = b;
+      if (i > 0){
+        adj[label[first + i]].push_back(label[first + i - 1]);
+        adj[label[first + i - 1]].push_back(label[first + i]);
+      }
+    }
+    for (lno_t i = 0; i < 2 * size; ++i){
+      const lno_t u = label[first + gen() % size], v = label[first + gen() % size];
+      adj[u].push_back(v);
+      adj[v].push_back(u);
+    }
+    first += size;
+  }
+  for (lno_t i = 0; i < num_isolated; ++i) block[label[first + i]] = num_small + 1 + i;
+
+  size_type nnz = 0;
+  for (lno_t i = 0; i < n; ++i){
+    std::shuffle(adj[i].begin(), adj[i].end(), gen);
+    nnz += adj[i].size();
+  }
+  row_map = row_map_t("row_map", n + 1);
+  entries = entries_t("entries", nnz);
+  typename row_map_t::HostMirror h_row_map = Kokkos::create_mirror_view(row_map);
+  typename entries_t::HostMirror h_entries = Kokkos::create_mirror_view(entries);
+  size_type k = 0;
+  for (lno_t i = 0; i < n; ++i){
+    h_row_map(i) = k;
+    for (size_t j = 0; j < adj[i].size(); ++j) h_entries(k++) = adj[i][j];
+  }
+  h_row_map(n) = k;
+  Kokkos::deep_copy(row_map, h_row_map);
+  Kokkos::deep_copy(entries, h_entries);
+  return block;
+}
+
+template <typename lno_t, typename size_type, typename device>
+void test_connected_components(lno_t large_size, lno_t num_small, lno_t small_size, lno_t num_isolated) {
+  typedef Kokkos::View<size_type *, device> row_map_t;
+  typedef Kokkos::View<lno_t *, device> entries_t;
+
+  row_map_t row_map;
+  entries_t entries;
+  std::vector<int> block = random_block_graph(large_size, num_small, small_size, num_isolated, row_map, entries);
+  const lno_t n = block.size();
+
+  entries_t labels("labels", n);
+  lno_t num_components = KokkosGraph::Experimental::connected_components(n, row_map, entries, labels);
+  EXPECT_EQ(num_components, lno_t((large_size > 0 ? 1 : 0) + num_small + num_isolated));
+
+  typename entries_t::HostMirror h_labels = Kokkos::create_mirror_view(labels);
+  Kokkos::deep_copy(h_labels, labels);
+  //labels are numbered by first vertex, and match the blocks one to one.
+  std::vector<int> block_of_label(num_components, -1);
+  lno_t next_label = 0, num_errors = 0;
+  for (lno_t i = 0; i < n; ++i){
+    const lno_t l = h_labels(i);
+    if (l < 0 || l >= num_components){
+      ++num_errors;
+      continue;
+    }
+    if (block_of_label[l] == -1){
+      if (l != next_label++) ++num_errors;
+      block_of_label[l] = block[i];
+    }
+    else if (block_of_label[l] != block[i]) ++num_errors;
+  }
+  EXPECT_TRUE(num_errors == 0);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, graph ## _ ## connected_components ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_connected_components<ORDINAL,OFFSET,DEVICE>(20000, 50, 30, 100); \
+  test_connected_components<ORDINAL,OFFSET,DEVICE>(0, 300, 5, 0); \
+  test_connected_components<ORDINAL,OFFSET,DEVICE>(10, 0, 1, 3); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
@@ -43,6 +43,8 @@
 
 #include <gtest/gtest.h>
 #include <Kokkos_Core.hpp>
+#include <vector>
+#include <algorithm>
 
 #include "KokkosGraph_graph_color.hpp"
 #include "KokkosSparse_CrsMatrix.hpp"
@@ -57,12 +59,25 @@ using namespace KokkosGraph;
 using namespace KokkosGraph::Experimental;
 
 namespace Test {
+//the pseudo random priority of a vertex in the JPL coloring.
+template <typename lno_t>
+unsigned int jpl_priority(lno_t v){
+  unsigned int h = static_cast<unsigned int>(v) * 2654435761u;
+  h ^= h >> 16;
+  h *= 0x45d9f3bu;
+  h ^= h >> 16;
+  return h;
+}
+
 template <typename crsMat_t, typename device>
 int run_graphcolor(
     crsMat_t input_mat,
     ColoringAlgorithm coloring_algorithm,
     size_t &num_colors,
-    typename crsMat_t::StaticCrsGraphType::entries_type::non_const_type & vertex_colors){
+    typename crsMat_t::StaticCrsGraphType::entries_type::non_const_type & vertex_colors,
+    bool balance_colors = false,
+    size_t *max_color_size = NULL,
+    ColoringOrdering coloring_ordering = COLORING_ORDER_NATURAL){
   typedef typename crsMat_t::StaticCrsGraphType graph_t;
   typedef typename graph_t::row_map_type lno_view_t;
   typedef typename graph_t::entries_type   lno_nnz_view_t;
@@ -82,6 +97,8 @@ int run_graphcolor(
   kh.set_dynamic_scheduling(true);
 
   kh.create_graph_coloring_handle(coloring_algorithm);
+  kh.get_graph_coloring_handle()->set_balance_colors(balance_colors);
+  kh.get_graph_coloring_handle()->set_coloring_ordering(coloring_ordering);
 
 
   const size_t num_rows_1 = input_mat.numRows();
@@ -93,6 +110,38 @@ int run_graphcolor(
 
   num_colors = kh.get_graph_coloring_handle()->get_num_colors();
   vertex_colors = kh.get_graph_coloring_handle()->get_vertex_colors();
+  if (max_color_size != NULL){
+    typename KernelHandle::GraphColoringHandleType::nnz_lno_persistent_work_host_view_t histogram =
+        kh.get_graph_coloring_handle()->get_color_histogram();
+    size_t total = 0;
+    *max_color_size = 0;
+    for (size_t c = 0; c < histogram.extent(0); ++c){
+      total += histogram(c);
+      if (size_t(histogram(c)) > *max_color_size) *max_color_size = histogram(c);
+    }
+    EXPECT_EQ(histogram.extent(0), num_colors);
+    EXPECT_EQ(total, num_rows_1);
+  }
+
+  //the color sets hold every vertex once, under its color, in ascending order.
+  typename KernelHandle::GraphColoringHandleType::nnz_lno_persistent_work_host_view_t h_set_xadj =
+      kh.get_graph_coloring_handle()->get_host_color_set_xadj();
+  typename KernelHandle::GraphColoringHandleType::nnz_lno_persistent_work_view_t set_adj =
+      kh.get_graph_coloring_handle()->get_color_set_adj();
+  typename KernelHandle::GraphColoringHandleType::nnz_lno_persistent_work_host_view_t h_set_adj =
+      Kokkos::create_mirror_view(set_adj);
+  Kokkos::deep_copy(h_set_adj, set_adj);
+  typename lno_nnz_view_t::non_const_type::HostMirror h_colors = Kokkos::create_mirror_view(vertex_colors);
+  Kokkos::deep_copy(h_colors, vertex_colors);
+  EXPECT_EQ(h_set_xadj.extent(0), num_colors + 1);
+  EXPECT_EQ(h_set_adj.extent(0), num_rows_1);
+  EXPECT_EQ(size_t(h_set_xadj(num_colors)), num_rows_1);
+  for (size_t c = 0; c < num_colors; ++c){
+    for (lno_t k = h_set_xadj(c); k < h_set_xadj(c + 1); ++k){
+      EXPECT_EQ(size_t(h_colors(h_set_adj(k))), c + 1);
+      if (k > h_set_xadj(c)) EXPECT_LT(h_set_adj(k - 1), h_set_adj(k));
+    }
+  }
   kh.destroy_graph_coloring_handle();
   return 0;
 }
@@ -124,9 +173,9 @@ void test_coloring(lno_t numRows,size_type nnz, lno_t bandwidth, lno_t row_size_
   graph_t static_graph (sym_adj, sym_xadj);
   input_mat = crsMat_t("CrsMatrix", numCols, newValues, static_graph);
 
-  ColoringAlgorithm coloring_algorithms[] = {COLORING_DEFAULT, COLORING_SERIAL, COLORING_VB, COLORING_VBBIT, COLORING_VBCS, COLORING_EB};
+  ColoringAlgorithm coloring_algorithms[] = {COLORING_DEFAULT, COLORING_SERIAL, COLORING_VB, COLORING_VBBIT, COLORING_VBCS, COLORING_EB, COLORING_JPL};
 
-  for (int ii = 0; ii < 6; ++ii){
+  for (int ii = 0; ii < 7; ++ii){
     ColoringAlgorithm coloring_algorithm = coloring_algorithms[ii];
     color_view_t vector_colors;
     size_t num_colors;
@@ -172,14 +221,229 @@ void test_coloring(lno_t numRows,size_type nnz, lno_t bandwidth, lno_t row_size_
 
     EXPECT_TRUE( (num_conflict == 0));
   }
+
+  //the balanced coloring is valid, has the same number of colors, and no larger color class.
+  {
+    color_view_t vector_colors, balanced_colors;
+    size_t num_colors, balanced_num_colors, max_color_size, balanced_max_color_size;
+    run_graphcolor<crsMat_t, device>(input_mat, COLORING_VB, num_colors, vector_colors, false, &max_color_size);
+    run_graphcolor<crsMat_t, device>(input_mat, COLORING_VB, balanced_num_colors, balanced_colors, true, &balanced_max_color_size);
+    EXPECT_EQ(balanced_num_colors, num_colors);
+    EXPECT_LE(balanced_max_color_size, max_color_size);
+    lno_t num_conflict = KokkosKernels::Impl::kk_is_d1_coloring_valid
+        <lno_view_t,lno_nnz_view_t, color_view_t, typename device::execution_space>
+    (input_mat.numRows(), input_mat.numCols(), input_mat.graph.row_map, input_mat.graph.entries, balanced_colors);
+    EXPECT_TRUE( (num_conflict == 0));
+  }
+
+  //the orderings give valid colorings with at most max degree + 1 colors.
+  {
+    typename lno_view_t::HostMirror hrm = Kokkos::create_mirror_view (input_mat.graph.row_map);
+    Kokkos::deep_copy (hrm , input_mat.graph.row_map);
+    size_t max_degree = 0;
+    for (lno_t i = 0; i < input_mat.numRows(); ++i){
+      if (size_t(hrm(i + 1) - hrm(i)) > max_degree) max_degree = hrm(i + 1) - hrm(i);
+    }
+    ColoringAlgorithm ordered_algorithms[] = {COLORING_VB, COLORING_VBBIT, COLORING_VBCS, COLORING_JPL};
+    ColoringOrdering orderings[] = {COLORING_ORDER_LARGEST_FIRST, COLORING_ORDER_SMALLEST_LAST};
+    for (int ii = 0; ii < 4; ++ii){
+      for (int oo = 0; oo < 2; ++oo){
+        color_view_t vector_colors;
+        size_t num_colors;
+        run_graphcolor<crsMat_t, device>(input_mat, ordered_algorithms[ii], num_colors, vector_colors, false, NULL, orderings[oo]);
+        lno_t num_conflict = KokkosKernels::Impl::kk_is_d1_coloring_valid
+            <lno_view_t,lno_nnz_view_t, color_view_t, typename device::execution_space>
+        (input_mat.numRows(), input_mat.numCols(), input_mat.graph.row_map, input_mat.graph.entries, vector_colors);
+        EXPECT_TRUE( (num_conflict == 0));
+        EXPECT_LE(num_colors, max_degree + 1);
+      }
+    }
+  }
+
+  //the deterministic coloring is the JPL coloring of the host, whatever the algorithm.
+  {
+    typename lno_view_t::HostMirror hrm = Kokkos::create_mirror_view (input_mat.graph.row_map);
+    typename lno_nnz_view_t::HostMirror hentries = Kokkos::create_mirror_view (input_mat.graph.entries);
+    Kokkos::deep_copy (hrm , input_mat.graph.row_map);
+    Kokkos::deep_copy (hentries , input_mat.graph.entries);
+    const lno_t nv = input_mat.numRows();
+    std::vector<lno_t> ref(nv, 0), next(nv, 0);
+    for (bool uncolored = true; uncolored; ){
+      uncolored = false;
+      for (lno_t v = 0; v < nv; ++v){
+        next[v] = ref[v];
+        if (ref[v] > 0) continue;
+        bool is_max = true;
+        for (size_type k = hrm(v); k < hrm(v + 1); ++k){
+          const lno_t u = hentries(k);
+          if (u == v || u >= nv || ref[u] > 0) continue;
+          if (jpl_priority(u) > jpl_priority(v) || (jpl_priority(u) == jpl_priority(v) && u > v)) is_max = false;
+        }
+        if (!is_max){
+          uncolored = true;
+          continue;
+        }
+        std::vector<bool> used(hrm(v + 1) - hrm(v) + 2, false);
+        for (size_type k = hrm(v); k < hrm(v + 1); ++k){
+          const lno_t u = hentries(k);
+          if (u < nv && ref[u] > 0 && size_t(ref[u]) < used.size()) used[ref[u]] = true;
+        }
+        lno_t c = 1;
+        while (used[c]) ++c;
+        next[v] = c;
+      }
+      ref.swap(next);
+    }
+
+    typedef KokkosKernelsHandle
+        <size_type,lno_t, scalar_t,
+        typename device::execution_space, typename device::memory_space,typename device::memory_space > KernelHandle;
+    ColoringAlgorithm algorithms[] = {COLORING_VB, COLORING_EB, COLORING_JPL};
+    for (int ii = 0; ii < 3; ++ii){
+      KernelHandle kh;
+      kh.create_graph_coloring_handle(algorithms[ii]);
+      kh.get_graph_coloring_handle()->set_deterministic();
+      graph_color(&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries);
+      color_view_t vector_colors = kh.get_graph_coloring_handle()->get_vertex_colors();
+      typename color_view_t::HostMirror hcolor = Kokkos::create_mirror_view (vector_colors);
+      Kokkos::deep_copy (hcolor, vector_colors);
+      lno_t num_different = 0;
+      for (lno_t v = 0; v < nv; ++v){
+        if (hcolor(v) != ref[v]) num_different++;
+      }
+      EXPECT_EQ(num_different, 0);
+      kh.destroy_graph_coloring_handle();
+    }
+  }
+
+  //incremental recoloring: every 100th vertex loses its edges, the graph is colored,
+  //then the edges come back and only these vertices are recolored.
+  {
+    typedef KokkosKernelsHandle
+        <size_type,lno_t, scalar_t,
+        typename device::execution_space, typename device::memory_space,typename device::memory_space > KernelHandle;
+    typedef typename lno_view_t::non_const_type row_map_t;
+    typedef typename lno_nnz_view_t::non_const_type entries_t;
+
+    const lno_t num_rows_1 = input_mat.numRows();
+    typename lno_view_t::HostMirror hrm = Kokkos::create_mirror_view (input_mat.graph.row_map);
+    typename lno_nnz_view_t::HostMirror hentries = Kokkos::create_mirror_view (input_mat.graph.entries);
+    Kokkos::deep_copy (hrm , input_mat.graph.row_map);
+    Kokkos::deep_copy (hentries , input_mat.graph.entries);
+
+    row_map_t reduced_rm("reduced row map", num_rows_1 + 1);
+    entries_t reduced_entries("reduced entries", hentries.extent(0));
+    entries_t changed("changed", (num_rows_1 + 99) / 100);
+    typename row_map_t::HostMirror h_reduced_rm = Kokkos::create_mirror_view (reduced_rm);
+    typename entries_t::HostMirror h_reduced_entries = Kokkos::create_mirror_view (reduced_entries);
+    typename entries_t::HostMirror h_changed = Kokkos::create_mirror_view (changed);
+    size_type nnz_reduced = 0;
+    h_reduced_rm(0) = 0;
+    for (lno_t i = 0; i < num_rows_1; ++i){
+      if (i % 100 == 0) h_changed(i / 100) = i;
+      for (size_type j = hrm(i); j < hrm(i + 1); ++j){
+        if (i % 100 != 0 && hentries(j) % 100 != 0) h_reduced_entries(nnz_reduced++) = hentries(j);
+      }
+      h_reduced_rm(i + 1) = nnz_reduced;
+    }
+    Kokkos::deep_copy (reduced_rm, h_reduced_rm);
+    Kokkos::deep_copy (reduced_entries, h_reduced_entries);
+    Kokkos::deep_copy (changed, h_changed);
+
+    KernelHandle kh;
+    kh.create_graph_coloring_handle(COLORING_VB);
+    graph_color(&kh, num_rows_1, num_rows_1, reduced_rm, Kokkos::subview(reduced_entries, Kokkos::make_pair(size_type(0), nnz_reduced)));
+
+    typename color_view_t::HostMirror h_old_colors = Kokkos::create_mirror_view (kh.get_graph_coloring_handle()->get_vertex_colors());
+    Kokkos::deep_copy (h_old_colors, kh.get_graph_coloring_handle()->get_vertex_colors());
+
+    graph_color_incremental(&kh, num_rows_1, num_rows_1, input_mat.graph.row_map, input_mat.graph.entries, changed);
+
+    color_view_t vector_colors = kh.get_graph_coloring_handle()->get_vertex_colors();
+    lno_t num_conflict = KokkosKernels::Impl::kk_is_d1_coloring_valid
+        <lno_view_t,lno_nnz_view_t, color_view_t, typename device::execution_space>
+    (num_rows_1, num_rows_1, input_mat.graph.row_map, input_mat.graph.entries, vector_colors);
+    EXPECT_TRUE( (num_conflict == 0));
+
+    typename color_view_t::HostMirror hcolor = Kokkos::create_mirror_view (vector_colors);
+    Kokkos::deep_copy (hcolor, vector_colors);
+    lno_t num_moved = 0;
+    for (lno_t i = 0; i < num_rows_1; ++i){
+      if (i % 100 != 0 && hcolor(i) != h_old_colors(i)) num_moved++;
+      if (hcolor(i) <= 0) num_moved++;
+    }
+    EXPECT_EQ(num_moved, 0);
+    kh.destroy_graph_coloring_handle();
+  }
   //device::execution_space::finalize();
 
 }
 
+//crown graph, K_{n,n} minus a perfect matching, with the sides interleaved:
+//a_i = 2i, b_i = 2i + 1, and a_i adjacent to every b_j but b_i. Each a_i also
+//has a leaf 2n + i, so the a side has the larger degree. In the natural order
+//the greedy coloring gives a_i and b_i the color i + 1 and needs n colors;
+//largest-first colors the a side, an independent set, first and needs 2.
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_coloring_largest_first(lno_t n) {
+  using namespace Test;
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type lno_view_t;
+  typedef typename graph_t::entries_type lno_nnz_view_t;
+  typedef typename graph_t::row_map_type::non_const_type row_map_t;
+  typedef typename graph_t::entries_type::non_const_type entries_t;
+  typedef typename graph_t::entries_type::non_const_type color_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+
+  const lno_t num_rows = 3 * n;
+  std::vector<std::vector<lno_t> > cols(num_rows);
+  for (lno_t i = 0; i < n; ++i){
+    for (lno_t j = 0; j < n; ++j){
+      if (i != j) cols[2 * i].push_back(2 * j + 1);
+      if (i != j) cols[2 * i + 1].push_back(2 * j);
+    }
+    cols[2 * i].push_back(2 * n + i);
+    cols[2 * n + i].push_back(2 * i);
+  }
+
+  row_map_t rowmap("crown row map", num_rows + 1);
+  typename row_map_t::HostMirror h_rowmap = Kokkos::create_mirror_view(rowmap);
+  h_rowmap(0) = 0;
+  for (lno_t i = 0; i < num_rows; ++i) h_rowmap(i + 1) = h_rowmap(i) + cols[i].size();
+  const size_type nnz = h_rowmap(num_rows);
+  entries_t entries("crown entries", nnz);
+  scalar_view_t values("crown values", nnz);
+  typename entries_t::HostMirror h_entries = Kokkos::create_mirror_view(entries);
+  for (lno_t i = 0; i < num_rows; ++i){
+    std::sort(cols[i].begin(), cols[i].end());
+    for (size_t k = 0; k < cols[i].size(); ++k) h_entries(h_rowmap(i) + k) = cols[i][k];
+  }
+  Kokkos::deep_copy(rowmap, h_rowmap);
+  Kokkos::deep_copy(entries, h_entries);
+  Kokkos::deep_copy(values, scalar_t(1));
+  crsMat_t input_mat("crown graph", num_rows, num_rows, nnz, values, rowmap, entries);
+
+  ColoringAlgorithm ordered_algorithms[] = {COLORING_VB, COLORING_VBBIT, COLORING_VBCS, COLORING_JPL};
+  for (int ii = 0; ii < 4; ++ii){
+    size_t num_colors_natural = 0, num_colors_largest_first = 0;
+    color_view_t vector_colors;
+    run_graphcolor<crsMat_t, device>(input_mat, ordered_algorithms[ii], num_colors_natural, vector_colors);
+    run_graphcolor<crsMat_t, device>(input_mat, ordered_algorithms[ii], num_colors_largest_first, vector_colors,
+        false, NULL, COLORING_ORDER_LARGEST_FIRST);
+    lno_t num_conflict = KokkosKernels::Impl::kk_is_d1_coloring_valid
+        <lno_view_t,lno_nnz_view_t, color_view_t, typename device::execution_space>
+    (num_rows, num_rows, input_mat.graph.row_map, input_mat.graph.entries, vector_colors);
+    EXPECT_TRUE( (num_conflict == 0));
+    EXPECT_LE(num_colors_largest_first, num_colors_natural);
+  }
+}
+
 #define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
 TEST_F( TestCategory, graph ## _ ## graph_color ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
   test_coloring<SCALAR,ORDINAL,OFFSET,DEVICE>(50000, 50000 * 30, 200, 10); \
   test_coloring<SCALAR,ORDINAL,OFFSET,DEVICE>(50000, 50000 * 30, 100, 10); \
+  test_coloring_largest_first<SCALAR,ORDINAL,OFFSET,DEVICE>(100); \
 }
 
 #if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
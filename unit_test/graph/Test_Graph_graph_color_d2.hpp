@@ -126,7 +126,7 @@ void test_coloring_d2(lno_t numRows,size_type nnz, lno_t bandwidth, lno_t row_si
   graph_t static_graph (sym_adj, sym_xadj);
   input_mat = crsMat_t("CrsMatrix", numCols, newValues, static_graph);
 
-  ColoringAlgorithm coloring_algorithms[] = {COLORING_SPGEMM, COLORING_D2};
+  ColoringAlgorithm coloring_algorithms[] = {COLORING_SPGEMM, COLORING_D2, COLORING_D2_VB_BIT};
 
 
   typedef KokkosKernelsHandle
@@ -154,7 +154,7 @@ void test_coloring_d2(lno_t numRows,size_type nnz, lno_t bandwidth, lno_t row_si
    // done with spgemm 
    cp.destroy_spgemm_handle();
 
-  int num_algorithms = 2;
+  int num_algorithms = 3;
 
   for (int ii = 0; ii < num_algorithms; ++ii){
 
@@ -220,10 +220,71 @@ void test_coloring_d2(lno_t numRows,size_type nnz, lno_t bandwidth, lno_t row_si
 
 }
 
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_bipartite_coloring_d2(lno_t numRows, lno_t numCols, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type lno_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_nnz_view_t;
+  typedef typename device::execution_space execution_space;
+
+  typedef KokkosKernelsHandle
+      <size_type,lno_t, scalar_t,
+      execution_space, typename device::memory_space,typename device::memory_space > KernelHandle;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows,numCols,nnz,row_size_variance, bandwidth);
+
+  lno_view_t t_xadj("t_xadj", numCols + 1);
+  lno_nnz_view_t t_adj("t_adj", input_mat.graph.entries.extent(0));
+  KokkosKernels::Impl::kk_transpose_graph<
+      typename graph_t::row_map_type, typename graph_t::entries_type,
+      lno_view_t, lno_nnz_view_t, lno_view_t, execution_space>
+      (numRows, numCols, input_mat.graph.row_map, input_mat.graph.entries, t_xadj, t_adj);
+
+  ColoringAlgorithm coloring_algorithms[] = {COLORING_D2, COLORING_D2_VB_BIT};
+
+  for (int ii = 0; ii < 2; ++ii){
+    KernelHandle kh;
+    kh.create_graph_coloring_handle(coloring_algorithms[ii]);
+
+    bipartite_color_columns(&kh, numRows, numCols, input_mat.graph.row_map, input_mat.graph.entries, t_xadj, t_adj);
+
+    typename KernelHandle::GraphColoringHandleType::color_view_t colors = kh.get_graph_coloring_handle()->get_vertex_colors();
+    EXPECT_TRUE( (colors.extent(0) == size_t(numCols)));
+
+    typename graph_t::row_map_type::HostMirror hrm = Kokkos::create_mirror_view (input_mat.graph.row_map);
+    typename graph_t::entries_type::HostMirror hentries = Kokkos::create_mirror_view (input_mat.graph.entries);
+    typename KernelHandle::GraphColoringHandleType::color_view_t::HostMirror hcolor = Kokkos::create_mirror_view (colors);
+    Kokkos::deep_copy (hrm , input_mat.graph.row_map);
+    Kokkos::deep_copy (hentries , input_mat.graph.entries);
+    Kokkos::deep_copy (hcolor , colors);
+
+    // the columns of a row must all have different colors.
+    lno_t conf = 0, uncolored = 0;
+    for (lno_t i = 0; i < numCols; ++i){
+      if (hcolor(i) <= 0) uncolored++;
+    }
+    for (lno_t i = 0; i < numRows; ++i){
+      for (size_type j = hrm(i); j < hrm(i + 1); ++j){
+        for (size_type k = j + 1; k < hrm(i + 1); ++k){
+          if (hentries(j) != hentries(k) && hcolor(hentries(j)) == hcolor(hentries(k))){
+            conf++;
+          }
+        }
+      }
+    }
+    EXPECT_TRUE( (uncolored == 0));
+    EXPECT_TRUE( (conf == 0));
+
+    kh.destroy_graph_coloring_handle();
+  }
+}
+
 #define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
 TEST_F( TestCategory, graph ## _ ## graph_color_d2 ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
   test_coloring_d2<SCALAR,ORDINAL,OFFSET,DEVICE>(50000, 50000 * 30, 200, 10); \
   test_coloring_d2<SCALAR,ORDINAL,OFFSET,DEVICE>(50000, 50000 * 30, 100, 10); \
+  test_bipartite_coloring_d2<SCALAR,ORDINAL,OFFSET,DEVICE>(20000, 5000, 20000 * 10, 200, 5); \
 }
 
 #if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
@@ -0,0 +1,160 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "KokkosGraph_KCore.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_kcore(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance, lno_t clique_size) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type lno_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_nnz_view_t;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  //the first clique_size vertices also form a clique, the densest core.
+  lno_view_t in_xadj("xadj", numRows + 1);
+  lno_nnz_view_t in_adj;
+  {
+    typename graph_t::row_map_type::HostMirror h_xadj = Kokkos::create_mirror_view(input_mat.graph.row_map);
+    typename graph_t::entries_type::HostMirror h_adj = Kokkos::create_mirror_view(input_mat.graph.entries);
+    Kokkos::deep_copy(h_xadj, input_mat.graph.row_map);
+    Kokkos::deep_copy(h_adj, input_mat.graph.entries);
+    std::vector<lno_t> new_adj;
+    typename lno_view_t::HostMirror h_new_xadj = Kokkos::create_mirror_view(in_xadj);
+    h_new_xadj(0) = 0;
+    for (lno_t i = 0; i < numRows; ++i){
+      for (size_type e = h_xadj(i); e < h_xadj(i + 1); ++e) new_adj.push_back(h_adj(e));
+      if (i < clique_size){
+        for (lno_t v = 0; v < clique_size; ++v) new_adj.push_back(v);
+      }
+      h_new_xadj(i + 1) = new_adj.size();
+    }
+    in_adj = lno_nnz_view_t("adj", new_adj.size());
+    typename lno_nnz_view_t::HostMirror h_new_adj = Kokkos::create_mirror_view(in_adj);
+    for (size_t e = 0; e < new_adj.size(); ++e) h_new_adj(e) = new_adj[e];
+    Kokkos::deep_copy(in_xadj, h_new_xadj);
+    Kokkos::deep_copy(in_adj, h_new_adj);
+  }
+
+  lno_view_t sym_xadj;
+  lno_nnz_view_t sym_adj;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<lno_view_t, lno_nnz_view_t,
+      lno_view_t, lno_nnz_view_t, device>
+    (numRows, in_xadj, in_adj, sym_xadj, sym_adj);
+
+  lno_nnz_view_t coreness("coreness", numRows);
+  const lno_t degeneracy = KokkosGraph::Experimental::kcore(numRows, sym_xadj, sym_adj, coreness);
+
+  typename lno_view_t::HostMirror hrm = Kokkos::create_mirror_view(sym_xadj);
+  typename lno_nnz_view_t::HostMirror hentries = Kokkos::create_mirror_view(sym_adj);
+  typename lno_nnz_view_t::HostMirror h_core = Kokkos::create_mirror_view(coreness);
+  Kokkos::deep_copy(hrm, sym_xadj);
+  Kokkos::deep_copy(hentries, sym_adj);
+  Kokkos::deep_copy(h_core, coreness);
+
+  //serial peeling: repeatedly remove a vertex of smallest remaining degree.
+  std::vector<lno_t> degree(numRows, 0), core(numRows, -1);
+  std::set<std::pair<lno_t, lno_t> > queue;
+  for (lno_t i = 0; i < numRows; ++i){
+    for (size_type e = hrm(i); e < hrm(i + 1); ++e) if (hentries(e) != i) ++degree[i];
+    queue.insert(std::make_pair(degree[i], i));
+  }
+  lno_t k = 0;
+  while (!queue.empty()){
+    const lno_t i = queue.begin()->second;
+    if (queue.begin()->first > k) k = queue.begin()->first;
+    queue.erase(queue.begin());
+    core[i] = k;
+    for (size_type e = hrm(i); e < hrm(i + 1); ++e){
+      const lno_t j = hentries(e);
+      if (j == i || core[j] >= 0) continue;
+      queue.erase(std::make_pair(degree[j], j));
+      queue.insert(std::make_pair(--degree[j], j));
+    }
+  }
+
+  lno_t num_errors = 0;
+  for (lno_t i = 0; i < numRows; ++i){
+    if (h_core(i) != core[i]) ++num_errors;
+  }
+  EXPECT_TRUE(num_errors == 0);
+  EXPECT_EQ(degeneracy, k);
+  if (clique_size > 0) EXPECT_GE(degeneracy, clique_size - 1);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, graph ## _ ## kcore ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_kcore<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 5, 200, 10, 0); \
+  test_kcore<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 20, 30, 10, 40); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
@@ -0,0 +1,174 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <vector>
+
+#include "KokkosGraph_MIS.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_mis(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  using namespace KokkosGraph::Experimental;
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type lno_view_t;
+  typedef typename graph_t::entries_type lno_nnz_view_t;
+  typedef Kokkos::View<lno_t *, device> lno_work_view_t;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  typename lno_view_t::non_const_type sym_xadj;
+  typename lno_nnz_view_t::non_const_type sym_adj;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<lno_view_t, lno_nnz_view_t,
+      typename lno_view_t::non_const_type, typename lno_nnz_view_t::non_const_type, device>
+    (numRows, input_mat.graph.row_map, input_mat.graph.entries, sym_xadj, sym_adj);
+
+  typename lno_view_t::non_const_type::HostMirror hrm = Kokkos::create_mirror_view(sym_xadj);
+  typename lno_nnz_view_t::non_const_type::HostMirror hentries = Kokkos::create_mirror_view(sym_adj);
+  Kokkos::deep_copy(hrm, sym_xadj);
+  Kokkos::deep_copy(hentries, sym_adj);
+
+  for (int distance = 1; distance <= 2; ++distance){
+    auto set = distance == 1 ? graph_mis(numRows, sym_xadj, sym_adj) : graph_mis2(numRows, sym_xadj, sym_adj);
+    auto h_set = Kokkos::create_mirror_view(set);
+    Kokkos::deep_copy(h_set, set);
+
+    //dist[v] is the distance to the closest set vertex, if at most distance.
+    std::vector<int> in_set(numRows, 0), dist(numRows, distance + 1);
+    lno_t num_errors = 0;
+    for (size_t i = 0; i < set.extent(0); ++i){
+      if (i > 0 && h_set(i) <= h_set(i - 1)) ++num_errors;
+      in_set[h_set(i)] = 1;
+      dist[h_set(i)] = 0;
+    }
+    for (lno_t v = 0; v < numRows; ++v){
+      if (!in_set[v]) continue;
+      for (size_type e = hrm(v); e < hrm(v + 1); ++e){
+        const lno_t n = hentries(e);
+        if (n == v) continue;
+        if (in_set[n]) ++num_errors;
+        if (dist[n] > 1) dist[n] = 1;
+        if (distance == 2){
+          for (size_type f = hrm(n); f < hrm(n + 1); ++f){
+            const lno_t k = hentries(f);
+            if (k == v) continue;
+            if (in_set[k]) ++num_errors;
+            if (dist[k] > 2) dist[k] = 2;
+          }
+        }
+      }
+    }
+    //maximal: every vertex is within distance of the set.
+    for (lno_t v = 0; v < numRows; ++v){
+      if (dist[v] > distance) ++num_errors;
+    }
+    EXPECT_TRUE(num_errors == 0) << "distance " << distance;
+  }
+
+  lno_work_view_t aggregates("aggregates", numRows);
+  lno_t num_aggregates = graph_mis2_aggregate(numRows, sym_xadj, sym_adj, aggregates);
+  auto roots = graph_mis2(numRows, sym_xadj, sym_adj);
+  EXPECT_EQ(size_t(num_aggregates), roots.extent(0));
+  auto h_aggregates = Kokkos::create_mirror_view(aggregates);
+  auto h_roots = Kokkos::create_mirror_view(roots);
+  Kokkos::deep_copy(h_aggregates, aggregates);
+  Kokkos::deep_copy(h_roots, roots);
+
+  //every vertex is within two edges of its root, through a vertex of its aggregate.
+  lno_t num_errors = 0;
+  for (lno_t a = 0; a < num_aggregates; ++a){
+    if (h_aggregates(h_roots(a)) != a) ++num_errors;
+  }
+  for (lno_t v = 0; v < numRows; ++v){
+    const lno_t a = h_aggregates(v);
+    if (a < 0 || a >= num_aggregates){
+      ++num_errors;
+      continue;
+    }
+    const lno_t r = h_roots(a);
+    bool found = v == r;
+    for (size_type e = hrm(v); e < hrm(v + 1) && !found; ++e){
+      const lno_t n = hentries(e);
+      if (h_aggregates(n) != a) continue;
+      if (n == r) found = true;
+      for (size_type f = hrm(n); f < hrm(n + 1) && !found; ++f){
+        if (hentries(f) == r) found = true;
+      }
+    }
+    if (!found) ++num_errors;
+  }
+  EXPECT_TRUE(num_errors == 0);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, graph ## _ ## mis ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_mis<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 10, 200, 5); \
+  test_mis<SCALAR,ORDINAL,OFFSET,DEVICE>(2000, 2000 * 3, 2000, 2); \
+  test_mis<SCALAR,ORDINAL,OFFSET,DEVICE>(500, 500 * 30, 500, 10); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
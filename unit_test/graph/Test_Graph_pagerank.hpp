@@ -0,0 +1,130 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "KokkosGraph_PageRank.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_pagerank(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  using namespace KokkosGraph::Experimental;
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef Kokkos::View<scalar_t *, device> scalar_view_t;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  auto hrm = Kokkos::create_mirror_view(input_mat.graph.row_map);
+  auto hentries = Kokkos::create_mirror_view(input_mat.graph.entries);
+  Kokkos::deep_copy(hrm, input_mat.graph.row_map);
+  Kokkos::deep_copy(hentries, input_mat.graph.entries);
+
+  //reference power iteration on the host.
+  const scalar_t damping = 0.85;
+  const scalar_t n = scalar_t(numRows);
+  std::vector<scalar_t> x(numRows, 1 / n), y(numRows);
+  for (int iteration = 0; iteration < 200; ++iteration){
+    scalar_t dangling = 0;
+    for (lno_t v = 0; v < numRows; ++v){
+      if (hrm(v + 1) == hrm(v)) dangling += x[v];
+    }
+    for (lno_t v = 0; v < numRows; ++v) y[v] = (1 - damping) / n + damping * dangling / n;
+    for (lno_t u = 0; u < numRows; ++u){
+      for (size_type e = hrm(u); e < hrm(u + 1); ++e){
+        y[hentries(e)] += damping * x[u] / scalar_t(hrm(u + 1) - hrm(u));
+      }
+    }
+    x.swap(y);
+  }
+
+  for (int worklist = 0; worklist < 2; ++worklist){
+    scalar_view_t ranks("ranks", numRows);
+    int iterations = worklist ?
+        pagerank_worklist(numRows, input_mat.graph.row_map, input_mat.graph.entries, ranks, damping, scalar_t(1e-12)) :
+        pagerank(numRows, input_mat.graph.row_map, input_mat.graph.entries, ranks, damping, scalar_t(1e-12));
+    EXPECT_GT(iterations, 0);
+    auto h_ranks = Kokkos::create_mirror_view(ranks);
+    Kokkos::deep_copy(h_ranks, ranks);
+
+    scalar_t sum = 0;
+    lno_t num_errors = 0;
+    for (lno_t v = 0; v < numRows; ++v){
+      sum += h_ranks(v);
+      if (std::abs(h_ranks(v) - x[v]) > 1e-6 * x[v]) ++num_errors;
+    }
+    EXPECT_TRUE(num_errors == 0) << "worklist " << worklist;
+    EXPECT_NEAR(sum, 1.0, 1e-6) << "worklist " << worklist;
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, graph ## _ ## pagerank ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_pagerank<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 10, 200, 5); \
+  test_pagerank<SCALAR,ORDINAL,OFFSET,DEVICE>(2000, 2000 * 3, 2000, 2); \
+  test_pagerank<SCALAR,ORDINAL,OFFSET,DEVICE>(500, 500 * 30, 500, 10); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
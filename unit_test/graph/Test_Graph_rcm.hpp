@@ -0,0 +1,247 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "KokkosGraph_RCM.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_permute.hpp"
+#include "KokkosSparse_spmv.hpp"
+
+namespace Test {
+
+// 5-point Laplacian of a nx x ny grid with randomly renumbered vertices,
+// followed by num_isolated vertices that only have a diagonal.
+template <typename crsMat_t>
+crsMat_t shuffled_grid_laplacian(
+    typename crsMat_t::ordinal_type nx,
+    typename crsMat_t::ordinal_type ny,
+    typename crsMat_t::ordinal_type num_isolated){
+  typedef typename crsMat_t::ordinal_type lno_t;
+  typedef typename crsMat_t::size_type size_type;
+  typedef typename crsMat_t::value_type scalar_t;
+  typedef typename crsMat_t::row_map_type::non_const_type row_map_t;
+  typedef typename crsMat_t::index_type::non_const_type entries_t;
+  typedef typename crsMat_t::values_type::non_const_type values_t;
+
+  const lno_t num_grid = nx * ny;
+  const lno_t n = num_grid + num_isolated;
+  std::vector<lno_t> label(n);
+  for (lno_t i = 0; i < n; ++i) label[i] = i;
+  std::mt19937 gen(13);
+  std::shuffle(label.begin(), label.end(), gen);
+
+  std::vector<std::vector<lno_t> > adj(n);
+  for (lno_t y = 0; y < ny; ++y){
+    for (lno_t x = 0; x < nx; ++x){
+      const lno_t v = label[x + nx * y];
+      adj[v].push_back(v);
+      if (x > 0) adj[v].push_back(label[x - 1 + nx * y]);
+      if (x < nx - 1) adj[v].push_back(label[x + 1 + nx * y]);
+      if (y > 0) adj[v].push_back(label[x + nx * (y - 1)]);
+      if (y < ny - 1) adj[v].push_back(label[x + nx * (y + 1)]);
+    }
+  }
+  for (lno_t i = num_grid; i < n; ++i) adj[label[i]].push_back(label[i]);
+
+  size_type nnz = 0;
+  for (lno_t i = 0; i < n; ++i) nnz += adj[i].size();
+  row_map_t row_map("row_map", n + 1);
+  entries_t entries("entries", nnz);
+  values_t values("values", nnz);
+  typename row_map_t::HostMirror h_row_map = Kokkos::create_mirror_view(row_map);
+  typename entries_t::HostMirror h_entries = Kokkos::create_mirror_view(entries);
+  typename values_t::HostMirror h_values = Kokkos::create_mirror_view(values);
+  size_type k = 0;
+  for (lno_t i = 0; i < n; ++i){
+    h_row_map(i) = k;
+    for (size_t j = 0; j < adj[i].size(); ++j, ++k){
+      h_entries(k) = adj[i][j];
+      h_values(k) = adj[i][j] == i ? scalar_t(4 + i % 3) : scalar_t(-1);
+    }
+  }
+  h_row_map(n) = k;
+  Kokkos::deep_copy(row_map, h_row_map);
+  Kokkos::deep_copy(entries, h_entries);
+  Kokkos::deep_copy(values, h_values);
+  return crsMat_t("shuffled grid", n, n, nnz, values, row_map, entries);
+}
+
+template <typename crsMat_t>
+typename crsMat_t::ordinal_type matrix_bandwidth(const crsMat_t &A){
+  typedef typename crsMat_t::ordinal_type lno_t;
+  typedef typename crsMat_t::size_type size_type;
+  typename crsMat_t::row_map_type::HostMirror h_row_map = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror h_entries = Kokkos::create_mirror_view(A.graph.entries);
+  Kokkos::deep_copy(h_row_map, A.graph.row_map);
+  Kokkos::deep_copy(h_entries, A.graph.entries);
+  lno_t bandwidth = 0;
+  for (lno_t i = 0; i < A.numRows(); ++i){
+    for (size_type j = h_row_map(i); j < h_row_map(i + 1); ++j){
+      const lno_t d = h_entries(j) > i ? h_entries(j) - i : i - h_entries(j);
+      if (d > bandwidth) bandwidth = d;
+    }
+  }
+  return bandwidth;
+}
+
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_rcm(lno_t nx, lno_t ny, lno_t num_isolated) {
+  using namespace Test;
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+
+  crsMat_t A = shuffled_grid_laplacian<crsMat_t>(nx, ny, num_isolated);
+  const lno_t n = A.numRows();
+
+  auto old_to_new = KokkosGraph::Experimental::graph_rcm(n, A.graph.row_map, A.graph.entries);
+  ASSERT_EQ(old_to_new.extent(0), size_t(n));
+
+  {
+    auto h_old_to_new = Kokkos::create_mirror_view(old_to_new);
+    Kokkos::deep_copy(h_old_to_new, old_to_new);
+    std::vector<int> seen(n, 0);
+    lno_t num_bad = 0;
+    for (lno_t i = 0; i < n; ++i){
+      if (h_old_to_new(i) < 0 || h_old_to_new(i) >= n || seen[h_old_to_new(i)]++) ++num_bad;
+    }
+    EXPECT_TRUE(num_bad == 0);
+  }
+
+  crsMat_t B = KokkosSparse::Experimental::permute_crs_matrix(A, old_to_new);
+  EXPECT_TRUE(B.nnz() == A.nnz());
+  //a BFS order of the grid has levels of at most min(nx, ny) vertices.
+  const lno_t bound = 2 * (std::min(nx, ny) + 1);
+  EXPECT_LE(matrix_bandwidth(B), bound);
+
+  //B P x must be P A x.
+  scalar_view_t x("x", n), px("px", n), y("y", n), py("py", n), pyb("pyb", n), xb("xb", n);
+  Kokkos::Random_XorShift64_Pool<typename device::execution_space> rand_pool(13718);
+  Kokkos::fill_random(x, rand_pool, scalar_t(10));
+  KokkosSparse::spmv("N", scalar_t(1), A, x, scalar_t(0), y);
+  KokkosSparse::Experimental::permute_vector(old_to_new, x, px);
+  KokkosSparse::Experimental::permute_vector(old_to_new, y, py);
+  KokkosSparse::spmv("N", scalar_t(1), B, px, scalar_t(0), pyb);
+  KokkosSparse::Experimental::inverse_permute_vector(old_to_new, px, xb);
+
+  auto h_py = Kokkos::create_mirror_view(py);
+  auto h_pyb = Kokkos::create_mirror_view(pyb);
+  auto h_x = Kokkos::create_mirror_view(x);
+  auto h_xb = Kokkos::create_mirror_view(xb);
+  Kokkos::deep_copy(h_py, py);
+  Kokkos::deep_copy(h_pyb, pyb);
+  Kokkos::deep_copy(h_x, x);
+  Kokkos::deep_copy(h_xb, xb);
+  lno_t num_errors = 0;
+  for (lno_t i = 0; i < n; ++i){
+    if (std::abs(h_py(i) - h_pyb(i)) > 1e-10 * (1 + std::abs(h_py(i)))) ++num_errors;
+    if (h_x(i) != h_xb(i)) ++num_errors;
+  }
+  EXPECT_TRUE(num_errors == 0);
+
+  //the row cluster order is the inverse of the permutation, and the spmv
+  //with its worksets gives the same y.
+  auto row_order = KokkosGraph::Experimental::graph_row_cluster_order(n, A.graph.row_map, A.graph.entries);
+  ASSERT_EQ(row_order.extent(0), size_t(n));
+  auto h_old_to_new = Kokkos::create_mirror_view(old_to_new);
+  auto h_row_order = Kokkos::create_mirror_view(row_order);
+  Kokkos::deep_copy(h_old_to_new, old_to_new);
+  Kokkos::deep_copy(h_row_order, row_order);
+  for (lno_t i = 0; i < n; ++i){
+    if (h_row_order(h_old_to_new(i)) != i) ++num_errors;
+  }
+  EXPECT_TRUE(num_errors == 0);
+
+  typedef KokkosSparse::SPMVHandle<lno_t, size_type, typename device::execution_space> spmv_handle_t;
+  spmv_handle_t handle;
+  typename spmv_handle_t::nnz_lno_view_t handle_order("row order", n);
+  Kokkos::deep_copy(handle_order, row_order);
+  handle.set_row_order(handle_order);
+  scalar_view_t yo("yo", n);
+  KokkosSparse::spmv(handle, "N", scalar_t(1), A, x, scalar_t(0), yo);
+  auto h_y = Kokkos::create_mirror_view(y);
+  auto h_yo = Kokkos::create_mirror_view(yo);
+  Kokkos::deep_copy(h_y, y);
+  Kokkos::deep_copy(h_yo, yo);
+  for (lno_t i = 0; i < n; ++i){
+    if (std::abs(h_y(i) - h_yo(i)) > 1e-10 * (1 + std::abs(h_y(i)))) ++num_errors;
+  }
+  EXPECT_TRUE(num_errors == 0);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, graph ## _ ## rcm ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_rcm<SCALAR,ORDINAL,OFFSET,DEVICE>(40, 25, 0); \
+  test_rcm<SCALAR,ORDINAL,OFFSET,DEVICE>(100, 10, 7); \
+  test_rcm<SCALAR,ORDINAL,OFFSET,DEVICE>(1, 50, 1); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
@@ -0,0 +1,536 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "KokkosGraph_Triangle.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosKernels_BitUtils.hpp"
+
+namespace Test {
+//counts the triangles given to the visitor of triangle_generic, with the
+//column sets compressed into bits.
+template <typename count_view_t, typename lno_t>
+struct TriangleCountVisitor{
+  count_view_t count;
+  TriangleCountVisitor(count_view_t count_): count(count_){}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t &row, const lno_t &col_set_index, const lno_t &col_set, const lno_t &thread_id) const {
+    Kokkos::atomic_fetch_add(&count(0), typename count_view_t::non_const_value_type(KokkosKernels::Impl::pop_count(col_set)));
+  }
+};
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_triangle_count(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance, lno_t hub_stride = 0) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type lno_view_t;
+  typedef typename graph_t::entries_type lno_nnz_view_t;
+  typedef Kokkos::View<size_type *, device> count_view_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+  typename lno_view_t::non_const_type in_xadj_dev("xadj", numRows + 1);
+  typename lno_nnz_view_t::non_const_type in_adj_dev;
+
+  //the first four vertices become hubs, adjacent to every hub_stride-th vertex.
+  {
+    typename lno_view_t::HostMirror h_xadj = Kokkos::create_mirror_view(input_mat.graph.row_map);
+    typename lno_nnz_view_t::HostMirror h_adj = Kokkos::create_mirror_view(input_mat.graph.entries);
+    Kokkos::deep_copy(h_xadj, input_mat.graph.row_map);
+    Kokkos::deep_copy(h_adj, input_mat.graph.entries);
+    std::vector<lno_t> new_adj;
+    typename lno_view_t::non_const_type::HostMirror h_new_xadj = Kokkos::create_mirror_view(in_xadj_dev);
+    h_new_xadj(0) = 0;
+    for (lno_t i = 0; i < numRows; ++i){
+      for (size_type e = h_xadj(i); e < h_xadj(i + 1); ++e) new_adj.push_back(h_adj(e));
+      if (hub_stride > 0 && i < 4){
+        for (lno_t v = 0; v < numRows; v += hub_stride) new_adj.push_back(v);
+      }
+      h_new_xadj(i + 1) = new_adj.size();
+    }
+    in_adj_dev = typename lno_nnz_view_t::non_const_type("adj", new_adj.size());
+    typename lno_nnz_view_t::non_const_type::HostMirror h_new_adj = Kokkos::create_mirror_view(in_adj_dev);
+    for (size_t e = 0; e < new_adj.size(); ++e) h_new_adj(e) = new_adj[e];
+    Kokkos::deep_copy(in_xadj_dev, h_new_xadj);
+    Kokkos::deep_copy(in_adj_dev, h_new_adj);
+  }
+
+  typename lno_view_t::non_const_type sym_xadj;
+  typename lno_nnz_view_t::non_const_type sym_adj;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<lno_view_t, lno_nnz_view_t,
+      typename lno_view_t::non_const_type, typename lno_nnz_view_t::non_const_type, device>
+    (numRows, in_xadj_dev, in_adj_dev, sym_xadj, sym_adj);
+
+  //the second pass has too little shared memory for the bitmap of the hubs.
+  for (int pass = 0; pass < 2; ++pass){
+    KernelHandle kh;
+    if (pass == 1) kh.set_shmem_size(64);
+    count_view_t edge_triangles("edge triangles", sym_adj.extent(0));
+    count_view_t vertex_triangles("vertex triangles", numRows);
+    KokkosGraph::Experimental::triangle_count_per_edge(&kh, numRows, sym_xadj, sym_adj, edge_triangles);
+    KokkosGraph::Experimental::triangle_count_per_vertex(&kh, numRows, sym_xadj, sym_adj, vertex_triangles);
+
+    typename lno_view_t::non_const_type::HostMirror hrm = Kokkos::create_mirror_view(sym_xadj);
+    typename lno_nnz_view_t::non_const_type::HostMirror hentries = Kokkos::create_mirror_view(sym_adj);
+    typename count_view_t::HostMirror h_edge = Kokkos::create_mirror_view(edge_triangles);
+    typename count_view_t::HostMirror h_vertex = Kokkos::create_mirror_view(vertex_triangles);
+    Kokkos::deep_copy(hrm, sym_xadj);
+    Kokkos::deep_copy(hentries, sym_adj);
+    Kokkos::deep_copy(h_edge, edge_triangles);
+    Kokkos::deep_copy(h_vertex, vertex_triangles);
+
+    //brute force: mark the neighbors of i, count the marked neighbors of each neighbor j.
+    std::vector<lno_t> mark(numRows, -1);
+    lno_t num_edge_errors = 0, num_vertex_errors = 0;
+    for (lno_t i = 0; i < numRows; ++i){
+      for (size_type e = hrm(i); e < hrm(i + 1); ++e) mark[hentries(e)] = i;
+      size_type total = 0;
+      for (size_type e = hrm(i); e < hrm(i + 1); ++e){
+        const lno_t j = hentries(e);
+        size_type support = 0;
+        if (j != i){
+          for (size_type f = hrm(j); f < hrm(j + 1); ++f){
+            const lno_t k = hentries(f);
+            if (k != i && k != j && mark[k] == i) ++support;
+          }
+        }
+        if (h_edge(e) != support) ++num_edge_errors;
+        total += support;
+      }
+      if (h_vertex(i) != total / 2) ++num_vertex_errors;
+    }
+    EXPECT_TRUE(num_edge_errors == 0);
+    EXPECT_TRUE(num_vertex_errors == 0);
+  }
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_triangle_count_relabel(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance, lno_t hub_stride) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type lno_view_t;
+  typedef typename graph_t::entries_type lno_nnz_view_t;
+  typedef Kokkos::View<size_t *, device> count_view_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+  typename lno_view_t::non_const_type in_xadj_dev("xadj", numRows + 1);
+  typename lno_nnz_view_t::non_const_type in_adj_dev;
+
+  //the last four vertices become hubs, adjacent to every hub_stride-th vertex,
+  //so the largest degrees are at the end of the natural order.
+  {
+    typename lno_view_t::HostMirror h_xadj = Kokkos::create_mirror_view(input_mat.graph.row_map);
+    typename lno_nnz_view_t::HostMirror h_adj = Kokkos::create_mirror_view(input_mat.graph.entries);
+    Kokkos::deep_copy(h_xadj, input_mat.graph.row_map);
+    Kokkos::deep_copy(h_adj, input_mat.graph.entries);
+    std::vector<lno_t> new_adj;
+    typename lno_view_t::non_const_type::HostMirror h_new_xadj = Kokkos::create_mirror_view(in_xadj_dev);
+    h_new_xadj(0) = 0;
+    for (lno_t i = 0; i < numRows; ++i){
+      for (size_type e = h_xadj(i); e < h_xadj(i + 1); ++e) new_adj.push_back(h_adj(e));
+      if (i >= numRows - 4){
+        for (lno_t v = 0; v < numRows; v += hub_stride) new_adj.push_back(v);
+      }
+      h_new_xadj(i + 1) = new_adj.size();
+    }
+    in_adj_dev = typename lno_nnz_view_t::non_const_type("adj", new_adj.size());
+    typename lno_nnz_view_t::non_const_type::HostMirror h_new_adj = Kokkos::create_mirror_view(in_adj_dev);
+    for (size_t e = 0; e < new_adj.size(); ++e) h_new_adj(e) = new_adj[e];
+    Kokkos::deep_copy(in_xadj_dev, h_new_xadj);
+    Kokkos::deep_copy(in_adj_dev, h_new_adj);
+  }
+
+  typename lno_view_t::non_const_type sym_xadj;
+  typename lno_nnz_view_t::non_const_type sym_adj;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<lno_view_t, lno_nnz_view_t,
+      typename lno_view_t::non_const_type, typename lno_nnz_view_t::non_const_type, device>
+    (numRows, in_xadj_dev, in_adj_dev, sym_xadj, sym_adj);
+
+  //reference: each triangle is counted once at each of its vertices.
+  size_t expected = 0;
+  {
+    KernelHandle kh;
+    Kokkos::View<size_type *, device> vertex_triangles("vertex triangles", numRows);
+    KokkosGraph::Experimental::triangle_count_per_vertex(&kh, numRows, sym_xadj, sym_adj, vertex_triangles);
+    typename Kokkos::View<size_type *, device>::HostMirror h_vertex = Kokkos::create_mirror_view(vertex_triangles);
+    Kokkos::deep_copy(h_vertex, vertex_triangles);
+    for (lno_t i = 0; i < numRows; ++i) expected += h_vertex(i);
+    expected /= 3;
+  }
+  EXPECT_GT(expected, size_t(0));
+
+  size_t totals[2];
+  for (int relabel = 0; relabel < 2; ++relabel){
+    KernelHandle kh;
+    kh.create_spgemm_handle(KokkosSparse::SPGEMM_KK_TRIANGLE_LL);
+    kh.get_spgemm_handle()->set_compression(true);
+    kh.get_spgemm_handle()->set_relabel_by_degree(relabel == 1);
+    count_view_t count("triangle count", 1);
+    KokkosGraph::Experimental::triangle_generic(&kh, numRows, sym_xadj, sym_adj,
+        Test::TriangleCountVisitor<count_view_t, lno_t>(count));
+    typename count_view_t::HostMirror h_count = Kokkos::create_mirror_view(count);
+    Kokkos::deep_copy(h_count, count);
+    totals[relabel] = h_count(0);
+
+    if (relabel == 1){
+      //the permutation kept in the handle must be a permutation of the vertices.
+      typename KernelHandle::nnz_lno_persistent_work_view_t old_to_new =
+          kh.get_spgemm_handle()->get_degree_relabel_permutation();
+      EXPECT_EQ(old_to_new.extent(0), size_t(numRows));
+      typename KernelHandle::nnz_lno_persistent_work_view_t::HostMirror h_old_to_new = Kokkos::create_mirror_view(old_to_new);
+      Kokkos::deep_copy(h_old_to_new, old_to_new);
+      std::vector<int> seen(numRows, 0);
+      lno_t num_errors = 0;
+      for (lno_t i = 0; i < numRows; ++i){
+        if (h_old_to_new(i) < 0 || h_old_to_new(i) >= numRows || seen[h_old_to_new(i)]++) ++num_errors;
+      }
+      EXPECT_TRUE(num_errors == 0);
+    }
+    kh.destroy_spgemm_handle();
+  }
+  EXPECT_EQ(totals[0], expected);
+  EXPECT_EQ(totals[1], totals[0]);
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_ktruss(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance, int k) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type lno_view_t;
+  typedef typename graph_t::entries_type lno_nnz_view_t;
+  typedef Kokkos::View<int *, device> flag_view_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  typename lno_view_t::non_const_type sym_xadj;
+  typename lno_nnz_view_t::non_const_type sym_adj;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<lno_view_t, lno_nnz_view_t,
+      typename lno_view_t::non_const_type, typename lno_nnz_view_t::non_const_type, device>
+    (numRows, input_mat.graph.row_map, input_mat.graph.entries, sym_xadj, sym_adj);
+
+  KernelHandle kh;
+  flag_view_t in_truss("in truss", sym_adj.extent(0));
+  KokkosGraph::Experimental::ktruss(&kh, numRows, sym_xadj, sym_adj, k, in_truss);
+
+  typename lno_view_t::non_const_type::HostMirror hrm = Kokkos::create_mirror_view(sym_xadj);
+  typename lno_nnz_view_t::non_const_type::HostMirror hentries = Kokkos::create_mirror_view(sym_adj);
+  typename flag_view_t::HostMirror h_in_truss = Kokkos::create_mirror_view(in_truss);
+  Kokkos::deep_copy(hrm, sym_xadj);
+  Kokkos::deep_copy(hentries, sym_adj);
+  Kokkos::deep_copy(h_in_truss, in_truss);
+
+  //reference: recount the supports of the alive edges until none is removed.
+  const size_type ne = hentries.extent(0);
+  std::vector<int> alive(ne);
+  for (lno_t i = 0; i < numRows; ++i){
+    for (size_type e = hrm(i); e < hrm(i + 1); ++e) alive[e] = hentries(e) != i;
+  }
+  std::vector<lno_t> mark(numRows, -1);
+  bool changed = true;
+  while (changed){
+    changed = false;
+    std::vector<int> next(alive);
+    for (lno_t i = 0; i < numRows; ++i){
+      for (size_type e = hrm(i); e < hrm(i + 1); ++e) if (alive[e]) mark[hentries(e)] = i;
+      for (size_type e = hrm(i); e < hrm(i + 1); ++e){
+        if (!alive[e]) continue;
+        const lno_t j = hentries(e);
+        int support = 0;
+        for (size_type f = hrm(j); f < hrm(j + 1); ++f){
+          if (alive[f] && hentries(f) != i && mark[hentries(f)] == i) ++support;
+        }
+        if (support < k - 2){
+          next[e] = 0;
+          changed = true;
+        }
+      }
+      for (size_type e = hrm(i); e < hrm(i + 1); ++e) mark[hentries(e)] = -1;
+    }
+    alive.swap(next);
+  }
+
+  lno_t num_errors = 0;
+  for (size_type e = 0; e < ne; ++e){
+    if (h_in_truss(e) != alive[e]) ++num_errors;
+  }
+  EXPECT_TRUE(num_errors == 0);
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_triangle_enumerate_streaming(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance, size_t buffer_size) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type lno_view_t;
+  typedef typename graph_t::entries_type lno_nnz_view_t;
+  typedef Kokkos::View<size_type *, device> count_view_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  typename lno_view_t::non_const_type sym_xadj;
+  typename lno_nnz_view_t::non_const_type sym_adj;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<lno_view_t, lno_nnz_view_t,
+      typename lno_view_t::non_const_type, typename lno_nnz_view_t::non_const_type, device>
+    (numRows, input_mat.graph.row_map, input_mat.graph.entries, sym_xadj, sym_adj);
+
+  KernelHandle kh;
+  count_view_t vertex_triangles("vertex triangles", numRows);
+  KokkosGraph::Experimental::triangle_count_per_vertex(&kh, numRows, sym_xadj, sym_adj, vertex_triangles);
+  typename count_view_t::HostMirror h_vertex = Kokkos::create_mirror_view(vertex_triangles);
+  Kokkos::deep_copy(h_vertex, vertex_triangles);
+
+  typename lno_view_t::non_const_type::HostMirror hrm = Kokkos::create_mirror_view(sym_xadj);
+  typename lno_nnz_view_t::non_const_type::HostMirror hentries = Kokkos::create_mirror_view(sym_adj);
+  Kokkos::deep_copy(hrm, sym_xadj);
+  Kokkos::deep_copy(hentries, sym_adj);
+  std::set<std::pair<lno_t, lno_t> > edges;
+  for (lno_t i = 0; i < numRows; ++i){
+    for (size_type e = hrm(i); e < hrm(i + 1); ++e) edges.insert(std::make_pair(i, lno_t(hentries(e))));
+  }
+
+  //each streamed triangle must be a triangle of the graph, seen once, and count once per vertex.
+  std::set<std::vector<lno_t> > seen;
+  std::vector<size_type> counts(numRows, 0);
+  lno_t num_errors = 0;
+  size_t num_flushes = 0;
+  size_t total = KokkosGraph::Experimental::triangle_enumerate_streaming(&kh, numRows, sym_xadj, sym_adj, buffer_size,
+      [&] (const Kokkos::View<lno_t *[3], Kokkos::LayoutRight, Kokkos::HostSpace> &triangles, size_t num_triangles){
+    ++num_flushes;
+    for (size_t t = 0; t < num_triangles; ++t){
+      std::vector<lno_t> tri(3);
+      for (int c = 0; c < 3; ++c) tri[c] = triangles(t, c);
+      if (!edges.count(std::make_pair(tri[0], tri[1])) || !edges.count(std::make_pair(tri[1], tri[2])) ||
+          !edges.count(std::make_pair(tri[0], tri[2]))) ++num_errors;
+      for (int c = 0; c < 3; ++c) ++counts[tri[c]];
+      std::sort(tri.begin(), tri.end());
+      if (!seen.insert(tri).second) ++num_errors;
+    }
+  });
+  EXPECT_TRUE(num_errors == 0);
+  EXPECT_EQ(total, seen.size());
+  for (lno_t i = 0; i < numRows; ++i){
+    if (counts[i] != h_vertex(i)) ++num_errors;
+  }
+  EXPECT_TRUE(num_errors == 0);
+  if (total > 4 * buffer_size) EXPECT_GT(num_flushes, size_t(1));
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_triangle_count_sampling(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type lno_view_t;
+  typedef typename graph_t::entries_type lno_nnz_view_t;
+  typedef Kokkos::View<size_type *, device> count_view_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  typename lno_view_t::non_const_type sym_xadj;
+  typename lno_nnz_view_t::non_const_type sym_adj;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<lno_view_t, lno_nnz_view_t,
+      typename lno_view_t::non_const_type, typename lno_nnz_view_t::non_const_type, device>
+    (numRows, input_mat.graph.row_map, input_mat.graph.entries, sym_xadj, sym_adj);
+
+  KernelHandle kh;
+  count_view_t vertex_triangles("vertex triangles", numRows);
+  KokkosGraph::Experimental::triangle_count_per_vertex(&kh, numRows, sym_xadj, sym_adj, vertex_triangles);
+  typename count_view_t::HostMirror h_vertex = Kokkos::create_mirror_view(vertex_triangles);
+  Kokkos::deep_copy(h_vertex, vertex_triangles);
+  size_t total = 0;
+  for (lno_t i = 0; i < numRows; ++i) total += h_vertex(i);
+  const double exact = double(total / 3);
+
+  KokkosGraph::Experimental::TriangleCountEstimate wedge =
+      KokkosGraph::Experimental::triangle_count_wedge_sampling(&kh, numRows, sym_xadj, sym_adj, 100000, 1);
+  EXPECT_EQ(wedge.num_samples, size_t(100000));
+  EXPECT_GT(wedge.std_error, 0.0);
+  EXPECT_LE(std::abs(wedge.count - exact), 5 * wedge.std_error);
+  EXPECT_LE(wedge.lower, wedge.count);
+  EXPECT_GE(wedge.upper, wedge.count);
+
+  //a budget of every trial on the whole graph keeps one color, and the count is exact.
+  const size_t ne = sym_adj.extent(0);
+  KokkosGraph::Experimental::TriangleCountEstimate full =
+      KokkosGraph::Experimental::triangle_count_colorful(&kh, numRows, sym_xadj, sym_adj, 4 * ne, 4, 1);
+  EXPECT_EQ(full.count, exact);
+  EXPECT_EQ(full.std_error, 0.0);
+
+  //four colors keep about a quarter of the entries in each trial.
+  KokkosGraph::Experimental::TriangleCountEstimate colorful =
+      KokkosGraph::Experimental::triangle_count_colorful(&kh, numRows, sym_xadj, sym_adj, ne, 4, 1);
+  EXPECT_LE(colorful.num_samples, 2 * ne);
+  EXPECT_LE(std::abs(colorful.count - exact), 0.25 * exact);
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_edge_similarity(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type lno_view_t;
+  typedef typename graph_t::entries_type lno_nnz_view_t;
+  typedef Kokkos::View<double *, device> similarity_view_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  typename lno_view_t::non_const_type sym_xadj;
+  typename lno_nnz_view_t::non_const_type sym_adj;
+  KokkosKernels::Impl::symmetrize_graph_symbolic_hashmap<lno_view_t, lno_nnz_view_t,
+      typename lno_view_t::non_const_type, typename lno_nnz_view_t::non_const_type, device>
+    (numRows, input_mat.graph.row_map, input_mat.graph.entries, sym_xadj, sym_adj);
+
+  typename lno_view_t::non_const_type::HostMirror hrm = Kokkos::create_mirror_view(sym_xadj);
+  typename lno_nnz_view_t::non_const_type::HostMirror hentries = Kokkos::create_mirror_view(sym_adj);
+  Kokkos::deep_copy(hrm, sym_xadj);
+  Kokkos::deep_copy(hentries, sym_adj);
+  std::vector<lno_t> degree(numRows, 0);
+  for (lno_t i = 0; i < numRows; ++i){
+    for (size_type e = hrm(i); e < hrm(i + 1); ++e) if (hentries(e) != i) ++degree[i];
+  }
+
+  const KokkosGraph::Experimental::EdgeSimilarity measures[3] = {
+      KokkosGraph::Experimental::SIMILARITY_COMMON_NEIGHBORS,
+      KokkosGraph::Experimental::SIMILARITY_JACCARD,
+      KokkosGraph::Experimental::SIMILARITY_ADAMIC_ADAR};
+  for (int m = 0; m < 3; ++m){
+    KernelHandle kh;
+    similarity_view_t similarity("similarity", sym_adj.extent(0));
+    KokkosGraph::Experimental::edge_similarity(&kh, numRows, sym_xadj, sym_adj, measures[m], similarity);
+    typename similarity_view_t::HostMirror h_similarity = Kokkos::create_mirror_view(similarity);
+    Kokkos::deep_copy(h_similarity, similarity);
+
+    //brute force: mark the neighbors of i, visit the marked neighbors of each neighbor j.
+    std::vector<lno_t> mark(numRows, -1);
+    lno_t num_errors = 0;
+    for (lno_t i = 0; i < numRows; ++i){
+      for (size_type e = hrm(i); e < hrm(i + 1); ++e) mark[hentries(e)] = i;
+      for (size_type e = hrm(i); e < hrm(i + 1); ++e){
+        const lno_t j = hentries(e);
+        double common = 0, adamic_adar = 0;
+        if (j != i){
+          for (size_type f = hrm(j); f < hrm(j + 1); ++f){
+            const lno_t k = hentries(f);
+            if (k != i && k != j && mark[k] == i){
+              common += 1;
+              adamic_adar += 1.0 / std::log(double(degree[k]));
+            }
+          }
+        }
+        double expected = common;
+        if (measures[m] == KokkosGraph::Experimental::SIMILARITY_JACCARD && j != i)
+          expected = common / (degree[i] + degree[j] - common);
+        else if (measures[m] == KokkosGraph::Experimental::SIMILARITY_ADAMIC_ADAR)
+          expected = adamic_adar;
+        if (std::abs(h_similarity(e) - expected) > 1e-10 * (1 + std::abs(expected))) ++num_errors;
+      }
+    }
+    EXPECT_TRUE(num_errors == 0);
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, graph ## _ ## triangle_count ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_triangle_count<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 20, 200, 10); \
+  test_triangle_count<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 20, 30, 10); \
+  test_triangle_count<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 20, 30, 10, 7); \
+  test_triangle_count_relabel<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 20, 30, 10, 3); \
+  test_ktruss<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 20, 30, 10, 4); \
+  test_ktruss<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 20, 30, 10, 7); \
+  test_triangle_enumerate_streaming<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 20, 30, 10, 1000); \
+  test_triangle_count_sampling<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 20, 30, 10); \
+  test_edge_similarity<SCALAR,ORDINAL,OFFSET,DEVICE>(5000, 5000 * 20, 30, 10); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_BatchedGemm.hpp"
+#include "Test_Batched_BatchedGemm_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_BlockTridiag.hpp"
+#include "Test_Batched_BlockTridiag_Real.hpp"
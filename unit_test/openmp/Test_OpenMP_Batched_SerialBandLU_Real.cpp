@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_SerialBandLU.hpp"
+#include "Test_Batched_SerialBandLU_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_SerialEigenSymmetric.hpp"
+#include "Test_Batched_SerialEigenSymmetric_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_SerialInverseLU.hpp"
+#include "Test_Batched_SerialInverseLU_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_SerialMixedPrecision.hpp"
+#include "Test_Batched_SerialMixedPrecision_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_SerialQR.hpp"
+#include "Test_Batched_SerialQR_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_TeamCholesky.hpp"
+#include "Test_Batched_TeamCholesky_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_TeamInverseLU.hpp"
+#include "Test_Batched_TeamInverseLU_Real.hpp"
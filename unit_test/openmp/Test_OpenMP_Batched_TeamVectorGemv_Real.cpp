@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_TeamVectorGemv.hpp"
+#include "Test_Batched_TeamVectorGemv_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_TeamVectorTrsm.hpp"
+#include "Test_Batched_TeamVectorTrsm_Real.hpp"
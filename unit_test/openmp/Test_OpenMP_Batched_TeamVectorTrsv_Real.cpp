@@ -0,0 +1,3 @@
+#include "Test_OpenMP.hpp"
+#include "Test_Batched_TeamVectorTrsv.hpp"
+#include "Test_Batched_TeamVectorTrsv_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Serial.hpp"
+#include "Test_Batched_CompactBatch.hpp"
+#include "Test_Batched_CompactBatch_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Serial.hpp"
+#include "Test_Batched_SerialBandLU.hpp"
+#include "Test_Batched_SerialBandLU_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Serial.hpp"
+#include "Test_Batched_SerialCholesky.hpp"
+#include "Test_Batched_SerialCholesky_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Serial.hpp"
+#include "Test_Batched_SerialGemmEpilogue.hpp"
+#include "Test_Batched_SerialGemmEpilogue_Real.hpp"
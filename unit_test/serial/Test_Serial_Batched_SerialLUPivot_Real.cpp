@@ -0,0 +1,3 @@
+#include "Test_Serial.hpp"
+#include "Test_Batched_SerialLUPivot.hpp"
+#include "Test_Batched_SerialLUPivot_Real.hpp"
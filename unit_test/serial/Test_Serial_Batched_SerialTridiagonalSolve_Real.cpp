@@ -0,0 +1,3 @@
+#include "Test_Serial.hpp"
+#include "Test_Batched_SerialTridiagonalSolve.hpp"
+#include "Test_Batched_SerialTridiagonalSolve_Real.hpp"
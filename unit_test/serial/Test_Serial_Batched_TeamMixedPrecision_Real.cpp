@@ -0,0 +1,3 @@
+#include "Test_Serial.hpp"
+#include "Test_Batched_TeamMixedPrecision.hpp"
+#include "Test_Batched_TeamMixedPrecision_Real.hpp"
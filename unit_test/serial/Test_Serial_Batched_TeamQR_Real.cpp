@@ -0,0 +1,3 @@
+#include "Test_Serial.hpp"
+#include "Test_Batched_TeamQR.hpp"
+#include "Test_Batched_TeamQR_Real.hpp"
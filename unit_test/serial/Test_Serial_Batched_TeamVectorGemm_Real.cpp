@@ -0,0 +1,3 @@
+#include "Test_Serial.hpp"
+#include "Test_Batched_TeamVectorGemm.hpp"
+#include "Test_Batched_TeamVectorGemm_Real.hpp"
@@ -0,0 +1,3 @@
+#include "Test_Serial.hpp"
+#include "Test_Batched_TeamVectorTrsv.hpp"
+#include "Test_Batched_TeamVectorTrsv_Real.hpp"
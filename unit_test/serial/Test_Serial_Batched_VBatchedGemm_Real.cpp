@@ -0,0 +1,3 @@
+#include "Test_Serial.hpp"
+#include "Test_Batched_VBatchedGemm.hpp"
+#include "Test_Batched_VBatchedGemm_Real.hpp"
@@ -0,0 +1,232 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_DiaMatrix.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosSparse_spmv_dia.hpp"
+#include "KokkosSparse_gauss_seidel_dia.hpp"
+#include "KokkosBlas1_nrm2.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+namespace Test {
+
+// The 5-point Laplacian of an nx x ny grid, with a perturbed diagonal.
+template <typename crsMat_t>
+crsMat_t make_dia_laplacian(typename crsMat_t::ordinal_type nx, typename crsMat_t::ordinal_type ny) {
+  typedef typename crsMat_t::ordinal_type lno_t;
+  typedef typename crsMat_t::size_type size_type;
+  typedef typename crsMat_t::value_type scalar_t;
+  const lno_t n = nx * ny;
+  const size_type numEntries = n + 2 * (nx - 1) * ny + 2 * nx * (ny - 1);
+  typename crsMat_t::row_map_type::non_const_type row_map("row_map", n + 1);
+  typename crsMat_t::index_type::non_const_type entries("entries", numEntries);
+  typename crsMat_t::values_type::non_const_type values("values", numEntries);
+  typename crsMat_t::row_map_type::non_const_type::HostMirror hr = Kokkos::create_mirror_view(row_map);
+  typename crsMat_t::index_type::non_const_type::HostMirror he = Kokkos::create_mirror_view(entries);
+  typename crsMat_t::values_type::non_const_type::HostMirror hv = Kokkos::create_mirror_view(values);
+  size_type nnz = 0;
+  hr(0) = 0;
+  for (lno_t i = 0; i < n; ++i){
+    const lno_t ix = i % nx, iy = i / nx;
+    if (iy > 0)      { he(nnz) = i - nx; hv(nnz++) = -1; }
+    if (ix > 0)      { he(nnz) = i - 1;  hv(nnz++) = -1; }
+    he(nnz) = i; hv(nnz++) = scalar_t(4.5 + 0.1 * (i % 5));
+    if (ix < nx - 1) { he(nnz) = i + 1;  hv(nnz++) = -1; }
+    if (iy < ny - 1) { he(nnz) = i + nx; hv(nnz++) = -1; }
+    hr(i + 1) = nnz;
+  }
+  Kokkos::deep_copy(row_map, hr);
+  Kokkos::deep_copy(entries, he);
+  Kokkos::deep_copy(values, hv);
+  return crsMat_t("A", n, n, nnz, values, row_map, entries);
+}
+
+template <typename crsMat_t, typename diaMat_t>
+void check_dia_spmv(const crsMat_t& A, const diaMat_t& D) {
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename crsMat_t::value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  typedef typename ATS::mag_type mag_t;
+  const mag_t eps = 1e3 * Kokkos::Details::ArithTraits<mag_t>::epsilon();
+
+  scalar_view_t x("x", A.numCols()), y("y", A.numRows()), y_ref("y ref", A.numRows());
+  typename scalar_view_t::HostMirror hx = Kokkos::create_mirror_view(x);
+  typename scalar_view_t::HostMirror hy = Kokkos::create_mirror_view(y);
+  for (size_t i = 0; i < hx.extent(0); ++i) hx(i) = scalar_t(1 + i % 5);
+  for (size_t i = 0; i < hy.extent(0); ++i) hy(i) = scalar_t(i % 3);
+  Kokkos::deep_copy(x, hx);
+
+  for (int dobeta = 0; dobeta < 2; ++dobeta){
+    const scalar_t beta = dobeta ? scalar_t(0.5) : ATS::zero();
+    Kokkos::deep_copy(y, hy);
+    Kokkos::deep_copy(y_ref, hy);
+    KokkosSparse::spmv("N", scalar_t(2), A, x, beta, y_ref);
+    KokkosSparse::Experimental::spmv("N", scalar_t(2), D, x, beta, y);
+    typename scalar_view_t::HostMirror h_y = Kokkos::create_mirror_view(y);
+    typename scalar_view_t::HostMirror h_y_ref = Kokkos::create_mirror_view(y_ref);
+    Kokkos::deep_copy(h_y, y);
+    Kokkos::deep_copy(h_y_ref, y_ref);
+    for (size_t i = 0; i < h_y.extent(0); ++i)
+      EXPECT_NEAR(ATS::abs(h_y(i) - h_y_ref(i)), 0, eps * (1 + ATS::abs(h_y_ref(i))));
+  }
+}
+
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_dia_matrix(lno_t nx, lno_t ny) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef KokkosSparse::Experimental::DiaMatrix<scalar_t, lno_t, device> diaMat_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  typedef typename ATS::mag_type mag_t;
+  const mag_t eps = 1e3 * Kokkos::Details::ArithTraits<mag_t>::epsilon();
+
+  crsMat_t A = Test::make_dia_laplacian<crsMat_t>(nx, ny);
+  const lno_t n = A.numRows();
+  const lno_t expected_diagonals = 1 + (nx > 1 ? 2 : 0) + (ny > 1 ? 2 : 0);
+  EXPECT_EQ(KokkosSparse::Experimental::count_dia_diagonals(A), expected_diagonals);
+  EXPECT_THROW(diaMat_t(A, expected_diagonals - 1), std::runtime_error);
+
+  diaMat_t D(A, expected_diagonals);
+  ASSERT_EQ(D.numDiagonals(), expected_diagonals);
+  EXPECT_EQ(D.numRows(), n);
+  EXPECT_EQ(D.numCols(), n);
+  EXPECT_EQ(D.nnz(), A.nnz());
+
+  //the conversion against the entries of A, and the coloring.
+  typename diaMat_t::offsets_type::HostMirror ho = Kokkos::create_mirror_view(D.offsets);
+  typename diaMat_t::values_type::HostMirror hdv = Kokkos::create_mirror_view(D.values);
+  Kokkos::deep_copy(ho, D.offsets);
+  Kokkos::deep_copy(hdv, D.values);
+  ASSERT_GE(D.diagonalIndex(), 0);
+  EXPECT_EQ(ho(D.diagonalIndex()), 0);
+  for (lno_t k = 0; k < D.numDiagonals(); ++k){
+    if (k > 0) EXPECT_LT(ho(k - 1), ho(k));
+    if (ho(k) != 0) EXPECT_NE(ho(k) % D.numColors(), 0);
+  }
+  typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(hr, A.graph.row_map);
+  Kokkos::deep_copy(he, A.graph.entries);
+  Kokkos::deep_copy(hv, A.values);
+  for (lno_t i = 0; i < n; ++i){
+    scalar_t row_sum = ATS::zero(), dia_row_sum = ATS::zero();
+    for (size_type j = hr(i); j < hr(i + 1); ++j){
+      lno_t k = 0;
+      while (k < D.numDiagonals() && ho(k) != he(j) - i) ++k;
+      ASSERT_LT(k, D.numDiagonals());
+      EXPECT_EQ(hdv(i, k), hv(j));
+      row_sum += hv(j);
+    }
+    for (lno_t k = 0; k < D.numDiagonals(); ++k) dia_row_sum += hdv(i, k);
+    EXPECT_EQ(dia_row_sum, row_sum);
+  }
+
+  Test::check_dia_spmv(A, D);
+
+  //a forward sweep against the host sweep in color order.
+  scalar_view_t b("b", n), x("x", n);
+  typename scalar_view_t::HostMirror hb = Kokkos::create_mirror_view(b);
+  for (lno_t i = 0; i < n; ++i) hb(i) = scalar_t(1 + i % 7);
+  Kokkos::deep_copy(b, hb);
+  const scalar_t omega = scalar_t(1.2);
+  std::vector<scalar_t> x_ref(n, ATS::zero());
+  for (lno_t c = 0; c < D.numColors(); ++c){
+    for (lno_t i = c; i < n; i += D.numColors()){
+      scalar_t sum = hb(i), diag = ATS::one();
+      for (size_type j = hr(i); j < hr(i + 1); ++j){
+        if (he(j) == i) diag = hv(j);
+        else sum -= hv(j) * x_ref[he(j)];
+      }
+      x_ref[i] += omega * (sum / diag - x_ref[i]);
+    }
+  }
+  KokkosSparse::Experimental::forward_sweep_dia_gauss_seidel_apply(D, x, b, true, 1, omega);
+  typename scalar_view_t::HostMirror hx = Kokkos::create_mirror_view(x);
+  Kokkos::deep_copy(hx, x);
+  for (lno_t i = 0; i < n; ++i)
+    EXPECT_NEAR(ATS::abs(hx(i) - x_ref[i]), 0, eps * (1 + ATS::abs(x_ref[i])));
+
+  //the symmetric sweeps converge.
+  scalar_view_t r("r", n);
+  KokkosSparse::Experimental::symmetric_dia_gauss_seidel_apply(D, x, b, true, 20);
+  Kokkos::deep_copy(r, b);
+  KokkosSparse::spmv("N", -1, A, x, 1, r);
+  EXPECT_LT(KokkosBlas::nrm2(r), 1e-3 * KokkosBlas::nrm2(b));
+
+  //a banded random matrix, with more diagonals.
+  const lno_t numRows = 300;
+  crsMat_t B = KokkosKernels::Impl::kk_generate_diagonally_dominant_sparse_matrix<crsMat_t>
+    (numRows, numRows, numRows * 5, 2, 6);
+  diaMat_t DB(B);
+  EXPECT_EQ(DB.numDiagonals(), KokkosSparse::Experimental::count_dia_diagonals(B));
+  Test::check_dia_spmv(B, DB);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## dia_matrix ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_dia_matrix<SCALAR,ORDINAL,OFFSET,DEVICE>(30, 20); \
+  test_dia_matrix<SCALAR,ORDINAL,OFFSET,DEVICE>(33, 17); \
+  test_dia_matrix<SCALAR,ORDINAL,OFFSET,DEVICE>(500, 1); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
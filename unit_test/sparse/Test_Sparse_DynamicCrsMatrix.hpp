@@ -0,0 +1,272 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <map>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_DynamicCrsMatrix.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosSparse_spmv_dynamiccrs.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+namespace Test {
+
+// Row i gets 1 at column (i + shift) % numCols, unless done(i) is set;
+// done(i) records whether the row had room for it.
+template <typename dynMat_t, typename flag_view_t>
+struct DynamicShiftInsertFunctor {
+  typedef typename dynMat_t::non_const_ordinal_type lno_t;
+  dynMat_t D;
+  flag_view_t done;
+  lno_t shift;
+
+  DynamicShiftInsertFunctor(const dynMat_t& D_, const flag_view_t& done_, lno_t shift_) :
+    D(D_), done(done_), shift(shift_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t i) const {
+    if (done(i)) return;
+    done(i) = D.sumIntoOrInsert(i, (i + shift) % D.numCols(), 1) ? 1 : 0;
+  }
+};
+
+// Thread i adds 1 at (i % numTargetRows, i), so that many threads insert into
+// the same few rows at once.
+template <typename dynMat_t>
+struct DynamicContendedInsertFunctor {
+  typedef typename dynMat_t::non_const_ordinal_type lno_t;
+  typedef int value_type;
+  dynMat_t D;
+  lno_t numTargetRows;
+
+  DynamicContendedInsertFunctor(const dynMat_t& D_, lno_t numTargetRows_) :
+    D(D_), numTargetRows(numTargetRows_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t i, int& failed) const {
+    if (!D.sumIntoOrInsert(i % numTargetRows, i, 1)) ++failed;
+  }
+};
+
+template <typename flag_view_t, typename lno_t>
+struct DynamicCountFunctor {
+  typedef int value_type;
+  flag_view_t done;
+
+  DynamicCountFunctor(const flag_view_t& done_) : done(done_) {}
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const lno_t i, int& n) const { n += done(i); }
+};
+
+template <typename crsMat_t, typename ref_t>
+void check_dynamic_against_ref(const crsMat_t& C, const ref_t& ref) {
+  typedef typename crsMat_t::ordinal_type lno_t;
+  typedef typename crsMat_t::size_type size_type;
+  typedef typename crsMat_t::value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+
+  typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view(C.graph.row_map);
+  typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view(C.graph.entries);
+  typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view(C.values);
+  Kokkos::deep_copy(hr, C.graph.row_map);
+  Kokkos::deep_copy(he, C.graph.entries);
+  Kokkos::deep_copy(hv, C.values);
+  //A may hold duplicate columns, so compare the sums per column.
+  for (lno_t i = 0; i < C.numRows(); ++i){
+    typename ref_t::value_type row;
+    for (size_type j = hr(i); j < hr(i + 1); ++j) row[he(j)] += hv(j);
+    ASSERT_EQ(row.size(), ref[i].size()) << "row " << i;
+    for (typename ref_t::value_type::const_iterator it = row.begin(); it != row.end(); ++it){
+      const typename ref_t::value_type::const_iterator r = ref[i].find(it->first);
+      ASSERT_TRUE(r != ref[i].end()) << "row " << i << " col " << it->first;
+      EXPECT_NEAR(ATS::abs(it->second - r->second), 0, 1e-12 * (1 + ATS::abs(r->second)));
+    }
+  }
+}
+
+template <typename crsMat_t, typename dynMat_t>
+void check_dynamic_spmv(const crsMat_t& C, const dynMat_t& D) {
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename crsMat_t::value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  typedef typename ATS::mag_type mag_t;
+  const mag_t eps = 1e3 * Kokkos::Details::ArithTraits<mag_t>::epsilon();
+
+  scalar_view_t x("x", C.numCols()), y("y", C.numRows()), y_ref("y ref", C.numRows());
+  typename scalar_view_t::HostMirror hx = Kokkos::create_mirror_view(x);
+  typename scalar_view_t::HostMirror hy = Kokkos::create_mirror_view(y);
+  for (size_t i = 0; i < hx.extent(0); ++i) hx(i) = scalar_t(1 + i % 5);
+  for (size_t i = 0; i < hy.extent(0); ++i) hy(i) = scalar_t(i % 3);
+  Kokkos::deep_copy(x, hx);
+
+  for (int dobeta = 0; dobeta < 2; ++dobeta){
+    const scalar_t beta = dobeta ? scalar_t(0.5) : ATS::zero();
+    Kokkos::deep_copy(y, hy);
+    Kokkos::deep_copy(y_ref, hy);
+    KokkosSparse::spmv("N", scalar_t(2), C, x, beta, y_ref);
+    KokkosSparse::Experimental::spmv("N", scalar_t(2), D, x, beta, y);
+    typename scalar_view_t::HostMirror h_y = Kokkos::create_mirror_view(y);
+    typename scalar_view_t::HostMirror h_y_ref = Kokkos::create_mirror_view(y_ref);
+    Kokkos::deep_copy(h_y, y);
+    Kokkos::deep_copy(h_y_ref, y_ref);
+    for (size_t i = 0; i < h_y.extent(0); ++i)
+      EXPECT_NEAR(ATS::abs(h_y(i) - h_y_ref(i)), 0, eps * (1 + ATS::abs(h_y_ref(i))));
+  }
+}
+
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_dynamic_crs_matrix(lno_t numRows, size_type nnz, lno_t bandwidth) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef KokkosSparse::Experimental::DynamicCrsMatrix<scalar_t, lno_t, device, size_type> dynMat_t;
+  typedef Kokkos::View<int*, device> flag_view_t;
+  typedef typename device::execution_space execution_space;
+  typedef std::vector<std::map<lno_t, scalar_t> > ref_t;
+
+  crsMat_t A = KokkosKernels::Impl::kk_generate_diagonally_dominant_sparse_matrix<crsMat_t>
+    (numRows, numRows, nnz, 2, bandwidth);
+  const lno_t numTargetRows = numRows < 4 ? numRows : 4;
+  const lno_t numContended = numRows < 64 ? numRows : 64;
+
+  ref_t ref(numRows);
+  {
+    typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view(A.graph.row_map);
+    typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view(A.graph.entries);
+    typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view(A.values);
+    Kokkos::deep_copy(hr, A.graph.row_map);
+    Kokkos::deep_copy(he, A.graph.entries);
+    Kokkos::deep_copy(hv, A.values);
+    for (lno_t i = 0; i < numRows; ++i)
+      for (size_type j = hr(i); j < hr(i + 1); ++j) ref[i][he(j)] += hv(j);
+  }
+
+  //the conversion keeps the entries and adds the slack to every row.
+  const size_type slack = 3 + (numContended + numTargetRows - 1) / numTargetRows;
+  dynMat_t D(A, slack);
+  EXPECT_EQ(D.numRows(), numRows);
+  EXPECT_EQ(D.numCols(), numRows);
+  EXPECT_EQ(D.capacity(), A.nnz() + slack * numRows);
+  EXPECT_FALSE(D.overflowed());
+  Test::check_dynamic_spmv(A, D);
+
+  //in place insertion, into existing and new entries.
+  const lno_t shifts[3] = {0, 7, 13};
+  flag_view_t done("done", numRows);
+  for (int s = 0; s < 3; ++s){
+    Kokkos::deep_copy(done, 0);
+    Kokkos::parallel_for("KokkosKernels::UnitTests::dynamic_crs_insert",
+        Kokkos::RangePolicy<execution_space, lno_t>(0, numRows),
+        Test::DynamicShiftInsertFunctor<dynMat_t, flag_view_t>(D, done, shifts[s]));
+    int num_done = 0;
+    Kokkos::parallel_reduce("KokkosKernels::UnitTests::dynamic_crs_count",
+        Kokkos::RangePolicy<execution_space, lno_t>(0, numRows),
+        Test::DynamicCountFunctor<flag_view_t, lno_t>(done), num_done);
+    EXPECT_EQ(num_done, numRows);
+    for (lno_t i = 0; i < numRows; ++i) ref[i][(i + shifts[s]) % numRows] += 1;
+  }
+  int failed = 0;
+  Kokkos::parallel_reduce("KokkosKernels::UnitTests::dynamic_crs_contended",
+      Kokkos::RangePolicy<execution_space, lno_t>(0, numContended),
+      Test::DynamicContendedInsertFunctor<dynMat_t>(D, numTargetRows), failed);
+  EXPECT_EQ(failed, 0);
+  for (lno_t i = 0; i < numContended; ++i) ref[i % numTargetRows][i] += 1;
+  EXPECT_FALSE(D.overflowed());
+
+  crsMat_t C = D.compact();
+  Test::check_dynamic_against_ref(C, ref);
+  Test::check_dynamic_spmv(C, D);
+
+  //without slack, the new entries overflow; reserve() makes room for them.
+  dynMat_t E(A, 0);
+  EXPECT_EQ(E.capacity(), A.nnz());
+  Kokkos::deep_copy(done, 0);
+  Test::DynamicShiftInsertFunctor<dynMat_t, flag_view_t> insert_e(E, done, numRows / 2);
+  Kokkos::parallel_for("KokkosKernels::UnitTests::dynamic_crs_insert",
+      Kokkos::RangePolicy<execution_space, lno_t>(0, numRows), insert_e);
+  E.reserve(1);
+  EXPECT_FALSE(E.overflowed());
+  insert_e.D = E;
+  Kokkos::parallel_for("KokkosKernels::UnitTests::dynamic_crs_insert",
+      Kokkos::RangePolicy<execution_space, lno_t>(0, numRows), insert_e);
+  EXPECT_FALSE(E.overflowed());
+  {
+    crsMat_t AE = E.compact();
+    ref_t ref_a(numRows);
+    typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view(A.graph.row_map);
+    typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view(A.graph.entries);
+    typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view(A.values);
+    Kokkos::deep_copy(hr, A.graph.row_map);
+    Kokkos::deep_copy(he, A.graph.entries);
+    Kokkos::deep_copy(hv, A.values);
+    for (lno_t i = 0; i < numRows; ++i){
+      for (size_type j = hr(i); j < hr(i + 1); ++j) ref_a[i][he(j)] += hv(j);
+      ref_a[i][(i + numRows / 2) % numRows] += 1;
+    }
+    Test::check_dynamic_against_ref(AE, ref_a);
+    Test::check_dynamic_spmv(AE, E);
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## dynamic_crs_matrix ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_dynamic_crs_matrix<SCALAR,ORDINAL,OFFSET,DEVICE>(10, 30, 5); \
+  test_dynamic_crs_matrix<SCALAR,ORDINAL,OFFSET,DEVICE>(2000, 2000 * 10, 100); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,243 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#include <gtest/gtest.h>
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+#include <vector>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_BlockCrsMatrix.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosSparse_analyze.hpp"
+
+//Block tridiagonal matrix of nb x nb dense bs x bs blocks, with diagonal
+//diag and off diagonal entries -1. With lower_only, only the entries with
+//j <= i are kept; with unsorted_row >= 0, the entries of that row are
+//reversed and its diagonal is set to 0.5.
+template <typename crsMat_t>
+crsMat_t make_block_tridiagonal_matrix(const int nb, const int bs, const double diag,
+    const bool lower_only, const int unsorted_row){
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type row_map_view_t;
+  typedef typename graph_t::entries_type::non_const_type cols_view_t;
+  typedef typename crsMat_t::values_type::non_const_type values_view_t;
+  typedef typename crsMat_t::ordinal_type lno_t;
+  typedef typename crsMat_t::value_type scalar_t;
+
+  const lno_t n = nb * bs;
+  std::vector<typename row_map_view_t::non_const_value_type> rows(1, 0);
+  std::vector<lno_t> cols;
+  std::vector<scalar_t> vals;
+  for (lno_t i = 0; i < n; ++i){
+    const lno_t r = i / bs;
+    const size_t row_begin = cols.size();
+    for (lno_t c = (r > 0 ? r - 1 : 0) * bs; c < (r + 2 < nb ? r + 2 : nb) * bs; ++c){
+      if (lower_only && c > i) continue;
+      cols.push_back(c);
+      vals.push_back(c == i ? scalar_t(diag) : scalar_t(-1));
+    }
+    if (i == unsorted_row){
+      for (size_t a = row_begin, b = cols.size() - 1; a < b; ++a, --b){
+        std::swap(cols[a], cols[b]);
+        std::swap(vals[a], vals[b]);
+      }
+      for (size_t k = row_begin; k < cols.size(); ++k)
+        if (cols[k] == i) vals[k] = scalar_t(0.5);
+    }
+    rows.push_back(cols.size());
+  }
+
+  row_map_view_t row_map("row_map", n + 1);
+  cols_view_t entries("entries", cols.size());
+  values_view_t values("values", vals.size());
+  typename row_map_view_t::HostMirror h_row_map = Kokkos::create_mirror_view(row_map);
+  typename cols_view_t::HostMirror h_entries = Kokkos::create_mirror_view(entries);
+  typename values_view_t::HostMirror h_values = Kokkos::create_mirror_view(values);
+  for (lno_t i = 0; i <= n; ++i) h_row_map(i) = rows[i];
+  for (size_t k = 0; k < cols.size(); ++k){
+    h_entries(k) = cols[k];
+    h_values(k) = vals[k];
+  }
+  Kokkos::deep_copy(row_map, h_row_map);
+  Kokkos::deep_copy(entries, h_entries);
+  Kokkos::deep_copy(values, h_values);
+  graph_t graph(entries, row_map);
+  return crsMat_t("A", n, values, graph);
+}
+
+//nb is odd and at least 3, so that the dense blocks are 4 x 4 and not 8 x 8.
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_analyze(const int nb){
+  typedef KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef KokkosSparse::Experimental::BlockCrsMatrix<scalar_t, lno_t, device, void, size_type> blockCrsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType::row_map_type::non_const_type row_map_view_t;
+  typedef typename crsMat_t::StaticCrsGraphType::entries_type::non_const_type cols_view_t;
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t, typename device::execution_space,
+       typename device::memory_space, typename device::memory_space> KernelHandle;
+  typedef KokkosSparse::SPMVHandle<lno_t, size_type, typename device::execution_space> SPMVHandle_t;
+  typedef Kokkos::View<scalar_t *, device> vector_t;
+
+  const int bs = 4;
+  const lno_t n = nb * bs;
+  const double eps = 1e-12;
+
+  //the first and last block rows have 2 blocks, the others 3.
+  crsMat_t A = make_block_tridiagonal_matrix<crsMat_t>(nb, bs, 20, false, -1);
+  KokkosSparse::MatrixAnalysis a = KokkosSparse::analyze(A);
+  const double mean = (2 * bs * 8.0 + (n - 2 * bs) * 12.0) / n;
+  EXPECT_TRUE(a.is_for(A.graph.row_map.data(), n, A.nnz()));
+  EXPECT_FALSE(a.is_block_matrix);
+  EXPECT_EQ(a.block_size, bs);
+  EXPECT_TRUE(a.has_dense_blocks());
+  EXPECT_EQ(a.min_row_length, size_t(8));
+  EXPECT_EQ(a.max_row_length, size_t(12));
+  EXPECT_NEAR(a.mean_row_length, mean, eps);
+  EXPECT_NEAR(a.row_length_variance, (2 * bs * 64.0 + (n - 2 * bs) * 144.0) / n - mean * mean, 1e-9);
+  EXPECT_EQ(a.row_length_histogram.counts[8], size_t(2 * bs));
+  EXPECT_EQ(a.row_length_histogram.counts[12], size_t(n - 2 * bs));
+  EXPECT_EQ(a.lower_bandwidth, int64_t(2 * bs - 1));
+  EXPECT_EQ(a.upper_bandwidth, int64_t(2 * bs - 1));
+  EXPECT_TRUE(a.is_pattern_symmetric());
+  EXPECT_TRUE(a.are_rows_sorted());
+  EXPECT_TRUE(a.has_full_diagonal());
+  EXPECT_TRUE(a.is_strictly_diagonally_dominant());
+
+  //a reversed row breaks the blocks and the dominance, not the symmetry.
+  crsMat_t B = make_block_tridiagonal_matrix<crsMat_t>(nb, bs, 20, false, 5);
+  KokkosSparse::MatrixAnalysis b = KokkosSparse::analyze(B);
+  EXPECT_EQ(b.block_size, 1);
+  EXPECT_EQ(b.num_unsorted_rows, size_t(1));
+  EXPECT_TRUE(b.is_pattern_symmetric());
+  EXPECT_TRUE(b.has_full_diagonal());
+  EXPECT_EQ(b.num_diagonally_dominant_rows, size_t(n - 1));
+  EXPECT_FALSE(b.is_diagonally_dominant());
+
+  //the lower triangle: every strictly lower entry is asymmetric.
+  crsMat_t L = make_block_tridiagonal_matrix<crsMat_t>(nb, bs, 20, true, -1);
+  KokkosSparse::MatrixAnalysis l = KokkosSparse::analyze(L);
+  EXPECT_EQ(l.block_size, 1);
+  EXPECT_EQ(l.lower_bandwidth, int64_t(2 * bs - 1));
+  EXPECT_EQ(l.upper_bandwidth, int64_t(0));
+  EXPECT_EQ(l.num_asymmetric_entries, size_t(L.nnz() - n));
+  EXPECT_FALSE(l.is_pattern_symmetric());
+
+  //the same matrix as a BlockCrsMatrix, whose point rows are those of A.
+  {
+    row_map_view_t block_row_map("block_row_map", nb + 1);
+    cols_view_t block_entries("block_entries", 3 * nb - 2);
+    typename row_map_view_t::HostMirror h_row_map = Kokkos::create_mirror_view(block_row_map);
+    typename cols_view_t::HostMirror h_entries = Kokkos::create_mirror_view(block_entries);
+    h_row_map(0) = 0;
+    for (int r = 0; r < nb; ++r){
+      size_type k = h_row_map(r);
+      for (int c = (r > 0 ? r - 1 : 0); c < (r + 2 < nb ? r + 2 : nb); ++c) h_entries(k++) = c;
+      h_row_map(r + 1) = k;
+    }
+    Kokkos::deep_copy(block_row_map, h_row_map);
+    Kokkos::deep_copy(block_entries, h_entries);
+    blockCrsMat_t AB("AB", nb, nb, A.nnz(), A.values, block_row_map, block_entries, bs);
+    KokkosSparse::MatrixAnalysis ab = KokkosSparse::analyze(AB);
+    EXPECT_TRUE(ab.is_block_matrix);
+    EXPECT_EQ(ab.block_size, bs);
+    EXPECT_EQ(ab.num_point_rows(), int64_t(n));
+    EXPECT_EQ(ab.min_row_length, size_t(2));
+    EXPECT_EQ(ab.max_row_length, size_t(3));
+    EXPECT_EQ(ab.lower_bandwidth, int64_t(1));
+    EXPECT_TRUE(ab.is_pattern_symmetric());
+    EXPECT_TRUE(ab.has_full_diagonal());
+    EXPECT_TRUE(ab.is_strictly_diagonally_dominant());
+  }
+
+  //the handles use the attached analysis of the matrix, and only of it.
+  KernelHandle kh;
+  EXPECT_TRUE(kh.get_matrix_analysis(A.graph.row_map.data(), n, A.nnz()) == NULL);
+  kh.set_matrix_analysis(a);
+  kh.set_matrix_analysis(b);
+  kh.set_matrix_analysis(a);
+  const KokkosSparse::MatrixAnalysis *cached = kh.get_matrix_analysis(A.graph.row_map.data(), n, A.nnz());
+  EXPECT_TRUE(cached != NULL);
+  EXPECT_TRUE(kh.get_matrix_analysis(A.graph.row_map.data(), n, A.nnz() + 1) == NULL);
+  if (cached != NULL) EXPECT_EQ(cached->block_size, a.block_size);
+  EXPECT_EQ(kh.get_suggested_vector_size(n, A.nnz(), A.graph.row_map),
+      KokkosKernels::Impl::kk_get_suggested_vector_size(n, A.nnz(), kh.get_row_length_histogram(n, A.graph.row_map),
+          KokkosKernels::Impl::kk_get_exec_space_type<typename device::execution_space>()));
+  kh.reset_matrix_analyses();
+  EXPECT_TRUE(kh.get_matrix_analysis(A.graph.row_map.data(), n, A.nnz()) == NULL);
+
+  SPMVHandle_t spmv_handle;
+  spmv_handle.set_analysis(a);
+  EXPECT_TRUE(spmv_handle.has_analysis_for(A.graph.row_map.data(), n, A.nnz()));
+  EXPECT_FALSE(spmv_handle.has_analysis_for(B.graph.row_map.data(), n, B.nnz()));
+  vector_t x("x", n), y("y", n), y_ref("y_ref", n);
+  Kokkos::deep_copy(x, scalar_t(1));
+  KokkosSparse::spmv(spmv_handle, "N", scalar_t(1), A, x, scalar_t(0), y);
+  KokkosSparse::spmv("N", scalar_t(1), A, x, scalar_t(0), y_ref);
+  typename vector_t::HostMirror h_y = Kokkos::create_mirror_view(y);
+  typename vector_t::HostMirror h_y_ref = Kokkos::create_mirror_view(y_ref);
+  Kokkos::deep_copy(h_y, y);
+  Kokkos::deep_copy(h_y_ref, y_ref);
+  for (lno_t i = 0; i < n; ++i)
+    EXPECT_NEAR(h_y(i), h_y_ref(i), eps);
+  spmv_handle.reset_plan();
+  EXPECT_TRUE(spmv_handle.has_analysis_for(A.graph.row_map.data(), n, A.nnz()));
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## analyze ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_analyze<SCALAR,ORDINAL,OFFSET,DEVICE>(3); \
+  test_analyze<SCALAR,ORDINAL,OFFSET,DEVICE>(25); \
+  test_analyze<SCALAR,ORDINAL,OFFSET,DEVICE>(1001); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
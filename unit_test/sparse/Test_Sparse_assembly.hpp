@@ -0,0 +1,173 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <set>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_assembly.hpp"
+
+//assembles the bilinear quadrilaterals of an nx x ny grid, in a shuffled
+//element order; the first nrows nodes are owned.
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_assembly(lno_t nx, lno_t ny, lno_t nrows) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef Kokkos::View<lno_t*[4], device> elem_node_t;
+  typedef KokkosSparse::Experimental::AssemblyGraph<graph_t, elem_node_t> assembly_t;
+  typedef Kokkos::View<scalar_t*[4], device> elem_vectors_t;
+  typedef Kokkos::View<scalar_t*[4][4], device> elem_matrices_t;
+  typedef Kokkos::View<scalar_t*, device> vector_t;
+
+  const lno_t nelem = nx * ny;
+  elem_node_t elem_node("elem_node", nelem);
+  elem_vectors_t elem_vectors("elem_vectors", nelem);
+  elem_matrices_t elem_matrices("elem_matrices", nelem);
+  typename elem_node_t::HostMirror h_elem_node = Kokkos::create_mirror_view(elem_node);
+  typename elem_vectors_t::HostMirror h_elem_vectors = Kokkos::create_mirror_view(elem_vectors);
+  typename elem_matrices_t::HostMirror h_elem_matrices = Kokkos::create_mirror_view(elem_matrices);
+
+  std::vector<lno_t> order(nelem);
+  for (lno_t e = 0; e < nelem; ++e) order[e] = e;
+  srand(245);
+  for (lno_t e = nelem - 1; e > 0; --e) std::swap(order[e], order[rand() % (e + 1)]);
+  for (lno_t e = 0; e < nelem; ++e){
+    const lno_t x = order[e] % nx, y = order[e] / nx;
+    h_elem_node(e, 0) = y * (nx + 1) + x;
+    h_elem_node(e, 1) = y * (nx + 1) + x + 1;
+    h_elem_node(e, 2) = (y + 1) * (nx + 1) + x + 1;
+    h_elem_node(e, 3) = (y + 1) * (nx + 1) + x;
+    for (int i = 0; i < 4; ++i){
+      h_elem_vectors(e, i) = scalar_t(rand() % 100) / 10;
+      for (int j = 0; j < 4; ++j) h_elem_matrices(e, i, j) = scalar_t(rand() % 100) / 10;
+    }
+  }
+  Kokkos::deep_copy(elem_node, h_elem_node);
+  Kokkos::deep_copy(elem_vectors, h_elem_vectors);
+  Kokkos::deep_copy(elem_matrices, h_elem_matrices);
+
+  //reference graph and sums
+  std::vector<std::set<lno_t> > reference(nrows);
+  for (lno_t e = 0; e < nelem; ++e)
+    for (int i = 0; i < 4; ++i)
+      if (h_elem_node(e, i) < nrows)
+        for (int j = 0; j < 4; ++j) reference[h_elem_node(e, i)].insert(h_elem_node(e, j));
+
+  const assembly_t assembly(elem_node, nrows);
+  crsMat_t A("A", assembly.graph);
+  ASSERT_EQ(A.numRows(), nrows);
+
+  typename graph_t::row_map_type::HostMirror h_row_map = Kokkos::create_mirror_view(A.graph.row_map);
+  typename graph_t::entries_type::HostMirror h_entries = Kokkos::create_mirror_view(A.graph.entries);
+  Kokkos::deep_copy(h_row_map, A.graph.row_map);
+  Kokkos::deep_copy(h_entries, A.graph.entries);
+
+  size_t num_errors = 0;
+  for (lno_t i = 0; i < nrows; ++i){
+    ASSERT_EQ(size_t(h_row_map(i + 1) - h_row_map(i)), reference[i].size());
+    size_type k = h_row_map(i);
+    for (typename std::set<lno_t>::const_iterator it = reference[i].begin(); it != reference[i].end(); ++it, ++k)
+      if (h_entries(k) != *it) ++num_errors;
+  }
+  EXPECT_TRUE(num_errors == 0);
+
+  //element offsets
+  typename assembly_t::elem_graph_type::HostMirror h_elem_graph = Kokkos::create_mirror_view(assembly.elem_graph);
+  Kokkos::deep_copy(h_elem_graph, assembly.elem_graph);
+  std::vector<scalar_t> ref_values(h_entries.extent(0), 0), ref_vector(nrows, 0);
+  num_errors = 0;
+  for (lno_t e = 0; e < nelem; ++e){
+    for (int i = 0; i < 4; ++i){
+      const lno_t n = h_elem_node(e, i);
+      for (int j = 0; j < 4; ++j){
+        const size_type offset = h_elem_graph(e, i, j);
+        if (n >= nrows){
+          if (offset != assembly_t::invalid_offset()) ++num_errors;
+          continue;
+        }
+        if (offset < h_row_map(n) || offset >= h_row_map(n + 1) || h_entries(offset) != h_elem_node(e, j)) ++num_errors;
+        else ref_values[offset] += h_elem_matrices(e, i, j);
+      }
+      if (n < nrows) ref_vector[n] += h_elem_vectors(e, i);
+    }
+  }
+  EXPECT_TRUE(num_errors == 0);
+
+  //atomic-free gather
+  vector_t vector("vector", nrows);
+  assembly.gather(elem_vectors, elem_matrices, vector, A.values);
+  typename vector_t::HostMirror h_vector = Kokkos::create_mirror_view(vector);
+  typename crsMat_t::values_type::HostMirror h_values = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(h_vector, vector);
+  Kokkos::deep_copy(h_values, A.values);
+  num_errors = 0;
+  for (size_t k = 0; k < ref_values.size(); ++k)
+    if (std::abs(ref_values[k] - h_values(k)) > 1e-10 * (1 + std::abs(ref_values[k]))) ++num_errors;
+  for (lno_t i = 0; i < nrows; ++i)
+    if (std::abs(ref_vector[i] - h_vector(i)) > 1e-10 * (1 + std::abs(ref_vector[i]))) ++num_errors;
+  EXPECT_TRUE(num_errors == 0);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## assembly ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_assembly<SCALAR,ORDINAL,OFFSET,DEVICE>(30, 20, 31 * 21); \
+  test_assembly<SCALAR,ORDINAL,OFFSET,DEVICE>(30, 20, 300); \
+  test_assembly<SCALAR,ORDINAL,OFFSET,DEVICE>(1, 1, 4); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
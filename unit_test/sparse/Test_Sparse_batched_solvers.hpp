@@ -0,0 +1,202 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_BatchedCrsMatrix.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosSparse_spmv_batched.hpp"
+#include "KokkosSparse_batched_solvers.hpp"
+
+namespace Test {
+
+// A batch of n x n matrices with the pattern of a 1-D convection-diffusion
+// stencil, plus the entries at distance 7. Matrix b has the diagonal 4 + b/10
+// and the off-diagonal entries -1 -/+ convection*(b+1)/num_matrices, so the
+// batch is symmetric positive definite if convection == 0.
+template <typename batchedMat_t>
+batchedMat_t batched_test_matrices(typename batchedMat_t::ordinal_type n, int num_matrices, double convection){
+  typedef typename batchedMat_t::ordinal_type lno_t;
+  typedef typename batchedMat_t::size_type size_type;
+  typedef typename batchedMat_t::non_const_value_type scalar_t;
+  typedef typename batchedMat_t::staticcrsgraph_type graph_t;
+  typedef typename batchedMat_t::row_map_type::non_const_type row_map_t;
+  typedef typename batchedMat_t::index_type::non_const_type entries_t;
+  typedef typename batchedMat_t::values_type values_t;
+
+  std::vector<size_type> rows(1, 0);
+  std::vector<lno_t> cols;
+  std::vector<int> kind;
+  for (lno_t i = 0; i < n; ++i){
+    if (i >= 7) {cols.push_back(i - 7); kind.push_back(3);}
+    if (i > 0) {cols.push_back(i - 1); kind.push_back(1);}
+    cols.push_back(i); kind.push_back(0);
+    if (i < n - 1) {cols.push_back(i + 1); kind.push_back(2);}
+    if (i + 7 < n) {cols.push_back(i + 7); kind.push_back(3);}
+    rows.push_back(cols.size());
+  }
+  const size_type nnz = cols.size();
+  row_map_t row_map("row_map", n + 1);
+  entries_t entries("entries", nnz);
+  values_t values("values", num_matrices, nnz);
+  typename row_map_t::HostMirror h_row_map = Kokkos::create_mirror_view(row_map);
+  typename entries_t::HostMirror h_entries = Kokkos::create_mirror_view(entries);
+  typename values_t::HostMirror h_values = Kokkos::create_mirror_view(values);
+  for (lno_t i = 0; i <= n; ++i) h_row_map(i) = rows[i];
+  for (size_type k = 0; k < nnz; ++k){
+    h_entries(k) = cols[k];
+    for (int b = 0; b < num_matrices; ++b){
+      const double c = convection * (b + 1) / num_matrices;
+      switch (kind[k]) {
+      case 0: h_values(b, k) = scalar_t(4 + 0.1 * b); break;
+      case 1: h_values(b, k) = scalar_t(-1 - c); break;
+      case 2: h_values(b, k) = scalar_t(-1 + c); break;
+      default: h_values(b, k) = scalar_t(-0.5); break;
+      }
+    }
+  }
+  Kokkos::deep_copy(row_map, h_row_map);
+  Kokkos::deep_copy(entries, h_entries);
+  Kokkos::deep_copy(values, h_values);
+  return batchedMat_t(n, graph_t(entries, row_map), values);
+}
+
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_batched_solvers(lno_t n, int num_matrices) {
+  typedef KokkosSparse::Experimental::BatchedCrsMatrix<scalar_t, lno_t, device, size_type> batchedMat_t;
+  typedef typename batchedMat_t::matrix_type crsMat_t;
+  typedef typename Kokkos::Details::ArithTraits<scalar_t>::mag_type mag_t;
+  typedef Kokkos::View<scalar_t**, Kokkos::LayoutRight, device> mv_t;
+  typedef Kokkos::View<scalar_t*, device> vector_t;
+  typedef Kokkos::View<int*, device> iters_t;
+  typedef Kokkos::View<mag_t*, device> norms_t;
+
+  const mag_t tol = 1e-10;
+  const int max_iters = 4 * n;
+
+  for (int sym = 0; sym < 2; ++sym){
+    batchedMat_t A = Test::batched_test_matrices<batchedMat_t>(n, num_matrices, sym ? 0.0 : 0.8);
+    EXPECT_EQ(A.numMatrices(), num_matrices);
+    EXPECT_EQ(A.numRows(), n);
+
+    mv_t X_true("X_true", num_matrices, n);
+    mv_t B("B", num_matrices, n);
+    typename mv_t::HostMirror h_X_true = Kokkos::create_mirror_view(X_true);
+    for (int b = 0; b < num_matrices; ++b)
+      for (lno_t i = 0; i < n; ++i)
+        h_X_true(b, i) = scalar_t(1 + ((7 * i + 3 * b) % 11) / 11.0);
+    Kokkos::deep_copy(X_true, h_X_true);
+
+    //the batched spmv matches the spmv of each matrix.
+    KokkosSparse::Experimental::spmv("N", 1, A, X_true, 0, B);
+    for (int b = 0; b < num_matrices; ++b){
+      crsMat_t Ab = A.matrix(b);
+      vector_t y("y", n);
+      KokkosSparse::spmv("N", 1, Ab, Kokkos::subview(X_true, b, Kokkos::ALL()), 0, y);
+      typename vector_t::HostMirror h_y = Kokkos::create_mirror_view(y);
+      Kokkos::deep_copy(h_y, y);
+      auto h_B = Kokkos::create_mirror_view(Kokkos::subview(B, b, Kokkos::ALL()));
+      Kokkos::deep_copy(h_B, Kokkos::subview(B, b, Kokkos::ALL()));
+      for (lno_t i = 0; i < n; ++i)
+        EXPECT_NEAR(Kokkos::Details::ArithTraits<scalar_t>::abs(h_y(i) - h_B(i)), 0, 1e-12);
+    }
+
+    iters_t iters("iters", num_matrices);
+    norms_t norms("norms", num_matrices);
+    for (int solver = 0; solver < 3; ++solver){
+      if (solver == 0 && !sym) continue;
+      mv_t X("X", num_matrices, n);
+      int nfailed = 0;
+      if (solver == 0)
+        nfailed = KokkosSparse::Experimental::batched_cg(A, B, X, tol, max_iters, iters, norms);
+      else if (solver == 1)
+        nfailed = KokkosSparse::Experimental::batched_bicgstab(A, B, X, tol, max_iters, iters, norms);
+      else
+        nfailed = KokkosSparse::Experimental::batched_gmres(A, B, X, tol, max_iters, 10, iters, norms);
+      EXPECT_EQ(nfailed, 0) << "solver " << solver;
+
+      typename iters_t::HostMirror h_iters = Kokkos::create_mirror_view(iters);
+      typename norms_t::HostMirror h_norms = Kokkos::create_mirror_view(norms);
+      typename mv_t::HostMirror h_X = Kokkos::create_mirror_view(X);
+      Kokkos::deep_copy(h_iters, iters);
+      Kokkos::deep_copy(h_norms, norms);
+      Kokkos::deep_copy(h_X, X);
+      for (int b = 0; b < num_matrices; ++b){
+        EXPECT_GT(h_iters(b), 0);
+        EXPECT_LE(h_iters(b), max_iters);
+        EXPECT_LE(h_norms(b), tol);
+        for (lno_t i = 0; i < n; ++i)
+          EXPECT_NEAR(Kokkos::Details::ArithTraits<scalar_t>::abs(h_X(b, i) - h_X_true(b, i)), 0, 1e-7);
+      }
+    }
+
+    //without the optional outputs, and with X already the solution.
+    EXPECT_EQ(KokkosSparse::Experimental::batched_gmres(A, B, X_true, tol, max_iters, 10), 0);
+    EXPECT_EQ(KokkosSparse::Experimental::batched_bicgstab(A, B, X_true, tol, max_iters), 0);
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## batched_solvers ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_batched_solvers<SCALAR,ORDINAL,OFFSET,DEVICE>(50, 16); \
+  test_batched_solvers<SCALAR,ORDINAL,OFFSET,DEVICE>(200, 5); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_block_jacobi.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosBlas1_fill.hpp"
+#include "KokkosBlas1_nrm2.hpp"
+
+namespace Test {
+
+// block diagonal matrix with dense, diagonally dominant blocks of
+// block_size consecutive rows, the last one smaller, and with its rows and
+// columns permuted by i -> (i * stride) % n.
+template <typename crsMat_t>
+crsMat_t block_jacobi_matrix(typename crsMat_t::ordinal_type n, typename crsMat_t::ordinal_type block_size,
+    typename crsMat_t::ordinal_type stride){
+  typedef typename crsMat_t::ordinal_type lno_t;
+  typedef typename crsMat_t::size_type size_type;
+  typedef typename crsMat_t::value_type scalar_t;
+  typedef typename crsMat_t::row_map_type::non_const_type row_map_t;
+  typedef typename crsMat_t::index_type::non_const_type entries_t;
+  typedef typename crsMat_t::values_type::non_const_type values_t;
+
+  std::vector<lno_t> perm(n), inv_perm(n);
+  for (lno_t i = 0; i < n; ++i){
+    perm[i] = (i * stride) % n;
+    inv_perm[perm[i]] = i;
+  }
+  std::vector<size_type> rows(1, 0);
+  std::vector<lno_t> cols;
+  std::vector<scalar_t> vals;
+  for (lno_t pi = 0; pi < n; ++pi){
+    const lno_t i = inv_perm[pi];
+    const lno_t begin = (i / block_size) * block_size;
+    const lno_t end = std::min(begin + block_size, n);
+    for (lno_t j = begin; j < end; ++j){
+      cols.push_back(perm[j]);
+      vals.push_back(i == j ? scalar_t(10 + i % 5) : scalar_t(-1 - 0.5 * ((i + j) % 3)));
+    }
+    rows.push_back(cols.size());
+  }
+  const size_type nnz = cols.size();
+  row_map_t row_map("row_map", n + 1);
+  entries_t entries("entries", nnz);
+  values_t values("values", nnz);
+  typename row_map_t::HostMirror h_row_map = Kokkos::create_mirror_view(row_map);
+  typename entries_t::HostMirror h_entries = Kokkos::create_mirror_view(entries);
+  typename values_t::HostMirror h_values = Kokkos::create_mirror_view(values);
+  for (lno_t i = 0; i <= n; ++i) h_row_map(i) = rows[i];
+  for (size_type k = 0; k < nnz; ++k){
+    h_entries(k) = cols[k];
+    h_values(k) = vals[k];
+  }
+  Kokkos::deep_copy(row_map, h_row_map);
+  Kokkos::deep_copy(entries, h_entries);
+  Kokkos::deep_copy(values, h_values);
+  return crsMat_t("block diagonal", n, n, nnz, values, row_map, entries);
+}
+
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_block_jacobi(lno_t n, lno_t block_size) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::execution_space exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef KokkosSparse::BlockJacobiHandle<lno_t, size_type, scalar_t, exec_space> handle_t;
+
+  scalar_view_t r("r", n);
+  scalar_view_t z("z", n);
+  scalar_view_t res("res", n);
+  KokkosBlas::fill(r, 1);
+  const double initial = KokkosBlas::nrm2(r);
+
+  //the blocks of the preconditioner are those of the matrix, so it solves exactly:
+  //with consecutive blocks for the unpermuted matrix, and with the graph partition for the permuted one.
+  for (int permuted = 0; permuted < 2; ++permuted){
+    crsMat_t A = Test::block_jacobi_matrix<crsMat_t>(n, block_size, permuted ? 7919 : 1);
+    handle_t handle(block_size, permuted ? KokkosSparse::BLOCK_JACOBI_GRAPH : KokkosSparse::BLOCK_JACOBI_CONTIGUOUS);
+    KokkosSparse::block_jacobi_numeric(handle, A);
+    EXPECT_EQ(handle.get_num_blocks(), (n + block_size - 1) / block_size);
+    KokkosSparse::block_jacobi_apply(handle, r, z);
+
+    Kokkos::deep_copy(res, r);
+    KokkosSparse::spmv("N", -1, A, z, 1, res);
+    EXPECT_LT(KokkosBlas::nrm2(res), 1e-10 * initial);
+  }
+
+  //smaller blocks than those of the matrix only approximate its inverse.
+  crsMat_t A = Test::block_jacobi_matrix<crsMat_t>(n, block_size, 1);
+  handle_t handle(block_size - 1);
+  KokkosSparse::block_jacobi_numeric(handle, A);
+  KokkosSparse::block_jacobi_apply(handle, r, z);
+  Kokkos::deep_copy(res, r);
+  KokkosSparse::spmv("N", -1, A, z, 1, res);
+  EXPECT_LT(KokkosBlas::nrm2(res), initial);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## block_jacobi ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_block_jacobi<SCALAR,ORDINAL,OFFSET,DEVICE>(202, 4); \
+  test_block_jacobi<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 7); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,141 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+
+#include<KokkosSparse_BlockCrsMatrix.hpp>
+#include<KokkosSparse_blockcrs_gauss_seidel.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+#include<cstdlib>     //for rand
+#include<vector>
+
+namespace Test {
+
+//block tridiagonal matrix with a few random off-diagonal blocks, so that
+//the block graph is not symmetric. Every point row is strictly diagonally
+//dominant, and y = A * ones.
+template <typename blockMat_t, typename vector_t>
+blockMat_t makeBlockDominantMatrix(
+    typename blockMat_t::ordinal_type nbrows,
+    typename blockMat_t::ordinal_type block_size,
+    vector_t &y)
+{
+  typedef typename blockMat_t::row_map_type::non_const_type size_type_view_t;
+  typedef typename blockMat_t::index_type::non_const_type lno_view_t;
+  typedef typename blockMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename size_type_view_t::non_const_value_type size_type;
+  typedef typename lno_view_t::non_const_value_type lno_t;
+  typedef typename scalar_view_t::non_const_value_type scalar_t;
+
+  srand(4321);
+  std::vector<size_type> rowmap(nbrows + 1, 0);
+  std::vector<lno_t> entries;
+  for (lno_t r = 0; r < nbrows; ++r){
+    for (lno_t c = 0; c < nbrows; ++c){
+      if ((c >= r - 1 && c <= r + 1) || rand() % (nbrows + 1) == 0) entries.push_back(c);
+    }
+    rowmap[r + 1] = entries.size();
+  }
+  const size_type nblocks = entries.size();
+  const lno_t bs = block_size;
+
+  std::vector<scalar_t> values(nblocks * bs * bs);
+  typename vector_t::HostMirror h_y = Kokkos::create_mirror_view(y);
+  for (lno_t r = 0; r < nbrows; ++r){
+    const size_type begin = rowmap[r];
+    const lno_t length = rowmap[r + 1] - begin;
+    for (lno_t i = 0; i < bs; ++i){
+      scalar_t *row = &values[begin * bs * bs + i * length * bs];
+      scalar_t offdiag_sum = 0;
+      lno_t diag_pos = 0;
+      for (lno_t K = 0; K < length; ++K){
+        for (lno_t j = 0; j < bs; ++j){
+          if (entries[begin + K] == r && i == j){
+            diag_pos = K * bs + j;
+            continue;
+          }
+          row[K * bs + j] = -(rand() % 100 + 1) / 100.0;
+          offdiag_sum += row[K * bs + j];
+        }
+      }
+      row[diag_pos] = -2 * offdiag_sum + 1;
+      h_y(r * bs + i) = row[diag_pos] + offdiag_sum;
+    }
+  }
+  Kokkos::deep_copy(y, h_y);
+
+  size_type_view_t d_rowmap("rowmap", nbrows + 1);
+  lno_view_t d_entries("entries", nblocks);
+  scalar_view_t d_values("values", values.size());
+  typename size_type_view_t::HostMirror h_rowmap = Kokkos::create_mirror_view(d_rowmap);
+  typename lno_view_t::HostMirror h_entries = Kokkos::create_mirror_view(d_entries);
+  typename scalar_view_t::HostMirror h_values = Kokkos::create_mirror_view(d_values);
+  for (lno_t r = 0; r <= nbrows; ++r) h_rowmap(r) = rowmap[r];
+  for (size_type k = 0; k < nblocks; ++k) h_entries(k) = entries[k];
+  for (size_t k = 0; k < values.size(); ++k) h_values(k) = values[k];
+  Kokkos::deep_copy(d_rowmap, h_rowmap);
+  Kokkos::deep_copy(d_entries, h_entries);
+  Kokkos::deep_copy(d_values, h_values);
+  return blockMat_t("block matrix", nbrows, nbrows, values.size(), d_values, d_rowmap, d_entries, block_size);
+}
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, class Device>
+void test_blockcrs_gauss_seidel(lno_t nbrows, lno_t block_size)
+{
+  typedef typename KokkosSparse::Experimental::BlockCrsMatrix<scalar_t, lno_t, Device, void, size_type> blockMat_t;
+  typedef typename blockMat_t::values_type::non_const_type scalar_view_t;
+
+  typedef typename KokkosKernels::Experimental::KokkosKernelsHandle<size_type, lno_t, scalar_t,
+  typename Device::execution_space, typename Device::memory_space, typename Device::memory_space> KernelHandle;
+
+  const lno_t n = nbrows * block_size;
+  scalar_view_t y("y", n);
+  scalar_view_t x("x", n);
+  scalar_view_t expected_x("expected_x", n);
+  Kokkos::deep_copy(expected_x, Kokkos::Details::ArithTraits<scalar_t>::one());
+
+  blockMat_t A = Test::makeBlockDominantMatrix<blockMat_t, scalar_view_t>(nbrows, block_size, y);
+
+  for (int apply_type = 0; apply_type < 3; ++apply_type){
+    KernelHandle kh;
+    kh.create_gs_handle();
+    KokkosSparse::Experimental::blockcrs_gauss_seidel_symbolic(&kh, A, false);
+    KokkosSparse::Experimental::blockcrs_gauss_seidel_numeric(&kh, A, false);
+    EXPECT_EQ(kh.get_gs_handle()->get_block_size(), block_size);
+
+    switch (apply_type){
+    case 0:
+      KokkosSparse::Experimental::symmetric_blockcrs_gauss_seidel_apply(&kh, A, x, y, true, 40);
+      break;
+    case 1:
+      KokkosSparse::Experimental::forward_sweep_blockcrs_gauss_seidel_apply(&kh, A, x, y, true, 80);
+      break;
+    default:
+      KokkosSparse::Experimental::backward_sweep_blockcrs_gauss_seidel_apply(&kh, A, x, y, true, 80);
+      break;
+    }
+    EXPECT_NEAR_KK_1DVIEW(expected_x, x, 1e-8);
+    kh.destroy_gs_handle();
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## blockcrs_gauss_seidel ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_blockcrs_gauss_seidel<SCALAR,ORDINAL,OFFSET,DEVICE>(1, 1); \
+  test_blockcrs_gauss_seidel<SCALAR,ORDINAL,OFFSET,DEVICE>(100, 1); \
+  test_blockcrs_gauss_seidel<SCALAR,ORDINAL,OFFSET,DEVICE>(100, 3); \
+  test_blockcrs_gauss_seidel<SCALAR,ORDINAL,OFFSET,DEVICE>(500, 6); \
+}
+
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
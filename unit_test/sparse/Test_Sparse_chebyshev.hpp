@@ -0,0 +1,223 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_chebyshev.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosBlas1_axpby.hpp"
+#include "KokkosBlas1_fill.hpp"
+#include "KokkosBlas1_nrm2.hpp"
+
+namespace Test {
+
+// 5-point Laplacian of a nx x nx grid.
+template <typename crsMat_t>
+crsMat_t chebyshev_grid_laplacian(typename crsMat_t::ordinal_type nx){
+  typedef typename crsMat_t::ordinal_type lno_t;
+  typedef typename crsMat_t::size_type size_type;
+  typedef typename crsMat_t::value_type scalar_t;
+  typedef typename crsMat_t::row_map_type::non_const_type row_map_t;
+  typedef typename crsMat_t::index_type::non_const_type entries_t;
+  typedef typename crsMat_t::values_type::non_const_type values_t;
+
+  const lno_t n = nx * nx;
+  std::vector<size_type> rows(1, 0);
+  std::vector<lno_t> cols;
+  std::vector<scalar_t> vals;
+  for (lno_t y = 0; y < nx; ++y){
+    for (lno_t x = 0; x < nx; ++x){
+      const lno_t v = x + nx * y;
+      cols.push_back(v); vals.push_back(4);
+      if (x > 0) {cols.push_back(v - 1); vals.push_back(-1);}
+      if (x < nx - 1) {cols.push_back(v + 1); vals.push_back(-1);}
+      if (y > 0) {cols.push_back(v - nx); vals.push_back(-1);}
+      if (y < nx - 1) {cols.push_back(v + nx); vals.push_back(-1);}
+      rows.push_back(cols.size());
+    }
+  }
+  const size_type nnz = cols.size();
+  row_map_t row_map("row_map", n + 1);
+  entries_t entries("entries", nnz);
+  values_t values("values", nnz);
+  typename row_map_t::HostMirror h_row_map = Kokkos::create_mirror_view(row_map);
+  typename entries_t::HostMirror h_entries = Kokkos::create_mirror_view(entries);
+  typename values_t::HostMirror h_values = Kokkos::create_mirror_view(values);
+  for (lno_t i = 0; i <= n; ++i) h_row_map(i) = rows[i];
+  for (size_type k = 0; k < nnz; ++k){
+    h_entries(k) = cols[k];
+    h_values(k) = vals[k];
+  }
+  Kokkos::deep_copy(row_map, h_row_map);
+  Kokkos::deep_copy(entries, h_entries);
+  Kokkos::deep_copy(values, h_values);
+  return crsMat_t("grid", n, n, nnz, values, row_map, entries);
+}
+
+// The same Laplacian as a matrix-free operator.
+template <typename scalar_view_t, typename lno_t, typename size_type>
+struct ChebyshevGridOperator {
+  typedef typename scalar_view_t::execution_space execution_space;
+  typedef typename scalar_view_t::non_const_value_type non_const_value_type;
+  typedef lno_t non_const_ordinal_type;
+  typedef size_type non_const_size_type;
+
+  lno_t nx;
+
+  ChebyshevGridOperator(lno_t nx_) : nx(nx_) {}
+
+  lno_t numRows() const {return nx * nx;}
+  lno_t numCols() const {return nx * nx;}
+
+  template <typename XVector, typename YVector>
+  struct ApplyFunctor {
+    lno_t nx;
+    XVector x;
+    YVector y;
+
+    ApplyFunctor(lno_t nx_, XVector x_, YVector y_) : nx(nx_), x(x_), y(y_) {}
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(const lno_t v) const {
+      const lno_t i = v % nx, j = v / nx;
+      non_const_value_type sum = 4 * x(v);
+      if (i > 0) sum -= x(v - 1);
+      if (i < nx - 1) sum -= x(v + 1);
+      if (j > 0) sum -= x(v - nx);
+      if (j < nx - 1) sum -= x(v + nx);
+      y(v) = sum;
+    }
+  };
+
+  template <typename XVector, typename YVector>
+  void apply(const XVector& x, const YVector& y) const {
+    Kokkos::parallel_for(Kokkos::RangePolicy<execution_space>(0, numRows()),
+                         ApplyFunctor<XVector, YVector>(nx, x, y));
+  }
+
+  template <typename DVector>
+  void diagonal(const DVector& d) const {
+    Kokkos::deep_copy(d, non_const_value_type(4));
+  }
+};
+
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_chebyshev(lno_t nx, int degree) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::execution_space exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef KokkosSparse::ChebyshevHandle<lno_t, size_type, scalar_t, exec_space> handle_t;
+  typedef typename handle_t::mag_t mag_t;
+
+  crsMat_t A = Test::chebyshev_grid_laplacian<crsMat_t>(nx);
+  const lno_t n = A.numRows();
+  //the largest eigenvalue of D^{-1} A.
+  const mag_t lambda_max = (1 + std::cos(std::acos(-1.0) / (nx + 1)));
+
+  //the power iterations estimate lambda_max from below, before the boost.
+  handle_t estimate_handle(degree);
+  estimate_handle.set_num_power_iterations(50);
+  KokkosSparse::chebyshev_setup(estimate_handle, A);
+  EXPECT_LE(estimate_handle.get_lambda_max(), estimate_handle.get_boost_factor() * lambda_max * (1 + 1e-10));
+  EXPECT_GE(estimate_handle.get_lambda_max(), 0.5 * lambda_max);
+
+  scalar_view_t x_true("x_true", n);
+  scalar_view_t b("b", n);
+  scalar_view_t x("x", n);
+  scalar_view_t r("r", n);
+  KokkosBlas::fill(x_true, 1);
+  KokkosSparse::spmv("N", 1, A, x_true, 0, b);
+  const mag_t initial = KokkosBlas::nrm2(b);
+
+  //Gershgorin bound on the eigenvalues of D^{-1} A.
+  handle_t handle(degree);
+  handle.set_lambda_max(2);
+  KokkosSparse::chebyshev_setup(handle, A);
+  EXPECT_EQ(handle.get_lambda_max(), 2);
+  KokkosSparse::chebyshev_apply(handle, A, x, b, true);
+  for (int k = 1; k < 20; ++k) {
+    KokkosSparse::chebyshev_apply(handle, A, x, b);
+  }
+  Kokkos::deep_copy(r, b);
+  KokkosSparse::spmv("N", -1, A, x, 1, r);
+  EXPECT_LT(KokkosBlas::nrm2(r), 0.2 * initial);
+
+  //the matrix-free operator gives the iterates of the matrix.
+  typedef Test::ChebyshevGridOperator<scalar_view_t, lno_t, size_type> operator_t;
+  operator_t op(nx);
+  scalar_view_t x_op("x_op", n);
+  handle_t op_handle(degree);
+  op_handle.set_lambda_max(2);
+  KokkosSparse::chebyshev_setup(op_handle, op);
+  KokkosSparse::chebyshev_apply(op_handle, op, x_op, b, true);
+  for (int k = 1; k < 20; ++k) {
+    KokkosSparse::chebyshev_apply(op_handle, op, x_op, b);
+  }
+  KokkosBlas::axpy(-1, x, x_op);
+  EXPECT_LT(KokkosBlas::nrm2(x_op), 1e-10 * KokkosBlas::nrm2(x));
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## chebyshev ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_chebyshev<SCALAR,ORDINAL,OFFSET,DEVICE>(20, 3); \
+  test_chebyshev<SCALAR,ORDINAL,OFFSET,DEVICE>(40, 5); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,138 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+//Writes a random matrix to a .kkcg file with the given number of rows per
+//block, reads its graph back and compares it with the sorted rows of the
+//matrix, then checks that a truncated block is rejected.
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_compressed_graph(lno_t nrows, lno_t ncols, size_type nnz, size_t rows_per_block) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef Kokkos::View<size_type *, Kokkos::HostSpace> row_map_view_t;
+  typedef Kokkos::View<lno_t *, Kokkos::HostSpace> entries_view_t;
+
+  const std::string filename("KokkosSparse_compressed_graph_test.kkcg");
+  crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(nrows, ncols, nnz, 2, ncols / 2 + 1);
+
+  typename crsMat_t::row_map_type::HostMirror h_row_map = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror h_entries = Kokkos::create_mirror_view(A.graph.entries);
+  Kokkos::deep_copy(h_row_map, A.graph.row_map);
+  Kokkos::deep_copy(h_entries, A.graph.entries);
+  KokkosKernels::Impl::write_graph_compressed<lno_t, size_type>(nrows, ncols,
+      h_row_map.data(), h_entries.data(), filename.c_str(), rows_per_block);
+
+  {
+    KokkosKernels::Impl::kk_mapped_graph_file mapped(filename.c_str());
+    EXPECT_EQ(mapped.header().nrows, uint64_t(nrows));
+    EXPECT_EQ(mapped.header().ncols, uint64_t(ncols));
+    ASSERT_EQ(mapped.header().nnz, uint64_t(A.nnz()));
+
+    row_map_view_t row_map("row_map", nrows + 1);
+    entries_view_t entries("entries", A.nnz());
+    mapped.decode(row_map, entries);
+
+    size_t num_errors = 0;
+    for (lno_t i = 0; i <= nrows; ++i)
+      if (row_map(i) != h_row_map(i)) ++num_errors;
+    for (lno_t i = 0; i < nrows && num_errors == 0; ++i) {
+      std::vector<lno_t> row(h_entries.data() + h_row_map(i), h_entries.data() + h_row_map(i + 1));
+      std::sort(row.begin(), row.end());
+      for (size_type k = h_row_map(i); k < h_row_map(i + 1); ++k)
+        if (entries(k) != row[k - h_row_map(i)]) ++num_errors;
+    }
+    EXPECT_TRUE(num_errors == 0);
+  }
+
+  crsMat_t B = KokkosKernels::Impl::read_kokkos_crst_matrix<crsMat_t>(filename.c_str());
+  EXPECT_EQ(B.numRows(), A.numRows());
+  EXPECT_EQ(B.nnz(), A.nnz());
+
+  if (nrows > 0) {
+    //the last byte ends a variable-byte integer, make it continue past the end
+    FILE *fp = fopen(filename.c_str(), "r+b");
+    ASSERT_TRUE(fp != NULL);
+    fseek(fp, -1, SEEK_END);
+    fputc(0x80, fp);
+    fclose(fp);
+
+    bool rejected = false;
+    try {
+      KokkosKernels::Impl::kk_mapped_graph_file mapped(filename.c_str());
+      row_map_view_t row_map("row_map", nrows + 1);
+      entries_view_t entries("entries", A.nnz());
+      mapped.decode(row_map, entries);
+    }
+    catch (std::runtime_error &) { rejected = true; }
+    EXPECT_TRUE(rejected);
+  }
+  std::remove(filename.c_str());
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## compressed_graph ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_compressed_graph<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000, 20000, 1); \
+  test_compressed_graph<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000, 20000, 1024); \
+  test_compressed_graph<SCALAR,ORDINAL,OFFSET,DEVICE>(50, 3000, 40000, 7); \
+  test_compressed_graph<SCALAR,ORDINAL,OFFSET,DEVICE>(20000, 20000, 400000, 256); \
+  test_compressed_graph<SCALAR,ORDINAL,OFFSET,DEVICE>(10, 10, 0, 4); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,115 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <map>
+#include <utility>
+#include <cmath>
+#include <cstdlib>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_coo2crs.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_coo2crs(lno_t nrows, lno_t ncols, size_t num_triplets) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef Kokkos::View<lno_t*, Kokkos::HostSpace> host_lno_view_t;
+  typedef Kokkos::View<scalar_t*, Kokkos::HostSpace> host_scalar_view_t;
+
+  //triplets on the host, with many duplicates
+  host_lno_view_t rows("rows", num_triplets), cols("cols", num_triplets);
+  host_scalar_view_t vals("vals", num_triplets);
+  std::map<std::pair<lno_t, lno_t>, scalar_t> reference;
+  srand(245);
+  for (size_t k = 0; k < num_triplets; ++k){
+    rows(k) = rand() % nrows;
+    cols(k) = rand() % ncols;
+    vals(k) = scalar_t(rand() % 100) / 10;
+    reference[std::make_pair(rows(k), cols(k))] += vals(k);
+  }
+
+  crsMat_t A = KokkosSparse::Experimental::coo2crs<crsMat_t>(nrows, ncols, rows, cols, vals);
+  EXPECT_EQ(A.numRows(), nrows);
+  EXPECT_EQ(A.numCols(), ncols);
+  ASSERT_EQ(size_t(A.nnz()), reference.size());
+
+  typename crsMat_t::row_map_type::HostMirror h_row_map = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror h_entries = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror h_values = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(h_row_map, A.graph.row_map);
+  Kokkos::deep_copy(h_entries, A.graph.entries);
+  Kokkos::deep_copy(h_values, A.values);
+
+  //the map is ordered by (row, column), like the matrix
+  typename std::map<std::pair<lno_t, lno_t>, scalar_t>::const_iterator it = reference.begin();
+  size_t num_errors = 0;
+  for (lno_t i = 0; i < nrows; ++i){
+    for (size_type j = h_row_map(i); j < h_row_map(i + 1); ++j, ++it){
+      if (it->first.first != i || it->first.second != h_entries(j) ||
+          std::abs(it->second - h_values(j)) > 1e-10 * (1 + std::abs(it->second))) ++num_errors;
+    }
+  }
+  EXPECT_TRUE(num_errors == 0);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## coo2crs ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_coo2crs<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000, 20000); \
+  test_coo2crs<SCALAR,ORDINAL,OFFSET,DEVICE>(50, 3000, 40000); \
+  test_coo2crs<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 10, 100); \
+  test_coo2crs<SCALAR,ORDINAL,OFFSET,DEVICE>(10, 10, 0); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
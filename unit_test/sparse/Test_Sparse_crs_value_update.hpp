@@ -0,0 +1,223 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <vector>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_crs_value_update.hpp"
+#include "KokkosSparse_gauss_seidel.hpp"
+#include "KokkosSparse_transpose.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_crs_value_update(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::execution_space exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef Kokkos::View<lno_t*, device> lno_view_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  typedef typename ATS::mag_type mag_t;
+  const mag_t eps = 1e3 * Kokkos::Details::ArithTraits<mag_t>::epsilon();
+
+  crsMat_t A = KokkosKernels::Impl::kk_generate_diagonally_dominant_sparse_matrix<crsMat_t>
+    (numRows, numRows, nnz, row_size_variance, bandwidth);
+  typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(hr, A.graph.row_map);
+  Kokkos::deep_copy(he, A.graph.entries);
+  Kokkos::deep_copy(hv, A.values);
+
+  //a stream of every entry, then every third entry again, then one entry
+  //per row out of the pattern, which is ignored.
+  std::vector<lno_t> rows, cols;
+  std::vector<size_type> pos;
+  for (lno_t i = 0; i < numRows; ++i)
+    for (size_type j = hr(i); j < hr(i + 1); ++j){ rows.push_back(i); cols.push_back(he(j)); pos.push_back(j); }
+  for (size_type j = 0; j < A.nnz(); j += 3){ rows.push_back(rows[j]); cols.push_back(cols[j]); pos.push_back(pos[j]); }
+  const size_t num_valid = rows.size();
+  for (lno_t i = 0; i < numRows; ++i){
+    lno_t col = 0;
+    bool found = true;
+    while (found && col < numRows){
+      found = false;
+      for (size_type j = hr(i); j < hr(i + 1); ++j) found = found || he(j) == col;
+      if (found) ++col;
+    }
+    if (col < numRows){ rows.push_back(i); cols.push_back(col); pos.push_back(A.nnz()); }
+  }
+  const size_t n = rows.size();
+  lno_view_t d_rows("rows", n), d_cols("cols", n);
+  scalar_view_t d_vals("vals", n);
+  typename lno_view_t::HostMirror h_rows = Kokkos::create_mirror_view(d_rows);
+  typename lno_view_t::HostMirror h_cols = Kokkos::create_mirror_view(d_cols);
+  typename scalar_view_t::HostMirror h_vals = Kokkos::create_mirror_view(d_vals);
+  for (size_t k = 0; k < n; ++k){
+    h_rows(k) = rows[k];
+    h_cols(k) = cols[k];
+    h_vals(k) = scalar_t(1 + k % 5);
+  }
+  Kokkos::deep_copy(d_rows, h_rows);
+  Kokkos::deep_copy(d_cols, h_cols);
+  Kokkos::deep_copy(d_vals, h_vals);
+
+  //the sums of the stream, and the values kept by a replace.
+  std::vector<scalar_t> sums(A.nnz(), ATS::zero());
+  for (size_t k = 0; k < num_valid; ++k) sums[pos[k]] += h_vals(k);
+
+  for (int cached = 0; cached < 2; ++cached){
+    KokkosSparse::Experimental::CrsValueMap<crsMat_t> map;
+    if (cached){
+      map = KokkosSparse::Experimental::CrsValueMap<crsMat_t>(A, d_rows, d_cols);
+      EXPECT_EQ(map.numEntries(), n);
+      EXPECT_EQ(map.numValid(), num_valid);
+      EXPECT_TRUE(map.is_map_for(A));
+    }
+
+    size_t version = A.valuesVersion();
+    if (cached) map.sum_into(A, d_vals, true);
+    else {
+      Kokkos::deep_copy(A.values, ATS::zero());
+      EXPECT_EQ(KokkosSparse::Experimental::sum_into_values(A, d_rows, d_cols, d_vals), num_valid);
+    }
+    EXPECT_EQ(A.valuesVersion(), version + 1);
+    Kokkos::deep_copy(hv, A.values);
+    for (size_type j = 0; j < A.nnz(); ++j)
+      EXPECT_NEAR(ATS::abs(hv(j) - sums[j]), 0, eps * (1 + ATS::abs(sums[j])));
+
+    //replace with one value per entry, as the repeated entries may keep any value.
+    scalar_view_t d_replace("replace", n);
+    typename scalar_view_t::HostMirror h_replace = Kokkos::create_mirror_view(d_replace);
+    for (size_t k = 0; k < n; ++k) h_replace(k) = scalar_t(pos[k] % 7) + scalar_t(cached);
+    Kokkos::deep_copy(d_replace, h_replace);
+    version = A.valuesVersion();
+    if (cached) map.replace(A, d_replace);
+    else EXPECT_EQ(KokkosSparse::Experimental::replace_values(A, d_rows, d_cols, d_replace), num_valid);
+    EXPECT_EQ(A.valuesVersion(), version + 1);
+    Kokkos::deep_copy(hv, A.values);
+    for (size_type j = 0; j < A.nnz(); ++j)
+      EXPECT_EQ(hv(j), scalar_t(j % 7) + scalar_t(cached));
+  }
+
+  //the transpose handle tells whether the values changed since the last gather.
+  KokkosSparse::TransposeHandle<lno_t, size_type, exec_space> th;
+  crsMat_t AT = KokkosSparse::transpose(th, A);
+  EXPECT_TRUE(th.are_values_current(A.values.data(), A.valuesVersion(), AT.values.data()));
+  KokkosSparse::Experimental::sum_into_values(A, d_rows, d_cols, d_vals);
+  EXPECT_FALSE(th.are_values_current(A.values.data(), A.valuesVersion(), AT.values.data()));
+  KokkosSparse::transpose_values(th, A, AT);
+  EXPECT_TRUE(th.are_values_current(A.values.data(), A.valuesVersion(), AT.values.data()));
+
+  //the Gauss-Seidel numeric phase is redone only after a value update.
+  {
+    typedef KokkosKernels::Experimental::KokkosKernelsHandle
+        <size_type, lno_t, scalar_t,
+        typename device::execution_space, typename device::memory_space, typename device::memory_space > KernelHandle;
+    //a diagonally dominant matrix again.
+    Kokkos::deep_copy(hv, A.values);
+    for (lno_t i = 0; i < numRows; ++i){
+      scalar_t off = ATS::zero();
+      for (size_type j = hr(i); j < hr(i + 1); ++j) if (he(j) != i) off += ATS::abs(hv(j));
+      for (size_type j = hr(i); j < hr(i + 1); ++j) if (he(j) == i) hv(j) = 2 * off + 1;
+    }
+    Kokkos::deep_copy(A.values, hv);
+    A.bumpValuesVersion();
+
+    KernelHandle kh, kh_ref;
+    kh.create_gs_handle(KokkosSparse::GS_DEFAULT);
+    KokkosSparse::Experimental::gauss_seidel_update_values(&kh, A);
+    EXPECT_TRUE(kh.get_gs_handle()->is_numeric_called_for(A.values.data(), A.valuesVersion()));
+
+    //add the values once more; the handle sees the new version.
+    KokkosSparse::Experimental::CrsValueMap<crsMat_t> map(A, d_rows, d_cols);
+    scalar_view_t d_twice("twice", n);
+    for (size_t k = 0; k < n; ++k) h_vals(k) = k < num_valid ? hv(pos[k]) : ATS::zero();
+    Kokkos::deep_copy(d_twice, h_vals);
+    map.sum_into(A, d_twice, false);
+    EXPECT_FALSE(kh.get_gs_handle()->is_numeric_called_for(A.values.data(), A.valuesVersion()));
+    KokkosSparse::Experimental::gauss_seidel_update_values(&kh, A);
+    EXPECT_TRUE(kh.get_gs_handle()->is_numeric_called_for(A.values.data(), A.valuesVersion()));
+
+    kh_ref.create_gs_handle(KokkosSparse::GS_DEFAULT);
+    KokkosSparse::Experimental::gauss_seidel_symbolic(&kh_ref, numRows, numRows, A.graph.row_map, A.graph.entries);
+    KokkosSparse::Experimental::gauss_seidel_numeric(&kh_ref, numRows, numRows, A.graph.row_map, A.graph.entries, A.values);
+
+    scalar_view_t b("b", numRows), x("x", numRows), x_ref("x ref", numRows);
+    Kokkos::deep_copy(b, scalar_t(1));
+    KokkosSparse::Experimental::symmetric_gauss_seidel_apply
+      (&kh, numRows, numRows, A.graph.row_map, A.graph.entries, A.values, x, b, true, true, 2);
+    KokkosSparse::Experimental::symmetric_gauss_seidel_apply
+      (&kh_ref, numRows, numRows, A.graph.row_map, A.graph.entries, A.values, x_ref, b, true, true, 2);
+    exec_space::fence();
+    typename scalar_view_t::HostMirror hx = Kokkos::create_mirror_view(x);
+    typename scalar_view_t::HostMirror hx_ref = Kokkos::create_mirror_view(x_ref);
+    Kokkos::deep_copy(hx, x);
+    Kokkos::deep_copy(hx_ref, x_ref);
+    for (lno_t i = 0; i < numRows; ++i)
+      EXPECT_NEAR(ATS::abs(hx(i) - hx_ref(i)), 0, eps * (1 + ATS::abs(hx_ref(i))));
+    kh.destroy_gs_handle();
+    kh_ref.destroy_gs_handle();
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## crs_value_update ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_crs_value_update<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000 * 20, 200, 10); \
+  test_crs_value_update<SCALAR,ORDINAL,OFFSET,DEVICE>(50, 50 * 5, 50, 2); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
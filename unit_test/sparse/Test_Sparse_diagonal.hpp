@@ -0,0 +1,136 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_diagonal.hpp"
+#include "KokkosSparse_getDiagCopy.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_diagonal(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::execution_space exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  typedef typename ATS::mag_type mag_t;
+  typedef Kokkos::Details::ArithTraits<mag_t> ATM;
+
+  crsMat_t A = KokkosKernels::Impl::kk_generate_diagonally_dominant_sparse_matrix<crsMat_t>
+    (numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(hr, A.graph.row_map);
+  Kokkos::deep_copy(he, A.graph.entries);
+  Kokkos::deep_copy(hv, A.values);
+  std::vector<scalar_t> diag(numRows, ATS::zero());
+  for (lno_t i = 0; i < numRows; ++i){
+    for (size_type j = hr(i); j < hr(i + 1); ++j){
+      if (he(j) == i) diag[i] = hv(j);
+    }
+  }
+
+  KokkosSparse::DiagonalHandle<lno_t, size_type, exec_space> handle;
+  typename KokkosSparse::DiagonalHandle<lno_t, size_type, exec_space>::offsets_view_t offsets =
+    KokkosSparse::get_diagonal_offsets(handle, A);
+  //the offsets are kept for the following calls.
+  EXPECT_TRUE(KokkosSparse::get_diagonal_offsets(handle, A).data() == offsets.data());
+
+  scalar_view_t d("diagonal", numRows);
+  KokkosSparse::getDiagCopy(d, offsets, A);
+  scalar_view_t inv_d("inverse diagonal", numRows);
+  KokkosSparse::get_inverse_diagonal(handle, A, inv_d);
+  typename scalar_view_t::HostMirror hd = Kokkos::create_mirror_view(d);
+  typename scalar_view_t::HostMirror hinv_d = Kokkos::create_mirror_view(inv_d);
+  Kokkos::deep_copy(hd, d);
+  Kokkos::deep_copy(hinv_d, inv_d);
+  const mag_t eps = 1e3 * ATM::epsilon();
+  for (lno_t i = 0; i < numRows; ++i){
+    EXPECT_EQ(hd(i), diag[i]);
+    const scalar_t expected = diag[i] == ATS::zero() ? ATS::one() : ATS::one() / diag[i];
+    EXPECT_NEAR(ATS::abs(hinv_d(i) - expected), 0, eps * ATS::abs(expected));
+  }
+
+  scalar_view_t inv_sqrt_d("inverse square root diagonal", numRows);
+  scalar_view_t inv_d2("inverse diagonal", numRows);
+  KokkosSparse::symmetric_diagonal_scale(handle, A, inv_sqrt_d, inv_d2);
+  typename crsMat_t::values_type::HostMirror hv_scaled = Kokkos::create_mirror_view(A.values);
+  typename scalar_view_t::HostMirror hinv_d2 = Kokkos::create_mirror_view(inv_d2);
+  Kokkos::deep_copy(hv_scaled, A.values);
+  Kokkos::deep_copy(hinv_d2, inv_d2);
+  std::vector<scalar_t> s(numRows, ATS::one());
+  for (lno_t i = 0; i < numRows; ++i){
+    EXPECT_EQ(hinv_d2(i), hinv_d(i));
+    if (diag[i] != ATS::zero()) s[i] = ATM::one() / ATM::sqrt(ATS::abs(diag[i]));
+  }
+  for (lno_t i = 0; i < numRows; ++i){
+    for (size_type j = hr(i); j < hr(i + 1); ++j){
+      const scalar_t expected = s[i] * hv(j) * s[he(j)];
+      EXPECT_NEAR(ATS::abs(hv_scaled(j) - expected), 0, eps * ATS::abs(expected));
+    }
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## diagonal ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_diagonal<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000 * 30, 200, 10); \
+  test_diagonal<SCALAR,ORDINAL,OFFSET,DEVICE>(50, 50 * 5, 50, 2); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,218 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+
+#include<KokkosSparse_CrsMatrix.hpp>
+#include<KokkosSparse_spgemm_normal.hpp>
+#include<KokkosKernels_SparseUtils.hpp>
+#include<KokkosKernels_IOUtils.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+#include<vector>
+
+#ifndef kokkos_complex_double
+#define kokkos_complex_double Kokkos::complex<double>
+#define kokkos_complex_float Kokkos::complex<float>
+#endif
+
+namespace Test {
+
+template <typename crsMat_t, typename device>
+void check_spgemm_normal(crsMat_t A, KokkosSparse::Experimental::SpgemmNormalProduct product) {
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type lno_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_nnz_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+
+  typedef typename lno_view_t::value_type size_type;
+  typedef typename lno_nnz_view_t::value_type lno_t;
+  typedef typename scalar_view_t::value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> KAT;
+  typedef typename KAT::mag_type mag_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  const bool a_at = product == KokkosSparse::Experimental::SPGEMM_A_AT;
+  const lno_t m = A.numRows();
+  const lno_t n = A.numCols();
+  const lno_t c_rows = a_at ? m : n;
+
+  //the rows of A must be sorted.
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "KokkosBatched_Vector.hpp"
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosSparse_gauss_seidel.hpp"
+#include "KokkosSparse_gauss_seidel_ensemble.hpp"
+#include "KokkosBlas1_ensemble.hpp"
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+namespace Test {
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_ensemble(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  enum : int { l = 4 };
+  typedef KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef KokkosBatched::Experimental::Vector<KokkosBatched::Experimental::SIMD<scalar_t>, l> ensemble_t;
+  typedef KokkosSparse::CrsMatrix<ensemble_t, lno_t, device, void, size_type> ensMat_t;
+  typedef typename ensMat_t::values_type::non_const_type ens_values_t;
+  typedef Kokkos::View<ensemble_t*, device> ens_view_t;
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+       typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  crsMat_t A = KokkosKernels::Impl::kk_generate_diagonally_dominant_sparse_matrix<crsMat_t>(
+      numRows, numRows, nnz, row_size_variance, bandwidth);
+  const size_type annz = A.nnz();
+
+  //member m of the ensemble scales the off-diagonal entries of A by
+  //1 / (1 + m), which keeps every member diagonally dominant.
+  typename crsMat_t::row_map_type::HostMirror h_rm = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror h_ent = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror h_val = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(h_rm, A.graph.row_map);
+  Kokkos::deep_copy(h_ent, A.graph.entries);
+  Kokkos::deep_copy(h_val, A.values);
+
+  ens_values_t values_e("values_e", annz);
+  typename ens_values_t::HostMirror h_val_e = Kokkos::create_mirror_view(values_e);
+  for (lno_t i = 0; i < numRows; ++i) {
+    for (size_type k = h_rm(i); k < h_rm(i + 1); ++k) {
+      for (int m = 0; m < l; ++m)
+        h_val_e(k)[m] = h_ent(k) == i ? h_val(k) : h_val(k) / scalar_t(1 + m);
+    }
+  }
+  Kokkos::deep_copy(values_e, h_val_e);
+  ensMat_t E("E", A.numCols(), values_e, A.graph);
+
+  ens_view_t x("x", numRows), y("y", numRows);
+  typename ens_view_t::HostMirror h_x = Kokkos::create_mirror_view(x);
+  typename ens_view_t::HostMirror h_y = Kokkos::create_mirror_view(y);
+  for (lno_t i = 0; i < numRows; ++i) {
+    for (int m = 0; m < l; ++m) {
+      h_x(i)[m] = scalar_t(1) + scalar_t(i % 7) / 4 + m;
+      h_y(i)[m] = scalar_t(i % 3) - m;
+    }
+  }
+  Kokkos::deep_copy(x, h_x);
+  Kokkos::deep_copy(y, h_y);
+
+  //host reference y = beta*y + alpha*E*x, member by member.
+  ensemble_t alpha, beta;
+  for (int m = 0; m < l; ++m) {
+    alpha[m] = scalar_t(1.5) + m;
+    beta[m] = scalar_t(m) / 2;
+  }
+  std::vector<scalar_t> ref(numRows * l), ref_mag(numRows * l);
+  for (lno_t i = 0; i < numRows; ++i) {
+    for (int m = 0; m < l; ++m) {
+      scalar_t sum = 0, mag = 0;
+      for (size_type k = h_rm(i); k < h_rm(i + 1); ++k) {
+        sum += h_val_e(k)[m] * h_x(h_ent(k))[m];
+        mag += std::abs(h_val_e(k)[m] * h_x(h_ent(k))[m]);
+      }
+      ref[i * l + m] = beta[m] * h_y(i)[m] + alpha[m] * sum;
+      ref_mag[i * l + m] = std::abs(beta[m] * h_y(i)[m]) + std::abs(alpha[m]) * mag;
+    }
+  }
+
+  KokkosSparse::spmv("N", alpha, E, x, beta, y);
+  Kokkos::deep_copy(h_y, y);
+  for (lno_t i = 0; i < numRows; ++i) {
+    for (int m = 0; m < l; ++m)
+      EXPECT_NEAR(h_y(i)[m], ref[i * l + m], 1e-12 * (1 + ref_mag[i * l + m])) << "row " << i << " member " << m;
+  }
+
+  //the transpose modes are not supported for ensemble matrices.
+  EXPECT_THROW(KokkosSparse::spmv("T", alpha, E, x, beta, y), std::runtime_error);
+
+  //BLAS1: the reductions return one result per member.
+  const ensemble_t d = KokkosBlas::Experimental::ensemble_dot(x, y);
+  const ensemble_t n = KokkosBlas::Experimental::ensemble_nrm2(x);
+  for (int m = 0; m < l; ++m) {
+    scalar_t ref_d = 0, ref_n = 0, ref_d_mag = 0;
+    for (lno_t i = 0; i < numRows; ++i) {
+      ref_d += h_x(i)[m] * h_y(i)[m];
+      ref_d_mag += std::abs(h_x(i)[m] * h_y(i)[m]);
+      ref_n += h_x(i)[m] * h_x(i)[m];
+    }
+    EXPECT_NEAR(d[m], ref_d, 1e-12 * (1 + ref_d_mag)) << "member " << m;
+    EXPECT_NEAR(n[m], std::sqrt(ref_n), 1e-12 * (1 + std::sqrt(ref_n))) << "member " << m;
+  }
+  KokkosBlas::Experimental::ensemble_axpby(alpha, x, scalar_t(-1), y);
+  typename ens_view_t::HostMirror h_y2 = Kokkos::create_mirror_view(y);
+  Kokkos::deep_copy(h_y2, y);
+  for (lno_t i = 0; i < numRows; ++i) {
+    for (int m = 0; m < l; ++m)
+      EXPECT_NEAR(h_y2(i)[m], alpha[m] * h_x(i)[m] - h_y(i)[m],
+                  1e-12 * (1 + std::abs(alpha[m] * h_x(i)[m]) + std::abs(h_y(i)[m])));
+  }
+
+  //Gauss-Seidel: the coloring of the graph, computed once with the member
+  //scalar type, drives the sweeps of all the members. Solve E x = b with b = E x_ref.
+  ens_view_t b("b", numRows), x_gs("x_gs", numRows);
+  KokkosSparse::spmv("N", ensemble_t(1), E, x, ensemble_t(0), b);
+
+  KernelHandle kh;
+  kh.create_gs_handle(KokkosSparse::GS_DEFAULT);
+  KokkosSparse::Experimental::gauss_seidel_symbolic(
+      &kh, numRows, numRows, A.graph.row_map, A.graph.entries, false);
+  KokkosSparse::Experimental::ensemble_symmetric_gauss_seidel_apply(
+      &kh, numRows, numRows, A.graph.row_map, A.graph.entries, values_e, x_gs, b, true, 50);
+  kh.destroy_gs_handle();
+
+  typename ens_view_t::HostMirror h_x_gs = Kokkos::create_mirror_view(x_gs);
+  Kokkos::deep_copy(h_x_gs, x_gs);
+  for (int m = 0; m < l; ++m) {
+    scalar_t err = 0, nrm = 0;
+    for (lno_t i = 0; i < numRows; ++i) {
+      err += (h_x_gs(i)[m] - h_x(i)[m]) * (h_x_gs(i)[m] - h_x(i)[m]);
+      nrm += h_x(i)[m] * h_x(i)[m];
+    }
+    EXPECT_LT(std::sqrt(err), 1e-6 * std::sqrt(nrm)) << "member " << m;
+  }
+}
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## ensemble ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_ensemble<SCALAR,ORDINAL,OFFSET,DEVICE>(10, 30, 5, 2); \
+  test_ensemble<SCALAR,ORDINAL,OFFSET,DEVICE>(2000, 2000 * 12, 100, 4); \
+}
+
+//ensemble matrices are header only: no ETI is needed for the ensemble scalar,
+//only for the member scalar used by gauss_seidel_symbolic.
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
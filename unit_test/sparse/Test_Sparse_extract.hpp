@@ -0,0 +1,160 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_extract.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_extract(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance, lno_t block_size) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef Kokkos::View<lno_t*, device> lno_view_t;
+  typedef Kokkos::View<scalar_t***, device> blocks_view_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+
+  crsMat_t A = KokkosKernels::Impl::kk_generate_diagonally_dominant_sparse_matrix<crsMat_t>
+    (numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(hr, A.graph.row_map);
+  Kokkos::deep_copy(he, A.graph.entries);
+  Kokkos::deep_copy(hv, A.values);
+
+  //every third row, backwards, with the first one twice; the columns not 1 mod 4, backwards.
+  std::vector<lno_t> rows, cols, col_map(numRows, -1);
+  for (lno_t i = numRows - 1; i >= 0; i -= 3) rows.push_back(i);
+  rows.push_back(rows[0]);
+  for (lno_t j = numRows - 1; j >= 0; --j){
+    if (j % 4 != 1){
+      col_map[j] = cols.size();
+      cols.push_back(j);
+    }
+  }
+  lno_view_t d_rows("rows", rows.size()), d_cols("cols", cols.size());
+  typename lno_view_t::HostMirror h_rows = Kokkos::create_mirror_view(d_rows);
+  typename lno_view_t::HostMirror h_cols = Kokkos::create_mirror_view(d_cols);
+  for (size_t i = 0; i < rows.size(); ++i) h_rows(i) = rows[i];
+  for (size_t j = 0; j < cols.size(); ++j) h_cols(j) = cols[j];
+  Kokkos::deep_copy(d_rows, h_rows);
+  Kokkos::deep_copy(d_cols, h_cols);
+
+  crsMat_t S = KokkosSparse::extract_submatrix(A, d_rows, d_cols);
+  EXPECT_EQ(S.numRows(), lno_t(rows.size()));
+  EXPECT_EQ(S.numCols(), lno_t(cols.size()));
+  typename crsMat_t::row_map_type::HostMirror hsr = Kokkos::create_mirror_view(S.graph.row_map);
+  typename crsMat_t::index_type::HostMirror hse = Kokkos::create_mirror_view(S.graph.entries);
+  typename crsMat_t::values_type::HostMirror hsv = Kokkos::create_mirror_view(S.values);
+  Kokkos::deep_copy(hsr, S.graph.row_map);
+  Kokkos::deep_copy(hse, S.graph.entries);
+  Kokkos::deep_copy(hsv, S.values);
+  size_type pos = 0;
+  for (size_t i = 0; i < rows.size(); ++i){
+    ASSERT_EQ(hsr(i), pos);
+    for (size_type k = hr(rows[i]); k < hr(rows[i] + 1); ++k){
+      if (col_map[he(k)] < 0) continue;
+      ASSERT_EQ(hse(pos), col_map[he(k)]);
+      EXPECT_EQ(hsv(pos), hv(k));
+      ++pos;
+    }
+  }
+  EXPECT_EQ(hsr(rows.size()), pos);
+  EXPECT_EQ(size_type(S.nnz()), pos);
+
+  //a column given twice.
+  h_cols(1) = h_cols(0);
+  Kokkos::deep_copy(d_cols, h_cols);
+  EXPECT_ANY_THROW(KokkosSparse::extract_submatrix(A, d_rows, d_cols));
+
+  //the diagonal blocks, the last one completed with the identity.
+  const lno_t numBlocks = KokkosSparse::num_diagonal_blocks(A, block_size);
+  EXPECT_EQ(numBlocks, (numRows + block_size - 1) / block_size);
+  blocks_view_t blocks("blocks", numBlocks, block_size, block_size);
+  KokkosSparse::extract_diagonal_blocks(A, block_size, blocks);
+  typename blocks_view_t::HostMirror hb = Kokkos::create_mirror_view(blocks);
+  Kokkos::deep_copy(hb, blocks);
+  std::vector<scalar_t> dense(block_size * block_size);
+  for (lno_t b = 0; b < numBlocks; ++b){
+    std::fill(dense.begin(), dense.end(), ATS::zero());
+    for (lno_t li = 0; li < block_size; ++li){
+      const lno_t i = b * block_size + li;
+      if (i >= numRows){
+        dense[li * block_size + li] = ATS::one();
+        continue;
+      }
+      for (size_type k = hr(i); k < hr(i + 1); ++k){
+        const lno_t lj = he(k) - b * block_size;
+        if (lj >= 0 && lj < block_size) dense[li * block_size + lj] += hv(k);
+      }
+    }
+    for (lno_t li = 0; li < block_size; ++li)
+      for (lno_t lj = 0; lj < block_size; ++lj)
+        EXPECT_EQ(hb(b, li, lj), dense[li * block_size + lj]);
+  }
+  blocks_view_t wrong("wrong", numBlocks + 1, block_size, block_size);
+  EXPECT_ANY_THROW(KokkosSparse::extract_diagonal_blocks(A, block_size, wrong));
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## extract ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_extract<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000 * 30, 200, 10, 8); \
+  test_extract<SCALAR,ORDINAL,OFFSET,DEVICE>(50, 50 * 5, 50, 2, 7); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
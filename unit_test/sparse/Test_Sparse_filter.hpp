@@ -0,0 +1,158 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_filter.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_filter(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  typedef typename ATS::mag_type mag_t;
+
+  crsMat_t A = KokkosKernels::Impl::kk_generate_diagonally_dominant_sparse_matrix<crsMat_t>
+    (numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(hr, A.graph.row_map);
+  Kokkos::deep_copy(he, A.graph.entries);
+  Kokkos::deep_copy(hv, A.values);
+
+  //mixed signs off the diagonal, so that the classical criterion drops some entries.
+  for (lno_t i = 0; i < numRows; ++i){
+    for (size_type j = hr(i); j < hr(i + 1); ++j){
+      if (he(j) != i && j % 3 != 0) hv(j) = -hv(j);
+    }
+  }
+  Kokkos::deep_copy(A.values, hv);
+
+  std::vector<mag_t> d(numRows, 0), m(numRows, 0);
+  for (lno_t i = 0; i < numRows; ++i){
+    scalar_t diag = ATS::zero();
+    for (size_type j = hr(i); j < hr(i + 1); ++j){
+      if (he(j) == i) diag += hv(j);
+      else m[i] = std::max(m[i], mag_t(-ATS::real(hv(j))));
+    }
+    d[i] = std::sqrt(ATS::abs(diag));
+  }
+
+  const KokkosSparse::SparseFilterCriterion criteria[3] =
+    {KokkosSparse::FILTER_ABSOLUTE, KokkosSparse::FILTER_SYMMETRIC, KokkosSparse::FILTER_CLASSICAL};
+  for (int c = 0; c < 3; ++c){
+    for (int keep_diagonal = 0; keep_diagonal < 2; ++keep_diagonal){
+      const mag_t theta = criteria[c] == KokkosSparse::FILTER_ABSOLUTE ? mag_t(5) : mag_t(0.25);
+      crsMat_t F = KokkosSparse::filter_matrix(A, criteria[c], theta, keep_diagonal);
+      typename crsMat_t::staticcrsgraph_type G = KokkosSparse::filter_graph(A, criteria[c], theta, keep_diagonal);
+
+      typename crsMat_t::row_map_type::HostMirror hfr = Kokkos::create_mirror_view(F.graph.row_map);
+      typename crsMat_t::index_type::HostMirror hfe = Kokkos::create_mirror_view(F.graph.entries);
+      typename crsMat_t::values_type::HostMirror hfv = Kokkos::create_mirror_view(F.values);
+      typename crsMat_t::row_map_type::HostMirror hgr = Kokkos::create_mirror_view(G.row_map);
+      typename crsMat_t::index_type::HostMirror hge = Kokkos::create_mirror_view(G.entries);
+      Kokkos::deep_copy(hfr, F.graph.row_map);
+      Kokkos::deep_copy(hfe, F.graph.entries);
+      Kokkos::deep_copy(hfv, F.values);
+      Kokkos::deep_copy(hgr, G.row_map);
+      Kokkos::deep_copy(hge, G.entries);
+      EXPECT_EQ(F.numRows(), numRows);
+      EXPECT_EQ(F.numCols(), A.numCols());
+      EXPECT_EQ(hfr(numRows), size_type(F.nnz()));
+      EXPECT_EQ(G.entries.extent(0), F.graph.entries.extent(0));
+
+      //the kept entries of each row, in the order of A.
+      size_type pos = 0, dropped = 0;
+      for (lno_t i = 0; i < numRows; ++i){
+        ASSERT_EQ(hfr(i), pos);
+        ASSERT_EQ(hgr(i), pos);
+        for (size_type j = hr(i); j < hr(i + 1); ++j){
+          const lno_t col = he(j);
+          bool keep;
+          if (col == i) keep = keep_diagonal;
+          else if (criteria[c] == KokkosSparse::FILTER_ABSOLUTE) keep = ATS::abs(hv(j)) >= theta;
+          else if (criteria[c] == KokkosSparse::FILTER_SYMMETRIC) keep = ATS::abs(hv(j)) >= theta * d[i] * d[col];
+          else keep = m[i] > 0 && -ATS::real(hv(j)) >= theta * m[i];
+          if (!keep){
+            ++dropped;
+            continue;
+          }
+          ASSERT_EQ(hfe(pos), col);
+          ASSERT_EQ(hge(pos), col);
+          EXPECT_EQ(hfv(pos), hv(j));
+          ++pos;
+        }
+      }
+      EXPECT_EQ(hfr(numRows), pos);
+      EXPECT_GT(dropped, size_type(0));
+    }
+  }
+
+  //a zero threshold of the absolute criterion keeps every entry.
+  crsMat_t F = KokkosSparse::filter_matrix(A, KokkosSparse::FILTER_ABSOLUTE, mag_t(0));
+  EXPECT_EQ(F.nnz(), A.nnz());
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## filter ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_filter<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000 * 30, 200, 10); \
+  test_filter<SCALAR,ORDINAL,OFFSET,DEVICE>(50, 50 * 5, 50, 2); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
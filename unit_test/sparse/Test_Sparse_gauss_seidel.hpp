@@ -51,10 +51,13 @@
 #include <KokkosSparse_spmv.hpp>
 #include <KokkosBlas1_dot.hpp>
 #include <KokkosBlas1_axpby.hpp>
+#include <KokkosBlas1_scal.hpp>
 #include <cstdlib>
 #include <iostream>
 #include <complex>
 #include "KokkosSparse_gauss_seidel.hpp"
+#include "KokkosSparse_sor_sequential_impl.hpp"
+#include "KokkosKernels_GraphCapture.hpp"
 
 #ifndef kokkos_complex_double
 #define kokkos_complex_double Kokkos::complex<double>
@@ -76,7 +79,10 @@ int run_gauss_seidel_1(
     bool is_symmetric_graph,
     int apply_type = 0, // 0 for symmetric, 1 for forward, 2 for backward.
     bool skip_symbolic = false,
-    bool skip_numeric = false
+    bool skip_numeric = false,
+    int fused_color_size = 0,
+    bool in_place = false,
+    int long_row_threshold = 0
     ){
   typedef typename crsMat_t::StaticCrsGraphType graph_t;
   typedef typename graph_t::row_map_type lno_view_t;
@@ -99,7 +105,9 @@ int run_gauss_seidel_1(
   kh.set_team_work_size(16);
   kh.set_dynamic_scheduling(true);
   kh.create_gs_handle(gs_algorithm);
-
+  kh.get_gs_handle()->set_fused_color_size(fused_color_size);
+  kh.get_gs_handle()->set_in_place(in_place);
+  kh.get_gs_handle()->set_long_row_threshold(long_row_threshold);
 
   const size_t num_rows_1 = input_mat.numRows();
   const size_t num_cols_1 = input_mat.numCols();
@@ -196,13 +204,13 @@ void test_gauss_seidel(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_
   const scalar_view_t solution_x = create_x_vector<scalar_view_t>(nv);
   scalar_view_t y_vector = create_y_vector(input_mat, solution_x);
 #ifdef gauss_seidel_testmore
-  GSAlgorithm gs_algorithms[] ={GS_DEFAULT, GS_TEAM, GS_PERMUTED};
+  GSAlgorithm gs_algorithms[] ={GS_DEFAULT, GS_TEAM, GS_PERMUTED, GS_TWOSTAGE, GS_HYBRID};
   int apply_count = 3;
-  for (int ii = 0; ii < 3; ++ii){
+  for (int ii = 0; ii < 5; ++ii){
 #else
   int apply_count = 1;
-  GSAlgorithm gs_algorithms[] ={GS_DEFAULT};
-  for (int ii = 0; ii < 1; ++ii){
+  GSAlgorithm gs_algorithms[] ={GS_DEFAULT, GS_TWOSTAGE, GS_HYBRID};
+  for (int ii = 0; ii < 3; ++ii){
 #endif
     GSAlgorithm gs_algorithm = gs_algorithms[ii];
     scalar_view_t x_vector ("x vector", nv);
@@ -245,6 +253,230 @@ void test_gauss_seidel(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_
       }
     }
   }
+
+  //all colors fused into a single launch per sweep, then the in place mode,
+  //then the team sweeps with the rows longer than the average given a team each.
+  for (int mode = 0; mode < 3; ++mode)
+  for (int apply_type = 0; apply_type < 3; ++apply_type){
+    scalar_view_t x_vector ("x vector", nv);
+    const scalar_t alpha = 1.0;
+    KokkosBlas::axpby(alpha, solution_x, -alpha, x_vector);
+    typedef typename Kokkos::Details::ArithTraits<scalar_t>::mag_type mag_t;
+    mag_t initial_norm_res = Kokkos::Details::ArithTraits<scalar_t>::abs (KokkosBlas::dot( x_vector , x_vector ));
+    initial_norm_res  = Kokkos::Details::ArithTraits<mag_t>::sqrt( initial_norm_res );
+    Kokkos::deep_copy (x_vector , 0);
+
+    if (mode == 0)
+      run_gauss_seidel_1<crsMat_t, device>(input_mat, GS_DEFAULT, x_vector, y_vector, false, apply_type, false, false, numRows);
+    else if (mode == 1)
+      run_gauss_seidel_1<crsMat_t, device>(input_mat, GS_DEFAULT, x_vector, y_vector, false, apply_type, false, false, 0, true);
+    else
+      run_gauss_seidel_1<crsMat_t, device>(input_mat, GS_TEAM, x_vector, y_vector, false, apply_type, false, false, 0, false,
+          input_mat.nnz() / numRows);
+
+    KokkosBlas::axpby(alpha, solution_x, -alpha, x_vector);
+    mag_t result_norm_res  = Kokkos::Details::ArithTraits<scalar_t>::abs( KokkosBlas::dot( x_vector , x_vector ) );
+    result_norm_res = Kokkos::Details::ArithTraits<mag_t>::sqrt(result_norm_res);
+    EXPECT_TRUE( (result_norm_res < initial_norm_res));
+  }
+
+  //a recorded and replayed apply gives the same iterates as the eager ones.
+  {
+    typedef KokkosKernelsHandle
+        <size_type, lno_t, scalar_t,
+        typename device::execution_space, typename device::memory_space, typename device::memory_space > KernelHandle;
+    KernelHandle kh;
+    kh.create_gs_handle(GS_DEFAULT);
+    gauss_seidel_symbolic
+      (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, false);
+    gauss_seidel_numeric
+      (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, false);
+
+    scalar_view_t x_eager ("x eager", nv), x_replay ("x replay", nv);
+    for (int i = 0; i < 3; ++i)
+      symmetric_gauss_seidel_apply
+        (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x_eager, y_vector, false, true, 1);
+
+    auto sweep = [&](){
+      symmetric_gauss_seidel_apply
+        (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x_replay, y_vector, false, true, 1);
+    };
+    sweep();
+    KokkosKernels::Experimental::GraphCapture<typename device::execution_space> graph;
+    graph.capture(sweep);
+    graph.replay(2);
+    device::execution_space::fence();
+
+    typename scalar_view_t::HostMirror h_eager = Kokkos::create_mirror_view(x_eager);
+    typename scalar_view_t::HostMirror h_replay = Kokkos::create_mirror_view(x_replay);
+    Kokkos::deep_copy(h_eager, x_eager);
+    Kokkos::deep_copy(h_replay, x_replay);
+    for (lno_t i = 0; i < nv; ++i)
+      EXPECT_EQ(h_eager(i), h_replay(i));
+    kh.destroy_gs_handle();
+  }
+
+  //GS_HYBRID with one block is sequential SOR, and with several blocks the
+  //damped symmetric sweeps still converge.
+  {
+    typedef KokkosKernelsHandle
+        <size_type, lno_t, scalar_t,
+        typename device::execution_space, typename device::memory_space, typename device::memory_space > KernelHandle;
+    typedef typename Kokkos::Details::ArithTraits<scalar_t>::mag_type mag_t;
+    for (int num_blocks = 1; num_blocks <= 4; num_blocks += 3){
+      const scalar_t omega = num_blocks == 1 ? 1.2 : 0.9;
+      KernelHandle kh;
+      kh.create_gs_handle(GS_HYBRID);
+      kh.get_gs_handle()->set_num_hybrid_blocks(num_blocks);
+      kh.get_gs_handle()->set_damping_factor(omega);
+      EXPECT_EQ(kh.get_gs_handle()->get_damping_factor(), omega);
+      gauss_seidel_symbolic
+        (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, false);
+      gauss_seidel_numeric
+        (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, false);
+      EXPECT_EQ(kh.get_gs_handle()->get_hybrid_block_rows().extent(0), size_t(num_blocks + 1));
+
+      scalar_view_t x_vector ("x vector", nv);
+      if (num_blocks == 1){
+        forward_sweep_gauss_seidel_apply
+          (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x_vector, y_vector, true, true, 2);
+
+        auto h_row_map = Kokkos::create_mirror_view(input_mat.graph.row_map);
+        auto h_entries = Kokkos::create_mirror_view(input_mat.graph.entries);
+        auto h_values = Kokkos::create_mirror_view(input_mat.values);
+        auto h_y = Kokkos::create_mirror_view(y_vector);
+        auto h_x = Kokkos::create_mirror_view(x_vector);
+        Kokkos::deep_copy(h_row_map, input_mat.graph.row_map);
+        Kokkos::deep_copy(h_entries, input_mat.graph.entries);
+        Kokkos::deep_copy(h_values, input_mat.values);
+        Kokkos::deep_copy(h_y, y_vector);
+        Kokkos::deep_copy(h_x, x_vector);
+        std::vector<size_type> ptr(h_row_map.data(), h_row_map.data() + nv + 1);
+        std::vector<scalar_t> inv_diag(nv), x_ref(nv);
+        for (lno_t i = 0; i < nv; ++i)
+          for (size_type k = ptr[i]; k < ptr[i + 1]; ++k)
+            if (h_entries(k) == i) inv_diag[i] = scalar_t(1) / h_values(k);
+        for (int sweep = 0; sweep < 2; ++sweep)
+          KokkosSparse::Impl::Sequential::gaussSeidel<lno_t, size_type, scalar_t, scalar_t, scalar_t>
+            (nv, 1, &ptr[0], h_entries.data(), h_values.data(), h_y.data(), nv, &x_ref[0], nv, &inv_diag[0], omega, "F");
+        for (lno_t i = 0; i < nv; ++i)
+          EXPECT_NEAR(Kokkos::Details::ArithTraits<scalar_t>::abs(h_x(i) - x_ref[i]), 0,
+                      1000 * Kokkos::Details::ArithTraits<mag_t>::epsilon() * (1 + Kokkos::Details::ArithTraits<scalar_t>::abs(x_ref[i])));
+      }
+      else {
+        symmetric_gauss_seidel_apply
+          (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x_vector, y_vector, true, true, 20);
+        const scalar_t alpha = 1.0;
+        mag_t initial_norm_res = Kokkos::Details::ArithTraits<mag_t>::sqrt(
+            Kokkos::Details::ArithTraits<scalar_t>::abs(KokkosBlas::dot(solution_x, solution_x)));
+        KokkosBlas::axpby(alpha, solution_x, -alpha, x_vector);
+        mag_t result_norm_res = Kokkos::Details::ArithTraits<mag_t>::sqrt(
+            Kokkos::Details::ArithTraits<scalar_t>::abs(KokkosBlas::dot(x_vector, x_vector)));
+        EXPECT_LT(result_norm_res, 0.5 * initial_norm_res);
+      }
+      kh.destroy_gs_handle();
+    }
+  }
+
+  //the first sweep from a zero initial vector, which reads only the entries
+  //of the rows it has already updated, gives the iterates of the full sweeps.
+  {
+    typedef KokkosKernelsHandle
+        <size_type, lno_t, scalar_t,
+        typename device::execution_space, typename device::memory_space, typename device::memory_space > KernelHandle;
+    typedef typename Kokkos::Details::ArithTraits<scalar_t>::mag_type mag_t;
+    GSAlgorithm zero_x_algorithms[] = {GS_PERMUTED, GS_TEAM};
+    for (int ii = 0; ii < 2; ++ii)
+    for (int apply_type = 0; apply_type < 3; ++apply_type){
+      KernelHandle kh;
+      kh.create_gs_handle(zero_x_algorithms[ii]);
+      gauss_seidel_symbolic
+        (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, false);
+      gauss_seidel_numeric
+        (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, false);
+      EXPECT_EQ(kh.get_gs_handle()->get_permuted_lower_end().extent(0), size_t(nv));
+
+      scalar_view_t x_zero ("x zero", nv), x_full ("x full", nv);
+      for (int init_zero = 1; init_zero >= 0; --init_zero){
+        scalar_view_t x = init_zero ? x_zero : x_full;
+        if (apply_type == 0)
+          symmetric_gauss_seidel_apply
+            (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x, y_vector, init_zero, true, 2);
+        else if (apply_type == 1)
+          forward_sweep_gauss_seidel_apply
+            (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x, y_vector, init_zero, true, 2);
+        else
+          backward_sweep_gauss_seidel_apply
+            (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x, y_vector, init_zero, true, 2);
+      }
+
+      typename scalar_view_t::HostMirror h_zero = Kokkos::create_mirror_view(x_zero);
+      typename scalar_view_t::HostMirror h_full = Kokkos::create_mirror_view(x_full);
+      Kokkos::deep_copy(h_zero, x_zero);
+      Kokkos::deep_copy(h_full, x_full);
+      for (lno_t i = 0; i < nv; ++i)
+        EXPECT_NEAR(Kokkos::Details::ArithTraits<scalar_t>::abs(h_zero(i) - h_full(i)), 0,
+                    1000 * Kokkos::Details::ArithTraits<mag_t>::epsilon() * (1 + Kokkos::Details::ArithTraits<scalar_t>::abs(h_full(i))));
+      kh.destroy_gs_handle();
+    }
+  }
+
+  //the applies of a multivector, all of its columns swept together, give
+  //the iterates of the applies of each column.
+  {
+    typedef KokkosKernelsHandle
+        <size_type, lno_t, scalar_t,
+        typename device::execution_space, typename device::memory_space, typename device::memory_space > KernelHandle;
+    typedef Kokkos::View<scalar_t**, Kokkos::LayoutLeft, device> scalar_mv_t;
+    typedef typename Kokkos::Details::ArithTraits<scalar_t>::mag_type mag_t;
+    const int num_vectors = 5;
+    for (int apply_type = 0; apply_type < 3; ++apply_type){
+      KernelHandle kh;
+      kh.create_gs_handle(GS_DEFAULT);
+      gauss_seidel_symbolic
+        (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, false);
+      gauss_seidel_numeric
+        (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, false);
+
+      scalar_mv_t x_mv ("x mv", nv, num_vectors), y_mv ("y mv", nv, num_vectors);
+      for (int k = 0; k < num_vectors; ++k)
+        KokkosBlas::scal(Kokkos::subview(y_mv, Kokkos::ALL(), k), scalar_t(k + 1), y_vector);
+      if (apply_type == 0)
+        symmetric_gauss_seidel_apply
+          (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x_mv, y_mv, true, true, 2);
+      else if (apply_type == 1)
+        forward_sweep_gauss_seidel_apply
+          (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x_mv, y_mv, true, true, 2);
+      else
+        backward_sweep_gauss_seidel_apply
+          (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x_mv, y_mv, true, true, 2);
+
+      typename scalar_mv_t::HostMirror h_x_mv = Kokkos::create_mirror_view(x_mv);
+      Kokkos::deep_copy(h_x_mv, x_mv);
+      for (int k = 0; k < num_vectors; ++k){
+        scalar_view_t x_k ("x k", nv), y_k ("y k", nv);
+        Kokkos::deep_copy(y_k, Kokkos::subview(y_mv, Kokkos::ALL(), k));
+        if (apply_type == 0)
+          symmetric_gauss_seidel_apply
+            (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x_k, y_k, true, true, 2);
+        else if (apply_type == 1)
+          forward_sweep_gauss_seidel_apply
+            (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x_k, y_k, true, true, 2);
+        else
+          backward_sweep_gauss_seidel_apply
+            (&kh, nv, nv, input_mat.graph.row_map, input_mat.graph.entries, input_mat.values, x_k, y_k, true, true, 2);
+
+        typename scalar_view_t::HostMirror h_x_k = Kokkos::create_mirror_view(x_k);
+        Kokkos::deep_copy(h_x_k, x_k);
+        const mag_t eps = 1e-3;
+        for (lno_t i = 0; i < nv; ++i){
+          const mag_t diff = Kokkos::Details::ArithTraits<scalar_t>::abs(h_x_mv(i, k) - h_x_k(i));
+          EXPECT_TRUE(diff <= eps * (1 + Kokkos::Details::ArithTraits<scalar_t>::abs(h_x_k(i))));
+        }
+      }
+      kh.destroy_gs_handle();
+    }
+  }
   //device::execution_space::finalize();
 }
 
@@ -0,0 +1,164 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_SparseUtils.hpp"
+
+//Counts the rows of A that are not sorted, have duplicate or out of range
+//entries, or, with check_symmetric, entries without their transpose.
+template <typename crsMat_t>
+size_t count_generated_errors(const crsMat_t &A, bool check_sorted, bool check_symmetric) {
+  typedef typename crsMat_t::non_const_ordinal_type lno_t;
+  typedef typename crsMat_t::non_const_size_type size_type;
+  typename crsMat_t::row_map_type::HostMirror rm = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror e = Kokkos::create_mirror_view(A.graph.entries);
+  Kokkos::deep_copy(rm, A.graph.row_map);
+  Kokkos::deep_copy(e, A.graph.entries);
+
+  size_t num_errors = 0;
+  for (lno_t i = 0; i < A.numRows(); ++i) {
+    for (size_type k = rm(i); k < rm(i + 1); ++k) {
+      if (e(k) < 0 || e(k) >= A.numCols()) ++num_errors;
+      if (check_sorted && k > rm(i) && e(k) <= e(k - 1)) ++num_errors;
+      if (!check_sorted)
+        for (size_type j = rm(i); j < k; ++j)
+          if (e(j) == e(k)) ++num_errors;
+      if (check_symmetric) {
+        bool found = false;
+        for (size_type j = rm(e(k)); j < rm(e(k) + 1) && !found; ++j)
+          found = (e(j) == i);
+        if (!found) ++num_errors;
+      }
+    }
+  }
+  return num_errors;
+}
+
+template <typename crsMat_t>
+bool is_identical_matrix(const crsMat_t &A, const crsMat_t &B) {
+  typedef typename crsMat_t::execution_space exec_space;
+  typedef typename Kokkos::Details::ArithTraits<typename crsMat_t::non_const_value_type>::mag_type mag_t;
+  if (A.numRows() != B.numRows() || A.numCols() != B.numCols() || A.nnz() != B.nnz()) return false;
+  return KokkosKernels::Impl::kk_is_identical_view
+      <typename crsMat_t::row_map_type, typename crsMat_t::row_map_type, typename crsMat_t::non_const_size_type, exec_space>(A.graph.row_map, B.graph.row_map, 0) &&
+    KokkosKernels::Impl::kk_is_identical_view
+      <typename crsMat_t::index_type, typename crsMat_t::index_type, typename crsMat_t::non_const_ordinal_type, exec_space>(A.graph.entries, B.graph.entries, 0) &&
+    KokkosKernels::Impl::kk_is_identical_view
+      <typename crsMat_t::values_type, typename crsMat_t::values_type, mag_t, exec_space>(A.values, B.values, mag_t(0));
+}
+
+//Generates each kind of matrix twice, checks that they are identical
+//and that their patterns are valid.
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_generators(lno_t n) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+
+  {
+    size_type nnz = 20 * size_type(n), nnz2 = nnz;
+    crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix_parallel<crsMat_t>(n, n, nnz, 10, 100);
+    crsMat_t B = KokkosKernels::Impl::kk_generate_sparse_matrix_parallel<crsMat_t>(n, n, nnz2, 10, 100);
+    EXPECT_EQ(nnz, size_type(A.nnz()));
+    EXPECT_TRUE(is_identical_matrix(A, B));
+    EXPECT_EQ(count_generated_errors(A, false, false), size_t(0));
+
+    nnz2 = 20 * size_type(n);
+    crsMat_t C = KokkosKernels::Impl::kk_generate_sparse_matrix_parallel<crsMat_t>(n, n, nnz2, 10, 100, 42);
+    EXPECT_FALSE(is_identical_matrix(A, C));
+  }
+  {
+    size_type nnz = 20 * size_type(n), nnz2 = nnz;
+    crsMat_t A = KokkosKernels::Impl::kk_generate_diagonally_dominant_sparse_matrix_parallel<crsMat_t>(n, n, nnz, 10, 100);
+    crsMat_t B = KokkosKernels::Impl::kk_generate_diagonally_dominant_sparse_matrix_parallel<crsMat_t>(n, n, nnz2, 10, 100);
+    EXPECT_TRUE(is_identical_matrix(A, B));
+    EXPECT_EQ(count_generated_errors(A, false, false), size_t(0));
+  }
+  {
+    crsMat_t A = KokkosKernels::Impl::kk_generate_banded_matrix<crsMat_t>(n, n, 3, 2);
+    crsMat_t B = KokkosKernels::Impl::kk_generate_banded_matrix<crsMat_t>(n, n, 3, 2);
+    EXPECT_EQ(size_type(A.nnz()), 6 * size_type(n) - 9);
+    EXPECT_TRUE(is_identical_matrix(A, B));
+    EXPECT_EQ(count_generated_errors(A, true, false), size_t(0));
+#ifdef KOKKOS_ENABLE_OPENMP
+    //on OpenMP the entries are touched first by the row blocks of the raw
+    //OpenMP spmv, which are kept on the graph.
+    if (std::is_same<typename crsMat_t::execution_space, Kokkos::OpenMP>::value)
+      EXPECT_EQ(int(A.graph.row_block_offsets.extent(0)), omp_get_max_threads() + 1);
+#endif
+  }
+  {
+    crsMat_t A = KokkosKernels::Impl::kk_generate_laplacian_matrix<crsMat_t>(n, 7);
+    EXPECT_EQ(size_type(A.nnz()), 5 * size_type(n) * 7 - 2 * (size_type(n) + 7));
+    EXPECT_EQ(count_generated_errors(A, true, true), size_t(0));
+
+    crsMat_t B = KokkosKernels::Impl::kk_generate_laplacian_matrix<crsMat_t>(5, 6, 7);
+    EXPECT_EQ(size_type(B.nnz()), size_type(7 * 210 - 2 * (42 + 35 + 30)));
+    EXPECT_EQ(count_generated_errors(B, true, true), size_t(0));
+  }
+  {
+    crsMat_t A = KokkosKernels::Impl::kk_generate_rmat_matrix<crsMat_t>(10, 8);
+    crsMat_t B = KokkosKernels::Impl::kk_generate_rmat_matrix<crsMat_t>(10, 8);
+    EXPECT_EQ(A.numRows(), lno_t(1024));
+    EXPECT_TRUE(A.nnz() > 0 && size_type(A.nnz()) <= size_type(2 * 8 * 1024));
+    EXPECT_TRUE(is_identical_matrix(A, B));
+    EXPECT_EQ(count_generated_errors(A, true, true), size_t(0));
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## generators ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_generators<SCALAR,ORDINAL,OFFSET,DEVICE>(1000); \
+  test_generators<SCALAR,ORDINAL,OFFSET,DEVICE>(20000); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
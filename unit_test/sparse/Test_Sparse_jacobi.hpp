@@ -0,0 +1,152 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_jacobi.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosBlas1_nrm2.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_jacobi(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::execution_space exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef KokkosSparse::JacobiHandle<lno_t, size_type, scalar_t, exec_space> handle_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  typedef typename ATS::mag_type mag_t;
+  typedef Kokkos::Details::ArithTraits<mag_t> ATM;
+
+  crsMat_t A = KokkosKernels::Impl::kk_generate_diagonally_dominant_sparse_matrix<crsMat_t>
+    (numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(hr, A.graph.row_map);
+  Kokkos::deep_copy(he, A.graph.entries);
+  Kokkos::deep_copy(hv, A.values);
+
+  scalar_view_t b("b", numRows), x0("x0", numRows);
+  typename scalar_view_t::HostMirror hb = Kokkos::create_mirror_view(b);
+  typename scalar_view_t::HostMirror hx0 = Kokkos::create_mirror_view(x0);
+  for (lno_t i = 0; i < numRows; ++i){
+    hb(i) = scalar_t(1 + i % 7);
+    hx0(i) = scalar_t(0.5 * (i % 3));
+  }
+  Kokkos::deep_copy(b, hb);
+  Kokkos::deep_copy(x0, hx0);
+  const mag_t eps = 1e3 * ATM::epsilon();
+
+  for (int l1 = 0; l1 < 2; ++l1){
+    handle_t handle(l1 ? KokkosSparse::JACOBI_L1 : KokkosSparse::JACOBI_DAMPED);
+    KokkosSparse::jacobi_setup(handle, A);
+    const scalar_t omega = handle.get_damping_factor();
+
+    //two sweeps against the sweeps of the host copy.
+    std::vector<scalar_t> d(numRows, ATS::zero()), x(hx0.data(), hx0.data() + numRows), x_new(numRows);
+    for (lno_t i = 0; i < numRows; ++i){
+      for (size_type j = hr(i); j < hr(i + 1); ++j){
+        if (he(j) == i) d[i] += hv(j);
+        else if (l1) d[i] += ATS::abs(hv(j));
+      }
+    }
+    for (int sweep = 0; sweep < 2; ++sweep){
+      for (lno_t i = 0; i < numRows; ++i){
+        scalar_t r = hb(i);
+        for (size_type j = hr(i); j < hr(i + 1); ++j) r -= hv(j) * x[he(j)];
+        x_new[i] = x[i] + omega * r / d[i];
+      }
+      x.swap(x_new);
+    }
+    scalar_view_t x_dev("x", numRows);
+    Kokkos::deep_copy(x_dev, x0);
+    KokkosSparse::jacobi_apply(handle, A, x_dev, b, 2);
+    typename scalar_view_t::HostMirror hx = Kokkos::create_mirror_view(x_dev);
+    Kokkos::deep_copy(hx, x_dev);
+    for (lno_t i = 0; i < numRows; ++i)
+      EXPECT_NEAR(ATS::abs(hx(i) - x[i]), 0, eps * (1 + ATS::abs(x[i])));
+
+    //a zero initial guess ignores the input x.
+    scalar_view_t x_zero("x zero", numRows), x_ref("x ref", numRows);
+    Kokkos::deep_copy(x_zero, x0);
+    KokkosSparse::jacobi_apply(handle, A, x_zero, b, 3, true);
+    KokkosSparse::jacobi_apply(handle, A, x_ref, b, 3);
+    typename scalar_view_t::HostMirror hx_zero = Kokkos::create_mirror_view(x_zero);
+    typename scalar_view_t::HostMirror hx_ref = Kokkos::create_mirror_view(x_ref);
+    Kokkos::deep_copy(hx_zero, x_zero);
+    Kokkos::deep_copy(hx_ref, x_ref);
+    for (lno_t i = 0; i < numRows; ++i)
+      EXPECT_NEAR(ATS::abs(hx_zero(i) - hx_ref(i)), 0, eps * (1 + ATS::abs(hx_ref(i))));
+
+    //the sweeps converge on the diagonally dominant matrix.
+    scalar_view_t r("r", numRows);
+    KokkosSparse::jacobi_apply(handle, A, x_zero, b, 20);
+    Kokkos::deep_copy(r, b);
+    KokkosSparse::spmv("N", -1, A, x_zero, 1, r);
+    EXPECT_LT(KokkosBlas::nrm2(r), 1e-3 * KokkosBlas::nrm2(b));
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## jacobi ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_jacobi<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000 * 30, 200, 10); \
+  test_jacobi<SCALAR,ORDINAL,OFFSET,DEVICE>(50, 50 * 5, 50, 2); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
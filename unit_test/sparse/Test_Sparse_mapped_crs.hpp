@@ -0,0 +1,157 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+//Writes a random matrix to a .kkcrs file, maps it back and compares,
+//then checks that a mismatched type and a corrupted file are rejected.
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_mapped_crs(lno_t nrows, lno_t ncols, size_type nnz) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef KokkosKernels::Impl::kk_mapped_crs_file<lno_t, size_type, scalar_t> mapped_t;
+
+  const std::string filename("KokkosSparse_mapped_crs_test.kkcrs");
+  crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(nrows, ncols, nnz, 2, ncols / 2 + 1);
+  KokkosKernels::Impl::write_kokkos_crst_matrix(A, filename.c_str());
+
+  typename crsMat_t::row_map_type::HostMirror h_row_map = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror h_entries = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror h_values = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(h_row_map, A.graph.row_map);
+  Kokkos::deep_copy(h_entries, A.graph.entries);
+  Kokkos::deep_copy(h_values, A.values);
+
+  {
+    mapped_t mapped(filename.c_str(), true);
+    EXPECT_EQ(mapped.numRows(), A.numRows());
+    EXPECT_EQ(mapped.numCols(), A.numCols());
+    ASSERT_EQ(mapped.nnz(), size_type(A.nnz()));
+    EXPECT_FALSE(mapped.isSymmetric());
+
+    size_t num_errors = 0;
+    for (lno_t i = 0; i <= nrows; ++i)
+      if (mapped.row_map()(i) != h_row_map(i)) ++num_errors;
+    for (size_type k = 0; k < mapped.nnz(); ++k)
+      if (mapped.entries()(k) != h_entries(k) || mapped.values()(k) != h_values(k)) ++num_errors;
+    EXPECT_TRUE(num_errors == 0);
+  }
+
+  crsMat_t B = KokkosKernels::Impl::read_kokkos_crst_matrix<crsMat_t>(filename.c_str());
+  EXPECT_EQ(B.numRows(), A.numRows());
+  EXPECT_EQ(B.numCols(), A.numCols());
+  EXPECT_EQ(B.nnz(), A.nnz());
+
+  {
+    //the smallest staging buffers, so that the arrays are streamed in many chunks
+    crsMat_t C = KokkosKernels::Impl::read_kokkos_crst_matrix_streamed<crsMat_t>(filename.c_str(), 1, true);
+    ASSERT_EQ(C.nnz(), A.nnz());
+    typename crsMat_t::row_map_type::HostMirror c_row_map = Kokkos::create_mirror_view(C.graph.row_map);
+    typename crsMat_t::index_type::HostMirror c_entries = Kokkos::create_mirror_view(C.graph.entries);
+    typename crsMat_t::values_type::HostMirror c_values = Kokkos::create_mirror_view(C.values);
+    Kokkos::deep_copy(c_row_map, C.graph.row_map);
+    Kokkos::deep_copy(c_entries, C.graph.entries);
+    Kokkos::deep_copy(c_values, C.values);
+
+    size_t num_errors = 0;
+    for (lno_t i = 0; i <= nrows; ++i)
+      if (c_row_map(i) != h_row_map(i)) ++num_errors;
+    for (size_type k = 0; k < size_type(C.nnz()); ++k)
+      if (c_entries(k) != h_entries(k) || c_values(k) != h_values(k)) ++num_errors;
+    EXPECT_TRUE(num_errors == 0);
+  }
+
+  bool rejected = false;
+  try {
+    KokkosKernels::Impl::kk_mapped_crs_file<lno_t, size_type, float> mapped(filename.c_str());
+  }
+  catch (std::runtime_error &) { rejected = true; }
+  EXPECT_TRUE(rejected);
+
+  if (nnz > 0) {
+    //flip a byte of the last value
+    KokkosKernels::Impl::kk_crs_file_header h;
+    FILE *fp = fopen(filename.c_str(), "r+b");
+    ASSERT_TRUE(fp != NULL);
+    ASSERT_EQ(fread(&h, sizeof(h), 1, fp), size_t(1));
+    const long pos = long(h.values_offset + h.nnz * h.scalar_bytes) - 1;
+    fseek(fp, pos, SEEK_SET);
+    const int c = fgetc(fp);
+    fseek(fp, pos, SEEK_SET);
+    fputc(c ^ 0x55, fp);
+    fclose(fp);
+
+    rejected = false;
+    try {
+      mapped_t mapped(filename.c_str(), true);
+    }
+    catch (std::runtime_error &) { rejected = true; }
+    EXPECT_TRUE(rejected);
+  }
+  std::remove(filename.c_str());
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## mapped_crs ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_mapped_crs<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000, 20000); \
+  test_mapped_crs<SCALAR,ORDINAL,OFFSET,DEVICE>(50, 3000, 40000); \
+  test_mapped_crs<SCALAR,ORDINAL,OFFSET,DEVICE>(20000, 20000, 400000); \
+  test_mapped_crs<SCALAR,ORDINAL,OFFSET,DEVICE>(10, 10, 0); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,170 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_matrix_powers.hpp"
+#include "KokkosSparse_spmv.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+namespace Test {
+
+// The basis of the recurrence v_k = alpha_k (A v_{k-1} - theta_k v_{k-1}) - beta_k v_{k-2}
+// with one spmv per level, on the host copies of the columns.
+template <typename crsMat_t, typename basis_t>
+void check_matrix_powers(const crsMat_t& A, const basis_t& V,
+    const std::vector<typename crsMat_t::value_type>& alpha,
+    const std::vector<typename crsMat_t::value_type>& theta,
+    const std::vector<typename crsMat_t::value_type>& beta) {
+  typedef typename crsMat_t::value_type scalar_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+  typedef typename ATS::mag_type mag_t;
+  const mag_t eps = 1e3 * Kokkos::Details::ArithTraits<mag_t>::epsilon();
+  const size_t n = V.extent(0);
+  const int s = static_cast<int>(V.extent(1)) - 1;
+
+  typename basis_t::HostMirror hV = Kokkos::create_mirror_view(V);
+  Kokkos::deep_copy(hV, V);
+  std::vector<std::vector<scalar_t> > ref(s + 1, std::vector<scalar_t>(n));
+  for (size_t i = 0; i < n; ++i) ref[0][i] = hV(i, 0);
+  scalar_view_t v("v", n), Av("Av", n);
+  typename scalar_view_t::HostMirror hv = Kokkos::create_mirror_view(v);
+  typename scalar_view_t::HostMirror hAv = Kokkos::create_mirror_view(Av);
+  for (int k = 1; k <= s; ++k){
+    for (size_t i = 0; i < n; ++i) hv(i) = ref[k - 1][i];
+    Kokkos::deep_copy(v, hv);
+    KokkosSparse::spmv("N", ATS::one(), A, v, ATS::zero(), Av);
+    Kokkos::deep_copy(hAv, Av);
+    mag_t scale = 0;
+    for (size_t i = 0; i < n; ++i){
+      ref[k][i] = alpha[k] * (hAv(i) - theta[k] * ref[k - 1][i]);
+      if (k > 1) ref[k][i] -= beta[k] * ref[k - 2][i];
+      if (ATS::abs(ref[k][i]) > scale) scale = ATS::abs(ref[k][i]);
+    }
+    for (size_t i = 0; i < n; ++i)
+      EXPECT_NEAR(ATS::abs(hV(i, k) - ref[k][i]), 0, eps * (1 + scale));
+  }
+}
+
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_matrix_powers(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance, int s) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef Kokkos::View<scalar_t**, Kokkos::LayoutLeft, device> basis_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> ATS;
+
+  crsMat_t A = KokkosKernels::Impl::kk_generate_diagonally_dominant_sparse_matrix<crsMat_t>
+    (numRows, numRows, nnz, row_size_variance, bandwidth);
+  //scale A so that the powers stay bounded.
+  typename crsMat_t::values_type::HostMirror hA = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(hA, A.values);
+  scalar_t max_entry = ATS::zero();
+  for (size_t j = 0; j < hA.extent(0); ++j)
+    if (ATS::abs(hA(j)) > ATS::abs(max_entry)) max_entry = ATS::abs(hA(j));
+  for (size_t j = 0; j < hA.extent(0); ++j) hA(j) /= max_entry;
+  Kokkos::deep_copy(A.values, hA);
+
+  scalar_view_t x("x", numRows);
+  typename scalar_view_t::HostMirror hx = Kokkos::create_mirror_view(x);
+  for (lno_t i = 0; i < numRows; ++i) hx(i) = scalar_t(1 + i % 7);
+  Kokkos::deep_copy(x, hx);
+
+  const lno_t w = KokkosSparse::matrix_bandwidth(A);
+  EXPECT_LE(w, numRows - 1);
+  basis_t V("V", numRows, s + 1);
+  std::vector<scalar_t> alpha(s + 1, ATS::one()), theta(s + 1, ATS::zero()), beta(s + 1, ATS::zero());
+
+  //monomial, with the bandwidth computed in the call and given.
+  KokkosSparse::matrix_powers(A, x, V);
+  Test::check_matrix_powers(A, V, alpha, theta, beta);
+  Kokkos::deep_copy(V, ATS::zero());
+  KokkosSparse::matrix_powers(A, x, V, w);
+  Test::check_matrix_powers(A, V, alpha, theta, beta);
+
+  //Newton.
+  scalar_view_t shifts("shifts", s);
+  typename scalar_view_t::HostMirror hshifts = Kokkos::create_mirror_view(shifts);
+  for (int k = 0; k < s; ++k){
+    hshifts(k) = scalar_t(0.1 * (k + 1));
+    theta[k + 1] = hshifts(k);
+  }
+  Kokkos::deep_copy(shifts, hshifts);
+  KokkosSparse::matrix_powers_newton(A, x, V, shifts);
+  Test::check_matrix_powers(A, V, alpha, theta, beta);
+
+  //Chebyshev on [0, 2].
+  const scalar_t center = ATS::one(), half_width = ATS::one();
+  for (int k = 1; k <= s; ++k){
+    alpha[k] = scalar_t(k == 1 ? 1 : 2) / half_width;
+    theta[k] = center;
+    beta[k] = k == 1 ? ATS::zero() : ATS::one();
+  }
+  KokkosSparse::matrix_powers_chebyshev(A, x, V, center, half_width);
+  Test::check_matrix_powers(A, V, alpha, theta, beta);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## matrix_powers ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_matrix_powers<SCALAR,ORDINAL,OFFSET,DEVICE>(10000, 10000 * 7, 4, 2, 4); \
+  test_matrix_powers<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000 * 10, 1000, 4, 3); \
+  test_matrix_powers<SCALAR,ORDINAL,OFFSET,DEVICE>(100, 100 * 3, 3, 1, 1); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
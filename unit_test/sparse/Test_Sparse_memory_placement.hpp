@@ -0,0 +1,112 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosKernels_MemoryPlacement.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_memory_placement() {
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t, typename device::execution_space,
+       typename device::memory_space, typename device::memory_space> KernelHandle;
+  typedef KokkosKernels::MemoryPlacement placement_t;
+
+  //C = A x A, 10 entries per row and 100 multiplications per row of C.
+  const size_t m = 10000, nnz = 10 * m, flops = 100 * m, nnzC = 50 * m;
+  placement_t placement;
+  placement.predict_spgemm<size_type, lno_t, scalar_t>(m, m, m, nnz, nnz, nnzC, flops, 200, 16);
+
+  //without a capacity, everything goes to the fast memory.
+  EXPECT_EQ(placement.place(), 15);
+  placement.set_fast_memory_capacity(placement.get_bytes(placement_t::A) + placement.get_bytes(placement_t::B) +
+      placement.get_bytes(placement_t::C) + placement.get_bytes(placement_t::WORK));
+  EXPECT_EQ(placement.place(), 15);
+
+  //the work arrays first, then B.
+  placement.set_fast_memory_capacity(placement.get_bytes(placement_t::WORK) + placement.get_bytes(placement_t::B));
+  int memspaces = placement.place();
+  EXPECT_TRUE(placement_t::is_fast(memspaces, placement_t::WORK));
+  EXPECT_TRUE(placement_t::is_fast(memspaces, placement_t::B));
+  EXPECT_FALSE(placement_t::is_fast(memspaces, placement_t::A));
+  EXPECT_FALSE(placement_t::is_fast(memspaces, placement_t::C));
+
+  //B has the size of A, so either the work arrays fit and B does not, or
+  //the work arrays are skipped for B.
+  placement.set_fast_memory_capacity(placement.get_bytes(placement_t::A));
+  memspaces = placement.place();
+  EXPECT_NE(placement_t::is_fast(memspaces, placement_t::WORK), placement_t::is_fast(memspaces, placement_t::B));
+  EXPECT_EQ(placement_t::is_fast(memspaces, placement_t::WORK),
+      placement.get_bytes(placement_t::WORK) <= placement.get_bytes(placement_t::A));
+
+  //Gauss-Seidel reads the copy of the handle in every sweep, the input matrix once.
+  KernelHandle kh;
+  kh.get_memory_placement().predict_gauss_seidel<size_type, lno_t, scalar_t>(m, nnz, 10);
+  EXPECT_EQ(kh.get_memory_placement().place(), 15);
+  kh.set_fast_memory_capacity(kh.get_memory_placement().get_bytes(placement_t::WORK));
+  EXPECT_EQ(kh.get_memory_placement().place(), 1 << placement_t::WORK);
+
+  //triangle counting, with a capacity for a single operand.
+  placement_t triangle_placement;
+  triangle_placement.predict_triangle<size_type, lno_t>(m, nnz / 2, flops / 4, 50, 16);
+  triangle_placement.set_fast_memory_capacity(triangle_placement.get_bytes(placement_t::A));
+  memspaces = triangle_placement.place();
+  EXPECT_FALSE(placement_t::is_fast(memspaces, placement_t::A) && placement_t::is_fast(memspaces, placement_t::B));
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## memory_placement ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_memory_placement<SCALAR,ORDINAL,OFFSET,DEVICE>(); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,131 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <Kokkos_Core.hpp>
+
+#include "KokkosKernels_SimpleUtils.hpp"
+
+template <typename size_type, typename device>
+void test_exclusive_prefix_sum(size_t n) {
+  typedef Kokkos::View<size_type *, device> view_t;
+  typedef typename device::execution_space exec_space;
+
+  view_t arr("arr", n);
+  typename view_t::HostMirror h_arr = Kokkos::create_mirror_view(arr);
+  std::vector<size_type> expected(n);
+  size_type sum = 0;
+  for (size_t i = 0; i < n; ++i) {
+    h_arr(i) = size_type(i % 7);
+    expected[i] = sum;
+    sum += h_arr(i);
+  }
+  Kokkos::deep_copy(arr, h_arr);
+
+  KokkosKernels::Impl::kk_exclusive_parallel_prefix_sum<view_t, exec_space>(n, arr);
+  Kokkos::deep_copy(h_arr, arr);
+  size_t num_errors = 0;
+  for (size_t i = 0; i < n; ++i)
+    num_errors += (h_arr(i) != expected[i]);
+  EXPECT_EQ(num_errors, size_t(0));
+}
+
+//segment s has length s % 5, so that a few of them are empty.
+template <typename size_type, typename device>
+void test_exclusive_segmented_prefix_sum(size_t num_segments) {
+  typedef Kokkos::View<size_type *, device> view_t;
+  typedef typename device::execution_space exec_space;
+
+  view_t offsets("offsets", num_segments + 1);
+  typename view_t::HostMirror h_offsets = Kokkos::create_mirror_view(offsets);
+  h_offsets(0) = 0;
+  for (size_t s = 0; s < num_segments; ++s)
+    h_offsets(s + 1) = h_offsets(s) + size_type(s % 5);
+  Kokkos::deep_copy(offsets, h_offsets);
+  const size_t n = h_offsets(num_segments);
+
+  view_t arr("arr", n);
+  typename view_t::HostMirror h_arr = Kokkos::create_mirror_view(arr);
+  std::vector<size_type> expected(n);
+  for (size_t s = 0; s < num_segments; ++s) {
+    size_type sum = 0;
+    for (size_t i = h_offsets(s); i < size_t(h_offsets(s + 1)); ++i) {
+      h_arr(i) = size_type(i % 3 + 1);
+      expected[i] = sum;
+      sum += h_arr(i);
+    }
+  }
+  Kokkos::deep_copy(arr, h_arr);
+
+  KokkosKernels::Impl::kk_exclusive_parallel_segmented_prefix_sum<view_t, view_t, exec_space>(num_segments, offsets, arr);
+  Kokkos::deep_copy(h_arr, arr);
+  size_t num_errors = 0;
+  for (size_t i = 0; i < n; ++i)
+    num_errors += (h_arr(i) != expected[i]);
+  EXPECT_EQ(num_errors, size_t(0));
+}
+
+//The large sizes take the blocked scan on the host spaces and the
+//look-back scan on Cuda.
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## prefix_sum ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  const size_t host_size = 2 * size_t(KOKKOSKERNELS_SCAN_HOST_BLOCK_SIZE) * DEVICE::execution_space::concurrency(); \
+  test_exclusive_prefix_sum<OFFSET,DEVICE>(0); \
+  test_exclusive_prefix_sum<OFFSET,DEVICE>(1000); \
+  test_exclusive_prefix_sum<OFFSET,DEVICE>(host_size + 1234); \
+  test_exclusive_prefix_sum<OFFSET,DEVICE>(KOKKOSKERNELS_SCAN_LOOKBACK_MIN_SIZE + KOKKOSKERNELS_SCAN_TILE_SIZE / 2); \
+  test_exclusive_segmented_prefix_sum<OFFSET,DEVICE>(1); \
+  test_exclusive_segmented_prefix_sum<OFFSET,DEVICE>(100000); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
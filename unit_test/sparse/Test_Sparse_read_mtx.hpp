@@ -0,0 +1,136 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <set>
+#include <utility>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+//Writes a random nrows x ncols general matrix, in two number formats and
+//with blank lines, and compares the parallel reader with read_mtx.
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_read_mtx(lno_t nrows, lno_t ncols, size_t nnz, bool symmetrize, bool remove_diagonal, bool transpose) {
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+
+  const std::string filename("KokkosSparse_read_mtx_test.mtx");
+  {
+    std::set<std::pair<lno_t, lno_t> > entries;
+    std::ofstream mmf(filename.c_str());
+    mmf << "%%MatrixMarket matrix coordinate real general\n% a comment\n"
+        << nrows << " " << ncols << " " << nnz << "\n";
+    mmf.precision(17);
+    srand(245);
+    while (entries.size() < nnz){
+      const lno_t i = rand() % nrows, j = rand() % ncols;
+      if (!entries.insert(std::make_pair(i, j)).second) continue;
+      const double v = (rand() % 2000 - 1000) / 7.0;
+      if (entries.size() % 2) mmf << i + 1 << " " << j + 1 << " " << v << "\n";
+      else mmf << "  " << i + 1 << "\t" << j + 1 << "  " << std::scientific << v << std::defaultfloat << " \r\n";
+      if (entries.size() % 1000 == 0) mmf << "\n";
+    }
+  }
+
+  lno_t nv = 0, *adj = NULL;
+  size_type ne = 0, *xadj = NULL;
+  scalar_t *ew = NULL;
+  {
+    //read_mtx does not skip blank lines between entries
+    std::ifstream in(filename.c_str());
+    std::ofstream out((filename + ".ref").c_str());
+    std::string line;
+    while (std::getline(in, line))
+      if (!line.empty()) out << line << "\n";
+  }
+  KokkosKernels::Impl::read_mtx<lno_t, size_type, scalar_t>
+    ((filename + ".ref").c_str(), &nv, &ne, &xadj, &adj, &ew, symmetrize, remove_diagonal, transpose);
+  crsMat_t A = KokkosKernels::Impl::read_mtx_parallel<crsMat_t>
+    (filename.c_str(), symmetrize, remove_diagonal, transpose);
+  std::remove(filename.c_str());
+  std::remove((filename + ".ref").c_str());
+
+  EXPECT_EQ(A.numRows(), nv);
+  EXPECT_EQ(A.numCols(), transpose ? nrows : ncols);
+  ASSERT_EQ(size_type(A.nnz()), ne);
+
+  typename crsMat_t::row_map_type::HostMirror h_row_map = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror h_entries = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror h_values = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(h_row_map, A.graph.row_map);
+  Kokkos::deep_copy(h_entries, A.graph.entries);
+  Kokkos::deep_copy(h_values, A.values);
+
+  //with symmetrize, read_mtx keeps any one of a repeated entry
+  size_t num_errors = 0;
+  for (lno_t i = 0; i <= nv; ++i)
+    if (h_row_map(i) != xadj[i]) ++num_errors;
+  for (size_type k = 0; k < ne; ++k)
+    if (h_entries(k) != adj[k] || (!symmetrize && h_values(k) != ew[k])) ++num_errors;
+  EXPECT_TRUE(num_errors == 0);
+  delete [] xadj; delete [] adj; delete [] ew;
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## read_mtx ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_read_mtx<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 800, 50000, false, false, false); \
+  test_read_mtx<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 800, 50000, false, true, true); \
+  test_read_mtx<SCALAR,ORDINAL,OFFSET,DEVICE>(500, 500, 20000, true, true, false); \
+  test_read_mtx<SCALAR,ORDINAL,OFFSET,DEVICE>(10, 10, 0, false, false, false); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,111 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include "KokkosKernels_Handle.hpp"
+#include "KokkosKernels_ExecSpaceUtils.hpp"
+
+//Row i of the row map has length i % 4, plus 1000 for every 100th row.
+template <typename lno_t, typename size_type, typename device>
+void test_row_length_histogram(lno_t nrows) {
+  typedef Kokkos::View<size_type *, device> row_map_t;
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, double, typename device::execution_space,
+       typename device::memory_space, typename device::memory_space> KernelHandle;
+  using KokkosKernels::Impl::kk_row_length_histogram;
+
+  row_map_t row_map("row_map", nrows + 1);
+  typename row_map_t::HostMirror h_row_map = Kokkos::create_mirror_view(row_map);
+  h_row_map(0) = 0;
+  for (lno_t i = 0; i < nrows; ++i)
+    h_row_map(i + 1) = h_row_map(i) + i % 4 + (i % 100 == 0 ? 1000 : 0);
+  Kokkos::deep_copy(row_map, h_row_map);
+
+  kk_row_length_histogram h = KokkosKernels::Impl::kk_get_row_length_histogram
+      <row_map_t, typename device::execution_space>(nrows, row_map);
+  EXPECT_EQ(h.num_rows(), size_t(nrows));
+  for (int b = 1; b < 4; ++b)
+    EXPECT_EQ(h.counts[b], size_t(nrows / 4));
+  EXPECT_EQ(h.counts[0], size_t(nrows / 4 - nrows / 100));
+  EXPECT_EQ(h.counts[kk_row_length_histogram::bin(1000)], size_t(nrows / 100));
+  EXPECT_EQ(h.percentile(0.5), size_t(2));
+  EXPECT_EQ(h.percentile(1.0), size_t(1024));
+
+  //the long rows raise the vector size above the one of the average.
+  const size_t nnz = h_row_map(nrows);
+  const int average_vector_size = KokkosKernels::Impl::kk_get_suggested_vector_size(nrows, nnz, KokkosKernels::Impl::Exec_CUDA);
+  EXPECT_GT(KokkosKernels::Impl::kk_get_suggested_vector_size(nrows, nnz, h, KokkosKernels::Impl::Exec_CUDA), average_vector_size);
+  EXPECT_EQ(KokkosKernels::Impl::kk_get_suggested_vector_size(nrows, nnz, h, KokkosKernels::Impl::Exec_SERIAL), 1);
+
+  //without a tail, the vector size of the average.
+  kk_row_length_histogram uniform;
+  uniform.counts[8] = nrows;
+  EXPECT_EQ(KokkosKernels::Impl::kk_get_suggested_vector_size(nrows, 8 * size_t(nrows), uniform, KokkosKernels::Impl::Exec_CUDA), 8);
+
+  KernelHandle kh;
+  const kk_row_length_histogram *cached = &kh.get_row_length_histogram(nrows, row_map);
+  EXPECT_EQ(cached, &kh.get_row_length_histogram(nrows, row_map));
+  for (int b = 0; b < KOKKOSKERNELS_ROW_LENGTH_HISTOGRAM_BINS; ++b)
+    EXPECT_EQ(cached->counts[b], h.counts[b]);
+  EXPECT_EQ(kh.get_suggested_vector_size(nrows, nnz, row_map),
+      KokkosKernels::Impl::kk_get_suggested_vector_size(nrows, nnz, h,
+          KokkosKernels::Impl::kk_get_exec_space_type<typename device::execution_space>()));
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## row_length_histogram ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_row_length_histogram<ORDINAL,OFFSET,DEVICE>(10000); \
+  test_row_length_histogram<ORDINAL,OFFSET,DEVICE>(100000); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,130 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "KokkosKernels_SparseUtils.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_sort_crs(lno_t nrows, lno_t ncols) {
+  typedef Kokkos::View<size_type*, device> row_map_t;
+  typedef Kokkos::View<lno_t*, device> entries_t;
+  typedef Kokkos::View<scalar_t*, device> values_t;
+
+  //a mix of short rows and of rows sorted by a team, with shuffled columns.
+  //the value of each entry is a function of its row and column.
+  std::mt19937 gen(1223);
+  std::vector<lno_t> columns(ncols);
+  for (lno_t j = 0; j < ncols; ++j) columns[j] = j;
+  std::vector<size_type> h_rows(nrows + 1, 0);
+  std::vector<lno_t> h_cols;
+  for (lno_t i = 0; i < nrows; ++i){
+    const lno_t length = std::min(ncols, i % 4 == 0 ? lno_t(65 + (i * 37) % 500) : lno_t(i % 65));
+    std::shuffle(columns.begin(), columns.end(), gen);
+    h_cols.insert(h_cols.end(), columns.begin(), columns.begin() + length);
+    h_rows[i + 1] = h_rows[i] + length;
+  }
+  const size_type nnz = h_rows[nrows];
+
+  row_map_t row_map("row_map", nrows + 1);
+  entries_t entries("entries", nnz), sorted_entries("sorted entries", nnz);
+  values_t values("values", nnz), sorted_values("sorted values", nnz);
+  typename row_map_t::HostMirror hr = Kokkos::create_mirror_view(row_map);
+  typename entries_t::HostMirror he = Kokkos::create_mirror_view(entries);
+  typename values_t::HostMirror hv = Kokkos::create_mirror_view(values);
+  for (lno_t i = 0; i < nrows; ++i){
+    hr(i) = h_rows[i];
+    for (size_type j = h_rows[i]; j < h_rows[i + 1]; ++j){
+      he(j) = h_cols[j];
+      hv(j) = scalar_t(i) + scalar_t(h_cols[j]) / ncols;
+    }
+  }
+  hr(nrows) = nnz;
+  Kokkos::deep_copy(row_map, hr);
+  Kokkos::deep_copy(entries, he);
+  Kokkos::deep_copy(values, hv);
+
+  KokkosKernels::Impl::kk_sort_graph<row_map_t, entries_t, values_t, entries_t, values_t,
+    typename device::execution_space>(row_map, entries, values, sorted_entries, sorted_values);
+  //in place, and entries only.
+  KokkosKernels::Impl::kk_sort_crs_rows<row_map_t, entries_t, values_t,
+    typename device::execution_space>(row_map, entries, values_t());
+
+  Kokkos::deep_copy(he, sorted_entries);
+  Kokkos::deep_copy(hv, sorted_values);
+  typename entries_t::HostMirror he2 = Kokkos::create_mirror_view(entries);
+  Kokkos::deep_copy(he2, entries);
+  size_t num_errors = 0;
+  for (lno_t i = 0; i < nrows; ++i){
+    for (size_type j = h_rows[i]; j < h_rows[i + 1]; ++j){
+      if (j > h_rows[i] && he(j - 1) >= he(j)) ++num_errors;
+      if (hv(j) != scalar_t(i) + scalar_t(he(j)) / ncols) ++num_errors;
+      if (he2(j) != he(j)) ++num_errors;
+    }
+  }
+  EXPECT_TRUE(num_errors == 0);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## sort_crs ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_sort_crs<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 2000); \
+  test_sort_crs<SCALAR,ORDINAL,OFFSET,DEVICE>(300, 70); \
+  test_sort_crs<SCALAR,ORDINAL,OFFSET,DEVICE>(0, 10); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -10,6 +10,7 @@
 
 #include<algorithm>   //for std::random_shuffle
 #include<cstdlib>     //for rand
+#include<vector>
 #include<type_traits> //for std::is_same
 
 #ifndef kokkos_complex_double
@@ -131,7 +132,7 @@ void checkSumRowCorrect(ordinal_type row, crsMat_t A, crsMat_t B, crsMat_t C)
 }
 
 template <typename scalar_t, typename lno_t, typename size_type, class Device>
-void test_spadd(lno_t numRows, size_type minNNZ, size_type maxNNZ, bool sortRows)
+void test_spadd(lno_t numRows, size_type minNNZ, size_type maxNNZ, bool sortRows, bool sortedOutput = false, bool positionMap = false)
 {
   typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, Device, void, size_type> crsMat_t;
 
@@ -144,6 +145,8 @@ void test_spadd(lno_t numRows, size_type minNNZ, size_type maxNNZ, bool sortRows
 
   KernelHandle handle;
   handle.create_spadd_handle(sortRows);
+  handle.get_spadd_handle()->set_sorted_output(sortedOutput);
+  handle.get_spadd_handle()->set_use_position_map(positionMap);
   crsMat_t A = Test::randomMatrix<crsMat_t, lno_t>(numRows, minNNZ, maxNNZ, sortRows);
   crsMat_t B = Test::randomMatrix<crsMat_t, lno_t>(numRows, minNNZ, maxNNZ, sortRows);
   row_map_type c_row_map("C row map", numRows + 1);
@@ -157,20 +160,51 @@ void test_spadd(lno_t numRows, size_type minNNZ, size_type maxNNZ, bool sortRows
     row_map_type,
     entries_type>
   (&handle, A.graph.row_map, A.graph.entries, B.graph.row_map, B.graph.entries, c_row_map);
+  //a second symbolic call with copies of the same patterns is served from the handle
+  {
+    uint64_t pattern_hash = addHandle->get_symbolic_pattern_hash();
+    row_map_type a_row_map_copy("A row map copy", A.graph.row_map.extent(0));
+    entries_type a_entries_copy("A entries copy", A.graph.entries.extent(0));
+    Kokkos::deep_copy(a_row_map_copy, A.graph.row_map);
+    Kokkos::deep_copy(a_entries_copy, A.graph.entries);
+    row_map_type c_row_map_again("C row map again", numRows + 1);
+    KokkosSparse::Experimental::spadd_symbolic<
+      KernelHandle,
+      typename row_map_type::const_type,
+      typename entries_type::const_type,
+      typename row_map_type::const_type,
+      typename entries_type::const_type,
+      row_map_type,
+      entries_type>
+    (&handle, a_row_map_copy, a_entries_copy, B.graph.row_map, B.graph.entries, c_row_map_again);
+    EXPECT_EQ(pattern_hash, addHandle->get_symbolic_pattern_hash());
+    auto h_c_row_map = Kokkos::create_mirror_view(c_row_map);
+    auto h_c_row_map_again = Kokkos::create_mirror_view(c_row_map_again);
+    Kokkos::deep_copy(h_c_row_map, c_row_map);
+    Kokkos::deep_copy(h_c_row_map_again, c_row_map_again);
+    for(lno_t i = 0; i <= numRows; i++)
+    {
+      EXPECT_EQ(h_c_row_map(i), h_c_row_map_again(i));
+    }
+  }
   values_type c_values("C values", addHandle->get_max_result_nnz());
   entries_type c_entries("C entries", addHandle->get_max_result_nnz());
-  KokkosSparse::Experimental::spadd_numeric<
-    KernelHandle,
-    typename row_map_type::const_type,
-    typename entries_type::const_type,
-    scalar_t, typename values_type::const_type,
-    typename row_map_type::const_type,
-    typename entries_type::const_type,
-    scalar_t, typename values_type::const_type,
-    row_map_type, entries_type, values_type>
-    (&handle, A.graph.row_map, A.graph.entries, A.values, 1,
-     B.graph.row_map, B.graph.entries, B.values, 1,
-     c_row_map, c_entries, c_values);
+  //the second call reuses C, and must not accumulate into the values of the first
+  for(int call = 0; call < (positionMap ? 2 : 1); call++)
+  {
+    KokkosSparse::Experimental::spadd_numeric<
+      KernelHandle,
+      typename row_map_type::const_type,
+      typename entries_type::const_type,
+      scalar_t, typename values_type::const_type,
+      typename row_map_type::const_type,
+      typename entries_type::const_type,
+      scalar_t, typename values_type::const_type,
+      row_map_type, entries_type, values_type>
+      (&handle, A.graph.row_map, A.graph.entries, A.values, 1,
+       B.graph.row_map, B.graph.entries, B.values, 1,
+       c_row_map, c_entries, c_values);
+  }
   //done with handle
   //create C using CRS arrays
   crsMat_t C("C", numRows, numRows, addHandle->get_max_result_nnz(), c_values, c_row_map, c_entries);
@@ -183,12 +217,109 @@ void test_spadd(lno_t numRows, size_type minNNZ, size_type maxNNZ, bool sortRows
   }
 }
 
+template <typename scalar_t, typename lno_t, typename size_type, class Device>
+void test_spadd_multi(lno_t numRows, size_type minNNZ, size_type maxNNZ, int numOperands, bool sortRows)
+{
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, Device, void, size_type> crsMat_t;
+
+  typedef typename crsMat_t::row_map_type::non_const_type row_map_type;
+  typedef typename crsMat_t::index_type::non_const_type entries_type;
+  typedef typename crsMat_t::values_type::non_const_type values_type;
+
+  typedef typename KokkosKernels::Experimental::KokkosKernelsHandle<size_type, lno_t, scalar_t,
+  typename Device::execution_space, typename Device::memory_space, typename Device::memory_space> KernelHandle;
+
+  KernelHandle handle;
+  handle.create_spadd_handle(sortRows);
+  std::vector<crsMat_t> mats;
+  std::vector<typename row_map_type::const_type> rowmaps;
+  std::vector<typename entries_type::const_type> entries;
+  std::vector<typename values_type::const_type> values;
+  std::vector<scalar_t> coefs;
+  for(int op = 0; op < numOperands; op++)
+  {
+    mats.push_back(Test::randomMatrix<crsMat_t, lno_t>(numRows, minNNZ, maxNNZ, sortRows));
+    rowmaps.push_back(mats[op].graph.row_map);
+    entries.push_back(mats[op].graph.entries);
+    values.push_back(mats[op].values);
+    coefs.push_back(scalar_t(op + 1));
+  }
+  row_map_type c_row_map("C row map", numRows + 1);
+  auto addHandle = handle.get_spadd_handle();
+  KokkosSparse::Experimental::spadd_symbolic<
+    KernelHandle,
+    typename row_map_type::const_type,
+    typename entries_type::const_type,
+    row_map_type,
+    entries_type>
+  (&handle, rowmaps, entries, c_row_map);
+  values_type c_values("C values", addHandle->get_max_result_nnz());
+  entries_type c_entries("C entries", addHandle->get_max_result_nnz());
+  //numeric is called twice with the same C, as for operators re-assembled with fixed patterns
+  for(int call = 0; call < 2; call++)
+  {
+    KokkosSparse::Experimental::spadd_numeric<
+      KernelHandle,
+      typename row_map_type::const_type,
+      typename entries_type::const_type,
+      typename values_type::const_type,
+      scalar_t,
+      row_map_type, entries_type, values_type>
+      (&handle, rowmaps, entries, values, coefs,
+       c_row_map, c_entries, c_values);
+  }
+  handle.destroy_spadd_handle();
+
+  auto Crowmap = Kokkos::create_mirror_view(c_row_map);
+  auto Centries = Kokkos::create_mirror_view(c_entries);
+  auto Cvalues = Kokkos::create_mirror_view(c_values);
+  Kokkos::deep_copy(Crowmap, c_row_map);
+  Kokkos::deep_copy(Centries, c_entries);
+  Kokkos::deep_copy(Cvalues, c_values);
+  //check each row of C against the dense sum of the rows of the operands
+  for(lno_t i = 0; i < numRows; i++)
+  {
+    std::vector<scalar_t> correct(numRows, 0);
+    std::vector<bool> nonzeros(numRows, false);
+    for(int op = 0; op < numOperands; op++)
+    {
+      auto rowmap = Kokkos::create_mirror_view(mats[op].graph.row_map);
+      auto opEntries = Kokkos::create_mirror_view(mats[op].graph.entries);
+      auto opValues = Kokkos::create_mirror_view(mats[op].values);
+      Kokkos::deep_copy(rowmap, mats[op].graph.row_map);
+      Kokkos::deep_copy(opEntries, mats[op].graph.entries);
+      Kokkos::deep_copy(opValues, mats[op].values);
+      for(size_type j = rowmap(i); j < rowmap(i + 1); j++)
+      {
+        correct[opEntries(j)] += coefs[op] * opValues(j);
+        nonzeros[opEntries(j)] = true;
+      }
+    }
+    size_type nz = 0;
+    for(lno_t j = 0; j < numRows; j++)
+    {
+      if(nonzeros[j])
+        nz++;
+    }
+    ASSERT_EQ(Crowmap(i + 1) - Crowmap(i), nz) << "multi-operand sum row " << i << " has the wrong number of entries";
+    for(size_type j = Crowmap(i); j < Crowmap(i + 1); j++)
+    {
+      EXPECT_EQ(correct[Centries(j)], Cvalues(j)) << "multi-operand sum row " << i << ", column " << Centries(j);
+    }
+  }
+}
+
 #define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
 TEST_F( TestCategory,sparse ## _ ## spadd ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
   test_spadd<SCALAR,ORDINAL,OFFSET,DEVICE> (10, 0, 3, true); \
   test_spadd<SCALAR,ORDINAL,OFFSET,DEVICE> (10, 0, 3, false); \
   test_spadd<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 50, 100, true); \
   test_spadd<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 50, 100, false); \
+  test_spadd<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 50, 100, false, true); \
+  test_spadd<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 50, 100, true, false, true); \
+  test_spadd<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 50, 100, false, false, true); \
+  test_spadd_multi<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 10, 30, 4, true); \
+  test_spadd_multi<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 10, 30, 6, false); \
 }
 
 #if (defined (KOKKOSKERNELS_INST_DOUBLE) \
@@ -0,0 +1,186 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+
+#include<KokkosSparse_CrsMatrix.hpp>
+#include<KokkosSparse_spchol.hpp>
+#include<KokkosBlas1_scal.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+#include<cstdlib>     //for rand
+#include<vector>
+#include<algorithm>
+#include<stdexcept>
+
+#ifndef kokkos_complex_double
+#define kokkos_complex_double Kokkos::complex<double>
+#define kokkos_complex_float Kokkos::complex<float>
+#endif
+
+namespace Test {
+
+//symmetric banded matrix with random off-diagonal pairs -1 within the
+//bandwidth and the diagonal set to diag_shift plus the number of
+//off-diagonal entries of the row, so that every row sums to diag_shift.
+template <typename crsMat_t>
+crsMat_t makeSymmetricBandedMatrix(
+    typename crsMat_t::ordinal_type nrows,
+    typename crsMat_t::ordinal_type bandwidth,
+    typename crsMat_t::value_type diag_shift)
+{
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type size_type_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename size_type_view_t::non_const_value_type size_type;
+  typedef typename lno_view_t::non_const_value_type lno_t;
+  typedef typename scalar_view_t::non_const_value_type scalar_t;
+
+  srand(13721);
+  const scalar_t one = Kokkos::Details::ArithTraits<scalar_t>::one();
+  std::vector<std::vector<lno_t> > cols(nrows);
+  for (lno_t i = 0; i < nrows; i++){
+    const lno_t begin = i < bandwidth ? 0 : i - bandwidth;
+    for (lno_t j = begin; j < i; j++){
+      if (j == i - 1 || rand() % 3 == 0){
+        cols[i].push_back(j);
+        cols[j].push_back(i);
+      }
+    }
+  }
+
+  std::vector<size_type> rowmap(nrows + 1, 0);
+  for (lno_t i = 0; i < nrows; i++) rowmap[i + 1] = rowmap[i] + cols[i].size() + 1;
+  const size_type nnz = rowmap[nrows];
+  size_type_view_t d_rowmap("rowmap", nrows + 1);
+  lno_view_t d_entries("entries", nnz);
+  scalar_view_t d_values("values", nnz);
+  typename size_type_view_t::HostMirror h_rowmap = Kokkos::create_mirror_view(d_rowmap);
+  typename lno_view_t::HostMirror h_entries = Kokkos::create_mirror_view(d_entries);
+  typename scalar_view_t::HostMirror h_values = Kokkos::create_mirror_view(d_values);
+  for (lno_t i = 0; i <= nrows; i++) h_rowmap(i) = rowmap[i];
+  for (lno_t i = 0; i < nrows; i++){
+    cols[i].push_back(i);
+    std::sort(cols[i].begin(), cols[i].end());
+    for (size_t k = 0; k < cols[i].size(); k++){
+      h_entries(rowmap[i] + k) = cols[i][k];
+      h_values(rowmap[i] + k) = cols[i][k] == i ? diag_shift + scalar_t(cols[i].size() - 1) * one : -one;
+    }
+  }
+  Kokkos::deep_copy(d_rowmap, h_rowmap);
+  Kokkos::deep_copy(d_entries, h_entries);
+  Kokkos::deep_copy(d_values, h_values);
+  return crsMat_t("symmetric banded matrix", nrows, nrows, nnz, d_values, d_rowmap, d_entries);
+}
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, class Device>
+void test_spchol(lno_t numRows, lno_t bandwidth)
+{
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, Device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+
+  typedef typename KokkosKernels::Experimental::KokkosKernelsHandle<size_type, lno_t, scalar_t,
+  typename Device::execution_space, typename Device::memory_space, typename Device::memory_space> KernelHandle;
+
+  const scalar_t one = Kokkos::Details::ArithTraits<scalar_t>::one();
+  scalar_view_t b("b", numRows);
+  scalar_view_t x("x", numRows);
+  scalar_view_t expected_x("expected_x", numRows);
+  Kokkos::deep_copy(expected_x, one);
+
+  //every row of A sums to one, so A 1 = 1
+  crsMat_t A = Test::makeSymmetricBandedMatrix<crsMat_t>(numRows, bandwidth, one);
+  Kokkos::deep_copy(b, one);
+
+  double eps = std::is_same<scalar_t, float>::value ? 1e-3 : 1e-7;
+
+  lno_t max_sizes[] = {0, 1, 4};
+  for (int isize = 0; isize < 3; ++isize){
+    KernelHandle kh;
+    kh.create_spchol_handle(numRows);
+    kh.get_spchol_handle()->set_max_supernode_size(max_sizes[isize]);
+    KokkosSparse::Experimental::spchol_symbolic(&kh, A.graph.row_map, A.graph.entries);
+    EXPECT_TRUE(kh.get_spchol_handle()->is_symbolic_complete());
+    //L holds at least the lower triangle of A
+    EXPECT_GE(size_t(kh.get_spchol_handle()->get_nnzL()), size_t((A.nnz() + numRows) / 2));
+    if (max_sizes[isize] == 1){
+      EXPECT_EQ(kh.get_spchol_handle()->get_num_supernodes(), numRows);
+    }
+
+    KokkosSparse::Experimental::spchol_numeric(&kh, A.graph.row_map, A.graph.entries, A.values);
+    EXPECT_TRUE(kh.get_spchol_handle()->is_numeric_complete());
+    Kokkos::deep_copy(x, Kokkos::Details::ArithTraits<scalar_t>::zero());
+    KokkosSparse::Experimental::spchol_solve(&kh, b, x);
+    EXPECT_NEAR_KK_1DVIEW(expected_x, x, eps);
+
+    //second factorization of 2 A reuses the symbolic phase
+    scalar_view_t values2("values2", A.nnz());
+    KokkosBlas::scal(values2, one + one, A.values);
+    KokkosSparse::Experimental::spchol_numeric(&kh, A.graph.row_map, A.graph.entries, values2);
+    scalar_view_t b2("b2", numRows);
+    Kokkos::deep_copy(b2, one + one);
+    Kokkos::deep_copy(x, Kokkos::Details::ArithTraits<scalar_t>::zero());
+    KokkosSparse::Experimental::spchol_solve(&kh, b2, x);
+    EXPECT_NEAR_KK_1DVIEW(expected_x, x, eps);
+  }
+
+  //rows sum to -1, so 1^T B 1 < 0 and B is not positive definite
+  {
+    crsMat_t B = Test::makeSymmetricBandedMatrix<crsMat_t>(numRows, bandwidth, -one);
+    KernelHandle kh;
+    kh.create_spchol_handle(numRows);
+    EXPECT_THROW(KokkosSparse::Experimental::spchol_numeric(&kh, B.graph.row_map, B.graph.entries, B.values),
+                 std::runtime_error);
+    EXPECT_FALSE(kh.get_spchol_handle()->is_numeric_complete());
+  }
+
+  //A with its last diagonal entry made negative is indefinite, and only
+  //the pivot of the root supernode fails, after all the others are factored
+  {
+    scalar_view_t values_indef("values_indef", A.nnz());
+    Kokkos::deep_copy(values_indef, A.values);
+    typename crsMat_t::row_map_type::HostMirror h_rowmap = Kokkos::create_mirror_view(A.graph.row_map);
+    Kokkos::deep_copy(h_rowmap, A.graph.row_map);
+    //the entries of each row are sorted, so the diagonal of the last row is its last entry
+    auto last_diag = Kokkos::subview(values_indef, size_type(h_rowmap(numRows) - 1));
+    Kokkos::deep_copy(last_diag, -scalar_t(2 * numRows) * one);
+
+    KernelHandle kh;
+    kh.create_spchol_handle(numRows);
+    kh.get_spchol_handle()->set_max_supernode_size(4);
+    KokkosSparse::Experimental::spchol_numeric(&kh, A.graph.row_map, A.graph.entries, A.values);
+    EXPECT_TRUE(kh.get_spchol_handle()->is_numeric_complete());
+    EXPECT_THROW(KokkosSparse::Experimental::spchol_numeric(&kh, A.graph.row_map, A.graph.entries, values_indef),
+                 std::runtime_error);
+    //the failed factor replaced the previous one, so it cannot be solved with
+    EXPECT_FALSE(kh.get_spchol_handle()->is_numeric_complete());
+    EXPECT_TRUE(kh.get_spchol_handle()->is_symbolic_complete());
+    EXPECT_THROW(KokkosSparse::Experimental::spchol_solve(&kh, b, x), std::runtime_error);
+
+    //the handle keeps its symbolic phase and factors A again
+    KokkosSparse::Experimental::spchol_numeric(&kh, A.graph.row_map, A.graph.entries, A.values);
+    EXPECT_TRUE(kh.get_spchol_handle()->is_numeric_complete());
+    Kokkos::deep_copy(x, Kokkos::Details::ArithTraits<scalar_t>::zero());
+    KokkosSparse::Experimental::spchol_solve(&kh, b, x);
+    EXPECT_NEAR_KK_1DVIEW(expected_x, x, eps);
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory,sparse ## _ ## spchol ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_spchol<SCALAR,ORDINAL,OFFSET,DEVICE> (1, 1); \
+  test_spchol<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 5); \
+  test_spchol<SCALAR,ORDINAL,OFFSET,DEVICE> (1000, 20); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -51,7 +51,10 @@
 #include <stdexcept>
 
 #include "KokkosSparse_spgemm.hpp"
+#include "KokkosSparse_block_spgemm.hpp"
 #include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_prefetch.hpp"
+#include "KokkosKernels_BitmapAccumulator.hpp"
 
 #include<gtest/gtest.h>
 #include<Kokkos_Core.hpp>
@@ -76,8 +79,28 @@ using namespace KokkosKernels::Experimental;
 
 namespace Test {
 
+//the handle options exercised by run_spgemm; each test sets the one it checks.
+struct SpgemmTestOptions {
+  bool reuse_numeric;
+  bool row_binning;
+  bool sort_rows;
+  bool high_precision;
+  bool persistent_pool;
+  bool linear_probing;
+  size_t memory_budget;
+  bool use_workspace;
+  bool prefetch;
+  bool reuse_compressed_b;
+
+  SpgemmTestOptions():
+    reuse_numeric(false), row_binning(false), sort_rows(false), high_precision(false),
+    persistent_pool(false), linear_probing(false), memory_budget(0), use_workspace(false),
+    prefetch(false), reuse_compressed_b(false) {}
+};
+
 template <typename crsMat_t, typename device>
-int run_spgemm(crsMat_t input_mat, crsMat_t input_mat2, KokkosSparse::SPGEMMAlgorithm spgemm_algorithm, crsMat_t &result) {
+int run_spgemm(crsMat_t input_mat, crsMat_t input_mat2, KokkosSparse::SPGEMMAlgorithm spgemm_algorithm, crsMat_t &result,
+               const SpgemmTestOptions &options = SpgemmTestOptions()) {
   typedef typename crsMat_t::StaticCrsGraphType graph_t;
   typedef typename graph_t::row_map_type::non_const_type lno_view_t;
   typedef typename graph_t::entries_type::non_const_type   lno_nnz_view_t;
@@ -96,9 +119,19 @@ int run_spgemm(crsMat_t input_mat, crsMat_t input_mat2, KokkosSparse::SPGEMMAlgo
   KernelHandle kh;
   kh.set_team_work_size(16);
   kh.set_dynamic_scheduling(true);
+  kh.set_prefetch_before_numeric(options.prefetch);
   //kh.set_verbose(true);
 
   kh.create_spgemm_handle(spgemm_algorithm);
+  kh.get_spgemm_handle()->set_reuse_contribution_map(options.reuse_numeric);
+  kh.get_spgemm_handle()->set_row_binning(options.row_binning);
+  kh.get_spgemm_handle()->set_sort_output_rows(options.sort_rows);
+  kh.get_spgemm_handle()->set_high_precision_accumulation(options.high_precision);
+  kh.get_spgemm_handle()->set_linear_probing_accumulator(options.linear_probing);
+  kh.get_spgemm_handle()->set_memory_budget(options.memory_budget);
+  kh.get_spgemm_handle()->set_reuse_compressed_b(options.reuse_compressed_b);
+  if (options.persistent_pool) kh.create_persistent_pool();
+  if (options.use_workspace) kh.create_workspace();
 
 
   const size_t num_rows_1 = input_mat.numRows();
@@ -153,8 +186,83 @@ int run_spgemm(crsMat_t input_mat, crsMat_t input_mat2, KokkosSparse::SPGEMMAlgo
       entriesC,
       valuesC
   );
+  if (options.reuse_numeric || options.persistent_pool){
+    //the second call scatters with the contribution map of the first one,
+    //or computes on the pool memory left by the first one.
+    Kokkos::deep_copy(valuesC, scalar_t());
+    spgemm_numeric(
+        &kh,
+        num_rows_1,
+        num_rows_2,
+        num_cols_2,
+        input_mat.graph.row_map,
+        input_mat.graph.entries,
+        input_mat.values,
+        false,
+
+        input_mat2.graph.row_map,
+        input_mat2.graph.entries,
+        input_mat2.values,
+        false,
+        row_mapC,
+        entriesC,
+        valuesC
+    );
+  }
 
 
+  if (options.use_workspace){
+    //a second symbolic phase of the same size must find all of its
+    //temporaries on the workspace grown by the first one.
+    const size_t num_allocations = kh.get_workspace()->get_num_allocations();
+    const size_t num_fallback_allocations = kh.get_workspace()->get_num_fallback_allocations();
+    kh.create_spgemm_handle(spgemm_algorithm);
+    lno_view_t row_mapC2 ("non_const_lnow_row", num_rows_1 + 1);
+    spgemm_symbolic (
+        &kh,
+        num_rows_1,
+        num_rows_2,
+        num_cols_2,
+        input_mat.graph.row_map,
+        input_mat.graph.entries,
+        false,
+        input_mat2.graph.row_map,
+        input_mat2.graph.entries,
+        false,
+        row_mapC2
+    );
+    if (kh.get_workspace()->get_num_allocations() != num_allocations ||
+        kh.get_workspace()->get_num_fallback_allocations() != num_fallback_allocations)
+      return 1;
+  }
+
+  if (options.reuse_compressed_b){
+    //a second handle with the compressed B of the first one must find the
+    //same row map without compressing B again.
+    KernelHandle kh2;
+    kh2.set_team_work_size(16);
+    kh2.set_dynamic_scheduling(true);
+    kh2.create_spgemm_handle(spgemm_algorithm);
+    kh2.get_spgemm_handle()->share_compressed_b(*kh.get_spgemm_handle());
+    lno_view_t row_mapC2 ("non_const_lnow_row", num_rows_1 + 1);
+    spgemm_symbolic (
+        &kh2,
+        num_rows_1,
+        num_rows_2,
+        num_cols_2,
+        input_mat.graph.row_map,
+        input_mat.graph.entries,
+        false,
+        input_mat2.graph.row_map,
+        input_mat2.graph.entries,
+        false,
+        row_mapC2
+    );
+    if (!KokkosKernels::Impl::kk_is_identical_view
+        <lno_view_t, lno_view_t, size_type, typename device::execution_space>(row_mapC, row_mapC2, 0))
+      return 1;
+  }
+
   graph_t static_graph (entriesC, row_mapC);
   crsMat_t crsmat("CrsMatrix", num_cols_2, valuesC, static_graph);
   result = crsmat;
@@ -162,6 +270,25 @@ int run_spgemm(crsMat_t input_mat, crsMat_t input_mat2, KokkosSparse::SPGEMMAlgo
 
   return 0;
 }
+template <typename crsMat_t>
+bool is_sorted_rows(crsMat_t output_mat){
+  typename crsMat_t::StaticCrsGraphType::row_map_type::HostMirror h_rowmap =
+      Kokkos::create_mirror_view(output_mat.graph.row_map);
+  typename crsMat_t::StaticCrsGraphType::entries_type::HostMirror h_entries =
+      Kokkos::create_mirror_view(output_mat.graph.entries);
+  Kokkos::deep_copy(h_rowmap, output_mat.graph.row_map);
+  Kokkos::deep_copy(h_entries, output_mat.graph.entries);
+
+  for (size_t i = 0; i + 1 < h_rowmap.extent(0); ++i){
+    for (size_t j = h_rowmap(i) + 1; j < size_t (h_rowmap(i + 1)); ++j){
+      if (!(h_entries(j - 1) < h_entries(j))){
+        std::cout << "row:" << i << " is not sorted at:" << j << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
 template <typename crsMat_t, typename device>
 bool is_same_matrix(crsMat_t output_mat1, crsMat_t output_mat2){
 
@@ -287,9 +414,9 @@ void test_spgemm(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_v
   crsMat_t output_mat2;
   run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_DEBUG, output_mat2);
 
-  SPGEMMAlgorithm algorithms [] = {SPGEMM_KK_MEMORY, SPGEMM_KK_SPEED, SPGEMM_KK_MEMSPEED, SPGEMM_CUSPARSE,SPGEMM_MKL};
+  SPGEMMAlgorithm algorithms [] = {SPGEMM_KK_MEMORY, SPGEMM_KK_SPEED, SPGEMM_KK_MEMSPEED, SPGEMM_KK_AUTO, SPGEMM_CUSPARSE,SPGEMM_MKL};
 
-  for (int ii = 0; ii < 5; ++ii){
+  for (int ii = 0; ii < 6; ++ii){
 
     SPGEMMAlgorithm spgemm_algorithm = algorithms[ii];
 
@@ -339,6 +466,9 @@ void test_spgemm(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_v
     case SPGEMM_KK_MEMORY:
       algo = "SPGEMM_KK_MEMORY";
       break;
+    case SPGEMM_KK_AUTO:
+      algo = "SPGEMM_KK_AUTO";
+      break;
     default:
       break;
     }
@@ -377,14 +507,326 @@ void test_spgemm(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_v
     }
     //std::cout << "algo:" << algo << " spgemm_time:" << spgemm_time << " output_check_time:" << timer1.seconds() << std::endl;
   }
+
+  {
+    crsMat_t output_mat;
+    SpgemmTestOptions options;
+    options.reuse_numeric = true;
+    int res = run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_KK_MEMORY, output_mat, options);
+    EXPECT_TRUE( (res == 0)) << "SPGEMM_KK_MEMORY contribution map";
+    bool is_identical = is_same_matrix<crsMat_t, device>(output_mat, output_mat2);
+    EXPECT_TRUE(is_identical) << "SPGEMM_KK_MEMORY contribution map";
+  }
+
+  {
+    crsMat_t output_mat;
+    SpgemmTestOptions options;
+    options.row_binning = true;
+    int res = run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_KK_MEMORY, output_mat, options);
+    EXPECT_TRUE( (res == 0)) << "SPGEMM_KK_MEMORY row binning";
+    bool is_identical = is_same_matrix<crsMat_t, device>(output_mat, output_mat2);
+    EXPECT_TRUE(is_identical) << "SPGEMM_KK_MEMORY row binning";
+  }
+
+  {
+    crsMat_t output_mat;
+    SpgemmTestOptions options;
+    options.sort_rows = true;
+    int res = run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_KK_MEMORY, output_mat, options);
+    EXPECT_TRUE( (res == 0)) << "SPGEMM_KK_MEMORY sorted rows";
+    EXPECT_TRUE(is_sorted_rows<crsMat_t>(output_mat)) << "SPGEMM_KK_MEMORY sorted rows";
+    bool is_identical = is_same_matrix<crsMat_t, device>(output_mat, output_mat2);
+    EXPECT_TRUE(is_identical) << "SPGEMM_KK_MEMORY sorted rows";
+  }
+
+  {
+    crsMat_t output_mat;
+    SpgemmTestOptions options;
+    options.high_precision = true;
+    int res = run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_KK_MEMORY, output_mat, options);
+    EXPECT_TRUE( (res == 0)) << "SPGEMM_KK_MEMORY high precision accumulation";
+    bool is_identical = is_same_matrix<crsMat_t, device>(output_mat, output_mat2);
+    EXPECT_TRUE(is_identical) << "SPGEMM_KK_MEMORY high precision accumulation";
+  }
+
+  {
+    crsMat_t output_mat;
+    SpgemmTestOptions options;
+    options.persistent_pool = true;
+    int res = run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_KK_MEMORY, output_mat, options);
+    EXPECT_TRUE( (res == 0)) << "SPGEMM_KK_MEMORY persistent pool";
+    bool is_identical = is_same_matrix<crsMat_t, device>(output_mat, output_mat2);
+    EXPECT_TRUE(is_identical) << "SPGEMM_KK_MEMORY persistent pool";
+  }
+
+  {
+    crsMat_t output_mat;
+    SpgemmTestOptions options;
+    options.linear_probing = true;
+    int res = run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_KK_MEMORY, output_mat, options);
+    EXPECT_TRUE( (res == 0)) << "SPGEMM_KK_MEMORY linear probing accumulator";
+    bool is_identical = is_same_matrix<crsMat_t, device>(output_mat, output_mat2);
+    EXPECT_TRUE(is_identical) << "SPGEMM_KK_MEMORY linear probing accumulator";
+  }
+
+  {
+    //a budget below a dense accumulator makes SPGEMM_KK_SPEED use the hashmap accumulators.
+    crsMat_t output_mat;
+    SpgemmTestOptions options;
+    options.memory_budget = 1;
+    int res = run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_KK_SPEED, output_mat, options);
+    EXPECT_TRUE( (res == 0)) << "SPGEMM_KK_SPEED memory budget";
+    bool is_identical = is_same_matrix<crsMat_t, device>(output_mat, output_mat2);
+    EXPECT_TRUE(is_identical) << "SPGEMM_KK_SPEED memory budget";
+  }
+
+  {
+    crsMat_t output_mat;
+    SpgemmTestOptions options;
+    options.use_workspace = true;
+    int res = run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_KK_MEMORY, output_mat, options);
+    EXPECT_TRUE( (res == 0)) << "SPGEMM_KK_MEMORY workspace";
+    bool is_identical = is_same_matrix<crsMat_t, device>(output_mat, output_mat2);
+    EXPECT_TRUE(is_identical) << "SPGEMM_KK_MEMORY workspace";
+  }
+
+  {
+    //the prefetch hints only matter for CudaUVMSpace, and never change the product.
+    KokkosSparse::prefetch(input_mat);
+    crsMat_t output_mat;
+    SpgemmTestOptions options;
+    options.prefetch = true;
+    int res = run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_KK_MEMORY, output_mat, options);
+    EXPECT_TRUE( (res == 0)) << "SPGEMM_KK_MEMORY prefetch";
+    bool is_identical = is_same_matrix<crsMat_t, device>(output_mat, output_mat2);
+    EXPECT_TRUE(is_identical) << "SPGEMM_KK_MEMORY prefetch";
+  }
+
+  {
+    crsMat_t output_mat;
+    SpgemmTestOptions options;
+    options.reuse_compressed_b = true;
+    int res = run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_KK_MEMORY, output_mat, options);
+    EXPECT_TRUE( (res == 0)) << "SPGEMM_KK_MEMORY reuse compressed B";
+    bool is_identical = is_same_matrix<crsMat_t, device>(output_mat, output_mat2);
+    EXPECT_TRUE(is_identical) << "SPGEMM_KK_MEMORY reuse compressed B";
+  }
+
+  if (KokkosKernels::Impl::kk_get_exec_space_type<typename device::execution_space>() != KokkosKernels::Impl::Exec_CUDA) {
+    //host execution spaces default to the multithreaded SPGEMM_KK_AUTO.
+    typedef KokkosKernels::Experimental::KokkosKernelsHandle
+        <size_type, lno_t, scalar_t,
+        typename device::execution_space, typename device::memory_space,typename device::memory_space > KernelHandle;
+    KernelHandle kh;
+    kh.create_spgemm_handle();
+    EXPECT_TRUE(kh.get_spgemm_handle()->is_auto_select_algorithm()) << "SPGEMM_DEFAULT";
+    kh.destroy_spgemm_handle();
+
+    crsMat_t output_mat;
+    int res = run_spgemm<crsMat_t, device>(input_mat, input_mat, SPGEMM_DEFAULT, output_mat);
+    EXPECT_TRUE( (res == 0)) << "SPGEMM_DEFAULT";
+    bool is_identical = is_same_matrix<crsMat_t, device>(output_mat, output_mat2);
+    EXPECT_TRUE(is_identical) << "SPGEMM_DEFAULT";
+  }
   //device::execution_space::finalize();
 }
 
+//runs symbolic and numeric on one handle and checks its statistics.
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_spgemm_stats(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  using namespace Test;
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type lno_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_nnz_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+
+  for (int collect = 0; collect < 2; ++collect){
+    KernelHandle kh;
+    kh.create_spgemm_handle(SPGEMM_KK_MEMORY);
+    kh.get_spgemm_handle()->set_accumulator_type(SPGEMM_ACC_SPARSE);
+    kh.get_spgemm_handle()->set_collect_stats(collect == 1);
+
+    lno_view_t row_mapC("row_mapC", numRows + 1);
+    spgemm_symbolic(&kh, numRows, numRows, numRows,
+        A.graph.row_map, A.graph.entries, false,
+        A.graph.row_map, A.graph.entries, false,
+        row_mapC);
+    const size_t c_nnz = kh.get_spgemm_handle()->get_c_nnz();
+    lno_nnz_view_t entriesC(Kokkos::ViewAllocateWithoutInitializing("entriesC"), c_nnz);
+    scalar_view_t valuesC(Kokkos::ViewAllocateWithoutInitializing("valuesC"), c_nnz);
+    spgemm_numeric(&kh, numRows, numRows, numRows,
+        A.graph.row_map, A.graph.entries, A.values, false,
+        A.graph.row_map, A.graph.entries, A.values, false,
+        row_mapC, entriesC, valuesC);
+
+    const SPGEMMStats &stats = kh.get_spgemm_handle()->get_stats();
+    if (collect){
+      EXPECT_EQ(stats.algorithm, SPGEMM_KK_MEMORY);
+      EXPECT_EQ(stats.accumulator, SPGEMM_ACC_SPARSE);
+      EXPECT_GT(stats.symbolic_pool_chunks, size_t(0));
+      EXPECT_GT(stats.symbolic_pool_bytes, size_t(0));
+      EXPECT_GT(stats.numeric_pool_chunks, size_t(0));
+      EXPECT_GT(stats.numeric_pool_bytes, size_t(0));
+      EXPECT_GT(stats.symbolic_time, 0.0);
+      EXPECT_GT(stats.numeric_time, 0.0);
+      EXPECT_GT(stats.numeric_kernel_time, 0.0);
+      EXPECT_LE(stats.numeric_kernel_time, stats.numeric_time);
+    }
+    else {
+      EXPECT_EQ(stats.algorithm, SPGEMM_DEFAULT);
+      EXPECT_EQ(stats.accumulator, SPGEMM_ACC_DEFAULT);
+      EXPECT_EQ(stats.symbolic_pool_chunks, size_t(0));
+      EXPECT_EQ(stats.symbolic_pool_bytes, size_t(0));
+      EXPECT_EQ(stats.numeric_pool_chunks, size_t(0));
+      EXPECT_EQ(stats.numeric_pool_bytes, size_t(0));
+      EXPECT_EQ(stats.symbolic_time, 0.0);
+      EXPECT_EQ(stats.compression_time, 0.0);
+      EXPECT_EQ(stats.symbolic_pool_alloc_time, 0.0);
+      EXPECT_EQ(stats.symbolic_hash_time, 0.0);
+      EXPECT_EQ(stats.numeric_time, 0.0);
+      EXPECT_EQ(stats.numeric_pool_alloc_time, 0.0);
+      EXPECT_EQ(stats.numeric_kernel_time, 0.0);
+    }
+    kh.destroy_spgemm_handle();
+  }
+}
+
+//forces the bitmap accumulator of SPGEMM_KK_SPEED with a narrow B, whose
+//dense rows fit the memory budget, and checks C against SPGEMM_KK_MEMORY.
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_spgemm_bitmap(lno_t numRows, lno_t numInner, lno_t numCols) {
+  using namespace Test;
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type lno_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_nnz_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  //the GPU version of SPGEMM_KK_SPEED uses a hashmap instead.
+  if (KokkosKernels::Impl::kk_get_exec_space_type<typename device::execution_space>() == KokkosKernels::Impl::Exec_CUDA)
+    return;
+
+  size_type nnzA = size_type(numRows) * 10;
+  size_type nnzB = size_type(numInner) * numCols / 2;
+  crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numInner, nnzA, 2, numInner);
+  crsMat_t B = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numInner, numCols, nnzB, 2, numCols);
+
+  const size_t concurrency = device::execution_space::concurrency();
+  const size_t dense_chunk_size = KokkosKernels::Experimental::BitmapAccumulator
+      <lno_t, lno_t, scalar_t>::get_memory_size(numCols);
+
+  KernelHandle kh;
+  kh.create_spgemm_handle(SPGEMM_KK_SPEED);
+  kh.get_spgemm_handle()->set_collect_stats(true);
+  kh.get_spgemm_handle()->set_memory_budget(
+      4 * concurrency * dense_chunk_size * (sizeof(scalar_t) + sizeof(lno_t)));
+
+  lno_view_t row_mapC("row_mapC", numRows + 1);
+  spgemm_symbolic(&kh, numRows, numInner, numCols,
+      A.graph.row_map, A.graph.entries, false,
+      B.graph.row_map, B.graph.entries, false,
+      row_mapC);
+  const size_t c_nnz = kh.get_spgemm_handle()->get_c_nnz();
+  lno_nnz_view_t entriesC(Kokkos::ViewAllocateWithoutInitializing("entriesC"), c_nnz);
+  scalar_view_t valuesC(Kokkos::ViewAllocateWithoutInitializing("valuesC"), c_nnz);
+  spgemm_numeric(&kh, numRows, numInner, numCols,
+      A.graph.row_map, A.graph.entries, A.values, false,
+      B.graph.row_map, B.graph.entries, B.values, false,
+      row_mapC, entriesC, valuesC);
+
+  //the numeric pool is one bitmap accumulator per thread.
+  const SPGEMMStats &stats = kh.get_spgemm_handle()->get_stats();
+  EXPECT_EQ(stats.numeric_pool_chunks, concurrency);
+  EXPECT_EQ(stats.numeric_pool_bytes, sizeof(scalar_t) * concurrency * dense_chunk_size);
+  kh.destroy_spgemm_handle();
+
+  graph_t static_graph (entriesC, row_mapC);
+  crsMat_t C("CrsMatrix", numCols, valuesC, static_graph);
+  EXPECT_TRUE(is_sorted_rows<crsMat_t>(C)) << "SPGEMM_KK_SPEED bitmap sorted rows";
+
+  crsMat_t C_ref;
+  int res = run_spgemm<crsMat_t, device>(A, B, SPGEMM_KK_MEMORY, C_ref);
+  EXPECT_TRUE((res == 0)) << "SPGEMM_KK_MEMORY";
+  bool is_identical = is_same_matrix<crsMat_t, device>(C, C_ref);
+  EXPECT_TRUE(is_identical) << "SPGEMM_KK_SPEED bitmap";
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_block_spgemm(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance, lno_t block_size) {
+  using namespace Test;
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename KokkosSparse::Experimental::BlockCrsMatrix<scalar_t, lno_t, device, void, size_type> blockCrsMat_t;
+  typedef typename crsMat_t::row_map_type::non_const_type row_map_t;
+  typedef typename crsMat_t::index_type::non_const_type entries_t;
+  typedef typename crsMat_t::values_type::non_const_type values_t;
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+  typedef typename Kokkos::Details::ArithTraits<scalar_t>::mag_type eps_type;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnz, row_size_variance, bandwidth);
+  size_t out_r, out_c;
+  row_map_t xadj;
+  entries_t adj;
+  values_t vals;
+  KokkosKernels::Impl::kk_create_blockcrs_formated_point_crsmatrix(
+      block_size, numRows, numRows,
+      input_mat.graph.row_map, input_mat.graph.entries, input_mat.values,
+      out_r, out_c, xadj, adj, vals);
+  crsMat_t point_mat("blocked point", out_r, out_c, vals.extent(0), vals, xadj, adj);
+  blockCrsMat_t block_mat(point_mat, block_size);
+
+  //the point product, in blocks.
+  crsMat_t point_product;
+  int res = run_spgemm<crsMat_t, device>(point_mat, point_mat, SPGEMM_KK_MEMORY, point_product);
+  EXPECT_TRUE( (res == 0)) << "point product of the block matrix";
+  blockCrsMat_t expected =
+      KokkosKernels::Impl::kk_create_blockcrs_matrix_from_point_crs<blockCrsMat_t>(point_product, block_size);
+  EXPECT_EQ(expected.blockDim(), block_size);
+
+  KernelHandle kh;
+  kh.create_spgemm_handle(SPGEMM_KK_MEMORY);
+  blockCrsMat_t block_product;
+  KokkosSparse::Experimental::block_spgemm_symbolic(&kh, block_mat, block_mat, block_product);
+  KokkosSparse::Experimental::block_spgemm_numeric(&kh, block_mat, block_mat, block_product);
+  EXPECT_TRUE(is_sorted_rows(block_product));
+
+  eps_type eps = std::is_same<eps_type,float>::value?2*1e-3:1e-7;
+  EXPECT_TRUE((KokkosKernels::Impl::kk_is_identical_view
+      <typename blockCrsMat_t::row_map_type, typename blockCrsMat_t::row_map_type, size_type, typename device::execution_space>
+      (block_product.graph.row_map, expected.graph.row_map, 0)));
+  EXPECT_TRUE((KokkosKernels::Impl::kk_is_identical_view
+      <typename blockCrsMat_t::index_type, typename blockCrsMat_t::index_type, lno_t, typename device::execution_space>
+      (block_product.graph.entries, expected.graph.entries, 0)));
+  EXPECT_TRUE((KokkosKernels::Impl::kk_is_identical_view
+      <typename blockCrsMat_t::values_type, typename blockCrsMat_t::values_type, eps_type, typename device::execution_space>
+      (block_product.values, expected.values, eps)));
+
+  //the numeric phase again, for new values with the same patterns.
+  KokkosSparse::Experimental::block_spgemm_numeric(&kh, block_mat, block_mat, block_product);
+  EXPECT_TRUE((KokkosKernels::Impl::kk_is_identical_view
+      <typename blockCrsMat_t::values_type, typename blockCrsMat_t::values_type, eps_type, typename device::execution_space>
+      (block_product.values, expected.values, eps)));
+}
+
 
 
 #define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
 TEST_F( TestCategory, sparse ## _ ## spgemm ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
   test_spgemm<SCALAR,ORDINAL,OFFSET,DEVICE>(10000, 10000 * 30, 500, 10); \
+  test_spgemm_stats<SCALAR,ORDINAL,OFFSET,DEVICE>(2000, 2000 * 20, 200, 10); \
+  test_spgemm_bitmap<SCALAR,ORDINAL,OFFSET,DEVICE>(2000, 100, 64); \
+  test_block_spgemm<SCALAR,ORDINAL,OFFSET,DEVICE>(500, 500 * 5, 50, 2, 3); \
+  test_block_spgemm<SCALAR,ORDINAL,OFFSET,DEVICE>(200, 200 * 3, 40, 2, 4); \
 }
 
 //test_spgemm<SCALAR,ORDINAL,OFFSET,DEVICE>(50000, 50000 * 30, 100, 10);
@@ -0,0 +1,287 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+
+#include<KokkosSparse_CrsMatrix.hpp>
+#include<KokkosSparse_spgemm_chunked.hpp>
+#include<KokkosSparse_spgemm_partitioned.hpp>
+#include<KokkosKernels_IOUtils.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+#include<vector>
+
+#ifndef kokkos_complex_double
+#define kokkos_complex_double Kokkos::complex<double>
+#define kokkos_complex_float Kokkos::complex<float>
+#endif
+
+namespace Test {
+
+//Compares each row of C = A*B in host memory with a dense host
+//accumulation of A*B.
+template <typename crsMat_t>
+void check_spgemm_host_result(crsMat_t A, crsMat_t B,
+    typename crsMat_t::row_map_type::non_const_type::HostMirror h_rmC,
+    typename crsMat_t::index_type::non_const_type::HostMirror h_entC,
+    typename crsMat_t::values_type::non_const_type::HostMirror h_valC) {
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type lno_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_nnz_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+
+  typedef typename lno_view_t::value_type size_type;
+  typedef typename lno_nnz_view_t::value_type lno_t;
+  typedef typename scalar_view_t::value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> KAT;
+  typedef typename KAT::mag_type mag_t;
+
+  const lno_t m = A.numRows();
+  const lno_t k = B.numCols();
+
+  typename graph_t::row_map_type::HostMirror h_rmA = Kokkos::create_mirror_view(A.graph.row_map);
+  typename graph_t::entries_type::HostMirror h_entA = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror h_valA = Kokkos::create_mirror_view(A.values);
+  typename graph_t::row_map_type::HostMirror h_rmB = Kokkos::create_mirror_view(B.graph.row_map);
+  typename graph_t::entries_type::HostMirror h_entB = Kokkos::create_mirror_view(B.graph.entries);
+  typename crsMat_t::values_type::HostMirror h_valB = Kokkos::create_mirror_view(B.values);
+  Kokkos::deep_copy(h_rmA, A.graph.row_map);
+  Kokkos::deep_copy(h_entA, A.graph.entries);
+  Kokkos::deep_copy(h_valA, A.values);
+  Kokkos::deep_copy(h_rmB, B.graph.row_map);
+  Kokkos::deep_copy(h_entB, B.graph.entries);
+  Kokkos::deep_copy(h_valB, B.values);
+
+  const mag_t eps = std::is_same<mag_t, float>::value ? 1e-3 : 1e-9;
+
+  ASSERT_EQ(size_t (m + 1), h_rmC.extent(0));
+  EXPECT_EQ(size_type (0), h_rmC(0));
+  EXPECT_EQ(size_t (h_rmC(m)), h_entC.extent(0));
+
+  std::vector<scalar_t> c(k, KAT::zero());
+  std::vector<mag_t> c_mag(k, 0);
+  std::vector<char> in_ab(k, 0), seen(k, 0);
+  for (lno_t i = 0; i < m; ++i){
+    lno_t ref_row_nnz = 0;
+    for (size_type a = h_rmA(i); a < h_rmA(i + 1); ++a){
+      const lno_t rowB = h_entA(a);
+      for (size_type b = h_rmB(rowB); b < h_rmB(rowB + 1); ++b){
+        const lno_t col = h_entB(b);
+        if (!in_ab[col]) ++ref_row_nnz;
+        in_ab[col] = 1;
+        c[col] += h_valA(a) * h_valB(b);
+        c_mag[col] += KAT::abs(h_valA(a)) * KAT::abs(h_valB(b));
+      }
+    }
+
+    EXPECT_EQ(size_type (ref_row_nnz), h_rmC(i + 1) - h_rmC(i)) << "row " << i;
+    for (size_type z = h_rmC(i); z < h_rmC(i + 1); ++z){
+      const lno_t col = h_entC(z);
+      ASSERT_TRUE(col >= 0 && col < k);
+      EXPECT_TRUE(in_ab[col] && !seen[col]) << "row " << i << " col " << col;
+      seen[col] = 1;
+      EXPECT_NEAR_KK(h_valC(z), c[col], eps * (1 + c_mag[col]));
+    }
+    for (lno_t j = 0; j < k; ++j){
+      c[j] = KAT::zero();
+      c_mag[j] = 0;
+      in_ab[j] = seen[j] = 0;
+    }
+  }
+}
+
+//Computes C = A*B by row blocks of at most block_nnz multiplications into
+//host memory.
+template <typename crsMat_t, typename device>
+void check_spgemm_chunked(crsMat_t A, crsMat_t B, size_t block_nnz) {
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type lno_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_nnz_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+
+  typedef typename lno_view_t::value_type size_type;
+  typedef typename lno_nnz_view_t::value_type lno_t;
+  typedef typename scalar_view_t::value_type scalar_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  const lno_t m = A.numRows();
+  const lno_t n = B.numRows();
+  const lno_t k = B.numCols();
+
+  KernelHandle kh;
+  kh.create_spgemm_handle();
+  kh.get_spgemm_handle()->set_chunk_memory_budget(block_nnz * (sizeof(lno_t) + sizeof(scalar_t)));
+
+  typename lno_view_t::HostMirror h_rmC;
+  typename lno_nnz_view_t::HostMirror h_entC;
+  typename scalar_view_t::HostMirror h_valC;
+  KokkosSparse::Experimental::spgemm_chunked_to_host(
+      &kh, m, n, k,
+      A.graph.row_map, A.graph.entries, A.values,
+      B.graph.row_map, B.graph.entries, B.values,
+      h_rmC, h_entC, h_valC);
+  kh.destroy_spgemm_handle();
+
+  check_spgemm_host_result(A, B, h_rmC, h_entC, h_valC);
+}
+
+//Computes C = A*B with A partitioned by rows into num_parts parts, and
+//gathers C.
+template <typename crsMat_t, typename device>
+void check_spgemm_partitioned(crsMat_t A, crsMat_t B, int num_parts) {
+  typedef typename crsMat_t::size_type size_type;
+  typedef typename crsMat_t::ordinal_type lno_t;
+  typedef typename crsMat_t::value_type scalar_t;
+  typedef KokkosSparse::Experimental::RowPartitionedCrsMatrix<scalar_t, lno_t, device, size_type> partitioned_t;
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  partitioned_t partitioned_A(A, num_parts);
+  std::vector<KernelHandle> kh(num_parts);
+  std::vector<KernelHandle *> handles(num_parts);
+  for (int p = 0; p < num_parts; ++p){
+    kh[p].create_spgemm_handle();
+    handles[p] = &kh[p];
+  }
+
+  partitioned_t partitioned_C;
+  KokkosSparse::Experimental::partitioned_spgemm_symbolic(handles, partitioned_A, B, partitioned_C);
+  KokkosSparse::Experimental::partitioned_spgemm_numeric(handles, partitioned_A, B, partitioned_C);
+  ASSERT_EQ(num_parts, partitioned_C.numParts());
+  for (int p = 0; p < num_parts; ++p){
+    EXPECT_EQ(partitioned_A.rowBegin(p), partitioned_C.rowBegin(p));
+  }
+
+  crsMat_t C = partitioned_C.gather();
+  typename crsMat_t::row_map_type::non_const_type::HostMirror h_rmC("h_rmC", C.graph.row_map.extent(0));
+  typename crsMat_t::index_type::non_const_type::HostMirror h_entC("h_entC", C.graph.entries.extent(0));
+  typename crsMat_t::values_type::non_const_type::HostMirror h_valC("h_valC", C.values.extent(0));
+  Kokkos::deep_copy(h_rmC, C.graph.row_map);
+  Kokkos::deep_copy(h_entC, C.graph.entries);
+  Kokkos::deep_copy(h_valC, C.values);
+  check_spgemm_host_result(A, B, h_rmC, h_entC, h_valC);
+}
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_spgemm_chunked(lno_t numRows, size_type nnz_per_row, lno_t bandwidth) {
+  using namespace Test;
+  typedef KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+
+  size_type nnzA = numRows * nnz_per_row;
+  crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnzA, 2, bandwidth);
+
+  //a single row per block, a few rows per block, and a single block.
+  check_spgemm_chunked<crsMat_t, device>(A, A, 1);
+  check_spgemm_chunked<crsMat_t, device>(A, A, 8 * nnz_per_row * nnz_per_row);
+  check_spgemm_chunked<crsMat_t, device>(A, A, size_t (nnzA) * nnz_per_row * 4);
+
+  //the same row blocks, as parts of a partitioned A.
+  check_spgemm_partitioned<crsMat_t, device>(A, A, 1);
+  check_spgemm_partitioned<crsMat_t, device>(A, A, 4);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## spgemm_chunked ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_spgemm_chunked<SCALAR,ORDINAL,OFFSET,DEVICE>(10, 3, 8); \
+  test_spgemm_chunked<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 10, 50); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int64_t, size_t, TestExecSpace)
+#endif
+
@@ -0,0 +1,244 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+
+#include<KokkosSparse_CrsMatrix.hpp>
+#include<KokkosSparse_spgemm_masked.hpp>
+#include<KokkosKernels_IOUtils.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+#include<vector>
+
+#ifndef kokkos_complex_double
+#define kokkos_complex_double Kokkos::complex<double>
+#define kokkos_complex_float Kokkos::complex<float>
+#endif
+
+namespace Test {
+
+//Computes C<M> = A*B (or C<!M> = A*B) and compares each row with a dense
+//host accumulation of A*B filtered by the mask row.
+template <typename crsMat_t, typename device>
+void check_spgemm_masked(crsMat_t A, crsMat_t B, crsMat_t M, bool complement) {
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type lno_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_nnz_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+
+  typedef typename lno_view_t::value_type size_type;
+  typedef typename lno_nnz_view_t::value_type lno_t;
+  typedef typename scalar_view_t::value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> KAT;
+  typedef typename KAT::mag_type mag_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  const lno_t m = A.numRows();
+  const lno_t n = B.numRows();
+  const lno_t k = B.numCols();
+
+  KernelHandle kh;
+  kh.create_spgemm_handle();
+
+  lno_view_t row_mapC("row_mapC", m + 1);
+  KokkosSparse::Experimental::spgemm_masked_symbolic(
+      &kh, m, n, k,
+      A.graph.row_map, A.graph.entries,
+      B.graph.row_map, B.graph.entries,
+      M.graph.row_map, M.graph.entries,
+      complement,
+      row_mapC);
+
+  size_t c_nnz = kh.get_spgemm_handle()->get_c_nnz();
+  lno_nnz_view_t entriesC("entriesC", c_nnz);
+  scalar_view_t valuesC("valuesC", c_nnz);
+  KokkosSparse::Experimental::spgemm_masked_numeric(
+      &kh, m, n, k,
+      A.graph.row_map, A.graph.entries, A.values,
+      B.graph.row_map, B.graph.entries, B.values,
+      M.graph.row_map, M.graph.entries,
+      complement,
+      row_mapC, entriesC, valuesC);
+  kh.destroy_spgemm_handle();
+
+  typename graph_t::row_map_type::HostMirror h_rmA = Kokkos::create_mirror_view(A.graph.row_map);
+  typename graph_t::entries_type::HostMirror h_entA = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror h_valA = Kokkos::create_mirror_view(A.values);
+  typename graph_t::row_map_type::HostMirror h_rmB = Kokkos::create_mirror_view(B.graph.row_map);
+  typename graph_t::entries_type::HostMirror h_entB = Kokkos::create_mirror_view(B.graph.entries);
+  typename crsMat_t::values_type::HostMirror h_valB = Kokkos::create_mirror_view(B.values);
+  typename graph_t::row_map_type::HostMirror h_rmM = Kokkos::create_mirror_view(M.graph.row_map);
+  typename graph_t::entries_type::HostMirror h_entM = Kokkos::create_mirror_view(M.graph.entries);
+  Kokkos::deep_copy(h_rmA, A.graph.row_map);
+  Kokkos::deep_copy(h_entA, A.graph.entries);
+  Kokkos::deep_copy(h_valA, A.values);
+  Kokkos::deep_copy(h_rmB, B.graph.row_map);
+  Kokkos::deep_copy(h_entB, B.graph.entries);
+  Kokkos::deep_copy(h_valB, B.values);
+  Kokkos::deep_copy(h_rmM, M.graph.row_map);
+  Kokkos::deep_copy(h_entM, M.graph.entries);
+
+  typename lno_view_t::HostMirror h_rmC = Kokkos::create_mirror_view(row_mapC);
+  typename lno_nnz_view_t::HostMirror h_entC = Kokkos::create_mirror_view(entriesC);
+  typename scalar_view_t::HostMirror h_valC = Kokkos::create_mirror_view(valuesC);
+  Kokkos::deep_copy(h_rmC, row_mapC);
+  Kokkos::deep_copy(h_entC, entriesC);
+  Kokkos::deep_copy(h_valC, valuesC);
+
+  const mag_t eps = std::is_same<mag_t, float>::value ? 1e-3 : 1e-9;
+
+  std::vector<scalar_t> c(k, KAT::zero());
+  std::vector<mag_t> c_mag(k, 0);
+  std::vector<char> in_ab(k, 0), in_mask(k, 0), seen(k, 0);
+  for (lno_t i = 0; i < m; ++i){
+    for (size_type a = h_rmA(i); a < h_rmA(i + 1); ++a){
+      const lno_t rowB = h_entA(a);
+      for (size_type b = h_rmB(rowB); b < h_rmB(rowB + 1); ++b){
+        const lno_t col = h_entB(b);
+        in_ab[col] = 1;
+        c[col] += h_valA(a) * h_valB(b);
+        c_mag[col] += KAT::abs(h_valA(a)) * KAT::abs(h_valB(b));
+      }
+    }
+    for (size_type z = h_rmM(i); z < h_rmM(i + 1); ++z){
+      in_mask[h_entM(z)] = 1;
+    }
+    lno_t ref_row_nnz = 0;
+    for (lno_t j = 0; j < k; ++j){
+      if (in_ab[j] && (in_mask[j] != 0) != complement) ++ref_row_nnz;
+    }
+
+    EXPECT_EQ(size_type (ref_row_nnz), h_rmC(i + 1) - h_rmC(i)) << "row " << i;
+    for (size_type z = h_rmC(i); z < h_rmC(i + 1); ++z){
+      const lno_t col = h_entC(z);
+      ASSERT_TRUE(col >= 0 && col < k);
+      EXPECT_TRUE(in_ab[col] && (in_mask[col] != 0) != complement && !seen[col]) << "row " << i << " col " << col;
+      seen[col] = 1;
+      EXPECT_NEAR_KK(h_valC(z), c[col], eps * (1 + c_mag[col]));
+    }
+    for (lno_t j = 0; j < k; ++j){
+      c[j] = KAT::zero();
+      c_mag[j] = 0;
+      in_ab[j] = in_mask[j] = seen[j] = 0;
+    }
+  }
+}
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_spgemm_masked(lno_t numRows, size_type nnz_per_row, lno_t bandwidth) {
+  using namespace Test;
+  typedef KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+
+  size_type nnzA = numRows * nnz_per_row;
+  size_type nnzM = numRows * (2 * nnz_per_row);
+  crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnzA, 2, bandwidth);
+  crsMat_t M = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numRows, nnzM, 2, 2 * bandwidth);
+
+  check_spgemm_masked<crsMat_t, device>(A, A, M, false);
+  check_spgemm_masked<crsMat_t, device>(A, A, M, true);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## spgemm_masked ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_spgemm_masked<SCALAR,ORDINAL,OFFSET,DEVICE>(10, 3, 8); \
+  test_spgemm_masked<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 10, 50); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int64_t, size_t, TestExecSpace)
+#endif
+
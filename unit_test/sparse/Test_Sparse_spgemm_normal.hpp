@@ -0,0 +1,251 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+
+#include<KokkosSparse_CrsMatrix.hpp>
+#include<KokkosSparse_spgemm_normal.hpp>
+#include<KokkosKernels_SparseUtils.hpp>
+#include<KokkosKernels_IOUtils.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+#include<vector>
+
+#ifndef kokkos_complex_double
+#define kokkos_complex_double Kokkos::complex<double>
+#define kokkos_complex_float Kokkos::complex<float>
+#endif
+
+namespace Test {
+
+template <typename crsMat_t, typename device>
+void check_spgemm_normal(crsMat_t A, KokkosSparse::Experimental::SpgemmNormalProduct product) {
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type lno_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_nnz_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+
+  typedef typename lno_view_t::value_type size_type;
+  typedef typename lno_nnz_view_t::value_type lno_t;
+  typedef typename scalar_view_t::value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> KAT;
+  typedef typename KAT::mag_type mag_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  const bool a_at = product == KokkosSparse::Experimental::SPGEMM_A_AT;
+  const lno_t m = A.numRows();
+  const lno_t n = A.numCols();
+  const lno_t c_rows = a_at ? m : n;
+
+  //the rows of A must be sorted.
+  lno_nnz_view_t entriesA("entriesA", A.graph.entries.extent(0));
+  scalar_view_t valuesA("valuesA", A.values.extent(0));
+  KokkosKernels::Impl::kk_sort_graph
+      <typename graph_t::row_map_type, typename graph_t::entries_type, typename crsMat_t::values_type,
+       lno_nnz_view_t, scalar_view_t, typename device::execution_space>
+      (A.graph.row_map, A.graph.entries, A.values, entriesA, valuesA);
+
+  KernelHandle kh;
+  kh.create_spgemm_handle();
+
+  lno_view_t row_mapC("row_mapC", c_rows + 1);
+  KokkosSparse::Experimental::spgemm_normal_symbolic(
+      &kh, product, m, n,
+      A.graph.row_map, entriesA,
+      row_mapC);
+
+  size_t c_nnz = kh.get_spgemm_handle()->get_c_nnz();
+  lno_nnz_view_t entriesC("entriesC", c_nnz);
+  scalar_view_t valuesC("valuesC", c_nnz);
+  KokkosSparse::Experimental::spgemm_normal_numeric(
+      &kh, product, m, n,
+      A.graph.row_map, entriesA, valuesA,
+      row_mapC, entriesC, valuesC);
+  kh.destroy_spgemm_handle();
+
+  typename graph_t::row_map_type::HostMirror h_rmA = Kokkos::create_mirror_view(A.graph.row_map);
+  typename lno_nnz_view_t::HostMirror h_entA = Kokkos::create_mirror_view(entriesA);
+  typename scalar_view_t::HostMirror h_valA = Kokkos::create_mirror_view(valuesA);
+  Kokkos::deep_copy(h_rmA, A.graph.row_map);
+  Kokkos::deep_copy(h_entA, entriesA);
+  Kokkos::deep_copy(h_valA, valuesA);
+
+  typename lno_view_t::HostMirror h_rmC = Kokkos::create_mirror_view(row_mapC);
+  typename lno_nnz_view_t::HostMirror h_entC = Kokkos::create_mirror_view(entriesC);
+  typename scalar_view_t::HostMirror h_valC = Kokkos::create_mirror_view(valuesC);
+  Kokkos::deep_copy(h_rmC, row_mapC);
+  Kokkos::deep_copy(h_entC, entriesC);
+  Kokkos::deep_copy(h_valC, valuesC);
+
+  //reference with an explicit transpose on the host.
+  std::vector<size_type> t_rm(n + 1, 0);
+  std::vector<lno_t> t_ent(h_entA.extent(0));
+  std::vector<scalar_t> t_val(h_entA.extent(0));
+  for (size_type a = 0; a < h_rmA(m); ++a) ++t_rm[h_entA(a) + 1];
+  for (lno_t j = 0; j < n; ++j) t_rm[j + 1] += t_rm[j];
+  std::vector<size_type> t_pos(t_rm.begin(), t_rm.end() - 1);
+  for (lno_t i = 0; i < m; ++i){
+    for (size_type a = h_rmA(i); a < h_rmA(i + 1); ++a){
+      const size_type p = t_pos[h_entA(a)]++;
+      t_ent[p] = i;
+      t_val[p] = h_valA(a);
+    }
+  }
+
+  const mag_t eps = std::is_same<mag_t, float>::value ? 1e-3 : 1e-9;
+
+  std::vector<scalar_t> c(c_rows, KAT::zero());
+  std::vector<mag_t> c_mag(c_rows, 0);
+  std::vector<char> in_c(c_rows, 0), seen(c_rows, 0);
+  for (lno_t i = 0; i < c_rows; ++i){
+    lno_t ref_row_nnz = 0;
+    //row i of the left operand times the right operand.
+    const size_type l_begin = a_at ? h_rmA(i) : t_rm[i];
+    const size_type l_end = a_at ? h_rmA(i + 1) : t_rm[i + 1];
+    for (size_type l = l_begin; l < l_end; ++l){
+      const lno_t k = a_at ? h_entA(l) : t_ent[l];
+      const scalar_t val_l = a_at ? h_valA(l) : t_val[l];
+      const size_type r_begin = a_at ? t_rm[k] : h_rmA(k);
+      const size_type r_end = a_at ? t_rm[k + 1] : h_rmA(k + 1);
+      for (size_type r = r_begin; r < r_end; ++r){
+        const lno_t col = a_at ? t_ent[r] : h_entA(r);
+        const scalar_t val_r = a_at ? t_val[r] : h_valA(r);
+        if (!in_c[col]) ++ref_row_nnz;
+        in_c[col] = 1;
+        c[col] += val_l * val_r;
+        c_mag[col] += KAT::abs(val_l) * KAT::abs(val_r);
+      }
+    }
+
+    EXPECT_EQ(size_type (ref_row_nnz), h_rmC(i + 1) - h_rmC(i)) << "row " << i;
+    for (size_type z = h_rmC(i); z < h_rmC(i + 1); ++z){
+      const lno_t col = h_entC(z);
+      ASSERT_TRUE(col >= 0 && col < c_rows);
+      EXPECT_TRUE(in_c[col] && !seen[col]) << "row " << i << " col " << col;
+      seen[col] = 1;
+      EXPECT_NEAR_KK(h_valC(z), c[col], eps * (1 + c_mag[col]));
+    }
+    for (lno_t j = 0; j < c_rows; ++j){
+      c[j] = KAT::zero();
+      c_mag[j] = 0;
+      in_c[j] = seen[j] = 0;
+    }
+  }
+}
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_spgemm_normal(lno_t numRows, lno_t numCols, size_type nnz_per_row, lno_t bandwidth) {
+  using namespace Test;
+  typedef KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+
+  size_type nnzA = numRows * nnz_per_row;
+  crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numCols, nnzA, 2, bandwidth);
+
+  check_spgemm_normal<crsMat_t, device>(A, KokkosSparse::Experimental::SPGEMM_A_AT);
+  check_spgemm_normal<crsMat_t, device>(A, KokkosSparse::Experimental::SPGEMM_AT_A);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## spgemm_normal ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_spgemm_normal<SCALAR,ORDINAL,OFFSET,DEVICE>(10, 10, 3, 8); \
+  test_spgemm_normal<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 600, 10, 50); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int64_t, size_t, TestExecSpace)
+#endif
+
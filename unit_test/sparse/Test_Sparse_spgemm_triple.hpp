@@ -0,0 +1,248 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+
+#include<KokkosSparse_CrsMatrix.hpp>
+#include<KokkosSparse_spgemm_triple.hpp>
+#include<KokkosKernels_IOUtils.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+#include<vector>
+
+#ifndef kokkos_complex_double
+#define kokkos_complex_double Kokkos::complex<double>
+#define kokkos_complex_float Kokkos::complex<float>
+#endif
+
+namespace Test {
+
+//Computes C = R*A*P with the fused kernel and compares each row with a
+//dense host accumulation of (R*A)*P.
+template <typename crsMat_t, typename device>
+void check_spgemm_triple(crsMat_t R, crsMat_t A, crsMat_t P) {
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type lno_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_nnz_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+
+  typedef typename lno_view_t::value_type size_type;
+  typedef typename lno_nnz_view_t::value_type lno_t;
+  typedef typename scalar_view_t::value_type scalar_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> KAT;
+  typedef typename KAT::mag_type mag_t;
+
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t,
+      typename device::execution_space, typename device::memory_space, typename device::memory_space> KernelHandle;
+
+  const lno_t m = R.numRows();
+  const lno_t n = A.numRows();
+  const lno_t k = P.numRows();
+  const lno_t l = P.numCols();
+
+  KernelHandle kh;
+  kh.create_spgemm_handle();
+
+  lno_view_t row_mapC("row_mapC", m + 1);
+  KokkosSparse::Experimental::spgemm_triple_symbolic(
+      &kh, m, n, k, l,
+      R.graph.row_map, R.graph.entries,
+      A.graph.row_map, A.graph.entries,
+      P.graph.row_map, P.graph.entries,
+      row_mapC);
+
+  size_t c_nnz = kh.get_spgemm_handle()->get_c_nnz();
+  lno_nnz_view_t entriesC("entriesC", c_nnz);
+  scalar_view_t valuesC("valuesC", c_nnz);
+  KokkosSparse::Experimental::spgemm_triple_numeric(
+      &kh, m, n, k, l,
+      R.graph.row_map, R.graph.entries, R.values,
+      A.graph.row_map, A.graph.entries, A.values,
+      P.graph.row_map, P.graph.entries, P.values,
+      row_mapC, entriesC, valuesC);
+  kh.destroy_spgemm_handle();
+
+  typename graph_t::row_map_type::HostMirror h_rmR = Kokkos::create_mirror_view(R.graph.row_map);
+  typename graph_t::entries_type::HostMirror h_entR = Kokkos::create_mirror_view(R.graph.entries);
+  typename crsMat_t::values_type::HostMirror h_valR = Kokkos::create_mirror_view(R.values);
+  typename graph_t::row_map_type::HostMirror h_rmA = Kokkos::create_mirror_view(A.graph.row_map);
+  typename graph_t::entries_type::HostMirror h_entA = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror h_valA = Kokkos::create_mirror_view(A.values);
+  typename graph_t::row_map_type::HostMirror h_rmP = Kokkos::create_mirror_view(P.graph.row_map);
+  typename graph_t::entries_type::HostMirror h_entP = Kokkos::create_mirror_view(P.graph.entries);
+  typename crsMat_t::values_type::HostMirror h_valP = Kokkos::create_mirror_view(P.values);
+  Kokkos::deep_copy(h_rmR, R.graph.row_map);
+  Kokkos::deep_copy(h_entR, R.graph.entries);
+  Kokkos::deep_copy(h_valR, R.values);
+  Kokkos::deep_copy(h_rmA, A.graph.row_map);
+  Kokkos::deep_copy(h_entA, A.graph.entries);
+  Kokkos::deep_copy(h_valA, A.values);
+  Kokkos::deep_copy(h_rmP, P.graph.row_map);
+  Kokkos::deep_copy(h_entP, P.graph.entries);
+  Kokkos::deep_copy(h_valP, P.values);
+
+  typename lno_view_t::HostMirror h_rmC = Kokkos::create_mirror_view(row_mapC);
+  typename lno_nnz_view_t::HostMirror h_entC = Kokkos::create_mirror_view(entriesC);
+  typename scalar_view_t::HostMirror h_valC = Kokkos::create_mirror_view(valuesC);
+  Kokkos::deep_copy(h_rmC, row_mapC);
+  Kokkos::deep_copy(h_entC, entriesC);
+  Kokkos::deep_copy(h_valC, valuesC);
+
+  const mag_t eps = std::is_same<mag_t, float>::value ? 1e-3 : 1e-9;
+
+  std::vector<scalar_t> ra(k, KAT::zero()), c(l, KAT::zero());
+  std::vector<mag_t> ra_mag(k, 0), c_mag(l, 0);
+  std::vector<char> in_c(l, 0);
+  for (lno_t i = 0; i < m; ++i){
+    for (size_type r = h_rmR(i); r < h_rmR(i + 1); ++r){
+      const lno_t rowA = h_entR(r);
+      for (size_type a = h_rmA(rowA); a < h_rmA(rowA + 1); ++a){
+        ra[h_entA(a)] += h_valR(r) * h_valA(a);
+        ra_mag[h_entA(a)] += KAT::abs(h_valR(r)) * KAT::abs(h_valA(a));
+      }
+    }
+    lno_t ref_row_nnz = 0;
+    for (lno_t j = 0; j < k; ++j){
+      if (ra_mag[j] == 0) continue;
+      for (size_type p = h_rmP(j); p < h_rmP(j + 1); ++p){
+        const lno_t col = h_entP(p);
+        if (!in_c[col]) { in_c[col] = 1; ++ref_row_nnz; }
+        c[col] += ra[j] * h_valP(p);
+        c_mag[col] += ra_mag[j] * KAT::abs(h_valP(p));
+      }
+      ra[j] = KAT::zero();
+      ra_mag[j] = 0;
+    }
+
+    EXPECT_EQ(size_type (ref_row_nnz), h_rmC(i + 1) - h_rmC(i)) << "row " << i;
+    for (size_type z = h_rmC(i); z < h_rmC(i + 1); ++z){
+      const lno_t col = h_entC(z);
+      ASSERT_TRUE(col >= 0 && col < l);
+      EXPECT_TRUE(in_c[col]) << "row " << i << " col " << col;
+      EXPECT_NEAR_KK(h_valC(z), c[col], eps * (1 + c_mag[col]));
+    }
+    for (lno_t j = 0; j < l; ++j){
+      c[j] = KAT::zero();
+      c_mag[j] = 0;
+      in_c[j] = 0;
+    }
+  }
+}
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_spgemm_triple(lno_t fine_rows, lno_t coarse_rows, size_type nnz_per_row, lno_t bandwidth) {
+  using namespace Test;
+  typedef KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+
+  size_type nnzA = fine_rows * nnz_per_row;
+  size_type nnzR = coarse_rows * nnz_per_row;
+  size_type nnzP = fine_rows * (nnz_per_row / 2 + 1);
+  crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(fine_rows, fine_rows, nnzA, 2, bandwidth);
+  crsMat_t R = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(coarse_rows, fine_rows, nnzR, 2, bandwidth);
+  crsMat_t P = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(fine_rows, coarse_rows, nnzP, 2, bandwidth);
+
+  check_spgemm_triple<crsMat_t, device>(R, A, P);
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## spgemm_triple ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_spgemm_triple<SCALAR,ORDINAL,OFFSET,DEVICE>(12, 8, 3, 8); \
+  test_spgemm_triple<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 600, 10, 50); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int64_t, size_t, TestExecSpace)
+#endif
+
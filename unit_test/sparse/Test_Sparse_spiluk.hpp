@@ -0,0 +1,157 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+
+#include<KokkosSparse_CrsMatrix.hpp>
+#include<KokkosSparse_spiluk.hpp>
+#include<KokkosSparse_sptrsv.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+#include<cstdlib>     //for rand
+#include<vector>
+
+#ifndef kokkos_complex_double
+#define kokkos_complex_double Kokkos::complex<double>
+#define kokkos_complex_float Kokkos::complex<float>
+#endif
+
+namespace Test {
+
+//banded matrix with random off-diagonal entries -1 within the bandwidth
+//and the diagonal set so that every row sums to 2.
+template <typename crsMat_t, typename vector_t>
+crsMat_t makeBandedMatrix(
+    typename crsMat_t::ordinal_type nrows,
+    typename crsMat_t::ordinal_type bandwidth,
+    vector_t &b)
+{
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type size_type_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename size_type_view_t::non_const_value_type size_type;
+  typedef typename lno_view_t::non_const_value_type lno_t;
+  typedef typename scalar_view_t::non_const_value_type scalar_t;
+
+  srand(13721);
+  std::vector<size_type> rowmap(nrows + 1, 0);
+  std::vector<lno_t> entries;
+  std::vector<scalar_t> values;
+  typename vector_t::HostMirror h_b = Kokkos::create_mirror_view(b);
+  const scalar_t one = Kokkos::Details::ArithTraits<scalar_t>::one();
+  for (lno_t i = 0; i < nrows; i++){
+    scalar_t diag = one + one;
+    const size_type diag_pos = entries.size();
+    entries.push_back(i);
+    values.push_back(diag);
+    const lno_t begin = i < bandwidth ? 0 : i - bandwidth;
+    const lno_t end = i + 1 + bandwidth < nrows ? i + 1 + bandwidth : nrows;
+    for (lno_t j = begin; j < end; j++){
+      if (j != i && (j == i - 1 || j == i + 1 || rand() % 3 == 0)){
+        entries.push_back(j);
+        values.push_back(-one);
+        diag += one;
+      }
+    }
+    values[diag_pos] = diag;
+    h_b(i) = one + one;
+    rowmap[i + 1] = entries.size();
+  }
+  Kokkos::deep_copy(b, h_b);
+
+  const size_type nnz = rowmap[nrows];
+  size_type_view_t d_rowmap("rowmap", nrows + 1);
+  lno_view_t d_entries("entries", nnz);
+  scalar_view_t d_values("values", nnz);
+  typename size_type_view_t::HostMirror h_rowmap = Kokkos::create_mirror_view(d_rowmap);
+  typename lno_view_t::HostMirror h_entries = Kokkos::create_mirror_view(d_entries);
+  typename scalar_view_t::HostMirror h_values = Kokkos::create_mirror_view(d_values);
+  for (lno_t i = 0; i <= nrows; i++) h_rowmap(i) = rowmap[i];
+  for (size_type i = 0; i < nnz; i++){
+    h_entries(i) = entries[i];
+    h_values(i) = values[i];
+  }
+  Kokkos::deep_copy(d_rowmap, h_rowmap);
+  Kokkos::deep_copy(d_entries, h_entries);
+  Kokkos::deep_copy(d_values, h_values);
+  return crsMat_t("banded matrix", nrows, nrows, nnz, d_values, d_rowmap, d_entries);
+}
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, class Device>
+void test_spiluk(lno_t numRows, lno_t bandwidth)
+{
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, Device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+
+  typedef typename KokkosKernels::Experimental::KokkosKernelsHandle<size_type, lno_t, scalar_t,
+  typename Device::execution_space, typename Device::memory_space, typename Device::memory_space> KernelHandle;
+
+  scalar_view_t b("b", numRows);
+  scalar_view_t y("y", numRows);
+  scalar_view_t x("x", numRows);
+  scalar_view_t expected_x("expected_x", numRows);
+  Kokkos::deep_copy(expected_x, Kokkos::Details::ArithTraits<scalar_t>::one());
+
+  crsMat_t A = Test::makeBandedMatrix<crsMat_t, scalar_view_t>(numRows, bandwidth, b);
+
+  double eps = std::is_same<scalar_t, float>::value || std::is_same<scalar_t, Kokkos::complex<float> >::value ? 1e-3 : 1e-7;
+
+  std::vector<KokkosSparse::SPILUKAlgorithm> algorithms;
+  algorithms.push_back(KokkosSparse::SPILUK_DEFAULT);
+  algorithms.push_back(KokkosSparse::SPILUK_LVLSCHD_RP);
+  algorithms.push_back(KokkosSparse::SPILUK_LVLSCHD_TP1);
+  algorithms.push_back(KokkosSparse::SPILUK_TASK);
+
+  for (size_t ialgo = 0; ialgo < algorithms.size(); ++ialgo){
+    //ILU(0) keeps the pattern of A, with the diagonal in both factors
+    {
+      KernelHandle kh;
+      kh.create_spiluk_handle(algorithms[ialgo], numRows, 0);
+      KokkosSparse::Experimental::spiluk_symbolic(&kh, A.graph.row_map, A.graph.entries);
+      EXPECT_TRUE(kh.get_spiluk_handle()->is_symbolic_complete());
+      EXPECT_EQ(size_t(kh.get_spiluk_handle()->get_nnzL() + kh.get_spiluk_handle()->get_nnzU()),
+                size_t(A.nnz() + numRows));
+    }
+
+    //with a level of fill of at least the bandwidth there is no dropped
+    //entry, and L and U are the exact LU factors of A
+    KernelHandle kh;
+    kh.create_spiluk_handle(algorithms[ialgo], numRows, numRows);
+    crsMat_t L, U;
+    KokkosSparse::Experimental::spiluk_numeric(&kh, A, L, U);
+    EXPECT_TRUE(kh.get_spiluk_handle()->is_numeric_complete());
+
+    kh.create_sptrsv_handle(numRows, true);
+    Kokkos::deep_copy(y, Kokkos::Details::ArithTraits<scalar_t>::zero());
+    KokkosSparse::Experimental::sptrsv_solve(&kh, L.graph.row_map, L.graph.entries, L.values, b, y);
+    kh.create_sptrsv_handle(numRows, false);
+    Kokkos::deep_copy(x, Kokkos::Details::ArithTraits<scalar_t>::zero());
+    KokkosSparse::Experimental::sptrsv_solve(&kh, U.graph.row_map, U.graph.entries, U.values, y, x);
+    EXPECT_NEAR_KK_1DVIEW(expected_x, x, eps);
+
+    //second factorization reuses the symbolic phase
+    KokkosSparse::Experimental::spiluk_numeric(&kh, A, L, U);
+    Kokkos::deep_copy(x, Kokkos::Details::ArithTraits<scalar_t>::zero());
+    KokkosSparse::Experimental::sptrsv_solve(&kh, U.graph.row_map, U.graph.entries, U.values, y, x);
+    EXPECT_NEAR_KK_1DVIEW(expected_x, x, eps);
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory,sparse ## _ ## spiluk ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_spiluk<SCALAR,ORDINAL,OFFSET,DEVICE> (1, 1); \
+  test_spiluk<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 5); \
+  test_spiluk<SCALAR,ORDINAL,OFFSET,DEVICE> (1000, 20); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
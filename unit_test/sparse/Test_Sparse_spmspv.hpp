@@ -0,0 +1,184 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_spmspv.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+namespace Test {
+
+//y = A*x on the host, sorted by row.
+template <typename crsMat_t>
+std::vector<std::pair<typename crsMat_t::ordinal_type, typename crsMat_t::value_type> >
+host_spmspv(const crsMat_t &A, const std::vector<typename crsMat_t::ordinal_type> &x_indices,
+    const std::vector<typename crsMat_t::value_type> &x_values){
+  typedef typename crsMat_t::ordinal_type lno_t;
+  typedef typename crsMat_t::size_type size_type;
+  typedef typename crsMat_t::value_type scalar_t;
+  typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(hr, A.graph.row_map);
+  Kokkos::deep_copy(he, A.graph.entries);
+  Kokkos::deep_copy(hv, A.values);
+  std::vector<scalar_t> dense_x(A.numCols(), scalar_t());
+  std::vector<bool> x_marker(A.numCols(), false);
+  for (size_t k = 0; k < x_indices.size(); ++k){
+    dense_x[x_indices[k]] = x_values[k];
+    x_marker[x_indices[k]] = true;
+  }
+  std::vector<std::pair<lno_t, scalar_t> > y;
+  for (lno_t i = 0; i < A.numRows(); ++i){
+    scalar_t sum = scalar_t();
+    bool hit = false;
+    for (size_type j = hr(i); j < hr(i + 1); ++j){
+      if (x_marker[he(j)]){
+        sum += hv(j) * dense_x[he(j)];
+        hit = true;
+      }
+    }
+    if (hit) y.push_back(std::make_pair(i, sum));
+  }
+  return y;
+}
+
+//the nonzeroes of y computed on the device, sorted by row.
+template <typename index_view_t, typename value_view_t>
+std::vector<std::pair<typename index_view_t::value_type, typename value_view_t::value_type> >
+sorted_host_sparse_vector(const index_view_t &indices, const value_view_t &values, size_t n){
+  typename index_view_t::HostMirror hi = Kokkos::create_mirror_view(indices);
+  typename value_view_t::HostMirror hv = Kokkos::create_mirror_view(values);
+  Kokkos::deep_copy(hi, indices);
+  Kokkos::deep_copy(hv, values);
+  std::vector<std::pair<typename index_view_t::value_type, typename value_view_t::value_type> > y;
+  for (size_t k = 0; k < n; ++k) y.push_back(std::make_pair(hi(k), hv(k)));
+  std::sort(y.begin(), y.end());
+  return y;
+}
+
+template <typename pair_t>
+void check_sparse_vector(const std::vector<pair_t> &y, const std::vector<pair_t> &expected){
+  ASSERT_EQ(y.size(), expected.size());
+  for (size_t k = 0; k < y.size(); ++k){
+    EXPECT_EQ(y[k].first, expected[k].first);
+    EXPECT_NEAR(y[k].second, expected[k].second, 1e-9 * (1 + std::abs(expected[k].second)));
+  }
+}
+
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_spmspv(lno_t numRows, lno_t numCols, size_type nnz, lno_t bandwidth, lno_t row_size_variance, lno_t nx) {
+  using namespace Test;
+  using namespace KokkosSparse::Experimental;
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::execution_space exec_space;
+  typedef SpMSpVHandle<lno_t, size_type, scalar_t, exec_space> handle_t;
+  typedef Kokkos::View<lno_t *, device> index_view_t;
+  typedef Kokkos::View<scalar_t *, device> value_view_t;
+
+  crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numCols, nnz, row_size_variance, bandwidth);
+
+  //a frontier of nx distinct columns.
+  std::vector<lno_t> columns(numCols);
+  for (lno_t j = 0; j < numCols; ++j) columns[j] = j;
+  std::random_shuffle(columns.begin(), columns.end());
+  std::vector<lno_t> hx_indices(columns.begin(), columns.begin() + nx);
+  std::vector<scalar_t> hx_values(nx);
+  for (lno_t k = 0; k < nx; ++k) hx_values[k] = scalar_t(1 + k % 7) / 4;
+
+  index_view_t x_indices("x_indices", nx);
+  value_view_t x_values("x_values", nx);
+  typename index_view_t::HostMirror hxi = Kokkos::create_mirror_view(x_indices);
+  typename value_view_t::HostMirror hxv = Kokkos::create_mirror_view(x_values);
+  for (lno_t k = 0; k < nx; ++k){
+    hxi(k) = hx_indices[k];
+    hxv(k) = hx_values[k];
+  }
+  Kokkos::deep_copy(x_indices, hxi);
+  Kokkos::deep_copy(x_values, hxv);
+
+  const std::vector<std::pair<lno_t, scalar_t> > expected = host_spmspv(A, hx_indices, hx_values);
+
+  const SpMSpVAlgorithm algorithms[3] = {SPMSPV_PUSH, SPMSPV_PULL, SPMSPV_AUTO};
+  for (int a = 0; a < 3; ++a){
+    handle_t handle;
+    handle.set_algorithm(algorithms[a]);
+    index_view_t y_indices;
+    value_view_t y_values;
+    //the second call reuses the transpose and the work arrays of the handle.
+    for (int rep = 0; rep < 2; ++rep){
+      lno_t nnz_y = spmspv(handle, A, x_indices, x_values, y_indices, y_values);
+      if (algorithms[a] != SPMSPV_AUTO) EXPECT_EQ(handle.get_last_algorithm(), algorithms[a]);
+      check_sparse_vector(sorted_host_sparse_vector(y_indices, y_values, nnz_y), expected);
+    }
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## spmspv ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_spmspv<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000, 1000 * 30, 200, 10, 1); \
+  test_spmspv<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000, 1000 * 30, 200, 10, 50); \
+  test_spmspv<SCALAR,ORDINAL,OFFSET,DEVICE>(800, 2000, 800 * 20, 2000, 10, 1500); \
+  test_spmspv<SCALAR,ORDINAL,OFFSET,DEVICE>(2000, 100, 2000 * 10, 100, 5, 30); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -3,6 +3,18 @@
 #include<Kokkos_Random.hpp>
 
 #include<KokkosSparse_spmv.hpp>
+#include<KokkosSparse_spmv_sell.hpp>
+#include<KokkosSparse_spmv_dot.hpp>
+#include<KokkosSparse_spmv_blockcrs.hpp>
+#include<KokkosSparse_spmv_symmetric.hpp>
+#include<KokkosSparse_spmv_deltacrs.hpp>
+#include<KokkosSparse_spmv_split.hpp>
+#include<KokkosSparse_spmv_partitioned.hpp>
+#include<KokkosSparse_spmm_dense.hpp>
+#include<KokkosKernels_SparseUtils.hpp>
+#include<KokkosBlas1_dot.hpp>
+#include<KokkosBlas1_axpby.hpp>
+#include<KokkosBlas1_scal.hpp>
 #include<KokkosKernels_TestUtils.hpp>
 #include<KokkosKernels_IOUtils.hpp>
 #include<KokkosKernels_Utils.hpp>
@@ -89,7 +101,8 @@ void sequential_spmv(crsMat_t input_mat, x_vector_type x, y_vector_type y,
 
 template <typename crsMat_t, typename x_vector_type, typename y_vector_type>
 void check_spmv(crsMat_t input_mat, x_vector_type x, y_vector_type y,
-    typename y_vector_type::non_const_value_type alpha, typename y_vector_type::non_const_value_type beta){
+    typename y_vector_type::non_const_value_type alpha, typename y_vector_type::non_const_value_type beta,
+    const KokkosSparse::SPMVControls& controls = KokkosSparse::SPMVControls()){
   //typedef typename crsMat_t::StaticCrsGraphType graph_t;
   typedef typename crsMat_t::execution_space ExecSpace;
   typedef Kokkos::RangePolicy<ExecSpace> my_exec_space;
@@ -104,7 +117,7 @@ void check_spmv(crsMat_t input_mat, x_vector_type x, y_vector_type y,
 
   sequential_spmv(input_mat, x, expected_y, alpha, beta);
   //KokkosKernels::Impl::print_1Dview(expected_y);
-  KokkosSparse::spmv("N", alpha, input_mat, x, beta, y);
+  KokkosSparse::spmv(controls, "N", alpha, input_mat, x, beta, y);
   //KokkosKernels::Impl::print_1Dview(y);
   typedef Kokkos::Details::ArithTraits<typename y_vector_type::non_const_value_type> AT;
   int num_errors = 0;
@@ -117,10 +130,290 @@ void check_spmv(crsMat_t input_mat, x_vector_type x, y_vector_type y,
   EXPECT_TRUE(num_errors==0);
 }
 
+template <typename crsMat_t, typename x_vector_type, typename y_vector_type, typename handle_t>
+void check_spmv_handle(handle_t &handle, crsMat_t input_mat, x_vector_type x, y_vector_type y,
+    typename y_vector_type::non_const_value_type alpha, typename y_vector_type::non_const_value_type beta){
+  typedef typename crsMat_t::execution_space ExecSpace;
+  typedef Kokkos::RangePolicy<ExecSpace> my_exec_space;
+
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename scalar_view_t::value_type ScalarA;
+  double eps = std::is_same<ScalarA,float>::value?2*1e-3:1e-7;
+  size_t nr = input_mat.numRows();
+  y_vector_type expected_y("expected", nr);
+  Kokkos::deep_copy(expected_y, y);
+  Kokkos::fence();
+
+  sequential_spmv(input_mat, x, expected_y, alpha, beta);
+  KokkosSparse::spmv(handle, "N", alpha, input_mat, x, beta, y);
+  EXPECT_TRUE(handle.get_is_inspected());
+  int num_errors = 0;
+  Kokkos::parallel_reduce("KokkosKernels::UnitTests::spmv_handle"
+                         ,my_exec_space(0, y.extent(0))
+                         ,fSPMV<y_vector_type, y_vector_type, y_vector_type>(expected_y,y,eps)
+                         ,num_errors);
+  if(num_errors>0) printf("KokkosKernels::UnitTests::spmv_handle: %i errors of %i\n",
+      num_errors,y.extent_int(0));
+  EXPECT_TRUE(num_errors==0);
+}
+
+template <typename crsMat_t, typename x_vector_type, typename y_vector_type>
+void check_spmv_cached_transpose(crsMat_t input_mat, x_vector_type x, y_vector_type y,
+    typename y_vector_type::non_const_value_type alpha, typename y_vector_type::non_const_value_type beta){
+  typedef typename crsMat_t::execution_space ExecSpace;
+  typedef Kokkos::RangePolicy<ExecSpace> my_exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename scalar_view_t::value_type ScalarA;
+  typedef KokkosSparse::SPMVHandle<typename crsMat_t::non_const_ordinal_type,
+      typename crsMat_t::non_const_size_type, ExecSpace> handle_t;
+
+  double eps = std::is_same<ScalarA,float>::value?2*1e-3:1e-7;
+  size_t nc = input_mat.numCols();
+  y_vector_type expected_y("expected", nc);
+
+  //a copy of the values, which are changed in place below.
+  scalar_view_t values("values", input_mat.nnz());
+  Kokkos::deep_copy(values, input_mat.values);
+  crsMat_t mat("cached transpose", input_mat.numCols(), values, input_mat.graph);
+
+  KokkosSparse::SPMVControls controls;
+  controls.set_cache_transpose(true);
+  handle_t handle(controls);
+  for (int update = 0; update < 2; ++update){
+    if (update){
+      KokkosBlas::scal(values, ScalarA(2), values);
+      handle.values_updated();
+    }
+    Kokkos::deep_copy(expected_y, y);
+    KokkosSparse::spmv("T", alpha, mat, x, beta, expected_y);
+    KokkosSparse::spmv(handle, "T", alpha, mat, x, beta, y);
+    EXPECT_TRUE(handle.get_is_transpose_inspected());
+    EXPECT_TRUE(handle.get_are_transpose_values_current());
+    int num_errors = 0;
+    Kokkos::parallel_reduce("KokkosKernels::UnitTests::spmv_cached_transpose"
+                           ,my_exec_space(0, y.extent(0))
+                           ,fSPMV<y_vector_type, y_vector_type, y_vector_type>(expected_y,y,eps)
+                           ,num_errors);
+    if(num_errors>0) printf("KokkosKernels::UnitTests::spmv_cached_transpose: %i errors of %i after %i updates\n",
+        num_errors,y.extent_int(0),update);
+    EXPECT_TRUE(num_errors==0);
+  }
+}
+
+template <typename crsMat_t, typename x_vector_type, typename y_vector_type>
+void check_spmv_sell(crsMat_t input_mat, x_vector_type x, y_vector_type y,
+    typename y_vector_type::non_const_value_type alpha, typename y_vector_type::non_const_value_type beta,
+    typename crsMat_t::ordinal_type chunk_size, typename crsMat_t::ordinal_type sigma){
+  typedef typename crsMat_t::execution_space ExecSpace;
+  typedef Kokkos::RangePolicy<ExecSpace> my_exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename scalar_view_t::value_type ScalarA;
+  typedef KokkosSparse::Experimental::SellMatrix<ScalarA, typename crsMat_t::ordinal_type,
+      typename crsMat_t::device_type, typename crsMat_t::size_type> sellMat_t;
+
+  double eps = std::is_same<ScalarA,float>::value?2*1e-3:1e-7;
+  size_t nr = input_mat.numRows();
+  y_vector_type expected_y("expected", nr);
+  Kokkos::deep_copy(expected_y, y);
+  Kokkos::fence();
+
+  sellMat_t sell_mat(input_mat, chunk_size, sigma);
+  sequential_spmv(input_mat, x, expected_y, alpha, beta);
+  KokkosSparse::Experimental::spmv("N", alpha, sell_mat, x, beta, y);
+  int num_errors = 0;
+  Kokkos::parallel_reduce("KokkosKernels::UnitTests::spmv_sell"
+                         ,my_exec_space(0, y.extent(0))
+                         ,fSPMV<y_vector_type, y_vector_type, y_vector_type>(expected_y,y,eps)
+                         ,num_errors);
+  if(num_errors>0) printf("KokkosKernels::UnitTests::spmv_sell: %i errors of %i with chunk size %i, sigma %i\n",
+      num_errors,y.extent_int(0),int(chunk_size),int(sigma));
+  EXPECT_TRUE(num_errors==0);
+}
+
+template <typename crsMat_t, typename x_vector_type, typename y_vector_type, typename delta_t>
+void check_spmv_deltacrs(crsMat_t input_mat, x_vector_type x, y_vector_type y,
+    typename y_vector_type::non_const_value_type alpha, typename y_vector_type::non_const_value_type beta,
+    delta_t){
+  typedef typename crsMat_t::execution_space ExecSpace;
+  typedef Kokkos::RangePolicy<ExecSpace> my_exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename scalar_view_t::value_type ScalarA;
+  typedef KokkosSparse::Experimental::DeltaCrsMatrix<ScalarA, typename crsMat_t::ordinal_type,
+      typename crsMat_t::device_type, typename crsMat_t::size_type, delta_t> deltaMat_t;
+
+  double eps = std::is_same<ScalarA,float>::value?2*1e-3:1e-7;
+  size_t nr = input_mat.numRows();
+  y_vector_type expected_y("expected", nr);
+  Kokkos::deep_copy(expected_y, y);
+  Kokkos::fence();
+
+  deltaMat_t delta_mat(input_mat);
+  sequential_spmv(input_mat, x, expected_y, alpha, beta);
+  KokkosSparse::Experimental::spmv("N", alpha, delta_mat, x, beta, y);
+  int num_errors = 0;
+  Kokkos::parallel_reduce("KokkosKernels::UnitTests::spmv_deltacrs"
+                         ,my_exec_space(0, y.extent(0))
+                         ,fSPMV<y_vector_type, y_vector_type, y_vector_type>(expected_y,y,eps)
+                         ,num_errors);
+  if(num_errors>0) printf("KokkosKernels::UnitTests::spmv_deltacrs: %i errors of %i with %i wide entries\n",
+      num_errors,y.extent_int(0),int(delta_mat.numWideEntries()));
+  EXPECT_TRUE(num_errors==0);
+}
+
+template <typename crsMat_t, typename x_vector_type, typename y_vector_type>
+void check_spmv_dot(crsMat_t input_mat, x_vector_type x, y_vector_type y,
+    typename y_vector_type::non_const_value_type alpha, typename y_vector_type::non_const_value_type beta){
+  typedef typename crsMat_t::execution_space ExecSpace;
+  typedef Kokkos::RangePolicy<ExecSpace> my_exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename scalar_view_t::value_type ScalarA;
+  typedef Kokkos::Details::ArithTraits<typename y_vector_type::non_const_value_type> AT;
+
+  double eps = std::is_same<ScalarA,float>::value?2*1e-3:1e-7;
+  size_t nr = input_mat.numRows();
+  y_vector_type expected_y("expected", nr);
+  Kokkos::deep_copy(expected_y, y);
+  Kokkos::fence();
+
+  sequential_spmv(input_mat, x, expected_y, alpha, beta);
+  auto x_owned = Kokkos::subview(x, std::pair<size_t, size_t>(0, nr));
+  auto expected_dot = KokkosBlas::dot(x_owned, expected_y);
+  auto fused_dot = KokkosSparse::Experimental::spmv_dot("N", alpha, input_mat, x, beta, y);
+  int num_errors = 0;
+  Kokkos::parallel_reduce("KokkosKernels::UnitTests::spmv_dot"
+                         ,my_exec_space(0, y.extent(0))
+                         ,fSPMV<y_vector_type, y_vector_type, y_vector_type>(expected_y,y,eps)
+                         ,num_errors);
+  if(num_errors>0) printf("KokkosKernels::UnitTests::spmv_dot: %i errors of %i\n",
+      num_errors,y.extent_int(0));
+  EXPECT_TRUE(num_errors==0);
+  EXPECT_TRUE(AT::abs(expected_dot - fused_dot) <= eps * (AT::abs(expected_dot) + 1));
+}
+
+template <typename crsMat_t, typename x_vector_type, typename y_vector_type>
+void check_spmv_space(crsMat_t input_mat, x_vector_type x, y_vector_type y,
+    typename y_vector_type::non_const_value_type alpha, typename y_vector_type::non_const_value_type beta){
+  typedef typename crsMat_t::execution_space ExecSpace;
+  typedef Kokkos::RangePolicy<ExecSpace> my_exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename scalar_view_t::value_type ScalarA;
+  typedef Kokkos::Details::ArithTraits<typename y_vector_type::non_const_value_type> AT;
+
+  double eps = std::is_same<ScalarA,float>::value?2*1e-3:1e-7;
+  size_t nr = input_mat.numRows();
+  y_vector_type expected_y("expected", nr);
+  Kokkos::deep_copy(expected_y, y);
+  Kokkos::fence();
+
+  sequential_spmv(input_mat, x, expected_y, alpha, beta);
+  ExecSpace space;
+  KokkosSparse::spmv(space, "N", alpha, input_mat, x, beta, y);
+  space.fence();
+  int num_errors = 0;
+  Kokkos::parallel_reduce("KokkosKernels::UnitTests::spmv_space"
+                         ,my_exec_space(0, y.extent(0))
+                         ,fSPMV<y_vector_type, y_vector_type, y_vector_type>(expected_y,y,eps)
+                         ,num_errors);
+  if(num_errors>0) printf("KokkosKernels::UnitTests::spmv_space: %i errors of %i\n",
+      num_errors,y.extent_int(0));
+  EXPECT_TRUE(num_errors==0);
+
+  //The BLAS1 overloads on the same instance: y := y - expected_y must be zero.
+  auto x_owned = Kokkos::subview(x, std::pair<size_t, size_t>(0, nr));
+  auto expected_dot = KokkosBlas::dot(x_owned, expected_y);
+  auto space_dot = KokkosBlas::dot(space, x_owned, y);
+  EXPECT_TRUE(AT::abs(expected_dot - space_dot) <= eps * (AT::abs(expected_dot) + 1));
+  KokkosBlas::axpby(space, -AT::one(), expected_y, AT::one(), y);
+  KokkosBlas::scal(space, y, AT::one() + AT::one(), y);
+  auto diff_dot = KokkosBlas::dot(space, y, y);
+  EXPECT_TRUE(AT::abs(diff_dot) <= eps * (AT::abs(expected_dot) + 1));
+}
+
+template <typename crsMat_t, typename x_vector_type, typename y_vector_type>
+void check_spmv_split(crsMat_t input_mat, x_vector_type x, y_vector_type y,
+    typename y_vector_type::non_const_value_type alpha, typename y_vector_type::non_const_value_type beta,
+    typename crsMat_t::ordinal_type column_threshold){
+  typedef typename crsMat_t::execution_space ExecSpace;
+  typedef Kokkos::RangePolicy<ExecSpace> my_exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename scalar_view_t::value_type ScalarA;
+  typedef KokkosSparse::Experimental::SplitCrsMatrix<ScalarA, typename crsMat_t::ordinal_type,
+    typename crsMat_t::device_type, typename crsMat_t::size_type> split_matrix_t;
+
+  double eps = std::is_same<ScalarA,float>::value?2*1e-3:1e-7;
+  size_t nr = input_mat.numRows();
+  y_vector_type expected_y("expected", nr);
+  Kokkos::deep_copy(expected_y, y);
+  Kokkos::fence();
+
+  sequential_spmv(input_mat, x, expected_y, alpha, beta);
+  split_matrix_t split_mat(input_mat, column_threshold);
+  EXPECT_TRUE(split_mat.nnz() == input_mat.nnz());
+  //The ghost phase is issued separately, as after a halo exchange.
+  ExecSpace space;
+  KokkosSparse::Experimental::spmv_owned(space, "N", alpha, split_mat, x, beta, y);
+  KokkosSparse::Experimental::spmv_ghost(space, "N", alpha, split_mat, x, y);
+  space.fence();
+  int num_errors = 0;
+  Kokkos::parallel_reduce("KokkosKernels::UnitTests::spmv_split"
+                         ,my_exec_space(0, y.extent(0))
+                         ,fSPMV<y_vector_type, y_vector_type, y_vector_type>(expected_y,y,eps)
+                         ,num_errors);
+  if(num_errors>0) printf("KokkosKernels::UnitTests::spmv_split: %i errors of %i with threshold %d\n",
+      num_errors,y.extent_int(0),(int) column_threshold);
+  EXPECT_TRUE(num_errors==0);
+}
+
+template <typename crsMat_t, typename x_vector_type, typename y_vector_type>
+void check_spmv_partitioned(crsMat_t input_mat, x_vector_type x, y_vector_type y,
+    typename y_vector_type::non_const_value_type alpha, typename y_vector_type::non_const_value_type beta,
+    int num_parts){
+  typedef typename crsMat_t::execution_space ExecSpace;
+  typedef Kokkos::RangePolicy<ExecSpace> my_exec_space;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename scalar_view_t::value_type ScalarA;
+  typedef KokkosSparse::Experimental::RowPartitionedCrsMatrix<ScalarA, typename crsMat_t::ordinal_type,
+    typename crsMat_t::device_type, typename crsMat_t::size_type> partitioned_matrix_t;
+
+  double eps = std::is_same<ScalarA,float>::value?2*1e-3:1e-7;
+  size_t nr = input_mat.numRows();
+  y_vector_type expected_y("expected", nr);
+  Kokkos::deep_copy(expected_y, y);
+  Kokkos::fence();
+
+  sequential_spmv(input_mat, x, expected_y, alpha, beta);
+  partitioned_matrix_t partitioned_mat(input_mat, num_parts);
+  EXPECT_EQ(partitioned_mat.numParts(), num_parts);
+  EXPECT_TRUE(partitioned_mat.nnz() == input_mat.nnz());
+  EXPECT_EQ(partitioned_mat.numRows(), input_mat.numRows());
+  //one instance per part, as one per device or stream.
+  std::vector<ExecSpace> spaces(num_parts);
+  KokkosSparse::Experimental::spmv(spaces, "N", alpha, partitioned_mat, x, beta, y);
+  for (int p = 0; p < num_parts; ++p) spaces[p].fence();
+  int num_errors = 0;
+  Kokkos::parallel_reduce("KokkosKernels::UnitTests::spmv_partitioned"
+                         ,my_exec_space(0, y.extent(0))
+                         ,fSPMV<y_vector_type, y_vector_type, y_vector_type>(expected_y,y,eps)
+                         ,num_errors);
+  if(num_errors>0) printf("KokkosKernels::UnitTests::spmv_partitioned: %i errors of %i with %d parts\n",
+      num_errors,y.extent_int(0),num_parts);
+  EXPECT_TRUE(num_errors==0);
+
+  //the gathered matrix is the input matrix.
+  crsMat_t gathered = partitioned_mat.gather();
+  EXPECT_TRUE((KokkosKernels::Impl::kk_is_identical_view
+      <typename crsMat_t::row_map_type, typename crsMat_t::row_map_type, typename crsMat_t::size_type, ExecSpace>
+      (gathered.graph.row_map, input_mat.graph.row_map, 0)));
+  EXPECT_TRUE((KokkosKernels::Impl::kk_is_identical_view
+      <typename crsMat_t::index_type, typename crsMat_t::index_type, typename crsMat_t::ordinal_type, ExecSpace>
+      (gathered.graph.entries, input_mat.graph.entries, 0)));
+}
+
 template <typename crsMat_t, typename x_vector_type, typename y_vector_type>
 void check_spmv_mv(crsMat_t input_mat, x_vector_type x, y_vector_type y, y_vector_type expected_y,
     typename y_vector_type::non_const_value_type alpha,
-    typename y_vector_type::non_const_value_type beta, int numMV){
+    typename y_vector_type::non_const_value_type beta, int numMV,
+    const KokkosSparse::SPMVControls& controls = KokkosSparse::SPMVControls()){
   //typedef typename crsMat_t::StaticCrsGraphType graph_t;
   typedef typename crsMat_t::execution_space ExecSpace;
   typedef Kokkos::RangePolicy<ExecSpace> my_exec_space;
@@ -133,7 +426,7 @@ void check_spmv_mv(crsMat_t input_mat, x_vector_type x, y_vector_type y, y_vecto
 
   Kokkos::fence();
 
-  KokkosSparse::spmv("N", alpha, input_mat, x, beta, y);
+  KokkosSparse::spmv(controls, "N", alpha, input_mat, x, beta, y);
 
 
   for (int i = 0; i < numMV; ++i){
@@ -156,7 +449,247 @@ void check_spmv_mv(crsMat_t input_mat, x_vector_type x, y_vector_type y, y_vecto
   }
 }
 
+template <typename crsMat_t, typename layout>
+void check_dense_spmm(crsMat_t input_mat, int numMV,
+    typename crsMat_t::non_const_value_type alpha, typename crsMat_t::non_const_value_type beta){
+  typedef typename crsMat_t::execution_space ExecSpace;
+  typedef typename crsMat_t::device_type Device;
+  typedef typename crsMat_t::non_const_value_type ScalarA;
+  typedef typename crsMat_t::non_const_ordinal_type lno_t;
+  typedef typename crsMat_t::non_const_size_type size_type;
+  typedef Kokkos::Details::ArithTraits<ScalarA> AT;
+  typedef Kokkos::View<ScalarA**, layout, Device> mv_t;
+  typedef KokkosSparse::SPMVHandle<lno_t, size_type, ExecSpace> handle_t;
+
+  double eps = std::is_same<ScalarA,float>::value?2*1e-3:1e-7;
+  const lno_t nr = input_mat.numRows();
+  const lno_t nc = input_mat.numCols();
+
+  //X*A with X numMV x nr, and A^T*X with X nr x numMV.
+  mv_t x_left("x_left", numMV, nr), y_left("y_left", numMV, nc);
+  mv_t x_t("x_t", nr, numMV), y_t("y_t", nc, numMV);
+  Kokkos::Random_XorShift64_Pool<ExecSpace> rand_pool(13718);
+  Kokkos::fill_random(x_left,rand_pool,ScalarA(10));
+  Kokkos::fill_random(y_left,rand_pool,ScalarA(10));
+  Kokkos::fill_random(x_t,rand_pool,ScalarA(10));
+  Kokkos::fill_random(y_t,rand_pool,ScalarA(10));
+
+  typename mv_t::HostMirror h_x_left = Kokkos::create_mirror_view(x_left);
+  typename mv_t::HostMirror h_x_t = Kokkos::create_mirror_view(x_t);
+  typename mv_t::HostMirror expected_left = Kokkos::create_mirror_view(y_left);
+  typename mv_t::HostMirror expected_t = Kokkos::create_mirror_view(y_t);
+  Kokkos::deep_copy(h_x_left, x_left);
+  Kokkos::deep_copy(h_x_t, x_t);
+  Kokkos::deep_copy(expected_left, y_left);
+  Kokkos::deep_copy(expected_t, y_t);
+
+  handle_t handle;
+  KokkosSparse::Experimental::dense_spmm(handle, alpha, x_left, input_mat, beta, y_left);
+  KokkosSparse::Experimental::spmm_transpose(handle, alpha, input_mat, x_t, beta, y_t);
+  EXPECT_TRUE(handle.get_is_transpose_inspected());
+
+  auto h_row_map = Kokkos::create_mirror_view(input_mat.graph.row_map);
+  auto h_entries = Kokkos::create_mirror_view(input_mat.graph.entries);
+  auto h_values = Kokkos::create_mirror_view(input_mat.values);
+  Kokkos::deep_copy(h_row_map, input_mat.graph.row_map);
+  Kokkos::deep_copy(h_entries, input_mat.graph.entries);
+  Kokkos::deep_copy(h_values, input_mat.values);
+  for (lno_t j = 0; j < nc; ++j){
+    for (int k = 0; k < numMV; ++k){
+      expected_left(k, j) = beta * expected_left(k, j);
+      expected_t(j, k) = beta * expected_t(j, k);
+    }
+  }
+  for (lno_t i = 0; i < nr; ++i){
+    for (size_type z = h_row_map(i); z < h_row_map(i + 1); ++z){
+      const lno_t j = h_entries(z);
+      for (int k = 0; k < numMV; ++k){
+        expected_left(k, j) += alpha * h_values(z) * h_x_left(k, i);
+        expected_t(j, k) += alpha * h_values(z) * h_x_t(i, k);
+      }
+    }
+  }
+
+  typename mv_t::HostMirror h_y_left = Kokkos::create_mirror_view(y_left);
+  typename mv_t::HostMirror h_y_t = Kokkos::create_mirror_view(y_t);
+  Kokkos::deep_copy(h_y_left, y_left);
+  Kokkos::deep_copy(h_y_t, y_t);
+  int num_errors_left = 0, num_errors_t = 0;
+  for (lno_t j = 0; j < nc; ++j){
+    for (int k = 0; k < numMV; ++k){
+      if (AT::abs(expected_left(k, j) - h_y_left(k, j)) > eps * (1 + AT::abs(expected_left(k, j)))) ++num_errors_left;
+      if (AT::abs(expected_t(j, k) - h_y_t(j, k)) > eps * (1 + AT::abs(expected_t(j, k)))) ++num_errors_t;
+    }
+  }
+  if(num_errors_left>0) printf("KokkosKernels::UnitTests::dense_spmm: %i errors of %i for %i vectors\n",
+      num_errors_left,int(nc*numMV),numMV);
+  if(num_errors_t>0) printf("KokkosKernels::UnitTests::spmm_transpose: %i errors of %i for %i vectors\n",
+      num_errors_t,int(nc*numMV),numMV);
+  EXPECT_TRUE(num_errors_left==0);
+  EXPECT_TRUE(num_errors_t==0);
+}
+
+}
+template <typename scalar_t, typename lno_t, typename size_type, class Device>
+void test_spmv_blockcrs(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance, lno_t block_size, int numMV){
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, Device, void, size_type> crsMat_t;
+  typedef typename KokkosSparse::Experimental::BlockCrsMatrix<scalar_t, lno_t, Device, void, size_type> blockCrsMat_t;
+  typedef typename crsMat_t::row_map_type::non_const_type row_map_t;
+  typedef typename crsMat_t::index_type::non_const_type entries_t;
+  typedef typename crsMat_t::values_type::non_const_type values_t;
+  typedef Kokkos::View<scalar_t**, Kokkos::LayoutLeft, Device> mv_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> AT;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows,numRows,nnz,row_size_variance, bandwidth);
+
+  //point matrix with dense blocks, in the layout of a BlockCrsMatrix.
+  size_t out_r, out_c;
+  row_map_t xadj;
+  entries_t adj;
+  values_t vals;
+  KokkosKernels::Impl::kk_create_blockcrs_formated_point_crsmatrix(
+      block_size, numRows, numRows,
+      input_mat.graph.row_map, input_mat.graph.entries, input_mat.values,
+      out_r, out_c, xadj, adj, vals);
+  crsMat_t point_mat("blocked point", out_r, out_c, vals.extent(0), vals, xadj, adj);
+  blockCrsMat_t block_mat(point_mat, block_size);
+
+  //the block size is found again from the point matrix.
+  EXPECT_EQ(KokkosKernels::Impl::kk_find_point_crs_block_size(block_size, out_r, out_c, xadj, adj), block_size);
+  blockCrsMat_t detected_mat =
+      KokkosKernels::Impl::kk_create_blockcrs_matrix_from_point_crs<blockCrsMat_t>(point_mat, block_size);
+  EXPECT_EQ(detected_mat.blockDim(), block_size);
+  EXPECT_EQ(detected_mat.numRows(), block_mat.numRows());
+  EXPECT_EQ(detected_mat.nnz(), block_mat.nnz());
+
+  mv_t x("x", out_c, numMV), y("y", out_r, numMV), expected_y("expected_y", out_r, numMV);
+  Kokkos::Random_XorShift64_Pool<typename Device::execution_space> rand_pool(13718);
+  Kokkos::fill_random(x,rand_pool,scalar_t(10));
+  Kokkos::fill_random(y,rand_pool,scalar_t(10));
+  Kokkos::deep_copy(expected_y, y);
+
+  double eps = std::is_same<scalar_t,float>::value?2*1e-3:1e-7;
+  for (int beta = 0; beta < 2; ++beta){
+    KokkosSparse::spmv("N", scalar_t(1), point_mat, x, scalar_t(beta), expected_y);
+    KokkosSparse::Experimental::spmv("N", scalar_t(1), detected_mat, x, scalar_t(beta), y);
+    auto x0 = Kokkos::subview(x, Kokkos::ALL(), 0);
+    auto y0 = Kokkos::subview(y, Kokkos::ALL(), 0);
+    auto expected_y0 = Kokkos::subview(expected_y, Kokkos::ALL(), 0);
+    KokkosSparse::spmv("N", scalar_t(1), point_mat, x0, scalar_t(beta), expected_y0);
+    KokkosSparse::Experimental::spmv("N", scalar_t(1), block_mat, x0, scalar_t(beta), y0);
+
+    typename mv_t::HostMirror h_y = Kokkos::create_mirror_view(y);
+    typename mv_t::HostMirror h_expected_y = Kokkos::create_mirror_view(expected_y);
+    Kokkos::deep_copy(h_y, y);
+    Kokkos::deep_copy(h_expected_y, expected_y);
+    int num_errors = 0;
+    for (size_t i = 0; i < out_r; ++i){
+      for (int k = 0; k < numMV; ++k){
+        if (AT::abs(h_y(i, k) - h_expected_y(i, k)) > eps * (1 + AT::abs(h_expected_y(i, k)))) num_errors++;
+      }
+    }
+    if(num_errors>0) printf("KokkosKernels::UnitTests::spmv_blockcrs: %i errors with block size %i\n",
+        num_errors, int(block_size));
+    EXPECT_TRUE(num_errors==0);
+  }
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, class Device>
+void test_spmv_symmetric(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance){
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, Device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::row_map_type::non_const_type row_map_t;
+  typedef typename crsMat_t::index_type::non_const_type entries_t;
+  typedef typename crsMat_t::values_type::non_const_type values_t;
+  typedef Kokkos::Details::ArithTraits<scalar_t> AT;
+
+  crsMat_t input_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows,numRows,nnz,row_size_variance, bandwidth);
+  typename row_map_t::HostMirror h_row_map = Kokkos::create_mirror_view(input_mat.graph.row_map);
+  typename entries_t::HostMirror h_entries = Kokkos::create_mirror_view(input_mat.graph.entries);
+  typename values_t::HostMirror h_values = Kokkos::create_mirror_view(input_mat.values);
+  Kokkos::deep_copy(h_row_map, input_mat.graph.row_map);
+  Kokkos::deep_copy(h_entries, input_mat.graph.entries);
+  Kokkos::deep_copy(h_values, input_mat.values);
+
+  //the upper triangle of the generated matrix, and the symmetric matrix it stands for.
+  row_map_t upper_row_map("upper row_map", numRows + 1), full_row_map("full row_map", numRows + 1);
+  typename row_map_t::HostMirror h_upper_row_map = Kokkos::create_mirror_view(upper_row_map);
+  typename row_map_t::HostMirror h_full_row_map = Kokkos::create_mirror_view(full_row_map);
+  for (lno_t i = 0; i <= numRows; ++i){
+    h_upper_row_map(i) = 0;
+    h_full_row_map(i) = 0;
+  }
+  for (lno_t i = 0; i < numRows; ++i){
+    for (size_type k = h_row_map(i); k < h_row_map(i + 1); ++k){
+      lno_t j = h_entries(k);
+      if (j < i) continue;
+      h_upper_row_map(i + 1)++;
+      h_full_row_map(i + 1)++;
+      if (j != i) h_full_row_map(j + 1)++;
+    }
+  }
+  for (lno_t i = 0; i < numRows; ++i){
+    h_upper_row_map(i + 1) += h_upper_row_map(i);
+    h_full_row_map(i + 1) += h_full_row_map(i);
+  }
+  entries_t upper_entries("upper entries", h_upper_row_map(numRows)), full_entries("full entries", h_full_row_map(numRows));
+  values_t upper_values("upper values", h_upper_row_map(numRows)), full_values("full values", h_full_row_map(numRows));
+  typename entries_t::HostMirror h_upper_entries = Kokkos::create_mirror_view(upper_entries);
+  typename entries_t::HostMirror h_full_entries = Kokkos::create_mirror_view(full_entries);
+  typename values_t::HostMirror h_upper_values = Kokkos::create_mirror_view(upper_values);
+  typename values_t::HostMirror h_full_values = Kokkos::create_mirror_view(full_values);
+  std::vector<size_type> full_pos(h_full_row_map.data(), h_full_row_map.data() + numRows);
+  size_type upper_pos = 0;
+  for (lno_t i = 0; i < numRows; ++i){
+    for (size_type k = h_row_map(i); k < h_row_map(i + 1); ++k){
+      lno_t j = h_entries(k);
+      if (j < i) continue;
+      h_upper_entries(upper_pos) = j;
+      h_upper_values(upper_pos++) = h_values(k);
+      h_full_entries(full_pos[i]) = j;
+      h_full_values(full_pos[i]++) = h_values(k);
+      if (j != i){
+        h_full_entries(full_pos[j]) = i;
+        h_full_values(full_pos[j]++) = h_values(k);
+      }
+    }
+  }
+  Kokkos::deep_copy(upper_row_map, h_upper_row_map);
+  Kokkos::deep_copy(upper_entries, h_upper_entries);
+  Kokkos::deep_copy(upper_values, h_upper_values);
+  Kokkos::deep_copy(full_row_map, h_full_row_map);
+  Kokkos::deep_copy(full_entries, h_full_entries);
+  Kokkos::deep_copy(full_values, h_full_values);
+  crsMat_t upper_mat("upper", numRows, numRows, upper_values.extent(0), upper_values, upper_row_map, upper_entries);
+  crsMat_t full_mat("full", numRows, numRows, full_values.extent(0), full_values, full_row_map, full_entries);
+
+  values_t x("x", numRows), y("y", numRows), expected_y("expected_y", numRows);
+  Kokkos::Random_XorShift64_Pool<typename Device::execution_space> rand_pool(13718);
+  Kokkos::fill_random(x,rand_pool,scalar_t(10));
+  Kokkos::fill_random(y,rand_pool,scalar_t(10));
+  Kokkos::deep_copy(expected_y, y);
+
+  //the coloring of the first call is reused by the next ones.
+  KokkosSparse::SPMVHandle<lno_t, size_type, typename Device::execution_space> handle;
+  double eps = std::is_same<scalar_t,float>::value?2*1e-3:1e-7;
+  for (int beta = 0; beta < 2; ++beta){
+    KokkosSparse::spmv("N", scalar_t(1), full_mat, x, scalar_t(beta), expected_y);
+    KokkosSparse::Experimental::spmv_symmetric(handle, "N", scalar_t(1), upper_mat, x, scalar_t(beta), y);
+    EXPECT_TRUE(handle.get_is_symmetric_inspected());
+
+    typename values_t::HostMirror h_y = Kokkos::create_mirror_view(y);
+    typename values_t::HostMirror h_expected_y = Kokkos::create_mirror_view(expected_y);
+    Kokkos::deep_copy(h_y, y);
+    Kokkos::deep_copy(h_expected_y, expected_y);
+    int num_errors = 0;
+    for (lno_t i = 0; i < numRows; ++i){
+      if (AT::abs(h_y(i) - h_expected_y(i)) > eps * (1 + AT::abs(h_expected_y(i)))) num_errors++;
+    }
+    if(num_errors>0) printf("KokkosKernels::UnitTests::spmv_symmetric: %i errors of %i\n",
+        num_errors, int(numRows));
+    EXPECT_TRUE(num_errors==0);
+  }
 }
+
 template <typename scalar_t, typename lno_t, typename size_type, class Device>
 void test_spmv(lno_t numRows,size_type nnz, lno_t bandwidth, lno_t row_size_variance){
 
@@ -188,6 +721,69 @@ void test_spmv(lno_t numRows,size_type nnz, lno_t bandwidth, lno_t row_size_vari
   Test::check_spmv(input_mat, input_x, output_y, 1.0, 0.0);
   Test::check_spmv(input_mat, input_x, output_y, 0.0, 1.0);
   Test::check_spmv(input_mat, input_x, output_y, 1.0, 1.0);
+
+  //merge path, with few items per thread so that rows are split among threads.
+  KokkosSparse::SPMVControls controls(KokkosSparse::SPMV_MERGE_PATH);
+  Test::check_spmv(input_mat, input_x, output_y, 1.0, 0.0, controls);
+  Test::check_spmv(input_mat, input_x, output_y, 1.0, 1.0, controls);
+  controls.set_merge_path_items_per_thread(7);
+  Test::check_spmv(input_mat, input_x, output_y, 1.0, 0.0, controls);
+  Test::check_spmv(input_mat, input_x, output_y, 0.0, 1.0, controls);
+  Test::check_spmv(input_mat, input_x, output_y, 1.0, 1.0, controls);
+
+  //the plan of the first call is reused by the next ones.
+  KokkosSparse::SPMVHandle<lno_t, size_type, typename Device::execution_space> handle;
+  Test::check_spmv_handle(handle, input_mat, input_x, output_y, 1.0, 0.0);
+  Test::check_spmv_handle(handle, input_mat, input_x, output_y, 0.0, 1.0);
+  Test::check_spmv_handle(handle, input_mat, input_x, output_y, 1.0, 1.0);
+  KokkosSparse::SPMVHandle<lno_t, size_type, typename Device::execution_space> merge_handle(controls);
+  Test::check_spmv_handle(merge_handle, input_mat, input_x, output_y, 1.0, 0.0);
+  EXPECT_TRUE(merge_handle.get_kernel() == KokkosSparse::SPMV_KERNEL_MERGE_PATH);
+  Test::check_spmv_handle(merge_handle, input_mat, input_x, output_y, 1.0, 1.0);
+  //x staged in scratch by the teams whose window of columns is narrow enough; the
+  //rows near the ends wrap around, so their worksets read x in place.
+  KokkosSparse::SPMVHandle<lno_t, size_type, typename Device::execution_space>
+    banded_handle(KokkosSparse::SPMVControls(KokkosSparse::SPMV_BANDED));
+  Test::check_spmv_handle(banded_handle, input_mat, input_x, output_y, 1.0, 0.0);
+  EXPECT_TRUE(banded_handle.get_kernel() == KokkosSparse::SPMV_KERNEL_BANDED);
+  EXPECT_EQ(banded_handle.get_workset_col_begin().extent(0) + 1, banded_handle.get_workset_offsets().extent(0));
+  Test::check_spmv_handle(banded_handle, input_mat, input_x, output_y, 0.0, 1.0);
+  Test::check_spmv_handle(banded_handle, input_mat, input_x, output_y, 1.0, 1.0);
+
+  //transpose through the transpose cached in the handle, before and after a change of values.
+  Test::check_spmv_cached_transpose(input_mat, input_x, output_y, 1.0, 0.0);
+  Test::check_spmv_cached_transpose(input_mat, input_x, output_y, 1.0, 1.0);
+
+  //sliced ELL with the default chunk size, and with a chunk size that leaves a partial last chunk.
+  lno_t chunk_size = KokkosSparse::Experimental::sell_default_chunk_size<scalar_t, typename Device::execution_space>();
+  Test::check_spmv_sell(input_mat, input_x, output_y, 1.0, 0.0, chunk_size, 32 * chunk_size);
+  Test::check_spmv_sell(input_mat, input_x, output_y, 1.0, 1.0, chunk_size, 1);
+  Test::check_spmv_sell(input_mat, input_x, output_y, 1.0, 1.0, 3, 7);
+
+  //16 bit deltas, and 8 bit deltas with the rows of a bandwidth over 255 at full width.
+  Test::check_spmv_deltacrs(input_mat, input_x, output_y, 1.0, 0.0, uint16_t());
+  Test::check_spmv_deltacrs(input_mat, input_x, output_y, 1.0, 1.0, uint16_t());
+  Test::check_spmv_deltacrs(input_mat, input_x, output_y, 1.0, 1.0, uint8_t());
+
+  Test::check_spmv_dot(input_mat, input_x, output_y, 1.0, 0.0);
+  Test::check_spmv_dot(input_mat, input_x, output_y, 1.0, 1.0);
+
+  Test::check_spmv_space(input_mat, input_x, output_y, 1.0, 0.0);
+  Test::check_spmv_space(input_mat, input_x, output_y, 1.0, 1.0);
+
+  Test::check_spmv_split(input_mat, input_x, output_y, 1.0, 0.0, input_mat.numCols() * 3 / 4);
+  Test::check_spmv_split(input_mat, input_x, output_y, 1.0, 1.0, input_mat.numCols() * 3 / 4);
+  Test::check_spmv_split(input_mat, input_x, output_y, 1.0, 1.0, input_mat.numCols());
+  Test::check_spmv_partitioned(input_mat, input_x, output_y, 1.0, 0.0, 1);
+  Test::check_spmv_partitioned(input_mat, input_x, output_y, 1.0, 1.0, 3);
+
+  //block sizes of the unrolled kernels, and one of the runtime kernel.
+  test_spmv_blockcrs<scalar_t, lno_t, size_type, Device>(1000, 1000 * 5, 100, 2, 2, 3);
+  test_spmv_blockcrs<scalar_t, lno_t, size_type, Device>(1000, 1000 * 5, 100, 2, 5, 1);
+  test_spmv_blockcrs<scalar_t, lno_t, size_type, Device>(1000, 1000 * 5, 100, 2, 8, 2);
+  test_spmv_blockcrs<scalar_t, lno_t, size_type, Device>(1000, 1000 * 5, 100, 2, 11, 2);
+
+  test_spmv_symmetric<scalar_t, lno_t, size_type, Device>(1000, 1000 * 10, 200, 5);
 }
 
 template <typename scalar_t, typename lno_t, typename size_type, typename layout, class Device>
@@ -220,6 +816,14 @@ void test_spmv_mv(lno_t numRows,size_type nnz, lno_t bandwidth, lno_t row_size_v
   Test::check_spmv_mv(input_mat, b_x, b_y, b_y_copy, 0.0, 1.0, numMV);
   Test::check_spmv_mv(input_mat, b_x, b_y, b_y_copy, 1.0, 1.0, numMV);
 
+  KokkosSparse::SPMVControls controls(KokkosSparse::SPMV_MERGE_PATH);
+  controls.set_merge_path_items_per_thread(7);
+  Test::check_spmv_mv(input_mat, b_x, b_y, b_y_copy, 1.0, 0.0, numMV, controls);
+  Test::check_spmv_mv(input_mat, b_x, b_y, b_y_copy, 1.0, 1.0, numMV, controls);
+
+  Test::check_dense_spmm<crsMat_t, layout>(input_mat, numMV, 1.0, 0.0);
+  Test::check_dense_spmm<crsMat_t, layout>(input_mat, numMV, 2.0, 1.0);
+
 
 }
 
@@ -366,6 +970,59 @@ void test_github_issue_101 ()
   }
 }
 
+template <typename lno_t, typename size_type, class Device>
+void test_spmv_mixed(lno_t numRows, size_type nnz, lno_t bandwidth, lno_t row_size_variance, int numMV){
+  typedef typename KokkosSparse::CrsMatrix<float, lno_t, Device, void, size_type> floatMat_t;
+  typedef typename KokkosSparse::CrsMatrix<double, lno_t, Device, void, size_type> doubleMat_t;
+  typedef typename doubleMat_t::values_type::non_const_type double_view_t;
+  typedef Kokkos::View<double**, Kokkos::LayoutLeft, Device> mv_t;
+  typedef Kokkos::Details::ArithTraits<double> AT;
+
+  floatMat_t float_mat = KokkosKernels::Impl::kk_generate_sparse_matrix<floatMat_t>(numRows,numRows,nnz,row_size_variance, bandwidth);
+
+  //the same matrix in double, with the values of the float matrix.
+  typename floatMat_t::values_type::HostMirror h_float_values = Kokkos::create_mirror_view(float_mat.values);
+  Kokkos::deep_copy(h_float_values, float_mat.values);
+  double_view_t double_values("double values", float_mat.nnz());
+  typename double_view_t::HostMirror h_double_values = Kokkos::create_mirror_view(double_values);
+  for (size_t k = 0; k < h_float_values.extent(0); ++k){
+    h_double_values(k) = h_float_values(k);
+  }
+  Kokkos::deep_copy(double_values, h_double_values);
+  doubleMat_t double_mat("double", float_mat.numCols(), double_values, float_mat.graph);
+
+  mv_t x("x", numRows, numMV), y("y", numRows, numMV), expected_y("expected_y", numRows, numMV);
+  Kokkos::Random_XorShift64_Pool<typename Device::execution_space> rand_pool(13718);
+  Kokkos::fill_random(x,rand_pool,10.0);
+  Kokkos::fill_random(y,rand_pool,10.0);
+  Kokkos::deep_copy(expected_y, y);
+
+  //the products accumulate in double, so they match the double matrix to double precision.
+  double eps = 1e-7;
+  for (int beta = 0; beta < 2; ++beta){
+    KokkosSparse::spmv("N", 1.0, double_mat, x, double(beta), expected_y);
+    KokkosSparse::spmv("N", 1.0, float_mat, x, double(beta), y);
+    auto x0 = Kokkos::subview(x, Kokkos::ALL(), 0);
+    auto y0 = Kokkos::subview(y, Kokkos::ALL(), 0);
+    auto expected_y0 = Kokkos::subview(expected_y, Kokkos::ALL(), 0);
+    KokkosSparse::spmv("N", 1.0, double_mat, x0, double(beta), expected_y0);
+    KokkosSparse::spmv("N", 1.0, float_mat, x0, double(beta), y0);
+
+    typename mv_t::HostMirror h_y = Kokkos::create_mirror_view(y);
+    typename mv_t::HostMirror h_expected_y = Kokkos::create_mirror_view(expected_y);
+    Kokkos::deep_copy(h_y, y);
+    Kokkos::deep_copy(h_expected_y, expected_y);
+    int num_errors = 0;
+    for (lno_t i = 0; i < numRows; ++i){
+      for (int k = 0; k < numMV; ++k){
+        if (AT::abs(h_y(i, k) - h_expected_y(i, k)) > eps * (1 + AT::abs(h_expected_y(i, k)))) num_errors++;
+      }
+    }
+    if(num_errors>0) printf("KokkosKernels::UnitTests::spmv_mixed: %i errors\n", num_errors);
+    EXPECT_TRUE(num_errors==0);
+  }
+}
+
 #define EXECUTE_TEST_ISSUE_101( DEVICE) \
 TEST_F( TestCategory,sparse ## _ ## spmv_issue_101 ## _ ## OFFSET ## _ ## DEVICE ) { \
 	test_github_issue_101<DEVICE> (); \
@@ -379,11 +1036,18 @@ TEST_F( TestCategory,sparse ## _ ## spmv ## _ ## SCALAR ## _ ## ORDINAL ## _ ##
   test_spmv<SCALAR,ORDINAL,OFFSET,DEVICE> (10000, 10000 * 20, 100, 5); \
 }
 
+#define EXECUTE_TEST_MIXED(ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory,sparse ## _ ## spmv_mixed ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_spmv_mixed<ORDINAL,OFFSET,DEVICE> (10000, 10000 * 20, 100, 5, 3); \
+}
+
 #define EXECUTE_TEST_MV(SCALAR, ORDINAL, OFFSET, LAYOUT, DEVICE) \
 TEST_F( TestCategory,sparse ## _ ## spmv_mv ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## LAYOUT ## _ ## DEVICE ) { \
   test_spmv_mv<SCALAR,ORDINAL,OFFSET,Kokkos::LAYOUT,DEVICE> (50000, 50000 * 30, 100, 10, 5); \
   test_spmv_mv<SCALAR,ORDINAL,OFFSET,Kokkos::LAYOUT,DEVICE> (50000, 50000 * 30, 200, 10, 1); \
   test_spmv_mv<SCALAR,ORDINAL,OFFSET,Kokkos::LAYOUT,DEVICE> (10000, 10000 * 20, 100, 5, 10); \
+  test_spmv_mv<SCALAR,ORDINAL,OFFSET,Kokkos::LAYOUT,DEVICE> (2000, 2000 * 20, 100, 5, 3); \
+  test_spmv_mv<SCALAR,ORDINAL,OFFSET,Kokkos::LAYOUT,DEVICE> (2000, 2000 * 20, 100, 5, 37); \
 }
 
 #if (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
@@ -694,4 +1358,8 @@ TEST_F( TestCategory,sparse ## _ ## spmv_mv ## _ ## SCALAR ## _ ## ORDINAL ## _
  EXECUTE_TEST_MV(kokkos_complex_float, int64_t, size_t, LayoutRight, TestExecSpace)
 #endif
 
-
+#if (defined (KOKKOSKERNELS_INST_FLOAT) && defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) && defined(KOKKOSKERNELS_INST_LAYOUTLEFT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST_MIXED(int, int, TestExecSpace)
+#endif
@@ -0,0 +1,319 @@
+#include<gtest/gtest.h>
+#include<Kokkos_Core.hpp>
+
+#include<KokkosSparse_CrsMatrix.hpp>
+#include<KokkosSparse_sptrsv.hpp>
+#include<KokkosKernels_TestUtils.hpp>
+
+#include<cstdlib>     //for rand
+#include<vector>
+
+#ifndef kokkos_complex_double
+#define kokkos_complex_double Kokkos::complex<double>
+#define kokkos_complex_float Kokkos::complex<float>
+#endif
+
+namespace Test {
+
+//Creates a random banded lower (or upper) triangular matrix with a
+//dominant diagonal, and the right hand side b = A * ones.
+//If dense is true, all entries within the band are nonzero.
+template <typename crsMat_t, typename vector_t>
+crsMat_t makeTriangularMatrix(
+    typename crsMat_t::ordinal_type nrows,
+    typename crsMat_t::ordinal_type bandwidth,
+    bool lower_tri,
+    vector_t &b,
+    bool dense = false)
+{
+  typedef typename crsMat_t::StaticCrsGraphType graph_t;
+  typedef typename graph_t::row_map_type::non_const_type size_type_view_t;
+  typedef typename graph_t::entries_type::non_const_type lno_view_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef typename size_type_view_t::non_const_value_type size_type;
+  typedef typename lno_view_t::non_const_value_type lno_t;
+  typedef typename scalar_view_t::non_const_value_type scalar_t;
+
+  srand(24816);
+  std::vector<size_type> rowmap(nrows + 1, 0);
+  std::vector<lno_t> entries;
+  std::vector<scalar_t> values;
+  typename vector_t::HostMirror h_b = Kokkos::create_mirror_view(b);
+  const scalar_t one = Kokkos::Details::ArithTraits<scalar_t>::one();
+  for (lno_t i = 0; i < nrows; i++){
+    scalar_t diag = one + one;
+    const lno_t begin = lower_tri ? (i < bandwidth ? 0 : i - bandwidth) : i + 1;
+    const lno_t end = lower_tri ? i : (i + 1 + bandwidth < nrows ? i + 1 + bandwidth : nrows);
+    for (lno_t j = begin; j < end; j++){
+      if (dense || rand() % 3 == 0){
+        entries.push_back(j);
+        values.push_back(-one);
+        diag += one;
+      }
+    }
+    //diagonal entry
+    entries.push_back(i);
+    values.push_back(diag);
+    //row sum is diag - (number of off-diagonals) = 2
+    h_b(i) = one + one;
+    rowmap[i + 1] = entries.size();
+  }
+  Kokkos::deep_copy(b, h_b);
+
+  const size_type nnz = rowmap[nrows];
+  size_type_view_t d_rowmap("rowmap", nrows + 1);
+  lno_view_t d_entries("entries", nnz);
+  scalar_view_t d_values("values", nnz);
+  typename size_type_view_t::HostMirror h_rowmap = Kokkos::create_mirror_view(d_rowmap);
+  typename lno_view_t::HostMirror h_entries = Kokkos::create_mirror_view(d_entries);
+  typename scalar_view_t::HostMirror h_values = Kokkos::create_mirror_view(d_values);
+  for (lno_t i = 0; i <= nrows; i++) h_rowmap(i) = rowmap[i];
+  for (size_type i = 0; i < nnz; i++){
+    h_entries(i) = entries[i];
+    h_values(i) = values[i];
+  }
+  Kokkos::deep_copy(d_rowmap, h_rowmap);
+  Kokkos::deep_copy(d_entries, h_entries);
+  Kokkos::deep_copy(d_values, h_values);
+  return crsMat_t("triangular matrix", nrows, nrows, nnz, d_values, d_rowmap, d_entries);
+}
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, class Device>
+void test_sptrsv(lno_t numRows, lno_t bandwidth, bool lower_tri, bool dense = false)
+{
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, Device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+
+  typedef typename KokkosKernels::Experimental::KokkosKernelsHandle<size_type, lno_t, scalar_t,
+  typename Device::execution_space, typename Device::memory_space, typename Device::memory_space> KernelHandle;
+
+  scalar_view_t b("b", numRows);
+  scalar_view_t x("x", numRows);
+  scalar_view_t expected_x("expected_x", numRows);
+  Kokkos::deep_copy(expected_x, Kokkos::Details::ArithTraits<scalar_t>::one());
+
+  crsMat_t A = Test::makeTriangularMatrix<crsMat_t, scalar_view_t>(numRows, bandwidth, lower_tri, b, dense);
+
+  double eps = std::is_same<scalar_t, float>::value || std::is_same<scalar_t, Kokkos::complex<float> >::value ? 1e-3 : 1e-7;
+
+  std::vector<KokkosSparse::SPTRSVAlgorithm> algorithms;
+  algorithms.push_back(KokkosSparse::SPTRSV_DEFAULT);
+  algorithms.push_back(KokkosSparse::SPTRSV_SEQUENTIAL);
+  algorithms.push_back(KokkosSparse::SPTRSV_LVLSCHD_RP);
+  algorithms.push_back(KokkosSparse::SPTRSV_LVLSCHD_TP1);
+  algorithms.push_back(KokkosSparse::SPTRSV_LVLSCHD_CHAIN);
+  algorithms.push_back(KokkosSparse::SPTRSV_SUPERNODAL);
+  algorithms.push_back(KokkosSparse::SPTRSV_TASK);
+
+  for (size_t ialgo = 0; ialgo < algorithms.size(); ++ialgo){
+    KernelHandle kh;
+    kh.create_sptrsv_handle(algorithms[ialgo], numRows, lower_tri);
+    KokkosSparse::Experimental::sptrsv_symbolic(&kh, A.graph.row_map, A.graph.entries);
+    EXPECT_TRUE(kh.get_sptrsv_handle()->is_symbolic_complete());
+
+    Kokkos::deep_copy(x, Kokkos::Details::ArithTraits<scalar_t>::zero());
+    KokkosSparse::Experimental::sptrsv_solve(&kh, A.graph.row_map, A.graph.entries, A.values, b, x);
+    EXPECT_NEAR_KK_1DVIEW(expected_x, x, eps);
+
+    //second solve reuses the symbolic phase
+    Kokkos::deep_copy(x, Kokkos::Details::ArithTraits<scalar_t>::zero());
+    KokkosSparse::Experimental::sptrsv_solve(&kh, A.graph.row_map, A.graph.entries, A.values, b, x);
+    EXPECT_NEAR_KK_1DVIEW(expected_x, x, eps);
+    kh.destroy_sptrsv_handle();
+  }
+
+  //supernodal solve with a user given partition into blocks of 4 rows
+  {
+    KernelHandle kh;
+    kh.create_sptrsv_handle(KokkosSparse::SPTRSV_SUPERNODAL, numRows, lower_tri);
+    typedef typename KernelHandle::SPTRSVHandleType::nnz_lno_view_host_t supernode_view_t;
+    const lno_t nsupernodes = (numRows + 3) / 4;
+    supernode_view_t supernode_ptr("supernode_ptr", nsupernodes + 1);
+    for (lno_t k = 0; k < nsupernodes; ++k) supernode_ptr(k) = 4 * k;
+    supernode_ptr(nsupernodes) = numRows;
+    kh.get_sptrsv_handle()->set_supernodes(supernode_ptr);
+
+    Kokkos::deep_copy(x, Kokkos::Details::ArithTraits<scalar_t>::zero());
+    KokkosSparse::Experimental::sptrsv_solve(&kh, A.graph.row_map, A.graph.entries, A.values, b, x);
+    EXPECT_EQ(kh.get_sptrsv_handle()->get_num_supernodes(), nsupernodes);
+    EXPECT_NEAR_KK_1DVIEW(expected_x, x, eps);
+  }
+
+  //task solve with blocks of 4 rows, each waiting for the blocks of its columns
+  {
+    KernelHandle kh;
+    kh.create_sptrsv_handle(KokkosSparse::SPTRSV_TASK, numRows, lower_tri);
+    kh.get_sptrsv_handle()->set_task_block_size(4);
+
+    Kokkos::deep_copy(x, Kokkos::Details::ArithTraits<scalar_t>::zero());
+    KokkosSparse::Experimental::sptrsv_solve(&kh, A.graph.row_map, A.graph.entries, A.values, b, x);
+    EXPECT_EQ(kh.get_sptrsv_handle()->get_num_task_blocks(), (numRows + 3) / 4);
+    EXPECT_NEAR_KK_1DVIEW(expected_x, x, eps);
+  }
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, class Device>
+void test_sptrsv_mv(lno_t numRows, lno_t bandwidth, bool lower_tri, int numVecs)
+{
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, Device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::values_type::non_const_type scalar_view_t;
+  typedef Kokkos::View<scalar_t**, Kokkos::LayoutLeft, Device> mv_t;
+
+  typedef typename KokkosKernels::Experimental::KokkosKernelsHandle<size_type, lno_t, scalar_t,
+  typename Device::execution_space, typename Device::memory_space, typename Device::memory_space> KernelHandle;
+
+  scalar_view_t b1("b1", numRows);
+  crsMat_t A = Test::makeTriangularMatrix<crsMat_t, scalar_view_t>(numRows, bandwidth, lower_tri, b1);
+
+  //column j of the solution is (j + 1) * ones
+  mv_t b("b", numRows, numVecs);
+  mv_t x("x", numRows, numVecs);
+  mv_t expected_x("expected_x", numRows, numVecs);
+  {
+    typename scalar_view_t::HostMirror h_b1 = Kokkos::create_mirror_view(b1);
+    Kokkos::deep_copy(h_b1, b1);
+    typename mv_t::HostMirror h_b = Kokkos::create_mirror_view(b);
+    typename mv_t::HostMirror h_expected_x = Kokkos::create_mirror_view(expected_x);
+    for (lno_t i = 0; i < numRows; ++i){
+      scalar_t scale = Kokkos::Details::ArithTraits<scalar_t>::one();
+      for (int j = 0; j < numVecs; ++j){
+        h_b(i, j) = scale * h_b1(i);
+        h_expected_x(i, j) = scale;
+        scale += Kokkos::Details::ArithTraits<scalar_t>::one();
+      }
+    }
+    Kokkos::deep_copy(b, h_b);
+    Kokkos::deep_copy(expected_x, h_expected_x);
+  }
+
+  double eps = std::is_same<scalar_t, float>::value || std::is_same<scalar_t, Kokkos::complex<float> >::value ? 1e-3 : 1e-7;
+
+  std::vector<KokkosSparse::SPTRSVAlgorithm> algorithms;
+  algorithms.push_back(KokkosSparse::SPTRSV_DEFAULT);
+  algorithms.push_back(KokkosSparse::SPTRSV_SUPERNODAL);
+
+  for (size_t ialgo = 0; ialgo < algorithms.size(); ++ialgo){
+    KernelHandle kh;
+    kh.create_sptrsv_handle(algorithms[ialgo], numRows, lower_tri);
+    Kokkos::deep_copy(x, Kokkos::Details::ArithTraits<scalar_t>::zero());
+    KokkosSparse::Experimental::sptrsv_solve(&kh, A.graph.row_map, A.graph.entries, A.values, b, x);
+    for (int j = 0; j < numVecs; ++j){
+      auto x_j = Kokkos::subview(x, Kokkos::ALL(), j);
+      auto expected_x_j = Kokkos::subview(expected_x, Kokkos::ALL(), j);
+      EXPECT_NEAR_KK_1DVIEW(expected_x_j, x_j, eps * (j + 1));
+    }
+    kh.destroy_sptrsv_handle();
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory,sparse ## _ ## sptrsv ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_sptrsv<SCALAR,ORDINAL,OFFSET,DEVICE> (1, 1, true); \
+  test_sptrsv<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 5, true); \
+  test_sptrsv<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 5, false); \
+  test_sptrsv<SCALAR,ORDINAL,OFFSET,DEVICE> (1000, 20, true); \
+  test_sptrsv<SCALAR,ORDINAL,OFFSET,DEVICE> (1000, 20, false); \
+  test_sptrsv<SCALAR,ORDINAL,OFFSET,DEVICE> (50, 50, true, true); \
+  test_sptrsv<SCALAR,ORDINAL,OFFSET,DEVICE> (50, 50, false, true); \
+  test_sptrsv_mv<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 5, true, 1); \
+  test_sptrsv_mv<SCALAR,ORDINAL,OFFSET,DEVICE> (100, 5, false, 5); \
+  test_sptrsv_mv<SCALAR,ORDINAL,OFFSET,DEVICE> (1000, 20, true, 16); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_FLOAT) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(float, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_DOUBLE_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_double, int64_t, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int64_t, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int, size_t, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_KOKKOS_COMPLEX_FLOAT_) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(kokkos_complex_float, int64_t, size_t, TestExecSpace)
+#endif
+
@@ -0,0 +1,131 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "KokkosKernels_Utils.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_symmetrize(lno_t nrows, lno_t max_row_length) {
+  typedef Kokkos::View<size_type*, device> row_map_t;
+  typedef Kokkos::View<lno_t*, device> entries_t;
+  typedef typename device::execution_space exec_space;
+
+  //random rows with duplicates and self loops.
+  std::mt19937 gen(4129);
+  std::vector<size_type> h_rows(nrows + 1, 0);
+  std::vector<lno_t> h_cols;
+  std::vector<std::set<lno_t> > expected(nrows);
+  for (lno_t i = 0; i < nrows; ++i){
+    const lno_t length = gen() % (max_row_length + 1);
+    for (lno_t k = 0; k < length; ++k){
+      const lno_t j = (k % 5 == 0) ? i : lno_t(gen() % nrows);
+      h_cols.push_back(j);
+      if (k % 7 == 0) h_cols.push_back(j);
+      expected[i].insert(j);
+      expected[j].insert(i);
+    }
+    h_rows[i + 1] = h_cols.size();
+  }
+  row_map_t row_map("row_map", nrows + 1);
+  entries_t entries("entries", h_cols.size());
+  typename row_map_t::HostMirror hr = Kokkos::create_mirror_view(row_map);
+  typename entries_t::HostMirror he = Kokkos::create_mirror_view(entries);
+  for (lno_t i = 0; i <= nrows; ++i) hr(i) = h_rows[i];
+  for (size_t k = 0; k < h_cols.size(); ++k) he(k) = h_cols[k];
+  Kokkos::deep_copy(row_map, hr);
+  Kokkos::deep_copy(entries, he);
+
+  for (int remove_diagonal = 0; remove_diagonal < 2; ++remove_diagonal){
+    row_map_t sym_row_map;
+    entries_t sym_entries;
+    KokkosKernels::Impl::symmetrize_graph<row_map_t, entries_t, row_map_t, entries_t, exec_space>
+        (nrows, row_map, entries, sym_row_map, sym_entries, remove_diagonal);
+
+    typename row_map_t::HostMirror hsr = Kokkos::create_mirror_view(sym_row_map);
+    typename entries_t::HostMirror hse = Kokkos::create_mirror_view(sym_entries);
+    Kokkos::deep_copy(hsr, sym_row_map);
+    Kokkos::deep_copy(hse, sym_entries);
+
+    //each row is the sorted set of the neighbors in either direction.
+    lno_t num_errors = 0;
+    EXPECT_EQ(size_t(hsr(nrows)), sym_entries.extent(0));
+    for (lno_t i = 0; i < nrows; ++i){
+      std::vector<lno_t> row(expected[i].begin(), expected[i].end());
+      if (remove_diagonal) row.erase(std::remove(row.begin(), row.end(), i), row.end());
+      if (size_t(hsr(i + 1) - hsr(i)) != row.size()){
+        ++num_errors;
+        continue;
+      }
+      for (size_t k = 0; k < row.size(); ++k){
+        if (hse(hsr(i) + k) != row[k]) ++num_errors;
+      }
+    }
+    EXPECT_TRUE(num_errors == 0);
+  }
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## symmetrize ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_symmetrize<SCALAR,ORDINAL,OFFSET,DEVICE>(2000, 30); \
+  test_symmetrize<SCALAR,ORDINAL,OFFSET,DEVICE>(50, 200); \
+  test_symmetrize<SCALAR,ORDINAL,OFFSET,DEVICE>(0, 10); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,161 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "KokkosSparse_CrsMatrix.hpp"
+#include "KokkosSparse_transpose.hpp"
+#include "KokkosKernels_IOUtils.hpp"
+
+namespace Test {
+
+//the rows of a matrix on the host, each sorted by (column, value).
+template <typename crsMat_t>
+std::vector<std::vector<std::pair<typename crsMat_t::ordinal_type, typename crsMat_t::value_type> > >
+sorted_host_rows(const crsMat_t &A, bool &are_columns_sorted){
+  typedef typename crsMat_t::ordinal_type lno_t;
+  typedef typename crsMat_t::size_type size_type;
+  typedef typename crsMat_t::value_type scalar_t;
+  typename crsMat_t::row_map_type::HostMirror hr = Kokkos::create_mirror_view(A.graph.row_map);
+  typename crsMat_t::index_type::HostMirror he = Kokkos::create_mirror_view(A.graph.entries);
+  typename crsMat_t::values_type::HostMirror hv = Kokkos::create_mirror_view(A.values);
+  Kokkos::deep_copy(hr, A.graph.row_map);
+  Kokkos::deep_copy(he, A.graph.entries);
+  Kokkos::deep_copy(hv, A.values);
+  are_columns_sorted = true;
+  std::vector<std::vector<std::pair<lno_t, scalar_t> > > rows(A.numRows());
+  for (lno_t i = 0; i < A.numRows(); ++i){
+    for (size_type j = hr(i); j < hr(i + 1); ++j){
+      if (j > hr(i) && he(j - 1) > he(j)) are_columns_sorted = false;
+      rows[i].push_back(std::make_pair(he(j), hv(j)));
+    }
+    std::sort(rows[i].begin(), rows[i].end());
+  }
+  return rows;
+}
+
+//the transpose on the host, from the rows of A.
+template <typename crsMat_t>
+std::vector<std::vector<std::pair<typename crsMat_t::ordinal_type, typename crsMat_t::value_type> > >
+host_transpose(const crsMat_t &A){
+  typedef typename crsMat_t::ordinal_type lno_t;
+  typedef typename crsMat_t::value_type scalar_t;
+  bool are_columns_sorted;
+  std::vector<std::vector<std::pair<lno_t, scalar_t> > > rows = sorted_host_rows(A, are_columns_sorted);
+  std::vector<std::vector<std::pair<lno_t, scalar_t> > > t_rows(A.numCols());
+  for (lno_t i = 0; i < A.numRows(); ++i){
+    for (size_t j = 0; j < rows[i].size(); ++j){
+      t_rows[rows[i][j].first].push_back(std::make_pair(i, rows[i][j].second));
+    }
+  }
+  for (lno_t i = 0; i < A.numCols(); ++i) std::sort(t_rows[i].begin(), t_rows[i].end());
+  return t_rows;
+}
+
+template <typename view_t>
+struct ScaleValues{
+  view_t values;
+  ScaleValues(const view_t &values_): values(values_){}
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t &k) const { values(k) = 2 * values(k) + 1; }
+};
+
+}
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_transpose(lno_t numRows, lno_t numCols, size_type nnz, lno_t bandwidth, lno_t row_size_variance) {
+  using namespace Test;
+  typedef typename KokkosSparse::CrsMatrix<scalar_t, lno_t, device, void, size_type> crsMat_t;
+  typedef typename crsMat_t::execution_space exec_space;
+
+  crsMat_t A = KokkosKernels::Impl::kk_generate_sparse_matrix<crsMat_t>(numRows, numCols, nnz, row_size_variance, bandwidth);
+
+  std::vector<std::vector<std::pair<lno_t, scalar_t> > > expected = host_transpose(A);
+  bool are_columns_sorted;
+
+  crsMat_t AT = KokkosSparse::transpose(A);
+  EXPECT_EQ(AT.numRows(), numCols);
+  EXPECT_EQ(AT.numCols(), numRows);
+  EXPECT_TRUE(sorted_host_rows(AT, are_columns_sorted) == expected);
+
+  crsMat_t ATs = KokkosSparse::transpose(A, true);
+  EXPECT_TRUE(sorted_host_rows(ATs, are_columns_sorted) == expected);
+  EXPECT_TRUE(are_columns_sorted);
+
+  //the pattern of the handle is reused across transposes.
+  KokkosSparse::TransposeHandle<lno_t, size_type, exec_space> handle(true);
+  crsMat_t ATh = KokkosSparse::transpose(handle, A);
+  EXPECT_TRUE(sorted_host_rows(ATh, are_columns_sorted) == expected);
+  EXPECT_TRUE(are_columns_sorted);
+  crsMat_t ATh2 = KokkosSparse::transpose(handle, A);
+  EXPECT_TRUE(ATh2.graph.entries.data() == ATh.graph.entries.data());
+  EXPECT_TRUE(sorted_host_rows(ATh2, are_columns_sorted) == expected);
+
+  Kokkos::parallel_for(Kokkos::RangePolicy<exec_space>(0, A.nnz()), ScaleValues<typename crsMat_t::values_type>(A.values));
+  KokkosSparse::transpose_values(handle, A, ATh);
+  EXPECT_TRUE(sorted_host_rows(ATh, are_columns_sorted) == host_transpose(A));
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## transpose ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_transpose<SCALAR,ORDINAL,OFFSET,DEVICE>(1000, 1000, 1000 * 30, 200, 10); \
+  test_transpose<SCALAR,ORDINAL,OFFSET,DEVICE>(800, 2000, 800 * 20, 2000, 10); \
+  test_transpose<SCALAR,ORDINAL,OFFSET,DEVICE>(2000, 100, 2000 * 10, 100, 5); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT64_T) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_SIZE_T) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int64_t, size_t, TestExecSpace)
+#endif
@@ -0,0 +1,128 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//               KokkosKernels 0.9: Linear Algebra and Graph Kernels
+//                 Copyright 2017 Sandia Corporation
+//
+// Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY SANDIA CORPORATION "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SANDIA CORPORATION OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Siva Rajamanickam (srajama@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+#include <Kokkos_Core.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include "KokkosKernels_Handle.hpp"
+
+template <typename scalar_t, typename lno_t, typename size_type, typename device>
+void test_tuning_database() {
+  typedef typename device::execution_space exec_space;
+  typedef KokkosKernels::Experimental::KokkosKernelsHandle
+      <size_type, lno_t, scalar_t, exec_space, typename device::memory_space, typename device::memory_space> handle_t;
+  typedef KokkosKernels::Impl::TuningDatabase database_t;
+
+  KokkosKernels::Experimental::clear_tuning_database();
+  database_t &database = KokkosKernels::Impl::tuning_database();
+
+  //matrices of about the same size and row length share a bucket.
+  EXPECT_EQ(database_t::key("spgemm", "Serial", 1000, 10000), database_t::key("spgemm", "Serial", 1023, 9000));
+  EXPECT_NE(database_t::key("spgemm", "Serial", 1000, 10000), database_t::key("spgemm", "Serial", 1000, 100000));
+  EXPECT_NE(database_t::key("spgemm", "Serial", 1000, 10000), database_t::key("spgemm", "Serial", 4000, 40000));
+
+  handle_t kh;
+  EXPECT_FALSE(kh.apply_tuning("spgemm", 1000, 10000));
+  EXPECT_EQ(kh.get_set_suggested_team_size(), -1);
+
+  //the faster of two runs is kept.
+  kh.set_suggested_team_size(8);
+  kh.set_suggested_vector_size(4);
+  kh.set_shmem_size(32768);
+  kh.set_dynamic_scheduling(false);
+  EXPECT_TRUE(kh.record_tuning("spgemm", 1000, 10000, 3, 2.0));
+  kh.set_suggested_team_size(16);
+  EXPECT_TRUE(kh.record_tuning("spgemm", 1000, 10000, 4, 1.0));
+  kh.set_suggested_team_size(2);
+  EXPECT_FALSE(kh.record_tuning("spgemm", 1000, 10000, 5, 1.5));
+  EXPECT_EQ(database.size(), size_t(1));
+
+  //the entry survives a save, clear and load.
+  const std::string filename = "kokkoskernels_tuning_database_test.json";
+  KokkosKernels::Experimental::save_tuning_database(filename);
+  KokkosKernels::Experimental::clear_tuning_database();
+  EXPECT_TRUE(database.empty());
+  KokkosKernels::Experimental::load_tuning_database(filename);
+  std::remove(filename.c_str());
+  EXPECT_EQ(database.size(), size_t(1));
+
+  handle_t kh2;
+  KokkosKernels::Impl::KernelTuning tuning;
+  EXPECT_TRUE(kh2.apply_tuning("spgemm", 1023, 9000, tuning));
+  EXPECT_EQ(tuning.algorithm, 4);
+  EXPECT_EQ(tuning.time, 1.0);
+  EXPECT_EQ(kh2.get_set_suggested_team_size(), 16);
+  EXPECT_EQ(kh2.get_set_suggested_vector_size(), 4);
+  EXPECT_EQ(kh2.get_shmem_size(), size_t(32768));
+  EXPECT_FALSE(kh2.is_dynamic_scheduling());
+
+  //other kernels and inputs keep the handle defaults.
+  handle_t kh3;
+  EXPECT_FALSE(kh3.apply_tuning("gauss_seidel", 1000, 10000));
+  EXPECT_FALSE(kh3.apply_tuning("spgemm", 100000, 10000000));
+  EXPECT_EQ(kh3.get_set_suggested_team_size(), -1);
+
+  bool thrown = false;
+  try {
+    KokkosKernels::Experimental::load_tuning_database("kokkoskernels_tuning_database_missing.json");
+  }
+  catch (std::exception &) {
+    thrown = true;
+  }
+  EXPECT_TRUE(thrown);
+  KokkosKernels::Experimental::clear_tuning_database();
+}
+
+#define EXECUTE_TEST(SCALAR, ORDINAL, OFFSET, DEVICE) \
+TEST_F( TestCategory, sparse ## _ ## tuning_database ## _ ## SCALAR ## _ ## ORDINAL ## _ ## OFFSET ## _ ## DEVICE ) { \
+  test_tuning_database<SCALAR,ORDINAL,OFFSET,DEVICE>(); \
+}
+
+#if (defined (KOKKOSKERNELS_INST_DOUBLE) \
+ && defined (KOKKOSKERNELS_INST_ORDINAL_INT) \
+ && defined (KOKKOSKERNELS_INST_OFFSET_INT) ) || (!defined(KOKKOSKERNELS_ETI_ONLY) && !defined(KOKKOSKERNELS_IMPL_CHECK_ETI_CALLS))
+ EXECUTE_TEST(double, int, int, TestExecSpace)
+#endif
@@ -0,0 +1,2 @@
+#include<Test_Threads.hpp>
+#include<Test_Blas3_trsm.hpp>